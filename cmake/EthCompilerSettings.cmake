@@ -221,6 +221,8 @@ if (SANITIZE)
 		)
 		list(JOIN undefinedSanitizerChecks "," sanitizerChecks)
 		set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -fsanitize=${sanitizerChecks} -fno-sanitize-recover=${sanitizerChecks}")
+	elseif (sanitizer STREQUAL "thread")
+		set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -fno-omit-frame-pointer -fsanitize=thread")
 	endif()
 endif()
 
@@ -240,6 +242,8 @@ if(COVERAGE)
 		message(FATAL_ERROR "Coverage not supported")
 	endif()
 	add_compile_options(-g --coverage)
+	# The coverage data is written at exit, so solc must not skip the exit handlers.
+	add_definitions(-DCOVERAGE_BUILD)
 endif()
 
 # SMT Solvers integration
@@ -34,12 +34,20 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Timing.h>
+
 #include <json/json.h>
 
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view/enumerate.hpp>
+#include <range/v3/view/zip.hpp>
+
+#include <boost/functional/hash.hpp>
 
+#include <chrono>
 #include <fstream>
+#include <functional>
+#include <unordered_map>
 #include <limits>
 
 using namespace std;
@@ -61,14 +69,23 @@ AssemblyItem const& Assembly::append(AssemblyItem _i)
 
 unsigned Assembly::codeSize(unsigned subTagSize) const
 {
-	for (unsigned tagSize = subTagSize; true; ++tagSize)
+	// Only the references to tags, data and subs depend on the tag size,
+	// so the items are traversed once and only the fixed point over the tag size is iterated.
+	size_t fixedSize = 1;
+	size_t references = 0;
+	for (auto const& i: m_data)
+		fixedSize += i.second.size();
+
+	for (AssemblyItem const& i: m_items)
 	{
-		size_t ret = 1;
-		for (auto const& i: m_data)
-			ret += i.second.size();
+		fixedSize += i.bytesRequired(0, Precision::Approximate);
+		if (i.type() == PushTag || i.type() == PushData || i.type() == PushSub)
+			++references;
+	}
 
-		for (AssemblyItem const& i: m_items)
-			ret += i.bytesRequired(tagSize, Precision::Approximate);
+	for (unsigned tagSize = subTagSize; true; ++tagSize)
+	{
+		size_t ret = fixedSize + references * tagSize;
 		if (numberEncodingSize(ret) <= tagSize)
 			return static_cast<unsigned>(ret);
 	}
@@ -198,7 +215,15 @@ void Assembly::assemblyStream(
 		_out << _prefix << "stop" << endl;
 		for (auto const& i: m_data)
 			if (u256(i.first) >= m_subs.size())
-				_out << _prefix << "data_" << toHex(u256(i.first)) << " " << util::toHex(i.second) << endl;
+			{
+				_out << _prefix << "data_" << toHex(u256(i.first));
+				if (auto table = m_tagTables.find(i.first); table != m_tagTables.end())
+					for (size_t tag: table->second)
+						_out << " tag_" << tag;
+				else
+					_out << " " << util::toHex(i.second);
+				_out << endl;
+			}
 
 		for (size_t i = 0; i < m_subs.size(); ++i)
 		{
@@ -238,9 +263,11 @@ Json::Value Assembly::createJsonValue(string _name, int _source, int _begin, int
 
 string Assembly::toStringInHex(u256 _value)
 {
-	std::stringstream hexStr;
-	hexStr << std::uppercase << hex << _value;
-	return hexStr.str();
+	// Without leading zeros, like the output of a stream.
+	string hex = util::toHex(toCompactBigEndian(_value, 1), HexPrefix::DontAdd, HexCase::Upper);
+	if (hex.size() > 1 && hex.front() == '0')
+		hex.erase(0, 1);
+	return hex;
 }
 
 Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices) const
@@ -376,6 +403,24 @@ AssemblyItem Assembly::namedTag(string const& _name, size_t _params, size_t _ret
 	return AssemblyItem{Tag, m_namedTags.at(_name).id};
 }
 
+AssemblyItem Assembly::newTagTable(vector<AssemblyItem> const& _tags)
+{
+	vector<size_t> tags;
+	string key = "tagTable";
+	for (AssemblyItem const& tag: _tags)
+	{
+		assertThrow(tag.type() == Tag || tag.type() == PushTag, AssemblyException, "Expected tag.");
+		auto [subId, tagId] = tag.splitForeignPushTag();
+		assertThrow(subId == numeric_limits<size_t>::max(), AssemblyException, "Foreign tag in tag table.");
+		tags.push_back(tagId);
+		key += " " + to_string(tagId);
+	}
+	h256 h(util::keccak256(key));
+	m_data[h] = bytes(tags.size() * tagTableEntrySize, 0);
+	m_tagTables[h] = move(tags);
+	return AssemblyItem(PushData, h);
+}
+
 AssemblyItem Assembly::newPushLibraryAddress(string const& _identifier)
 {
 	h256 h(util::keccak256(_identifier));
@@ -417,8 +462,20 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 }
 
 
+vector<string> Assembly::OptimiserReport::unconvergedPasses() const
+{
+	vector<string> result;
+	if (converged)
+		return result;
+	for (auto const& [name, statistics]: passes)
+		if (statistics.lastIterationChanges > 0)
+			result.push_back(name);
+	return result;
+}
+
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
+	shareIdenticalSubAssemblies();
 	optimiseInternal(_settings, {});
 	return *this;
 }
@@ -432,57 +489,97 @@ map<u256, u256> const& Assembly::optimiseInternal(
 		return *m_tagReplacements;
 
 	// Run optimisation for sub-assemblies.
+	vector<set<size_t>> subTagReferences = JumpdestRemover::referencedTagsOfSubs(m_items, m_subs.size());
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
 	{
 		OptimiserSettings settings = _settings;
 		// Disable creation mode for sub-assemblies.
 		settings.isCreation = false;
+		settings.optimiseSubAssembliesOnly = false;
 		map<u256, u256> const& subTagReplacements = m_subs[subId]->optimiseInternal(
 			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
+			move(subTagReferences[subId])
 		);
 		// Apply the replacements (can be empty).
 		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
 	}
+	if (_settings.optimiseSubAssembliesOnly)
+	{
+		m_tagReplacements = map<u256, u256>{};
+		return *m_tagReplacements;
+	}
+	// Tags in tag tables are only jumped to through the table, so they have to be kept like
+	// tags referenced from outside.
+	for (auto const& table: m_tagTables)
+		_tagsReferencedFromOutside.insert(table.second.begin(), table.second.end());
 
 	map<u256, u256> tagReplacements;
-	// Iterate until no new optimisation possibilities are found.
-	for (unsigned count = 1; count > 0;)
+	m_optimiserReport = {};
+	auto const startTime = chrono::steady_clock::now();
+	// Runs the given pass, which returns its number of changes, and records its statistics.
+	auto runPass = [&](string const& _name, function<size_t()> const& _pass) -> size_t
+	{
+		util::ScopedTraceSpan span(_name, "evmasm");
+		auto const passStart = chrono::steady_clock::now();
+		size_t changes = _pass();
+		OptimiserPassStatistics& statistics = m_optimiserReport.passes[_name];
+		statistics.changes += changes;
+		statistics.lastIterationChanges = changes;
+		statistics.time += chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - passStart);
+		return changes;
+	};
+	// Iterate until no new optimisation possibilities are found or the budget is exhausted.
+	for (size_t count = 1; count > 0;)
 	{
+		if (
+			(_settings.maxIterations > 0 && m_optimiserReport.iterations >= _settings.maxIterations) ||
+			(_settings.timeBudget.count() > 0 && chrono::steady_clock::now() - startTime >= _settings.timeBudget)
+		)
+		{
+			m_optimiserReport.converged = false;
+			break;
+		}
+		++m_optimiserReport.iterations;
 		count = 0;
 
+		// The inliner does not report its changes, so it does not count towards convergence.
 		if (_settings.runInliner)
-			Inliner{
-				m_items,
-				_tagsReferencedFromOutside,
-				_settings.expectedExecutionsPerDeployment,
-				_settings.isCreation,
-				_settings.evmVersion
-			}.optimise();
+			runPass("Inliner", [&]() -> size_t {
+				Inliner{
+					m_items,
+					_tagsReferencedFromOutside,
+					_settings.expectedExecutionsPerDeployment,
+					_settings.isCreation,
+					_settings.evmVersion,
+					_settings.inlinerCallSiteCostModel
+				}.optimise();
+				return 0;
+			});
 
 		if (_settings.runJumpdestRemover)
-		{
-			JumpdestRemover jumpdestOpt{m_items};
-			if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
-				count++;
-		}
+			count += runPass("JumpdestRemover", [&]() -> size_t {
+				JumpdestRemover jumpdestOpt{m_items};
+				return jumpdestOpt.optimise(_tagsReferencedFromOutside) ? 1 : 0;
+			});
 
 		if (_settings.runPeephole)
-		{
-			PeepholeOptimiser peepOpt{m_items};
-			while (peepOpt.optimise())
-			{
-				count++;
-				assertThrow(count < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
-			}
-		}
+			count += runPass("PeepholeOptimiser", [&]() -> size_t {
+				size_t changes = 0;
+				PeepholeOptimiser peepOpt{m_items};
+				while (peepOpt.optimise())
+				{
+					changes++;
+					assertThrow(changes < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
+				}
+				return changes;
+			});
 
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
-		{
-			BlockDeduplicator deduplicator{m_items};
-			if (deduplicator.deduplicate())
-			{
+			count += runPass("BlockDeduplicator", [&]() -> size_t {
+				BlockDeduplicator deduplicator{m_items};
+				if (!deduplicator.deduplicate())
+					return 0;
 				for (auto const& replacement: deduplicator.replacedTags())
 				{
 					assertThrow(
@@ -498,73 +595,195 @@ map<u256, u256> const& Assembly::optimiseInternal(
 					tagReplacements[replacement.first] = replacement.second;
 					if (_tagsReferencedFromOutside.erase(static_cast<size_t>(replacement.first)))
 						_tagsReferencedFromOutside.insert(static_cast<size_t>(replacement.second));
+					for (auto& table: m_tagTables)
+						replace(
+							table.second.begin(),
+							table.second.end(),
+							static_cast<size_t>(replacement.first),
+							static_cast<size_t>(replacement.second)
+						);
 				}
-				count++;
-			}
-		}
-
-		if (_settings.runCSE)
-		{
-			// Control flow graph optimization has been here before but is disabled because it
-			// assumes we only jump to tags that are pushed. This is not the case anymore with
-			// function types that can be stored in storage.
-			AssemblyItems optimisedItems;
-
-			bool usesMSize = ranges::any_of(m_items, [](AssemblyItem const& _i) {
-				return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
+				return 1;
 			});
 
-			auto iter = m_items.begin();
-			while (iter != m_items.end())
-			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
-				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
-				bool shouldReplace = false;
-				AssemblyItems optimisedChunk;
-				try
-				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < static_cast<size_t>(iter - orig));
-				}
-				catch (StackTooDeepException const&)
+		if (_settings.runCSE)
+			count += runPass("CommonSubexpressionEliminator", [&]() -> size_t {
+				// Control flow graph optimization has been here before but is disabled because it
+				// assumes we only jump to tags that are pushed. This is not the case anymore with
+				// function types that can be stored in storage.
+				size_t changes = 0;
+				AssemblyItems optimisedItems;
+
+				bool usesMSize = ranges::any_of(m_items, [](AssemblyItem const& _i) {
+					return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
+				});
+
+				auto iter = m_items.begin();
+				while (iter != m_items.end())
 				{
-					// This might happen if the opcode reconstruction is not as efficient
-					// as the hand-crafted code.
+					KnownState emptyState;
+					CommonSubexpressionEliminator eliminator{emptyState};
+					auto orig = iter;
+					iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
+					bool shouldReplace = false;
+					AssemblyItems optimisedChunk;
+					try
+					{
+						optimisedChunk = eliminator.getOptimizedItems();
+						shouldReplace = (optimisedChunk.size() < static_cast<size_t>(iter - orig));
+					}
+					catch (StackTooDeepException const&)
+					{
+						// This might happen if the opcode reconstruction is not as efficient
+						// as the hand-crafted code.
+					}
+					catch (ItemNotAvailableException const&)
+					{
+						// This might happen if e.g. associativity and commutativity rules
+						// reorganise the expression tree, but not all leaves are available.
+					}
+
+					if (shouldReplace)
+					{
+						changes++;
+						optimisedItems += optimisedChunk;
+					}
+					else
+						copy(orig, iter, back_inserter(optimisedItems));
 				}
-				catch (ItemNotAvailableException const&)
+				if (optimisedItems.size() < m_items.size())
 				{
-					// This might happen if e.g. associativity and commutativity rules
-					// reorganise the expression tree, but not all leaves are available.
+					m_items = move(optimisedItems);
+					changes++;
 				}
+				return changes;
+			});
+	}
 
-				if (shouldReplace)
-				{
-					count++;
-					optimisedItems += optimisedChunk;
-				}
-				else
-					copy(orig, iter, back_inserter(optimisedItems));
+	if (_settings.runConstantOptimiser)
+	{
+		runPass("ConstantOptimiser", [&]() -> size_t {
+			return ConstantOptimisationMethod::optimiseConstants(
+				_settings.isCreation,
+				_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
+				_settings.evmVersion,
+				*this,
+				_settings.parallelism
+			);
+		});
+		// The constant optimiser runs only once, after the loop.
+		m_optimiserReport.passes["ConstantOptimiser"].lastIterationChanges = 0;
+	}
+
+	m_tagReplacements = move(tagReplacements);
+	return *m_tagReplacements;
+}
+
+void Assembly::shareIdenticalSubAssemblies()
+{
+	// Assemblies that were already processed, mapped to the assembly replacing them.
+	map<Assembly const*, shared_ptr<Assembly>> replacements;
+	// Assemblies that can be shared, bucketed by their structural hash.
+	unordered_map<size_t, vector<shared_ptr<Assembly>>> representatives;
+
+	// Processes the tree bottom-up, so that identical sub-assemblies already share
+	// their own sub-assemblies when they are compared.
+	function<void(Assembly&)> visit = [&](Assembly& _assembly)
+	{
+		vector<set<size_t>> subTagReferences = JumpdestRemover::referencedTagsOfSubs(_assembly.m_items, _assembly.m_subs.size());
+		for (size_t subId = 0; subId < _assembly.m_subs.size(); ++subId)
+		{
+			shared_ptr<Assembly>& sub = _assembly.m_subs[subId];
+			if (auto it = replacements.find(sub.get()); it != replacements.end())
+			{
+				sub = it->second;
+				continue;
 			}
-			if (optimisedItems.size() < m_items.size())
+			visit(*sub);
+			replacements[sub.get()] = sub;
+
+			// Already optimised or assembled assemblies, as well as those whose tags are
+			// referenced from the parent, are kept as they are.
+			if (
+				sub->m_tagReplacements ||
+				!sub->m_assembledObject.bytecode.empty() ||
+				!subTagReferences[subId].empty()
+			)
+				continue;
+
+			vector<shared_ptr<Assembly>>& bucket = representatives[sub->structuralHash()];
+			auto representative = find_if(bucket.begin(), bucket.end(), [&](shared_ptr<Assembly> const& _candidate) {
+				return _candidate->structurallyEqual(*sub);
+			});
+			if (representative == bucket.end())
+				bucket.push_back(sub);
+			else
 			{
-				m_items = move(optimisedItems);
-				count++;
+				replacements[sub.get()] = *representative;
+				sub = *representative;
 			}
 		}
-	}
+	};
+	visit(*this);
+}
 
-	if (_settings.runConstantOptimiser)
-		ConstantOptimisationMethod::optimiseConstants(
-			_settings.isCreation,
-			_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
-			_settings.evmVersion,
-			*this
-		);
+size_t Assembly::structuralHash() const
+{
+	size_t seed = 0;
+	boost::hash_combine(seed, m_name);
+	boost::hash_combine(seed, m_usedTags);
+	boost::hash_combine(seed, m_items.size());
+	for (AssemblyItem const& item: m_items)
+	{
+		boost::hash_combine(seed, static_cast<int>(item.type()));
+		if (item.type() == Operation)
+			boost::hash_combine(seed, static_cast<uint8_t>(item.instruction()));
+		else if (item.type() != VerbatimBytecode)
+			boost::hash_combine(seed, static_cast<uint64_t>(item.data() & numeric_limits<uint64_t>::max()));
+	}
+	for (auto const& sub: m_subs)
+		boost::hash_combine(seed, sub.get());
+	boost::hash_combine(seed, m_data.size());
+	boost::hash_combine(seed, m_auxiliaryData.size());
+	return seed;
+}
 
-	m_tagReplacements = move(tagReplacements);
-	return *m_tagReplacements;
+bool Assembly::structurallyEqual(Assembly const& _other) const
+{
+	if (
+		m_invalid != _other.m_invalid ||
+		m_name != _other.m_name ||
+		m_usedTags != _other.m_usedTags ||
+		m_items.size() != _other.m_items.size() ||
+		m_subs != _other.m_subs ||
+		m_data != _other.m_data ||
+		m_tagTables != _other.m_tagTables ||
+		m_auxiliaryData != _other.m_auxiliaryData ||
+		m_strings != _other.m_strings ||
+		m_libraries != _other.m_libraries ||
+		m_immutables != _other.m_immutables ||
+		m_subPaths != _other.m_subPaths ||
+		m_namedTags.size() != _other.m_namedTags.size()
+	)
+		return false;
+	for (auto&& [tag, otherTag]: ranges::views::zip(m_namedTags, _other.m_namedTags))
+		if (
+			tag.first != otherTag.first ||
+			tag.second.id != otherTag.second.id ||
+			tag.second.sourceID != otherTag.second.sourceID ||
+			tag.second.params != otherTag.second.params ||
+			tag.second.returns != otherTag.second.returns
+		)
+			return false;
+	for (auto&& [item, otherItem]: ranges::views::zip(m_items, _other.m_items))
+		if (
+			item != otherItem ||
+			item.location() != otherItem.location() ||
+			item.getJumpType() != otherItem.getJumpType() ||
+			item.m_modifierDepth != otherItem.m_modifierDepth
+		)
+			return false;
+	return true;
 }
 
 LinkerObject const& Assembly::assemble() const
@@ -579,31 +798,41 @@ LinkerObject const& Assembly::assemble() const
 	LinkerObject& ret = m_assembledObject;
 
 	size_t subTagSize = 1;
-	map<u256, pair<string, vector<size_t>>> immutableReferencesBySub;
+	// The immutable references of the sub-assembly are used in place. The ones that are assigned
+	// are counted, so that unassigned ones can be detected at the end.
+	map<u256, pair<string, vector<size_t>>> const* immutableReferencesBySub = nullptr;
 	for (auto const& sub: m_subs)
 	{
 		auto const& linkerObject = sub->assemble();
 		if (!linkerObject.immutableReferences.empty())
 		{
 			assertThrow(
-				immutableReferencesBySub.empty(),
+				!immutableReferencesBySub,
 				AssemblyException,
 				"More than one sub-assembly references immutables."
 			);
-			immutableReferencesBySub = linkerObject.immutableReferences;
+			immutableReferencesBySub = &linkerObject.immutableReferences;
 		}
 		for (size_t tagPos: sub->m_tagPositionsInBytecode)
 			if (tagPos != numeric_limits<size_t>::max() && tagPos > subTagSize)
 				subTagSize = tagPos;
 	}
 
+	static vector<size_t> const noImmutableOffsets;
+	auto immutableOffsets = [&](u256 const& _identifier) -> vector<size_t> const& {
+		if (immutableReferencesBySub)
+			if (auto references = immutableReferencesBySub->find(_identifier); references != immutableReferencesBySub->end())
+				return references->second.second;
+		return noImmutableOffsets;
+	};
+
 	bool setsImmutables = false;
 	bool pushesImmutables = false;
 
 	for (auto const& i: m_items)
 		if (i.type() == AssignImmutable)
 		{
-			i.setImmutableOccurrences(immutableReferencesBySub[i.data()].second.size());
+			i.setImmutableOccurrences(immutableOffsets(i.data()).size());
 			setsImmutables = true;
 		}
 		else if (i.type() == PushImmutable)
@@ -617,7 +846,9 @@ LinkerObject const& Assembly::assemble() const
 
 	unsigned bytesRequiredForCode = codeSize(static_cast<unsigned>(subTagSize));
 	m_tagPositionsInBytecode = vector<size_t>(m_usedTags, numeric_limits<size_t>::max());
-	map<size_t, pair<size_t, size_t>> tagRef;
+	// Code locations of tag references, in increasing order, together with the referenced sub and tag.
+	vector<pair<size_t, pair<size_t, size_t>>> tagRef;
+	set<u256> assignedImmutables;
 	multimap<h256, unsigned> dataRef;
 	multimap<size_t, size_t> subRef;
 	vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
@@ -655,7 +886,7 @@ LinkerObject const& Assembly::assemble() const
 		case PushTag:
 		{
 			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
+			tagRef.emplace_back(ret.bytecode.size(), i.splitForeignPushTag());
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
 			break;
 		}
@@ -696,20 +927,24 @@ LinkerObject const& Assembly::assemble() const
 			break;
 		case PushImmutable:
 			ret.bytecode.push_back(static_cast<uint8_t>(Instruction::PUSH32));
+		{
+			auto& [identifier, offsets] = ret.immutableReferences[i.data()];
 			// Maps keccak back to the "identifier" string of that immutable.
-			ret.immutableReferences[i.data()].first = m_immutables.at(i.data());
+			if (offsets.empty())
+				identifier = m_immutables.at(i.data());
 			// Record the bytecode offset of the PUSH32 argument.
-			ret.immutableReferences[i.data()].second.emplace_back(ret.bytecode.size());
+			offsets.emplace_back(ret.bytecode.size());
 			// Advance bytecode by 32 bytes (default initialized).
 			ret.bytecode.resize(ret.bytecode.size() + 32);
 			break;
+		}
 		case VerbatimBytecode:
 			ret.bytecode += i.verbatimData();
 			break;
 		case AssignImmutable:
 		{
 			// Expect 2 elements on stack (source, dest_base)
-			auto const& offsets = immutableReferencesBySub[i.data()].second;
+			auto const& offsets = immutableOffsets(i.data());
 			for (size_t i = 0; i < offsets.size(); ++i)
 			{
 				if (i != offsets.size() - 1)
@@ -718,9 +953,11 @@ LinkerObject const& Assembly::assemble() const
 					ret.bytecode.push_back(uint8_t(Instruction::DUP2));
 				}
 				// TODO: should we make use of the constant optimizer methods for pushing the offsets?
-				bytes offsetBytes = toCompactBigEndian(u256(offsets[i]));
-				ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(static_cast<unsigned>(offsetBytes.size()))));
-				ret.bytecode += offsetBytes;
+				unsigned offsetSize = numberEncodingSize(offsets[i]);
+				ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(offsetSize)));
+				ret.bytecode.resize(ret.bytecode.size() + offsetSize);
+				bytesRef offsetBytes(&ret.bytecode.back() + 1 - offsetSize, offsetSize);
+				toBigEndian(offsets[i], offsetBytes);
 				ret.bytecode.push_back(uint8_t(Instruction::ADD));
 				ret.bytecode.push_back(uint8_t(Instruction::MSTORE));
 			}
@@ -729,7 +966,8 @@ LinkerObject const& Assembly::assemble() const
 				ret.bytecode.push_back(uint8_t(Instruction::POP));
 				ret.bytecode.push_back(uint8_t(Instruction::POP));
 			}
-			immutableReferencesBySub.erase(i.data());
+			if (!offsets.empty())
+				assignedImmutables.insert(i.data());
 			break;
 		}
 		case PushDeployTimeAddress:
@@ -752,7 +990,7 @@ LinkerObject const& Assembly::assemble() const
 		}
 	}
 
-	if (!immutableReferencesBySub.empty())
+	if (immutableReferencesBySub && assignedImmutables.size() != immutableReferencesBySub->size())
 		throw
 			langutil::Error(
 				1284_error,
@@ -788,16 +1026,18 @@ LinkerObject const& Assembly::assemble() const
 		bytesRef r(ret.bytecode.data() + i.first, bytesPerTag);
 		toBigEndian(pos, r);
 	}
+	// Index of the first occurrence of each tag in the items.
+	map<size_t, size_t> tagIndices;
+	if (!m_namedTags.empty())
+		for (auto&& [index, item]: m_items | ranges::views::enumerate)
+			if (item.type() == Tag)
+				tagIndices.emplace(static_cast<size_t>(item.data()), index);
 	for (auto const& [name, tagInfo]: m_namedTags)
 	{
 		size_t position = m_tagPositionsInBytecode.at(tagInfo.id);
 		optional<size_t> tagIndex;
-		for (auto&& [index, item]: m_items | ranges::views::enumerate)
-			if (item.type() == Tag && static_cast<size_t>(item.data()) == tagInfo.id)
-			{
-				tagIndex = index;
-				break;
-			}
+		if (auto it = tagIndices.find(tagInfo.id); it != tagIndices.end())
+			tagIndex = it->second;
 		ret.functionDebugData[name] = {
 			position == numeric_limits<size_t>::max() ? nullopt : optional<size_t>{position},
 			tagIndex,
@@ -817,7 +1057,17 @@ LinkerObject const& Assembly::assemble() const
 			bytesRef r(ret.bytecode.data() + ref->second, bytesPerDataRef);
 			toBigEndian(ret.bytecode.size(), r);
 		}
+		size_t const dataOffset = ret.bytecode.size();
 		ret.bytecode += dataItem.second;
+		if (auto table = m_tagTables.find(dataItem.first); table != m_tagTables.end())
+			for (auto&& [index, tagId]: table->second | ranges::views::enumerate)
+			{
+				size_t pos = m_tagPositionsInBytecode.at(tagId);
+				assertThrow(pos != numeric_limits<size_t>::max(), AssemblyException, "Reference to tag without position.");
+				assertThrow(numberEncodingSize(pos) <= tagTableEntrySize, AssemblyException, "Tag too large for tag table.");
+				bytesRef r(ret.bytecode.data() + dataOffset + index * tagTableEntrySize, tagTableEntrySize);
+				toBigEndian(pos, r);
+			}
 	}
 
 	ret.bytecode += m_auxiliaryData;
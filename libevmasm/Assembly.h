@@ -35,6 +35,7 @@
 
 #include <json/json.h>
 
+#include <chrono>
 #include <iostream>
 #include <sstream>
 #include <memory>
@@ -50,12 +51,24 @@ class Assembly
 public:
 	explicit Assembly(std::string _name = std::string()):m_name(std::move(_name)) { }
 
+	/// Number of bytes per entry of a table of tags.
+	static constexpr unsigned tagTableEntrySize = 4;
+
 	AssemblyItem newTag() { assertThrow(m_usedTags < 0xffffffff, AssemblyException, ""); return AssemblyItem(Tag, m_usedTags++); }
 	AssemblyItem newPushTag() { assertThrow(m_usedTags < 0xffffffff, AssemblyException, ""); return AssemblyItem(PushTag, m_usedTags++); }
+	/// @returns the identifier the next new tag will receive.
+	size_t nextTagId() const { return m_usedTags; }
 	/// Returns a tag identified by the given name. Creates it if it does not yet exist.
 	AssemblyItem namedTag(std::string const& _name, size_t _params, size_t _returns, std::optional<uint64_t> _sourceID);
 	AssemblyItem newData(bytes const& _data) { util::h256 h(util::keccak256(util::asString(_data))); m_data[h] = _data; return AssemblyItem(PushData, h); }
 	bytes const& data(util::h256 const& _i) const { return m_data.at(_i); }
+	/// Adds a table of the code offsets of the given tags of this assembly to the data section,
+	/// each encoded in tagTableEntrySize bytes. @returns the item pushing the offset of the table.
+	AssemblyItem newTagTable(std::vector<AssemblyItem> const& _tags);
+	/// @returns the identifier of the library whose address is pushed by items with data @a _i.
+	std::string const& libraryIdentifier(util::h256 const& _i) const { return m_libraries.at(_i); }
+	/// @returns the identifier of the immutable pushed by items with data @a _i.
+	std::string const& immutableIdentifier(util::h256 const& _i) const { return m_immutables.at(_i); }
 	AssemblyItem newSub(AssemblyPointer const& _sub) { m_subs.push_back(_sub); return AssemblyItem(PushSub, m_subs.size() - 1); }
 	Assembly const& sub(size_t _sub) const { return *m_subs.at(_sub); }
 	Assembly& sub(size_t _sub) { return *m_subs.at(_sub); }
@@ -128,6 +141,45 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = frontend::OptimiserSettings{}.expectedExecutionsPerDeployment;
+		/// Maximum number of threads used by the optimiser steps that can run in parallel.
+		/// The result of the optimisation does not depend on it.
+		size_t parallelism = 1;
+		/// Maximum number of iterations of the optimisation loop per assembly, unlimited if zero.
+		size_t maxIterations = 0;
+		/// Time after which no new iteration of the optimisation loop is started for an assembly,
+		/// unlimited if zero. Note that the result of the optimisation depends on the machine speed
+		/// if this budget is exhausted.
+		std::chrono::milliseconds timeBudget{0};
+		/// If true, only the sub-assemblies are optimised and the code of this assembly is left
+		/// as it is. The sub-assemblies are optimised in the same way as they are otherwise.
+		bool optimiseSubAssembliesOnly = false;
+		/// If true, the inliner weights calls inside loops, takes the stack shuffling at return
+		/// sites into account and limits the growth of the code size, see Inliner.
+		bool inlinerCallSiteCostModel = false;
+	};
+
+	struct OptimiserPassStatistics
+	{
+		/// Number of changes made by the pass over all iterations.
+		size_t changes = 0;
+		/// Number of changes made by the pass in the last iteration.
+		size_t lastIterationChanges = 0;
+		std::chrono::microseconds time{0};
+	};
+
+	/// Statistics of the optimisation of a single assembly, excluding its sub-assemblies.
+	struct OptimiserReport
+	{
+		/// Number of iterations of the optimisation loop.
+		size_t iterations = 0;
+		/// False if the iteration or time budget was exhausted before reaching a fixed point.
+		bool converged = true;
+		/// Statistics per optimiser pass, keyed by the name of the pass.
+		std::map<std::string, OptimiserPassStatistics> passes;
+
+		/// @returns the passes that still changed the code in the last iteration of the loop
+		/// if the budget was exhausted, i.e. the ones that prevented convergence.
+		std::vector<std::string> unconvergedPasses() const;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -141,6 +193,10 @@ public:
 	/// If @a _enable is not set, will perform some simple peephole optimizations.
 	Assembly& optimise(bool _enable, langutil::EVMVersion _evmVersion, bool _isCreation, size_t _runs);
 
+	/// @returns the statistics of the last optimisation of this assembly.
+	/// Those of the sub-assemblies can be retrieved via @a sub.
+	OptimiserReport const& optimiserReport() const { return m_optimiserReport; }
+
 	/// Create a text representation of the assembly.
 	std::string assemblyString(
 		langutil::DebugInfoSelection const& _debugInfoSelection = langutil::DebugInfoSelection::Default(),
@@ -172,6 +228,16 @@ protected:
 
 	unsigned codeSize(unsigned subTagSize) const;
 
+	/// Replaces all sub-assemblies in the tree below this assembly that are structurally identical
+	/// to an earlier one by a shared pointer to the earlier one, so that it is only optimised
+	/// and assembled once. Sub-assemblies whose tags are referenced from their parent are not shared.
+	void shareIdenticalSubAssemblies();
+	/// @returns a hash of the contents of this assembly that is equal for structurally
+	/// identical assemblies.
+	size_t structuralHash() const;
+	/// @returns true if both assemblies have the same contents. Sub-assemblies are compared by pointer.
+	bool structurallyEqual(Assembly const& _other) const;
+
 private:
 	static Json::Value createJsonValue(
 		std::string _name,
@@ -202,6 +268,8 @@ protected:
 	std::map<std::string, NamedTagInfo> m_namedTags;
 	AssemblyItems m_items;
 	std::map<util::h256, bytes> m_data;
+	/// Tags whose code offsets are filled into the data item with the same key during assembly.
+	std::map<util::h256, std::vector<size_t>> m_tagTables;
 	/// Data that is appended to the very end of the contract.
 	bytes m_auxiliaryData;
 	std::vector<std::shared_ptr<Assembly>> m_subs;
@@ -216,6 +284,7 @@ protected:
 	/// Contains the tag replacements relevant for super-assemblies.
 	/// If set, it means the optimizer has run and we will not run it again.
 	std::optional<std::map<u256, u256>> m_tagReplacements;
+	OptimiserReport m_optimiserReport;
 
 	mutable LinkerObject m_assembledObject;
 	mutable std::vector<size_t> m_tagPositionsInBytecode;
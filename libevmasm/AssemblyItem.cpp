@@ -24,10 +24,13 @@
 #include <libsolutil/Numeric.h>
 #include <libsolutil/StringUtils.h>
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/LEB128.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <charconv>
 #include <fstream>
 #include <limits>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
@@ -357,95 +360,196 @@ size_t AssemblyItem::opcodeCount() const noexcept
 	}
 }
 
+namespace
+{
+
+/// Components of a single source mapping entry.
+struct SourceMappingEntry
+{
+	int start = -1;
+	int length = -1;
+	int sourceIndex = -1;
+	char jump = 0;
+	int modifierDepth = -1;
+};
+
+/// Computes the source mapping entries of items, looking up the index of every
+/// (interned) source name only once.
+class SourceMappingEntries
+{
+public:
+	explicit SourceMappingEntries(map<string, unsigned> const& _sourceIndicesMap):
+		m_sourceIndicesMap(_sourceIndicesMap)
+	{}
+
+	SourceMappingEntry operator()(AssemblyItem const& _item)
+	{
+		SourceMappingEntry entry;
+		SourceLocation const& location = _item.location();
+		entry.start = location.start;
+		entry.length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
+		entry.sourceIndex = sourceIndex(location.sourceName);
+		entry.jump = '-';
+		if (_item.getJumpType() == AssemblyItem::JumpType::IntoFunction)
+			entry.jump = 'i';
+		else if (_item.getJumpType() == AssemblyItem::JumpType::OutOfFunction)
+			entry.jump = 'o';
+		entry.modifierDepth = static_cast<int>(_item.m_modifierDepth);
+		return entry;
+	}
+
+private:
+	int sourceIndex(string const* _sourceName)
+	{
+		if (!_sourceName)
+			return -1;
+		auto [it, inserted] = m_cache.try_emplace(_sourceName, -1);
+		if (inserted)
+			if (auto index = m_sourceIndicesMap.find(*_sourceName); index != m_sourceIndicesMap.end())
+				it->second = static_cast<int>(index->second);
+		return it->second;
+	}
+
+	map<string, unsigned> const& m_sourceIndicesMap;
+	unordered_map<string const*, int> m_cache;
+};
+
+void appendNumber(string& _out, int _value)
+{
+	char buffer[16];
+	auto result = to_chars(begin(buffer), end(buffer), _value);
+	_out.append(buffer, result.ptr);
+}
+
+}
+
 std::string AssemblyItem::computeSourceMapping(
 	AssemblyItems const& _items,
 	map<string, unsigned> const& _sourceIndicesMap
 )
 {
-	string ret;
+	SourceMappingWriter writer{_sourceIndicesMap};
+	// Most entries are empty or only differ in a few components.
+	writer.reserve(_items.size());
+	for (auto const& item: _items)
+		writer.append(item.location(), item.getJumpType(), item.m_modifierDepth, item.opcodeCount());
+	return writer.mapping();
+}
+
+bytes AssemblyItem::computeBinarySourceMapping(
+	AssemblyItems const& _items,
+	map<string, unsigned> const& _sourceIndicesMap
+)
+{
+	bytes ret;
+	ret.reserve(_items.size() * 5);
 
-	int prevStart = -1;
-	int prevLength = -1;
-	int prevSourceIndex = -1;
-	int prevModifierDepth = -1;
-	char prevJump = 0;
+	SourceMappingEntries entries{_sourceIndicesMap};
+	SourceMappingEntry prev{0, 0, 0, '-', 0};
 
+	auto appendDelta = [&](int _value, int _previous) {
+		ret += util::lebEncodeSigned(int64_t(_value) - int64_t(_previous));
+	};
 	for (auto const& item: _items)
 	{
-		if (!ret.empty())
-			ret += ";";
-
-		SourceLocation const& location = item.location();
-		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			(location.sourceName && _sourceIndicesMap.count(*location.sourceName)) ?
-			static_cast<int>(_sourceIndicesMap.at(*location.sourceName)) :
-			-1;
-		char jump = '-';
-		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction)
-			jump = 'i';
-		else if (item.getJumpType() == evmasm::AssemblyItem::JumpType::OutOfFunction)
-			jump = 'o';
-		int modifierDepth = static_cast<int>(item.m_modifierDepth);
-
-		unsigned components = 5;
-		if (modifierDepth == prevModifierDepth)
+		SourceMappingEntry const entry = entries(item);
+		for (size_t i = 0; i < max<size_t>(1, item.opcodeCount()); ++i)
+		{
+			appendDelta(entry.start, prev.start);
+			appendDelta(entry.length, prev.length);
+			appendDelta(entry.sourceIndex, prev.sourceIndex);
+			ret.push_back(entry.jump == 'i' ? 1 : entry.jump == 'o' ? 2 : 0);
+			ret += util::lebEncode(static_cast<uint64_t>(entry.modifierDepth));
+			prev = entry;
+		}
+	}
+	return ret;
+}
+
+void SourceMappingWriter::append(
+	SourceLocation const& _location,
+	AssemblyItem::JumpType _jumpType,
+	size_t _modifierDepth,
+	size_t _opcodeCount
+)
+{
+	if (!m_mapping.empty())
+		m_mapping += ";";
+
+	Entry entry;
+	entry.start = _location.start;
+	entry.length = _location.start != -1 && _location.end != -1 ? _location.end - _location.start : -1;
+	entry.sourceIndex = sourceIndex(_location.sourceName);
+	entry.jump = '-';
+	if (_jumpType == AssemblyItem::JumpType::IntoFunction)
+		entry.jump = 'i';
+	else if (_jumpType == AssemblyItem::JumpType::OutOfFunction)
+		entry.jump = 'o';
+	entry.modifierDepth = static_cast<int>(_modifierDepth);
+
+	unsigned components = 5;
+	if (entry.modifierDepth == m_previous.modifierDepth)
+	{
+		components--;
+		if (entry.jump == m_previous.jump)
 		{
 			components--;
-			if (jump == prevJump)
+			if (entry.sourceIndex == m_previous.sourceIndex)
 			{
 				components--;
-				if (sourceIndex == prevSourceIndex)
+				if (entry.length == m_previous.length)
 				{
 					components--;
-					if (length == prevLength)
-					{
+					if (entry.start == m_previous.start)
 						components--;
-						if (location.start == prevStart)
-							components--;
-					}
 				}
 			}
 		}
+	}
 
+	if (components-- > 0)
+	{
+		if (entry.start != m_previous.start)
+			appendNumber(m_mapping, entry.start);
 		if (components-- > 0)
 		{
-			if (location.start != prevStart)
-				ret += to_string(location.start);
+			m_mapping += ':';
+			if (entry.length != m_previous.length)
+				appendNumber(m_mapping, entry.length);
 			if (components-- > 0)
 			{
-				ret += ':';
-				if (length != prevLength)
-					ret += to_string(length);
+				m_mapping += ':';
+				if (entry.sourceIndex != m_previous.sourceIndex)
+					appendNumber(m_mapping, entry.sourceIndex);
 				if (components-- > 0)
 				{
-					ret += ':';
-					if (sourceIndex != prevSourceIndex)
-						ret += to_string(sourceIndex);
+					m_mapping += ':';
+					if (entry.jump != m_previous.jump)
+						m_mapping += entry.jump;
 					if (components-- > 0)
 					{
-						ret += ':';
-						if (jump != prevJump)
-							ret += jump;
-						if (components-- > 0)
-						{
-							ret += ':';
-							if (modifierDepth != prevModifierDepth)
-								ret += to_string(modifierDepth);
-						}
+						m_mapping += ':';
+						if (entry.modifierDepth != m_previous.modifierDepth)
+							appendNumber(m_mapping, entry.modifierDepth);
 					}
 				}
 			}
 		}
+	}
 
-		if (item.opcodeCount() > 1)
-			ret += string(item.opcodeCount() - 1, ';');
+	if (_opcodeCount > 1)
+		m_mapping += string(_opcodeCount - 1, ';');
 
-		prevStart = location.start;
-		prevLength = length;
-		prevSourceIndex = sourceIndex;
-		prevJump = jump;
-		prevModifierDepth = modifierDepth;
-	}
-	return ret;
+	m_previous = entry;
+}
+
+int SourceMappingWriter::sourceIndex(string const* _sourceName)
+{
+	if (!_sourceName)
+		return -1;
+	auto [it, inserted] = m_sourceIndexCache.try_emplace(_sourceName, -1);
+	if (inserted)
+		if (auto index = m_sourceIndicesMap.find(*_sourceName); index != m_sourceIndicesMap.end())
+			it->second = static_cast<int>(index->second);
+	return it->second;
 }
@@ -27,9 +27,13 @@
 #include <liblangutil/SourceLocation.h>
 #include <libsolutil/Common.h>
 #include <libsolutil/Assertions.h>
+#include <limits>
+#include <map>
+#include <memory>
 #include <optional>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 
 namespace solidity::evmasm
 {
@@ -61,7 +65,7 @@ using AssemblyItems = std::vector<AssemblyItem>;
 class AssemblyItem
 {
 public:
-	enum class JumpType { Ordinary, IntoFunction, OutOfFunction };
+	enum class JumpType: uint8_t { Ordinary, IntoFunction, OutOfFunction };
 
 	AssemblyItem(u256 _push, langutil::SourceLocation _location = langutil::SourceLocation()):
 		AssemblyItem(Push, std::move(_push), std::move(_location)) { }
@@ -77,12 +81,16 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			storeData(_data);
 	}
 	explicit AssemblyItem(bytes _verbatimData, size_t _arguments, size_t _returnVariables):
 		m_type(VerbatimBytecode),
 		m_instruction{},
-		m_verbatimBytecode{{_arguments, _returnVariables, std::move(_verbatimData)}}
+		m_verbatimBytecode{std::make_shared<std::tuple<size_t, size_t, bytes> const>(
+			_arguments,
+			_returnVariables,
+			std::move(_verbatimData)
+		)}
 	{}
 
 	AssemblyItem(AssemblyItem const&) = default;
@@ -102,8 +110,14 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	/// @returns the data of the item. Returned by value, since values that fit into 64 bits
+	/// are not stored as u256.
+	u256 data() const
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		return m_largeData ? *m_largeData : u256(m_smallData);
+	}
+	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); storeData(_data); }
 
 	bytes const& verbatimData() const { assertThrow(m_type == VerbatimBytecode, util::Exception, ""); return std::get<2>(*m_verbatimBytecode); }
 
@@ -120,7 +134,7 @@ public:
 		else if (type() == VerbatimBytecode)
 			return *m_verbatimBytecode == *_other.m_verbatimBytecode;
 		else
-			return data() == _other.data();
+			return equalData(_other);
 	}
 	bool operator!=(AssemblyItem const& _other) const { return !operator==(_other); }
 	/// Less-than operator compatible with operator==.
@@ -131,9 +145,9 @@ public:
 		else if (type() == Operation)
 			return instruction() < _other.instruction();
 		else if (type() == VerbatimBytecode)
-			return *m_verbatimBytecode == *_other.m_verbatimBytecode;
+			return *m_verbatimBytecode < *_other.m_verbatimBytecode;
 		else
-			return data() < _other.data();
+			return lessData(_other);
 	}
 
 	/// Shortcut that avoids constructing an AssemblyItem just to perform the comparison.
@@ -147,6 +161,15 @@ public:
 		AssemblyItems const& _items,
 		std::map<std::string, unsigned> const& _sourceIndicesMap
 	);
+	/// @returns the source mapping of @a _items in a compact binary form for tooling.
+	/// There is one entry per opcode. Each entry encodes the start offset, the length
+	/// and the source index as signed LEB128 deltas to the previous entry, starting from zero.
+	/// These are followed by one byte for the jump type (0: regular, 1: into function,
+	/// 2: out of function) and the modifier depth as unsigned LEB128.
+	static bytes computeBinarySourceMapping(
+		AssemblyItems const& _items,
+		std::map<std::string, unsigned> const& _sourceIndicesMap
+	);
 
 	/// @returns an upper bound for the number of bytes required by this item, assuming that
 	/// the value of a jump tag takes @a _addressLength bytes.
@@ -180,14 +203,47 @@ public:
 private:
 	size_t opcodeCount() const noexcept;
 
+	/// Stores values that fit into 64 bits inline and larger ones in m_largeData,
+	/// so that each value has exactly one representation.
+	void storeData(u256 const& _data)
+	{
+		if (_data <= std::numeric_limits<uint64_t>::max())
+		{
+			m_smallData = static_cast<uint64_t>(_data);
+			m_largeData.reset();
+		}
+		else
+		{
+			m_smallData = 0;
+			m_largeData = std::make_shared<u256 const>(_data);
+		}
+	}
+	bool equalData(AssemblyItem const& _other) const
+	{
+		if (!m_largeData || !_other.m_largeData)
+			return !m_largeData && !_other.m_largeData && m_smallData == _other.m_smallData;
+		return m_largeData == _other.m_largeData || *m_largeData == *_other.m_largeData;
+	}
+	bool lessData(AssemblyItem const& _other) const
+	{
+		// Values stored in m_largeData are larger than all values stored inline.
+		if (!m_largeData || !_other.m_largeData)
+			return !m_largeData && (_other.m_largeData || m_smallData < _other.m_smallData);
+		return *m_largeData < *_other.m_largeData;
+	}
+
+	// The members are ordered to keep the item small, since items are copied a lot during optimisation.
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
+	JumpType m_jumpType = JumpType::Ordinary;
+	/// The data of the item if it fits into 64 bits. Only valid if m_type != Operation.
+	uint64_t m_smallData = 0;
+	/// The data of the item if it does not fit into 64 bits. Immutable and shared between copies.
+	std::shared_ptr<u256 const> m_largeData;
 	/// If m_type == VerbatimBytecode, this holds number of arguments, number of
-	/// return variables and verbatim bytecode.
-	std::optional<std::tuple<size_t, size_t, bytes>> m_verbatimBytecode;
+	/// return variables and verbatim bytecode. Immutable and shared between copies.
+	std::shared_ptr<std::tuple<size_t, size_t, bytes> const> m_verbatimBytecode;
 	langutil::SourceLocation m_location;
-	JumpType m_jumpType = JumpType::Ordinary;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
 	mutable std::shared_ptr<u256> m_pushedValue;
@@ -211,4 +267,44 @@ inline std::ostream& operator<<(std::ostream& _out, AssemblyItems const& _items)
 	return _out;
 }
 
+/**
+ * Computes the compressed source mapping of a sequence of items one item at a time, so that
+ * code generators writing bytecode directly do not have to create the items.
+ */
+class SourceMappingWriter
+{
+public:
+	explicit SourceMappingWriter(std::map<std::string, unsigned> const& _sourceIndicesMap):
+		m_sourceIndicesMap(_sourceIndicesMap)
+	{}
+
+	/// Appends the entry of an item that consists of @a _opcodeCount opcodes.
+	void append(
+		langutil::SourceLocation const& _location,
+		AssemblyItem::JumpType _jumpType,
+		size_t _modifierDepth,
+		size_t _opcodeCount = 1
+	);
+	void reserve(size_t _items) { m_mapping.reserve(_items * 4); }
+	std::string const& mapping() const { return m_mapping; }
+
+private:
+	struct Entry
+	{
+		int start = -1;
+		int length = -1;
+		int sourceIndex = -1;
+		char jump = 0;
+		int modifierDepth = -1;
+	};
+
+	int sourceIndex(std::string const* _sourceName);
+
+	std::map<std::string, unsigned> const& m_sourceIndicesMap;
+	/// Source indices by the (interned) source names, so that each name is only looked up once.
+	std::unordered_map<std::string const*, int> m_sourceIndexCache;
+	std::string m_mapping;
+	Entry m_previous;
+};
+
 }
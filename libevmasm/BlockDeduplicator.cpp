@@ -27,17 +27,78 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
 #include <functional>
+#include <limits>
 #include <set>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
 
+namespace
+{
+
+size_t hashItem(AssemblyItem const& _item)
+{
+	size_t seed = 0;
+	boost::hash_combine(seed, static_cast<int>(_item.type()));
+	if (_item.type() == Operation)
+		boost::hash_combine(seed, static_cast<uint8_t>(_item.instruction()));
+	else if (_item.type() == VerbatimBytecode)
+		boost::hash_combine(seed, _item.verbatimData().size());
+	else
+		// Only the lowest 64 bits are hashed, the full data is compared on collisions.
+		boost::hash_combine(seed, static_cast<uint64_t>(_item.data() & u256(numeric_limits<uint64_t>::max())));
+	return seed;
+}
+
+/// Replaces the push tags like BlockDeduplicator::applyTagReplacement, but also
+/// records the indices of the items that were replaced in @a _replacedItems, if given.
+bool replaceTags(
+	AssemblyItems& _items,
+	map<u256, u256> const& _replacements,
+	size_t _subId,
+	vector<size_t>* _replacedItems
+)
+{
+	bool changed = false;
+	for (size_t i = 0; i < _items.size(); ++i)
+	{
+		AssemblyItem& item = _items[i];
+		if (item.type() == PushTag)
+		{
+			size_t subId;
+			size_t tagId;
+			tie(subId, tagId) = item.splitForeignPushTag();
+			if (subId != _subId)
+				continue;
+			auto it = _replacements.find(tagId);
+			// Recursively look for the element replaced by tagId
+			for (auto _it = it; _it != _replacements.end(); _it = _replacements.find(_it->second))
+				it = _it;
+
+			if (it != _replacements.end())
+			{
+				changed = true;
+				item.setPushTagSubIdAndTag(subId, static_cast<size_t>(it->second));
+				if (_replacedItems)
+					_replacedItems->push_back(i);
+			}
+		}
+	}
+	return changed;
+}
+
+}
+
 bool BlockDeduplicator::deduplicate()
 {
-	// Compares indices based on the suffix that starts there, ignoring tags and stopping at
+	// Compares blocks based on the suffix that starts at their tag, ignoring tags and stopping at
 	// opcodes that stop the control flow.
 
 	// Virtual tag that signifies "the current block" and which is used to optimise loops.
@@ -49,52 +110,99 @@ bool BlockDeduplicator::deduplicate()
 	)
 		return false;
 
-	function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
+	using diff_type = BlockIterator::difference_type;
+	BlockIterator const end{m_items.end(), m_items.end()};
+	// Calls @a _visitor with the begin of the block starting at the tag at @a _i.
+	// To compare recursive loops, we have to already unify PushTag opcodes of the
+	// block's own tag.
+	auto withBlock = [&](size_t _i, auto&& _visitor)
 	{
-		if (_i == _j)
-			return false;
-
-		// To compare recursive loops, we have to already unify PushTag opcodes of the
-		// block's own tag.
-		AssemblyItem pushFirstTag{pushSelf};
-		AssemblyItem pushSecondTag{pushSelf};
-
-		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
-
-		using diff_type = BlockIterator::difference_type;
-		BlockIterator first{m_items.begin() + diff_type(_i), m_items.end(), &pushFirstTag, &pushSelf};
-		BlockIterator second{m_items.begin() + diff_type(_j), m_items.end(), &pushSecondTag, &pushSelf};
-		BlockIterator end{m_items.end(), m_items.end()};
-
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
-
-		return std::lexicographical_compare(first, end, second, end);
+		AssemblyItem pushOwnTag = m_items.at(_i).pushTag();
+		BlockIterator begin{m_items.begin() + diff_type(_i), m_items.end(), &pushOwnTag, &pushSelf};
+		++begin;
+		return _visitor(begin);
+	};
+	auto hashBlock = [&](size_t _i)
+	{
+		return withBlock(_i, [&](BlockIterator _begin) {
+			size_t seed = 0;
+			for (; _begin != end; ++_begin)
+				boost::hash_combine(seed, hashItem(*_begin));
+			return seed;
+		});
+	};
+	auto equalBlocks = [&](size_t _i, size_t _j)
+	{
+		return withBlock(_i, [&](BlockIterator _first) {
+			return withBlock(_j, [&](BlockIterator _second) {
+				return std::equal(_first, end, _second, end);
+			});
+		});
 	};
 
+	// Blocks by hash, each bucket sorted by position. A block is replaced by the first
+	// block in its bucket that has the same content.
+	unordered_map<size_t, set<size_t>> blocksByHash;
+	map<size_t, size_t> blockHashes;
+	set<size_t> bucketsToUpdate;
+	for (size_t i = 0; i < m_items.size(); ++i)
+		if (m_items[i].type() == Tag)
+		{
+			size_t hash = hashBlock(i);
+			blockHashes[i] = hash;
+			blocksByHash[hash].insert(i);
+			bucketsToUpdate.insert(hash);
+		}
+
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
-		for (size_t i = 0; i < m_items.size(); ++i)
+		for (size_t hash: bucketsToUpdate)
 		{
-			if (m_items.at(i).type() != Tag)
-				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
-			else
-				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
+			set<size_t> const& bucket = blocksByHash[hash];
+			vector<size_t> representatives;
+			for (size_t i: bucket)
+			{
+				auto representative = find_if(representatives.begin(), representatives.end(), [&](size_t _j) {
+					return equalBlocks(_j, i);
+				});
+				if (representative == representatives.end())
+					representatives.push_back(i);
+				else
+					m_replacedTags[m_items.at(i).data()] = m_items.at(*representative).data();
+			}
 		}
+		bucketsToUpdate.clear();
 
-		if (!applyTagReplacement(m_items, m_replacedTags))
+		vector<size_t> replacedItems;
+		if (!replaceTags(m_items, m_replacedTags, size_t(-1), &replacedItems))
 			break;
+
+		// Only the blocks that contain a replaced push tag change their content. These are the blocks
+		// of all tags between the replaced item and the previous item that ends the control flow.
+		set<size_t> changedBlocks;
+		for (size_t replacedItem: replacedItems)
+			for (size_t i = replacedItem; i-- > 0;)
+			{
+				AssemblyItem const& item = m_items[i];
+				if (item.type() == Tag)
+				{
+					if (!changedBlocks.insert(i).second)
+						break;
+				}
+				else if (SemanticInformation::altersControlFlow(item) && item != AssemblyItem{Instruction::JUMPI})
+					break;
+			}
+
+		for (size_t i: changedBlocks)
+		{
+			size_t& hash = blockHashes.at(i);
+			blocksByHash[hash].erase(i);
+			bucketsToUpdate.insert(hash);
+			hash = hashBlock(i);
+			blocksByHash[hash].insert(i);
+			bucketsToUpdate.insert(hash);
+		}
 	}
 	return iterations > 0;
 }
@@ -105,27 +213,7 @@ bool BlockDeduplicator::applyTagReplacement(
 	size_t _subId
 )
 {
-	bool changed = false;
-	for (AssemblyItem& item: _items)
-		if (item.type() == PushTag)
-		{
-			size_t subId;
-			size_t tagId;
-			tie(subId, tagId) = item.splitForeignPushTag();
-			if (subId != _subId)
-				continue;
-			auto it = _replacements.find(tagId);
-			// Recursively look for the element replaced by tagId
-			for (auto _it = it; _it != _replacements.end(); _it = _replacements.find(_it->second))
-				it = _it;
-
-			if (it != _replacements.end())
-			{
-				changed = true;
-				item.setPushTagSubIdAndTag(subId, static_cast<size_t>(it->second));
-			}
-		}
-	return changed;
+	return replaceTags(_items, _replacements, _subId, nullptr);
 }
 
 BlockDeduplicator::BlockIterator& BlockDeduplicator::BlockIterator::operator++()
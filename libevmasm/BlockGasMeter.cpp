@@ -0,0 +1,161 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/** @file BlockGasMeter.cpp
+ * Gas estimation based on the basic blocks of a list of assembly items.
+ */
+
+#include <libevmasm/BlockGasMeter.h>
+#include <libevmasm/KnownState.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+
+BlockGasMeter::BlockGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion)
+{
+	// Blocks start at tags and after items that alter the control flow.
+	vector<pair<size_t, size_t>> blockRanges;
+	map<u256, size_t> tagBlocks;
+	for (size_t i = 0; i < _items.size(); ++i)
+	{
+		if (i == 0 || _items[i].type() == Tag || SemanticInformation::altersControlFlow(_items[i - 1]))
+		{
+			m_blockAtPosition[i] = blockRanges.size();
+			blockRanges.emplace_back(i, i);
+		}
+		blockRanges.back().second = i + 1;
+		if (_items[i].type() == Tag)
+			tagBlocks[_items[i].data()] = blockRanges.size() - 1;
+	}
+
+	auto isJump = [](AssemblyItem const& _item) {
+		return _item == AssemblyItem(Instruction::JUMP) || _item == AssemblyItem(Instruction::JUMPI);
+	};
+	for (auto const& [begin, end]: blockRanges)
+	{
+		Block& block = m_blocks.emplace_back();
+		GasMeter meter(make_shared<KnownState>(), _evmVersion);
+		for (size_t i = begin; i < end; ++i)
+		{
+			block.gas += meter.estimateMax(_items[i]);
+			if (_items[i].type() == PushTag && !(i + 1 < end && isJump(_items[i + 1])))
+				if (auto tagBlock = tagBlocks.find(_items[i].data()); tagBlock != tagBlocks.end())
+					block.pushedTags.push_back(tagBlock->second);
+		}
+
+		AssemblyItem const& lastItem = _items[end - 1];
+		if (isJump(lastItem))
+		{
+			bool const conditional = lastItem == AssemblyItem(Instruction::JUMPI);
+			if (lastItem.getJumpType() == AssemblyItem::JumpType::OutOfFunction)
+				block.exit = Block::Exit::FunctionReturn;
+			else if (end - begin < 2 || _items[end - 2].type() != PushTag)
+				block.exit = Block::Exit::UnknownJump;
+			else
+			{
+				if (auto tagBlock = tagBlocks.find(_items[end - 2].data()); tagBlock != tagBlocks.end())
+					block.target = tagBlock->second;
+				if (conditional)
+					block.exit = Block::Exit::ConditionalJump;
+				else if (lastItem.getJumpType() == AssemblyItem::JumpType::IntoFunction)
+					block.exit = Block::Exit::FunctionCall;
+				else
+					block.exit = Block::Exit::Jump;
+			}
+		}
+		else if (SemanticInformation::altersControlFlow(lastItem))
+			block.exit = Block::Exit::Stop;
+	}
+}
+
+GasMeter::GasConsumption BlockGasMeter::estimateMax(size_t _startIndex)
+{
+	auto block = m_blockAtPosition.find(_startIndex);
+	if (block == m_blockAtPosition.end())
+		return GasMeter::GasConsumption();
+	return longestPath(block->second, {});
+}
+
+GasMeter::GasConsumption BlockGasMeter::longestPath(size_t _block, PendingTags const& _pendingTags)
+{
+	pair<size_t, PendingTags> key{_block, _pendingTags};
+	if (auto longestPath = m_longestPaths.find(key); longestPath != m_longestPaths.end())
+		return longestPath->second;
+	// Reaching a block again with the same pending tags means that there is a loop.
+	if (!m_activePaths.insert(key).second)
+		return GasMeter::GasConsumption::infinite();
+
+	Block const& block = m_blocks.at(_block);
+	GasMeter::GasConsumption gas = block.gas;
+	PendingTags pendingTags = _pendingTags + block.pushedTags;
+	auto jumpTarget = [&]() {
+		// Jumps to tags that do not exist stop the computation.
+		return block.target ? longestPath(*block.target, pendingTags) : GasMeter::GasConsumption();
+	};
+	auto next = [&]() {
+		return _block + 1 < m_blocks.size() ? longestPath(_block + 1, pendingTags) : GasMeter::GasConsumption();
+	};
+	switch (block.exit)
+	{
+	case Block::Exit::Stop:
+	case Block::Exit::FunctionReturn:
+		break;
+	case Block::Exit::Fallthrough:
+		gas += next();
+		break;
+	case Block::Exit::Jump:
+		gas += jumpTarget();
+		break;
+	case Block::Exit::ConditionalJump:
+		gas += max(next(), jumpTarget());
+		break;
+	case Block::Exit::FunctionCall:
+		if (block.target)
+			gas += functionGas(*block.target);
+		// Functions that do not return are called without pushing a return address.
+		if (!gas.isInfinite && !pendingTags.empty())
+		{
+			size_t returnBlock = pendingTags.back();
+			pendingTags.pop_back();
+			gas += longestPath(returnBlock, pendingTags);
+		}
+		break;
+	case Block::Exit::UnknownJump:
+		gas = GasMeter::GasConsumption::infinite();
+		break;
+	}
+
+	m_activePaths.erase(key);
+	m_longestPaths[move(key)] = gas;
+	return gas;
+}
+
+GasMeter::GasConsumption BlockGasMeter::functionGas(size_t _entryBlock)
+{
+	if (auto gas = m_functionGas.find(_entryBlock); gas != m_functionGas.end())
+		return gas->second;
+	// Recursive calls are not bounded.
+	if (!m_activeFunctions.insert(_entryBlock).second)
+		return GasMeter::GasConsumption::infinite();
+	GasMeter::GasConsumption gas = longestPath(_entryBlock, {});
+	m_activeFunctions.erase(_entryBlock);
+	return m_functionGas[_entryBlock] = gas;
+}
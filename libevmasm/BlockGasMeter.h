@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/** @file BlockGasMeter.h
+ * Gas estimation based on the basic blocks of a list of assembly items.
+ */
+
+#pragma once
+
+#include <libevmasm/GasMeter.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::evmasm
+{
+
+/**
+ * Computes an upper bound on the gas usage of a computation starting at a certain position in
+ * a list of AssemblyItems until the computation stops, like PathGasMeter, but without
+ * simulating the state along every path.
+ *
+ * The items are split into basic blocks, whose costs are estimated only once and without
+ * knowledge about the state at their start. The longest path is then searched through the
+ * blocks, where a conditional jump is assumed to go both ways. A jump into a function adds
+ * the cost of the function until it returns, which is computed only once per function, and
+ * continues at the last tag pushed before the call that was not jumped to yet.
+ * Loops, recursion and jumps to tags that are not pushed right before result in an infinite
+ * estimate.
+ */
+class BlockGasMeter
+{
+public:
+	BlockGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
+
+	/// @returns the estimate for the computation starting at @a _startIndex, which is either
+	/// zero or the position of a tag.
+	GasMeter::GasConsumption estimateMax(size_t _startIndex);
+
+	static GasMeter::GasConsumption estimateMax(
+		AssemblyItems const& _items,
+		langutil::EVMVersion _evmVersion,
+		size_t _startIndex
+	)
+	{
+		return BlockGasMeter(_items, _evmVersion).estimateMax(_startIndex);
+	}
+
+private:
+	struct Block
+	{
+		enum class Exit { Stop, Fallthrough, Jump, ConditionalJump, FunctionCall, FunctionReturn, UnknownJump };
+
+		GasMeter::GasConsumption gas;
+		Exit exit = Exit::Fallthrough;
+		/// Block jumped to, if the jump target is pushed right before the jump and exists.
+		std::optional<size_t> target;
+		/// Blocks whose tags are pushed in this block but not jumped to right away,
+		/// which are the candidates for return addresses.
+		std::vector<size_t> pushedTags;
+	};
+	/// Blocks whose tags were pushed, but not used as return addresses yet, in the order
+	/// in which they were pushed.
+	using PendingTags = std::vector<size_t>;
+
+	/// @returns the gas of the longest path starting at the beginning of @a _block that does not
+	/// leave the current function.
+	GasMeter::GasConsumption longestPath(size_t _block, PendingTags const& _pendingTags);
+	/// @returns the gas of the longest path through the function starting at @a _entryBlock.
+	GasMeter::GasConsumption functionGas(size_t _entryBlock);
+
+	std::vector<Block> m_blocks;
+	/// Map from the position of the first item of a block to the block.
+	std::map<size_t, size_t> m_blockAtPosition;
+
+	std::map<std::pair<size_t, PendingTags>, GasMeter::GasConsumption> m_longestPaths;
+	std::set<std::pair<size_t, PendingTags>> m_activePaths;
+	std::map<size_t, GasMeter::GasConsumption> m_functionGas;
+	std::set<size_t> m_activeFunctions;
+};
+
+}
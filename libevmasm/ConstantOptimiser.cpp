@@ -24,6 +24,9 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
 
+#include <libsolutil/FixedU256.h>
+#include <libsolutil/Parallel.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -32,7 +35,8 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
 	langutil::EVMVersion _evmVersion,
-	Assembly& _assembly
+	Assembly& _assembly,
+	size_t _parallelism
 )
 {
 	// TODO: design the optimiser in a way this is not needed
@@ -43,36 +47,62 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	for (AssemblyItem const& item: _items)
 		if (item.type() == Push)
 			pushes[item]++;
-	map<u256, AssemblyItems> pendingReplacements;
-	for (auto it: pushes)
+
+	struct Candidate
 	{
-		AssemblyItem const& item = it.first;
-		if (item.data() < 0x100)
-			continue;
+		u256 value;
 		Params params;
-		params.multiplicity = it.second;
-		params.isCreation = _isCreation;
-		params.runs = _runs;
-		params.evmVersion = _evmVersion;
-		LiteralMethod lit(params, item.data());
+		enum class Method { Literal, CodeCopy, Compute } method = Method::Literal;
+		AssemblyItems computeRoutine;
+	};
+	vector<Candidate> candidates;
+	for (auto const& [item, multiplicity]: pushes)
+		if (item.data() >= 0x100)
+		{
+			Params params;
+			params.multiplicity = multiplicity;
+			params.isCreation = _isCreation;
+			params.runs = _runs;
+			params.evmVersion = _evmVersion;
+			candidates.push_back({item.data(), params});
+		}
+
+	// Only the evaluation of the methods runs in parallel. Data is appended to the assembly
+	// afterwards, in the order of the constants.
+	ComputeMethod::Cache cache;
+	util::parallelFor(candidates.size(), _parallelism, [&](size_t _index) {
+		Candidate& candidate = candidates[_index];
+		LiteralMethod lit(candidate.params, candidate.value);
 		bigint literalGas = lit.gasNeeded();
-		CodeCopyMethod copy(params, item.data());
+		CodeCopyMethod copy(candidate.params, candidate.value);
 		bigint copyGas = copy.gasNeeded();
-		ComputeMethod compute(params, item.data());
+		ComputeMethod compute(candidate.params, candidate.value, &cache);
 		bigint computeGas = compute.gasNeeded();
-		AssemblyItems replacement;
 		if (copyGas < literalGas && copyGas < computeGas)
+			candidate.method = Candidate::Method::CodeCopy;
+		else if (computeGas < literalGas && computeGas <= copyGas)
 		{
-			replacement = copy.execute(_assembly);
+			candidate.method = Candidate::Method::Compute;
+			candidate.computeRoutine = compute.execute(_assembly);
+		}
+	});
+
+	map<u256, AssemblyItems> pendingReplacements;
+	for (Candidate& candidate: candidates)
+	{
+		AssemblyItems replacement;
+		if (candidate.method == Candidate::Method::CodeCopy)
+		{
+			replacement = CodeCopyMethod(candidate.params, candidate.value).execute(_assembly);
 			optimisations++;
 		}
-		else if (computeGas < literalGas && computeGas <= copyGas)
+		else if (candidate.method == Candidate::Method::Compute)
 		{
-			replacement = compute.execute(_assembly);
+			replacement = move(candidate.computeRoutine);
 			optimisations++;
 		}
 		if (!replacement.empty())
-			pendingReplacements[item.data()] = replacement;
+			pendingReplacements[candidate.value] = replacement;
 	}
 	if (!pendingReplacements.empty())
 		replaceConstants(_items, pendingReplacements);
@@ -197,6 +227,19 @@ AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 		return findRepresentation(~_value) + AssemblyItems{Instruction::NOT};
 	else
 	{
+		auto cacheKey = make_pair(m_params.multiplicity, _value);
+		if (m_cache)
+		{
+			lock_guard<mutex> lock(m_cache->mutex);
+			auto it = m_cache->entries.find(cacheKey);
+			if (it != m_cache->entries.end() && m_maxSteps > it->second.steps)
+			{
+				m_maxSteps -= it->second.steps;
+				return it->second.routine;
+			}
+		}
+		size_t const stepsBefore = m_maxSteps;
+
 		// Decompose value into a * 2**k + b where abs(b) << 2**k
 		// Is not always better, try literal and decomposition method.
 		AssemblyItems routine{u256(_value)};
@@ -248,6 +291,12 @@ AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 				routine = move(newRoutine);
 			}
 		}
+		// If the search ran out of steps, its result depends on the steps that were left.
+		if (m_cache && m_maxSteps > 0)
+		{
+			lock_guard<mutex> lock(m_cache->mutex);
+			m_cache->entries.emplace(cacheKey, Cache::Entry{routine, stepsBefore - m_maxSteps});
+		}
 		return routine;
 	}
 }
@@ -273,7 +322,7 @@ bool ComputeMethod::checkRepresentation(u256 const& _value, AssemblyItems const&
 			case Instruction::EXP:
 				if (sp[-1] > 0xff)
 					return false;
-				sp[-1] = boost::multiprecision::pow(sp[0], unsigned(sp[-1]));
+				sp[-1] = u256(exp(FixedU256(sp[0]), FixedU256(sp[-1])));
 				break;
 			case Instruction::ADD:
 				sp[-1] = sp[0] + sp[-1];
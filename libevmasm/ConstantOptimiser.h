@@ -28,6 +28,9 @@
 
 #include <libsolutil/Assertions.h>
 
+#include <map>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace solidity::evmasm
@@ -45,12 +48,15 @@ class ConstantOptimisationMethod
 public:
 	/// Tries to optimised how constants are represented in the source code and modifies
 	/// @a _assembly.
+	/// The methods for the different constants are evaluated using up to @a _parallelism threads.
+	/// The result does not depend on the number of threads.
 	/// @returns zero if no optimisations could be performed.
 	static unsigned optimiseConstants(
 		bool _isCreation,
 		size_t _runs,
 		langutil::EVMVersion _evmVersion,
-		Assembly& _assembly
+		Assembly& _assembly,
+		size_t _parallelism = 1
 	);
 
 protected:
@@ -94,7 +100,7 @@ protected:
 	static void replaceConstants(AssemblyItems& _items, std::map<u256, AssemblyItems> const& _replacements);
 
 	Params m_params;
-	u256 const& m_value;
+	u256 const m_value;
 };
 
 /**
@@ -131,8 +137,24 @@ protected:
 class ComputeMethod: public ConstantOptimisationMethod
 {
 public:
-	explicit ComputeMethod(Params const& _params, u256 const& _value):
-		ConstantOptimisationMethod(_params, _value)
+	/// Representations found for values, shared between the constants of an assembly.
+	/// Since the gas estimate depends on the multiplicity of the constant, the representations
+	/// are keyed by multiplicity and value.
+	struct Cache
+	{
+		struct Entry
+		{
+			AssemblyItems routine;
+			/// Number of steps the search for the routine took.
+			size_t steps;
+		};
+		std::mutex mutex;
+		std::map<std::pair<size_t, u256>, Entry> entries;
+	};
+
+	explicit ComputeMethod(Params const& _params, u256 const& _value, Cache* _cache = nullptr):
+		ConstantOptimisationMethod(_params, _value),
+		m_cache(_cache)
 	{
 		m_routine = findRepresentation(m_value);
 		assertThrow(
@@ -150,6 +172,9 @@ public:
 
 protected:
 	/// Tries to recursively find a way to compute @a _value.
+	/// Uses and fills m_cache, if set. A cached routine is only used if the search for it
+	/// did not run out of steps and enough steps are left, so that it is the same routine
+	/// the search would find again.
 	AssemblyItems findRepresentation(u256 const& _value);
 	/// Recomputes the value from the calculated representation and checks for correctness.
 	bool checkRepresentation(u256 const& _value, AssemblyItems const& _routine) const;
@@ -158,6 +183,7 @@ protected:
 	/// Counter for the complexity of optimization, will stop when it reaches zero.
 	size_t m_maxSteps = 10000;
 	AssemblyItems m_routine;
+	Cache* m_cache = nullptr;
 };
 
 }
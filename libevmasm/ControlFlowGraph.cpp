@@ -222,22 +222,39 @@ void ControlFlowGraph::gatherKnowledge()
 	KnownStatePointer emptyState = make_shared<KnownState>();
 	bool unknownJumpEncountered = false;
 
+	/// Blocks on the path that led to a work queue item. The paths of items continuing the same
+	/// path share their common part, so that enqueuing an item does not copy the path.
+	struct PathNode
+	{
+		BlockId blockId;
+		shared_ptr<PathNode const> previous;
+	};
 	struct WorkQueueItem {
 		BlockId blockId;
 		KnownStatePointer state;
-		set<BlockId> blocksSeen;
+		shared_ptr<PathNode const> blocksSeen;
+	};
+	auto seen = [](WorkQueueItem const& _item, BlockId _blockId) {
+		for (PathNode const* node = _item.blocksSeen.get(); node; node = node->previous.get())
+			if (node->blockId == _blockId)
+				return true;
+		return false;
 	};
 
-	vector<WorkQueueItem> workQueue{WorkQueueItem{BlockId::initial(), emptyState->copy(), set<BlockId>()}};
+	vector<WorkQueueItem> workQueue{WorkQueueItem{BlockId::initial(), emptyState->copy(), nullptr}};
 	auto addWorkQueueItem = [&](WorkQueueItem const& _currentItem, BlockId _to, KnownStatePointer const& _state)
 	{
 		WorkQueueItem item;
 		item.blockId = _to;
 		item.state = _state->copy();
-		item.blocksSeen = _currentItem.blocksSeen;
-		item.blocksSeen.insert(_currentItem.blockId);
+		item.blocksSeen = make_shared<PathNode const>(PathNode{_currentItem.blockId, _currentItem.blocksSeen});
 		workQueue.push_back(move(item));
 	};
+	// Number of times each block was analysed. Once this reaches the limit, the knowledge at the
+	// start of the block is discarded when it is reached again, as for m_joinKnowledge == false,
+	// which bounds the work per block on code with many paths into the same block.
+	map<BlockId, size_t> analysisCount;
+	size_t const maxAnalysesPerBlock = 16;
 
 	while (!workQueue.empty())
 	{
@@ -253,14 +270,15 @@ void ControlFlowGraph::gatherKnowledge()
 		{
 			// We call reduceToCommonKnowledge even in the non-join setting to get the correct
 			// sequence number
-			if (!m_joinKnowledge)
+			if (!m_joinKnowledge || analysisCount[item.blockId] >= maxAnalysesPerBlock)
 				state->reset();
-			state->reduceToCommonKnowledge(*block.startState, !item.blocksSeen.count(item.blockId));
+			state->reduceToCommonKnowledge(*block.startState, !seen(item, item.blockId));
 			if (*state == *block.startState)
 				continue;
 		}
 
 		block.startState = state->copy();
+		++analysisCount[item.blockId];
 
 		// Feed all items except for the final jump yet because it will erase the target tag.
 		unsigned pc = block.begin;
@@ -289,7 +307,7 @@ void ControlFlowGraph::gatherKnowledge()
 					unknownJumpEncountered = true;
 					for (auto const& it: m_blocks)
 						if (it.second.begin < it.second.end && m_items[it.second.begin].type() == Tag)
-							workQueue.push_back(WorkQueueItem{it.first, emptyState->copy(), set<BlockId>()});
+							workQueue.push_back(WorkQueueItem{it.first, emptyState->copy(), nullptr});
 				}
 			}
 			else
@@ -27,6 +27,8 @@
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/SimplificationRules.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <functional>
 #include <tuple>
 #include <limits>
@@ -51,8 +53,42 @@ bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression cons
 			std::tie(otherInstr, _other.arguments, _other.sequenceNumber);
 	}
 	else
-		return std::tie(item->data(), arguments, sequenceNumber) <
-			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
+	{
+		u256 data = item->data();
+		u256 otherData = _other.item->data();
+		return std::tie(data, arguments, sequenceNumber) <
+			std::tie(otherData, _other.arguments, _other.sequenceNumber);
+	}
+}
+
+bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression const& _other) const
+{
+	assertThrow(!!item && !!_other.item, OptimizerException, "");
+	if (
+		hash != _other.hash ||
+		item->type() != _other.item->type() ||
+		sequenceNumber != _other.sequenceNumber ||
+		arguments != _other.arguments
+	)
+		return false;
+	else if (item->type() == Operation)
+		return item->instruction() == _other.item->instruction();
+	else
+		return item->data() == _other.item->data();
+}
+
+size_t ExpressionClasses::hashExpression(Expression const& _expr)
+{
+	assertThrow(!!_expr.item, OptimizerException, "");
+	size_t seed = 0;
+	boost::hash_combine(seed, static_cast<int>(_expr.item->type()));
+	if (_expr.item->type() == Operation)
+		boost::hash_combine(seed, static_cast<uint8_t>(_expr.item->instruction()));
+	else
+		boost::hash_combine(seed, static_cast<uint64_t>(_expr.item->data() & numeric_limits<uint64_t>::max()));
+	boost::hash_range(seed, _expr.arguments.begin(), _expr.arguments.end());
+	boost::hash_combine(seed, _expr.sequenceNumber);
+	return seed;
 }
 
 ExpressionClasses::Id ExpressionClasses::find(
@@ -70,6 +106,7 @@ ExpressionClasses::Id ExpressionClasses::find(
 
 	if (SemanticInformation::isCommutativeOperation(_item))
 		sort(exp.arguments.begin(), exp.arguments.end());
+	exp.hash = hashExpression(exp);
 
 	if (SemanticInformation::isDeterministic(_item))
 	{
@@ -107,6 +144,7 @@ void ExpressionClasses::forceEqual(
 
 	if (SemanticInformation::isCommutativeOperation(_item))
 		sort(exp.arguments.begin(), exp.arguments.end());
+	exp.hash = hashExpression(exp);
 
 	if (_copyItem)
 		exp.item = storeItem(_item);
@@ -119,6 +157,7 @@ ExpressionClasses::Id ExpressionClasses::newClass(SourceLocation const& _locatio
 	Expression exp;
 	exp.id = static_cast<Id>(m_representatives.size());
 	exp.item = storeItem(AssemblyItem(UndefinedItem, (u256(1) << 255) + exp.id, _location));
+	exp.hash = hashExpression(exp);
 	m_representatives.push_back(exp);
 	m_expressions.insert(exp);
 	return exp.id;
@@ -150,12 +189,10 @@ bool ExpressionClasses::knownNonZero(Id _c)
 
 u256 const* ExpressionClasses::knownConstant(Id _c)
 {
-	map<unsigned, Expression const*> matchGroups;
-	Pattern constant(Push);
-	constant.setMatchGroup(1, matchGroups);
-	if (!constant.matches(representative(_c), *this))
+	Expression const& expr = representative(_c);
+	if (!expr.item || expr.item->type() != Push)
 		return nullptr;
-	return &constant.d();
+	return &m_knownConstants.try_emplace(_c, expr.item->data()).first->second;
 }
 
 AssemblyItem const* ExpressionClasses::storeItem(AssemblyItem const& _item)
@@ -183,7 +220,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules store the current match groups, so every thread needs its own copy.
+	thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
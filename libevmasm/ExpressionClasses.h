@@ -31,6 +31,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_set>
 
 namespace solidity::langutil
 {
@@ -60,8 +61,17 @@ public:
 		Ids arguments;
 		/// Storage modification sequence, only used for storage and memory operations.
 		unsigned sequenceNumber = 0;
+		/// Hash of (item->type(), item->data(), arguments, sequenceNumber), computed once before
+		/// the expression is looked up or stored.
+		size_t hash = 0;
 		/// Behaves as if this was a tuple of (item->type(), item->data(), arguments, sequenceNumber).
 		bool operator<(Expression const& _other) const;
+		/// Equality with the same semantics as operator<, comparing the precomputed hashes first.
+		bool operator==(Expression const& _other) const;
+	};
+	struct ExpressionHash
+	{
+		size_t operator()(Expression const& _expr) const { return _expr.hash; }
 	};
 
 	/// Retrieves the id of the expression equivalence class resulting from the given item applied to the
@@ -100,7 +110,7 @@ public:
 	/// @note that this is not the negation of knownZero
 	bool knownNonZero(Id _c);
 	/// @returns a pointer to the value if the given class is known to be a constant,
-	/// and a nullptr otherwise.
+	/// and a nullptr otherwise. The pointer is valid for the lifetime of the ExpressionClasses object.
 	u256 const* knownConstant(Id _c);
 
 	/// Stores a copy of the given AssemblyItem and returns a pointer to the copy that is valid for
@@ -110,6 +120,9 @@ public:
 	std::string fullDAGToString(Id _id) const;
 
 private:
+	/// @returns the hash of the given expression, to be stored in Expression::hash.
+	static size_t hashExpression(Expression const& _expr);
+
 	/// Tries to simplify the given expression.
 	/// @returns its class if it possible or Id(-1) otherwise.
 	Id tryToSimplify(Expression const& _expr);
@@ -122,7 +135,9 @@ private:
 	/// Expression equivalence class representatives - we only store one item of an equivalence.
 	std::vector<Expression> m_representatives;
 	/// All expression ever encountered.
-	std::set<Expression> m_expressions;
+	std::unordered_set<Expression, ExpressionHash> m_expressions;
+	/// Values of the classes queried through knownConstant, stored at stable addresses.
+	std::map<Id, u256> m_knownConstants;
 	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
 };
 
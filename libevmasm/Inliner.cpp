@@ -99,17 +99,66 @@ bool Inliner::isInlineCandidate(size_t _tag, ranges::span<AssemblyItem const> _i
 	return true;
 }
 
-map<size_t, Inliner::InlinableBlock> Inliner::determineInlinableBlocks(AssemblyItems const& _items) const
+vector<uint64_t> Inliner::executionCounts(AssemblyItems const& _items) const
+{
+	vector<uint64_t> counts(_items.size(), 1);
+	if (!m_callSiteCostModel)
+		return counts;
+
+	map<size_t, size_t> tagPositions;
+	for (auto&& [index, item]: _items | ranges::views::enumerate)
+		if (item.type() == Tag)
+			if (optional<size_t> tag = getLocalTag(item))
+				tagPositions[*tag] = index;
+
+	// Number of loops starting at and ending before each item.
+	vector<size_t> loopStarts(_items.size() + 1, 0);
+	vector<size_t> loopEnds(_items.size() + 1, 0);
+	for (size_t index = 0; index + 1 < _items.size(); ++index)
+	{
+		AssemblyItem const& jump = _items[index + 1];
+		if (
+			_items[index].type() != PushTag ||
+			(jump != Instruction::JUMP && jump != Instruction::JUMPI) ||
+			jump.getJumpType() != AssemblyItem::JumpType::Ordinary
+		)
+			continue;
+		if (optional<size_t> tag = getLocalTag(_items[index]))
+			if (size_t const* position = util::valueOrNullptr(tagPositions, *tag); position && *position < index)
+			{
+				++loopStarts[*position];
+				++loopEnds[index + 2];
+			}
+	}
+
+	size_t depth = 0;
+	for (size_t index = 0; index < _items.size(); ++index)
+	{
+		depth = depth + loopStarts[index] - loopEnds[index];
+		for (size_t i = 0; i < min(depth, maxLoopDepth); ++i)
+			counts[index] *= loopIterations;
+	}
+	return counts;
+}
+
+map<size_t, Inliner::InlinableBlock> Inliner::determineInlinableBlocks(
+	AssemblyItems const& _items,
+	vector<uint64_t> const& _executionCounts
+) const
 {
 	std::map<size_t, ranges::span<AssemblyItem const>> inlinableBlockItems;
 	std::map<size_t, uint64_t> numPushTags;
+	std::map<size_t, uint64_t> numCalls;
 	std::optional<size_t> lastTag;
 	for (auto&& [index, item]: _items | ranges::views::enumerate)
 	{
 		// The number of PushTags approximates the number of calls to a block.
 		if (item.type() == PushTag)
 			if (optional<size_t> tag = getLocalTag(item))
+			{
 				++numPushTags[*tag];
+				numCalls[*tag] += _executionCounts[index];
+			}
 
 		// We can only inline blocks with straight control flow that end in a jump.
 		// Using breaksCSEAnalysisBlock will hopefully allow the return jump to be optimized after inlining.
@@ -133,17 +182,23 @@ map<size_t, Inliner::InlinableBlock> Inliner::determineInlinableBlocks(AssemblyI
 	map<size_t, InlinableBlock> result;
 	for (auto&& [tag, items]: inlinableBlockItems)
 		if (uint64_t const* numPushes = util::valueOrNullptr(numPushTags, tag))
-			result.emplace(tag, InlinableBlock{items, *numPushes});
+			result.emplace(tag, InlinableBlock{items, *numPushes, numCalls.at(tag)});
 	return result;
 }
 
-bool Inliner::shouldInlineFullFunctionBody(size_t _tag, ranges::span<AssemblyItem const> _block, uint64_t _pushTagCount) const
+bool Inliner::shouldInlineFullFunctionBody(
+	size_t _tag,
+	ranges::span<AssemblyItem const> _block,
+	uint64_t _pushTagCount,
+	uint64_t _callCount
+) const
 {
 	// Accumulate size of the inline candidate block in bytes (without the return jump).
 	uint64_t functionBodySize = codeSize(ranges::views::drop_last(_block, 1));
 
-	// Use the number of push tags as approximation of the average number of calls to the function per run.
-	uint64_t numberOfCalls = _pushTagCount;
+	// Use the number of push tags or, with the call site cost model, the number of push tags weighted
+	// by the loops around them as approximation of the average number of calls to the function per run.
+	uint64_t numberOfCalls = _callCount;
 	// Also use the number of push tags as approximation of the number of call sites to the function.
 	uint64_t numberOfCallSites = _pushTagCount;
 
@@ -166,6 +221,22 @@ bool Inliner::shouldInlineFullFunctionBody(size_t _tag, ranges::span<AssemblyIte
 		executionCost(uninlinedCallSitePattern, m_evmVersion) +
 		executionCost(uninlinedFunctionPattern, m_evmVersion)
 	);
+	if (m_callSiteCostModel)
+	{
+		// Once inlined, the return address is a known tag, so that the swaps moving it to the top
+		// of the stack right before the return jump can be removed by the common subexpression eliminator.
+		size_t shuffleStart = _block.size() - 1;
+		while (
+			shuffleStart > 0 &&
+			_block[shuffleStart - 1].type() == Operation &&
+			isSwapInstruction(_block[shuffleStart - 1].instruction())
+		)
+			--shuffleStart;
+		uninlinedExecutionCost += numberOfCalls * executionCost(
+			_block | ranges::views::slice(shuffleStart, _block.size() - 1),
+			m_evmVersion
+		);
+	}
 	// Each call site deposits the call site pattern, whereas the jump site pattern and the function itself are deposited once.
 	bigint uninlinedDepositCost = GasMeter::dataGas(
 		numberOfCallSites * codeSize(uninlinedCallSitePattern) +
@@ -208,7 +279,7 @@ optional<AssemblyItem> Inliner::shouldInline(size_t _tag, AssemblyItem const& _j
 		_jump.getJumpType() == AssemblyItem::JumpType::IntoFunction &&
 		blockExit == Instruction::JUMP &&
 		blockExit.getJumpType() == AssemblyItem::JumpType::OutOfFunction &&
-		shouldInlineFullFunctionBody(_tag, _block.items, _block.pushTagCount)
+		shouldInlineFullFunctionBody(_tag, _block.items, _block.pushTagCount, _block.callCount)
 	)
 	{
 		blockExit.setJumpType(AssemblyItem::JumpType::Ordinary);
@@ -238,39 +309,56 @@ optional<AssemblyItem> Inliner::shouldInline(size_t _tag, AssemblyItem const& _j
 
 void Inliner::optimise()
 {
-	std::map<size_t, InlinableBlock> inlinableBlocks = determineInlinableBlocks(m_items);
+	vector<uint64_t> counts = executionCounts(m_items);
+	std::map<size_t, InlinableBlock> inlinableBlocks = determineInlinableBlocks(m_items, counts);
 
 	if (inlinableBlocks.empty())
 		return;
 
+	uint64_t currentCodeSize = m_callSiteCostModel ? codeSize(m_items) : 0;
 	AssemblyItems newItems;
-	for (auto it = m_items.begin(); it != m_items.end(); ++it)
+	for (size_t index = 0; index < m_items.size(); ++index)
 	{
-		AssemblyItem const& item = *it;
-		if (next(it) != m_items.end())
+		AssemblyItem const& item = m_items[index];
+		if (index + 1 < m_items.size())
 		{
-			AssemblyItem const& nextItem = *next(it);
+			AssemblyItem const& nextItem = m_items[index + 1];
 			if (item.type() == PushTag && nextItem == Instruction::JUMP)
 			{
 				if (optional<size_t> tag = getLocalTag(item))
 					if (auto* inlinableBlock = util::valueOrNullptr(inlinableBlocks, *tag))
 						if (auto exitItem = shouldInline(*tag, nextItem, *inlinableBlock))
 						{
-							newItems += inlinableBlock->items | ranges::views::drop_last(1);
-							newItems.emplace_back(move(*exitItem));
-
-							// We are removing one push tag to the block we inline.
-							--inlinableBlock->pushTagCount;
-							// We might increase the number of push tags to other blocks.
-							for (AssemblyItem const& inlinedItem: inlinableBlock->items)
-								if (inlinedItem.type() == PushTag)
-									if (optional<size_t> duplicatedTag = getLocalTag(inlinedItem))
-										if (auto* block = util::valueOrNullptr(inlinableBlocks, *duplicatedTag))
-											++block->pushTagCount;
-
-							// Skip the original jump to the inlined tag and continue.
-							++it;
-							continue;
+							uint64_t inlinedSize = codeSize(inlinableBlock->items);
+							uint64_t replacedSize = codeSize(m_items | ranges::views::slice(index, index + 2));
+							bool exceedsSizeLimit =
+								m_callSiteCostModel &&
+								inlinedSize > replacedSize &&
+								currentCodeSize + inlinedSize - replacedSize > maxCodeSize;
+							if (!exceedsSizeLimit)
+							{
+								if (m_callSiteCostModel)
+									currentCodeSize = currentCodeSize + inlinedSize - replacedSize;
+								newItems += inlinableBlock->items | ranges::views::drop_last(1);
+								newItems.emplace_back(move(*exitItem));
+
+								// We are removing one push tag to the block we inline.
+								--inlinableBlock->pushTagCount;
+								inlinableBlock->callCount -= min(inlinableBlock->callCount, counts[index]);
+								// We might increase the number of push tags to other blocks.
+								for (AssemblyItem const& inlinedItem: inlinableBlock->items)
+									if (inlinedItem.type() == PushTag)
+										if (optional<size_t> duplicatedTag = getLocalTag(inlinedItem))
+											if (auto* block = util::valueOrNullptr(inlinableBlocks, *duplicatedTag))
+											{
+												++block->pushTagCount;
+												block->callCount += counts[index];
+											}
+
+								// Skip the original jump to the inlined tag and continue.
+								++index;
+								continue;
+							}
 						}
 			}
 		}
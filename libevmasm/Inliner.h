@@ -34,6 +34,16 @@
 namespace solidity::evmasm
 {
 
+/**
+ * Inlines the blocks jumped to from a PushTag followed by a JUMP, if this is cheaper over the
+ * number of runs of the code.
+ *
+ * By default, the number of calls of a function per run is approximated by the number of times
+ * its tag is pushed. With @a _callSiteCostModel, every call site instead counts as many calls
+ * as the loops around it are expected to iterate, the stack shuffling that moves the return
+ * address to the top before the return jump counts towards the cost of a call, and functions
+ * are no longer inlined once the code would grow beyond the size limit for deployed contracts.
+ */
 class Inliner
 {
 public:
@@ -42,15 +52,24 @@ public:
 		std::set<size_t> const& _tagsReferencedFromOutside,
 		size_t _runs,
 		bool _isCreation,
-		langutil::EVMVersion _evmVersion
+		langutil::EVMVersion _evmVersion,
+		bool _callSiteCostModel = false
 	):
 	m_items(_items),
 	m_tagsReferencedFromOutside(_tagsReferencedFromOutside),
 	m_runs(_runs),
 	m_isCreation(_isCreation),
-	m_evmVersion(_evmVersion)
+	m_evmVersion(_evmVersion),
+	m_callSiteCostModel(_callSiteCostModel)
 	{
 	}
+
+	/// Number of iterations assumed for every loop by the call site cost model.
+	static uint64_t constexpr loopIterations = 10;
+	/// Maximum loop nesting depth taken into account by the call site cost model.
+	static size_t constexpr maxLoopDepth = 3;
+	/// Code size in bytes beyond which the call site cost model does not inline functions.
+	static uint64_t constexpr maxCodeSize = 0x6000;
 	virtual ~Inliner() = default;
 
 	void optimise();
@@ -60,6 +79,9 @@ private:
 	{
 		ranges::span<AssemblyItem const> items;
 		uint64_t pushTagCount = 0;
+		/// Estimated number of calls per run, which is the number of PushTags unless the call
+		/// site cost model is used.
+		uint64_t callCount = 0;
 	};
 
 	/// @returns the exit item for the block to be inlined, if a particular jump to it should be inlined, otherwise nullopt.
@@ -67,18 +89,33 @@ private:
 	/// @returns true, if the full function at tag @a _tag with body @a _block that is referenced @a _pushTagCount times
 	/// should be inlined, false otherwise. @a _block should start at the first instruction after the function entry tag
 	/// up to and including the return jump.
-	bool shouldInlineFullFunctionBody(size_t _tag, ranges::span<AssemblyItem const> _block, uint64_t _pushTagCount) const;
+	/// @a _callCount is the estimated number of calls to the function per run.
+	bool shouldInlineFullFunctionBody(
+		size_t _tag,
+		ranges::span<AssemblyItem const> _block,
+		uint64_t _pushTagCount,
+		uint64_t _callCount
+	) const;
 	/// @returns true, if the @a _items at @a _tag are a potential candidate for inlining.
 	bool isInlineCandidate(size_t _tag, ranges::span<AssemblyItem const> _items) const;
 	/// @returns a map from tags that can potentially be inlined to the inlinable item range behind that tag and the
 	/// number of times the tag in question was referenced.
-	std::map<size_t, InlinableBlock> determineInlinableBlocks(AssemblyItems const& _items) const;
+	/// @a _executionCounts are the estimated numbers of executions of the items, see executionCounts.
+	std::map<size_t, InlinableBlock> determineInlinableBlocks(
+		AssemblyItems const& _items,
+		std::vector<uint64_t> const& _executionCounts
+	) const;
+	/// @returns the estimated number of executions per run of each item of @a _items, which is one
+	/// unless the call site cost model is used. Then, it is multiplied by loopIterations for each
+	/// loop containing the item, where loops are ordinary jumps to tags that precede the jump.
+	std::vector<uint64_t> executionCounts(AssemblyItems const& _items) const;
 
 	AssemblyItems& m_items;
 	std::set<size_t> const& m_tagsReferencedFromOutside;
 	size_t const m_runs = Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment;
 	bool const m_isCreation = false;
 	langutil::EVMVersion const m_evmVersion;
+	bool const m_callSiteCostModel = false;
 };
 
 }
@@ -24,6 +24,7 @@
 
 #include <libsolutil/Common.h>
 #include <libsolutil/CommonIO.h>
+#include <array>
 #include <functional>
 
 using namespace std;
@@ -178,7 +179,22 @@ std::map<std::string, Instruction> const solidity::evmasm::c_instructions =
 	{ "SELFDESTRUCT", Instruction::SELFDESTRUCT }
 };
 
-static std::map<Instruction, InstructionInfo> const c_instructionInfo =
+namespace
+{
+
+/// Compile-time counterpart of InstructionInfo, so that the table below ends up in read-only,
+/// shareable memory instead of being built on the heap at startup.
+struct StaticInstructionInfo
+{
+	char const* name = nullptr;
+	int additional = 0;
+	int args = 0;
+	int ret = 0;
+	bool sideEffects = false;
+	Tier gasPriceTier = Tier::Invalid;
+};
+
+constexpr std::pair<Instruction, StaticInstructionInfo> c_instructionInfoList[] =
 { //												Add, Args, Ret, SideEffects, GasPriceTier
 	{ Instruction::STOP,		{ "STOP",			0, 0, 0, true,  Tier::Zero } },
 	{ Instruction::ADD,			{ "ADD",			0, 2, 1, false, Tier::VeryLow } },
@@ -325,6 +341,16 @@ static std::map<Instruction, InstructionInfo> const c_instructionInfo =
 	{ Instruction::SELFDESTRUCT,	{ "SELFDESTRUCT",		0, 1, 0, true, Tier::Special } }
 };
 
+/// Information on the instructions indexed by opcode. Entries without a name are invalid instructions.
+constexpr std::array<StaticInstructionInfo, 256> c_instructionInfo = []() {
+	std::array<StaticInstructionInfo, 256> table{};
+	for (auto const& entry: c_instructionInfoList)
+		table[static_cast<uint8_t>(entry.first)] = entry.second;
+	return table;
+}();
+
+}
+
 void solidity::evmasm::eachInstruction(
 	bytes const& _mem,
 	function<void(Instruction,u256 const&)> const& _onInstruction
@@ -362,7 +388,7 @@ string solidity::evmasm::disassemble(bytes const& _mem, string const& _delimiter
 			ret << "0x" << std::uppercase << std::hex << static_cast<int>(_instr) << _delimiter;
 		else
 		{
-			InstructionInfo info = instructionInfo(_instr);
+			InstructionInfo const& info = instructionInfo(_instr);
 			ret << info.name;
 			if (info.additional)
 				ret << " 0x" << std::uppercase << std::hex << _data;
@@ -372,19 +398,26 @@ string solidity::evmasm::disassemble(bytes const& _mem, string const& _delimiter
 	return ret.str();
 }
 
-InstructionInfo solidity::evmasm::instructionInfo(Instruction _inst)
+InstructionInfo const& solidity::evmasm::instructionInfo(Instruction _inst)
 {
-	try
-	{
-		return c_instructionInfo.at(_inst);
-	}
-	catch (...)
-	{
-		return InstructionInfo({"<INVALID_INSTRUCTION: " + toString((unsigned)_inst) + ">", 0, 0, 0, false, Tier::Invalid});
-	}
+	// Built once from the compile-time table, so that the queries in the optimisers do not
+	// copy the names.
+	static array<InstructionInfo, 256> const infos = []() {
+		array<InstructionInfo, 256> result;
+		for (size_t i = 0; i < result.size(); ++i)
+		{
+			StaticInstructionInfo const& info = c_instructionInfo[i];
+			if (info.name)
+				result[i] = {info.name, info.additional, info.args, info.ret, info.sideEffects, info.gasPriceTier};
+			else
+				result[i] = {"<INVALID_INSTRUCTION: " + toString(i) + ">", 0, 0, 0, false, Tier::Invalid};
+		}
+		return result;
+	}();
+	return infos[static_cast<uint8_t>(_inst)];
 }
 
 bool solidity::evmasm::isValidInstruction(Instruction _inst)
 {
-	return !!c_instructionInfo.count(_inst);
+	return c_instructionInfo[static_cast<uint8_t>(_inst)].name != nullptr;
 }
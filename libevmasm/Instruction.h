@@ -293,7 +293,7 @@ struct InstructionInfo
 };
 
 /// Information on all the instructions.
-InstructionInfo instructionInfo(Instruction _inst);
+InstructionInfo const& instructionInfo(Instruction _inst);
 
 /// check whether instructions exists.
 bool isValidInstruction(Instruction _inst);
@@ -24,6 +24,7 @@
 
 #include <libevmasm/AssemblyItem.h>
 
+#include <functional>
 #include <limits>
 
 using namespace std;
@@ -33,8 +34,45 @@ using namespace solidity::evmasm;
 
 bool JumpdestRemover::optimise(set<size_t> const& _tagsReferencedFromOutside)
 {
-	set<size_t> references{referencedTags(m_items, numeric_limits<size_t>::max())};
-	references.insert(_tagsReferencedFromOutside.begin(), _tagsReferencedFromOutside.end());
+	size_t maxTag = 0;
+	bool hasTags = false;
+	for (AssemblyItem const& item: m_items)
+		if (item.type() == Tag)
+		{
+			auto asmIdAndTag = item.splitForeignPushTag();
+			assertThrow(asmIdAndTag.first == numeric_limits<size_t>::max(), OptimizerException, "Sub-assembly tag used as label.");
+			maxTag = max(maxTag, asmIdAndTag.second);
+			hasTags = true;
+		}
+	if (!hasTags)
+		return false;
+
+	// Tags are numbered consecutively, so the references are usually recorded in a bit vector
+	// indexed by tag. Sparse tags, which can only come from imported assemblies, use a set.
+	function<bool(size_t)> isReferenced;
+	vector<bool> referencedTagBits;
+	set<size_t> sparseReferencedTags;
+	if (maxTag <= 4 * m_items.size())
+	{
+		referencedTagBits.resize(maxTag + 1);
+		for (AssemblyItem const& item: m_items)
+			if (item.type() == PushTag)
+			{
+				auto [subId, tag] = item.splitForeignPushTag();
+				if (subId == numeric_limits<size_t>::max() && tag <= maxTag)
+					referencedTagBits[tag] = true;
+			}
+		for (size_t tag: _tagsReferencedFromOutside)
+			if (tag <= maxTag)
+				referencedTagBits[tag] = true;
+		isReferenced = [&](size_t _tag) { return bool(referencedTagBits[_tag]); };
+	}
+	else
+	{
+		sparseReferencedTags = referencedTags(m_items, numeric_limits<size_t>::max());
+		sparseReferencedTags.insert(_tagsReferencedFromOutside.begin(), _tagsReferencedFromOutside.end());
+		isReferenced = [&](size_t _tag) { return sparseReferencedTags.count(_tag) > 0; };
+	}
 
 	size_t initialSize = m_items.size();
 	/// Remove tags which are never referenced.
@@ -43,12 +81,7 @@ bool JumpdestRemover::optimise(set<size_t> const& _tagsReferencedFromOutside)
 		m_items.end(),
 		[&](AssemblyItem const& _item)
 		{
-			if (_item.type() != Tag)
-				return false;
-			auto asmIdAndTag = _item.splitForeignPushTag();
-			assertThrow(asmIdAndTag.first == numeric_limits<size_t>::max(), OptimizerException, "Sub-assembly tag used as label.");
-			size_t tag = asmIdAndTag.second;
-			return !references.count(tag);
+			return _item.type() == Tag && !isReferenced(_item.splitForeignPushTag().second);
 		}
 	);
 	m_items.erase(pend, m_items.end());
@@ -67,3 +100,16 @@ set<size_t> JumpdestRemover::referencedTags(AssemblyItems const& _items, size_t
 		}
 	return ret;
 }
+
+vector<set<size_t>> JumpdestRemover::referencedTagsOfSubs(AssemblyItems const& _items, size_t _numSubs)
+{
+	vector<set<size_t>> ret(_numSubs);
+	for (auto const& item: _items)
+		if (item.type() == PushTag)
+		{
+			auto [subId, tag] = item.splitForeignPushTag();
+			if (subId < _numSubs)
+				ret[subId].insert(tag);
+		}
+	return ret;
+}
@@ -66,7 +66,7 @@ ostream& KnownState::stream(ostream& _out) const
 		streamExpressionClass(_out, it.second);
 	}
 	_out << "Storage:" << endl;
-	for (auto const& it: m_storageContent)
+	for (auto const& it: *m_storageContent)
 	{
 		_out << "  ";
 		streamExpressionClass(_out, it.first);
@@ -74,7 +74,7 @@ ostream& KnownState::stream(ostream& _out) const
 		streamExpressionClass(_out, it.second);
 	}
 	_out << "Memory:" << endl;
-	for (auto const& it: m_memoryContent)
+	for (auto const& it: *m_memoryContent)
 	{
 		_out << "  ";
 		streamExpressionClass(_out, it.first);
@@ -130,7 +130,7 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 	else
 	{
 		Instruction instruction = _item.instruction();
-		InstructionInfo info = instructionInfo(instruction);
+		InstructionInfo const& info = instructionInfo(instruction);
 		if (SemanticInformation::isDupInstruction(_item))
 			setStackElement(
 				m_stackHeight + 1,
@@ -249,22 +249,27 @@ void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combine
 	// Use the smaller stack height. Essential to terminate in case of loops.
 	if (m_stackHeight > _other.m_stackHeight)
 	{
-		map<int, Id> shiftedStack;
+		StackElements shiftedStack;
 		for (auto const& stackElement: m_stackElements)
 			shiftedStack[stackElement.first - stackDiff] = stackElement.second;
 		m_stackElements = move(shiftedStack);
 		m_stackHeight = _other.m_stackHeight;
 	}
 
-	intersect(m_storageContent, _other.m_storageContent);
-	intersect(m_memoryContent, _other.m_memoryContent);
+	if (!m_storageContent.sharesValueWith(_other.m_storageContent))
+		intersect(m_storageContent.write(), *_other.m_storageContent);
+	if (!m_memoryContent.sharesValueWith(_other.m_memoryContent))
+		intersect(m_memoryContent.write(), *_other.m_memoryContent);
 	if (_combineSequenceNumbers)
 		m_sequenceNumber = max(m_sequenceNumber, _other.m_sequenceNumber);
 }
 
 bool KnownState::operator==(KnownState const& _other) const
 {
-	if (m_storageContent != _other.m_storageContent || m_memoryContent != _other.m_memoryContent)
+	if (
+		(!m_storageContent.sharesValueWith(_other.m_storageContent) && *m_storageContent != *_other.m_storageContent) ||
+		(!m_memoryContent.sharesValueWith(_other.m_memoryContent) && *m_memoryContent != *_other.m_memoryContent)
+	)
 		return false;
 	int stackDiff = m_stackHeight - _other.m_stackHeight;
 	auto thisIt = m_stackElements.cbegin();
@@ -292,7 +297,7 @@ KnownState::Id KnownState::relativeStackElement(int _stackOffset, SourceLocation
 void KnownState::clearTagUnions()
 {
 	for (auto it = m_stackElements.begin(); it != m_stackElements.end();)
-		if (m_tagUnions.left.count(it->second))
+		if (m_tagUnions->left.count(it->second))
 			it = m_stackElements.erase(it);
 		else
 			++it;
@@ -322,23 +327,24 @@ KnownState::StoreOperation KnownState::storeInStorage(
 	Id _value,
 	SourceLocation const& _location)
 {
-	if (m_storageContent.count(_slot) && m_storageContent[_slot] == _value)
+	std::map<Id, Id> const& storageContent = *m_storageContent;
+	if (storageContent.count(_slot) && storageContent.at(_slot) == _value)
 		// do not execute the storage if we know that the value is already there
 		return StoreOperation();
 	m_sequenceNumber++;
-	decltype(m_storageContent) storageContents;
+	std::map<Id, Id> storageContents;
 	// Copy over all values (i.e. retain knowledge about them) where we know that this store
 	// operation will not destroy the knowledge. Specifically, we copy storage locations we know
 	// are different from _slot or locations where we know that the stored value is equal to _value.
-	for (auto const& storageItem: m_storageContent)
+	for (auto const& storageItem: storageContent)
 		if (m_expressionClasses->knownToBeDifferent(storageItem.first, _slot) || storageItem.second == _value)
 			storageContents.insert(storageItem);
-	m_storageContent = move(storageContents);
+	storageContents[_slot] = _value;
+	m_storageContent = util::CopyOnWrite<std::map<Id, Id>>(move(storageContents));
 
 	AssemblyItem item(Instruction::SSTORE, _location);
 	Id id = m_expressionClasses->find(item, {_slot, _value}, true, m_sequenceNumber);
 	StoreOperation operation{StoreOperation::Storage, _slot, m_sequenceNumber, id};
-	m_storageContent[_slot] = _value;
 	// increment a second time so that we get unique sequence numbers for writes
 	m_sequenceNumber++;
 
@@ -347,30 +353,31 @@ KnownState::StoreOperation KnownState::storeInStorage(
 
 ExpressionClasses::Id KnownState::loadFromStorage(Id _slot, SourceLocation const& _location)
 {
-	if (m_storageContent.count(_slot))
-		return m_storageContent.at(_slot);
+	if (m_storageContent->count(_slot))
+		return m_storageContent->at(_slot);
 
 	AssemblyItem item(Instruction::SLOAD, _location);
-	return m_storageContent[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	return m_storageContent.write()[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
 }
 
 KnownState::StoreOperation KnownState::storeInMemory(Id _slot, Id _value, SourceLocation const& _location)
 {
-	if (m_memoryContent.count(_slot) && m_memoryContent[_slot] == _value)
+	std::map<Id, Id> const& memoryContent = *m_memoryContent;
+	if (memoryContent.count(_slot) && memoryContent.at(_slot) == _value)
 		// do not execute the store if we know that the value is already there
 		return StoreOperation();
 	m_sequenceNumber++;
-	decltype(m_memoryContent) memoryContents;
+	std::map<Id, Id> memoryContents;
 	// copy over values at points where we know that they are different from _slot by at least 32
-	for (auto const& memoryItem: m_memoryContent)
+	for (auto const& memoryItem: memoryContent)
 		if (m_expressionClasses->knownToBeDifferentBy32(memoryItem.first, _slot))
 			memoryContents.insert(memoryItem);
-	m_memoryContent = move(memoryContents);
+	memoryContents[_slot] = _value;
+	m_memoryContent = util::CopyOnWrite<std::map<Id, Id>>(move(memoryContents));
 
 	AssemblyItem item(Instruction::MSTORE, _location);
 	Id id = m_expressionClasses->find(item, {_slot, _value}, true, m_sequenceNumber);
 	StoreOperation operation{StoreOperation::Memory, _slot, m_sequenceNumber, id};
-	m_memoryContent[_slot] = _value;
 	// increment a second time so that we get unique sequence numbers for writes
 	m_sequenceNumber++;
 	return operation;
@@ -378,11 +385,11 @@ KnownState::StoreOperation KnownState::storeInMemory(Id _slot, Id _value, Source
 
 ExpressionClasses::Id KnownState::loadFromMemory(Id _slot, SourceLocation const& _location)
 {
-	if (m_memoryContent.count(_slot))
-		return m_memoryContent.at(_slot);
+	if (m_memoryContent->count(_slot))
+		return m_memoryContent->at(_slot);
 
 	AssemblyItem item(Instruction::MLOAD, _location);
-	return m_memoryContent[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	return m_memoryContent.write()[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
 }
 
 KnownState::Id KnownState::applyKeccak256(
@@ -407,8 +414,8 @@ KnownState::Id KnownState::applyKeccak256(
 		);
 		arguments.push_back(loadFromMemory(slot, _location));
 	}
-	if (m_knownKeccak256Hashes.count({arguments, length}))
-		return m_knownKeccak256Hashes.at({arguments, length});
+	if (m_knownKeccak256Hashes->count({arguments, length}))
+		return m_knownKeccak256Hashes->at({arguments, length});
 	Id v;
 	// If all arguments are known constants, compute the Keccak-256 here
 	if (all_of(arguments.begin(), arguments.end(), [this](Id _a) { return !!m_expressionClasses->knownConstant(_a); }))
@@ -421,13 +428,13 @@ KnownState::Id KnownState::applyKeccak256(
 	}
 	else
 		v = m_expressionClasses->find(keccak256Item, {_start, _length}, true, m_sequenceNumber);
-	return m_knownKeccak256Hashes[{arguments, length}] = v;
+	return m_knownKeccak256Hashes.write()[{arguments, length}] = v;
 }
 
 set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
 {
-	if (m_tagUnions.left.count(_expressionId))
-		return m_tagUnions.left.at(_expressionId);
+	if (m_tagUnions->left.count(_expressionId))
+		return m_tagUnions->left.at(_expressionId);
 	// Might be a tag, then return the set of itself.
 	ExpressionClasses::Expression expr = m_expressionClasses->representative(_expressionId);
 	if (expr.item && expr.item->type() == PushTag)
@@ -438,12 +445,12 @@ set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
 
 KnownState::Id KnownState::tagUnion(set<u256> _tags)
 {
-	if (m_tagUnions.right.count(_tags))
-		return m_tagUnions.right.at(_tags);
+	if (m_tagUnions->right.count(_tags))
+		return m_tagUnions->right.at(_tags);
 	else
 	{
 		Id id = m_expressionClasses->newClass(SourceLocation());
-		m_tagUnions.right.insert(make_pair(_tags, id));
+		m_tagUnions.write().right.insert(make_pair(_tags, id));
 		return id;
 	}
 }
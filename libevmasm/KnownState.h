@@ -46,7 +46,9 @@
 #endif // defined(__clang__)
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/CopyOnWrite.h>
 #include <libsolutil/Exceptions.h>
+#include <libsolutil/FlatMap.h>
 #include <libevmasm/ExpressionClasses.h>
 #include <libevmasm/SemanticInformation.h>
 
@@ -77,11 +79,17 @@ using AssemblyItems = std::vector<AssemblyItem>;
  * The general workings are that for each assembly item that is fed, an equivalence class is
  * derived from the operation and the equivalence class of its arguments. DUPi, SWAPi and some
  * arithmetic instructions are used to infer equivalences while these classes are determined.
+ *
+ * States are copied at every branch of the analysed code, so the knowledge about storage, memory,
+ * hashes and tag unions is shared between copies until one of them modifies it.
  */
 class KnownState
 {
 public:
 	using Id = ExpressionClasses::Id;
+	/// The stack rarely holds more than the 17 elements that can be accessed, so the map is flat
+	/// and states can be copied without allocating.
+	using StackElements = util::FlatMap<int, Id, 24>;
 	struct StoreOperation
 	{
 		enum Target { Invalid, Memory, Storage };
@@ -108,11 +116,11 @@ public:
 	StoreOperation feedItem(AssemblyItem const& _item, bool _copyItem = false);
 
 	/// Resets any knowledge about storage.
-	void resetStorage() { m_storageContent.clear(); }
+	void resetStorage() { m_storageContent.reset(); }
 	/// Resets any knowledge about storage.
-	void resetMemory() { m_memoryContent.clear(); }
+	void resetMemory() { m_memoryContent.reset(); }
 	/// Resets known Keccak-256 hashes
-	void resetKnownKeccak256Hashes() { m_knownKeccak256Hashes.clear(); }
+	void resetKnownKeccak256Hashes() { m_knownKeccak256Hashes.reset(); }
 	/// Resets any knowledge about the current stack.
 	void resetStack() { m_stackElements.clear(); m_stackHeight = 0; }
 	/// Resets any knowledge.
@@ -146,10 +154,10 @@ public:
 	void clearTagUnions();
 
 	int stackHeight() const { return m_stackHeight; }
-	std::map<int, Id> const& stackElements() const { return m_stackElements; }
+	StackElements const& stackElements() const { return m_stackElements; }
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
-	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	std::map<Id, Id> const& storageContent() const { return *m_storageContent; }
 
 private:
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
@@ -178,22 +186,22 @@ private:
 	/// Current stack height, can be negative.
 	int m_stackHeight = 0;
 	/// Current stack layout, mapping stack height -> equivalence class
-	std::map<int, Id> m_stackElements;
+	StackElements m_stackElements;
 	/// Current sequence number, this is incremented with each modification to storage or memory.
 	unsigned m_sequenceNumber = 1;
 	/// Knowledge about storage content.
-	std::map<Id, Id> m_storageContent;
+	util::CopyOnWrite<std::map<Id, Id>> m_storageContent;
 	/// Knowledge about memory content. Keys are memory addresses, note that the values overlap
 	/// and are not contained here if they are not completely known.
-	std::map<Id, Id> m_memoryContent;
+	util::CopyOnWrite<std::map<Id, Id>> m_memoryContent;
 	/// Keeps record of all Keccak-256 hashes that are computed. The first parameter in the
 	/// std::pair corresponds to memory content and the second parameter corresponds to the length
 	/// that is accessed.
-	std::map<std::pair<std::vector<Id>, unsigned>, Id> m_knownKeccak256Hashes;
+	util::CopyOnWrite<std::map<std::pair<std::vector<Id>, unsigned>, Id>> m_knownKeccak256Hashes;
 	/// Structure containing the classes of equivalent expressions.
 	std::shared_ptr<ExpressionClasses> m_expressionClasses;
 	/// Container for unions of tags stored on the stack.
-	boost::bimap<Id, std::set<u256>> m_tagUnions;
+	util::CopyOnWrite<boost::bimap<Id, std::set<u256>>> m_tagUnions;
 };
 
 }
@@ -38,25 +38,33 @@ void LinkerObject::append(LinkerObject const& _other)
 
 void LinkerObject::link(map<string, h160> const& _libraryAddresses)
 {
-	std::map<size_t, std::string> remainingRefs;
-	for (auto const& linkRef: linkReferences)
-		if (h160 const* address = matchLibrary(linkRef.second, _libraryAddresses))
-			copy(address->data(), address->data() + 20, bytecode.begin() + vector<uint8_t>::difference_type(linkRef.first));
+	for (auto linkRef = linkReferences.begin(); linkRef != linkReferences.end();)
+		if (h160 const* address = matchLibrary(linkRef->second, _libraryAddresses))
+		{
+			copy(address->data(), address->data() + 20, bytecode.begin() + vector<uint8_t>::difference_type(linkRef->first));
+			linkRef = linkReferences.erase(linkRef);
+		}
 		else
-			remainingRefs.insert(linkRef);
-	linkReferences.swap(remainingRefs);
+			++linkRef;
 }
 
 string LinkerObject::toHex() const
 {
-	string hex = solidity::util::toHex(bytecode);
+	string hex(bytecode.size() * 2, 0);
+	solidity::util::toHex(bytesConstRef(&bytecode), hex.data());
+	// Libraries are usually referenced more than once, so their hashes are only computed once.
+	map<string_view, h256> hashes;
 	for (auto const& ref: linkReferences)
 	{
 		size_t pos = ref.first * 2;
-		string hash = libraryPlaceholder(ref.second);
+		auto [hashIt, inserted] = hashes.try_emplace(ref.second);
+		if (inserted)
+			hashIt->second = keccak256(ref.second);
+		h256 const& hash = hashIt->second;
+		// The placeholder is "__$" followed by the first 34 hex characters of the hash, "$__".
 		hex[pos] = hex[pos + 1] = hex[pos + 38] = hex[pos + 39] = '_';
-		for (size_t i = 0; i < 36; ++i)
-			hex[pos + 2 + i] = hash.at(i);
+		hex[pos + 2] = hex[pos + 37] = '$';
+		solidity::util::toHex(bytesConstRef(hash.data(), 17), hex.data() + pos + 3);
 	}
 	return hex;
 }
@@ -28,8 +28,8 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
-PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion):
-	m_items(_items), m_evmVersion(_evmVersion)
+PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion, size_t _maxSteps):
+	m_items(_items), m_evmVersion(_evmVersion), m_maxSteps(_maxSteps)
 {
 	for (size_t i = 0; i < m_items.size(); ++i)
 		if (m_items[i].type() == Tag)
@@ -41,6 +41,10 @@ GasMeter::GasConsumption PathGasMeter::estimateMax(
 	shared_ptr<KnownState> const& _state
 )
 {
+	m_queue.clear();
+	m_highestGasUsagePerJumpdest.clear();
+	m_steps = 0;
+	m_stepLimitReached = false;
 	auto path = make_unique<GasPath>();
 	path->index = _startIndex;
 	path->state = _state->copy();
@@ -54,15 +58,18 @@ GasMeter::GasConsumption PathGasMeter::estimateMax(
 
 void PathGasMeter::queue(std::unique_ptr<GasPath>&& _newPath)
 {
-	if (
-		m_highestGasUsagePerJumpdest.count(_newPath->index) &&
-		_newPath->gas < m_highestGasUsagePerJumpdest.at(_newPath->index)
-	)
+	if (!worthQueueing(_newPath->index, _newPath->gas))
 		return;
 	m_highestGasUsagePerJumpdest[_newPath->index] = _newPath->gas;
 	m_queue[_newPath->index] = move(_newPath);
 }
 
+bool PathGasMeter::worthQueueing(size_t _index, GasMeter::GasConsumption const& _gas) const
+{
+	auto it = m_highestGasUsagePerJumpdest.find(_index);
+	return it == m_highestGasUsagePerJumpdest.end() || !(_gas < it->second);
+}
+
 GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 {
 	assertThrow(!m_queue.empty(), OptimizerException, "");
@@ -85,6 +92,11 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 	set<u256> jumpTags;
 	for (; index < m_items.size() && !gas.isInfinite; ++index)
 	{
+		if (++m_steps > m_maxSteps)
+		{
+			m_stepLimitReached = true;
+			return GasMeter::GasConsumption::infinite();
+		}
 		bool branchStops = false;
 		jumpTags.clear();
 		AssemblyItem const& item = m_items.at(index);
@@ -119,16 +131,29 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 
 		gas += meter.estimateMax(item);
 
-		for (u256 const& tag: jumpTags)
+		for (auto it = jumpTags.begin(); it != jumpTags.end(); ++it)
 		{
+			size_t targetIndex = m_items.size();
+			if (auto position = m_tagPositions.find(*it); position != m_tagPositions.end())
+				targetIndex = position->second;
+			// Only copy the state for paths that are not discarded anyway.
+			if (!worthQueueing(targetIndex, gas))
+				continue;
 			auto newPath = make_unique<GasPath>();
-			newPath->index = m_items.size();
-			if (m_tagPositions.count(tag))
-				newPath->index = m_tagPositions.at(tag);
+			newPath->index = targetIndex;
 			newPath->gas = gas;
 			newPath->largestMemoryAccess = meter.largestMemoryAccess();
-			newPath->state = state->copy();
-			newPath->visitedJumpdests = path->visitedJumpdests;
+			// If the current path ends here, the last branch can take over its state.
+			if (branchStops && next(it) == jumpTags.end())
+			{
+				newPath->state = state;
+				newPath->visitedJumpdests = move(path->visitedJumpdests);
+			}
+			else
+			{
+				newPath->state = state->copy();
+				newPath->visitedJumpdests = path->visitedJumpdests;
+			}
 			queue(move(newPath));
 		}
 
@@ -26,6 +26,7 @@
 
 #include <liblangutil/EVMVersion.h>
 
+#include <limits>
 #include <set>
 #include <vector>
 #include <memory>
@@ -48,14 +49,22 @@ struct GasPath
  * Computes an upper bound on the gas usage of a computation starting at a certain position in
  * a list of AssemblyItems in a given state until the computation stops.
  * Can be used to estimate the gas usage of functions on any given input.
+ * Stops with an infinite estimate after evaluating @a _maxSteps items along all paths.
  */
 class PathGasMeter
 {
 public:
-	explicit PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
+	explicit PathGasMeter(
+		AssemblyItems const& _items,
+		langutil::EVMVersion _evmVersion,
+		size_t _maxSteps = std::numeric_limits<size_t>::max()
+	);
 
 	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
 
+	/// @returns true if the last estimation was stopped because it evaluated too many items.
+	bool stepLimitReached() const { return m_stepLimitReached; }
+
 	static GasMeter::GasConsumption estimateMax(
 		AssemblyItems const& _items,
 		langutil::EVMVersion _evmVersion,
@@ -72,6 +81,8 @@ private:
 	/// This is not exact as different state might influence higher gas costs at a later
 	/// point in time, but it greatly reduces computational overhead.
 	void queue(std::unique_ptr<GasPath>&& _newPath);
+	/// @returns false if @a queue would discard a path reaching @a _index with gas usage @a _gas.
+	bool worthQueueing(size_t _index, GasMeter::GasConsumption const& _gas) const;
 	GasMeter::GasConsumption handleQueueItem();
 
 	/// Map of jumpdest -> gas path, so not really a queue. We only have one queued up
@@ -81,6 +92,9 @@ private:
 	std::map<u256, size_t> m_tagPositions;
 	AssemblyItems const& m_items;
 	langutil::EVMVersion m_evmVersion;
+	size_t m_maxSteps;
+	size_t m_steps = 0;
+	bool m_stepLimitReached = false;
 };
 
 }
@@ -81,10 +81,16 @@ struct ApplyRule<Method, 1>
 template <class Method, size_t WindowSize>
 struct SimplePeepholeOptimizerMethod
 {
+	/// Cheap check on the first item of the window, so that rules that cannot match
+	/// are skipped without looking at the whole window. Rules can hide this to
+	/// restrict the kinds of items they start with.
+	static bool canStartWith(AssemblyItem const&) { return true; }
+
 	static bool apply(OptimiserState& _state)
 	{
 		if (
 			_state.i + WindowSize <= _state.items.size() &&
+			Method::canStartWith(_state.items[_state.i]) &&
 			ApplyRule<Method, WindowSize>::applyRule(_state.items.begin() + static_cast<ptrdiff_t>(_state.i), _state.out)
 		)
 		{
@@ -120,6 +126,7 @@ struct PushPop: SimplePeepholeOptimizerMethod<PushPop, 2>
 
 struct OpPop: SimplePeepholeOptimizerMethod<OpPop, 2>
 {
+	static bool canStartWith(AssemblyItem const& _item) { return _item.type() == Operation; }
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _pop,
@@ -142,6 +149,7 @@ struct OpPop: SimplePeepholeOptimizerMethod<OpPop, 2>
 
 struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap, 2>
 {
+	static bool canStartWith(AssemblyItem const& _item) { return SemanticInformation::isSwapInstruction(_item); }
 	static size_t applySimple(AssemblyItem const& _s1, AssemblyItem const& _s2, std::back_insert_iterator<AssemblyItems>)
 	{
 		return _s1 == _s2 && SemanticInformation::isSwapInstruction(_s1);
@@ -150,6 +158,7 @@ struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap, 2>
 
 struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush, 2>
 {
+	static bool canStartWith(AssemblyItem const& _item) { return _item.type() == Push; }
 	static bool applySimple(AssemblyItem const& _push1, AssemblyItem const& _push2, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		if (_push1.type() == Push && _push2.type() == Push && _push1.data() == _push2.data())
@@ -165,6 +174,7 @@ struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush, 2>
 
 struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap, 2>
 {
+	static bool canStartWith(AssemblyItem const& _item) { return _item == Instruction::SWAP1; }
 	static bool applySimple(AssemblyItem const& _swap, AssemblyItem const& _op, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		// Remove SWAP1 if following instruction is commutative
@@ -183,6 +193,7 @@ struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap, 2>
 
 struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison, 2>
 {
+	static bool canStartWith(AssemblyItem const& _item) { return _item == Instruction::SWAP1; }
 	static bool applySimple(AssemblyItem const& _swap, AssemblyItem const& _op, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		static map<Instruction, Instruction> const swappableOps{
@@ -209,6 +220,7 @@ struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison, 2>
 /// Remove swapN after dupN
 struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap, 2>
 {
+	static bool canStartWith(AssemblyItem const& _item) { return SemanticInformation::isDupInstruction(_item); }
 	static size_t applySimple(
 		AssemblyItem const& _dupN,
 		AssemblyItem const& _swapN,
@@ -232,6 +244,7 @@ struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap, 2>
 
 struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI, 4>
 {
+	static bool canStartWith(AssemblyItem const& _item) { return _item == Instruction::ISZERO; }
 	static size_t applySimple(
 		AssemblyItem const& _iszero1,
 		AssemblyItem const& _iszero2,
@@ -258,6 +271,7 @@ struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI, 4>
 
 struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext, 3>
 {
+	static bool canStartWith(AssemblyItem const& _item) { return _item.type() == PushTag; }
 	static size_t applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _jump,
@@ -284,6 +298,7 @@ struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext, 3>
 
 struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions, 3>
 {
+	static bool canStartWith(AssemblyItem const& _item) { return _item.type() == PushTag || _item.type() == Push; }
 	static bool applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _pushConstant,
@@ -319,6 +334,7 @@ struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions, 3>
 
 struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 {
+	static bool canStartWith(AssemblyItem const& _item) { return _item.type() == Push; }
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _not,
@@ -390,6 +406,7 @@ bool PeepholeOptimiser::optimise()
 {
 	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
 	auto const approx = evmasm::Precision::Approximate;
+	m_optimisedItems.reserve(m_items.size());
 	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
 	while (state.i < m_items.size())
 		applyMethods(
@@ -27,6 +27,7 @@
 #include <libevmasm/SimplificationRule.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/FixedU256.h>
 
 #include <boost/multiprecision/detail/min_max.hpp>
 
@@ -40,16 +41,6 @@
 namespace solidity::evmasm
 {
 
-template <class S> S divWorkaround(S const& _a, S const& _b)
-{
-	return (S)(bigint(_a) / bigint(_b));
-}
-
-template <class S> S modWorkaround(S const& _a, S const& _b)
-{
-	return (S)(bigint(_a) % bigint(_b));
-}
-
 // This works around a bug fixed with Boost 1.64.
 // https://www.boost.org/doc/libs/release/libs/multiprecision/doc/html/boost_multiprecision/map/hist.html#boost_multiprecision.map.hist.multiprecision_2_3_1_boost_1_64
 template <class S> S shlWorkaround(S const& _x, unsigned _amount)
@@ -85,11 +76,11 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 		{Builtins::ADD(A, B), [=]{ return A.d() + B.d(); }},
 		{Builtins::MUL(A, B), [=]{ return A.d() * B.d(); }},
 		{Builtins::SUB(A, B), [=]{ return A.d() - B.d(); }},
-		{Builtins::DIV(A, B), [=]{ return B.d() == 0 ? 0 : divWorkaround(A.d(), B.d()); }},
-		{Builtins::SDIV(A, B), [=]{ return B.d() == 0 ? 0 : s2u(divWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::MOD(A, B), [=]{ return B.d() == 0 ? 0 : modWorkaround(A.d(), B.d()); }},
-		{Builtins::SMOD(A, B), [=]{ return B.d() == 0 ? 0 : s2u(modWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::EXP(A, B), [=]{ return Word(boost::multiprecision::powm(bigint(A.d()), bigint(B.d()), bigint(1) << Pattern::WordSize)); }},
+		{Builtins::DIV(A, B), [=]{ return Word(FixedU256(A.d()) / FixedU256(B.d())); }},
+		{Builtins::SDIV(A, B), [=]{ return Word(sdiv(FixedU256(A.d()), FixedU256(B.d()))); }},
+		{Builtins::MOD(A, B), [=]{ return Word(FixedU256(A.d()) % FixedU256(B.d())); }},
+		{Builtins::SMOD(A, B), [=]{ return Word(smod(FixedU256(A.d()), FixedU256(B.d()))); }},
+		{Builtins::EXP(A, B), [=]{ return Word(exp(FixedU256(A.d()), FixedU256(B.d()))); }},
 		{Builtins::NOT(A), [=]{ return ~A.d(); }},
 		{Builtins::LT(A, B), [=]() -> Word { return A.d() < B.d() ? 1 : 0; }},
 		{Builtins::GT(A, B), [=]() -> Word { return A.d() > B.d() ? 1 : 0; }},
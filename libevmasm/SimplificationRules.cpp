@@ -31,6 +31,7 @@
 
 #include <utility>
 #include <functional>
+#include <limits>
 
 using namespace std;
 using namespace solidity;
@@ -45,8 +46,13 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	resetMatchGroups();
 
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
+	uint8_t instruction = uint8_t(_expr.item->instruction());
+	unsigned constants = constantArguments(_expr, _classes);
+	for (size_t i = 0; i < m_rules[instruction].size(); ++i)
 	{
+		if ((m_constantArgumentMasks[instruction][i] & ~constants) != 0)
+			continue;
+		auto const& rule = m_rules[instruction][i];
 		if (rule.pattern.matches(_expr, _classes))
 			if (!rule.feasible || rule.feasible())
 				return &rule;
@@ -56,6 +62,18 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	return nullptr;
 }
 
+unsigned Rules::constantArguments(Expression const& _expr, ExpressionClasses const& _classes)
+{
+	unsigned mask = 0;
+	for (size_t i = 0; i < _expr.arguments.size() && i < numeric_limits<unsigned>::digits; ++i)
+	{
+		AssemblyItem const* item = _classes.representative(_expr.arguments[i]).item;
+		if (item && item->type() == Push)
+			mask |= 1u << i;
+	}
+	return mask;
+}
+
 bool Rules::isInitialized() const
 {
 	return !m_rules[uint8_t(Instruction::ADD)].empty();
@@ -69,7 +87,14 @@ void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
 
 void Rules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	uint8_t instruction = uint8_t(_rule.pattern.instruction());
+	unsigned mask = 0;
+	vector<Pattern> arguments = _rule.pattern.arguments();
+	for (size_t i = 0; i < arguments.size() && i < numeric_limits<unsigned>::digits; ++i)
+		if (arguments[i].type() == Push)
+			mask |= 1u << i;
+	m_rules[instruction].push_back(_rule);
+	m_constantArgumentMasks[instruction].push_back(mask);
 }
 
 Rules::Rules()
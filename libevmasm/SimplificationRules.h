@@ -73,10 +73,16 @@ private:
 
 	void resetMatchGroups() { m_matchGroups.clear(); }
 
+	/// @returns a bit mask of the argument positions of @a _expr whose representative is a constant.
+	static unsigned constantArguments(Expression const& _expr, ExpressionClasses const& _classes);
+
 	std::map<unsigned, Expression const*> m_matchGroups;
 	/// Pattern to match, replacement to be applied and flag indicating whether
 	/// the replacement might remove some elements (except constants).
 	std::vector<SimplificationRule<Pattern>> m_rules[256];
+	/// For each rule in m_rules, the bit mask of argument positions its pattern requires to be
+	/// constants. Rules whose mask is not covered by the expression are skipped without matching.
+	std::vector<unsigned> m_constantArgumentMasks[256];
 };
 
 /**
@@ -117,7 +123,7 @@ public:
 	/// @returns the id of the matched expression if this pattern is part of a match group.
 	Id id() const { return matchGroupValue().id; }
 	/// @returns the data of the matched expression if this pattern is part of a match group.
-	u256 const& d() const { return matchGroupValue().item->data(); }
+	u256 d() const { return matchGroupValue().item->data(); }
 
 	std::string toString() const;
 
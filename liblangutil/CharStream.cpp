@@ -55,6 +55,15 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
 
+CharStream::CharStream(string _source, string _name):
+	m_name(move(_name))
+{
+	// The string is stored on the heap, so that the view stays valid if the stream is moved.
+	auto source = make_shared<string const>(move(_source));
+	m_source = *source;
+	m_owner = move(source);
+}
+
 char CharStream::advanceAndGet(size_t _chars)
 {
 	if (isPastEndOfInput())
@@ -82,39 +91,20 @@ char CharStream::setPosition(size_t _location)
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), size_type(_position));
-	if (searchStart > 0)
-		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	string line = m_source.substr(
-		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
-	if (!line.empty() && line.back() == '\r')
-		line.pop_back();
-	return line;
+	size_t const line = lineIndex(max<size_t>(min<size_t>(m_source.size(), size_t(_position)), 1));
+	vector<size_t> const& starts = lineStarts();
+	size_t const lineEnd = line + 1 < starts.size() ? starts[line + 1] - 1 : m_source.size();
+	string text{m_source.substr(starts[line], lineEnd - starts[line])};
+	if (!text.empty() && text.back() == '\r')
+		text.pop_back();
+	return text;
 }
 
 LineColumn CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	using diff_type = string::difference_type;
-	size_type searchPosition = min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
-	return LineColumn{lineNumber, static_cast<int>(searchPosition - lineStart)};
+	size_t const searchPosition = min<size_t>(m_source.size(), size_t(_position));
+	size_t const line = lineIndex(searchPosition);
+	return LineColumn{static_cast<int>(line), static_cast<int>(searchPosition - lineStarts()[line])};
 }
 
 string_view CharStream::text(SourceLocation const& _location) const
@@ -129,7 +119,7 @@ string_view CharStream::text(SourceLocation const& _location) const
 	);
 }
 
-string CharStream::singleLineSnippet(string const& _sourceCode, SourceLocation const& _location)
+string CharStream::singleLineSnippet(string_view _sourceCode, SourceLocation const& _location)
 {
 	if (!_location.hasText())
 		return {};
@@ -137,7 +127,7 @@ string CharStream::singleLineSnippet(string const& _sourceCode, SourceLocation c
 	if (static_cast<size_t>(_location.start) >= _sourceCode.size())
 		return {};
 
-	string cut = _sourceCode.substr(static_cast<size_t>(_location.start), static_cast<size_t>(_location.end - _location.start));
+	string cut{_sourceCode.substr(static_cast<size_t>(_location.start), static_cast<size_t>(_location.end - _location.start))};
 	auto newLinePos = cut.find_first_of("\n\r");
 	if (newLinePos != string::npos)
 		cut = cut.substr(0, newLinePos) + "...";
@@ -147,7 +137,16 @@ string CharStream::singleLineSnippet(string const& _sourceCode, SourceLocation c
 
 optional<int> CharStream::translateLineColumnToPosition(LineColumn const& _lineColumn) const
 {
-	return translateLineColumnToPosition(m_source, _lineColumn);
+	vector<size_t> const& starts = lineStarts();
+	if (_lineColumn.line < 0 || static_cast<size_t>(_lineColumn.line) >= starts.size())
+		return nullopt;
+
+	size_t const line = static_cast<size_t>(_lineColumn.line);
+	size_t const offset = starts[line];
+	size_t const endOfLine = line + 1 < starts.size() ? starts[line + 1] - 1 : m_source.size();
+	if (offset + static_cast<size_t>(_lineColumn.column) > endOfLine)
+		return nullopt;
+	return offset + static_cast<size_t>(_lineColumn.column);
 }
 
 optional<int> CharStream::translateLineColumnToPosition(std::string const& _text, LineColumn const& _input)
@@ -173,3 +172,27 @@ optional<int> CharStream::translateLineColumnToPosition(std::string const& _text
 	return offset + static_cast<size_t>(_input.column);
 }
 
+vector<size_t> const& CharStream::lineStarts() const
+{
+	if (auto lineStarts = atomic_load(&m_lineStarts))
+		return *lineStarts;
+
+	auto lineStarts = make_shared<vector<size_t>>();
+	lineStarts->push_back(0);
+	for (size_t position = m_source.find('\n'); position != string::npos; position = m_source.find('\n', position + 1))
+		lineStarts->push_back(position + 1);
+
+	// If another thread was faster, use its result, so that references handed out stay valid.
+	shared_ptr<vector<size_t> const> expected;
+	shared_ptr<vector<size_t> const> desired = move(lineStarts);
+	if (atomic_compare_exchange_strong(&m_lineStarts, &expected, desired))
+		return *desired;
+	return *expected;
+}
+
+size_t CharStream::lineIndex(size_t _position) const
+{
+	vector<size_t> const& starts = lineStarts();
+	// The first line starts at zero, so there is always an element that is not greater.
+	return static_cast<size_t>(upper_bound(starts.begin(), starts.end(), _position) - starts.begin()) - 1;
+}
@@ -51,10 +51,13 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -71,13 +74,20 @@ class CharStream
 {
 public:
 	CharStream() = default;
-	CharStream(std::string _source, std::string _name):
-		m_source(std::move(_source)), m_name(std::move(_name)) {}
+	CharStream(std::string _source, std::string _name);
+	/// Creates a stream that references @a _source instead of copying it, e.g. a memory-mapped file.
+	/// @a _owner has to keep the memory of @a _source alive.
+	CharStream(std::string_view _source, std::shared_ptr<void const> _owner, std::string _name):
+		m_owner(std::move(_owner)), m_source(_source), m_name(std::move(_name)) {}
 
 	size_t position() const { return m_position; }
 	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
 
-	char get(size_t _charsForward = 0) const { return m_source[m_position + _charsForward]; }
+	/// @returns the character @a _charsForward characters after the current position or zero past the end.
+	char get(size_t _charsForward = 0) const
+	{
+		return m_position + _charsForward < m_source.size() ? m_source[m_position + _charsForward] : 0;
+	}
 	char advanceAndGet(size_t _chars = 1);
 	/// Sets scanner position to @ _amount characters backwards in source text.
 	/// @returns The character of the current location after update is returned.
@@ -89,15 +99,15 @@ public:
 
 	void reset() { m_position = 0; }
 
-	std::string const& source() const noexcept { return m_source; }
+	std::string_view source() const noexcept { return m_source; }
 	std::string const& name() const noexcept { return m_name; }
 
 	size_t size() const { return m_source.size(); }
 
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors.
+	/// The first call computes an index of the line starts, further calls are cheap.
 	std::string lineAtPosition(int _position) const;
 	LineColumn translatePositionToLineColumn(int _position) const;
 	///@}
@@ -133,12 +143,22 @@ public:
 		return singleLineSnippet(m_source, _location);
 	}
 
-	static std::string singleLineSnippet(std::string const& _sourceCode, SourceLocation const& _location);
+	static std::string singleLineSnippet(std::string_view _sourceCode, SourceLocation const& _location);
 
 private:
-	std::string m_source;
+	/// @returns the offsets of the first characters of all lines in ascending order.
+	/// Computed on first use. Safe to be called concurrently.
+	std::vector<size_t> const& lineStarts() const;
+	/// @returns the index of the line that contains the offset @a _position.
+	size_t lineIndex(size_t _position) const;
+
+	/// Keeps the memory referenced by m_source alive.
+	std::shared_ptr<void const> m_owner;
+	std::string_view m_source;
 	std::string m_name;
 	size_t m_position{0};
+	/// Cache for lineStarts(). Only ever set once, accessed through the atomic shared_ptr functions.
+	mutable std::shared_ptr<std::vector<size_t> const> m_lineStarts;
 };
 
 }
@@ -0,0 +1,172 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <liblangutil/CharacterSearch.h>
+
+#include <liblangutil/Common.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+
+namespace
+{
+
+bool isLineBreakCandidate(char _c)
+{
+	return ('\n' <= _c && _c <= '\r') || uint8_t(_c) == 0xc2 || uint8_t(_c) == 0xe2;
+}
+
+bool isIdentifierPartOrPeriod(char _c, bool _allowPeriod)
+{
+	return isIdentifierPart(_c) || (_allowPeriod && _c == '.');
+}
+
+#if defined(__SSE2__)
+
+size_t constexpr blockSize = 16;
+
+/// @returns the bytes of @a _block that are in the range [_low, _high] as 0xff, all others as 0.
+/// Only works for ASCII ranges, since the comparison is signed.
+__m128i inRange(__m128i _block, char _low, char _high)
+{
+	return _mm_and_si128(
+		_mm_cmpgt_epi8(_block, _mm_set1_epi8(static_cast<char>(_low - 1))),
+		_mm_cmplt_epi8(_block, _mm_set1_epi8(static_cast<char>(_high + 1)))
+	);
+}
+
+__m128i equalTo(__m128i _block, char _c)
+{
+	return _mm_cmpeq_epi8(_block, _mm_set1_epi8(_c));
+}
+
+/// Applies @a _stopMask to consecutive blocks of @a _text starting at @a _position, as long as
+/// complete blocks are left. @a _stopMask has to return a bitmask of the bytes to stop at.
+/// @returns the position of the first byte to stop at or the position of the first byte
+/// that has not been inspected.
+template <typename StopMask>
+size_t findInBlocks(string_view _text, size_t _position, StopMask _stopMask)
+{
+	for (; _position + blockSize <= _text.size(); _position += blockSize)
+	{
+		__m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_text.data() + _position));
+		if (unsigned const mask = _stopMask(block))
+			return _position + static_cast<size_t>(__builtin_ctz(mask));
+	}
+	return _position;
+}
+
+unsigned toBitmask(__m128i _block)
+{
+	return static_cast<unsigned>(_mm_movemask_epi8(_block));
+}
+
+#endif
+
+}
+
+size_t solidity::langutil::findEndOfWhitespace(string_view _text, size_t _position)
+{
+#if defined(__SSE2__)
+	// Most whitespace is short, so avoid setting up the vector comparison for single characters.
+	if (_position < _text.size() && isWhiteSpace(_text[_position]))
+		_position = findInBlocks(_text, _position, [](__m128i _block) {
+			__m128i const whitespace = _mm_or_si128(
+				_mm_or_si128(equalTo(_block, ' '), equalTo(_block, '\n')),
+				_mm_or_si128(equalTo(_block, '\t'), equalTo(_block, '\r'))
+			);
+			return ~toBitmask(whitespace) & 0xffffu;
+		});
+#endif
+	return findEndOfWhitespaceBytewise(_text, _position);
+}
+
+size_t solidity::langutil::findLineBreakCandidate(string_view _text, size_t _position)
+{
+#if defined(__SSE2__)
+	_position = findInBlocks(_text, _position, [](__m128i _block) {
+		return toBitmask(_mm_or_si128(
+			inRange(_block, '\n', '\r'),
+			_mm_or_si128(equalTo(_block, static_cast<char>(0xc2)), equalTo(_block, static_cast<char>(0xe2)))
+		));
+	});
+#endif
+	return findLineBreakCandidateBytewise(_text, _position);
+}
+
+size_t solidity::langutil::findCharacter(string_view _text, size_t _position, char _character)
+{
+	if (_position >= _text.size())
+		return _text.size();
+	// memchr is vectorised by all common C libraries.
+	void const* match = memchr(_text.data() + _position, _character, _text.size() - _position);
+	return match ? static_cast<size_t>(static_cast<char const*>(match) - _text.data()) : _text.size();
+}
+
+size_t solidity::langutil::findEndOfIdentifier(string_view _text, size_t _position, bool _allowPeriod)
+{
+#if defined(__SSE2__)
+	_position = findInBlocks(_text, _position, [_allowPeriod](__m128i _block) {
+		__m128i identifierPart = _mm_or_si128(
+			_mm_or_si128(inRange(_block, 'a', 'z'), inRange(_block, 'A', 'Z')),
+			_mm_or_si128(inRange(_block, '0', '9'), _mm_or_si128(equalTo(_block, '_'), equalTo(_block, '$')))
+		);
+		if (_allowPeriod)
+			identifierPart = _mm_or_si128(identifierPart, equalTo(_block, '.'));
+		return ~toBitmask(identifierPart) & 0xffffu;
+	});
+#endif
+	return findEndOfIdentifierBytewise(_text, _position, _allowPeriod);
+}
+
+size_t solidity::langutil::findEndOfWhitespaceBytewise(string_view _text, size_t _position)
+{
+	while (_position < _text.size() && isWhiteSpace(_text[_position]))
+		++_position;
+	return min(_position, _text.size());
+}
+
+size_t solidity::langutil::findLineBreakCandidateBytewise(string_view _text, size_t _position)
+{
+	while (_position < _text.size() && !isLineBreakCandidate(_text[_position]))
+		++_position;
+	return min(_position, _text.size());
+}
+
+size_t solidity::langutil::findCharacterBytewise(string_view _text, size_t _position, char _character)
+{
+	while (_position < _text.size() && _text[_position] != _character)
+		++_position;
+	return min(_position, _text.size());
+}
+
+size_t solidity::langutil::findEndOfIdentifierBytewise(string_view _text, size_t _position, bool _allowPeriod)
+{
+	while (_position < _text.size() && isIdentifierPartOrPeriod(_text[_position], _allowPeriod))
+		++_position;
+	return min(_position, _text.size());
+}
@@ -0,0 +1,59 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Functions that search source text for the end of whitespace, comments and identifiers.
+ * They process 16 bytes at a time using SSE2 where it is available and fall back to
+ * inspecting one byte at a time otherwise.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace solidity::langutil
+{
+
+/// @returns the position of the first character at or after @a _position in @a _text that is not
+/// whitespace (see isWhiteSpace), or the size of @a _text if there is none.
+size_t findEndOfWhitespace(std::string_view _text, size_t _position);
+
+/// @returns the position of the first character at or after @a _position in @a _text that could
+/// start a line break: one of '\n', '\v', '\f' and '\r' or the first byte of the UTF-8 encoding of
+/// U+0085, U+2028 or U+2029. Returns the size of @a _text if there is none.
+size_t findLineBreakCandidate(std::string_view _text, size_t _position);
+
+/// @returns the position of the first occurrence of @a _character at or after @a _position in
+/// @a _text, or the size of @a _text if there is none.
+size_t findCharacter(std::string_view _text, size_t _position, char _character);
+
+/// @returns the position of the first character at or after @a _position in @a _text that cannot
+/// be part of an identifier (see isIdentifierPart), or the size of @a _text if there is none.
+/// If @a _allowPeriod is set, periods are considered part of identifiers, as they are in Yul.
+size_t findEndOfIdentifier(std::string_view _text, size_t _position, bool _allowPeriod);
+
+/// Reference implementations of the functions above that inspect one byte at a time.
+/// Only meant for tests and benchmarks.
+///@{
+size_t findEndOfWhitespaceBytewise(std::string_view _text, size_t _position);
+size_t findLineBreakCandidateBytewise(std::string_view _text, size_t _position);
+size_t findCharacterBytewise(std::string_view _text, size_t _position, char _character);
+size_t findEndOfIdentifierBytewise(std::string_view _text, size_t _position, bool _allowPeriod);
+///@}
+
+}
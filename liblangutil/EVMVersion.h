@@ -25,6 +25,7 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <boost/operators.hpp>
 
@@ -53,9 +54,15 @@ public:
 	static EVMVersion berlin() { return {Version::Berlin}; }
 	static EVMVersion london() { return {Version::London}; }
 
+	/// @returns all EVM versions in increasing order.
+	static std::vector<EVMVersion> allVersions()
+	{
+		return {homestead(), tangerineWhistle(), spuriousDragon(), byzantium(), constantinople(), petersburg(), istanbul(), berlin(), london()};
+	}
+
 	static std::optional<EVMVersion> fromString(std::string const& _version)
 	{
-		for (auto const& v: {homestead(), tangerineWhistle(), spuriousDragon(), byzantium(), constantinople(), petersburg(), istanbul(), berlin(), london()})
+		for (auto const& v: allVersions())
 			if (_version == v.name())
 				return v;
 		return std::nullopt;
@@ -61,9 +61,15 @@ void ErrorReporter::warning(
 	error(_error, Error::Type::Warning, _location, _secondaryLocation, _description);
 }
 
+void ErrorReporter::warning(ErrorId _error, SourceLocation const& _location, function<string()> const& _description)
+{
+	if (!checkForExcessiveErrors(_error, Error::Type::Warning))
+		m_errorList.push_back(make_shared<Error>(_error, Error::Type::Warning, _description(), _location));
+}
+
 void ErrorReporter::error(ErrorId _errorId, Error::Type _type, SourceLocation const& _location, string const& _description)
 {
-	if (checkForExcessiveErrors(_type))
+	if (checkForExcessiveErrors(_errorId, _type))
 		return;
 
 	m_errorList.push_back(make_shared<Error>(_errorId, _type, _description, _location));
@@ -71,7 +77,7 @@ void ErrorReporter::error(ErrorId _errorId, Error::Type _type, SourceLocation co
 
 void ErrorReporter::error(ErrorId _errorId, Error::Type _type, SourceLocation const& _location, SecondarySourceLocation const& _secondaryLocation, string const& _description)
 {
-	if (checkForExcessiveErrors(_type))
+	if (checkForExcessiveErrors(_errorId, _type))
 		return;
 
 	m_errorList.push_back(make_shared<Error>(_errorId, _type, _description, _location, _secondaryLocation));
@@ -82,8 +88,15 @@ bool ErrorReporter::hasExcessiveErrors() const
 	return m_errorCount > c_maxErrorsAllowed;
 }
 
-bool ErrorReporter::checkForExcessiveErrors(Error::Type _type)
+bool ErrorReporter::checkForExcessiveErrors(ErrorId _error, Error::Type _type)
 {
+	if (
+		m_limitPerErrorId > 0 &&
+		(_type == Error::Type::Warning || _type == Error::Type::Info) &&
+		++m_countPerErrorId[_error.error] > m_limitPerErrorId
+	)
+		return true;
+
 	if (_type == Error::Type::Warning)
 	{
 		m_warningCount++;
@@ -262,6 +275,12 @@ void ErrorReporter::info(
 	error(_error, Error::Type::Info, _location, _description);
 }
 
+void ErrorReporter::info(ErrorId _error, SourceLocation const& _location, function<string()> const& _description)
+{
+	if (!checkForExcessiveErrors(_error, Error::Type::Info))
+		m_errorList.push_back(make_shared<Error>(_error, Error::Type::Info, _description(), _location));
+}
+
 void ErrorReporter::info(ErrorId _error, string const& _description)
 {
 	error(_error, Error::Type::Info, SourceLocation(), _description);
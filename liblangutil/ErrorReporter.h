@@ -32,6 +32,9 @@
 
 #include <boost/range/adaptor/filtered.hpp>
 
+#include <functional>
+#include <unordered_map>
+
 namespace solidity::langutil
 {
 
@@ -43,7 +46,9 @@ public:
 		m_errorList(_errors) { }
 
 	ErrorReporter(ErrorReporter const& _errorReporter) noexcept:
-		m_errorList(_errorReporter.m_errorList) { }
+		m_errorList(_errorReporter.m_errorList),
+		m_limitPerErrorId(_errorReporter.m_limitPerErrorId)
+	{ }
 
 	ErrorReporter& operator=(ErrorReporter const& _errorReporter);
 
@@ -63,8 +68,16 @@ public:
 		SecondarySourceLocation const& _secondaryLocation
 	);
 
+	/// Reports a warning whose description is only created if the warning is not dropped
+	/// because of the limits on the number of warnings.
+	void warning(ErrorId _error, SourceLocation const& _location, std::function<std::string()> const& _description);
+
 	void info(ErrorId _error, SourceLocation const& _location, std::string const& _description);
 
+	/// Reports an info whose description is only created if the info is not dropped
+	/// because of the limits on the number of infos.
+	void info(ErrorId _error, SourceLocation const& _location, std::function<std::string()> const& _description);
+
 	void error(
 		ErrorId _error,
 		Error::Type _type,
@@ -137,6 +150,9 @@ public:
 	// @returns true if the maximum error count has been reached.
 	bool hasExcessiveErrors() const;
 
+	/// Stores at most @a _limit warnings and infos with the same error ID and drops the rest. Errors are never dropped. Zero means that there is no limit.
+	void setLimitPerErrorId(unsigned _limit) { m_limitPerErrorId = _limit; }
+
 	class ErrorWatcher
 	{
 	public:
@@ -181,13 +197,16 @@ private:
 		std::string const& _description = std::string());
 
 	// @returns true if error shouldn't be stored
-	bool checkForExcessiveErrors(Error::Type _type);
+	bool checkForExcessiveErrors(ErrorId _error, Error::Type _type);
 
 	ErrorList& m_errorList;
 
 	unsigned m_errorCount = 0;
 	unsigned m_warningCount = 0;
 	unsigned m_infoCount = 0;
+	unsigned m_limitPerErrorId = 0;
+	/// Number of warnings and infos reported per error ID, only counted if there is a limit.
+	std::unordered_map<unsigned long long, unsigned> m_countPerErrorId;
 
 	unsigned const c_maxWarningsAllowed = 256;
 	unsigned const c_maxErrorsAllowed = 256;
@@ -26,6 +26,7 @@
 #include <liblangutil/Token.h>
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace solidity::langutil
 {
@@ -80,7 +81,7 @@ protected:
 	Token currentToken() const;
 	Token peekNextToken() const;
 	std::string tokenName(Token _token);
-	std::string currentLiteral() const;
+	std::string_view currentLiteral() const;
 	virtual Token advance();
 	///@}
 
@@ -50,6 +50,7 @@
  * Solidity scanner.
  */
 
+#include <liblangutil/CharacterSearch.h>
 #include <liblangutil/Common.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/Scanner.h>
@@ -116,7 +117,7 @@ public:
 		if (_type == LITERAL_TYPE_COMMENT)
 			m_scanner->m_skippedComments[Scanner::NextNext].literal.clear();
 		else
-			m_scanner->m_tokens[Scanner::NextNext].literal.clear();
+			m_scanner->m_tokens[Scanner::NextNext].clearLiteral();
 	}
 	~LiteralScope()
 	{
@@ -125,7 +126,7 @@ public:
 			if (m_type == LITERAL_TYPE_COMMENT)
 				m_scanner->m_skippedComments[Scanner::NextNext].literal.clear();
 			else
-				m_scanner->m_tokens[Scanner::NextNext].literal.clear();
+				m_scanner->m_tokens[Scanner::NextNext].clearLiteral();
 		}
 	}
 	void complete() { m_complete = true; }
@@ -190,6 +191,32 @@ std::optional<unsigned> Scanner::scanUnicode()
 	return x;
 }
 
+void Scanner::addLiteralSourceChars(size_t _start, size_t _end)
+{
+	TokenDesc& token = m_tokens[NextNext];
+	if (token.literalIsSlice)
+	{
+		if (token.literalLength == 0)
+			token.literalStart = _start;
+		if (token.literalStart + token.literalLength == _start)
+		{
+			token.literalLength += _end - _start;
+			return;
+		}
+		ownLiteral();
+	}
+	token.literal.append(m_source.source().substr(_start, _end - _start));
+}
+
+void Scanner::ownLiteral()
+{
+	TokenDesc& token = m_tokens[NextNext];
+	if (!token.literalIsSlice)
+		return;
+	token.literal = string(m_source.source().substr(token.literalStart, token.literalLength));
+	token.literalIsSlice = false;
+}
+
 // This supports codepoints between 0000 and FFFF.
 void Scanner::addUnicodeAsUTF8(unsigned codepoint)
 {
@@ -248,8 +275,13 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 bool Scanner::skipWhitespace()
 {
 	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
+	// The current character has to be checked separately, since a multi-line comment
+	// replaces its last character by a space.
+	if (isWhiteSpace(m_char))
+	{
 		advance();
+		m_char = m_source.setPosition(findEndOfWhitespace(m_source.source(), sourcePos()));
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -287,7 +319,13 @@ static ScannerError validateBiDiMarkup(CharStream& _stream, size_t _startPositio
 
 	int directionOverrideDepth = 0;
 
-	for (size_t currentPos = _startPosition; currentPos < endPosition; ++currentPos)
+	// All sequences start with the same byte, so only positions where it occurs need to be checked.
+	string_view const text = _stream.source().substr(0, endPosition);
+	for (
+		size_t currentPos = findCharacter(text, _startPosition, '\xE2');
+		currentPos < endPosition;
+		currentPos = findCharacter(text, currentPos + 1, '\xE2')
+	)
 	{
 		_stream.setPosition(currentPos);
 
@@ -311,9 +349,14 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source.position();
-	while (!isUnicodeLinebreak())
-		if (!advance())
+	while (!isSourcePastEndOfInput())
+	{
+		// Skip everything that cannot be the start of a line break at once.
+		m_char = m_source.setPosition(findLineBreakCandidate(m_source.source(), sourcePos()));
+		if (isSourcePastEndOfInput() || isUnicodeLinebreak())
 			break;
+		advance();
+	}
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -393,13 +436,16 @@ Token Scanner::skipMultiLineComment()
 	size_t startPosition = m_source.position();
 	while (!isSourcePastEndOfInput())
 	{
-		char prevChar = m_char;
+		// Skip everything that cannot be the start of the end of the comment at once.
+		m_char = m_source.setPosition(findCharacter(m_source.source(), sourcePos(), '*'));
+		if (isSourcePastEndOfInput())
+			break;
 		advance();
 
 		// If we have reached the end of the multi-line comment, we
 		// consume the '/' and insert a whitespace. This way all
 		// multi-line comments are treated as whitespace.
-		if (prevChar == '*' && m_char == '/')
+		if (m_char == '/')
 		{
 			ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
 			if (unicodeDirectionError != ScannerError::NoError)
@@ -828,6 +874,7 @@ Token Scanner::scanString(bool const _isUnicode)
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	while (m_char != quote && !isSourcePastEndOfInput() && !isUnicodeLinebreak())
 	{
+		size_t const position = sourcePos();
 		char c = m_char;
 		advance();
 		if (c == '\\')
@@ -845,7 +892,7 @@ Token Scanner::scanString(bool const _isUnicode)
 			// any potential complications with locale.
 			if (!_isUnicode && (static_cast<unsigned>(c) <= 0x1f || static_cast<unsigned>(c) >= 0x7f))
 				return setError(ScannerError::IllegalCharacterInString);
-			addLiteralChar(c);
+			addLiteralSourceChar(position);
 		}
 	}
 	if (m_char != quote)
@@ -919,7 +966,7 @@ Token Scanner::scanNumber(char _charSeen)
 	if (_charSeen == '.')
 	{
 		// we have already seen a decimal point of the float
-		addLiteralChar('.');
+		addLiteralSourceChar(sourcePos() - 1);
 		if (m_char == '_')
 			return setError(ScannerError::IllegalToken);
 		scanDecimalDigits();  // we know we have at least one digit
@@ -1010,16 +1057,18 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
+	size_t const start = sourcePos();
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	size_t const end = findEndOfIdentifier(m_source.source(), start + 1, m_kind == ScannerKind::Yul);
+	addLiteralSourceChars(start, end);
+	m_char = m_source.setPosition(end);
 	literal.complete();
-	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
+	std::string_view const identifier = tokenLiteral(m_tokens[NextNext]);
+	auto const token = TokenTraits::fromIdentifierOrKeyword(identifier);
 	if (m_kind == ScannerKind::Yul)
 	{
 		// Turn Solidity identifier into a Yul keyword
-		if (m_tokens[NextNext].literal == "leave")
+		if (identifier == "leave")
 			return std::make_tuple(Token::Leave, 0, 0);
 		// Turn non-Yul keywords into identifiers.
 		if (!TokenTraits::isYulKeyword(std::get<0>(token)))
@@ -58,6 +58,7 @@
 
 #include <optional>
 #include <iosfwd>
+#include <string_view>
 
 namespace solidity::langutil
 {
@@ -102,7 +103,7 @@ class Scanner
 public:
 	explicit Scanner(CharStream& _source):
 		m_source(_source),
-		m_sourceName{std::make_shared<std::string>(_source.name())}
+		m_sourceName{internSourceName(_source.name())}
 	{
 		reset();
 	}
@@ -144,7 +145,8 @@ public:
 	}
 
 	SourceLocation currentLocation() const { return m_tokens[Current].location; }
-	std::string const& currentLiteral() const { return m_tokens[Current].literal; }
+	/// @returns the literal of the current token. The view is only valid until the scanner advances.
+	std::string_view currentLiteral() const { return tokenLiteral(m_tokens[Current]); }
 	std::tuple<unsigned, unsigned> const& currentTokenInfo() const { return m_tokens[Current].extendedTokenInfo; }
 
 	/// Retrieves the last error that occurred during lexical analysis.
@@ -168,7 +170,7 @@ public:
 	/// @returns the next token without advancing input.
 	Token peekNextToken() const { return m_tokens[Next].token; }
 	SourceLocation peekLocation() const { return m_tokens[Next].location; }
-	std::string const& peekLiteral() const { return m_tokens[Next].literal; }
+	std::string_view peekLiteral() const { return tokenLiteral(m_tokens[Next]); }
 
 	Token peekNextNextToken() const { return m_tokens[NextNext].token; }
 	///@}
@@ -186,17 +188,47 @@ private:
 	{
 		Token token;
 		SourceLocation location;
+		/// Literal of the token if it is not a slice of the source, i.e. for comments and
+		/// for string literals that contain escape sequences or are hex encoded.
 		std::string literal;
+		/// Start and length of the literal in the source, if @a literalIsSlice is set.
+		/// Identifiers, numbers and most string literals are stored this way without copying.
+		size_t literalStart = 0;
+		size_t literalLength = 0;
+		bool literalIsSlice = true;
 		ScannerError error = ScannerError::NoError;
 		std::tuple<unsigned, unsigned> extendedTokenInfo;
+
+		void clearLiteral()
+		{
+			literal.clear();
+			literalStart = 0;
+			literalLength = 0;
+			literalIsSlice = true;
+		}
 	};
 
+	/// @returns the literal of the token, either as a slice of the source or of its own storage.
+	std::string_view tokenLiteral(TokenDesc const& _token) const
+	{
+		if (_token.literalIsSlice)
+			return m_source.source().substr(_token.literalStart, _token.literalLength);
+		return _token.literal;
+	}
+
 	///@{
 	///@name Literal buffer support
-	inline void addLiteralChar(char c) { m_tokens[NextNext].literal.push_back(c); }
+	/// Appends a character that does not appear at this point in the source, e.g. a decoded escape sequence.
+	inline void addLiteralChar(char c) { ownLiteral(); m_tokens[NextNext].literal.push_back(c); }
+	/// Appends the source characters from @a _start up to (excluding) @a _end. Keeps the literal
+	/// a slice of the source as long as it consists of consecutive source characters.
+	void addLiteralSourceChars(size_t _start, size_t _end);
+	inline void addLiteralSourceChar(size_t _position) { addLiteralSourceChars(_position, _position + 1); }
 	inline void addCommentLiteralChar(char c) { m_skippedComments[NextNext].literal.push_back(c); }
-	inline void addLiteralCharAndAdvance() { addLiteralChar(m_char); advance(); }
+	inline void addLiteralCharAndAdvance() { addLiteralSourceChar(sourcePos()); advance(); }
 	void addUnicodeAsUTF8(unsigned codepoint);
+	/// Copies the literal of the token being scanned into its own storage, if it is still a slice.
+	void ownLiteral();
 	///@}
 
 	bool advance() { m_char = m_source.advanceAndGet(); return !m_source.isPastEndOfInput(); }
@@ -258,7 +290,7 @@ private:
 	TokenDesc m_tokens[3] = {}; // desc for the current, next and nextnext token
 
 	CharStream& m_source;
-	std::shared_ptr<std::string const> m_sourceName;
+	std::string const* m_sourceName;
 
 	ScannerKind m_kind = ScannerKind::Solidity;
 
@@ -22,12 +22,27 @@
 #include <boost/algorithm/string.hpp>
 
 #include <iostream>
+#include <mutex>
+#include <set>
 
 using namespace solidity;
 using namespace solidity::langutil;
 using namespace std;
 
-SourceLocation solidity::langutil::parseSourceLocation(string const& _input, vector<shared_ptr<string const>> const& _sourceNames)
+string const* solidity::langutil::internSourceName(string_view _sourceName)
+{
+	// Never destroyed, so that the names outlive all static objects that might refer to them.
+	static auto* names = new set<string, less<>>();
+	static mutex namesMutex;
+
+	lock_guard<mutex> lock(namesMutex);
+	auto it = names->find(_sourceName);
+	if (it == names->end())
+		it = names->emplace(_sourceName).first;
+	return &*it;
+}
+
+SourceLocation solidity::langutil::parseSourceLocation(string const& _input, vector<string const*> const& _sourceNames)
 {
 	// Expected input: "start:length:sourceindex"
 	enum SrcElem: size_t { Start, Length, Index };
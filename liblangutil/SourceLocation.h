@@ -24,14 +24,18 @@
 #pragma once
 
 #include <iosfwd>
-#include <memory>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
 namespace solidity::langutil
 {
 
+/// @returns a pointer to the unique copy of @a _sourceName. All calls with equal names return
+/// the same pointer, which stays valid until the end of the program. Thread-safe.
+std::string const* internSourceName(std::string_view _sourceName);
+
 /**
  * Representation of an interval of source positions.
  * The interval includes start and excludes end.
@@ -73,14 +77,8 @@ struct SourceLocation
 		return _other.start < end && start < _other.end;
 	}
 
-	bool equalSources(SourceLocation const& _other) const
-	{
-		if (!!sourceName != !!_other.sourceName)
-			return false;
-		if (sourceName && *sourceName != *_other.sourceName)
-			return false;
-		return true;
-	}
+	/// Source names are interned, so equal names have equal pointers.
+	bool equalSources(SourceLocation const& _other) const { return sourceName == _other.sourceName; }
 
 	bool isValid() const { return sourceName || start != -1 || end != -1; }
 
@@ -108,12 +106,14 @@ struct SourceLocation
 
 	int start = -1;
 	int end = -1;
-	std::shared_ptr<std::string const> sourceName;
+	/// Interned name of the source, see internSourceName(). Trivially copyable, so that copying
+	/// locations does not cost any reference counting.
+	std::string const* sourceName = nullptr;
 };
 
 SourceLocation parseSourceLocation(
 	std::string const& _input,
-	std::vector<std::shared_ptr<std::string const>> const& _sourceNames
+	std::vector<std::string const*> const& _sourceNames
 );
 
 /// Stream output for Location (used e.g. in boost exceptions).
@@ -43,6 +43,7 @@
 #include <liblangutil/Token.h>
 #include <liblangutil/Exceptions.h>
 #include <map>
+#include <string_view>
 
 using namespace std;
 
@@ -134,13 +135,13 @@ std::string friendlyName(Token tok)
 }
 
 
-static Token keywordByName(string const& _name)
+static Token keywordByName(string_view _name)
 {
 	// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
 	// and keywords to be put inside the keywords variable.
 #define KEYWORD(name, string, precedence) {string, Token::name},
 #define TOKEN(name, string, precedence)
-	static map<string, Token> const keywords({TOKEN_LIST(TOKEN, KEYWORD)});
+	static map<string, Token, less<>> const keywords({TOKEN_LIST(TOKEN, KEYWORD)});
 #undef KEYWORD
 #undef TOKEN
 	auto it = keywords.find(_name);
@@ -152,11 +153,11 @@ bool isYulKeyword(string const& _literal)
 	return _literal == "leave" || isYulKeyword(keywordByName(_literal));
 }
 
-tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string const& _literal)
+tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string_view _literal)
 {
 	// Used for `bytesM`, `uintM`, `intM`, `fixedMxN`, `ufixedMxN`.
 	// M/N must be shortest representation. M can never be 0. N can be zero.
-	auto parseSize = [](string::const_iterator _begin, string::const_iterator _end) -> int
+	auto parseSize = [](string_view::const_iterator _begin, string_view::const_iterator _end) -> int
 	{
 		// No number.
 		if (distance(_begin, _end) == 0)
@@ -183,7 +184,7 @@ tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string const& _
 	auto positionM = find_if(_literal.begin(), _literal.end(), ::isdigit);
 	if (positionM != _literal.end())
 	{
-		string baseType(_literal.begin(), positionM);
+		string_view baseType = _literal.substr(0, static_cast<size_t>(positionM - _literal.begin()));
 		auto positionX = find_if_not(positionM, _literal.end(), ::isdigit);
 		int m = parseSize(positionM, positionX);
 		Token keyword = keywordByName(baseType);
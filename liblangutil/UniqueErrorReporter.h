@@ -21,12 +21,17 @@
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/Exceptions.h>
 
+#include <boost/functional/hash.hpp>
+
+#include <unordered_map>
+
 namespace solidity::langutil
 {
 
 /*
  * Wrapper for ErrorReporter that removes duplicates.
  * Two errors are considered the same if their error ID and location are the same.
+ * Only a hash of the description of each error is kept to check that duplicates are identical.
  */
 class UniqueErrorReporter
 {
@@ -56,6 +61,23 @@ public:
 		}
 	}
 
+	/// Reports a warning whose description is only created if the warning is neither a duplicate
+	/// nor dropped because of the limits of the error reporter.
+	void warning(ErrorId _error, SourceLocation const& _location, std::function<std::string()> const& _description)
+	{
+		if (!m_seenErrors.count({_error, _location}))
+		{
+			size_t descriptionHash = 0;
+			m_errorReporter.warning(_error, _location, [&]() {
+				std::string description = _description();
+				descriptionHash = std::hash<std::string>{}(description);
+				return description;
+			});
+			if (_location != SourceLocation{})
+				m_seenErrors[{_error, _location}] = descriptionHash;
+		}
+	}
+
 	void warning(ErrorId _error, std::string const& _description)
 	{
 		m_errorReporter.warning(_error, _description);
@@ -77,9 +99,10 @@ public:
 
 	bool seen(ErrorId _error, SourceLocation const& _location, std::string const& _description) const
 	{
-		if (m_seenErrors.count({_error, _location}))
+		if (auto seenError = m_seenErrors.find({_error, _location}); seenError != m_seenErrors.end())
 		{
-			solAssert(m_seenErrors.at({_error, _location}) == _description, "");
+			// The hash is zero if the description was not created because the error was dropped.
+			solAssert(!seenError->second || seenError->second == std::hash<std::string>{}(_description), "");
 			return true;
 		}
 		return false;
@@ -88,7 +111,21 @@ public:
 	void markAsSeen(ErrorId _error, SourceLocation const& _location, std::string const& _description)
 	{
 		if (_location != SourceLocation{})
-			m_seenErrors[{_error, _location}] = _description;
+			m_seenErrors[{_error, _location}] = std::hash<std::string>{}(_description);
+	}
+
+	/// Appends the errors in @a _errors whose error ID and location were not reported before.
+	/// Unlike for reported errors, the descriptions of duplicates may differ, and the first one is kept.
+	void append(ErrorList const& _errors)
+	{
+		for (auto const& error: _errors)
+		{
+			SourceLocation location = error->sourceLocation() ? *error->sourceLocation() : SourceLocation{};
+			if (m_seenErrors.count({error->errorId(), location}))
+				continue;
+			m_errorReporter.append({error});
+			markAsSeen(error->errorId(), location, error->comment() ? *error->comment() : std::string{});
+		}
 	}
 
 	ErrorList const& errors() const { return m_errorReporter.errors(); }
@@ -98,7 +135,21 @@ public:
 private:
 	ErrorReporter m_errorReporter;
 	ErrorList m_uniqueErrors;
-	std::map<std::pair<ErrorId, SourceLocation>, std::string> m_seenErrors;
+	struct ErrorKeyHash
+	{
+		size_t operator()(std::pair<ErrorId, SourceLocation> const& _key) const
+		{
+			size_t seed = 0;
+			boost::hash_combine(seed, _key.first.error);
+			boost::hash_combine(seed, _key.second.start);
+			boost::hash_combine(seed, _key.second.end);
+			// Source names are interned, so equal names have equal addresses.
+			boost::hash_combine(seed, _key.second.sourceName);
+			return seed;
+		}
+	};
+	/// Hashes of the descriptions of the errors reported so far, by error ID and location.
+	std::unordered_map<std::pair<ErrorId, SourceLocation>, size_t, ErrorKeyHash> m_seenErrors;
 };
 
 }
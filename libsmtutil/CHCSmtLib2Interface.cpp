@@ -18,6 +18,9 @@
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+#include <libsmtutil/SolverProcess.h>
+
 #include <libsolutil/Keccak256.h>
 
 #include <boost/algorithm/string/join.hpp>
@@ -40,16 +43,20 @@ using namespace solidity::smtutil;
 CHCSmtLib2Interface::CHCSmtLib2Interface(
 	map<h256, string> const& _queryResponses,
 	ReadCallback::Callback _smtCallback,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	optional<string> _solverCommand
 ):
 	CHCSolverInterface(_queryTimeout),
 	m_smtlib2(make_unique<SMTLib2Interface>(_queryResponses, _smtCallback, m_queryTimeout)),
 	m_queryResponses(move(_queryResponses)),
-	m_smtCallback(_smtCallback)
+	m_smtCallback(_smtCallback),
+	m_solverCommand(move(_solverCommand))
 {
 	reset();
 }
 
+CHCSmtLib2Interface::~CHCSmtLib2Interface() = default;
+
 void CHCSmtLib2Interface::reset()
 {
 	m_accumulatedOutput.clear();
@@ -80,32 +87,28 @@ void CHCSmtLib2Interface::registerRelation(Expression const& _expr)
 
 void CHCSmtLib2Interface::addRule(Expression const& _expr, std::string const& /*_name*/)
 {
-	write(
-		"(assert\n(forall " + forall() + "\n" +
-		m_smtlib2->toSExpr(_expr) +
-		"))\n\n"
-	);
+	m_accumulatedOutput += "(assert\n(forall ";
+	m_accumulatedOutput += forall();
+	m_accumulatedOutput += '\n';
+	m_smtlib2->toSExpr(_expr, m_accumulatedOutput);
+	m_accumulatedOutput += "))\n\n\n";
 }
 
 tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::query(Expression const& _block)
 {
-	string accumulated{};
-	swap(m_accumulatedOutput, accumulated);
 	solAssert(m_smtlib2, "");
-	writeHeader();
+	// The declarations and rules are shared by all queries and only copied once into each query.
+	string query = header();
 	for (auto const& decl: m_smtlib2->userSorts() | ranges::views::values)
-		write(decl);
-	m_accumulatedOutput += accumulated;
-
-	string queryRule = "(assert\n(forall " + forall() + "\n" +
-		"(=> " + _block.name + " false)"
-		"))";
-	string response = querySolver(
-		m_accumulatedOutput +
-		queryRule +
-		"\n(check-sat)"
-	);
-	swap(m_accumulatedOutput, accumulated);
+	{
+		query += decl;
+		query += '\n';
+	}
+	string queryRule = "(assert\n(forall " + forall() + "\n(=> " + _block.name + " false)))\n(check-sat)";
+	query.reserve(query.size() + m_accumulatedOutput.size() + queryRule.size());
+	query += m_accumulatedOutput;
+	query += queryRule;
+	string response = querySolver(query);
 
 	CheckResult result;
 	// TODO proper parsing
@@ -149,11 +152,13 @@ string CHCSmtLib2Interface::toSmtLibSort(vector<SortPointer> const& _sorts)
 	return ssort;
 }
 
-void CHCSmtLib2Interface::writeHeader()
+string CHCSmtLib2Interface::header() const
 {
+	string header;
 	if (m_queryTimeout)
-		write("(set-option :timeout " + to_string(*m_queryTimeout) + ")");
-	write("(set-logic HORN)\n");
+		header += "(set-option :timeout " + to_string(*m_queryTimeout) + ")\n";
+	header += "(set-logic HORN)\n\n";
+	return header;
 }
 
 string CHCSmtLib2Interface::forall()
@@ -163,7 +168,13 @@ string CHCSmtLib2Interface::forall()
 	{
 		solAssert(sort, "");
 		if (sort->kind != Kind::Function)
-			vars += " (" + name + " " + toSmtLibSort(*sort) + ")";
+		{
+			vars += " (";
+			vars += name;
+			vars += ' ';
+			vars += toSmtLibSort(*sort);
+			vars += ')';
+		}
 	}
 	vars += ")";
 	return vars;
@@ -193,9 +204,10 @@ void CHCSmtLib2Interface::declareFunction(string const& _name, SortPointer const
 	}
 }
 
-void CHCSmtLib2Interface::write(string _data)
+void CHCSmtLib2Interface::write(string const& _data)
 {
-	m_accumulatedOutput += move(_data) + "\n";
+	m_accumulatedOutput += _data;
+	m_accumulatedOutput += '\n';
 }
 
 string CHCSmtLib2Interface::querySolver(string const& _input)
@@ -203,11 +215,42 @@ string CHCSmtLib2Interface::querySolver(string const& _input)
 	util::h256 inputHash = util::keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	// The solver behind the callback is not known, so its responses are only cached
+	// by the queries, which include the timeout option.
+	string const solver = QueryCache::solverConfiguration(
+		m_solverCommand ? "smtlib2 horn " + *m_solverCommand : "smtlib2 horn",
+		m_queryTimeout
+	);
+	if (m_queryCache)
+		if (optional<string> response = m_queryCache->lookup(solver, _input))
+			return *response;
+	if (m_solverCommand && !m_solverProcessStarted)
+	{
+		m_solverProcessStarted = true;
+		m_solverProcess = SolverProcess::start(*m_solverCommand);
+	}
+	if (m_solverProcess && m_solverProcess->running())
+	{
+		m_solverProcess->send("(reset)\n" + _input + "\n");
+		if (optional<string> response = m_solverProcess->receiveCheckResult())
+		{
+			if (m_queryCache && (*response == "sat\n" || *response == "unsat\n"))
+				m_queryCache->store(solver, _input, *response);
+			return *response;
+		}
+	}
 	if (m_smtCallback)
 	{
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
+		{
+			if (
+				m_queryCache &&
+				(boost::starts_with(result.responseOrErrorMessage, "sat") || boost::starts_with(result.responseOrErrorMessage, "unsat"))
+			)
+				m_queryCache->store(solver, _input, result.responseOrErrorMessage);
 			return result.responseOrErrorMessage;
+		}
 	}
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
@@ -29,14 +29,21 @@
 namespace solidity::smtutil
 {
 
+class SolverProcess;
+
 class CHCSmtLib2Interface: public CHCSolverInterface
 {
 public:
+	/// If @a _solverCommand is given, the solver it starts for the first query answers the queries
+	/// that have no given response instead of the callback. The solver is reset before each
+	/// query, since Horn solvers do not necessarily support incremental queries.
 	explicit CHCSmtLib2Interface(
 		std::map<util::h256, std::string> const& _queryResponses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		std::optional<std::string> _solverCommand = {}
 	);
+	~CHCSmtLib2Interface() override;
 
 	void reset();
 
@@ -58,12 +65,13 @@ private:
 	std::string toSmtLibSort(Sort const& _sort);
 	std::string toSmtLibSort(std::vector<SortPointer> const& _sort);
 
-	void writeHeader();
+	/// @returns the options and the logic that start every query.
+	std::string header() const;
 	std::string forall();
 
 	void declareFunction(std::string const& _name, SortPointer const& _sort);
 
-	void write(std::string _data);
+	void write(std::string const& _data);
 
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
 	std::string querySolver(std::string const& _input);
@@ -71,6 +79,7 @@ private:
 	/// Used to access toSmtLibSort, SExpr, and handle variables.
 	std::unique_ptr<SMTLib2Interface> m_smtlib2;
 
+	/// Declarations and rules, which are shared by all queries.
 	std::string m_accumulatedOutput;
 	std::set<std::string> m_variables;
 
@@ -80,6 +89,10 @@ private:
 	frontend::ReadCallback::Callback m_smtCallback;
 
 	std::map<Sort const*, std::string> m_sortNames;
+
+	std::optional<std::string> m_solverCommand;
+	bool m_solverProcessStarted = false;
+	std::unique_ptr<SolverProcess> m_solverProcess;
 };
 
 }
@@ -59,8 +59,16 @@ public:
 		Expression const& _expr
 	) = 0;
 
+	/// Sets the cache of the responses of the solver, which is not used if it is null.
+	void setQueryCache(std::shared_ptr<QueryCache const> _queryCache) { m_queryCache = std::move(_queryCache); }
+
+	/// Sets the timeout of the following queries in milliseconds.
+	/// Should only be used if the solver was created with a timeout.
+	virtual void setTimeout(unsigned _milliseconds) { m_queryTimeout = _milliseconds; }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
+	std::shared_ptr<QueryCache const> m_queryCache;
 };
 
 }
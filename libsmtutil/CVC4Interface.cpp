@@ -18,8 +18,11 @@
 
 #include <libsmtutil/CVC4Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/CommonIO.h>
 
+#include <cvc4/base/configuration.h>
 #include <cvc4/util/bitvector.h>
 
 using namespace std;
@@ -37,8 +40,10 @@ CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout):
 void CVC4Interface::reset()
 {
 	m_variables.clear();
+	m_translations.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
+	m_solver.setOption("produce-assertions", m_queryCache != nullptr);
 	if (m_queryTimeout)
 		m_solver.setTimeLimit(*m_queryTimeout);
 	else
@@ -58,6 +63,8 @@ void CVC4Interface::pop()
 void CVC4Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	if (m_variables.count(_name))
+		m_translations.clear();
 	m_variables[_name] = m_context.mkVar(_name.c_str(), cvc4Sort(*_sort));
 }
 
@@ -87,6 +94,18 @@ void CVC4Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	string const solver = QueryCache::solverConfiguration("cvc4 " + CVC4::Configuration::getVersionString(), m_queryTimeout);
+	string query;
+	if (m_queryCache)
+	{
+		for (CVC4::Expr const& assertion: m_solver.getAssertions())
+			query += "(assert " + assertion.toString() + ")\n";
+		for (Expression const& e: _expressionsToEvaluate)
+			query += "(get-value (" + toCVC4Expr(e).toString() + "))\n";
+		if (auto cachedResult = m_queryCache->lookupCheck(solver, query))
+			return *cachedResult;
+	}
+
 	CheckResult result;
 	vector<string> values;
 	try
@@ -118,10 +137,39 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 		values.clear();
 	}
 
+	if (m_queryCache)
+		m_queryCache->storeCheck(solver, query, {result, values});
 	return make_pair(result, values);
 }
 
+void CVC4Interface::setQueryCache(shared_ptr<QueryCache const> _queryCache)
+{
+	SolverInterface::setQueryCache(move(_queryCache));
+	reset();
+}
+
+void CVC4Interface::setTimeout(unsigned _milliseconds)
+{
+	SolverInterface::setTimeout(_milliseconds);
+	m_solver.setTimeLimit(_milliseconds);
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
+{
+	if (_expr.arguments.empty())
+		return translate(_expr);
+
+	auto key = make_pair(_expr.arguments.node().get(), _expr.name);
+	if (auto const* translation = valueOrNullptr(m_translations, key))
+		if (translation->sort == _expr.sort || *translation->sort == *_expr.sort)
+			return translation->expr;
+
+	CVC4::Expr result = translate(_expr);
+	m_translations.insert_or_assign(key, Translation{_expr.arguments.node(), _expr.sort, result});
+	return result;
+}
+
+CVC4::Expr CVC4Interface::translate(Expression const& _expr)
 {
 	// Variable
 	if (_expr.arguments.empty() && m_variables.count(_expr.name))
@@ -55,8 +55,15 @@ public:
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
+	/// Also resets the solver, since it only keeps the assertions for the cache if one is set.
+	void setQueryCache(std::shared_ptr<QueryCache const> _queryCache) override;
+
+	void setTimeout(unsigned _milliseconds) override;
+
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
+	/// Translates @a _expr without looking up the translations of its arguments.
+	CVC4::Expr translate(Expression const& _expr);
 	CVC4::Type cvc4Sort(Sort const& _sort);
 	std::vector<CVC4::Type> cvc4Sort(std::vector<SortPointer> const& _sorts);
 
@@ -64,6 +71,18 @@ private:
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
 
+	/// Translation of an expression with arguments, which is reused for all its copies.
+	struct Translation
+	{
+		/// Keeps the shared arguments alive, so that their address is not reused.
+		std::shared_ptr<std::vector<Expression> const> arguments;
+		SortPointer sort;
+		CVC4::Expr expr;
+	};
+	/// Translations of the expressions with arguments, indexed by the shared arguments and the name.
+	/// Cleared whenever a declaration is replaced.
+	std::map<std::pair<std::vector<Expression> const*, std::string>, Translation> m_translations;
+
 	// CVC4 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	// The tests start failing for CVC4 with less than 6000,
@@ -0,0 +1,406 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/QueryCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <random>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::smtutil;
+using namespace solidity::util;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// @returns @a _query with each sequence of whitespace replaced by a single space
+/// and without leading and trailing whitespace.
+string normalise(string const& _query)
+{
+	string normalised;
+	normalised.reserve(_query.size());
+	for (char c: _query)
+		if (!isspace(static_cast<unsigned char>(c)))
+			normalised.push_back(c);
+		else if (!normalised.empty() && normalised.back() != ' ')
+			normalised.push_back(' ');
+	if (!normalised.empty() && normalised.back() == ' ')
+		normalised.pop_back();
+	return normalised;
+}
+
+/// Thrown if a stored response is malformed, in which case it is ignored.
+struct MalformedResponse {};
+
+string resultToString(CheckResult _result)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE:
+		return "sat";
+	case CheckResult::UNSATISFIABLE:
+		return "unsat";
+	default:
+		return "unknown";
+	}
+}
+
+CheckResult resultFromJson(Json::Value const& _json)
+{
+	if (_json == "sat")
+		return CheckResult::SATISFIABLE;
+	else if (_json == "unsat")
+		return CheckResult::UNSATISFIABLE;
+	else if (_json == "unknown")
+		return CheckResult::UNKNOWN;
+	throw MalformedResponse{};
+}
+
+Json::Value sortToJson(Sort const& _sort)
+{
+	Json::Value json(Json::objectValue);
+	switch (_sort.kind)
+	{
+	case Kind::Int:
+		json["kind"] = "int";
+		if (auto const* intSort = dynamic_cast<IntSort const*>(&_sort))
+			json["signed"] = intSort->isSigned;
+		break;
+	case Kind::Bool:
+		json["kind"] = "bool";
+		break;
+	case Kind::BitVector:
+		json["kind"] = "bitvector";
+		if (auto const* bitVectorSort = dynamic_cast<BitVectorSort const*>(&_sort))
+			json["size"] = bitVectorSort->size;
+		break;
+	case Kind::Function:
+	{
+		auto const& functionSort = dynamic_cast<FunctionSort const&>(_sort);
+		json["kind"] = "function";
+		json["domain"] = Json::arrayValue;
+		for (SortPointer const& sort: functionSort.domain)
+			json["domain"].append(sortToJson(*sort));
+		json["codomain"] = sortToJson(*functionSort.codomain);
+		break;
+	}
+	case Kind::Array:
+	{
+		auto const& arraySort = dynamic_cast<ArraySort const&>(_sort);
+		json["kind"] = "array";
+		json["domain"] = sortToJson(*arraySort.domain);
+		json["range"] = sortToJson(*arraySort.range);
+		break;
+	}
+	case Kind::Sort:
+		json["kind"] = "sort";
+		json["inner"] = sortToJson(*dynamic_cast<SortSort const&>(_sort).inner);
+		break;
+	case Kind::Tuple:
+	{
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(_sort);
+		json["kind"] = "tuple";
+		json["name"] = tupleSort.name;
+		json["members"] = Json::arrayValue;
+		for (string const& member: tupleSort.members)
+			json["members"].append(member);
+		json["components"] = Json::arrayValue;
+		for (SortPointer const& sort: tupleSort.components)
+			json["components"].append(sortToJson(*sort));
+		break;
+	}
+	}
+	return json;
+}
+
+SortPointer sortFromJson(Json::Value const& _json)
+{
+	if (!_json.isObject() || !_json["kind"].isString())
+		throw MalformedResponse{};
+	string const kind = _json["kind"].asString();
+	if (kind == "int")
+	{
+		if (!_json.isMember("signed"))
+			return make_shared<Sort>(Kind::Int);
+		if (!_json["signed"].isBool())
+			throw MalformedResponse{};
+		return SortProvider::intSort(_json["signed"].asBool());
+	}
+	else if (kind == "bool")
+		return SortProvider::boolSort;
+	else if (kind == "bitvector")
+	{
+		if (!_json.isMember("size"))
+			return make_shared<Sort>(Kind::BitVector);
+		if (!_json["size"].isUInt())
+			throw MalformedResponse{};
+		return make_shared<BitVectorSort>(_json["size"].asUInt());
+	}
+	else if (kind == "function")
+	{
+		if (!_json["domain"].isArray())
+			throw MalformedResponse{};
+		vector<SortPointer> domain;
+		for (auto const& sort: _json["domain"])
+			domain.push_back(sortFromJson(sort));
+		return make_shared<FunctionSort>(move(domain), sortFromJson(_json["codomain"]));
+	}
+	else if (kind == "array")
+		return make_shared<ArraySort>(sortFromJson(_json["domain"]), sortFromJson(_json["range"]));
+	else if (kind == "sort")
+		return make_shared<SortSort>(sortFromJson(_json["inner"]));
+	else if (kind == "tuple")
+	{
+		if (!_json["name"].isString() || !_json["members"].isArray() || !_json["components"].isArray())
+			throw MalformedResponse{};
+		vector<string> members;
+		for (auto const& member: _json["members"])
+		{
+			if (!member.isString())
+				throw MalformedResponse{};
+			members.push_back(member.asString());
+		}
+		vector<SortPointer> components;
+		for (auto const& sort: _json["components"])
+			components.push_back(sortFromJson(sort));
+		if (members.size() != components.size())
+			throw MalformedResponse{};
+		return make_shared<TupleSort>(_json["name"].asString(), move(members), move(components));
+	}
+	throw MalformedResponse{};
+}
+
+Json::Value expressionToJson(Expression const& _expression)
+{
+	Json::Value json(Json::objectValue);
+	json["name"] = _expression.name;
+	json["sort"] = sortToJson(*_expression.sort);
+	if (!_expression.arguments.empty())
+	{
+		json["arguments"] = Json::arrayValue;
+		for (Expression const& argument: _expression.arguments)
+			json["arguments"].append(expressionToJson(argument));
+	}
+	return json;
+}
+
+Expression expressionFromJson(Json::Value const& _json)
+{
+	if (!_json.isObject() || !_json["name"].isString())
+		throw MalformedResponse{};
+	vector<Expression> arguments;
+	if (_json.isMember("arguments"))
+	{
+		if (!_json["arguments"].isArray())
+			throw MalformedResponse{};
+		for (auto const& argument: _json["arguments"])
+			arguments.push_back(expressionFromJson(argument));
+	}
+	return Expression(_json["name"].asString(), move(arguments), sortFromJson(_json["sort"]));
+}
+
+/// @returns the unsigned integer in the decimal string @a _key.
+unsigned indexFromKey(string const& _key)
+{
+	if (_key.empty() || _key.size() > 9 || !all_of(_key.begin(), _key.end(), [](char c) { return isdigit(static_cast<unsigned char>(c)); }))
+		throw MalformedResponse{};
+	return static_cast<unsigned>(stoul(_key));
+}
+
+}
+
+string QueryCache::solverConfiguration(string const& _solver, optional<unsigned> _queryTimeout)
+{
+	return _solver + (_queryTimeout ? " timeout " + to_string(*_queryTimeout) : " resource limit");
+}
+
+optional<string> QueryCache::lookup(string const& _solver, string const& _query) const
+{
+	if (m_mode == Mode::Record)
+		return nullopt;
+	try
+	{
+		fs::path file = path(_solver, _query);
+		if (fs::is_regular_file(file))
+			return readFileAsString(file);
+	}
+	catch (...)
+	{
+	}
+	return nullopt;
+}
+
+void QueryCache::store(string const& _solver, string const& _query, string const& _response) const
+{
+	if (m_mode == Mode::Replay)
+		return;
+	try
+	{
+		fs::path file = path(_solver, _query);
+		fs::create_directories(m_directory);
+		// Other compiler processes can store the same response at the same time,
+		// so the file is written under a unique name and then renamed atomically.
+		fs::path temporaryFile = file;
+		temporaryFile += "." + to_string(random_device{}()) + ".tmp";
+		{
+			ofstream output(temporaryFile.string(), ios::binary | ios::trunc);
+			output << _response;
+			if (!output)
+			{
+				fs::remove(temporaryFile);
+				return;
+			}
+		}
+		fs::rename(temporaryFile, file);
+	}
+	catch (...)
+	{
+	}
+}
+
+optional<pair<CheckResult, vector<string>>> QueryCache::lookupCheck(
+	string const& _solver,
+	string const& _query
+) const
+{
+	optional<string> response = lookup(_solver, _query);
+	Json::Value json;
+	if (!response || !jsonParseStrict(*response, json) || !json.isArray() || json.empty())
+		return nullopt;
+
+	pair<CheckResult, vector<string>> result;
+	try
+	{
+		result.first = resultFromJson(json[0]);
+	}
+	catch (MalformedResponse const&)
+	{
+		return nullopt;
+	}
+	for (Json::ArrayIndex i = 1; i < json.size(); ++i)
+	{
+		if (!json[i].isString())
+			return nullopt;
+		result.second.push_back(json[i].asString());
+	}
+	return result;
+}
+
+void QueryCache::storeCheck(
+	string const& _solver,
+	string const& _query,
+	pair<CheckResult, vector<string>> const& _result
+) const
+{
+	if (!storesResult(_result.first))
+		return;
+
+	Json::Value json(Json::arrayValue);
+	json.append(resultToString(_result.first));
+	for (string const& value: _result.second)
+		json.append(value);
+	store(_solver, _query, jsonCompactPrint(json));
+}
+
+optional<tuple<CheckResult, Expression, CHCSolverInterface::CexGraph>> QueryCache::lookupCHCQuery(
+	string const& _solver,
+	string const& _query
+) const
+{
+	optional<string> response = lookup(_solver, _query);
+	Json::Value json;
+	if (!response || !jsonParseStrict(*response, json) || !json.isObject())
+		return nullopt;
+
+	try
+	{
+		CheckResult result = resultFromJson(json["result"]);
+		Expression invariant = expressionFromJson(json["invariant"]);
+		CHCSolverInterface::CexGraph cex;
+		if (!json["nodes"].isObject() || !json["edges"].isObject())
+			throw MalformedResponse{};
+		for (string const& key: json["nodes"].getMemberNames())
+			cex.nodes.emplace(indexFromKey(key), expressionFromJson(json["nodes"][key]));
+		for (string const& key: json["edges"].getMemberNames())
+		{
+			if (!json["edges"][key].isArray())
+				throw MalformedResponse{};
+			vector<unsigned>& edges = cex.edges[indexFromKey(key)];
+			for (auto const& edge: json["edges"][key])
+			{
+				if (!edge.isUInt())
+					throw MalformedResponse{};
+				edges.push_back(edge.asUInt());
+			}
+		}
+		return tuple{result, move(invariant), move(cex)};
+	}
+	catch (MalformedResponse const&)
+	{
+		return nullopt;
+	}
+}
+
+void QueryCache::storeCHCQuery(
+	string const& _solver,
+	string const& _query,
+	tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> const& _result
+) const
+{
+	auto const& [result, invariant, cex] = _result;
+	if (!storesResult(result))
+		return;
+
+	Json::Value json(Json::objectValue);
+	json["result"] = resultToString(result);
+	json["invariant"] = expressionToJson(invariant);
+	json["nodes"] = Json::objectValue;
+	for (auto const& [id, node]: cex.nodes)
+		json["nodes"][to_string(id)] = expressionToJson(node);
+	json["edges"] = Json::objectValue;
+	for (auto const& [id, edges]: cex.edges)
+	{
+		Json::Value& edgesJson = json["edges"][to_string(id)] = Json::arrayValue;
+		for (unsigned edge: edges)
+			edgesJson.append(edge);
+	}
+	store(_solver, _query, jsonCompactPrint(json));
+}
+
+bool QueryCache::storesResult(CheckResult _result) const
+{
+	// Unknown results can depend on the machine if a timeout is used, and errors should be reported again.
+	return
+		_result == CheckResult::SATISFIABLE ||
+		_result == CheckResult::UNSATISFIABLE ||
+		(_result == CheckResult::UNKNOWN && m_mode == Mode::Record);
+}
+
+fs::path QueryCache::path(string const& _solver, string const& _query) const
+{
+	return m_directory / (keccak256(_solver + '\0' + normalise(_query)).hex() + ".smt");
+}
@@ -0,0 +1,107 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/SolverInterface.h>
+
+#include <boost/filesystem.hpp>
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Cache of the responses of SMT solvers that persists across compiler invocations.
+ * Each response is stored in its own file in a directory, named after the hash of the
+ * normalised query and of the configuration of the solver, i.e. its name, version and limits.
+ * Failures to read or write the files are ignored, since the cache is only an optimisation.
+ * The cache can be used by several threads and processes at the same time.
+ * The responses can also be recorded once and replayed afterwards, for example as test fixtures.
+ */
+class QueryCache
+{
+public:
+	enum class Mode
+	{
+		/// Stored responses are used and the other responses of the solvers are stored.
+		ReadWrite,
+		/// The solvers answer all queries and all their responses are stored, including unknown
+		/// results, which do not depend on the machine if no timeout is used.
+		Record,
+		/// Stored responses are used, but the responses of the solvers to the other queries are not stored.
+		Replay
+	};
+
+	explicit QueryCache(boost::filesystem::path _directory, Mode _mode = Mode::ReadWrite):
+		m_directory(std::move(_directory)),
+		m_mode(_mode)
+	{}
+
+	/// @returns the configuration of a solver with the name and version @a _solver that answers
+	/// queries within @a _queryTimeout milliseconds, or within its resource limit if it is not set.
+	static std::string solverConfiguration(std::string const& _solver, std::optional<unsigned> _queryTimeout);
+
+	/// @returns the response to @a _query stored for the solver configuration @a _solver, if any.
+	std::optional<std::string> lookup(std::string const& _solver, std::string const& _query) const;
+	/// Stores @a _response as the response to @a _query for the solver configuration @a _solver.
+	void store(std::string const& _solver, std::string const& _query, std::string const& _response) const;
+
+	/// @returns the result of a satisfiability check and the values of the evaluated expressions
+	/// stored by @a storeCheck, if any.
+	std::optional<std::pair<CheckResult, std::vector<std::string>>> lookupCheck(
+		std::string const& _solver,
+		std::string const& _query
+	) const;
+	/// Stores the result of a satisfiability check, unless the solver did not answer the query.
+	void storeCheck(
+		std::string const& _solver,
+		std::string const& _query,
+		std::pair<CheckResult, std::vector<std::string>> const& _result
+	) const;
+
+	/// @returns the result of a CHC query together with its invariant and counterexample graph
+	/// stored by @a storeCHCQuery, if any.
+	std::optional<std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph>> lookupCHCQuery(
+		std::string const& _solver,
+		std::string const& _query
+	) const;
+	/// Stores the result of a CHC query, unless the solver did not answer it.
+	void storeCHCQuery(
+		std::string const& _solver,
+		std::string const& _query,
+		std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> const& _result
+	) const;
+
+private:
+	boost::filesystem::path path(std::string const& _solver, std::string const& _query) const;
+
+	/// @returns true if a result of a check should be stored.
+	bool storesResult(CheckResult _result) const;
+
+	boost::filesystem::path m_directory;
+	Mode m_mode = Mode::ReadWrite;
+};
+
+}
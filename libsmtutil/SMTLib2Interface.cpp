@@ -18,9 +18,11 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+#include <libsmtutil/SolverProcess.h>
+
 #include <libsolutil/Keccak256.h>
 
-#include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <range/v3/algorithm/find_if.hpp>
@@ -42,19 +44,25 @@ using namespace solidity::smtutil;
 SMTLib2Interface::SMTLib2Interface(
 	map<h256, string> _queryResponses,
 	ReadCallback::Callback _smtCallback,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	optional<string> _solverCommand
 ):
 	SolverInterface(_queryTimeout),
 	m_queryResponses(move(_queryResponses)),
-	m_smtCallback(move(_smtCallback))
+	m_smtCallback(move(_smtCallback)),
+	m_solverCommand(move(_solverCommand))
 {
 	reset();
 }
 
+SMTLib2Interface::~SMTLib2Interface() = default;
+
 void SMTLib2Interface::reset()
 {
+	if (m_solverProcess)
+		m_solverProcess->send("(reset)\n");
 	m_accumulatedOutput.clear();
-	m_accumulatedOutput.emplace_back();
+	m_scopeStarts.clear();
 	m_variables.clear();
 	m_userSorts.clear();
 	write("(set-option :produce-models true)");
@@ -65,13 +73,25 @@ void SMTLib2Interface::reset()
 
 void SMTLib2Interface::push()
 {
-	m_accumulatedOutput.emplace_back();
+	m_scopeStarts.push_back(m_accumulatedOutput.size());
+	m_accumulatedOutput += '\n';
+	if (m_solverProcess)
+		m_solverProcess->send("(push 1)\n");
 }
 
 void SMTLib2Interface::pop()
 {
-	smtAssert(!m_accumulatedOutput.empty(), "");
-	m_accumulatedOutput.pop_back();
+	smtAssert(!m_scopeStarts.empty(), "");
+	m_accumulatedOutput.resize(m_scopeStarts.back());
+	m_scopeStarts.pop_back();
+	if (m_solverProcess)
+		m_solverProcess->send("(pop 1)\n");
+}
+
+void SMTLib2Interface::setTimeout(unsigned _milliseconds)
+{
+	SolverInterface::setTimeout(_milliseconds);
+	write("(set-option :timeout " + to_string(_milliseconds) + ")");
 }
 
 void SMTLib2Interface::declareVariable(string const& _name, SortPointer const& _sort)
@@ -111,15 +131,21 @@ void SMTLib2Interface::declareFunction(string const& _name, SortPointer const& _
 
 void SMTLib2Interface::addAssertion(Expression const& _expr)
 {
-	write("(assert " + toSExpr(_expr) + ")");
+	// The expression is emitted into its own buffer, since emitting it can declare sorts.
+	string assertion = "(assert ";
+	toSExpr(_expr, assertion);
+	assertion += ')';
+	write(assertion);
 }
 
 pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	string command = checkSatAndGetValuesCommand(_expressionsToEvaluate);
+	string query;
+	query.reserve(m_accumulatedOutput.size() + command.size());
+	query += m_accumulatedOutput;
+	query += command;
+	string response = querySolver(query, command, !_expressionsToEvaluate.empty());
 
 	CheckResult result;
 	// TODO proper parsing
@@ -139,43 +165,48 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> con
 }
 
 string SMTLib2Interface::toSExpr(Expression const& _expr)
+{
+	string sexpr;
+	toSExpr(_expr, sexpr);
+	return sexpr;
+}
+
+void SMTLib2Interface::toSExpr(Expression const& _expr, string& _output)
 {
 	if (_expr.arguments.empty())
-		return _expr.name;
+	{
+		_output += _expr.name;
+		return;
+	}
 
-	std::string sexpr = "(";
 	if (_expr.name == "int2bv")
 	{
 		size_t size = std::stoul(_expr.arguments[1].name);
-		auto arg = toSExpr(_expr.arguments.front());
-		auto int2bv = "(_ int2bv " + to_string(size) + ")";
+		string arg = toSExpr(_expr.arguments.front());
+		string int2bv = "(_ int2bv " + to_string(size) + ")";
 		// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
-		sexpr += string("ite ") +
-			"(>= " + arg + " 0) " +
-			"(" + int2bv + " " + arg + ") " +
-			"(bvneg (" + int2bv + " (- " + arg + ")))";
+		_output += "(ite (>= " + arg + " 0) (" + int2bv + " " + arg + ") (bvneg (" + int2bv + " (- " + arg + "))))";
 	}
 	else if (_expr.name == "bv2int")
 	{
 		auto intSort = dynamic_pointer_cast<IntSort>(_expr.sort);
 		smtAssert(intSort, "");
 
-		auto arg = toSExpr(_expr.arguments.front());
-		auto nat = "(bv2nat " + arg + ")";
+		string arg = toSExpr(_expr.arguments.front());
+		string nat = "(bv2nat " + arg + ")";
 
 		if (!intSort->isSigned)
-			return nat;
+		{
+			_output += nat;
+			return;
+		}
 
 		auto bvSort = dynamic_pointer_cast<BitVectorSort>(_expr.arguments.front().sort);
 		smtAssert(bvSort, "");
-		auto size = to_string(bvSort->size);
 		auto pos = to_string(bvSort->size - 1);
 
 		// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
-		sexpr += string("ite ") +
-			"(= ((_ extract " + pos + " " + pos + ")" + arg + ") #b0) " +
-			nat + " " +
-			"(- (bv2nat (bvneg " + arg + ")))";
+		_output += "(ite (= ((_ extract " + pos + " " + pos + ")" + arg + ") #b0) " + nat + " (- (bv2nat (bvneg " + arg + "))))";
 	}
 	else if (_expr.name == "const_array")
 	{
@@ -184,8 +215,11 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 		smtAssert(sortSort, "");
 		auto arraySort = dynamic_pointer_cast<ArraySort>(sortSort->inner);
 		smtAssert(arraySort, "");
-		sexpr += "(as const " + toSmtLibSort(*arraySort) + ") ";
-		sexpr += toSExpr(_expr.arguments.at(1));
+		_output += "((as const ";
+		_output += toSmtLibSort(*arraySort);
+		_output += ") ";
+		toSExpr(_expr.arguments.at(1), _output);
+		_output += ')';
 	}
 	else if (_expr.name == "tuple_get")
 	{
@@ -193,24 +227,32 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.arguments.at(0).sort);
 		size_t index = std::stoul(_expr.arguments.at(1).name);
 		smtAssert(index < tupleSort->members.size(), "");
-		sexpr += "|" + tupleSort->members.at(index) + "| " + toSExpr(_expr.arguments.at(0));
-	}
-	else if (_expr.name == "tuple_constructor")
-	{
-		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.sort);
-		smtAssert(tupleSort, "");
-		sexpr += "|" + tupleSort->name + "|";
-		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+		_output += "(|";
+		_output += tupleSort->members.at(index);
+		_output += "| ";
+		toSExpr(_expr.arguments.at(0), _output);
+		_output += ')';
 	}
 	else
 	{
-		sexpr += _expr.name;
+		_output += '(';
+		if (_expr.name == "tuple_constructor")
+		{
+			auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.sort);
+			smtAssert(tupleSort, "");
+			_output += '|';
+			_output += tupleSort->name;
+			_output += '|';
+		}
+		else
+			_output += _expr.name;
 		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+		{
+			_output += ' ';
+			toSExpr(arg, _output);
+		}
+		_output += ')';
 	}
-	sexpr += ")";
-	return sexpr;
 }
 
 string SMTLib2Interface::toSmtLibSort(Sort const& _sort)
@@ -261,10 +303,12 @@ string SMTLib2Interface::toSmtLibSort(vector<SortPointer> const& _sorts)
 	return ssort;
 }
 
-void SMTLib2Interface::write(string _data)
+void SMTLib2Interface::write(string const& _data)
 {
-	smtAssert(!m_accumulatedOutput.empty(), "");
-	m_accumulatedOutput.back() += move(_data) + "\n";
+	m_accumulatedOutput += _data;
+	m_accumulatedOutput += '\n';
+	if (m_solverProcess)
+		m_solverProcess->send(_data + '\n');
 }
 
 string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _expressionsToEvaluate)
@@ -280,7 +324,9 @@ string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _
 			auto const& e = _expressionsToEvaluate.at(i);
 			smtAssert(e.sort->kind == Kind::Int || e.sort->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
 			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort->kind == Kind::Int ? "Int" : "Bool") + ")\n";
-			command += "(assert (= |EVALEXPR_" + to_string(i) + "| " + toSExpr(e) + "))\n";
+			command += "(assert (= |EVALEXPR_" + to_string(i) + "| ";
+			toSExpr(e, command);
+			command += "))\n";
 		}
 		command += "(check-sat)\n";
 		command += "(get-value (";
@@ -308,17 +354,77 @@ vector<string> SMTLib2Interface::parseValues(string::const_iterator _start, stri
 	return values;
 }
 
-string SMTLib2Interface::querySolver(string const& _input)
+string SMTLib2Interface::querySolver(string const& _input, string const& _checkCommand, bool _readValues)
 {
 	h256 inputHash = keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	// The solver behind the callback is not known, so its responses are only cached
+	// by the queries, which include the timeout option.
+	string const solver = QueryCache::solverConfiguration(
+		m_solverCommand ? "smtlib2 " + *m_solverCommand : "smtlib2",
+		m_queryTimeout
+	);
+	if (m_queryCache)
+		if (optional<string> response = m_queryCache->lookup(solver, _input))
+			return *response;
+	if (solverProcess())
+		if (optional<string> response = querySolverProcess(_checkCommand, _readValues))
+		{
+			if (m_queryCache && (*response == "sat\n" || *response == "unsat\n"))
+				m_queryCache->store(solver, _input, *response);
+			return *response;
+		}
 	if (m_smtCallback)
 	{
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
+		{
+			if (
+				m_queryCache &&
+				(boost::starts_with(result.responseOrErrorMessage, "sat") || boost::starts_with(result.responseOrErrorMessage, "unsat"))
+			)
+				m_queryCache->store(solver, _input, result.responseOrErrorMessage);
 			return result.responseOrErrorMessage;
+		}
 	}
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
 }
+
+SolverProcess* SMTLib2Interface::solverProcess()
+{
+	if (m_solverCommand && !m_solverProcessStarted)
+	{
+		m_solverProcessStarted = true;
+		m_solverProcess = SolverProcess::start(*m_solverCommand);
+		if (m_solverProcess)
+		{
+			size_t scopeEnd = 0;
+			for (size_t scopeStart: m_scopeStarts)
+			{
+				m_solverProcess->send(m_accumulatedOutput.substr(scopeEnd, scopeStart - scopeEnd) + "(push 1)\n");
+				scopeEnd = scopeStart;
+			}
+			m_solverProcess->send(m_accumulatedOutput.substr(scopeEnd));
+		}
+	}
+	return m_solverProcess && m_solverProcess->running() ? m_solverProcess.get() : nullptr;
+}
+
+optional<string> SMTLib2Interface::querySolverProcess(string const& _checkCommand, bool _readValues)
+{
+	smtAssert(m_solverProcess, "");
+	// The expressions to evaluate are declared in the scope of the check only.
+	m_solverProcess->send("(push 1)\n" + _checkCommand);
+	optional<string> response = m_solverProcess->receiveCheckResult();
+	if (response && *response == "sat\n" && _readValues)
+	{
+		optional<string> values = m_solverProcess->receive();
+		if (!values)
+			return nullopt;
+		*response += *values;
+	}
+	m_solverProcess->send("(pop 1)\n");
+	return response;
+}
@@ -34,6 +34,8 @@
 namespace solidity::smtutil
 {
 
+class SolverProcess;
+
 class SMTLib2Interface: public SolverInterface
 {
 public:
@@ -41,11 +43,16 @@ public:
 	SMTLib2Interface(SMTLib2Interface const&) = delete;
 	SMTLib2Interface& operator=(SMTLib2Interface const&) = delete;
 
+	/// If @a _solverCommand is given, the solver it starts answers the queries that have no given
+	/// response instead of the callback. The solver is started for the first such query, and
+	/// afterwards the declarations and assertions are sent to it as they are made.
 	explicit SMTLib2Interface(
 		std::map<util::h256, std::string> _queryResponses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		std::optional<std::string> _solverCommand = {}
 	);
+	~SMTLib2Interface() override;
 
 	void reset() override;
 
@@ -59,27 +66,47 @@ public:
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
 
+	/// Emits the timeout as an option, which only applies to the current scope of the output.
+	void setTimeout(unsigned _milliseconds) override;
+
 	// Used by CHCSmtLib2Interface
 	std::string toSExpr(Expression const& _expr);
+	/// Appends the S-expression of @a _expr to @a _output, which must not be the output
+	/// of this interface, since emitting the expression can declare sorts.
+	void toSExpr(Expression const& _expr, std::string& _output);
 	std::string toSmtLibSort(Sort const& _sort);
 	std::string toSmtLibSort(std::vector<SortPointer> const& _sort);
 
-	std::map<std::string, SortPointer> variables() { return m_variables; }
+	std::map<std::string, SortPointer> const& variables() const { return m_variables; }
 
 	std::vector<std::pair<std::string, std::string>> const& userSorts() const { return m_userSorts; }
 
 private:
 	void declareFunction(std::string const& _name, SortPointer const& _sort);
 
-	void write(std::string _data);
+	void write(std::string const& _data);
 
 	std::string checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
 	std::vector<std::string> parseValues(std::string::const_iterator _start, std::string::const_iterator _end);
 
-	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
-	std::string querySolver(std::string const& _input);
-
-	std::vector<std::string> m_accumulatedOutput;
+	/// Communicates with the solver process if there is one, and via the callback otherwise.
+	/// @a _input is the full query, @a _checkCommand its part that checks the assertions sent
+	/// to the solver process, and @a _readValues is true if the check evaluates expressions.
+	/// Throws SMTSolverError on error.
+	std::string querySolver(std::string const& _input, std::string const& _checkCommand, bool _readValues);
+
+	/// Starts the solver process with the declarations, assertions and scopes made so far,
+	/// unless it was already started.
+	/// @returns the solver process, or nullptr if there is none or it terminated.
+	SolverProcess* solverProcess();
+	/// Sends @a _checkCommand to the solver process in its own scope.
+	/// @returns its response, or nullopt if the solver process terminated.
+	std::optional<std::string> querySolverProcess(std::string const& _checkCommand, bool _readValues);
+
+	/// Declarations and assertions of all scopes, which form the prefix of every query.
+	std::string m_accumulatedOutput;
+	/// For each scope, the size of the output before it.
+	std::vector<size_t> m_scopeStarts;
 	std::map<std::string, SortPointer> m_variables;
 
 	/// Each pair in this vector represents an SMTChecker created
@@ -92,6 +119,10 @@ private:
 	std::vector<std::string> m_unhandledQueries;
 
 	frontend::ReadCallback::Callback m_smtCallback;
+
+	std::optional<std::string> m_solverCommand;
+	bool m_solverProcessStarted = false;
+	std::unique_ptr<SolverProcess> m_solverProcess;
 };
 
 }
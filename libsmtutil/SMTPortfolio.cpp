@@ -26,6 +26,9 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Timing.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -36,12 +39,20 @@ SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	size_t _parallelism,
+	optional<string> _externalSolver
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_parallelism(_parallelism)
 {
 	if (_enabledSolvers.smtlib2)
-		m_solvers.emplace_back(make_unique<SMTLib2Interface>(move(_smtlib2Responses), move(_smtCallback), m_queryTimeout));
+		m_solvers.emplace_back(make_unique<SMTLib2Interface>(
+			move(_smtlib2Responses),
+			move(_smtCallback),
+			m_queryTimeout,
+			move(_externalSolver)
+		));
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3 && Z3Interface::available())
 		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout));
@@ -112,16 +123,70 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * The solvers are queried in parallel if allowed by m_parallelism, which reduces the time
+ * of the query to that of the slowest solver. The results are still combined in the order
+ * of the solvers, so the result and the model do not depend on which solver is faster.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
+{
+	vector<pair<CheckResult, vector<string>>> results(m_solvers.size());
+	parallelFor(m_solvers.size(), m_parallelism, [&](size_t _index) {
+		util::ScopedTraceSpan span("SMT query", "smt");
+		results[_index] = m_solvers[_index]->check(_expressionsToEvaluate);
+	});
+	return combineResults(move(results));
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::checkWithPrefix(
+	Expression const& _query,
+	vector<Expression> const& _prefix,
+	Expression const& _condition,
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	vector<pair<CheckResult, vector<string>>> results(m_solvers.size());
+	parallelFor(m_solvers.size(), m_parallelism, [&](size_t _index) {
+		util::ScopedTraceSpan span("SMT query", "smt");
+		results[_index] = m_solvers[_index]->checkWithPrefix(_query, _prefix, _condition, _expressionsToEvaluate);
+	});
+	return combineResults(move(results));
+}
+
+vector<string> SMTPortfolio::unhandledQueries()
+{
+	// This code assumes that the constructor guarantees that
+	// SmtLib2Interface is in position 0, if enabled.
+	if (!m_solvers.empty())
+		if (auto smtlib2 = dynamic_cast<SMTLib2Interface*>(m_solvers.front().get()))
+			return smtlib2->unhandledQueries();
+	return {};
+}
+
+void SMTPortfolio::setQueryCache(shared_ptr<QueryCache const> _queryCache)
+{
+	for (auto& solver: m_solvers)
+		solver->setQueryCache(_queryCache);
+}
+
+void SMTPortfolio::setTimeout(unsigned _milliseconds)
+{
+	SolverInterface::setTimeout(_milliseconds);
+	for (auto& solver: m_solvers)
+		solver->setTimeout(_milliseconds);
+}
+
+bool SMTPortfolio::solverAnswered(CheckResult result)
+{
+	return result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE;
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::combineResults(vector<pair<CheckResult, vector<string>>> _results)
 {
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	for (auto& [result, values]: _results)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
 		if (solverAnswered(result))
 		{
 			if (!solverAnswered(lastResult))
@@ -140,18 +205,3 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const&
 	}
 	return make_pair(lastResult, finalValues);
 }
-
-vector<string> SMTPortfolio::unhandledQueries()
-{
-	// This code assumes that the constructor guarantees that
-	// SmtLib2Interface is in position 0, if enabled.
-	if (!m_solvers.empty())
-		if (auto smtlib2 = dynamic_cast<SMTLib2Interface*>(m_solvers.front().get()))
-			return smtlib2->unhandledQueries();
-	return {};
-}
-
-bool SMTPortfolio::solverAnswered(CheckResult result)
-{
-	return result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE;
-}
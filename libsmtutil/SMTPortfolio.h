@@ -33,7 +33,8 @@ namespace solidity::smtutil
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
- * to SMT queries.
+ * to SMT queries. The solvers can be queried in parallel, since each
+ * of them only works on its own state.
  */
 class SMTPortfolio: public SolverInterface
 {
@@ -46,7 +47,9 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		size_t _parallelism = 1,
+		std::optional<std::string> _externalSolver = {}
 	);
 
 	void reset() override;
@@ -59,13 +62,27 @@ public:
 	void addAssertion(Expression const& _expr) override;
 
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	std::pair<CheckResult, std::vector<std::string>> checkWithPrefix(
+		Expression const& _query,
+		std::vector<Expression> const& _prefix,
+		Expression const& _condition,
+		std::vector<Expression> const& _expressionsToEvaluate
+	) override;
 
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
+	void setQueryCache(std::shared_ptr<QueryCache const> _queryCache) override;
+	void setTimeout(unsigned _milliseconds) override;
 private:
 	static bool solverAnswered(CheckResult result);
+	/// @returns a single result from the results of the solvers, as explained in `check`.
+	static std::pair<CheckResult, std::vector<std::string>> combineResults(
+		std::vector<std::pair<CheckResult, std::vector<std::string>>> _results
+	);
 
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	/// Maximum number of solvers that are queried at the same time.
+	size_t m_parallelism = 1;
 
 	std::vector<Expression> m_assertions;
 };
@@ -0,0 +1,120 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/Slicing.h>
+
+#include <cctype>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::smtutil;
+
+namespace
+{
+
+/// @returns true if @a _name is the name of a literal or of an operator of the theories
+/// instead of a variable or an uninterpreted function.
+bool isInterpreted(string const& _name)
+{
+	static set<string, less<>> const operators{
+		"ite", "not", "and", "or", "=>", "=", "<", "<=", ">", ">=", "+", "-", "*", "div", "mod",
+		"bvnot", "bvand", "bvor", "bvxor", "bvshl", "bvlshr", "bvashr", "int2bv", "bv2int",
+		"select", "store", "const_array", "tuple_get", "tuple_constructor", "true", "false"
+	};
+	return _name.empty() || isdigit(static_cast<unsigned char>(_name.front())) || operators.count(_name);
+}
+
+/// Assigns indices to the symbols of expressions and joins the symbols that occur in the same
+/// expression into one set.
+class SymbolSets
+{
+public:
+	/// Joins the symbols of @a _expression into one set.
+	/// @returns the index of one of the symbols or nullopt if there are none.
+	optional<size_t> join(Expression const& _expression)
+	{
+		optional<size_t> first;
+		// Copies of an expression share their arguments, which are only visited once.
+		unordered_set<vector<Expression> const*> visited;
+		vector<Expression const*> stack{&_expression};
+		while (!stack.empty())
+		{
+			Expression const* expression = stack.back();
+			stack.pop_back();
+			if (!isInterpreted(expression->name))
+			{
+				size_t symbol = index(expression->name);
+				if (first)
+					unite(*first, symbol);
+				else
+					first = symbol;
+			}
+			if (auto const& arguments = expression->arguments.node(); arguments && visited.insert(arguments.get()).second)
+				for (Expression const& argument: *arguments)
+					stack.push_back(&argument);
+		}
+		return first;
+	}
+
+	size_t find(size_t _symbol)
+	{
+		while (m_parent[_symbol] != _symbol)
+			_symbol = m_parent[_symbol] = m_parent[m_parent[_symbol]];
+		return _symbol;
+	}
+
+private:
+	size_t index(string const& _name)
+	{
+		auto [it, inserted] = m_indices.try_emplace(_name, m_parent.size());
+		if (inserted)
+			m_parent.push_back(it->second);
+		return it->second;
+	}
+
+	void unite(size_t _a, size_t _b)
+	{
+		m_parent[find(_a)] = find(_b);
+	}
+
+	unordered_map<string, size_t> m_indices;
+	vector<size_t> m_parent;
+};
+
+}
+
+vector<Expression> smtutil::sliceConjuncts(vector<Expression> const& _conjuncts, Expression const& _target)
+{
+	SymbolSets symbols;
+	vector<optional<size_t>> conjunctSymbols;
+	conjunctSymbols.reserve(_conjuncts.size());
+	for (Expression const& conjunct: _conjuncts)
+		conjunctSymbols.emplace_back(symbols.join(conjunct));
+	optional<size_t> targetSymbol = symbols.join(_target);
+
+	vector<Expression> slice;
+	for (size_t i = 0; i < _conjuncts.size(); ++i)
+		if (!conjunctSymbols[i] || (targetSymbol && symbols.find(*conjunctSymbols[i]) == symbols.find(*targetSymbol)))
+			slice.push_back(_conjuncts[i]);
+	return slice;
+}
@@ -0,0 +1,36 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/// @returns the conjuncts of @a _conjuncts in their original order that share a variable or
+/// an uninterpreted function with @a _target, directly or through other returned conjuncts,
+/// together with the conjuncts without any variables.
+/// If the returned conjuncts together with the target are unsatisfiable, so are all conjuncts
+/// together with the target. The converse does not hold, since the dropped conjuncts can be
+/// unsatisfiable on their own.
+std::vector<Expression> sliceConjuncts(std::vector<Expression> const& _conjuncts, Expression const& _target);
+
+}
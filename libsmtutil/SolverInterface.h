@@ -39,6 +39,8 @@
 namespace solidity::smtutil
 {
 
+class QueryCache;
+
 struct SMTSolverChoice
 {
 	bool cvc4 = false;
@@ -116,10 +118,53 @@ enum class CheckResult
 };
 
 /// C++ representation of an SMTLIB2 expression.
+/// The arguments of an expression are immutable and shared between its copies, so that
+/// copying an expression is cheap and the subterms of larger expressions form a DAG.
 class Expression
 {
 	friend class SolverInterface;
 public:
+	/// Immutable list of the arguments of an expression that is shared between its copies.
+	class Arguments
+	{
+	public:
+		using value_type = Expression;
+		using const_iterator = std::vector<Expression>::const_iterator;
+
+		Arguments() = default;
+		Arguments(std::vector<Expression> _arguments):
+			m_arguments(
+				_arguments.empty() ?
+				nullptr :
+				std::make_shared<std::vector<Expression> const>(std::move(_arguments))
+			)
+		{}
+
+		operator std::vector<Expression> const&() const { return m_arguments ? *m_arguments : noArguments(); }
+
+		size_t size() const { return m_arguments ? m_arguments->size() : 0; }
+		bool empty() const { return !m_arguments; }
+		Expression const& at(size_t _index) const { return static_cast<std::vector<Expression> const&>(*this).at(_index); }
+		Expression const& operator[](size_t _index) const { return (*m_arguments)[_index]; }
+		Expression const& front() const { return m_arguments->front(); }
+		Expression const& back() const { return m_arguments->back(); }
+		const_iterator begin() const { return static_cast<std::vector<Expression> const&>(*this).begin(); }
+		const_iterator end() const { return static_cast<std::vector<Expression> const&>(*this).end(); }
+
+		/// @returns the shared list, which identifies the arguments of all copies of an expression,
+		/// or nullptr if there are no arguments.
+		std::shared_ptr<std::vector<Expression> const> const& node() const { return m_arguments; }
+
+	private:
+		static std::vector<Expression> const& noArguments()
+		{
+			static std::vector<Expression> const empty;
+			return empty;
+		}
+
+		std::shared_ptr<std::vector<Expression> const> m_arguments;
+	};
+
 	explicit Expression(bool _v): Expression(_v ? "true" : "false", Kind::Bool) {}
 	explicit Expression(std::shared_ptr<SortSort> _sort, std::string _name = ""): Expression(std::move(_name), {}, _sort) {}
 	explicit Expression(std::string _name, std::vector<Expression> _arguments, SortPointer _sort):
@@ -486,7 +531,7 @@ public:
 	}
 
 	std::string name;
-	std::vector<Expression> arguments;
+	Arguments arguments;
 	SortPointer sort;
 
 private:
@@ -531,14 +576,41 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Checks for satisfiability of @a _query together with the assertions, evaluates the expressions
+	/// if a model is available, and removes @a _query again. Throws SMTSolverError on error.
+	/// @a _query has to be equivalent to the conjunction of @a _prefix and @a _condition.
+	/// Incremental solvers can keep the conjuncts of @a _prefix, ordered from the oldest to the newest,
+	/// asserted between calls and only assert the conjuncts that differ from the previous call.
+	/// By default, @a _query is asserted in its own scope.
+	virtual std::pair<CheckResult, std::vector<std::string>> checkWithPrefix(
+		Expression const& _query,
+		std::vector<Expression> const& /*_prefix*/,
+		Expression const& /*_condition*/,
+		std::vector<Expression> const& _expressionsToEvaluate
+	)
+	{
+		push();
+		ScopeGuard popQuery([&]() { pop(); });
+		addAssertion(_query);
+		return check(_expressionsToEvaluate);
+	}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
 	/// @returns how many SMT solvers this interface has.
 	virtual size_t solvers() { return 1; }
 
+	/// Sets the cache of the responses of the solver, which is not used if it is null.
+	virtual void setQueryCache(std::shared_ptr<QueryCache const> _queryCache) { m_queryCache = std::move(_queryCache); }
+
+	/// Sets the timeout of the following queries in milliseconds.
+	/// Should only be used if the solver was created with a timeout.
+	virtual void setTimeout(unsigned _milliseconds) { m_queryTimeout = _milliseconds; }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
+	std::shared_ptr<QueryCache const> m_queryCache;
 };
 
 }
@@ -0,0 +1,175 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/SolverProcess.h>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/process/args.hpp>
+#include <boost/process/child.hpp>
+#include <boost/process/exception.hpp>
+#include <boost/process/io.hpp>
+#include <boost/process/pipe.hpp>
+#include <boost/process/search_path.hpp>
+
+#include <system_error>
+
+using namespace std;
+using namespace solidity::smtutil;
+
+namespace bp = boost::process;
+
+struct SolverProcess::Process
+{
+	Process(string const& _executable, vector<string> const& _arguments):
+		child(
+			_executable,
+			bp::args(_arguments),
+			bp::std_in < input,
+			bp::std_out > output,
+			bp::std_err > bp::null
+		)
+	{}
+
+	bp::opstream input;
+	bp::ipstream output;
+	bp::child child;
+};
+
+namespace
+{
+
+/// @returns the path of the executable of @a _command and its arguments,
+/// or nullopt if the executable is not found.
+optional<pair<string, vector<string>>> executableAndArguments(string const& _command)
+{
+	vector<string> arguments;
+	boost::split(arguments, _command, boost::is_space(), boost::token_compress_on);
+	arguments.erase(remove(arguments.begin(), arguments.end(), ""), arguments.end());
+	if (arguments.empty())
+		return nullopt;
+
+	string executable = arguments.front();
+	arguments.erase(arguments.begin());
+	if (executable.find_first_of("/\\") == string::npos)
+		executable = bp::search_path(executable).string();
+	if (executable.empty() || !boost::filesystem::exists(executable))
+		return nullopt;
+	return make_pair(move(executable), move(arguments));
+}
+
+}
+
+unique_ptr<SolverProcess> SolverProcess::start(string const& _command)
+{
+	auto executable = executableAndArguments(_command);
+	if (!executable)
+		return nullptr;
+
+	try
+	{
+		return unique_ptr<SolverProcess>(new SolverProcess(make_unique<Process>(executable->first, executable->second)));
+	}
+	catch (bp::process_error const&)
+	{
+		return nullptr;
+	}
+}
+
+bool SolverProcess::available(string const& _command)
+{
+	return executableAndArguments(_command).has_value();
+}
+
+SolverProcess::SolverProcess(unique_ptr<Process> _process):
+	m_process(move(_process))
+{
+}
+
+SolverProcess::~SolverProcess()
+{
+	send("(exit)\n");
+	m_process->input.pipe().close();
+	error_code ignored;
+	if (m_process->child.running(ignored))
+		m_process->child.terminate(ignored);
+	m_process->child.wait(ignored);
+}
+
+bool SolverProcess::running()
+{
+	error_code ignored;
+	return m_process->child.running(ignored) && m_process->output.good();
+}
+
+void SolverProcess::send(string const& _commands)
+{
+	// Writing to a terminated process is an error, so the process is checked first.
+	if (!running() || !m_process->input.good())
+		return;
+	m_process->input << _commands;
+	m_process->input.flush();
+}
+
+optional<string> SolverProcess::receiveCheckResult()
+{
+	bool error = false;
+	while (optional<string> response = receive())
+		if (*response == "sat\n" || *response == "unsat\n" || *response == "unknown\n")
+			return error ? "error\n" : *response;
+		else if (boost::starts_with(*response, "(error"))
+			error = true;
+	return nullopt;
+}
+
+optional<string> SolverProcess::receive()
+{
+	string response;
+	size_t depth = 0;
+	// The closing character of the string literal or quoted symbol that is read, if any.
+	optional<char> quote;
+	for (int next = m_process->output.get(); next != char_traits<char>::eof(); next = m_process->output.get())
+	{
+		char c = static_cast<char>(next);
+		if (quote)
+		{
+			response += c;
+			if (c == *quote)
+				quote.reset();
+			continue;
+		}
+		if (isspace(static_cast<unsigned char>(c)))
+		{
+			if (!response.empty() && depth == 0)
+				return response + "\n";
+			if (!response.empty())
+				response += c;
+			continue;
+		}
+		response += c;
+		if (c == '"' || c == '|')
+			quote = c;
+		else if (c == '(')
+			++depth;
+		else if (c == ')' && depth > 0 && --depth == 0)
+			return response + "\n";
+	}
+	return nullopt;
+}
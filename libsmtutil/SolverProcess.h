@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/**
+ * External SMT solver process that is kept alive and speaks SMT-LIB2 over pipes.
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+class SolverProcess
+{
+public:
+	/// Noncopyable.
+	SolverProcess(SolverProcess const&) = delete;
+	SolverProcess& operator=(SolverProcess const&) = delete;
+
+	/// Starts the solver given by @a _command, which is an executable followed by its
+	/// arguments, separated by spaces. The executable is searched in the PATH unless it
+	/// contains a path separator. The solver has to read SMT-LIB2 commands from its standard input.
+	/// @returns nullptr if the solver cannot be started.
+	static std::unique_ptr<SolverProcess> start(std::string const& _command);
+
+	/// @returns true if the executable of @a _command exists, without starting it.
+	static bool available(std::string const& _command);
+
+	/// Terminates the solver.
+	~SolverProcess();
+
+	/// @returns false if the solver terminated, in which case it does not respond anymore.
+	bool running();
+
+	/// Sends @a _commands to the solver. Does nothing if the solver terminated.
+	void send(std::string const& _commands);
+
+	/// Reads the responses of the solver until the response to a check-sat command.
+	/// @returns the response, i.e. "sat", "unsat" or "unknown" followed by a newline,
+	/// "error\n" if the solver reported an error since the last response to a check-sat command,
+	/// or nullopt if the solver terminated.
+	std::optional<std::string> receiveCheckResult();
+
+	/// @returns the next response of the solver, i.e. a symbol or a parenthesized
+	/// S-expression followed by a newline, or nullopt if the solver terminated.
+	std::optional<std::string> receive();
+
+private:
+	/// The process and its pipes, which are only known to the implementation.
+	struct Process;
+
+	explicit SolverProcess(std::unique_ptr<Process> _process);
+
+	std::unique_ptr<Process> m_process;
+};
+
+}
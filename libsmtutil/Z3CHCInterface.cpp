@@ -18,6 +18,8 @@
 
 #include <libsmtutil/Z3CHCInterface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/CommonIO.h>
 
 #include <set>
@@ -27,11 +29,36 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::smtutil;
 
+shared_ptr<Z3LemmaStore> Z3LemmaStore::shared()
+{
+	static shared_ptr<Z3LemmaStore> store = make_shared<Z3LemmaStore>();
+	return store;
+}
+
+void Z3LemmaStore::record(z3::context& _context, z3::func_decl const& _relation, z3::expr const& _invariant)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_invariants.insert_or_assign(
+		_relation.to_string(),
+		z3::expr(m_context, Z3_translate(_context, _invariant, m_context))
+	);
+}
+
+optional<z3::expr> Z3LemmaStore::lookup(z3::context& _context, z3::func_decl const& _relation)
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto invariant = m_invariants.find(_relation.to_string());
+	if (invariant == m_invariants.end())
+		return nullopt;
+	return z3::expr(_context, Z3_translate(m_context, invariant->second, _context));
+}
+
 Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout):
 	CHCSolverInterface(_queryTimeout),
 	m_z3Interface(make_unique<Z3Interface>(m_queryTimeout)),
 	m_context(m_z3Interface->context()),
-	m_solver(*m_context)
+	m_solver(*m_context),
+	m_rules(*m_context)
 {
 	Z3_get_version(
 		&get<0>(m_version),
@@ -40,13 +67,10 @@ Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout):
 		&get<3>(m_version)
 	);
 
-	// These need to be set globally.
-	z3::set_param("rewriter.pull_cheap_ite", true);
+	Z3Interface::setGlobalParameters(!m_queryTimeout);
 
 	if (m_queryTimeout)
 		m_context->set("timeout", int(*m_queryTimeout));
-	else
-		z3::set_param("rlimit", Z3Interface::resourceLimit);
 
 	setSpacerOptions();
 }
@@ -60,11 +84,13 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
 	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
+	m_relations.push_back(_expr.name);
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 {
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
+	m_rules.push_back(rule);
 	if (m_z3Interface->constants().empty())
 		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
 	else
@@ -80,36 +106,57 @@ void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression const& _expr)
 {
 	CheckResult result;
+	// The responses are cached with their invariants and counterexamples.
+	string const solver = QueryCache::solverConfiguration(
+		Z3Interface::solverName() + (m_preProcessing ? "" : " without preprocessing"),
+		m_queryTimeout
+	);
+	string query;
 	try
 	{
 		z3::expr z3Expr = m_z3Interface->toZ3Expr(_expr);
+
+		if (m_queryCache)
+		{
+			z3::expr_vector queries(*m_context);
+			queries.push_back(z3Expr);
+			query = m_solver.to_string(queries);
+			if (auto cachedResult = m_queryCache->lookupCHCQuery(solver, query))
+				return move(*cachedResult);
+		}
+
+		if (m_lemmaStore && !m_addedStoredLemmas)
+			addStoredLemmas();
+
+		tuple<CheckResult, Expression, CexGraph> response{CheckResult::UNKNOWN, Expression(true), {}};
 		switch (m_solver.query(z3Expr))
 		{
 		case z3::check_result::sat:
 		{
-			result = CheckResult::SATISFIABLE;
+			get<0>(response) = CheckResult::SATISFIABLE;
 			// z3 version 4.8.8 modified Spacer to also return
 			// proofs containing nonlinear clauses.
 			if (m_version >= tuple(4, 8, 8, 0))
 			{
 				auto proof = m_solver.get_answer();
-				return {result, Expression(true), cexGraph(proof)};
+				get<2>(response) = cexGraph(proof);
 			}
 			break;
 		}
 		case z3::check_result::unsat:
 		{
-			result = CheckResult::UNSATISFIABLE;
-			auto invariants = m_z3Interface->fromZ3Expr(m_solver.get_answer());
-			return {result, move(invariants), {}};
+			get<0>(response) = CheckResult::UNSATISFIABLE;
+			if (m_lemmaStore)
+				storeLemmas();
+			get<1>(response) = m_z3Interface->fromZ3Expr(m_solver.get_answer());
+			break;
 		}
 		case z3::check_result::unknown:
-		{
-			result = CheckResult::UNKNOWN;
 			break;
 		}
-		}
-		// TODO retrieve model / invariants
+		if (m_queryCache)
+			m_queryCache->storeCHCQuery(solver, query, response);
+		return response;
 	}
 	catch (z3::exception const& _err)
 	{
@@ -125,6 +172,8 @@ tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::que
 			result = CheckResult::ERROR;
 	}
 
+	if (m_queryCache && !query.empty())
+		m_queryCache->storeCHCQuery(solver, query, {result, Expression(true), {}});
 	return {result, Expression(true), {}};
 }
 
@@ -144,11 +193,161 @@ void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
 	// Spacer optimization should be
 	// - enabled for better solving (default)
 	// - disable for counterexample generation
-	p.set("fp.xform.slice", _preProcessing);
+	p.set("fp.xform.slice", _preProcessing && !m_lemmaStore);
 	p.set("fp.xform.inline_linear", _preProcessing);
 	p.set("fp.xform.inline_eager", _preProcessing);
 
+	if (m_timeoutChanged && m_queryTimeout)
+		p.set("timeout", *m_queryTimeout);
+
 	m_solver.set(p);
+	m_preProcessing = _preProcessing;
+}
+
+void Z3CHCInterface::setTimeout(unsigned _milliseconds)
+{
+	CHCSolverInterface::setTimeout(_milliseconds);
+	m_timeoutChanged = true;
+	setSpacerOptions(m_preProcessing);
+}
+
+void Z3CHCInterface::setLemmaStore(shared_ptr<Z3LemmaStore> _lemmaStore)
+{
+	m_lemmaStore = move(_lemmaStore);
+	setSpacerOptions(m_preProcessing);
+}
+
+void Z3CHCInterface::addStoredLemmas()
+{
+	m_addedStoredLemmas = true;
+
+	map<string, pair<z3::func_decl, z3::expr>> candidates;
+	for (string const& relation: m_relations)
+	{
+		z3::func_decl function = m_z3Interface->functions().at(relation);
+		if (optional<z3::expr> invariant = m_lemmaStore->lookup(*m_context, function))
+			candidates.emplace(relation, make_pair(function, *invariant));
+	}
+
+	set<string> const relations(m_relations.begin(), m_relations.end());
+	// Replaces the applications of relations in @a _body by their candidate, or by true if there is none.
+	auto assumeCandidates = [&](z3::expr const& _body) {
+		z3::expr_vector applications(*m_context);
+		z3::expr_vector replacements(*m_context);
+		set<unsigned> seen;
+		vector<z3::expr> toVisit{_body};
+		while (!toVisit.empty())
+		{
+			z3::expr node = toVisit.back();
+			toVisit.pop_back();
+			if (!node.is_app() || !seen.insert(Z3_get_ast_id(*m_context, node)).second)
+				continue;
+			string const name = node.decl().name().str();
+			if (relations.count(name))
+			{
+				applications.push_back(node);
+				if (candidates.count(name))
+				{
+					z3::expr_vector arguments(*m_context);
+					for (unsigned i = 0; i < node.num_args(); ++i)
+						arguments.push_back(node.arg(i));
+					replacements.push_back(candidates.at(name).second.substitute(arguments));
+				}
+				else
+					replacements.push_back(m_context->bool_val(true));
+				continue;
+			}
+			for (unsigned i = 0; i < node.num_args(); ++i)
+				toVisit.push_back(node.arg(i));
+		}
+		return z3::expr(_body).substitute(applications, replacements);
+	};
+
+	try
+	{
+		// The candidates that are not preserved by a rule are dropped until the remaining ones are
+		// inductive. They are then invariants of this system and do not change the answers of queries.
+		bool dropped = true;
+		while (dropped && !candidates.empty())
+		{
+			dropped = false;
+			for (unsigned i = 0; i < m_rules.size() && !candidates.empty(); ++i)
+			{
+				z3::expr rule = m_rules[static_cast<int>(i)];
+				z3::expr head = rule.is_implies() ? rule.arg(1) : rule;
+				z3::expr body = rule.is_implies() ? rule.arg(0) : m_context->bool_val(true);
+				if (!head.is_app() || !candidates.count(head.decl().name().str()))
+					continue;
+
+				z3::solver solver(*m_context);
+				if (m_queryTimeout)
+				{
+					z3::params parameters(*m_context);
+					parameters.set("timeout", *m_queryTimeout);
+					solver.set(parameters);
+				}
+				// The head is replaced as well, by the candidate of its relation.
+				solver.add(assumeCandidates(body) && !assumeCandidates(head));
+				if (solver.check() != z3::check_result::unsat)
+				{
+					candidates.erase(head.decl().name().str());
+					dropped = true;
+				}
+			}
+		}
+
+		for (auto& candidate: candidates)
+			m_solver.add_cover(-1, candidate.second.first, candidate.second.second);
+	}
+	catch (z3::exception const&)
+	{
+		// The stored lemmas only speed up the queries, which are also answered without them.
+	}
+}
+
+void Z3CHCInterface::storeLemmas()
+{
+	try
+	{
+		for (string const& relation: m_relations)
+		{
+			z3::func_decl function = m_z3Interface->functions().at(relation);
+			z3::expr invariant = m_solver.get_cover_delta(-1, function);
+			if (!invariant.is_true())
+				m_lemmaStore->record(*m_context, function, invariant);
+		}
+	}
+	catch (z3::exception const&)
+	{
+	}
+}
+
+unique_ptr<Z3CHCInterface> Z3CHCInterface::clone() const
+{
+	auto copy = make_unique<Z3CHCInterface>(m_queryTimeout);
+	copy->m_z3Interface->importDeclarations(*m_z3Interface);
+	for (string const& relation: m_relations)
+	{
+		z3::func_decl function = copy->m_z3Interface->functions().at(relation);
+		copy->m_solver.register_relation(function);
+	}
+	copy->m_relations = m_relations;
+	copy->m_queryCache = m_queryCache;
+	if (m_lemmaStore)
+		copy->setLemmaStore(m_lemmaStore);
+	for (unsigned i = 0; i < m_rules.size(); ++i)
+		copy->m_rules.push_back(z3::expr(
+			*copy->m_context,
+			Z3_translate(*m_context, m_rules[static_cast<int>(i)], *copy->m_context)
+		));
+
+	z3::expr_vector rules(*copy->m_context, m_solver.rules());
+	for (unsigned i = 0; i < rules.size(); ++i)
+	{
+		z3::expr rule = rules[static_cast<int>(i)];
+		copy->m_solver.add_rule(rule, copy->m_context->str_symbol(("rule_" + to_string(i)).c_str()));
+	}
+	return copy;
 }
 
 /**
@@ -25,12 +25,42 @@
 #include <libsmtutil/CHCSolverInterface.h>
 #include <libsmtutil/Z3Interface.h>
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <tuple>
 #include <vector>
 
 namespace solidity::smtutil
 {
 
+/**
+ * Invariants that Spacer found for the relations of earlier Horn systems, by the name and the sort
+ * of the relation. They are candidates for the relations of later systems, for example after a
+ * function of the analyzed contract changed, and are only used if they are inductive there.
+ * Can be shared by interfaces on different threads.
+ */
+class Z3LemmaStore
+{
+public:
+	/// @returns the store that is shared by the analyses of this process.
+	static std::shared_ptr<Z3LemmaStore> shared();
+
+	/// Records @a _invariant of @a _relation, whose arguments are the variables of the invariant.
+	/// Both belong to @a _context. Replaces an earlier invariant of the relation.
+	void record(z3::context& _context, z3::func_decl const& _relation, z3::expr const& _invariant);
+	/// @returns the invariant of a relation with the name and the sort of @a _relation
+	/// translated to @a _context, or nullopt if there is none.
+	std::optional<z3::expr> lookup(z3::context& _context, z3::func_decl const& _relation);
+
+private:
+	std::mutex m_mutex;
+	/// Context of the stored invariants, which are translated from and to the contexts of the interfaces.
+	z3::context m_context;
+	std::map<std::string, z3::expr> m_invariants;
+};
+
 class Z3CHCInterface: public CHCSolverInterface
 {
 public:
@@ -49,6 +79,20 @@ public:
 
 	void setSpacerOptions(bool _preProcessing = true);
 
+	void setTimeout(unsigned _milliseconds) override;
+
+	/// Sets the store of the invariants of earlier systems, which are used as lemmas
+	/// of the first query if they are inductive, and which records the invariants of safe queries.
+	/// Rules for relations that have invariants must not be added after the first query.
+	/// Disables the slicing of the rules, which Spacer does not support together with lemmas.
+	void setLemmaStore(std::shared_ptr<Z3LemmaStore> _lemmaStore);
+
+	/// @returns an interface with its own context that contains the same declarations,
+	/// relations and rules as this one, but does not share the lemmas learnt during queries.
+	/// Must only be called before this interface was queried, since the queries can
+	/// transform the rule set. Both interfaces can be used by different threads afterwards.
+	std::unique_ptr<Z3CHCInterface> clone() const;
+
 private:
 	/// Constructs a nonlinear counterexample graph from the refutation.
 	CHCSolverInterface::CexGraph cexGraph(z3::expr const& _proof);
@@ -59,14 +103,33 @@ private:
 	/// @returns the arguments of @a _predicate.
 	std::vector<std::string> arguments(z3::expr const& _predicate);
 
+	/// Adds the invariants of the lemma store that are inductive for the rules as lemmas.
+	void addStoredLemmas();
+	/// Records the invariants of the relations after a safe query in the lemma store.
+	void storeLemmas();
+
 	// Used to handle variables.
 	std::unique_ptr<Z3Interface> m_z3Interface;
 
 	z3::context* m_context;
 	// Horn solver.
 	z3::fixedpoint m_solver;
+	/// The rules of the solver before their variables are bound.
+	z3::expr_vector m_rules;
 
 	std::tuple<unsigned, unsigned, unsigned, unsigned> m_version = std::tuple(0, 0, 0, 0);
+
+	/// Names of the registered relations, in the order of their registration.
+	std::vector<std::string> m_relations;
+
+	/// Whether the preprocessing of Spacer is enabled, which can change the answers.
+	bool m_preProcessing = true;
+	/// Whether the timeout was changed after the construction and has to be set in the solver.
+	bool m_timeoutChanged = false;
+
+	std::shared_ptr<Z3LemmaStore> m_lemmaStore;
+	/// Whether the stored lemmas were already added, which is done before the first query.
+	bool m_addedStoredLemmas = false;
 };
 
 }
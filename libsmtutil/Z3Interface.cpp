@@ -18,6 +18,8 @@
 
 #include <libsmtutil/Z3Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 
@@ -25,10 +27,35 @@
 #include <libsmtutil/Z3Loader.h>
 #endif
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity::smtutil;
 using namespace solidity::util;
 
+namespace
+{
+
+/// @returns true if @a _a and @a _b are the same expression, which is cheaper to find out
+/// than to assert them again.
+bool equalExpressions(Expression const& _a, Expression const& _b)
+{
+	if (_a.name != _b.name || _a.arguments.size() != _b.arguments.size())
+		return false;
+	if (_a.arguments.empty())
+		return *_a.sort == *_b.sort;
+	if (_a.sort->kind != _b.sort->kind)
+		return false;
+	if (_a.arguments.node() == _b.arguments.node())
+		return true;
+	for (size_t i = 0; i < _a.arguments.size(); ++i)
+		if (!equalExpressions(_a.arguments[i], _b.arguments[i]))
+			return false;
+	return true;
+}
+
+}
+
 bool Z3Interface::available()
 {
 #ifdef HAVE_Z3_DLOPEN
@@ -38,28 +65,69 @@ bool Z3Interface::available()
 #endif
 }
 
+string Z3Interface::solverName()
+{
+	return string("z3 ") + Z3_get_full_version();
+}
+
 Z3Interface::Z3Interface(std::optional<unsigned> _queryTimeout):
 	SolverInterface(_queryTimeout),
 	m_solver(m_context)
 {
-	// These need to be set globally.
-	z3::set_param("rewriter.pull_cheap_ite", true);
+	setGlobalParameters(!m_queryTimeout);
 
 	if (m_queryTimeout)
 		m_context.set("timeout", int(*m_queryTimeout));
-	else
+}
+
+void Z3Interface::setTimeout(unsigned _milliseconds)
+{
+	SolverInterface::setTimeout(_milliseconds);
+	z3::params parameters(m_context);
+	parameters.set("timeout", _milliseconds);
+	m_solver.set(parameters);
+}
+
+void Z3Interface::releasePrefix()
+{
+	for (size_t i = 0; i < m_prefixScopes.size(); ++i)
+		m_solver.pop();
+	m_prefix.clear();
+	m_prefixScopes.clear();
+}
+
+void Z3Interface::setGlobalParameters(bool _resourceLimit)
+{
+	static mutex parametersMutex;
+	static bool pullCheapIteSet = false;
+	static bool resourceLimitSet = false;
+
+	lock_guard<mutex> lock(parametersMutex);
+	if (!pullCheapIteSet)
+	{
+		z3::set_param("rewriter.pull_cheap_ite", true);
+		pullCheapIteSet = true;
+	}
+	if (_resourceLimit && !resourceLimitSet)
+	{
 		z3::set_param("rlimit", resourceLimit);
+		resourceLimitSet = true;
+	}
 }
 
 void Z3Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_translations.clear();
 	m_solver.reset();
+	m_prefix.clear();
+	m_prefixScopes.clear();
 }
 
 void Z3Interface::push()
 {
+	releasePrefix();
 	m_solver.push();
 }
 
@@ -74,7 +142,10 @@ void Z3Interface::declareVariable(string const& _name, SortPointer const& _sort)
 	if (_sort->kind == Kind::Function)
 		declareFunction(_name, *_sort);
 	else if (m_constants.count(_name))
+	{
 		m_constants.at(_name) = m_context.constant(_name.c_str(), z3Sort(*_sort));
+		m_translations.clear();
+	}
 	else
 		m_constants.emplace(_name, m_context.constant(_name.c_str(), z3Sort(*_sort)));
 }
@@ -84,11 +155,26 @@ void Z3Interface::declareFunction(string const& _name, Sort const& _sort)
 	smtAssert(_sort.kind == Kind::Function, "");
 	FunctionSort fSort = dynamic_cast<FunctionSort const&>(_sort);
 	if (m_functions.count(_name))
+	{
 		m_functions.at(_name) = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+		m_translations.clear();
+	}
 	else
 		m_functions.emplace(_name, m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain)));
 }
 
+void Z3Interface::importDeclarations(Z3Interface const& _other)
+{
+	for (auto const& [name, constant]: _other.m_constants)
+		m_constants.insert_or_assign(name, z3::expr(m_context, Z3_translate(_other.m_context, constant, m_context)));
+	for (auto const& [name, function]: _other.m_functions)
+	{
+		Z3_ast translated = Z3_translate(_other.m_context, Z3_func_decl_to_ast(_other.m_context, function), m_context);
+		m_functions.insert_or_assign(name, z3::func_decl(m_context, Z3_to_func_decl(m_context, translated)));
+	}
+	m_translations.clear();
+}
+
 void Z3Interface::addAssertion(Expression const& _expr)
 {
 	m_solver.add(toZ3Expr(_expr));
@@ -96,6 +182,16 @@ void Z3Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	string query;
+	if (m_queryCache)
+	{
+		query = m_solver.to_smt2();
+		for (Expression const& e: _expressionsToEvaluate)
+			query += "(get-value (" + toZ3Expr(e).to_string() + "))\n";
+		if (auto cachedResult = m_queryCache->lookupCheck(QueryCache::solverConfiguration(solverName(), m_queryTimeout), query))
+			return *cachedResult;
+	}
+
 	CheckResult result;
 	vector<string> values;
 	try
@@ -136,10 +232,64 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 		values.clear();
 	}
 
+	if (m_queryCache)
+		m_queryCache->storeCheck(QueryCache::solverConfiguration(solverName(), m_queryTimeout), query, {result, values});
 	return make_pair(result, values);
 }
 
+pair<CheckResult, vector<string>> Z3Interface::checkWithPrefix(
+	Expression const&,
+	vector<Expression> const& _prefix,
+	Expression const& _condition,
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	size_t sharedConjuncts = 0;
+	while (
+		sharedConjuncts < min(m_prefix.size(), _prefix.size()) &&
+		equalExpressions(m_prefix[sharedConjuncts], _prefix[sharedConjuncts])
+	)
+		++sharedConjuncts;
+
+	while (m_prefix.size() > sharedConjuncts)
+	{
+		m_solver.pop();
+		m_prefix.erase(m_prefix.begin() + static_cast<ptrdiff_t>(m_prefixScopes.back()), m_prefix.end());
+		m_prefixScopes.pop_back();
+	}
+	if (m_prefix.size() < _prefix.size())
+	{
+		m_prefixScopes.push_back(m_prefix.size());
+		m_solver.push();
+		for (size_t i = m_prefix.size(); i < _prefix.size(); ++i)
+		{
+			addAssertion(_prefix[i]);
+			m_prefix.push_back(_prefix[i]);
+		}
+	}
+
+	m_solver.push();
+	ScopeGuard popCondition([&]() { m_solver.pop(); });
+	addAssertion(_condition);
+	return check(_expressionsToEvaluate);
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
+{
+	if (_expr.arguments.empty())
+		return translate(_expr);
+
+	auto key = make_pair(_expr.arguments.node().get(), _expr.name);
+	if (auto const* translation = valueOrNullptr(m_translations, key))
+		if (translation->sort == _expr.sort || *translation->sort == *_expr.sort)
+			return translation->expr;
+
+	z3::expr result = translate(_expr);
+	m_translations.insert_or_assign(key, Translation{_expr.arguments.node(), _expr.sort, result});
+	return result;
+}
+
+z3::expr Z3Interface::translate(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
 		return m_constants.at(_expr.name);
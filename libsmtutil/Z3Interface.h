@@ -35,6 +35,9 @@ public:
 
 	static bool available();
 
+	/// @returns the name and full version of Z3, which identify it in the query cache.
+	static std::string solverName();
+
 	void reset() override;
 
 	void push() override;
@@ -44,15 +47,35 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	/// Keeps the conjuncts of the prefix asserted, so that checks with a shared prefix only assert
+	/// the conjuncts that differ from those of the previous check and reuse the state of the solver.
+	std::pair<CheckResult, std::vector<std::string>> checkWithPrefix(
+		Expression const& _query,
+		std::vector<Expression> const& _prefix,
+		Expression const& _condition,
+		std::vector<Expression> const& _expressionsToEvaluate
+	) override;
+
+	void setTimeout(unsigned _milliseconds) override;
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
 
+	/// Declares the constants and functions of @a _other, which uses a different context.
+	/// Both contexts must not be in use by other threads at the same time.
+	void importDeclarations(Z3Interface const& _other);
+
 	std::map<std::string, z3::expr> constants() const { return m_constants; }
 	std::map<std::string, z3::func_decl> functions() const { return m_functions; }
 
 	z3::context* context() { return &m_context; }
 
+	/// Sets the parameters that Z3 only supports globally, unless they are already set.
+	/// The resource limit is only set if @a _resourceLimit is true.
+	/// Can be called from several threads, and does not modify the parameters once they
+	/// are set, so that creating a solver does not interfere with queries on other threads.
+	static void setGlobalParameters(bool _resourceLimit);
+
 	// Z3 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	static int const resourceLimit = 1000000;
@@ -60,6 +83,12 @@ public:
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
+	/// Translates @a _expr without looking up the translations of its arguments.
+	z3::expr translate(Expression const& _expr);
+
+	/// Removes the scopes of the conjuncts of the prefix kept by `checkWithPrefix`.
+	void releasePrefix();
+
 	z3::sort z3Sort(Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<SortPointer> const& _sorts);
 	smtutil::SortPointer fromZ3Sort(z3::sort const& _sort);
@@ -70,6 +99,24 @@ private:
 
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+
+	/// Translation of an expression with arguments, which is reused for all its copies.
+	struct Translation
+	{
+		/// Keeps the shared arguments alive, so that their address is not reused.
+		std::shared_ptr<std::vector<Expression> const> arguments;
+		SortPointer sort;
+		z3::expr expr;
+	};
+	/// Translations of the expressions with arguments, indexed by the shared arguments and the name.
+	/// Cleared whenever a declaration is replaced.
+	std::map<std::pair<std::vector<Expression> const*, std::string>, Translation> m_translations;
+
+	/// Conjuncts of the prefix that are currently asserted, from the oldest to the newest.
+	std::vector<Expression> m_prefix;
+	/// For each scope of the solver that asserts conjuncts of the prefix,
+	/// the number of conjuncts asserted before it.
+	std::vector<size_t> m_prefixScopes;
 };
 
 }
@@ -26,9 +26,17 @@
 #include <libsolidity/interface/Version.h>
 #include <libyul/YulString.h>
 
+#include <libsolutil/Common.h>
+
+#include <condition_variable>
 #include <cstdlib>
+#include <limits>
 #include <list>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <string>
+#include <vector>
 
 #include "license.h"
 
@@ -39,12 +47,36 @@ using namespace solidity::util;
 using solidity::frontend::ReadCallback;
 using solidity::frontend::StandardCompiler;
 
+struct solidity_read_request
+{
+	mutex resultsMutex;
+	condition_variable completed;
+	vector<optional<ReadCallback::Result>> results;
+	size_t remaining = 0;
+};
+
 namespace
 {
 
 // The strings in this list must not be resized after they have been added here (via solidity_alloc()), because
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static list<string> solidityAllocations;
+static mutex solidityAllocationsMutex;
+
+/// Guards the interned Yul identifiers, which are shared by all compilations. Compilations that
+/// keep them hold it shared, clearing them requires holding it exclusively.
+static shared_mutex yulStringsMutex;
+
+/// Number of bytes the interned Yul identifiers may occupy before a compiler created via
+/// solidity_compiler_create() clears them.
+static size_t constexpr yulStringMemoryLimit = 64 * 1024 * 1024;
+
+/// Adds @p _data to the list of allocations and @returns the pointer to pass to the caller.
+char* storeAllocation(string _data)
+{
+	lock_guard<mutex> lock(solidityAllocationsMutex);
+	return solidityAllocations.emplace_back(move(_data)).data();
+}
 
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
@@ -53,6 +85,7 @@ static list<string> solidityAllocations;
 /// on the caller-side and hence, will call abort() then.
 string takeOverAllocation(char const* _data)
 {
+	lock_guard<mutex> lock(solidityAllocationsMutex);
 	for (auto iter = begin(solidityAllocations); iter != end(solidityAllocations); ++iter)
 		if (iter->data() == _data)
 		{
@@ -72,6 +105,30 @@ void truncateCString(string& _data)
 		_data.resize(pos);
 }
 
+/// Converts the contents or the error returned by a callback into a result, taking over their allocations.
+ReadCallback::Result takeOverResult(char* _contents, char* _error)
+{
+	ReadCallback::Result result;
+	result.success = true;
+	if (!_contents && !_error)
+	{
+		result.success = false;
+		result.responseOrErrorMessage = "Callback not supported.";
+	}
+	if (_contents)
+	{
+		result.success = true;
+		result.responseOrErrorMessage = takeOverAllocation(_contents);
+	}
+	if (_error)
+	{
+		result.success = false;
+		result.responseOrErrorMessage = takeOverAllocation(_error);
+	}
+	truncateCString(result.responseOrErrorMessage);
+	return result;
+}
+
 ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, void* _readContext)
 {
 	ReadCallback::Callback readCallback;
@@ -82,38 +139,80 @@ ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, vo
 			char* contents_c = nullptr;
 			char* error_c = nullptr;
 			_readCallback(_readContext, _kind.data(), _data.data(), &contents_c, &error_c);
-			ReadCallback::Result result;
-			result.success = true;
-			if (!contents_c && !error_c)
-			{
-				result.success = false;
-				result.responseOrErrorMessage = "Callback not supported.";
-			}
-			if (contents_c)
-			{
-				result.success = true;
-				result.responseOrErrorMessage = takeOverAllocation(contents_c);
-			}
-			if (error_c)
-			{
-				result.success = false;
-				result.responseOrErrorMessage = takeOverAllocation(error_c);
-			}
-			truncateCString(result.responseOrErrorMessage);
-			return result;
+			return takeOverResult(contents_c, error_c);
 		};
 	}
 	return readCallback;
 }
 
+ReadCallback::BatchCallback wrapReadFilesCallback(CStyleReadFilesCallback _readCallback, void* _readContext)
+{
+	return [=](string const& _kind, vector<string> const& _data)
+	{
+		solidity_read_request request;
+		request.results.resize(_data.size());
+		request.remaining = _data.size();
+		vector<char const*> data;
+		for (string const& item: _data)
+			data.push_back(item.c_str());
+		_readCallback(_readContext, _kind.c_str(), data.size(), data.data(), &request);
+
+		unique_lock<mutex> lock(request.resultsMutex);
+		request.completed.wait(lock, [&]() { return request.remaining == 0; });
+		vector<ReadCallback::Result> results;
+		for (optional<ReadCallback::Result>& result: request.results)
+			results.emplace_back(move(*result));
+		return results;
+	};
+}
+
 string compile(string _input, CStyleReadFileCallback _readCallback, void* _readContext)
 {
+	// The compiler clears the interned Yul identifiers before compiling.
+	unique_lock<shared_mutex> lock(yulStringsMutex);
 	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
 	return compiler.compile(move(_input));
 }
 
 }
 
+struct solidity_compiler
+{
+	solidity_compiler()
+	{
+		// The identifiers are cleared by solidity_compiler_compile() once no other compilation uses them.
+		compiler.setYulStringMemoryLimit(numeric_limits<size_t>::max());
+	}
+
+	/// Compiles @a _input using the callbacks, which are only used for this compilation.
+	string compile(char const* _input, ReadCallback::Callback _readFile, ReadCallback::BatchCallback _readFiles)
+	{
+		string output;
+		bool exceedsMemoryLimit = false;
+		{
+			lock_guard<mutex> compilationLock(compilationMutex);
+			shared_lock<shared_mutex> yulStringsLock(yulStringsMutex);
+			compiler.setReadFileCallback(move(_readFile));
+			compiler.setBatchReadCallback(move(_readFiles));
+			ScopeGuard resetReadCallbacks([&]() {
+				compiler.setReadFileCallback({});
+				compiler.setBatchReadCallback({});
+			});
+			output = compiler.compile(string(_input));
+			exceedsMemoryLimit = yul::YulStringRepository::instance().statistics().bytes > yulStringMemoryLimit;
+		}
+		// Compilations running on other threads still refer to the identifiers, in which case
+		// they are cleared after a later compilation.
+		if (exceedsMemoryLimit)
+			if (unique_lock<shared_mutex> lock(yulStringsMutex, try_to_lock); lock.owns_lock())
+				yul::YulStringRepository::reset();
+		return output;
+	}
+
+	mutex compilationMutex;
+	StandardCompiler compiler;
+};
+
 extern "C"
 {
 extern char const* solidity_license() noexcept
@@ -129,14 +228,14 @@ extern char const* solidity_version() noexcept
 
 extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
 {
-	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
+	return storeAllocation(compile(_input, _readCallback, _readContext));
 }
 
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
 	{
-		return solidityAllocations.emplace_back(_size, '\0').data();
+		return storeAllocation(string(_size, '\0'));
 	}
 	catch (...)
 	{
@@ -154,7 +253,80 @@ extern void solidity_reset() noexcept
 {
 	// This is called right before each compilation, but not at the end, so additional memory
 	// can be freed here.
-	yul::YulStringRepository::reset();
+	{
+		unique_lock<shared_mutex> lock(yulStringsMutex);
+		yul::YulStringRepository::reset();
+	}
+	lock_guard<mutex> lock(solidityAllocationsMutex);
 	solidityAllocations.clear();
 }
+
+extern solidity_compiler* solidity_compiler_create() noexcept
+{
+	try
+	{
+		return new solidity_compiler();
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+extern char* solidity_compiler_compile(
+	solidity_compiler* _compiler,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) noexcept
+{
+	try
+	{
+		return storeAllocation(_compiler->compile(_input, wrapReadCallback(_readCallback, _readContext), {}));
+	}
+	catch (...)
+	{
+		// most likely a std::bad_alloc(), if at all.
+		return nullptr;
+	}
+}
+
+extern void solidity_compiler_destroy(solidity_compiler* _compiler) noexcept
+{
+	delete _compiler;
+}
+
+extern char* solidity_compiler_compile_batched(
+	solidity_compiler* _compiler,
+	char const* _input,
+	CStyleReadFilesCallback _readCallback,
+	void* _readContext
+) noexcept
+{
+	try
+	{
+		ReadCallback::BatchCallback readFiles = wrapReadFilesCallback(_readCallback, _readContext);
+		ReadCallback::Callback readFile = [=](string const& _kind, string const& _data)
+		{
+			return readFiles(_kind, {_data}).front();
+		};
+		return storeAllocation(_compiler->compile(_input, move(readFile), move(readFiles)));
+	}
+	catch (...)
+	{
+		// most likely a std::bad_alloc(), if at all.
+		return nullptr;
+	}
+}
+
+extern void solidity_read_request_complete(solidity_read_request* _request, size_t _index, char* _contents, char* _error) noexcept
+{
+	ReadCallback::Result result = takeOverResult(_contents, _error);
+	lock_guard<mutex> lock(_request->resultsMutex);
+	if (_index >= _request->results.size() || _request->results[_index])
+		abort();
+	_request->results[_index] = move(result);
+	if (--_request->remaining == 0)
+		_request->completed.notify_one();
+}
 }
@@ -52,6 +52,29 @@ extern "C" {
 /// If the callback is not supported, *o_contents and *o_error must be set to NULL.
 typedef void (*CStyleReadFileCallback)(void* _context, char const* _kind, char const* _data, char** o_contents, char** o_error);
 
+/// Set of queries of a CStyleReadFilesCallback whose results are still expected.
+typedef struct solidity_read_request solidity_read_request;
+
+/// Callback used to retrieve several source files or data at once, for example in parallel.
+///
+/// @param _context The readContext passed to solidity_compiler_compile_batched. Can be NULL.
+/// @param _kind The kind of callback (a string).
+/// @param _count The number of queries.
+/// @param _data The data for each of the queries (an array of @p _count strings).
+/// @param _request The request to pass the results to via solidity_read_request_complete().
+///
+/// The callback does not have to wait for the results: they can be passed to
+/// solidity_read_request_complete() from any thread, before or after the callback returns.
+/// The compiler waits until the result of every query was passed. The strings in @p _data
+/// stay valid until then.
+typedef void (*CStyleReadFilesCallback)(
+	void* _context,
+	char const* _kind,
+	size_t _count,
+	char const* const* _data,
+	solidity_read_request* _request
+);
+
 /// Returns the complete license document.
 ///
 /// The pointer returned must NOT be freed by the caller.
@@ -94,8 +117,67 @@ char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback,
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
 /// is invalid after calling this!
+/// It waits for running compilations, but must not be called while results of compilers created via
+/// solidity_compiler_create() or memory retrieved via solidity_alloc() are still in use on other threads.
 void solidity_reset() SOLC_NOEXCEPT;
 
+/// Compiler that keeps its state between compilations. Created via solidity_compiler_create().
+///
+/// Different compilers can be used from different threads at the same time. Calls to the same compiler
+/// from several threads are executed one after another.
+typedef struct solidity_compiler solidity_compiler;
+
+/// Creates a new compiler, which has to be destroyed via solidity_compiler_destroy().
+///
+/// @returns the new compiler or NULL if it could not be allocated.
+solidity_compiler* solidity_compiler_create() SOLC_NOEXCEPT;
+
+/// Takes a "Standard Input JSON" and an optional callback (can be set to null) and compiles it using @p _compiler.
+/// Returns a "Standard Output JSON". Both are to be UTF-8 encoded.
+///
+/// In contrast to solidity_compile(), the interned identifiers of the Yul code and the builtin Yul dialects
+/// that refer to them are only cleared once they exceed a memory limit and no other compilation is running.
+///
+/// @param _compiler The compiler to use. Must not be NULL.
+/// @param _input The input JSON to process.
+/// @param _readCallback The optional callback pointer. Can be NULL, but if not NULL,
+///                      it can be called by the compiler to request additional input.
+///                      It is called on the thread that called this function.
+/// @param _readContext An optional context pointer passed to _readCallback. Can be NULL.
+///
+/// @returns A pointer to the result, or NULL if memory could not be allocated. The pointer returned
+/// must be freed by the caller using solidity_free() or solidity_reset().
+char* solidity_compiler_compile(
+	solidity_compiler* _compiler,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) SOLC_NOEXCEPT;
+
+/// Destroys @p _compiler, which must not be in use anymore. Results returned by it
+/// stay valid until they are freed. Does nothing if @p _compiler is NULL.
+void solidity_compiler_destroy(solidity_compiler* _compiler) SOLC_NOEXCEPT;
+
+/// Works like solidity_compiler_compile(), but retrieves the imported files using @p _readCallback,
+/// which receives all files requested by the sources that were parsed so far at once instead of
+/// one after another, and is also used for the other queries.
+///
+/// @param _readCallback The callback pointer. Must not be NULL.
+char* solidity_compiler_compile_batched(
+	solidity_compiler* _compiler,
+	char const* _input,
+	CStyleReadFilesCallback _readCallback,
+	void* _readContext
+) SOLC_NOEXCEPT;
+
+/// Passes the result of the query at @p _index of @p _request, which has the same meaning
+/// as the output parameters of CStyleReadFileCallback: @p _contents and @p _error have to be
+/// allocated via solidity_alloc(), or be NULL if the query is not supported.
+///
+/// The result of every query must be passed exactly once. The request is invalid after the last
+/// result was passed. This call will abort() if the index is out of range or was already completed.
+void solidity_read_request_complete(solidity_read_request* _request, size_t _index, char* _contents, char* _error) SOLC_NOEXCEPT;
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,13 +28,13 @@
 #include <liblangutil/ErrorReporter.h>
 
 #include <limits>
+#include <mutex>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::langutil;
 
-using TypedRational = ConstantEvaluator::TypedRational;
 
 namespace
 {
@@ -252,6 +252,22 @@ optional<TypedRational> convertType(optional<TypedRational> const& _value, Type
 	return _value ? convertType(_value->value, _type) : nullopt;
 }
 
+/// Guards the values cached in the annotations, since the static analysis of several sources
+/// runs in parallel and can evaluate the same (imported) constants.
+mutex cacheMutex;
+
+optional<TypedRational> cachedValue(Expression const& _expression)
+{
+	lock_guard<mutex> lock(cacheMutex);
+	return _expression.annotation().constantValue;
+}
+
+void storeValue(Expression const& _expression, TypedRational const& _value)
+{
+	lock_guard<mutex> lock(cacheMutex);
+	_expression.annotation().constantValue = _value;
+}
+
 optional<TypedRational> constantToTypedValue(Type const& _type)
 {
 	if (_type.category() == Type::Category::RationalNumber)
@@ -296,9 +312,18 @@ optional<TypedRational> ConstantEvaluator::evaluate(ASTNode const& _node)
 		}
 		else if (auto const* expression = dynamic_cast<Expression const*>(&_node))
 		{
-			expression->accept(*this);
-			if (!m_values.count(&_node))
-				m_values[&_node] = nullopt;
+			if (optional<TypedRational> value = cachedValue(*expression))
+				m_values[&_node] = move(value);
+			else
+			{
+				expression->accept(*this);
+				if (!m_values.count(&_node))
+					m_values[&_node] = nullopt;
+				else if (m_values[&_node])
+					// Only values that could be computed are cached: Evaluations that fail because the
+					// type of a constant is not known yet have to be repeated later.
+					storeValue(*expression, *m_values[&_node]);
+			}
 		}
 	}
 	return m_values.at(&_node);
@@ -46,12 +46,11 @@ class TypeChecker;
 class ConstantEvaluator: private ASTConstVisitor
 {
 public:
-	struct TypedRational
-	{
-		Type const* type;
-		rational value;
-	};
+	using TypedRational = frontend::TypedRational;
 
+	/// Evaluates @a _expr to a constant, if possible. Values that could be computed are stored in
+	/// the annotations of the evaluated expressions and reused by later evaluations, so that
+	/// constants referenced in several places are only evaluated once per compilation.
 	static std::optional<TypedRational> evaluate(
 		langutil::ErrorReporter& _errorReporter,
 		Expression const& _expr
@@ -70,6 +69,8 @@ private:
 
 	std::optional<TypedRational> evaluate(ASTNode const& _node);
 
+	/// Sub-expressions are evaluated explicitly by the endVisit functions and not traversed automatically.
+	bool visitNode(ASTNode const&) override { return false; }
 	void endVisit(BinaryOperation const& _operation) override;
 	void endVisit(UnaryOperation const& _operation) override;
 	void endVisit(Literal const& _literal) override;
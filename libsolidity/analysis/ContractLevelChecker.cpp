@@ -271,16 +271,15 @@ void ContractLevelChecker::checkAbstractDefinitions(ContractDefinition const& _c
 	// update proxies.
 	for (ContractDefinition const* contract: _contract.annotation().linearizedBaseContracts | ranges::views::reverse)
 	{
-		for (VariableDeclaration const* v: contract->stateVariables())
-			if (v->isPartOfExternalInterface())
-				registerProxy(OverrideProxy(v));
+		// The proxies are shared with the override checker, so each signature is only computed once.
+		for (OverrideProxy const& variable: m_overrideChecker.publicStateVariables(*contract))
+			registerProxy(variable);
 
-		for (FunctionDefinition const* function: contract->definedFunctions())
-			if (!function->isConstructor())
-				registerProxy(OverrideProxy(function));
+		for (OverrideProxy const& function: m_overrideChecker.definedFunctions(*contract))
+			registerProxy(function);
 
-		for (ModifierDefinition const* modifier: contract->functionModifiers())
-			registerProxy(OverrideProxy(modifier));
+		for (OverrideProxy const& modifier: m_overrideChecker.definedModifiers(*contract))
+			registerProxy(modifier);
 	}
 
 	// Set to not fully implemented if at least one flag is false.
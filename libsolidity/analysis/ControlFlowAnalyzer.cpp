@@ -21,9 +21,13 @@
 #include <liblangutil/SourceLocation.h>
 #include <libsolutil/Algorithms.h>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include <range/v3/algorithm/sort.hpp>
 
+#include <algorithm>
 #include <functional>
+#include <unordered_map>
 
 using namespace std;
 using namespace std::placeholders;
@@ -31,6 +35,57 @@ using namespace solidity::langutil;
 using namespace solidity::frontend;
 
 
+struct ControlFlowAnalyzer::FlowIndex
+{
+	explicit FlowIndex(CFGNode const* _entry)
+	{
+		// Depth first search over the exits, recording the nodes in post-order.
+		vector<pair<CFGNode const*, size_t>> stack{{_entry, 0}};
+		nodeIndices[_entry] = 0;
+		while (!stack.empty())
+		{
+			auto& [node, nextExit] = stack.back();
+			if (nextExit < node->exits.size())
+			{
+				CFGNode const* exit = node->exits[nextExit++];
+				if (nodeIndices.emplace(exit, 0).second)
+					stack.emplace_back(exit, 0);
+			}
+			else
+			{
+				nodes.push_back(node);
+				stack.pop_back();
+			}
+		}
+		reverse(nodes.begin(), nodes.end());
+
+		for (size_t nodeIndex = 0; nodeIndex < nodes.size(); ++nodeIndex)
+		{
+			nodeIndices[nodes[nodeIndex]] = nodeIndex;
+			firstOccurrences.push_back(occurrences.size());
+			for (VariableOccurrence const& occurrence: nodes[nodeIndex]->variableOccurrences)
+			{
+				occurrences.push_back(&occurrence);
+				occurrenceVariables.push_back(
+					variableIndices.emplace(&occurrence.declaration(), variableIndices.size()).first->second
+				);
+			}
+		}
+	}
+
+	/// Reachable nodes in reverse post-order.
+	vector<CFGNode const*> nodes;
+	/// Index of each reachable node in ``nodes``.
+	unordered_map<CFGNode const*, size_t> nodeIndices;
+	/// The variable occurrences of all reachable nodes. The occurrences of node ``i`` start
+	/// at ``firstOccurrences[i]``.
+	vector<VariableOccurrence const*> occurrences;
+	vector<size_t> firstOccurrences;
+	/// Index of the variable of each element of ``occurrences``.
+	vector<size_t> occurrenceVariables;
+	unordered_map<VariableDeclaration const*, size_t> variableIndices;
+};
+
 bool ControlFlowAnalyzer::run()
 {
 	for (auto& [pair, flow]: m_cfg.allFunctionFlows())
@@ -51,59 +106,56 @@ void ControlFlowAnalyzer::analyze(FunctionDefinition const& _function, ContractD
 	if (_contract && _contract != _function.annotation().contract)
 		mostDerivedContractName = _contract->name();
 
+	FlowIndex index(_flow.entry);
 	checkUninitializedAccess(
-		_flow.entry,
+		index,
 		_flow.exit,
 		_function.body().statements().empty(),
 		mostDerivedContractName
 	);
-	checkUnreachable(_flow.entry, _flow.exit, _flow.revert, _flow.transactionReturn);
+	checkUnreachable(index, _flow.exit, _flow.revert, _flow.transactionReturn);
 }
 
 
-void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNode const* _exit, bool _emptyBody, optional<string> _contractName)
+void ControlFlowAnalyzer::checkUninitializedAccess(FlowIndex const& _index, CFGNode const* _exit, bool _emptyBody, optional<string> _contractName)
 {
-	struct NodeInfo
-	{
-		set<VariableDeclaration const*> unassignedVariablesAtEntry;
-		set<VariableDeclaration const*> unassignedVariablesAtExit;
-		set<VariableOccurrence const*> uninitializedVariableAccesses;
-		/// Propagate the information from another node to this node.
-		/// To be used to propagate information from a node to its exit nodes.
-		/// Returns true, if new variables were added and thus the current node has
-		/// to be traversed again.
-		bool propagateFrom(NodeInfo const& _entryNode)
-		{
-			size_t previousUnassignedVariablesAtEntry = unassignedVariablesAtEntry.size();
-			size_t previousUninitializedVariableAccessess = uninitializedVariableAccesses.size();
-			unassignedVariablesAtEntry += _entryNode.unassignedVariablesAtExit;
-			uninitializedVariableAccesses += _entryNode.uninitializedVariableAccesses;
-			return
-				unassignedVariablesAtEntry.size() > previousUnassignedVariablesAtEntry ||
-				uninitializedVariableAccesses.size() > previousUninitializedVariableAccessess
-			;
-		}
-	};
-	map<CFGNode const*, NodeInfo> nodeInfos;
-	set<CFGNode const*> nodesToTraverse;
-	nodesToTraverse.insert(_entry);
-
-	// Walk all paths starting from the nodes in ``nodesToTraverse`` until ``NodeInfo::propagateFrom``
-	// returns false for all exits, i.e. until all paths have been walked with maximal sets of unassigned
-	// variables and accesses.
+	using BitVector = boost::dynamic_bitset<>;
+
+	// The exit is not reachable, so there cannot be any path with an uninitialized access.
+	auto exitIndex = _index.nodeIndices.find(_exit);
+	if (exitIndex == _index.nodeIndices.end())
+		return;
+
+	size_t const numNodes = _index.nodes.size();
+	// Bit ``v`` is set if the variable with index ``v`` is unassigned at the entry of the node.
+	vector<BitVector> unassignedVariablesAtEntry(numNodes, BitVector(_index.variableIndices.size()));
+	// Bit ``o`` is set if the occurrence with index ``o`` is an uninitialized access on a path to the node.
+	vector<BitVector> uninitializedVariableAccesses(numNodes, BitVector(_index.occurrences.size()));
+
+	// Traverse the nodes in reverse post-order, so that most nodes are only visited after all their
+	// entries, and revisit the exits of a node until no more unassigned variables and accesses are
+	// propagated to them.
+	set<size_t> nodesToTraverse;
+	for (size_t nodeIndex = 0; nodeIndex < numNodes; ++nodeIndex)
+		nodesToTraverse.insert(nodesToTraverse.end(), nodeIndex);
+
+	BitVector unassignedVariables;
 	while (!nodesToTraverse.empty())
 	{
-		CFGNode const* currentNode = *nodesToTraverse.begin();
+		size_t currentIndex = *nodesToTraverse.begin();
 		nodesToTraverse.erase(nodesToTraverse.begin());
+		CFGNode const* currentNode = _index.nodes[currentIndex];
 
-		auto& nodeInfo = nodeInfos[currentNode];
-		auto unassignedVariables = nodeInfo.unassignedVariablesAtEntry;
-		for (auto const& variableOccurrence: currentNode->variableOccurrences)
+		unassignedVariables = unassignedVariablesAtEntry[currentIndex];
+		BitVector& accesses = uninitializedVariableAccesses[currentIndex];
+		size_t const firstOccurrence = _index.firstOccurrences[currentIndex];
+		for (size_t occurrenceIndex = firstOccurrence; occurrenceIndex < firstOccurrence + currentNode->variableOccurrences.size(); ++occurrenceIndex)
 		{
-			switch (variableOccurrence.kind())
+			size_t variableIndex = _index.occurrenceVariables[occurrenceIndex];
+			switch (_index.occurrences[occurrenceIndex]->kind())
 			{
 				case VariableOccurrence::Kind::Assignment:
-					unassignedVariables.erase(&variableOccurrence.declaration());
+					unassignedVariables.reset(variableIndex);
 					break;
 				case VariableOccurrence::Kind::InlineAssembly:
 					// We consider all variables referenced in inline assembly as accessed.
@@ -111,37 +163,45 @@ void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNod
 					// the control flow in the assembly at some point.
 				case VariableOccurrence::Kind::Access:
 				case VariableOccurrence::Kind::Return:
-					if (unassignedVariables.count(&variableOccurrence.declaration()))
+					if (unassignedVariables.test(variableIndex))
 					{
 						// Merely store the unassigned access. We do not generate an error right away, since this
 						// path might still always revert. It is only an error if this is propagated to the exit
 						// node of the function (i.e. there is a path with an uninitialized access).
-						nodeInfo.uninitializedVariableAccesses.insert(&variableOccurrence);
+						accesses.set(occurrenceIndex);
 					}
 					break;
 				case VariableOccurrence::Kind::Declaration:
-					unassignedVariables.insert(&variableOccurrence.declaration());
+					unassignedVariables.set(variableIndex);
 					break;
 			}
 		}
-		nodeInfo.unassignedVariablesAtExit = std::move(unassignedVariables);
 
 		// Propagate changes to all exits and queue them for traversal, if needed.
 		for (auto const& exit: currentNode->exits)
-			if (
-				auto exists = valueOrNullptr(nodeInfos, exit);
-				nodeInfos[exit].propagateFrom(nodeInfo) || !exists
-			)
-				nodesToTraverse.insert(exit);
+		{
+			size_t exitNodeIndex = _index.nodeIndices.at(exit);
+			BitVector& exitUnassigned = unassignedVariablesAtEntry[exitNodeIndex];
+			BitVector& exitAccesses = uninitializedVariableAccesses[exitNodeIndex];
+			if (!unassignedVariables.is_subset_of(exitUnassigned) || !accesses.is_subset_of(exitAccesses))
+			{
+				exitUnassigned |= unassignedVariables;
+				exitAccesses |= accesses;
+				nodesToTraverse.insert(exitNodeIndex);
+			}
+		}
 	}
 
-	auto const& exitInfo = nodeInfos[_exit];
-	if (!exitInfo.uninitializedVariableAccesses.empty())
+	BitVector const& exitAccesses = uninitializedVariableAccesses[exitIndex->second];
+	if (exitAccesses.any())
 	{
-		vector<VariableOccurrence const*> uninitializedAccessesOrdered(
-			exitInfo.uninitializedVariableAccesses.begin(),
-			exitInfo.uninitializedVariableAccesses.end()
-		);
+		vector<VariableOccurrence const*> uninitializedAccessesOrdered;
+		for (
+			size_t occurrenceIndex = exitAccesses.find_first();
+			occurrenceIndex != BitVector::npos;
+			occurrenceIndex = exitAccesses.find_next(occurrenceIndex)
+		)
+			uninitializedAccessesOrdered.push_back(_index.occurrences[occurrenceIndex]);
 		ranges::sort(
 			uninitializedAccessesOrdered,
 			[](VariableOccurrence const* lhs, VariableOccurrence const* rhs) -> bool
@@ -194,22 +254,14 @@ void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNod
 	}
 }
 
-void ControlFlowAnalyzer::checkUnreachable(CFGNode const* _entry, CFGNode const* _exit, CFGNode const* _revert, CFGNode const* _transactionReturn)
+void ControlFlowAnalyzer::checkUnreachable(FlowIndex const& _index, CFGNode const* _exit, CFGNode const* _revert, CFGNode const* _transactionReturn)
 {
-	// collect all nodes reachable from the entry point
-	std::set<CFGNode const*> reachable = util::BreadthFirstSearch<CFGNode const*>{{_entry}}.run(
-		[](CFGNode const* _node, auto&& _addChild) {
-			for (CFGNode const* exit: _node->exits)
-				_addChild(exit);
-		}
-	).visited;
-
 	// traverse all paths backwards from exit, revert and transaction return
 	// and extract (valid) source locations of unreachable nodes into sorted set
 	std::set<SourceLocation> unreachable;
 	util::BreadthFirstSearch<CFGNode const*>{{_exit, _revert, _transactionReturn}}.run(
 		[&](CFGNode const* _node, auto&& _addChild) {
-			if (!reachable.count(_node) && _node->location.isValid())
+			if (!_index.nodeIndices.count(_node) && _node->location.isValid())
 				unreachable.insert(_node->location);
 			for (CFGNode const* entry: _node->entries)
 				_addChild(entry);
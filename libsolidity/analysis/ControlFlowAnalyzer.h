@@ -34,17 +34,22 @@ public:
 	bool run();
 
 private:
+	/// The nodes of a function flow that are reachable from its entry in reverse post-order, together
+	/// with dense indices of the variables and variable occurrences in these nodes.
+	/// Shared by the dataflow analysis and the unreachable code detection.
+	struct FlowIndex;
+
 	void analyze(FunctionDefinition const& _function, ContractDefinition const* _contract, FunctionFlow const& _flow);
 	/// Checks for uninitialized variable accesses in the control flow between @param _entry and @param _exit.
-	/// @param _entry entry node
+	/// @param _index the reachable nodes of the flow starting at @param _entry
 	/// @param _exit exit node
 	/// @param _emptyBody whether the body of the function is empty (true) or not (false)
 	/// @param _contractName name of the most derived contract, should be empty
 	///        if the function is also defined in it
-	void checkUninitializedAccess(CFGNode const* _entry, CFGNode const* _exit, bool _emptyBody, std::optional<std::string> _contractName = {});
+	void checkUninitializedAccess(FlowIndex const& _index, CFGNode const* _exit, bool _emptyBody, std::optional<std::string> _contractName = {});
 	/// Checks for unreachable code, i.e. code ending in @param _exit, @param _revert or @param _transactionReturn
-	/// that can not be reached from @param _entry.
-	void checkUnreachable(CFGNode const* _entry, CFGNode const* _exit, CFGNode const* _revert, CFGNode const* _transactionReturn);
+	/// that is not contained in @param _index, i.e. can not be reached from the entry.
+	void checkUnreachable(FlowIndex const& _index, CFGNode const* _exit, CFGNode const* _revert, CFGNode const* _transactionReturn);
 
 	CFG const& m_cfg;
 	langutil::ErrorReporter& m_errorReporter;
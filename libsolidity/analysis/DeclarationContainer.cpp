@@ -29,10 +29,23 @@
 #include <range/v3/view/filter.hpp>
 #include <range/v3/range/conversion.hpp>
 
+#include <algorithm>
+#include <atomic>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// Incremented whenever a declaration is registered or activated in any container, which
+/// invalidates all cached lookups. A lookup can see the declarations of all enclosing containers,
+/// so a change to any of them can change its result.
+atomic<uint64_t> declarationGeneration{1};
+
+}
+
 Declaration const* DeclarationContainer::conflictingDeclaration(
 	Declaration const& _declaration,
 	ASTString const* _name
@@ -42,10 +55,10 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	if (auto visible = m_declarations.find(*_name); visible != m_declarations.end())
+		declarations += visible->second;
+	if (auto invisible = m_invisibleDeclarations.find(*_name); invisible != m_invisibleDeclarations.end())
+		declarations += invisible->second;
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -85,13 +98,16 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 
 void DeclarationContainer::activateVariable(ASTString const& _name)
 {
+	auto invisible = m_invisibleDeclarations.find(_name);
 	solAssert(
-		m_invisibleDeclarations.count(_name) && m_invisibleDeclarations.at(_name).size() == 1,
+		invisible != m_invisibleDeclarations.end() && invisible->second.size() == 1,
 		"Tried to activate a non-inactive variable or multiple inactive variables with the same name."
 	);
-	solAssert(m_declarations.count(_name) == 0 || m_declarations.at(_name).empty(), "");
-	m_declarations[_name].emplace_back(m_invisibleDeclarations.at(_name).front());
-	m_invisibleDeclarations.erase(_name);
+	vector<Declaration const*>& declarations = m_declarations[_name];
+	solAssert(declarations.empty(), "");
+	declarations.emplace_back(invisible->second.front());
+	m_invisibleDeclarations.erase(invisible);
+	++declarationGeneration;
 }
 
 bool DeclarationContainer::isInvisible(ASTString const& _name) const
@@ -130,6 +146,8 @@ bool DeclarationContainer::registerDeclaration(
 	vector<Declaration const*>& decls = _invisible ? m_invisibleDeclarations[*_name] : m_declarations[*_name];
 	if (!util::contains(decls, &_declaration))
 		decls.push_back(&_declaration);
+	m_namesByLength[_name->size()].insert(*_name);
+	++declarationGeneration;
 	return true;
 }
 
@@ -151,27 +169,53 @@ vector<Declaration const*> DeclarationContainer::resolveName(
 {
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
 	vector<Declaration const*> result;
+	resolveNameLocally(_name, _alsoInvisible, _onlyVisibleAsUnqualifiedNames, result);
+	if (!result.empty() || !_recursive || !m_enclosingContainer)
+		return result;
 
-	if (m_declarations.count(_name))
-	{
-		if (_onlyVisibleAsUnqualifiedNames)
-			result += m_declarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
-		else
-			result += m_declarations.at(_name);
-	}
+	uint64_t const generation = declarationGeneration;
+	CachedResolution& cached = m_resolutionCache[(_alsoInvisible ? 2u : 0u) | (_onlyVisibleAsUnqualifiedNames ? 1u : 0u)][_name];
+	if (cached.generation == generation)
+		return cached.declarations;
+
+	for (
+		DeclarationContainer const* container = m_enclosingContainer;
+		container && result.empty();
+		container = container->m_enclosingContainer
+	)
+		container->resolveNameLocally(_name, _alsoInvisible, _onlyVisibleAsUnqualifiedNames, result);
+
+	cached.generation = generation;
+	cached.declarations = result;
+	return result;
+}
 
-	if (_alsoInvisible && m_invisibleDeclarations.count(_name))
+void DeclarationContainer::resolveNameLocally(
+	ASTString const& _name,
+	bool _alsoInvisible,
+	bool _onlyVisibleAsUnqualifiedNames,
+	vector<Declaration const*>& _result
+) const
+{
+	auto append = [&](vector<Declaration const*> const& _declarations)
 	{
 		if (_onlyVisibleAsUnqualifiedNames)
-			result += m_invisibleDeclarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
+			_result += _declarations | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
 		else
-			result += m_invisibleDeclarations.at(_name);
-	}
+			_result += _declarations;
+	};
 
-	if (result.empty() && _recursive && m_enclosingContainer)
-		result = m_enclosingContainer->resolveName(_name, true, _alsoInvisible, _onlyVisibleAsUnqualifiedNames);
+	if (auto visible = m_declarations.find(_name); visible != m_declarations.end())
+		append(visible->second);
 
-	return result;
+	if (_alsoInvisible)
+		if (auto invisible = m_invisibleDeclarations.find(_name); invisible != m_invisibleDeclarations.end())
+			append(invisible->second);
+}
+
+map<ASTString, vector<Declaration const*>> DeclarationContainer::declarations() const
+{
+	return {m_declarations.begin(), m_declarations.end()};
 }
 
 vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) const
@@ -182,19 +226,27 @@ vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) con
 	static size_t const MAXIMUM_LENGTH_THRESHOLD = 80 * 80;
 
 	vector<ASTString> similar;
+	vector<ASTString> similarInvisible;
 	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
-	for (auto const& declaration: m_declarations)
-	{
-		string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
-	}
-	for (auto const& declaration: m_invisibleDeclarations)
-	{
-		string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
-	}
+	// The edit distance is at least the difference of the lengths, so only those lengths are searched.
+	auto const lengthsEnd = m_namesByLength.upper_bound(_name.size() + maximumEditDistance);
+	for (
+		auto lengths = m_namesByLength.lower_bound(_name.size() > maximumEditDistance ? _name.size() - maximumEditDistance : 0);
+		lengths != lengthsEnd;
+		++lengths
+	)
+		for (ASTString const& declarationName: lengths->second)
+			if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
+			{
+				if (m_declarations.count(declarationName))
+					similar.push_back(declarationName);
+				if (m_invisibleDeclarations.count(declarationName))
+					similarInvisible.push_back(declarationName);
+			}
+	// Sorted per group, so that the suggestions do not depend on the order of the index.
+	sort(similar.begin(), similar.end());
+	sort(similarInvisible.begin(), similarInvisible.end());
+	similar += move(similarInvisible);
 
 	if (m_enclosingContainer)
 		similar += m_enclosingContainer->similarNames(_name);
@@ -202,6 +254,18 @@ vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) con
 	return similar;
 }
 
+void DeclarationContainer::retainInnerContainers(set<DeclarationContainer const*> const& _containers)
+{
+	m_innerContainers.erase(
+		remove_if(
+			m_innerContainers.begin(),
+			m_innerContainers.end(),
+			[&](DeclarationContainer const* _container) { return !_containers.count(_container); }
+		),
+		m_innerContainers.end()
+	);
+}
+
 void DeclarationContainer::populateHomonyms(back_insert_iterator<Homonyms> _it) const
 {
 	for (DeclarationContainer const* innerContainer: m_innerContainers)
@@ -27,6 +27,13 @@
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <array>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
 namespace solidity::frontend
 {
 
@@ -64,6 +71,8 @@ public:
 	/// @param _onlyVisibleAsUnqualifiedNames if true, do not include declarations which can never
 	///        actually be referenced using their name alone (without being qualified with the name
 	///        of scope in which they are declared).
+	/// Results of recursive lookups are cached until a declaration is registered or activated in
+	/// any container.
 	std::vector<Declaration const*> resolveName(
 		ASTString const& _name,
 		bool _recursive = false,
@@ -72,7 +81,8 @@ public:
 	) const;
 	ASTNode const* enclosingNode() const { return m_enclosingNode; }
 	DeclarationContainer const* enclosingContainer() const { return m_enclosingContainer; }
-	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const { return m_declarations; }
+	/// @returns the visible declarations, ordered by name.
+	std::map<ASTString, std::vector<Declaration const*>> declarations() const;
 	/// @returns whether declaration is valid, and if not also returns previous declaration.
 	Declaration const* conflictingDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr) const;
 
@@ -91,12 +101,35 @@ public:
 	/// and declaration is the corresponding homonymous outer-scope declaration.
 	void populateHomonyms(std::back_insert_iterator<Homonyms> _it) const;
 
+	/// Forgets all inner containers that are not in @a _containers, e.g. because they are destroyed.
+	void retainInnerContainers(std::set<DeclarationContainer const*> const& _containers);
+
 private:
+	struct CachedResolution
+	{
+		uint64_t generation = 0;
+		std::vector<Declaration const*> declarations;
+	};
+
+	/// Appends the declarations named @a _name in this container (but not the enclosing ones) to @a _result.
+	void resolveNameLocally(
+		ASTString const& _name,
+		bool _alsoInvisible,
+		bool _onlyVisibleAsUnqualifiedNames,
+		std::vector<Declaration const*>& _result
+	) const;
+
 	ASTNode const* m_enclosingNode = nullptr;
 	DeclarationContainer const* m_enclosingContainer = nullptr;
 	std::vector<DeclarationContainer const*> m_innerContainers;
-	std::map<ASTString, std::vector<Declaration const*>> m_declarations;
-	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_declarations;
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	/// Names of all visible and invisible declarations, indexed by their length, so that
+	/// similar names are only searched among names of similar length.
+	std::map<size_t, std::set<ASTString>> m_namesByLength;
+	/// Results of recursive lookups, indexed by the flags of the lookup.
+	/// They are valid as long as their generation is the current one.
+	mutable std::array<std::unordered_map<ASTString, CachedResolution>, 4> m_resolutionCache;
 	/// List of declarations (name and location) to check later for homonymity.
 	std::vector<std::pair<std::string, langutil::SourceLocation const*>> m_homonymCandidates;
 };
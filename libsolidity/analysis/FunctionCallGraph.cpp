@@ -18,6 +18,7 @@
 
 #include <libsolidity/analysis/FunctionCallGraph.h>
 
+#include <libsolutil/Common.h>
 #include <libsolutil/StringUtils.h>
 
 #include <range/v3/range/conversion.hpp>
@@ -28,9 +29,9 @@ using namespace std;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
-CallGraph FunctionCallGraphBuilder::buildCreationGraph(ContractDefinition const& _contract)
+CallGraph FunctionCallGraphBuilder::buildCreationGraph(ContractDefinition const& _contract, CallSummaries* _summaries)
 {
-	FunctionCallGraphBuilder builder(_contract);
+	FunctionCallGraphBuilder builder(_contract, _summaries);
 	solAssert(builder.m_currentNode == CallGraph::Node(CallGraph::SpecialNode::Entry), "");
 
 	// Create graph for constructor, state vars, etc
@@ -41,7 +42,7 @@ CallGraph FunctionCallGraphBuilder::buildCreationGraph(ContractDefinition const&
 		builder.m_currentNode = CallGraph::SpecialNode::Entry;
 		for (auto const* stateVar: base->stateVariables())
 			if (!stateVar->isConstant())
-				stateVar->accept(builder);
+				builder.addCallsOf(*stateVar);
 
 		if (base->constructor())
 		{
@@ -55,7 +56,7 @@ CallGraph FunctionCallGraphBuilder::buildCreationGraph(ContractDefinition const&
 		// Functions called from the inheritance specifier should have an edge from the constructor
 		// for consistency with functions called from constructor modifiers.
 		for (auto const& inheritanceSpecifier: base->baseContracts())
-			inheritanceSpecifier->accept(builder);
+			builder.addCallsOf(*inheritanceSpecifier);
 	}
 
 	builder.m_currentNode = CallGraph::SpecialNode::Entry;
@@ -66,10 +67,11 @@ CallGraph FunctionCallGraphBuilder::buildCreationGraph(ContractDefinition const&
 
 CallGraph FunctionCallGraphBuilder::buildDeployedGraph(
 	ContractDefinition const& _contract,
-	CallGraph const& _creationGraph
+	CallGraph const& _creationGraph,
+	CallSummaries* _summaries
 )
 {
-	FunctionCallGraphBuilder builder(_contract);
+	FunctionCallGraphBuilder builder(_contract, _summaries);
 	solAssert(builder.m_currentNode == CallGraph::Node(CallGraph::SpecialNode::Entry), "");
 
 	auto getSecondElement = [](auto const& _tuple){ return get<1>(_tuple); };
@@ -124,9 +126,9 @@ bool FunctionCallGraphBuilder::visit(FunctionCall const& _functionCall)
 		// If it's not a direct call, we don't really know which function will be called (it may even
 		// change at runtime). All we can do is to add an edge to the dispatch which in turn has
 		// edges to all functions could possibly be called.
-		add(m_currentNode, CallGraph::SpecialNode::InternalDispatch);
+		m_currentSummary->callsInternalDispatch = true;
 	else if (functionType->kind() == FunctionType::Kind::Error)
-		m_graph.usedErrors.insert(&dynamic_cast<ErrorDefinition const&>(functionType->declaration()));
+		m_currentSummary->usedErrors.push_back(&dynamic_cast<ErrorDefinition const&>(functionType->declaration()));
 
 	return true;
 }
@@ -136,7 +138,7 @@ bool FunctionCallGraphBuilder::visit(EmitStatement const& _emitStatement)
 	auto const* functionType = dynamic_cast<FunctionType const*>(_emitStatement.eventCall().expression().annotation().type);
 	solAssert(functionType, "");
 
-	m_graph.emittedEvents.insert(&dynamic_cast<EventDefinition const&>(functionType->declaration()));
+	m_currentSummary->emittedEvents.push_back(&dynamic_cast<EventDefinition const&>(functionType->declaration()));
 
 	return true;
 }
@@ -159,7 +161,7 @@ bool FunctionCallGraphBuilder::visit(Identifier const& _identifier)
 
 		// For events kind() == Event, so we have an extra check here
 		if (funType && funType->kind() == FunctionType::Kind::Internal)
-			functionReferenced(callable->resolveVirtual(m_contract), _identifier.annotation().calledDirectly);
+			m_currentSummary->references.push_back({callable, VirtualLookup::Virtual, nullptr, _identifier.annotation().calledDirectly});
 	}
 
 	return true;
@@ -176,7 +178,7 @@ bool FunctionCallGraphBuilder::visit(MemberAccess const& _memberAccess)
 		))
 		{
 			ContractType const& accessedContractType = dynamic_cast<ContractType const&>(*magicType->typeArgument());
-			m_graph.bytecodeDependency.emplace(&accessedContractType.contractDefinition(), &_memberAccess);
+			m_currentSummary->bytecodeDependencies.emplace_back(&accessedContractType.contractDefinition(), &_memberAccess);
 		}
 
 	auto functionType = dynamic_cast<FunctionType const*>(_memberAccess.annotation().type);
@@ -184,23 +186,22 @@ bool FunctionCallGraphBuilder::visit(MemberAccess const& _memberAccess)
 	if (!functionType || !functionDef || functionType->kind() != FunctionType::Kind::Internal)
 		return true;
 
-	// Super functions
+	CallSummary::Reference reference{functionDef, VirtualLookup::Static, nullptr, _memberAccess.annotation().calledDirectly};
+	// Super functions are resolved once the most derived contract is known.
 	if (*_memberAccess.annotation().requiredLookup == VirtualLookup::Super)
 	{
 		if (auto const* typeType = dynamic_cast<TypeType const*>(exprType))
 			if (auto const contractType = dynamic_cast<ContractType const*>(typeType->actualType()))
 			{
 				solAssert(contractType->isSuper(), "");
-				functionDef = &functionDef->resolveVirtual(
-					m_contract,
-					contractType->contractDefinition().superContract(m_contract)
-				);
+				reference.lookup = VirtualLookup::Super;
+				reference.superCallScope = &contractType->contractDefinition();
 			}
 	}
 	else
 		solAssert(*_memberAccess.annotation().requiredLookup == VirtualLookup::Static, "");
 
-	functionReferenced(*functionDef, _memberAccess.annotation().calledDirectly);
+	m_currentSummary->references.push_back(reference);
 	return true;
 }
 
@@ -210,13 +211,8 @@ bool FunctionCallGraphBuilder::visit(ModifierInvocation const& _modifierInvocati
 	{
 		VirtualLookup const& requiredLookup = *_modifierInvocation.name().annotation().requiredLookup;
 
-		if (requiredLookup == VirtualLookup::Virtual)
-			functionReferenced(modifier->resolveVirtual(m_contract));
-		else
-		{
-			solAssert(requiredLookup == VirtualLookup::Static, "");
-			functionReferenced(*modifier);
-		}
+		solAssert(requiredLookup == VirtualLookup::Virtual || requiredLookup == VirtualLookup::Static, "");
+		m_currentSummary->references.push_back({modifier, requiredLookup, nullptr, true});
 	}
 
 	return true;
@@ -225,7 +221,7 @@ bool FunctionCallGraphBuilder::visit(ModifierInvocation const& _modifierInvocati
 bool FunctionCallGraphBuilder::visit(NewExpression const& _newExpression)
 {
 	if (ContractType const* contractType = dynamic_cast<ContractType const*>(_newExpression.typeName().annotation().type))
-		m_graph.bytecodeDependency.emplace(&contractType->contractDefinition(), &_newExpression);
+		m_currentSummary->bytecodeDependencies.emplace_back(&contractType->contractDefinition(), &_newExpression);
 
 	return true;
 }
@@ -251,12 +247,50 @@ void FunctionCallGraphBuilder::processQueue()
 		solAssert(holds_alternative<CallableDeclaration const*>(m_currentNode), "");
 
 		m_visitQueue.pop_front();
-		get<CallableDeclaration const*>(m_currentNode)->accept(*this);
+		addCallsOf(*get<CallableDeclaration const*>(m_currentNode));
 	}
 
 	m_currentNode = CallGraph::SpecialNode::Entry;
 }
 
+FunctionCallGraphBuilder::CallSummary const& FunctionCallGraphBuilder::summary(ASTNode const& _node)
+{
+	auto [summary, inserted] = m_summaries->try_emplace(&_node);
+	if (inserted)
+	{
+		solAssert(!m_currentSummary, "");
+		m_currentSummary = &summary->second;
+		ScopeGuard resetSummary([&]() { m_currentSummary = nullptr; });
+		_node.accept(*this);
+	}
+	return summary->second;
+}
+
+void FunctionCallGraphBuilder::addCallsOf(ASTNode const& _node)
+{
+	CallSummary const& calls = summary(_node);
+
+	for (CallSummary::Reference const& reference: calls.references)
+	{
+		CallableDeclaration const* callable = reference.callable;
+		if (reference.lookup == VirtualLookup::Virtual)
+			callable = &callable->resolveVirtual(m_contract);
+		else if (reference.lookup == VirtualLookup::Super)
+		{
+			solAssert(reference.superCallScope, "");
+			callable = &callable->resolveVirtual(m_contract, reference.superCallScope->superContract(m_contract));
+		}
+		functionReferenced(*callable, reference.calledDirectly);
+	}
+
+	if (calls.callsInternalDispatch)
+		add(m_currentNode, CallGraph::SpecialNode::InternalDispatch);
+	for (auto const& [contract, node]: calls.bytecodeDependencies)
+		m_graph.bytecodeDependency.emplace(contract, node);
+	m_graph.emittedEvents.insert(calls.emittedEvents.begin(), calls.emittedEvents.end());
+	m_graph.usedErrors.insert(calls.usedErrors.begin(), calls.usedErrors.end());
+}
+
 void FunctionCallGraphBuilder::add(CallGraph::Node _caller, CallGraph::Node _callee)
 {
 	m_graph.edges[_caller].insert(_callee);
@@ -24,6 +24,9 @@
 
 #include <deque>
 #include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -57,15 +60,42 @@ namespace solidity::frontend
 class FunctionCallGraphBuilder: private ASTConstVisitor
 {
 public:
-	static CallGraph buildCreationGraph(ContractDefinition const& _contract);
+	/// The calls and other graph relevant facts of a function, modifier, state variable or inheritance
+	/// specifier. They do not depend on the contract the graph is built for, since virtual and super
+	/// calls are only resolved when the summary is added to the graph.
+	struct CallSummary
+	{
+		struct Reference
+		{
+			CallableDeclaration const* callable = nullptr;
+			VirtualLookup lookup = VirtualLookup::Static;
+			/// The contract the super call is made from, for VirtualLookup::Super.
+			ContractDefinition const* superCallScope = nullptr;
+			bool calledDirectly = true;
+		};
+		/// The referenced callables in the order of their first reference.
+		std::vector<Reference> references;
+		bool callsInternalDispatch = false;
+		/// In the order of their occurrence, since the graph keeps the first one per contract.
+		std::vector<std::pair<ContractDefinition const*, ASTNode const*>> bytecodeDependencies;
+		std::vector<EventDefinition const*> emittedEvents;
+		std::vector<ErrorDefinition const*> usedErrors;
+	};
+	/// Call summaries by AST node. They can be shared between the graphs of all contracts, so that
+	/// the functions of a base contract are only visited once and not once per derived contract.
+	using CallSummaries = std::unordered_map<ASTNode const*, CallSummary>;
+
+	static CallGraph buildCreationGraph(ContractDefinition const& _contract, CallSummaries* _summaries = nullptr);
 	static CallGraph buildDeployedGraph(
 		ContractDefinition const& _contract,
-		CallGraph const& _creationGraph
+		CallGraph const& _creationGraph,
+		CallSummaries* _summaries = nullptr
 	);
 
 private:
-	FunctionCallGraphBuilder(ContractDefinition const& _contract):
-		m_contract(_contract)
+	FunctionCallGraphBuilder(ContractDefinition const& _contract, CallSummaries* _summaries):
+		m_contract(_contract),
+		m_summaries(_summaries ? _summaries : &m_ownSummaries)
 	{}
 
 	bool visit(FunctionCall const& _functionCall) override;
@@ -78,6 +108,11 @@ private:
 	void enqueueCallable(CallableDeclaration const& _callable);
 	void processQueue();
 
+	/// @returns the call summary of @a _node, visiting it if it is not known yet.
+	CallSummary const& summary(ASTNode const& _node);
+	/// Adds the calls of @a _node to the graph, as calls from m_currentNode.
+	void addCallsOf(ASTNode const& _node);
+
 	void add(CallGraph::Node _caller, CallGraph::Node _callee);
 	void functionReferenced(CallableDeclaration const& _callable, bool _calledDirectly = true);
 
@@ -85,6 +120,10 @@ private:
 	ContractDefinition const& m_contract;
 	CallGraph m_graph;
 	std::deque<CallableDeclaration const*> m_visitQueue;
+	/// The summary the visitor currently records to.
+	CallSummary* m_currentSummary = nullptr;
+	CallSummaries m_ownSummaries;
+	CallSummaries* m_summaries = nullptr;
 };
 
 std::ostream& operator<<(std::ostream& _out, CallGraph::Node const& _node);
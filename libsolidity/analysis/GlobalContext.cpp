@@ -125,6 +125,18 @@ vector<Declaration const*> GlobalContext::declarations() const
 	return declarations;
 }
 
+void GlobalContext::retainContracts(set<ContractDefinition const*> const& _contracts)
+{
+	if (m_currentContract && !_contracts.count(m_currentContract))
+		m_currentContract = nullptr;
+	for (auto* declarations: {&m_thisPointer, &m_superPointer})
+		for (auto it = declarations->begin(); it != declarations->end();)
+			if (it->first && !_contracts.count(it->first))
+				it = declarations->erase(it);
+			else
+				++it;
+}
+
 MagicVariableDeclaration const* GlobalContext::currentThis() const
 {
 	if (!m_thisPointer[m_currentContract])
@@ -26,6 +26,7 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -56,6 +57,10 @@ public:
 	/// @returns a vector of all implicit global declarations excluding "this".
 	std::vector<Declaration const*> declarations() const;
 
+	/// Removes the "this" and "super" declarations of all contracts not in @a _contracts,
+	/// e.g. because they are destroyed.
+	void retainContracts(std::set<ContractDefinition const*> const& _contracts);
+
 private:
 	std::vector<std::shared_ptr<MagicVariableDeclaration const>> m_magicVariables;
 	ContractDefinition const* m_currentContract = nullptr;
@@ -143,6 +143,26 @@ bool NameAndTypeResolver::resolveNamesAndTypes(SourceUnit& _source)
 	return true;
 }
 
+void NameAndTypeResolver::retainScopes(set<ASTNode const*> const& _nodes)
+{
+	set<DeclarationContainer const*> retainedScopes;
+	for (auto it = m_scopes.begin(); it != m_scopes.end();)
+		if (it->first && !_nodes.count(it->first))
+			it = m_scopes.erase(it);
+		else
+		{
+			retainedScopes.insert(it->second.get());
+			++it;
+		}
+	for (auto const& scope: m_scopes)
+		scope.second->retainInnerContainers(retainedScopes);
+
+	// "this" and "super" still refer to the contract that was resolved last.
+	m_globalContext.resetCurrentContract();
+	m_scopes[nullptr]->registerDeclaration(*m_globalContext.currentThis(), true, true);
+	m_scopes[nullptr]->registerDeclaration(*m_globalContext.currentSuper(), true, true);
+}
+
 bool NameAndTypeResolver::updateDeclaration(Declaration const& _declaration)
 {
 	try
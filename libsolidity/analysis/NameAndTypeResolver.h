@@ -103,6 +103,11 @@ public:
 	/// Sets the current scope.
 	void setScope(ASTNode const* _node);
 
+	/// Removes the scopes of all nodes not in @a _nodes, so that the declarations of the remaining
+	/// source units can be reused while the other source units are registered and resolved again.
+	/// The nodes of the removed scopes may already be destroyed.
+	void retainScopes(std::set<ASTNode const*> const& _nodes);
+
 private:
 	/// Internal version of @a resolveNamesAndTypes (called from there) throws exceptions on fatal errors.
 	bool resolveNamesAndTypesInternal(ASTNode& _node, bool _resolveInsideCode = true);
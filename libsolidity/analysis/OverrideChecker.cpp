@@ -37,22 +37,11 @@ using namespace solidity::frontend;
 using namespace solidity::langutil;
 
 using solidity::util::GenericVisitor;
-using solidity::util::contains_if;
 using solidity::util::joinHumanReadable;
 
 namespace
 {
 
-// Helper struct to do a search by name
-struct MatchByName
-{
-	string const& m_name;
-	bool operator()(OverrideProxy const& _item)
-	{
-		return _item.name() == m_name;
-	}
-};
-
 /**
  * Construct the override graph for this signature.
  * Reserve node 0 for the current contract and node
@@ -465,28 +454,33 @@ void OverrideChecker::checkIllegalOverrides(ContractDefinition const& _contract)
 	OverrideProxyBySignatureMultiSet const& inheritedFuncs = inheritedFunctions(_contract);
 	OverrideProxyBySignatureMultiSet const& inheritedMods = inheritedModifiers(_contract);
 
-	for (ModifierDefinition const* modifier: _contract.functionModifiers())
+	set<string> inheritedFunctionNames;
+	for (OverrideProxy const& function: inheritedFuncs)
+		inheritedFunctionNames.insert(function.name());
+	set<string> inheritedModifierNames;
+	for (OverrideProxy const& modifier: inheritedMods)
+		inheritedModifierNames.insert(modifier.name());
+
+	for (OverrideProxy const& modifier: definedModifiers(_contract))
 	{
-		if (contains_if(inheritedFuncs, MatchByName{modifier->name()}))
+		if (inheritedFunctionNames.count(modifier.name()))
 			m_errorReporter.typeError(
 				5631_error,
-				modifier->location(),
+				modifier.location(),
 				"Override changes function or public state variable to modifier."
 			);
 
-		checkOverrideList(OverrideProxy{modifier}, inheritedMods);
+		checkOverrideList(modifier, inheritedMods);
 	}
 
-	for (FunctionDefinition const* function: _contract.definedFunctions())
+	for (OverrideProxy const& function: definedFunctions(_contract))
 	{
-		if (function->isConstructor())
-			continue;
+		if (inheritedModifierNames.count(function.name()))
+			m_errorReporter.typeError(1469_error, function.location(), "Override changes modifier to function.");
 
-		if (contains_if(inheritedMods, MatchByName{function->name()}))
-			m_errorReporter.typeError(1469_error, function->location(), "Override changes modifier to function.");
-
-		checkOverrideList(OverrideProxy{function}, inheritedFuncs);
+		checkOverrideList(function, inheritedFuncs);
 	}
+	auto publicStateVar = publicStateVariables(_contract).begin();
 	for (auto const* stateVar: _contract.stateVariables())
 	{
 		if (!stateVar->isPublic())
@@ -497,10 +491,11 @@ void OverrideChecker::checkIllegalOverrides(ContractDefinition const& _contract)
 			continue;
 		}
 
-		if (contains_if(inheritedMods, MatchByName{stateVar->name()}))
+		if (inheritedModifierNames.count(stateVar->name()))
 			m_errorReporter.typeError(1456_error, stateVar->location(), "Override changes modifier to public state variable.");
 
-		checkOverrideList(OverrideProxy{stateVar}, inheritedFuncs);
+		solAssert(publicStateVar->declaration() == stateVar, "");
+		checkOverrideList(*publicStateVar++, inheritedFuncs);
 	}
 
 }
@@ -687,20 +682,25 @@ void OverrideChecker::checkAmbiguousOverrides(ContractDefinition const& _contrac
 		// Fetch inherited functions and sort them by signature.
 		// We get at least one function per signature and direct base contract, which is
 		// enough because we re-construct the inheritance graph later.
-		OverrideProxyBySignatureMultiSet nonOverriddenFunctions = inheritedFunctions(_contract);
+		OverrideProxyBySignatureMultiSet const& inheritedFuncs = inheritedFunctions(_contract);
 
-		// Remove all functions that match the signature of a function in the current contract.
-		for (FunctionDefinition const* f: _contract.definedFunctions())
-			nonOverriddenFunctions.erase(OverrideProxy{f});
-		for (VariableDeclaration const* v: _contract.stateVariables())
-			if (v->isPublic())
-				nonOverriddenFunctions.erase(OverrideProxy{v});
+		// Skip all functions that match the signature of a function in the current contract.
+		set<OverrideProxy, OverrideProxy::CompareBySignature> overridden;
+		overridden += definedFunctions(_contract);
+		overridden += publicStateVariables(_contract);
 
 		// Walk through the set of functions signature by signature.
-		for (auto it = nonOverriddenFunctions.cbegin(); it != nonOverriddenFunctions.cend();)
+		for (auto it = inheritedFuncs.cbegin(); it != inheritedFuncs.cend();)
 		{
+			auto nextSignature = inheritedFuncs.upper_bound(*it);
+			if (overridden.count(*it))
+			{
+				it = nextSignature;
+				continue;
+			}
+
 			std::set<OverrideProxy> baseFunctions;
-			for (auto nextSignature = nonOverriddenFunctions.upper_bound(*it); it != nextSignature; ++it)
+			for (; it != nextSignature; ++it)
 				baseFunctions.insert(*it);
 
 			checkAmbiguousOverridesInternal(std::move(baseFunctions), _contract.location());
@@ -708,14 +708,21 @@ void OverrideChecker::checkAmbiguousOverrides(ContractDefinition const& _contrac
 	}
 
 	{
-		OverrideProxyBySignatureMultiSet modifiers = inheritedModifiers(_contract);
-		for (ModifierDefinition const* mod: _contract.functionModifiers())
-			modifiers.erase(OverrideProxy{mod});
+		OverrideProxyBySignatureMultiSet const& modifiers = inheritedModifiers(_contract);
+		set<OverrideProxy, OverrideProxy::CompareBySignature> overridden;
+		overridden += definedModifiers(_contract);
 
 		for (auto it = modifiers.cbegin(); it != modifiers.cend();)
 		{
+			auto next = modifiers.upper_bound(*it);
+			if (overridden.count(*it))
+			{
+				it = next;
+				continue;
+			}
+
 			std::set<OverrideProxy> baseModifiers;
-			for (auto next = modifiers.upper_bound(*it); it != next; ++it)
+			for (; it != next; ++it)
 				baseModifiers.insert(*it);
 
 			checkAmbiguousOverridesInternal(std::move(baseModifiers), _contract.location());
@@ -890,12 +897,8 @@ OverrideChecker::OverrideProxyBySignatureMultiSet const& OverrideChecker::inheri
 		for (auto const* base: resolveDirectBaseContracts(_contract))
 		{
 			set<OverrideProxy, OverrideProxy::CompareBySignature> functionsInBase;
-			for (FunctionDefinition const* fun: base->definedFunctions())
-				if (!fun->isConstructor())
-					functionsInBase.emplace(OverrideProxy{fun});
-			for (VariableDeclaration const* var: base->stateVariables())
-				if (var->isPublic())
-					functionsInBase.emplace(OverrideProxy{var});
+			functionsInBase += definedFunctions(*base);
+			functionsInBase += publicStateVariables(*base);
 
 			for (OverrideProxy const& func: inheritedFunctions(*base))
 				functionsInBase.insert(func);
@@ -918,8 +921,7 @@ OverrideChecker::OverrideProxyBySignatureMultiSet const& OverrideChecker::inheri
 		for (auto const* base: resolveDirectBaseContracts(_contract))
 		{
 			set<OverrideProxy, OverrideProxy::CompareBySignature> modifiersInBase;
-			for (ModifierDefinition const* mod: base->functionModifiers())
-				modifiersInBase.emplace(OverrideProxy{mod});
+			modifiersInBase += definedModifiers(*base);
 
 			for (OverrideProxy const& mod: inheritedModifiers(*base))
 				modifiersInBase.insert(mod);
@@ -932,3 +934,35 @@ OverrideChecker::OverrideProxyBySignatureMultiSet const& OverrideChecker::inheri
 
 	return m_inheritedModifiers[&_contract];
 }
+
+vector<OverrideProxy> const& OverrideChecker::definedFunctions(ContractDefinition const& _contract) const
+{
+	auto [it, inserted] = m_definedFunctions.try_emplace(&_contract);
+	if (inserted)
+		for (FunctionDefinition const* fun: _contract.definedFunctions())
+			if (!fun->isConstructor())
+				// Computing the comparator here shares it with all copies of the proxy.
+				it->second.emplace_back(fun).overrideComparator();
+	return it->second;
+}
+
+vector<OverrideProxy> const& OverrideChecker::publicStateVariables(ContractDefinition const& _contract) const
+{
+	auto [it, inserted] = m_publicStateVariables.try_emplace(&_contract);
+	if (inserted)
+		for (VariableDeclaration const* var: _contract.stateVariables())
+			if (var->isPublic())
+				// Computing the comparator here shares it with all copies of the proxy.
+				it->second.emplace_back(var).overrideComparator();
+	return it->second;
+}
+
+vector<OverrideProxy> const& OverrideChecker::definedModifiers(ContractDefinition const& _contract) const
+{
+	auto [it, inserted] = m_definedModifiers.try_emplace(&_contract);
+	if (inserted)
+		for (ModifierDefinition const* mod: _contract.functionModifiers())
+			// Computing the comparator here shares it with all copies of the proxy.
+			it->second.emplace_back(mod).overrideComparator();
+	return it->second;
+}
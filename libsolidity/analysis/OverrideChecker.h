@@ -29,6 +29,7 @@
 #include <set>
 #include <variant>
 #include <optional>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -152,6 +153,13 @@ public:
 	OverrideProxyBySignatureMultiSet const& inheritedFunctions(ContractDefinition const& _contract) const;
 	OverrideProxyBySignatureMultiSet const& inheritedModifiers(ContractDefinition const& _contract) const;
 
+	/// @returns the functions (except the constructor), public state variables and modifiers
+	/// defined in @a _contract itself. The proxies are created only once per contract,
+	/// so that their signatures are computed only once, no matter how many contracts inherit them.
+	std::vector<OverrideProxy> const& definedFunctions(ContractDefinition const& _contract) const;
+	std::vector<OverrideProxy> const& publicStateVariables(ContractDefinition const& _contract) const;
+	std::vector<OverrideProxy> const& definedModifiers(ContractDefinition const& _contract) const;
+
 private:
 	void checkIllegalOverrides(ContractDefinition const& _contract);
 	/// Performs various checks related to @a _overriding overriding @a _super like
@@ -187,6 +195,10 @@ private:
 	/// Cache for inheritedFunctions().
 	std::map<ContractDefinition const*, OverrideProxyBySignatureMultiSet> mutable m_inheritedFunctions;
 	std::map<ContractDefinition const*, OverrideProxyBySignatureMultiSet> mutable m_inheritedModifiers;
+	/// Caches for definedFunctions(), publicStateVariables() and definedModifiers().
+	std::map<ContractDefinition const*, std::vector<OverrideProxy>> mutable m_definedFunctions;
+	std::map<ContractDefinition const*, std::vector<OverrideProxy>> mutable m_publicStateVariables;
+	std::map<ContractDefinition const*, std::vector<OverrideProxy>> mutable m_definedModifiers;
 };
 
 }
@@ -158,7 +158,7 @@ void ViewPureChecker::endVisit(FunctionDefinition const& _funDef)
 		m_errorReporter.warning(
 			2018_error,
 			_funDef.location(),
-			"Function state mutability can be restricted to " + stateMutabilityToString(m_bestMutabilityAndLocation.mutability)
+			[&]() { return "Function state mutability can be restricted to " + stateMutabilityToString(m_bestMutabilityAndLocation.mutability); }
 		);
 	m_currentFunction = nullptr;
 }
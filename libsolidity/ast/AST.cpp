@@ -32,6 +32,7 @@
 #include <boost/algorithm/string.hpp>
 
 #include <functional>
+#include <string_view>
 #include <utility>
 
 using namespace std;
@@ -237,39 +238,61 @@ vector<ErrorDefinition const*> ContractDefinition::interfaceErrors(bool _require
 vector<pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractDefinition::interfaceFunctionList(bool _includeInheritedFunctions) const
 {
 	return m_interfaceFunctionList[_includeInheritedFunctions].init([&]{
-		set<string> signaturesSeen;
+		set<string_view> signaturesSeen;
 		vector<pair<util::FixedHash<4>, FunctionTypePointer>> interfaceFunctionList;
 
 		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
 		{
 			if (_includeInheritedFunctions == false && contract != this)
 				continue;
-			vector<FunctionTypePointer> functions;
-			for (FunctionDefinition const* f: contract->definedFunctions())
-				if (f->isPartOfExternalInterface())
-					functions.push_back(TypeProvider::function(*f, FunctionType::Kind::External));
-			for (VariableDeclaration const* v: contract->stateVariables())
-				if (v->isPartOfExternalInterface())
-					functions.push_back(TypeProvider::function(*v));
-			for (FunctionTypePointer const& fun: functions)
-			{
-				if (!fun->interfaceFunctionType())
-					// Fails hopefully because we already registered the error
-					continue;
-				string functionSignature = fun->externalSignature();
-				if (signaturesSeen.count(functionSignature) == 0)
-				{
-					signaturesSeen.insert(functionSignature);
-					util::FixedHash<4> hash(util::keccak256(functionSignature));
+			// The signatures and selectors of the bases are computed only once and shared
+			// by all contracts that inherit from them.
+			for (auto const& [hash, fun, functionSignature]: contract->declaredInterfaceFunctions())
+				if (signaturesSeen.insert(functionSignature).second)
 					interfaceFunctionList.emplace_back(hash, fun);
-				}
-			}
 		}
 
 		return interfaceFunctionList;
 	});
 }
 
+vector<tuple<util::FixedHash<4>, FunctionTypePointer, string>> const& ContractDefinition::declaredInterfaceFunctions() const
+{
+	return m_declaredInterfaceFunctions.init([&]{
+		set<string> signaturesSeen;
+		vector<tuple<util::FixedHash<4>, FunctionTypePointer, string>> interfaceFunctions;
+
+		vector<FunctionTypePointer> functions;
+		for (FunctionDefinition const* f: definedFunctions())
+			if (f->isPartOfExternalInterface())
+				functions.push_back(TypeProvider::function(*f, FunctionType::Kind::External));
+		for (VariableDeclaration const* v: stateVariables())
+			if (v->isPartOfExternalInterface())
+				functions.push_back(TypeProvider::function(*v));
+		for (FunctionTypePointer const& fun: functions)
+		{
+			if (!fun->interfaceFunctionType())
+				// Fails hopefully because we already registered the error
+				continue;
+			string functionSignature = fun->externalSignature();
+			if (signaturesSeen.count(functionSignature) == 0)
+			{
+				signaturesSeen.insert(functionSignature);
+				interfaceFunctions.emplace_back(util::FixedHash<4>{}, fun, std::move(functionSignature));
+			}
+		}
+
+		vector<bytesConstRef> signatures;
+		for (auto const& function: interfaceFunctions)
+			signatures.emplace_back(get<2>(function));
+		vector<util::h256> hashes = util::keccak256Many(signatures);
+		for (size_t i = 0; i < interfaceFunctions.size(); ++i)
+			get<0>(interfaceFunctions[i]) = util::FixedHash<4>(hashes[i]);
+
+		return interfaceFunctions;
+	});
+}
+
 uint32_t ContractDefinition::interfaceId() const
 {
 	uint32_t result{0};
@@ -288,6 +311,16 @@ ContractDefinitionAnnotation& ContractDefinition::annotation() const
 	return initAnnotation<ContractDefinitionAnnotation>();
 }
 
+void ContractDefinition::clearAnnotation()
+{
+	Declaration::clearAnnotation();
+	for (auto& interfaceFunctionList: m_interfaceFunctionList)
+		interfaceFunctionList.reset();
+	m_declaredInterfaceFunctions.reset();
+	m_interfaceEvents.reset();
+	m_definedFunctionsByName.reset();
+}
+
 ContractDefinition const* ContractDefinition::superContract(ContractDefinition const& _mostDerivedContract) const
 {
 	auto const& hierarchy = _mostDerivedContract.annotation().linearizedBaseContracts;
@@ -965,6 +998,11 @@ string Literal::getChecksummedAddress() const
 	return util::getChecksummedAddress(address);
 }
 
+LiteralAnnotation& Literal::annotation() const
+{
+	return initAnnotation<LiteralAnnotation>();
+}
+
 TryCatchClause const* TryStatement::successClause() const
 {
 	solAssert(m_clauses.size() > 0, "");
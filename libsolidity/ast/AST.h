@@ -42,6 +42,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -79,6 +80,9 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	int64_t id() const { return int64_t(m_id); }
+	/// Adds @a _offset to the ID of this node. Only to be used by the parser, so that source units
+	/// that were parsed independently of each other can be numbered as if parsed in sequence.
+	void shiftID(int64_t _offset) { m_id = static_cast<size_t>(int64_t(m_id) + _offset); }
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -112,6 +116,9 @@ public:
 
 	///@todo make this const-safe by providing a different way to access the annotation
 	virtual ASTAnnotation& annotation() const;
+	/// Removes the annotation and everything else computed during analysis,
+	/// so that the node can be analysed again.
+	virtual void clearAnnotation() { m_annotation.reset(); }
 
 	///@{
 	///@name equality operators
@@ -121,7 +128,7 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -557,6 +564,7 @@ public:
 	Type const* type() const override;
 
 	ContractDefinitionAnnotation& annotation() const override;
+	void clearAnnotation() override;
 
 	ContractKind contractKind() const { return m_contractKind; }
 
@@ -568,6 +576,9 @@ public:
 
 private:
 	std::multimap<std::string, FunctionDefinition const*> const& definedFunctionsByName() const;
+	/// @returns the selectors, types and external signatures of the functions and public state
+	/// variables declared in this contract itself (without those of its bases).
+	std::vector<std::tuple<util::FixedHash<4>, FunctionTypePointer, std::string>> const& declaredInterfaceFunctions() const;
 
 	std::vector<ASTPointer<InheritanceSpecifier>> m_baseContracts;
 	std::vector<ASTPointer<ASTNode>> m_subNodes;
@@ -575,6 +586,7 @@ private:
 	bool m_abstract{false};
 
 	util::LazyInit<std::vector<std::pair<util::FixedHash<4>, FunctionTypePointer>>> m_interfaceFunctionList[2];
+	util::LazyInit<std::vector<std::tuple<util::FixedHash<4>, FunctionTypePointer, std::string>>> m_declaredInterfaceFunctions;
 	util::LazyInit<std::vector<EventDefinition const*>> m_interfaceEvents;
 	util::LazyInit<std::multimap<std::string, FunctionDefinition const*>> m_definedFunctionsByName;
 };
@@ -2320,6 +2332,8 @@ public:
 	/// @returns the checksummed version of an address (or empty string if not valid)
 	std::string getChecksummedAddress() const;
 
+	LiteralAnnotation& annotation() const override;
+
 private:
 	Token m_token;
 	ASTPointer<ASTString> m_value;
@@ -27,12 +27,16 @@
 #include <libsolidity/ast/ASTEnums.h>
 #include <libsolidity/ast/ExperimentalFeatures.h>
 
+#include <libsolutil/Numeric.h>
 #include <libsolutil/SetOnce.h>
 
+#include <boost/rational.hpp>
+
 #include <map>
 #include <memory>
 #include <optional>
 #include <set>
+#include <tuple>
 #include <vector>
 
 namespace solidity::yul
@@ -255,6 +259,13 @@ struct IdentifierPathAnnotation: ASTAnnotation
 	SetOnce<VirtualLookup> requiredLookup;
 };
 
+/// Value of a constant expression together with its type, as computed by the ConstantEvaluator.
+struct TypedRational
+{
+	Type const* type;
+	boost::rational<bigint> value;
+};
+
 struct ExpressionAnnotation: ASTAnnotation
 {
 	/// Inferred type of the expression.
@@ -284,6 +295,10 @@ struct ExpressionAnnotation: ASTAnnotation
 	/// Note that even the simplest expressions, like `(f)()`, result in an indirect call even if they consist of
 	/// values known at compilation time.
 	bool calledDirectly = false;
+
+	/// Value of the expression, if the ConstantEvaluator already evaluated it to a constant.
+	/// Only accessed by the ConstantEvaluator, which guards it with a mutex.
+	std::optional<TypedRational> constantValue;
 };
 
 struct IdentifierAnnotation: ExpressionAnnotation
@@ -298,6 +313,12 @@ struct IdentifierAnnotation: ExpressionAnnotation
 	std::vector<Declaration const*> overloadedDeclarations;
 };
 
+struct LiteralAnnotation: ExpressionAnnotation
+{
+	/// Whether the number literal is valid and its value, set the first time it is converted.
+	std::optional<std::tuple<bool, boost::rational<bigint>>> numberValue;
+};
+
 struct MemberAccessAnnotation: ExpressionAnnotation
 {
 	/// Referenced declaration, set at latest during overload resolution stage.
@@ -188,13 +188,35 @@ Json::Value ASTJsonConverter::inlineAssemblyIdentifierToJson(pair<yul::Identifie
 	return tuple;
 }
 
-void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node)
+void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format, string const& _indentation)
 {
-	_stream << util::jsonPrettyPrint(toJson(_node));
+	vector<pair<ASTNode const*, bool>> children;
+	m_deferredNodes = &children;
+	ScopeGuard resetDeferredNodes([&]() { m_deferredNodes = nullptr; });
+	_node.accept(*this);
+	m_deferredNodes = nullptr;
+
+	util::jsonStreamPrint(
+		_stream,
+		util::removeNullMembers(std::move(m_currentValue)),
+		_format,
+		[&](ostream& _childStream, size_t _index, string const& _childIndentation) {
+			bool const inEvent = m_inEvent;
+			m_inEvent = children.at(_index).second;
+			print(_childStream, *children.at(_index).first, _format, _childIndentation);
+			m_inEvent = inEvent;
+		},
+		_indentation
+	);
 }
 
 Json::Value ASTJsonConverter::toJson(ASTNode const& _node)
 {
+	if (m_deferredNodes)
+	{
+		m_deferredNodes->emplace_back(&_node, m_inEvent);
+		return util::jsonPlaceholder(m_deferredNodes->size() - 1);
+	}
 	_node.accept(*this);
 	return util::removeNullMembers(std::move(m_currentValue));
 }
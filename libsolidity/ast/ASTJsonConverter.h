@@ -27,6 +27,7 @@
 #include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <liblangutil/Exceptions.h>
+#include <libsolutil/JSON.h>
 
 #include <json/json.h>
 
@@ -58,7 +59,15 @@ public:
 		std::map<std::string, unsigned> _sourceIndices = std::map<std::string, unsigned>()
 	);
 	/// Output the json representation of the AST to _stream.
-	void print(std::ostream& _stream, ASTNode const& _node);
+	/// The children of a node are only converted while the node is printed, so only the JSON of
+	/// the nodes on the path from @a _node to the node being printed is kept in memory.
+	/// @a _indentation is added to every line but the first one.
+	void print(
+		std::ostream& _stream,
+		ASTNode const& _node,
+		util::JsonFormat const& _format = util::JsonFormat{util::JsonFormat::Pretty},
+		std::string const& _indentation = ""
+	);
 	Json::Value toJson(ASTNode const& _node);
 	template <class T>
 	Json::Value toJson(std::vector<ASTPointer<T>> const& _nodes)
@@ -197,6 +206,9 @@ private:
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json::Value m_currentValue;
+	/// If set, toJson only stores nodes here, together with the value of m_inEvent,
+	/// and returns placeholders for them.
+	std::vector<std::pair<ASTNode const*, bool>>* m_deferredNodes = nullptr;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
 
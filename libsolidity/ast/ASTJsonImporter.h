@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <unordered_set>
 #include <vector>
 #include <libsolidity/ast/AST.h>
 #include <json/json.h>
@@ -130,7 +131,7 @@ private:
 
 	// =============== general helper functions ===================
 	/// @returns the member of a given JSON object, throws if member does not exist
-	Json::Value member(Json::Value const& _node, std::string const& _name);
+	Json::Value const& member(Json::Value const& _node, std::string const& _name);
 	/// @returns the appropriate TokenObject used in parsed Strings (pragma directive or operator)
 	Token scanSingleToken(Json::Value const& _node);
 	template<class T>
@@ -154,11 +155,11 @@ private:
 
 	// =========== member variables ===============
 	/// list of source names, order by source index
-	std::vector<std::shared_ptr<std::string const>> m_sourceNames;
+	std::vector<std::string const*> m_sourceNames;
 	/// filepath to AST
 	std::map<std::string, ASTPointer<SourceUnit>> m_sourceUnits;
 	/// IDs already used by the nodes
-	std::set<int64_t> m_usedIDs;
+	std::unordered_set<int64_t> m_usedIDs;
 	/// Configured EVM version
 	langutil::EVMVersion m_evmVersion;
 };
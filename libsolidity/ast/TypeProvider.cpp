@@ -26,133 +26,23 @@ using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
-BoolType const TypeProvider::m_boolean{};
-InaccessibleDynamicType const TypeProvider::m_inaccessibleDynamic{};
-
-/// The string and bytes unique_ptrs are initialized when they are first used because
-/// they rely on `byte` being available which we cannot guarantee in the static init context.
-unique_ptr<ArrayType> TypeProvider::m_bytesStorage;
-unique_ptr<ArrayType> TypeProvider::m_bytesMemory;
-unique_ptr<ArrayType> TypeProvider::m_bytesCalldata;
-unique_ptr<ArrayType> TypeProvider::m_stringStorage;
-unique_ptr<ArrayType> TypeProvider::m_stringMemory;
-
-TupleType const TypeProvider::m_emptyTuple{};
-AddressType const TypeProvider::m_payableAddress{StateMutability::Payable};
-AddressType const TypeProvider::m_address{StateMutability::NonPayable};
-
-array<unique_ptr<IntegerType>, 32> const TypeProvider::m_intM{{
-	{make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 4, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 5, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 6, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 7, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 8, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 9, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 10, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 11, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 12, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 13, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 14, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 15, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 16, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 17, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 18, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 19, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 20, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 21, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 22, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 23, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 24, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 25, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 26, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 27, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 28, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 29, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 30, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 31, IntegerType::Modifier::Signed)},
-	{make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Signed)}
-}};
-
-array<unique_ptr<IntegerType>, 32> const TypeProvider::m_uintM{{
-	{make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 4, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 5, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 6, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 7, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 8, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 9, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 10, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 11, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 12, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 13, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 14, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 15, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 16, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 17, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 18, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 19, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 20, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 21, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 22, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 23, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 24, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 25, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 26, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 27, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 28, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 29, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 30, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 31, IntegerType::Modifier::Unsigned)},
-	{make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Unsigned)}
-}};
-
-array<unique_ptr<FixedBytesType>, 32> const TypeProvider::m_bytesM{{
-	{make_unique<FixedBytesType>(1)},
-	{make_unique<FixedBytesType>(2)},
-	{make_unique<FixedBytesType>(3)},
-	{make_unique<FixedBytesType>(4)},
-	{make_unique<FixedBytesType>(5)},
-	{make_unique<FixedBytesType>(6)},
-	{make_unique<FixedBytesType>(7)},
-	{make_unique<FixedBytesType>(8)},
-	{make_unique<FixedBytesType>(9)},
-	{make_unique<FixedBytesType>(10)},
-	{make_unique<FixedBytesType>(11)},
-	{make_unique<FixedBytesType>(12)},
-	{make_unique<FixedBytesType>(13)},
-	{make_unique<FixedBytesType>(14)},
-	{make_unique<FixedBytesType>(15)},
-	{make_unique<FixedBytesType>(16)},
-	{make_unique<FixedBytesType>(17)},
-	{make_unique<FixedBytesType>(18)},
-	{make_unique<FixedBytesType>(19)},
-	{make_unique<FixedBytesType>(20)},
-	{make_unique<FixedBytesType>(21)},
-	{make_unique<FixedBytesType>(22)},
-	{make_unique<FixedBytesType>(23)},
-	{make_unique<FixedBytesType>(24)},
-	{make_unique<FixedBytesType>(25)},
-	{make_unique<FixedBytesType>(26)},
-	{make_unique<FixedBytesType>(27)},
-	{make_unique<FixedBytesType>(28)},
-	{make_unique<FixedBytesType>(29)},
-	{make_unique<FixedBytesType>(30)},
-	{make_unique<FixedBytesType>(31)},
-	{make_unique<FixedBytesType>(32)}
-}};
-
-array<unique_ptr<MagicType>, 4> const TypeProvider::m_magics{{
-	{make_unique<MagicType>(MagicType::Kind::Block)},
-	{make_unique<MagicType>(MagicType::Kind::Message)},
-	{make_unique<MagicType>(MagicType::Kind::Transaction)},
-	{make_unique<MagicType>(MagicType::Kind::ABI)}
-	// MetaType is stored separately
-}};
+TypeProvider::TypeProvider()
+{
+	for (unsigned i = 0; i < 32; ++i)
+	{
+		m_intM[i] = make_unique<IntegerType>(8 * (i + 1), IntegerType::Modifier::Signed);
+		m_uintM[i] = make_unique<IntegerType>(8 * (i + 1), IntegerType::Modifier::Unsigned);
+		m_bytesM[i] = make_unique<FixedBytesType>(i + 1);
+	}
+
+	m_magics = {{
+		{make_unique<MagicType>(MagicType::Kind::Block)},
+		{make_unique<MagicType>(MagicType::Kind::Message)},
+		{make_unique<MagicType>(MagicType::Kind::Transaction)},
+		{make_unique<MagicType>(MagicType::Kind::ABI)}
+		// MetaType is stored separately
+	}};
+}
 
 inline void clearCache(Type const& type)
 {
@@ -174,34 +64,89 @@ inline void clearCaches(Container& container)
 		clearCache(e);
 }
 
+void TypeProvider::clearTypeCaches()
+{
+	TypeProvider& provider = instance();
+	lock_guard<recursive_mutex> lock(provider.m_mutex);
+	clearCache(provider.m_boolean);
+	clearCache(provider.m_inaccessibleDynamic);
+	clearCache(provider.m_bytesStorage);
+	clearCache(provider.m_bytesMemory);
+	clearCache(provider.m_bytesCalldata);
+	clearCache(provider.m_stringStorage);
+	clearCache(provider.m_stringMemory);
+	clearCache(provider.m_emptyTuple);
+	clearCache(provider.m_payableAddress);
+	clearCache(provider.m_address);
+	clearCaches(provider.m_intM);
+	clearCaches(provider.m_uintM);
+	clearCaches(provider.m_bytesM);
+	clearCaches(provider.m_magics);
+	clearCaches(provider.m_generalTypes);
+	for (auto const& type: provider.m_stringLiteralTypes)
+		clearCache(type.second);
+	for (auto const& type: provider.m_ufixedMxN)
+		clearCache(type.second);
+	for (auto const& type: provider.m_fixedMxN)
+		clearCache(type.second);
+	// The keys may refer to AST nodes that are destroyed and whose memory is reused.
+	provider.m_internTables.clear();
+}
+
 void TypeProvider::reset()
 {
-	clearCache(m_boolean);
-	clearCache(m_inaccessibleDynamic);
-	clearCache(m_bytesStorage);
-	clearCache(m_bytesMemory);
-	clearCache(m_bytesCalldata);
-	clearCache(m_stringStorage);
-	clearCache(m_stringMemory);
-	clearCache(m_emptyTuple);
-	clearCache(m_payableAddress);
-	clearCache(m_address);
-	clearCaches(instance().m_intM);
-	clearCaches(instance().m_uintM);
-	clearCaches(instance().m_bytesM);
-	clearCaches(instance().m_magics);
-
-	instance().m_generalTypes.clear();
-	instance().m_stringLiteralTypes.clear();
-	instance().m_ufixedMxN.clear();
-	instance().m_fixedMxN.clear();
+	clearTypeCaches();
+
+	TypeProvider& provider = instance();
+	lock_guard<recursive_mutex> lock(provider.m_mutex);
+	provider.m_generalTypes.clear();
+	provider.m_stringLiteralTypes.clear();
+	provider.m_ufixedMxN.clear();
+	provider.m_fixedMxN.clear();
+}
+
+namespace
+{
+
+/// @returns the value that identifies the constructor argument @a _value: its address for
+/// AST nodes and types and a copy of it otherwise.
+template <typename T>
+auto internKey(T const& _value)
+{
+	if constexpr (is_base_of_v<ASTNode, T> || is_base_of_v<Type, T>)
+		return &_value;
+	else
+		return _value;
+}
+
+}
+
+template <typename T, typename Key, typename Create>
+inline T const* TypeProvider::intern(Key _key, Create&& _create)
+{
+	// Constructing a type can request other types, which locks the mutex again.
+	lock_guard<recursive_mutex> lock(instance().m_mutex);
+	unique_ptr<InternTableBase>& table = instance().m_internTables[typeid(InternTable<T, Key>)];
+	if (!table)
+		table = make_unique<InternTable<T, Key>>();
+	auto& types = static_cast<InternTable<T, Key>&>(*table).types;
+
+	auto it = types.find(_key);
+	if (it != types.end())
+		return it->second;
+
+	instance().m_generalTypes.emplace_back(_create());
+	T const* type = static_cast<T const*>(instance().m_generalTypes.back().get());
+	types.emplace(move(_key), type);
+	return type;
 }
 
 template <typename T, typename... Args>
 inline T const* TypeProvider::createAndGet(Args&& ... _args)
 {
-	instance().m_generalTypes.emplace_back(make_unique<T>(std::forward<Args>(_args)...));
-	return static_cast<T const*>(instance().m_generalTypes.back().get());
+	// Types are immutable and only depend on their constructor arguments.
+	auto key = make_tuple(internKey(_args)...);
+	return intern<T>(move(key), [&]() { return make_unique<T>(std::forward<Args>(_args)...); });
 }
 
 Type const* TypeProvider::fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability)
@@ -306,37 +251,47 @@ Type const* TypeProvider::fromElementaryTypeName(string const& _name)
 
 ArrayType const* TypeProvider::bytesStorage()
 {
-	if (!m_bytesStorage)
-		m_bytesStorage = make_unique<ArrayType>(DataLocation::Storage, false);
-	return m_bytesStorage.get();
+	TypeProvider& provider = instance();
+	lock_guard<recursive_mutex> lock(provider.m_mutex);
+	if (!provider.m_bytesStorage)
+		provider.m_bytesStorage = make_unique<ArrayType>(DataLocation::Storage, false);
+	return provider.m_bytesStorage.get();
 }
 
 ArrayType const* TypeProvider::bytesMemory()
 {
-	if (!m_bytesMemory)
-		m_bytesMemory = make_unique<ArrayType>(DataLocation::Memory, false);
-	return m_bytesMemory.get();
+	TypeProvider& provider = instance();
+	lock_guard<recursive_mutex> lock(provider.m_mutex);
+	if (!provider.m_bytesMemory)
+		provider.m_bytesMemory = make_unique<ArrayType>(DataLocation::Memory, false);
+	return provider.m_bytesMemory.get();
 }
 
 ArrayType const* TypeProvider::bytesCalldata()
 {
-	if (!m_bytesCalldata)
-		m_bytesCalldata = make_unique<ArrayType>(DataLocation::CallData, false);
-	return m_bytesCalldata.get();
+	TypeProvider& provider = instance();
+	lock_guard<recursive_mutex> lock(provider.m_mutex);
+	if (!provider.m_bytesCalldata)
+		provider.m_bytesCalldata = make_unique<ArrayType>(DataLocation::CallData, false);
+	return provider.m_bytesCalldata.get();
 }
 
 ArrayType const* TypeProvider::stringStorage()
 {
-	if (!m_stringStorage)
-		m_stringStorage = make_unique<ArrayType>(DataLocation::Storage, true);
-	return m_stringStorage.get();
+	TypeProvider& provider = instance();
+	lock_guard<recursive_mutex> lock(provider.m_mutex);
+	if (!provider.m_stringStorage)
+		provider.m_stringStorage = make_unique<ArrayType>(DataLocation::Storage, true);
+	return provider.m_stringStorage.get();
 }
 
 ArrayType const* TypeProvider::stringMemory()
 {
-	if (!m_stringMemory)
-		m_stringMemory = make_unique<ArrayType>(DataLocation::Memory, true);
-	return m_stringMemory.get();
+	TypeProvider& provider = instance();
+	lock_guard<recursive_mutex> lock(provider.m_mutex);
+	if (!provider.m_stringMemory)
+		provider.m_stringMemory = make_unique<ArrayType>(DataLocation::Memory, true);
+	return provider.m_stringMemory.get();
 }
 
 Type const* TypeProvider::forLiteral(Literal const& _literal)
@@ -378,6 +333,7 @@ RationalNumberType const* TypeProvider::rationalNumber(Literal const& _literal)
 
 StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
 {
+	lock_guard<recursive_mutex> lock(instance().m_mutex);
 	auto i = instance().m_stringLiteralTypes.find(literal);
 	if (i != instance().m_stringLiteralTypes.end())
 		return i->second.get();
@@ -387,6 +343,7 @@ StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
 
 FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPointType::Modifier _modifier)
 {
+	lock_guard<recursive_mutex> lock(instance().m_mutex);
 	auto& map = _modifier == FixedPointType::Modifier::Unsigned ? instance().m_ufixedMxN : instance().m_fixedMxN;
 
 	auto i = map.find(make_pair(m, n));
@@ -402,7 +359,7 @@ FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPoin
 TupleType const* TypeProvider::tuple(vector<Type const*> members)
 {
 	if (members.empty())
-		return &m_emptyTuple;
+		return &instance().m_emptyTuple;
 
 	return createAndGet<TupleType>(move(members));
 }
@@ -412,8 +369,10 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
-	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
-	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	return intern<ReferenceType>(
+		make_tuple(_type, _location, _isPointer),
+		[&]() { return _type->copyForLocation(_location, _isPointer); }
+	);
 }
 
 FunctionType const* TypeProvider::function(FunctionDefinition const& _function, FunctionType::Kind _kind)
@@ -558,7 +517,7 @@ ModifierType const* TypeProvider::modifier(ModifierDefinition const& _def)
 MagicType const* TypeProvider::magic(MagicType::Kind _kind)
 {
 	solAssert(_kind != MagicType::Kind::MetaType, "MetaType is handled separately");
-	return m_magics.at(static_cast<size_t>(_kind)).get();
+	return instance().m_magics.at(static_cast<size_t>(_kind)).get();
 }
 
 MagicType const* TypeProvider::meta(Type const* _type)
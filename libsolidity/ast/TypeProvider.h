@@ -23,7 +23,10 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <typeindex>
+#include <unordered_map>
 #include <utility>
 
 namespace solidity::frontend
@@ -37,21 +40,49 @@ namespace solidity::frontend
  *
  * It is not recommended to explicitly instantiate types unless you really know what and why
  * you are doing it.
+ *
+ * The types are owned by a TypeProvider instance. The static functions use the instance that
+ * has been made current on the calling thread via setCurrent() and a process-wide default
+ * instance if there is none. Each compilation can thus use its own instance and compilations
+ * on different threads do not interfere with each other.
+ * Several threads may request types and their members from the same instance at once. The other
+ * lazily computed data of the types is not synchronised, though.
  */
 class TypeProvider
 {
 public:
-	TypeProvider() = default;
-	TypeProvider(TypeProvider&&) = default;
+	TypeProvider();
+	TypeProvider(TypeProvider&&) = delete;
 	TypeProvider(TypeProvider const&) = delete;
-	TypeProvider& operator=(TypeProvider&&) = default;
+	TypeProvider& operator=(TypeProvider&&) = delete;
 	TypeProvider& operator=(TypeProvider const&) = delete;
 	~TypeProvider() = default;
 
-	/// Resets state of this TypeProvider to initial state, wiping all mutable types.
+	/// Makes @a _provider the instance used by the static functions on the current thread.
+	/// If it is null, the default instance is used.
+	/// @returns the previously current instance.
+	static TypeProvider* setCurrent(TypeProvider* _provider)
+	{
+		TypeProvider* previous = m_current;
+		m_current = _provider;
+		return previous;
+	}
+
+	/// @returns the instance made current on this thread, or null if the default instance is used.
+	static TypeProvider* current() { return m_current; }
+
+	/// Resets state of the current TypeProvider to initial state, wiping all mutable types.
 	/// This invalidates all dangling pointers to types provided by this TypeProvider.
 	static void reset();
 
+	/// @returns the mutex that guards the current TypeProvider and the member lists of its types.
+	static std::recursive_mutex& mutex() { return instance().m_mutex; }
+
+	/// Clears the lazily computed data of all types of the current TypeProvider, like member lists,
+	/// which may refer to AST nodes that are destroyed. The types themselves remain valid,
+	/// but the factory functions will not return them anymore.
+	static void clearTypeCaches();
+
 	/// @name Factory functions
 	/// Factory functions that convert an AST @ref TypeName to a Type.
 	static Type const* fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability = {});
@@ -61,10 +92,10 @@ public:
 	static Type const* fromElementaryTypeName(std::string const& _name);
 
 	/// @returns boolean type.
-	static BoolType const* boolean() noexcept { return &m_boolean; }
+	static BoolType const* boolean() noexcept { return &instance().m_boolean; }
 
 	static FixedBytesType const* byte() { return fixedBytes(1); }
-	static FixedBytesType const* fixedBytes(unsigned m) { return m_bytesM.at(m - 1).get(); }
+	static FixedBytesType const* fixedBytes(unsigned m) { return instance().m_bytesM.at(m - 1).get(); }
 
 	static ArrayType const* bytesStorage();
 	static ArrayType const* bytesMemory();
@@ -83,16 +114,16 @@ public:
 
 	static ArraySliceType const* arraySlice(ArrayType const& _arrayType);
 
-	static AddressType const* payableAddress() noexcept { return &m_payableAddress; }
-	static AddressType const* address() noexcept { return &m_address; }
+	static AddressType const* payableAddress() noexcept { return &instance().m_payableAddress; }
+	static AddressType const* address() noexcept { return &instance().m_address; }
 
 	static IntegerType const* integer(unsigned _bits, IntegerType::Modifier _modifier)
 	{
 		solAssert((_bits % 8) == 0, "");
 		if (_modifier == IntegerType::Modifier::Unsigned)
-			return m_uintM.at(_bits / 8 - 1).get();
+			return instance().m_uintM.at(_bits / 8 - 1).get();
 		else
-			return m_intM.at(_bits / 8 - 1).get();
+			return instance().m_intM.at(_bits / 8 - 1).get();
 	}
 	static IntegerType const* uint(unsigned _bits) { return integer(_bits, IntegerType::Modifier::Unsigned); }
 
@@ -107,7 +138,7 @@ public:
 	/// @returns a tuple type with the given members.
 	static TupleType const* tuple(std::vector<Type const*> members);
 
-	static TupleType const* emptyTuple() noexcept { return &m_emptyTuple; }
+	static TupleType const* emptyTuple() noexcept { return &instance().m_emptyTuple; }
 
 	static ReferenceType const* withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer);
 
@@ -181,7 +212,7 @@ public:
 
 	static ContractType const* contract(ContractDefinition const& _contract, bool _isSuper = false);
 
-	static InaccessibleDynamicType const* inaccessibleDynamic() noexcept { return &m_inaccessibleDynamic; }
+	static InaccessibleDynamicType const* inaccessibleDynamic() noexcept { return &instance().m_inaccessibleDynamic; }
 
 	/// @returns the type of an enum instance for given definition, there is one distinct type per enum definition.
 	static EnumType const* enumType(EnumDefinition const& _enum);
@@ -204,38 +235,63 @@ public:
 	static UserDefinedValueType const* userDefinedValueType(UserDefinedValueTypeDefinition const& _definition);
 
 private:
-	/// Global TypeProvider instance.
+	/// TypeProvider instance used by the static functions on the current thread.
 	static TypeProvider& instance()
 	{
-		static TypeProvider _provider;
-		return _provider;
+		if (m_current)
+			return *m_current;
+		static TypeProvider defaultProvider;
+		return defaultProvider;
 	}
 
+	/// @returns the type constructed from @a _args. Types are only constructed once per
+	/// combination of arguments, so that equal types mostly share one instance.
 	template <typename T, typename... Args>
 	static inline T const* createAndGet(Args&& ... _args);
+	/// @returns the type stored under @a _key, which is created by @a _create if there is none.
+	template <typename T, typename Key, typename Create>
+	static inline T const* intern(Key _key, Create&& _create);
+
+	struct InternTableBase
+	{
+		virtual ~InternTableBase() = default;
+	};
+	/// Lookup table of the types of class @a T created from arguments @a Key.
+	template <typename T, typename Key>
+	struct InternTable: InternTableBase
+	{
+		std::map<Key, T const*> types;
+	};
+
+	static inline thread_local TypeProvider* m_current = nullptr;
 
-	static BoolType const m_boolean;
-	static InaccessibleDynamicType const m_inaccessibleDynamic;
+	BoolType const m_boolean{};
+	InaccessibleDynamicType const m_inaccessibleDynamic{};
 
 	/// These are lazy-initialized because they depend on `byte` being available.
-	static std::unique_ptr<ArrayType> m_bytesStorage;
-	static std::unique_ptr<ArrayType> m_bytesMemory;
-	static std::unique_ptr<ArrayType> m_bytesCalldata;
-	static std::unique_ptr<ArrayType> m_stringStorage;
-	static std::unique_ptr<ArrayType> m_stringMemory;
-
-	static TupleType const m_emptyTuple;
-	static AddressType const m_payableAddress;
-	static AddressType const m_address;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_intM;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_uintM;
-	static std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
-	static std::array<std::unique_ptr<MagicType>, 4> const m_magics;        ///< MagicType's except MetaType
+	std::unique_ptr<ArrayType> m_bytesStorage;
+	std::unique_ptr<ArrayType> m_bytesMemory;
+	std::unique_ptr<ArrayType> m_bytesCalldata;
+	std::unique_ptr<ArrayType> m_stringStorage;
+	std::unique_ptr<ArrayType> m_stringMemory;
+
+	TupleType const m_emptyTuple{};
+	AddressType const m_payableAddress{StateMutability::Payable};
+	AddressType const m_address{StateMutability::NonPayable};
+	std::array<std::unique_ptr<IntegerType>, 32> m_intM;
+	std::array<std::unique_ptr<IntegerType>, 32> m_uintM;
+	std::array<std::unique_ptr<FixedBytesType>, 32> m_bytesM;
+	std::array<std::unique_ptr<MagicType>, 4> m_magics;        ///< MagicType's except MetaType
 
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_ufixedMxN{};
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+	/// The lookup tables of the types in m_generalTypes, one per type class and argument types.
+	std::unordered_map<std::type_index, std::unique_ptr<InternTableBase>> m_internTables{};
+	/// Guards the lazily created types and the lookup tables, so that types can be requested
+	/// from several threads at once.
+	std::recursive_mutex m_mutex;
 };
 
 }
@@ -42,12 +42,13 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/algorithm/string/split.hpp>
 
-#include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
 #include <range/v3/view/transform.hpp>
 
+#include <atomic>
 #include <limits>
+#include <mutex>
 #include <unordered_set>
 #include <utility>
 
@@ -173,16 +174,64 @@ pair<u256, unsigned> const* StorageOffsets::offset(size_t _index) const
 void MemberList::combine(MemberList const & _other)
 {
 	m_memberTypes += _other.m_memberTypes;
+	m_nameIndex.reset();
+}
+
+Type const* MemberList::memberType(string const& _name) const
+{
+	Type const* type = nullptr;
+	forEachMemberNamed(_name, [&](size_t _index) {
+		solAssert(!type, "Requested member type by non-unique name.");
+		type = m_memberTypes[_index].type;
+	});
+	return type;
+}
+
+MemberList::MemberMap MemberList::membersByName(string const& _name) const
+{
+	MemberMap members;
+	forEachMemberNamed(_name, [&](size_t _index) { members.push_back(m_memberTypes[_index]); });
+	return members;
 }
 
 pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
 {
 	StorageOffsets const& offsets = storageOffsets();
 
-	for (auto&& [index, member]: m_memberTypes | ranges::views::enumerate)
-		if (member.name == _name)
-			return offsets.offset(index);
-	return nullptr;
+	auto it = nameIndex().first.find(_name);
+	if (it == nameIndex().first.end())
+		return nullptr;
+	return offsets.offset(it->second);
+}
+
+MemberList::NameIndex const& MemberList::nameIndex() const
+{
+	return m_nameIndex.init([&]{
+		NameIndex index;
+		index.next.resize(m_memberTypes.size(), NameIndex::end);
+		// Walk backwards so that each new entry goes to the front of its list.
+		for (size_t i = m_memberTypes.size(); i > 0; --i)
+		{
+			auto [it, inserted] = index.first.emplace(m_memberTypes[i - 1].name, i - 1);
+			if (!inserted)
+			{
+				index.next[i - 1] = it->second;
+				it->second = i - 1;
+			}
+		}
+		return index;
+	});
+}
+
+template <typename Callback>
+void MemberList::forEachMemberNamed(string const& _name, Callback&& _callback) const
+{
+	NameIndex const& index = nameIndex();
+	auto it = index.first.find(_name);
+	if (it == index.first.end())
+		return;
+	for (size_t i = it->second; i != NameIndex::end; i = index.next[i])
+		_callback(i);
 }
 
 u256 const& MemberList::storageSize() const
@@ -283,10 +332,32 @@ Type const* Type::commonType(Type const* _a, Type const* _b)
 		return nullptr;
 }
 
+namespace
+{
+atomic<size_t> memberCacheHits{0};
+atomic<size_t> memberCacheMisses{0};
+}
+
+Type::MemberCacheStatistics Type::memberCacheStatistics()
+{
+	return {memberCacheHits.load(), memberCacheMisses.load()};
+}
+
+void Type::resetMemberCacheStatistics()
+{
+	memberCacheHits = 0;
+	memberCacheMisses = 0;
+}
+
 MemberList const& Type::members(ASTNode const* _currentScope) const
 {
-	if (!m_members[_currentScope])
+	// The members of a type can be requested by several analysis threads at once.
+	lock_guard<recursive_mutex> lock(TypeProvider::mutex());
+	if (m_members[_currentScope])
+		++memberCacheHits;
+	else
 	{
+		++memberCacheMisses;
 		solAssert(
 			_currentScope == nullptr ||
 			dynamic_cast<SourceUnit const*>(_currentScope) ||
@@ -796,16 +867,25 @@ tuple<bool, rational> RationalNumberType::parseRational(string const& _value)
 			rational numerator;
 			rational denominator(1);
 
-			denominator = bigint(string(fractionalBegin, _value.end()));
+			string_view const digits(_value);
+			size_t const radixPosition = static_cast<size_t>(radixPoint - _value.begin());
+			optional<bigint> fractional = parseNumber(digits.substr(static_cast<size_t>(fractionalBegin - _value.begin())), 10);
+			optional<bigint> integral = parseNumber(digits.substr(0, radixPosition), 10);
+			if (!fractional || !integral)
+				return make_tuple(false, rational(0));
+
+			denominator = *fractional;
 			denominator /= boost::multiprecision::pow(
 				bigint(10),
 				static_cast<unsigned>(distance(radixPoint + 1, _value.end()))
 			);
-			numerator = bigint(string(_value.begin(), radixPoint));
+			numerator = *integral;
 			value = numerator + denominator;
 		}
+		else if (optional<bigint> integral = parseNumber(_value, 10))
+			value = *integral;
 		else
-			value = bigint(_value);
+			return make_tuple(false, rational(0));
 		return make_tuple(true, value);
 	}
 	catch (...)
@@ -815,6 +895,15 @@ tuple<bool, rational> RationalNumberType::parseRational(string const& _value)
 }
 
 tuple<bool, rational> RationalNumberType::isValidLiteral(Literal const& _literal)
+{
+	// The value is computed during several analysis steps, so it is only converted once.
+	auto& cachedValue = _literal.annotation().numberValue;
+	if (!cachedValue)
+		cachedValue = convertLiteral(_literal);
+	return *cachedValue;
+}
+
+tuple<bool, rational> RationalNumberType::convertLiteral(Literal const& _literal)
 {
 	rational value;
 	try
@@ -828,7 +917,10 @@ tuple<bool, rational> RationalNumberType::isValidLiteral(Literal const& _literal
 		if (boost::starts_with(valueString, "0x"))
 		{
 			// process as hex
-			value = bigint(valueString);
+			optional<bigint> hexValue = parseNumber(string_view(valueString).substr(2), 16);
+			if (!hexValue)
+				return make_tuple(false, rational(0));
+			value = *hexValue;
 		}
 		else if (expPoint != valueString.end())
 		{
@@ -1603,6 +1695,9 @@ string ArrayType::richIdentifier() const
 
 bool ArrayType::operator==(Type const& _other) const
 {
+	// TypeProvider returns the same instance for types constructed the same way.
+	if (this == &_other)
+		return true;
 	if (_other.category() != category())
 		return false;
 	ArrayType const& other = dynamic_cast<ArrayType const&>(_other);
@@ -2954,6 +3049,8 @@ string FunctionType::richIdentifier() const
 
 bool FunctionType::operator==(Type const& _other) const
 {
+	if (this == &_other)
+		return true;
 	if (_other.category() != category())
 		return false;
 	FunctionType const& other = dynamic_cast<FunctionType const&>(_other);
@@ -3648,6 +3745,8 @@ string MappingType::richIdentifier() const
 
 bool MappingType::operator==(Type const& _other) const
 {
+	if (this == &_other)
+		return true;
 	if (_other.category() != category())
 		return false;
 	MappingType const& other = dynamic_cast<MappingType const&>(_other);
@@ -3694,6 +3793,8 @@ string TypeType::richIdentifier() const
 
 bool TypeType::operator==(Type const& _other) const
 {
+	if (this == &_other)
+		return true;
 	if (_other.category() != category())
 		return false;
 	TypeType const& other = dynamic_cast<TypeType const&>(_other);
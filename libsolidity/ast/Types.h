@@ -36,11 +36,14 @@
 
 #include <boost/rational.hpp>
 
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 
 namespace solidity::frontend
@@ -122,25 +125,8 @@ public:
 	explicit MemberList(MemberMap _members): m_memberTypes(std::move(_members)) {}
 
 	void combine(MemberList const& _other);
-	Type const* memberType(std::string const& _name) const
-	{
-		Type const* type = nullptr;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-			{
-				solAssert(!type, "Requested member type by non-unique name.");
-				type = it.type;
-			}
-		return type;
-	}
-	MemberMap membersByName(std::string const& _name) const
-	{
-		MemberMap members;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-				members.push_back(it);
-		return members;
-	}
+	Type const* memberType(std::string const& _name) const;
+	MemberMap membersByName(std::string const& _name) const;
 	/// @returns the offset of the given member in storage slots and bytes inside a slot or
 	/// a nullptr if the member is not part of storage.
 	std::pair<u256, unsigned> const* memberStorageOffset(std::string const& _name) const;
@@ -151,10 +137,26 @@ public:
 	MemberMap::const_iterator end() const { return m_memberTypes.end(); }
 
 private:
+	/// Index of the members by name. The members with the same name form a linked list
+	/// in the order of m_memberTypes.
+	struct NameIndex
+	{
+		static size_t constexpr end = std::numeric_limits<size_t>::max();
+		/// Index of the first member with the given name.
+		std::unordered_map<std::string_view, size_t> first;
+		/// Index of the next member with the same name, or end.
+		std::vector<size_t> next;
+	};
+
 	StorageOffsets const& storageOffsets() const;
+	NameIndex const& nameIndex() const;
+	/// Calls @a _callback with the index of each member named @a _name.
+	template <typename Callback>
+	void forEachMemberNamed(std::string const& _name, Callback&& _callback) const;
 
 	MemberMap m_memberTypes;
 	util::LazyInit<StorageOffsets> m_storageOffsets;
+	util::LazyInit<NameIndex> m_nameIndex;
 };
 
 static_assert(std::is_nothrow_move_constructible<MemberList>::value, "MemberList should be noexcept move constructible");
@@ -372,6 +374,16 @@ public:
 	/// Clears all internally cached values (if any).
 	virtual void clearCache() const;
 
+	/// Requests to members() that were answered from the cache (hits) or had to compute the members (misses).
+	struct MemberCacheStatistics
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+	};
+	/// @returns the statistics of the member list cache of all types since the last reset.
+	static MemberCacheStatistics memberCacheStatistics();
+	static void resetMemberCacheStatistics();
+
 private:
 	/// @returns a member list containing all members added to this type by `using for` directives.
 	static MemberList::MemberMap boundFunctions(Type const& _type, ASTNode const& _scope);
@@ -392,7 +404,7 @@ protected:
 
 
 	/// List of member types (parameterised by scape), will be lazy-initialized.
-	mutable std::map<ASTNode const*, std::unique_ptr<MemberList>> m_members;
+	mutable std::unordered_map<ASTNode const*, std::unique_ptr<MemberList>> m_members;
 	mutable std::optional<std::vector<std::tuple<std::string, Type const*>>> m_stackItems;
 	mutable std::optional<size_t> m_stackSize;
 };
@@ -589,9 +601,13 @@ public:
 	bool isZero() const { return m_value == 0; }
 
 	/// @returns true if the literal is a valid integer.
+	/// The result is cached in the annotation of the literal.
 	static std::tuple<bool, rational> isValidLiteral(Literal const& _literal);
 
 private:
+	/// Converts the value of @a _literal, including its subdenomination.
+	static std::tuple<bool, rational> convertLiteral(Literal const& _literal);
+
 	rational m_value;
 
 	/// Bytes type to which the rational can be implicitly converted.
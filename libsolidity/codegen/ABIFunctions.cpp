@@ -35,6 +35,44 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// @returns true if every word is a valid ABI encoding of a value of type @a _type,
+/// i.e. if decoding the value does not require validation.
+bool decodedWithoutValidation(Type const& _type)
+{
+	if (auto const* integerType = dynamic_cast<IntegerType const*>(&_type))
+		return integerType->numBits() == 256;
+	else if (auto const* fixedBytesType = dynamic_cast<FixedBytesType const*>(&_type))
+		return fixedBytesType->numBytes() == 32;
+	return false;
+}
+
+/// @returns true if values of the memory type @a _type are stored in memory exactly like they
+/// are ABI-encoded and decoding them does not require validation, i.e. if they can be decoded
+/// by copying their encoding.
+bool decodedByCopyingStaticData(Type const& _type)
+{
+	if (auto const* arrayType = dynamic_cast<ArrayType const*>(&_type))
+		return
+			!arrayType->isDynamicallySized() &&
+			!arrayType->isByteArray() &&
+			decodedWithoutValidation(*arrayType->baseType());
+	else if (auto const* structType = dynamic_cast<StructType const*>(&_type))
+	{
+		if (structType->recursive())
+			return false;
+		auto const& members = structType->members(nullptr);
+		return members.begin() != members.end() && all_of(members.begin(), members.end(), [](auto const& _member) {
+			return decodedWithoutValidation(*_member.type);
+		});
+	}
+	return false;
+}
+
+}
+
 string ABIFunctions::tupleEncoder(
 	TypePointers const& _givenTypes,
 	TypePointers _targetTypes,
@@ -86,7 +124,18 @@ string ABIFunctions::tupleEncoder(
 			solAssert(_targetTypes[i], "");
 			size_t sizeOnStack = _givenTypes[i]->sizeOnStack();
 			bool dynamic = _targetTypes[i]->isDynamicallyEncoded();
+			string values = suffixedVariableNameList("value", stackPos, stackPos + sizeOnStack);
+			// Values that are encoded into a single word are stored directly at their
+			// offset instead of calling the encoding function of their type.
+			optional<string> encodedValue =
+				dynamic ?
+				nullopt :
+				valueEncodingExpression(*_givenTypes[i], *_targetTypes[i], options, values);
 			Whiskers elementTempl(
+				encodedValue ?
+				string(R"(
+					mstore(add(headStart, <pos>), <encodedValue>)
+				)") :
 				dynamic ?
 				string(R"(
 					mstore(add(headStart, <pos>), sub(tail, headStart))
@@ -96,10 +145,14 @@ string ABIFunctions::tupleEncoder(
 					<abiEncode>(<values> add(headStart, <pos>))
 				)")
 			);
-			string values = suffixedVariableNameList("value", stackPos, stackPos + sizeOnStack);
-			elementTempl("values", values.empty() ? "" : values + ", ");
 			elementTempl("pos", to_string(headPos));
-			elementTempl("abiEncode", abiEncodingFunction(*_givenTypes[i], *_targetTypes[i], options));
+			if (encodedValue)
+				elementTempl("encodedValue", *encodedValue);
+			else
+			{
+				elementTempl("values", values.empty() ? "" : values + ", ");
+				elementTempl("abiEncode", abiEncodingFunction(*_givenTypes[i], *_targetTypes[i], options));
+			}
 			encodeElements += elementTempl.render();
 			headPos += _targetTypes[i]->calldataHeadSize();
 			stackPos += sizeOnStack;
@@ -162,7 +215,17 @@ string ABIFunctions::tupleEncoderPacked(
 			solAssert(_targetTypes[i], "");
 			size_t sizeOnStack = _givenTypes[i]->sizeOnStack();
 			bool dynamic = _targetTypes[i]->isDynamicallyEncoded();
+			string values = suffixedVariableNameList("value", stackPos, stackPos + sizeOnStack);
+			optional<string> encodedValue =
+				dynamic ?
+				nullopt :
+				valueEncodingExpression(*_givenTypes[i], *_targetTypes[i], options, values);
 			Whiskers elementTempl(
+				encodedValue ?
+				string(R"(
+					mstore(pos, <encodedValue>)
+					pos := add(pos, <calldataEncodedSize>)
+				)") :
 				dynamic ?
 				string(R"(
 					pos := <abiEncode>(<values> pos)
@@ -172,11 +235,15 @@ string ABIFunctions::tupleEncoderPacked(
 					pos := add(pos, <calldataEncodedSize>)
 				)")
 			);
-			string values = suffixedVariableNameList("value", stackPos, stackPos + sizeOnStack);
-			elementTempl("values", values.empty() ? "" : values + ", ");
 			if (!dynamic)
 				elementTempl("calldataEncodedSize", to_string(_targetTypes[i]->calldataEncodedSize(false)));
-			elementTempl("abiEncode", abiEncodingFunction(*_givenTypes[i], *_targetTypes[i], options));
+			if (encodedValue)
+				elementTempl("encodedValue", *encodedValue);
+			else
+			{
+				elementTempl("values", values.empty() ? "" : values + ", ");
+				elementTempl("abiEncode", abiEncodingFunction(*_givenTypes[i], *_targetTypes[i], options));
+			}
 			encodeElements += elementTempl.render();
 			stackPos += sizeOnStack;
 		}
@@ -364,31 +431,53 @@ string ABIFunctions::abiEncodingFunction(
 			}
 		)");
 		templ("functionName", functionName);
-
-		if (_from.dataStoredIn(DataLocation::Storage))
-		{
-			// special case: convert storage reference type to value type - this is only
-			// possible for library calls where we just forward the storage reference
-			solAssert(_options.encodeAsLibraryTypes, "");
-			solAssert(_options.padded && !_options.dynamicInplace, "Non-padded / inplace encoding for library call requested.");
-			solAssert(to == *TypeProvider::uint256(), "");
-			templ("cleanupConvert", "value");
-		}
-		else
-		{
-			string cleanupConvert;
-			if (_from == to)
-				cleanupConvert = m_utils.cleanupFunction(_from) + "(value)";
-			else
-				cleanupConvert = m_utils.conversionFunction(_from, to) + "(value)";
-			if (!_options.padded)
-				cleanupConvert = m_utils.leftAlignFunction(to) + "(" + cleanupConvert + ")";
-			templ("cleanupConvert", cleanupConvert);
-		}
+		optional<string> cleanupConvert = valueEncodingExpression(_from, to, _options, "value");
+		solAssert(cleanupConvert, "");
+		templ("cleanupConvert", *cleanupConvert);
 		return templ.render();
 	});
 }
 
+optional<string> ABIFunctions::valueEncodingExpression(
+	Type const& _givenType,
+	Type const& _targetType,
+	EncodingOptions const& _options,
+	string const& _value
+)
+{
+	Type const* toInterface = _targetType.fullEncodingType(_options.encodeAsLibraryTypes, true, false);
+	solUnimplementedAssert(toInterface, "Encoding type \"" + _targetType.toString() + "\" not yet implemented.");
+	Type const& to = *toInterface;
+
+	if (
+		_givenType.category() == Type::Category::StringLiteral ||
+		_givenType.category() == Type::Category::Function ||
+		!to.isValueType()
+	)
+		return nullopt;
+
+	solAssert(_givenType.sizeOnStack() == 1, "");
+	solAssert(to.calldataEncodedSize() == 32, "");
+	if (_givenType.dataStoredIn(DataLocation::Storage))
+	{
+		// special case: convert storage reference type to value type - this is only
+		// possible for library calls where we just forward the storage reference
+		solAssert(_options.encodeAsLibraryTypes, "");
+		solAssert(_options.padded && !_options.dynamicInplace, "Non-padded / inplace encoding for library call requested.");
+		solAssert(to == *TypeProvider::uint256(), "");
+		return _value;
+	}
+
+	string cleanupConvert;
+	if (_givenType == to)
+		cleanupConvert = m_utils.cleanupFunction(_givenType) + "(" + _value + ")";
+	else
+		cleanupConvert = m_utils.conversionFunction(_givenType, to) + "(" + _value + ")";
+	if (!_options.padded)
+		cleanupConvert = m_utils.leftAlignFunction(to) + "(" + cleanupConvert + ")";
+	return cleanupConvert;
+}
+
 string ABIFunctions::abiEncodeAndReturnUpdatedPosFunction(
 	Type const& _givenType,
 	Type const& _targetType,
@@ -1191,6 +1280,18 @@ string ABIFunctions::abiDecodingFunctionArrayAvailableLength(ArrayType const& _t
 				if gt(srcEnd, end) {
 					<revertInvalidStride>()
 				}
+				<?copyElements>
+					calldatacopy(dst, offset, sub(srcEnd, offset))
+				<!copyElements><?copyElementData>
+					let size := sub(srcEnd, offset)
+					let elements := <allocate>(size)
+					calldatacopy(elements, offset, size)
+					for { let elementsEnd := add(elements, size) } lt(elements, elementsEnd) { elements := add(elements, <stride>) }
+					{
+						mstore(dst, elements)
+						dst := add(dst, 0x20)
+					}
+				<!copyElementData>
 				for { let src := offset } lt(src, srcEnd) { src := add(src, <stride>) }
 				{
 					<?dynamicBase>
@@ -1203,8 +1304,15 @@ string ABIFunctions::abiDecodingFunctionArrayAvailableLength(ArrayType const& _t
 					mstore(dst, <decodingFun>(elementPos, end))
 					dst := add(dst, 0x20)
 				}
+				</copyElementData></copyElements>
 			}
 		)");
+		// Elements that do not need validation are copied from calldata at once. This does not
+		// work for memory, since there is no opcode to copy memory.
+		bool copyElements = !_fromMemory && decodedWithoutValidation(*_type.baseType());
+		bool copyElementData = !_fromMemory && !copyElements && decodedByCopyingStaticData(*_type.baseType());
+		templ("copyElements", copyElements);
+		templ("copyElementData", copyElementData);
 		templ("functionName", functionName);
 		templ("readableTypeName", _type.toString(true));
 		templ("allocate", m_utils.allocationFunction());
@@ -1218,7 +1326,8 @@ string ABIFunctions::abiDecodingFunctionArrayAvailableLength(ArrayType const& _t
 			revertReasonIfDebugFunction("ABI decoding: invalid calldata array stride")
 		);
 		templ("revertStringOffset", revertReasonIfDebugFunction("ABI decoding: invalid calldata array offset"));
-		templ("decodingFun", abiDecodingFunction(*_type.baseType(), _fromMemory, false));
+		if (!copyElements && !copyElementData)
+			templ("decodingFun", abiDecodingFunction(*_type.baseType(), _fromMemory, false));
 		return templ.render();
 	});
 }
@@ -1535,7 +1644,7 @@ string ABIFunctions::arrayStoreLengthForEncodingFunction(ArrayType const& _type,
 
 string ABIFunctions::createFunction(string const& _name, function<string ()> const& _creator)
 {
-	return m_functionCollector.createFunction(_name, _creator);
+	return m_functionCollector.createSharedFunction(_name, _creator);
 }
 
 size_t ABIFunctions::headSize(TypePointers const& _targetTypes)
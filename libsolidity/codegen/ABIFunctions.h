@@ -32,6 +32,7 @@
 
 #include <functional>
 #include <map>
+#include <optional>
 #include <vector>
 
 namespace solidity::frontend
@@ -224,6 +225,15 @@ private:
 		Type const& _to,
 		EncodingOptions const& _options
 	);
+	/// @returns the expression that converts @a _value of type @a _givenType into the single
+	/// word encoding it as @a _targetType or nullopt if the value is not encoded as a single word
+	/// computed from the value only.
+	std::optional<std::string> valueEncodingExpression(
+		Type const& _givenType,
+		Type const& _targetType,
+		EncodingOptions const& _options,
+		std::string const& _value
+	);
 
 	/// @returns the name of the ABI decoding function for the given type
 	/// and queues the generation of the function to the requested functions.
@@ -60,6 +60,12 @@ void ArrayUtils::copyArrayToStorage(ArrayType const& _targetType, ArrayType cons
 	bool directCopy = sourceIsStorage && sourceBaseType->isValueType() && *sourceBaseType == *targetBaseType;
 	bool haveByteOffsetSource = !directCopy && sourceIsStorage && sourceBaseType->storageBytes() <= 16;
 	bool haveByteOffsetTarget = !directCopy && targetBaseType->storageBytes() <= 16;
+	bool packedValueCopy =
+		!sourceIsStorage &&
+		!_sourceType.isByteArray() &&
+		sourceBaseType->isValueType() &&
+		sourceBaseType->sizeOnStack() == 1 &&
+		haveByteOffsetTarget;
 	unsigned byteOffsetSize = (haveByteOffsetSource ? 1u : 0u) + (haveByteOffsetTarget ? 1u : 0u);
 
 	// stack: source_ref [source_length] target_ref
@@ -180,6 +186,25 @@ void ArrayUtils::copyArrayToStorage(ArrayType const& _targetType, ArrayType cons
 			utils.convertLengthToSize(_sourceType);
 			_context << Instruction::DUP3 << Instruction::ADD;
 			// stack: target_ref target_data_end source_data_pos target_data_pos source_data_end
+			auto clearTargetLeftovers = [&]()
+			{
+				// zero-out leftovers in target
+				// stack: target_ref target_data_end source_data_pos target_data_pos_updated source_data_end
+				_context << Instruction::POP << Instruction::SWAP1 << Instruction::POP;
+				// stack: target_ref target_data_end target_data_pos_updated
+				if (targetBaseType->storageBytes() < 32)
+					utils.clearStorageLoop(TypeProvider::uint256());
+				else
+					utils.clearStorageLoop(targetBaseType);
+				_context << Instruction::POP;
+			};
+			if (packedValueCopy)
+			{
+				utils.copyValueArrayToPackedStorage(_targetType, _sourceType);
+				_context << copyLoopEndWithoutByteOffset;
+				clearTargetLeftovers();
+				return;
+			}
 			if (haveByteOffsetTarget)
 				_context << u256(0);
 			if (haveByteOffsetSource)
@@ -297,16 +322,7 @@ void ArrayUtils::copyArrayToStorage(ArrayType const& _targetType, ArrayType cons
 			if (haveByteOffsetSource)
 				_context << Instruction::POP;
 			_context << copyLoopEndWithoutByteOffset;
-
-			// zero-out leftovers in target
-			// stack: target_ref target_data_end source_data_pos target_data_pos_updated source_data_end
-			_context << Instruction::POP << Instruction::SWAP1 << Instruction::POP;
-			// stack: target_ref target_data_end target_data_pos_updated
-			if (targetBaseType->storageBytes() < 32)
-				utils.clearStorageLoop(TypeProvider::uint256());
-			else
-				utils.clearStorageLoop(targetBaseType);
-			_context << Instruction::POP;
+			clearTargetLeftovers();
 		}
 	);
 }
@@ -977,6 +993,79 @@ void ArrayUtils::clearStorageLoop(Type const* _type) const
 	);
 }
 
+void ArrayUtils::copyValueArrayToPackedStorage(ArrayType const& _targetType, ArrayType const& _sourceType) const
+{
+	Type const* sourceBaseType = _sourceType.baseType();
+	Type const* targetBaseType = _targetType.baseType();
+	solAssert(_sourceType.location() != DataLocation::Storage, "");
+	solAssert(sourceBaseType->isValueType() && sourceBaseType->sizeOnStack() == 1, "");
+	solAssert(targetBaseType->isValueType() && targetBaseType->storageBytes() <= 16, "");
+
+	bool fromCalldata = _sourceType.location() == DataLocation::CallData;
+	unsigned storageBytes = targetBaseType->storageBytes();
+	unsigned itemsPerSlot = 32 / storageBytes;
+	CompilerUtils utils(m_context);
+
+	// stack: source_data_pos target_data_pos source_data_end
+	// The slot value is assembled on the stack, the multiplier shifts the next item into place.
+	m_context << u256(0) << u256(1);
+	evmasm::AssemblyItem loopStart = m_context.newTag();
+	m_context << loopStart;
+	// stack: source_data_pos target_data_pos source_data_end slot_value multiplier
+	m_context
+		<< Instruction::DUP5 << Instruction::DUP4
+		<< Instruction::GT << Instruction::ISZERO;
+	evmasm::AssemblyItem loopEnd = m_context.appendConditionalJump();
+	m_context << Instruction::DUP5;
+	utils.loadFromMemoryDynamic(*sourceBaseType, fromCalldata, true, false);
+	// convert and clean the value like StorageItem::storeValue does
+	if (dynamic_cast<FunctionType const*>(targetBaseType))
+		m_context << ((u256(1) << (8 * storageBytes)) - 1) << Instruction::AND;
+	else if (targetBaseType->leftAligned())
+	{
+		utils.convertType(*sourceBaseType, *targetBaseType, true);
+		utils.rightShiftNumberOnStack(256 - 8 * storageBytes);
+	}
+	else
+		utils.convertType(*sourceBaseType, *targetBaseType, true, true);
+	// stack: source_data_pos target_data_pos source_data_end slot_value multiplier value
+	m_context
+		<< Instruction::DUP2 << Instruction::MUL
+		<< Instruction::DUP3 << Instruction::OR
+		<< Instruction::SWAP2 << Instruction::POP;
+	// increment source
+	m_context
+		<< Instruction::SWAP4
+		<< (fromCalldata ? sourceBaseType->calldataHeadSize() : sourceBaseType->memoryHeadSize())
+		<< Instruction::ADD
+		<< Instruction::SWAP4;
+	// stack: source_data_pos target_data_pos source_data_end slot_value multiplier
+	m_context << Instruction::DUP1 << (u256(1) << (8 * storageBytes * (itemsPerSlot - 1))) << Instruction::EQ;
+	evmasm::AssemblyItem slotFull = m_context.appendConditionalJump();
+	m_context << (u256(1) << (8 * storageBytes)) << Instruction::MUL;
+	m_context.appendJumpTo(loopStart);
+
+	m_context << slotFull;
+	// store the complete slot and start the next one
+	m_context << Instruction::POP << Instruction::DUP3 << Instruction::SSTORE;
+	m_context << Instruction::SWAP1 << u256(1) << Instruction::ADD << Instruction::SWAP1;
+	m_context << u256(0) << u256(1);
+	m_context.appendJumpTo(loopStart);
+
+	m_context << loopEnd;
+	// store the partially assembled last slot, if any
+	m_context << u256(1) << Instruction::EQ;
+	evmasm::AssemblyItem slotEmpty = m_context.appendConditionalJump();
+	// stack: source_data_pos target_data_pos source_data_end slot_value
+	m_context << Instruction::DUP3 << Instruction::SSTORE;
+	m_context << Instruction::SWAP1 << u256(1) << Instruction::ADD << Instruction::SWAP1;
+	evmasm::AssemblyItem end = m_context.appendJumpToNew();
+	m_context.adjustStackOffset(1);
+	m_context << slotEmpty << Instruction::POP;
+	m_context << end;
+	// stack: source_data_pos target_data_pos_updated source_data_end
+}
+
 void ArrayUtils::convertLengthToSize(ArrayType const& _arrayType, bool _pad) const
 {
 	if (_arrayType.location() == DataLocation::Storage)
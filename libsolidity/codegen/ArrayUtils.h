@@ -108,6 +108,12 @@ public:
 	void accessCallDataArrayElement(ArrayType const& _arrayType, bool _doBoundsCheck = true) const;
 
 private:
+	/// Copies the elements of a memory or calldata array of value types to a storage array
+	/// whose elements are packed, assembling each slot on the stack before storing it.
+	/// The remaining bytes of the last slot written are zeroed.
+	/// Stack pre: source_data_pos target_data_pos source_data_end
+	/// Stack post: source_data_pos_updated target_data_pos_updated source_data_end
+	void copyValueArrayToPackedStorage(ArrayType const& _targetType, ArrayType const& _sourceType) const;
 	/// Adds the given number of bytes to a storage byte offset counter and also increments
 	/// the storage offset if adding this number again would increase the counter over 32.
 	/// @param byteOffsetPosition the stack offset of the storage byte offset
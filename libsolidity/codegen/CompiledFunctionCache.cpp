@@ -0,0 +1,39 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the code of functions compiled by the legacy code generator, to be reused by the
+ * other contracts of a compilation that inherit the functions.
+ */
+
+#include <libsolidity/codegen/CompiledFunctionCache.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+vector<shared_ptr<CompiledFunctionCache::Function const>> const& CompiledFunctionCache::find(Declaration const& _function) const
+{
+	static vector<shared_ptr<Function const>> const empty;
+	auto it = m_functions.find(&_function);
+	return it != m_functions.end() ? it->second : empty;
+}
+
+void CompiledFunctionCache::store(Declaration const& _function, shared_ptr<Function const> _compiled)
+{
+	m_functions[&_function].emplace_back(move(_compiled));
+}
@@ -0,0 +1,145 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the code of functions compiled by the legacy code generator, to be reused by the
+ * other contracts of a compilation that inherit the functions.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTEnums.h>
+#include <libsolidity/ast/ASTForward.h>
+
+#include <libevmasm/AssemblyItem.h>
+
+#include <libsolutil/Common.h>
+#include <libsolutil/FixedHash.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+class CompilerContext;
+
+/**
+ * Code of functions compiled into the runtime context of a contract. The runtime context of
+ * another contract of the same compilation can append the code instead of compiling the
+ * function again if the contract gives the same answers to all questions the code generator
+ * asked about the contract while compiling the function, e.g. which functions override the
+ * ones that are called and where the state variables are stored.
+ */
+class CompiledFunctionCache
+{
+public:
+	/// Questions about the contract being compiled, together with their answers.
+	struct VirtualFunction
+	{
+		FunctionDefinition const* function;
+		FunctionDefinition const* resolved;
+	};
+	struct VirtualModifier
+	{
+		ModifierDefinition const* modifier;
+		ModifierDefinition const* resolved;
+	};
+	struct SuperFunction
+	{
+		FunctionDefinition const* function;
+		ContractDefinition const* base;
+		FunctionDefinition const* resolved;
+	};
+	struct StorageLocation
+	{
+		Declaration const* variable;
+		std::pair<u256, unsigned> location;
+	};
+	using Query = std::variant<VirtualFunction, VirtualModifier, SuperFunction, StorageLocation>;
+
+	/// Requests for tags that do not belong to the function itself.
+	struct EntryLabel
+	{
+		Declaration const* function;
+	};
+	struct LowLevelFunction
+	{
+		std::string name;
+		unsigned inArgs;
+		unsigned outArgs;
+		std::function<void(CompilerContext&)> generator;
+	};
+	struct NamedTag
+	{
+		std::string name;
+		size_t params;
+		size_t returns;
+		std::optional<uint64_t> sourceID;
+	};
+	struct ExternalTag
+	{
+		std::variant<EntryLabel, LowLevelFunction, NamedTag> request;
+		/// Identifier of the next tag to be created at the time of the request.
+		size_t nextTag;
+		/// The tag returned by the request.
+		size_t tag;
+	};
+
+	struct Function
+	{
+		/// Whether ABI coder v2 and checked arithmetic were used at the start and at the end of the function.
+		bool useABICoderV2 = false;
+		Arithmetic arithmetic = Arithmetic::Checked;
+		bool useABICoderV2After = false;
+		Arithmetic arithmeticAfter = Arithmetic::Checked;
+		/// Questions about the contract in the order in which they were asked.
+		std::vector<Query> queries;
+		/// External tags in the order in which they were requested.
+		std::vector<ExternalTag> externalTags;
+		/// Identifiers of the first tag created while compiling the function and of the tag after the last one.
+		/// All tags in between that were not requested as external tags belong to the function.
+		size_t firstTag = 0;
+		size_t endTag = 0;
+		evmasm::AssemblyItems items;
+		int stackHeightAfter = 0;
+		/// Data, libraries and immutables referenced by the items.
+		std::map<util::h256, bytes> data;
+		std::map<util::h256, std::string> libraries;
+		std::map<util::h256, std::string> immutables;
+		/// Yul utility functions requested from the collector, in the order of the requests.
+		std::vector<std::string> yulFunctions;
+		/// Yul utility functions called from the code.
+		std::set<std::string> externallyUsedYulFunctions;
+	};
+
+	/// @returns the compiled versions of @a _function in the order in which they were stored.
+	std::vector<std::shared_ptr<Function const>> const& find(Declaration const& _function) const;
+	void store(Declaration const& _function, std::shared_ptr<Function const> _compiled);
+
+private:
+	std::map<Declaration const*, std::vector<std::shared_ptr<Function const>>> m_functions;
+};
+
+}
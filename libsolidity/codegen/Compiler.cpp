@@ -33,23 +33,30 @@ using namespace solidity::frontend;
 void Compiler::compileContract(
 	ContractDefinition const& _contract,
 	std::map<ContractDefinition const*, shared_ptr<Compiler const>> const& _otherCompilers,
-	bytes const& _metadata
+	bytes const& _metadata,
+	util::TimingCollector* _timings
 )
 {
-	ContractCompiler runtimeCompiler(nullptr, m_runtimeContext, m_optimiserSettings);
-	runtimeCompiler.compileContract(_contract, _otherCompilers);
-	m_runtimeContext.appendToAuxiliaryData(_metadata);
-
-	// This might modify m_runtimeContext because it can access runtime functions at
-	// creation time.
-	OptimiserSettings creationSettings{m_optimiserSettings};
-	// The creation code will be executed at most once, so we modify the optimizer
-	// settings accordingly.
-	creationSettings.expectedExecutionsPerDeployment = 1;
-	ContractCompiler creationCompiler(&runtimeCompiler, m_context, creationSettings);
-	m_runtimeSub = creationCompiler.compileConstructor(_contract, _otherCompilers);
-
-	m_context.optimise(m_optimiserSettings);
+	{
+		util::ScopedTimer timer(_timings, "evmCodeGeneration");
+		ContractCompiler runtimeCompiler(nullptr, m_runtimeContext, m_optimiserSettings);
+		runtimeCompiler.compileContract(_contract, _otherCompilers);
+		m_runtimeContext.appendToAuxiliaryData(_metadata);
+
+		// This might modify m_runtimeContext because it can access runtime functions at
+		// creation time.
+		OptimiserSettings creationSettings{m_optimiserSettings};
+		// The creation code will be executed at most once, so we modify the optimizer
+		// settings accordingly.
+		creationSettings.expectedExecutionsPerDeployment = 1;
+		ContractCompiler creationCompiler(&runtimeCompiler, m_context, creationSettings);
+		m_runtimeSub = creationCompiler.compileConstructor(_contract, _otherCompilers);
+	}
+
+	{
+		util::ScopedTimer timer(_timings, "evmAssemblyOptimisation");
+		m_context.optimise(m_optimiserSettings, !m_optimiseCreationCode);
+	}
 
 	solAssert(m_context.appendYulUtilityFunctionsRan(), "appendYulUtilityFunctions() was not called.");
 	solAssert(m_runtimeContext.appendYulUtilityFunctionsRan(), "appendYulUtilityFunctions() was not called.");
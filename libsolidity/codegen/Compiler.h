@@ -28,6 +28,7 @@
 #include <libsolidity/interface/DebugSettings.h>
 #include <liblangutil/EVMVersion.h>
 #include <libevmasm/Assembly.h>
+#include <libsolutil/Timing.h>
 #include <functional>
 #include <ostream>
 
@@ -45,11 +46,23 @@ public:
 
 	/// Compiles a contract.
 	/// @arg _metadata contains the to be injected metadata CBOR
+	/// @arg _timings if given, receives the time spent in the code generation and in the optimiser
 	void compileContract(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
-		bytes const& _metadata
+		bytes const& _metadata,
+		util::TimingCollector* _timings = nullptr
 	);
+	/// Sets the caches shared with the other contracts of the compilation. They have to outlive this object.
+	void setFunctionCaches(CompiledFunctionCache* _compiledFunctions, MultiUseYulFunctionCache* _yulFunctions)
+	{
+		m_runtimeContext.setCompiledFunctionCache(_compiledFunctions);
+		m_runtimeContext.setYulFunctionCache(_yulFunctions);
+		m_context.setYulFunctionCache(_yulFunctions);
+	}
+	/// Sets whether the creation code is optimised. If not, only the runtime code and the other
+	/// sub-assemblies are, which does not change the runtime code.
+	void setOptimiseCreationCode(bool _optimise) { m_optimiseCreationCode = _optimise; }
 	/// @returns Entire assembly.
 	evmasm::Assembly const& assembly() const { return m_context.assembly(); }
 	/// @returns Runtime assembly.
@@ -64,6 +77,7 @@ public:
 
 private:
 	OptimiserSettings const m_optimiserSettings;
+	bool m_optimiseCreationCode = true;
 	CompilerContext m_runtimeContext;
 	size_t m_runtimeSub = size_t(-1); ///< Identifier of the runtime sub-assembly, if present.
 	CompilerContext m_context;
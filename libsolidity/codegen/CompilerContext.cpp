@@ -43,6 +43,7 @@
 
 #include <libsolutil/Whiskers.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Visitor.h>
 
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/Scanner.h>
@@ -119,6 +120,95 @@ void CompilerContext::startFunction(Declaration const& _function)
 	*this << functionEntryLabel(_function);
 }
 
+void CompilerContext::setCompiledFunctionCache(CompiledFunctionCache* _cache)
+{
+	solAssert(!m_runtimeContext, "Compiled functions can only be shared between runtime contexts.");
+	m_compiledFunctionCache = _cache;
+}
+
+bool CompilerContext::appendCompiledFunctionFromCache(Declaration const& _function)
+{
+	if (!m_compiledFunctionCache)
+		return false;
+	for (auto const& compiled: m_compiledFunctionCache->find(_function))
+		if (answersQueriesOf(*compiled))
+		{
+			m_functionCompilationQueue.startFunction(_function);
+			appendCompiledFunction(*compiled);
+			return true;
+		}
+	return false;
+}
+
+void CompilerContext::compileFunctionIntoCache(Declaration const& _function, function<void()> const& _compile)
+{
+	if (!m_compiledFunctionCache || !dynamic_cast<FunctionDefinition const*>(&_function))
+	{
+		_compile();
+		return;
+	}
+
+	solAssert(!m_functionRecording, "");
+	m_functionRecording = make_unique<FunctionRecording>();
+	m_functionRecording->function.useABICoderV2 = m_useABICoderV2;
+	m_functionRecording->function.arithmetic = m_arithmetic;
+	m_functionRecording->function.firstTag = m_asm->nextTagId();
+	m_functionRecording->firstItem = m_asm->items().size();
+	m_yulFunctionCollector.startRecording();
+	unique_ptr<FunctionRecording> recording;
+	{
+		ScopeGuard stopRecording([&]() { recording = move(m_functionRecording); });
+		_compile();
+	}
+	optional<vector<string>> yulFunctions = m_yulFunctionCollector.stopRecording();
+	if (!recording->cacheable || !yulFunctions)
+		return;
+
+	CompiledFunctionCache::Function& compiled = recording->function;
+	compiled.endTag = m_asm->nextTagId();
+	set<size_t> externalTags;
+	for (auto const& externalTag: compiled.externalTags)
+		externalTags.insert(externalTag.tag);
+	for (size_t i = recording->firstItem; i < m_asm->items().size(); ++i)
+	{
+		evmasm::AssemblyItem const& item = m_asm->items()[i];
+		switch (item.type())
+		{
+		case evmasm::Operation:
+		case evmasm::Push:
+		case evmasm::VerbatimBytecode:
+			break;
+		case evmasm::Tag:
+		case evmasm::PushTag:
+		{
+			auto [subId, tag] = item.splitForeignPushTag();
+			bool const ownTag = compiled.firstTag <= tag && tag < compiled.endTag;
+			if (subId != numeric_limits<size_t>::max() || (!ownTag && !externalTags.count(tag)))
+				return;
+			break;
+		}
+		case evmasm::PushData:
+			compiled.data[h256(item.data())] = m_asm->data(h256(item.data()));
+			break;
+		case evmasm::PushLibraryAddress:
+			compiled.libraries[h256(item.data())] = m_asm->libraryIdentifier(h256(item.data()));
+			break;
+		case evmasm::PushImmutable:
+			compiled.immutables[h256(item.data())] = m_asm->immutableIdentifier(h256(item.data()));
+			break;
+		default:
+			// Sub-assemblies, the program size and the deploy time address depend on the contract.
+			return;
+		}
+	}
+	compiled.items.assign(m_asm->items().begin() + static_cast<ptrdiff_t>(recording->firstItem), m_asm->items().end());
+	compiled.stackHeightAfter = m_asm->deposit();
+	compiled.useABICoderV2After = m_useABICoderV2;
+	compiled.arithmeticAfter = m_arithmetic;
+	compiled.yulFunctions = move(*yulFunctions);
+	m_compiledFunctionCache->store(_function, make_shared<CompiledFunctionCache::Function const>(move(compiled)));
+}
+
 void CompilerContext::callLowLevelFunction(
 	string const& _name,
 	unsigned _inArgs,
@@ -143,6 +233,8 @@ void CompilerContext::callYulFunction(
 )
 {
 	m_externallyUsedYulFunctions.insert(_name);
+	if (m_functionRecording)
+		m_functionRecording->function.externallyUsedYulFunctions.insert(_name);
 	auto const retTag = pushNewTag();
 	CompilerUtils(*this).moveIntoStack(_inArgs);
 	appendJumpTo(namedTag(_name, _inArgs, _outArgs, {}), evmasm::AssemblyItem::JumpType::IntoFunction);
@@ -157,16 +249,17 @@ evmasm::AssemblyItem CompilerContext::lowLevelFunctionTag(
 	function<void(CompilerContext&)> const& _generator
 )
 {
+	size_t const nextTag = m_asm->nextTagId();
 	auto it = m_lowLevelFunctions.find(_name);
 	if (it == m_lowLevelFunctions.end())
 	{
 		evmasm::AssemblyItem tag = newTag().pushTag();
 		m_lowLevelFunctions.insert(make_pair(_name, tag));
 		m_lowLevelFunctionGenerationQueue.push(make_tuple(_name, _inArgs, _outArgs, _generator));
-		return tag;
+		it = m_lowLevelFunctions.find(_name);
 	}
-	else
-		return it->second;
+	recordExternalTag(CompiledFunctionCache::LowLevelFunction{_name, _inArgs, _outArgs, _generator}, nextTag, it->second);
+	return it->second;
 }
 
 void CompilerContext::appendMissingLowLevelFunctions()
@@ -270,29 +363,63 @@ bool CompilerContext::isLocalVariable(Declaration const* _declaration) const
 
 evmasm::AssemblyItem CompilerContext::functionEntryLabel(Declaration const& _declaration)
 {
-	return m_functionCompilationQueue.entryLabel(_declaration, *this);
+	size_t const nextTag = m_asm->nextTagId();
+	evmasm::AssemblyItem label = m_functionCompilationQueue.entryLabel(_declaration, *this);
+	recordExternalTag(CompiledFunctionCache::EntryLabel{&_declaration}, nextTag, label);
+	return label;
 }
 
 evmasm::AssemblyItem CompilerContext::functionEntryLabelIfExists(Declaration const& _declaration) const
 {
+	if (m_functionRecording)
+		m_functionRecording->cacheable = false;
 	return m_functionCompilationQueue.entryLabelIfExists(_declaration);
 }
 
 FunctionDefinition const& CompilerContext::superFunction(FunctionDefinition const& _function, ContractDefinition const& _base)
 {
 	solAssert(m_mostDerivedContract, "No most derived contract set.");
-	ContractDefinition const* super = _base.superContract(mostDerivedContract());
+	ContractDefinition const* super = _base.superContract(*m_mostDerivedContract);
 	solAssert(super, "Super contract not available.");
 
-	FunctionDefinition const& resolvedFunction = _function.resolveVirtual(mostDerivedContract(), super);
+	FunctionDefinition const& resolvedFunction = _function.resolveVirtual(*m_mostDerivedContract, super);
 	solAssert(resolvedFunction.isImplemented(), "");
 
+	if (m_functionRecording)
+		m_functionRecording->function.queries.emplace_back(
+			CompiledFunctionCache::SuperFunction{&_function, &_base, &resolvedFunction}
+		);
 	return resolvedFunction;
 }
 
+FunctionDefinition const& CompilerContext::virtualFunction(FunctionDefinition const& _function)
+{
+	solAssert(m_mostDerivedContract, "No most derived contract set.");
+	FunctionDefinition const& resolvedFunction = _function.resolveVirtual(*m_mostDerivedContract);
+	if (m_functionRecording)
+		m_functionRecording->function.queries.emplace_back(
+			CompiledFunctionCache::VirtualFunction{&_function, &resolvedFunction}
+		);
+	return resolvedFunction;
+}
+
+ModifierDefinition const& CompilerContext::virtualModifier(ModifierDefinition const& _modifier)
+{
+	solAssert(m_mostDerivedContract, "No most derived contract set.");
+	ModifierDefinition const& resolvedModifier = _modifier.resolveVirtual(*m_mostDerivedContract);
+	if (m_functionRecording)
+		m_functionRecording->function.queries.emplace_back(
+			CompiledFunctionCache::VirtualModifier{&_modifier, &resolvedModifier}
+		);
+	return resolvedModifier;
+}
+
 ContractDefinition const& CompilerContext::mostDerivedContract() const
 {
 	solAssert(m_mostDerivedContract, "Most derived contract not set.");
+	// Arbitrary uses of the contract cannot be recorded.
+	if (m_functionRecording)
+		m_functionRecording->cacheable = false;
 	return *m_mostDerivedContract;
 }
 
@@ -323,9 +450,21 @@ pair<u256, unsigned> CompilerContext::storageLocationOfVariable(Declaration cons
 {
 	auto it = m_stateVariables.find(&_declaration);
 	solAssert(it != m_stateVariables.end(), "Variable not found in storage.");
+	if (m_functionRecording)
+		m_functionRecording->function.queries.emplace_back(
+			CompiledFunctionCache::StorageLocation{&_declaration, it->second}
+		);
 	return it->second;
 }
 
+evmasm::AssemblyItem CompilerContext::namedTag(string const& _name, size_t _params, size_t _returns, optional<uint64_t> _sourceID)
+{
+	size_t const nextTag = m_asm->nextTagId();
+	evmasm::AssemblyItem tag = m_asm->namedTag(_name, _params, _returns, _sourceID);
+	recordExternalTag(CompiledFunctionCache::NamedTag{_name, _params, _returns, _sourceID}, nextTag, tag);
+	return tag;
+}
+
 CompilerContext& CompilerContext::appendJump(evmasm::AssemblyItem::JumpType _jumpType)
 {
 	evmasm::AssemblyItem item(Instruction::JUMP);
@@ -572,19 +711,114 @@ void CompilerContext::updateSourceLocation()
 evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, m_evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, m_evmVersion, 0, 1, 0, chrono::milliseconds{0}, false, false};
 	asmSettings.isCreation = true;
 	asmSettings.runInliner = _settings.runInliner;
+	asmSettings.inlinerCallSiteCostModel = _settings.inlinerCallSiteCostModel;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
 	asmSettings.runCSE = _settings.runCSE;
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
+	asmSettings.maxIterations = _settings.evmasmMaxIterations;
+	asmSettings.timeBudget = chrono::milliseconds(_settings.evmasmTimeBudget);
 	asmSettings.evmVersion = m_evmVersion;
 	return asmSettings;
 }
 
+bool CompilerContext::answersQueriesOf(CompiledFunctionCache::Function const& _compiled) const
+{
+	if (_compiled.useABICoderV2 != m_useABICoderV2 || _compiled.arithmetic != m_arithmetic)
+		return false;
+
+	solAssert(m_mostDerivedContract, "Most derived contract not set.");
+	ContractDefinition const& mostDerived = *m_mostDerivedContract;
+	// The questions are asked in the original order and only until the first different answer,
+	// so that none of them is asked that compiling the function would not ask as well.
+	for (CompiledFunctionCache::Query const& query: _compiled.queries)
+		if (!std::visit(GenericVisitor{
+			[&](CompiledFunctionCache::VirtualFunction const& _query) {
+				return &_query.function->resolveVirtual(mostDerived) == _query.resolved;
+			},
+			[&](CompiledFunctionCache::VirtualModifier const& _query) {
+				return &_query.modifier->resolveVirtual(mostDerived) == _query.resolved;
+			},
+			[&](CompiledFunctionCache::SuperFunction const& _query) {
+				ContractDefinition const* super = _query.base->superContract(mostDerived);
+				return super && &_query.function->resolveVirtual(mostDerived, super) == _query.resolved;
+			},
+			[&](CompiledFunctionCache::StorageLocation const& _query) {
+				auto it = m_stateVariables.find(_query.variable);
+				return it != m_stateVariables.end() && it->second == _query.location;
+			}
+		}, query))
+			return false;
+	return true;
+}
+
+void CompilerContext::appendCompiledFunction(CompiledFunctionCache::Function const& _compiled)
+{
+	// The tags are requested and created in the same order as while compiling the function,
+	// so that the result is the same as if the function was compiled again.
+	map<size_t, size_t> tags;
+	auto externalTag = _compiled.externalTags.begin();
+	auto requestExternalTags = [&](size_t _nextTag) {
+		for (; externalTag != _compiled.externalTags.end() && externalTag->nextTag == _nextTag; ++externalTag)
+			tags[externalTag->tag] = static_cast<size_t>(std::visit(GenericVisitor{
+				[&](CompiledFunctionCache::EntryLabel const& _request) {
+					return functionEntryLabel(*_request.function);
+				},
+				[&](CompiledFunctionCache::LowLevelFunction const& _request) {
+					return lowLevelFunctionTag(_request.name, _request.inArgs, _request.outArgs, _request.generator);
+				},
+				[&](CompiledFunctionCache::NamedTag const& _request) {
+					return namedTag(_request.name, _request.params, _request.returns, _request.sourceID);
+				}
+			}, externalTag->request).data());
+	};
+	for (size_t tag = _compiled.firstTag; tag < _compiled.endTag; ++tag)
+	{
+		requestExternalTags(tag);
+		if (!tags.count(tag))
+			tags[tag] = static_cast<size_t>(newTag().data());
+	}
+	requestExternalTags(_compiled.endTag);
+	solAssert(externalTag == _compiled.externalTags.end(), "");
+
+	for (evmasm::AssemblyItem item: _compiled.items)
+	{
+		if (item.type() == evmasm::Tag || item.type() == evmasm::PushTag)
+			item.setData(tags.at(static_cast<size_t>(item.data())));
+		m_asm->items().emplace_back(move(item));
+	}
+	for (auto const& [hash, data]: _compiled.data)
+		m_asm->newData(data);
+	for (auto const& [hash, identifier]: _compiled.libraries)
+		m_asm->newPushLibraryAddress(identifier);
+	for (auto const& [hash, identifier]: _compiled.immutables)
+		m_asm->newPushImmutable(identifier);
+	m_asm->setDeposit(_compiled.stackHeightAfter);
+
+	m_yulFunctionCollector.addCachedFunctions(_compiled.yulFunctions);
+	m_externallyUsedYulFunctions += _compiled.externallyUsedYulFunctions;
+	m_useABICoderV2 = _compiled.useABICoderV2After;
+	m_arithmetic = _compiled.arithmeticAfter;
+}
+
+void CompilerContext::recordExternalTag(
+	variant<CompiledFunctionCache::EntryLabel, CompiledFunctionCache::LowLevelFunction, CompiledFunctionCache::NamedTag> _request,
+	size_t _nextTag,
+	evmasm::AssemblyItem const& _tag
+)
+{
+	if (!m_functionRecording)
+		return;
+	auto [subId, tag] = _tag.splitForeignPushTag();
+	solAssert(subId == numeric_limits<size_t>::max(), "");
+	m_functionRecording->function.externalTags.push_back({move(_request), _nextTag, tag});
+}
+
 evmasm::AssemblyItem CompilerContext::FunctionCompilationQueue::entryLabel(
 	Declaration const& _declaration,
 	CompilerContext& _context
@@ -604,7 +838,8 @@ evmasm::AssemblyItem CompilerContext::FunctionCompilationQueue::entryLabel(
 
 		// some name that cannot clash with yul function names.
 		string labelName = "@" + _declaration.name() + "_" + to_string(_declaration.id());
-		evmasm::AssemblyItem tag = _context.namedTag(
+		// Not requested via the context, so that it is recorded as a function entry label and not as a named tag.
+		evmasm::AssemblyItem tag = _context.m_asm->namedTag(
 			labelName,
 			params,
 			returns,
@@ -27,6 +27,7 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/codegen/CompiledFunctionCache.h>
 
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -42,6 +43,7 @@
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <functional>
+#include <memory>
 #include <ostream>
 #include <stack>
 #include <queue>
@@ -119,6 +121,10 @@ public:
 	/// @returns the function that overrides the given declaration from the most derived class just
 	/// above _base in the current inheritance hierarchy.
 	FunctionDefinition const& superFunction(FunctionDefinition const& _function, ContractDefinition const& _base);
+	/// @returns the function that overrides the given declaration in the most derived contract.
+	FunctionDefinition const& virtualFunction(FunctionDefinition const& _function);
+	/// @returns the modifier that overrides the given declaration in the most derived contract.
+	ModifierDefinition const& virtualModifier(ModifierDefinition const& _modifier);
 	/// Sets the contract currently being compiled - the most derived one.
 	void setMostDerivedContract(ContractDefinition const& _contract) { m_mostDerivedContract = &_contract; }
 	ContractDefinition const& mostDerivedContract() const;
@@ -135,6 +141,22 @@ public:
 	/// as "having code".
 	void startFunction(Declaration const& _function);
 
+	/// Sets the cache of Yul utility functions shared with the other contracts of the compilation.
+	/// It has to outlive this object.
+	void setYulFunctionCache(MultiUseYulFunctionCache* _cache) { m_yulFunctionCollector.setCache(_cache); }
+	/// Sets the cache of compiled functions shared with the runtime contexts of the other contracts
+	/// of the compilation, which have to use the same settings. It has to outlive this object.
+	/// Only valid for runtime contexts.
+	void setCompiledFunctionCache(CompiledFunctionCache* _cache);
+	/// If the cache of compiled functions holds code of @a _function that was compiled for a contract
+	/// that answers all questions asked during its compilation in the same way as the current one,
+	/// appends that code instead of the function entry label, marks the function as "having code"
+	/// and @returns true.
+	bool appendCompiledFunctionFromCache(Declaration const& _function);
+	/// Calls @a _compile to compile @a _function and stores the code in the cache of compiled functions
+	/// unless it depends on the contract in a way that is not recorded.
+	void compileFunctionIntoCache(Declaration const& _function, std::function<void()> const& _compile);
+
 	/// Appends a call to the named low-level function and inserts the generator into the
 	/// list of low-level-functions to be generated, unless it already exists.
 	/// Note that the generator should not assume that objects are still alive when it is called,
@@ -218,10 +240,7 @@ public:
 	/// @returns a new tag without pushing any opcodes or data
 	evmasm::AssemblyItem newTag() { return m_asm->newTag(); }
 	/// @returns a new tag identified by name.
-	evmasm::AssemblyItem namedTag(std::string const& _name, size_t _params, size_t _returns, std::optional<uint64_t> _sourceID)
-	{
-		return m_asm->namedTag(_name, _params, _returns, _sourceID);
-	}
+	evmasm::AssemblyItem namedTag(std::string const& _name, size_t _params, size_t _returns, std::optional<uint64_t> _sourceID);
 	/// Adds a subroutine to the code (in the data section) and pushes its size (via a tag)
 	/// on the stack. @returns the pushsub assembly item.
 	evmasm::AssemblyItem addSubroutine(evmasm::AssemblyPointer const& _assembly) { return m_asm->appendSubroutine(_assembly); }
@@ -233,6 +252,8 @@ public:
 	void appendProgramSize() { m_asm->appendProgramSize(); }
 	/// Adds data to the data section, pushes a reference to the stack
 	evmasm::AssemblyItem appendData(bytes const& _data) { return m_asm->append(_data); }
+	/// Adds a table of the code offsets of the given tags to the data section, pushes a reference to the stack
+	evmasm::AssemblyItem appendTagTable(std::vector<evmasm::AssemblyItem> const& _tags) { return m_asm->append(m_asm->newTagTable(_tags)); }
 	/// Appends the address (virtual, will be filled in by linker) of a library.
 	void appendLibraryAddress(std::string const& _identifier) { m_asm->appendLibraryAddress(_identifier); }
 	/// Appends an immutable variable. The value will be filled in by the constructor.
@@ -282,8 +303,14 @@ public:
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendToAuxiliaryData(bytes const& _data) { m_asm->appendToAuxiliaryData(_data); }
 
-	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(translateOptimiserSettings(_settings)); }
+	/// Run optimisation step. If @a _subAssembliesOnly is true, the code of this context itself
+	/// is not optimised, only its sub-assemblies are.
+	void optimise(OptimiserSettings const& _settings, bool _subAssembliesOnly = false)
+	{
+		evmasm::Assembly::OptimiserSettings settings = translateOptimiserSettings(_settings);
+		settings.optimiseSubAssembliesOnly = _subAssembliesOnly;
+		m_asm->optimise(settings);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -316,6 +343,19 @@ private:
 
 	evmasm::Assembly::OptimiserSettings translateOptimiserSettings(OptimiserSettings const& _settings);
 
+	/// @returns true if the contract gives the same answers to all questions asked while compiling @a _compiled.
+	bool answersQueriesOf(CompiledFunctionCache::Function const& _compiled) const;
+	/// Appends the code of @a _compiled, requests the tags it refers to and creates new tags for its own ones.
+	void appendCompiledFunction(CompiledFunctionCache::Function const& _compiled);
+	/// Records the request of a tag that does not belong to the function currently being compiled,
+	/// if it is stored in the cache of compiled functions. @a _nextTag is the identifier the next
+	/// new tag would have received before the request.
+	void recordExternalTag(
+		std::variant<CompiledFunctionCache::EntryLabel, CompiledFunctionCache::LowLevelFunction, CompiledFunctionCache::NamedTag> _request,
+		size_t _nextTag,
+		evmasm::AssemblyItem const& _tag
+	);
+
 	/**
 	 * Helper class that manages function labels and ensures that referenced functions are
 	 * compiled in a specific order.
@@ -395,6 +435,21 @@ private:
 	std::queue<std::tuple<std::string, unsigned, unsigned, std::function<void(CompilerContext&)>>> m_lowLevelFunctionGenerationQueue;
 	/// Flag to check that appendYulUtilityFunctions() was called exactly once
 	bool m_appendYulUtilityFunctionsRan = false;
+	/// Cache of compiled functions shared with other contracts, if any.
+	CompiledFunctionCache* m_compiledFunctionCache = nullptr;
+
+	/// The function currently compiled by compileFunctionIntoCache.
+	struct FunctionRecording
+	{
+		CompiledFunctionCache::Function function;
+		/// Index of the first item appended for the function.
+		size_t firstItem = 0;
+		/// False if the code depends on the contract in a way that is not recorded.
+		bool cacheable = true;
+	};
+	/// Recording of the function currently being compiled, if it is to be stored in the cache.
+	/// The recording is modified by const functions that answer questions about the contract.
+	std::unique_ptr<FunctionRecording> m_functionRecording;
 };
 
 }
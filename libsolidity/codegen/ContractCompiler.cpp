@@ -386,6 +386,67 @@ void ContractCompiler::appendInternalSelector(
 	}
 }
 
+void ContractCompiler::appendSelectorJumpTable(
+	map<FixedHash<4>, evmasm::AssemblyItem const> const& _entryPoints,
+	vector<FixedHash<4>> const& _ids,
+	evmasm::AssemblyItem const& _notFoundTag,
+	size_t _runs
+)
+{
+	// Code for selecting from n functions through a table with m entries:
+	//   push m, dup2, mod, push 4, mul, push <table>, add,
+	//   push 4, swap1, push 0, codecopy, push 0, mload, push 224, shr, jump
+	//   m times: bucket_i: SELECT[size of bucket i]
+	// The lookup costs about 65 gas independently of n, while each comparison costs 22 gas.
+	// Empty buckets directly jump to the tag for not found functions.
+	//
+	// We use the m between n and 2n minimising the sum of the squares of the bucket sizes,
+	// which is proportional to the average number of comparisons per call.
+	size_t buckets = _ids.size();
+	size_t minCost = numeric_limits<size_t>::max();
+	for (size_t candidate = _ids.size(); candidate <= 2 * _ids.size(); ++candidate)
+	{
+		map<size_t, size_t> bucketSizes;
+		for (auto const& id: _ids)
+			++bucketSizes[static_cast<size_t>(FixedHash<4>::Arith(id) % candidate)];
+		size_t cost = 0;
+		for (auto const& bucketSize: bucketSizes)
+			cost += bucketSize.second * bucketSize.second;
+		if (cost < minCost)
+		{
+			minCost = cost;
+			buckets = candidate;
+		}
+	}
+
+	map<size_t, vector<FixedHash<4>>> bucketIDs;
+	for (auto const& id: _ids)
+		bucketIDs[static_cast<size_t>(FixedHash<4>::Arith(id) % buckets)].emplace_back(id);
+	map<size_t, evmasm::AssemblyItem> bucketTags;
+	vector<evmasm::AssemblyItem> table(buckets, _notFoundTag);
+	for (auto const& bucket: bucketIDs)
+	{
+		bucketTags.emplace(bucket.first, m_context.newTag());
+		table[bucket.first] = bucketTags.at(bucket.first);
+	}
+
+	m_context << u256(buckets) << Instruction::DUP2 << Instruction::MOD;
+	m_context << u256(evmasm::Assembly::tagTableEntrySize) << Instruction::MUL;
+	m_context.appendTagTable(table);
+	m_context << Instruction::ADD;
+	// stack: <funhash> <offset of the table entry>
+	m_context << u256(evmasm::Assembly::tagTableEntrySize) << Instruction::SWAP1 << u256(0) << Instruction::CODECOPY;
+	m_context << u256(0) << Instruction::MLOAD;
+	CompilerUtils(m_context).rightShiftNumberOnStack(256 - 8 * evmasm::Assembly::tagTableEntrySize);
+	m_context << Instruction::JUMP;
+
+	for (auto const& bucket: bucketIDs)
+	{
+		m_context << bucketTags.at(bucket.first);
+		appendInternalSelector(_entryPoints, bucket.second, _notFoundTag, _runs);
+	}
+}
+
 namespace
 {
 
@@ -454,7 +515,11 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 			sortedIDs.emplace_back(it.first);
 		}
 		std::sort(sortedIDs.begin(), sortedIDs.end());
-		appendInternalSelector(callDataUnpackerEntryPoints, sortedIDs, notFound, m_optimiserSettings.expectedExecutionsPerDeployment);
+		size_t const jumpTableThreshold = m_optimiserSettings.selectorJumpTableThreshold;
+		if (jumpTableThreshold > 0 && sortedIDs.size() >= jumpTableThreshold)
+			appendSelectorJumpTable(callDataUnpackerEntryPoints, sortedIDs, notFound, m_optimiserSettings.expectedExecutionsPerDeployment);
+		else
+			appendInternalSelector(callDataUnpackerEntryPoints, sortedIDs, notFound, m_optimiserSettings.expectedExecutionsPerDeployment);
 	}
 
 	m_context << notFoundOrReceiveEther;
@@ -1419,7 +1484,8 @@ void ContractCompiler::appendMissingFunctions()
 	while (Declaration const* function = m_context.nextFunctionToCompile())
 	{
 		m_context.setStackOffset(0);
-		function->accept(*this);
+		if (!m_context.appendCompiledFunctionFromCache(*function))
+			m_context.compileFunctionIntoCache(*function, [&]() { function->accept(*this); });
 		solAssert(m_context.nextFunctionToCompile() != function, "Compiled the wrong function?");
 	}
 	m_context.appendMissingLowLevelFunctions();
@@ -1457,7 +1523,7 @@ void ContractCompiler::appendModifierOrFunctionCode()
 			solAssert(lookup == VirtualLookup::Virtual || lookup == VirtualLookup::Static, "");
 			ModifierDefinition const& modifier =
 				lookup == VirtualLookup::Virtual ?
-				referencedModifier.resolveVirtual(m_context.mostDerivedContract()) :
+				m_context.virtualModifier(referencedModifier) :
 				referencedModifier;
 
 			CompilerContext::LocationSetter locationSetter(m_context, modifier);
@@ -95,6 +95,14 @@ private:
 		evmasm::AssemblyItem const& _notFoundTag,
 		size_t _runs
 	);
+	/// Appends the function selector that jumps through a table indexed by the function identifier
+	/// modulo the number of buckets to the comparisons of the identifiers that fall into the bucket.
+	void appendSelectorJumpTable(
+		std::map<util::FixedHash<4>, evmasm::AssemblyItem const> const& _entryPoints,
+		std::vector<util::FixedHash<4>> const& _ids,
+		evmasm::AssemblyItem const& _notFoundTag,
+		size_t _runs
+	);
 	void appendFunctionSelector(ContractDefinition const& _contract);
 	void appendCallValueCheck();
 	void appendReturnValuePacker(TypePointers const& _typeParameters, bool _isLibrary);
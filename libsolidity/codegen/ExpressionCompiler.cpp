@@ -643,10 +643,7 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 						// the runtime entry label to be created at the creation time context.
 						CompilerContext::LocationSetter locationSetter2(m_context, *identifier);
 						solAssert(*identifier->annotation().requiredLookup == VirtualLookup::Virtual, "");
-						utils().pushCombinedFunctionEntryLabel(
-							functionDef->resolveVirtual(m_context.mostDerivedContract()),
-							false
-						);
+						utils().pushCombinedFunctionEntryLabel(m_context.virtualFunction(*functionDef), false);
 						shortcutTaken = true;
 					}
 				}
@@ -2164,7 +2161,7 @@ void ExpressionCompiler::endVisit(Identifier const& _identifier)
 		// constructor context, since this would force the compiler to include unreferenced
 		// internal functions in the runtime context.
 		solAssert(*_identifier.annotation().requiredLookup == VirtualLookup::Virtual, "");
-		utils().pushCombinedFunctionEntryLabel(functionDef->resolveVirtual(m_context.mostDerivedContract()));
+		utils().pushCombinedFunctionEntryLabel(m_context.virtualFunction(*functionDef));
 	}
 	else if (auto variable = dynamic_cast<VariableDeclaration const*>(declaration))
 		appendVariable(*variable, static_cast<Expression const&>(_identifier));
@@ -26,11 +26,32 @@
 #include <libsolutil/Whiskers.h>
 #include <libsolutil/StringUtils.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
+shared_ptr<MultiUseYulFunctionCache::Function const> MultiUseYulFunctionCache::find(string const& _name) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_functions.find(_name);
+	return it != m_functions.end() ? it->second : nullptr;
+}
+
+void MultiUseYulFunctionCache::store(string const& _name, shared_ptr<Function const> _function)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_functions.emplace(_name, move(_function));
+}
+
+size_t MultiUseYulFunctionCache::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_functions.size();
+}
+
 string MultiUseYulFunctionCollector::requestedFunctions()
 {
 	string result = move(m_code);
@@ -41,15 +62,7 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
-	if (!m_requestedFunctions.count(_name))
-	{
-		m_requestedFunctions.insert(_name);
-		string fun = _creator();
-		solAssert(!fun.empty(), "");
-		solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
-		m_code += move(fun);
-	}
-	return _name;
+	return createFunction(_name, false, _creator);
 }
 
 string MultiUseYulFunctionCollector::createFunction(
@@ -58,15 +71,118 @@ string MultiUseYulFunctionCollector::createFunction(
 )
 {
 	solAssert(!_name.empty(), "");
-	if (!m_requestedFunctions.count(_name))
+	return createFunction(_name, false, functionAssembler(_name, _creator));
+}
+
+string MultiUseYulFunctionCollector::createSharedFunction(string const& _name, function<string ()> const& _creator)
+{
+	return createFunction(_name, true, _creator);
+}
+
+string MultiUseYulFunctionCollector::createSharedFunction(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	solAssert(!_name.empty(), "");
+	return createFunction(_name, true, functionAssembler(_name, _creator));
+}
+
+string MultiUseYulFunctionCollector::createFunction(string const& _name, bool _shared, function<string()> const& _creator)
+{
+	if (!m_dependencies.empty())
+	{
+		m_dependencies.back().names.push_back(_name);
+		// Functions that depend on the contract cannot be shared, and neither can the functions requesting them.
+		if (!_shared)
+			for (Dependencies& dependencies: m_dependencies)
+				dependencies.shareable = false;
+	}
+	if (m_requestedFunctions.count(_name))
+		return _name;
+
+	bool const useCache = _shared && m_cache;
+	if (useCache)
+		if (auto cachedFunction = m_cache->find(_name))
+		{
+			addCachedFunction(_name, *cachedFunction);
+			return _name;
+		}
+
+	m_requestedFunctions.insert(_name);
+	if (useCache)
+		m_dependencies.emplace_back();
+	string fun = _creator();
+	solAssert(!fun.empty(), "");
+	solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
+	if (useCache)
 	{
-		m_requestedFunctions.insert(_name);
+		Dependencies dependencies = move(m_dependencies.back());
+		m_dependencies.pop_back();
+		// Only store functions whose dependencies can be taken from the cache as well.
+		if (dependencies.shareable && all_of(
+			dependencies.names.begin(),
+			dependencies.names.end(),
+			[&](string const& _dependency) { return _dependency == _name || m_cache->find(_dependency); }
+		))
+			m_cache->store(_name, make_shared<MultiUseYulFunctionCache::Function const>(
+				MultiUseYulFunctionCache::Function{fun, move(dependencies.names)}
+			));
+	}
+	m_code += move(fun);
+	return _name;
+}
+
+void MultiUseYulFunctionCollector::addCachedFunction(string const& _name, MultiUseYulFunctionCache::Function const& _function)
+{
+	// Reproduces the order in which the functions are added when they are created.
+	m_requestedFunctions.insert(_name);
+	for (string const& dependency: _function.dependencies)
+		if (!m_requestedFunctions.count(dependency))
+		{
+			auto cachedDependency = m_cache->find(dependency);
+			solAssert(cachedDependency, "");
+			addCachedFunction(dependency, *cachedDependency);
+		}
+	m_code += _function.code;
+}
+
+optional<vector<string>> MultiUseYulFunctionCollector::stopRecording()
+{
+	Dependencies recording = move(m_dependencies.back());
+	m_dependencies.pop_back();
+	if (!m_cache || !recording.shareable)
+		return nullopt;
+	for (string const& name: recording.names)
+		if (!m_cache->find(name))
+			return nullopt;
+	return move(recording.names);
+}
+
+void MultiUseYulFunctionCollector::addCachedFunctions(vector<string> const& _names)
+{
+	solAssert(m_cache, "");
+	for (string const& name: _names)
+		if (!m_requestedFunctions.count(name))
+		{
+			auto cachedFunction = m_cache->find(name);
+			solAssert(cachedFunction, "");
+			addCachedFunction(name, *cachedFunction);
+		}
+}
+
+function<string()> MultiUseYulFunctionCollector::functionAssembler(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	return [&_name, &_creator]() {
 		vector<string> arguments;
 		vector<string> returnParameters;
 		string body = _creator(arguments, returnParameters);
 		solAssert(!body.empty(), "");
 
-		m_code += Whiskers(R"(
+		return Whiskers(R"(
 			function <functionName>(<args>)<?+retParams> -> <retParams></+retParams> {
 				<body>
 			}
@@ -76,6 +192,5 @@ string MultiUseYulFunctionCollector::createFunction(
 		("retParams", joinHumanReadable(returnParameters))
 		("body", body)
 		.render();
-	}
-	return _name;
+	};
 }
@@ -24,12 +24,41 @@
 
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <set>
+#include <vector>
 
 namespace solidity::frontend
 {
 
+/**
+ * Yul functions created by MultiUseYulFunctionCollector::createSharedFunction, shared between
+ * the collectors of all contracts of a compilation. Can be used from several threads.
+ */
+class MultiUseYulFunctionCache
+{
+public:
+	struct Function
+	{
+		std::string code;
+		/// Names of the functions requested while creating the function, in the order of the requests.
+		std::vector<std::string> dependencies;
+	};
+
+	/// @returns the function called @a _name or nullptr if it is not in the cache.
+	std::shared_ptr<Function const> find(std::string const& _name) const;
+	/// Stores @a _function as @a _name unless there already is a function of that name.
+	void store(std::string const& _name, std::shared_ptr<Function const> _function);
+	size_t size() const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::shared_ptr<Function const>> m_functions;
+};
+
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
@@ -47,6 +76,30 @@ public:
 		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
 	);
 
+	/// Same as createFunction, but for functions whose code only depends on @a _name and on settings
+	/// that are the same for the whole compilation. If a cache is set, the function is taken from
+	/// it together with the functions it requests if another collector created it before, and
+	/// stored in it otherwise.
+	std::string createSharedFunction(std::string const& _name, std::function<std::string()> const& _creator);
+
+	std::string createSharedFunction(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
+	/// Sets the cache used by createSharedFunction. It has to outlive this object.
+	void setCache(MultiUseYulFunctionCache* _cache) { m_cache = _cache; }
+
+	/// Starts recording the names of the functions requested from now on, except for the ones
+	/// requested while creating other functions.
+	void startRecording() { m_dependencies.emplace_back(); }
+	/// Stops the recording started by the last call to startRecording.
+	/// @returns the recorded names in the order of the requests if all of the functions are in the
+	/// cache, i.e. can be added to other collectors using addCachedFunctions.
+	std::optional<std::vector<std::string>> stopRecording();
+	/// Adds the cached functions @a _names and the functions they depend on that were not created yet.
+	void addCachedFunctions(std::vector<std::string> const& _names);
+
 	/// @returns concatenation of all generated functions in the order in which they were
 	/// generated.
 	/// Clears the internal list, i.e. calling it again will result in an
@@ -57,8 +110,30 @@ public:
 	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
 
 private:
+	/// The functions requested while creating a shared function.
+	struct Dependencies
+	{
+		std::vector<std::string> names;
+		/// False if one of the requested functions is not shared.
+		bool shareable = true;
+	};
+
+	std::string createFunction(std::string const& _name, bool _shared, std::function<std::string()> const& _creator);
+	/// Adds @a _function, called @a _name, and the functions it depends on that were not created yet.
+	void addCachedFunction(std::string const& _name, MultiUseYulFunctionCache::Function const& _function);
+	/// @returns a creator that assembles a function from the body, arguments and return parameters
+	/// provided by @a _creator.
+	static std::function<std::string()> functionAssembler(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
 	std::set<std::string> m_requestedFunctions;
 	std::string m_code;
+	MultiUseYulFunctionCache* m_cache = nullptr;
+	/// One entry for each shared function that is currently being created and will be cached
+	/// and for each recording.
+	std::vector<Dependencies> m_dependencies;
 };
 
 }
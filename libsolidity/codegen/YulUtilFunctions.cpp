@@ -38,7 +38,7 @@ using namespace solidity::frontend;
 string YulUtilFunctions::identityFunction()
 {
 	string functionName = "identity";
-	return m_functionCollector.createFunction("identity", [&](vector<string>& _args, vector<string>& _rets) {
+	return m_functionCollector.createSharedFunction("identity", [&](vector<string>& _args, vector<string>& _rets) {
 		_args.push_back("value");
 		_rets.push_back("ret");
 		return "ret := value";
@@ -48,7 +48,7 @@ string YulUtilFunctions::identityFunction()
 string YulUtilFunctions::combineExternalFunctionIdFunction()
 {
 	string functionName = "combine_external_function_id";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(addr, selector) -> combined {
 				combined := <shl64>(or(<shl32>(addr), and(selector, 0xffffffff)))
@@ -64,7 +64,7 @@ string YulUtilFunctions::combineExternalFunctionIdFunction()
 string YulUtilFunctions::splitExternalFunctionIdFunction()
 {
 	string functionName = "split_external_function_id";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(combined) -> addr, selector {
 				combined := <shr64>(combined)
@@ -82,7 +82,7 @@ string YulUtilFunctions::splitExternalFunctionIdFunction()
 string YulUtilFunctions::copyToMemoryFunction(bool _fromCalldata)
 {
 	string functionName = "copy_" + string(_fromCalldata ? "calldata" : "memory") + "_to_memory";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (_fromCalldata)
 		{
 			return Whiskers(R"(
@@ -121,7 +121,7 @@ string YulUtilFunctions::copyLiteralToMemoryFunction(string const& _literal)
 {
 	string functionName = "copy_literal_to_memory_" + util::toHex(util::keccak256(_literal).asBytes());
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>() -> memPtr {
 				memPtr := <arrayAllocationFunction>(<size>)
@@ -140,7 +140,7 @@ string YulUtilFunctions::storeLiteralInMemoryFunction(string const& _literal)
 {
 	string functionName = "store_literal_in_memory_" + util::toHex(util::keccak256(_literal).asBytes());
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		size_t words = (_literal.length() + 31) / 32;
 		vector<map<string, string>> wordParams(words);
 		for (size_t i = 0; i < words; ++i)
@@ -166,7 +166,7 @@ string YulUtilFunctions::copyLiteralToStorageFunction(string const& _literal)
 {
 	string functionName = "copy_literal_to_storage_" + util::toHex(util::keccak256(_literal).asBytes());
 
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return m_functionCollector.createSharedFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"slot"};
 
 		if (_literal.size() >= 32)
@@ -218,7 +218,7 @@ string YulUtilFunctions::requireOrAssertFunction(bool _assert, Type const* _mess
 
 	solAssert(!_assert || !_messageType, "Asserts can't have messages!");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (!_messageType)
 			return Whiskers(R"(
 				function <functionName>(condition) {
@@ -264,7 +264,7 @@ string YulUtilFunctions::requireOrAssertFunction(bool _assert, Type const* _mess
 string YulUtilFunctions::leftAlignFunction(Type const& _type)
 {
 	string functionName = string("leftAlign_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) -> aligned {
 				<body>
@@ -326,7 +326,7 @@ string YulUtilFunctions::shiftLeftFunction(size_t _numBits)
 	solAssert(_numBits < 256, "");
 
 	string functionName = "shift_left_" + to_string(_numBits);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value) -> newValue {
@@ -349,7 +349,7 @@ string YulUtilFunctions::shiftLeftFunction(size_t _numBits)
 string YulUtilFunctions::shiftLeftFunctionDynamic()
 {
 	string functionName = "shift_left_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(bits, value) -> newValue {
@@ -375,7 +375,7 @@ string YulUtilFunctions::shiftRightFunction(size_t _numBits)
 	// the opcodes SAR and SDIV behave differently with regards to rounding!
 
 	string functionName = "shift_right_" + to_string(_numBits) + "_unsigned";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value) -> newValue {
@@ -398,7 +398,7 @@ string YulUtilFunctions::shiftRightFunction(size_t _numBits)
 string YulUtilFunctions::shiftRightFunctionDynamic()
 {
 	string const functionName = "shift_right_unsigned_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(bits, value) -> newValue {
@@ -419,7 +419,7 @@ string YulUtilFunctions::shiftRightFunctionDynamic()
 string YulUtilFunctions::shiftRightSignedFunctionDynamic()
 {
 	string const functionName = "shift_right_signed_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(bits, value) -> result {
@@ -450,7 +450,7 @@ string YulUtilFunctions::typedShiftLeftFunction(Type const& _type, Type const& _
 	solAssert(_amountType.category() == Type::Category::Integer, "");
 	solAssert(!dynamic_cast<IntegerType const&>(_amountType).isSigned(), "");
 	string const functionName = "shift_left_" + _type.identifier() + "_" + _amountType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, bits) -> result {
@@ -476,7 +476,7 @@ string YulUtilFunctions::typedShiftRightFunction(Type const& _type, Type const&
 	bool valueSigned = integerType && integerType->isSigned();
 
 	string const functionName = "shift_right_" + _type.identifier() + "_" + _amountType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, bits) -> result {
@@ -499,7 +499,7 @@ string YulUtilFunctions::updateByteSliceFunction(size_t _numBytes, size_t _shift
 	size_t numBits = _numBytes * 8;
 	size_t shiftBits = _shiftBytes * 8;
 	string functionName = "update_byte_slice_" + to_string(_numBytes) + "_shift_" + to_string(_shiftBytes);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, toInsert) -> result {
@@ -521,7 +521,7 @@ string YulUtilFunctions::updateByteSliceFunctionDynamic(size_t _numBytes)
 	solAssert(_numBytes <= 32, "");
 	size_t numBits = _numBytes * 8;
 	string functionName = "update_byte_slice_dynamic" + to_string(_numBytes);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value, shiftBytes, toInsert) -> result {
@@ -542,7 +542,7 @@ string YulUtilFunctions::updateByteSliceFunctionDynamic(size_t _numBytes)
 string YulUtilFunctions::maskBytesFunctionDynamic()
 {
 	string functionName = "mask_bytes_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data, bytes) -> result {
 				let mask := not(<shr>(mul(8, bytes), not(0)))
@@ -558,7 +558,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunction(size_t _bytes)
 {
 	string functionName = "mask_lower_order_bytes_" + to_string(_bytes);
 	solAssert(_bytes <= 32, "");
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data) -> result {
 				result := and(data, <mask>)
@@ -572,7 +572,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunction(size_t _bytes)
 string YulUtilFunctions::maskLowerOrderBytesFunctionDynamic()
 {
 	string functionName = "mask_lower_order_bytes_dynamic";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data, bytes) -> result {
 				let mask := not(<shl>(mul(8, bytes), not(0)))
@@ -587,7 +587,7 @@ string YulUtilFunctions::maskLowerOrderBytesFunctionDynamic()
 string YulUtilFunctions::roundUpFunction()
 {
 	string functionName = "round_up_to_mul_of_32";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(value) -> result {
@@ -601,7 +601,7 @@ string YulUtilFunctions::roundUpFunction()
 
 string YulUtilFunctions::divide32CeilFunction()
 {
-	return m_functionCollector.createFunction(
+	return m_functionCollector.createSharedFunction(
 		"divide_by_32_ceil",
 		[&](vector<string>& _args, vector<string>& _ret) {
 			_args = {"value"};
@@ -617,7 +617,7 @@ string YulUtilFunctions::overflowCheckedIntAddFunction(IntegerType const& _type)
 	// TODO: Consider to add a special case for unsigned 256-bit integers
 	//       and use the following instead:
 	//       sum := add(x, y) if lt(sum, x) { <panic>() }
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> sum {
@@ -648,7 +648,7 @@ string YulUtilFunctions::overflowCheckedIntAddFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntAddFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_add_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> sum {
@@ -664,7 +664,7 @@ string YulUtilFunctions::wrappingIntAddFunction(IntegerType const& _type)
 string YulUtilFunctions::overflowCheckedIntMulFunction(IntegerType const& _type)
 {
 	string functionName = "checked_mul_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			// Multiplication by zero could be treated separately and directly return zero.
 			Whiskers(R"(
@@ -700,7 +700,7 @@ string YulUtilFunctions::overflowCheckedIntMulFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntMulFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_mul_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> product {
@@ -716,7 +716,7 @@ string YulUtilFunctions::wrappingIntMulFunction(IntegerType const& _type)
 string YulUtilFunctions::overflowCheckedIntDivFunction(IntegerType const& _type)
 {
 	string functionName = "checked_div_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> r {
@@ -746,7 +746,7 @@ string YulUtilFunctions::overflowCheckedIntDivFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntDivFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_div_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> r {
@@ -767,7 +767,7 @@ string YulUtilFunctions::wrappingIntDivFunction(IntegerType const& _type)
 string YulUtilFunctions::intModFunction(IntegerType const& _type)
 {
 	string functionName = "mod_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> r {
@@ -788,7 +788,7 @@ string YulUtilFunctions::intModFunction(IntegerType const& _type)
 string YulUtilFunctions::overflowCheckedIntSubFunction(IntegerType const& _type)
 {
 	string functionName = "checked_sub_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> diff {
@@ -818,7 +818,7 @@ string YulUtilFunctions::overflowCheckedIntSubFunction(IntegerType const& _type)
 string YulUtilFunctions::wrappingIntSubFunction(IntegerType const& _type)
 {
 	string functionName = "wrapping_sub_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return
 			Whiskers(R"(
 			function <functionName>(x, y) -> diff {
@@ -839,7 +839,7 @@ string YulUtilFunctions::overflowCheckedIntExpFunction(
 	solAssert(!_exponentType.isSigned(), "");
 
 	string functionName = "checked_exp_" + _type.identifier() + "_" + _exponentType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent) -> power {
@@ -876,7 +876,7 @@ string YulUtilFunctions::overflowCheckedIntLiteralExpFunction(
 
 	string functionName = "checked_exp_" + _baseType.richIdentifier() + "_" + _exponentType.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]()
+	return m_functionCollector.createSharedFunction(functionName, [&]()
 	{
 		// Converts a bigint number into u256 (negative numbers represented in two's complement form.)
 		// We assume that `_v` fits in 256 bits.
@@ -990,7 +990,7 @@ string YulUtilFunctions::overflowCheckedUnsignedExpFunction()
 	solAssert(pow(bigint(306), 32) >= pow(bigint(2), 256), "");
 
 	string functionName = "checked_exp_unsigned";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent, max) -> power {
@@ -1038,7 +1038,7 @@ string YulUtilFunctions::overflowCheckedUnsignedExpFunction()
 string YulUtilFunctions::overflowCheckedSignedExpFunction()
 {
 	string functionName = "checked_exp_signed";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent, min, max) -> power {
@@ -1094,7 +1094,7 @@ string YulUtilFunctions::overflowCheckedExpLoopFunction()
 	// This function does not include the final multiplication.
 
 	string functionName = "checked_exp_helper";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(_power, _base, exponent, max) -> power, base {
@@ -1133,7 +1133,7 @@ string YulUtilFunctions::wrappingIntExpFunction(
 	solAssert(!_exponentType.isSigned(), "");
 
 	string functionName = "wrapping_exp_" + _type.identifier() + "_" + _exponentType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return
 			Whiskers(R"(
 			function <functionName>(base, exponent) -> power {
@@ -1152,7 +1152,7 @@ string YulUtilFunctions::wrappingIntExpFunction(
 string YulUtilFunctions::arrayLengthFunction(ArrayType const& _type)
 {
 	string functionName = "array_length_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers w(R"(
 			function <functionName>(value<?dynamic><?calldata>, len</calldata></dynamic>) -> length {
 				<?dynamic>
@@ -1194,7 +1194,7 @@ string YulUtilFunctions::arrayLengthFunction(ArrayType const& _type)
 string YulUtilFunctions::extractByteArrayLengthFunction()
 {
 	string functionName = "extract_byte_array_length";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers w(R"(
 			function <functionName>(data) -> length {
 				length := div(data, 2)
@@ -1223,7 +1223,7 @@ std::string YulUtilFunctions::resizeArrayFunction(ArrayType const& _type)
 		return resizeDynamicByteArrayFunction(_type);
 
 	string functionName = "resize_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(array, newLen) {
 				if gt(newLen, <maxArrayLength>) {
@@ -1262,7 +1262,7 @@ string YulUtilFunctions::cleanUpStorageArrayEndFunction(ArrayType const& _type)
 	solUnimplementedAssert(_type.baseType()->storageBytes() <= 32);
 
 	string functionName = "cleanup_storage_array_end_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return m_functionCollector.createSharedFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"array", "len", "startIndex"};
 		return Whiskers(R"(
 			if lt(startIndex, len) {
@@ -1295,7 +1295,7 @@ string YulUtilFunctions::cleanUpStorageArrayEndFunction(ArrayType const& _type)
 string YulUtilFunctions::resizeDynamicByteArrayFunction(ArrayType const& _type)
 {
 	string functionName = "resize_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return m_functionCollector.createSharedFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"array", "newLen"};
 		return Whiskers(R"(
 			let data := sload(array)
@@ -1322,7 +1322,7 @@ string YulUtilFunctions::cleanUpDynamicByteArrayEndSlotsFunction(ArrayType const
 	solAssert(_type.isDynamicallySized(), "");
 
 	string functionName = "clean_up_bytearray_end_slots_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return m_functionCollector.createSharedFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"array", "len", "startIndex"};
 		return Whiskers(R"(
 			if gt(len, 31) {
@@ -1343,7 +1343,7 @@ string YulUtilFunctions::cleanUpDynamicByteArrayEndSlotsFunction(ArrayType const
 string YulUtilFunctions::decreaseByteArraySizeFunction(ArrayType const& _type)
 {
 	string functionName = "byte_array_decrease_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, data, oldLen, newLen) {
 				switch lt(newLen, 32)
@@ -1386,7 +1386,7 @@ string YulUtilFunctions::decreaseByteArraySizeFunction(ArrayType const& _type)
 string YulUtilFunctions::increaseByteArraySizeFunction(ArrayType const& _type)
 {
 	string functionName = "byte_array_increase_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&](vector<string>& _args, vector<string>&) {
+	return m_functionCollector.createSharedFunction(functionName, [&](vector<string>& _args, vector<string>&) {
 		_args = {"array", "data", "oldLen", "newLen"};
 		return Whiskers(R"(
 			if gt(newLen, <maxArrayLength>) { <panic>() }
@@ -1421,7 +1421,7 @@ string YulUtilFunctions::increaseByteArraySizeFunction(ArrayType const& _type)
 string YulUtilFunctions::byteArrayTransitLongToShortFunction(ArrayType const& _type)
 {
 	string functionName = "transit_byte_array_long_to_short_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, len) {
 				// we need to copy elements from old array to new
@@ -1441,7 +1441,7 @@ string YulUtilFunctions::byteArrayTransitLongToShortFunction(ArrayType const& _t
 string YulUtilFunctions::shortByteArrayEncodeUsedAreaSetLengthFunction()
 {
 	string functionName = "extract_used_part_and_set_length_of_short_byte_array";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(data, len) -> used {
 				// we want to save only elements that are part of the array after resizing
@@ -1457,7 +1457,7 @@ string YulUtilFunctions::shortByteArrayEncodeUsedAreaSetLengthFunction()
 
 string YulUtilFunctions::longByteArrayStorageIndexAccessNoCheckFunction()
 {
-	return m_functionCollector.createFunction(
+	return m_functionCollector.createSharedFunction(
 		"long_byte_array_index_access_no_checks",
 		[&](vector<string>& _args, vector<string>& _returnParams) {
 			_args = {"array", "index"};
@@ -1482,7 +1482,7 @@ string YulUtilFunctions::storageArrayPopFunction(ArrayType const& _type)
 		return storageByteArrayPopFunction(_type);
 
 	string functionName = "array_pop_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array) {
 				let oldLen := <fetchLength>(array)
@@ -1511,7 +1511,7 @@ string YulUtilFunctions::storageByteArrayPopFunction(ArrayType const& _type)
 	solAssert(_type.isByteArray(), "");
 
 	string functionName = "byte_array_pop_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array) {
 				let data := sload(array)
@@ -1562,7 +1562,7 @@ string YulUtilFunctions::storageArrayPushFunction(ArrayType const& _type, Type c
 		_fromType->identifier() +
 		"_to_" +
 		_type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array <values>) {
 				<?isByteArray>
@@ -1626,7 +1626,7 @@ string YulUtilFunctions::storageArrayPushZeroFunction(ArrayType const& _type)
 	solUnimplementedAssert(_type.baseType()->storageBytes() <= 32, "Base type is not yet implemented.");
 
 	string functionName = "array_push_zero_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array) -> slot, offset {
 				<?isBytes>
@@ -1655,7 +1655,7 @@ string YulUtilFunctions::storageArrayPushZeroFunction(ArrayType const& _type)
 string YulUtilFunctions::partialClearStorageSlotFunction()
 {
 	string functionName = "partial_clear_storage_slot";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 		function <functionName>(slot, offset) {
 			let mask := <shr>(mul(8, sub(32, offset)), <ones>)
@@ -1676,19 +1676,26 @@ string YulUtilFunctions::clearStorageRangeFunction(Type const& _type)
 
 	string functionName = "clear_storage_range_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
-		return Whiskers(R"(
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
+		Whiskers templ(R"(
 			function <functionName>(start, end) {
 				for {} lt(start, end) { start := add(start, <increment>) }
 				{
-					<setToZero>(start, 0)
+					<?valueType>
+						sstore(start, 0)
+					<!valueType>
+						<setToZero>(start, 0)
+					</valueType>
 				}
 			}
-		)")
-		("functionName", functionName)
-		("setToZero", storageSetToZeroFunction(_type.storageBytes() < 32 ? *TypeProvider::uint256() : _type))
-		("increment", _type.storageSize().str())
-		.render();
+		)");
+		templ("functionName", functionName);
+		// Value types occupy at most one slot, so each slot in the range can be cleared as a whole.
+		templ("valueType", _type.isValueType());
+		if (!_type.isValueType())
+			templ("setToZero", storageSetToZeroFunction(_type.storageBytes() < 32 ? *TypeProvider::uint256() : _type));
+		templ("increment", _type.storageSize().str());
+		return templ.render();
 	});
 }
 
@@ -1707,18 +1714,37 @@ string YulUtilFunctions::clearStorageArrayFunction(ArrayType const& _type)
 
 	string functionName = "clear_storage_array_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
+		// Small static arrays of value types are cleared slot by slot without a loop,
+		// using the same limit as the legacy code generator.
+		bool unrolled =
+			!_type.isDynamicallySized() &&
+			_type.length() > 0 &&
+			_type.baseType()->isValueType() &&
+			_type.storageSize() <= 5;
+		vector<map<string, string>> slotOffsets;
+		if (unrolled)
+			for (u256 offset = 0; offset < _type.storageSize(); ++offset)
+				slotOffsets.emplace_back(map<string, string>{{"offset", offset.str()}});
 		return Whiskers(R"(
 			function <functionName>(slot) {
 				<?dynamic>
 					<resizeArray>(slot, 0)
 				<!dynamic>
-					<?+clearRange><clearRange>(slot, add(slot, <lenToSize>(<len>)))</+clearRange>
+					<?unrolled>
+						<#slotOffset>
+							sstore(add(slot, <offset>), 0)
+						</slotOffset>
+					<!unrolled>
+						<?+clearRange><clearRange>(slot, add(slot, <lenToSize>(<len>)))</+clearRange>
+					</unrolled>
 				</dynamic>
 			}
 		)")
 		("functionName", functionName)
 		("dynamic", _type.isDynamicallySized())
+		("unrolled", unrolled)
+		("slotOffset", slotOffsets)
 		("resizeArray", _type.isDynamicallySized() ? resizeArrayFunction(_type) : "")
 		(
 			"clearRange",
@@ -1738,7 +1764,7 @@ string YulUtilFunctions::clearStorageStructFunction(StructType const& _type)
 
 	string functionName = "clear_struct_storage_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		MemberList::MemberMap structMembers = _type.nativeMembers(nullptr);
 		vector<map<string, string>> memberSetValues;
 
@@ -1798,9 +1824,16 @@ string YulUtilFunctions::copyArrayToStorageFunction(ArrayType const& _fromType,
 		return copyByteArrayToStorageFunction(_fromType, _toType);
 	if (_fromType.dataStoredIn(DataLocation::Storage) && _toType.baseType()->isValueType())
 		return copyValueArrayStorageToStorageFunction(_fromType, _toType);
+	if (
+		!_fromType.dataStoredIn(DataLocation::Storage) &&
+		_fromType.baseType()->isValueType() &&
+		_fromType.baseType()->sizeOnStack() == 1 &&
+		_toType.storageStride() <= 16
+	)
+		return copyValueArrayToPackedStorageFunction(_fromType, _toType);
 
 	string functionName = "copy_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
-	return m_functionCollector.createFunction(functionName, [&](){
+	return m_functionCollector.createSharedFunction(functionName, [&](){
 		Whiskers templ(R"(
 			function <functionName>(slot, value<?isFromDynamicCalldata>, len</isFromDynamicCalldata>) {
 				<?fromStorage> if eq(slot, value) { leave } </fromStorage>
@@ -1905,7 +1938,7 @@ string YulUtilFunctions::copyByteArrayToStorageFunction(ArrayType const& _fromTy
 	solAssert(_toType.isByteArray(), "");
 
 	string functionName = "copy_byte_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
-	return m_functionCollector.createFunction(functionName, [&](){
+	return m_functionCollector.createSharedFunction(functionName, [&](){
 		Whiskers templ(R"(
 			function <functionName>(slot, src<?fromCalldata>, len</fromCalldata>) {
 				<?fromStorage> if eq(slot, src) { leave } </fromStorage>
@@ -1973,6 +2006,70 @@ string YulUtilFunctions::copyByteArrayToStorageFunction(ArrayType const& _fromTy
 }
 
 
+string YulUtilFunctions::copyValueArrayToPackedStorageFunction(ArrayType const& _fromType, ArrayType const& _toType)
+{
+	solAssert(_fromType.baseType()->isValueType(), "");
+	solAssert(_fromType.baseType()->sizeOnStack() == 1, "");
+	solAssert(_fromType.baseType()->isImplicitlyConvertibleTo(*_toType.baseType()), "");
+	solAssert(!_fromType.isByteArray(), "");
+	solAssert(!_fromType.dataStoredIn(DataLocation::Storage), "");
+	solAssert(_toType.dataStoredIn(DataLocation::Storage), "");
+	solAssert(_toType.storageStride() <= 16, "");
+
+	string functionName = "copy_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
+	return m_functionCollector.createSharedFunction(functionName, [&](){
+		Whiskers templ(R"(
+			function <functionName>(slot, value<?isFromDynamicCalldata>, len</isFromDynamicCalldata>) {
+				let length := <arrayLength>(value<?isFromDynamicCalldata>, len</isFromDynamicCalldata>)
+
+				<resizeArray>(slot, length)
+
+				let srcPtr := <srcDataLocation>(value)
+				let dstSlot := <dstDataLocation>(slot)
+
+				let fullSlots := div(length, <itemsPerSlot>)
+
+				for { let i := 0 } lt(i, fullSlots) { i := add(i, 1) } {
+					let dstSlotValue := 0
+					for { let j := 0 } lt(j, <itemsPerSlot>) { j := add(j, 1) } {
+						let itemValue := <prepareStore>(<convert>(<readFromCalldataOrMemory>(srcPtr)))
+						dstSlotValue := <updateByteSlice>(dstSlotValue, mul(<dstStride>, j), itemValue)
+						srcPtr := add(srcPtr, <srcStride>)
+					}
+					sstore(add(dstSlot, i), dstSlotValue)
+				}
+
+				let spill := sub(length, mul(fullSlots, <itemsPerSlot>))
+				if gt(spill, 0) {
+					// The remaining bytes of the last slot are unused and therefore zero.
+					let dstSlotValue := 0
+					for { let j := 0 } lt(j, spill) { j := add(j, 1) } {
+						let itemValue := <prepareStore>(<convert>(<readFromCalldataOrMemory>(srcPtr)))
+						dstSlotValue := <updateByteSlice>(dstSlotValue, mul(<dstStride>, j), itemValue)
+						srcPtr := add(srcPtr, <srcStride>)
+					}
+					sstore(add(dstSlot, fullSlots), dstSlotValue)
+				}
+			}
+		)");
+		bool fromCalldata = _fromType.dataStoredIn(DataLocation::CallData);
+		templ("functionName", functionName);
+		templ("isFromDynamicCalldata", _fromType.isDynamicallySized() && fromCalldata);
+		templ("arrayLength", arrayLengthFunction(_fromType));
+		templ("resizeArray", resizeArrayFunction(_toType));
+		templ("srcDataLocation", arrayDataAreaFunction(_fromType));
+		templ("dstDataLocation", arrayDataAreaFunction(_toType));
+		templ("itemsPerSlot", to_string(32 / _toType.storageStride()));
+		templ("readFromCalldataOrMemory", readFromMemoryOrCalldata(*_fromType.baseType(), fromCalldata));
+		templ("convert", conversionFunction(*_fromType.baseType(), *_toType.baseType()));
+		templ("prepareStore", prepareStoreFunction(*_toType.baseType()));
+		templ("updateByteSlice", updateByteSliceFunctionDynamic(_toType.storageStride()));
+		templ("dstStride", to_string(_toType.storageStride()));
+		templ("srcStride", to_string(fromCalldata ? _fromType.calldataStride() : _fromType.memoryStride()));
+		return templ.render();
+	});
+}
+
 string YulUtilFunctions::copyValueArrayStorageToStorageFunction(ArrayType const& _fromType, ArrayType const& _toType)
 {
 	solAssert(_fromType.baseType()->isValueType(), "");
@@ -1988,7 +2085,7 @@ string YulUtilFunctions::copyValueArrayStorageToStorageFunction(ArrayType const&
 	solAssert(_toType.storageStride() <= 32, "");
 
 	string functionName = "copy_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
-	return m_functionCollector.createFunction(functionName, [&](){
+	return m_functionCollector.createSharedFunction(functionName, [&](){
 		Whiskers templ(R"(
 			function <functionName>(dst, src) {
 				if eq(dst, src) { leave }
@@ -2107,7 +2204,7 @@ string YulUtilFunctions::copyValueArrayStorageToStorageFunction(ArrayType const&
 string YulUtilFunctions::arrayConvertLengthToSize(ArrayType const& _type)
 {
 	string functionName = "array_convert_length_to_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Type const& baseType = *_type.baseType();
 
 		switch (_type.location())
@@ -2161,7 +2258,7 @@ string YulUtilFunctions::arrayAllocationSizeFunction(ArrayType const& _type)
 {
 	solAssert(_type.dataStoredIn(DataLocation::Memory), "");
 	string functionName = "array_allocation_size_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers w(R"(
 			function <functionName>(length) -> size {
 				// Make sure we can allocate memory without overflow
@@ -2189,7 +2286,7 @@ string YulUtilFunctions::arrayAllocationSizeFunction(ArrayType const& _type)
 string YulUtilFunctions::arrayDataAreaFunction(ArrayType const& _type)
 {
 	string functionName = "array_dataslot_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		// No special processing for calldata arrays, because they are stored as
 		// offset of the data area and length on the stack, so the offset already
 		// points to the data area.
@@ -2220,7 +2317,7 @@ string YulUtilFunctions::arrayDataAreaFunction(ArrayType const& _type)
 string YulUtilFunctions::storageArrayIndexAccessFunction(ArrayType const& _type)
 {
 	string functionName = "storage_array_index_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(array, index) -> slot, offset {
 				let arrayLength := <arrayLen>(array)
@@ -2265,7 +2362,7 @@ string YulUtilFunctions::storageArrayIndexAccessFunction(ArrayType const& _type)
 string YulUtilFunctions::memoryArrayIndexAccessFunction(ArrayType const& _type)
 {
 	string functionName = "memory_array_index_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(baseRef, index) -> addr {
 				if iszero(lt(index, <arrayLen>(baseRef))) {
@@ -2292,7 +2389,7 @@ string YulUtilFunctions::calldataArrayIndexAccessFunction(ArrayType const& _type
 {
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	string functionName = "calldata_array_index_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(base_ref<?dynamicallySized>, length</dynamicallySized>, index) -> addr<?dynamicallySizedBase>, len</dynamicallySizedBase> {
 				if iszero(lt(index, <?dynamicallySized>length<!dynamicallySized><arrayLen></dynamicallySized>)) { <panic>() }
@@ -2319,7 +2416,7 @@ string YulUtilFunctions::calldataArrayIndexRangeAccess(ArrayType const& _type)
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	solAssert(_type.isDynamicallySized(), "");
 	string functionName = "calldata_array_index_range_access_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(offset, length, startIndex, endIndex) -> offsetOut, lengthOut {
 				if gt(startIndex, endIndex) { <revertSliceStartAfterEnd>() }
@@ -2341,7 +2438,7 @@ string YulUtilFunctions::accessCalldataTailFunction(Type const& _type)
 	solAssert(_type.isDynamicallyEncoded(), "");
 	solAssert(_type.dataStoredIn(DataLocation::CallData), "");
 	string functionName = "access_calldata_tail_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(base_ref, ptr_to_tail) -> addr<?dynamicallySized>, length</dynamicallySized> {
 				let rel_offset_of_tail := calldataload(ptr_to_tail)
@@ -2372,7 +2469,7 @@ string YulUtilFunctions::nextArrayElementFunction(ArrayType const& _type)
 	if (_type.dataStoredIn(DataLocation::Storage))
 		solAssert(_type.baseType()->storageBytes() > 16, "");
 	string functionName = "array_nextElement_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(ptr) -> next {
 				next := add(ptr, <advance>)
@@ -2413,7 +2510,7 @@ string YulUtilFunctions::copyArrayFromStorageToMemoryFunction(ArrayType const& _
 
 	string functionName = "copy_array_from_storage_to_memory_" + _from.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (_from.baseType()->isValueType())
 		{
 			solAssert(*_from.baseType() == *_to.baseType(), "");
@@ -2497,7 +2594,7 @@ string YulUtilFunctions::bytesConcatFunction(vector<Type const*> const& _argumen
 		functionName += "_" + argumentType->identifier();
 	}
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(<parameters>) -> outPtr {
 				outPtr := <allocateUnbounded>()
@@ -2525,7 +2622,7 @@ string YulUtilFunctions::bytesConcatFunction(vector<Type const*> const& _argumen
 string YulUtilFunctions::mappingIndexAccessFunction(MappingType const& _mappingType, Type const& _keyType)
 {
 	string functionName = "mapping_index_access_" + _mappingType.identifier() + "_of_" + _keyType.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (_mappingType.keyType()->isDynamicallySized())
 			return Whiskers(R"(
 				function <functionName>(slot <?+key>,</+key> <key>) -> dataSlot {
@@ -2582,7 +2679,7 @@ string YulUtilFunctions::readFromStorageDynamic(Type const& _type, bool _splitFu
 		string(_splitFunctionTypes ? "split_" : "") +
 		_type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot, offset) -> value {
 				if gt(offset, 0) { <panic>() }
@@ -2610,7 +2707,7 @@ string YulUtilFunctions::readFromStorageValueType(Type const& _type, optional<si
 			"_" +
 			_type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		Whiskers templ(R"(
 			function <functionName>(slot<?dynamic>, offset</dynamic>) -> <?split>addr, selector<!split>value</split> {
 				<?split>let</split> value := <extract>(sload(slot)<?dynamic>, offset</dynamic>)
@@ -2671,7 +2768,7 @@ string YulUtilFunctions::readFromStorageReferenceType(Type const& _type)
 		.render();
 	}
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot) -> value {
 				value := <allocStruct>()
@@ -2710,7 +2807,7 @@ string YulUtilFunctions::updateStorageValueFunction(
 		"_to_" +
 		_toType.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		if (_toType.isValueType())
 		{
 			solAssert(_fromType.isImplicitlyConvertibleTo(_toType), "");
@@ -2813,7 +2910,7 @@ string YulUtilFunctions::writeToMemoryFunction(Type const& _type)
 {
 	string const functionName = "write_to_memory_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		solAssert(!dynamic_cast<StringLiteralType const*>(&_type), "");
 		if (auto ref = dynamic_cast<ReferenceType const*>(&_type))
 		{
@@ -2870,7 +2967,7 @@ string YulUtilFunctions::extractFromStorageValueDynamic(Type const& _type)
 	string functionName =
 		"extract_from_storage_value_dynamic" +
 		_type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot_value, offset) -> value {
 				value := <cleanupStorage>(<shr>(mul(offset, 8), slot_value))
@@ -2886,7 +2983,7 @@ string YulUtilFunctions::extractFromStorageValueDynamic(Type const& _type)
 string YulUtilFunctions::extractFromStorageValue(Type const& _type, size_t _offset)
 {
 	string functionName = "extract_from_storage_value_offset_" + to_string(_offset) + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		return Whiskers(R"(
 			function <functionName>(slot_value) -> value {
 				value := <cleanupStorage>(<shr>(slot_value))
@@ -2904,7 +3001,7 @@ string YulUtilFunctions::cleanupFromStorageFunction(Type const& _type)
 	solAssert(_type.isValueType(), "");
 
 	string functionName = string("cleanup_from_storage_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		Whiskers templ(R"(
 			function <functionName>(value) -> cleaned {
 				cleaned := <cleaned>
@@ -2937,7 +3034,7 @@ string YulUtilFunctions::cleanupFromStorageFunction(Type const& _type)
 string YulUtilFunctions::prepareStoreFunction(Type const& _type)
 {
 	string functionName = "prepare_store_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		solAssert(_type.isValueType(), "");
 		auto const* funType = dynamic_cast<FunctionType const*>(&_type);
 		if (funType && funType->kind() == FunctionType::Kind::External)
@@ -2973,7 +3070,7 @@ string YulUtilFunctions::prepareStoreFunction(Type const& _type)
 string YulUtilFunctions::allocationFunction()
 {
 	string functionName = "allocate_memory";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(size) -> memPtr {
 				memPtr := <allocateUnbounded>()
@@ -2990,7 +3087,7 @@ string YulUtilFunctions::allocationFunction()
 string YulUtilFunctions::allocateUnboundedFunction()
 {
 	string functionName = "allocate_unbounded";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>() -> memPtr {
 				memPtr := mload(<freeMemoryPointer>)
@@ -3005,7 +3102,7 @@ string YulUtilFunctions::allocateUnboundedFunction()
 string YulUtilFunctions::finalizeAllocationFunction()
 {
 	string functionName = "finalize_allocation";
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(memPtr, size) {
 				let newFreePtr := add(memPtr, <roundUp>(size))
@@ -3034,7 +3131,7 @@ string YulUtilFunctions::zeroMemoryFunction(Type const& _type)
 	solAssert(_type.hasSimpleZeroValueInMemory(), "");
 
 	string functionName = "zero_memory_chunk_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(dataStart, dataSizeInBytes) {
 				calldatacopy(dataStart, calldatasize(), dataSizeInBytes)
@@ -3050,7 +3147,7 @@ string YulUtilFunctions::zeroComplexMemoryArrayFunction(ArrayType const& _type)
 	solAssert(!_type.baseType()->hasSimpleZeroValueInMemory(), "");
 
 	string functionName = "zero_complex_memory_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		solAssert(_type.memoryStride() == 32, "");
 		return Whiskers(R"(
 			function <functionName>(dataStart, dataSizeInBytes) {
@@ -3069,7 +3166,7 @@ string YulUtilFunctions::zeroComplexMemoryArrayFunction(ArrayType const& _type)
 string YulUtilFunctions::allocateMemoryArrayFunction(ArrayType const& _type)
 {
 	string functionName = "allocate_memory_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 				function <functionName>(length) -> memPtr {
 					let allocSize := <allocSize>(length)
@@ -3090,7 +3187,7 @@ string YulUtilFunctions::allocateMemoryArrayFunction(ArrayType const& _type)
 string YulUtilFunctions::allocateAndInitializeMemoryArrayFunction(ArrayType const& _type)
 {
 	string functionName = "allocate_and_zero_memory_array_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 				function <functionName>(length) -> memPtr {
 					memPtr := <allocArray>(length)
@@ -3115,7 +3212,7 @@ string YulUtilFunctions::allocateAndInitializeMemoryArrayFunction(ArrayType cons
 string YulUtilFunctions::allocateMemoryStructFunction(StructType const& _type)
 {
 	string functionName = "allocate_memory_struct_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 		function <functionName>() -> memPtr {
 			memPtr := <alloc>(<allocSize>)
@@ -3132,7 +3229,7 @@ string YulUtilFunctions::allocateMemoryStructFunction(StructType const& _type)
 string YulUtilFunctions::allocateAndInitializeMemoryStructFunction(StructType const& _type)
 {
 	string functionName = "allocate_and_zero_memory_struct_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 		function <functionName>() -> memPtr {
 			memPtr := <allocStruct>()
@@ -3191,7 +3288,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			_from.identifier() +
 			"_to_" +
 			_to.identifier();
-		return m_functionCollector.createFunction(functionName, [&]() {
+		return m_functionCollector.createSharedFunction(functionName, [&]() {
 			return Whiskers(R"(
 				function <functionName>(<?external>addr, </external>functionId) -> <?external>outAddr, </external>outFunctionId {
 					<?external>outAddr := addr</external>
@@ -3230,7 +3327,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 			_from.identifier() +
 			"_to_" +
 			_to.identifier();
-		return m_functionCollector.createFunction(functionName, [&]() {
+		return m_functionCollector.createSharedFunction(functionName, [&]() {
 			return Whiskers(R"(
 				function <functionName>(offset, length) -> outOffset, outLength {
 					outOffset := offset
@@ -3261,7 +3358,7 @@ string YulUtilFunctions::conversionFunction(Type const& _from, Type const& _to)
 		_from.identifier() +
 		"_to_" +
 		_to.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) -> converted {
 				<body>
@@ -3453,7 +3550,7 @@ string YulUtilFunctions::bytesToFixedBytesConversionFunction(ArrayType const& _f
 	solAssert(_from.isByteArray() && !_from.isString(), "");
 	solAssert(_from.isDynamicallySized(), "");
 	string functionName = "convert_bytes_to_fixedbytes_from_" + _from.identifier() + "_to_" + _to.identifier();
-	return m_functionCollector.createFunction(functionName, [&](auto& _args, auto& _returnParams) {
+	return m_functionCollector.createSharedFunction(functionName, [&](auto& _args, auto& _returnParams) {
 		_args = { "array" };
 		bool fromCalldata = _from.dataStoredIn(DataLocation::CallData);
 		if (fromCalldata)
@@ -3517,7 +3614,7 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 		"_to_" +
 		_to.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&](auto& _arguments, auto&) {
+	return m_functionCollector.createSharedFunction(functionName, [&](auto& _arguments, auto&) {
 		_arguments = {"slot", "value"};
 		Whiskers templ(R"(
 			<?fromStorage> if iszero(eq(slot, value)) { </fromStorage>
@@ -3641,7 +3738,7 @@ string YulUtilFunctions::arrayConversionFunction(ArrayType const& _from, ArrayTy
 		"_to_" +
 		_to.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value<?fromCalldataDynamic>, length</fromCalldataDynamic>) -> converted <?toCalldataDynamic>, outLength</toCalldataDynamic> {
 				<body>
@@ -3707,7 +3804,7 @@ string YulUtilFunctions::cleanupFunction(Type const& _type)
 		return cleanupFunction(userDefinedValueType->underlyingType());
 
 	string functionName = string("cleanup_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) -> cleaned {
 				<body>
@@ -3804,7 +3901,7 @@ string YulUtilFunctions::cleanupFunction(Type const& _type)
 string YulUtilFunctions::validatorFunction(Type const& _type, bool _revertOnFailure)
 {
 	string functionName = string("validator_") + (_revertOnFailure ? "revert_" : "assert_") + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(value) {
 				if iszero(<condition>) { <failure> }
@@ -3869,7 +3966,7 @@ string YulUtilFunctions::packedHashFunction(
 	size_t sizeOnStack = 0;
 	for (Type const* t: _givenTypes)
 		sizeOnStack += t->sizeOnStack();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		Whiskers templ(R"(
 			function <functionName>(<variables>) -> hash {
 				let pos := <allocateUnbounded>()
@@ -3890,7 +3987,7 @@ string YulUtilFunctions::forwardingRevertFunction()
 {
 	bool forward = m_evmVersion.supportsReturndata();
 	string functionName = "revert_forward_" + to_string(forward);
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (forward)
 			return Whiskers(R"(
 				function <functionName>() {
@@ -3920,7 +4017,7 @@ std::string YulUtilFunctions::decrementCheckedFunction(Type const& _type)
 
 	string const functionName = "decrement_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
@@ -3943,7 +4040,7 @@ std::string YulUtilFunctions::decrementWrappingFunction(Type const& _type)
 
 	string const functionName = "decrement_wrapping_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(sub(value, 1))
@@ -3962,7 +4059,7 @@ std::string YulUtilFunctions::incrementCheckedFunction(Type const& _type)
 
 	string const functionName = "increment_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
@@ -3985,7 +4082,7 @@ std::string YulUtilFunctions::incrementWrappingFunction(Type const& _type)
 
 	string const functionName = "increment_wrapping_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(add(value, 1))
@@ -4004,7 +4101,7 @@ string YulUtilFunctions::negateNumberCheckedFunction(Type const& _type)
 	solAssert(type.isSigned(), "Expected signed type!");
 
 	string const functionName = "negate_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				value := <cleanupFunction>(value)
@@ -4027,7 +4124,7 @@ string YulUtilFunctions::negateNumberWrappingFunction(Type const& _type)
 	solAssert(type.isSigned(), "Expected signed type!");
 
 	string const functionName = "negate_wrapping_" + _type.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>(value) -> ret {
 				ret := <cleanupFunction>(sub(0, value))
@@ -4045,7 +4142,7 @@ string YulUtilFunctions::zeroValueFunction(Type const& _type, bool _splitFunctio
 
 	string const functionName = "zero_value_for_" + string(_splitFunctionTypes ? "split_" : "") + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		FunctionType const* fType = dynamic_cast<FunctionType const*>(&_type);
 		if (fType && fType->kind() == FunctionType::Kind::External && _splitFunctionTypes)
 			return Whiskers(R"(
@@ -4118,7 +4215,7 @@ string YulUtilFunctions::storageSetToZeroFunction(Type const& _type)
 {
 	string const functionName = "storage_set_to_zero_" + _type.identifier();
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (_type.isValueType())
 			return Whiskers(R"(
 				function <functionName>(slot, offset) {
@@ -4165,7 +4262,7 @@ string YulUtilFunctions::conversionFunctionSpecial(Type const& _from, Type const
 		_from.identifier() +
 		"_to_" +
 		_to.identifier();
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		if (
 			auto fromTuple = dynamic_cast<TupleType const*>(&_from), toTuple = dynamic_cast<TupleType const*>(&_to);
 			fromTuple && toTuple && fromTuple->components().size() == toTuple->components().size()
@@ -4257,7 +4354,7 @@ string YulUtilFunctions::readFromMemoryOrCalldata(Type const& _type, bool _fromC
 	if (_fromCalldata)
 		solAssert(!_type.isDynamicallyEncoded(), "");
 
-	return m_functionCollector.createFunction(functionName, [&] {
+	return m_functionCollector.createSharedFunction(functionName, [&] {
 		if (auto refType = dynamic_cast<ReferenceType const*>(&_type))
 		{
 			solAssert(refType->sizeOnStack() == 1, "");
@@ -4317,7 +4414,7 @@ string YulUtilFunctions::readFromMemoryOrCalldata(Type const& _type, bool _fromC
 string YulUtilFunctions::revertReasonIfDebugFunction(string const& _message)
 {
 	string functionName = "revert_error_" + util::toHex(util::keccak256(_message).asBytes());
-	return m_functionCollector.createFunction(functionName, [&](auto&, auto&) -> string {
+	return m_functionCollector.createSharedFunction(functionName, [&](auto&, auto&) -> string {
 		return revertReasonIfDebugBody(m_revertStrings, allocateUnboundedFunction() + "()", _message);
 	});
 }
@@ -4365,7 +4462,7 @@ string YulUtilFunctions::revertReasonIfDebugBody(
 string YulUtilFunctions::panicFunction(util::PanicCode _code)
 {
 	string functionName = "panic_error_" + toCompactHexWithPrefix(uint64_t(_code));
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return Whiskers(R"(
 			function <functionName>() {
 				mstore(0, <selector>)
@@ -4385,7 +4482,7 @@ string YulUtilFunctions::returnDataSelectorFunction()
 	string const functionName = "return_data_selector";
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> sig {
 				if gt(returndatasize(), 3) {
@@ -4405,7 +4502,7 @@ string YulUtilFunctions::tryDecodeErrorMessageFunction()
 	string const functionName = "try_decode_error_message";
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> ret {
 				if lt(returndatasize(), 0x44) { leave }
@@ -4444,7 +4541,7 @@ string YulUtilFunctions::tryDecodePanicDataFunction()
 	string const functionName = "try_decode_panic_data";
 	solAssert(m_evmVersion.supportsReturndata(), "");
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> success, data {
 				if gt(returndatasize(), 0x23) {
@@ -4463,7 +4560,7 @@ string YulUtilFunctions::extractReturndataFunction()
 {
 	string const functionName = "extract_returndata";
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>() -> data {
 				<?supportsReturndata>
@@ -4500,7 +4597,7 @@ string YulUtilFunctions::copyConstructorArgumentsToMemoryFunction(
 		"_" +
 		toString(_contract.id());
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		string returnParams = suffixedVariableNameList("ret_param_",0, CompilerUtils::sizeOnStack(_contract.constructor()->parameters()));
 		ABIFunctions abiFunctions(m_evmVersion, m_revertStrings, m_functionCollector);
 
@@ -4528,7 +4625,7 @@ string YulUtilFunctions::externalCodeFunction()
 {
 	string functionName = "external_code_at";
 
-	return m_functionCollector.createFunction(functionName, [&]() {
+	return m_functionCollector.createSharedFunction(functionName, [&]() {
 		return util::Whiskers(R"(
 			function <functionName>(addr) -> mpos {
 				let length := extcodesize(addr)
@@ -262,6 +262,11 @@ public:
 	/// signature (to_slot, from_slot) ->
 	std::string copyValueArrayStorageToStorageFunction(ArrayType const& _fromType, ArrayType const& _toType);
 
+	/// @returns the name of a function that will copy an array of value types from memory or calldata
+	/// to a storage array whose elements are packed, assembling each slot on the stack before storing it.
+	/// signature (to_slot, from_ptr[, from_length]) ->
+	std::string copyValueArrayToPackedStorageFunction(ArrayType const& _fromType, ArrayType const& _toType);
+
 	/// Returns the name of a function that will convert a given length to the
 	/// size in memory (number of storage slots or calldata/memory bytes) it
 	/// will require.
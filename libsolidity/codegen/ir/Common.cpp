@@ -136,14 +136,18 @@ string dispenseLocationComment(langutil::SourceLocation const& _location, IRGene
 	solAssert(_location.sourceName, "");
 	_context.markSourceUsed(*_location.sourceName);
 
-	string debugInfo = AsmPrinter::formatSourceLocation(
-		_location,
-		_context.sourceIndices(),
-		_context.debugInfoSelection(),
-		_context.soliditySourceProvider()
-	);
-
-	return debugInfo.empty() ? "" : "/// " + debugInfo;
+	auto [comment, inserted] = _context.locationComments().try_emplace(_location);
+	if (inserted)
+	{
+		string debugInfo = AsmPrinter::formatSourceLocation(
+			_location,
+			_context.sourceIndices(),
+			_context.debugInfoSelection(),
+			_context.soliditySourceProvider()
+		);
+		comment->second = debugInfo.empty() ? "" : "/// " + debugInfo;
+	}
+	return comment->second;
 }
 
 string dispenseLocationComment(ASTNode const& _node, IRGenerationContext& _context)
@@ -173,6 +173,8 @@ public:
 
 	std::map<std::string, unsigned> const& sourceIndices() const { return m_sourceIndices; }
 	void markSourceUsed(std::string const& _name) { m_usedSourceNames.insert(_name); }
+	/// Comments that were already created by dispenseLocationComment, by their location.
+	std::map<langutil::SourceLocation, std::string>& locationComments() { return m_locationComments; }
 	std::set<std::string> const& usedSourceNames() const { return m_usedSourceNames; }
 
 	bool immutableRegistered(VariableDeclaration const& _varDecl) const { return m_immutableVariables.count(&_varDecl); }
@@ -187,6 +189,7 @@ private:
 	OptimiserSettings m_optimiserSettings;
 	std::map<std::string, unsigned> m_sourceIndices;
 	std::set<std::string> m_usedSourceNames;
+	std::map<langutil::SourceLocation, std::string> m_locationComments;
 	ContractDefinition const* m_mostDerivedContract = nullptr;
 	std::map<VariableDeclaration const*, IRVariable> m_localVariables;
 	/// Memory offsets reserved for the values of immutable variables during contract creation.
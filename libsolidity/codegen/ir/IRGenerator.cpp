@@ -85,6 +85,14 @@ set<CallableDeclaration const*, ASTNode::CompareByID> collectReachableCallables(
 	return reachableCallables;
 }
 
+string const experimentalWarning =
+	"/*=====================================================*\n"
+	" *                       WARNING                       *\n"
+	" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
+	" *       It can result in LOSS OF FUNDS or worse       *\n"
+	" *                !USE AT YOUR OWN RISK!               *\n"
+	" *=====================================================*/\n\n";
+
 }
 
 pair<string, string> IRGenerator::run(
@@ -93,35 +101,50 @@ pair<string, string> IRGenerator::run(
 	map<ContractDefinition const*, string_view const> const& _otherYulSources
 )
 {
-	string const ir = yul::reindent(generate(_contract, _cborMetadata, _otherYulSources));
+	string ir = generateUnoptimized(_contract, _cborMetadata, _otherYulSources);
+	return {ir, optimize(ir)};
+}
 
-	yul::AssemblyStack asmStack(
+string IRGenerator::generateUnoptimized(
+	ContractDefinition const& _contract,
+	bytes const& _cborMetadata,
+	map<ContractDefinition const*, string_view const> const& _otherYulSources
+)
+{
+	return experimentalWarning + yul::reindent(generate(_contract, _cborMetadata, _otherYulSources));
+}
+
+string IRGenerator::optimize(
+	string const& _ir,
+	size_t _parallelism,
+	util::TimingCollector* _optimiserStepTimings,
+	shared_ptr<yul::AssemblyStack>* o_optimizedStack
+) const
+{
+	auto asmStack = make_shared<yul::AssemblyStack>(
 		m_evmVersion,
 		yul::AssemblyStack::Language::StrictAssembly,
 		m_optimiserSettings,
 		m_context.debugInfoSelection()
 	);
-	if (!asmStack.parseAndAnalyze("", ir))
+	asmStack->setParallelism(_parallelism);
+	asmStack->setOptimiserStepTimings(_optimiserStepTimings);
+	if (!asmStack->parseAndAnalyze("", _ir))
 	{
 		string errorMessage;
-		for (auto const& error: asmStack.errors())
+		for (auto const& error: asmStack->errors())
 			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(
 				*error,
-				asmStack.charStream("")
+				asmStack->charStream("")
 			);
-		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
+		solAssert(false, _ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
-	asmStack.optimize();
-
-	string warning =
-		"/*=====================================================*\n"
-		" *                       WARNING                       *\n"
-		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
-		" *       It can result in LOSS OF FUNDS or worse       *\n"
-		" *                !USE AT YOUR OWN RISK!               *\n"
-		" *=====================================================*/\n\n";
+	asmStack->optimize();
 
-	return {warning + ir, warning + asmStack.print(m_context.soliditySourceProvider())};
+	string optimizedIR = experimentalWarning + asmStack->print(m_context.soliditySourceProvider());
+	if (o_optimizedStack)
+		*o_optimizedStack = move(asmStack);
+	return optimizedIR;
 }
 
 string IRGenerator::generate(
@@ -1109,6 +1132,7 @@ void IRGenerator::resetContext(ContractDefinition const& _contract, ExecutionCon
 		m_context.soliditySourceProvider()
 	);
 	newContext.copyFunctionIDsFrom(m_context);
+	newContext.functionCollector().setCache(m_functionCache);
 	m_context = move(newContext);
 
 	m_context.setMostDerivedContract(_contract);
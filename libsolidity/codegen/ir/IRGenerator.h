@@ -32,8 +32,16 @@
 #include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/Timing.h>
+
+#include <memory>
 #include <string>
 
+namespace solidity::yul
+{
+class AssemblyStack;
+}
+
 namespace solidity::frontend
 {
 
@@ -66,6 +74,14 @@ public:
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
+	/// Sets the cache of utility functions shared with the generators of the other contracts
+	/// of the compilation. It has to outlive this object.
+	void setFunctionCache(MultiUseYulFunctionCache* _cache)
+	{
+		m_functionCache = _cache;
+		m_context.functionCollector().setCache(_cache);
+	}
+
 	/// Generates and returns the IR code, in unoptimized and optimized form
 	/// (or just pretty-printed, depending on the optimizer settings).
 	std::pair<std::string, std::string> run(
@@ -74,6 +90,28 @@ public:
 		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
 	);
 
+	/// Generates and returns the unoptimized IR code. Together with @a optimize, this
+	/// is equivalent to @a run.
+	std::string generateUnoptimized(
+		ContractDefinition const& _contract,
+		bytes const& _cborMetadata,
+		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
+	);
+
+	/// Parses IR code returned by @a generateUnoptimized and returns it in optimized form
+	/// (or just pretty-printed, depending on the optimizer settings). Does not access the
+	/// Solidity AST or modify the generator, so it can be run for several contracts concurrently.
+	/// Up to @a _parallelism threads are used to optimise the sub-objects of the IR.
+	/// If @a _optimiserStepTimings is given, the time spent in each optimiser step is recorded in it.
+	/// If @a o_optimizedStack is given, it is set to the assembly stack holding the optimised and
+	/// analysed object, so that code can be generated without parsing the returned IR again.
+	std::string optimize(
+		std::string const& _ir,
+		size_t _parallelism = 1,
+		util::TimingCollector* _optimiserStepTimings = nullptr,
+		std::shared_ptr<yul::AssemblyStack>* o_optimizedStack = nullptr
+	) const;
+
 private:
 	std::string generate(
 		ContractDefinition const& _contract,
@@ -139,6 +177,7 @@ private:
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
+	MultiUseYulFunctionCache* m_functionCache = nullptr;
 };
 
 }
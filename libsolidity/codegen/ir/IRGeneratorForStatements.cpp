@@ -416,17 +416,22 @@ bool IRGeneratorForStatements::visit(Conditional const& _conditional)
 
 	appendCode() << "switch " << condition << "\n" "case 0 {\n";
 
+	auto const storageReadCacheBefore = m_storageReadCache;
 	_conditional.falseExpression().accept(*this);
 	setLocation(_conditional);
 
 	assign(_conditional, _conditional.falseExpression());
 	appendCode() << "}\n" "default {\n";
 
+	intersectStorageReadCache(storageReadCacheBefore);
+	auto const storageReadCacheFalse = m_storageReadCache;
+	m_storageReadCache = storageReadCacheBefore;
 	_conditional.trueExpression().accept(*this);
 	setLocation(_conditional);
 
 	assign(_conditional, _conditional.trueExpression());
 	appendCode() << "}\n";
+	intersectStorageReadCache(storageReadCacheFalse);
 
 	return false;
 }
@@ -589,6 +594,7 @@ bool IRGeneratorForStatements::visit(IfStatement const& _ifStatement)
 	setLocation(_ifStatement);
 	string condition = expressionAsType(_ifStatement.condition(), *TypeProvider::boolean());
 
+	auto const storageReadCacheBefore = m_storageReadCache;
 	if (_ifStatement.falseStatement())
 	{
 		appendCode() << "switch " << condition << "\n" "case 0 {\n";
@@ -598,9 +604,13 @@ bool IRGeneratorForStatements::visit(IfStatement const& _ifStatement)
 	}
 	else
 		appendCode() << "if " << condition << " {\n";
+	intersectStorageReadCache(storageReadCacheBefore);
+	auto const storageReadCacheFalse = m_storageReadCache;
+	m_storageReadCache = storageReadCacheBefore;
 	_ifStatement.trueStatement().accept(*this);
 	setLocation(_ifStatement);
 	appendCode() << "}\n";
+	intersectStorageReadCache(storageReadCacheFalse);
 
 	return false;
 }
@@ -610,6 +620,7 @@ void IRGeneratorForStatements::endVisit(PlaceholderStatement const& _placeholder
 	solAssert(m_placeholderCallback, "");
 	setLocation(_placeholder);
 	appendCode() << m_placeholderCallback();
+	m_storageReadCache.clear();
 }
 
 bool IRGeneratorForStatements::visit(ForStatement const& _forStatement)
@@ -698,6 +709,7 @@ bool IRGeneratorForStatements::visit(UnaryOperation const& _unaryOperation)
 						", " <<
 						_storage.offsetString() <<
 						")\n";
+					invalidateStorageReadCache(_storage, m_currentLValue->type);
 					m_currentLValue.reset();
 				},
 				[&](auto const&) {
@@ -902,6 +914,36 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 
 	vector<ASTPointer<Expression const>> const& arguments = _functionCall.sortedArguments();
 
+	// The arguments have been evaluated, but the call itself might write to storage,
+	// unless it is an internal call to a view function or a builtin that cannot.
+	if (functionCallKind != FunctionCallKind::StructConstructorCall)
+		switch (functionType->kind())
+		{
+		case FunctionType::Kind::Internal:
+			if (functionType->stateMutability() > StateMutability::View)
+				m_storageReadCache.clear();
+			break;
+		case FunctionType::Kind::Event:
+		case FunctionType::Kind::Error:
+		case FunctionType::Kind::Revert:
+		case FunctionType::Kind::Require:
+		case FunctionType::Kind::Assert:
+		case FunctionType::Kind::KECCAK256:
+		case FunctionType::Kind::ABIEncode:
+		case FunctionType::Kind::ABIEncodePacked:
+		case FunctionType::Kind::ABIEncodeWithSelector:
+		case FunctionType::Kind::ABIEncodeWithSignature:
+		case FunctionType::Kind::ABIDecode:
+		case FunctionType::Kind::AddMod:
+		case FunctionType::Kind::MulMod:
+		case FunctionType::Kind::GasLeft:
+		case FunctionType::Kind::BlockHash:
+		case FunctionType::Kind::ObjectCreation:
+			break;
+		default:
+			m_storageReadCache.clear();
+		}
+
 	if (functionCallKind == FunctionCallKind::StructConstructorCall)
 	{
 		TypeType const& type = dynamic_cast<TypeType const&>(*_functionCall.expression().annotation().type);
@@ -1283,6 +1325,19 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 				", " <<
 				(arrayLengthFunction + "(" + array.commaSeparatedList() +")") <<
 				")\n";
+
+			// Optimization: The memory allocated by an ABI encoding that is passed to keccak256
+			// directly is not referenced anywhere else, so it can be reused after hashing.
+			if (auto const* encodingCall = dynamic_cast<FunctionCall const*>(arguments.front().get()))
+				if (*encodingCall->annotation().kind == FunctionCallKind::FunctionCall)
+					if (auto const* encodingType = dynamic_cast<FunctionType const*>(encodingCall->expression().annotation().type))
+						if (
+							encodingType->kind() == FunctionType::Kind::ABIEncode ||
+							encodingType->kind() == FunctionType::Kind::ABIEncodePacked ||
+							encodingType->kind() == FunctionType::Kind::ABIEncodeWithSelector ||
+							encodingType->kind() == FunctionType::Kind::ABIEncodeWithSignature
+						)
+							appendCode() << m_utils.finalizeAllocationFunction() << "(" << array.name() << ", 0)\n";
 		}
 		break;
 	}
@@ -1850,9 +1905,15 @@ void IRGeneratorForStatements::endVisit(MemberAccess const& _memberAccess)
 		case DataLocation::Storage:
 		{
 			pair<u256, unsigned> const& offsets = structType.storageOffsetsOfMember(member);
-			string slot = m_context.newYulVariable();
-			appendCode() << "let " << slot << " := " <<
-				("add(" + expression.part("slot").name() + ", " + offsets.first.str() + ")\n");
+			string slot;
+			if (optional<u256> structSlot = constantStorageSlot(_memberAccess.expression()))
+				slot = toCompactHexWithPrefix(*structSlot + offsets.first);
+			else
+			{
+				slot = m_context.newYulVariable();
+				appendCode() << "let " << slot << " := " <<
+					("add(" + expression.part("slot").name() + ", " + offsets.first.str() + ")\n");
+			}
 			setLValue(_memberAccess, IRLValue{
 				type(_memberAccess),
 				IRLValue::Storage{slot, offsets.second}
@@ -2085,6 +2146,7 @@ bool IRGeneratorForStatements::visit(InlineAssembly const& _inlineAsm)
 {
 	setLocation(_inlineAsm);
 	m_context.setInlineAssemblySeen();
+	m_storageReadCache.clear();
 	CopyTranslate bodyCopier{_inlineAsm.dialect(), m_context, _inlineAsm.annotation().externalReferences};
 
 	yul::Statement modified = bodyCopier(_inlineAsm.operations());
@@ -2471,8 +2533,10 @@ void IRGeneratorForStatements::appendExternalFunctionCall(
 				returndatacopy(<pos>, 0, returndatasize())
 			</dynamicReturnSize>
 
-			// update freeMemoryPointer according to dynamic return size
-			<finalizeAllocation>(<pos>, <returnSize>)
+			<?updateFreeMemoryPointer>
+				// update freeMemoryPointer according to dynamic return size
+				<finalizeAllocation>(<pos>, <returnSize>)
+			</updateFreeMemoryPointer>
 
 			// decode return parameters from external try-call into retVars
 			<?+retVars> <retVars> := </+retVars> <abiDecode>(<pos>, add(<pos>, <returnSize>))
@@ -2498,7 +2562,6 @@ void IRGeneratorForStatements::appendExternalFunctionCall(
 	else
 		templ("success", m_context.newYulVariable());
 	templ("allocateUnbounded", m_utils.allocateUnboundedFunction());
-	templ("finalizeAllocation", m_utils.finalizeAllocationFunction());
 	templ("shl28", m_utils.shiftLeftFunction(8 * (32 - 4)));
 
 	templ("funSel", IRVariable(_functionCall.expression()).part("functionSelector").name());
@@ -2513,6 +2576,17 @@ void IRGeneratorForStatements::appendExternalFunctionCall(
 
 	templ("reservedReturnSize", returnInfo.dynamicReturnSize ? "0" : to_string(returnInfo.estimatedReturnSize));
 
+	// Return values of value types are decoded onto the stack and nothing refers to the
+	// memory of the call afterwards, so it is left to be reused.
+	bool const updateFreeMemoryPointer = !all_of(
+		returnInfo.returnTypes.begin(),
+		returnInfo.returnTypes.end(),
+		[](Type const* _type) { return _type->isValueType(); }
+	);
+	templ("updateFreeMemoryPointer", updateFreeMemoryPointer);
+	if (updateFreeMemoryPointer)
+		templ("finalizeAllocation", m_utils.finalizeAllocationFunction());
+
 	string const retVars = IRVariable(_functionCall).commaSeparatedList();
 	templ("retVars", retVars);
 	solAssert(retVars.empty() == returnInfo.returnTypes.empty(), "");
@@ -2869,10 +2943,12 @@ void IRGeneratorForStatements::appendAndOrOperatorCode(BinaryOperation const& _b
 		appendCode() << "if iszero(" << value.name() << ") {\n";
 	else
 		appendCode() << "if " << value.name() << " {\n";
+	auto const storageReadCacheBefore = m_storageReadCache;
 	_binOp.rightExpression().accept(*this);
 	setLocation(_binOp);
 	assign(value, _binOp.rightExpression());
 	appendCode() << "}\n";
+	intersectStorageReadCache(storageReadCacheBefore);
 }
 
 void IRGeneratorForStatements::writeToLValue(IRLValue const& _lvalue, IRVariable const& _value)
@@ -2895,7 +2971,7 @@ void IRGeneratorForStatements::writeToLValue(IRLValue const& _lvalue, IRVariable
 					offsetArgument <<
 					_value.commaSeparatedListPrefixed() <<
 					")\n";
-
+				invalidateStorageReadCache(_storage, _lvalue.type);
 			},
 			[&](IRLValue::Memory const& _memory) {
 				if (_lvalue.type.isValueType())
@@ -2978,11 +3054,26 @@ IRVariable IRGeneratorForStatements::readFromLValue(IRLValue const& _lvalue)
 					std::get<string>(_storage.offset) <<
 					")\n";
 			else
-				define(result) <<
-					m_utils.readFromStorage(_lvalue.type, std::get<unsigned>(_storage.offset), true) <<
-					"(" <<
-					_storage.slot <<
-					")\n";
+			{
+				pair<string, unsigned> const key{_storage.slot, std::get<unsigned>(_storage.offset)};
+				auto cached = m_storageReadCache.find(key);
+				if (cached != m_storageReadCache.end() && cached->second.type() == _lvalue.type)
+					define(result, cached->second);
+				else
+				{
+					define(result) <<
+						m_utils.readFromStorage(_lvalue.type, std::get<unsigned>(_storage.offset), true) <<
+						"(" <<
+						_storage.slot <<
+						")\n";
+					// Only slots known at compile time can be referred to again.
+					if (isValidHex(_storage.slot))
+					{
+						m_storageReadCache.erase(key);
+						m_storageReadCache.emplace(key, result);
+					}
+				}
+			}
 		},
 		[&](IRLValue::Memory const& _memory) {
 			if (_lvalue.type.isValueType())
@@ -3035,6 +3126,69 @@ void IRGeneratorForStatements::setLValue(Expression const& _expression, IRLValue
 		define(_expression, readFromLValue(_lvalue));
 }
 
+optional<u256> IRGeneratorForStatements::constantStorageSlot(Expression const& _expression) const
+{
+	if (auto const* identifier = dynamic_cast<Identifier const*>(&_expression))
+	{
+		auto const* variable = dynamic_cast<VariableDeclaration const*>(identifier->annotation().referencedDeclaration);
+		if (
+			variable &&
+			variable->isStateVariable() &&
+			!variable->isConstant() &&
+			!variable->immutable() &&
+			m_context.isStateVariable(*variable)
+		)
+			return m_context.storageLocationOfStateVariable(*variable).first;
+	}
+	else if (auto const* memberAccess = dynamic_cast<MemberAccess const*>(&_expression))
+	{
+		auto const* structType = dynamic_cast<StructType const*>(memberAccess->expression().annotation().type);
+		if (structType && structType->location() == DataLocation::Storage)
+			if (optional<u256> structSlot = constantStorageSlot(memberAccess->expression()))
+				return *structSlot + structType->storageOffsetsOfMember(memberAccess->memberName()).first;
+	}
+	return nullopt;
+}
+
+void IRGeneratorForStatements::invalidateStorageReadCache(IRLValue::Storage const& _storage, Type const& _type)
+{
+	if (
+		!_type.isValueType() ||
+		!isValidHex(_storage.slot) ||
+		!holds_alternative<unsigned>(_storage.offset)
+	)
+	{
+		m_storageReadCache.clear();
+		return;
+	}
+
+	unsigned const writeStart = get<unsigned>(_storage.offset);
+	unsigned const writeEnd = writeStart + _type.storageBytes();
+	for (auto it = m_storageReadCache.begin(); it != m_storageReadCache.end();)
+	{
+		auto const& [slot, offset] = it->first;
+		unsigned const readEnd = offset + it->second.type().storageBytes();
+		if (slot == _storage.slot && offset < writeEnd && writeStart < readEnd)
+			it = m_storageReadCache.erase(it);
+		else
+			++it;
+	}
+}
+
+void IRGeneratorForStatements::intersectStorageReadCache(
+	map<pair<string, unsigned>, IRVariable> const& _other
+)
+{
+	for (auto it = m_storageReadCache.begin(); it != m_storageReadCache.end();)
+	{
+		auto otherIt = _other.find(it->first);
+		if (otherIt == _other.end() || otherIt->second.name() != it->second.name())
+			it = m_storageReadCache.erase(it);
+		else
+			++it;
+	}
+}
+
 void IRGeneratorForStatements::generateLoop(
 	Statement const& _body,
 	Expression const* _conditionExpression,
@@ -3052,12 +3206,17 @@ void IRGeneratorForStatements::generateLoop(
 		appendCode() << "let " << firstRun << " := 1\n";
 	}
 
+	// Values read before or in a previous iteration might have been changed by the loop body,
+	// so nothing is cached across the parts of the loop.
+	m_storageReadCache.clear();
 	appendCode() << "for {\n";
 	if (_initExpression)
 		_initExpression->accept(*this);
+	m_storageReadCache.clear();
 	appendCode() << "} 1 {\n";
 	if (_loopExpression)
 		_loopExpression->accept(*this);
+	m_storageReadCache.clear();
 	appendCode() << "}\n";
 	appendCode() << "{\n";
 
@@ -3073,12 +3232,16 @@ void IRGeneratorForStatements::generateLoop(
 			") { break }\n";
 
 		if (_isDoWhile)
+		{
 			appendCode() << "}\n" << firstRun << " := 0\n";
+			m_storageReadCache.clear();
+		}
 	}
 
 	_body.accept(*this);
 
 	appendCode() << "}\n";
+	m_storageReadCache.clear();
 }
 
 Type const& IRGeneratorForStatements::type(Expression const& _expression)
@@ -3114,10 +3277,12 @@ bool IRGeneratorForStatements::visit(TryStatement const& _tryStatement)
 	successClause.block().accept(*this);
 	setLocation(_tryStatement);
 	appendCode() << "}\n";
+	m_storageReadCache.clear();
 
 	appendCode() << "default { // failure case\n";
 	handleCatch(_tryStatement);
 	appendCode() << "}\n";
+	m_storageReadCache.clear();
 
 	return false;
 }
@@ -3238,7 +3403,9 @@ void IRGeneratorForStatements::revertWithError(
 
 bool IRGeneratorForStatements::visit(TryCatchClause const& _clause)
 {
+	m_storageReadCache.clear();
 	_clause.block().accept(*this);
+	m_storageReadCache.clear();
 	return false;
 }
 
@@ -26,6 +26,8 @@
 #include <libsolidity/codegen/ir/IRVariable.h>
 
 #include <functional>
+#include <map>
+#include <optional>
 
 namespace solidity::frontend
 {
@@ -210,6 +212,17 @@ private:
 	/// Stores the given @a _lvalue in m_currentLValue, if it will be written to (willBeWrittenTo). Otherwise
 	/// defines the expression @a _expression by reading the value from @a _lvalue.
 	void setLValue(Expression const& _expression, IRLValue _lvalue);
+
+	/// @returns the storage slot of the state variable or member of a state variable of struct type
+	/// referenced by @a _expression, if it is known at compile time.
+	std::optional<u256> constantStorageSlot(Expression const& _expression) const;
+	/// Removes all values from the storage read cache that might be changed by writing a value of
+	/// type @a _type to @a _storage.
+	void invalidateStorageReadCache(IRLValue::Storage const& _storage, Type const& _type);
+	/// Removes all values from the storage read cache that are not also contained in @a _other.
+	/// Used to merge the caches of the code paths of a branch, where @a _other is the cache
+	/// before the branch and the current cache is the one at the end of a path.
+	void intersectStorageReadCache(std::map<std::pair<std::string, unsigned>, IRVariable> const& _other);
 	void generateLoop(
 		Statement const& _body,
 		Expression const* _conditionExpression,
@@ -225,6 +238,11 @@ private:
 	std::function<std::string()> m_placeholderCallback;
 	YulUtilFunctions& m_utils;
 	std::optional<IRLValue> m_currentLValue;
+	/// Yul variables holding values of value types read from storage slots that are known at
+	/// compile time, keyed by slot and offset. The cache only covers straight-line code:
+	/// It is cleared by everything that might write to storage in an unknown way and pruned
+	/// at the end of branches.
+	std::map<std::pair<std::string, unsigned>, IRVariable> m_storageReadCache;
 };
 
 }
@@ -26,7 +26,7 @@ using namespace solidity::smtutil;
 using namespace solidity::frontend;
 using namespace solidity::frontend::smt;
 
-map<string, ArraySlicePredicate::SliceData> ArraySlicePredicate::m_slicePredicates;
+thread_local map<string, ArraySlicePredicate::SliceData> ArraySlicePredicate::m_slicePredicates;
 
 pair<bool, ArraySlicePredicate::SliceData const&> ArraySlicePredicate::create(SortPointer _sort, EncodingContext& _context)
 {
@@ -56,7 +56,8 @@ struct ArraySlicePredicate
 
 private:
 	/// Maps a unique sort name to its slice data.
-	static std::map<std::string, SliceData> m_slicePredicates;
+	/// Each thread has its own slice predicates, like it has its own predicates.
+	static thread_local std::map<std::string, SliceData> m_slicePredicates;
 };
 
 }
@@ -20,7 +20,9 @@
 
 #include <libsolidity/formal/SymbolicTypes.h>
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SMTPortfolio.h>
+#include <libsmtutil/Slicing.h>
 
 #include <liblangutil/CharStream.h>
 #include <liblangutil/CharStreamProvider.h>
@@ -35,17 +37,53 @@ using namespace solidity::util;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// @returns true if @a _body contains a statement that leaves the loop or the current
+/// iteration early, which the unrolling of loops does not take into account.
+bool containsLoopExit(Statement const& _body)
+{
+	struct LoopExitFinder: ASTConstVisitor
+	{
+		bool visit(Break const&) override { found = true; return false; }
+		bool visit(Continue const&) override { found = true; return false; }
+		bool visit(Return const&) override { found = true; return false; }
+		bool found = false;
+	};
+	LoopExitFinder finder;
+	_body.accept(finder);
+	return finder.found;
+}
+
+}
+
 BMC::BMC(
 	smt::EncodingContext& _context,
 	UniqueErrorReporter& _errorReporter,
 	map<h256, string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings const& _settings,
-	CharStreamProvider const& _charStreamProvider
+	SolverBudget const& _budget,
+	CharStreamProvider const& _charStreamProvider,
+	size_t _parallelism
 ):
 	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider),
-	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _settings.solvers, _settings.timeout))
+	m_interface(make_unique<smtutil::SMTPortfolio>(
+		_smtlib2Responses,
+		_smtCallback,
+		_settings.solvers,
+		_budget.solverTimeout(_settings.timeout),
+		_parallelism,
+		_settings.externalSolver
+	)),
+	m_budget(_budget)
 {
+	if (m_settings.queryCacheDirectory)
+		m_interface->setQueryCache(make_shared<smtutil::QueryCache>(
+			*m_settings.queryCacheDirectory,
+			m_settings.queryCacheMode
+		));
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (m_settings.solvers.cvc4 || m_settings.solvers.z3)
 		if (!_smtlib2Responses.empty())
@@ -100,6 +138,14 @@ void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<Verificatio
 			" Consider increasing the timeout per query."
 		);
 
+	for (auto const& [node, time]: m_solvingTimes)
+		m_errorReporter.info(
+			4280_error,
+			node->location(),
+			"BMC: Solving the queries of this target took " + to_string(time.count()) + " ms."
+		);
+	m_solvingTimes.clear();
+
 	// If this check is true, Z3 and CVC4 are not available
 	// and the query answers were not provided, since SMTPortfolio
 	// guarantees that SmtLib2Interface is the first solver, if enabled.
@@ -276,106 +322,41 @@ bool BMC::visit(Conditional const& _op)
 	return false;
 }
 
-// Here we consider the execution of two branches:
-// Branch 1 assumes the loop condition to be true and executes the loop once,
-// after resetting touched variables.
-// Branch 2 assumes the loop condition to be false and skips the loop after
-// visiting the condition (it might contain side-effects, they need to be considered)
-// and does not erase knowledge.
-// If the loop is a do-while, condition side-effects are lost since the body,
-// executed once before the condition, might reassign variables.
-// Variables touched by the loop are merged with Branch 2.
 bool BMC::visit(WhileStatement const& _node)
 {
-	auto indicesBeforeLoop = copyVariableIndices();
-	m_context.resetVariables(touchedVariables(_node));
-	decltype(indicesBeforeLoop) indicesAfterLoop;
-	if (_node.isDoWhile())
+	if (auto exceedsBound = unrollLoop(&_node.condition(), _node.body(), nullptr, _node.isDoWhile()))
 	{
-		indicesAfterLoop = visitBranch(&_node.body()).first;
-		// TODO the assertions generated in the body should still be active in the condition
-		_node.condition().accept(*this);
-		if (isRootFunction())
-			addVerificationTarget(
-				VerificationTargetType::ConstantCondition,
-				expr(_node.condition()),
-				&_node.condition()
-			);
+		// Only the iterations beyond the bound erase knowledge.
+		auto indicesAfterUnrolling = copyVariableIndices();
+		++m_unrolledLoopDepth;
+		pushPathCondition(*exceedsBound);
+		encodeLoop(_node, false);
+		popPathCondition();
+		--m_unrolledLoopDepth;
+		mergeVariables(*exceedsBound, copyVariableIndices(), indicesAfterUnrolling);
 	}
 	else
-	{
-		_node.condition().accept(*this);
-		if (isRootFunction())
-			addVerificationTarget(
-				VerificationTargetType::ConstantCondition,
-				expr(_node.condition()),
-				&_node.condition()
-			);
-
-		indicesAfterLoop = visitBranch(&_node.body(), expr(_node.condition())).first;
-	}
-
-	// We reset the execution to before the loop
-	// and visit the condition in case it's not a do-while.
-	// A do-while's body might have non-precise information
-	// in its first run about variables that are touched.
-	resetVariableIndices(indicesBeforeLoop);
-	if (!_node.isDoWhile())
-		_node.condition().accept(*this);
-
-	mergeVariables(expr(_node.condition()), indicesAfterLoop, copyVariableIndices());
-
-	m_loopExecutionHappened = true;
+		encodeLoop(_node, _node.isDoWhile());
 	return false;
 }
 
-// Here we consider the execution of two branches similar to WhileStatement.
 bool BMC::visit(ForStatement const& _node)
 {
 	if (_node.initializationExpression())
 		_node.initializationExpression()->accept(*this);
 
-	auto indicesBeforeLoop = copyVariableIndices();
-
-	// Do not reset the init expression part.
-	auto touchedVars = touchedVariables(_node.body());
-	if (_node.condition())
-		touchedVars += touchedVariables(*_node.condition());
-	if (_node.loopExpression())
-		touchedVars += touchedVariables(*_node.loopExpression());
-
-	m_context.resetVariables(touchedVars);
-
-	if (_node.condition())
+	if (auto exceedsBound = unrollLoop(_node.condition(), _node.body(), _node.loopExpression(), false))
 	{
-		_node.condition()->accept(*this);
-		if (isRootFunction())
-			addVerificationTarget(
-				VerificationTargetType::ConstantCondition,
-				expr(*_node.condition()),
-				_node.condition()
-			);
+		auto indicesAfterUnrolling = copyVariableIndices();
+		++m_unrolledLoopDepth;
+		pushPathCondition(*exceedsBound);
+		encodeLoop(_node);
+		popPathCondition();
+		--m_unrolledLoopDepth;
+		mergeVariables(*exceedsBound, copyVariableIndices(), indicesAfterUnrolling);
 	}
-
-	m_context.pushSolver();
-	if (_node.condition())
-		m_context.addAssertion(expr(*_node.condition()));
-	_node.body().accept(*this);
-	if (_node.loopExpression())
-		_node.loopExpression()->accept(*this);
-	m_context.popSolver();
-
-	auto indicesAfterLoop = copyVariableIndices();
-	// We reset the execution to before the loop
-	// and visit the condition.
-	resetVariableIndices(indicesBeforeLoop);
-	if (_node.condition())
-		_node.condition()->accept(*this);
-
-	auto forCondition = _node.condition() ? expr(*_node.condition()) : smtutil::Expression(true);
-	mergeVariables(forCondition, indicesAfterLoop, copyVariableIndices());
-
-	m_loopExecutionHappened = true;
+	else
+		encodeLoop(_node);
 	return false;
 }
 
@@ -500,6 +481,149 @@ void BMC::endVisit(Return const& _return)
 
 /// Visitor helpers.
 
+// Here we consider the execution of two branches:
+// Branch 1 assumes the loop condition to be true and executes the loop once,
+// after resetting touched variables.
+// Branch 2 assumes the loop condition to be false and skips the loop after
+// visiting the condition (it might contain side-effects, they need to be considered)
+// and does not erase knowledge.
+// If the loop is a do-while, condition side-effects are lost since the body,
+// executed once before the condition, might reassign variables.
+// Variables touched by the loop are merged with Branch 2.
+void BMC::encodeLoop(WhileStatement const& _node, bool _isDoWhile)
+{
+	auto indicesBeforeLoop = copyVariableIndices();
+	m_context.resetVariables(touchedVariables(_node));
+	decltype(indicesBeforeLoop) indicesAfterLoop;
+	if (_isDoWhile)
+	{
+		indicesAfterLoop = visitBranch(&_node.body()).first;
+		// TODO the assertions generated in the body should still be active in the condition
+		_node.condition().accept(*this);
+		if (isRootFunction())
+			addVerificationTarget(
+				VerificationTargetType::ConstantCondition,
+				expr(_node.condition()),
+				&_node.condition()
+			);
+	}
+	else
+	{
+		_node.condition().accept(*this);
+		if (isRootFunction())
+			addVerificationTarget(
+				VerificationTargetType::ConstantCondition,
+				expr(_node.condition()),
+				&_node.condition()
+			);
+
+		indicesAfterLoop = visitBranch(&_node.body(), expr(_node.condition())).first;
+	}
+
+	// We reset the execution to before the loop
+	// and visit the condition in case it's not a do-while.
+	// A do-while's body might have non-precise information
+	// in its first run about variables that are touched.
+	resetVariableIndices(indicesBeforeLoop);
+	if (!_isDoWhile)
+		_node.condition().accept(*this);
+
+	mergeVariables(expr(_node.condition()), indicesAfterLoop, copyVariableIndices());
+
+	m_loopExecutionHappened = true;
+}
+
+// Here we consider the execution of two branches similar to WhileStatement.
+void BMC::encodeLoop(ForStatement const& _node)
+{
+	auto indicesBeforeLoop = copyVariableIndices();
+
+	// Do not reset the init expression part.
+	auto touchedVars = touchedVariables(_node.body());
+	if (_node.condition())
+		touchedVars += touchedVariables(*_node.condition());
+	if (_node.loopExpression())
+		touchedVars += touchedVariables(*_node.loopExpression());
+
+	m_context.resetVariables(touchedVars);
+
+	if (_node.condition())
+	{
+		_node.condition()->accept(*this);
+		if (isRootFunction())
+			addVerificationTarget(
+				VerificationTargetType::ConstantCondition,
+				expr(*_node.condition()),
+				_node.condition()
+			);
+	}
+
+	m_context.pushSolver();
+	if (_node.condition())
+		m_context.addAssertion(expr(*_node.condition()));
+	_node.body().accept(*this);
+	if (_node.loopExpression())
+		_node.loopExpression()->accept(*this);
+	m_context.popSolver();
+
+	auto indicesAfterLoop = copyVariableIndices();
+	// We reset the execution to before the loop
+	// and visit the condition.
+	resetVariableIndices(indicesBeforeLoop);
+	if (_node.condition())
+		_node.condition()->accept(*this);
+
+	auto forCondition = _node.condition() ? expr(*_node.condition()) : smtutil::Expression(true);
+	mergeVariables(forCondition, indicesAfterLoop, copyVariableIndices());
+
+	m_loopExecutionHappened = true;
+}
+
+// Each iteration executes the body under the loop condition and merges the variables with
+// their values before the iteration. Since the condition does not assign to variables,
+// it stays false in the remaining iterations once the loop is left. The iterations are
+// encoded once and the targets of all of them are checked with the same assertions.
+optional<smtutil::Expression> BMC::unrollLoop(
+	Expression const* _condition,
+	Statement const& _body,
+	ExpressionStatement const* _loopExpression,
+	bool _isDoWhile
+)
+{
+	if (
+		!m_settings.bmcLoopIterations ||
+		*m_settings.bmcLoopIterations == 0 ||
+		(_condition && !touchedVariables(*_condition).empty()) ||
+		containsLoopExit(_body)
+	)
+		return nullopt;
+
+	auto loopCondition = [&]() {
+		if (!_condition)
+			return smtutil::Expression(true);
+		_condition->accept(*this);
+		return expr(*_condition);
+	};
+
+	++m_unrolledLoopDepth;
+	for (unsigned iteration = 0; iteration < *m_settings.bmcLoopIterations; ++iteration)
+	{
+		// The first iteration of a do-while loop is executed unconditionally.
+		smtutil::Expression entered = (_isDoWhile && iteration == 0) ? smtutil::Expression(true) : loopCondition();
+		auto indicesBeforeIteration = copyVariableIndices();
+		pushPathCondition(entered);
+		_body.accept(*this);
+		if (_loopExpression)
+			_loopExpression->accept(*this);
+		popPathCondition();
+		auto indicesAfterIteration = copyVariableIndices();
+		resetVariableIndices(indicesBeforeIteration);
+		mergeVariables(entered, indicesAfterIteration, indicesBeforeIteration);
+	}
+	--m_unrolledLoopDepth;
+	return loopCondition();
+}
+
 void BMC::visitAssert(FunctionCall const& _funCall)
 {
 	auto const& args = _funCall.arguments();
@@ -705,6 +829,14 @@ void BMC::checkVerificationTargets()
 {
 	for (auto& target: m_verificationTargets)
 		checkVerificationTarget(target);
+
+	// The checks that were not decided with the short timeouts of the first pass
+	// are repeated with longer timeouts, after the other targets of the function.
+	m_retrying = true;
+	for (auto const& retry: m_retries)
+		retry();
+	m_retries.clear();
+	m_retrying = false;
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
@@ -743,6 +875,7 @@ void BMC::checkConstantCondition(BMCVerificationTarget& _target)
 	checkBooleanNotConstant(
 		*_target.expression,
 		_target.constraints,
+		_target.assertions,
 		_target.value,
 		_target.callStack
 	);
@@ -769,10 +902,8 @@ void BMC::checkUnderflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
-		_target.constraints && _target.value < smt::minValue(*intType),
-		_target.callStack,
-		_target.modelExpressions,
-		_target.expression->location(),
+		_target,
+		_target.value < smt::minValue(*intType),
 		4144_error,
 		8312_error,
 		"Underflow (resulting value less than " + formatNumberReadable(intType->minValue()) + ")",
@@ -802,10 +933,8 @@ void BMC::checkOverflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
-		_target.constraints && _target.value > smt::maxValue(*intType),
-		_target.callStack,
-		_target.modelExpressions,
-		_target.expression->location(),
+		_target,
+		_target.value > smt::maxValue(*intType),
 		2661_error,
 		8065_error,
 		"Overflow (resulting value larger than " + formatNumberReadable(intType->maxValue()) + ")",
@@ -825,10 +954,8 @@ void BMC::checkDivByZero(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
-		_target.constraints && (_target.value == 0),
-		_target.callStack,
-		_target.modelExpressions,
-		_target.expression->location(),
+		_target,
+		_target.value == 0,
 		3046_error,
 		5272_error,
 		"Division by zero",
@@ -841,10 +968,8 @@ void BMC::checkBalance(BMCVerificationTarget& _target)
 {
 	solAssert(_target.type == VerificationTargetType::Balance, "");
 	checkCondition(
-		_target.constraints && _target.value,
-		_target.callStack,
-		_target.modelExpressions,
-		_target.expression->location(),
+		_target,
+		_target.value,
 		1236_error,
 		4010_error,
 		"Insufficient funds",
@@ -863,10 +988,8 @@ void BMC::checkAssert(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
-		_target.constraints && !_target.value,
-		_target.callStack,
-		_target.modelExpressions,
-		_target.expression->location(),
+		_target,
+		!_target.value,
 		4661_error,
 		7812_error,
 		"Assertion violation"
@@ -881,13 +1004,16 @@ void BMC::addVerificationTarget(
 {
 	if (!m_settings.targets.has(_type) || (m_currentContract && !shouldAnalyze(*m_currentContract)))
 		return;
+	if (_type == VerificationTargetType::ConstantCondition && m_unrolledLoopDepth > 0)
+		return;
 
 	BMCVerificationTarget target{
 		{
 			_type,
 			_value,
-			currentPathConditions() && m_context.assertions()
+			currentPathConditions()
 		},
+		m_context.assertions(),
 		_expression,
 		m_callStack,
 		modelExpressions()
@@ -901,10 +1027,8 @@ void BMC::addVerificationTarget(
 /// Solving.
 
 void BMC::checkCondition(
-	smtutil::Expression _condition,
-	vector<SMTEncoder::CallStackEntry> const& _callStack,
-	pair<vector<smtutil::Expression>, vector<string>> const& _modelExpressions,
-	SourceLocation const& _location,
+	BMCVerificationTarget const& _target,
+	smtutil::Expression const& _condition,
 	ErrorId _errorHappens,
 	ErrorId _errorMightHappen,
 	string const& _description,
@@ -912,13 +1036,12 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
+	SourceLocation const& location = _target.expression->location();
 
 	vector<smtutil::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
-	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
-	if (_callStack.size())
+	tie(expressionsToEvaluate, expressionNames) = _target.modelExpressions;
+	if (_target.callStack.size())
 		if (_additionalValue)
 		{
 			expressionsToEvaluate.emplace_back(*_additionalValue);
@@ -926,7 +1049,29 @@ void BMC::checkCondition(
 		}
 	smtutil::CheckResult result;
 	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+	tie(result, values) = checkSatisfiableAndGenerateModel(
+		*_target.expression,
+		_target.constraints,
+		_target.assertions,
+		_condition,
+		expressionsToEvaluate
+	);
+
+	if (result == smtutil::CheckResult::UNKNOWN && m_budget.limited() && !m_retrying)
+	{
+		m_retries.emplace_back([=, &_target]() {
+			checkCondition(
+				_target,
+				_condition,
+				_errorHappens,
+				_errorMightHappen,
+				_description,
+				_additionalValueName,
+				_additionalValue
+			);
+		});
+		return;
+	}
 
 	string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
@@ -947,7 +1092,7 @@ void BMC::checkCondition(
 	{
 	case smtutil::CheckResult::SATISFIABLE:
 	{
-		solAssert(!_callStack.empty(), "");
+		solAssert(!_target.callStack.empty(), "");
 		std::ostringstream message;
 		message << "BMC: " << _description << " happens here.";
 
@@ -967,10 +1112,10 @@ void BMC::checkCondition(
 
 		m_errorReporter.warning(
 			_errorHappens,
-			_location,
+			location,
 			message.str(),
 			SecondarySourceLocation().append(modelMessage.str(), SourceLocation{})
-			.append(SMTEncoder::callStackMessage(_callStack))
+			.append(SMTEncoder::callStackMessage(_target.callStack))
 			.append(move(secondaryLocation))
 		);
 		break;
@@ -981,23 +1126,22 @@ void BMC::checkCondition(
 	{
 		++m_unprovedAmt;
 		if (m_settings.showUnproved)
-			m_errorReporter.warning(_errorMightHappen, _location, "BMC: " + _description + " might happen here.", secondaryLocation);
+			m_errorReporter.warning(_errorMightHappen, location, "BMC: " + _description + " might happen here.", secondaryLocation);
 		break;
 	}
 	case smtutil::CheckResult::CONFLICTING:
-		m_errorReporter.warning(1584_error, _location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		m_errorReporter.warning(1584_error, location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
 		break;
 	case smtutil::CheckResult::ERROR:
-		m_errorReporter.warning(1823_error, _location, "BMC: Error trying to invoke SMT solver.");
+		m_errorReporter.warning(1823_error, location, "BMC: Error trying to invoke SMT solver.");
 		break;
 	}
-
-	m_interface->pop();
 }
 
 void BMC::checkBooleanNotConstant(
 	Expression const& _condition,
-	smtutil::Expression const& _constraints,
+	smtutil::Expression const& _pathConditions,
+	smtutil::Expression const& _assertions,
 	smtutil::Expression const& _value,
 	vector<SMTEncoder::CallStackEntry> const& _callStack
 )
@@ -1006,15 +1150,8 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && _value);
-	auto positiveResult = checkSatisfiable();
-	m_interface->pop();
-
-	m_interface->push();
-	m_interface->addAssertion(_constraints && !_value);
-	auto negatedResult = checkSatisfiable();
-	m_interface->pop();
+	auto positiveResult = checkSatisfiable(_condition, _pathConditions, _assertions, _value);
+	auto negatedResult = checkSatisfiable(_condition, _pathConditions, _assertions, !_value);
 
 	if (positiveResult == smtutil::CheckResult::ERROR || negatedResult == smtutil::CheckResult::ERROR)
 		m_errorReporter.warning(8592_error, _condition.location(), "BMC: Error trying to invoke SMT solver.");
@@ -1053,14 +1190,58 @@ void BMC::checkBooleanNotConstant(
 	}
 }
 
-pair<smtutil::CheckResult, vector<string>>
-BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expressionsToEvaluate)
+pair<smtutil::CheckResult, vector<string>> BMC::checkSatisfiableAndGenerateModel(
+	Expression const& _target,
+	smtutil::Expression const& _pathConditions,
+	smtutil::Expression const& _assertions,
+	smtutil::Expression const& _condition,
+	vector<smtutil::Expression> const& _expressionsToEvaluate
+)
 {
+	// The assertions are accumulated as `newest && older`, so the conjuncts shared by the targets
+	// of a function are found by following the second operands, and are ordered from the oldest.
+	vector<smtutil::Expression> assertionConjuncts;
+	smtutil::Expression const* conjunction = &_assertions;
+	while (conjunction->name == "and" && conjunction->arguments.size() == 2)
+	{
+		assertionConjuncts.push_back(conjunction->arguments[0]);
+		conjunction = &conjunction->arguments[1];
+	}
+	assertionConjuncts.push_back(*conjunction);
+	reverse(assertionConjuncts.begin(), assertionConjuncts.end());
+
+	if (m_budget.exhausted())
+		return {smtutil::CheckResult::UNKNOWN, {}};
+	if (m_budget.limited())
+		m_interface->setTimeout(m_budget.queryTimeout(m_settings.timeout, m_retrying));
+	auto const start = chrono::steady_clock::now();
+
 	smtutil::CheckResult result;
 	vector<string> values;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		// The target is first checked only against the assertions it depends on. If they already
+		// rule the target out, so do all assertions. Otherwise, the full query is needed, since
+		// the other assertions can make the target unreachable, and to obtain the counterexample.
+		smtutil::Expression target = _pathConditions && _condition;
+		vector<smtutil::Expression> slice = smtutil::sliceConjuncts(assertionConjuncts, target);
+		size_t const dropped = assertionConjuncts.size() - slice.size();
+		if (dropped > 0)
+		{
+			if (m_timings)
+				m_timings->recordChange("modelChecking.bmc.slicedAssertions", true, -static_cast<int64_t>(dropped));
+			smtutil::Expression slicedAssertions(true);
+			for (smtutil::Expression const& conjunct: slice)
+				slicedAssertions = conjunct && slicedAssertions;
+			result = m_interface->checkWithPrefix(slicedAssertions && target, slice, target, {}).first;
+		}
+		if (dropped == 0 || result != smtutil::CheckResult::UNSATISFIABLE)
+			tie(result, values) = m_interface->checkWithPrefix(
+				(_pathConditions && _assertions) && _condition,
+				assertionConjuncts,
+				target,
+				_expressionsToEvaluate
+			);
 	}
 	catch (smtutil::SolverError const& _e)
 	{
@@ -1071,6 +1252,9 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 		result = smtutil::CheckResult::ERROR;
 	}
 
+	if (m_budget.limited())
+		m_solvingTimes[&_target] += chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+
 	for (string& value: values)
 	{
 		try
@@ -1084,9 +1268,14 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 	return make_pair(result, values);
 }
 
-smtutil::CheckResult BMC::checkSatisfiable()
+smtutil::CheckResult BMC::checkSatisfiable(
+	Expression const& _target,
+	smtutil::Expression const& _pathConditions,
+	smtutil::Expression const& _assertions,
+	smtutil::Expression const& _condition
+)
 {
-	return checkSatisfiableAndGenerateModel({}).first;
+	return checkSatisfiableAndGenerateModel(_target, _pathConditions, _assertions, _condition, {}).first;
 }
 
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
@@ -32,12 +32,16 @@
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/SMTEncoder.h>
+#include <libsolidity/formal/SolverBudget.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/SolverInterface.h>
+#include <libsolutil/Timing.h>
 #include <liblangutil/UniqueErrorReporter.h>
 
+#include <chrono>
+#include <functional>
 #include <set>
 #include <string>
 #include <vector>
@@ -63,7 +67,9 @@ public:
 		std::map<h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings const& _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		SolverBudget const& _budget,
+		langutil::CharStreamProvider const& _charStreamProvider,
+		size_t _parallelism = 1
 	);
 
 	void analyze(SourceUnit const& _sources, std::map<ASTNode const*, std::set<VerificationTargetType>, smt::EncodingContext::IdCompare> _solvedTargets);
@@ -73,6 +79,9 @@ public:
 	/// the constructor.
 	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
 
+	/// Records how many assertions were dropped from the queries in @a _timings, if not null.
+	void setTimings(util::TimingCollector* _timings) { m_timings = _timings; }
+
 	/// @returns true if _funCall should be inlined, otherwise false.
 	/// @param _scopeContract The contract that contains the current function being analyzed.
 	/// @param _contextContract The most derived contract, currently being analyzed.
@@ -103,6 +112,22 @@ private:
 
 	/// Visitor helpers.
 	//@{
+	/// Encodes the loop by erasing the knowledge about the variables it touches and
+	/// executing its body once.
+	void encodeLoop(WhileStatement const& _node, bool _isDoWhile);
+	void encodeLoop(ForStatement const& _node);
+	/// Unrolls the loop with the given condition, body and loop expression for the iterations
+	/// given in the settings, starting from the current state.
+	/// Only loops whose condition does not assign to variables and whose body does not contain
+	/// break, continue or return are unrolled.
+	/// @returns the condition under which the loop runs longer than that, or nullopt if the loop
+	/// is not unrolled.
+	std::optional<smtutil::Expression> unrollLoop(
+		Expression const* _condition,
+		Statement const& _body,
+		ExpressionStatement const* _loopExpression,
+		bool _isDoWhile
+	);
 	void visitAssert(FunctionCall const& _funCall);
 	void visitRequire(FunctionCall const& _funCall);
 	void visitAddMulMod(FunctionCall const& _funCall) override;
@@ -130,8 +155,11 @@ private:
 
 	/// Verification targets.
 	//@{
+	/// The constraints of a target are its path conditions, which are checked together
+	/// with the assertions of the encoding at the point where the target was created.
 	struct BMCVerificationTarget: VerificationTarget
 	{
+		smtutil::Expression assertions;
 		Expression const* expression;
 		std::vector<CallStackEntry> callStack;
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> modelExpressions;
@@ -154,12 +182,12 @@ private:
 
 	/// Solver related.
 	//@{
-	/// Check that a condition can be satisfied.
+	/// Check that a condition can be satisfied under the constraints of the target @a _target.
+	/// If the budget is limited and the condition could not be decided in the first pass,
+	/// the check is repeated in the second pass instead of being reported.
 	void checkCondition(
-		smtutil::Expression _condition,
-		std::vector<CallStackEntry> const& _callStack,
-		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> const& _modelExpressions,
-		langutil::SourceLocation const& _location,
+		BMCVerificationTarget const& _target,
+		smtutil::Expression const& _condition,
 		langutil::ErrorId _errorHappens,
 		langutil::ErrorId _errorMightHappen,
 		std::string const& _description,
@@ -170,22 +198,52 @@ private:
 	/// is a literal constant.
 	void checkBooleanNotConstant(
 		Expression const& _condition,
-		smtutil::Expression const& _constraints,
+		smtutil::Expression const& _pathConditions,
+		smtutil::Expression const& _assertions,
 		smtutil::Expression const& _value,
 		std::vector<CallStackEntry> const& _callStack
 	);
-	std::pair<smtutil::CheckResult, std::vector<std::string>>
-	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
+	/// Checks whether @a _condition can hold under @a _pathConditions and @a _assertions.
+	/// Incremental solvers keep the conjuncts of @a _assertions asserted between checks,
+	/// so that the targets of a function do not assert their shared assertions again.
+	/// The solving time is attributed to @a _target. If the budget is exhausted,
+	/// the solver is not queried and the result is unknown.
+	std::pair<smtutil::CheckResult, std::vector<std::string>> checkSatisfiableAndGenerateModel(
+		Expression const& _target,
+		smtutil::Expression const& _pathConditions,
+		smtutil::Expression const& _assertions,
+		smtutil::Expression const& _condition,
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate
+	);
 
-	smtutil::CheckResult checkSatisfiable();
+	smtutil::CheckResult checkSatisfiable(
+		Expression const& _target,
+		smtutil::Expression const& _pathConditions,
+		smtutil::Expression const& _assertions,
+		smtutil::Expression const& _condition
+	);
 	//@}
 
 	std::unique_ptr<smtutil::SolverInterface> m_interface;
 
+	SolverBudget const& m_budget;
+	/// Whether the targets are checked in the second pass of a limited budget.
+	bool m_retrying = false;
+	/// Checks of the current targets to repeat in the second pass.
+	std::vector<std::function<void()>> m_retries;
+	/// Time spent solving the queries of each target, only measured if the budget is limited.
+	std::map<ASTNode const*, std::chrono::milliseconds, smt::EncodingContext::IdCompare> m_solvingTimes;
+
 	/// Flags used for better warning messages.
 	bool m_loopExecutionHappened = false;
 	bool m_externalFunctionCallHappened = false;
 
+	util::TimingCollector* m_timings = nullptr;
+
+	/// Number of unrolled loops the current node is in. Constant conditions are not reported
+	/// there, since a condition can be constant in each iteration without being constant in all.
+	unsigned m_unrolledLoopDepth = 0;
+
 	std::vector<BMCVerificationTarget> m_verificationTargets;
 
 	/// Targets that were already proven.
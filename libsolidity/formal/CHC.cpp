@@ -31,8 +31,11 @@
 #include <libsolidity/ast/TypeProvider.h>
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
+#include <libsmtutil/QueryCache.h>
 #include <liblangutil/CharStreamProvider.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Timing.h>
 
 #ifdef HAVE_Z3_DLOPEN
 #include <z3_version.h>
@@ -62,9 +65,13 @@ CHC::CHC(
 	[[maybe_unused]] map<util::h256, string> const& _smtlib2Responses,
 	[[maybe_unused]] ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings const& _settings,
-	CharStreamProvider const& _charStreamProvider
+	SolverBudget const& _budget,
+	CharStreamProvider const& _charStreamProvider,
+	size_t _parallelism
 ):
-	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider)
+	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider),
+	m_parallelism(_parallelism),
+	m_budget(_budget)
 {
 	bool usesZ3 = m_settings.solvers.z3;
 #ifdef HAVE_Z3
@@ -72,8 +79,18 @@ CHC::CHC(
 #else
 	usesZ3 = false;
 #endif
+	if (m_settings.queryCacheDirectory)
+		m_queryCache = make_shared<QueryCache>(*m_settings.queryCacheDirectory, m_settings.queryCacheMode);
 	if (!usesZ3 && m_settings.solvers.smtlib2)
-		m_interface = make_unique<CHCSmtLib2Interface>(_smtlib2Responses, _smtCallback, m_settings.timeout);
+	{
+		m_interface = make_unique<CHCSmtLib2Interface>(
+			_smtlib2Responses,
+			_smtCallback,
+			m_budget.solverTimeout(m_settings.timeout),
+			m_settings.externalSolver
+		);
+		m_interface->setQueryCache(m_queryCache);
+	}
 }
 
 void CHC::analyze(SourceUnit const& _source)
@@ -996,9 +1013,12 @@ void CHC::resetSourceAnalysis()
 	if (usesZ3)
 	{
 		/// z3::fixedpoint does not have a reset mechanism, so we need to create another.
-		m_interface = std::make_unique<Z3CHCInterface>(m_settings.timeout);
-		auto z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+		m_interface = std::make_unique<Z3CHCInterface>(m_budget.solverTimeout(m_settings.timeout));
+		m_interface->setQueryCache(m_queryCache);
+		auto z3Interface = dynamic_cast<Z3CHCInterface*>(m_interface.get());
 		solAssert(z3Interface, "");
+		if (m_settings.reuseInvariants)
+			z3Interface->setLemmaStore(Z3LemmaStore::shared());
 		m_context.setSolver(z3Interface->z3Interface());
 	}
 #endif
@@ -1534,38 +1554,50 @@ void CHC::addRule(smtutil::Expression const& _rule, string const& _ruleName)
 
 tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
 {
+	auto queryResult = solve(*m_interface, _query);
+	reportSolverProblems(get<0>(queryResult), _location);
+	return queryResult;
+}
+
+tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::solve(
+	CHCSolverInterface& _solver,
+	smtutil::Expression const& _query
+) const
+{
+	util::ScopedTraceSpan span("CHC query", "smt");
 	CheckResult result;
 	smtutil::Expression invariant(true);
 	CHCSolverInterface::CexGraph cex;
-	tie(result, invariant, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
-	{
+	tie(result, invariant, cex) = _solver.query(_query);
 #ifdef HAVE_Z3
-		if (m_settings.solvers.z3)
-		{
-			// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
-			// We now disable those optimizations and check whether we can still solve the problem.
-			auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
-			solAssert(spacer, "");
-			spacer->setSpacerOptions(false);
+	if (result == CheckResult::SATISFIABLE && m_settings.solvers.z3)
+	{
+		// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
+		// We now disable those optimizations and check whether we can still solve the problem.
+		auto* spacer = dynamic_cast<Z3CHCInterface*>(&_solver);
+		solAssert(spacer, "");
+		spacer->setSpacerOptions(false);
 
-			CheckResult resultNoOpt;
-			smtutil::Expression invariantNoOpt(true);
-			CHCSolverInterface::CexGraph cexNoOpt;
-			tie(resultNoOpt, invariantNoOpt, cexNoOpt) = m_interface->query(_query);
+		CheckResult resultNoOpt;
+		smtutil::Expression invariantNoOpt(true);
+		CHCSolverInterface::CexGraph cexNoOpt;
+		tie(resultNoOpt, invariantNoOpt, cexNoOpt) = _solver.query(_query);
 
-			if (resultNoOpt == CheckResult::SATISFIABLE)
-				cex = move(cexNoOpt);
+		if (resultNoOpt == CheckResult::SATISFIABLE)
+			cex = move(cexNoOpt);
 
-			spacer->setSpacerOptions(true);
-		}
-#endif
-		break;
+		spacer->setSpacerOptions(true);
 	}
+#endif
+	return {result, invariant, cex};
+}
+
+void CHC::reportSolverProblems(CheckResult _result, langutil::SourceLocation const& _location)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE:
 	case CheckResult::UNSATISFIABLE:
-		break;
 	case CheckResult::UNKNOWN:
 		break;
 	case CheckResult::CONFLICTING:
@@ -1575,7 +1607,6 @@ tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query
 		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
 		break;
 	}
-	return {result, invariant, cex};
 }
 
 void CHC::verificationTargetEncountered(
@@ -1633,6 +1664,7 @@ void CHC::checkVerificationTargets()
 	}
 
 	set<unsigned> checkedErrorIds;
+	vector<CHCTargetCheck> checks;
 	for (auto const& [targetId, placeholders]: targetEntryPoints)
 	{
 		string errorType;
@@ -1687,9 +1719,14 @@ void CHC::checkVerificationTargets()
 		else
 			solAssert(false, "");
 
-		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		checks.push_back({target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here."});
 		checkedErrorIds.insert(target.errorId);
 	}
+	if (m_budget.limited())
+		checkAndReportTargetsWithinBudget(checks);
+	else if (!checkAndReportTargetsInParallel(checks))
+		for (CHCTargetCheck const& check: checks)
+			checkAndReportTarget(check);
 
 	auto toReport = m_unsafeTargets;
 	if (m_settings.showUnproved)
@@ -1717,6 +1754,14 @@ void CHC::checkVerificationTargets()
 			" Consider increasing the timeout per query."
 		);
 
+	for (auto const& [node, time]: m_solvingTimes)
+		m_errorReporter.info(
+			6917_error,
+			node->location(),
+			"CHC: Solving the queries of this target took " + to_string(time.count()) + " ms."
+		);
+	m_solvingTimes.clear();
+
 	if (!m_settings.invariants.invariants.empty())
 	{
 		string msg;
@@ -1778,29 +1823,136 @@ void CHC::checkVerificationTargets()
 		m_safeTargets[m_verificationTargets.at(id).errorNode].insert(m_verificationTargets.at(id).type);
 }
 
-void CHC::checkAndReportTarget(
-	CHCVerificationTarget const& _target,
-	vector<CHCQueryPlaceholder> const& _placeholders,
-	ErrorId _errorReporterId,
-	string _satMsg,
-	string _unknownMsg
-)
+void CHC::checkAndReportTarget(CHCTargetCheck const& _check)
 {
-	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
+	if (isKnownUnsafe(_check.target))
 		return;
 
+	smtutil::Expression errorBlock = addTargetQuery(_check);
+	reportTargetResult(_check, query(errorBlock, _check.target.errorNode->location()), errorBlock);
+}
+
+bool CHC::checkAndReportTargetsInParallel([[maybe_unused]] vector<CHCTargetCheck> const& _checks)
+{
+#ifdef HAVE_Z3
+	auto const* z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+	if (m_parallelism <= 1 || _checks.size() <= 1 || !z3Interface)
+		return false;
+
+	// All queries are added to the Horn system before it is copied, since the copies
+	// can only be made before the system is queried. The additional error blocks do not
+	// change the answers, since they are not reachable from the other error blocks.
+	vector<optional<smtutil::Expression>> errorBlocks;
+	vector<size_t> queried;
+	for (CHCTargetCheck const& check: _checks)
+		if (isKnownUnsafe(check.target))
+			errorBlocks.emplace_back(nullopt);
+		else
+		{
+			queried.push_back(errorBlocks.size());
+			errorBlocks.emplace_back(addTargetQuery(check));
+		}
+
+	vector<tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph>> results(
+		_checks.size(),
+		{CheckResult::ERROR, smtutil::Expression(true), {}}
+	);
+	for (size_t batchStart = 0; batchStart < queried.size(); batchStart += m_parallelism)
+	{
+		size_t const batchSize = min(m_parallelism, queried.size() - batchStart);
+		// Cloning translates the rules from the context of the original interface, which is not thread-safe.
+		vector<unique_ptr<Z3CHCInterface>> solvers;
+		for (size_t i = 0; i < batchSize; ++i)
+			solvers.emplace_back(z3Interface->clone());
+		parallelFor(batchSize, m_parallelism, [&](size_t _index) {
+			size_t const checkIndex = queried[batchStart + _index];
+			results[checkIndex] = solve(*solvers[_index], *errorBlocks[checkIndex]);
+		});
+	}
+
+	// An earlier target with the same node and type can make the query of a target
+	// unnecessary. Its result is then ignored, as if it had not been queried.
+	for (size_t checkIndex: queried)
+		if (!isKnownUnsafe(_checks[checkIndex].target))
+		{
+			reportSolverProblems(get<0>(results[checkIndex]), _checks[checkIndex].target.errorNode->location());
+			reportTargetResult(_checks[checkIndex], results[checkIndex], *errorBlocks[checkIndex]);
+		}
+	return true;
+#else
+	return false;
+#endif
+}
+
+void CHC::checkAndReportTargetsWithinBudget(vector<CHCTargetCheck> const& _checks)
+{
+	// The targets that are not decided with the short timeouts of the first pass
+	// are queried again with longer timeouts, after all other targets.
+	vector<pair<CHCTargetCheck const*, smtutil::Expression>> retries;
+	for (CHCTargetCheck const& check: _checks)
+	{
+		if (isKnownUnsafe(check.target))
+			continue;
+		smtutil::Expression errorBlock = addTargetQuery(check);
+		auto result = queryWithinBudget(check, errorBlock, false);
+		if (get<0>(result) == CheckResult::UNKNOWN)
+			retries.emplace_back(&check, move(errorBlock));
+		else
+			reportTargetResult(check, result, errorBlock);
+	}
+
+	for (auto const& [check, errorBlock]: retries)
+		if (!isKnownUnsafe(check->target))
+			reportTargetResult(*check, queryWithinBudget(*check, errorBlock, true), errorBlock);
+}
+
+tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::queryWithinBudget(
+	CHCTargetCheck const& _check,
+	smtutil::Expression const& _errorBlock,
+	bool _retry
+)
+{
+	if (m_budget.exhausted())
+		return {CheckResult::UNKNOWN, smtutil::Expression(true), {}};
+
+	m_interface->setTimeout(m_budget.queryTimeout(m_settings.timeout, _retry));
+	auto const start = chrono::steady_clock::now();
+	auto result = query(_errorBlock, _check.target.errorNode->location());
+	m_solvingTimes[_check.target.errorNode] += chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+	return result;
+}
+
+bool CHC::isKnownUnsafe(CHCVerificationTarget const& _target) const
+{
+	return m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type);
+}
+
+smtutil::Expression CHC::addTargetQuery(CHCTargetCheck const& _check)
+{
 	createErrorBlock();
-	for (auto const& placeholder: _placeholders)
+	for (auto const& placeholder: _check.placeholders)
 		connectBlocks(
 			placeholder.fromPredicate,
 			error(),
-			placeholder.constraints && placeholder.errorExpression == _target.errorId
+			placeholder.constraints && placeholder.errorExpression == _check.target.errorId
 		);
-	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
+	return error();
+}
+
+void CHC::reportTargetResult(
+	CHCTargetCheck const& _check,
+	tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> const& _queryResult,
+	smtutil::Expression const& _errorBlock
+)
+{
+	auto const& [result, invariant, model] = _queryResult;
+	CHCVerificationTarget const& target = _check.target;
+	auto const& location = target.errorNode->location();
 	if (result == CheckResult::UNSATISFIABLE)
 	{
-		m_safeTargets[_target.errorNode].insert(_target.type);
+		m_safeTargets[target.errorNode].insert(target.type);
+		if (m_settings.invariants.invariants.empty())
+			return;
 		set<Predicate const*> predicates;
 		for (auto const* pred: m_interfaces | ranges::views::values)
 			predicates.insert(pred);
@@ -1812,26 +1964,26 @@ void CHC::checkAndReportTarget(
 	}
 	else if (result == CheckResult::SATISFIABLE)
 	{
-		solAssert(!_satMsg.empty(), "");
-		auto cex = generateCounterexample(model, error().name);
+		solAssert(!_check.satMsg.empty(), "");
+		auto cex = generateCounterexample(model, _errorBlock.name);
 		if (cex)
-			m_unsafeTargets[_target.errorNode][_target.type] = {
-				_errorReporterId,
+			m_unsafeTargets[target.errorNode][target.type] = {
+				_check.errorReporterId,
 				location,
-				"CHC: " + _satMsg + "\nCounterexample:\n" + *cex
+				"CHC: " + _check.satMsg + "\nCounterexample:\n" + *cex
 			};
 		else
-			m_unsafeTargets[_target.errorNode][_target.type] = {
-				_errorReporterId,
+			m_unsafeTargets[target.errorNode][target.type] = {
+				_check.errorReporterId,
 				location,
-				"CHC: " + _satMsg
+				"CHC: " + _check.satMsg
 			};
 	}
-	else if (!_unknownMsg.empty())
-		m_unprovedTargets[_target.errorNode][_target.type] = {
-			_errorReporterId,
+	else if (!_check.unknownMsg.empty())
+		m_unprovedTargets[target.errorNode][target.type] = {
+			_check.errorReporterId,
 			location,
-			"CHC: " + _unknownMsg
+			"CHC: " + _check.unknownMsg
 		};
 }
 
@@ -34,6 +34,7 @@
 #include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/Predicate.h>
 #include <libsolidity/formal/SMTEncoder.h>
+#include <libsolidity/formal/SolverBudget.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
@@ -44,6 +45,7 @@
 
 #include <boost/algorithm/string/join.hpp>
 
+#include <chrono>
 #include <map>
 #include <optional>
 #include <set>
@@ -60,7 +62,9 @@ public:
 		std::map<util::h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings const& _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		SolverBudget const& _budget,
+		langutil::CharStreamProvider const& _charStreamProvider,
+		size_t _parallelism = 1
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -248,6 +252,14 @@ private:
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
 	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// Answers @a _query with @a _solver without reporting anything.
+	/// Only reads the state of this object, so it can be called from several threads.
+	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> solve(
+		smtutil::CHCSolverInterface& _solver,
+		smtutil::Expression const& _query
+	) const;
+	/// Reports a problem of the solvers that led to @a _result.
+	void reportSolverProblems(smtutil::CheckResult _result, langutil::SourceLocation const& _location);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -255,13 +267,34 @@ private:
 	// Forward declarations. Definitions are below.
 	struct CHCVerificationTarget;
 	struct CHCQueryPlaceholder;
+	struct CHCTargetCheck;
 	void checkAssertTarget(ASTNode const* _scope, CHCVerificationTarget const& _target);
-	void checkAndReportTarget(
-		CHCVerificationTarget const& _target,
-		std::vector<CHCQueryPlaceholder> const& _placeholders,
-		langutil::ErrorId _errorReporterId,
-		std::string _satMsg,
-		std::string _unknownMsg = ""
+	void checkAndReportTarget(CHCTargetCheck const& _check);
+	/// Checks and reports @a _checks like checkAndReportTarget, but answers the queries of
+	/// several targets at the same time, each with its own copy of the Horn system.
+	/// @returns false if this is not possible, in which case nothing is done.
+	bool checkAndReportTargetsInParallel(std::vector<CHCTargetCheck> const& _checks);
+	/// Checks and reports @a _checks like checkAndReportTarget within a limited budget,
+	/// querying the targets that could not be decided again in a second pass.
+	void checkAndReportTargetsWithinBudget(std::vector<CHCTargetCheck> const& _checks);
+	/// Queries the reachability of @a _errorBlock with the timeout of the first pass of the budget or,
+	/// if @a _retry is true, of the second one, and adds the solving time to the target of @a _check.
+	/// @returns an unknown result without querying if the budget is exhausted.
+	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> queryWithinBudget(
+		CHCTargetCheck const& _check,
+		smtutil::Expression const& _errorBlock,
+		bool _retry
+	);
+	/// @returns true if a counterexample for the node and the type of @a _target is already known.
+	bool isKnownUnsafe(CHCVerificationTarget const& _target) const;
+	/// Adds the rules that reach a new error block from every placeholder of @a _check.
+	/// @returns the error block, whose reachability is the query of the target.
+	smtutil::Expression addTargetQuery(CHCTargetCheck const& _check);
+	/// Records the result of the query of @a _check, where @a _errorBlock is the queried error block.
+	void reportTargetResult(
+		CHCTargetCheck const& _check,
+		std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> const& _queryResult,
+		smtutil::Expression const& _errorBlock
 	);
 
 	std::optional<std::string> generateCounterexample(smtutil::CHCSolverInterface::CexGraph const& _graph, std::string const& _root);
@@ -367,6 +400,16 @@ private:
 	/// A placeholder is created for each possible context of a function (e.g. multiple contracts in contract inheritance hierarchy).
 	std::map<ASTNode const*, std::vector<CHCQueryPlaceholder>, smt::EncodingContext::IdCompare> m_queryPlaceholders;
 
+	/// A verification target together with all its query placeholders and the messages to report.
+	struct CHCTargetCheck
+	{
+		CHCVerificationTarget const& target;
+		std::vector<CHCQueryPlaceholder> const& placeholders;
+		langutil::ErrorId errorReporterId;
+		std::string satMsg;
+		std::string unknownMsg;
+	};
+
 	/// Records verification conditions IDs per function encountered during an analysis of that function.
 	/// The key is the ASTNode of the function where the verification condition has been encountered,
 	/// or the ASTNode of the contract if the verification condition happens inside an implicit constructor.
@@ -421,6 +464,18 @@ private:
 
 	/// CHC solver.
 	std::unique_ptr<smtutil::CHCSolverInterface> m_interface;
+
+	/// Maximum number of queries of verification targets that are answered at the same time.
+	/// The queries are answered one at a time if the budget is limited.
+	size_t m_parallelism = 1;
+
+	SolverBudget const& m_budget;
+	/// Time spent solving the queries of each target, only measured if the budget is limited.
+	std::map<ASTNode const*, std::chrono::milliseconds, smt::EncodingContext::IdCompare> m_solvingTimes;
+
+	/// Cache of the responses of the solvers, which is null if it is disabled
+	/// or if invariants are requested, since they are not cached.
+	std::shared_ptr<smtutil::QueryCache const> m_queryCache;
 };
 
 }
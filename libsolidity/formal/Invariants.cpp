@@ -45,6 +45,8 @@ map<Predicate const*, set<string>> collectInvariants(
 		targets.insert("interface_");
 	if (_invariantsSetting.has(InvariantType::Reentrancy))
 		targets.insert("nondet_interface_");
+	if (targets.empty())
+		return {};
 
 	map<string, pair<smtutil::Expression, smtutil::Expression>> equalities;
 	// Collect equalities where one of the sides is a predicate we're interested in.
@@ -52,12 +54,13 @@ map<Predicate const*, set<string>> collectInvariants(
 		if (_expr->name == "=")
 			for (auto const& t: targets)
 			{
-				auto arg0 = _expr->arguments.at(0);
-				auto arg1 = _expr->arguments.at(1);
+				// The sides are only copied if they are stored, since they can be large expressions.
+				auto const& arg0 = _expr->arguments.at(0);
+				auto const& arg1 = _expr->arguments.at(1);
 				if (starts_with(arg0.name, t))
-					equalities.insert({arg0.name, {arg0, move(arg1)}});
+					equalities.insert({arg0.name, {arg0, arg1}});
 				else if (starts_with(arg1.name, t))
-					equalities.insert({arg1.name, {arg1, move(arg0)}});
+					equalities.insert({arg1.name, {arg1, arg0}});
 			}
 		for (auto const& arg: _expr->arguments)
 			_addChild(&arg);
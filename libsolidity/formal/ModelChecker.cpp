@@ -21,9 +21,18 @@
 #include <libsmtutil/Z3Interface.h>
 #endif
 
+#include <libsolidity/ast/TypeProvider.h>
+
+#include <libsmtutil/SolverProcess.h>
+
+#include <libsolutil/Common.h>
+#include <libsolutil/Parallel.h>
+
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view.hpp>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -35,16 +44,29 @@ ModelChecker::ModelChecker(
 	langutil::CharStreamProvider const& _charStreamProvider,
 	map<h256, string> const& _smtlib2Responses,
 	ModelCheckerSettings _settings,
-	ReadCallback::Callback const& _smtCallback
+	ReadCallback::Callback const& _smtCallback,
+	size_t _parallelism
 ):
 	m_errorReporter(_errorReporter),
 	m_settings(move(_settings)),
-	m_context(),
-	m_bmc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider),
-	m_chc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider)
+	m_charStreamProvider(_charStreamProvider),
+	m_smtlib2Responses(_smtlib2Responses),
+	m_smtCallback(_smtCallback),
+	m_parallelism(_parallelism),
+	m_budget(m_settings.totalTimeout),
+	m_context()
 {
 }
 
+void ModelChecker::createEngines()
+{
+	if (m_bmc)
+		return;
+	m_bmc = make_unique<BMC>(m_context, m_uniqueErrorReporter, m_smtlib2Responses, m_smtCallback, m_settings, m_budget, m_charStreamProvider, m_parallelism);
+	m_chc = make_unique<CHC>(m_context, m_uniqueErrorReporter, m_smtlib2Responses, m_smtCallback, m_settings, m_budget, m_charStreamProvider, m_parallelism);
+	m_bmc->setTimings(m_timings);
+}
+
 // TODO This should be removed for 0.9.0.
 void ModelChecker::enableAllEnginesIfPragmaPresent(vector<shared_ptr<SourceUnit>> const& _sources)
 {
@@ -116,23 +138,114 @@ void ModelChecker::analyze(SourceUnit const& _source)
 	if (m_settings.engine.none())
 		return;
 
+	createEngines();
 	if (m_settings.engine.chc)
-		m_chc.analyze(_source);
+	{
+		util::ScopedTimer timer(m_timings, "modelChecking.chc", true);
+		m_chc->analyze(_source);
+	}
 
-	auto solvedTargets = m_chc.safeTargets();
-	for (auto const& [node, targets]: m_chc.unsafeTargets())
+	auto solvedTargets = m_chc->safeTargets();
+	for (auto const& [node, targets]: m_chc->unsafeTargets())
 		solvedTargets[node] += targets | ranges::views::keys;
 
 	if (m_settings.engine.bmc)
-		m_bmc.analyze(_source, solvedTargets);
+	{
+		util::ScopedTimer timer(m_timings, "modelChecking.bmc", true);
+		m_bmc->analyze(_source, solvedTargets);
+	}
+
+	m_errorReporter.append(m_uniqueErrorReporter.errors());
+	m_uniqueErrorReporter.clear();
+}
+
+void ModelChecker::analyze(vector<SourceUnit const*> const& _sources)
+{
+	if (
+		m_settings.engine.any() &&
+		m_settings.solvers.smtlib2 &&
+		m_settings.externalSolver &&
+		!smtutil::SolverProcess::available(*m_settings.externalSolver)
+	)
+		m_uniqueErrorReporter.warning(
+			2758_error,
+			SourceLocation(),
+			"The external SMT solver \"" + *m_settings.externalSolver + "\" was not found. "
+			"The SMT-LIB2 queries will not be answered by it."
+		);
+
+	// Each job analyzes a source from the perspective of a single contract,
+	// or from none if no contract of the source is analyzed.
+	vector<pair<SourceUnit const*, ContractDefinition const*>> jobs;
+	for (SourceUnit const* source: _sources)
+	{
+		size_t const jobsBefore = jobs.size();
+		for (auto const* contract: ASTNode::filteredNodes<ContractDefinition>(source->nodes()))
+			if (shouldAnalyze(*contract))
+				jobs.emplace_back(source, contract);
+		if (jobs.size() == jobsBefore)
+			jobs.emplace_back(source, nullptr);
+	}
+
+	if (m_parallelism <= 1 || jobs.size() <= 1 || m_settings.engine.none())
+	{
+		for (SourceUnit const* source: _sources)
+			analyze(*source);
+		return;
+	}
 
+	// The callback is not required to be thread-safe.
+	mutex callbackMutex;
+	ReadCallback::Callback smtCallback;
+	if (m_smtCallback)
+		smtCallback = [&](string const& _kind, string const& _query) {
+			lock_guard<mutex> lock(callbackMutex);
+			return m_smtCallback(_kind, _query);
+		};
+
+	TypeProvider* typeProvider = TypeProvider::current();
+	vector<ErrorList> jobErrors(jobs.size());
+	vector<vector<string>> jobUnhandledQueries(jobs.size());
+	parallelFor(jobs.size(), m_parallelism, [&](size_t _index) {
+		auto const& [source, contract] = jobs[_index];
+		TypeProvider* previousTypeProvider = TypeProvider::setCurrent(typeProvider);
+		ScopeGuard restoreTypeProvider([&]() { TypeProvider::setCurrent(previousTypeProvider); });
+
+		ModelCheckerSettings settings = m_settings;
+		if (contract)
+			settings.contracts.contracts = {{contract->sourceUnitName(), {contract->name()}}};
+		// The jobs share the rest of the budget, which is measured from the start of each job.
+		if (m_budget.limited())
+			settings.totalTimeout = m_budget.remaining();
+		ErrorReporter errorReporter(jobErrors[_index]);
+		ModelChecker checker(errorReporter, m_charStreamProvider, m_smtlib2Responses, move(settings), smtCallback);
+		checker.setTimings(m_timings);
+		checker.analyze(*source);
+		jobUnhandledQueries[_index] = checker.unhandledQueries();
+	});
+
+	for (size_t index = 0; index < jobs.size(); ++index)
+	{
+		m_uniqueErrorReporter.append(jobErrors[index]);
+		m_unhandledQueries += jobUnhandledQueries[index];
+	}
 	m_errorReporter.append(m_uniqueErrorReporter.errors());
 	m_uniqueErrorReporter.clear();
 }
 
 vector<string> ModelChecker::unhandledQueries()
 {
-	return m_bmc.unhandledQueries() + m_chc.unhandledQueries();
+	if (!m_bmc)
+		return m_unhandledQueries;
+	return m_bmc->unhandledQueries() + m_chc->unhandledQueries() + m_unhandledQueries;
+}
+
+bool ModelChecker::shouldAnalyze(ContractDefinition const& _contract) const
+{
+	return _contract.canBeDeployed() && (
+		m_settings.contracts.isDefault() ||
+		m_settings.contracts.has(_contract.sourceUnitName(), _contract.name())
+	);
 }
 
 solidity::smtutil::SMTSolverChoice ModelChecker::availableSolvers()
@@ -27,14 +27,19 @@
 #include <libsolidity/formal/CHC.h>
 #include <libsolidity/formal/EncodingContext.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/formal/SolverBudget.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <libsolutil/Timing.h>
+
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/UniqueErrorReporter.h>
 
+#include <memory>
+
 namespace solidity::langutil
 {
 class ErrorReporter;
@@ -49,12 +54,16 @@ class ModelChecker
 public:
 	/// @param _enabledSolvers represents a runtime choice of which SMT solvers
 	/// should be used, even if all are available. The default choice is to use all.
+	/// @param _parallelism is the maximum number of threads used to analyze different contracts.
+	/// If only a single contract is analyzed, it is the maximum number of threads used by the solvers
+	/// of the BMC engine for a query and by the CHC engine for the queries of different verification targets.
 	ModelChecker(
 		langutil::ErrorReporter& _errorReporter,
 		langutil::CharStreamProvider const& _charStreamProvider,
 		std::map<solidity::util::h256, std::string> const& _smtlib2Responses,
 		ModelCheckerSettings _settings = ModelCheckerSettings{},
-		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback()
+		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback(),
+		size_t _parallelism = 1
 	);
 
 	// TODO This should be removed for 0.9.0.
@@ -64,8 +73,19 @@ public:
 	/// do not exist.
 	void checkRequestedSourcesAndContracts(std::vector<std::shared_ptr<SourceUnit>> const& _sources);
 
+	/// Records the time spent in the CHC and BMC engines in @a _timings, if not null.
+	void setTimings(util::TimingCollector* _timings) { m_timings = _timings; }
+
 	void analyze(SourceUnit const& _sources);
 
+	/// Analyzes @a _sources in the given order.
+	/// If the parallelism is larger than one and there are several contracts to analyze,
+	/// each contract is analyzed on its own thread, with its own encoding context and solvers.
+	/// The warnings are then reported in the order of the sources and contracts, without duplicates.
+	/// Since the engines do not share knowledge between contracts in that case, the results can
+	/// differ from a sequential analysis of the sources.
+	void analyze(std::vector<SourceUnit const*> const& _sources);
+
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
@@ -75,6 +95,14 @@ public:
 	static smtutil::SMTSolverChoice availableSolvers();
 
 private:
+	/// Creates the engines and with them the solvers, unless already done.
+	/// This is delayed until a source is analyzed with an enabled engine, so that compilations
+	/// without model checking neither load nor set up any solver.
+	void createEngines();
+
+	/// @returns true if the contract @a _contract is analyzed as the most derived contract.
+	bool shouldAnalyze(ContractDefinition const& _contract) const;
+
 	/// Error reporter from CompilerStack.
 	/// We need to append m_uniqueErrorReporter
 	/// to this one when the analysis is done.
@@ -87,14 +115,26 @@ private:
 
 	ModelCheckerSettings m_settings;
 
+	langutil::CharStreamProvider const& m_charStreamProvider;
+	std::map<solidity::util::h256, std::string> const& m_smtlib2Responses;
+	ReadCallback::Callback m_smtCallback;
+	size_t m_parallelism;
+	util::TimingCollector* m_timings = nullptr;
+
+	/// Queries that were not answered in the contracts analyzed on separate threads.
+	std::vector<std::string> m_unhandledQueries;
+
+	/// Time that BMC and CHC may spend solving, measured from the construction.
+	SolverBudget m_budget;
+
 	/// Stores the context of the encoding.
 	smt::EncodingContext m_context;
 
 	/// Bounded Model Checker engine.
-	BMC m_bmc;
+	std::unique_ptr<BMC> m_bmc;
 
 	/// Constrained Horn Clauses engine.
-	CHC m_chc;
+	std::unique_ptr<CHC> m_chc;
 };
 
 }
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 
 #include <optional>
@@ -156,6 +157,24 @@ struct ModelCheckerSettings
 	smtutil::SMTSolverChoice solvers = smtutil::SMTSolverChoice::All();
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
 	std::optional<unsigned> timeout;
+	/// Directory in which the responses of the solvers are cached across compiler invocations.
+	/// No responses are cached if it is not set.
+	std::optional<std::string> queryCacheDirectory;
+	/// Whether the responses in the cache are used and new responses are added to it.
+	smtutil::QueryCache::Mode queryCacheMode = smtutil::QueryCache::Mode::ReadWrite;
+	/// Command that starts an SMT solver reading SMT-LIB2 from its standard input, which
+	/// answers the queries of the SMT-LIB2 solver instead of the SMT query callback.
+	std::optional<std::string> externalSolver;
+	/// Wall-clock time in milliseconds that the analysis may spend solving queries.
+	/// If it is set, the verification targets are checked in two passes with adaptive
+	/// timeouts per query and the solving time of each target is reported.
+	std::optional<unsigned> totalTimeout;
+	/// Whether the CHC engine reuses the invariants that Z3 found in earlier analyses of this process
+	/// as lemmas, if they are still inductive.
+	bool reuseInvariants = false;
+	/// Number of iterations for which the BMC engine unrolls loops instead of erasing the
+	/// knowledge about the variables they touch. Loops are not unrolled if it is not set or zero.
+	std::optional<unsigned> bmcLoopIterations;
 
 	bool operator!=(ModelCheckerSettings const& _other) const noexcept { return !(*this == _other); }
 	bool operator==(ModelCheckerSettings const& _other) const noexcept
@@ -168,7 +187,13 @@ struct ModelCheckerSettings
 			showUnproved == _other.showUnproved &&
 			solvers == _other.solvers &&
 			targets == _other.targets &&
-			timeout == _other.timeout;
+			timeout == _other.timeout &&
+			queryCacheDirectory == _other.queryCacheDirectory &&
+			queryCacheMode == _other.queryCacheMode &&
+			externalSolver == _other.externalSolver &&
+			totalTimeout == _other.totalTimeout &&
+			reuseInvariants == _other.reuseInvariants &&
+			bmcLoopIterations == _other.bmcLoopIterations;
 	}
 };
 
@@ -2409,19 +2409,13 @@ Type const* SMTEncoder::typeWithoutPointer(Type const* _type)
 
 void SMTEncoder::mergeVariables(smtutil::Expression const& _condition, VariableIndices const& _indicesEndTrue, VariableIndices const& _indicesEndFalse)
 {
-	for (auto const& entry: _indicesEndTrue)
-	{
-		VariableDeclaration const* var = entry.first;
-		auto trueIndex = entry.second;
-		if (_indicesEndFalse.count(var) && _indicesEndFalse.at(var) != trueIndex)
-		{
+	for (auto const& [var, trueIndex]: _indicesEndTrue)
+		if (auto falseIndex = _indicesEndFalse.find(var); falseIndex != _indicesEndFalse.end() && falseIndex->second != trueIndex)
 			m_context.addAssertion(m_context.newValue(*var) == smtutil::Expression::ite(
 				_condition,
 				valueAtIndex(*var, trueIndex),
-				valueAtIndex(*var, _indicesEndFalse.at(var)))
+				valueAtIndex(*var, falseIndex->second))
 			);
-		}
-	}
 }
 
 smtutil::Expression SMTEncoder::currentValue(VariableDeclaration const& _decl) const
@@ -2589,6 +2583,7 @@ ContractDefinition const* SMTEncoder::currentScopeContract()
 SMTEncoder::VariableIndices SMTEncoder::copyVariableIndices()
 {
 	VariableIndices indices;
+	indices.reserve(m_context.variables().size());
 	for (auto const& var: m_context.variables())
 		indices.emplace(var.first, var.second->index());
 	return indices;
@@ -2596,8 +2591,11 @@ SMTEncoder::VariableIndices SMTEncoder::copyVariableIndices()
 
 void SMTEncoder::resetVariableIndices(VariableIndices const& _indices)
 {
-	for (auto const& var: _indices)
-		m_context.variable(*var.first)->setIndex(var.second);
+	// Most variables are not touched by a branch, and setting their index would only create
+	// the expression of their current value again.
+	for (auto const& [var, index]: _indices)
+		if (auto variable = m_context.variable(*var); variable->index() != index)
+			variable->setIndex(index);
 }
 
 void SMTEncoder::clearIndices(ContractDefinition const* _contract, FunctionDefinition const* _function)
@@ -0,0 +1,59 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/SolverBudget.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+SolverBudget::SolverBudget(optional<unsigned> _milliseconds)
+{
+	if (_milliseconds)
+		m_deadline = chrono::steady_clock::now() + chrono::milliseconds(*_milliseconds);
+}
+
+unsigned SolverBudget::remaining() const
+{
+	solAssert(limited(), "");
+	auto const left = chrono::duration_cast<chrono::milliseconds>(*m_deadline - chrono::steady_clock::now()).count();
+	return left > 0 ? static_cast<unsigned>(left) : 0;
+}
+
+optional<unsigned> SolverBudget::solverTimeout(optional<unsigned> _configured) const
+{
+	if (!limited())
+		return _configured;
+	return _configured.value_or(initialTimeout);
+}
+
+unsigned SolverBudget::queryTimeout(optional<unsigned> _configured, bool _retry) const
+{
+	solAssert(!exhausted(), "");
+	unsigned const left = remaining();
+	if (_configured && *_configured == 0)
+		return left;
+	unsigned const timeout = _configured.value_or(initialTimeout);
+	if (_retry)
+		return timeout > left / retryFactor ? left : timeout * retryFactor;
+	return min(timeout, left);
+}
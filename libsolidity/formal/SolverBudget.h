@@ -0,0 +1,66 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/**
+ * Wall-clock time that the engines of the model checker may spend solving queries.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+namespace solidity::frontend
+{
+
+/**
+ * A limited budget is spent in passes over the verification targets. The queries of the first pass
+ * use a short timeout, so that the easy targets are solved before the hard ones take up the budget.
+ * The targets that could not be proved are queried again in a second pass with a longer timeout.
+ * No query may take longer than the rest of the budget, and no queries are made once it is spent.
+ */
+class SolverBudget
+{
+public:
+	/// Timeout of the queries of the first pass if no timeout per query is configured.
+	static unsigned constexpr initialTimeout = 1000;
+	/// Factor by which the timeout of the second pass is longer than the one of the first pass.
+	static unsigned constexpr retryFactor = 10;
+
+	/// Starts a budget of @a _milliseconds from now, which is unlimited if it is not set.
+	explicit SolverBudget(std::optional<unsigned> _milliseconds);
+
+	bool limited() const { return m_deadline.has_value(); }
+	/// @returns true if the budget is limited and has been spent.
+	bool exhausted() const { return limited() && remaining() == 0; }
+	/// @returns the milliseconds left of a limited budget.
+	unsigned remaining() const;
+
+	/// @returns the timeout that the solvers are created with, given the configured timeout per query.
+	/// This is the configured timeout unless the budget is limited.
+	std::optional<unsigned> solverTimeout(std::optional<unsigned> _configured) const;
+	/// @returns the timeout of a query of a limited budget that is not exhausted, in the first pass
+	/// or, if @a _retry is true, in the second one. A configured timeout of zero does not
+	/// limit the queries, apart from the rest of the budget.
+	unsigned queryTimeout(std::optional<unsigned> _configured, bool _retry) const;
+
+private:
+	std::optional<std::chrono::steady_clock::time_point> m_deadline;
+};
+
+}
@@ -0,0 +1,199 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/BytecodeCache.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/JSON.h>
+
+#include <fstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::frontend;
+
+namespace
+{
+
+Json::Value optionalToJson(optional<size_t> const& _value)
+{
+	return _value ? Json::Value(Json::UInt64(*_value)) : Json::Value(Json::nullValue);
+}
+
+optional<size_t> optionalFromJson(Json::Value const& _json)
+{
+	if (_json.isNull())
+		return nullopt;
+	return static_cast<size_t>(_json.asUInt64());
+}
+
+Json::Value linkerObjectToJson(LinkerObject const& _object)
+{
+	Json::Value output(Json::objectValue);
+	output["object"] = util::toHex(_object.bytecode);
+
+	output["linkReferences"] = Json::objectValue;
+	for (auto const& [offset, library]: _object.linkReferences)
+		output["linkReferences"][to_string(offset)] = library;
+
+	output["immutableReferences"] = Json::objectValue;
+	for (auto const& [hash, reference]: _object.immutableReferences)
+	{
+		Json::Value& immutable = output["immutableReferences"][hash.str()];
+		immutable["name"] = reference.first;
+		immutable["offsets"] = Json::arrayValue;
+		for (size_t offset: reference.second)
+			immutable["offsets"].append(Json::UInt64(offset));
+	}
+
+	output["functionDebugData"] = Json::objectValue;
+	for (auto const& [name, debugData]: _object.functionDebugData)
+	{
+		Json::Value& function = output["functionDebugData"][name];
+		function["bytecodeOffset"] = optionalToJson(debugData.bytecodeOffset);
+		function["instructionIndex"] = optionalToJson(debugData.instructionIndex);
+		function["sourceID"] = optionalToJson(debugData.sourceID);
+		function["params"] = Json::UInt64(debugData.params);
+		function["returns"] = Json::UInt64(debugData.returns);
+	}
+	return output;
+}
+
+LinkerObject linkerObjectFromJson(Json::Value const& _json)
+{
+	LinkerObject object;
+	object.bytecode = util::fromHex(_json["object"].asString(), util::WhenError::Throw);
+
+	Json::Value const& linkReferences = _json["linkReferences"];
+	for (auto it = linkReferences.begin(); it != linkReferences.end(); ++it)
+		object.linkReferences[stoul(it.name())] = it->asString();
+
+	Json::Value const& immutableReferences = _json["immutableReferences"];
+	for (auto it = immutableReferences.begin(); it != immutableReferences.end(); ++it)
+	{
+		auto& reference = object.immutableReferences[u256(it.name())];
+		reference.first = (*it)["name"].asString();
+		for (Json::Value const& offset: (*it)["offsets"])
+			reference.second.push_back(static_cast<size_t>(offset.asUInt64()));
+	}
+
+	Json::Value const& functionDebugData = _json["functionDebugData"];
+	for (auto it = functionDebugData.begin(); it != functionDebugData.end(); ++it)
+	{
+		LinkerObject::FunctionDebugData& debugData = object.functionDebugData[it.name()];
+		debugData.bytecodeOffset = optionalFromJson((*it)["bytecodeOffset"]);
+		debugData.instructionIndex = optionalFromJson((*it)["instructionIndex"]);
+		debugData.sourceID = optionalFromJson((*it)["sourceID"]);
+		debugData.params = static_cast<size_t>((*it)["params"].asUInt64());
+		debugData.returns = static_cast<size_t>((*it)["returns"].asUInt64());
+	}
+	return object;
+}
+
+}
+
+optional<BytecodeCache::Entry> BytecodeCache::load(util::h256 const& _key) const
+{
+	boost::filesystem::path const path = entryPath(_key);
+	boost::system::error_code errorCode;
+	if (!boost::filesystem::is_regular_file(path, errorCode))
+		return nullopt;
+
+	Json::Value json;
+	try
+	{
+		if (!util::jsonParseStrict(util::readFileAsString(path), json))
+			return nullopt;
+	}
+	catch (util::Exception const&)
+	{
+		return nullopt;
+	}
+	return fromJson(json);
+}
+
+void BytecodeCache::store(util::h256 const& _key, Entry const& _entry) const
+{
+	boost::system::error_code errorCode;
+	boost::filesystem::create_directories(m_directory, errorCode);
+	if (errorCode)
+		return;
+
+	// Write to a temporary file first, so that readers never see partially written entries.
+	boost::filesystem::path const temporaryPath = m_directory / boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+	{
+		ofstream file(temporaryPath.string(), ios::binary | ios::trunc);
+		file << util::jsonCompactPrint(toJson(_entry));
+		if (!file)
+		{
+			file.close();
+			boost::filesystem::remove(temporaryPath, errorCode);
+			return;
+		}
+	}
+	boost::filesystem::rename(temporaryPath, entryPath(_key), errorCode);
+	if (errorCode)
+		boost::filesystem::remove(temporaryPath, errorCode);
+}
+
+Json::Value BytecodeCache::toJson(Entry const& _entry)
+{
+	Json::Value output(Json::objectValue);
+	output["bytecode"] = linkerObjectToJson(_entry.object);
+	output["bytecode"]["sourceMap"] = _entry.sourceMapping;
+	output["bytecode"]["generatedSources"] = _entry.generatedSources;
+	output["deployedBytecode"] = linkerObjectToJson(_entry.runtimeObject);
+	output["deployedBytecode"]["sourceMap"] = _entry.runtimeSourceMapping;
+	output["deployedBytecode"]["generatedSources"] = _entry.runtimeGeneratedSources;
+	output["assembly"] = _entry.assembly;
+	output["legacyAssembly"] = _entry.assemblyJSON;
+	return output;
+}
+
+optional<BytecodeCache::Entry> BytecodeCache::fromJson(Json::Value const& _json)
+{
+	if (!_json.isObject() || !_json["bytecode"].isObject() || !_json["deployedBytecode"].isObject())
+		return nullopt;
+
+	try
+	{
+		Entry entry;
+		entry.object = linkerObjectFromJson(_json["bytecode"]);
+		entry.sourceMapping = _json["bytecode"]["sourceMap"].asString();
+		entry.generatedSources = _json["bytecode"]["generatedSources"];
+		entry.runtimeObject = linkerObjectFromJson(_json["deployedBytecode"]);
+		entry.runtimeSourceMapping = _json["deployedBytecode"]["sourceMap"].asString();
+		entry.runtimeGeneratedSources = _json["deployedBytecode"]["generatedSources"];
+		entry.assembly = _json["assembly"].asString();
+		entry.assemblyJSON = _json["legacyAssembly"];
+		return entry;
+	}
+	catch (exception const&)
+	{
+		// Thrown for values of the wrong type, invalid hex strings and malformed numbers.
+		return nullopt;
+	}
+}
+
+boost::filesystem::path BytecodeCache::entryPath(util::h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent cache of the EVM outputs of compiled contracts.
+ */
+
+#pragma once
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem.hpp>
+
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Stores the EVM outputs of contracts as JSON files in a directory. The key of an entry is
+ * a hash of everything the outputs depend on, in particular of the contract metadata.
+ * Entries are written atomically, so that several processes can share the same directory.
+ * Entries that cannot be read are treated as missing and errors while writing are ignored.
+ */
+class BytecodeCache
+{
+public:
+	/// The outputs of a contract that are stored in the cache.
+	struct Entry
+	{
+		evmasm::LinkerObject object;
+		evmasm::LinkerObject runtimeObject;
+		std::string sourceMapping;
+		std::string runtimeSourceMapping;
+		Json::Value generatedSources;
+		Json::Value runtimeGeneratedSources;
+		/// Assembly as text, including the source code snippets.
+		std::string assembly;
+		/// Assembly as returned by Assembly::assemblyJSON().
+		Json::Value assemblyJSON;
+	};
+
+	explicit BytecodeCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the entry stored under @a _key or an empty optional if there is none.
+	std::optional<Entry> load(util::h256 const& _key) const;
+	/// Stores @a _entry under @a _key, replacing a previous entry.
+	void store(util::h256 const& _key, Entry const& _entry) const;
+
+	static Json::Value toJson(Entry const& _entry);
+	/// @returns the entry represented by @a _json or an empty optional if it is malformed.
+	static std::optional<Entry> fromJson(Json::Value const& _json);
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
@@ -62,9 +62,13 @@
 #include <libyul/YulString.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AsmJsonConverter.h>
+#include <libyul/AssemblyCache.h>
 #include <libyul/AssemblyStack.h>
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
+#include <libyul/backends/evm/ControlFlowGasEstimator.h>
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMDialect.h>
 
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
@@ -74,16 +78,20 @@
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/MemoryMappedFile.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/Parallel.h>
 
 #include <json/json.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
+#include <algorithm>
 #include <utility>
 #include <map>
 #include <limits>
 #include <string>
+#include <sstream>
 
 using namespace std;
 using namespace solidity;
@@ -93,29 +101,126 @@ using namespace solidity::frontend;
 using solidity::util::errinfo_comment;
 using solidity::util::toHex;
 
-static int g_compilerStackCounts = 0;
+static thread_local int g_compilerStackCounts = 0;
+
+namespace
+{
+
+/// Removes the results of a previous analysis from an AST, so that it can be analysed again.
+class AnnotationRemover: private ASTVisitor
+{
+public:
+	static void run(SourceUnit& _sourceUnit)
+	{
+		AnnotationRemover remover;
+		_sourceUnit.accept(remover);
+	}
+
+private:
+	bool visitNode(ASTNode& _node) override
+	{
+		_node.clearAnnotation();
+		return true;
+	}
+};
+
+/// @returns true if @a _sourceUnit contains inline assembly. The Yul ASTs of inline assembly
+/// blocks refer to the YulStringRepository, which can be reset between compilations.
+bool containsInlineAssembly(SourceUnit const& _sourceUnit)
+{
+	bool found = false;
+	SimpleASTVisitor visitor(
+		[&](ASTNode const& _node) {
+			if (dynamic_cast<InlineAssembly const*>(&_node))
+				found = true;
+			return !found;
+		},
+		[](ASTNode const&) {}
+	);
+	_sourceUnit.accept(visitor);
+	return found;
+}
+
+}
 
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
+	m_typeProvider{make_unique<TypeProvider>()},
 	m_readFile{std::move(_readFile)},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
+	// The static TypeProvider API uses the instance that is current on the calling thread,
+	// so we must ensure that no more than one compiler stack per thread is using it at a time.
 	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
 	++g_compilerStackCounts;
+	m_previousTypeProvider = TypeProvider::setCurrent(m_typeProvider.get());
 }
 
 CompilerStack::~CompilerStack()
 {
 	--g_compilerStackCounts;
-	TypeProvider::reset();
+	TypeProvider::setCurrent(m_previousTypeProvider);
+}
+
+bool CompilerStack::checkSources(
+	vector<Source const*> const& _sources,
+	function<bool(SourceUnit const&, ErrorReporter&)> const& _check
+)
+{
+	if (m_parallelism <= 1 || _sources.size() <= 1)
+	{
+		bool success = true;
+		for (Source const* source: _sources)
+			if (source->ast && !_check(*source->ast, m_errorReporter))
+				success = false;
+		return success;
+	}
+
+	struct CheckResult
+	{
+		ErrorList errors;
+		bool success = true;
+		bool fatal = false;
+	};
+	vector<CheckResult> results(_sources.size());
+	TypeProvider* typeProvider = m_typeProvider.get();
+	util::parallelFor(_sources.size(), m_parallelism, [&](size_t _index) {
+		if (!_sources[_index]->ast)
+			return;
+		CheckResult& result = results[_index];
+		TypeProvider* previousTypeProvider = TypeProvider::setCurrent(typeProvider);
+		ScopeGuard restoreTypeProvider([&]() { TypeProvider::setCurrent(previousTypeProvider); });
+		ErrorReporter errorReporter(result.errors);
+		try
+		{
+			result.success = _check(*_sources[_index]->ast, errorReporter);
+		}
+		catch (FatalError const&)
+		{
+			result.fatal = true;
+		}
+	});
+
+	bool success = true;
+	for (CheckResult const& result: results)
+	{
+		m_errorReporter.append(result.errors);
+		// Sequential checks would not have reached the following sources.
+		if (result.fatal)
+			BOOST_THROW_EXCEPTION(FatalError());
+		if (!result.success)
+			success = false;
+	}
+	return success;
 }
 
 void CompilerStack::createAndAssignCallGraphs()
 {
+	// Shared by all contracts, so that functions inherited by several contracts are only visited once.
+	FunctionCallGraphBuilder::CallSummaries callSummaries;
 	for (Source const* source: m_sourceOrder)
 	{
-		if (!source->ast)
+		// The call graphs of sources whose analysis is reused are still assigned.
+		if (!source->ast || source->analysisReused)
 			continue;
 
 		for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
@@ -124,12 +229,13 @@ void CompilerStack::createAndAssignCallGraphs()
 				m_contracts.at(contract->fullyQualifiedName()).contract->annotation();
 
 			annotation.creationCallGraph = make_unique<CallGraph>(
-				FunctionCallGraphBuilder::buildCreationGraph(*contract)
+				FunctionCallGraphBuilder::buildCreationGraph(*contract, &callSummaries)
 			);
 			annotation.deployedCallGraph = make_unique<CallGraph>(
 				FunctionCallGraphBuilder::buildDeployedGraph(
 					*contract,
-					**annotation.creationCallGraph
+					**annotation.creationCallGraph,
+					&callSummaries
 				)
 			);
 
@@ -279,6 +385,55 @@ void CompilerStack::selectDebugInfo(DebugInfoSelection _debugInfoSelection)
 	m_debugInfoSelection = _debugInfoSelection;
 }
 
+void CompilerStack::setParallelism(size_t _parallelism)
+{
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set parallelism before compilation.");
+	solAssert(_parallelism > 0, "");
+	m_parallelism = _parallelism;
+}
+
+void CompilerStack::setBatchReadCallback(ReadCallback::BatchCallback _readFiles)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must set the batch read callback before parsing.");
+	m_readFiles = move(_readFiles);
+}
+
+void CompilerStack::enableASTCache(bool _enable)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must enable the AST cache before parsing.");
+	m_astCacheEnabled = _enable;
+	if (!_enable)
+	{
+		m_astCache.clear();
+		m_artifactCache.clear();
+	}
+}
+
+void CompilerStack::setBytecodeCache(shared_ptr<BytecodeCache const> _cache)
+{
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set the bytecode cache before compilation.");
+	m_bytecodeCache = move(_cache);
+}
+
+void CompilerStack::enableIntermediateRelease(function<Intermediates(string const&)> _retainedIntermediates)
+{
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must enable the release of intermediates before compilation.");
+	m_retainedIntermediates = move(_retainedIntermediates);
+}
+
+void CompilerStack::enableTimingCollection(bool _enable)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must enable timing collection before parsing.");
+	m_collectTimings = _enable;
+	resetTimings();
+}
+
 void CompilerStack::addSMTLib2Response(h256 const& _hash, string const& _response)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -288,8 +443,11 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, string const& _respons
 
 void CompilerStack::reset(bool _keepSettings)
 {
+	if (m_astCacheEnabled)
+		storeArtifactsInCache();
 	m_stackState = Empty;
 	m_hasError = false;
+	m_functionBodiesSkipped = false;
 	m_sources.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
@@ -301,18 +459,36 @@ void CompilerStack::reset(bool _keepSettings)
 		m_evmVersion = langutil::EVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_generateIR = false;
+		m_optimiseCreationCode = true;
 		m_generateEwasm = false;
+		m_parallelism = 1;
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 		m_metadataHash = MetadataHash::IPFS;
 		m_stopAfter = State::CompilationSuccessful;
+		m_lazyFunctionBodies = false;
+		m_astCacheEnabled = false;
+		m_astCache.clear();
+		m_artifactCache.clear();
+		m_bytecodeCache.reset();
+		m_collectTimings = false;
 	}
-	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_evmAssemblyCache.reset();
+	m_yulFunctionCache.reset();
+	m_compiledFunctionCache.reset();
 	m_errorReporter.clear();
-	TypeProvider::reset();
+	resetTimings();
+	// The annotations of cached ASTs whose analysis can be reused still refer to the types,
+	// the global context and the scopes of the previous analysis.
+	if (none_of(m_astCache.begin(), m_astCache.end(), [](auto const& _cached) { return _cached.second.analysed; }))
+	{
+		m_nameAndTypeResolver.reset();
+		m_globalContext.reset();
+		TypeProvider::reset();
+	}
 }
 
 void CompilerStack::setSources(StringMap _sources)
@@ -321,60 +497,101 @@ void CompilerStack::setSources(StringMap _sources)
 		solThrow(CompilerError, "Cannot change sources once set.");
 	if (m_stackState != Empty)
 		solThrow(CompilerError, "Must set sources before parsing.");
-	for (auto source: _sources)
-		m_sources[source.first].charStream = make_unique<CharStream>(/*content*/std::move(source.second), /*name*/source.first);
+	for (auto& [name, content]: _sources)
+		m_sources[name].charStream = make_unique<CharStream>(/*content*/std::move(content), /*name*/name);
 	m_stackState = SourcesSet;
 }
 
+void CompilerStack::setSources(StringMap _sources, map<string, shared_ptr<util::MemoryMappedFile const>> _mappedSources)
+{
+	for (auto const& [name, file]: _mappedSources)
+		solAssert(file && !_sources.count(name), "");
+	setSources(std::move(_sources));
+	for (auto& [name, file]: _mappedSources)
+	{
+		string_view const content = file->contents();
+		m_sources[name].charStream = make_unique<CharStream>(content, std::move(file), name);
+	}
+}
+
 bool CompilerStack::parse()
+{
+	return parseSources(m_lazyFunctionBodies && m_stopAfter <= ParsedAndImported);
+}
+
+bool CompilerStack::parseSources(bool _skipFunctionBodies)
 {
 	if (m_stackState != SourcesSet)
 		solThrow(CompilerError, "Must call parse only after the SourcesSet state.");
 	m_errorReporter.clear();
+	util::ScopedTimer timer(m_stageTimings.get(), "parsing", true);
 
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
-	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+	m_functionBodiesSkipped = _skipFunctionBodies;
+	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery, _skipFunctionBodies};
 
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
 
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
-	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.ast = parser.parse(*source.charStream);
-		if (!source.ast)
-			solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
-		else
+	// Only the ASTs of the current sources are kept, so that the cache does not grow indefinitely.
+	map<h256, CachedSourceUnit> reusableASTs;
+
+	// The AST cache depends on the IDs assigned to the previous sources, so it is only
+	// used if the sources are parsed one after another.
+	if ((m_parallelism > 1 || m_readFiles) && !m_astCacheEnabled)
+		parseInParallel(sourcesToParse, _skipFunctionBodies);
+	else
+		for (size_t i = 0; i < sourcesToParse.size(); ++i)
 		{
-			source.ast->annotation().path = path;
+			string const& path = sourcesToParse[i];
+			Source& source = m_sources[path];
 
-			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+			// Whether the AST is reused with the annotations of its previous analysis.
+			bool keepAnnotations = false;
+			if (m_astCacheEnabled)
 			{
-				solAssert(!import->path().empty(), "Import path cannot be empty.");
-
-				// The current value of `path` is the absolute path as seen from this source file.
-				// We first have to apply remappings before we can store the actual absolute path
-				// as seen globally.
-				import->annotation().absolutePath = applyRemapping(util::absolutePath(
-					import->path(),
-					path
-				), path);
-			}
-
-			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast))
+				source.astCacheKey = astCacheKey(path, source, parser.lastNodeID());
+				if (auto cached = m_astCache.find(source.astCacheKey); cached != m_astCache.end())
 				{
-					string const& newPath = newSource.first;
-					string const& newContents = newSource.second;
-					m_sources[newPath].charStream = make_shared<CharStream>(newContents, newPath);
-					sourcesToParse.push_back(newPath);
+					source.ast = cached->second.ast;
+					parser.setLastNodeID(cached->second.lastNodeID);
+					CachedSourceUnit& reused = reusableASTs.emplace(source.astCacheKey, cached->second).first->second;
+
+					keepAnnotations = reused.analysed;
+					for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+						if (keepAnnotations && *import->annotation().absolutePath != importedPath(*import, path))
+							keepAnnotations = false;
+					if (!keepAnnotations)
+					{
+						AnnotationRemover::run(*source.ast);
+						reused.analysed = false;
+					}
 				}
+			}
+			if (!source.ast)
+			{
+				size_t const previousErrorCount = m_errorReporter.errors().size();
+				source.ast = parser.parse(*source.charStream);
+				// Only cache sources that did not produce any diagnostics, since these would
+				// not be reported again if the AST is reused.
+				if (
+					m_astCacheEnabled &&
+					source.ast &&
+					m_errorReporter.errors().size() == previousErrorCount &&
+					!containsInlineAssembly(*source.ast)
+				)
+					reusableASTs.emplace(source.astCacheKey, CachedSourceUnit{source.ast, parser.lastNodeID()});
+			}
+
+			processParsedSource(path, !keepAnnotations, sourcesToParse);
 		}
-	}
+
+	m_astCache = move(reusableASTs);
+	if (m_astCacheEnabled)
+		determineReusableAnalysis();
 
 	if (m_stopAfter <= Parsed)
 		m_stackState = Parsed;
@@ -388,11 +605,88 @@ bool CompilerStack::parse()
 	return !m_hasError;
 }
 
-void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
+void CompilerStack::parseInParallel(vector<string>& _sourcesToParse, bool _skipFunctionBodies)
+{
+	struct ParsedSource
+	{
+		ErrorList errors;
+		unique_ptr<ErrorReporter> errorReporter;
+		unique_ptr<Parser> parser;
+		ASTPointer<SourceUnit> ast;
+	};
+
+	// Sources discovered through imports are parsed in later rounds, in the same order in
+	// which they would be parsed one after another.
+	int64_t lastNodeID = 0;
+	for (size_t roundBegin = 0; roundBegin < _sourcesToParse.size();)
+	{
+		size_t const roundEnd = _sourcesToParse.size();
+		vector<CharStream*> charStreams;
+		for (size_t i = roundBegin; i < roundEnd; ++i)
+			charStreams.push_back(m_sources.at(_sourcesToParse[i]).charStream.get());
+
+		vector<ParsedSource> parsedSources(charStreams.size());
+		util::parallelFor(charStreams.size(), m_parallelism, [&](size_t _index) {
+			ParsedSource& parsed = parsedSources[_index];
+			parsed.errorReporter = make_unique<ErrorReporter>(parsed.errors);
+			parsed.parser = make_unique<Parser>(*parsed.errorReporter, m_evmVersion, m_parserErrorRecovery, _skipFunctionBodies);
+			parsed.parser->recordCreatedNodes();
+			parsed.ast = parsed.parser->parse(*charStreams[_index]);
+		});
+
+		if (m_readFiles && m_stopAfter >= ParsedAndImported)
+		{
+			vector<pair<string, SourceUnit const*>> round;
+			for (size_t i = 0; i < parsedSources.size(); ++i)
+				round.emplace_back(_sourcesToParse[roundBegin + i], parsedSources[i].ast.get());
+			prefetchMissingSources(round);
+		}
+		ScopeGuard clearPrefetchedSources([&]() { m_prefetchedSources.clear(); });
+
+		// Every source was numbered starting from zero. Moving the IDs by the number of IDs that
+		// were used by the previous sources results in the same IDs as sequential parsing.
+		for (size_t i = 0; i < parsedSources.size(); ++i)
+		{
+			ParsedSource& parsed = parsedSources[i];
+			parsed.parser->shiftNodeIDs(lastNodeID);
+			lastNodeID += parsed.parser->lastNodeID();
+			m_errorReporter.append(parsed.errors);
+
+			string const& path = _sourcesToParse[roundBegin + i];
+			m_sources[path].ast = move(parsed.ast);
+			processParsedSource(path, true, _sourcesToParse);
+		}
+		roundBegin = roundEnd;
+	}
+}
+
+void CompilerStack::processParsedSource(string const& _path, bool _annotatePaths, vector<string>& _sourcesToParse)
+{
+	Source& source = m_sources[_path];
+	if (!source.ast)
+	{
+		solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
+		return;
+	}
+
+	if (_annotatePaths)
+		annotatePaths(_path, *source.ast);
+
+	if (m_stopAfter >= ParsedAndImported)
+		for (auto const& newSource: loadMissingSources(*source.ast))
+		{
+			string const& newPath = newSource.first;
+			string const& newContents = newSource.second;
+			m_sources[newPath].charStream = make_shared<CharStream>(newContents, newPath);
+			_sourcesToParse.push_back(newPath);
+		}
+}
+
+void CompilerStack::importASTs(map<string, Json::Value> _sources)
 {
 	if (m_stackState != Empty)
 		solThrow(CompilerError, "Must call importASTs only before the SourcesSet state.");
-	m_sourceJsons = _sources;
+	m_sourceJsons = move(_sources);
 	map<string, ASTPointer<SourceUnit>> reconstructedSources = ASTJsonImporter(m_evmVersion).jsonToSourceUnit(m_sourceJsons);
 	for (auto& src: reconstructedSources)
 	{
@@ -415,9 +709,54 @@ bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		solThrow(CompilerError, "Must call analyze only after parsing was performed.");
+
+	if (m_functionBodiesSkipped)
+	{
+		// The analysis needs the bodies of functions and modifiers, so parse everything again.
+		for (auto& pair: m_sources)
+			pair.second.ast.reset();
+		m_contracts.clear();
+		m_hasError = false;
+		m_stackState = SourcesSet;
+		if (!parseSources(false) && !m_parserErrorRecovery)
+			return false;
+	}
+
+	util::ScopedTimer timer(m_stageTimings.get(), "analysis", true);
 	resolveImports();
 
+	// Keep only the parts of the previous analysis that belong to sources whose analysis is reused.
+	set<ASTNode const*> reusedNodes;
+	set<ContractDefinition const*> reusedContracts;
+	vector<Source const*> sourcesToAnalyse;
 	for (Source const* source: m_sourceOrder)
+		if (source->analysisReused)
+		{
+			SimpleASTVisitor collector(
+				[&](ASTNode const& _node) { reusedNodes.insert(&_node); return true; },
+				[](ASTNode const&) {}
+			);
+			source->ast->accept(collector);
+			for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+				reusedContracts.insert(contract);
+		}
+		else
+			sourcesToAnalyse.push_back(source);
+	if (!reusedNodes.empty())
+	{
+		solAssert(m_globalContext && m_nameAndTypeResolver, "");
+		TypeProvider::clearTypeCaches();
+		m_globalContext->retainContracts(reusedContracts);
+		m_nameAndTypeResolver->retainScopes(reusedNodes);
+	}
+	else if (m_globalContext)
+	{
+		m_nameAndTypeResolver.reset();
+		m_globalContext.reset();
+		TypeProvider::reset();
+	}
+
+	for (Source const* source: sourcesToAnalyse)
 		if (source->ast)
 			Scoper::assignScopes(*source->ast);
 
@@ -426,43 +765,47 @@ bool CompilerStack::analyze()
 	try
 	{
 		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
 				noErrors = false;
 
-		m_globalContext = make_shared<GlobalContext>();
-		// We need to keep the same resolver during the whole process.
-		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		if (!m_globalContext)
+		{
+			m_globalContext = make_shared<GlobalContext>();
+			// We need to keep the same resolver during the whole process.
+			m_nameAndTypeResolver = make_unique<NameAndTypeResolver>(*m_globalContext, m_evmVersion, m_errorReporter);
+		}
+		NameAndTypeResolver& resolver = *m_nameAndTypeResolver;
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !resolver.registerDeclarations(*source->ast))
 				return false;
 
 		map<string, SourceUnit const*> sourceUnitsByName;
 		for (auto& source: m_sources)
 			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
 				return false;
 
 		resolver.warnHomonymDeclarations();
 
 		DocStringTagParser docStringTagParser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
 				noErrors = false;
 
 		// Requires DocStringTagParser
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
 				return false;
 
 		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !declarationTypeChecker.check(*source->ast))
 				return false;
 
 		// Requires DeclarationTypeChecker to have run
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
 				noErrors = false;
 
@@ -472,13 +815,13 @@ bool CompilerStack::analyze()
 		// type checker.
 		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (auto sourceAst = source->ast)
 				noErrors = contractLevelChecker.check(*sourceAst);
 
 		// Requires ContractLevelChecker
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
 				noErrors = false;
 
@@ -490,7 +833,7 @@ bool CompilerStack::analyze()
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
 		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
 				noErrors = false;
 
@@ -498,7 +841,7 @@ bool CompilerStack::analyze()
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
 			PostTypeChecker postTypeChecker(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast && !postTypeChecker.check(*source->ast))
 					noErrors = false;
 			if (!postTypeChecker.finalize())
@@ -512,15 +855,15 @@ bool CompilerStack::analyze()
 			findAndReportCyclicContractDependencies();
 		}
 
-		if (noErrors)
-			for (Source const* source: m_sourceOrder)
-				if (source->ast && !PostTypeContractLevelChecker{m_errorReporter}.check(*source->ast))
-					noErrors = false;
+		if (noErrors && !checkSources(sourcesToAnalyse, [](SourceUnit const& _source, ErrorReporter& _errorReporter) {
+			return PostTypeContractLevelChecker{_errorReporter}.check(_source);
+		}))
+			noErrors = false;
 
 		// Check that immutable variables are never read in c'tors and assigned
 		// exactly once
 		if (noErrors)
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast)
 					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
@@ -546,14 +889,11 @@ bool CompilerStack::analyze()
 			}
 		}
 
-		if (noErrors)
-		{
-			// Checks for common mistakes. Only generates warnings.
-			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (source->ast && !staticAnalyzer.analyze(*source->ast))
-					noErrors = false;
-		}
+		// Checks for common mistakes. Only generates warnings.
+		if (noErrors && !checkSources(sourcesToAnalyse, [](SourceUnit const& _source, ErrorReporter& _errorReporter) {
+			return StaticAnalyzer(_errorReporter).analyze(_source);
+		}))
+			noErrors = false;
 
 		if (noErrors)
 		{
@@ -569,13 +909,23 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
-			ModelChecker modelChecker(m_errorReporter, *this, m_smtlib2Responses, m_modelCheckerSettings, m_readFile);
+			ModelChecker modelChecker(
+				m_errorReporter,
+				*this,
+				m_smtlib2Responses,
+				m_modelCheckerSettings,
+				m_readFile,
+				m_parallelism
+			);
 			auto allSources = applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
+			modelChecker.setTimings(m_stageTimings.get());
 			modelChecker.enableAllEnginesIfPragmaPresent(allSources);
 			modelChecker.checkRequestedSourcesAndContracts(allSources);
+			vector<SourceUnit const*> sourcesToCheck;
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
-					modelChecker.analyze(*source->ast);
+					sourcesToCheck.push_back(source->ast.get());
+			modelChecker.analyze(sourcesToCheck);
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
 		}
 	}
@@ -589,6 +939,15 @@ bool CompilerStack::analyze()
 	m_stackState = AnalysisPerformed;
 	if (!noErrors)
 		m_hasError = true;
+	m_analysedForYulOptimiser = m_optimiserSettings.runYulOptimiser;
+	m_diagnosticsAfterAnalysis = m_errorList.size();
+
+	if (m_astCacheEnabled)
+	{
+		storeAnalysisResultsInCache();
+		if (!m_hasError)
+			loadArtifactsFromCache();
+	}
 
 	return !m_hasError;
 }
@@ -643,63 +1002,394 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_hasError)
 		solThrow(CompilerError, "Called compile with errors.");
 
-	// Only compile contracts individually which have been requested.
-	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	util::ScopedTimer timer(m_stageTimings.get(), "compilation", true);
+
+	// When stopping after the IR generation, neither the EVM nor the Ewasm code is generated.
+	bool const stopAfterIR = m_stopAfter == IRGenerated;
+	bool const evmBytecodeEnabled = m_generateEvmBytecode;
+	bool const irEnabled = m_generateIR;
+	bool const ewasmEnabled = m_generateEwasm;
+	ScopeGuard restoreCodeGeneration([&]() {
+		m_generateEvmBytecode = evmBytecodeEnabled;
+		m_generateIR = irEnabled;
+		m_generateEwasm = ewasmEnabled;
+	});
+	if (stopAfterIR)
+	{
+		m_generateEvmBytecode = false;
+		m_generateIR = true;
+		m_generateEwasm = false;
+	}
 
+	// Only compile contracts individually which have been requested.
+	vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
+					requestedContracts.push_back(contract);
+
+	m_contractsCreatedByOthers.clear();
+	if (!m_optimiseCreationCode)
+		for (auto const& [name, contract]: m_contracts)
+			for (auto const& [dependency, referencee]: contract.contract->annotation().contractDependencies)
+				m_contractsCreatedByOthers.insert(dependency);
+
+	size_t const diagnosticsBeforeCompilation = m_errorReporter.errors().size();
+	vector<ContractDefinition const*> const contractsToCompile = loadFromBytecodeCache(requestedContracts);
+	m_evmAssemblyCache = make_unique<yul::EVMAssemblyCache>();
+	m_yulFunctionCache = make_unique<MultiUseYulFunctionCache>();
+	m_compiledFunctionCache = make_unique<CompiledFunctionCache>();
+	// The bytecode cache stores all outputs, so they are kept until the end of the compilation.
+	bool const releasesIntermediates = m_retainedIntermediates && !useBytecodeCache();
+	// Contracts that are only dependencies of others do not consume their optimised objects.
+	ScopeGuard releaseOptimizedIRStacks([&]() {
+		for (auto& pair: m_contracts)
+			pair.second.yulIROptimizedStack.reset();
+	});
+
+	try
+	{
+		if (m_parallelism > 1)
+			compileInParallel(contractsToCompile);
+		else
+		{
+			// The contracts whose intermediates can be released after compiling each contract,
+			// since it is the last one that needs them.
+			vector<vector<ContractDefinition const*>> releasedAfter(contractsToCompile.size());
+			if (releasesIntermediates)
+			{
+				map<ContractDefinition const*, size_t> lastUse;
+				for (size_t index = 0; index < contractsToCompile.size(); ++index)
 				{
-					try
-					{
-						if (m_viaIR || m_generateIR || m_generateEwasm)
-							generateIR(*contract);
-						if (m_generateEvmBytecode)
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-								compileContract(*contract, otherCompilers);
-						}
-						if (m_generateEwasm)
-							generateEwasm(*contract);
-					}
-					catch (Error const& _error)
+					vector<ContractDefinition const*> toVisit{contractsToCompile[index]};
+					set<ContractDefinition const*> visited{contractsToCompile[index]};
+					while (!toVisit.empty())
 					{
-						if (_error.type() != Error::Type::CodeGenerationError)
-							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
+						ContractDefinition const* contract = toVisit.back();
+						toVisit.pop_back();
+						lastUse[contract] = index;
+						for (auto const& [dependency, referencee]: contract->annotation().contractDependencies)
+							if (visited.insert(dependency).second)
+								toVisit.push_back(dependency);
 					}
-					catch (UnimplementedFeatureError const& _unimplementedError)
+				}
+				for (auto const& [contract, index]: lastUse)
+					releasedAfter[index].push_back(contract);
+			}
+
+			map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+			for (size_t index = 0; index < contractsToCompile.size(); ++index)
+			{
+				ContractDefinition const* contract = contractsToCompile[index];
+				if (m_viaIR || m_generateIR || m_generateEwasm)
+					generateIR(*contract);
+				if (m_generateEvmBytecode)
+				{
+					if (m_viaIR)
 					{
-						if (
-							SourceLocation const* sourceLocation =
-							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
-						)
-						{
-							string const* comment = _unimplementedError.comment();
-							m_errorReporter.error(
-								1834_error,
-								Error::Type::CodeGenerationError,
-								*sourceLocation,
-								"Unimplemented feature error" +
-								((comment && !comment->empty()) ? ": " + *comment : string{}) +
-								" in " +
-								_unimplementedError.lineInfo()
-							);
-							return false;
-						}
-						else
-							throw;
+						generateEVMFromIR(*contract);
+						checkRuntimeCodeSize(*contract);
 					}
+					else
+						compileContract(*contract, otherCompilers);
+				}
+				if (m_generateEwasm)
+					generateEwasm(*contract);
+
+				for (ContractDefinition const* released: releasedAfter[index])
+				{
+					string const& name = released->fullyQualifiedName();
+					releaseIntermediates(m_contracts.at(name), m_retainedIntermediates(name));
+					otherCompilers.erase(released);
 				}
+			}
+		}
+	}
+	catch (Error const& _error)
+	{
+		if (_error.type() != Error::Type::CodeGenerationError)
+			throw;
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+		return false;
+	}
+	catch (UnimplementedFeatureError const& _unimplementedError)
+	{
+		if (
+			SourceLocation const* sourceLocation =
+			boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
+		)
+		{
+			string const* comment = _unimplementedError.comment();
+			m_errorReporter.error(
+				1834_error,
+				Error::Type::CodeGenerationError,
+				*sourceLocation,
+				"Unimplemented feature error" +
+				((comment && !comment->empty()) ? ": " + *comment : string{}) +
+				" in " +
+				_unimplementedError.lineInfo()
+			);
+			return false;
+		}
+		else
+			throw;
+	}
+	if (stopAfterIR)
+	{
+		m_stackState = IRGenerated;
+		return true;
+	}
 	m_stackState = CompilationSuccessful;
+	// The code size warning is issued again for contracts taken from the cache, but other
+	// diagnostics of the code generator would be lost.
+	if (all_of(
+		m_errorReporter.errors().begin() + static_cast<ptrdiff_t>(diagnosticsBeforeCompilation),
+		m_errorReporter.errors().end(),
+		[](shared_ptr<Error const> const& _error) { return _error->errorId() == 5574_error; }
+	))
+		storeInBytecodeCache(contractsToCompile);
+	if (releasesIntermediates)
+		for (auto& [name, contract]: m_contracts)
+			releaseIntermediates(contract, m_retainedIntermediates(name));
 	this->link();
 	return true;
 }
 
+void CompilerStack::resetCompilation(OptimiserSettings _optimiserSettings, bool _viaIR)
+{
+	if (m_stackState < AnalysisPerformed || m_hasError)
+		solThrow(CompilerError, "Must perform a successful analysis before resetting the compilation.");
+	if (_optimiserSettings.runYulOptimiser && !m_analysedForYulOptimiser)
+		solThrow(CompilerError, "Cannot enable the Yul optimiser after the analysis was performed without it.");
+
+	m_stackState = AnalysisPerformed;
+	m_optimiserSettings = std::move(_optimiserSettings);
+	m_viaIR = _viaIR;
+	// Only the contract definitions are kept, all other outputs are generated again
+	// or taken from the artifact cache.
+	if (m_astCacheEnabled)
+		storeArtifactsInCache();
+	map<string const, Contract> contracts;
+	for (auto const& [name, contract]: m_contracts)
+		contracts[name].contract = contract.contract;
+	m_contracts.swap(contracts);
+	if (m_astCacheEnabled)
+		loadArtifactsFromCache();
+	m_errorList.resize(m_diagnosticsAfterAnalysis);
+}
+
+void CompilerStack::compileInParallel(vector<ContractDefinition const*> const& _contracts)
+{
+	vector<PendingIROptimisation> pendingOptimisations;
+	if (m_viaIR || m_generateIR || m_generateEwasm)
+		for (ContractDefinition const* contract: _contracts)
+			generateIR(*contract, &pendingOptimisations);
+
+	// @returns the number of threads available to each of @a _jobs jobs run in parallel.
+	auto threadsPerJob = [&](size_t _jobs) { return max<size_t>(1, m_parallelism / max<size_t>(1, _jobs)); };
+
+	// The optimiser only works on the generated source and does not access the AST.
+	size_t const threadsPerOptimisation = threadsPerJob(pendingOptimisations.size());
+	parallelFor(pendingOptimisations.size(), m_parallelism, [&](size_t _index) {
+		PendingIROptimisation const& pending = pendingOptimisations[_index];
+		Contract& compiledContract = m_contracts.at(pending.contract->fullyQualifiedName());
+		util::ScopedTraceSpan span(pending.contract->fullyQualifiedName(), "contract");
+		util::ScopedTimer timer(compiledContract.timings.get(), "irOptimisation");
+		compiledContract.yulIROptimized = pending.generator->optimize(
+			compiledContract.yulIR,
+			threadsPerOptimisation,
+			m_optimiserStepTimings.get(),
+			m_viaIR && m_generateEvmBytecode ? &compiledContract.yulIROptimizedStack : nullptr
+		);
+	});
+	pendingOptimisations.clear();
+
+	if (m_generateEvmBytecode && !m_viaIR)
+	{
+		map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+		for (ContractDefinition const* contract: _contracts)
+			compileContract(*contract, otherCompilers);
+	}
+
+	bool const generateEVMFromIRCode = m_generateEvmBytecode && m_viaIR;
+	size_t const threadsPerContract = threadsPerJob(_contracts.size());
+	parallelFor(_contracts.size(), m_parallelism, [&](size_t _index) {
+		if (generateEVMFromIRCode)
+			generateEVMFromIR(*_contracts[_index], threadsPerContract);
+		if (m_generateEwasm)
+			generateEwasm(*_contracts[_index]);
+	});
+
+	// Warnings are issued afterwards to keep their order independent of the scheduling.
+	if (generateEVMFromIRCode)
+		for (ContractDefinition const* contract: _contracts)
+			checkRuntimeCodeSize(*contract);
+}
+
+bool CompilerStack::useBytecodeCache() const
+{
+	return
+		m_bytecodeCache &&
+		m_generateEvmBytecode &&
+		m_optimiseCreationCode &&
+		!m_generateIR &&
+		!m_generateEwasm;
+}
+
+h256 CompilerStack::bytecodeCacheKey(Contract const& _contract) const
+{
+	// The metadata covers the sources and the settings the bytecode depends on. The source maps
+	// and the assembly also depend on the indices of all sources and on the debug info selection.
+	ostringstream key;
+	key << metadata(_contract) << '\0' << m_debugInfoSelection << '\0';
+	for (auto const& [name, index]: sourceIndices())
+		key << name << '\0' << index << '\0';
+	return keccak256(key.str());
+}
+
+vector<ContractDefinition const*> CompilerStack::loadFromBytecodeCache(vector<ContractDefinition const*> const& _contracts)
+{
+	if (!useBytecodeCache())
+		return _contracts;
+
+	map<ContractDefinition const*, BytecodeCache::Entry> entries;
+	for (ContractDefinition const* contract: _contracts)
+		if (contract->canBeDeployed())
+			if (auto entry = m_bytecodeCache->load(bytecodeCacheKey(m_contracts.at(contract->fullyQualifiedName()))))
+				entries.emplace(contract, move(*entry));
+
+	// The legacy code generator compiles all contracts created by the contracts it compiles,
+	// so there is no point in taking those from the cache.
+	if (!m_viaIR)
+	{
+		vector<ContractDefinition const*> toVisit;
+		for (ContractDefinition const* contract: _contracts)
+			if (!entries.count(contract))
+				toVisit.push_back(contract);
+		set<ContractDefinition const*> visited(toVisit.begin(), toVisit.end());
+		while (!toVisit.empty())
+		{
+			ContractDefinition const* contract = toVisit.back();
+			toVisit.pop_back();
+			for (auto const& [dependency, referencee]: contract->annotation().contractDependencies)
+				if (visited.insert(dependency).second)
+				{
+					entries.erase(dependency);
+					toVisit.push_back(dependency);
+				}
+		}
+	}
+
+	vector<ContractDefinition const*> contractsToCompile;
+	for (ContractDefinition const* contract: _contracts)
+	{
+		auto it = entries.find(contract);
+		if (it == entries.end())
+		{
+			contractsToCompile.push_back(contract);
+			continue;
+		}
+
+		auto cachedOutputs = make_shared<BytecodeCache::Entry const>(move(it->second));
+		Contract& compiledContract = m_contracts.at(contract->fullyQualifiedName());
+		compiledContract.object = cachedOutputs->object;
+		compiledContract.runtimeObject = cachedOutputs->runtimeObject;
+		compiledContract.sourceMapping.emplace(cachedOutputs->sourceMapping);
+		compiledContract.runtimeSourceMapping.emplace(cachedOutputs->runtimeSourceMapping);
+		compiledContract.generatedSources.init([&]{ return cachedOutputs->generatedSources; });
+		compiledContract.runtimeGeneratedSources.init([&]{ return cachedOutputs->runtimeGeneratedSources; });
+		compiledContract.cachedOutputs = move(cachedOutputs);
+		checkRuntimeCodeSize(*contract);
+	}
+	return contractsToCompile;
+}
+
+void CompilerStack::storeInBytecodeCache(vector<ContractDefinition const*> const& _contracts) const
+{
+	solAssert(m_stackState == CompilationSuccessful, "");
+	if (!useBytecodeCache())
+		return;
+
+	StringMap sourceCodes;
+	for (auto const& [name, source]: m_sources)
+		sourceCodes[name] = string(source.charStream->source());
+
+	for (ContractDefinition const* contract: _contracts)
+	{
+		if (!contract->canBeDeployed())
+			continue;
+
+		string const& name = contract->fullyQualifiedName();
+		Contract const& compiledContract = m_contracts.at(name);
+		BytecodeCache::Entry entry;
+		// Linking happens afterwards, so the objects still contain their link references.
+		entry.object = compiledContract.object;
+		entry.runtimeObject = compiledContract.runtimeObject;
+		if (string const* mapping = sourceMapping(name))
+			entry.sourceMapping = *mapping;
+		if (string const* mapping = runtimeSourceMapping(name))
+			entry.runtimeSourceMapping = *mapping;
+		entry.generatedSources = generatedSources(name, false);
+		entry.runtimeGeneratedSources = generatedSources(name, true);
+		entry.assembly = assemblyString(name, sourceCodes);
+		entry.assemblyJSON = assemblyJSON(name);
+		m_bytecodeCache->store(bytecodeCacheKey(compiledContract), entry);
+	}
+}
+
+void CompilerStack::releaseIntermediates(Contract& _contract, Intermediates const& _retained)
+{
+	if (!_retained.evmAssembly)
+	{
+		// The source mappings are part of the bytecode outputs.
+		if (_contract.evmAssembly && !_contract.sourceMapping)
+			_contract.sourceMapping.emplace(evmasm::AssemblyItem::computeSourceMapping(
+				_contract.evmAssembly->items(),
+				sourceIndices()
+			));
+		if (_contract.evmRuntimeAssembly && !_contract.runtimeSourceMapping)
+			_contract.runtimeSourceMapping.emplace(evmasm::AssemblyItem::computeSourceMapping(
+				_contract.evmRuntimeAssembly->items(),
+				sourceIndices()
+			));
+		_contract.compiler.reset();
+		_contract.evmAssembly.reset();
+		_contract.evmRuntimeAssembly.reset();
+		_contract.assemblyJSON.reset();
+	}
+	if (!_retained.ir)
+		string().swap(_contract.yulIR);
+	if (!_retained.irOptimized)
+	{
+		string().swap(_contract.yulIROptimized);
+		_contract.yulIROptimizedStack.reset();
+	}
+	if (!_retained.ewasm)
+		string().swap(_contract.ewasm);
+}
+
+void CompilerStack::releaseIntermediates(string const& _contractName)
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	string const& name = contract(_contractName).contract->fullyQualifiedName();
+	releaseIntermediates(m_contracts.at(name), Intermediates{false, false, false, false});
+}
+
+void CompilerStack::resetTimings()
+{
+	m_stageTimings.reset();
+	m_optimiserStepTimings.reset();
+	if (m_collectTimings)
+	{
+		m_stageTimings = make_unique<util::TimingCollector>();
+		m_optimiserStepTimings = make_unique<util::TimingCollector>();
+		Type::resetMemberCacheStatistics();
+	}
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
@@ -850,7 +1540,7 @@ std::string const CompilerStack::filesystemFriendlyName(string const& _contractN
 
 string const& CompilerStack::yulIR(string const& _contractName) const
 {
-	if (m_stackState != CompilationSuccessful)
+	if (m_stackState < IRGenerated)
 		solThrow(CompilerError, "Compilation was not successful.");
 
 	return contract(_contractName).yulIR;
@@ -858,7 +1548,7 @@ string const& CompilerStack::yulIR(string const& _contractName) const
 
 string const& CompilerStack::yulIROptimized(string const& _contractName) const
 {
-	if (m_stackState != CompilationSuccessful)
+	if (m_stackState < IRGenerated)
 		solThrow(CompilerError, "Compilation was not successful.");
 
 	return contract(_contractName).yulIROptimized;
@@ -905,11 +1595,12 @@ string CompilerStack::assemblyString(string const& _contractName, StringMap cons
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.evmAssembly)
 		return currentContract.evmAssembly->assemblyString(m_debugInfoSelection, _sourceCodes);
+	else if (currentContract.cachedOutputs)
+		return currentContract.cachedOutputs->assembly;
 	else
 		return string();
 }
 
-/// TODO: cache the JSON
 Json::Value CompilerStack::assemblyJSON(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
@@ -917,7 +1608,9 @@ Json::Value CompilerStack::assemblyJSON(string const& _contractName) const
 
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.evmAssembly)
-		return currentContract.evmAssembly->assemblyJSON(sourceIndices());
+		return currentContract.assemblyJSON.init([&]{ return currentContract.evmAssembly->assemblyJSON(sourceIndices()); });
+	else if (currentContract.cachedOutputs)
+		return currentContract.cachedOutputs->assemblyJSON;
 	else
 		return Json::Value();
 }
@@ -1085,24 +1778,179 @@ size_t CompilerStack::functionEntryPoint(
 	return 0;
 }
 
+string CompilerStack::importedPath(ImportDirective const& _import, string const& _path)
+{
+	solAssert(!_import.path().empty(), "Import path cannot be empty.");
+
+	// The path of the import is relative to the importing source file.
+	// We first have to apply remappings before we can store the actual absolute path
+	// as seen globally.
+	return applyRemapping(util::absolutePath(_import.path(), _path), _path);
+}
+
+void CompilerStack::annotatePaths(string const& _path, SourceUnit& _ast)
+{
+	_ast.annotation().path = _path;
+	for (auto const& import: ASTNode::filteredNodes<ImportDirective>(_ast.nodes()))
+		import->annotation().absolutePath = importedPath(*import, _path);
+}
+
+void CompilerStack::determineReusableAnalysis()
+{
+	set<string> reusable;
+	if (m_stopAfter >= AnalysisPerformed)
+		for (auto const& [path, source]: m_sources)
+			if (auto cached = m_astCache.find(source.astCacheKey); source.ast && cached != m_astCache.end() && cached->second.analysed)
+				reusable.insert(path);
+
+	// The analysis of a source depends on the sources it imports,
+	// so it can only be reused if theirs is reused as well.
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (auto it = reusable.begin(); it != reusable.end();)
+		{
+			bool importsReusable = true;
+			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(m_sources.at(*it).ast->nodes()))
+				if (!reusable.count(*import->annotation().absolutePath))
+					importsReusable = false;
+
+			if (importsReusable)
+				++it;
+			else
+			{
+				it = reusable.erase(it);
+				changed = true;
+			}
+		}
+	}
+
+	for (auto& [path, source]: m_sources)
+		if (reusable.count(path))
+			source.analysisReused = true;
+		else if (auto cached = m_astCache.find(source.astCacheKey); source.ast && cached != m_astCache.end() && cached->second.analysed)
+		{
+			AnnotationRemover::run(*source.ast);
+			annotatePaths(path, *source.ast);
+			cached->second.analysed = false;
+		}
+}
+
+void CompilerStack::storeAnalysisResultsInCache()
+{
+	set<string> sourcesWithDiagnostics;
+	for (shared_ptr<Error const> const& error: m_errorReporter.errors())
+	{
+		if (SourceLocation const* location = error->sourceLocation(); location && location->sourceName)
+			sourcesWithDiagnostics.insert(*location->sourceName);
+		if (SecondarySourceLocation const* secondaryLocation = error->secondarySourceLocation())
+			for (auto const& info: secondaryLocation->infos)
+				if (info.second.sourceName)
+					sourcesWithDiagnostics.insert(*info.second.sourceName);
+	}
+
+	for (auto const& [path, source]: m_sources)
+		if (auto cached = m_astCache.find(source.astCacheKey); source.ast && cached != m_astCache.end())
+			cached->second.analysed = !m_hasError && !sourcesWithDiagnostics.count(path);
+}
+
+void CompilerStack::loadArtifactsFromCache()
+{
+	solAssert(m_stackState >= AnalysisPerformed && !m_hasError, "");
+
+	// The outputs of a contract only depend on the sources visible from its source.
+	map<string, h256> visibleSourcesKeys;
+	for (auto const& [path, source]: m_sources)
+	{
+		solAssert(source.ast, "");
+		util::BreadthFirstSearch<string> visibleSources{{path}};
+		visibleSources.run([&](string const& _path, auto&& _addChild) {
+			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(m_sources.at(_path).ast->nodes()))
+				_addChild(*import->annotation().absolutePath);
+		});
+		string keys;
+		for (string const& visiblePath: visibleSources.visited)
+			keys += m_sources.at(visiblePath).astCacheKey.hex();
+		visibleSourcesKeys[path] = util::keccak256(keys);
+	}
+
+	for (auto& [name, compiledContract]: m_contracts)
+	{
+		compiledContract.artifactCacheKey = util::keccak256(
+			visibleSourcesKeys.at(compiledContract.contract->sourceUnitName()).hex() + '\0' + name
+		);
+		auto cached = m_artifactCache.find(*compiledContract.artifactCacheKey);
+		if (cached == m_artifactCache.end())
+			continue;
+		CachedArtifacts const& artifacts = cached->second;
+		if (artifacts.abi)
+			compiledContract.abi.init([&]{ return *artifacts.abi; });
+		if (artifacts.storageLayout)
+			compiledContract.storageLayout.init([&]{ return *artifacts.storageLayout; });
+		if (artifacts.userDocumentation)
+			compiledContract.userDocumentation.init([&]{ return *artifacts.userDocumentation; });
+		if (artifacts.devDocumentation)
+			compiledContract.devDocumentation.init([&]{ return *artifacts.devDocumentation; });
+	}
+}
+
+void CompilerStack::storeArtifactsInCache()
+{
+	// Only the outputs of the current contracts are kept, so that the cache does not grow indefinitely.
+	map<h256, CachedArtifacts> artifactCache;
+	for (auto const& [name, compiledContract]: m_contracts)
+	{
+		if (!compiledContract.artifactCacheKey)
+			continue;
+		CachedArtifacts& artifacts = artifactCache[*compiledContract.artifactCacheKey];
+		auto store = [](optional<Json::Value>& _cached, util::LazyInit<Json::Value const> const& _output) {
+			if (Json::Value const* output = _output.get())
+				_cached = *output;
+		};
+		store(artifacts.abi, compiledContract.abi);
+		store(artifacts.storageLayout, compiledContract.storageLayout);
+		store(artifacts.userDocumentation, compiledContract.userDocumentation);
+		store(artifacts.devDocumentation, compiledContract.devDocumentation);
+	}
+	m_artifactCache = move(artifactCache);
+}
+
+h256 CompilerStack::astCacheKey(string const& _path, Source const& _source, int64_t _previousNodeID) const
+{
+	return util::keccak256(
+		_path + '\0' +
+		_source.keccak256().hex() + '\0' +
+		m_evmVersion.name() + '\0' +
+		(m_parserErrorRecovery ? "1" : "0") + '\0' +
+		(m_functionBodiesSkipped ? "1" : "0") + '\0' +
+		to_string(_previousNodeID)
+	);
+}
+
+bytesConstRef CompilerStack::Source::content() const
+{
+	string_view const source = charStream->source();
+	return bytesConstRef(reinterpret_cast<uint8_t const*>(source.data()), source.size());
+}
+
 h256 const& CompilerStack::Source::keccak256() const
 {
 	if (keccak256HashCached == h256{})
-		keccak256HashCached = util::keccak256(charStream->source());
+		keccak256HashCached = util::keccak256(content());
 	return keccak256HashCached;
 }
 
 h256 const& CompilerStack::Source::swarmHash() const
 {
 	if (swarmHashCached == h256{})
-		swarmHashCached = util::bzzr1Hash(charStream->source());
+		swarmHashCached = util::bzzr1Hash(content());
 	return swarmHashCached;
 }
 
 string const& CompilerStack::Source::ipfsUrl() const
 {
 	if (ipfsUrlCached.empty())
-		ipfsUrlCached = "dweb:/ipfs/" + util::ipfsHashBase58(charStream->source());
+		ipfsUrlCached = "dweb:/ipfs/" + util::ipfsHashBase58(content());
 	return ipfsUrlCached;
 }
 
@@ -1120,10 +1968,7 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 				if (m_sources.count(importPath) || newSources.count(importPath))
 					continue;
 
-				ReadCallback::Result result{false, string("File not supplied initially.")};
-				if (m_readFile)
-					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
-
+				ReadCallback::Result result = readSource(importPath);
 				if (result.success)
 					newSources[importPath] = result.responseOrErrorMessage;
 				else
@@ -1144,6 +1989,47 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 	return newSources;
 }
 
+void CompilerStack::prefetchMissingSources(vector<pair<string, SourceUnit const*>> const& _sources)
+{
+	vector<string> missingPaths;
+	set<string> seen;
+	for (auto const& [path, ast]: _sources)
+		if (ast)
+			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(ast->nodes()))
+			{
+				string importPath = importedPath(*import, path);
+				if (!m_sources.count(importPath) && seen.insert(importPath).second)
+					missingPaths.emplace_back(move(importPath));
+			}
+	if (missingPaths.empty())
+		return;
+
+	vector<ReadCallback::Result> results = m_readFiles(
+		ReadCallback::kindString(ReadCallback::Kind::ReadFile),
+		missingPaths
+	);
+	solAssert(results.size() == missingPaths.size(), "Batch read callback returned the wrong number of results.");
+	for (size_t i = 0; i < missingPaths.size(); ++i)
+		m_prefetchedSources[move(missingPaths[i])] = move(results[i]);
+}
+
+ReadCallback::Result CompilerStack::readSource(string const& _path)
+{
+	if (auto prefetched = m_prefetchedSources.find(_path); prefetched != m_prefetchedSources.end())
+		return prefetched->second;
+
+	string const kind = ReadCallback::kindString(ReadCallback::Kind::ReadFile);
+	if (m_readFile)
+		return m_readFile(kind, _path);
+	if (m_readFiles)
+	{
+		vector<ReadCallback::Result> results = m_readFiles(kind, {_path});
+		solAssert(results.size() == 1, "Batch read callback returned the wrong number of results.");
+		return move(results.front());
+	}
+	return {false, "File not supplied initially."};
+}
+
 string CompilerStack::applyRemapping(string const& _path, string const& _context)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
@@ -1196,7 +2082,12 @@ void CompilerStack::storeContractDefinitions()
 				// thus contracts can only conflict if declared in the same source file. This
 				// should already cause a double-declaration error elsewhere.
 				if (!m_contracts.count(fullyQualifiedName))
-					m_contracts[fullyQualifiedName].contract = contract;
+				{
+					Contract& compiledContract = m_contracts[fullyQualifiedName];
+					compiledContract.contract = contract;
+					if (m_collectTimings)
+						compiledContract.timings = make_shared<util::TimingCollector>();
+				}
 			}
 }
 
@@ -1246,6 +2137,11 @@ void CompilerStack::assemble(
 	{
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
+}
+
+void CompilerStack::checkRuntimeCodeSize(ContractDefinition const& _contract)
+{
+	Contract const& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	// Throw a warning if EIP-170 limits are exceeded:
 	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
@@ -1285,10 +2181,13 @@ void CompilerStack::compileContract(
 	if (!_contract.canBeDeployed())
 		return;
 
+	util::ScopedTraceSpan span(_contract.fullyQualifiedName(), "contract");
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
 	compiledContract.compiler = compiler;
+	compiler->setFunctionCaches(m_compiledFunctionCache.get(), m_yulFunctionCache.get());
+	compiler->setOptimiseCreationCode(m_optimiseCreationCode || m_contractsCreatedByOthers.count(&_contract));
 
 	solAssert(!m_viaIR, "");
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract, /* _forIR */ false);
@@ -1296,7 +2195,7 @@ void CompilerStack::compileContract(
 	try
 	{
 		// Run optimiser and compile the contract.
-		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata, compiledContract.timings.get());
 	}
 	catch(evmasm::OptimizerException const&)
 	{
@@ -1305,10 +2204,17 @@ void CompilerStack::compileContract(
 
 	_otherCompilers[compiledContract.contract] = compiler;
 
-	assemble(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
+	{
+		util::ScopedTimer timer(compiledContract.timings.get(), "evmAssembly");
+		assemble(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
+	}
+	checkRuntimeCodeSize(_contract);
 }
 
-void CompilerStack::generateIR(ContractDefinition const& _contract)
+void CompilerStack::generateIR(
+	ContractDefinition const& _contract,
+	vector<PendingIROptimisation>* o_pendingOptimisations
+)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 	if (m_hasError)
@@ -1328,24 +2234,45 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 
 	string dependenciesSource;
 	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
-		generateIR(*dependency);
+		generateIR(*dependency, o_pendingOptimisations);
 
 	if (!_contract.canBeDeployed())
 		return;
 
+	util::ScopedTraceSpan span(_contract.fullyQualifiedName(), "contract");
 	map<ContractDefinition const*, string_view const> otherYulSources;
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
 
-	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings, sourceIndices(), m_debugInfoSelection, this);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(
-		_contract,
-		createCBORMetadata(compiledContract, /* _forIR */ true),
-		otherYulSources
+	auto generator = make_unique<IRGenerator>(
+		m_evmVersion,
+		m_revertStrings,
+		m_optimiserSettings,
+		sourceIndices(),
+		m_debugInfoSelection,
+		this
 	);
+	generator->setFunctionCache(m_yulFunctionCache.get());
+	bytes cborEncodedMetadata = createCBORMetadata(compiledContract, /* _forIR */ true);
+	{
+		util::ScopedTimer timer(compiledContract.timings.get(), "irGeneration");
+		compiledContract.yulIR = generator->generateUnoptimized(_contract, cborEncodedMetadata, otherYulSources);
+	}
+	if (o_pendingOptimisations)
+		o_pendingOptimisations->push_back({&_contract, move(generator)});
+	else
+	{
+		util::ScopedTimer timer(compiledContract.timings.get(), "irOptimisation");
+		compiledContract.yulIROptimized = generator->optimize(
+			compiledContract.yulIR,
+			1,
+			m_optimiserStepTimings.get(),
+			m_viaIR && m_generateEvmBytecode ? &compiledContract.yulIROptimizedStack : nullptr
+		);
+	}
 }
 
-void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
+void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract, size_t _parallelism)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 	if (m_hasError)
@@ -1359,21 +2286,35 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::AssemblyStack stack(
-		m_evmVersion,
-		yul::AssemblyStack::Language::StrictAssembly,
-		m_optimiserSettings,
-		m_debugInfoSelection
-	);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	stack.optimize();
+	util::ScopedTraceSpan span(_contract.fullyQualifiedName(), "contract");
 
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+	// The object the optimised IR was printed from is equivalent to the result of parsing it.
+	shared_ptr<yul::AssemblyStack> stack = move(compiledContract.yulIROptimizedStack);
+	if (!stack)
+	{
+		// Re-parse the Yul IR in EVM dialect
+		stack = make_shared<yul::AssemblyStack>(
+			m_evmVersion,
+			yul::AssemblyStack::Language::StrictAssembly,
+			m_optimiserSettings,
+			m_debugInfoSelection
+		);
+		stack->parseAndAnalyze("", compiledContract.yulIROptimized);
+	}
+	stack->setParallelism(_parallelism);
+	stack->setOptimiserStepTimings(m_optimiserStepTimings.get());
+	stack->setAssemblyCache(m_evmAssemblyCache.get());
+	{
+		util::ScopedTimer timer(compiledContract.timings.get(), "irOptimisation");
+		stack->optimize();
+	}
 
+	//cout << yul::AsmPrinter{}(*stack->parserResult()->code) << endl;
+
+	util::ScopedTimer timer(compiledContract.timings.get(), "evmCodeGeneration");
 	string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
-	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
+	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack->assembleEVMWithDeployed(deployedName);
 	assemble(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
 }
 
@@ -1391,6 +2332,8 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 	if (!compiledContract.ewasm.empty())
 		return;
 
+	util::ScopedTraceSpan span(_contract.fullyQualifiedName(), "contract");
+	util::ScopedTimer timer(compiledContract.timings.get(), "ewasmGeneration");
 	// Re-parse the Yul IR in EVM dialect
 	yul::AssemblyStack stack(
 		m_evmVersion,
@@ -1398,6 +2341,7 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 		m_optimiserSettings,
 		m_debugInfoSelection
 	);
+	stack.setOptimiserStepTimings(m_optimiserStepTimings.get());
 	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
 
 	stack.optimize();
@@ -1476,7 +2420,7 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 		if (optional<string> licenseString = s.second.ast->licenseString())
 			meta["sources"][s.first]["license"] = *licenseString;
 		if (m_metadataLiteralSources)
-			meta["sources"][s.first]["content"] = s.second.charStream->source();
+			meta["sources"][s.first]["content"] = string(s.second.charStream->source());
 		else
 		{
 			meta["sources"][s.first]["urls"] = Json::arrayValue;
@@ -1681,6 +2625,18 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 		return Json::Value(util::toString(_gas.value));
 }
 
+/// TODO: This could move into a method shared with externalSignature()
+string internalSignature(FunctionDefinition const& _function)
+{
+	FunctionType type(_function);
+	string sig = _function.name() + "(";
+	auto paramTypes = type.parameterTypes();
+	for (auto it = paramTypes.begin(); it != paramTypes.end(); ++it)
+		sig += (*it)->toString() + (it + 1 == paramTypes.end() ? "" : ",");
+	sig += ")";
+	return sig;
+}
+
 }
 
 Json::Value CompilerStack::gasEstimates(string const& _contractName) const
@@ -1691,6 +2647,9 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 	if (!assemblyItems(_contractName) && !runtimeAssemblyItems(_contractName))
 		return Json::Value();
 
+	if (m_viaIR)
+		return gasEstimatesFromIR(_contractName);
+
 	using Gas = GasEstimator::GasConsumption;
 	GasEstimator gasEstimator(m_evmVersion);
 	Json::Value output(Json::objectValue);
@@ -1742,15 +2701,7 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 			if (entry > 0)
 				gas = gasEstimator.functionalEstimation(*items, entry, *it);
 
-			/// TODO: This could move into a method shared with externalSignature()
-			FunctionType type(*it);
-			string sig = it->name() + "(";
-			auto paramTypes = type.parameterTypes();
-			for (auto it = paramTypes.begin(); it != paramTypes.end(); ++it)
-				sig += (*it)->toString() + (it + 1 == paramTypes.end() ? "" : ",");
-			sig += ")";
-
-			internalFunctions[sig] = gasToJson(gas);
+			internalFunctions[internalSignature(*it)] = gasToJson(gas);
 		}
 
 		if (!internalFunctions.empty())
@@ -1759,3 +2710,145 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 
 	return output;
 }
+
+Json::Value CompilerStack::gasEstimatesFromIR(string const& _contractName) const
+{
+	Contract const& compiledContract = contract(_contractName);
+	ContractDefinition const& definition = *compiledContract.contract;
+	solAssert(!compiledContract.yulIROptimized.empty(), "");
+
+	using Gas = GasEstimator::GasConsumption;
+	yul::AssemblyStack stack(
+		m_evmVersion,
+		yul::AssemblyStack::Language::StrictAssembly,
+		m_optimiserSettings,
+		m_debugInfoSelection
+	);
+	bool analysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	solAssert(analysisSuccessful, "");
+	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVMObjects(m_evmVersion);
+
+	shared_ptr<yul::Object> creationObject = stack.parserResult();
+	auto buildCFG = [&](yul::Object const& _object) {
+		solAssert(_object.code && _object.analysisInfo, "");
+		return yul::ControlFlowGraphBuilder::build(*_object.analysisInfo, dialect, *_object.code);
+	};
+	Json::Value output(Json::objectValue);
+
+	{
+		unique_ptr<yul::CFG> cfg = buildCFG(*creationObject);
+		Gas executionGas = yul::ControlFlowGasEstimator(*cfg, dialect).mainGas();
+		Gas codeDepositGas{evmasm::GasMeter::dataGas(runtimeObject(_contractName).bytecode, false, m_evmVersion)};
+
+		Json::Value creation(Json::objectValue);
+		creation["codeDepositCost"] = gasToJson(codeDepositGas);
+		creation["executionCost"] = gasToJson(executionGas);
+		executionGas += codeDepositGas;
+		creation["totalCost"] = gasToJson(executionGas);
+		output["creation"] = creation;
+	}
+
+	auto runtimeObjectIndex = creationObject->subIndexByName.find(yul::YulString(IRNames::deployedObject(definition)));
+	solAssert(runtimeObjectIndex != creationObject->subIndexByName.end(), "");
+	auto runtime = dynamic_pointer_cast<yul::Object>(creationObject->subObjects.at(runtimeObjectIndex->second));
+	solAssert(runtime, "");
+	unique_ptr<yul::CFG> cfg = buildCFG(*runtime);
+	yul::ControlFlowGasEstimator estimator(*cfg, dialect, m_parallelism);
+
+	/// External functions take the case of the dispatcher for their selector.
+	auto const& interfaceFunctions = definition.interfaceFunctionList();
+	vector<Gas> externalGas(interfaceFunctions.size());
+	util::parallelFor(interfaceFunctions.size(), m_parallelism, [&](size_t _index) {
+		externalGas[_index] = estimator.mainGas(u256(FixedHash<4>::Arith(interfaceFunctions[_index].first)));
+	});
+	Json::Value externalFunctions(Json::objectValue);
+	for (size_t i = 0; i < interfaceFunctions.size(); ++i)
+		externalFunctions[interfaceFunctions[i].second->externalSignature()] = gasToJson(externalGas[i]);
+
+	if (definition.fallbackFunction())
+		/// The selector of an invalid signature does not match any case of the dispatcher.
+		externalFunctions[""] = gasToJson(estimator.mainGas(u256(FixedHash<4>::Arith(FixedHash<4>(util::keccak256("INVALID"))))));
+
+	if (!externalFunctions.empty())
+		output["external"] = externalFunctions;
+
+	/// Internal functions
+	Json::Value internalFunctions(Json::objectValue);
+	for (auto const& it: definition.definedFunctions())
+	{
+		/// Exclude externally visible functions, constructor, fallback and receive ether function
+		if (it->isPartOfExternalInterface() || !it->isOrdinary())
+			continue;
+
+		/// Functions that were inlined or removed by the optimizer have no estimate.
+		optional<Gas> gas = estimator.functionGas(yul::YulString(IRNames::function(*it)));
+		internalFunctions[internalSignature(*it)] = gasToJson(gas ? *gas : Gas::infinite());
+	}
+
+	if (!internalFunctions.empty())
+		output["internal"] = internalFunctions;
+
+	return output;
+}
+
+Json::Value CompilerStack::timingJSON() const
+{
+	if (!m_stageTimings)
+		return Json::nullValue;
+
+	auto timingsToJson = [](util::TimingCollector const& _timings, bool _withPeakMemory, bool _withChanges = false)
+	{
+		Json::Value output(Json::objectValue);
+		for (auto const& [phase, entry]: _timings.entries())
+		{
+			Json::Value& phaseOutput = output[phase];
+			phaseOutput["wallTime"] = Json::UInt64(chrono::duration_cast<chrono::microseconds>(entry.wallTime).count());
+			phaseOutput["count"] = Json::UInt64(entry.count);
+			if (_withPeakMemory)
+				phaseOutput["peakMemory"] = Json::UInt64(entry.peakMemory);
+			if (_withChanges || entry.changes > 0)
+			{
+				phaseOutput["changes"] = Json::UInt64(entry.changes);
+				phaseOutput["sizeDelta"] = Json::Int64(entry.sizeDelta);
+			}
+		}
+		return output;
+	};
+
+	// Sums up the statistics of the evmasm optimiser passes over @a _assembly and its sub-assemblies.
+	std::function<void(evmasm::Assembly const&, Json::Value&)> addOptimiserPasses =
+		[&](evmasm::Assembly const& _assembly, Json::Value& _output)
+		{
+			for (auto const& [pass, statistics]: _assembly.optimiserReport().passes)
+			{
+				Json::Value& passOutput = _output[pass];
+				passOutput["wallTime"] = Json::UInt64(passOutput["wallTime"].asUInt64() + Json::UInt64(statistics.time.count()));
+				passOutput["changes"] = Json::UInt64(passOutput["changes"].asUInt64() + statistics.changes);
+			}
+			for (size_t subId = 0; subId < _assembly.numSubs(); ++subId)
+				addOptimiserPasses(_assembly.sub(subId), _output);
+		};
+
+	Json::Value output(Json::objectValue);
+	output["stages"] = timingsToJson(*m_stageTimings, true);
+	output["contracts"] = Json::objectValue;
+	for (auto const& [name, compiledContract]: m_contracts)
+		if (compiledContract.timings)
+		{
+			Json::Value contractOutput = timingsToJson(*compiledContract.timings, false);
+			if (compiledContract.evmAssembly)
+			{
+				Json::Value passes(Json::objectValue);
+				addOptimiserPasses(*compiledContract.evmAssembly, passes);
+				if (!passes.empty())
+					contractOutput["evmAssemblyOptimiserPasses"] = move(passes);
+			}
+			if (!contractOutput.empty())
+				output["contracts"][compiledContract.contract->sourceUnitName()][compiledContract.contract->name()] = move(contractOutput);
+		}
+	output["optimiserSteps"] = timingsToJson(*m_optimiserStepTimings, false, true);
+	Type::MemberCacheStatistics const memberCache = Type::memberCacheStatistics();
+	output["memberCache"]["hits"] = Json::UInt64(memberCache.hits);
+	output["memberCache"]["misses"] = Json::UInt64(memberCache.misses);
+	return output;
+}
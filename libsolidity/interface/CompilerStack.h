@@ -25,6 +25,7 @@
 #pragma once
 
 #include <libsolidity/analysis/FunctionCallGraph.h>
+#include <libsolidity/interface/BytecodeCache.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -46,6 +47,7 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
+#include <libsolutil/Timing.h>
 
 #include <json/json.h>
 
@@ -61,6 +63,11 @@ namespace solidity::langutil
 class CharStream;
 }
 
+namespace solidity::util
+{
+class MemoryMappedFile;
+}
+
 
 namespace solidity::evmasm
 {
@@ -69,6 +76,12 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 }
 
+namespace solidity::yul
+{
+class AssemblyStack;
+class EVMAssemblyCache;
+}
+
 namespace solidity::frontend
 {
 
@@ -76,11 +89,17 @@ namespace solidity::frontend
 class ASTNode;
 class ContractDefinition;
 class FunctionDefinition;
+class ImportDirective;
 class SourceUnit;
 class Compiler;
+class CompiledFunctionCache;
+class IRGenerator;
+class MultiUseYulFunctionCache;
 class GlobalContext;
+class NameAndTypeResolver;
 class Natspec;
 class DeclarationContainer;
+class TypeProvider;
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -88,6 +107,9 @@ class DeclarationContainer;
  * before compilation to bytecode) or run the whole compilation in one call.
  * If error recovery is active, it is possible to progress through the stages even when
  * there are errors. In any case, producing code is only possible without errors.
+ * Every compiler stack owns the types it creates. Compiler stacks on different threads are
+ * independent, but there can only be one per thread at a time and it has to be used on the
+ * thread that created it.
  */
 class CompilerStack: public langutil::CharStreamProvider
 {
@@ -102,9 +124,23 @@ public:
 		Parsed,
 		ParsedAndImported,
 		AnalysisPerformed,
+		/// Only reached when stopping after the IR generation, in which case no EVM or Ewasm code is generated.
+		IRGenerated,
 		CompilationSuccessful
 	};
 
+	/// Intermediate results of the code generation of a contract, which are only needed for some
+	/// of its outputs and while the contracts that depend on it are compiled.
+	struct Intermediates
+	{
+		/// The legacy code generator and the EVM assemblies, used for the assembly outputs, the
+		/// gas estimates, the generated sources and the timings of the assembly optimiser.
+		bool evmAssembly = true;
+		bool ir = true;
+		bool irOptimized = true;
+		bool ewasm = true;
+	};
+
 	enum class MetadataFormat {
 		WithReleaseVersionTag,
 		WithPrereleaseVersionTag,
@@ -165,6 +201,12 @@ public:
 		m_parserErrorRecovery = _wantErrorRecovery;
 	}
 
+	/// Sets whether the bodies of functions and modifiers are left unparsed if the compilation
+	/// stops after parsing, which suffices for requests about declarations only.
+	/// If a later stage is requested anyway, the sources are parsed again with all bodies.
+	/// Must be set before parsing.
+	void setLazyFunctionBodies(bool _lazyFunctionBodies) { m_lazyFunctionBodies = _lazyFunctionBodies; }
+
 	/// Sets the pipeline to go through the Yul IR or not.
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
@@ -189,12 +231,71 @@ public:
 	/// Enable EVM Bytecode generation. This is enabled by default.
 	void enableEvmBytecodeGeneration(bool _enable = true) { m_generateEvmBytecode = _enable; }
 
+	/// Enable the optimisation of the creation code by the EVM assembly optimiser. This is enabled
+	/// by default. If disabled, the legacy code generator does not optimise the creation code of
+	/// contracts that are not created by other contracts and the bytecode cache is not used.
+	/// The runtime code does not change, so this can be disabled if only runtime outputs are needed.
+	void enableCreationCodeOptimisation(bool _enable = true) { m_optimiseCreationCode = _enable; }
+
 	/// Enable experimental generation of Yul IR code.
 	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
 
 	/// Enable experimental generation of Ewasm code. If enabled, IR is also generated.
 	void enableEwasmGeneration(bool _enable = true) { m_generateEwasm = _enable; }
 
+	/// Sets the maximum number of threads used during compilation. If it is larger than one,
+	/// the sources are parsed in parallel unless the AST cache is enabled, some of the analysis
+	/// checks run for several sources in parallel, and the optimisation of the IR and the
+	/// generation of EVM and Ewasm code from the IR are performed for several contracts in
+	/// parallel. The model checker analyzes several contracts in parallel, or, for a single
+	/// contract, the SMT solvers of the BMC engine answer each query in parallel.
+	/// The output does not depend on this setting, except for the answers of the model checker,
+	/// which does not share knowledge between contracts analyzed in parallel, and whose CHC engine
+	/// checks the verification targets in parallel using copies of the Horn system.
+	/// Must be set before compiling.
+	void setParallelism(size_t _parallelism);
+
+	/// Sets the callback used to read all files that are imported by the sources parsed so far
+	/// and not yet known at once. If it is set, the sources are parsed in rounds, unless the AST
+	/// cache is enabled, and the imports of each round are read with a single call. The callback
+	/// passed to the constructor is still used for the other queries.
+	/// Must be set before parsing.
+	void setBatchReadCallback(ReadCallback::BatchCallback _readFiles);
+
+	/// Enables or disables the reuse of parsed sources across calls to `reset(true)`.
+	/// A source is not parsed again if its name, its contents, the EVM version, the error recovery
+	/// setting and the IDs its AST nodes would receive are the same as in the previous run.
+	/// If the previous analysis of such a source was successful and did not report anything about it,
+	/// and the same holds for all sources it imports directly or indirectly, the results of the analysis
+	/// are reused as well and only the other sources are analysed again.
+	/// The ABI, the storage layout and the Natspec documentation of a contract are kept as well and
+	/// reused as long as neither its source nor any of the sources this imports change.
+	/// Disabling the cache discards its contents.
+	/// Must be set before parsing.
+	void enableASTCache(bool _enable = true);
+
+	/// Sets the cache that is consulted before generating EVM code for a contract and that
+	/// receives the outputs of contracts compiled afterwards. Contracts taken from the cache have
+	/// no assembly items, so gas estimates are not available for them.
+	/// The cache is not used if IR or Ewasm generation is enabled.
+	/// Must be set before compiling.
+	void setBytecodeCache(std::shared_ptr<BytecodeCache const> _cache);
+
+	/// Enables releasing the intermediate results of the code generation of a contract as soon as
+	/// no contract that is compiled afterwards depends on it, except those @a _retainedIntermediates
+	/// returns for its fully qualified name. The bytecode and the source mappings are always kept,
+	/// so a contract can still be created by others. Contracts compiled in parallel are only released
+	/// at the end of the compilation. Nothing is released if the bytecode cache is used.
+	/// An empty function disables the release.
+	/// Must be set before compiling.
+	void enableIntermediateRelease(std::function<Intermediates(std::string const&)> _retainedIntermediates);
+
+	/// Enables the collection of the wall time and the peak memory usage of the compilation stages,
+	/// of the time spent in the code generation of each contract and in each Yul optimiser step.
+	/// The results are available through timingJSON().
+	/// Must be set before parsing.
+	void enableTimingCollection(bool _enable = true);
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -210,6 +311,11 @@ public:
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
 
+	/// Sets the sources, some of which are memory-mapped files. The mapped sources are
+	/// referenced instead of copied and the files are kept mapped as long as they are in use.
+	/// Must be set before parsing.
+	void setSources(StringMap _sources, std::map<std::string, std::shared_ptr<util::MemoryMappedFile const>> _mappedSources);
+
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
 	void addSMTLib2Response(util::h256 const& _hash, std::string const& _response);
@@ -220,7 +326,7 @@ public:
 
 	/// Imports given SourceUnits so they can be analyzed. Leads to the same internal state as parse().
 	/// Will throw errors if the import fails
-	void importASTs(std::map<std::string, Json::Value> const& _sources);
+	void importASTs(std::map<std::string, Json::Value> _sources);
 
 	/// Performs the analysis steps (imports, scopesetting, syntaxCheck, referenceResolving,
 	///  typechecking, staticAnalysis) on previously parsed sources.
@@ -232,9 +338,17 @@ public:
 	bool parseAndAnalyze(State _stopAfter = State::CompilationSuccessful);
 
 	/// Compiles the source units that were previously added and parsed.
+	/// If @a _stopAfter is IRGenerated, only the IR of the contracts is generated and optimised.
 	/// @returns false on error.
 	bool compile(State _stopAfter = State::CompilationSuccessful);
 
+	/// Discards the results of the code generation and the diagnostics it reported, so that the
+	/// contracts can be compiled again using @a _optimiserSettings and @a _viaIR, reusing the results
+	/// of parsing and analysis. The Yul optimiser can only be enabled if the analysis was performed
+	/// with it, since the analysis rejects some inline assembly only if it is enabled.
+	/// Must be called after a successful analysis.
+	void resetCompilation(OptimiserSettings _optimiserSettings, bool _viaIR);
+
 	/// @returns the list of sources (paths) used
 	std::vector<std::string> sourceNames() const;
 
@@ -256,6 +370,11 @@ public:
 	/// by calling @a addSMTLib2Response).
 	std::vector<std::string> const& unhandledSMTLib2Queries() const { return m_unhandledSMTLib2Queries; }
 
+	/// Releases all intermediate results of the code generation of a contract, once its outputs
+	/// that need them are generated. The bytecode, the source mappings and the outputs of the
+	/// analysis remain available.
+	void releaseIntermediates(std::string const& _contractName);
+
 	/// @returns a list of the contract names in the sources.
 	std::vector<std::string> contractNames() const;
 
@@ -344,6 +463,14 @@ public:
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
 	Json::Value gasEstimates(std::string const& _contractName) const;
 
+	/// @returns a JSON object with the collected timings or null if timing collection is disabled.
+	/// Wall times are given in microseconds, memory usage in bytes.
+	Json::Value timingJSON() const;
+
+	/// @returns the statistics of the Yul optimiser steps summed up over all objects
+	/// or nullptr if timing collection is disabled.
+	util::TimingCollector const* optimiserStepTimings() const { return m_optimiserStepTimings.get(); }
+
 	/// Changes the format of the metadata appended at the end of the bytecode.
 	/// This is mostly a workaround to avoid bytecode and gas differences between compiler builds
 	/// caused by differences in metadata. Should only be used for testing.
@@ -358,7 +485,13 @@ private:
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
+		/// Key of the AST in the AST cache, if it is enabled.
+		util::h256 astCacheKey;
+		/// Whether the annotations of a previous analysis are kept and the source is not analysed again.
+		bool analysisReused = false;
 		void reset() { *this = Source(); }
+		/// @returns the text of the source without copying it.
+		bytesConstRef content() const;
 		util::h256 const& keccak256() const;
 		util::h256 const& swarmHash() const;
 		std::string const& ipfsUrl() const;
@@ -375,6 +508,8 @@ private:
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
 		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		/// The analysed object of the optimized IR, from the optimisation until EVM code is generated from it.
+		std::shared_ptr<yul::AssemblyStack> yulIROptimizedStack;
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -384,10 +519,78 @@ private:
 		util::LazyInit<Json::Value const> devDocumentation;
 		util::LazyInit<Json::Value const> generatedSources;
 		util::LazyInit<Json::Value const> runtimeGeneratedSources;
+		util::LazyInit<Json::Value const> assemblyJSON;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		/// Key of the ABI, storage layout and Natspec outputs in the artifact cache, if the AST
+		/// cache is enabled and the analysis was successful.
+		std::optional<util::h256> artifactCacheKey;
+		/// Outputs taken from the bytecode cache instead of being generated.
+		std::shared_ptr<BytecodeCache::Entry const> cachedOutputs;
+		/// Time spent in the code generation phases of this contract, if collected.
+		std::shared_ptr<util::TimingCollector> timings;
+	};
+
+	/// An AST that can be reused by the next parse.
+	struct CachedSourceUnit
+	{
+		std::shared_ptr<SourceUnit> ast;
+		/// ID of the last node of the AST, so that parsing can continue after it.
+		int64_t lastNodeID = 0;
+		/// Whether the annotations of the AST are the result of a successful analysis that did
+		/// not report anything about this source.
+		bool analysed = false;
 	};
 
+	/// Outputs of a contract that only depend on the analysis, kept while the AST cache is enabled.
+	struct CachedArtifacts
+	{
+		std::optional<Json::Value> abi;
+		std::optional<Json::Value> storageLayout;
+		std::optional<Json::Value> userDocumentation;
+		std::optional<Json::Value> devDocumentation;
+	};
+
+	/// Parses all source units that were added, skipping function bodies if @a _skipFunctionBodies is true.
+	bool parseSources(bool _skipFunctionBodies);
+	/// Parses @a _sourcesToParse, and the sources they import, using up to m_parallelism threads.
+	/// Each source is parsed with its own parser and error reporter. The node IDs and the order of
+	/// the errors are the same as if the sources were parsed one after another.
+	/// The sources imported by a round of sources are read at once if m_readFiles is set.
+	void parseInParallel(std::vector<std::string>& _sourcesToParse, bool _skipFunctionBodies);
+	/// Annotates the paths of the freshly parsed source at @a _path if @a _annotatePaths is true,
+	/// and appends the sources it imports that are not yet known to @a _sourcesToParse.
+	void processParsedSource(std::string const& _path, bool _annotatePaths, std::vector<std::string>& _sourcesToParse);
+
+	/// @returns the key of @a _source in the AST cache, if its AST starts after the node
+	/// with the ID @a _previousNodeID.
+	util::h256 astCacheKey(std::string const& _path, Source const& _source, int64_t _previousNodeID) const;
+
+	/// Marks the sources whose analysis can be reused, i.e. those with an analysed AST from
+	/// the cache that only import such sources, and clears the annotations of all other reused ASTs.
+	void determineReusableAnalysis();
+	/// Discards the collected timings and creates new collectors if timing collection is enabled.
+	void resetTimings();
+
+	/// Records in the AST cache which sources were analysed without reporting anything about them.
+	void storeAnalysisResultsInCache();
+	/// Determines the keys of the contracts in the artifact cache, which are derived from the
+	/// AST cache keys of their sources and of the sources those import directly or indirectly,
+	/// and initializes the outputs of the contracts that are in the cache.
+	void loadArtifactsFromCache();
+	/// Replaces the artifact cache by the outputs generated for or taken from the cache by the
+	/// current contracts.
+	void storeArtifactsInCache();
+
+	/// Runs @a _check on the AST of each of @a _sources with an error reporter of its own, on up to
+	/// m_parallelism threads. The errors are reported in the order of the sources, as if the checks
+	/// ran one after another. @a _check must only modify the annotations of its own source.
+	/// @returns false if any of the checks returned false.
+	bool checkSources(
+		std::vector<Source const*> const& _sources,
+		std::function<bool(SourceUnit const&, langutil::ErrorReporter&)> const& _check
+	);
+
 	void createAndAssignCallGraphs();
 	void findAndReportCyclicContractDependencies();
 
@@ -395,7 +598,16 @@ private:
 	/// @a m_readFile
 	/// @returns the newly loaded sources.
 	StringMap loadMissingSources(SourceUnit const& _ast);
+	/// Reads the sources imported by the freshly parsed @a _sources (by path) that are not yet known
+	/// using a single call of @a m_readFiles and stores them for loadMissingSources().
+	void prefetchMissingSources(std::vector<std::pair<std::string, SourceUnit const*>> const& _sources);
+	/// @returns the source at @a _path, read either before by prefetchMissingSources() or now.
+	ReadCallback::Result readSource(std::string const& _path);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
+	/// @returns the absolute path of the source imported by @a _import from the source @a _path.
+	std::string importedPath(ImportDirective const& _import, std::string const& _path);
+	/// Stores the path of the source @a _ast and the absolute paths of its imports in its annotations.
+	void annotatePaths(std::string const& _path, SourceUnit& _ast);
 	void resolveImports();
 
 	/// Store the contract definitions in m_contracts.
@@ -407,6 +619,33 @@ private:
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
+	/// @returns true if a bytecode cache is set and the requested outputs can be taken from it.
+	bool useBytecodeCache() const;
+	/// @returns the key of the EVM outputs of @a _contract in the bytecode cache.
+	util::h256 bytecodeCacheKey(Contract const& _contract) const;
+	/// Takes the outputs of those of @a _contracts that are in the bytecode cache from it.
+	/// @returns the contracts that still have to be compiled.
+	std::vector<ContractDefinition const*> loadFromBytecodeCache(std::vector<ContractDefinition const*> const& _contracts);
+	/// Stores the outputs of @a _contracts in the bytecode cache.
+	void storeInBytecodeCache(std::vector<ContractDefinition const*> const& _contracts) const;
+	/// Releases the intermediates of @a _contract except @a _retained, computing its source
+	/// mappings first.
+	void releaseIntermediates(Contract& _contract, Intermediates const& _retained);
+
+	/// IR generator of a contract whose IR has been generated but not yet optimised.
+	struct PendingIROptimisation
+	{
+		ContractDefinition const* contract = nullptr;
+		std::unique_ptr<IRGenerator> generator;
+	};
+
+	/// Compiles the given contracts using up to m_parallelism threads.
+	/// IR generation and the legacy code generator access the AST and the type provider and
+	/// thus run sequentially, while the optimisation of the IR and the generation of EVM and
+	/// Ewasm code from it are performed in parallel. Threads that are not needed for separate
+	/// contracts are used to optimise the sub-objects of a contract in parallel.
+	void compileInParallel(std::vector<ContractDefinition const*> const& _contracts);
+
 	/// Assembles the contract.
 	/// This function should only be internally called by compileContract and generateEVMFromIR.
 	void assemble(
@@ -415,6 +654,10 @@ private:
 		std::shared_ptr<evmasm::Assembly> _runtimeAssembly
 	);
 
+	/// Issues a warning if the runtime code of the assembled contract exceeds the limit
+	/// introduced in Spurious Dragon.
+	void checkRuntimeCodeSize(ContractDefinition const& _contract);
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
@@ -425,11 +668,19 @@ private:
 
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
-	void generateIR(ContractDefinition const& _contract);
+	/// If @a o_pendingOptimisations is given, the IR of the contract and its dependencies is
+	/// not optimised. Instead, the generators are appended to it, so that the optimisation can
+	/// be performed later.
+	void generateIR(
+		ContractDefinition const& _contract,
+		std::vector<PendingIROptimisation>* o_pendingOptimisations = nullptr
+	);
 
-	/// Generate EVM representation for a single contract.
-	/// Depends on output generated by generateIR.
-	void generateEVMFromIR(ContractDefinition const& _contract);
+	/// Generate EVM representation for a single contract, using up to @a _parallelism threads
+	/// to optimise its sub-objects.
+	/// Depends on output generated by generateIR. Uses the optimised object kept by generateIR
+	/// if there is one and parses the optimised IR otherwise.
+	void generateEVMFromIR(ContractDefinition const& _contract, size_t _parallelism = 1);
 
 	/// Generate Ewasm representation for a single contract.
 	/// Depends on output generated by generateIR.
@@ -472,6 +723,10 @@ private:
 	/// This will generate the JSON object and store it in the Contract object if it is not present yet.
 	Json::Value const& natspecDev(Contract const&) const;
 
+	/// @returns the gas estimates of a contract compiled via the IR, which are computed on the
+	/// control flow graph of its optimized IR.
+	Json::Value gasEstimatesFromIR(std::string const& _contractName) const;
+
 	/// @returns the Contract Metadata matching the pipeline selected using the viaIR setting.
 	/// This will generate the metadata and store it in the Contract object if it is not present yet.
 	std::string const& metadata(Contract const& _contract) const;
@@ -483,7 +738,13 @@ private:
 		FunctionDefinition const& _function
 	) const;
 
+	/// Owns all types. Declared first, so that it outlives everything that refers to types.
+	std::unique_ptr<TypeProvider> m_typeProvider;
+	TypeProvider* m_previousTypeProvider = nullptr;
 	ReadCallback::Callback m_readFile;
+	ReadCallback::BatchCallback m_readFiles;
+	/// Results of m_readFiles for the imports of the current round of parsing, by path.
+	std::map<std::string, ReadCallback::Result> m_prefetchedSources;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
@@ -493,15 +754,40 @@ private:
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
+	bool m_optimiseCreationCode = true;
+	/// Contracts whose creation code is part of another contract, the creation code of which has
+	/// to be optimised in any case. Only filled if the optimisation of the creation code is disabled.
+	std::set<ContractDefinition const*> m_contractsCreatedByOthers;
 	bool m_generateEwasm = false;
+	size_t m_parallelism = 1;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
 	std::map<std::string const, Source> m_sources;
+	bool m_astCacheEnabled = false;
+	/// ASTs of the sources of the last parse, keyed by astCacheKey().
+	std::map<util::h256, CachedSourceUnit> m_astCache;
+	/// Outputs of the contracts of the last analysis, keyed by their artifactCacheKey.
+	std::map<util::h256, CachedArtifacts> m_artifactCache;
+	std::shared_ptr<BytecodeCache const> m_bytecodeCache;
+	std::function<Intermediates(std::string const&)> m_retainedIntermediates;
+	bool m_collectTimings = false;
+	std::unique_ptr<util::TimingCollector> m_stageTimings;
+	std::unique_ptr<util::TimingCollector> m_optimiserStepTimings;
+	/// EVM assemblies generated from the optimised IR during the current compilation, so that
+	/// contracts with identical IR are only compiled to EVM code once.
+	std::unique_ptr<yul::EVMAssemblyCache> m_evmAssemblyCache;
+	/// Utility functions generated during the current compilation, shared by all contracts.
+	std::unique_ptr<MultiUseYulFunctionCache> m_yulFunctionCache;
+	/// Functions compiled by the legacy code generator during the current compilation, so that
+	/// inherited functions are only compiled once if they do not depend on the derived contract.
+	std::unique_ptr<CompiledFunctionCache> m_compiledFunctionCache;
 	// if imported, store AST-JSONS for each filename
 	std::map<std::string, Json::Value> m_sourceJsons;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<util::h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
+	/// Kept across resets only if the analysis of some sources is reused.
+	std::unique_ptr<NameAndTypeResolver> m_nameAndTypeResolver;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
 
@@ -511,6 +797,12 @@ private:
 	MetadataHash m_metadataHash = MetadataHash::IPFS;
 	langutil::DebugInfoSelection m_debugInfoSelection = langutil::DebugInfoSelection::Default();
 	bool m_parserErrorRecovery = false;
+	bool m_lazyFunctionBodies = false;
+	/// Whether the analysis was performed for the Yul optimiser, and the number of diagnostics it left.
+	bool m_analysedForYulOptimiser = false;
+	size_t m_diagnosticsAfterAnalysis = 0;
+	/// Whether the ASTs lack the bodies of functions and modifiers.
+	bool m_functionBodiesSkipped = false;
 	State m_stackState = Empty;
 	bool m_importedSources = false;
 	/// Whether or not there has been an error during processing.
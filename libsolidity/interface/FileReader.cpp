@@ -37,6 +37,8 @@ using solidity::util::readFileAsString;
 using solidity::util::joinHumanReadable;
 using std::map;
 using std::reference_wrapper;
+using std::set;
+using std::shared_ptr;
 using std::string;
 using std::vector;
 
@@ -86,17 +88,39 @@ void FileReader::allowDirectory(boost::filesystem::path _path)
 
 void FileReader::setSource(boost::filesystem::path const& _path, SourceCode _source)
 {
-	m_sourceCodes[cliPathToSourceUnitName(_path)] = std::move(_source);
+	string sourceUnitName = cliPathToSourceUnitName(_path);
+	m_mappedSourceCodes.erase(sourceUnitName);
+	m_sourceCodes[std::move(sourceUnitName)] = std::move(_source);
+}
+
+void FileReader::setMappedSource(boost::filesystem::path const& _path, shared_ptr<util::MemoryMappedFile const> _file)
+{
+	solAssert(_file, "");
+	string sourceUnitName = cliPathToSourceUnitName(_path);
+	m_sourceCodes.erase(sourceUnitName);
+	m_mappedSourceCodes[std::move(sourceUnitName)] = std::move(_file);
 }
 
 void FileReader::setStdin(SourceCode _source)
 {
+	m_mappedSourceCodes.erase("<stdin>");
 	m_sourceCodes["<stdin>"] = std::move(_source);
 }
 
 void FileReader::setSources(StringMap _sources)
 {
 	m_sourceCodes = std::move(_sources);
+	m_mappedSourceCodes.clear();
+}
+
+set<SourceUnitName> FileReader::sourceUnitNames() const
+{
+	set<SourceUnitName> names;
+	for (auto const& [name, source]: m_sourceCodes)
+		names.insert(name);
+	for (auto const& [name, file]: m_mappedSourceCodes)
+		names.insert(name);
+	return names;
 }
 
 ReadCallback::Result FileReader::readFile(string const& _kind, string const& _sourceUnitName)
@@ -105,6 +129,13 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 	{
 		if (_kind != ReadCallback::kindString(ReadCallback::Kind::ReadFile))
 			solAssert(false, "ReadFile callback used as callback kind " + _kind);
+		if (m_sharedSources)
+		{
+			if (auto shared = m_sharedSources->m_sourceCodes.find(_sourceUnitName); shared != m_sharedSources->m_sourceCodes.end())
+				return ReadCallback::Result{true, m_sourceCodes[_sourceUnitName] = shared->second};
+			if (auto shared = m_sharedSources->m_mappedSourceCodes.find(_sourceUnitName); shared != m_sharedSources->m_mappedSourceCodes.end())
+				return ReadCallback::Result{true, m_sourceCodes[_sourceUnitName] = string(shared->second->contents())};
+		}
 		string strippedSourceUnitName = _sourceUnitName;
 		if (strippedSourceUnitName.find("file://") == 0)
 			strippedSourceUnitName.erase(0, 7);
@@ -154,7 +185,7 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 
 		// NOTE: we ignore the FileNotFound exception as we manually check above
 		auto contents = readFileAsString(candidates[0]);
-		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
+		solAssert(m_sourceCodes.count(_sourceUnitName) == 0 && m_mappedSourceCodes.count(_sourceUnitName) == 0, "");
 		m_sourceCodes[_sourceUnitName] = contents;
 		return ReadCallback::Result{true, contents};
 	}
@@ -20,9 +20,12 @@
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsolutil/MemoryMappedFile.h>
+
 #include <boost/filesystem.hpp>
 
 #include <map>
+#include <memory>
 #include <set>
 
 namespace solidity::frontend
@@ -37,6 +40,7 @@ class FileReader
 public:
 	using StringMap = std::map<SourceUnitName, SourceCode>;
 	using PathMap = std::map<SourceUnitName, boost::filesystem::path>;
+	using MappedFileMap = std::map<SourceUnitName, std::shared_ptr<util::MemoryMappedFile const>>;
 	using FileSystemPathSet = std::set<boost::filesystem::path>;
 
 	enum SymlinkResolution {
@@ -62,11 +66,16 @@ public:
 	FileSystemPathSet const& allowedDirectories() const noexcept { return m_allowedDirectories; }
 
 	StringMap const& sourceCodes() const noexcept { return m_sourceCodes; }
+	/// Sources that were added as memory-mapped files. They are not part of @a sourceCodes().
+	MappedFileMap const& mappedSourceCodes() const noexcept { return m_mappedSourceCodes; }
+	/// @returns the names of all source units, both from @a sourceCodes() and @a mappedSourceCodes().
+	std::set<SourceUnitName> sourceUnitNames() const;
 
 	/// Retrieves the source code for a given source unit name.
 	SourceCode const& sourceCode(SourceUnitName const& _sourceUnitName) const { return m_sourceCodes.at(_sourceUnitName); }
 
 	/// Resets all sources to the given map of source unit name to source codes.
+	/// Removes all memory-mapped sources.
 	/// Does not enforce @a allowedDirectories().
 	void setSources(StringMap _sources);
 
@@ -74,6 +83,11 @@ public:
 	/// Does not enforce @a allowedDirectories().
 	void setSource(boost::filesystem::path const& _path, SourceCode _source);
 
+	/// Adds a memory-mapped file under a source unit name created by normalizing the file path.
+	/// Its content is not copied into @a sourceCodes().
+	/// Does not enforce @a allowedDirectories().
+	void setMappedSource(boost::filesystem::path const& _path, std::shared_ptr<util::MemoryMappedFile const> _file);
+
 	/// Adds the source code under the source unit name of @a <stdin>.
 	/// Does not enforce @a allowedDirectories().
 	void setStdin(SourceCode _source);
@@ -87,6 +101,11 @@ public:
 	/// already exists, previous content is discarded.
 	frontend::ReadCallback::Result readFile(std::string const& _kind, std::string const& _sourceUnitName);
 
+	/// Makes readFile() take the sources of @a _sources with the requested source unit name, if there
+	/// is one, instead of reading the file from disk. @a _sources must outlive this reader and must not
+	/// be modified while it is used, so that it can be shared by readers on several threads.
+	void setSharedSources(FileReader const* _sources) { m_sharedSources = _sources; }
+
 	frontend::ReadCallback::Callback reader()
 	{
 		return [this](std::string const& _kind, std::string const& _path) { return readFile(_kind, _path); };
@@ -156,6 +175,12 @@ private:
 
 	/// map of input files to source code strings
 	StringMap m_sourceCodes;
+
+	/// map of input files to memory-mapped source codes
+	MappedFileMap m_mappedSourceCodes;
+
+	/// Sources that are used instead of reading files from disk, if set.
+	FileReader const* m_sharedSources = nullptr;
 };
 
 }
@@ -78,7 +78,7 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 		);
 	}
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, state);
+	return estimateMax(_items, 0, state);
 }
 
 GasEstimator::GasConsumption GasEstimator::functionalEstimation(
@@ -100,7 +100,24 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	if (parametersSize > 0)
 		state->feedItem(swapInstruction(parametersSize));
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state);
+	return estimateMax(_items, _offset, state);
+}
+
+GasEstimator::GasConsumption GasEstimator::estimateMax(
+	AssemblyItems const& _items,
+	size_t _startIndex,
+	shared_ptr<KnownState> const& _state
+) const
+{
+	PathGasMeter pathGasMeter(_items, m_evmVersion, m_maxPathSteps);
+	GasConsumption gas = pathGasMeter.estimateMax(_startIndex, _state);
+	if (!pathGasMeter.stepLimitReached())
+		return gas;
+
+	unique_ptr<BlockGasMeter>& blockGasMeter = m_blockGasMeters[&_items];
+	if (!blockGasMeter)
+		blockGasMeter = make_unique<BlockGasMeter>(_items, m_evmVersion);
+	return blockGasMeter->estimateMax(_startIndex);
 }
 
 set<ASTNode const*> GasEstimator::finestNodesAtLocation(
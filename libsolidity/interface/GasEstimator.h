@@ -26,10 +26,12 @@
 #include <liblangutil/EVMVersion.h>
 
 #include <libevmasm/Assembly.h>
+#include <libevmasm/BlockGasMeter.h>
 #include <libevmasm/GasMeter.h>
 
 #include <array>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::frontend
@@ -46,10 +48,19 @@ public:
 	using ASTGasConsumptionSelfAccumulated =
 		std::map<ASTNode const*, std::array<GasConsumption, 2>>;
 
-	explicit GasEstimator(langutil::EVMVersion _evmVersion): m_evmVersion(_evmVersion) {}
+	/// Number of assembly items up to which the paths through the code are evaluated with
+	/// full knowledge about the state, after which the estimate is derived from the basic blocks.
+	static size_t constexpr defaultMaxPathSteps = 1000000;
+
+	explicit GasEstimator(langutil::EVMVersion _evmVersion, size_t _maxPathSteps = defaultMaxPathSteps):
+		m_evmVersion(_evmVersion),
+		m_maxPathSteps(_maxPathSteps)
+	{}
 
 	/// @returns the estimated gas consumption by the (public or external) function with the
 	/// given signature. If no signature is given, estimates the maximum gas usage.
+	/// If the estimate is derived from the basic blocks, the signature is not taken into
+	/// account and the maximum over all functions is returned.
 	GasConsumption functionalEstimation(
 		evmasm::AssemblyItems const& _items,
 		std::string const& _signature = ""
@@ -65,9 +76,21 @@ public:
 	) const;
 
 private:
+	/// @returns the estimate of PathGasMeter, or the one of BlockGasMeter if the former
+	/// exceeds the step limit.
+	GasConsumption estimateMax(
+		evmasm::AssemblyItems const& _items,
+		size_t _startIndex,
+		std::shared_ptr<evmasm::KnownState> const& _state
+	) const;
+
 	/// @returns the set of AST nodes which are the finest nodes at their location.
 	static std::set<ASTNode const*> finestNodesAtLocation(std::vector<ASTNode const*> const& _roots);
 	langutil::EVMVersion m_evmVersion;
+	size_t m_maxPathSteps;
+	/// Block-based gas meters, which are only created if needed and reused for all
+	/// estimates on the same items.
+	mutable std::map<evmasm::AssemblyItems const*, std::unique_ptr<evmasm::BlockGasMeter>> m_blockGasMeters;
 };
 
 }
@@ -19,11 +19,11 @@
 #include <libsolutil/CommonIO.h>
 #include <liblangutil/Exceptions.h>
 
-using std::equal;
 using std::find;
 using std::move;
 using std::nullopt;
 using std::optional;
+using std::pair;
 using std::string;
 using std::string_view;
 using std::vector;
@@ -36,47 +36,76 @@ void ImportRemapper::setRemappings(vector<Remapping> _remappings)
 	for (auto const& remapping: _remappings)
 		solAssert(!remapping.prefix.empty(), "");
 	m_remappings = move(_remappings);
+
+	m_contexts = {};
+	m_prefixes.clear();
+	m_targets.clear();
+	m_resolvedPaths.clear();
+	for (auto const& remapping: m_remappings)
+	{
+		optional<size_t>& prefixes = m_contexts[util::sanitizePath(remapping.context)];
+		if (!prefixes)
+		{
+			prefixes = m_prefixes.size();
+			m_prefixes.emplace_back();
+		}
+		// A later remapping with the same context and prefix takes precedence.
+		m_prefixes[*prefixes][util::sanitizePath(remapping.prefix)] = m_targets.size();
+		m_targets.emplace_back(util::sanitizePath(remapping.target));
+	}
 }
 
 SourceUnitName ImportRemapper::apply(ImportPath const& _path, string const& _context) const
 {
-	// Try to find the longest prefix match in all remappings that are active in the current context.
-	auto isPrefixOf = [](string const& _a, string const& _b)
+	auto [resolved, inserted] = m_resolvedPaths.try_emplace({_context, _path});
+	if (!inserted)
+		return resolved->second;
+
+	resolved->second = _path;
+	// Try to find the longest prefix match in all remappings that are active in the closest context.
+	vector<pair<size_t, size_t>> contexts = m_contexts.prefixesOf(_context);
+	for (auto context = contexts.rbegin(); context != contexts.rend(); ++context)
 	{
-		if (_a.length() > _b.length())
-			return false;
-		return equal(_a.begin(), _a.end(), _b.begin());
-	};
-
-	size_t longestPrefix = 0;
-	size_t longestContext = 0;
-	string bestMatchTarget;
+		vector<pair<size_t, size_t>> prefixes = m_prefixes[context->second].prefixesOf(_path);
+		if (prefixes.empty())
+			continue;
+		auto const& [prefixLength, target] = prefixes.back();
+		resolved->second = m_targets[target];
+		resolved->second.append(_path.begin() + static_cast<string::difference_type>(prefixLength), _path.end());
+		break;
+	}
+	return resolved->second;
+}
 
-	for (auto const& redir: m_remappings)
+optional<size_t>& ImportRemapper::Trie::operator[](string const& _key)
+{
+	size_t node = 0;
+	for (char c: _key)
 	{
-		string context = util::sanitizePath(redir.context);
-		string prefix = util::sanitizePath(redir.prefix);
-
-		// Skip if current context is closer
-		if (context.length() < longestContext)
-			continue;
-		// Skip if redir.context is not a prefix of _context
-		if (!isPrefixOf(context, _context))
-			continue;
-		// Skip if we already have a closer prefix match.
-		if (prefix.length() < longestPrefix && context.length() == longestContext)
-			continue;
-		// Skip if the prefix does not match.
-		if (!isPrefixOf(prefix, _path))
-			continue;
+		auto [child, inserted] = nodes[node].children.try_emplace(c, nodes.size());
+		node = child->second;
+		if (inserted)
+			nodes.emplace_back();
+	}
+	return nodes[node].value;
+}
 
-		longestContext = context.length();
-		longestPrefix = prefix.length();
-		bestMatchTarget = util::sanitizePath(redir.target);
+vector<pair<size_t, size_t>> ImportRemapper::Trie::prefixesOf(string const& _string) const
+{
+	vector<pair<size_t, size_t>> prefixes;
+	size_t node = 0;
+	for (size_t length = 0;; ++length)
+	{
+		if (nodes[node].value)
+			prefixes.emplace_back(length, *nodes[node].value);
+		if (length == _string.size())
+			break;
+		auto child = nodes[node].children.find(_string[length]);
+		if (child == nodes[node].children.end())
+			break;
+		node = child->second;
 	}
-	string path = bestMatchTarget;
-	path.append(_path.begin() + static_cast<string::difference_type>(longestPrefix), _path.end());
-	return path;
+	return prefixes;
 }
 
 bool ImportRemapper::isRemapping(string_view _input)
@@ -17,8 +17,10 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <map>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace solidity::frontend
@@ -49,11 +51,15 @@ public:
 		std::string target;
 	};
 
-	void clear() { m_remappings.clear(); }
+	void clear() { setRemappings({}); }
 
 	void setRemappings(std::vector<Remapping> _remappings);
 	std::vector<Remapping> const& remappings() const noexcept { return m_remappings; }
 
+	/// Applies the remapping with the longest context that is a prefix of @a _context and,
+	/// among those, with the longest prefix of @a _path, where later remappings take precedence.
+	/// The results are cached until the remappings change, so the function must not be called
+	/// concurrently.
 	SourceUnitName apply(ImportPath const& _path, std::string const& _context) const;
 
 	/// @returns true if the string can be parsed as a remapping
@@ -63,9 +69,36 @@ public:
 	static std::optional<Remapping> parseRemapping(std::string_view _input);
 
 private:
+	/// Trie over strings whose nodes can hold an index.
+	struct Trie
+	{
+		struct Node
+		{
+			std::map<char, size_t> children;
+			std::optional<size_t> value;
+		};
+
+		/// @returns the value of the node of @a _key, which is created if necessary.
+		std::optional<size_t>& operator[](std::string const& _key);
+		/// @returns the lengths and values of the keys that are prefixes of @a _string,
+		/// ordered by length.
+		std::vector<std::pair<size_t, size_t>> prefixesOf(std::string const& _string) const;
+
+		std::vector<Node> nodes{1};
+	};
+
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
 	std::vector<Remapping> m_remappings = {};
+	/// Trie over the sanitized contexts of the remappings, whose values are indices into m_prefixes.
+	Trie m_contexts;
+	/// Tries over the sanitized prefixes of the remappings with a common context, whose values are
+	/// indices into m_targets.
+	std::vector<Trie> m_prefixes;
+	/// Sanitized targets of the remappings.
+	std::vector<std::string> m_targets;
+	/// Results of apply by context and import path.
+	mutable std::map<std::pair<std::string, ImportPath>, SourceUnitName> m_resolvedPaths;
 };
 
 }
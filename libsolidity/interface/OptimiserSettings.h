@@ -27,6 +27,7 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -110,6 +111,7 @@ struct OptimiserSettings
 		return
 			runOrderLiterals == _other.runOrderLiterals &&
 			runInliner == _other.runInliner &&
+			inlinerCallSiteCostModel == _other.inlinerCallSiteCostModel &&
 			runJumpdestRemover == _other.runJumpdestRemover &&
 			runPeephole == _other.runPeephole &&
 			runDeduplicate == _other.runDeduplicate &&
@@ -118,7 +120,12 @@ struct OptimiserSettings
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			yulOptimiserCandidateSteps == _other.yulOptimiserCandidateSteps &&
+			yulOptimiserCandidateTimeBudget == _other.yulOptimiserCandidateTimeBudget &&
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			evmasmMaxIterations == _other.evmasmMaxIterations &&
+			evmasmTimeBudget == _other.evmasmTimeBudget &&
+			selectorJumpTableThreshold == _other.selectorJumpTableThreshold;
 	}
 
 	/// Move literals to the right of commutative binary operators during code generation.
@@ -126,6 +133,9 @@ struct OptimiserSettings
 	bool runOrderLiterals = false;
 	/// Inliner
 	bool runInliner = false;
+	/// Let the inliner estimate the number of calls from the loops around the call sites, add the
+	/// stack shuffling at the return sites to the cost of a call and limit the growth of the code.
+	bool inlinerCallSiteCostModel = false;
 	/// Non-referenced jump destination remover.
 	bool runJumpdestRemover = false;
 	/// Peephole optimizer
@@ -146,9 +156,25 @@ struct OptimiserSettings
 	/// them just by setting this to an empty string. Set @a runYulOptimiser to false if you want
 	/// no optimisations.
 	std::string yulOptimiserSteps = DefaultYulOptimiserSteps;
+	/// Further sequences of optimisation steps to be tried by the Yul optimiser. If there are any,
+	/// each object is optimised with @a yulOptimiserSteps and with each of them concurrently and
+	/// the result with the lowest estimated costs is kept.
+	std::vector<std::string> yulOptimiserCandidateSteps;
+	/// Time in milliseconds after which the optimisation of an object with a sequence of
+	/// @a yulOptimiserCandidateSteps is abandoned, unlimited if zero.
+	size_t yulOptimiserCandidateTimeBudget = 0;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Maximum number of iterations of the evmasm optimisation loop per assembly, unlimited if zero.
+	size_t evmasmMaxIterations = 0;
+	/// Time in milliseconds after which the evmasm optimiser does not start a new iteration
+	/// for an assembly, unlimited if zero.
+	size_t evmasmTimeBudget = 0;
+	/// Minimum number of external functions from which the legacy code generator dispatches
+	/// calls through a jump table indexed by a hash of the function selector instead of through
+	/// a sequence of comparisons. Never uses a jump table if zero.
+	size_t selectorJumpTableThreshold = 0;
 };
 
 }
@@ -27,6 +27,7 @@
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libyul/AssemblyStack.h>
 #include <libyul/Exceptions.h>
+#include <libyul/ObjectSerialiser.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <libevmasm/Instruction.h>
@@ -43,6 +44,7 @@
 
 #include <algorithm>
 #include <optional>
+#include <sstream>
 
 using namespace std;
 using namespace solidity;
@@ -180,7 +182,7 @@ bool hashMatchesContent(string const& _hash, string const& _content)
 
 bool isArtifactRequested(Json::Value const& _outputSelection, string const& _artifact, bool _wildcardMatchesExperimental)
 {
-	static set<string> experimental{"ir", "irOptimized", "wast", "ewasm", "ewasm.wast"};
+	static set<string> experimental{"ir", "irOptimized", "irOptimizedBinary", "wast", "ewasm", "ewasm.wast"};
 	for (auto const& selectedArtifactJson: _outputSelection)
 	{
 		string const& selectedArtifact = selectedArtifactJson.asString();
@@ -245,6 +247,21 @@ bool isArtifactRequested(Json::Value const& _outputSelection, string const& _fil
 	return false;
 }
 
+/// @returns true if the timings of the compilation were requested. Since they differ between runs,
+/// they have to be requested explicitly as the source-level artifact "timing" and are not matched by "*".
+bool isTimingRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		if (fileRequests.isObject() && fileRequests[""].isArray())
+			for (auto const& artifact: fileRequests[""])
+				if (artifact.isString() && artifact.asString() == "timing")
+					return true;
+	return false;
+}
+
 /// @returns all artifact names of the EVM object, either for creation or deploy time.
 vector<string> evmObjectComponents(string const& _objectKind)
 {
@@ -255,45 +272,72 @@ vector<string> evmObjectComponents(string const& _objectKind)
 	return util::applyMap(components, [&](auto const& _s) { return "evm." + _objectKind + _s; });
 }
 
-/// @returns true if any binary was requested, i.e. we actually have to perform compilation.
-bool isBinaryRequested(Json::Value const& _outputSelection)
+/// @returns true if any of @a _artifacts is requested for any contract. Source-level requests,
+/// i.e. the ones for the empty contract name, are ignored, since they never select contract outputs.
+bool isContractArtifactRequested(Json::Value const& _outputSelection, vector<string> const& _artifacts)
 {
 	if (!_outputSelection.isObject())
 		return false;
 
-	// This does not include "evm.methodIdentifiers" on purpose!
-	static vector<string> const outputsThatRequireBinaries = vector<string>{
-		"*",
-		"ir", "irOptimized",
-		"wast", "wasm", "ewasm.wast", "ewasm.wasm",
-		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
-	} + evmObjectComponents("bytecode") + evmObjectComponents("deployedBytecode");
-
 	for (auto const& fileRequests: _outputSelection)
-		for (auto const& requests: fileRequests)
-			for (auto const& output: outputsThatRequireBinaries)
-				if (isArtifactRequested(requests, output, false))
-					return true;
+		if (fileRequests.isObject())
+			for (string const& contract: fileRequests.getMemberNames())
+				if (!contract.empty())
+					for (auto const& artifact: _artifacts)
+						if (isArtifactRequested(fileRequests[contract], artifact, false))
+							return true;
 	return false;
 }
 
+/// @returns the state the compiler stack has to reach to produce the outputs selected by
+/// @a _outputSelection. Source-level outputs like the AST only need the analysis.
+CompilerStack::State requiredCompilerStackState(Json::Value const& _outputSelection)
+{
+	using State = CompilerStack::State;
+	static map<string, State> const requiredStates = [] {
+		map<string, State> states{
+			{"abi", State::AnalysisPerformed},
+			{"metadata", State::AnalysisPerformed},
+			{"userdoc", State::AnalysisPerformed},
+			{"devdoc", State::AnalysisPerformed},
+			{"storageLayout", State::AnalysisPerformed},
+			{"evm.methodIdentifiers", State::AnalysisPerformed},
+		};
+		for (string const& output: vector<string>{"ir", "irOptimized"})
+			states.emplace(output, State::IRGenerated);
+		for (string const& output: vector<string>{
+			"wast", "wasm", "ewasm.wast", "ewasm.wasm",
+			"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
+		} + evmObjectComponents("bytecode") + evmObjectComponents("deployedBytecode"))
+			states.emplace(output, State::CompilationSuccessful);
+		return states;
+	}();
+
+	State state = State::AnalysisPerformed;
+	for (auto const& [output, outputState]: requiredStates)
+		if (outputState > state && isContractArtifactRequested(_outputSelection, {output}))
+			state = outputState;
+	return state;
+}
+
 /// @returns true if EVM bytecode was requested, i.e. we have to run the old code generator.
 bool isEvmBytecodeRequested(Json::Value const& _outputSelection)
 {
-	if (!_outputSelection.isObject())
-		return false;
-
-	static vector<string> const outputsThatRequireEvmBinaries = vector<string>{
-		"*",
-		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
-	} + evmObjectComponents("bytecode") + evmObjectComponents("deployedBytecode");
+	return isContractArtifactRequested(
+		_outputSelection,
+		vector<string>{"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"} +
+		evmObjectComponents("bytecode") +
+		evmObjectComponents("deployedBytecode")
+	);
+}
 
-	for (auto const& fileRequests: _outputSelection)
-		for (auto const& requests: fileRequests)
-			for (auto const& output: outputsThatRequireEvmBinaries)
-				if (isArtifactRequested(requests, output, false))
-					return true;
-	return false;
+/// @returns true if any output that depends on the creation code was requested.
+bool isCreationCodeRequested(Json::Value const& _outputSelection)
+{
+	return isContractArtifactRequested(
+		_outputSelection,
+		vector<string>{"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"} + evmObjectComponents("bytecode")
+	);
 }
 
 /// @returns true if any Ewasm code was requested. Note that as an exception, '*' does not
@@ -331,6 +375,40 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns the intermediates of the code generation that the outputs of the contract
+/// @a _contractName selected by @a _outputSelection are generated from.
+CompilerStack::Intermediates requiredIntermediates(
+	Json::Value const& _outputSelection,
+	string const& _contractName,
+	bool _viaIR
+)
+{
+	size_t colon = _contractName.rfind(':');
+	solAssert(colon != string::npos, "");
+	string file = _contractName.substr(0, colon);
+	string name = _contractName.substr(colon + 1);
+	auto requested = [&](vector<string> const& _artifacts) {
+		return isArtifactRequested(_outputSelection, file, name, _artifacts, false);
+	};
+
+	bool const gasEstimates = requested({"evm.gasEstimates"});
+	CompilerStack::Intermediates intermediates;
+	intermediates.evmAssembly =
+		isTimingRequested(_outputSelection) ||
+		requested({
+			"evm.assembly",
+			"evm.legacyAssembly",
+			"evm.gasEstimates",
+			"evm.bytecode.generatedSources",
+			"evm.deployedBytecode.generatedSources"
+		});
+	intermediates.ir = requested({"ir"});
+	// The gas estimates of the IR code generator are computed from the optimized IR.
+	intermediates.irOptimized = requested({"irOptimized"}) || (_viaIR && gasEstimates);
+	intermediates.ewasm = requested({"ewasm.wast"});
+	return intermediates;
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret{Json::objectValue};
@@ -439,13 +517,19 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"configurations", "parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
+std::optional<Json::Value> checkConfigurationKeys(Json::Value const& _input, string const& _name)
+{
+	static set<string> keys{"optimizer", "viaIR"};
+	return checkKeys(_input, keys, "settings.configurations." + _name);
+}
+
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"contracts", "divModNoSlacks", "engine", "invariants", "showUnproved", "solvers", "targets", "timeout"};
+	static set<string> keys{"bmcLoopIterations", "contracts", "divModNoSlacks", "engine", "invariants", "showUnproved", "solvers", "targets", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -648,6 +732,46 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 
 	ret.errors = Json::arrayValue;
 
+	// The first URLs of all sources are read at once, the others only if they are needed.
+	map<string, ReadCallback::Result> prefetchedURLs;
+	if (m_readFiles)
+	{
+		vector<string> urls;
+		for (auto const& sourceName: sources.getMemberNames())
+		{
+			Json::Value const& source = sources[sourceName];
+			if (
+				source.isObject() &&
+				!source["content"].isString() &&
+				source["urls"].isArray() &&
+				!source["urls"].empty() &&
+				source["urls"][0].isString() &&
+				!prefetchedURLs.count(source["urls"][0].asString())
+			)
+			{
+				urls.push_back(source["urls"][0].asString());
+				prefetchedURLs[urls.back()];
+			}
+		}
+		if (!urls.empty())
+		{
+			vector<ReadCallback::Result> results = m_readFiles(ReadCallback::kindString(ReadCallback::Kind::ReadFile), urls);
+			solAssert(results.size() == urls.size(), "Batch read callback returned the wrong number of results.");
+			for (size_t i = 0; i < urls.size(); ++i)
+				prefetchedURLs[urls[i]] = move(results[i]);
+		}
+	}
+	auto readURL = [&](string const& _url) -> ReadCallback::Result {
+		if (auto prefetched = prefetchedURLs.find(_url); prefetched != prefetchedURLs.end())
+			return prefetched->second;
+		string const kind = ReadCallback::kindString(ReadCallback::Kind::ReadFile);
+		if (m_readFile)
+			return m_readFile(kind, _url);
+		vector<ReadCallback::Result> results = m_readFiles(kind, {_url});
+		solAssert(results.size() == 1, "Batch read callback returned the wrong number of results.");
+		return move(results.front());
+	};
+
 	for (auto const& sourceName: sources.getMemberNames())
 	{
 		string hash;
@@ -660,7 +784,11 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 
 		if (sources[sourceName]["content"].isString())
 		{
-			string content = sources[sourceName]["content"].asString();
+			string content;
+			if (auto extracted = m_extractedSourceContents.find(sourceName); extracted != m_extractedSourceContents.end())
+				content = move(extracted->second);
+			else
+				content = sources[sourceName]["content"].asString();
 			if (!hash.empty() && !hashMatchesContent(hash, content))
 				ret.errors.append(formatError(
 					Error::Severity::Error,
@@ -669,11 +797,15 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				ret.sources[sourceName] = content;
+			{
+				if (!hash.empty())
+					cacheSourceContent(util::h256(hash), content);
+				ret.sources[sourceName] = move(content);
+			}
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
-			if (!m_readFile)
+			if (!m_readFile && !m_readFiles)
 				return formatFatalError("JSONError", "No import callback supplied, but URL is requested.");
 
 			bool found = false;
@@ -683,7 +815,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 			{
 				if (!url.isString())
 					return formatFatalError("JSONError", "URL must be a string.");
-				ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), url.asString());
+				ReadCallback::Result result = readURL(url.asString());
 				if (result.success)
 				{
 					if (!hash.empty() && !hashMatchesContent(hash, result.responseOrErrorMessage))
@@ -695,6 +827,8 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 						));
 					else
 					{
+						if (!hash.empty())
+							cacheSourceContent(util::h256(hash), result.responseOrErrorMessage);
 						ret.sources[sourceName] = result.responseOrErrorMessage;
 						found = true;
 						break;
@@ -715,6 +849,27 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 				));
 			}
 		}
+		else if (m_sourceCacheMemoryLimit > 0 && !hash.empty())
+		{
+			// Sources given only by their hash have to be known from earlier inputs.
+			auto cached = m_cachedSourceContents.end();
+			try
+			{
+				cached = m_cachedSourceContents.find(util::h256(hash));
+			}
+			catch (util::BadHexCharacter const&)
+			{
+			}
+			if (cached != m_cachedSourceContents.end())
+				ret.sources[sourceName] = cached->second;
+			else
+				ret.errors.append(formatError(
+					Error::Severity::Error,
+					"IOError",
+					"general",
+					"No content known for the supplied hash of \"" + sourceName + "\"."
+				));
+		}
 		else
 			return formatFatalError("JSONError", "Invalid input source specified.");
 	}
@@ -765,10 +920,19 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		if (!settings["stopAfter"].isString())
 			return formatFatalError("JSONError", "\"settings.stopAfter\" must be a string.");
 
-		if (settings["stopAfter"].asString() != "parsing")
-			return formatFatalError("JSONError", "Invalid value for \"settings.stopAfter\". Only valid value is \"parsing\".");
+		static map<string, CompilerStack::State> const stages{
+			{"parsing", CompilerStack::State::Parsed},
+			{"analysis", CompilerStack::State::AnalysisPerformed},
+			{"ir", CompilerStack::State::IRGenerated},
+		};
+		auto stage = stages.find(settings["stopAfter"].asString());
+		if (stage == stages.end())
+			return formatFatalError(
+				"JSONError",
+				"Invalid value for \"settings.stopAfter\". Valid values are \"parsing\", \"analysis\" and \"ir\"."
+			);
 
-		ret.stopAfter = CompilerStack::State::Parsed;
+		ret.stopAfter = stage->second;
 	}
 
 	if (settings.isMember("parserErrorRecovery"))
@@ -785,6 +949,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.viaIR = settings["viaIR"].asBool();
 	}
 
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt() || settings["parallelism"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be a positive integer.");
+		ret.parallelism = settings["parallelism"].asUInt();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -863,6 +1034,37 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 			ret.optimiserSettings = std::get<OptimiserSettings>(std::move(optimiserSettings));
 	}
 
+	Json::Value const& configurations = settings["configurations"];
+	if (!!configurations && !configurations.isObject())
+		return formatFatalError("JSONError", "\"settings.configurations\" must be an object.");
+	for (auto const& name: configurations.getMemberNames())
+	{
+		Json::Value const& configuration = configurations[name];
+		if (auto result = checkConfigurationKeys(configuration, name))
+			return *result;
+		// Settings that are not given are the same as in the main settings.
+		auto& [optimiserSettings, viaIR] = ret.configurations[name] = {ret.optimiserSettings, ret.viaIR};
+		if (configuration.isMember("viaIR"))
+		{
+			if (!configuration["viaIR"].isBool())
+				return formatFatalError("JSONError", "\"settings.configurations." + name + ".viaIR\" must be a Boolean.");
+			viaIR = configuration["viaIR"].asBool();
+		}
+		if (configuration.isMember("optimizer"))
+		{
+			auto parsedSettings = parseOptimizerSettings(configuration["optimizer"]);
+			if (std::holds_alternative<Json::Value>(parsedSettings))
+				return std::get<Json::Value>(std::move(parsedSettings)); // was an error
+			optimiserSettings = std::get<OptimiserSettings>(std::move(parsedSettings));
+		}
+		// The analysis is shared with the main settings and rejects some inline assembly only for the Yul optimizer.
+		if (optimiserSettings.runYulOptimiser && !ret.optimiserSettings.runYulOptimiser)
+			return formatFatalError(
+				"JSONError",
+				"\"settings.configurations." + name + "\" cannot enable the Yul optimizer if the main settings do not enable it."
+			);
+	}
+
 	Json::Value jsonLibraries = settings.get("libraries", Json::Value(Json::objectValue));
 	if (!jsonLibraries.isObject())
 		return formatFatalError("JSONError", "\"libraries\" is not a JSON object.");
@@ -927,7 +1129,9 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 
 	ret.outputSelection = std::move(outputSelection);
 
-	if (ret.stopAfter != CompilerStack::State::CompilationSuccessful && isBinaryRequested(ret.outputSelection))
+	// Outputs that only need the analysis are still produced after stopping after the parsing.
+	CompilerStack::State const requiredState = requiredCompilerStackState(ret.outputSelection);
+	if (requiredState > ret.stopAfter && requiredState > CompilerStack::State::AnalysisPerformed)
 		return formatFatalError(
 			"JSONError",
 			"Requested output selection conflicts with \"settings.stopAfter\"."
@@ -938,6 +1142,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 	if (auto result = checkModelCheckerSettingsKeys(modelCheckerSettings))
 		return *result;
 
+	if (modelCheckerSettings.isMember("bmcLoopIterations"))
+	{
+		if (!modelCheckerSettings["bmcLoopIterations"].isUInt())
+			return formatFatalError("JSONError", "settings.modelChecker.bmcLoopIterations must be an unsigned integer.");
+		ret.modelCheckerSettings.bmcLoopIterations = modelCheckerSettings["bmcLoopIterations"].asUInt();
+	}
+
 	if (modelCheckerSettings.isMember("contracts"))
 	{
 		auto const& sources = modelCheckerSettings["contracts"];
@@ -1065,41 +1276,92 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json::Value StandardCompiler::compileSolidity(
+	StandardCompiler::InputsAndSettings _inputsAndSettings,
+	shared_ptr<CompilerStack> _analysedCompilerStack,
+	shared_ptr<StringMap const> _analysedSources
+)
 {
-	CompilerStack compilerStack(m_readFile);
-
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
-	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
-		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
-	compilerStack.setViaIR(_inputsAndSettings.viaIR);
-	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
-	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
-	compilerStack.setRemappings(move(_inputsAndSettings.remappings));
-	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
-	compilerStack.setRevertStringBehaviour(_inputsAndSettings.revertStrings);
-	if (_inputsAndSettings.debugInfoSelection.has_value())
-		compilerStack.selectDebugInfo(_inputsAndSettings.debugInfoSelection.value());
-	compilerStack.setLibraries(_inputsAndSettings.libraries);
-	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
-	compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
-	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
-	compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
-
-	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
-	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
-	compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
+	bool const recompile = !!_analysedCompilerStack;
+	// The outputs of all configurations are generated by the same compiler stack one after
+	// another, so they cannot be generated while printing.
+	bool const deferOutputs = m_deferOutputs;
+	ScopeGuard restoreDeferOutputs([&]() { m_deferOutputs = deferOutputs; });
+	if (!_inputsAndSettings.configurations.empty())
+		m_deferOutputs = false;
+
+	shared_ptr<CompilerStack> ownedCompilerStack = std::move(_analysedCompilerStack);
+	shared_ptr<StringMap const> sourceList = std::move(_analysedSources);
+	if (recompile)
+		ownedCompilerStack->resetCompilation(std::move(_inputsAndSettings.optimiserSettings), _inputsAndSettings.viaIR);
+	else
+	{
+		if (m_sourceCacheMemoryLimit > 0 && m_cachedCompilerStack)
+		{
+			// All settings are set again below, but the ASTs of the last compilation are kept.
+			ownedCompilerStack = m_cachedCompilerStack;
+			ownedCompilerStack->reset(true);
+		}
+		else
+		{
+			ownedCompilerStack = make_shared<CompilerStack>(m_readFile);
+			if (m_sourceCacheMemoryLimit > 0)
+			{
+				ownedCompilerStack->enableASTCache();
+				m_cachedCompilerStack = ownedCompilerStack;
+			}
+		}
+	}
+	CompilerStack& compilerStack = *ownedCompilerStack;
+
+	if (!recompile)
+	{
+		sourceList = make_shared<StringMap const>(std::move(_inputsAndSettings.sources));
+		compilerStack.setSources(*sourceList);
+		for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
+			compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
+		compilerStack.setViaIR(_inputsAndSettings.viaIR);
+		compilerStack.setParallelism(_inputsAndSettings.parallelism);
+		compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
+		compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
+		compilerStack.setRemappings(move(_inputsAndSettings.remappings));
+		compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
+		compilerStack.setRevertStringBehaviour(_inputsAndSettings.revertStrings);
+		compilerStack.selectDebugInfo(_inputsAndSettings.debugInfoSelection.value_or(DebugInfoSelection::Default()));
+		compilerStack.setLibraries(_inputsAndSettings.libraries);
+		compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
+		compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
+		compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
+		compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
+
+		compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
+		compilerStack.enableCreationCodeOptimisation(isCreationCodeRequested(_inputsAndSettings.outputSelection));
+		compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+		compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
+		compilerStack.enableTimingCollection(isTimingRequested(_inputsAndSettings.outputSelection));
+		// While the outputs are streamed, the intermediates of each contract are released as soon as
+		// its outputs are printed, and those no output needs already during the compilation.
+		if (m_deferOutputs)
+			compilerStack.enableIntermediateRelease([
+				outputSelection = _inputsAndSettings.outputSelection,
+				viaIR = _inputsAndSettings.viaIR
+			](string const& _contractName) {
+				return requiredIntermediates(outputSelection, _contractName, viaIR);
+			});
+		else
+			compilerStack.enableIntermediateRelease({});
+	}
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
-	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
+	bool const binariesRequested =
+		requiredCompilerStackState(_inputsAndSettings.outputSelection) >= CompilerStack::State::IRGenerated;
 
 	try
 	{
 		if (binariesRequested)
-			compilerStack.compile();
-		else
+			compilerStack.compile(_inputsAndSettings.stopAfter);
+		else if (!recompile)
 			compilerStack.parseAndAnalyze(_inputsAndSettings.stopAfter);
 
 		for (auto const& error: compilerStack.errors())
@@ -1223,6 +1485,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	}
 
 	bool analysisPerformed = compilerStack.state() >= CompilerStack::State::AnalysisPerformed;
+	bool const irGenerated = compilerStack.state() >= CompilerStack::State::IRGenerated;
 	bool const compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
 
 	if (compilerStack.hasError() && !_inputsAndSettings.parserErrorRecovery)
@@ -1230,7 +1493,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 	/// Inconsistent state - stop here to receive error reports from users
 	if (
-		((binariesRequested && !compilationSuccess) || !analysisPerformed) &&
+		((binariesRequested && !irGenerated) || !analysisPerformed) &&
 		(errors.empty() && _inputsAndSettings.stopAfter >= CompilerStack::State::AnalysisPerformed)
 	)
 		return formatFatalError("InternalCompilerError", "No error reported, but compilation failed.");
@@ -1240,21 +1503,40 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	if (errors.size() > 0)
 		output["errors"] = std::move(errors);
 
-	if (!compilerStack.unhandledSMTLib2Queries().empty())
+	if (!recompile && !compilerStack.unhandledSMTLib2Queries().empty())
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
 			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
 
 	bool const wildcardMatchesExperimental = false;
 
-	output["sources"] = Json::objectValue;
+	if (!recompile)
+		output["sources"] = Json::objectValue;
 	unsigned sourceIndex = 0;
-	if (compilerStack.state() >= CompilerStack::State::Parsed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
+	if (!recompile && compilerStack.state() >= CompilerStack::State::Parsed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
 		for (string const& sourceName: compilerStack.sourceNames())
 		{
 			Json::Value sourceResult = Json::objectValue;
 			sourceResult["id"] = sourceIndex++;
 			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonConverter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			{
+				if (m_deferOutputs)
+				{
+					sourceResult["ast"] = util::jsonPlaceholder(m_deferredOutputs.size());
+					SourceUnit const* ast = &compilerStack.ast(sourceName);
+					m_deferredOutputs.emplace_back([this, ast](ostream& _stream, string const& _indentation) {
+						CompilerStack const& deferredCompilerStack = *m_deferredOutputsCompilerStack;
+						ASTJsonConverter(deferredCompilerStack.state(), deferredCompilerStack.sourceIndices()).print(
+							_stream,
+							*ast,
+							m_jsonPrintingFormat,
+							_indentation
+						);
+					});
+					m_deferredOutputsCompilerStack = ownedCompilerStack;
+				}
+				else
+					sourceResult["ast"] = ASTJsonConverter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			}
 			output["sources"][sourceName] = sourceResult;
 		}
 
@@ -1265,6 +1547,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		solAssert(colon != string::npos, "");
 		string file = contractName.substr(0, colon);
 		string name = contractName.substr(colon + 1);
+		size_t const firstDeferredOutput = m_deferredOutputs.size();
 
 		// ABI, storage layout, documentation and metadata
 		Json::Value contractData(Json::objectValue);
@@ -1280,10 +1563,20 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			contractData["devdoc"] = compilerStack.natspecDev(contractName);
 
 		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
+		auto irOutput = [&](string const& _ir) {
+			if (!m_deferOutputs)
+				return Json::Value(_ir);
+			// The IR is only copied while the output is printed.
+			m_deferredOutputs.emplace_back([ir = &_ir](ostream& _stream, string const&) {
+				util::jsonStreamPrintString(_stream, *ir);
+			});
+			m_deferredOutputsCompilerStack = ownedCompilerStack;
+			return util::jsonStringPlaceholder(m_deferredOutputs.size() - 1);
+		};
+		if (irGenerated && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
+			contractData["ir"] = irOutput(compilerStack.yulIR(contractName));
+		if (irGenerated && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
+			contractData["irOptimized"] = irOutput(compilerStack.yulIROptimized(contractName));
 
 		// Ewasm
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
@@ -1292,57 +1585,85 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
 
 		// EVM
-		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
+		// The assembly, the gas estimates and the bytecode are only generated while the output is
+		// printed, so that they do not have to be kept in memory for all contracts at the same time.
+		auto deferredOutput = [&](function<Json::Value(CompilerStack const&)> _generate) {
+			m_deferredOutputs.emplace_back([this, generate = move(_generate)](ostream& _stream, string const& _indentation) {
+				util::jsonStreamPrint(_stream, generate(*m_deferredOutputsCompilerStack), m_jsonPrintingFormat, {}, _indentation);
+			});
+			m_deferredOutputsCompilerStack = ownedCompilerStack;
+			return util::jsonPlaceholder(m_deferredOutputs.size() - 1);
+		};
+		auto evmObject = [
 			file,
 			name,
-			evmObjectComponents("bytecode"),
+			outputSelection = _inputsAndSettings.outputSelection,
 			wildcardMatchesExperimental
-		))
-			evmData["bytecode"] = collectEVMObject(
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
-				false,
+		](CompilerStack const& _compilerStack, string const& _contractName, bool _runtimeObject) {
+			string const objectKind = _runtimeObject ? "deployedBytecode" : "bytecode";
+			return collectEVMObject(
+				_runtimeObject ? _compilerStack.runtimeObject(_contractName) : _compilerStack.object(_contractName),
+				_runtimeObject ? _compilerStack.runtimeSourceMapping(_contractName) : _compilerStack.sourceMapping(_contractName),
+				_compilerStack.generatedSources(_contractName, _runtimeObject),
+				_runtimeObject,
 				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
+					outputSelection,
 					file,
 					name,
-					"evm.bytecode." + _element,
+					"evm." + objectKind + "." + _element,
 					wildcardMatchesExperimental
 				); }
 			);
+		};
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			evmObjectComponents("deployedBytecode"),
-			wildcardMatchesExperimental
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
-				true,
-				[&](string const& _element) { return isArtifactRequested(
-					_inputsAndSettings.outputSelection,
-					file,
-					name,
-					"evm.deployedBytecode." + _element,
-					wildcardMatchesExperimental
-				); }
-			);
+		Json::Value evmData(Json::objectValue);
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+		{
+			if (m_deferOutputs)
+			{
+				m_deferredOutputs.emplace_back([this, contractName, sourceList](ostream& _stream, string const&) {
+					util::jsonStreamPrintString(_stream, m_deferredOutputsCompilerStack->assemblyString(contractName, *sourceList));
+				});
+				m_deferredOutputsCompilerStack = ownedCompilerStack;
+				evmData["assembly"] = util::jsonStringPlaceholder(m_deferredOutputs.size() - 1);
+			}
+			else
+				evmData["assembly"] = compilerStack.assemblyString(contractName, *sourceList);
+		}
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
+			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
+		{
+			// Placeholders can only stand for non-empty objects, but there are no gas estimates without code.
+			if (m_deferOutputs && (compilerStack.assemblyItems(contractName) || compilerStack.runtimeAssemblyItems(contractName)))
+				evmData["gasEstimates"] = deferredOutput([contractName](CompilerStack const& _compilerStack) {
+					return _compilerStack.gasEstimates(contractName);
+				});
+			else
+				evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+		}
+
+		for (bool runtimeObject: {false, true})
+		{
+			string const objectKind = runtimeObject ? "deployedBytecode" : "bytecode";
+			if (!compilationSuccess || !isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				evmObjectComponents(objectKind),
+				wildcardMatchesExperimental
+			))
+				continue;
+			// At least one of the components is requested, so the object is not empty.
+			if (m_deferOutputs)
+				evmData[objectKind] = deferredOutput([evmObject, contractName, runtimeObject](CompilerStack const& _compilerStack) {
+					return evmObject(_compilerStack, contractName, runtimeObject);
+				});
+			else
+				evmData[objectKind] = evmObject(compilerStack, contractName, runtimeObject);
+		}
 
 		if (!evmData.empty())
 			contractData["evm"] = evmData;
@@ -1353,10 +1674,37 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 				contractsOutput[file] = Json::objectValue;
 			contractsOutput[file][name] = contractData;
 		}
+
+		if (m_deferOutputs && compilationSuccess)
+		{
+			for (size_t index = firstDeferredOutput; index < m_deferredOutputs.size(); ++index)
+				m_deferredOutputContracts[index] = contractName;
+			if (m_deferredOutputs.size() > firstDeferredOutput)
+				m_pendingDeferredOutputs[contractName] = m_deferredOutputs.size() - firstDeferredOutput;
+			// The timings are collected from the assemblies after all contracts.
+			else if (!isTimingRequested(_inputsAndSettings.outputSelection))
+				compilerStack.releaseIntermediates(contractName);
+		}
 	}
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
+	if (!recompile && isTimingRequested(_inputsAndSettings.outputSelection))
+		output["timing"] = compilerStack.timingJSON();
+
+	// The other configurations share the parsed and analysed sources, only the code is generated again.
+	if (analysisPerformed && !compilerStack.hasError())
+		for (auto& [name, configuration]: _inputsAndSettings.configurations)
+		{
+			InputsAndSettings configurationInputs;
+			configurationInputs.outputSelection = _inputsAndSettings.outputSelection;
+			configurationInputs.stopAfter = _inputsAndSettings.stopAfter;
+			configurationInputs.parserErrorRecovery = _inputsAndSettings.parserErrorRecovery;
+			configurationInputs.optimiserSettings = std::move(configuration.first);
+			configurationInputs.viaIR = configuration.second;
+			output["configurations"][name] = compileSolidity(std::move(configurationInputs), ownedCompilerStack, sourceList);
+		}
+
 	return output;
 }
 
@@ -1498,6 +1846,10 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "irOptimized", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["irOptimized"] = stack.print();
+	// The binary format is meant for tools and only produced if it is requested explicitly.
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "irOptimizedBinary", false))
+		output["contracts"][sourceName][contractName]["irOptimizedBinary"] =
+			util::toHex(yul::ObjectSerialiser::serialise(*stack.parserResult()));
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "evm.assembly", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["evm"]["assembly"] = object.assembly;
 
@@ -1507,7 +1859,15 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	if (
+		m_yulStringMemoryLimit == 0 ||
+		YulStringRepository::instance().statistics().bytes > m_yulStringMemoryLimit
+	)
+	{
+		// The ASTs kept by the compiler stack refer to the identifiers.
+		m_cachedCompilerStack.reset();
+		YulStringRepository::reset();
+	}
 
 	try
 	{
@@ -1541,31 +1901,99 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 }
 
 string StandardCompiler::compile(string const& _input) noexcept
+{
+	try
+	{
+		ostringstream stream;
+		if (compile(_input, stream))
+			return stream.str();
+	}
+	catch (...)
+	{
+	}
+	return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+}
+
+bool StandardCompiler::compile(string const& _input, ostream& _output) noexcept
 {
 	Json::Value input;
 	string errors;
+	ScopeGuard resetExtractedSourceContents([&]() { m_extractedSourceContents.clear(); });
 	try
 	{
-		if (!util::jsonParseStrict(_input, input, &errors))
-			return util::jsonPrint(formatFatalError("JSONError", errors), m_jsonPrintingFormat);
+		// The contents of the sources are moved out of the input into the compiler stack later,
+		// so they are not stored in the JSON value.
+		vector<pair<vector<string>, string>> extracted;
+		if (!util::jsonParseStrictExtractingStrings(
+			_input,
+			input,
+			[](vector<string> const& _path) {
+				return _path.size() == 3 && _path[0] == "sources" && _path[2] == "content";
+			},
+			extracted,
+			&errors
+		))
+		{
+			_output << util::jsonPrint(formatFatalError("JSONError", errors), m_jsonPrintingFormat);
+			return true;
+		}
+		for (auto& [path, content]: extracted)
+			m_extractedSourceContents[path[1]] = move(content);
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return true;
 	}
 
+	// The ASTs and the largest contract outputs are only generated while the output is printed.
+	m_deferOutputs = true;
+	ScopeGuard resetDeferredOutputs([&]() {
+		m_deferOutputs = false;
+		m_deferredOutputs.clear();
+		m_deferredOutputContracts.clear();
+		m_pendingDeferredOutputs.clear();
+		m_deferredOutputsCompilerStack.reset();
+	});
+
 	// cout << "Input: " << input.toStyledString() << endl;
 	Json::Value output = compile(input);
 	// cout << "Output: " << output.toStyledString() << endl;
 
 	try
 	{
-		return util::jsonPrint(output, m_jsonPrintingFormat);
+		util::jsonStreamPrint(
+			_output,
+			output,
+			m_jsonPrintingFormat,
+			[&](ostream& _stream, size_t _index, string const& _indentation) {
+				m_deferredOutputs.at(_index)(_stream, _indentation);
+				auto contract = m_deferredOutputContracts.find(_index);
+				if (contract != m_deferredOutputContracts.end() && --m_pendingDeferredOutputs.at(contract->second) == 0)
+					m_deferredOutputsCompilerStack->releaseIntermediates(contract->second);
+			}
+		);
+		return !_output.fail();
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		return false;
+	}
+}
+
+void StandardCompiler::cacheSourceContent(util::h256 const& _hash, string const& _content)
+{
+	if (m_sourceCacheMemoryLimit == 0 || _content.size() > m_sourceCacheMemoryLimit || m_cachedSourceContents.count(_hash))
+		return;
+	while (m_cachedSourceContentsSize + _content.size() > m_sourceCacheMemoryLimit)
+	{
+		m_cachedSourceContentsSize -= m_cachedSourceContents.at(m_cachedSourceContentsOrder.front()).size();
+		m_cachedSourceContents.erase(m_cachedSourceContentsOrder.front());
+		m_cachedSourceContentsOrder.pop_front();
 	}
+	m_cachedSourceContents[_hash] = _content;
+	m_cachedSourceContentsOrder.push_back(_hash);
+	m_cachedSourceContentsSize += _content.size();
 }
 
 Json::Value StandardCompiler::formatFunctionDebugData(
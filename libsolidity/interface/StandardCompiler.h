@@ -28,7 +28,10 @@
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <functional>
+#include <list>
 #include <optional>
+#include <ostream>
 #include <utility>
 #include <variant>
 
@@ -62,6 +65,34 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Performs the same processing steps as above, but writes the serialized JSON output to
+	/// @a _output, generating the large parts of it only while writing them.
+	/// @returns false if an error occurred while writing, in which case the output is incomplete.
+	bool compile(std::string const& _input, std::ostream& _output) noexcept;
+
+	/// Replaces the callback used to read files for import statements by @a _readFile.
+	void setReadFileCallback(ReadCallback::Callback _readFile)
+	{
+		m_readFile = std::move(_readFile);
+		m_cachedCompilerStack.reset();
+	}
+	/// Sets the callback used to read several files at once: the first URLs of all sources given by
+	/// their URLs, and the imports of each round of parsing.
+	void setBatchReadCallback(ReadCallback::BatchCallback _readFiles) { m_readFiles = std::move(_readFiles); }
+
+	/// Keeps the contents of the sources whose keccak256 hash is given in the input across
+	/// compilations, so that later inputs can specify the same sources by their hash alone.
+	/// At most @a _memoryLimit bytes of contents are kept, older ones are dropped beyond that.
+	/// The compiler stack is kept as well and does not parse and analyse sources again that did
+	/// not change, as long as the interned Yul identifiers are kept (see setYulStringMemoryLimit).
+	/// No other compiler stack can be used on the same thread while the cache is enabled.
+	void enableSourceCache(size_t _memoryLimit) { m_sourceCacheMemoryLimit = _memoryLimit; }
+
+	/// Sets the number of bytes the interned Yul identifiers may occupy before they are cleared
+	/// at the start of a compilation. If it is zero (the default), they are cleared every time.
+	/// Otherwise, long-running processes can reuse the identifiers and the builtin dialects
+	/// that refer to them across compilations.
+	void setYulStringMemoryLimit(size_t _bytes) { m_yulStringMemoryLimit = _bytes; }
 
 	static Json::Value formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
@@ -87,18 +118,58 @@ private:
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t parallelism = 1;
+		/// The optimiser settings and the viaIR setting of the configurations the contracts are
+		/// also compiled with, by the names of the configurations.
+		std::map<std::string, std::pair<OptimiserSettings, bool>> configurations;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Compiles the sources and @returns the output, including the outputs of the configurations.
+	/// If @a _analysedCompilerStack is given, it has to have analysed @a _analysedSources already,
+	/// and only the errors and the contracts compiled again with the optimiser settings and the
+	/// viaIR setting of @a _inputsAndSettings are returned.
+	Json::Value compileSolidity(
+		InputsAndSettings _inputsAndSettings,
+		std::shared_ptr<CompilerStack> _analysedCompilerStack = nullptr,
+		std::shared_ptr<StringMap const> _analysedSources = nullptr
+	);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
+	/// Adds @a _content, whose keccak256 hash is @a _hash, to the cached source contents, if enabled.
+	void cacheSourceContent(util::h256 const& _hash, std::string const& _content);
+
 	ReadCallback::Callback m_readFile;
+	ReadCallback::BatchCallback m_readFiles;
 
 	util::JsonFormat m_jsonPrintingFormat;
+
+	/// If true, compileSolidity outputs placeholders instead of the JSON of the ASTs and of the IR.
+	bool m_deferOutputs = false;
+	/// The functions printing the outputs in place of the placeholders, given the indentation of
+	/// the placeholder, and the compiler stack the outputs belong to.
+	std::vector<std::function<void(std::ostream&, std::string const&)>> m_deferredOutputs;
+	std::shared_ptr<CompilerStack> m_deferredOutputsCompilerStack;
+	/// The contract each deferred output belongs to, if any, and the number of deferred outputs
+	/// of each contract that are not printed yet. Its intermediates are released after the last one.
+	std::map<size_t, std::string> m_deferredOutputContracts;
+	std::map<std::string, size_t> m_pendingDeferredOutputs;
+	/// The contents of the sources by source name that were taken out of the input while parsing it.
+	/// The input only contains empty strings in their place.
+	std::map<std::string, std::string> m_extractedSourceContents;
+
+	size_t m_yulStringMemoryLimit = 0;
+
+	size_t m_sourceCacheMemoryLimit = 0;
+	/// The contents of sources by their keccak256 hash, in the order they were added.
+	std::map<util::h256, std::string> m_cachedSourceContents;
+	std::list<util::h256> m_cachedSourceContentsOrder;
+	size_t m_cachedSourceContentsSize = 0;
+	/// The compiler stack that is reused across compilations if the source cache is enabled.
+	std::shared_ptr<CompilerStack> m_cachedCompilerStack;
 };
 
 }
@@ -0,0 +1,400 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/lsp/LanguageServer.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/interface/Version.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/SourceLocation.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <json/json.h>
+
+using namespace std;
+using namespace std::placeholders;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+
+namespace
+{
+
+string const fileUriPrefix = "file://";
+
+string percentDecode(string const& _input)
+{
+	string output;
+	for (size_t i = 0; i < _input.size(); ++i)
+		if (_input[i] == '%' && i + 2 < _input.size() && isxdigit(_input[i + 1]) && isxdigit(_input[i + 2]))
+		{
+			output += static_cast<char>(stoi(_input.substr(i + 1, 2), nullptr, 16));
+			i += 2;
+		}
+		else
+			output += _input[i];
+	return output;
+}
+
+string percentEncode(string const& _input)
+{
+	string output;
+	for (char c: _input)
+		if (isalnum(static_cast<unsigned char>(c)) || string("-._~/").find(c) != string::npos)
+			output += c;
+		else
+			output += "%" + util::toHex(static_cast<uint8_t>(c), util::HexCase::Upper);
+	return output;
+}
+
+int toLspSeverity(Error::Severity _severity)
+{
+	switch (_severity)
+	{
+	case Error::Severity::Error:
+		return 1;
+	case Error::Severity::Warning:
+		return 2;
+	case Error::Severity::Info:
+		return 3;
+	}
+	solAssert(false);
+}
+
+}
+
+LanguageServer::LanguageServer(Transport& _client):
+	m_client(_client),
+	m_handlers{
+		{"initialize", bind(&LanguageServer::handleInitialize, this, _1, _2)},
+		{"initialized", [](MessageID const&, Json::Value const&) {}},
+		{"shutdown", [this](MessageID const& _id, Json::Value const&) {
+			m_shutdownRequested = true;
+			m_client.reply(_id, Json::nullValue);
+		}},
+		{"exit", [this](MessageID const&, Json::Value const&) { m_exitRequested = true; }},
+		{"textDocument/didOpen", [this](MessageID const&, Json::Value const& _params) { handleDidOpen(_params); }},
+		{"textDocument/didChange", [this](MessageID const&, Json::Value const& _params) { handleDidChange(_params); }},
+		{"textDocument/didClose", [this](MessageID const&, Json::Value const& _params) { handleDidClose(_params); }},
+		{"textDocument/definition", bind(&LanguageServer::handleDefinition, this, _1, _2)},
+	},
+	m_compilerStack(bind(&LanguageServer::readFile, this, _1, _2))
+{
+	m_compilerStack.enableASTCache();
+}
+
+bool LanguageServer::run()
+{
+	while (!m_exitRequested && !m_client.closed())
+	{
+		optional<Json::Value> message = m_client.receive();
+		if (!message)
+			continue;
+
+		MessageID const id = (*message)["id"];
+		if (!(*message)["method"].isString())
+		{
+			// Responses are ignored, since the server does not send any requests.
+			if (!message->isMember("result") && !message->isMember("error"))
+				m_client.error(id, ErrorCode::InvalidRequest, "Missing method name.");
+			continue;
+		}
+		string const method = (*message)["method"].asString();
+
+		auto handler = m_handlers.find(method);
+		if (handler == m_handlers.end())
+		{
+			// Unknown notifications are ignored.
+			if (!id.isNull())
+				m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + method + ".");
+		}
+		else if (!m_initialized && method != "initialize" && method != "exit")
+		{
+			if (!id.isNull())
+				m_client.error(id, ErrorCode::ServerNotInitialized, "Server is not initialized.");
+		}
+		else
+			try
+			{
+				handler->second(id, (*message)["params"]);
+			}
+			catch (Json::Exception const&)
+			{
+				if (!id.isNull())
+					m_client.error(id, ErrorCode::InvalidParams, "Invalid parameters for " + method + ".");
+			}
+			catch (util::Exception const& _exception)
+			{
+				if (!id.isNull())
+					m_client.error(id, ErrorCode::InternalError, string("Unhandled exception: ") + _exception.what());
+			}
+	}
+	return m_shutdownRequested;
+}
+
+void LanguageServer::handleInitialize(MessageID const& _id, Json::Value const& _params)
+{
+	if (_params["rootUri"].isString())
+		m_rootPath = sourceUnitNameFromUri(_params["rootUri"].asString());
+	else if (_params["rootPath"].isString())
+		m_rootPath = _params["rootPath"].asString();
+	m_initialized = true;
+
+	Json::Value result;
+	result["serverInfo"]["name"] = "solc";
+	result["serverInfo"]["version"] = string(VersionNumber);
+	result["capabilities"]["textDocumentSync"]["openClose"] = true;
+	// Incremental changes.
+	result["capabilities"]["textDocumentSync"]["change"] = 2;
+	result["capabilities"]["definitionProvider"] = true;
+	m_client.reply(_id, move(result));
+}
+
+void LanguageServer::handleDidOpen(Json::Value const& _params)
+{
+	Json::Value const& document = _params["textDocument"];
+	m_openFiles[sourceUnitNameFromUri(document["uri"].asString())] = document["text"].asString();
+	compileAndUpdateDiagnostics();
+}
+
+void LanguageServer::handleDidChange(Json::Value const& _params)
+{
+	string const sourceUnitName = sourceUnitNameFromUri(_params["textDocument"]["uri"].asString());
+	auto file = m_openFiles.find(sourceUnitName);
+	if (file == m_openFiles.end())
+		return;
+
+	string& text = file->second;
+	for (Json::Value const& change: _params["contentChanges"])
+	{
+		if (!change.isMember("range"))
+		{
+			text = change["text"].asString();
+			continue;
+		}
+		auto position = [&](Json::Value const& _position) {
+			return CharStream::translateLineColumnToPosition(
+				text,
+				LineColumn{_position["line"].asInt(), _position["character"].asInt()}
+			);
+		};
+		optional<int> const start = position(change["range"]["start"]);
+		optional<int> const end = position(change["range"]["end"]);
+		// Changes outside of the document are ignored, since notifications cannot fail.
+		if (start && end && *start <= *end)
+			text.replace(static_cast<size_t>(*start), static_cast<size_t>(*end - *start), change["text"].asString());
+	}
+	compileAndUpdateDiagnostics();
+}
+
+void LanguageServer::handleDidClose(Json::Value const& _params)
+{
+	m_openFiles.erase(sourceUnitNameFromUri(_params["textDocument"]["uri"].asString()));
+	compileAndUpdateDiagnostics();
+}
+
+void LanguageServer::handleDefinition(MessageID const& _id, Json::Value const& _params)
+{
+	string const sourceUnitName = sourceUnitNameFromUri(_params["textDocument"]["uri"].asString());
+	optional<int> const position = offset(sourceUnitName, _params["position"]);
+	if (!position)
+	{
+		m_client.reply(_id, Json::nullValue);
+		return;
+	}
+
+	// The innermost node at the position, which is the last one visited that contains it.
+	ASTNode const* node = nullptr;
+	SimpleASTVisitor locator(
+		[&](ASTNode const& _node) {
+			if (_node.location().start > *position || *position > _node.location().end)
+				return false;
+			node = &_node;
+			return true;
+		},
+		[](ASTNode const&) {}
+	);
+	m_compilerStack.ast(sourceUnitName).accept(locator);
+
+	Json::Value locations(Json::arrayValue);
+	Declaration const* declaration = nullptr;
+	if (auto const* identifier = dynamic_cast<Identifier const*>(node))
+		declaration = identifier->annotation().referencedDeclaration;
+	else if (auto const* memberAccess = dynamic_cast<MemberAccess const*>(node))
+		declaration = memberAccess->annotation().referencedDeclaration;
+	else if (auto const* identifierPath = dynamic_cast<IdentifierPath const*>(node))
+		declaration = identifierPath->annotation().referencedDeclaration;
+	else if (auto const* import = dynamic_cast<ImportDirective const*>(node))
+		if (SourceUnit const* sourceUnit = import->annotation().sourceUnit)
+		{
+			SourceLocation start = sourceUnit->location();
+			start.end = start.start;
+			locations.append(toLocation(start));
+		}
+
+	if (declaration)
+	{
+		SourceLocation const& location =
+			declaration->nameLocation().hasText() ? declaration->nameLocation() : declaration->location();
+		// Builtins do not have a location.
+		if (location.hasText())
+			locations.append(toLocation(location));
+	}
+	m_client.reply(_id, move(locations));
+}
+
+void LanguageServer::compileAndUpdateDiagnostics()
+{
+	m_compilerStack.reset(true);
+	m_compilerStack.setSources(StringMap(m_openFiles.begin(), m_openFiles.end()));
+	m_compilerStack.parseAndAnalyze(CompilerStack::State::AnalysisPerformed);
+
+	map<string, Json::Value> diagnostics;
+	for (string const& sourceUnitName: m_filesWithDiagnostics)
+		diagnostics[sourceUnitName] = Json::arrayValue;
+	for (auto const& file: m_openFiles)
+		diagnostics[file.first] = Json::arrayValue;
+	for (shared_ptr<Error const> const& error: m_compilerStack.errors())
+	{
+		SourceLocation const* location = error->sourceLocation();
+		if (!location || !location->hasText())
+			continue;
+
+		Json::Value diagnostic;
+		diagnostic["range"] = toRange(*location);
+		diagnostic["severity"] = toLspSeverity(Error::errorSeverity(error->type()));
+		diagnostic["code"] = Json::UInt64{error->errorId().error};
+		diagnostic["source"] = "solc";
+		diagnostic["message"] = error->comment() ? *error->comment() : error->typeName();
+		if (SecondarySourceLocation const* secondaryLocation = error->secondarySourceLocation())
+			for (auto const& [message, secondary]: secondaryLocation->infos)
+				if (secondary.hasText())
+				{
+					Json::Value information;
+					information["message"] = message;
+					information["location"] = toLocation(secondary);
+					diagnostic["relatedInformation"].append(move(information));
+				}
+		diagnostics[*location->sourceName].append(move(diagnostic));
+	}
+
+	m_filesWithDiagnostics.clear();
+	for (auto&& [sourceUnitName, sourceDiagnostics]: diagnostics)
+	{
+		if (!sourceDiagnostics.empty())
+			m_filesWithDiagnostics.insert(sourceUnitName);
+		Json::Value params;
+		params["uri"] = uriFromSourceUnitName(sourceUnitName);
+		params["diagnostics"] = move(sourceDiagnostics);
+		m_client.notify("textDocument/publishDiagnostics", move(params));
+	}
+}
+
+ReadCallback::Result LanguageServer::readFile(string const& _kind, string const& _sourceUnitName) const
+{
+	if (_kind != ReadCallback::kindString(ReadCallback::Kind::ReadFile))
+		return {false, "Unsupported query kind \"" + _kind + "\"."};
+
+	if (auto file = m_openFiles.find(_sourceUnitName); file != m_openFiles.end())
+		return {true, file->second};
+
+	boost::filesystem::path const path = pathFromSourceUnitName(_sourceUnitName);
+	try
+	{
+		if (!boost::filesystem::is_regular_file(path))
+			return {false, "File not found: " + path.generic_string()};
+		return {true, util::readFileAsString(path)};
+	}
+	catch (boost::filesystem::filesystem_error const& _exception)
+	{
+		return {false, "Error reading " + path.generic_string() + ": " + _exception.what()};
+	}
+	catch (util::Exception const&)
+	{
+		return {false, "Error reading " + path.generic_string() + "."};
+	}
+}
+
+string LanguageServer::sourceUnitNameFromUri(string const& _uri) const
+{
+	string path = percentDecode(boost::starts_with(_uri, fileUriPrefix) ? _uri.substr(fileUriPrefix.size()) : _uri);
+	string const root = m_rootPath.generic_string();
+	if (!root.empty() && boost::starts_with(path, root + "/"))
+		return path.substr(root.size() + 1);
+	return path;
+}
+
+string LanguageServer::uriFromSourceUnitName(string const& _sourceUnitName) const
+{
+	return fileUriPrefix + percentEncode(pathFromSourceUnitName(_sourceUnitName).generic_string());
+}
+
+boost::filesystem::path LanguageServer::pathFromSourceUnitName(string const& _sourceUnitName) const
+{
+	boost::filesystem::path path(_sourceUnitName);
+	if (path.is_absolute() || m_rootPath.empty())
+		return path;
+	return m_rootPath / path;
+}
+
+optional<int> LanguageServer::offset(string const& _sourceUnitName, Json::Value const& _position) const
+{
+	// The sources are only analysed if all of them could be parsed.
+	if (m_compilerStack.state() < CompilerStack::State::AnalysisPerformed)
+		return nullopt;
+	vector<string> const sourceNames = m_compilerStack.sourceNames();
+	if (find(sourceNames.begin(), sourceNames.end(), _sourceUnitName) == sourceNames.end())
+		return nullopt;
+	return m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(
+		LineColumn{_position["line"].asInt(), _position["character"].asInt()}
+	);
+}
+
+Json::Value LanguageServer::toLocation(SourceLocation const& _location) const
+{
+	solAssert(_location.sourceName, "");
+	Json::Value location;
+	location["uri"] = uriFromSourceUnitName(*_location.sourceName);
+	location["range"] = toRange(_location);
+	return location;
+}
+
+Json::Value LanguageServer::toRange(SourceLocation const& _location) const
+{
+	solAssert(_location.sourceName, "");
+	CharStream const& charStream = m_compilerStack.charStream(*_location.sourceName);
+	auto toPosition = [&](int _offset) {
+		LineColumn const lineColumn = charStream.translatePositionToLineColumn(_offset);
+		Json::Value position;
+		position["line"] = lineColumn.line;
+		position["character"] = lineColumn.column;
+		return position;
+	};
+	Json::Value range;
+	range["start"] = toPosition(_location.start);
+	range["end"] = toPosition(_location.end);
+	return range;
+}
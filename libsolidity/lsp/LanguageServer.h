@@ -0,0 +1,101 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Language server that reports diagnostics and resolves definitions for the documents opened
+ * in an editor.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/ReadFile.h>
+#include <libsolidity/lsp/Transport.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+
+namespace solidity::lsp
+{
+
+/**
+ * Implements the part of the language server protocol that is needed for diagnostics and
+ * go-to-definition.
+ *
+ * The documents opened by the client are analysed together with the files they import, which
+ * are read from the file system. A single CompilerStack with the AST cache enabled is kept
+ * across edits, so that after an edit only the changed sources and the sources whose node IDs
+ * are shifted by the change are parsed again, and only those and the sources importing them are
+ * analysed again. Definitions are resolved using the annotations of the last analysis.
+ *
+ * Source unit names are the paths of the files relative to the root of the workspace.
+ * Positions are counted in bytes rather than in UTF-16 code units.
+ */
+class LanguageServer
+{
+public:
+	explicit LanguageServer(Transport& _client);
+
+	/// Processes messages until the client sends "exit" or the transport is closed.
+	/// @returns true if the client requested the shutdown before the server exited.
+	bool run();
+
+private:
+	/// Handler of a request or notification, where notifications have a null ID.
+	using Handler = std::function<void(MessageID const&, Json::Value const&)>;
+
+	void handleInitialize(MessageID const& _id, Json::Value const& _params);
+	void handleDidOpen(Json::Value const& _params);
+	void handleDidChange(Json::Value const& _params);
+	void handleDidClose(Json::Value const& _params);
+	void handleDefinition(MessageID const& _id, Json::Value const& _params);
+
+	/// Analyses the open documents and publishes the diagnostics of all sources.
+	void compileAndUpdateDiagnostics();
+	/// @returns the open document with the name @a _sourceUnitName, or otherwise the
+	/// corresponding file.
+	frontend::ReadCallback::Result readFile(std::string const& _kind, std::string const& _sourceUnitName) const;
+
+	std::string sourceUnitNameFromUri(std::string const& _uri) const;
+	std::string uriFromSourceUnitName(std::string const& _sourceUnitName) const;
+	boost::filesystem::path pathFromSourceUnitName(std::string const& _sourceUnitName) const;
+	/// @returns the byte offset of the LSP position @a _position in @a _sourceUnitName, if it
+	/// is a valid position in an analysed source.
+	std::optional<int> offset(std::string const& _sourceUnitName, Json::Value const& _position) const;
+	/// @returns the LSP location of @a _location, which has to be part of an analysed source.
+	Json::Value toLocation(langutil::SourceLocation const& _location) const;
+	Json::Value toRange(langutil::SourceLocation const& _location) const;
+
+	Transport& m_client;
+	std::map<std::string, Handler> m_handlers;
+	/// Contents of the documents opened by the client, keyed by their source unit names.
+	std::map<std::string, std::string> m_openFiles;
+	/// Sources for which diagnostics were published, so that they can be cleared once fixed.
+	std::set<std::string> m_filesWithDiagnostics;
+	boost::filesystem::path m_rootPath;
+	frontend::CompilerStack m_compilerStack;
+	bool m_initialized = false;
+	bool m_shutdownRequested = false;
+	bool m_exitRequested = false;
+};
+
+}
@@ -0,0 +1,110 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/lsp/Transport.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/trim.hpp>
+
+#include <iostream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::lsp;
+
+void Transport::notify(string _method, Json::Value _params)
+{
+	Json::Value message;
+	message["method"] = move(_method);
+	message["params"] = move(_params);
+	send(move(message));
+}
+
+void Transport::reply(MessageID const& _id, Json::Value _result)
+{
+	Json::Value message;
+	message["id"] = _id;
+	message["result"] = move(_result);
+	send(move(message));
+}
+
+void Transport::error(MessageID const& _id, ErrorCode _code, string _message)
+{
+	Json::Value message;
+	message["id"] = _id;
+	message["error"]["code"] = static_cast<int>(_code);
+	message["error"]["message"] = move(_message);
+	send(move(message));
+}
+
+bool IOStreamTransport::closed() const noexcept
+{
+	return m_input.eof() || m_input.fail();
+}
+
+optional<Json::Value> IOStreamTransport::receive()
+{
+	// The header consists of lines terminated by "\r\n" and ends with an empty line.
+	optional<size_t> contentLength;
+	string line;
+	while (getline(m_input, line))
+	{
+		boost::trim_right_if(line, boost::is_any_of("\r"));
+		if (line.empty())
+			break;
+		static string const contentLengthField = "content-length:";
+		if (boost::istarts_with(line, contentLengthField))
+			try
+			{
+				contentLength = stoul(boost::trim_copy(line.substr(contentLengthField.size())));
+			}
+			catch (logic_error const&)
+			{
+			}
+	}
+	if (closed())
+		return nullopt;
+	if (!contentLength)
+	{
+		error({}, ErrorCode::ParseError, "Missing or invalid Content-Length header.");
+		return nullopt;
+	}
+
+	string content(*contentLength, '\0');
+	m_input.read(content.data(), static_cast<streamsize>(*contentLength));
+	if (closed())
+		return nullopt;
+
+	Json::Value message;
+	string errors;
+	if (!util::jsonParseStrict(content, message, &errors) || !message.isObject())
+	{
+		error({}, ErrorCode::ParseError, "Error parsing JSON-RPC message: " + errors);
+		return nullopt;
+	}
+	return message;
+}
+
+void IOStreamTransport::send(Json::Value _message)
+{
+	_message["jsonrpc"] = "2.0";
+	string const content = util::jsonCompactPrint(_message);
+	m_output << "Content-Length: " << content.size() << "\r\n\r\n" << content << flush;
+}
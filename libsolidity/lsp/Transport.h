@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Transport of the JSON-RPC messages of the language server protocol.
+ */
+
+#pragma once
+
+#include <json/value.h>
+
+#include <iosfwd>
+#include <optional>
+#include <string>
+
+namespace solidity::lsp
+{
+
+using MessageID = Json::Value;
+
+enum class ErrorCode
+{
+	// Defined by JSON-RPC.
+	ParseError = -32700,
+	InvalidRequest = -32600,
+	MethodNotFound = -32601,
+	InvalidParams = -32602,
+	InternalError = -32603,
+
+	// Defined by the language server protocol.
+	ServerNotInitialized = -32002,
+	RequestFailed = -32803,
+};
+
+/**
+ * Abstract transport of messages between the language server and its client.
+ */
+class Transport
+{
+public:
+	virtual ~Transport() = default;
+
+	/// @returns true if no further messages can be received.
+	virtual bool closed() const noexcept = 0;
+	/// @returns the next message or an empty optional if it could not be read or parsed,
+	/// in which case an error has been sent to the client already.
+	virtual std::optional<Json::Value> receive() = 0;
+
+	void notify(std::string _method, Json::Value _params);
+	void reply(MessageID const& _id, Json::Value _result);
+	void error(MessageID const& _id, ErrorCode _code, std::string _message);
+
+protected:
+	virtual void send(Json::Value _message) = 0;
+};
+
+/**
+ * Transport over a pair of streams, where each message is preceded by a header that gives
+ * the length of its content, as used by the language server protocol over standard input
+ * and output.
+ */
+class IOStreamTransport: public Transport
+{
+public:
+	IOStreamTransport(std::istream& _in, std::ostream& _out): m_input(_in), m_output(_out) {}
+
+	bool closed() const noexcept override;
+	std::optional<Json::Value> receive() override;
+
+protected:
+	void send(Json::Value _message) override;
+
+private:
+	std::istream& m_input;
+	std::ostream& m_output;
+};
+
+}
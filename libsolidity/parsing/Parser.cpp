@@ -31,6 +31,8 @@
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
 #include <liblangutil/SourceLocation.h>
+#include <libsolutil/Arena.h>
+#include <libsolutil/Common.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/algorithm/string/replace.hpp>
@@ -72,7 +74,16 @@ public:
 		solAssert(m_location.sourceName, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		solAssert(m_parser.m_nodeArena, "");
+		ASTPointer<NodeType> node = allocate_shared<NodeType>(
+			util::ArenaAllocator<NodeType>(m_parser.m_nodeArena),
+			m_parser.nextID(),
+			m_location,
+			std::forward<Args>(_args)...
+		);
+		if (m_parser.m_recordCreatedNodes)
+			m_parser.m_createdNodes.push_back(node);
+		return node;
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -85,10 +96,15 @@ private:
 ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 {
 	solAssert(!m_insideModifier, "");
+	m_createdNodes.clear();
 	try
 	{
 		m_recursionDepth = 0;
 		m_scanner = make_shared<Scanner>(_charStream);
+		// All nodes of a source unit are allocated from one arena, which is released in one go
+		// once the last of them is destroyed.
+		m_nodeArena = make_shared<util::Arena>();
+		ScopeGuard resetArena([&]() { m_nodeArena.reset(); });
 		ASTNodeFactory nodeFactory(*this);
 
 		vector<ASTPointer<ASTNode>> nodes;
@@ -153,6 +169,14 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	}
 }
 
+void Parser::shiftNodeIDs(int64_t _offset)
+{
+	solAssert(m_recordCreatedNodes, "");
+	for (ASTPointer<ASTNode> const& node: m_createdNodes)
+		node->shiftID(_offset);
+	m_createdNodes.clear();
+}
+
 void Parser::parsePragmaVersion(SourceLocation const& _location, vector<Token> const& _tokens, vector<string> const& _literals)
 {
 	SemVerMatchExpressionParser parser(_tokens, _literals);
@@ -209,7 +233,7 @@ ASTPointer<PragmaDirective> Parser::parsePragmaDirective()
 			parserError(6281_error, "Token incompatible with Solidity parser as part of pragma directive.");
 		else
 		{
-			string literal = m_scanner->currentLiteral();
+			string literal{m_scanner->currentLiteral()};
 			if (literal.empty() && TokenTraits::toString(token))
 				literal = TokenTraits::toString(token);
 			literals.push_back(literal);
@@ -647,7 +671,7 @@ ASTPointer<ASTNode> Parser::parseFunctionDefinition(bool _freeFunction)
 		advance();
 	else
 	{
-		block = parseBlock();
+		block = parseFunctionBody();
 		nodeFactory.setEndPositionFromNode(block);
 	}
 	return nodeFactory.createNode<FunctionDefinition>(
@@ -900,7 +924,7 @@ ASTPointer<ModifierDefinition> Parser::parseModifierDefinition()
 	nodeFactory.markEndPosition();
 	if (m_scanner->currentToken() != Token::Semicolon)
 	{
-		block = parseBlock();
+		block = parseFunctionBody();
 		nodeFactory.setEndPositionFromNode(block);
 	}
 	else
@@ -1218,6 +1242,32 @@ ASTPointer<Block> Parser::parseBlock(bool _allowUnchecked, ASTPointer<ASTString>
 	return nodeFactory.createNode<Block>(_docString, unchecked, statements);
 }
 
+ASTPointer<Block> Parser::parseFunctionBody()
+{
+	if (m_skipFunctionBodies)
+		return skipBlock();
+	return parseBlock();
+}
+
+ASTPointer<Block> Parser::skipBlock()
+{
+	ASTNodeFactory nodeFactory(*this);
+	expectToken(Token::LBrace);
+	size_t depth = 0;
+	for (Token token = m_scanner->currentToken(); token != Token::EOS; token = m_scanner->next())
+		if (token == Token::LBrace)
+			depth++;
+		else if (token == Token::RBrace)
+		{
+			if (depth == 0)
+				break;
+			depth--;
+		}
+	nodeFactory.markEndPosition();
+	expectToken(Token::RBrace);
+	return nodeFactory.createNode<Block>(nullptr, false, vector<ASTPointer<Statement>>{});
+}
+
 ASTPointer<Statement> Parser::parseStatement(bool _allowUnchecked)
 {
 	RecursionGuard recursionGuard(*this);
@@ -1327,7 +1377,10 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = nativeLocationOf(*block).end;
-	return make_shared<InlineAssembly>(nextID(), location, _docString, dialect, block);
+	auto inlineAssembly = make_shared<InlineAssembly>(nextID(), location, _docString, dialect, block);
+	if (m_recordCreatedNodes)
+		m_createdNodes.push_back(inlineAssembly);
+	return inlineAssembly;
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -1926,7 +1979,7 @@ ASTPointer<Expression> Parser::parsePrimaryExpression()
 	case Token::UnicodeStringLiteral:
 	case Token::HexStringLiteral:
 	{
-		string literal = m_scanner->currentLiteral();
+		string literal{m_scanner->currentLiteral()};
 		Token firstToken = m_scanner->currentToken();
 		while (m_scanner->peekNextToken() == firstToken)
 		{
@@ -2084,24 +2137,25 @@ optional<string> Parser::findLicenseString(std::vector<ASTPointer<ASTNode>> cons
 
 	// Search inside all parts of the source not covered by parsed nodes.
 	// This will leave e.g. "global comments".
-	using iter = std::string::const_iterator;
+	using iter = char const*;
 	vector<pair<iter, iter>> sequencesToSearch;
-	string const& source = m_scanner->charStream().source();
-	sequencesToSearch.emplace_back(source.begin(), source.end());
+	string_view const source = m_scanner->charStream().source();
+	iter const sourceEnd = source.data() + source.size();
+	sequencesToSearch.emplace_back(source.data(), sourceEnd);
 	for (ASTPointer<ASTNode> const& node: _nodes)
 		if (node->location().hasText())
 		{
-			sequencesToSearch.back().second = source.begin() + node->location().start;
-			sequencesToSearch.emplace_back(source.begin() + node->location().end, source.end());
+			sequencesToSearch.back().second = source.data() + node->location().start;
+			sequencesToSearch.emplace_back(source.data() + node->location().end, sourceEnd);
 		}
 
 	vector<string> licenseNames;
 	for (auto const& [start, end]: sequencesToSearch)
 	{
-		auto declarationsBegin = std::sregex_iterator(start, end, licenseDeclarationRegex);
-		auto declarationsEnd = std::sregex_iterator();
+		auto declarationsBegin = std::cregex_iterator(start, end, licenseDeclarationRegex);
+		auto declarationsEnd = std::cregex_iterator();
 
-		for (std::sregex_iterator declIt = declarationsBegin; declIt != declarationsEnd; ++declIt)
+		for (std::cregex_iterator declIt = declarationsBegin; declIt != declarationsEnd; ++declIt)
 			if (!declIt->empty())
 			{
 				string license = boost::trim_copy(string((*declIt)[1]));
@@ -32,23 +32,44 @@ namespace solidity::langutil
 class CharStream;
 }
 
+namespace solidity::util
+{
+class Arena;
+}
+
 namespace solidity::frontend
 {
 
 class Parser: public langutil::ParserBase
 {
 public:
+	/// @param _skipFunctionBodies if true, the bodies of functions and modifiers are not parsed.
+	/// They are replaced by empty blocks that cover the source range of the skipped bodies.
 	explicit Parser(
 		langutil::ErrorReporter& _errorReporter,
 		langutil::EVMVersion _evmVersion,
-		bool _errorRecovery = false
+		bool _errorRecovery = false,
+		bool _skipFunctionBodies = false
 	):
 		ParserBase(_errorReporter, _errorRecovery),
-		m_evmVersion(_evmVersion)
+		m_evmVersion(_evmVersion),
+		m_skipFunctionBodies(_skipFunctionBodies)
 	{}
 
 	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream);
 
+	/// @returns the ID of the last AST node created by this parser.
+	int64_t lastNodeID() const { return m_currentNodeID; }
+	/// Continues the numbering of AST nodes after @a _id, e.g. if a source unit that was
+	/// parsed before is reused instead of being parsed again.
+	void setLastNodeID(int64_t _id) { m_currentNodeID = _id; }
+	/// Keeps track of the nodes created by the following calls to parse, so that they can be
+	/// renumbered using shiftNodeIDs.
+	void recordCreatedNodes() { m_recordCreatedNodes = true; }
+	/// Adds @a _offset to the IDs of all nodes created by the last call to parse.
+	/// Requires recordCreatedNodes to be called before parsing.
+	void shiftNodeIDs(int64_t _offset);
+
 private:
 	class ASTNodeFactory;
 
@@ -119,6 +140,11 @@ private:
 		bool _allowEmpty = true
 	);
 	ASTPointer<Block> parseBlock(bool _allowUncheckedBlock = false, ASTPointer<ASTString> const& _docString = {});
+	/// Parses the body of a function or modifier, or skips it if requested.
+	ASTPointer<Block> parseFunctionBody();
+	/// Skips a block by only matching its braces.
+	/// @returns an empty block that covers the source range of the skipped block.
+	ASTPointer<Block> skipBlock();
 	ASTPointer<Statement> parseStatement(bool _allowUncheckedBlock = false);
 	ASTPointer<InlineAssembly> parseInlineAssembly(ASTPointer<ASTString> const& _docString = {});
 	ASTPointer<IfStatement> parseIfStatement(ASTPointer<ASTString> const& _docString);
@@ -215,8 +241,15 @@ private:
 	/// Flag that signifies whether '_' is parsed as a PlaceholderStatement or a regular identifier.
 	bool m_insideModifier = false;
 	langutil::EVMVersion m_evmVersion;
+	bool m_skipFunctionBodies = false;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	bool m_recordCreatedNodes = false;
+	/// All nodes created by the last call to parse, including the ones that are not part of
+	/// the resulting AST. Only filled if m_recordCreatedNodes is set.
+	std::vector<ASTPointer<ASTNode>> m_createdNodes;
+	/// Memory of the nodes of the source unit that is being parsed. The nodes keep it alive.
+	std::shared_ptr<util::Arena> m_nodeArena;
 };
 
 }
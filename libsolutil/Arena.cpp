@@ -0,0 +1,46 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Arena.h>
+
+#include <libsolutil/Assertions.h>
+#include <libsolutil/Exceptions.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+void* Arena::allocateInNewBlock(size_t _size, size_t _alignment)
+{
+	assertThrow(_alignment > 0 && (_alignment & (_alignment - 1)) == 0, Exception, "Alignment has to be a power of two.");
+	// Large objects get a block of their own, so that the remainder of the current block stays usable.
+	bool const ownBlock = _size + _alignment > m_blockSize / 4;
+	size_t const blockSize = ownBlock ? _size + _alignment : m_blockSize;
+	// Not value-initialised on purpose.
+	m_blocks.emplace_back(new byte[blockSize]);
+	m_reservedBytes += blockSize;
+
+	uintptr_t const begin = reinterpret_cast<uintptr_t>(m_blocks.back().get());
+	uintptr_t const aligned = (begin + _alignment - 1) & ~uintptr_t(_alignment - 1);
+	if (!ownBlock)
+	{
+		m_next = aligned + _size;
+		m_end = begin + blockSize;
+	}
+	return reinterpret_cast<void*>(aligned);
+}
@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Bump allocation of objects that all live about as long as each other.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Memory arena that hands out memory by advancing a pointer into large blocks.
+ * Memory is not returned to the arena when objects are freed. It is released all at once
+ * when the arena is destroyed.
+ * Not thread-safe.
+ */
+class Arena
+{
+public:
+	explicit Arena(size_t _blockSize = 64 * 1024): m_blockSize(_blockSize) {}
+	Arena(Arena const&) = delete;
+	Arena& operator=(Arena const&) = delete;
+
+	/// @returns @a _size bytes of memory aligned to @a _alignment, which has to be a power of two.
+	void* allocate(size_t _size, size_t _alignment)
+	{
+		uintptr_t const aligned = (m_next + _alignment - 1) & ~uintptr_t(_alignment - 1);
+		if (aligned + _size > m_end || aligned < m_next)
+			return allocateInNewBlock(_size, _alignment);
+		m_next = aligned + _size;
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	/// @returns the number of bytes of all blocks allocated so far.
+	size_t reservedBytes() const { return m_reservedBytes; }
+
+private:
+	void* allocateInNewBlock(size_t _size, size_t _alignment);
+
+	size_t m_blockSize;
+	std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+	uintptr_t m_next = 0;
+	uintptr_t m_end = 0;
+	size_t m_reservedBytes = 0;
+};
+
+/**
+ * Allocator that takes its memory from an arena. Every copy of the allocator shares ownership
+ * of the arena. Combined with std::allocate_shared, this keeps the arena alive until the last
+ * object allocated from it is destroyed.
+ */
+template <class T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(std::shared_ptr<Arena> _arena): m_arena(std::move(_arena)) {}
+	template <class U>
+	ArenaAllocator(ArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _count) { return static_cast<T*>(m_arena->allocate(sizeof(T) * _count, alignof(T))); }
+	/// Memory is only released together with the arena.
+	void deallocate(T*, size_t) {}
+
+	std::shared_ptr<Arena> const& arena() const { return m_arena; }
+
+	template <class U>
+	bool operator==(ArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <class U>
+	bool operator!=(ArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<Arena> m_arena;
+};
+
+}
@@ -28,6 +28,13 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <array>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SOLIDITY_HEX_X86 1
+#include <immintrin.h>
+#endif
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -38,6 +45,51 @@ namespace
 static char const* upperHexChars = "0123456789ABCDEF";
 static char const* lowerHexChars = "0123456789abcdef";
 
+/// The values of the hex characters and -1 for all other characters.
+constexpr array<int8_t, 256> hexValues = []() {
+	array<int8_t, 256> values{};
+	for (size_t i = 0; i < 256; ++i)
+		if (i >= '0' && i <= '9')
+			values[i] = static_cast<int8_t>(i - '0');
+		else if (i >= 'a' && i <= 'f')
+			values[i] = static_cast<int8_t>(i - 'a' + 10);
+		else if (i >= 'A' && i <= 'F')
+			values[i] = static_cast<int8_t>(i - 'A' + 10);
+		else
+			values[i] = -1;
+	return values;
+}();
+
+void toHexPortable(uint8_t const* _data, size_t _size, char* _output, char const* _chars)
+{
+	for (size_t i = 0; i < _size; ++i)
+	{
+		_output[2 * i] = _chars[_data[i] >> 4];
+		_output[2 * i + 1] = _chars[_data[i] & 0xf];
+	}
+}
+
+#ifdef SOLIDITY_HEX_X86
+
+/// Converts sixteen bytes at a time by looking up both nibbles with a byte shuffle.
+__attribute__((target("ssse3"))) void toHexSSSE3(uint8_t const* _data, size_t _size, char* _output, char const* _chars)
+{
+	__m128i const chars = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_chars));
+	__m128i const lowNibble = _mm_set1_epi8(0x0f);
+	size_t i = 0;
+	for (; i + 16 <= _size; i += 16)
+	{
+		__m128i const input = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_data + i));
+		__m128i const high = _mm_shuffle_epi8(chars, _mm_and_si128(_mm_srli_epi16(input, 4), lowNibble));
+		__m128i const low = _mm_shuffle_epi8(chars, _mm_and_si128(input, lowNibble));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(_output + 2 * i), _mm_unpacklo_epi8(high, low));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(_output + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+	}
+	toHexPortable(_data + i, _size - i, _output + 2 * i, _chars);
+}
+
+#endif
+
 }
 
 string solidity::util::toHex(uint8_t _data, HexCase _case)
@@ -63,14 +115,18 @@ string solidity::util::toHex(bytes const& _data, HexPrefix _prefix, HexCase _cas
 		ret[i++] = 'x';
 	}
 
-	// Mixed case will be handled inside the loop.
-	char const* chars = _case == HexCase::Upper ? upperHexChars : lowerHexChars;
+	if (_case != HexCase::Mixed)
+	{
+		toHex(bytesConstRef(&_data), ret.data() + i, _case);
+		return ret;
+	}
+
+	char const* chars = lowerHexChars;
 	size_t rix = _data.size() - 1;
 	for (uint8_t c: _data)
 	{
 		// switch hex case every four hexchars
-		if (_case == HexCase::Mixed)
-			chars = (rix-- & 2) == 0 ? lowerHexChars : upperHexChars;
+		chars = (rix-- & 2) == 0 ? lowerHexChars : upperHexChars;
 
 		ret[i++] = chars[(static_cast<size_t>(c) >> 4ul) & 0xfu];
 		ret[i++] = chars[c & 0xfu];
@@ -80,6 +136,19 @@ string solidity::util::toHex(bytes const& _data, HexPrefix _prefix, HexCase _cas
 	return ret;
 }
 
+void solidity::util::toHex(bytesConstRef _data, char* _output, HexCase _case)
+{
+	assertThrow(_case != HexCase::Mixed, BadHexCase, "Mixed case can only be used for byte arrays.");
+
+	char const* chars = _case == HexCase::Upper ? upperHexChars : lowerHexChars;
+#ifdef SOLIDITY_HEX_X86
+	static bool const useSSSE3 = __builtin_cpu_supports("ssse3");
+	if (useSSSE3)
+		return toHexSSSE3(_data.data(), _data.size(), _output, chars);
+#endif
+	toHexPortable(_data.data(), _data.size(), _output, chars);
+}
+
 int solidity::util::fromHex(char _i, WhenError _throw)
 {
 	if (_i >= '0' && _i <= '9')
@@ -99,30 +168,42 @@ bytes solidity::util::fromHex(std::string const& _s, WhenError _throw)
 	if (_s.empty())
 		return {};
 
-	unsigned s = (_s.size() >= 2 && _s[0] == '0' && _s[1] == 'x') ? 2 : 0;
-	std::vector<uint8_t> ret;
-	ret.reserve((_s.size() - s + 1) / 2);
+	size_t s = (_s.size() >= 2 && _s[0] == '0' && _s[1] == 'x') ? 2 : 0;
+	bytes ret((_s.size() - s + 1) / 2);
 
-	if (_s.size() % 2)
+	size_t o = 0;
+	if ((_s.size() - s) % 2)
 	{
 		int h = fromHex(_s[s++], _throw);
-		if (h != -1)
-			ret.push_back(static_cast<uint8_t>(h));
-		else
+		if (h == -1)
 			return bytes();
+		ret[o++] = static_cast<uint8_t>(h);
 	}
-	for (unsigned i = s; i < _s.size(); i += 2)
+	if (!fromHex(_s.data() + s, ret.size() - o, ret.data() + o))
 	{
-		int h = fromHex(_s[i], _throw);
-		int l = fromHex(_s[i + 1], _throw);
-		if (h != -1 && l != -1)
-			ret.push_back(static_cast<uint8_t>(h * 16 + l));
-		else
-			return bytes();
+		// Find the invalid character for the error message.
+		if (_throw == WhenError::Throw)
+			for (size_t i = s; i < _s.size(); ++i)
+				fromHex(_s[i], _throw);
+		return bytes();
 	}
 	return ret;
 }
 
+bool solidity::util::fromHex(char const* _input, size_t _size, uint8_t* _output)
+{
+	// The values are combined with a bitwise or, so that invalid characters only have to be checked once.
+	int8_t invalid = 0;
+	for (size_t i = 0; i < _size; ++i)
+	{
+		int8_t const high = hexValues[static_cast<uint8_t>(_input[2 * i])];
+		int8_t const low = hexValues[static_cast<uint8_t>(_input[2 * i + 1])];
+		invalid |= static_cast<int8_t>(high | low);
+		_output[i] = static_cast<uint8_t>((static_cast<uint8_t>(high) << 4) | (static_cast<uint8_t>(low) & 0xf));
+	}
+	return invalid >= 0;
+}
+
 
 bool solidity::util::passesAddressChecksum(string const& _str, bool _strict)
 {
@@ -405,6 +405,10 @@ std::string toHex(uint8_t _data, HexCase _case = HexCase::Lower);
 /// optionally with "0x" prefix and with uppercase hex letters.
 std::string toHex(bytes const& _data, HexPrefix _prefix = HexPrefix::DontAdd, HexCase _case = HexCase::Lower);
 
+/// Writes the hex duplets of @a _data to @a _output, which has to have room for
+/// 2 * _data.size() characters. No terminating zero is written. Mixed case is not supported.
+void toHex(bytesConstRef _data, char* _output, HexCase _case = HexCase::Lower);
+
 /// Converts a (printable) ASCII hex character into the corresponding integer value.
 /// @example fromHex('A') == 10 && fromHex('f') == 15 && fromHex('5') == 5
 int fromHex(char _i, WhenError _throw);
@@ -413,6 +417,10 @@ int fromHex(char _i, WhenError _throw);
 /// @example fromHex("41626261") == asBytes("Abba")
 /// If _throw = ThrowType::DontThrow, it replaces bad hex characters with 0's, otherwise it will throw an exception.
 bytes fromHex(std::string const& _s, WhenError _throw = WhenError::DontThrow);
+
+/// Decodes the 2 * @a _size hex characters at @a _input into @a _size bytes at @a _output.
+/// @returns false if one of the characters is not a hex character, in which case the output is unspecified.
+bool fromHex(char const* _input, size_t _size, uint8_t* _output);
 /// Converts byte array to a string containing the same (binary) data. Unless
 /// the byte array happens to contain ASCII data, this won't be printable.
 inline std::string asString(bytes const& _b)
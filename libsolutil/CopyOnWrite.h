@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/** @file CopyOnWrite.h
+ * Value whose copies share their contents until one of them is modified.
+ */
+
+#pragma once
+
+#include <memory>
+
+namespace solidity::util
+{
+
+/**
+ * Holds a value of type T that is shared between all copies of this object, so that copying
+ * is cheap. The value is copied only when it is modified through write() while it is shared.
+ * A default constructed object holds a default constructed value without allocating.
+ *
+ * Copies of an object must not be modified concurrently with each other, since whether the
+ * value is shared is determined from the reference count.
+ */
+template<typename T>
+class CopyOnWrite
+{
+public:
+	CopyOnWrite() = default;
+	explicit CopyOnWrite(T _value): m_value(std::make_shared<T>(std::move(_value))) {}
+
+	T const& operator*() const { return m_value ? *m_value : empty(); }
+	T const* operator->() const { return &**this; }
+
+	/// @returns a reference to the value that is not shared with any other object.
+	/// The reference is invalidated by copying this object.
+	T& write()
+	{
+		if (!m_value)
+			m_value = std::make_shared<T>();
+		else if (m_value.use_count() > 1)
+			m_value = std::make_shared<T>(*m_value);
+		return *m_value;
+	}
+	/// Resets the value to a default constructed one.
+	void reset() { m_value.reset(); }
+
+	/// @returns true if this object and @a _other share their value, in which case the values
+	/// are equal.
+	bool sharesValueWith(CopyOnWrite const& _other) const
+	{
+		return m_value == _other.m_value;
+	}
+
+private:
+	static T const& empty()
+	{
+		static T const value{};
+		return value;
+	}
+
+	std::shared_ptr<T> m_value;
+};
+
+}
@@ -141,7 +141,12 @@ public:
 	uint8_t operator[](unsigned _i) const { return m_data[_i]; }
 
 	/// @returns the hash as a user-readable hex string.
-	std::string hex() const { return toHex(asBytes()); }
+	std::string hex() const
+	{
+		std::string result(N * 2, 0);
+		toHex(ref(), result.data());
+		return result;
+	}
 
 	/// @returns a mutable byte vector_ref to the object's data.
 	bytesRef ref() { return bytesRef(m_data.data(), N); }
@@ -0,0 +1,442 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Fixed-width 256-bit unsigned integer made of four 64-bit limbs, for evaluating EVM arithmetic.
+ */
+
+#pragma once
+
+#include <libsolutil/Numeric.h>
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace solidity
+{
+
+namespace detail
+{
+
+/// @returns the low 64 bits of @a _a + @a _b + @a _carry and sets @a _carry to the carry out.
+inline uint64_t addWithCarry(uint64_t _a, uint64_t _b, uint64_t& _carry)
+{
+	uint64_t const sum = _a + _b;
+	uint64_t const result = sum + _carry;
+	_carry = uint64_t(sum < _a) + uint64_t(result < sum);
+	return result;
+}
+
+/// @returns the low 64 bits of @a _a - @a _b - @a _borrow and sets @a _borrow to the borrow out.
+inline uint64_t subtractWithBorrow(uint64_t _a, uint64_t _b, uint64_t& _borrow)
+{
+	uint64_t const difference = _a - _b;
+	uint64_t const result = difference - _borrow;
+	_borrow = uint64_t(_a < _b) + uint64_t(difference < _borrow);
+	return result;
+}
+
+/// @returns the product of @a _a and @a _b as its high and low 64 bits.
+inline std::pair<uint64_t, uint64_t> multiply(uint64_t _a, uint64_t _b)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 const product = static_cast<unsigned __int128>(_a) * _b;
+	return {static_cast<uint64_t>(product >> 64), static_cast<uint64_t>(product)};
+#else
+	uint64_t const aLow = _a & 0xffffffff;
+	uint64_t const aHigh = _a >> 32;
+	uint64_t const bLow = _b & 0xffffffff;
+	uint64_t const bHigh = _b >> 32;
+	uint64_t const lowLow = aLow * bLow;
+	uint64_t const highLow = aHigh * bLow;
+	uint64_t const lowHigh = aLow * bHigh;
+	uint64_t const middle = (lowLow >> 32) + (highLow & 0xffffffff) + lowHigh;
+	return {aHigh * bHigh + (highLow >> 32) + (middle >> 32), (middle << 32) | (lowLow & 0xffffffff)};
+#endif
+}
+
+/// @returns the low 64 bits of @a _a * @a _b + @a _addend + @a _carry and sets @a _carry to the high 64 bits.
+inline uint64_t multiplyAdd(uint64_t _a, uint64_t _b, uint64_t _addend, uint64_t& _carry)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 const result = static_cast<unsigned __int128>(_a) * _b + _addend + _carry;
+	_carry = static_cast<uint64_t>(result >> 64);
+	return static_cast<uint64_t>(result);
+#else
+	auto [high, low] = multiply(_a, _b);
+	uint64_t addendCarry = 0;
+	uint64_t const sum = addWithCarry(low, _addend, addendCarry);
+	uint64_t carryCarry = 0;
+	uint64_t const result = addWithCarry(sum, _carry, carryCarry);
+	// The high half of a product is at most 2**64 - 2, so this does not overflow.
+	_carry = high + addendCarry + carryCarry;
+	return result;
+#endif
+}
+
+/// @returns the quotient of @a _high * 2**64 + @a _low divided by @a _divisor, which must be larger
+/// than @a _high, and sets @a _remainder to the remainder.
+inline uint64_t divide(uint64_t _high, uint64_t _low, uint64_t _divisor, uint64_t& _remainder)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 const dividend = (static_cast<unsigned __int128>(_high) << 64) | _low;
+	_remainder = static_cast<uint64_t>(dividend % _divisor);
+	return static_cast<uint64_t>(dividend / _divisor);
+#else
+	uint64_t quotient = 0;
+	for (unsigned i = 64; i > 0; --i)
+	{
+		bool const overflow = (_high >> 63) != 0;
+		_high = (_high << 1) | (_low >> 63);
+		_low <<= 1;
+		quotient <<= 1;
+		if (overflow || _high >= _divisor)
+		{
+			_high -= _divisor;
+			quotient |= 1;
+		}
+	}
+	_remainder = _high;
+	return quotient;
+#endif
+}
+
+/// @returns the number of leading zero bits of @a _value, which must not be zero.
+inline unsigned countLeadingZeros(uint64_t _value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<unsigned>(__builtin_clzll(_value));
+#else
+	unsigned count = 0;
+	for (uint64_t bit = uint64_t(1) << 63; !(_value & bit); bit >>= 1)
+		++count;
+	return count;
+#endif
+}
+
+}
+
+/// Unsigned 256-bit integer with the wrapping semantics of the EVM, including that division
+/// and modulo by zero result in zero. It is trivially copyable and does not allocate, which
+/// makes it cheaper than u256 for evaluating instructions on constants.
+class FixedU256
+{
+public:
+	FixedU256() = default;
+	constexpr FixedU256(uint64_t _value): m_limbs{{_value, 0, 0, 0}} {}
+	explicit FixedU256(u256 const& _value)
+	{
+		auto const& backend = _value.backend();
+		unsigned constexpr limbBits = sizeof(boost::multiprecision::limb_type) * 8;
+		for (size_t i = 0; i < backend.size(); ++i)
+			m_limbs[i * limbBits / 64] |= uint64_t(backend.limbs()[i]) << (i * limbBits % 64);
+	}
+
+	explicit operator u256() const
+	{
+		u256 result;
+		boost::multiprecision::import_bits(result, m_limbs.rbegin(), m_limbs.rend(), 64);
+		return result;
+	}
+
+	/// @returns the limb with the given index, where index zero is the least significant one.
+	uint64_t limb(size_t _index) const { return m_limbs[_index]; }
+
+	bool isZero() const { return (m_limbs[0] | m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0; }
+	/// @returns true if the number is negative when it is interpreted as two's complement.
+	bool isNegative() const { return (m_limbs[3] >> 63) != 0; }
+	bool bit(unsigned _index) const { return _index < 256 && ((m_limbs[_index / 64] >> (_index % 64)) & 1); }
+	/// @returns the number of bits that are needed to represent the number, i.e. zero for zero.
+	unsigned bitLength() const
+	{
+		for (size_t i = 4; i > 0; --i)
+			if (m_limbs[i - 1])
+				return static_cast<unsigned>(i * 64) - detail::countLeadingZeros(m_limbs[i - 1]);
+		return 0;
+	}
+
+	friend bool operator==(FixedU256 const& _a, FixedU256 const& _b) { return _a.m_limbs == _b.m_limbs; }
+	friend bool operator!=(FixedU256 const& _a, FixedU256 const& _b) { return !(_a == _b); }
+	friend bool operator<(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		for (size_t i = 4; i > 0; --i)
+			if (_a.m_limbs[i - 1] != _b.m_limbs[i - 1])
+				return _a.m_limbs[i - 1] < _b.m_limbs[i - 1];
+		return false;
+	}
+	friend bool operator>(FixedU256 const& _a, FixedU256 const& _b) { return _b < _a; }
+	friend bool operator<=(FixedU256 const& _a, FixedU256 const& _b) { return !(_b < _a); }
+	friend bool operator>=(FixedU256 const& _a, FixedU256 const& _b) { return !(_a < _b); }
+
+	friend FixedU256 operator+(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 result;
+		uint64_t carry = 0;
+		for (size_t i = 0; i < 4; ++i)
+			result.m_limbs[i] = detail::addWithCarry(_a.m_limbs[i], _b.m_limbs[i], carry);
+		return result;
+	}
+	friend FixedU256 operator-(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 result;
+		uint64_t borrow = 0;
+		for (size_t i = 0; i < 4; ++i)
+			result.m_limbs[i] = detail::subtractWithBorrow(_a.m_limbs[i], _b.m_limbs[i], borrow);
+		return result;
+	}
+	friend FixedU256 operator-(FixedU256 const& _a) { return FixedU256(0) - _a; }
+	friend FixedU256 operator*(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 result;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			if (!_a.m_limbs[i])
+				continue;
+			uint64_t carry = 0;
+			for (size_t j = 0; i + j < 4; ++j)
+				result.m_limbs[i + j] = detail::multiplyAdd(_a.m_limbs[i], _b.m_limbs[j], result.m_limbs[i + j], carry);
+		}
+		return result;
+	}
+	friend FixedU256 operator/(FixedU256 const& _a, FixedU256 const& _b) { return divMod(_a, _b).first; }
+	friend FixedU256 operator%(FixedU256 const& _a, FixedU256 const& _b) { return divMod(_a, _b).second; }
+
+	friend FixedU256 operator~(FixedU256 const& _a)
+	{
+		FixedU256 result;
+		for (size_t i = 0; i < 4; ++i)
+			result.m_limbs[i] = ~_a.m_limbs[i];
+		return result;
+	}
+	friend FixedU256 operator&(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 result;
+		for (size_t i = 0; i < 4; ++i)
+			result.m_limbs[i] = _a.m_limbs[i] & _b.m_limbs[i];
+		return result;
+	}
+	friend FixedU256 operator|(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 result;
+		for (size_t i = 0; i < 4; ++i)
+			result.m_limbs[i] = _a.m_limbs[i] | _b.m_limbs[i];
+		return result;
+	}
+	friend FixedU256 operator^(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 result;
+		for (size_t i = 0; i < 4; ++i)
+			result.m_limbs[i] = _a.m_limbs[i] ^ _b.m_limbs[i];
+		return result;
+	}
+	/// Shifts by @a _amount bits, where amounts of at least 256 result in zero.
+	friend FixedU256 operator<<(FixedU256 const& _a, unsigned _amount)
+	{
+		FixedU256 result;
+		if (_amount >= 256)
+			return result;
+		size_t const limbShift = _amount / 64;
+		unsigned const bitShift = _amount % 64;
+		for (size_t i = limbShift; i < 4; ++i)
+		{
+			result.m_limbs[i] = _a.m_limbs[i - limbShift] << bitShift;
+			if (bitShift && i > limbShift)
+				result.m_limbs[i] |= _a.m_limbs[i - limbShift - 1] >> (64 - bitShift);
+		}
+		return result;
+	}
+	/// Shifts by @a _amount bits, where amounts of at least 256 result in zero.
+	friend FixedU256 operator>>(FixedU256 const& _a, unsigned _amount)
+	{
+		FixedU256 result;
+		if (_amount >= 256)
+			return result;
+		size_t const limbShift = _amount / 64;
+		unsigned const bitShift = _amount % 64;
+		for (size_t i = 0; i + limbShift < 4; ++i)
+		{
+			result.m_limbs[i] = _a.m_limbs[i + limbShift] >> bitShift;
+			if (bitShift && i + limbShift + 1 < 4)
+				result.m_limbs[i] |= _a.m_limbs[i + limbShift + 1] << (64 - bitShift);
+		}
+		return result;
+	}
+
+	FixedU256& operator+=(FixedU256 const& _other) { return *this = *this + _other; }
+	FixedU256& operator-=(FixedU256 const& _other) { return *this = *this - _other; }
+	FixedU256& operator*=(FixedU256 const& _other) { return *this = *this * _other; }
+	FixedU256& operator/=(FixedU256 const& _other) { return *this = *this / _other; }
+	FixedU256& operator%=(FixedU256 const& _other) { return *this = *this % _other; }
+	FixedU256& operator&=(FixedU256 const& _other) { return *this = *this & _other; }
+	FixedU256& operator|=(FixedU256 const& _other) { return *this = *this | _other; }
+	FixedU256& operator^=(FixedU256 const& _other) { return *this = *this ^ _other; }
+	FixedU256& operator<<=(unsigned _amount) { return *this = *this << _amount; }
+	FixedU256& operator>>=(unsigned _amount) { return *this = *this >> _amount; }
+
+	/// @returns the quotient and the remainder of @a _a divided by @a _b, which are zero if @a _b is zero.
+	friend std::pair<FixedU256, FixedU256> divMod(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		if (_b.isZero())
+			return {FixedU256(0), FixedU256(0)};
+		if (_a < _b)
+			return {FixedU256(0), _a};
+		FixedU256 quotient;
+		size_t const divisorLength = (_b.bitLength() + 63) / 64;
+		if (divisorLength == 1)
+		{
+			uint64_t remainder = 0;
+			for (size_t i = 4; i > 0; --i)
+				quotient.m_limbs[i - 1] = detail::divide(remainder, _a.m_limbs[i - 1], _b.m_limbs[0], remainder);
+			return {quotient, FixedU256(remainder)};
+		}
+#if defined(__SIZEOF_INT128__)
+		// Long division on limbs as in Knuth, The Art of Computer Programming, Vol. 2, 4.3.1, Algorithm D.
+		size_t const dividendLength = (_a.bitLength() + 63) / 64;
+		unsigned const shift = detail::countLeadingZeros(_b.m_limbs[divisorLength - 1]);
+		std::array<uint64_t, 4> divisor{};
+		std::array<uint64_t, 5> remainder{};
+		for (size_t i = divisorLength; i > 0; --i)
+			divisor[i - 1] = (_b.m_limbs[i - 1] << shift) | (shift && i > 1 ? _b.m_limbs[i - 2] >> (64 - shift) : 0);
+		remainder[dividendLength] = shift ? _a.m_limbs[dividendLength - 1] >> (64 - shift) : 0;
+		for (size_t i = dividendLength; i > 0; --i)
+			remainder[i - 1] = (_a.m_limbs[i - 1] << shift) | (shift && i > 1 ? _a.m_limbs[i - 2] >> (64 - shift) : 0);
+
+		uint64_t const top = divisor[divisorLength - 1];
+		uint64_t const second = divisor[divisorLength - 2];
+		for (size_t j = dividendLength - divisorLength + 1; j > 0; --j)
+		{
+			size_t const position = j - 1;
+			// Estimate the quotient limb from the top limbs, which is at most two too large.
+			unsigned __int128 const numerator =
+				(static_cast<unsigned __int128>(remainder[position + divisorLength]) << 64) |
+				remainder[position + divisorLength - 1];
+			unsigned __int128 estimate = numerator / top;
+			unsigned __int128 estimateRemainder = numerator % top;
+			while (
+				(estimate >> 64) ||
+				estimate * second > ((estimateRemainder << 64) | remainder[position + divisorLength - 2])
+			)
+			{
+				--estimate;
+				estimateRemainder += top;
+				if (estimateRemainder >> 64)
+					break;
+			}
+
+			uint64_t quotientLimb = static_cast<uint64_t>(estimate);
+			uint64_t carry = 0;
+			uint64_t borrow = 0;
+			for (size_t i = 0; i < divisorLength; ++i)
+			{
+				uint64_t const product = detail::multiplyAdd(quotientLimb, divisor[i], 0, carry);
+				remainder[position + i] = detail::subtractWithBorrow(remainder[position + i], product, borrow);
+			}
+			remainder[position + divisorLength] = detail::subtractWithBorrow(remainder[position + divisorLength], carry, borrow);
+			if (borrow)
+			{
+				// The estimate was one too large, so the divisor is added back.
+				--quotientLimb;
+				carry = 0;
+				for (size_t i = 0; i < divisorLength; ++i)
+					remainder[position + i] = detail::addWithCarry(remainder[position + i], divisor[i], carry);
+				remainder[position + divisorLength] += carry;
+			}
+			quotient.m_limbs[position] = quotientLimb;
+		}
+
+		FixedU256 unnormalizedRemainder;
+		for (size_t i = 0; i < divisorLength; ++i)
+			unnormalizedRemainder.m_limbs[i] = (remainder[i] >> shift) | (shift ? remainder[i + 1] << (64 - shift) : 0);
+		return {quotient, unnormalizedRemainder};
+#else
+		// Binary long division, which only takes as many steps as the quotient has bits.
+		unsigned const shift = _a.bitLength() - _b.bitLength();
+		FixedU256 remainder = _a;
+		FixedU256 divisor = _b << shift;
+		for (unsigned step = 0; step <= shift; ++step)
+		{
+			quotient <<= 1;
+			if (remainder >= divisor)
+			{
+				remainder -= divisor;
+				quotient.m_limbs[0] |= 1;
+			}
+			divisor >>= 1;
+		}
+		return {quotient, remainder};
+#endif
+	}
+
+	/// @returns @a _a divided by @a _b as two's complement numbers, rounded towards zero,
+	/// which is zero if @a _b is zero.
+	friend FixedU256 sdiv(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 const quotient = (_a.isNegative() ? -_a : _a) / (_b.isNegative() ? -_b : _b);
+		return _a.isNegative() != _b.isNegative() ? -quotient : quotient;
+	}
+	/// @returns the remainder of @a _a divided by @a _b as two's complement numbers,
+	/// which has the sign of @a _a and is zero if @a _b is zero.
+	friend FixedU256 smod(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 const remainder = (_a.isNegative() ? -_a : _a) % (_b.isNegative() ? -_b : _b);
+		return _a.isNegative() ? -remainder : remainder;
+	}
+	/// @returns @a _a shifted right by @a _amount bits as a two's complement number.
+	friend FixedU256 sar(FixedU256 const& _a, unsigned _amount)
+	{
+		return _a.isNegative() ? ~(~_a >> _amount) : _a >> _amount;
+	}
+	/// @returns @a _base to the power of @a _exponent modulo 2**256.
+	friend FixedU256 exp(FixedU256 _base, FixedU256 const& _exponent)
+	{
+		FixedU256 result(1);
+		for (unsigned i = 0, length = _exponent.bitLength(); i < length; ++i)
+		{
+			if (_exponent.bit(i))
+				result *= _base;
+			if (i + 1 < length)
+				_base *= _base;
+		}
+		return result;
+	}
+	/// @returns @a _value sign-extended from the byte with index @a _byte, counted from the least significant byte.
+	friend FixedU256 signExtend(FixedU256 const& _byte, FixedU256 const& _value)
+	{
+		if (_byte >= FixedU256(31))
+			return _value;
+		unsigned const testBit = static_cast<unsigned>(_byte.m_limbs[0]) * 8 + 7;
+		FixedU256 const mask = (FixedU256(1) << testBit) - FixedU256(1);
+		return _value.bit(testBit) ? _value | ~mask : _value & mask;
+	}
+	/// @returns the byte of @a _value with index @a _index, counted from the most significant byte.
+	friend FixedU256 byteOf(FixedU256 const& _index, FixedU256 const& _value)
+	{
+		if (_index >= FixedU256(32))
+			return FixedU256(0);
+		return FixedU256((_value >> static_cast<unsigned>(8 * (31 - _index.m_limbs[0]))).m_limbs[0] & 0xff);
+	}
+
+private:
+	/// The limbs, starting with the least significant one.
+	std::array<uint64_t, 4> m_limbs{};
+};
+
+static_assert(std::is_trivially_copyable_v<FixedU256>);
+
+}
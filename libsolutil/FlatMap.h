@@ -0,0 +1,134 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/** @file FlatMap.h
+ * Map that is stored as a vector sorted by the keys.
+ */
+
+#pragma once
+
+#include <libsolutil/SmallVector.h>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+namespace solidity::util
+{
+
+/**
+ * Map with the interface of a subset of std::map that stores its entries sorted by key in a
+ * SmallVector, so that small maps do not allocate at all and can be copied cheaply. Insertions
+ * and removals move the entries after them, so this is only suitable for small maps.
+ * Unlike for std::map, the keys can be modified through iterators, which must not change their
+ * order, and all iterators and references are invalidated by insertions and removals.
+ */
+template<typename K, typename V, size_t N = 8, typename Compare = std::less<K>>
+class FlatMap
+{
+public:
+	using key_type = K;
+	using mapped_type = V;
+	using value_type = std::pair<K, V>;
+	using size_type = size_t;
+	using iterator = value_type*;
+	using const_iterator = value_type const*;
+
+	FlatMap() = default;
+	FlatMap(std::initializer_list<value_type> _values)
+	{
+		for (value_type const& value: _values)
+			insert(value);
+	}
+
+	iterator begin() { return m_values.begin(); }
+	iterator end() { return m_values.end(); }
+	const_iterator begin() const { return m_values.begin(); }
+	const_iterator end() const { return m_values.end(); }
+	const_iterator cbegin() const { return m_values.begin(); }
+	const_iterator cend() const { return m_values.end(); }
+	size_t size() const { return m_values.size(); }
+	bool empty() const { return m_values.empty(); }
+	void clear() { m_values.clear(); }
+	void reserve(size_t _capacity) { m_values.reserve(_capacity); }
+
+	V& operator[](K const& _key)
+	{
+		iterator position = lower_bound(_key);
+		if (position == end() || m_compare(_key, position->first))
+			position = m_values.insert(position, value_type(_key, V{}));
+		return position->second;
+	}
+	V& at(K const& _key)
+	{
+		iterator position = find(_key);
+		if (position == end())
+			throw std::out_of_range("FlatMap::at");
+		return position->second;
+	}
+	V const& at(K const& _key) const { return const_cast<FlatMap&>(*this).at(_key); }
+
+	std::pair<iterator, bool> insert(value_type _value)
+	{
+		iterator position = lower_bound(_value.first);
+		if (position != end() && !m_compare(_value.first, position->first))
+			return {position, false};
+		return {m_values.insert(position, std::move(_value)), true};
+	}
+	std::pair<iterator, bool> emplace(K _key, V _value) { return insert(value_type(std::move(_key), std::move(_value))); }
+
+	iterator erase(const_iterator _position) { return m_values.erase(_position); }
+	iterator erase(const_iterator _first, const_iterator _last) { return m_values.erase(_first, _last); }
+	size_t erase(K const& _key)
+	{
+		iterator position = find(_key);
+		if (position == end())
+			return 0;
+		m_values.erase(position);
+		return 1;
+	}
+
+	iterator find(K const& _key)
+	{
+		iterator position = lower_bound(_key);
+		return position != end() && !m_compare(_key, position->first) ? position : end();
+	}
+	const_iterator find(K const& _key) const { return const_cast<FlatMap&>(*this).find(_key); }
+	size_t count(K const& _key) const { return find(_key) == end() ? 0 : 1; }
+
+	iterator lower_bound(K const& _key)
+	{
+		return std::lower_bound(begin(), end(), _key, [&](value_type const& _a, K const& _b) { return m_compare(_a.first, _b); });
+	}
+	const_iterator lower_bound(K const& _key) const { return const_cast<FlatMap&>(*this).lower_bound(_key); }
+	iterator upper_bound(K const& _key)
+	{
+		return std::upper_bound(begin(), end(), _key, [&](K const& _a, value_type const& _b) { return m_compare(_a, _b.first); });
+	}
+	const_iterator upper_bound(K const& _key) const { return const_cast<FlatMap&>(*this).upper_bound(_key); }
+
+	bool operator==(FlatMap const& _other) const { return m_values == _other.m_values; }
+	bool operator!=(FlatMap const& _other) const { return m_values != _other.m_values; }
+
+private:
+	SmallVector<value_type, N> m_values;
+	Compare m_compare;
+};
+
+}
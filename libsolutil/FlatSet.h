@@ -0,0 +1,106 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/** @file FlatSet.h
+ * Set that is stored as a sorted vector.
+ */
+
+#pragma once
+
+#include <libsolutil/SmallVector.h>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+namespace solidity::util
+{
+
+/**
+ * Set with the interface of a subset of std::set that stores its elements sorted in a SmallVector,
+ * so that small sets do not allocate at all and lookups do not chase pointers. Insertions and
+ * removals move the elements after them, so this is only suitable for small sets.
+ * Unlike for std::set, all iterators are invalidated by insertions and removals.
+ */
+template<typename T, size_t N = 8, typename Compare = std::less<T>>
+class FlatSet
+{
+public:
+	using value_type = T;
+	using key_type = T;
+	using size_type = size_t;
+	using iterator = T const*;
+	using const_iterator = T const*;
+
+	FlatSet() = default;
+	FlatSet(std::initializer_list<T> _values) { insert(_values.begin(), _values.end()); }
+	template<typename Iterator>
+	FlatSet(Iterator _begin, Iterator _end) { insert(_begin, _end); }
+
+	iterator begin() const { return m_values.begin(); }
+	iterator end() const { return m_values.end(); }
+	size_t size() const { return m_values.size(); }
+	bool empty() const { return m_values.empty(); }
+	void clear() { m_values.clear(); }
+	void reserve(size_t _capacity) { m_values.reserve(_capacity); }
+
+	std::pair<iterator, bool> insert(T _value)
+	{
+		iterator position = lower_bound(_value);
+		if (position != end() && !m_compare(_value, *position))
+			return {position, false};
+		return {m_values.insert(position, std::move(_value)), true};
+	}
+	template<typename Iterator>
+	void insert(Iterator _begin, Iterator _end)
+	{
+		for (; _begin != _end; ++_begin)
+			insert(*_begin);
+	}
+	template<typename... Args>
+	std::pair<iterator, bool> emplace(Args&&... _args) { return insert(T(std::forward<Args>(_args)...)); }
+
+	iterator erase(const_iterator _position) { return m_values.erase(_position); }
+	size_t erase(T const& _value)
+	{
+		iterator position = find(_value);
+		if (position == end())
+			return 0;
+		m_values.erase(position);
+		return 1;
+	}
+
+	iterator find(T const& _value) const
+	{
+		iterator position = lower_bound(_value);
+		return position != end() && !m_compare(_value, *position) ? position : end();
+	}
+	size_t count(T const& _value) const { return find(_value) == end() ? 0 : 1; }
+	iterator lower_bound(T const& _value) const { return std::lower_bound(begin(), end(), _value, m_compare); }
+	iterator upper_bound(T const& _value) const { return std::upper_bound(begin(), end(), _value, m_compare); }
+
+	bool operator==(FlatSet const& _other) const { return m_values == _other.m_values; }
+	bool operator!=(FlatSet const& _other) const { return m_values != _other.m_values; }
+	bool operator<(FlatSet const& _other) const { return m_values < _other.m_values; }
+
+private:
+	SmallVector<T, N> m_values;
+	Compare m_compare;
+};
+
+}
@@ -0,0 +1,140 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Mapping from keys to values that also keeps track of the keys that map to each value,
+ * so that all entries with a certain value can be removed without scanning the whole map.
+ */
+template<typename K, typename V>
+struct InvertibleMap
+{
+	/// Maps each key to its value.
+	std::unordered_map<K, V> values;
+	/// Maps each value to the set of keys that have this value. Never contains empty sets.
+	std::unordered_map<V, std::set<K>> references;
+
+	bool empty() const { return values.empty(); }
+
+	void set(K const& _key, V const& _value)
+	{
+		eraseKey(_key);
+		values[_key] = _value;
+		references[_value].insert(_key);
+	}
+
+	void eraseKey(K const& _key)
+	{
+		auto it = values.find(_key);
+		if (it == values.end())
+			return;
+		eraseReference(it->second, _key);
+		values.erase(it);
+	}
+
+	/// Removes all entries whose value is @a _value.
+	void eraseValue(V const& _value)
+	{
+		auto it = references.find(_value);
+		if (it == references.end())
+			return;
+		for (K const& key: it->second)
+			values.erase(key);
+		references.erase(it);
+	}
+
+	/// Removes all entries for which @a _predicate(key, value) returns true.
+	template<typename Predicate>
+	void eraseIf(Predicate&& _predicate)
+	{
+		std::vector<K> keysToErase;
+		for (auto const& [key, value]: values)
+			if (_predicate(key, value))
+				keysToErase.push_back(key);
+		for (K const& key: keysToErase)
+			eraseKey(key);
+	}
+
+	void clear()
+	{
+		values.clear();
+		references.clear();
+	}
+
+private:
+	void eraseReference(V const& _value, K const& _key)
+	{
+		auto it = references.find(_value);
+		if (it == references.end())
+			return;
+		it->second.erase(_key);
+		if (it->second.empty())
+			references.erase(it);
+	}
+};
+
+/**
+ * Relation between elements that also keeps track of the inverse relation,
+ * so that all elements related to a given one can be found without scanning.
+ */
+template<typename T>
+struct InvertibleRelation
+{
+	/// values[a].count(b) iff a is related to b.
+	std::unordered_map<T, std::set<T>> values;
+	/// references[b].count(a) iff a is related to b. Never contains empty sets.
+	std::unordered_map<T, std::set<T>> references;
+
+	/// Replaces the elements @a _key is related to by @a _values.
+	void set(T const& _key, std::set<T> _values)
+	{
+		eraseKey(_key);
+		for (T const& value: _values)
+			references[value].insert(_key);
+		values[_key] = std::move(_values);
+	}
+
+	/// Removes @a _key together with all the elements it is related to.
+	/// Elements that are related to @a _key are not changed.
+	void eraseKey(T const& _key)
+	{
+		auto it = values.find(_key);
+		if (it == values.end())
+			return;
+		for (T const& value: it->second)
+		{
+			auto referencesIt = references.find(value);
+			if (referencesIt == references.end())
+				continue;
+			referencesIt->second.erase(_key);
+			if (referencesIt->second.empty())
+				references.erase(referencesIt);
+		}
+		values.erase(it);
+	}
+};
+
+}
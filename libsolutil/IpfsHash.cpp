@@ -19,9 +19,9 @@
 #include <libsolutil/IpfsHash.h>
 
 #include <libsolutil/Exceptions.h>
-#include <libsolutil/picosha2.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Numeric.h>
+#include <libsolutil/SHA256.h>
 
 using namespace std;
 using namespace solidity;
@@ -48,7 +48,7 @@ bytes encodeByteArray(bytes const& _data)
 
 bytes encodeHash(bytes const& _data)
 {
-	return bytes{0x12, 0x20} + picosha2::hash256(_data);
+	return bytes{0x12, 0x20} + sha256(&_data).asBytes();
 }
 
 bytes encodeLinkData(bytes const& _data)
@@ -153,51 +153,59 @@ bytes groupChunksBottomUp(Chunks _currentLevel)
 }
 }
 
-bytes solidity::util::ipfsHash(string _data)
+bytes solidity::util::ipfsHash(bytesConstRef _data)
 {
 	size_t const maxChunkSize = 1024 * 256;
-	size_t chunkCount = _data.length() / maxChunkSize + (_data.length() % maxChunkSize > 0 ? 1 : 0);
+	size_t chunkCount = _data.size() / maxChunkSize + (_data.size() % maxChunkSize > 0 ? 1 : 0);
 	chunkCount = chunkCount == 0 ? 1 : chunkCount;
 
 	Chunks allChunks;
 
 	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
 	{
-		bytes chunkBytes = asBytes(
-			_data.substr(chunkIndex * maxChunkSize, min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize))
+		bytesConstRef chunkBytes = _data.cropped(
+			chunkIndex * maxChunkSize,
+			min(maxChunkSize, _data.size() - chunkIndex * maxChunkSize)
 		);
 
 		bytes lengthAsVarint = varintEncoding(chunkBytes.size());
 
-		bytes protobufEncodedData;
+		// The protobuf encoding surrounds the data of the chunk, which is hashed
+		// where it is instead of being copied into the encoding.
+		bytes protobufPrefix;
 		// Type: File
-		protobufEncodedData += bytes{0x08, 0x02};
+		protobufPrefix += bytes{0x08, 0x02};
 		if (!chunkBytes.empty())
 		{
 			// Data (length delimited bytes)
-			protobufEncodedData += bytes{0x12};
-			protobufEncodedData += lengthAsVarint;
-			protobufEncodedData += chunkBytes;
+			protobufPrefix += bytes{0x12};
+			protobufPrefix += lengthAsVarint;
 		}
 		// filesize: length as varint
-		protobufEncodedData += bytes{0x18} + lengthAsVarint;
+		bytes protobufSuffix = bytes{0x18} + lengthAsVarint;
+		size_t const protobufSize = protobufPrefix.size() + chunkBytes.size() + protobufSuffix.size();
 
 		// PBDag:
 		// Data: (length delimited bytes)
-		bytes blockData = encodeByteArray(protobufEncodedData);
+		bytes blockPrefix = bytes{0x0a} + varintEncoding(protobufSize) + protobufPrefix;
 
 		// Multihash: sha2-256, 256 bits
+		SHA256 hasher;
+		hasher.update(&blockPrefix);
+		hasher.update(chunkBytes);
+		hasher.update(&protobufSuffix);
+
 		allChunks.emplace_back(
-			encodeHash(blockData),
+			bytes{0x12, 0x20} + hasher.digest().asBytes(),
 			chunkBytes.size(),
-			blockData.size()
+			blockPrefix.size() + chunkBytes.size() + protobufSuffix.size()
 		);
 	}
 
 	return groupChunksBottomUp(std::move(allChunks));
 }
 
-string solidity::util::ipfsHashBase58(string _data)
+string solidity::util::ipfsHashBase58(bytesConstRef _data)
 {
-	return base58Encode(ipfsHash(std::move(_data)));
+	return base58Encode(ipfsHash(_data));
 }
@@ -30,9 +30,11 @@ namespace solidity::util
 /// As hash function it will use sha2-256.
 /// The effect is that the hash should be identical to the one produced by
 /// the command `ipfs add <filename>`.
-bytes ipfsHash(std::string _data);
+bytes ipfsHash(bytesConstRef _data);
+inline bytes ipfsHash(std::string const& _data) { return ipfsHash(bytesConstRef(_data)); }
 
 /// Compute the "ipfs hash" as above, but encoded in base58 as used by ipfs / bitcoin.
-std::string ipfsHashBase58(std::string _data);
+std::string ipfsHashBase58(bytesConstRef _data);
+inline std::string ipfsHashBase58(std::string const& _data) { return ipfsHashBase58(bytesConstRef(_data)); }
 
 }
@@ -22,7 +22,9 @@
 
 #include <libsolutil/JSON.h>
 
+#include <libsolutil/Assertions.h>
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -88,6 +90,265 @@ bool parse(Json::CharReaderBuilder& _builder, string const& _input, Json::Value&
 	return reader->parse(_input.c_str(), _input.c_str() + _input.length(), &_json, _errs);
 }
 
+/// Finds the string values of the members for whose path @a _extract returns true
+/// in a JSON document. It relies on jsoncpp parsing the rest of the document to detect
+/// invalid input, but the strings it decodes are checked in the same way as jsoncpp does.
+class StringExtractor
+{
+public:
+	StringExtractor(string const& _input, function<bool(vector<string> const&)> const& _extract):
+		m_input(_input),
+		m_extract(_extract)
+	{}
+
+	/// @returns false if the input is not a valid JSON document or a string cannot be extracted.
+	bool run()
+	{
+		skipWhitespace();
+		if (!value(0))
+			return false;
+		skipWhitespace();
+		return m_position == m_input.size();
+	}
+
+	/// @returns the input without the contents of the extracted strings.
+	string skeleton() const
+	{
+		string result;
+		size_t position = 0;
+		for (auto const& [begin, end]: m_ranges)
+		{
+			result.append(m_input, position, begin - position);
+			result += "\"\"";
+			position = end;
+		}
+		result.append(m_input, position, string::npos);
+		return result;
+	}
+
+	vector<pair<vector<string>, string>>& extracted() { return m_extracted; }
+
+private:
+	/// The maximum depth of nested values, which is the one of jsoncpp.
+	static size_t constexpr maxDepth = 1000;
+
+	bool value(size_t _depth)
+	{
+		if (m_position == m_input.size() || _depth >= maxDepth)
+			return false;
+		switch (m_input[m_position])
+		{
+		case '{':
+			return object(_depth);
+		case '[':
+			return array(_depth);
+		case '"':
+			return skipString();
+		default:
+			return scalar();
+		}
+	}
+
+	bool object(size_t _depth)
+	{
+		++m_position;
+		skipWhitespace();
+		if (consume('}'))
+			return true;
+		do
+		{
+			skipWhitespace();
+			string name;
+			if (m_position == m_input.size() || m_input[m_position] != '"' || !decodeString(name))
+				return false;
+			skipWhitespace();
+			if (!consume(':'))
+				return false;
+			skipWhitespace();
+			m_path.emplace_back(move(name));
+			if (m_position < m_input.size() && m_input[m_position] == '"' && m_extract(m_path))
+			{
+				size_t const begin = m_position;
+				string decoded;
+				if (!decodeString(decoded))
+					return false;
+				m_ranges.emplace_back(begin, m_position);
+				m_extracted.emplace_back(m_path, move(decoded));
+			}
+			else if (!value(_depth + 1))
+				return false;
+			m_path.pop_back();
+			skipWhitespace();
+		}
+		while (consume(','));
+		return consume('}');
+	}
+
+	bool array(size_t _depth)
+	{
+		++m_position;
+		skipWhitespace();
+		if (consume(']'))
+			return true;
+		do
+		{
+			skipWhitespace();
+			// The path only consists of member names, so members of objects in arrays are not extracted.
+			vector<string> path;
+			swap(path, m_path);
+			bool const valid = value(_depth + 1);
+			swap(path, m_path);
+			if (!valid)
+				return false;
+			skipWhitespace();
+		}
+		while (consume(','));
+		return consume(']');
+	}
+
+	bool scalar()
+	{
+		size_t const begin = m_position;
+		while (m_position < m_input.size() && (isalnum(static_cast<unsigned char>(m_input[m_position])) || string_view("+-.").find(m_input[m_position]) != string_view::npos))
+			++m_position;
+		return m_position > begin;
+	}
+
+	bool skipString()
+	{
+		for (++m_position; m_position < m_input.size(); ++m_position)
+			if (m_input[m_position] == '"')
+			{
+				++m_position;
+				return true;
+			}
+			else if (m_input[m_position] == '\\')
+				++m_position;
+		return false;
+	}
+
+	/// Decodes the string at the current position like jsoncpp.
+	bool decodeString(string& _decoded)
+	{
+		size_t const begin = m_position;
+		if (!skipString())
+			return false;
+		_decoded.reserve(m_position - begin - 2);
+		m_position = begin + 1;
+		while (true)
+		{
+			size_t special = m_position;
+			while (m_input[special] != '"' && m_input[special] != '\\')
+				++special;
+			_decoded.append(m_input, m_position, special - m_position);
+			m_position = special + 1;
+			if (m_input[special] == '"')
+				return true;
+			if (m_position == m_input.size())
+				return false;
+			switch (m_input[m_position++])
+			{
+			case '"': _decoded += '"'; break;
+			case '/': _decoded += '/'; break;
+			case '\\': _decoded += '\\'; break;
+			case 'b': _decoded += '\b'; break;
+			case 'f': _decoded += '\f'; break;
+			case 'n': _decoded += '\n'; break;
+			case 'r': _decoded += '\r'; break;
+			case 't': _decoded += '\t'; break;
+			case 'u':
+			{
+				unsigned codePoint = 0;
+				if (!hexDigits(codePoint))
+					return false;
+				if (codePoint >= 0xd800 && codePoint <= 0xdbff)
+				{
+					// jsoncpp combines the surrogate with the next escape sequence without checking it.
+					unsigned second = 0;
+					if (m_input.compare(m_position, 2, "\\u") != 0)
+						return false;
+					m_position += 2;
+					if (!hexDigits(second))
+						return false;
+					codePoint = 0x10000 + ((codePoint & 0x3ff) << 10) + (second & 0x3ff);
+				}
+				appendUTF8(_decoded, codePoint);
+				break;
+			}
+			default:
+				return false;
+			}
+		}
+	}
+
+	bool hexDigits(unsigned& _value)
+	{
+		if (m_position + 4 > m_input.size())
+			return false;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			char const c = m_input[m_position++];
+			unsigned digit = 0;
+			if (c >= '0' && c <= '9')
+				digit = unsigned(c - '0');
+			else if (c >= 'a' && c <= 'f')
+				digit = unsigned(c - 'a' + 10);
+			else if (c >= 'A' && c <= 'F')
+				digit = unsigned(c - 'A' + 10);
+			else
+				return false;
+			_value = _value * 16 + digit;
+		}
+		return true;
+	}
+
+	static void appendUTF8(string& _output, unsigned _codePoint)
+	{
+		if (_codePoint <= 0x7f)
+			_output += static_cast<char>(_codePoint);
+		else if (_codePoint <= 0x7ff)
+		{
+			_output += static_cast<char>(0xc0 | (_codePoint >> 6));
+			_output += static_cast<char>(0x80 | (_codePoint & 0x3f));
+		}
+		else if (_codePoint <= 0xffff)
+		{
+			_output += static_cast<char>(0xe0 | (_codePoint >> 12));
+			_output += static_cast<char>(0x80 | ((_codePoint >> 6) & 0x3f));
+			_output += static_cast<char>(0x80 | (_codePoint & 0x3f));
+		}
+		else
+		{
+			_output += static_cast<char>(0xf0 | (_codePoint >> 18));
+			_output += static_cast<char>(0x80 | ((_codePoint >> 12) & 0x3f));
+			_output += static_cast<char>(0x80 | ((_codePoint >> 6) & 0x3f));
+			_output += static_cast<char>(0x80 | (_codePoint & 0x3f));
+		}
+	}
+
+	void skipWhitespace()
+	{
+		while (m_position < m_input.size() && string_view(" \t\n\r").find(m_input[m_position]) != string_view::npos)
+			++m_position;
+	}
+
+	bool consume(char _character)
+	{
+		if (m_position == m_input.size() || m_input[m_position] != _character)
+			return false;
+		++m_position;
+		return true;
+	}
+
+	string const& m_input;
+	function<bool(vector<string> const&)> const& m_extract;
+	size_t m_position = 0;
+	vector<string> m_path;
+	/// The positions of the extracted strings including their quotes.
+	vector<pair<size_t, size_t>> m_ranges;
+	vector<pair<vector<string>, string>> m_extracted;
+};
+
 /// Takes a JSON value (@ _json) and removes all its members with value 'null' recursively.
 void removeNullMembersHelper(Json::Value& _json)
 {
@@ -140,10 +401,148 @@ string jsonPrint(Json::Value const& _input, JsonFormat const& _format)
 	return result;
 }
 
+namespace
+{
+/// Key of the only member of placeholders. It cannot occur in regular output.
+string const placeholderKey = "\x01";
+}
+
+Json::Value jsonPlaceholder(size_t _index)
+{
+	Json::Value placeholder(Json::objectValue);
+	placeholder[placeholderKey] = Json::UInt64(_index);
+	return placeholder;
+}
+
+Json::Value jsonStringPlaceholder(size_t _index)
+{
+	Json::Value placeholder(Json::objectValue);
+	placeholder[placeholderKey] = to_string(_index);
+	return placeholder;
+}
+
+void jsonStreamPrint(
+	ostream& _stream,
+	Json::Value const& _input,
+	JsonFormat const& _format,
+	function<void(ostream&, size_t, string const&)> const& _printPlaceholder,
+	string const& _indentation
+)
+{
+	static string const quotedKey = jsonCompactPrint(Json::Value(placeholderKey));
+	string const text = jsonPrint(_input, _format);
+
+	auto writeIndented = [&](size_t _begin, size_t _end) {
+		for (size_t lineEnd; (lineEnd = text.find('\n', _begin)) < _end; _begin = lineEnd + 1)
+			_stream.write(text.data() + _begin, static_cast<streamsize>(lineEnd + 1 - _begin)) << _indentation;
+		_stream.write(text.data() + _begin, static_cast<streamsize>(_end - _begin));
+	};
+	auto isSpace = [](char _c) { return _c == ' ' || _c == '\n'; };
+
+	size_t written = 0;
+	for (size_t keyBegin = text.find(quotedKey); keyBegin != string::npos; keyBegin = text.find(quotedKey, keyBegin + quotedKey.size()))
+	{
+		// Strings that contain the key are followed by something else than a colon.
+		size_t position = keyBegin + quotedKey.size();
+		if (position >= text.size() || text[position] != ':')
+			continue;
+		for (++position; position < text.size() && text[position] == ' '; ++position) {}
+		bool const isString = position < text.size() && text[position] == '"';
+		if (isString)
+			++position;
+		size_t index = 0;
+		for (; position < text.size() && text[position] >= '0' && text[position] <= '9'; ++position)
+			index = index * 10 + static_cast<size_t>(text[position] - '0');
+		if (isString)
+		{
+			assertThrow(position < text.size() && text[position] == '"', Exception, "Invalid JSON placeholder.");
+			++position;
+		}
+		for (; position < text.size() && isSpace(text[position]); ++position) {}
+		assertThrow(position < text.size() && text[position] == '}', Exception, "Invalid JSON placeholder.");
+		size_t const placeholderEnd = position + 1;
+
+		size_t placeholderBegin = keyBegin;
+		while (placeholderBegin > written && isSpace(text[placeholderBegin - 1]))
+			--placeholderBegin;
+		assertThrow(placeholderBegin > written && text[placeholderBegin - 1] == '{', Exception, "Invalid JSON placeholder.");
+		--placeholderBegin;
+		// Strings start on the line of their key, separated from the colon like scalar values.
+		if (isString)
+			while (placeholderBegin > written && isSpace(text[placeholderBegin - 1]))
+				--placeholderBegin;
+
+		// The closing brace of the placeholder is indented like the lines of its replacement.
+		size_t const lineBegin = text.rfind('\n', position);
+		string const indentation =
+			lineBegin != string::npos && lineBegin > placeholderBegin ?
+			_indentation + text.substr(lineBegin + 1, position - lineBegin - 1) :
+			_indentation;
+
+		writeIndented(written, placeholderBegin);
+		if (isString && _format.format == JsonFormat::Pretty)
+			_stream << ' ';
+		_printPlaceholder(_stream, index, indentation);
+		written = placeholderEnd;
+	}
+	writeIndented(written, text.size());
+}
+
+void jsonStreamPrintString(ostream& _stream, string_view _value)
+{
+	// The string is escaped in chunks that end with a line break. jsoncpp decodes multi-byte
+	// characters without checking the continuation bytes, so a line break can only end a chunk
+	// if none of the three bytes before it starts such a character.
+	size_t constexpr minChunkSize = 1 << 16;
+	auto endsCharacter = [&](size_t _lineBreak) {
+		for (size_t i = _lineBreak >= 3 ? _lineBreak - 3 : 0; i < _lineBreak; ++i)
+			if (static_cast<unsigned char>(_value[i]) >= 0x80)
+				return false;
+		return true;
+	};
+
+	_stream << '"';
+	while (!_value.empty())
+	{
+		size_t chunkEnd = _value.size();
+		if (_value.size() > minChunkSize)
+		{
+			size_t lineBreak = _value.find('\n', minChunkSize);
+			while (lineBreak != string_view::npos && !endsCharacter(lineBreak))
+				lineBreak = _value.find('\n', lineBreak + 1);
+			if (lineBreak != string_view::npos)
+				chunkEnd = lineBreak + 1;
+		}
+		string const quoted = jsonCompactPrint(Json::Value(string(_value.substr(0, chunkEnd))));
+		_stream.write(quoted.data() + 1, static_cast<streamsize>(quoted.size() - 2));
+		_value.remove_prefix(chunkEnd);
+	}
+	_stream << '"';
+}
+
 bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
 {
 	static StrictModeCharReaderBuilder readerBuilder;
 	return parse(readerBuilder, _input, _json, _errs);
 }
 
+bool jsonParseStrictExtractingStrings(
+	string const& _input,
+	Json::Value& _json,
+	function<bool(vector<string> const&)> const& _extract,
+	vector<pair<vector<string>, string>>& _extracted,
+	string* _errs /* = nullptr */
+)
+{
+	_extracted.clear();
+	StringExtractor extractor(_input, _extract);
+	if (extractor.run() && jsonParseStrict(extractor.skeleton(), _json))
+	{
+		_extracted = move(extractor.extracted());
+		return true;
+	}
+	// The positions in jsoncpp's error messages have to refer to the original input.
+	return jsonParseStrict(_input, _json, _errs);
+}
+
 } // namespace solidity::util
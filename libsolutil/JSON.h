@@ -25,7 +25,12 @@
 
 #include <json/json.h>
 
+#include <functional>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace solidity::util
 {
@@ -60,6 +65,33 @@ std::string jsonCompactPrint(Json::Value const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json::Value const& _input, JsonFormat const& _format);
 
+/// @returns a JSON object that stands for a non-empty JSON object that is only provided when
+/// printing using jsonStreamPrint. @a _index identifies the placeholder.
+Json::Value jsonPlaceholder(size_t _index);
+
+/// @returns a JSON object that stands for a string that is only provided when printing using
+/// jsonStreamPrint. @a _index identifies the placeholder. It can only be used as the value of
+/// an object member.
+Json::Value jsonStringPlaceholder(size_t _index);
+
+/// Writes the JSON object (@a _input) to @a _stream in the same way as jsonPrint would do it.
+/// Every placeholder created by jsonPlaceholder or jsonStringPlaceholder is printed by calling
+/// @a _printPlaceholder with its index and the indentation that the placeholder has to add to
+/// each of its lines.
+/// @a _indentation is added to every line of @a _input but the first one.
+/// This allows printing large documents without building them in memory.
+void jsonStreamPrint(
+	std::ostream& _stream,
+	Json::Value const& _input,
+	JsonFormat const& _format,
+	std::function<void(std::ostream&, size_t, std::string const&)> const& _printPlaceholder,
+	std::string const& _indentation = ""
+);
+
+/// Writes @a _value to @a _stream as a JSON string in the same way as jsonPrint would do it,
+/// without building the escaped string in memory at once.
+void jsonStreamPrintString(std::ostream& _stream, std::string_view _value);
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
@@ -67,4 +99,18 @@ std::string jsonPrint(Json::Value const& _input, JsonFormat const& _format);
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParseStrict(std::string const& _input, Json::Value& _json, std::string* _errs = nullptr);
 
+/// Parse a JSON string (@a _input) like jsonParseStrict, but without storing some of its string values
+/// in the resulting JSON object (@a _json). These are the strings that are values of object members
+/// for whose path, the names of the members from the root to the string, @a _extract returns true.
+/// They are decoded directly from the input into @a _extracted, together with their paths, and
+/// replaced by empty strings in @a _json. This is cheaper than building them in the JSON object.
+/// If the input is invalid, the result and the error messages are the ones of jsonParseStrict.
+bool jsonParseStrictExtractingStrings(
+	std::string const& _input,
+	Json::Value& _json,
+	std::function<bool(std::vector<std::string> const&)> const& _extract,
+	std::vector<std::pair<std::vector<std::string>, std::string>>& _extracted,
+	std::string* _errs = nullptr
+);
+
 }
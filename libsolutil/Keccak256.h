@@ -27,6 +27,7 @@
 #include <libsolutil/FixedHash.h>
 
 #include <string>
+#include <vector>
 
 namespace solidity::util
 {
@@ -43,4 +44,8 @@ inline h256 keccak256(std::string const& _input) { return keccak256(bytesConstRe
 /// Calculate Keccak-256 hash of the given input (presented as a FixedHash), returns a 256-bit hash.
 template<unsigned N> inline h256 keccak256(FixedHash<N> const& _input) { return keccak256(_input.ref()); }
 
+/// Calculate the Keccak-256 hashes of all of the given inputs, in the same order.
+/// Inputs of similar length are hashed in parallel using SIMD instructions where available.
+std::vector<h256> keccak256Many(std::vector<bytesConstRef> const& _inputs);
+
 }
@@ -35,6 +35,15 @@ inline bytes lebEncode(uint64_t _n)
 	return encoded;
 }
 
+/// @returns the number of bytes of the unsigned encoding of @a _n, without encoding it.
+inline size_t lebEncodedSize(uint64_t _n)
+{
+	size_t size = 1;
+	for (; _n > 0x7f; _n >>= 7)
+		++size;
+	return size;
+}
+
 // signed right shift is an arithmetic right shift
 static_assert((-1 >> 1) == -1, "Arithmetic shift not supported.");
 
@@ -21,7 +21,9 @@
 #include <libsolutil/Assertions.h>
 #include <libsolutil/Exceptions.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -79,6 +81,12 @@ public:
 		return m_value.value();
 	}
 
+	/// Discards the stored value, so that the next call to init() computes it again.
+	void reset() { m_value.reset(); }
+
+	/// @returns a pointer to the stored value or nullptr if it has not been initialized yet.
+	value_type const* get() const { return m_value ? &m_value.value() : nullptr; }
+
 private:
 	/// Although not quite logically const, this is marked const for pragmatic reasons. It doesn't change the platonic
 	/// value of the object (which is something that is initialized to some computed value on first use).
@@ -92,4 +100,69 @@ private:
 	mutable std::optional<value_type> m_value;
 };
 
+/**
+ * A LazyInit that can be initialized and accessed from multiple threads at the same time. The function
+ * that initializes the stored value is called only once, and once the value is initialized, accessing
+ * it only requires an atomic load.
+ *
+ * @tparam T the type of the stored value; may not be a function, reference, array, or void type; may be const-qualified.
+ */
+template<typename T>
+class ConcurrentLazyInit
+{
+public:
+	using value_type = T;
+
+	static_assert(std::is_object_v<value_type>, "Function, reference, and void types are not supported");
+	static_assert(!std::is_array_v<value_type>, "Array types are not supported.");
+	static_assert(!std::is_volatile_v<value_type>, "Volatile-qualified types are not supported.");
+
+	ConcurrentLazyInit() = default;
+
+	ConcurrentLazyInit(ConcurrentLazyInit const&) = delete;
+	ConcurrentLazyInit& operator=(ConcurrentLazyInit const&) = delete;
+
+	template<typename F>
+	value_type& init(F&& _fun)
+	{
+		return *doInit(std::forward<F>(_fun));
+	}
+
+	template<typename F>
+	value_type const& init(F&& _fun) const
+	{
+		return *doInit(std::forward<F>(_fun));
+	}
+
+	/// Discards the stored value, so that the next call to init() computes it again.
+	/// Must not be called while other threads call init() or still use the value.
+	void reset()
+	{
+		std::lock_guard lock(m_mutex);
+		m_pointer.store(nullptr, std::memory_order_relaxed);
+		m_value.reset();
+	}
+
+private:
+	template<typename F>
+	value_type* doInit(F&& _fun) const
+	{
+		if (value_type* value = m_pointer.load(std::memory_order_acquire))
+			return value;
+
+		std::lock_guard lock(m_mutex);
+		if (!m_value.has_value())
+		{
+			m_value.emplace(std::forward<F>(_fun)());
+			m_pointer.store(&m_value.value(), std::memory_order_release);
+		}
+		return &m_value.value();
+	}
+
+	mutable std::mutex m_mutex;
+	mutable std::optional<value_type> m_value;
+	/// Points to the value once it is initialized.
+	mutable std::atomic<value_type*> m_pointer = nullptr;
+};
+
 }
@@ -0,0 +1,105 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/MemoryMappedFile.h>
+
+#include <libsolutil/Assertions.h>
+#include <libsolutil/Exceptions.h>
+
+#include <limits>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+shared_ptr<MemoryMappedFile const> MemoryMappedFile::map(boost::filesystem::path const& _path)
+{
+	assertThrow(boost::filesystem::exists(_path), FileNotFound, _path.string());
+	assertThrow(boost::filesystem::is_regular_file(_path), NotAFile, _path.string());
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileW(
+		_path.wstring().c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		nullptr
+	);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 || static_cast<unsigned long long>(size.QuadPart) > numeric_limits<size_t>::max())
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+		return nullptr;
+	// The view keeps the mapping alive.
+	void const* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!data)
+		return nullptr;
+	return shared_ptr<MemoryMappedFile const>(new MemoryMappedFile(static_cast<char const*>(data), static_cast<size_t>(size.QuadPart)));
+#elif !defined(__EMSCRIPTEN__)
+	int file = open(_path.string().c_str(), O_RDONLY);
+	if (file < 0)
+		return nullptr;
+
+	struct stat status;
+	if (fstat(file, &status) != 0 || status.st_size <= 0 || static_cast<unsigned long long>(status.st_size) > numeric_limits<size_t>::max())
+	{
+		close(file);
+		return nullptr;
+	}
+
+	size_t const size = static_cast<size_t>(status.st_size);
+	void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+	// The mapping stays valid after closing the file.
+	close(file);
+	if (data == MAP_FAILED)
+		return nullptr;
+	return shared_ptr<MemoryMappedFile const>(new MemoryMappedFile(static_cast<char const*>(data), size));
+#else
+	return nullptr;
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#if defined(_WIN32)
+	UnmapViewOfFile(m_data);
+#elif !defined(__EMSCRIPTEN__)
+	munmap(const_cast<char*>(m_data), m_size);
+#endif
+}
@@ -0,0 +1,59 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Read-only memory mapping of files.
+ */
+
+#pragma once
+
+#include <boost/filesystem.hpp>
+
+#include <memory>
+#include <string_view>
+
+namespace solidity::util
+{
+
+/**
+ * The contents of a file, mapped read-only into memory. The pages are loaded on demand and
+ * are shared with the page cache of the operating system instead of being copied.
+ * The file must not be modified while it is mapped.
+ */
+class MemoryMappedFile
+{
+public:
+	/// Maps the file at @a _path into memory.
+	/// @returns nullptr if the file cannot be mapped, e.g. because it is empty or because the
+	/// platform does not support memory mapping. The file should be read normally in that case.
+	/// @throws FileNotFound if the file does not exist. And NotAFile if it is not a regular file.
+	static std::shared_ptr<MemoryMappedFile const> map(boost::filesystem::path const& _path);
+
+	MemoryMappedFile(MemoryMappedFile const&) = delete;
+	MemoryMappedFile& operator=(MemoryMappedFile const&) = delete;
+	~MemoryMappedFile();
+
+	std::string_view contents() const { return {m_data, m_size}; }
+
+private:
+	MemoryMappedFile(char const* _data, size_t _size): m_data(_data), m_size(_size) {}
+
+	char const* m_data;
+	size_t m_size;
+};
+
+}
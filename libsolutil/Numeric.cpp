@@ -20,6 +20,7 @@
 
 #include <liblangutil/Exceptions.h>
 
+using namespace std;
 using namespace solidity;
 
 bool solidity::fitsPrecisionBaseX(bigint const& _mantissa, double _log2OfBase, uint32_t _exp)
@@ -38,3 +39,47 @@ bool solidity::fitsPrecisionBaseX(bigint const& _mantissa, double _log2OfBase, u
 	bigint bitsNeeded = mostSignificantMantissaBit + bigint(floor(double(_exp) * _log2OfBase)) + 1;
 	return bitsNeeded <= bitsMax;
 }
+
+optional<bigint> solidity::parseNumber(string_view _digits, unsigned _base)
+{
+	solAssert(_base == 10 || _base == 16, "");
+	// Number of digits that always fit into 64 bits.
+	size_t const digitsPerChunk = _base == 16 ? 16 : 19;
+	uint64_t const wordBase = _base;
+
+	bigint value;
+	// The first chunk is shorter, so that the remaining ones are complete.
+	size_t chunkSize = _digits.size() % digitsPerChunk;
+	if (chunkSize == 0)
+		chunkSize = digitsPerChunk;
+	for (size_t position = 0; position < _digits.size(); position += chunkSize, chunkSize = digitsPerChunk)
+	{
+		uint64_t chunk = 0;
+		uint64_t chunkFactor = 1;
+		for (char c: _digits.substr(position, chunkSize))
+		{
+			uint64_t digit;
+			if (c >= '0' && c <= '9')
+				digit = uint64_t(c - '0');
+			else if (_base == 16 && c >= 'a' && c <= 'f')
+				digit = uint64_t(c - 'a' + 10);
+			else if (_base == 16 && c >= 'A' && c <= 'F')
+				digit = uint64_t(c - 'A' + 10);
+			else
+				return nullopt;
+			chunk = chunk * wordBase + digit;
+			chunkFactor *= wordBase;
+		}
+		if (position == 0)
+			value = chunk;
+		else
+		{
+			if (_base == 16)
+				value <<= 64;
+			else
+				value *= chunkFactor;
+			value += chunk;
+		}
+	}
+	return value;
+}
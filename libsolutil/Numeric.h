@@ -32,6 +32,8 @@
 #include <boost/multiprecision/cpp_int.hpp>
 
 #include <limits>
+#include <optional>
+#include <string_view>
 
 namespace solidity
 {
@@ -79,6 +81,13 @@ inline u256 exp256(u256 _base, u256 _exponent)
 /// where X is given indirectly via _log2OfBase = log2(X).
 bool fitsPrecisionBaseX(bigint const& _mantissa, double _log2OfBase, uint32_t _exp);
 
+/// Converts the digits @a _digits in base @a _base, which has to be 10 or 16, to a number.
+/// Collects as many digits as fit into 64 bits before updating the number, which makes it
+/// cheaper than the string conversion of bigint, especially for short numbers.
+/// An empty string is converted to zero.
+/// @returns nullopt if @a _digits contains a character that is not a digit in @a _base.
+std::optional<bigint> parseNumber(std::string_view _digits, unsigned _base);
+
 
 // Big-endian to/from host endian conversion functions.
 
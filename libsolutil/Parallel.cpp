@@ -0,0 +1,67 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+void solidity::util::parallelFor(size_t _count, size_t _maxThreads, function<void(size_t)> const& _job)
+{
+	vector<exception_ptr> exceptions(_count);
+	atomic<size_t> nextIndex{0};
+	auto worker = [&]()
+	{
+		for (size_t index = nextIndex++; index < _count; index = nextIndex++)
+			try
+			{
+				_job(index);
+			}
+			catch (...)
+			{
+				exceptions[index] = current_exception();
+			}
+	};
+
+	vector<thread> threads;
+	size_t const numThreads = min(_count, max<size_t>(_maxThreads, 1));
+	for (size_t i = 1; i < numThreads; ++i)
+		try
+		{
+			threads.emplace_back(worker);
+		}
+		catch (system_error const&)
+		{
+			// Could not start another thread, continue with the ones we have.
+			break;
+		}
+
+	worker();
+	for (thread& t: threads)
+		t.join();
+
+	for (exception_ptr const& exception: exceptions)
+		if (exception)
+			rethrow_exception(exception);
+}
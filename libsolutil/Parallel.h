@@ -0,0 +1,43 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helpers for running independent jobs on multiple threads.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace solidity::util
+{
+
+/// Calls @a _job once for every index in the range [0, @a _count), using at most @a _maxThreads
+/// threads (including the calling thread). Indices are handed out in increasing order, but jobs
+/// may finish in any order, so @a _job must only touch state that is private to its index or
+/// otherwise synchronised.
+///
+/// An exception thrown by a job does not stop the remaining jobs. Once all jobs are done, the
+/// exception of the job with the smallest index is rethrown, which makes error reporting
+/// independent of the scheduling.
+///
+/// If no additional threads can be started (e.g. on platforms without thread support),
+/// all jobs are run on the calling thread.
+void parallelFor(size_t _count, size_t _maxThreads, std::function<void(size_t)> const& _job);
+
+}
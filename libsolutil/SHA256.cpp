@@ -0,0 +1,193 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/** @file SHA256.cpp
+ */
+
+#include <libsolutil/SHA256.h>
+
+#include <libsolutil/picosha2.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SOLIDITY_SHA256_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+void compressPortable(uint32_t* _state, uint8_t const* _blocks, size_t _count)
+{
+	picosha2::word_t state[8];
+	copy(_state, _state + 8, state);
+	for (size_t i = 0; i < _count; ++i)
+		picosha2::detail::hash256_block(state, _blocks + 64 * i, _blocks + 64 * (i + 1));
+	for (size_t i = 0; i < 8; ++i)
+		_state[i] = static_cast<uint32_t>(state[i]);
+}
+
+#ifdef SOLIDITY_SHA256_X86
+
+alignas(16) uint32_t const roundConstants[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+__attribute__((target("sha,sse4.1"))) void compressSHAExtensions(uint32_t* _state, uint8_t const* _blocks, size_t _count)
+{
+	__m128i const byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+
+	// The instructions expect the state as the words ABEF and CDGH.
+	__m128i dcba = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_state));
+	__m128i hgfe = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_state + 4));
+	__m128i const cdab = _mm_shuffle_epi32(dcba, 0xb1);
+	hgfe = _mm_shuffle_epi32(hgfe, 0x1b);
+	__m128i abef = _mm_alignr_epi8(cdab, hgfe, 8);
+	__m128i cdgh = _mm_blend_epi16(hgfe, cdab, 0xf0);
+
+	for (size_t block = 0; block < _count; ++block)
+	{
+		uint8_t const* data = _blocks + 64 * block;
+		__m128i const abefBefore = abef;
+		__m128i const cdghBefore = cdgh;
+		// The last four groups of four words of the message schedule.
+		__m128i words[4];
+		for (size_t group = 0; group < 16; ++group)
+		{
+			__m128i& current = words[group % 4];
+			if (group < 4)
+				current = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + 16 * group)), byteSwap);
+			else
+			{
+				__m128i const previous = words[(group + 3) % 4];
+				__m128i schedule = _mm_sha256msg1_epu32(current, words[(group + 1) % 4]);
+				schedule = _mm_add_epi32(schedule, _mm_alignr_epi8(previous, words[(group + 2) % 4], 4));
+				current = _mm_sha256msg2_epu32(schedule, previous);
+			}
+			__m128i message = _mm_add_epi32(
+				current,
+				_mm_load_si128(reinterpret_cast<__m128i const*>(roundConstants + 4 * group))
+			);
+			cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+			message = _mm_shuffle_epi32(message, 0x0e);
+			// Each double round turns ABEF into CDGH, so the variables hold ABEF and CDGH again after two.
+			abef = _mm_sha256rnds2_epu32(abef, cdgh, message);
+		}
+		abef = _mm_add_epi32(abef, abefBefore);
+		cdgh = _mm_add_epi32(cdgh, cdghBefore);
+	}
+
+	__m128i const feba = _mm_shuffle_epi32(abef, 0x1b);
+	__m128i const dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(_state), _mm_blend_epi16(feba, dchg, 0xf0));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(_state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+bool hasSHAExtensions()
+{
+	unsigned eax = 0;
+	unsigned ebx = 0;
+	unsigned ecx = 0;
+	unsigned edx = 0;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSE4_1) || !(ecx & bit_SSSE3))
+		return false;
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+		return false;
+	return (ebx & bit_SHA) != 0;
+}
+
+#endif
+
+}
+
+void solidity::util::SHA256::update(bytesConstRef _data)
+{
+	m_length += _data.size();
+	uint8_t const* data = _data.data();
+	size_t size = _data.size();
+	if (m_bufferSize > 0)
+	{
+		size_t const taken = min(size, m_buffer.size() - m_bufferSize);
+		if (taken > 0)
+			memcpy(m_buffer.data() + m_bufferSize, data, taken);
+		m_bufferSize += taken;
+		data += taken;
+		size -= taken;
+		if (m_bufferSize < m_buffer.size())
+			return;
+		compress(m_buffer.data(), 1);
+		m_bufferSize = 0;
+	}
+	compress(data, size / 64);
+	m_bufferSize = size % 64;
+	if (m_bufferSize > 0)
+		memcpy(m_buffer.data(), data + size - m_bufferSize, m_bufferSize);
+}
+
+h256 solidity::util::SHA256::digest()
+{
+	uint64_t const bitLength = m_length * 8;
+	m_buffer[m_bufferSize++] = 0x80;
+	if (m_bufferSize > 56)
+	{
+		fill(m_buffer.begin() + static_cast<ptrdiff_t>(m_bufferSize), m_buffer.end(), 0);
+		compress(m_buffer.data(), 1);
+		m_bufferSize = 0;
+	}
+	fill(m_buffer.begin() + static_cast<ptrdiff_t>(m_bufferSize), m_buffer.begin() + 56, 0);
+	for (size_t i = 0; i < 8; ++i)
+		m_buffer[56 + i] = static_cast<uint8_t>(bitLength >> (56 - 8 * i));
+	compress(m_buffer.data(), 1);
+
+	h256 result;
+	for (size_t i = 0; i < 32; ++i)
+		result.data()[i] = static_cast<uint8_t>(m_state[i / 4] >> (24 - 8 * (i % 4)));
+	return result;
+}
+
+void solidity::util::SHA256::compress(uint8_t const* _blocks, size_t _count)
+{
+	if (_count == 0)
+		return;
+#ifdef SOLIDITY_SHA256_X86
+	static bool const useSHAExtensions = hasSHAExtensions();
+	if (useSHAExtensions)
+		return compressSHAExtensions(m_state.data(), _blocks, _count);
+#endif
+	compressPortable(m_state.data(), _blocks, _count);
+}
+
+h256 solidity::util::sha256(bytesConstRef _input)
+{
+	SHA256 hasher;
+	hasher.update(_input);
+	return hasher.digest();
+}
@@ -0,0 +1,55 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/** @file SHA256.h
+ * SHA-256 that uses the SHA extensions of the CPU if they are available.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <array>
+#include <cstdint>
+
+namespace solidity::util
+{
+
+/// Incremental SHA-256. The data can be passed in any number of parts, which are not copied
+/// apart from the last incomplete block.
+class SHA256
+{
+public:
+	void update(bytesConstRef _data);
+	/// @returns the hash of all data passed so far. No data may be passed afterwards.
+	h256 digest();
+
+private:
+	void compress(uint8_t const* _blocks, size_t _count);
+
+	std::array<uint32_t, 8> m_state = {
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+	};
+	std::array<uint8_t, 64> m_buffer = {};
+	size_t m_bufferSize = 0;
+	uint64_t m_length = 0;
+};
+
+/// Calculate the SHA-256 hash of the given input.
+h256 sha256(bytesConstRef _input);
+
+}
@@ -0,0 +1,241 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/** @file SmallVector.h
+ * Vector that stores up to a fixed number of elements without allocating.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace solidity::util
+{
+
+/**
+ * Sequence container with the interface of a subset of std::vector that stores up to @a N elements
+ * inside the object itself and only allocates memory for more elements. Iterators, pointers and
+ * references are invalidated by every modification that changes the size or moves the elements,
+ * including moving the container while the elements are stored inline.
+ */
+template<typename T, size_t N>
+class SmallVector
+{
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = T const&;
+	using iterator = T*;
+	using const_iterator = T const*;
+
+	SmallVector() = default;
+	SmallVector(std::initializer_list<T> _values): SmallVector(_values.begin(), _values.end()) {}
+	template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+	SmallVector(Iterator _begin, Iterator _end)
+	{
+		for (; _begin != _end; ++_begin)
+			emplace_back(*_begin);
+	}
+	SmallVector(SmallVector const& _other)
+	{
+		reserve(_other.size());
+		std::uninitialized_copy(_other.begin(), _other.end(), m_data);
+		m_size = _other.m_size;
+	}
+	SmallVector(SmallVector&& _other) noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		takeFrom(std::move(_other));
+	}
+	~SmallVector()
+	{
+		clear();
+		deallocate();
+	}
+
+	SmallVector& operator=(SmallVector const& _other)
+	{
+		if (this != &_other)
+		{
+			clear();
+			reserve(_other.size());
+			std::uninitialized_copy(_other.begin(), _other.end(), m_data);
+			m_size = _other.m_size;
+		}
+		return *this;
+	}
+	SmallVector& operator=(SmallVector&& _other) noexcept(std::is_nothrow_move_constructible_v<T>)
+	{
+		if (this != &_other)
+		{
+			clear();
+			deallocate();
+			takeFrom(std::move(_other));
+		}
+		return *this;
+	}
+
+	iterator begin() { return m_data; }
+	iterator end() { return m_data + m_size; }
+	const_iterator begin() const { return m_data; }
+	const_iterator end() const { return m_data + m_size; }
+	T* data() { return m_data; }
+	T const* data() const { return m_data; }
+
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	size_t capacity() const { return m_capacity; }
+	/// @returns true if the elements are stored inside the object.
+	bool isInline() const { return m_data == inlineData(); }
+
+	T& operator[](size_t _index) { return m_data[_index]; }
+	T const& operator[](size_t _index) const { return m_data[_index]; }
+	T& front() { return m_data[0]; }
+	T const& front() const { return m_data[0]; }
+	T& back() { return m_data[m_size - 1]; }
+	T const& back() const { return m_data[m_size - 1]; }
+
+	void reserve(size_t _capacity)
+	{
+		if (_capacity > m_capacity)
+			reallocate(_capacity);
+	}
+
+	template<typename... Args>
+	T& emplace_back(Args&&... _args)
+	{
+		if (m_size == m_capacity)
+		{
+			// The arguments might refer to elements, which are moved by the reallocation.
+			T value(std::forward<Args>(_args)...);
+			reallocate(std::max<size_t>(2 * m_capacity, 4));
+			new (m_data + m_size) T(std::move(value));
+		}
+		else
+			new (m_data + m_size) T(std::forward<Args>(_args)...);
+		return m_data[m_size++];
+	}
+	void push_back(T const& _value) { emplace_back(_value); }
+	void push_back(T&& _value) { emplace_back(std::move(_value)); }
+	void pop_back()
+	{
+		--m_size;
+		m_data[m_size].~T();
+	}
+
+	/// Inserts @a _value before @a _position. @returns an iterator to the inserted element.
+	iterator insert(const_iterator _position, T _value)
+	{
+		size_t const index = static_cast<size_t>(_position - begin());
+		if (index == m_size)
+			emplace_back(std::move(_value));
+		else
+		{
+			emplace_back(std::move(back()));
+			std::move_backward(begin() + index, end() - 2, end() - 1);
+			m_data[index] = std::move(_value);
+		}
+		return begin() + index;
+	}
+
+	iterator erase(const_iterator _position) { return erase(_position, _position + 1); }
+	iterator erase(const_iterator _first, const_iterator _last)
+	{
+		iterator first = begin() + (_first - begin());
+		iterator last = begin() + (_last - begin());
+		// Moving an element onto itself can leave it in the moved-from state.
+		if (first == last)
+			return first;
+		iterator newEnd = std::move(last, end(), first);
+		std::destroy(newEnd, end());
+		m_size -= static_cast<size_t>(last - first);
+		return first;
+	}
+
+	void clear()
+	{
+		std::destroy(begin(), end());
+		m_size = 0;
+	}
+
+	bool operator==(SmallVector const& _other) const
+	{
+		return std::equal(begin(), end(), _other.begin(), _other.end());
+	}
+	bool operator!=(SmallVector const& _other) const { return !(*this == _other); }
+	bool operator<(SmallVector const& _other) const
+	{
+		return std::lexicographical_compare(begin(), end(), _other.begin(), _other.end());
+	}
+
+private:
+	T* inlineData() { return reinterpret_cast<T*>(m_storage); }
+	T const* inlineData() const { return reinterpret_cast<T const*>(m_storage); }
+
+	void reallocate(size_t _capacity)
+	{
+		T* data = std::allocator<T>().allocate(_capacity);
+		std::uninitialized_move(begin(), end(), data);
+		std::destroy(begin(), end());
+		deallocate();
+		m_data = data;
+		m_capacity = _capacity;
+	}
+
+	/// Frees the allocated memory, which has to contain no elements anymore.
+	void deallocate()
+	{
+		if (!isInline())
+			std::allocator<T>().deallocate(m_data, m_capacity);
+		m_data = inlineData();
+		m_capacity = N;
+	}
+
+	/// Takes the elements of @a _other, which is left empty. Requires this to be empty and inline.
+	void takeFrom(SmallVector&& _other)
+	{
+		if (_other.isInline())
+		{
+			std::uninitialized_move(_other.begin(), _other.end(), m_data);
+			m_size = _other.m_size;
+			_other.clear();
+		}
+		else
+		{
+			m_data = _other.m_data;
+			m_size = _other.m_size;
+			m_capacity = _other.m_capacity;
+			_other.m_data = _other.inlineData();
+			_other.m_size = 0;
+			_other.m_capacity = N;
+		}
+	}
+
+	T* m_data = inlineData();
+	size_t m_size = 0;
+	size_t m_capacity = N;
+	alignas(T) unsigned char m_storage[N == 0 ? 1 : N * sizeof(T)];
+};
+
+}
@@ -39,7 +39,7 @@ bool solidity::util::stringWithinDistance(string const& _str1, string const& _st
 	if (_lenThreshold > 0 && n1 * n2 > _lenThreshold)
 		return false;
 
-	size_t distance = stringDistance(_str1, _str2);
+	size_t distance = boundedStringDistance(_str1, _str2, _maxDistance);
 
 	// if distance is not greater than _maxDistance, and distance is strictly less than length of both names, they can be considered similar
 	// this is to avoid irrelevant suggestions
@@ -86,6 +86,59 @@ size_t solidity::util::stringDistance(string const& _str1, string const& _str2)
 	return dp[(n1 % 3) + n2 * 3];
 }
 
+size_t solidity::util::boundedStringDistance(string const& _str1, string const& _str2, size_t _maxDistance)
+{
+	size_t const n1 = _str1.size();
+	size_t const n2 = _str2.size();
+	size_t const tooLarge = _maxDistance + 1;
+	// The distance is at least the difference of the lengths.
+	if ((n1 > n2 ? n1 - n2 : n2 - n1) > _maxDistance)
+		return tooLarge;
+
+	// The same formulation as in stringDistance, but all entries are capped at tooLarge, which every entry
+	// outside of the band |i1 - i2| <= _maxDistance is. The entries just outside of the band that are read
+	// are set to tooLarge explicitly, since the rows share their storage.
+	vector<size_t> dp(3 * (n2 + 1), tooLarge);
+	size_t previousRowMinimum = tooLarge;
+	for (size_t i1 = 0; i1 <= n1; ++i1)
+	{
+		size_t const first = i1 > _maxDistance ? i1 - _maxDistance : 0;
+		size_t const last = min(n2, i1 + _maxDistance);
+		if (first > 0)
+			dp[(i1 % 3) + (first - 1) * 3] = tooLarge;
+		if (last < n2)
+			dp[(i1 % 3) + (last + 1) * 3] = tooLarge;
+
+		size_t rowMinimum = tooLarge;
+		for (size_t i2 = first; i2 <= last; ++i2)
+		{
+			size_t x = 0;
+			if (min(i1, i2) == 0)
+				x = max(i1, i2);
+			else
+			{
+				size_t left = dp[(i1 - 1) % 3 + i2 * 3];
+				size_t up = dp[(i1 % 3) + (i2 - 1) * 3];
+				size_t upleft = dp[((i1 - 1) % 3) + (i2 - 1) * 3];
+				x = min(left + 1, up + 1);
+				x = min(x, _str1[i1 - 1] == _str2[i2 - 1] ? upleft : upleft + 1);
+				if (i1 > 1 && i2 > 1 && _str1[i1 - 1] == _str2[i2 - 2] && _str1[i1 - 2] == _str2[i2 - 1])
+					x = min(x, dp[((i1 - 2) % 3) + (i2 - 2) * 3] + 1);
+			}
+			x = min(x, tooLarge);
+			dp[(i1 % 3) + i2 * 3] = x;
+			rowMinimum = min(rowMinimum, x);
+		}
+
+		// Every entry is computed from the two rows before it, so no later entry can be small enough.
+		if (rowMinimum == tooLarge && previousRowMinimum == tooLarge)
+			return tooLarge;
+		previousRowMinimum = rowMinimum;
+	}
+
+	return dp[(n1 % 3) + n2 * 3];
+}
+
 string solidity::util::quotedAlternativesList(vector<string> const& suggestions)
 {
 	vector<string> quotedSuggestions;
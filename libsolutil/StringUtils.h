@@ -39,6 +39,10 @@ namespace solidity::util
 bool stringWithinDistance(std::string const& _str1, std::string const& _str2, size_t _maxDistance, size_t _lenThreshold = 0);
 // Calculates the Damerau–Levenshtein distance between _str1 and _str2
 size_t stringDistance(std::string const& _str1, std::string const& _str2);
+// Calculates the Damerau–Levenshtein distance between _str1 and _str2 if it is not greater than _maxDistance
+// and returns _maxDistance + 1 otherwise. Only the diagonal band of width 2 * _maxDistance + 1 is computed
+// and the computation stops as soon as two consecutive rows exceed _maxDistance.
+size_t boundedStringDistance(std::string const& _str1, std::string const& _str2, size_t _maxDistance);
 // Return a string having elements of suggestions as quoted, alternative suggestions. e.g. "a", "b" or "c"
 std::string quotedAlternativesList(std::vector<std::string> const& suggestions);
 
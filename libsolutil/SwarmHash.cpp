@@ -68,6 +68,28 @@ h256 bmtHash(bytesConstRef _data)
 	if (_data.size() <= 64)
 		return keccak256(_data);
 
+	// If the data consists of a power of two segments of 64 bytes, the tree is complete
+	// and the nodes of each level can be hashed together.
+	if (_data.size() % 64 == 0 && ((_data.size() / 64) & (_data.size() / 64 - 1)) == 0)
+	{
+		vector<bytesConstRef> nodes;
+		for (size_t i = 0; i < _data.size(); i += 64)
+			nodes.emplace_back(_data.cropped(i, 64));
+		bytes level;
+		while (true)
+		{
+			vector<h256> hashes = keccak256Many(nodes);
+			if (hashes.size() == 1)
+				return hashes.front();
+			level.clear();
+			for (h256 const& hash: hashes)
+				level += hash.asBytes();
+			nodes.clear();
+			for (size_t i = 0; i < level.size(); i += 64)
+				nodes.emplace_back(bytesConstRef(&level).cropped(i, 64));
+		}
+	}
+
 	size_t midPoint = _data.size() / 2;
 	return keccak256(
 		bmtHash(_data.cropped(0, midPoint)).asBytes() +
@@ -110,9 +132,9 @@ h256 solidity::util::bzzr0Hash(string const& _input)
 }
 
 
-h256 solidity::util::bzzr1Hash(bytes const& _input)
+h256 solidity::util::bzzr1Hash(bytesConstRef _input)
 {
 	if (_input.empty())
 		return h256{};
-	return chunkHash(&_input);
+	return chunkHash(_input);
 }
@@ -0,0 +1,194 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Timing.h>
+
+#include <libsolutil/JSON.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace solidity::util;
+
+namespace
+{
+
+struct TraceEvent
+{
+	string name;
+	char const* category;
+	size_t threadIndex;
+	TraceRecorder::Clock::time_point start;
+	TraceRecorder::Clock::time_point end;
+};
+
+struct TraceEvents
+{
+	mutex eventsMutex;
+	TraceRecorder::Clock::time_point origin;
+	vector<TraceEvent> events;
+	/// Small numbers for the threads in the order they first recorded a span, since the trace
+	/// viewers expect integer thread ids.
+	map<thread::id, size_t> threadIndices;
+};
+
+TraceEvents& traceEvents()
+{
+	static TraceEvents events;
+	return events;
+}
+
+/// @returns the microseconds between @a _origin and @a _time, which the trace event format uses.
+double traceMicroseconds(TraceRecorder::Clock::time_point _origin, TraceRecorder::Clock::time_point _time)
+{
+	return chrono::duration<double, micro>(_time - _origin).count();
+}
+
+}
+
+atomic<bool> TraceRecorder::s_enabled{false};
+
+void TimingCollector::record(string const& _phase, Clock::duration _wallTime, size_t _peakMemory)
+{
+	lock_guard lock(m_mutex);
+	Entry& entry = m_entries[_phase];
+	entry.wallTime += _wallTime;
+	++entry.count;
+	entry.peakMemory = max(entry.peakMemory, _peakMemory);
+}
+
+void TimingCollector::recordChange(string const& _phase, bool _changed, int64_t _sizeDelta)
+{
+	lock_guard lock(m_mutex);
+	Entry& entry = m_entries[_phase];
+	if (_changed)
+		++entry.changes;
+	entry.sizeDelta += _sizeDelta;
+}
+
+map<string, TimingCollector::Entry> TimingCollector::entries() const
+{
+	lock_guard lock(m_mutex);
+	return m_entries;
+}
+
+void TraceRecorder::enable()
+{
+	TraceEvents& trace = traceEvents();
+	lock_guard lock(trace.eventsMutex);
+	trace.events.clear();
+	trace.threadIndices.clear();
+	trace.origin = Clock::now();
+	s_enabled = true;
+}
+
+void TraceRecorder::disable()
+{
+	s_enabled = false;
+}
+
+void TraceRecorder::record(string _name, char const* _category, Clock::time_point _start, Clock::time_point _end)
+{
+	TraceEvents& trace = traceEvents();
+	lock_guard lock(trace.eventsMutex);
+	size_t threadIndex = trace.threadIndices.emplace(this_thread::get_id(), trace.threadIndices.size()).first->second;
+	trace.events.push_back({move(_name), _category, threadIndex, _start, _end});
+}
+
+void TraceRecorder::print(ostream& _stream)
+{
+	TraceEvents& trace = traceEvents();
+	lock_guard lock(trace.eventsMutex);
+	ios_base::fmtflags const flags = _stream.flags();
+	streamsize const precision = _stream.precision();
+	_stream << fixed << setprecision(3);
+	_stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	for (size_t threadIndex = 0; threadIndex < trace.threadIndices.size(); ++threadIndex)
+		_stream <<
+			(threadIndex > 0 ? "," : "") <<
+			"\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadIndex <<
+			",\"args\":{\"name\":\"" << "thread " << threadIndex << "\"}}";
+	for (TraceEvent const& event: trace.events)
+	{
+		_stream << ",\n{\"name\":";
+		jsonStreamPrintString(_stream, event.name);
+		_stream <<
+			",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadIndex <<
+			",\"ts\":" << traceMicroseconds(trace.origin, event.start) <<
+			",\"dur\":" << traceMicroseconds(event.start, event.end) << "}";
+	}
+	_stream << "\n]}\n";
+	_stream.flags(flags);
+	_stream.precision(precision);
+}
+
+void ScopedTraceSpan::start(string_view _name, char const* _category)
+{
+	m_category = _category;
+	m_name = string(_name);
+	m_start = TraceRecorder::Clock::now();
+}
+
+void ScopedTraceSpan::finish()
+{
+	TraceRecorder::record(move(m_name), m_category, m_start, TraceRecorder::Clock::now());
+}
+
+ScopedTimer::ScopedTimer(TimingCollector* _collector, string const& _phase, bool _recordPeakMemory):
+	m_span(_phase, "compiler"),
+	m_collector(_collector),
+	m_phase(_collector ? _phase : string{}),
+	m_recordPeakMemory(_recordPeakMemory)
+{
+	if (m_collector)
+		m_start = TimingCollector::Clock::now();
+}
+
+ScopedTimer::~ScopedTimer()
+{
+	if (m_collector)
+		m_collector->record(
+			m_phase,
+			TimingCollector::Clock::now() - m_start,
+			m_recordPeakMemory ? peakMemoryUsage() : 0
+		);
+}
+
+size_t solidity::util::peakMemoryUsage()
+{
+#if defined(__linux__) || defined(__APPLE__)
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	// macOS reports bytes, Linux kilobytes.
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
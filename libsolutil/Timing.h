@@ -0,0 +1,156 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helpers for measuring the time and memory spent in the phases of the compilation.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace solidity::util
+{
+
+/**
+ * Accumulates the wall time spent in named phases. Can be used from several threads at once.
+ */
+class TimingCollector
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Entry
+	{
+		Clock::duration wallTime{};
+		/// Number of times the phase was entered.
+		size_t count = 0;
+		/// Largest value of peakMemoryUsage() observed at the end of the phase, if recorded.
+		size_t peakMemory = 0;
+		/// Number of times the phase reported that it changed its input, if recorded.
+		size_t changes = 0;
+		/// Sum of the size differences of the input reported by the phase, if recorded.
+		int64_t sizeDelta = 0;
+	};
+
+	/// Adds @a _wallTime to the time spent in @a _phase.
+	void record(std::string const& _phase, Clock::duration _wallTime, size_t _peakMemory = 0);
+	/// Records the effect of one run of @a _phase on its input. Does not count as entering @a _phase.
+	void recordChange(std::string const& _phase, bool _changed, int64_t _sizeDelta);
+
+	/// @returns the accumulated entries of all phases.
+	std::map<std::string, Entry> entries() const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::string, Entry> m_entries;
+};
+
+/**
+ * Records the spans of the compilation together with the threads they ran on, to be written as
+ * trace events in the Chrome trace event format, which Perfetto and chrome://tracing can show.
+ * Recording is enabled for the whole process, so that the spans of all components are recorded
+ * without passing a recorder to each of them. Can be used from several threads at once.
+ */
+class TraceRecorder
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	/// Discards the spans recorded so far and starts recording. The timestamps of the trace are
+	/// relative to this call.
+	static void enable();
+	/// Stops recording. The recorded spans are kept until recording is enabled again.
+	static void disable();
+	static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+	/// Records a span of category @a _category that ran on the current thread.
+	static void record(std::string _name, char const* _category, Clock::time_point _start, Clock::time_point _end);
+
+	/// Prints the recorded spans as a JSON object in trace event format.
+	static void print(std::ostream& _stream);
+
+private:
+	static std::atomic<bool> s_enabled;
+};
+
+/**
+ * Records the span between its construction and its destruction in the TraceRecorder.
+ * If recording is disabled, the only cost is checking that once.
+ */
+class ScopedTraceSpan
+{
+public:
+	ScopedTraceSpan(std::string_view _name, char const* _category)
+	{
+		if (TraceRecorder::enabled())
+			start(_name, _category);
+	}
+	~ScopedTraceSpan()
+	{
+		if (m_category)
+			finish();
+	}
+
+	ScopedTraceSpan(ScopedTraceSpan const&) = delete;
+	ScopedTraceSpan& operator=(ScopedTraceSpan const&) = delete;
+
+private:
+	void start(std::string_view _name, char const* _category);
+	void finish();
+
+	/// Null unless the span is recorded.
+	char const* m_category = nullptr;
+	std::string m_name;
+	TraceRecorder::Clock::time_point m_start;
+};
+
+/**
+ * Records the wall time between its construction and its destruction in a TimingCollector.
+ * Does nothing if the collector is null. The phase is also recorded as a span of the trace.
+ */
+class ScopedTimer
+{
+public:
+	/// If @a _recordPeakMemory is true, the peak memory usage at destruction is recorded as well.
+	ScopedTimer(TimingCollector* _collector, std::string const& _phase, bool _recordPeakMemory = false);
+	~ScopedTimer();
+
+	ScopedTimer(ScopedTimer const&) = delete;
+	ScopedTimer& operator=(ScopedTimer const&) = delete;
+
+private:
+	ScopedTraceSpan m_span;
+	TimingCollector* m_collector = nullptr;
+	std::string m_phase;
+	bool m_recordPeakMemory = false;
+	TimingCollector::Clock::time_point m_start;
+};
+
+/// @returns the largest resident set size the process had so far in bytes, or zero if it is not
+/// available on this platform. Note that this covers the whole process and never decreases.
+size_t peakMemoryUsage();
+
+}
@@ -24,6 +24,14 @@
 
 #include <libsolutil/UTF8.h>
 
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SOLIDITY_UTF8_X86 1
+#include <immintrin.h>
+#endif
+
 namespace solidity::util
 {
 namespace
@@ -76,16 +84,31 @@ bool isWellFormed(unsigned char byte1, unsigned char byte2)
 	return false;
 }
 
-bool validateUTF8(unsigned char const* _input, size_t _length, size_t& _invalidPosition)
+/// @returns true if none of the eight bytes starting at @a _input has the high bit set.
+bool isASCIIWord(unsigned char const* _input)
+{
+	uint64_t word;
+	memcpy(&word, _input, sizeof(word));
+	return (word & 0x8080808080808080) == 0;
+}
+
+/// Validates the input from @a _begin, which has to be the start of a character that comes
+/// after valid input only.
+bool validateUTF8(unsigned char const* _input, size_t _begin, size_t _length, size_t& _invalidPosition)
 {
 	bool valid = true;
-	size_t i = 0;
+	size_t i = _begin;
 
 	for (; i < _length; i++)
 	{
 		// Check for Unicode Chapter 3 Table 3-6 conformity.
 		if (_input[i] < 0x80)
+		{
+			// Skip the ASCII characters that follow eight at a time.
+			while (i + 8 < _length && isASCIIWord(_input + i + 1))
+				i += 8;
 			continue;
+		}
 
 		size_t count = 0;
 		if (_input[i] >= 0xc0 && _input[i] <= 0xdf)
@@ -132,11 +155,153 @@ bool validateUTF8(unsigned char const* _input, size_t _length, size_t& _invalidP
 	return false;
 }
 
+#ifdef SOLIDITY_UTF8_X86
+
+/// @returns the start of the last character before @a _position, given that the input before
+/// it is valid apart from the last character possibly being incomplete.
+size_t lastCharacterStart(unsigned char const* _input, size_t _position)
+{
+	if (_position == 0)
+		return 0;
+	size_t start = _position - 1;
+	while (start > 0 && (_input[start] & 0xc0) == 0x80)
+		start--;
+	return start;
+}
+
+/// The classification of pairs of bytes from "Validating UTF-8 In Less Than One Instruction Per Byte"
+/// by Keiser and Lemire. A byte of the result is non-zero if the byte of @a _input at that position
+/// is invalid after the preceding ones.
+__attribute__((target("ssse3"))) __m128i invalidBytes(__m128i _input, __m128i _previousInput)
+{
+	// The bits are set for the pairs of a first and a second byte that are invalid.
+	constexpr char tooShort = 1 << 0; // lead byte or ASCII followed by a lead byte or ASCII
+	constexpr char tooLong = 1 << 1; // ASCII followed by a continuation byte
+	constexpr char overlong3 = 1 << 2; // e0 followed by 80..9f
+	constexpr char tooLarge = 1 << 3; // f4 followed by 90..bf or f5..ff followed by 90..bf
+	constexpr char surrogate = 1 << 4; // ed followed by a0..bf
+	constexpr char overlong2 = 1 << 5; // c0 or c1 followed by a continuation byte
+	constexpr char tooLarge1000 = 1 << 6; // f5..ff followed by 80..8f
+	constexpr char overlong4 = 1 << 6; // f0 followed by 80..8f
+	constexpr char twoContinuations = char(1 << 7); // continuation byte followed by a continuation byte
+	constexpr char carry = tooShort | tooLong | twoContinuations;
+
+	__m128i const lowNibble = _mm_set1_epi8(0x0f);
+	__m128i const previous1 = _mm_alignr_epi8(_input, _previousInput, 15);
+
+	__m128i const byte1High = _mm_shuffle_epi8(
+		_mm_setr_epi8(
+			tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong, tooLong,
+			twoContinuations, twoContinuations, twoContinuations, twoContinuations,
+			tooShort | overlong2,
+			tooShort,
+			tooShort | overlong3 | surrogate,
+			tooShort | tooLarge | tooLarge1000 | overlong4
+		),
+		_mm_and_si128(_mm_srli_epi16(previous1, 4), lowNibble)
+	);
+	__m128i const byte1Low = _mm_shuffle_epi8(
+		_mm_setr_epi8(
+			carry | overlong3 | overlong2 | overlong4,
+			carry | overlong2,
+			carry,
+			carry,
+			carry | tooLarge,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000 | surrogate,
+			carry | tooLarge | tooLarge1000,
+			carry | tooLarge | tooLarge1000
+		),
+		_mm_and_si128(previous1, lowNibble)
+	);
+	__m128i const byte2High = _mm_shuffle_epi8(
+		_mm_setr_epi8(
+			tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort, tooShort,
+			tooLong | overlong2 | twoContinuations | overlong3 | tooLarge1000 | overlong4,
+			tooLong | overlong2 | twoContinuations | overlong3 | tooLarge,
+			tooLong | overlong2 | twoContinuations | surrogate | tooLarge,
+			tooLong | overlong2 | twoContinuations | surrogate | tooLarge,
+			tooShort, tooShort, tooShort, tooShort
+		),
+		_mm_and_si128(_mm_srli_epi16(_input, 4), lowNibble)
+	);
+	__m128i const pairErrors = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+	// The third and fourth bytes of a character have to be continuation bytes, which are classified
+	// as two continuations above. Only those two continuations are valid.
+	__m128i const thirdByte = _mm_subs_epu8(_mm_alignr_epi8(_input, _previousInput, 14), _mm_set1_epi8(char(0xe0 - 0x80)));
+	__m128i const fourthByte = _mm_subs_epu8(_mm_alignr_epi8(_input, _previousInput, 13), _mm_set1_epi8(char(0xf0 - 0x80)));
+	__m128i const mustBeContinuation = _mm_and_si128(_mm_or_si128(thirdByte, fourthByte), _mm_set1_epi8(char(0x80)));
+	return _mm_xor_si128(mustBeContinuation, pairErrors);
+}
+
+/// @returns true if the last character of the sixteen bytes is incomplete.
+__attribute__((target("ssse3"))) bool endsIncomplete(__m128i _input)
+{
+	__m128i const maximum = _mm_setr_epi8(
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		char(0xf0 - 1), char(0xe0 - 1), char(0xc0 - 1)
+	);
+	__m128i const excess = _mm_subs_epu8(_input, maximum);
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(excess, _mm_setzero_si128())) != 0xffff;
+}
+
+/// @returns the length of a prefix of the input, a multiple of sixteen, that is valid apart from
+/// its last character possibly being incomplete. The prefix ends at the first invalid block.
+__attribute__((target("ssse3"))) size_t validBlocksLength(unsigned char const* _input, size_t _length)
+{
+	__m128i previous = _mm_setzero_si128();
+	size_t position = 0;
+	while (position + 16 <= _length)
+	{
+		// Skip four blocks of ASCII at once.
+		if (position + 64 <= _length && !endsIncomplete(previous))
+		{
+			__m128i blocks[4];
+			for (size_t i = 0; i < 4; ++i)
+				blocks[i] = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_input + position + 16 * i));
+			__m128i const any = _mm_or_si128(_mm_or_si128(blocks[0], blocks[1]), _mm_or_si128(blocks[2], blocks[3]));
+			if (_mm_movemask_epi8(any) == 0)
+			{
+				previous = blocks[3];
+				position += 64;
+				continue;
+			}
+		}
+
+		__m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_input + position));
+		__m128i const invalid = invalidBytes(block, previous);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(invalid, _mm_setzero_si128())) != 0xffff)
+			break;
+		previous = block;
+		position += 16;
+	}
+	return position;
+}
+
+#endif
+
 }
 
 bool validateUTF8(std::string const& _input, size_t& _invalidPosition)
 {
-	return validateUTF8(reinterpret_cast<unsigned char const*>(_input.c_str()), _input.length(), _invalidPosition);
+	auto const* input = reinterpret_cast<unsigned char const*>(_input.c_str());
+	size_t begin = 0;
+#ifdef SOLIDITY_UTF8_X86
+	// The blocks are only checked for validity. The rest, starting with the block that is invalid,
+	// is validated byte by byte to find the invalid position.
+	static bool const useSSSE3 = __builtin_cpu_supports("ssse3");
+	if (useSSSE3)
+		begin = lastCharacterStart(input, validBlocksLength(input, _input.length()));
+#endif
+	return validateUTF8(input, begin, _input.length(), _invalidPosition);
 }
 
 }
@@ -26,13 +26,249 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
 
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		(_c >= 'a' && _c <= 'z') ||
+		(_c >= 'A' && _c <= 'Z') ||
+		(_c >= '0' && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the position after the parameter name starting at @a _begin in @a _text.
+size_t parameterNameEnd(string_view _text, size_t _begin)
+{
+	size_t end = _begin;
+	while (end < _text.size() && isParameterCharacter(_text[end]))
+		++end;
+	return end;
+}
+
+}
+
+struct Whiskers::Template
+{
+	struct Segment;
+
+	/// A piece of the template, rendered by rendering its segments one after another.
+	struct Part
+	{
+		/// The text of this part, used in error messages.
+		string_view text;
+		vector<Segment> segments;
+	};
+
+	struct Segment
+	{
+		enum class Kind { Text, Parameter, List, Condition, ConditionalValue };
+		Kind kind = Kind::Text;
+		/// The text of a text segment.
+		string_view text;
+		/// The name of a parameter, list or condition, without the "+" of a conditional value.
+		string name;
+		/// The body of a list, or the parts rendered if a condition is true and if it is false.
+		vector<Part> parts;
+	};
+
+	/// @returns @a _text split into its elements.
+	static Part parse(string_view _text);
+	/// Parses the element starting with the "<" at @a _begin in @a _text.
+	/// @returns the element and the position after it, or nullopt if there is no element at
+	/// @a _begin. An element is only recognised if it is complete, i.e. lists and conditions need
+	/// to be closed. The parts of lists and conditions end at the first closing tag of the same name.
+	static optional<pair<Segment, size_t>> parseElement(string_view _text, size_t _begin);
+	/// Renders @a _part into @a _output. Inside lists, the values of the current element are given
+	/// by @a _listElement and lists are not available, i.e. @a _listParameters is null.
+	static void render(
+		Part const& _part,
+		StringMap const& _parameters,
+		StringMap const* _listElement,
+		map<string, bool> const& _conditions,
+		StringListMap const* _listParameters,
+		string& _output
+	);
+
+	string text;
+	Part root;
+};
+
+optional<pair<Whiskers::Template::Segment, size_t>> Whiskers::Template::parseElement(string_view _text, size_t _begin)
+{
+	size_t nameBegin = _begin + 1;
+	Segment::Kind kind = Segment::Kind::Parameter;
+	string prefix;
+	if (nameBegin < _text.size() && _text[nameBegin] == '#')
+	{
+		kind = Segment::Kind::List;
+		++nameBegin;
+	}
+	else if (nameBegin < _text.size() && _text[nameBegin] == '?')
+	{
+		kind = Segment::Kind::Condition;
+		if (++nameBegin < _text.size() && _text[nameBegin] == '+')
+		{
+			kind = Segment::Kind::ConditionalValue;
+			prefix = "+";
+			++nameBegin;
+		}
+	}
+	size_t const nameEnd = parameterNameEnd(_text, nameBegin);
+	if (nameEnd == nameBegin || nameEnd == _text.size() || _text[nameEnd] != '>')
+		return nullopt;
+
+	Segment segment;
+	segment.kind = kind;
+	segment.name = string(_text.substr(nameBegin, nameEnd - nameBegin));
+	size_t const bodyBegin = nameEnd + 1;
+	if (kind == Segment::Kind::Parameter)
+		return {{move(segment), bodyBegin}};
+
+	string const closingTag = "</" + prefix + segment.name + ">";
+	size_t const closingTagBegin = _text.find(closingTag, bodyBegin);
+	if (closingTagBegin == string_view::npos)
+		return nullopt;
+	size_t bodyEnd = closingTagBegin;
+	string_view elseBody;
+	if (kind != Segment::Kind::List)
+	{
+		string const elseTag = "<!" + prefix + segment.name + ">";
+		size_t const elseTagBegin = _text.substr(0, closingTagBegin).find(elseTag, bodyBegin);
+		if (elseTagBegin != string_view::npos)
+		{
+			bodyEnd = elseTagBegin;
+			elseBody = _text.substr(elseTagBegin + elseTag.size(), closingTagBegin - elseTagBegin - elseTag.size());
+		}
+	}
+	segment.parts.emplace_back(parse(_text.substr(bodyBegin, bodyEnd - bodyBegin)));
+	if (kind != Segment::Kind::List)
+		segment.parts.emplace_back(parse(elseBody));
+	return {{move(segment), closingTagBegin + closingTag.size()}};
+}
+
+Whiskers::Template::Part Whiskers::Template::parse(string_view _text)
+{
+	Part part{_text, {}};
+	size_t textBegin = 0;
+	auto addText = [&](size_t _end) {
+		if (_end > textBegin)
+		{
+			Segment text;
+			text.text = _text.substr(textBegin, _end - textBegin);
+			part.segments.emplace_back(move(text));
+		}
+	};
+	for (size_t position = _text.find('<'); position != string_view::npos; position = _text.find('<', position))
+		if (auto element = parseElement(_text, position))
+		{
+			addText(position);
+			part.segments.emplace_back(move(element->first));
+			textBegin = position = element->second;
+		}
+		else
+			++position;
+	addText(_text.size());
+	return part;
+}
+
+void Whiskers::Template::render(
+	Part const& _part,
+	StringMap const& _parameters,
+	StringMap const* _listElement,
+	map<string, bool> const& _conditions,
+	StringListMap const* _listParameters,
+	string& _output
+)
+{
+	auto findParameter = [&](string const& _name) -> string const* {
+		if (_listElement)
+			if (auto it = _listElement->find(_name); it != _listElement->end())
+				return &it->second;
+		if (auto it = _parameters.find(_name); it != _parameters.end())
+			return &it->second;
+		return nullptr;
+	};
+
+	for (Segment const& segment: _part.segments)
+		switch (segment.kind)
+		{
+		case Segment::Kind::Text:
+			_output += segment.text;
+			break;
+		case Segment::Kind::Parameter:
+		{
+			string const* value = findParameter(segment.name);
+			assertThrow(
+				value,
+				WhiskersError,
+				"Value for tag " + segment.name + " not provided.\n" +
+				"Template:\n" +
+				string(_part.text)
+			);
+			_output += *value;
+			break;
+		}
+		case Segment::Kind::List:
+		{
+			assertThrow(
+				_listParameters && _listParameters->count(segment.name),
+				WhiskersError, "List parameter " + segment.name + " not set."
+			);
+			for (auto const& element: _listParameters->at(segment.name))
+			{
+				for (auto const& value: element)
+					assertThrow(!_parameters.count(value.first), WhiskersError, "Parameter collision");
+				render(segment.parts.front(), _parameters, &element, _conditions, nullptr, _output);
+			}
+			break;
+		}
+		case Segment::Kind::Condition:
+		case Segment::Kind::ConditionalValue:
+		{
+			bool conditionValue = false;
+			if (segment.kind == Segment::Kind::ConditionalValue)
+			{
+				if (string const* value = findParameter(segment.name))
+					conditionValue = !value->empty();
+				else if (_listParameters && _listParameters->count(segment.name))
+					conditionValue = !_listParameters->at(segment.name).empty();
+				else
+					assertThrow(false, WhiskersError, "Tag " + segment.name + " used as condition but was not set.");
+			}
+			else
+			{
+				assertThrow(
+					_conditions.count(segment.name),
+					WhiskersError, "Condition parameter " + segment.name + " not set."
+				);
+				conditionValue = _conditions.at(segment.name);
+			}
+			render(
+				segment.parts.at(conditionValue ? 0 : 1),
+				_parameters,
+				_listElement,
+				_conditions,
+				_listParameters,
+				_output
+			);
+			break;
+		}
+		}
+}
+
 Whiskers::Whiskers(string _template):
-	m_template(move(_template))
+	m_template(compile(move(_template)))
 {
 }
 
@@ -71,14 +307,16 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	string result;
+	result.reserve(m_template->text.size());
+	Template::render(m_template->root, m_parameters, nullptr, m_conditions, &m_listParameters, result);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -109,124 +347,34 @@ void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string
 	{
 		string tag{"<" + prefix + _parameter + ">"};
 		assertThrow(
-			m_template.find(tag) != string::npos,
+			m_template->text.find(tag) != string::npos,
 			WhiskersError,
-			"Tag '" + tag + "' not found in template:\n" + m_template
+			"Tag '" + tag + "' not found in template:\n" + m_template->text
 		);
 	}
 }
 
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
+shared_ptr<Whiskers::Template const> Whiskers::compile(string _text)
 {
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
-	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
-	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
-}
+	// Most templates are literals in the code generators, but some are assembled at runtime,
+	// so the cache is emptied instead of growing without bound.
+	size_t constexpr maxCacheSize = 4096;
+	static mutex cacheMutex;
+	static unordered_map<string_view, shared_ptr<Template const>> cache;
 
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
-{
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
 	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
-		{
-			string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
-		}
-		else
-		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
-			bool conditionValue = false;
-			if (conditionName[0] == '+')
-			{
-				string tag = conditionName.substr(1);
+		lock_guard<mutex> lock(cacheMutex);
+		if (auto it = cache.find(_text); it != cache.end())
+			return it->second;
+	}
 
-				if (_parameters.count(tag))
-					conditionValue = !_parameters.at(tag).empty();
-				else if (_listParameters.count(tag))
-					conditionValue = !_listParameters.at(tag).empty();
-				else
-					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
-			}
-			else
-			{
-				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
-				);
-				conditionValue = _conditions.at(conditionName);
-			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
-		}
-	});
-}
+	auto compiledTemplate = make_shared<Template>();
+	compiledTemplate->text = move(_text);
+	compiledTemplate->root = Template::parse(compiledTemplate->text);
 
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
+	lock_guard<mutex> lock(cacheMutex);
+	if (cache.size() >= maxCacheSize)
+		cache.clear();
+	// The key refers to the text of the template, which lives as long as the entry.
+	return cache.emplace(compiledTemplate->text, compiledTemplate).first->second;
 }
-
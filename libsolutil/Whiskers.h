@@ -26,8 +26,9 @@
 
 #include <libsolutil/Exceptions.h>
 
-#include <string>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace solidity::util
@@ -67,6 +68,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *    Works similar to a conditional parameter where the checked condition is
  *    that the string or list parameter called "name" is non-empty or contains
  *    no elements respectively.
+ *
+ * Templates are split into their elements only once per template text and the result is
+ * shared by all instances using the same text.
  */
 class Whiskers
 {
@@ -101,19 +105,13 @@ private:
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
-
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
+	/// A template text split into its elements.
+	struct Template;
 
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
+	/// @returns the template for @a _text, reusing the one of an earlier call if possible.
+	static std::shared_ptr<Template const> compile(std::string _text);
 
-	std::string m_template;
+	std::shared_ptr<Template const> m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
@@ -54,6 +54,14 @@ struct DebugData
 		std::optional<int64_t> _astID = {}
 	)
 	{
+		// Nodes without any debug data are common in generated code, they all share one object.
+		if (!_nativeLocation.isValid() && !_originLocation.isValid() && !_astID)
+		{
+			static std::shared_ptr<DebugData const> const empty = std::make_shared<DebugData const>(
+				langutil::SourceLocation{}
+			);
+			return empty;
+		}
 		return std::make_shared<DebugData const>(
 			std::move(_nativeLocation),
 			std::move(_originLocation),
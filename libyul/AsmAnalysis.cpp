@@ -96,6 +96,20 @@ AsmAnalysisInfo AsmAnalyzer::analyzeStrictAssertCorrect(Dialect const& _dialect,
 	return analysisInfo;
 }
 
+AsmAnalysisInfo AsmAnalyzer::reanalyzeAssertCorrect([[maybe_unused]] Dialect const& _dialect, Object const& _object)
+{
+#ifdef NDEBUG
+	ErrorList errorList;
+	langutil::ErrorReporter errors(errorList);
+	AsmAnalysisInfo analysisInfo;
+	bool success = ScopeFiller(analysisInfo, errors)(*_object.code);
+	yulAssert(success && !errors.hasErrors(), "Invalid assembly/yul code.");
+	return analysisInfo;
+#else
+	return analyzeStrictAssertCorrect(_dialect, _object);
+#endif
+}
+
 vector<YulString> AsmAnalyzer::operator()(Literal const& _literal)
 {
 	expectValidType(_literal.type, nativeLocationOf(_literal));
@@ -78,6 +78,11 @@ public:
 	/// Performs analysis on the outermost code of the given object and returns the analysis info.
 	/// Asserts on failure.
 	static AsmAnalysisInfo analyzeStrictAssertCorrect(Dialect const& _dialect, Object const& _object);
+	/// Rebuilds the analysis info of code that passed the analysis before and was only transformed
+	/// by the optimiser since. Unless assertions are enabled (NDEBUG is not defined), this only
+	/// fills the scopes, which is all the analysis info consists of, without validating the code.
+	/// Asserts on failure.
+	static AsmAnalysisInfo reanalyzeAssertCorrect(Dialect const& _dialect, Object const& _object);
 
 	std::vector<YulString> operator()(Literal const& _literal);
 	std::vector<YulString> operator()(Identifier const&);
@@ -35,7 +35,7 @@
 #include <boost/algorithm/string.hpp>
 
 #include <algorithm>
-#include <regex>
+#include <array>
 
 using namespace std;
 using namespace solidity;
@@ -46,6 +46,55 @@ using namespace solidity::yul;
 namespace
 {
 
+bool isWhiteSpace(char _c)
+{
+	return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\v' || _c == '\f' || _c == '\r';
+}
+
+size_t whiteSpaceLength(string_view _text)
+{
+	size_t length = 0;
+	while (length < _text.size() && isWhiteSpace(_text[length]))
+		++length;
+	return length;
+}
+
+size_t digitsLength(string_view _text)
+{
+	size_t length = 0;
+	while (length < _text.size() && '0' <= _text[length] && _text[length] <= '9')
+		++length;
+	return length;
+}
+
+/// @returns the first tag like `@src` in @a _text that is preceded by white space or the start of
+/// the text and followed by white space or the end of the text, together with the text after the
+/// white space following the tag.
+optional<pair<string_view, string_view>> findTag(string_view _text)
+{
+	auto isTagCharacter = [](char _c) {
+		return
+			('a' <= _c && _c <= 'z') ||
+			('A' <= _c && _c <= 'Z') ||
+			('0' <= _c && _c <= '9') ||
+			_c == '-' ||
+			_c == '_';
+	};
+	for (size_t position = _text.find('@'); position != string_view::npos; position = _text.find('@', position + 1))
+	{
+		if (position > 0 && !isWhiteSpace(_text[position - 1]))
+			continue;
+		size_t end = position + 1;
+		while (end < _text.size() && isTagCharacter(_text[end]))
+			++end;
+		if (end == position + 1 || (end < _text.size() && !isWhiteSpace(_text[end])))
+			continue;
+		string_view tail = _text.substr(end);
+		return {{_text.substr(position, end - position), tail.substr(whiteSpaceLength(tail))}};
+	}
+	return nullopt;
+}
+
 optional<int> toInt(string const& _value)
 {
 	try
@@ -65,11 +114,11 @@ std::shared_ptr<DebugData const> Parser::createDebugData() const
 	switch (m_useSourceLocationFrom)
 	{
 		case UseSourceLocationFrom::Scanner:
-			return DebugData::create(ParserBase::currentLocation(), ParserBase::currentLocation());
+			return m_debugDataPool.create(ParserBase::currentLocation(), ParserBase::currentLocation());
 		case UseSourceLocationFrom::LocationOverride:
-			return DebugData::create(m_locationOverride, m_locationOverride);
+			return m_debugDataPool.create(m_locationOverride, m_locationOverride);
 		case UseSourceLocationFrom::Comments:
-			return DebugData::create(ParserBase::currentLocation(), m_locationFromComment, m_astIDFromComment);
+			return m_debugDataPool.create(ParserBase::currentLocation(), m_locationFromComment, m_astIDFromComment);
 	}
 	solAssert(false, "");
 }
@@ -85,10 +134,11 @@ void Parser::updateLocationEndFrom(
 	{
 		case UseSourceLocationFrom::Scanner:
 		{
-			DebugData updatedDebugData = *_debugData;
-			updatedDebugData.nativeLocation.end = _location.end;
-			updatedDebugData.originLocation.end = _location.end;
-			_debugData = make_shared<DebugData const>(move(updatedDebugData));
+			SourceLocation nativeLocation = _debugData->nativeLocation;
+			SourceLocation originLocation = _debugData->originLocation;
+			nativeLocation.end = _location.end;
+			originLocation.end = _location.end;
+			_debugData = m_debugDataPool.create(nativeLocation, originLocation, _debugData->astID);
 			break;
 		}
 		case UseSourceLocationFrom::LocationOverride:
@@ -96,9 +146,9 @@ void Parser::updateLocationEndFrom(
 			break;
 		case UseSourceLocationFrom::Comments:
 		{
-			DebugData updatedDebugData = *_debugData;
-			updatedDebugData.nativeLocation.end = _location.end;
-			_debugData = make_shared<DebugData const>(move(updatedDebugData));
+			SourceLocation nativeLocation = _debugData->nativeLocation;
+			nativeLocation.end = _location.end;
+			_debugData = m_debugDataPool.create(nativeLocation, _debugData->originLocation, _debugData->astID);
 			break;
 		}
 	}
@@ -146,31 +196,26 @@ void Parser::fetchDebugDataFromComment()
 {
 	solAssert(m_sourceNames.has_value(), "");
 
-	static regex const tagRegex = regex(
-		R"~~((?:^|\s+)(@[a-zA-Z0-9\-_]+)(?:\s+|$))~~", // tag, e.g: @src
-		regex_constants::ECMAScript | regex_constants::optimize
-	);
-
 	string_view commentLiteral = m_scanner->currentCommentLiteral();
-	match_results<string_view::const_iterator> match;
 
 	langutil::SourceLocation originLocation = m_locationFromComment;
 	// Empty for each new node.
 	optional<int> astID;
 
-	while (regex_search(commentLiteral.cbegin(), commentLiteral.cend(), match, tagRegex))
+	// Tags, e.g. @src, are separated from each other and from their arguments by white space.
+	while (optional<pair<string_view, string_view>> tagAndTail = findTag(commentLiteral))
 	{
-		solAssert(match.size() == 2, "");
-		commentLiteral = commentLiteral.substr(static_cast<size_t>(match.position() + match.length()));
+		string_view tag;
+		tie(tag, commentLiteral) = *tagAndTail;
 
-		if (match[1] == "@src")
+		if (tag == "@src")
 		{
 			if (auto parseResult = parseSrcComment(commentLiteral, m_scanner->currentCommentLocation()))
 				tie(commentLiteral, originLocation) = *parseResult;
 			else
 				break;
 		}
-		else if (match[1] == "@ast-id")
+		else if (tag == "@ast-id")
 		{
 			if (auto parseResult = parseASTIDComment(commentLiteral, m_scanner->currentCommentLocation()))
 				tie(commentLiteral, astID) = *parseResult;
@@ -191,13 +236,25 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 	langutil::SourceLocation const& _commentLocation
 )
 {
-	static regex const argsRegex = regex(
-		R"~~(^(-1|\d+):(-1|\d+):(-1|\d+)(?:\s+|$))~~"  // index and location, e.g.: 1:234:-1
-		R"~~(("(?:[^"\\]|\\.)*"?)?)~~",                // optional code snippet, e.g.: "string memory s = \"abc\";..."
-		regex_constants::ECMAScript | regex_constants::optimize
-	);
-	match_results<string_view::const_iterator> match;
-	if (!regex_search(_arguments.cbegin(), _arguments.cend(), match, argsRegex))
+	// Source index and location, e.g. 1:234:-1, each of which is -1 or a non-negative integer,
+	// followed by white space or the end of the comment.
+	string_view tail = _arguments;
+	array<string_view, 3> values;
+	bool valid = true;
+	for (size_t i = 0; i < values.size() && valid; ++i)
+	{
+		size_t length = tail.substr(0, 2) == "-1" ? 2 : digitsLength(tail);
+		values[i] = tail.substr(0, length);
+		tail.remove_prefix(length);
+		if (i + 1 < values.size())
+		{
+			valid = length > 0 && !tail.empty() && tail.front() == ':';
+			tail.remove_prefix(valid ? 1 : 0);
+		}
+		else
+			valid = length > 0 && (tail.empty() || isWhiteSpace(tail.front()));
+	}
+	if (!valid)
 	{
 		m_errorReporter.syntaxError(
 			8387_error,
@@ -206,26 +263,42 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 		);
 		return nullopt;
 	}
+	tail.remove_prefix(whiteSpaceLength(tail));
 
-	solAssert(match.size() == 5, "");
-	string_view tail = _arguments.substr(static_cast<size_t>(match.position() + match.length()));
-
-	if (match[4].matched && (
-		!boost::algorithm::ends_with(match[4].str(), "\"") ||
-		boost::algorithm::ends_with(match[4].str(), "\\\"")
-	))
+	// Optional code snippet, e.g. "string memory s = \"abc\";...", in which a backslash escapes
+	// any character but a line break.
+	if (!tail.empty() && tail.front() == '"')
 	{
-		m_errorReporter.syntaxError(
-			1544_error,
-			_commentLocation,
-			"Invalid code snippet in source location mapping. Quote is not terminated."
-		);
-		return {{tail, SourceLocation{}}};
+		size_t length = 1;
+		while (length < tail.size() && tail[length] != '"')
+			if (tail[length] != '\\')
+				++length;
+			else if (length + 1 < tail.size() && tail[length + 1] != '\n' && tail[length + 1] != '\r')
+				length += 2;
+			else
+				break;
+		if (length < tail.size() && tail[length] == '"')
+			++length;
+		string_view snippet = tail.substr(0, length);
+		tail.remove_prefix(length);
+
+		if (
+			!boost::algorithm::ends_with(snippet, "\"") ||
+			boost::algorithm::ends_with(snippet, "\\\"")
+		)
+		{
+			m_errorReporter.syntaxError(
+				1544_error,
+				_commentLocation,
+				"Invalid code snippet in source location mapping. Quote is not terminated."
+			);
+			return {{tail, SourceLocation{}}};
+		}
 	}
 
-	optional<int> const sourceIndex = toInt(match[1].str());
-	optional<int> const start = toInt(match[2].str());
-	optional<int> const end = toInt(match[3].str());
+	optional<int> const sourceIndex = toInt(string(values[0]));
+	optional<int> const start = toInt(string(values[1]));
+	optional<int> const end = toInt(string(values[2]));
 
 	if (!sourceIndex.has_value() || !start.has_value() || !end.has_value())
 		m_errorReporter.syntaxError(
@@ -244,9 +317,9 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 		);
 	else
 	{
-		shared_ptr<string const> sourceName = m_sourceNames->at(static_cast<unsigned>(sourceIndex.value()));
+		string const* sourceName = m_sourceNames->at(static_cast<unsigned>(sourceIndex.value()));
 		solAssert(sourceName, "");
-		return {{tail, SourceLocation{start.value(), end.value(), move(sourceName)}}};
+		return {{tail, SourceLocation{start.value(), end.value(), sourceName}}};
 	}
 	return {{tail, SourceLocation{}}};
 }
@@ -256,21 +329,12 @@ optional<pair<string_view, optional<int>>> Parser::parseASTIDComment(
 	langutil::SourceLocation const& _commentLocation
 )
 {
-	static regex const argRegex = regex(
-		R"~~(^(\d+)(?:\s|$))~~",
-		regex_constants::ECMAScript | regex_constants::optimize
-	);
-	match_results<string_view::const_iterator> match;
+	// A non-negative integer followed by white space or the end of the comment.
+	size_t length = digitsLength(_arguments);
+	bool matched = length > 0 && (length == _arguments.size() || isWhiteSpace(_arguments[length]));
 	optional<int> astID;
-	bool matched = regex_search(_arguments.cbegin(), _arguments.cend(), match, argRegex);
-	string_view tail = _arguments;
 	if (matched)
-	{
-		solAssert(match.size() == 2, "");
-		tail = _arguments.substr(static_cast<size_t>(match.position() + match.length()));
-
-		astID = toInt(match[1].str());
-	}
+		astID = toInt(string(_arguments.substr(0, length)));
 
 	if (!matched || !astID || *astID < 0 || static_cast<int64_t>(*astID) != *astID)
 	{
@@ -501,7 +565,7 @@ variant<Literal, Identifier> Parser::parseLiteralOrIdentifier()
 	{
 	case Token::Identifier:
 	{
-		Identifier identifier{createDebugData(), YulString{currentLiteral()}};
+		Identifier identifier{createDebugData(), YulString{string(currentLiteral())}};
 		advance();
 		return identifier;
 	}
@@ -519,7 +583,7 @@ variant<Literal, Identifier> Parser::parseLiteralOrIdentifier()
 			kind = LiteralKind::String;
 			break;
 		case Token::Number:
-			if (!isValidNumberLiteral(currentLiteral()))
+			if (!isValidNumberLiteral(string(currentLiteral())))
 				fatalParserError(4828_error, "Invalid number literal.");
 			kind = LiteralKind::Number;
 			break;
@@ -534,7 +598,7 @@ variant<Literal, Identifier> Parser::parseLiteralOrIdentifier()
 		Literal literal{
 			createDebugData(),
 			kind,
-			YulString{currentLiteral()},
+			YulString{string(currentLiteral())},
 			kind == LiteralKind::Boolean ? m_dialect.boolType : m_dialect.defaultType
 		};
 		advance();
@@ -673,7 +737,7 @@ TypedName Parser::parseTypedName()
 
 YulString Parser::expectAsmIdentifier()
 {
-	YulString name{currentLiteral()};
+	YulString name{string(currentLiteral())};
 	if (currentToken() == Token::Identifier && m_dialect.builtin(name))
 		fatalParserError(5568_error, "Cannot use builtin function name \"" + name.str() + "\" as identifier name.");
 	// NOTE: We keep the expectation here to ensure the correct source location for the error above.
@@ -25,6 +25,7 @@
 
 #include <libyul/AST.h>
 #include <libyul/ASTForward.h>
+#include <libyul/DebugDataPool.h>
 #include <libyul/Dialect.h>
 
 #include <liblangutil/SourceLocation.h>
@@ -73,7 +74,7 @@ public:
 	explicit Parser(
 		langutil::ErrorReporter& _errorReporter,
 		Dialect const& _dialect,
-		std::optional<std::map<unsigned, std::shared_ptr<std::string const>>> _sourceNames
+		std::optional<std::map<unsigned, std::string const*>> _sourceNames
 	):
 		ParserBase(_errorReporter),
 		m_dialect(_dialect),
@@ -156,13 +157,15 @@ protected:
 private:
 	Dialect const& m_dialect;
 
-	std::optional<std::map<unsigned, std::shared_ptr<std::string const>>> m_sourceNames;
+	std::optional<std::map<unsigned, std::string const*>> m_sourceNames;
 	langutil::SourceLocation m_locationOverride;
 	langutil::SourceLocation m_locationFromComment;
 	std::optional<int64_t> m_astIDFromComment;
 	UseSourceLocationFrom m_useSourceLocationFrom = UseSourceLocationFrom::Scanner;
 	ForLoopComponent m_currentForLoopComponent = ForLoopComponent::None;
 	bool m_insideFunction = false;
+	/// Shares equal debug data between the nodes of the parsed AST.
+	mutable DebugDataPool m_debugDataPool;
 };
 
 }
@@ -32,10 +32,10 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/replace.hpp>
 
-#include <range/v3/view/transform.hpp>
-
+#include <limits>
 #include <memory>
 #include <functional>
+#include <sstream>
 
 using namespace std;
 using namespace solidity;
@@ -43,196 +43,270 @@ using namespace solidity::langutil;
 using namespace solidity::util;
 using namespace solidity::yul;
 
-string AsmPrinter::operator()(Literal const& _literal)
+string AsmPrinter::operator()(Literal const& _literal) { return toString(_literal); }
+string AsmPrinter::operator()(Identifier const& _identifier) { return toString(_identifier); }
+string AsmPrinter::operator()(ExpressionStatement const& _statement) { return toString(_statement); }
+string AsmPrinter::operator()(Assignment const& _assignment) { return toString(_assignment); }
+string AsmPrinter::operator()(VariableDeclaration const& _variableDeclaration) { return toString(_variableDeclaration); }
+string AsmPrinter::operator()(FunctionDefinition const& _functionDefinition) { return toString(_functionDefinition); }
+string AsmPrinter::operator()(FunctionCall const& _functionCall) { return toString(_functionCall); }
+string AsmPrinter::operator()(If const& _if) { return toString(_if); }
+string AsmPrinter::operator()(Switch const& _switch) { return toString(_switch); }
+string AsmPrinter::operator()(ForLoop const& _forLoop) { return toString(_forLoop); }
+string AsmPrinter::operator()(Break const& _break) { return toString(_break); }
+string AsmPrinter::operator()(Continue const& _continue) { return toString(_continue); }
+// '_leave' and '__leave' is reserved in VisualStudio
+string AsmPrinter::operator()(Leave const& leave_) { return toString(leave_); }
+string AsmPrinter::operator()(Block const& _block) { return toString(_block); }
+
+void AsmPrinter::print(ostream& _stream, Block const& _block, string const& _indentation)
+{
+	Output output(_stream, _indentation);
+	ScopedSaveAndRestore outputGuard(m_output, &output);
+	print(_block);
+}
+
+AsmPrinter::Output& AsmPrinter::Output::operator<<(string_view _text)
+{
+	if (m_exceeded)
+		return *this;
+	if (!m_stream)
+	{
+		if (_text.find('\n') != string_view::npos || _text.size() > m_maxLength - m_length)
+			m_exceeded = true;
+		else
+			m_length += _text.size();
+		return *this;
+	}
+	for (size_t lineEnd; (lineEnd = _text.find('\n')) != string_view::npos; _text.remove_prefix(lineEnd + 1))
+		m_stream->write(_text.data(), static_cast<streamsize>(lineEnd + 1)) << m_indentation;
+	m_stream->write(_text.data(), static_cast<streamsize>(_text.size()));
+	return *this;
+}
+
+template <class Node>
+string AsmPrinter::toString(Node const& _node)
 {
-	string const locationComment = formatDebugData(_literal);
+	ostringstream stream;
+	Output output(stream);
+	ScopedSaveAndRestore outputGuard(m_output, &output);
+	print(_node);
+	return stream.str();
+}
+
+bool AsmPrinter::fitsOnLine(size_t _maxLength, function<void()> const& _print)
+{
+	Output measurement(_maxLength);
+	ScopedSaveAndRestore outputGuard(m_output, &measurement);
+	ScopedSaveAndRestore locationGuard(m_lastLocation, SourceLocation{m_lastLocation});
+	_print();
+	return !measurement.exceeded();
+}
+
+void AsmPrinter::print(Literal const& _literal)
+{
+	*m_output << formatDebugData(_literal);
 
 	switch (_literal.kind)
 	{
 	case LiteralKind::Number:
 		yulAssert(isValidDecimal(_literal.value.str()) || isValidHex(_literal.value.str()), "Invalid number literal");
-		return locationComment + _literal.value.str() + appendTypeName(_literal.type);
+		*m_output << _literal.value.str() << appendTypeName(_literal.type);
+		return;
 	case LiteralKind::Boolean:
 		yulAssert(_literal.value == "true"_yulstring || _literal.value == "false"_yulstring, "Invalid bool literal.");
-		return locationComment + ((_literal.value == "true"_yulstring) ? "true" : "false") + appendTypeName(_literal.type, true);
+		*m_output << ((_literal.value == "true"_yulstring) ? "true" : "false") << appendTypeName(_literal.type, true);
+		return;
 	case LiteralKind::String:
 		break;
 	}
 
-	return locationComment + escapeAndQuoteString(_literal.value.str()) + appendTypeName(_literal.type);
+	*m_output << escapeAndQuoteString(_literal.value.str()) << appendTypeName(_literal.type);
 }
 
-string AsmPrinter::operator()(Identifier const& _identifier)
+void AsmPrinter::print(Identifier const& _identifier)
 {
 	yulAssert(!_identifier.name.empty(), "Invalid identifier.");
-	return formatDebugData(_identifier) + _identifier.name.str();
+	*m_output << formatDebugData(_identifier) << _identifier.name.str();
 }
 
-string AsmPrinter::operator()(ExpressionStatement const& _statement)
+void AsmPrinter::print(ExpressionStatement const& _statement)
 {
-	string const locationComment = formatDebugData(_statement);
-
-	return locationComment + std::visit(*this, _statement.expression);
+	*m_output << formatDebugData(_statement);
+	print(_statement.expression);
 }
 
-string AsmPrinter::operator()(Assignment const& _assignment)
+void AsmPrinter::print(Assignment const& _assignment)
 {
-	string const locationComment = formatDebugData(_assignment);
+	*m_output << formatDebugData(_assignment);
 
 	yulAssert(_assignment.variableNames.size() >= 1, "");
-	string variables = (*this)(_assignment.variableNames.front());
-	for (size_t i = 1; i < _assignment.variableNames.size(); ++i)
-		variables += ", " + (*this)(_assignment.variableNames[i]);
-
-	return locationComment + variables + " := " + std::visit(*this, *_assignment.value);
+	printList(_assignment.variableNames);
+	*m_output << " := ";
+	print(*_assignment.value);
 }
 
-string AsmPrinter::operator()(VariableDeclaration const& _variableDeclaration)
+void AsmPrinter::print(VariableDeclaration const& _variableDeclaration)
 {
-	string out = formatDebugData(_variableDeclaration);
-
-	out += "let ";
-	out += boost::algorithm::join(
-		_variableDeclaration.variables | ranges::views::transform(
-			[this](TypedName argument) { return formatTypedName(argument); }
-		),
-		", "
-	);
+	*m_output << formatDebugData(_variableDeclaration) << "let ";
+	printList(_variableDeclaration.variables);
 	if (_variableDeclaration.value)
 	{
-		out += " := ";
-		out += std::visit(*this, *_variableDeclaration.value);
+		*m_output << " := ";
+		print(*_variableDeclaration.value);
 	}
-	return out;
 }
 
-string AsmPrinter::operator()(FunctionDefinition const& _functionDefinition)
+void AsmPrinter::print(FunctionDefinition const& _functionDefinition)
 {
 	yulAssert(!_functionDefinition.name.empty(), "Invalid function name.");
 
-	string out = formatDebugData(_functionDefinition);
-	out += "function " + _functionDefinition.name.str() + "(";
-	out += boost::algorithm::join(
-		_functionDefinition.parameters | ranges::views::transform(
-			[this](TypedName argument) { return formatTypedName(argument); }
-		),
-		", "
-	);
-	out += ")";
+	*m_output << formatDebugData(_functionDefinition) << "function " << _functionDefinition.name.str() << "(";
+	printList(_functionDefinition.parameters);
+	*m_output << ")";
 	if (!_functionDefinition.returnVariables.empty())
 	{
-		out += " -> ";
-		out += boost::algorithm::join(
-			_functionDefinition.returnVariables | ranges::views::transform(
-				[this](TypedName argument) { return formatTypedName(argument); }
-			),
-			", "
-		);
+		*m_output << " -> ";
+		printList(_functionDefinition.returnVariables);
 	}
-
-	return out + "\n" + (*this)(_functionDefinition.body);
+	*m_output << "\n";
+	print(_functionDefinition.body);
 }
 
-string AsmPrinter::operator()(FunctionCall const& _functionCall)
+void AsmPrinter::print(FunctionCall const& _functionCall)
 {
-	string const locationComment = formatDebugData(_functionCall);
-	string const functionName = (*this)(_functionCall.functionName);
-	return
-		locationComment +
-		functionName + "(" +
-		boost::algorithm::join(
-			_functionCall.arguments | ranges::views::transform([&](auto&& _node) { return std::visit(*this, _node); }),
-			", " ) +
-		")";
+	*m_output << formatDebugData(_functionCall);
+	print(_functionCall.functionName);
+	*m_output << "(";
+	printList(_functionCall.arguments);
+	*m_output << ")";
 }
 
-string AsmPrinter::operator()(If const& _if)
+void AsmPrinter::print(If const& _if)
 {
 	yulAssert(_if.condition, "Invalid if condition.");
 
-	string out = formatDebugData(_if);
-	out += "if " + std::visit(*this, *_if.condition);
+	*m_output << formatDebugData(_if) << "if ";
+	print(*_if.condition);
 
-	string body = (*this)(_if.body);
-	char delim = '\n';
-	if (body.find('\n') == string::npos)
-		delim = ' ';
-
-	return out + delim + body;
+	bool singleLine = fitsOnLine(numeric_limits<size_t>::max(), [&]() { print(_if.body); });
+	*m_output << (singleLine ? " " : "\n");
+	print(_if.body);
 }
 
-string AsmPrinter::operator()(Switch const& _switch)
+void AsmPrinter::print(Switch const& _switch)
 {
 	yulAssert(_switch.expression, "Invalid expression pointer.");
 
-	string out = formatDebugData(_switch);
-	out += "switch " + std::visit(*this, *_switch.expression);
+	*m_output << formatDebugData(_switch) << "switch ";
+	print(*_switch.expression);
 
 	for (auto const& _case: _switch.cases)
 	{
 		if (!_case.value)
-			out += "\ndefault ";
+			*m_output << "\ndefault ";
 		else
-			out += "\ncase " + (*this)(*_case.value) + " ";
-		out += (*this)(_case.body);
+		{
+			*m_output << "\ncase ";
+			print(*_case.value);
+			*m_output << " ";
+		}
+		print(_case.body);
 	}
-	return out;
 }
 
-string AsmPrinter::operator()(ForLoop const& _forLoop)
+void AsmPrinter::print(ForLoop const& _forLoop)
 {
 	yulAssert(_forLoop.condition, "Invalid for loop condition.");
-	string const locationComment = formatDebugData(_forLoop);
+	*m_output << formatDebugData(_forLoop);
+
+	bool singleLine = fitsOnLine(59, [&]() {
+		print(_forLoop.pre);
+		print(*_forLoop.condition);
+		print(_forLoop.post);
+	});
+	string_view const delim = singleLine ? " " : "\n";
+	*m_output << "for ";
+	print(_forLoop.pre);
+	*m_output << delim;
+	print(*_forLoop.condition);
+	*m_output << delim;
+	print(_forLoop.post);
+	*m_output << "\n";
+	print(_forLoop.body);
+}
 
-	string pre = (*this)(_forLoop.pre);
-	string condition = std::visit(*this, *_forLoop.condition);
-	string post = (*this)(_forLoop.post);
+void AsmPrinter::print(Break const& _break)
+{
+	*m_output << formatDebugData(_break) << "break";
+}
 
-	char delim = '\n';
-	if (
-		pre.size() + condition.size() + post.size() < 60 &&
-		pre.find('\n') == string::npos &&
-		post.find('\n') == string::npos
-	)
-		delim = ' ';
-	return
-		locationComment +
-		("for " + move(pre) + delim + move(condition) + delim + move(post) + "\n") +
-		(*this)(_forLoop.body);
+void AsmPrinter::print(Continue const& _continue)
+{
+	*m_output << formatDebugData(_continue) << "continue";
 }
 
-string AsmPrinter::operator()(Break const& _break)
+void AsmPrinter::print(Leave const& _leave)
 {
-	return formatDebugData(_break) + "break";
+	*m_output << formatDebugData(_leave) << "leave";
 }
 
-string AsmPrinter::operator()(Continue const& _continue)
+void AsmPrinter::print(Block const& _block)
 {
-	return formatDebugData(_continue) + "continue";
+	*m_output << formatDebugData(_block);
+
+	if (_block.statements.empty())
+	{
+		*m_output << "{ }";
+		return;
+	}
+	if (
+		_block.statements.size() == 1 &&
+		fitsOnLine(29, [&]() { print(_block.statements.front()); })
+	)
+	{
+		*m_output << "{ ";
+		print(_block.statements.front());
+		*m_output << " }";
+		return;
+	}
+	*m_output << "{";
+	m_output->indent();
+	for (Statement const& statement: _block.statements)
+	{
+		// Statements of a block that does not fit are not measured any further.
+		if (m_output->exceeded())
+			break;
+		*m_output << "\n";
+		print(statement);
+	}
+	m_output->unindent();
+	*m_output << "\n}";
 }
 
-// '_leave' and '__leave' is reserved in VisualStudio
-string AsmPrinter::operator()(Leave const& leave_)
+void AsmPrinter::print(Expression const& _expression)
 {
-	return formatDebugData(leave_) + "leave";
+	if (!m_output->exceeded())
+		std::visit([&](auto const& _node) { print(_node); }, _expression);
 }
 
-string AsmPrinter::operator()(Block const& _block)
+void AsmPrinter::print(Statement const& _statement)
 {
-	string const locationComment = formatDebugData(_block);
+	if (!m_output->exceeded())
+		std::visit([&](auto const& _node) { print(_node); }, _statement);
+}
 
-	if (_block.statements.empty())
-		return locationComment + "{ }";
-	string body = boost::algorithm::join(
-		_block.statements | ranges::views::transform([&](auto&& _node) { return std::visit(*this, _node); }),
-		"\n"
-	);
-	if (body.size() < 30 && body.find('\n') == string::npos)
-		return locationComment + "{ " + body + " }";
-	else
+template <class List>
+void AsmPrinter::printList(List const& _list)
+{
+	for (size_t i = 0; i < _list.size(); ++i)
 	{
-		boost::replace_all(body, "\n", "\n    ");
-		return locationComment + "{\n    " + body + "\n}";
+		if (i > 0)
+			*m_output << ", ";
+		if constexpr (is_same_v<typename List::value_type, TypedName>)
+			*m_output << formatTypedName(_list[i]);
+		else
+			print(_list[i]);
 	}
 }
 
@@ -319,12 +393,15 @@ string AsmPrinter::formatDebugData(shared_ptr<DebugData const> const& _debugData
 	{
 		m_lastLocation = _debugData->originLocation;
 
-		items.emplace_back(formatSourceLocation(
-			_debugData->originLocation,
-			m_nameToSourceIndex,
-			m_debugInfoSelection,
-			m_soliditySourceProvider
-		));
+		auto [formatted, inserted] = m_formattedSourceLocations.try_emplace(_debugData->originLocation);
+		if (inserted)
+			formatted->second = formatSourceLocation(
+				_debugData->originLocation,
+				m_nameToSourceIndex,
+				m_debugInfoSelection,
+				m_soliditySourceProvider
+			);
+		items.emplace_back(formatted->second);
 	}
 
 	string commentBody = joinHumanReadable(items, " ");
@@ -32,7 +32,11 @@
 #include <liblangutil/DebugInfoSelection.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <functional>
 #include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
 
 namespace solidity::yul
 {
@@ -48,7 +52,7 @@ class AsmPrinter
 public:
 	explicit AsmPrinter(
 		Dialect const* _dialect = nullptr,
-		std::optional<std::map<unsigned, std::shared_ptr<std::string const>>> _sourceIndexToName = {},
+		std::optional<std::map<unsigned, std::string const*>> _sourceIndexToName = {},
 		langutil::DebugInfoSelection const& _debugInfoSelection = langutil::DebugInfoSelection::Default(),
 		langutil::CharStreamProvider const* _soliditySourceProvider = nullptr
 	):
@@ -63,7 +67,7 @@ public:
 
 	explicit AsmPrinter(
 		Dialect const& _dialect,
-		std::optional<std::map<unsigned, std::shared_ptr<std::string const>>> _sourceIndexToName = {},
+		std::optional<std::map<unsigned, std::string const*>> _sourceIndexToName = {},
 		langutil::DebugInfoSelection const& _debugInfoSelection = langutil::DebugInfoSelection::Default(),
 		langutil::CharStreamProvider const* _soliditySourceProvider = nullptr
 	): AsmPrinter(&_dialect, _sourceIndexToName, _debugInfoSelection, _soliditySourceProvider) {}
@@ -83,6 +87,10 @@ public:
 	std::string operator()(Leave const& _continue);
 	std::string operator()(Block const& _block);
 
+	/// Writes the same text as the call operator to @a _stream without building it in memory.
+	/// @a _indentation is added to every line but the first one.
+	void print(std::ostream& _stream, Block const& _block, std::string const& _indentation = {});
+
 	static std::string formatSourceLocation(
 		langutil::SourceLocation const& _location,
 		std::map<std::string, unsigned> const& _nameToSourceIndex,
@@ -91,6 +99,59 @@ public:
 	);
 
 private:
+	/// Destination of the printed text that adds the indentation after every line break.
+	/// It can also just measure the text instead, in order to decide on the layout of the
+	/// enclosing code. Then it stops as soon as it is clear that the text does not fit.
+	class Output
+	{
+	public:
+		explicit Output(std::ostream& _stream, std::string _indentation = {}):
+			m_stream(&_stream), m_indentation(std::move(_indentation))
+		{}
+		/// Creates an output that measures if the text fits on one line of @a _maxLength characters.
+		explicit Output(size_t _maxLength): m_maxLength(_maxLength) {}
+
+		Output& operator<<(std::string_view _text);
+		void indent() { m_indentation += "    "; }
+		void unindent() { m_indentation.resize(m_indentation.size() - 4); }
+		/// @returns true if the measured text does not fit. Nothing is measured any more in that case.
+		bool exceeded() const { return m_exceeded; }
+
+	private:
+		std::ostream* m_stream = nullptr;
+		std::string m_indentation;
+		size_t m_maxLength = 0;
+		size_t m_length = 0;
+		bool m_exceeded = false;
+	};
+
+	/// @returns the text of @a _node.
+	template <class Node>
+	std::string toString(Node const& _node);
+	/// @returns true if the text written by @a _print fits on one line of at most @a _maxLength
+	/// characters. Nothing is written and the state of the printer is left unchanged.
+	bool fitsOnLine(size_t _maxLength, std::function<void()> const& _print);
+
+	void print(Literal const& _literal);
+	void print(Identifier const& _identifier);
+	void print(ExpressionStatement const& _statement);
+	void print(Assignment const& _assignment);
+	void print(VariableDeclaration const& _variableDeclaration);
+	void print(FunctionDefinition const& _functionDefinition);
+	void print(FunctionCall const& _functionCall);
+	void print(If const& _if);
+	void print(Switch const& _switch);
+	void print(ForLoop const& _forLoop);
+	void print(Break const& _break);
+	void print(Continue const& _continue);
+	void print(Leave const& _leave);
+	void print(Block const& _block);
+	void print(Expression const& _expression);
+	void print(Statement const& _statement);
+	/// Prints the elements of @a _list separated by ", ".
+	template <class List>
+	void printList(List const& _list);
+
 	std::string formatTypedName(TypedName _variable);
 	std::string appendTypeName(YulString _type, bool _isBoolLiteral = false) const;
 	std::string formatDebugData(std::shared_ptr<DebugData const> const& _debugData, bool _statement);
@@ -101,9 +162,12 @@ private:
 		return formatDebugData(_node.debugData, !isExpression);
 	}
 
+	Output* m_output = nullptr;
 	Dialect const* const m_dialect = nullptr;
 	std::map<std::string, unsigned> m_nameToSourceIndex;
 	langutil::SourceLocation m_lastLocation = {};
+	/// Results of formatSourceLocation, since the same locations occur many times in large code.
+	std::map<langutil::SourceLocation, std::string> m_formattedSourceLocations;
 	langutil::DebugInfoSelection m_debugInfoSelection = {};
 	langutil::CharStreamProvider const* m_soliditySourceProvider = nullptr;
 };
@@ -0,0 +1,46 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/AssemblyCache.h>
+
+#include <libevmasm/Assembly.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+optional<EVMAssemblyCache::Entry> EVMAssemblyCache::find(util::h256 const& _key) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_entries.find(_key);
+	if (it == m_entries.end())
+		return nullopt;
+	return it->second;
+}
+
+void EVMAssemblyCache::store(util::h256 const& _key, Entry _entry)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.emplace(_key, move(_entry));
+}
+
+size_t EVMAssemblyCache::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_entries.size();
+}
@@ -0,0 +1,69 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * In-memory cache of the EVM assemblies generated from Yul objects.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace solidity::evmasm
+{
+class Assembly;
+}
+
+namespace solidity::yul
+{
+
+/**
+ * Cache of the EVM assemblies generated from Yul objects that can be shared by the assembly
+ * stacks of one compilation job, so that identical objects are only compiled and assembled once.
+ * The key of an entry is a hash of the optimised object and everything its assembly depends on.
+ *
+ * The assemblies of an entry have to be assembled before they are stored, so that they are
+ * not modified any more. The cache can then be used by several threads at the same time.
+ */
+class EVMAssemblyCache
+{
+public:
+	struct Entry
+	{
+		std::shared_ptr<evmasm::Assembly> assembly;
+		/// The assembly of the deployed object or nullptr if there is none.
+		std::shared_ptr<evmasm::Assembly> runtimeAssembly;
+	};
+
+	/// @returns the entry stored under @a _key or an empty optional if there is none.
+	std::optional<Entry> find(util::h256 const& _key) const;
+	/// Stores @a _entry under @a _key, unless there is an entry already.
+	void store(util::h256 const& _key, Entry _entry);
+
+	size_t size() const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<util::h256, Entry> m_entries;
+};
+
+}
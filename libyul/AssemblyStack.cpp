@@ -23,8 +23,10 @@
 
 #include <libyul/AssemblyStack.h>
 
+#include <libyul/AssemblyCache.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
+#include <libyul/backends/evm/BytecodeAssembly.h>
 #include <libyul/backends/evm/EthAssemblyAdapter.h>
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/EVMDialect.h>
@@ -34,10 +36,19 @@
 #include <libyul/backends/wasm/WasmObjectCompiler.h>
 #include <libyul/backends/wasm/EVMToEwasmTranslator.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <libevmasm/Assembly.h>
+#include <libevmasm/GasMeter.h>
 #include <liblangutil/Scanner.h>
+
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/Parallel.h>
+
+#include <chrono>
+#include <functional>
 #include <optional>
 
 using namespace std;
@@ -71,20 +82,34 @@ evmasm::Assembly::OptimiserSettings translateOptimiserSettings(
 )
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, _evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false, false,  false, false, false, false, false, _evmVersion, 0, 1, 0, chrono::milliseconds{0}, false, false};
 	asmSettings.isCreation = true;
 	asmSettings.runInliner = _settings.runInliner;
+	asmSettings.inlinerCallSiteCostModel = _settings.inlinerCallSiteCostModel;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
 	asmSettings.runCSE = _settings.runCSE;
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
+	asmSettings.maxIterations = _settings.evmasmMaxIterations;
+	asmSettings.timeBudget = chrono::milliseconds(_settings.evmasmTimeBudget);
 	asmSettings.evmVersion = _evmVersion;
 
 	return asmSettings;
 }
 
+bool runsEVMAssemblyOptimiser(frontend::OptimiserSettings const& _settings)
+{
+	return
+		_settings.runInliner ||
+		_settings.runJumpdestRemover ||
+		_settings.runPeephole ||
+		_settings.runDeduplicate ||
+		_settings.runCSE ||
+		_settings.runConstantOptimiser;
+}
+
 }
 
 
@@ -110,6 +135,12 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 	return analyzeParsed();
 }
 
+void AssemblyStack::setParallelism(size_t _parallelism)
+{
+	yulAssert(_parallelism > 0, "");
+	m_parallelism = _parallelism;
+}
+
 void AssemblyStack::optimize()
 {
 	if (!m_optimiserSettings.runYulOptimiser)
@@ -120,7 +151,12 @@ void AssemblyStack::optimize()
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
 	optimize(*m_parserResult, true);
+#ifdef NDEBUG
+	// The optimiser suite already rebuilt the analysis info of every object.
+	m_analysisSuccessful = true;
+#else
 	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
+#endif
 }
 
 void AssemblyStack::translate(AssemblyStack::Language _targetLanguage)
@@ -185,30 +221,131 @@ void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) cons
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize);
+	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, m_parallelism);
 }
 
 void AssemblyStack::optimize(Object& _object, bool _isCreation)
+{
+	// The optimisation of an object only reads the names of its sub-objects, so all objects of
+	// the tree can be optimised independently. They are listed in post-order, which is the order
+	// of the sequential optimisation and thus also determines which error is reported first.
+	vector<pair<Object*, bool>> objects;
+	function<void(Object&, bool)> collect = [&](Object& _current, bool _creation)
+	{
+		for (auto& subNode: _current.subObjects)
+			if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+				collect(*subObject, false);
+		objects.emplace_back(&_current, _creation);
+	};
+	collect(_object, _isCreation);
+
+	// The threads that are not needed for the objects themselves are used by the optimiser
+	// to process the functions of each object concurrently.
+	size_t parallelismPerObject = max<size_t>(1, m_parallelism / objects.size());
+	util::parallelFor(objects.size(), m_parallelism, [&](size_t _index) {
+		optimizeCode(*objects[_index].first, objects[_index].second, parallelismPerObject);
+	});
+}
+
+namespace
+{
+
+/// @returns a rough estimate of the gas needed to deploy @a _code and to run it @a _runs times,
+/// which is used to compare the results of different sequences of optimisation steps.
+bigint estimatedCosts(EVMDialect const& _dialect, Block const& _code, bool _isCreation, size_t _runs)
+{
+	bigint const dataGas = _isCreation ?
+		evmasm::GasCosts::txDataNonZeroGas(_dialect.evmVersion()) :
+		evmasm::GasCosts::createDataGas;
+	return
+		bigint(CodeCost::codeCost(_dialect, _code)) * (_isCreation ? 1 : _runs) +
+		bigint(CodeSize::codeSizeIncludingFunctions(_code)) * dataGas;
+}
+
+}
+
+void AssemblyStack::optimizeCode(Object& _object, bool _isCreation, size_t _parallelism) const
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
-	for (auto& subNode: _object.subObjects)
-		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-			optimize(*subObject, false);
 
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect);
 	unique_ptr<GasMeter> meter;
-	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
+	if (evmDialect)
 		meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
-	OptimiserSuite::run(
-		dialect,
-		meter.get(),
-		_object,
-		m_optimiserSettings.optimizeStackAllocation,
-		m_optimiserSettings.yulOptimiserSteps,
-		_isCreation ? nullopt : make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
-		{}
-	);
+	auto optimizeWith = [&](
+		Object& _target,
+		string_view _sequence,
+		util::TimingCollector* _stepTimings,
+		size_t _threads,
+		optional<chrono::steady_clock::time_point> _deadline
+	)
+	{
+		OptimiserSuite::run(
+			dialect,
+			meter.get(),
+			_target,
+			m_optimiserSettings.optimizeStackAllocation,
+			_sequence,
+			_isCreation ? nullopt : make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
+			{},
+			_stepTimings,
+			_threads,
+			_deadline
+		);
+	};
+
+	vector<string> const& candidateSteps = m_optimiserSettings.yulOptimiserCandidateSteps;
+	// The costs of the results can only be compared for EVM code.
+	if (candidateSteps.empty() || !evmDialect)
+	{
+		optimizeWith(_object, m_optimiserSettings.yulOptimiserSteps, m_optimiserStepTimings, _parallelism, nullopt);
+		return;
+	}
+
+	// The object itself is optimised with the sequence of the settings, which is never abandoned,
+	// and every candidate sequence is run on a copy of it.
+	vector<Object> candidates(candidateSteps.size(), _object);
+	for (Object& candidate: candidates)
+	{
+		candidate.code = make_shared<Block>(ASTCopier{}.translate(*_object.code));
+		candidate.analysisInfo = make_shared<AsmAnalysisInfo>(AsmAnalyzer::analyzeStrictAssertCorrect(dialect, candidate));
+	}
+	optional<chrono::steady_clock::time_point> deadline;
+	if (m_optimiserSettings.yulOptimiserCandidateTimeBudget > 0)
+		deadline = chrono::steady_clock::now() + chrono::milliseconds(m_optimiserSettings.yulOptimiserCandidateTimeBudget);
+
+	// The costs of the results, where the first one belongs to the object itself and
+	// the candidates that were abandoned have none.
+	vector<optional<bigint>> costs(candidates.size() + 1);
+	size_t const threadsPerSequence = max<size_t>(1, _parallelism / costs.size());
+	util::parallelFor(costs.size(), _parallelism, [&](size_t _index) {
+		Object& target = _index == 0 ? _object : candidates[_index - 1];
+		try
+		{
+			if (_index == 0)
+				optimizeWith(target, m_optimiserSettings.yulOptimiserSteps, m_optimiserStepTimings, threadsPerSequence, nullopt);
+			else
+				optimizeWith(target, candidateSteps[_index - 1], nullptr, threadsPerSequence, deadline);
+		}
+		catch (OptimizerTimeout const&)
+		{
+			return;
+		}
+		costs[_index] = estimatedCosts(*evmDialect, *target.code, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
+	});
+
+	// Earlier sequences are preferred if the costs are equal, so the result is deterministic.
+	size_t best = 0;
+	for (size_t i = 1; i < costs.size(); ++i)
+		if (costs[i] && *costs[i] < *costs[best])
+			best = i;
+	if (best > 0)
+	{
+		_object.code = std::move(candidates[best - 1].code);
+		_object.analysisInfo = std::move(candidates[best - 1].analysisInfo);
+	}
 }
 
 MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
@@ -228,7 +365,7 @@ MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
 		Dialect const& dialect = languageToDialect(m_language, EVMVersion{});
 
 		MachineAssemblyObject object;
-		auto result = WasmObjectCompiler::compile(*m_parserResult, dialect);
+		auto result = WasmObjectCompiler::compile(*m_parserResult, dialect, m_parallelism);
 		object.assembly = std::move(result.first);
 		object.bytecode = make_shared<evmasm::LinkerObject>();
 		object.bytecode->bytecode = std::move(result.second);
@@ -242,6 +379,9 @@ MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
 std::pair<MachineAssemblyObject, MachineAssemblyObject>
 AssemblyStack::assembleWithDeployed(optional<string_view> _deployName) const
 {
+	if (m_directBytecodeGeneration && !runsEVMAssemblyOptimiser(m_optimiserSettings))
+		return assembleBytecodeWithDeployed(_deployName);
+
 	auto [creationAssembly, deployedAssembly] = assembleEVMWithDeployed(_deployName);
 	yulAssert(creationAssembly, "");
 	yulAssert(m_charStream, "");
@@ -273,6 +413,50 @@ AssemblyStack::assembleWithDeployed(optional<string_view> _deployName) const
 	return {std::move(creationObject), std::move(deployedObject)};
 }
 
+std::pair<MachineAssemblyObject, MachineAssemblyObject>
+AssemblyStack::assembleBytecodeWithDeployed(optional<string_view> _deployName) const
+{
+	yulAssert(m_analysisSuccessful, "");
+	yulAssert(m_parserResult, "");
+	yulAssert(m_parserResult->code, "");
+	yulAssert(m_parserResult->analysisInfo, "");
+	yulAssert(m_charStream, "");
+
+	BytecodeAssembly assembly({{m_charStream->name(), 0}});
+	compileEVM(assembly, m_optimiserSettings.optimizeStackAllocation);
+
+	// The deployed object is picked like in assembleEVMWithDeployed.
+	optional<size_t> subIndex;
+	if (_deployName.has_value())
+	{
+		for (size_t i = 0; i < assembly.numSubs(); i++)
+			if (assembly.sub(i).name() == _deployName)
+			{
+				subIndex = i;
+				break;
+			}
+
+		solAssert(subIndex.has_value(), "Failed to find object to be deployed.");
+	}
+	else if (assembly.numSubs() == 1)
+		subIndex = 0;
+
+	MachineAssemblyObject creationObject;
+	creationObject.bytecode = make_shared<evmasm::LinkerObject>(assembly.assemble());
+	yulAssert(creationObject.bytecode->immutableReferences.empty(), "Leftover immutables.");
+	creationObject.sourceMappings = make_unique<string>(assembly.sourceMapping());
+
+	MachineAssemblyObject deployedObject;
+	if (subIndex.has_value())
+	{
+		BytecodeAssembly& deployedAssembly = assembly.sub(*subIndex);
+		deployedObject.bytecode = make_shared<evmasm::LinkerObject>(deployedAssembly.assemble());
+		deployedObject.sourceMappings = make_unique<string>(deployedAssembly.sourceMapping());
+	}
+
+	return {std::move(creationObject), std::move(deployedObject)};
+}
+
 std::pair<std::shared_ptr<evmasm::Assembly>, std::shared_ptr<evmasm::Assembly>>
 AssemblyStack::assembleEVMWithDeployed(optional<string_view> _deployName) const
 {
@@ -281,11 +465,21 @@ AssemblyStack::assembleEVMWithDeployed(optional<string_view> _deployName) const
 	yulAssert(m_parserResult->code, "");
 	yulAssert(m_parserResult->analysisInfo, "");
 
+	optional<util::h256> cacheKey;
+	if (m_assemblyCache)
+	{
+		cacheKey = assemblyCacheKey(_deployName);
+		if (optional<EVMAssemblyCache::Entry> entry = m_assemblyCache->find(*cacheKey))
+			return {entry->assembly, entry->runtimeAssembly};
+	}
+
 	evmasm::Assembly assembly;
 	EthAssemblyAdapter adapter(assembly);
 	compileEVM(adapter, m_optimiserSettings.optimizeStackAllocation);
 
-	assembly.optimise(translateOptimiserSettings(m_optimiserSettings, m_evmVersion));
+	evmasm::Assembly::OptimiserSettings asmSettings = translateOptimiserSettings(m_optimiserSettings, m_evmVersion);
+	asmSettings.parallelism = m_parallelism;
+	assembly.optimise(asmSettings);
 
 	optional<size_t> subIndex;
 
@@ -305,13 +499,52 @@ AssemblyStack::assembleEVMWithDeployed(optional<string_view> _deployName) const
 	else if (assembly.numSubs() == 1)
 		subIndex = 0;
 
+	shared_ptr<evmasm::Assembly> creationAssembly = make_shared<evmasm::Assembly>(assembly);
+	shared_ptr<evmasm::Assembly> deployedAssembly;
 	if (subIndex.has_value())
-	{
-		evmasm::Assembly& runtimeAssembly = assembly.sub(*subIndex);
-		return {make_shared<evmasm::Assembly>(assembly), make_shared<evmasm::Assembly>(runtimeAssembly)};
-	}
+		deployedAssembly = make_shared<evmasm::Assembly>(assembly.sub(*subIndex));
+
+	if (m_assemblyCache)
+		try
+		{
+			// Assemble before the entry is shared, so that the assemblies are not modified later.
+			creationAssembly->assemble();
+			if (deployedAssembly)
+				deployedAssembly->assemble();
+			m_assemblyCache->store(*cacheKey, {creationAssembly, deployedAssembly});
+		}
+		catch (evmasm::AssemblyException const&)
+		{
+			// Do not cache the assemblies, the caller reports the error when assembling them.
+		}
+
+	return {move(creationAssembly), move(deployedAssembly)};
+}
 
-	return {make_shared<evmasm::Assembly>(assembly), {}};
+util::h256 AssemblyStack::assemblyCacheKey(optional<string_view> _deployName) const
+{
+	yulAssert(m_parserResult, "");
+	// Everything the assemblies depend on besides the object itself.
+	string key =
+		to_string(static_cast<int>(m_language)) + " " +
+		m_evmVersion.name() + " " +
+		(_deployName ? "deploy:" + string(*_deployName) : "no-deploy") + " " +
+		to_string(m_optimiserSettings.runInliner) +
+		to_string(m_optimiserSettings.runJumpdestRemover) +
+		to_string(m_optimiserSettings.runPeephole) +
+		to_string(m_optimiserSettings.runDeduplicate) +
+		to_string(m_optimiserSettings.runCSE) +
+		to_string(m_optimiserSettings.runConstantOptimiser) +
+		to_string(m_optimiserSettings.optimizeStackAllocation) + " " +
+		to_string(m_optimiserSettings.expectedExecutionsPerDeployment) + " " +
+		to_string(m_optimiserSettings.evmasmMaxIterations) + " " +
+		to_string(m_optimiserSettings.evmasmTimeBudget) + "\n";
+	// Source locations that are not given by comments refer to the parsed source.
+	if (m_charStream)
+		key += m_charStream->name() + "\n" + string(m_charStream->source()) + "\n";
+	// The assemblies contain the source locations, so they have to be part of the key.
+	key += m_parserResult->toString(&languageToDialect(m_language, m_evmVersion), DebugInfoSelection::All());
+	return util::keccak256(key);
 }
 
 string AssemblyStack::print(
@@ -34,6 +34,8 @@
 
 #include <libevmasm/LinkerObject.h>
 
+#include <libsolutil/FixedHash.h>
+
 #include <memory>
 #include <string>
 
@@ -47,10 +49,15 @@ namespace solidity::langutil
 class Scanner;
 }
 
+namespace solidity::util
+{
+class TimingCollector;
+}
+
 namespace solidity::yul
 {
 class AbstractAssembly;
-
+class EVMAssemblyCache;
 
 struct MachineAssemblyObject
 {
@@ -98,6 +105,26 @@ public:
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Sets the maximum number of threads used by @a optimize and by the assembly step. If it is
+	/// larger than one, an object and its sub-objects are optimised in parallel and the stack layouts
+	/// of the functions are computed in parallel during code generation. The result does not depend
+	/// on this setting.
+	void setParallelism(size_t _parallelism);
+
+	/// Sets the collector of the time spent in each optimiser step during @a optimize.
+	/// It has to outlive this object.
+	void setOptimiserStepTimings(util::TimingCollector* _timings) { m_optimiserStepTimings = _timings; }
+
+	/// Sets the cache used by @a assembleEVMWithDeployed and thus by @a assemble to reuse the
+	/// assembly of an identical object. It has to outlive this object.
+	void setAssemblyCache(EVMAssemblyCache* _cache) { m_assemblyCache = _cache; }
+
+	/// Sets whether @a assemble and @a assembleWithDeployed write the bytecode directly instead of
+	/// building and assembling an evmasm assembly, if the settings disable all steps of the evmasm
+	/// optimiser. The bytecode and the source mappings are the same, but the textual assembly of
+	/// the returned objects is empty.
+	void setDirectBytecodeGeneration(bool _enabled) { m_directBytecodeGeneration = _enabled; }
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
@@ -142,12 +169,26 @@ private:
 
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
 
+	/// Implements @a assembleWithDeployed using a BytecodeAssembly.
+	std::pair<MachineAssemblyObject, MachineAssemblyObject>
+	assembleBytecodeWithDeployed(std::optional<std::string_view> _deployName) const;
+
+	/// @returns the key of the EVM assembly of the current object in the assembly cache.
+	util::h256 assemblyCacheKey(std::optional<std::string_view> _deployName) const;
+
 	void optimize(yul::Object& _object, bool _isCreation);
+	/// Optimises the code of @a _object without its sub-objects.
+	/// @param _parallelism the number of threads available for optimising this object.
+	void optimizeCode(yul::Object& _object, bool _isCreation, size_t _parallelism) const;
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
 	langutil::DebugInfoSelection m_debugInfoSelection{};
+	size_t m_parallelism = 1;
+	util::TimingCollector* m_optimiserStepTimings = nullptr;
+	EVMAssemblyCache* m_assemblyCache = nullptr;
+	bool m_directBytecodeGeneration = false;
 
 	std::unique_ptr<langutil::CharStream> m_charStream;
 
@@ -26,43 +26,93 @@
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
+#include <libyul/optimiser/ASTCopier.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 
+namespace
+{
+
+/// @returns a copy of the grouped code @a _code in which only the main block and the functions
+/// in @a _functionsToCheck keep their bodies.
+Block reducedCode(Block const& _code, set<YulString> const& _functionsToCheck)
+{
+	Block reduced{_code.debugData, {}};
+	for (size_t index = 0; index < _code.statements.size(); ++index)
+	{
+		Statement const& statement = _code.statements[index];
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+		{
+			if (_functionsToCheck.count(function->name))
+				reduced.statements.emplace_back(ASTCopier{}(*function));
+			else
+				reduced.statements.emplace_back(FunctionDefinition{
+					function->debugData,
+					function->name,
+					function->parameters,
+					function->returnVariables,
+					Block{function->body.debugData, {}}
+				});
+		}
+		else if (index == 0 && holds_alternative<Block>(statement) && !_functionsToCheck.count(YulString{}))
+			reduced.statements.emplace_back(Block{std::get<Block>(statement).debugData, {}});
+		else
+			reduced.statements.emplace_back(ASTCopier{}.translate(statement));
+	}
+	return reduced;
+}
+
+}
+
 CompilabilityChecker::CompilabilityChecker(
 	Dialect const& _dialect,
 	Object const& _object,
-	bool _optimizeStackAllocation
+	bool _optimizeStackAllocation,
+	optional<set<YulString>> const& _functionsToCheck
 )
 {
 	if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect))
 	{
 		NoOutputEVMDialect noOutputDialect(*evmDialect);
 
+		Object const* object = &_object;
+		Object reducedObject;
+		if (_functionsToCheck)
+		{
+			reducedObject = _object;
+			reducedObject.code = make_shared<Block>(reducedCode(*_object.code, *_functionsToCheck));
+			reducedObject.analysisInfo = nullptr;
+			object = &reducedObject;
+		}
+
 		yul::AsmAnalysisInfo analysisInfo =
-			yul::AsmAnalyzer::analyzeStrictAssertCorrect(noOutputDialect, _object);
+			yul::AsmAnalyzer::reanalyzeAssertCorrect(noOutputDialect, *object);
 
 		BuiltinContext builtinContext;
-		builtinContext.currentObject = &_object;
-		if (!_object.name.empty())
-			builtinContext.subIDs[_object.name] = 1;
-		for (auto const& subNode: _object.subObjects)
+		builtinContext.currentObject = object;
+		if (!object->name.empty())
+			builtinContext.subIDs[object->name] = 1;
+		for (auto const& subNode: object->subObjects)
 			builtinContext.subIDs[subNode->name] = 1;
 		NoOutputAssembly assembly;
 		CodeTransform transform(
 			assembly,
 			analysisInfo,
-			*_object.code,
+			*object->code,
 			noOutputDialect,
 			builtinContext,
 			_optimizeStackAllocation
 		);
-		transform(*_object.code);
+		transform(*object->code);
 
 		for (StackTooDeepError const& error: transform.stackErrors())
 		{
+			// Only the checked functions are reported, the stubs of the others do not matter.
+			if (_functionsToCheck && !_functionsToCheck->count(error.functionName))
+				continue;
 			unreachableVariables[error.functionName].emplace(error.variable);
 			int& deficit = stackDeficit[error.functionName];
 			deficit = std::max(error.depth, deficit);
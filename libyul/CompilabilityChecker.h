@@ -27,6 +27,8 @@
 
 #include <map>
 #include <memory>
+#include <optional>
+#include <set>
 
 namespace solidity::yul
 {
@@ -41,10 +43,21 @@ namespace solidity::yul
  * functions are not nested. Otherwise, it might miss reporting some functions.
  *
  * Only checks the code of the object itself, does not descend into sub-objects.
+ *
+ * If @a _functionsToCheck is given, the code has to be in the form produced by the function
+ * grouper and only the functions with the given names are checked, where the empty name
+ * stands for the main block. All other bodies are replaced by empty blocks before the
+ * code is transformed, which is sufficient since the stack of a function does not depend on
+ * the other functions.
  */
 struct CompilabilityChecker
 {
-	CompilabilityChecker(Dialect const& _dialect, Object const& _object, bool _optimizeStackAllocation);
+	CompilabilityChecker(
+		Dialect const& _dialect,
+		Object const& _object,
+		bool _optimizeStackAllocation,
+		std::optional<std::set<YulString>> const& _functionsToCheck = std::nullopt
+	);
 	std::map<YulString, std::set<YulString>> unreachableVariables;
 	std::map<YulString, int> stackDeficit;
 };
@@ -0,0 +1,56 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/DebugDataPool.h>
+
+#include <boost/functional/hash.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+
+shared_ptr<DebugData const> DebugDataPool::create(
+	SourceLocation const& _nativeLocation,
+	SourceLocation const& _originLocation,
+	optional<int64_t> _astID
+)
+{
+	auto [it, inserted] = m_debugData.try_emplace(Key{_nativeLocation, _originLocation, _astID});
+	if (inserted)
+		it->second = allocate_shared<DebugData const>(
+			util::ArenaAllocator<DebugData const>(m_arena),
+			_nativeLocation,
+			_originLocation,
+			_astID
+		);
+	return it->second;
+}
+
+size_t DebugDataPool::KeyHash::operator()(Key const& _key) const
+{
+	size_t seed = 0;
+	for (SourceLocation const* location: {&_key.nativeLocation, &_key.originLocation})
+	{
+		boost::hash_combine(seed, location->sourceName);
+		boost::hash_combine(seed, location->start);
+		boost::hash_combine(seed, location->end);
+	}
+	boost::hash_combine(seed, _key.astID.value_or(-1));
+	return seed;
+}
@@ -0,0 +1,80 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Shared creation of the debug data of Yul AST nodes.
+ */
+
+#pragma once
+
+#include <libyul/AST.h>
+
+#include <libsolutil/Arena.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+namespace solidity::yul
+{
+
+/**
+ * Creates the debug data of the nodes of a Yul AST. Equal debug data is created only once
+ * and shared between all the nodes it is requested for. The objects are allocated from an
+ * arena, which is released once the last of them is destroyed.
+ * Not thread-safe.
+ */
+class DebugDataPool
+{
+public:
+	DebugDataPool(): m_arena(std::make_shared<util::Arena>(16 * 1024)) {}
+
+	std::shared_ptr<DebugData const> create(
+		langutil::SourceLocation const& _nativeLocation,
+		langutil::SourceLocation const& _originLocation = {},
+		std::optional<int64_t> _astID = {}
+	);
+
+	/// @returns the number of distinct debug data objects created so far.
+	size_t size() const { return m_debugData.size(); }
+
+private:
+	struct Key
+	{
+		langutil::SourceLocation nativeLocation;
+		langutil::SourceLocation originLocation;
+		std::optional<int64_t> astID;
+
+		bool operator==(Key const& _other) const
+		{
+			return
+				nativeLocation == _other.nativeLocation &&
+				originLocation == _other.originLocation &&
+				astID == _other.astID;
+		}
+	};
+	struct KeyHash
+	{
+		size_t operator()(Key const& _key) const;
+	};
+
+	std::shared_ptr<util::Arena> m_arena;
+	std::unordered_map<Key, std::shared_ptr<DebugData const>, KeyHash> m_debugData;
+};
+
+}
@@ -22,6 +22,8 @@
 #include <libyul/Dialect.h>
 #include <libyul/AST.h>
 
+#include <libsolutil/LazyInit.h>
+
 using namespace solidity::yul;
 using namespace std;
 using namespace solidity::langutil;
@@ -52,16 +54,15 @@ bool Dialect::validTypeForLiteral(LiteralKind _kind, YulString, YulString _type)
 
 Dialect const& Dialect::yulDeprecated()
 {
-	static unique_ptr<Dialect> dialect;
+	static solidity::util::ConcurrentLazyInit<unique_ptr<Dialect const>> dialect;
 	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
 
-	if (!dialect)
-	{
+	return *dialect.init([] {
 		// TODO will probably change, especially the list of types.
-		dialect = make_unique<Dialect>();
-		dialect->defaultType = "u256"_yulstring;
-		dialect->boolType = "bool"_yulstring;
-		dialect->types = {
+		auto result = make_unique<Dialect>();
+		result->defaultType = "u256"_yulstring;
+		result->boolType = "bool"_yulstring;
+		result->types = {
 			"bool"_yulstring,
 			"u8"_yulstring,
 			"s8"_yulstring,
@@ -74,7 +75,6 @@ Dialect const& Dialect::yulDeprecated()
 			"u256"_yulstring,
 			"s256"_yulstring
 		};
-	};
-
-	return *dialect;
+		return unique_ptr<Dialect const>(move(result));
+	});
 }
@@ -35,6 +35,8 @@ namespace solidity::yul
 
 struct YulException: virtual util::Exception {};
 struct OptimizerException: virtual YulException {};
+/// Thrown by the optimiser suite if its deadline passed before the optimisation was finished.
+struct OptimizerTimeout: virtual YulException {};
 struct CodegenException: virtual YulException {};
 struct YulAssertion: virtual YulException {};
 
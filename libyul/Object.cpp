@@ -33,27 +33,28 @@
 
 #include <range/v3/view/transform.hpp>
 
+#include <sstream>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
 using namespace solidity::util;
 using namespace solidity::yul;
 
-namespace
-{
-
-string indent(std::string const& _input)
+string Data::toString(Dialect const*, DebugInfoSelection const&, CharStreamProvider const*) const
 {
-	if (_input.empty())
-		return _input;
-	return boost::replace_all_copy("    " + _input, "\n", "\n    ");
-}
-
+	return "data \"" + name.str() + "\" hex\"" + util::toHex(data) + "\"";
 }
 
-string Data::toString(Dialect const*, DebugInfoSelection const&, CharStreamProvider const*) const
+void Data::print(
+	ostream& _stream,
+	Dialect const* _dialect,
+	DebugInfoSelection const& _debugInfoSelection,
+	CharStreamProvider const* _soliditySourceProvider,
+	string const&
+) const
 {
-	return "data \"" + name.str() + "\" hex\"" + util::toHex(data) + "\"";
+	_stream << toString(_dialect, _debugInfoSelection, _soliditySourceProvider);
 }
 
 string Object::toString(
@@ -61,31 +62,48 @@ string Object::toString(
 	DebugInfoSelection const& _debugInfoSelection,
 	CharStreamProvider const* _soliditySourceProvider
 ) const
+{
+	ostringstream stream;
+	print(stream, _dialect, _debugInfoSelection, _soliditySourceProvider);
+	return stream.str();
+}
+
+void Object::print(
+	ostream& _stream,
+	Dialect const* _dialect,
+	DebugInfoSelection const& _debugInfoSelection,
+	CharStreamProvider const* _soliditySourceProvider,
+	string const& _indentation
+) const
 {
 	yulAssert(code, "No code");
 	yulAssert(debugData, "No debug data");
 
-	string useSrcComment;
-
 	if (debugData->sourceNames)
-		useSrcComment =
-			"/// @use-src " +
+		_stream <<
+			"/// @use-src " <<
 			joinHumanReadable(ranges::views::transform(*debugData->sourceNames, [](auto&& _pair) {
 				return to_string(_pair.first) + ":" + util::escapeAndQuoteString(*_pair.second);
-			})) +
-			"\n";
+			})) <<
+			"\n" <<
+			_indentation;
 
-	string inner = "code " + AsmPrinter(
+	string const innerIndentation = _indentation + "    ";
+	_stream << "object \"" << name.str() << "\" {\n" << innerIndentation << "code ";
+	AsmPrinter(
 		_dialect,
 		debugData->sourceNames,
 		_debugInfoSelection,
 		_soliditySourceProvider
-	)(*code);
+	).print(_stream, *code, innerIndentation);
 
 	for (auto const& obj: subObjects)
-		inner += "\n" + obj->toString(_dialect, _debugInfoSelection, _soliditySourceProvider);
+	{
+		_stream << "\n" << innerIndentation;
+		obj->print(_stream, _dialect, _debugInfoSelection, _soliditySourceProvider, innerIndentation);
+	}
 
-	return useSrcComment + "object \"" + name.str() + "\" {\n" + indent(inner) + "\n}";
+	_stream << "\n" << _indentation << "}";
 }
 
 set<YulString> Object::qualifiedDataNames() const
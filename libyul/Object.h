@@ -30,8 +30,10 @@
 #include <libsolutil/Common.h>
 
 #include <memory>
+#include <ostream>
 #include <set>
 #include <limits>
+#include <string>
 
 namespace solidity::yul
 {
@@ -39,7 +41,7 @@ struct Dialect;
 struct AsmAnalysisInfo;
 
 
-using SourceNameMap = std::map<unsigned, std::shared_ptr<std::string const>>;
+using SourceNameMap = std::map<unsigned, std::string const*>;
 
 struct Object;
 
@@ -58,6 +60,15 @@ struct ObjectNode
 		langutil::DebugInfoSelection const& _debugInfoSelection,
 		langutil::CharStreamProvider const* _soliditySourceProvider
 	) const = 0;
+	/// Writes the same text as @a toString to @a _stream without building it in memory.
+	/// @a _indentation is added to every line but the first one.
+	virtual void print(
+		std::ostream& _stream,
+		Dialect const* _dialect,
+		langutil::DebugInfoSelection const& _debugInfoSelection,
+		langutil::CharStreamProvider const* _soliditySourceProvider,
+		std::string const& _indentation
+	) const = 0;
 };
 
 /**
@@ -74,6 +85,13 @@ struct Data: public ObjectNode
 		langutil::DebugInfoSelection const& _debugInfoSelection,
 		langutil::CharStreamProvider const* _soliditySourceProvider
 	) const override;
+	void print(
+		std::ostream& _stream,
+		Dialect const* _dialect,
+		langutil::DebugInfoSelection const& _debugInfoSelection,
+		langutil::CharStreamProvider const* _soliditySourceProvider,
+		std::string const& _indentation
+	) const override;
 };
 
 
@@ -94,7 +112,16 @@ public:
 		Dialect const* _dialect,
 		langutil::DebugInfoSelection const& _debugInfoSelection = langutil::DebugInfoSelection::Default(),
 		langutil::CharStreamProvider const* _soliditySourceProvider = nullptr
-	) const;
+	) const override;
+	/// Writes the string representation to @a _stream piece by piece, which avoids building
+	/// the text of large objects in memory.
+	void print(
+		std::ostream& _stream,
+		Dialect const* _dialect,
+		langutil::DebugInfoSelection const& _debugInfoSelection = langutil::DebugInfoSelection::Default(),
+		langutil::CharStreamProvider const* _soliditySourceProvider = nullptr,
+		std::string const& _indentation = {}
+	) const override;
 
 	/// @returns the set of names of data objects accessible from within the code of
 	/// this object, including the name of object itself
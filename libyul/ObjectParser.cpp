@@ -30,7 +30,7 @@
 
 #include <libsolutil/StringUtils.h>
 
-#include <regex>
+#include <cctype>
 
 using namespace std;
 using namespace solidity;
@@ -124,17 +124,24 @@ optional<SourceNameMap> ObjectParser::tryParseSourceNameMapping() const
 	// UseSrc     := [0-9]+ ':' FileName
 	// FileName   := "(([^\"]|\.)*)"
 
-	// Matches some "@use-src TEXT".
-	static std::regex const lineRE = std::regex(
-		"(^|\\s)@use-src\\b",
-		std::regex_constants::ECMAScript | std::regex_constants::optimize
-	);
-	std::smatch sm;
-	if (!std::regex_search(m_scanner->currentCommentLiteral(), sm, lineRE))
+	// Finds "@use-src TEXT", where @use-src is preceded by white space or the start of the comment
+	// and not followed by a word character.
+	string const& comment = m_scanner->currentCommentLiteral();
+	string const tag = "@use-src";
+	size_t position = comment.find(tag);
+	for (; position != string::npos; position = comment.find(tag, position + 1))
+	{
+		size_t const end = position + tag.size();
+		if (
+			(position == 0 || isspace(static_cast<unsigned char>(comment[position - 1]))) &&
+			(end == comment.size() || !(isalnum(static_cast<unsigned char>(comment[end])) || comment[end] == '_'))
+		)
+			break;
+	}
+	if (position == string::npos)
 		return nullopt;
 
-	solAssert(sm.size() == 2, "");
-	auto text = m_scanner->currentCommentLiteral().substr(static_cast<size_t>(sm.position() + sm.length()));
+	auto text = comment.substr(position + tag.size());
 	CharStream charStream(text, "");
 	Scanner scanner(charStream);
 	if (scanner.currentToken() == Token::EOS)
@@ -145,14 +152,14 @@ optional<SourceNameMap> ObjectParser::tryParseSourceNameMapping() const
 	{
 		if (scanner.currentToken() != Token::Number)
 			break;
-		auto sourceIndex = toUnsignedInt(scanner.currentLiteral());
+		auto sourceIndex = toUnsignedInt(string(scanner.currentLiteral()));
 		if (!sourceIndex)
 			break;
 		if (scanner.next() != Token::Colon)
 			break;
 		if (scanner.next() != Token::StringLiteral)
 			break;
-		sourceNames[*sourceIndex] = make_shared<string const>(scanner.currentLiteral());
+		sourceNames[*sourceIndex] = internSourceName(scanner.currentLiteral());
 
 		Token const next = scanner.next();
 		if (next == Token::EOS)
@@ -192,14 +199,14 @@ void ObjectParser::parseData(Object& _containingObject)
 		expectToken(Token::HexStringLiteral, false);
 	else
 		expectToken(Token::StringLiteral, false);
-	addNamedSubObject(_containingObject, name, make_shared<Data>(name, asBytes(currentLiteral())));
+	addNamedSubObject(_containingObject, name, make_shared<Data>(name, asBytes(string(currentLiteral()))));
 	advance();
 }
 
 YulString ObjectParser::parseUniqueName(Object const* _containingObject)
 {
 	expectToken(Token::StringLiteral, false);
-	YulString name{currentLiteral()};
+	YulString name{string(currentLiteral())};
 	if (name.empty())
 		parserError(3287_error, "Object name cannot be empty.");
 	else if (_containingObject && _containingObject->name == name)
@@ -0,0 +1,606 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary format of Yul objects.
+ */
+
+#include <libyul/ObjectSerialiser.h>
+
+#include <libyul/AST.h>
+#include <libyul/DebugDataPool.h>
+#include <libyul/Object.h>
+
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Has to be increased whenever the format or the AST changes.
+uint8_t const formatVersion = 1;
+string_view const magic = "yulb";
+
+/// The kinds of statements and expressions are stored as the indices of their alternatives.
+static_assert(variant_size_v<Statement> == 11 && variant_size_v<Expression> == 3);
+
+enum class NodeKind: uint8_t { Data, Object };
+
+class Writer
+{
+public:
+	bytes write(Object const& _object)
+	{
+		writeObjectNode(_object);
+
+		bytes result(magic.begin(), magic.end());
+		result.push_back(formatVersion);
+		writeUnsigned(result, m_strings.size());
+		for (string_view string: m_strings)
+		{
+			writeUnsigned(result, string.size());
+			result.insert(result.end(), string.begin(), string.end());
+		}
+		writeUnsigned(result, m_debugData.size());
+		for (DebugData const* debugData: m_debugData)
+		{
+			writeLocation(result, debugData->nativeLocation);
+			writeLocation(result, debugData->originLocation);
+			writeUnsigned(result, debugData->astID.has_value());
+			if (debugData->astID)
+				writeSigned(result, *debugData->astID);
+		}
+		result += m_nodes;
+		return result;
+	}
+
+	void operator()(Literal const& _literal)
+	{
+		writeDebugData(_literal.debugData);
+		writeUnsigned(m_nodes, static_cast<uint64_t>(_literal.kind));
+		writeString(_literal.value.str());
+		writeString(_literal.type.str());
+	}
+	void operator()(Identifier const& _identifier)
+	{
+		writeDebugData(_identifier.debugData);
+		writeString(_identifier.name.str());
+	}
+	void operator()(FunctionCall const& _call)
+	{
+		writeDebugData(_call.debugData);
+		(*this)(_call.functionName);
+		writeList(_call.arguments);
+	}
+	void operator()(ExpressionStatement const& _statement)
+	{
+		writeDebugData(_statement.debugData);
+		writeExpression(_statement.expression);
+	}
+	void operator()(Assignment const& _assignment)
+	{
+		writeDebugData(_assignment.debugData);
+		writeList(_assignment.variableNames);
+		writeOptionalExpression(_assignment.value);
+	}
+	void operator()(VariableDeclaration const& _declaration)
+	{
+		writeDebugData(_declaration.debugData);
+		writeList(_declaration.variables);
+		writeOptionalExpression(_declaration.value);
+	}
+	void operator()(FunctionDefinition const& _function)
+	{
+		writeDebugData(_function.debugData);
+		writeString(_function.name.str());
+		writeList(_function.parameters);
+		writeList(_function.returnVariables);
+		(*this)(_function.body);
+	}
+	void operator()(If const& _if)
+	{
+		writeDebugData(_if.debugData);
+		writeExpression(*_if.condition);
+		(*this)(_if.body);
+	}
+	void operator()(Switch const& _switch)
+	{
+		writeDebugData(_switch.debugData);
+		writeExpression(*_switch.expression);
+		writeList(_switch.cases);
+	}
+	void operator()(Case const& _case)
+	{
+		writeDebugData(_case.debugData);
+		writeUnsigned(m_nodes, _case.value != nullptr);
+		if (_case.value)
+			(*this)(*_case.value);
+		(*this)(_case.body);
+	}
+	void operator()(ForLoop const& _forLoop)
+	{
+		writeDebugData(_forLoop.debugData);
+		(*this)(_forLoop.pre);
+		writeExpression(*_forLoop.condition);
+		(*this)(_forLoop.post);
+		(*this)(_forLoop.body);
+	}
+	void operator()(Break const& _break) { writeDebugData(_break.debugData); }
+	void operator()(Continue const& _continue) { writeDebugData(_continue.debugData); }
+	void operator()(Leave const& _leave) { writeDebugData(_leave.debugData); }
+	void operator()(Block const& _block)
+	{
+		writeDebugData(_block.debugData);
+		writeList(_block.statements);
+	}
+	void operator()(Statement const& _statement)
+	{
+		writeUnsigned(m_nodes, _statement.index());
+		std::visit(*this, _statement);
+	}
+	void operator()(TypedName const& _name)
+	{
+		writeDebugData(_name.debugData);
+		writeString(_name.name.str());
+		writeString(_name.type.str());
+	}
+
+private:
+	void writeObjectNode(ObjectNode const& _node)
+	{
+		if (auto const* data = dynamic_cast<Data const*>(&_node))
+		{
+			m_nodes.push_back(static_cast<uint8_t>(NodeKind::Data));
+			writeString(data->name.str());
+			writeUnsigned(m_nodes, data->data.size());
+			m_nodes += data->data;
+			return;
+		}
+
+		auto const& object = dynamic_cast<Object const&>(_node);
+		m_nodes.push_back(static_cast<uint8_t>(NodeKind::Object));
+		writeString(object.name.str());
+		// The sub ID of objects that are not sub-objects is stored as zero.
+		writeUnsigned(m_nodes, object.subId == numeric_limits<size_t>::max() ? 0 : object.subId + 1);
+		writeUnsigned(m_nodes, object.code != nullptr);
+		if (object.code)
+			(*this)(*object.code);
+
+		bool hasSourceNames = object.debugData && object.debugData->sourceNames;
+		writeUnsigned(m_nodes, object.debugData != nullptr);
+		writeUnsigned(m_nodes, hasSourceNames);
+		if (hasSourceNames)
+		{
+			writeUnsigned(m_nodes, object.debugData->sourceNames->size());
+			for (auto const& [index, sourceName]: *object.debugData->sourceNames)
+			{
+				writeUnsigned(m_nodes, index);
+				writeString(*sourceName);
+			}
+		}
+
+		writeUnsigned(m_nodes, object.subObjects.size());
+		for (auto const& subObject: object.subObjects)
+			writeObjectNode(*subObject);
+		writeUnsigned(m_nodes, object.subIndexByName.size());
+		for (auto const& [name, index]: object.subIndexByName)
+		{
+			writeString(name.str());
+			writeUnsigned(m_nodes, index);
+		}
+	}
+
+	void writeExpression(Expression const& _expression)
+	{
+		writeUnsigned(m_nodes, _expression.index());
+		std::visit(*this, _expression);
+	}
+	void writeOptionalExpression(unique_ptr<Expression> const& _expression)
+	{
+		writeUnsigned(m_nodes, _expression != nullptr);
+		if (_expression)
+			writeExpression(*_expression);
+	}
+	void writeList(vector<Expression> const& _expressions)
+	{
+		writeUnsigned(m_nodes, _expressions.size());
+		for (Expression const& expression: _expressions)
+			writeExpression(expression);
+	}
+	template <typename T>
+	void writeList(vector<T> const& _nodes)
+	{
+		writeUnsigned(m_nodes, _nodes.size());
+		for (T const& node: _nodes)
+			(*this)(node);
+	}
+
+	void writeString(string_view _string)
+	{
+		auto [entry, inserted] = m_stringIndices.try_emplace(_string, m_strings.size());
+		if (inserted)
+			m_strings.push_back(_string);
+		writeUnsigned(m_nodes, entry->second);
+	}
+	/// Debug data is stored as its index plus one, so that zero stands for no debug data.
+	void writeDebugData(shared_ptr<DebugData const> const& _debugData)
+	{
+		if (!_debugData)
+		{
+			writeUnsigned(m_nodes, 0);
+			return;
+		}
+		auto [entry, inserted] = m_debugDataIndices.try_emplace(_debugData.get(), m_debugData.size());
+		if (inserted)
+			m_debugData.push_back(_debugData.get());
+		writeUnsigned(m_nodes, entry->second + 1);
+	}
+	void writeLocation(bytes& _output, SourceLocation const& _location)
+	{
+		// Source names are stored as their index in the string table plus one.
+		if (_location.sourceName)
+		{
+			auto [entry, inserted] = m_stringIndices.try_emplace(*_location.sourceName, m_strings.size());
+			if (inserted)
+				m_strings.push_back(*_location.sourceName);
+			writeUnsigned(_output, entry->second + 1);
+		}
+		else
+			writeUnsigned(_output, 0);
+		writeSigned(_output, _location.start);
+		writeSigned(_output, _location.end);
+	}
+
+	static void writeUnsigned(bytes& _output, uint64_t _value)
+	{
+		for (; _value >= 0x80; _value >>= 7)
+			_output.push_back(static_cast<uint8_t>(_value | 0x80));
+		_output.push_back(static_cast<uint8_t>(_value));
+	}
+	/// Stores signed values in the zigzag encoding, which keeps small negative values short.
+	static void writeSigned(bytes& _output, int64_t _value)
+	{
+		writeUnsigned(_output, (static_cast<uint64_t>(_value) << 1) ^ static_cast<uint64_t>(_value >> 63));
+	}
+
+	/// Identifiers and source names are interned, so the views stay valid.
+	vector<string_view> m_strings;
+	unordered_map<string_view, size_t> m_stringIndices;
+	vector<DebugData const*> m_debugData;
+	unordered_map<DebugData const*, size_t> m_debugDataIndices;
+	/// Data of the nodes, which is written after the tables.
+	bytes m_nodes;
+};
+
+class Reader
+{
+public:
+	explicit Reader(bytesConstRef _data): m_data(_data) {}
+
+	shared_ptr<Object> read()
+	{
+		if (
+			m_data.size() <= magic.size() ||
+			!equal(magic.begin(), magic.end(), m_data.begin()) ||
+			m_data[magic.size()] != formatVersion
+		)
+			fail("Not a serialised Yul object of this version.");
+		m_position = magic.size() + 1;
+
+		m_strings.resize(readSize());
+		for (YulString& string: m_strings)
+		{
+			size_t length = readSize();
+			string = YulString(std::string(reinterpret_cast<char const*>(m_data.data() + m_position), length));
+			m_position += length;
+		}
+
+		m_debugData.resize(readSize());
+		for (shared_ptr<DebugData const>& debugData: m_debugData)
+		{
+			SourceLocation nativeLocation = readLocation();
+			SourceLocation originLocation = readLocation();
+			optional<int64_t> astID;
+			if (readFlag())
+				astID = readSigned();
+			debugData = m_debugDataPool.create(nativeLocation, originLocation, astID);
+		}
+
+		shared_ptr<ObjectNode> node = readObjectNode();
+		auto object = dynamic_pointer_cast<Object>(node);
+		if (!object || m_position != m_data.size())
+			fail("Invalid serialised Yul object.");
+		return object;
+	}
+
+private:
+	shared_ptr<ObjectNode> readObjectNode()
+	{
+		if (m_position >= m_data.size())
+			fail("Unexpected end of data.");
+		uint8_t kind = m_data[m_position++];
+		if (kind == static_cast<uint8_t>(NodeKind::Data))
+		{
+			YulString name = readString();
+			size_t length = readSize();
+			bytes data(m_data.begin() + m_position, m_data.begin() + m_position + length);
+			m_position += length;
+			return make_shared<Data>(name, move(data));
+		}
+		else if (kind != static_cast<uint8_t>(NodeKind::Object))
+			fail("Invalid object node.");
+
+		auto object = make_shared<Object>();
+		object->name = readString();
+		uint64_t subId = readUnsigned();
+		object->subId = subId == 0 ? numeric_limits<size_t>::max() : static_cast<size_t>(subId - 1);
+		if (readFlag())
+			object->code = make_shared<Block>(readBlock());
+
+		bool hasDebugData = readFlag();
+		if (readFlag())
+		{
+			SourceNameMap sourceNames;
+			for (size_t count = readSize(); count > 0; --count)
+			{
+				auto index = static_cast<unsigned>(readUnsigned());
+				sourceNames[index] = internSourceName(readString().str());
+			}
+			object->debugData = make_shared<ObjectDebugData>(ObjectDebugData{move(sourceNames)});
+		}
+		else if (hasDebugData)
+			object->debugData = make_shared<ObjectDebugData>();
+
+		object->subObjects.resize(readSize());
+		for (shared_ptr<ObjectNode>& subObject: object->subObjects)
+			subObject = readObjectNode();
+		for (size_t count = readSize(); count > 0; --count)
+		{
+			YulString name = readString();
+			object->subIndexByName[name] = readIndex(object->subObjects.size());
+		}
+		return object;
+	}
+
+	Statement readStatement()
+	{
+		switch (readUnsigned())
+		{
+		case 0:
+		{
+			ExpressionStatement statement{readDebugData(), {}};
+			statement.expression = readExpression();
+			return statement;
+		}
+		case 1:
+		{
+			Assignment assignment{readDebugData(), {}, {}};
+			assignment.variableNames = readList<Identifier>([&] { return readIdentifier(); });
+			assignment.value = readOptionalExpression();
+			return assignment;
+		}
+		case 2:
+		{
+			VariableDeclaration declaration{readDebugData(), {}, {}};
+			declaration.variables = readList<TypedName>([&] { return readTypedName(); });
+			declaration.value = readOptionalExpression();
+			return declaration;
+		}
+		case 3:
+		{
+			FunctionDefinition function{readDebugData(), readString(), {}, {}, {}};
+			function.parameters = readList<TypedName>([&] { return readTypedName(); });
+			function.returnVariables = readList<TypedName>([&] { return readTypedName(); });
+			function.body = readBlock();
+			return function;
+		}
+		case 4:
+		{
+			If ifStatement{readDebugData(), {}, {}};
+			ifStatement.condition = make_unique<Expression>(readExpression());
+			ifStatement.body = readBlock();
+			return ifStatement;
+		}
+		case 5:
+		{
+			Switch switchStatement{readDebugData(), {}, {}};
+			switchStatement.expression = make_unique<Expression>(readExpression());
+			switchStatement.cases = readList<Case>([&] { return readCase(); });
+			return switchStatement;
+		}
+		case 6:
+		{
+			ForLoop forLoop{readDebugData(), {}, {}, {}, {}};
+			forLoop.pre = readBlock();
+			forLoop.condition = make_unique<Expression>(readExpression());
+			forLoop.post = readBlock();
+			forLoop.body = readBlock();
+			return forLoop;
+		}
+		case 7:
+			return Break{readDebugData()};
+		case 8:
+			return Continue{readDebugData()};
+		case 9:
+			return Leave{readDebugData()};
+		case 10:
+			return readBlock();
+		default:
+			fail("Invalid statement.");
+		}
+	}
+
+	Expression readExpression()
+	{
+		switch (readUnsigned())
+		{
+		case 0:
+		{
+			FunctionCall call{readDebugData(), readIdentifier(), {}};
+			call.arguments = readList<Expression>([&] { return readExpression(); });
+			return call;
+		}
+		case 1:
+			return readIdentifier();
+		case 2:
+			return readLiteral();
+		default:
+			fail("Invalid expression.");
+		}
+	}
+	unique_ptr<Expression> readOptionalExpression()
+	{
+		if (!readFlag())
+			return nullptr;
+		return make_unique<Expression>(readExpression());
+	}
+
+	Block readBlock()
+	{
+		Block block{readDebugData(), {}};
+		block.statements = readList<Statement>([&] { return readStatement(); });
+		return block;
+	}
+	Case readCase()
+	{
+		Case switchCase{readDebugData(), {}, {}};
+		if (readFlag())
+			switchCase.value = make_unique<Literal>(readLiteral());
+		switchCase.body = readBlock();
+		return switchCase;
+	}
+	Literal readLiteral()
+	{
+		shared_ptr<DebugData const> debugData = readDebugData();
+		uint64_t kind = readUnsigned();
+		if (kind > static_cast<uint64_t>(LiteralKind::String))
+			fail("Invalid literal kind.");
+		YulString value = readString();
+		return Literal{move(debugData), static_cast<LiteralKind>(kind), value, readString()};
+	}
+	Identifier readIdentifier()
+	{
+		shared_ptr<DebugData const> debugData = readDebugData();
+		return Identifier{move(debugData), readString()};
+	}
+	TypedName readTypedName()
+	{
+		shared_ptr<DebugData const> debugData = readDebugData();
+		YulString name = readString();
+		return TypedName{move(debugData), name, readString()};
+	}
+
+	template <typename T, typename ReadElement>
+	vector<T> readList(ReadElement const& _readElement)
+	{
+		vector<T> list;
+		size_t size = readSize();
+		list.reserve(size);
+		for (size_t i = 0; i < size; ++i)
+			list.emplace_back(_readElement());
+		return list;
+	}
+
+	YulString readString() { return m_strings[readIndex(m_strings.size())]; }
+	shared_ptr<DebugData const> readDebugData()
+	{
+		size_t index = readIndex(m_debugData.size() + 1);
+		return index == 0 ? nullptr : m_debugData[index - 1];
+	}
+	SourceLocation readLocation()
+	{
+		SourceLocation location;
+		if (size_t sourceName = readIndex(m_strings.size() + 1))
+			location.sourceName = internSourceName(m_strings[sourceName - 1].str());
+		location.start = readInt();
+		location.end = readInt();
+		return location;
+	}
+
+	uint64_t readUnsigned()
+	{
+		uint64_t value = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7)
+		{
+			if (m_position >= m_data.size())
+				fail("Unexpected end of data.");
+			uint8_t byte = m_data[m_position++];
+			value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return value;
+		}
+		fail("Invalid integer.");
+	}
+	int64_t readSigned()
+	{
+		uint64_t value = readUnsigned();
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+	int readInt()
+	{
+		int64_t value = readSigned();
+		if (value < numeric_limits<int>::min() || value > numeric_limits<int>::max())
+			fail("Invalid integer.");
+		return static_cast<int>(value);
+	}
+	bool readFlag() { return readIndex(2) == 1; }
+	size_t readIndex(size_t _size)
+	{
+		uint64_t index = readUnsigned();
+		if (index >= _size)
+			fail("Invalid index.");
+		return static_cast<size_t>(index);
+	}
+	/// Reads the size of a list or a string, which cannot be larger than the remaining data.
+	size_t readSize()
+	{
+		uint64_t size = readUnsigned();
+		if (size > m_data.size() - m_position)
+			fail("Unexpected end of data.");
+		return static_cast<size_t>(size);
+	}
+
+	[[noreturn]] static void fail(string const& _message)
+	{
+		BOOST_THROW_EXCEPTION(ObjectSerialisationError() << errinfo_comment(_message));
+	}
+
+	bytesConstRef m_data;
+	size_t m_position = 0;
+	vector<YulString> m_strings;
+	vector<shared_ptr<DebugData const>> m_debugData;
+	DebugDataPool m_debugDataPool;
+};
+
+}
+
+bytes ObjectSerialiser::serialise(Object const& _object)
+{
+	return Writer{}.write(_object);
+}
+
+shared_ptr<Object> ObjectSerialiser::deserialise(bytesConstRef _data)
+{
+	return Reader{_data}.read();
+}
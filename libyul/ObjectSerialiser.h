@@ -0,0 +1,58 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary format of Yul objects.
+ */
+
+#pragma once
+
+#include <libyul/Exceptions.h>
+
+#include <libsolutil/Common.h>
+
+#include <memory>
+
+namespace solidity::yul
+{
+
+struct Object;
+
+struct ObjectSerialisationError: virtual YulException {};
+
+/**
+ * Converts Yul objects including their code, data, sub-objects and debug data into a compact
+ * binary format and back, which is much faster than printing and re-parsing them.
+ *
+ * The data starts with a table of all the strings, i.e. identifiers, types, literal values and
+ * source names, followed by a table of the distinct debug data of the nodes. The nodes of the
+ * objects and of their code follow in pre-order and refer to the strings and the debug data by
+ * their indices. Integers are stored in the variable-length LEB128 encoding.
+ *
+ * The format is only meant to be read by the same version of the compiler. The analysis info
+ * of the objects is not stored.
+ */
+class ObjectSerialiser
+{
+public:
+	static bytes serialise(Object const& _object);
+	/// @returns the object stored in @a _data, without analysis info.
+	/// @throws ObjectSerialisationError if the data is malformed or of a different version.
+	static std::shared_ptr<Object> deserialise(bytesConstRef _data);
+};
+
+}
@@ -25,6 +25,8 @@
 
 #include <libyul/YulString.h>
 
+#include <libsolutil/FlatMap.h>
+
 #include <functional>
 #include <memory>
 #include <optional>
@@ -91,7 +93,9 @@ struct Scope
 	/// If true, variables from the super scope are not visible here (other identifiers are),
 	/// but they are still taken into account to prevent shadowing.
 	bool functionScope = false;
-	std::map<YulString, Identifier> identifiers;
+	/// Most scopes only contain a few identifiers, which are stored without allocations.
+	/// Registering an identifier invalidates the pointers to the others.
+	util::FlatMap<YulString, Identifier, 4> identifiers;
 };
 
 }
@@ -0,0 +1,111 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace solidity::yul;
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	uint64_t h = hash(_string);
+	Shard& shard = m_shards[h % shardCount];
+	{
+		shared_lock lock(shard.mutex);
+		if (optional<size_t> id = findID(shard, h, _string))
+			return Handle{*id, h};
+	}
+
+	unique_lock lock(shard.mutex);
+	// Another thread might have inserted the string in the meantime.
+	if (optional<size_t> id = findID(shard, h, _string))
+		return Handle{*id, h};
+	size_t id = m_nextID++;
+	string& stored = storage(id);
+	stored = _string;
+	shard.hashToID.emplace(h, id);
+
+	m_characters += stored.size();
+	// Short strings are stored inline in the block, longer ones allocate memory.
+	if (stored.capacity() > string{}.capacity())
+		m_externalBytes += stored.capacity() + 1;
+
+	return Handle{id, h};
+}
+
+void YulStringRepository::clear()
+{
+	for (Shard& shard: m_shards)
+	{
+		unique_lock lock(shard.mutex);
+		shard.hashToID.clear();
+	}
+
+	lock_guard lock(m_blocksMutex);
+	for (atomic<string*>& block: m_blocks)
+		block.store(nullptr, memory_order_relaxed);
+	m_ownedBlocks.clear();
+	// The empty string has ID zero.
+	m_ownedBlocks.emplace_back(make_unique<string[]>(blockSize));
+	m_blocks[0].store(m_ownedBlocks.back().get(), memory_order_release);
+	m_nextID = 1;
+	m_characters = 0;
+	m_externalBytes = 0;
+}
+
+YulStringRepository::Statistics YulStringRepository::statistics() const
+{
+	Statistics statistics;
+	statistics.strings = m_nextID - 1;
+	statistics.characters = m_characters;
+	lock_guard lock(m_blocksMutex);
+	statistics.bytes = m_ownedBlocks.size() * blockSize * sizeof(string) + m_externalBytes;
+	return statistics;
+}
+
+optional<size_t> YulStringRepository::findID(Shard const& _shard, uint64_t _hash, string const& _string) const
+{
+	auto range = _shard.hashToID.equal_range(_hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (idToString(it->second) == _string)
+			return it->second;
+	return nullopt;
+}
+
+string& YulStringRepository::storage(size_t _id)
+{
+	size_t blockIndex = _id / blockSize;
+	yulAssert(blockIndex < maxBlocks, "Too many distinct YulStrings.");
+	string* block = m_blocks[blockIndex].load(memory_order_acquire);
+	if (!block)
+	{
+		lock_guard lock(m_blocksMutex);
+		block = m_blocks[blockIndex].load(memory_order_relaxed);
+		if (!block)
+		{
+			m_ownedBlocks.emplace_back(make_unique<string[]>(blockSize));
+			block = m_ownedBlocks.back().get();
+			m_blocks[blockIndex].store(block, memory_order_release);
+		}
+	}
+	return block[_id % blockSize];
+}
@@ -23,8 +23,13 @@
 
 #include <fmt/format.h>
 
+#include <array>
+#include <atomic>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -36,6 +41,8 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+/// Lookups and insertions can be performed concurrently from multiple threads, but resetting
+/// the repository cannot.
 class YulStringRepository
 {
 public:
@@ -45,28 +52,33 @@ public:
 		std::uint64_t hash;
 	};
 
+	/// Memory footprint of the repository.
+	struct Statistics
+	{
+		/// Number of distinct non-empty strings.
+		size_t strings = 0;
+		/// Total length of these strings.
+		size_t characters = 0;
+		/// Bytes allocated for storing the strings, including the unused part of the blocks.
+		size_t bytes = 0;
+	};
+
 	static YulStringRepository& instance()
 	{
 		static YulStringRepository inst;
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	Handle stringToHandle(std::string const& _string);
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		// Blocks are only ever added, so the block of an ID that has been handed out is
+		// always present and the string it contains does not change anymore.
+		std::string const* block = m_blocks[_id / blockSize].load(std::memory_order_acquire);
+		return block[_id % blockSize];
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
+
+	Statistics statistics() const;
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -89,7 +101,7 @@ public:
 	{
 		for (auto const& cb: resetCallbacks())
 			cb();
-		instance() = YulStringRepository{};
+		instance().clear();
 	}
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
@@ -97,16 +109,37 @@ public:
 	{
 		ResetCallback(std::function<void()> _fun)
 		{
+			static std::mutex mutex;
+			std::lock_guard lock(mutex);
 			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
 		}
 	};
 
 private:
-	YulStringRepository() = default;
+	/// Number of independently locked parts of the hash table.
+	/// Strings are assigned to a shard based on their hash.
+	static constexpr size_t shardCount = 16;
+	/// Number of strings stored in a single block.
+	static constexpr size_t blockSize = 4096;
+	static constexpr size_t maxBlocks = 16384;
+
+	/// Part of the hash table. Aligned to avoid false sharing between the locks of different shards.
+	struct alignas(64) Shard
+	{
+		mutable std::shared_mutex mutex;
+		std::unordered_multimap<std::uint64_t, size_t> hashToID;
+	};
+
+	YulStringRepository() { clear(); }
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+
+	void clear();
+
+	/// Has to be called with the mutex of @a _shard locked.
+	std::optional<size_t> findID(Shard const& _shard, std::uint64_t _hash, std::string const& _string) const;
+	/// @returns the storage location of the string with the given ID, allocating a new block if needed.
+	std::string& storage(size_t _id);
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
@@ -114,8 +147,17 @@ private:
 		return callbacks;
 	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::array<Shard, shardCount> m_shards;
+	std::atomic<size_t> m_nextID{1};
+	std::atomic<size_t> m_characters{0};
+	/// Bytes allocated outside of the blocks for strings too long to be stored inline.
+	std::atomic<size_t> m_externalBytes{0};
+	/// Append-only storage of the strings, indexed by their ID.
+	/// The blocks are not moved or freed before the repository is reset, so references
+	/// to the strings stay valid and can be used without locking.
+	std::array<std::atomic<std::string*>, maxBlocks> m_blocks{};
+	mutable std::mutex m_blocksMutex;
+	std::vector<std::unique_ptr<std::string[]>> m_ownedBlocks;
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -0,0 +1,538 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Assembly that writes EVM bytecode directly, without building an evmasm assembly.
+ */
+
+#include <libyul/backends/evm/BytecodeAssembly.h>
+
+#include <libyul/Exceptions.h>
+
+#include <libevmasm/Exceptions.h>
+#include <libevmasm/Instruction.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/Numeric.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::util;
+using namespace solidity::evmasm;
+using namespace solidity::langutil;
+
+namespace
+{
+
+/// Writes @a _value into the @a _size bytes of @a _code starting at @a _position.
+void writeBigEndian(bytes& _code, size_t _position, size_t _size, size_t _value)
+{
+	bytesRef target(_code.data() + _position, _size);
+	toBigEndian(_value, target);
+}
+
+/// Appends the push of @a _value using as few bytes as possible.
+void appendPush(bytes& _code, u256 const& _value)
+{
+	unsigned size = max<unsigned>(1, numberEncodingSize(_value));
+	_code.push_back(static_cast<uint8_t>(pushInstruction(size)));
+	_code.resize(_code.size() + size);
+	bytesRef target(&_code.back() + 1 - size, size);
+	toBigEndian(_value, target);
+}
+
+}
+
+BytecodeAssembly::BytecodeAssembly(map<string, unsigned> _sourceIndices, string _name):
+	m_sourceIndices(move(_sourceIndices)),
+	m_name(move(_name))
+{
+}
+
+void BytecodeAssembly::setStackHeight(int height)
+{
+	m_stackHeight = height;
+	assertThrow(m_stackHeight >= 0, InvalidDeposit, "");
+}
+
+void BytecodeAssembly::appendInstruction(evmasm::Instruction _instruction)
+{
+	m_code.push_back(static_cast<uint8_t>(_instruction));
+	InstructionInfo info = instructionInfo(_instruction);
+	appendItem(m_code.size() - 1, static_cast<size_t>(info.args), static_cast<size_t>(info.ret), 1);
+}
+
+void BytecodeAssembly::appendConstant(u256 const& _constant)
+{
+	size_t start = m_code.size();
+	appendPush(m_code, _constant);
+	appendItem(start, 0, 1, m_code.size() - start);
+}
+
+void BytecodeAssembly::appendLabel(LabelID _labelId)
+{
+	assertThrow(_labelId != 0, AssemblyException, "Invalid tag position.");
+	assertThrow(_labelId < m_labelPositions.size(), AssemblyException, "Reference to non-existing tag.");
+	assertThrow(
+		m_labelPositions[_labelId] == numeric_limits<size_t>::max(),
+		AssemblyException,
+		"Duplicate tag position."
+	);
+	yulAssert(!m_assembledObject, "Code appended after assembling.");
+	m_labelPositions[_labelId] = m_code.size();
+	m_labelItemIndices.emplace(_labelId, m_itemCount++);
+	m_code.push_back(static_cast<uint8_t>(evmasm::Instruction::JUMPDEST));
+	m_approximateCodeSize += 1;
+	m_sourceMapping.append(m_currentLocation, AssemblyItem::JumpType::Ordinary, 0);
+}
+
+void BytecodeAssembly::appendLabelReference(LabelID _labelId)
+{
+	appendReference({m_code.size(), Reference::Kind::Tag, _labelId, h256{}});
+}
+
+AbstractAssembly::LabelID BytecodeAssembly::newLabelId()
+{
+	assertThrow(m_labelPositions.size() < 0xffffffff, AssemblyException, "");
+	m_labelPositions.push_back(numeric_limits<size_t>::max());
+	return m_labelPositions.size() - 1;
+}
+
+AbstractAssembly::LabelID BytecodeAssembly::namedLabel(
+	string const& _name,
+	size_t _params,
+	size_t _returns,
+	optional<size_t> _sourceID
+)
+{
+	assertThrow(!_name.empty(), AssemblyException, "Empty named tag.");
+	if (m_namedLabels.count(_name))
+	{
+		assertThrow(m_namedLabels.at(_name).params == _params, AssemblyException, "");
+		assertThrow(m_namedLabels.at(_name).returns == _returns, AssemblyException, "");
+		assertThrow(m_namedLabels.at(_name).sourceID == _sourceID, AssemblyException, "");
+	}
+	else
+		m_namedLabels[_name] = {newLabelId(), _sourceID, _params, _returns};
+	return m_namedLabels.at(_name).id;
+}
+
+void BytecodeAssembly::appendLinkerSymbol(string const& _linkerSymbol)
+{
+	m_code.push_back(static_cast<uint8_t>(evmasm::Instruction::PUSH20));
+	m_linkReferences[m_code.size()] = _linkerSymbol;
+	m_code.resize(m_code.size() + 20);
+	appendItem(m_code.size() - 21, 0, 1, 21);
+}
+
+void BytecodeAssembly::appendVerbatim(bytes _data, size_t _arguments, size_t _returnVariables)
+{
+	m_code += _data;
+	appendItem(m_code.size() - _data.size(), _arguments, _returnVariables, _data.size());
+}
+
+void BytecodeAssembly::appendJump(int _stackDiffAfter, JumpType _jumpType)
+{
+	appendJumpInstruction(evmasm::Instruction::JUMP, _jumpType);
+	m_stackHeight += _stackDiffAfter;
+	assertThrow(m_stackHeight >= 0, InvalidDeposit, "");
+}
+
+void BytecodeAssembly::appendJumpTo(LabelID _labelId, int _stackDiffAfter, JumpType _jumpType)
+{
+	appendLabelReference(_labelId);
+	appendJump(_stackDiffAfter, _jumpType);
+}
+
+void BytecodeAssembly::appendJumpToIf(LabelID _labelId, JumpType _jumpType)
+{
+	appendLabelReference(_labelId);
+	appendJumpInstruction(evmasm::Instruction::JUMPI, _jumpType);
+}
+
+void BytecodeAssembly::appendAssemblySize()
+{
+	appendReference({m_code.size(), Reference::Kind::ProgramSize, 0, h256{}});
+}
+
+pair<shared_ptr<AbstractAssembly>, AbstractAssembly::SubID> BytecodeAssembly::createSubAssembly(string _name)
+{
+	m_subs.emplace_back(make_shared<BytecodeAssembly>(m_sourceIndices, move(_name)));
+	return {m_subs.back(), m_subs.size() - 1};
+}
+
+void BytecodeAssembly::appendDataOffset(vector<AbstractAssembly::SubID> const& _subPath)
+{
+	if (auto it = m_dataHashBySubId.find(_subPath[0]); it != m_dataHashBySubId.end())
+	{
+		yulAssert(_subPath.size() == 1, "");
+		appendReference({m_code.size(), Reference::Kind::Data, 0, it->second});
+		return;
+	}
+
+	appendReference({m_code.size(), Reference::Kind::Sub, encodeSubPath(_subPath), h256{}});
+}
+
+void BytecodeAssembly::appendDataSize(vector<AbstractAssembly::SubID> const& _subPath)
+{
+	if (auto it = m_dataHashBySubId.find(_subPath[0]); it != m_dataHashBySubId.end())
+	{
+		yulAssert(_subPath.size() == 1, "");
+		appendConstant(m_data.at(it->second).size());
+		return;
+	}
+
+	size_t start = m_code.size();
+	appendPush(m_code, subAssemblyById(encodeSubPath(_subPath)).assemble().bytecode.size());
+	// The estimate assumes a program of up to 16MB like the one of evmasm::AssemblyItem.
+	appendItem(start, 0, 1, 1 + 4);
+}
+
+AbstractAssembly::SubID BytecodeAssembly::appendData(bytes const& _data)
+{
+	h256 hash(keccak256(asString(_data)));
+	m_data[hash] = _data;
+	SubID subID = m_nextDataCounter++;
+	m_dataHashBySubId[subID] = hash;
+	return subID;
+}
+
+void BytecodeAssembly::appendImmutable(string const& _identifier)
+{
+	m_pushesImmutables = true;
+	size_t start = m_code.size();
+	m_code.push_back(static_cast<uint8_t>(evmasm::Instruction::PUSH32));
+	auto& [identifier, offsets] = m_immutableReferences[u256(h256(keccak256(_identifier)))];
+	identifier = _identifier;
+	offsets.emplace_back(m_code.size());
+	m_code.resize(m_code.size() + 32);
+	appendItem(start, 0, 1, 1 + 32);
+}
+
+void BytecodeAssembly::appendImmutableAssignment(string const& _identifier)
+{
+	m_setsImmutables = true;
+	u256 hash(h256(keccak256(_identifier)));
+	static vector<size_t> const noOffsets;
+	vector<size_t> const* offsets = &noOffsets;
+	if (auto const* references = subImmutableReferences())
+		if (auto it = references->find(hash); it != references->end())
+			offsets = &it->second.second;
+
+	size_t start = m_code.size();
+	// Expect the value and the base offset on stack.
+	for (size_t i = 0; i < offsets->size(); ++i)
+	{
+		if (i != offsets->size() - 1)
+		{
+			m_code.push_back(static_cast<uint8_t>(evmasm::Instruction::DUP2));
+			m_code.push_back(static_cast<uint8_t>(evmasm::Instruction::DUP2));
+		}
+		size_t offsetSize = numberEncodingSize((*offsets)[i]);
+		m_code.push_back(static_cast<uint8_t>(pushInstruction(static_cast<unsigned>(offsetSize))));
+		m_code.resize(m_code.size() + offsetSize);
+		writeBigEndian(m_code, m_code.size() - offsetSize, offsetSize, (*offsets)[i]);
+		m_code.push_back(static_cast<uint8_t>(evmasm::Instruction::ADD));
+		m_code.push_back(static_cast<uint8_t>(evmasm::Instruction::MSTORE));
+	}
+	if (offsets->empty())
+	{
+		m_code.push_back(static_cast<uint8_t>(evmasm::Instruction::POP));
+		m_code.push_back(static_cast<uint8_t>(evmasm::Instruction::POP));
+	}
+	else
+		m_assignedImmutables.insert(hash);
+
+	// The estimate assumes a single reference like the one of evmasm::AssemblyItem.
+	appendItem(start, 2, 0, 3 + 32, offsets->empty() ? 2 : (offsets->size() - 1) * 5 + 3);
+}
+
+LinkerObject const& BytecodeAssembly::assemble()
+{
+	assertThrow(!m_invalid, AssemblyException, "Attempted to assemble invalid Assembly object.");
+	if (m_assembledObject)
+		return *m_assembledObject;
+
+	// Like evmasm::Assembly, the search for the size of the tags starts at the largest tag
+	// position in the sub-assemblies.
+	size_t subTagSize = 1;
+	size_t subSizes = 0;
+	for (auto const& sub: m_subs)
+	{
+		subSizes += sub->assemble().bytecode.size();
+		for (size_t position: sub->m_labelPositions)
+			if (position != numeric_limits<size_t>::max() && position > subTagSize)
+				subTagSize = position;
+	}
+	auto const* immutableReferencesBySub = subImmutableReferences();
+	if (m_setsImmutables || m_pushesImmutables)
+		assertThrow(
+			m_setsImmutables != m_pushesImmutables,
+			AssemblyException,
+			"Cannot push and assign immutables in the same assembly subroutine."
+		);
+	if (immutableReferencesBySub && m_assignedImmutables.size() != immutableReferencesBySub->size())
+		throw
+			langutil::Error(
+				1284_error,
+				langutil::Error::Type::CodeGenerationError,
+				"Some immutables were read from but never assigned, possibly because of optimization."
+			);
+
+	size_t codeReferences = 0;
+	for (Reference const& reference: m_references)
+		if (reference.kind != Reference::Kind::ProgramSize)
+			++codeReferences;
+	size_t fixedSize = 1 + m_approximateCodeSize;
+	for (auto const& data: m_data)
+		fixedSize += data.second.size();
+	size_t bytesRequiredForCode = 0;
+	for (size_t tagSize = subTagSize; true; ++tagSize)
+	{
+		bytesRequiredForCode = fixedSize + codeReferences * tagSize;
+		if (numberEncodingSize(bytesRequiredForCode) <= tagSize)
+			break;
+	}
+	unsigned bytesPerTag = numberEncodingSize(bytesRequiredForCode);
+	size_t bytesRequiredIncludingData = bytesRequiredForCode + 1 + m_auxiliaryData.size() + subSizes;
+	unsigned bytesPerDataRef = numberEncodingSize(bytesRequiredIncludingData);
+	auto referenceSize = [&](Reference const& _reference) -> size_t {
+		return 1 + (_reference.kind == Reference::Kind::Tag ? bytesPerTag : bytesPerDataRef);
+	};
+
+	// Number of bytes inserted before each position of m_code, which does not contain the
+	// pushes of the references yet.
+	vector<size_t> insertedBefore{0};
+	for (Reference const& reference: m_references)
+		insertedBefore.push_back(insertedBefore.back() + referenceSize(reference));
+	auto finalPosition = [&](size_t _position) {
+		auto next = upper_bound(
+			m_references.begin(),
+			m_references.end(),
+			_position,
+			[](size_t _value, Reference const& _reference) { return _value < _reference.position; }
+		);
+		return _position + insertedBefore[static_cast<size_t>(next - m_references.begin())];
+	};
+	for (size_t& position: m_labelPositions)
+		if (position != numeric_limits<size_t>::max())
+		{
+			position = finalPosition(position);
+			assertThrow(position < 0xffffffffL, AssemblyException, "Tag too large.");
+		}
+	if (m_firstNonTagPosition)
+		m_labelPositions[0] = m_firstNonTagPosition->first + insertedBefore[m_firstNonTagPosition->second];
+
+	LinkerObject ret;
+	bytes& code = ret.bytecode;
+	code.reserve(bytesRequiredIncludingData);
+	multimap<size_t, size_t> subReferences;
+	multimap<h256, size_t> dataReferences;
+	vector<size_t> sizeReferences;
+	size_t copied = 0;
+	for (Reference const& reference: m_references)
+	{
+		code.insert(
+			code.end(),
+			m_code.begin() + static_cast<ptrdiff_t>(copied),
+			m_code.begin() + static_cast<ptrdiff_t>(reference.position)
+		);
+		copied = reference.position;
+		size_t valueSize = referenceSize(reference) - 1;
+		code.push_back(static_cast<uint8_t>(pushInstruction(static_cast<unsigned>(valueSize))));
+		size_t valuePosition = code.size();
+		code.resize(code.size() + valueSize);
+		switch (reference.kind)
+		{
+		case Reference::Kind::Tag:
+		{
+			assertThrow(reference.id < m_labelPositions.size(), AssemblyException, "Reference to non-existing tag.");
+			size_t position = m_labelPositions[reference.id];
+			assertThrow(position != numeric_limits<size_t>::max(), AssemblyException, "Reference to tag without position.");
+			assertThrow(numberEncodingSize(position) <= valueSize, AssemblyException, "Tag too large for reserved space.");
+			writeBigEndian(code, valuePosition, valueSize, position);
+			break;
+		}
+		case Reference::Kind::Data:
+			dataReferences.emplace(reference.dataHash, valuePosition);
+			break;
+		case Reference::Kind::Sub:
+			subReferences.emplace(reference.id, valuePosition);
+			break;
+		case Reference::Kind::ProgramSize:
+			sizeReferences.push_back(valuePosition);
+			break;
+		}
+	}
+	code.insert(code.end(), m_code.begin() + static_cast<ptrdiff_t>(copied), m_code.end());
+
+	for (auto const& [position, symbol]: m_linkReferences)
+		ret.linkReferences[finalPosition(position)] = symbol;
+	for (auto const& [hash, references]: m_immutableReferences)
+	{
+		auto& [identifier, offsets] = ret.immutableReferences[hash];
+		identifier = references.first;
+		for (size_t offset: references.second)
+			offsets.push_back(finalPosition(offset));
+	}
+	for (auto const& [name, label]: m_namedLabels)
+	{
+		size_t position = m_labelPositions.at(label.id);
+		optional<size_t> itemIndex;
+		if (auto it = m_labelItemIndices.find(label.id); it != m_labelItemIndices.end())
+			itemIndex = it->second;
+		ret.functionDebugData[name] = {
+			position == numeric_limits<size_t>::max() ? nullopt : optional<size_t>{position},
+			itemIndex,
+			label.sourceID,
+			label.params,
+			label.returns
+		};
+	}
+
+	if (!m_subs.empty() || !m_data.empty() || !m_auxiliaryData.empty())
+		// Append an INVALID here to help tests find miscompilation.
+		code.push_back(static_cast<uint8_t>(evmasm::Instruction::INVALID));
+
+	for (auto const& [subId, position]: subReferences)
+	{
+		writeBigEndian(code, position, bytesPerDataRef, code.size());
+		ret.append(subAssemblyById(subId).assemble());
+	}
+
+	for (auto const& [hash, data]: m_data)
+	{
+		auto references = dataReferences.equal_range(hash);
+		if (references.first == references.second)
+			continue;
+		for (auto reference = references.first; reference != references.second; ++reference)
+			writeBigEndian(code, reference->second, bytesPerDataRef, code.size());
+		code += data;
+	}
+
+	code += m_auxiliaryData;
+
+	for (size_t position: sizeReferences)
+		writeBigEndian(code, position, bytesPerDataRef, code.size());
+
+	// The code is not needed anymore.
+	m_code = {};
+	m_references = {};
+	m_assembledObject = move(ret);
+	return *m_assembledObject;
+}
+
+void BytecodeAssembly::appendItem(
+	size_t _start,
+	size_t _arguments,
+	size_t _returns,
+	size_t _approximateSize,
+	size_t _opcodeCount,
+	AssemblyItem::JumpType _jumpType
+)
+{
+	yulAssert(!m_assembledObject, "Code appended after assembling.");
+	assertThrow(m_stackHeight >= 0, AssemblyException, "Stack underflow.");
+	m_stackHeight += static_cast<int>(_returns) - static_cast<int>(_arguments);
+	m_approximateCodeSize += _approximateSize;
+	if (!m_firstNonTagPosition)
+		m_firstNonTagPosition = {_start, m_references.size()};
+	++m_itemCount;
+	m_sourceMapping.append(m_currentLocation, _jumpType, 0, _opcodeCount);
+}
+
+void BytecodeAssembly::appendReference(Reference _reference)
+{
+	yulAssert(_reference.position == m_code.size(), "");
+	// Only the push instruction is counted, the size of the value is added when assembling,
+	// except for the program size, for which a program of up to 16MB is assumed.
+	bool programSize = _reference.kind == Reference::Kind::ProgramSize;
+	appendItem(_reference.position, 0, 1, programSize ? 1 + 4 : 1);
+	m_references.emplace_back(move(_reference));
+}
+
+void BytecodeAssembly::appendJumpInstruction(evmasm::Instruction _instruction, JumpType _jumpType)
+{
+	yulAssert(_instruction == evmasm::Instruction::JUMP || _instruction == evmasm::Instruction::JUMPI, "");
+	AssemblyItem::JumpType jumpType = AssemblyItem::JumpType::Ordinary;
+	switch (_jumpType)
+	{
+	case JumpType::Ordinary:
+		break;
+	case JumpType::IntoFunction:
+		jumpType = AssemblyItem::JumpType::IntoFunction;
+		break;
+	case JumpType::OutOfFunction:
+		jumpType = AssemblyItem::JumpType::OutOfFunction;
+		break;
+	}
+	m_code.push_back(static_cast<uint8_t>(_instruction));
+	InstructionInfo info = instructionInfo(_instruction);
+	appendItem(m_code.size() - 1, static_cast<size_t>(info.args), static_cast<size_t>(info.ret), 1, 1, jumpType);
+}
+
+size_t BytecodeAssembly::encodeSubPath(vector<SubID> const& _subPath)
+{
+	assertThrow(!_subPath.empty(), AssemblyException, "");
+	if (_subPath.size() == 1)
+	{
+		assertThrow(_subPath[0] < m_subs.size(), AssemblyException, "");
+		return _subPath[0];
+	}
+
+	if (m_subPaths.find(_subPath) == m_subPaths.end())
+	{
+		size_t objectId = numeric_limits<size_t>::max() - m_subPaths.size();
+		assertThrow(objectId >= m_subs.size(), AssemblyException, "");
+		m_subPaths[_subPath] = objectId;
+	}
+
+	return m_subPaths[_subPath];
+}
+
+BytecodeAssembly& BytecodeAssembly::subAssemblyById(size_t _subId)
+{
+	vector<SubID> subPath{_subId};
+	if (_subId >= m_subs.size())
+	{
+		auto it = find_if(m_subPaths.begin(), m_subPaths.end(), [&](auto const& _path) { return _path.second == _subId; });
+		assertThrow(it != m_subPaths.end(), AssemblyException, "");
+		subPath = it->first;
+	}
+	BytecodeAssembly* assembly = this;
+	for (SubID subId: subPath)
+		assembly = assembly->m_subs.at(subId).get();
+	return *assembly;
+}
+
+map<u256, pair<string, vector<size_t>>> const* BytecodeAssembly::subImmutableReferences()
+{
+	map<u256, pair<string, vector<size_t>>> const* references = nullptr;
+	for (auto const& sub: m_subs)
+		if (LinkerObject const& object = sub->assemble(); !object.immutableReferences.empty())
+		{
+			assertThrow(!references, AssemblyException, "More than one sub-assembly references immutables.");
+			references = &object.immutableReferences;
+		}
+	return references;
+}
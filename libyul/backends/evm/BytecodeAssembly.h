@@ -0,0 +1,177 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Assembly that writes EVM bytecode directly, without building an evmasm assembly.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/AbstractAssembly.h>
+
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/LinkerObject.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Assembly that writes the bytecode and the source mapping while the code is generated, without
+ * creating the items of an evmasm::Assembly. The result is the same as assembling an
+ * evmasm::Assembly without running any of its optimisation steps.
+ *
+ * The size of the pushes of tags, data offsets and the program size depends on the size of the
+ * whole code. Their positions are recorded and they are written in a single pass over the code
+ * when the object is assembled.
+ */
+class BytecodeAssembly: public AbstractAssembly
+{
+public:
+	/// @param _sourceIndices the indices of the source names in the source mapping.
+	explicit BytecodeAssembly(std::map<std::string, unsigned> _sourceIndices, std::string _name = {});
+	BytecodeAssembly(BytecodeAssembly const&) = delete;
+	BytecodeAssembly& operator=(BytecodeAssembly const&) = delete;
+
+	void setSourceLocation(langutil::SourceLocation const& _location) override { m_currentLocation = _location; }
+	int stackHeight() const override { return m_stackHeight; }
+	void setStackHeight(int height) override;
+	void appendInstruction(evmasm::Instruction _instruction) override;
+	void appendConstant(u256 const& _constant) override;
+	void appendLabel(LabelID _labelId) override;
+	void appendLabelReference(LabelID _labelId) override;
+	LabelID newLabelId() override;
+	LabelID namedLabel(std::string const& _name, size_t _params, size_t _returns, std::optional<size_t> _sourceID) override;
+	void appendLinkerSymbol(std::string const& _linkerSymbol) override;
+	void appendVerbatim(bytes _data, size_t _arguments, size_t _returnVariables) override;
+	void appendJump(int _stackDiffAfter, JumpType _jumpType) override;
+	void appendJumpTo(LabelID _labelId, int _stackDiffAfter, JumpType _jumpType) override;
+	void appendJumpToIf(LabelID _labelId, JumpType _jumpType) override;
+	void appendAssemblySize() override;
+	std::pair<std::shared_ptr<AbstractAssembly>, SubID> createSubAssembly(std::string _name = {}) override;
+	void appendDataOffset(std::vector<SubID> const& _subPath) override;
+	void appendDataSize(std::vector<SubID> const& _subPath) override;
+	SubID appendData(bytes const& _data) override;
+
+	void appendToAuxiliaryData(bytes const& _data) override { m_auxiliaryData += _data; }
+
+	void appendImmutable(std::string const& _identifier) override;
+	void appendImmutableAssignment(std::string const& _identifier) override;
+
+	void markAsInvalid() override { m_invalid = true; }
+
+	/// @returns the bytecode of this assembly followed by its sub-assemblies and data.
+	/// Nothing can be appended afterwards.
+	/// @throws evmasm::AssemblyException if the assembly was marked as invalid or is malformed.
+	evmasm::LinkerObject const& assemble();
+	/// @returns the source mapping of the code of this assembly, not including its sub-assemblies.
+	std::string const& sourceMapping() const { return m_sourceMapping.mapping(); }
+
+	std::string const& name() const { return m_name; }
+	size_t numSubs() const { return m_subs.size(); }
+	BytecodeAssembly& sub(size_t _index) { return *m_subs.at(_index); }
+
+private:
+	/// A push whose size is only known when the object is assembled.
+	struct Reference
+	{
+		enum class Kind { Tag, Data, Sub, ProgramSize };
+		/// Position in m_code, which does not contain the push yet.
+		size_t position;
+		Kind kind;
+		/// The tag or the encoded sub path.
+		size_t id = 0;
+		util::h256 dataHash;
+	};
+
+	/// Accounts for an item other than a label that starts at @a _start in m_code, consumes
+	/// @a _arguments and produces @a _returns stack slots, takes up to @a _approximateSize bytes
+	/// and consists of @a _opcodeCount opcodes.
+	void appendItem(
+		size_t _start,
+		size_t _arguments,
+		size_t _returns,
+		size_t _approximateSize,
+		size_t _opcodeCount = 1,
+		evmasm::AssemblyItem::JumpType _jumpType = evmasm::AssemblyItem::JumpType::Ordinary
+	);
+	void appendReference(Reference _reference);
+	void appendJumpInstruction(evmasm::Instruction _instruction, JumpType _jumpType);
+
+	size_t encodeSubPath(std::vector<SubID> const& _subPath);
+	BytecodeAssembly& subAssemblyById(size_t _subId);
+	/// @returns the immutable references of the only sub-assembly that has any, or nullptr.
+	std::map<u256, std::pair<std::string, std::vector<size_t>>> const* subImmutableReferences();
+
+	std::map<std::string, unsigned> m_sourceIndices;
+	evmasm::SourceMappingWriter m_sourceMapping{m_sourceIndices};
+	std::string m_name;
+	langutil::SourceLocation m_currentLocation;
+	int m_stackHeight = 0;
+	bool m_invalid = false;
+
+	/// The code without the pushes in m_references.
+	bytes m_code;
+	std::vector<Reference> m_references;
+	/// Upper bound for the size of the code, counting each reference as its push instruction only.
+	size_t m_approximateCodeSize = 0;
+	size_t m_itemCount = 0;
+	/// Position in m_code and number of preceding references of the first item that is not a
+	/// label, whose position in the bytecode is used as the position of label zero.
+	std::optional<std::pair<size_t, size_t>> m_firstNonTagPosition;
+
+	struct NamedLabel
+	{
+		LabelID id;
+		std::optional<size_t> sourceID;
+		size_t params;
+		size_t returns;
+	};
+	/// Positions of the labels in m_code and later in the bytecode.
+	std::vector<size_t> m_labelPositions{std::numeric_limits<size_t>::max()};
+	std::map<std::string, NamedLabel> m_namedLabels;
+	/// Index of the item of each label for the debug data of the named labels.
+	std::map<LabelID, size_t> m_labelItemIndices;
+
+	std::vector<std::shared_ptr<BytecodeAssembly>> m_subs;
+	std::map<std::vector<SubID>, size_t> m_subPaths;
+	std::map<util::h256, bytes> m_data;
+	std::map<SubID, util::h256> m_dataHashBySubId;
+	SubID m_nextDataCounter = std::numeric_limits<SubID>::max() / 2;
+	bytes m_auxiliaryData;
+
+	/// Positions in m_code.
+	std::map<size_t, std::string> m_linkReferences;
+	std::map<u256, std::pair<std::string, std::vector<size_t>>> m_immutableReferences;
+	std::set<u256> m_assignedImmutables;
+	bool m_setsImmutables = false;
+	bool m_pushesImmutables = false;
+
+	std::optional<evmasm::LinkerObject> m_assembledObject;
+};
+
+}
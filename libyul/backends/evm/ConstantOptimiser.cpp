@@ -27,7 +27,9 @@
 #include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/FixedU256.h>
 
+#include <mutex>
 #include <variant>
 
 using namespace std;
@@ -62,7 +64,7 @@ struct MiniEVMInterpreter
 		case evmasm::Instruction::MUL:
 			return args.at(0) * args.at(1);
 		case evmasm::Instruction::EXP:
-			return exp256(args.at(0), args.at(1));
+			return u256(exp(FixedU256(args.at(0)), FixedU256(args.at(1))));
 		case evmasm::Instruction::SHL:
 			return args.at(0) > 255 ? 0 : (args.at(1) << unsigned(args.at(0)));
 		case evmasm::Instruction::NOT:
@@ -88,6 +90,60 @@ struct MiniEVMInterpreter
 
 	EVMDialect const& m_dialect;
 };
+
+/// A representation shared between the runs of the constant optimiser, together with the
+/// constants whose representations were looked up while searching for it. Looking them up
+/// again fills the cache of the current run in the same way as the search did.
+struct SharedRepresentation
+{
+	vector<u256> lookups;
+	shared_ptr<RepresentationRecipe const> recipe;
+};
+
+class SharedRepresentationCache
+{
+public:
+	using Key = tuple<langutil::EVMVersion, bool, bigint>;
+
+	static SharedRepresentationCache& instance()
+	{
+		static SharedRepresentationCache cache;
+		return cache;
+	}
+
+	shared_ptr<SharedRepresentation const> find(Key const& _key, u256 const& _value)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto representations = m_representations.find(_key);
+		if (representations == m_representations.end())
+			return nullptr;
+		auto representation = representations->second.find(_value);
+		if (representation == representations->second.end())
+			return nullptr;
+		return representation->second;
+	}
+
+	void insert(Key const& _key, u256 const& _value, shared_ptr<SharedRepresentation const> _representation)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto& representations = m_representations[_key];
+		// Stop growing in long-running processes, the remaining constants are searched for
+		// in every run.
+		if (representations.size() < maxRepresentations)
+			representations.emplace(_value, move(_representation));
+	}
+
+private:
+	static size_t constexpr maxRepresentations = 0x10000;
+
+	mutex m_mutex;
+	map<Key, map<u256, shared_ptr<SharedRepresentation const>>> m_representations;
+};
+
+SharedRepresentationCache::Key sharedCacheKey(EVMDialect const& _dialect, GasMeter const& _meter)
+{
+	return {_dialect.evmVersion(), _meter.isCreation(), _meter.runs()};
+}
 }
 
 void ConstantOptimiser::visit(Expression& _e)
@@ -123,9 +179,41 @@ Expression const* RepresentationFinder::tryFindRepresentation(u256 const& _value
 
 Representation const& RepresentationFinder::findRepresentation(u256 const& _value)
 {
+	if (!m_lookups.empty())
+		m_lookups.back().push_back(_value);
 	if (m_cache.count(_value))
 		return m_cache.at(_value);
 
+	SharedRepresentationCache::Key key = sharedCacheKey(m_dialect, m_meter);
+	m_lookups.emplace_back();
+	Representation routine;
+	if (auto shared = SharedRepresentationCache::instance().find(key, _value))
+	{
+		for (u256 const& value: shared->lookups)
+			findRepresentation(value);
+		routine = instantiate(*shared->recipe);
+		m_lookups.pop_back();
+	}
+	else
+	{
+		routine = searchRepresentation(_value);
+		vector<u256> lookups = move(m_lookups.back());
+		m_lookups.pop_back();
+		// An exhausted search might not have found the representation a complete one finds.
+		if (m_maxSteps > 0)
+			SharedRepresentationCache::instance().insert(
+				key,
+				_value,
+				make_shared<SharedRepresentation>(SharedRepresentation{move(lookups), routine.recipe})
+			);
+	}
+	// Other representations refer to this one by its value.
+	routine.recipe = make_shared<RepresentationRecipe>(RepresentationRecipe{{}, _value, true, {}});
+	return m_cache[_value] = move(routine);
+}
+
+Representation RepresentationFinder::searchRepresentation(u256 const& _value)
+{
 	Representation routine = represent(_value);
 
 	if (numberEncodingSize(~_value) < numberEncodingSize(_value))
@@ -174,7 +262,29 @@ Representation const& RepresentationFinder::findRepresentation(u256 const& _valu
 		routine = min(move(routine), move(newRoutine));
 	}
 	yulAssert(MiniEVMInterpreter{m_dialect}.eval(*routine.expression) == _value, "Invalid expression generated.");
-	return m_cache[_value] = move(routine);
+	return routine;
+}
+
+Representation RepresentationFinder::instantiate(RepresentationRecipe const& _recipe)
+{
+	if (_recipe.otherRepresentation)
+	{
+		Representation const& other = findRepresentation(_recipe.value);
+		return {make_unique<Expression>(ASTCopier{}.translate(*other.expression)), other.cost, other.recipe};
+	}
+	else if (_recipe.instruction.empty())
+		return represent(_recipe.value);
+	else if (_recipe.arguments.size() == 1)
+		return represent(_recipe.instruction, instantiate(*_recipe.arguments.at(0)));
+	else
+	{
+		yulAssert(_recipe.arguments.size() == 2, "");
+		return represent(
+			_recipe.instruction,
+			instantiate(*_recipe.arguments.at(0)),
+			instantiate(*_recipe.arguments.at(1))
+		);
+	}
 }
 
 Representation RepresentationFinder::represent(u256 const& _value) const
@@ -182,6 +292,7 @@ Representation RepresentationFinder::represent(u256 const& _value) const
 	Representation repr;
 	repr.expression = make_unique<Expression>(Literal{m_debugData, LiteralKind::Number, YulString{formatNumber(_value)}, {}});
 	repr.cost = m_meter.costs(*repr.expression);
+	repr.recipe = make_shared<RepresentationRecipe>(RepresentationRecipe{{}, _value, false, {}});
 	return repr;
 }
 
@@ -197,6 +308,7 @@ Representation RepresentationFinder::represent(
 		{ASTCopier{}.translate(*_argument.expression)}
 	});
 	repr.cost = _argument.cost + m_meter.instructionCosts(*m_dialect.builtin(_instruction)->instruction);
+	repr.recipe = make_shared<RepresentationRecipe>(RepresentationRecipe{_instruction, 0, false, {_argument.recipe}});
 	return repr;
 }
 
@@ -213,6 +325,7 @@ Representation RepresentationFinder::represent(
 		{ASTCopier{}.translate(*_arg1.expression), ASTCopier{}.translate(*_arg2.expression)}
 	});
 	repr.cost = m_meter.instructionCosts(*m_dialect.builtin(_instruction)->instruction) + _arg1.cost + _arg2.cost;
+	repr.recipe = make_shared<RepresentationRecipe>(RepresentationRecipe{_instruction, 0, false, {_arg1.recipe, _arg2.recipe}});
 	return repr;
 }
 
@@ -34,15 +34,35 @@
 #include <tuple>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace solidity::yul
 {
 struct Dialect;
 class GasMeter;
 
+/**
+ * How a representation of a constant is composed, without the debug data of its nodes: a literal,
+ * the representation of another constant or an instruction applied to further recipes.
+ */
+struct RepresentationRecipe
+{
+	/// The instruction, empty for literals and the representations of other constants.
+	YulString instruction;
+	/// The value of the literal or of the other constant.
+	u256 value;
+	bool otherRepresentation = false;
+	std::vector<std::shared_ptr<RepresentationRecipe const>> arguments;
+};
+
 /**
  * Optimisation stage that replaces constants by expressions that compute them.
  *
+ * The representations found are shared between all the runs for the same EVM version and gas
+ * meter settings, also across objects and compilations, in a thread-safe cache of recipes. The
+ * expressions are rebuilt from the recipes with the debug data of the current run, so that the
+ * result is the same as without the shared cache.
+ *
  * Prerequisite: None
  */
 class ConstantOptimiser: public ASTModifier
@@ -59,6 +79,7 @@ public:
 	{
 		std::unique_ptr<Expression> expression;
 		bigint cost;
+		std::shared_ptr<RepresentationRecipe const> recipe;
 	};
 
 private:
@@ -91,6 +112,10 @@ private:
 	/// Recursively try to find the cheapest representation of the given number,
 	/// literal if necessary.
 	Representation const& findRepresentation(u256 const& _value);
+	/// Searches for the cheapest representation of the given number without the shared cache.
+	Representation searchRepresentation(u256 const& _value);
+	/// @returns the representation built from @a _recipe with the debug data of this finder.
+	Representation instantiate(RepresentationRecipe const& _recipe);
 
 	Representation represent(u256 const& _value) const;
 	Representation represent(YulString _instruction, Representation const& _arg) const;
@@ -104,6 +129,9 @@ private:
 	/// Counter for the complexity of optimization, will stop when it reaches zero.
 	size_t m_maxSteps = 10000;
 	std::map<u256, Representation>& m_cache;
+	/// For each representation currently being searched, the constants whose representations
+	/// were looked up, in order.
+	std::vector<std::vector<u256>> m_lookups;
 };
 
 }
@@ -0,0 +1,264 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Gas estimation on the control flow graph of Yul code for the EVM.
+ */
+
+#include <libyul/backends/evm/ControlFlowGasEstimator.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Visitor.h>
+
+#include <range/v3/view/map.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+using GasConsumption = ControlFlowGasEstimator::GasConsumption;
+
+/// Costs of the stack manipulations and jumps the code generator adds around the operations.
+/// These are the gas price tiers of DUP1 and PUSH1, JUMP, JUMPI and JUMPDEST.
+unsigned const stackSlotGas = GasCosts::tier2Gas;
+unsigned const pushTagGas = GasCosts::tier2Gas;
+unsigned const jumpGas = GasCosts::tier4Gas;
+unsigned const conditionalJumpGas = GasCosts::tier5Gas;
+unsigned const jumpdestGas = GasCosts::jumpdestGas;
+
+/// @returns the worst case run gas of @a _instruction, not including memory expansion and the
+/// costs that depend on the size of the data it processes.
+GasConsumption instructionGas(Instruction _instruction, langutil::EVMVersion _evmVersion)
+{
+	switch (_instruction)
+	{
+	case Instruction::EXP:
+		return GasCosts::expGas + 32 * GasCosts::expByteGas(_evmVersion);
+	case Instruction::KECCAK256:
+		return GasCosts::keccak256Gas;
+	case Instruction::SLOAD:
+		return GasCosts::sloadGas(_evmVersion);
+	case Instruction::SSTORE:
+		return GasCosts::totalSstoreSetGas(_evmVersion);
+	case Instruction::BALANCE:
+		return GasCosts::balanceGas(_evmVersion);
+	case Instruction::EXTCODESIZE:
+	case Instruction::EXTCODECOPY:
+	case Instruction::EXTCODEHASH:
+		return GasCosts::extCodeGas(_evmVersion);
+	case Instruction::LOG0:
+	case Instruction::LOG1:
+	case Instruction::LOG2:
+	case Instruction::LOG3:
+	case Instruction::LOG4:
+		return GasCosts::logGas + GasCosts::logTopicGas * unsigned(getLogNumber(_instruction));
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		return GasCosts::createGas;
+	case Instruction::SELFDESTRUCT:
+		return GasCosts::selfdestructGas(_evmVersion) + GasCosts::callNewAccountGas;
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+		// The gas forwarded to the called contract is not known.
+		return GasConsumption::infinite();
+	default:
+		return GasMeter::runGas(_instruction);
+	}
+}
+
+/// @returns the blocks reachable from @a _entry that do not belong to called functions.
+vector<CFG::BasicBlock const*> reachableBlocks(CFG::BasicBlock const* _entry)
+{
+	vector<CFG::BasicBlock const*> blocks{_entry};
+	set<CFG::BasicBlock const*> visited{_entry};
+	auto visit = [&](CFG::BasicBlock const* _block) {
+		if (visited.insert(_block).second)
+			blocks.push_back(_block);
+	};
+	for (size_t i = 0; i < blocks.size(); ++i)
+		std::visit(util::GenericVisitor{
+			[&](CFG::BasicBlock::Jump const& _jump) { visit(_jump.target); },
+			[&](CFG::BasicBlock::ConditionalJump const& _jump) {
+				visit(_jump.nonZero);
+				visit(_jump.zero);
+			},
+			[](auto const&) {}
+		}, blocks[i]->exit);
+	return blocks;
+}
+
+}
+
+ControlFlowGasEstimator::ControlFlowGasEstimator(
+	CFG const& _cfg,
+	EVMDialect const& _dialect,
+	size_t _parallelism
+):
+	m_cfg(_cfg),
+	m_dialect(_dialect)
+{
+	for (yul::FunctionCall const& comparison: m_cfg.ghostCalls)
+	{
+		u256 value = valueOfLiteral(std::get<Literal>(comparison.arguments.at(0)));
+		YulString ghostVariable = std::get<Identifier>(comparison.arguments.at(1)).name;
+		m_switchComparisons[&comparison] = {value, ghostVariable};
+		m_switchCases[ghostVariable].insert(value);
+	}
+
+	// Functions are estimated once all the functions they call are, so that the functions in a
+	// recursion and their callers keep the infinite estimate.
+	map<Scope::Function const*, set<Scope::Function const*>> callees;
+	map<Scope::Function const*, set<Scope::Function const*>> callers;
+	for (auto const& [function, info]: m_cfg.functionInfo)
+	{
+		m_functionGas[function] = GasConsumption::infinite();
+		m_functionsByName[function->name] = function;
+		for (CFG::BasicBlock const* block: reachableBlocks(info.entry))
+			for (CFG::Operation const& operation: block->operations)
+				if (auto const* call = get_if<CFG::FunctionCall>(&operation.operation))
+				{
+					callees[function].insert(&call->function.get());
+					callers[&call->function.get()].insert(function);
+				}
+	}
+
+	vector<Scope::Function const*> ready;
+	for (Scope::Function const* function: m_cfg.functionInfo | ranges::views::keys)
+		if (callees[function].empty())
+			ready.push_back(function);
+	while (!ready.empty())
+	{
+		// The jobs only read the estimates of functions that were finished before.
+		util::parallelFor(ready.size(), _parallelism, [&](size_t _index) {
+			Scope::Function const* function = ready[_index];
+			BlockGas blockGasCache;
+			m_functionGas.at(function) =
+				GasConsumption(jumpdestGas) + blockGas(*m_cfg.functionInfo.at(function).entry, blockGasCache, nullopt);
+		});
+
+		vector<Scope::Function const*> next;
+		for (Scope::Function const* function: ready)
+			for (Scope::Function const* caller: callers[function])
+			{
+				set<Scope::Function const*>& remaining = callees.at(caller);
+				remaining.erase(function);
+				if (remaining.empty())
+					next.push_back(caller);
+			}
+		ready = move(next);
+	}
+}
+
+GasConsumption ControlFlowGasEstimator::mainGas(optional<u256> const& _switchValue) const
+{
+	yulAssert(m_cfg.entry, "");
+	BlockGas blockGasCache;
+	return blockGas(*m_cfg.entry, blockGasCache, _switchValue);
+}
+
+optional<GasConsumption> ControlFlowGasEstimator::functionGas(YulString _functionName) const
+{
+	if (auto function = m_functionsByName.find(_functionName); function != m_functionsByName.end())
+		return m_functionGas.at(function->second);
+	return nullopt;
+}
+
+GasConsumption ControlFlowGasEstimator::blockGas(
+	CFG::BasicBlock const& _block,
+	BlockGas& _blockGas,
+	optional<u256> const& _switchValue
+) const
+{
+	if (auto gas = _blockGas.find(&_block); gas != _blockGas.end())
+		return gas->second;
+
+	GasConsumption gas;
+	for (CFG::Operation const& operation: _block.operations)
+		gas += operationGas(operation);
+
+	std::visit(util::GenericVisitor{
+		[&](CFG::BasicBlock::MainExit const&) {},
+		[&](CFG::BasicBlock::Jump const& _jump) {
+			// Backwards jumps only occur in loops.
+			if (_jump.backwards)
+				gas = GasConsumption::infinite();
+			else
+				gas += GasConsumption(pushTagGas + jumpGas + jumpdestGas) + blockGas(*_jump.target, _blockGas, _switchValue);
+		},
+		[&](CFG::BasicBlock::ConditionalJump const& _jump) {
+			gas += GasConsumption(pushTagGas + conditionalJumpGas + jumpdestGas);
+			if (auto const* condition = get_if<TemporarySlot>(&_jump.condition))
+				if (auto comparison = m_switchComparisons.find(&condition->call.get()); comparison != m_switchComparisons.end())
+					if (_switchValue && m_switchCases.at(comparison->second.second).count(*_switchValue))
+					{
+						CFG::BasicBlock const* taken =
+							comparison->second.first == *_switchValue ? _jump.nonZero : _jump.zero;
+						gas += blockGas(*taken, _blockGas, _switchValue);
+						return;
+					}
+			gas += max(
+				blockGas(*_jump.nonZero, _blockGas, _switchValue),
+				blockGas(*_jump.zero, _blockGas, _switchValue)
+			);
+		},
+		[&](CFG::BasicBlock::FunctionReturn const&) { gas += GasConsumption(jumpGas); },
+		[&](CFG::BasicBlock::Terminated const&) {}
+	}, _block.exit);
+
+	return _blockGas[&_block] = gas;
+}
+
+GasConsumption ControlFlowGasEstimator::operationGas(CFG::Operation const& _operation) const
+{
+	GasConsumption gas{u256(stackSlotGas) * _operation.input.size()};
+	std::visit(util::GenericVisitor{
+		[&](CFG::FunctionCall const& _call) {
+			// Pushing the return label and the function, jumping there and back.
+			gas += GasConsumption(2 * pushTagGas + jumpGas + jumpdestGas);
+			gas += m_functionGas.at(&_call.function.get());
+		},
+		[&](CFG::BuiltinCall const& _call) {
+			BuiltinFunctionForEVM const* builtin = m_dialect.builtin(_call.functionCall.get().functionName.name);
+			yulAssert(builtin, "");
+			gas += builtinGas(*builtin);
+		},
+		[&](CFG::Assignment const& _assignment) {
+			gas += GasConsumption{u256(stackSlotGas) * _assignment.variables.size()};
+		}
+	}, _operation.operation);
+	return gas;
+}
+
+GasConsumption ControlFlowGasEstimator::builtinGas(BuiltinFunctionForEVM const& _builtin) const
+{
+	if (_builtin.instruction)
+		return instructionGas(*_builtin.instruction, m_dialect.evmVersion());
+	else if (_builtin.name == "datacopy"_yulstring)
+		return GasMeter::runGas(Instruction::CODECOPY);
+	else
+		// The remaining builtins push a value determined at compile time or link time.
+		return GasConsumption(pushTagGas);
+}
@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Gas estimation on the control flow graph of Yul code for the EVM.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+
+#include <libevmasm/GasMeter.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct BuiltinFunctionForEVM;
+struct EVMDialect;
+
+/**
+ * Estimates the gas consumed by the longest path through the main code and through each function
+ * of a control flow graph, where both branches of every conditional jump are considered.
+ *
+ * Builtins cost the run gas of their instructions, using the worst case for storage and account
+ * accesses, and every stack slot consumed by an operation is assumed to cost one stack
+ * manipulation. Memory expansion and the size dependent costs of copying, hashing and logging
+ * are not taken into account. Loops, recursion and external calls, whose forwarded gas is not
+ * known, result in an infinite estimate.
+ *
+ * The functions are estimated on up to @a _parallelism threads, callees before their callers.
+ */
+class ControlFlowGasEstimator
+{
+public:
+	using GasConsumption = evmasm::GasMeter::GasConsumption;
+
+	/// @a _cfg has to persist across the usage of this class.
+	ControlFlowGasEstimator(CFG const& _cfg, EVMDialect const& _dialect, size_t _parallelism = 1);
+
+	/// @returns the estimate of the main code. If @a _switchValue is given, the switches with a
+	/// case for this value, like the function dispatcher, only take this case.
+	GasConsumption mainGas(std::optional<u256> const& _switchValue = std::nullopt) const;
+	/// @returns the estimate of a call of the function with the given name, or nullopt if there
+	/// is no such function.
+	std::optional<GasConsumption> functionGas(YulString _functionName) const;
+
+private:
+	using BlockGas = std::map<CFG::BasicBlock const*, GasConsumption>;
+
+	/// @returns the estimate of the longest path starting at @a _block until the end of the
+	/// current function or of the main code.
+	GasConsumption blockGas(
+		CFG::BasicBlock const& _block,
+		BlockGas& _blockGas,
+		std::optional<u256> const& _switchValue
+	) const;
+	GasConsumption operationGas(CFG::Operation const& _operation) const;
+	GasConsumption builtinGas(BuiltinFunctionForEVM const& _builtin) const;
+
+	CFG const& m_cfg;
+	EVMDialect const& m_dialect;
+	/// Functions of the control flow graph together with their estimates.
+	std::map<Scope::Function const*, GasConsumption> m_functionGas;
+	std::map<YulString, Scope::Function const*> m_functionsByName;
+	/// The case value compared against and the ghost variable of the switch the comparison
+	/// belongs to, for the comparisons the control flow graph generates for switches.
+	std::map<yul::FunctionCall const*, std::pair<u256, YulString>> m_switchComparisons;
+	std::map<YulString, std::set<u256>> m_switchCases;
+};
+
+}
@@ -0,0 +1,311 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Dominator and loop nesting analysis of control flow graphs.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+#include <libyul/Exceptions.h>
+
+#include <libsolutil/Visitor.h>
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Computes the dominator tree of the vertices reachable from an entry vertex, using the
+ * iterative algorithm by Cooper, Harvey and Kennedy ("A Simple, Fast Dominance Algorithm").
+ *
+ * A vertex A dominates a vertex B, if every path from the entry to B contains A.
+ * ForEachSuccessor{}(_vertex, _callback) has to call _callback for every successor of _vertex.
+ * Vertices that are not reachable from the entry are not part of the analysis.
+ */
+template<typename Vertex, typename ForEachSuccessor>
+class DominatorFinder
+{
+public:
+	explicit DominatorFinder(Vertex const& _entry)
+	{
+		computeReversePostOrder(_entry);
+		computeImmediateDominators();
+		numberDominatorTree();
+	}
+
+	/// @returns the reachable vertices in reverse post order. The entry comes first.
+	std::vector<Vertex const*> const& reversePostOrder() const { return m_vertices; }
+
+	bool reachable(Vertex const& _vertex) const { return m_indices.count(&_vertex); }
+
+	/// @returns the immediate dominator of @a _vertex or nullptr for the entry.
+	Vertex const* immediateDominator(Vertex const& _vertex) const
+	{
+		size_t index = indexOf(_vertex);
+		return index == 0 ? nullptr : m_vertices[m_immediateDominators[index]];
+	}
+
+	/// @returns the vertices immediately dominated by @a _vertex, in reverse post order.
+	std::vector<Vertex const*> dominatorTreeChildren(Vertex const& _vertex) const
+	{
+		std::vector<Vertex const*> children;
+		for (size_t child: m_children[indexOf(_vertex)])
+			children.push_back(m_vertices[child]);
+		return children;
+	}
+
+	/// @returns true if @a _dominator dominates @a _vertex. Every vertex dominates itself.
+	bool dominates(Vertex const& _dominator, Vertex const& _vertex) const
+	{
+		size_t dominator = indexOf(_dominator);
+		size_t vertex = indexOf(_vertex);
+		return m_treeEntry[dominator] <= m_treeEntry[vertex] && m_treeExit[vertex] <= m_treeExit[dominator];
+	}
+
+	/// @returns the predecessors of @a _vertex among the reachable vertices.
+	std::vector<Vertex const*> predecessors(Vertex const& _vertex) const
+	{
+		std::vector<Vertex const*> result;
+		for (size_t predecessor: m_predecessors[indexOf(_vertex)])
+			result.push_back(m_vertices[predecessor]);
+		return result;
+	}
+
+private:
+	size_t indexOf(Vertex const& _vertex) const
+	{
+		auto it = m_indices.find(&_vertex);
+		yulAssert(it != m_indices.end(), "Vertex not reachable from the entry.");
+		return it->second;
+	}
+
+	void computeReversePostOrder(Vertex const& _entry)
+	{
+		// Iterative depth-first search, so that deeply nested code cannot overflow the stack.
+		std::set<Vertex const*> visited;
+		std::vector<Vertex const*> postOrder;
+		std::vector<std::pair<Vertex const*, std::vector<Vertex const*>>> stack;
+		auto enter = [&](Vertex const* _vertex) {
+			visited.insert(_vertex);
+			std::vector<Vertex const*> successors;
+			ForEachSuccessor{}(*_vertex, [&](Vertex const& _successor) { successors.push_back(&_successor); });
+			// The successors are taken from the back.
+			std::reverse(successors.begin(), successors.end());
+			stack.emplace_back(_vertex, std::move(successors));
+		};
+		enter(&_entry);
+		while (!stack.empty())
+		{
+			auto& [vertex, successors] = stack.back();
+			if (successors.empty())
+			{
+				postOrder.push_back(vertex);
+				stack.pop_back();
+				continue;
+			}
+			Vertex const* successor = successors.back();
+			successors.pop_back();
+			if (!visited.count(successor))
+				enter(successor);
+		}
+
+		m_vertices.assign(postOrder.rbegin(), postOrder.rend());
+		for (size_t i = 0; i < m_vertices.size(); ++i)
+			m_indices[m_vertices[i]] = i;
+
+		m_predecessors.resize(m_vertices.size());
+		for (size_t i = 0; i < m_vertices.size(); ++i)
+			ForEachSuccessor{}(*m_vertices[i], [&](Vertex const& _successor) {
+				m_predecessors[m_indices.at(&_successor)].push_back(i);
+			});
+	}
+
+	void computeImmediateDominators()
+	{
+		std::vector<std::optional<size_t>> dominators(m_vertices.size());
+		dominators[0] = 0;
+		auto intersect = [&](size_t _a, size_t _b) {
+			while (_a != _b)
+			{
+				while (_a > _b)
+					_a = *dominators[_a];
+				while (_b > _a)
+					_b = *dominators[_b];
+			}
+			return _a;
+		};
+		for (bool changed = true; changed;)
+		{
+			changed = false;
+			for (size_t vertex = 1; vertex < m_vertices.size(); ++vertex)
+			{
+				std::optional<size_t> newDominator;
+				for (size_t predecessor: m_predecessors[vertex])
+					if (dominators[predecessor])
+						newDominator = newDominator ? intersect(*newDominator, predecessor) : predecessor;
+				yulAssert(newDominator, "");
+				if (dominators[vertex] != newDominator)
+				{
+					dominators[vertex] = newDominator;
+					changed = true;
+				}
+			}
+		}
+		m_immediateDominators.clear();
+		for (auto const& dominator: dominators)
+			m_immediateDominators.push_back(*dominator);
+	}
+
+	/// Numbers the vertices in the order in which a depth-first traversal of the dominator tree
+	/// enters and leaves them, so that dominance queries take constant time.
+	void numberDominatorTree()
+	{
+		m_children.resize(m_vertices.size());
+		for (size_t vertex = 1; vertex < m_vertices.size(); ++vertex)
+			m_children[m_immediateDominators[vertex]].push_back(vertex);
+
+		m_treeEntry.resize(m_vertices.size());
+		m_treeExit.resize(m_vertices.size());
+		size_t counter = 0;
+		std::vector<std::pair<size_t, size_t>> stack{{0, 0}};
+		m_treeEntry[0] = counter++;
+		while (!stack.empty())
+		{
+			auto& [vertex, nextChild] = stack.back();
+			if (nextChild == m_children[vertex].size())
+			{
+				m_treeExit[vertex] = counter++;
+				stack.pop_back();
+				continue;
+			}
+			size_t child = m_children[vertex][nextChild++];
+			m_treeEntry[child] = counter++;
+			stack.emplace_back(child, 0);
+		}
+	}
+
+	/// Reachable vertices in reverse post order.
+	std::vector<Vertex const*> m_vertices;
+	std::map<Vertex const*, size_t> m_indices;
+	/// Predecessors of each vertex, as indices into m_vertices.
+	std::vector<std::vector<size_t>> m_predecessors;
+	/// Immediate dominator of each vertex, as index into m_vertices. The entry dominates itself.
+	std::vector<size_t> m_immediateDominators;
+	/// Children of each vertex in the dominator tree.
+	std::vector<std::vector<size_t>> m_children;
+	std::vector<size_t> m_treeEntry;
+	std::vector<size_t> m_treeExit;
+};
+
+/**
+ * Determines the natural loops of a control flow graph based on its dominator tree.
+ *
+ * An edge from B to H is a back edge if H dominates B. The natural loop of the loop
+ * header H consists of H and all vertices that can reach the source of a back edge to H
+ * without passing through H.
+ */
+template<typename Vertex, typename ForEachSuccessor>
+class LoopNestingFinder
+{
+public:
+	explicit LoopNestingFinder(DominatorFinder<Vertex, ForEachSuccessor> const& _dominators)
+	{
+		for (Vertex const* vertex: _dominators.reversePostOrder())
+			ForEachSuccessor{}(*vertex, [&](Vertex const& _successor) {
+				if (_dominators.dominates(_successor, *vertex))
+					addToLoop(_dominators, _successor, *vertex);
+			});
+		for (Vertex const* vertex: _dominators.reversePostOrder())
+			if (m_loops.count(vertex))
+				m_headers.push_back(vertex);
+	}
+
+	/// @returns the headers of all loops, in reverse post order of the graph.
+	std::vector<Vertex const*> const& loopHeaders() const { return m_headers; }
+
+	/// @returns the number of loops containing @a _vertex.
+	size_t loopDepth(Vertex const& _vertex) const
+	{
+		size_t depth = 0;
+		for (auto const& [header, body]: m_loops)
+			if (body.count(&_vertex))
+				++depth;
+		return depth;
+	}
+
+	/// @returns true if @a _vertex is part of the loop with the header @a _header.
+	bool inLoop(Vertex const& _header, Vertex const& _vertex) const
+	{
+		auto it = m_loops.find(&_header);
+		return it != m_loops.end() && it->second.count(&_vertex);
+	}
+
+private:
+	void addToLoop(
+		DominatorFinder<Vertex, ForEachSuccessor> const& _dominators,
+		Vertex const& _header,
+		Vertex const& _backEdgeSource
+	)
+	{
+		std::set<Vertex const*>& body = m_loops[&_header];
+		body.insert(&_header);
+		std::vector<Vertex const*> toVisit{&_backEdgeSource};
+		while (!toVisit.empty())
+		{
+			Vertex const* vertex = toVisit.back();
+			toVisit.pop_back();
+			if (!body.insert(vertex).second)
+				continue;
+			for (Vertex const* predecessor: _dominators.predecessors(*vertex))
+				toVisit.push_back(predecessor);
+		}
+	}
+
+	/// Vertices of the natural loop of each loop header.
+	std::map<Vertex const*, std::set<Vertex const*>> m_loops;
+	std::vector<Vertex const*> m_headers;
+};
+
+/// Calls the callback for each block the control flow can continue with after @a _block.
+struct ForEachCFGSuccessor
+{
+	template<typename Callback>
+	void operator()(CFG::BasicBlock const& _block, Callback&& _callback) const
+	{
+		std::visit(util::GenericVisitor{
+			[&](CFG::BasicBlock::Jump const& _jump) { _callback(*_jump.target); },
+			[&](CFG::BasicBlock::ConditionalJump const& _jump) {
+				_callback(*_jump.nonZero);
+				_callback(*_jump.zero);
+			},
+			[](auto const&) {}
+		}, _block.exit);
+	}
+};
+
+using CFGDominatorFinder = DominatorFinder<CFG::BasicBlock, ForEachCFGSuccessor>;
+using CFGLoopNestingFinder = LoopNestingFinder<CFG::BasicBlock, ForEachCFGSuccessor>;
+
+}
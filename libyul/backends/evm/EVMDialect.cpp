@@ -31,6 +31,8 @@
 #include <libevmasm/SemanticInformation.h>
 #include <libevmasm/Instruction.h>
 
+#include <libsolutil/LazyInit.h>
+
 #include <liblangutil/Exceptions.h>
 
 #include <range/v3/view/reverse.hpp>
@@ -51,7 +53,7 @@ pair<YulString, BuiltinFunctionForEVM> createEVMFunction(
 	evmasm::Instruction _instruction
 )
 {
-	evmasm::InstructionInfo info = evmasm::instructionInfo(_instruction);
+	evmasm::InstructionInfo const& info = evmasm::instructionInfo(_instruction);
 	BuiltinFunctionForEVM f;
 	f.name = YulString{_name};
 	f.parameters.resize(static_cast<size_t>(info.args));
@@ -319,22 +321,54 @@ bool EVMDialect::reservedIdentifier(YulString _name) const
 	return m_reserved.count(_name) != 0;
 }
 
+namespace
+{
+
+/// The dialects of all EVM versions, each created on first use. The map itself is not modified
+/// after its construction, so that it can be read from multiple threads without locking.
+template<typename DialectType>
+class DialectCache
+{
+public:
+	DialectCache()
+	{
+		for (langutil::EVMVersion version: langutil::EVMVersion::allVersions())
+			m_dialects[version];
+	}
+
+	template<typename... Args>
+	DialectType const& get(langutil::EVMVersion _version, Args... _args)
+	{
+		return *m_dialects.at(_version).init([&] {
+			return make_unique<DialectType const>(_version, _args...);
+		});
+	}
+
+	/// Has to be called only while no other thread uses the dialects, like the reset of the YulStringRepository.
+	void reset()
+	{
+		for (auto& dialect: m_dialects)
+			dialect.second.reset();
+	}
+
+private:
+	map<langutil::EVMVersion, ConcurrentLazyInit<unique_ptr<DialectType const>>> m_dialects;
+};
+
+}
+
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version)
 {
-	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[_version])
-		dialects[_version] = make_unique<EVMDialect>(_version, false);
-	return *dialects[_version];
+	static DialectCache<EVMDialect> dialects;
+	static YulStringRepository::ResetCallback callback{[&] { dialects.reset(); }};
+	return dialects.get(_version, false);
 }
 
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _version)
 {
-	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[_version])
-		dialects[_version] = make_unique<EVMDialect>(_version, true);
-	return *dialects[_version];
+	static DialectCache<EVMDialect> dialects;
+	static YulStringRepository::ResetCallback callback{[&] { dialects.reset(); }};
+	return dialects.get(_version, true);
 }
 
 SideEffects EVMDialect::sideEffectsOfInstruction(evmasm::Instruction _instruction)
@@ -485,9 +519,7 @@ BuiltinFunctionForEVM const* EVMDialectTyped::equalityFunction(YulString _type)
 
 EVMDialectTyped const& EVMDialectTyped::instance(langutil::EVMVersion _version)
 {
-	static map<langutil::EVMVersion, unique_ptr<EVMDialectTyped const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[_version])
-		dialects[_version] = make_unique<EVMDialectTyped>(_version, true);
-	return *dialects[_version];
+	static DialectCache<EVMDialectTyped> dialects;
+	static YulStringRepository::ResetCallback callback{[&] { dialects.reset(); }};
+	return dialects.get(_version, true);
 }
@@ -54,6 +54,9 @@ public:
 	/// the costs for its arguments.
 	bigint instructionCosts(evmasm::Instruction _instruction) const;
 
+	bool isCreation() const { return m_isCreation; }
+	bigint const& runs() const { return m_runs; }
+
 private:
 	bigint combineCosts(std::pair<bigint, bigint> _costs) const;
 
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace solidity::yul
 {
 struct Object;
@@ -30,16 +32,25 @@ struct EVMDialect;
 class EVMObjectCompiler
 {
 public:
-	static void compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _optimize);
+	/// @param _parallelism the maximum number of threads used to compute the stack layouts
+	/// of the optimized code transform. Does not affect the resulting code.
+	static void compile(
+		Object& _object,
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		bool _optimize,
+		size_t _parallelism = 1
+	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect):
-		m_assembly(_assembly), m_dialect(_dialect)
+	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, size_t _parallelism):
+		m_assembly(_assembly), m_dialect(_dialect), m_parallelism(_parallelism)
 	{}
 
 	void run(Object& _object, bool _optimize);
 
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
+	size_t m_parallelism = 1;
 };
 
 }
@@ -23,6 +23,7 @@
 
 #include <libyul/Utilities.h>
 
+#include <libsolutil/Timing.h>
 #include <libsolutil/Visitor.h>
 #include <libsolutil/cxx20.h>
 
@@ -44,17 +45,28 @@ vector<StackTooDeepError> OptimizedEVMCodeTransform::run(
 	Block const& _block,
 	EVMDialect const& _dialect,
 	BuiltinContext& _builtinContext,
-	UseNamedLabels _useNamedLabelsForFunctions
+	UseNamedLabels _useNamedLabelsForFunctions,
+	size_t _parallelism
 )
 {
-	std::unique_ptr<CFG> dfg = ControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
-	StackLayout stackLayout = StackLayoutGenerator::run(*dfg);
+	util::ScopedTraceSpan span("OptimizedEVMCodeTransform", "yul");
+	std::unique_ptr<CFG> dfg;
+	{
+		util::ScopedTraceSpan buildSpan("ControlFlowGraphBuilder", "yul");
+		dfg = ControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
+	}
+	StackShuffleCache shuffleCache;
+	StackLayout stackLayout = [&]() {
+		util::ScopedTraceSpan layoutSpan("StackLayoutGenerator", "yul");
+		return StackLayoutGenerator::run(*dfg, shuffleCache, _parallelism);
+	}();
 	OptimizedEVMCodeTransform optimizedCodeTransform(
 		_assembly,
 		_builtinContext,
 		_useNamedLabelsForFunctions,
 		*dfg,
-		stackLayout
+		stackLayout,
+		shuffleCache
 	);
 	// Create initial entry layout.
 	optimizedCodeTransform.createStackLayout(debugDataOf(*dfg->entry), stackLayout.blockInfos.at(dfg->entry).entryLayout);
@@ -172,12 +184,14 @@ OptimizedEVMCodeTransform::OptimizedEVMCodeTransform(
 	BuiltinContext& _builtinContext,
 	UseNamedLabels _useNamedLabelsForFunctions,
 	CFG const& _dfg,
-	StackLayout const& _stackLayout
+	StackLayout const& _stackLayout,
+	StackShuffleCache& _shuffleCache
 ):
 	m_assembly(_assembly),
 	m_builtinContext(_builtinContext),
 	m_dfg(_dfg),
 	m_stackLayout(_stackLayout),
+	m_shuffleCache(_shuffleCache),
 	m_functionLabels([&](){
 		map<CFG::FunctionInfo const*, AbstractAssembly::LabelID> functionLabels;
 		set<YulString> assignedFunctionNames;
@@ -353,7 +367,8 @@ void OptimizedEVMCodeTransform::createStackLayout(std::shared_ptr<DebugData cons
 		[&]()
 		{
 			m_assembly.appendInstruction(evmasm::Instruction::POP);
-		}
+		},
+		m_shuffleCache
 	);
 	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
 }
@@ -39,6 +39,7 @@ namespace solidity::yul
 {
 struct AsmAnalysisInfo;
 struct StackLayout;
+class StackShuffleCache;
 
 class OptimizedEVMCodeTransform
 {
@@ -47,13 +48,16 @@ public:
 	/// 2) For none of the functions 3) for the first function of each name.
 	enum class UseNamedLabels { YesAndForceUnique, Never, ForFirstFunctionOfEachName };
 
+	/// Generates code for @a _block. Computes the stack layouts of the functions on up to @a _parallelism
+	/// threads, but emits the code of all of them into @a _assembly in a fixed order.
 	[[nodiscard]] static std::vector<StackTooDeepError> run(
 		AbstractAssembly& _assembly,
 		AsmAnalysisInfo& _analysisInfo,
 		Block const& _block,
 		EVMDialect const& _dialect,
 		BuiltinContext& _builtinContext,
-		UseNamedLabels _useNamedLabelsForFunctions
+		UseNamedLabels _useNamedLabelsForFunctions,
+		size_t _parallelism = 1
 	);
 
 	/// Generate code for the function call @a _call. Only public for using with std::visit.
@@ -68,7 +72,8 @@ private:
 		BuiltinContext& _builtinContext,
 		UseNamedLabels _useNamedLabelsForFunctions,
 		CFG const& _dfg,
-		StackLayout const& _stackLayout
+		StackLayout const& _stackLayout,
+		StackShuffleCache& _shuffleCache
 	);
 
 	/// Assert that it is valid to transition from @a _currentStack to @a _desiredStack.
@@ -101,6 +106,8 @@ private:
 	BuiltinContext& m_builtinContext;
 	CFG const& m_dfg;
 	StackLayout const& m_stackLayout;
+	/// Shared with the stack layout generator, which already shuffles between most of the same layouts.
+	StackShuffleCache& m_shuffleCache;
 	Stack m_stack;
 	std::map<yul::FunctionCall const*, AbstractAssembly::LabelID> m_returnLabels;
 	std::map<CFG::BasicBlock const*, AbstractAssembly::LabelID> m_blockLabels;
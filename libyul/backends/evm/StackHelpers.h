@@ -30,6 +30,10 @@
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/take.hpp>
 
+#include <limits>
+#include <map>
+#include <vector>
+
 namespace solidity::yul
 {
 
@@ -340,6 +344,68 @@ private:
 };
 
 
+/// Memoises the operations performed by ``createStackLayout`` to transform one stack layout into another.
+/// The shuffler only ever compares slots with each other and checks whether target slots are junk, so
+/// the operations only depend on which slots of the source and target layouts are equal. A layout pair
+/// is therefore keyed by replacing each slot with a number identifying its value, and the operations
+/// found for one layout pair are replayed for all layout pairs with the same key.
+class StackShuffleCache
+{
+public:
+	struct Operation
+	{
+		enum class Kind { Swap, PushOrDup, Pop };
+		Kind kind = Kind::Pop;
+		/// The depth for swaps and the offset of the pushed or dupped slot in the target layout.
+		size_t argument = 0;
+	};
+
+	/// @returns the key of shuffling @a _source to @a _target: the numbers of the source slots, followed by
+	/// a separator and the numbers of the target slots. Junk slots are numbered zero, all other slots are
+	/// numbered in the order of their first occurrence.
+	static std::vector<size_t> key(Stack const& _source, Stack const& _target)
+	{
+		std::map<StackSlot, size_t> numbers{{JunkSlot{}, 0}};
+		std::vector<size_t> result;
+		result.reserve(_source.size() + _target.size() + 1);
+		auto number = [&](StackSlot const& _slot) {
+			return numbers.emplace(_slot, numbers.size()).first->second;
+		};
+		for (auto const& slot: _source)
+			result.push_back(number(slot));
+		result.push_back(std::numeric_limits<size_t>::max());
+		for (auto const& slot: _target)
+			result.push_back(number(slot));
+		return result;
+	}
+
+	/// @returns the operations stored for @a _key or nullptr if there are none.
+	std::vector<Operation> const* find(std::vector<size_t> const& _key) const
+	{
+		auto it = m_operations.find(_key);
+		return it == m_operations.end() ? nullptr : &it->second;
+	}
+	void store(std::vector<size_t> _key, std::vector<Operation> _operations)
+	{
+		m_operations.emplace(std::move(_key), std::move(_operations));
+	}
+
+private:
+	std::map<std::vector<size_t>, std::vector<Operation>> m_operations;
+};
+
+/// Asserts that @a _currentStack matches @a _targetStack after shuffling and replaces the slots
+/// at the positions of junk slots in @a _targetStack by junk slots.
+inline void assertStackLayoutReached(Stack& _currentStack, Stack const& _targetStack)
+{
+	yulAssert(_currentStack.size() == _targetStack.size(), "");
+	for (auto&& [current, target]: ranges::zip_view(_currentStack, _targetStack))
+		if (std::holds_alternative<JunkSlot>(target))
+			current = JunkSlot{};
+		else
+			yulAssert(current == target, "");
+}
+
 /// Transforms @a _currentStack to @a _targetStack, invoking the provided shuffling operations.
 /// Modifies @a _currentStack itself after each invocation of the shuffling operations.
 /// @a _swap is a function with signature void(unsigned) that is called when the top most slot is swapped with
@@ -418,12 +484,69 @@ void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _sw
 
 	Shuffler<ShuffleOperations>::shuffle(_currentStack, _targetStack, _swap, _pushOrDup, _pop);
 
-	yulAssert(_currentStack.size() == _targetStack.size(), "");
-	for (auto&& [current, target]: ranges::zip_view(_currentStack, _targetStack))
-		if (std::holds_alternative<JunkSlot>(target))
-			current = JunkSlot{};
-		else
-			yulAssert(current == target, "");
+	assertStackLayoutReached(_currentStack, _targetStack);
+}
+
+/// Same as above, but replays the operations found for an earlier layout pair with the same key in @a _cache,
+/// if there is one, and stores the operations in @a _cache otherwise.
+template<typename Swap, typename PushOrDup, typename Pop>
+void createStackLayout(
+	Stack& _currentStack,
+	Stack const& _targetStack,
+	Swap _swap,
+	PushOrDup _pushOrDup,
+	Pop _pop,
+	StackShuffleCache& _cache
+)
+{
+	using Operation = StackShuffleCache::Operation;
+	std::vector<size_t> key = StackShuffleCache::key(_currentStack, _targetStack);
+	if (std::vector<Operation> const* operations = _cache.find(key))
+	{
+		// Invokes the callbacks in the same order and on the same intermediate layouts as the shuffler.
+		for (Operation const& operation: *operations)
+			switch (operation.kind)
+			{
+			case Operation::Kind::Swap:
+				_swap(static_cast<unsigned>(operation.argument));
+				std::swap(_currentStack.at(_currentStack.size() - operation.argument - 1), _currentStack.back());
+				break;
+			case Operation::Kind::PushOrDup:
+			{
+				StackSlot const& slot = _targetStack.at(operation.argument);
+				_pushOrDup(slot);
+				_currentStack.push_back(slot);
+				break;
+			}
+			case Operation::Kind::Pop:
+				_pop();
+				_currentStack.pop_back();
+				break;
+			}
+		assertStackLayoutReached(_currentStack, _targetStack);
+		return;
+	}
+
+	std::vector<Operation> recorded;
+	createStackLayout(
+		_currentStack,
+		_targetStack,
+		[&](unsigned _i) {
+			recorded.push_back({Operation::Kind::Swap, _i});
+			_swap(_i);
+		},
+		[&](StackSlot const& _slot) {
+			// The shuffler always pushes or dups a slot of the target layout itself.
+			yulAssert(_targetStack.data() <= &_slot && &_slot < _targetStack.data() + _targetStack.size(), "");
+			recorded.push_back({Operation::Kind::PushOrDup, static_cast<size_t>(&_slot - _targetStack.data())});
+			_pushOrDup(_slot);
+		},
+		[&]() {
+			recorded.push_back({Operation::Kind::Pop, 0});
+			_pop();
+		}
+	);
+	_cache.store(std::move(key), std::move(recorded));
 }
 
 }
@@ -25,6 +25,7 @@
 
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/cxx20.h>
+#include <libsolutil/Parallel.h>
 #include <libsolutil/Visitor.h>
 
 #include <range/v3/algorithm/any_of.hpp>
@@ -36,7 +37,6 @@
 #include <range/v3/view/drop_last.hpp>
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/iota.hpp>
-#include <range/v3/view/map.hpp>
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/take.hpp>
 #include <range/v3/view/take_last.hpp>
@@ -48,28 +48,54 @@ using namespace std;
 
 StackLayout StackLayoutGenerator::run(CFG const& _cfg)
 {
-	StackLayout stackLayout;
-	StackLayoutGenerator{stackLayout}.processEntryPoint(*_cfg.entry);
+	StackShuffleCache shuffleCache;
+	return run(_cfg, shuffleCache);
+}
+
+StackLayout StackLayoutGenerator::run(CFG const& _cfg, StackShuffleCache& _shuffleCache, size_t _parallelism)
+{
+	vector<CFG::BasicBlock const*> entries{_cfg.entry};
+	for (Scope::Function const* function: _cfg.functions)
+		entries.emplace_back(_cfg.functionInfo.at(function).entry);
 
-	for (auto& functionInfo: _cfg.functionInfo | ranges::views::values)
-		StackLayoutGenerator{stackLayout}.processEntryPoint(*functionInfo.entry);
+	StackLayout stackLayout;
+	if (_parallelism <= 1 || entries.size() <= 1)
+	{
+		for (CFG::BasicBlock const* entry: entries)
+			StackLayoutGenerator{stackLayout, _shuffleCache}.processEntryPoint(*entry);
+		return stackLayout;
+	}
 
+	// The main entry point and each function have their own blocks and operations, so their
+	// layouts can be computed separately and merged afterwards. The shuffle cache is not
+	// thread-safe, so all but the first job use a private one.
+	vector<StackLayout> layouts(entries.size());
+	vector<StackShuffleCache> shuffleCaches(entries.size() - 1);
+	util::parallelFor(entries.size(), _parallelism, [&](size_t _index) {
+		StackShuffleCache& shuffleCache = _index == 0 ? _shuffleCache : shuffleCaches[_index - 1];
+		StackLayoutGenerator{layouts[_index], shuffleCache}.processEntryPoint(*entries[_index]);
+	});
+	for (StackLayout& layout: layouts)
+	{
+		stackLayout.blockInfos.merge(layout.blockInfos);
+		stackLayout.operationEntryLayout.merge(layout.operationEntryLayout);
+	}
 	return stackLayout;
 }
 
 map<YulString, vector<StackLayoutGenerator::StackTooDeep>> StackLayoutGenerator::reportStackTooDeep(CFG const& _cfg)
 {
+	StackShuffleCache shuffleCache;
 	map<YulString, vector<StackLayoutGenerator::StackTooDeep>> stackTooDeepErrors;
-	stackTooDeepErrors[YulString{}] = reportStackTooDeep(_cfg, YulString{});
-	for (auto const& function: _cfg.functions)
-		if (auto errors = reportStackTooDeep(_cfg, function->name); !errors.empty())
+	stackTooDeepErrors[YulString{}] = reportStackTooDeep(*_cfg.entry, shuffleCache);
+	for (Scope::Function const* function: _cfg.functions)
+		if (auto errors = reportStackTooDeep(*_cfg.functionInfo.at(function).entry, shuffleCache); !errors.empty())
 			stackTooDeepErrors[function->name] = move(errors);
 	return stackTooDeepErrors;
 }
 
 vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooDeep(CFG const& _cfg, YulString _functionName)
 {
-	StackLayout stackLayout;
 	CFG::FunctionInfo const* functionInfo = nullptr;
 	if (!_functionName.empty())
 	{
@@ -81,20 +107,35 @@ vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooD
 		yulAssert(functionInfo, "Function not found.");
 	}
 
-	StackLayoutGenerator generator{stackLayout};
-	CFG::BasicBlock const* entry = functionInfo ? functionInfo->entry : _cfg.entry;
-	generator.processEntryPoint(*entry);
-	return generator.reportStackTooDeep(*entry);
+	StackShuffleCache shuffleCache;
+	return reportStackTooDeep(functionInfo ? *functionInfo->entry : *_cfg.entry, shuffleCache);
+}
+
+vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooDeep(
+	CFG::BasicBlock const& _entry,
+	StackShuffleCache& _shuffleCache
+)
+{
+	StackLayout stackLayout;
+	StackLayoutGenerator generator{stackLayout, _shuffleCache};
+	generator.processEntryPoint(_entry);
+	return generator.reportStackTooDeep(_entry);
 }
 
-StackLayoutGenerator::StackLayoutGenerator(StackLayout& _layout): m_layout(_layout)
+StackLayoutGenerator::StackLayoutGenerator(StackLayout& _layout, StackShuffleCache& _shuffleCache):
+	m_layout(_layout),
+	m_shuffleCache(_shuffleCache)
 {
 }
 
 namespace
 {
 /// @returns all stack too deep errors that would occur when shuffling @a _source to @a _target.
-vector<StackLayoutGenerator::StackTooDeep> findStackTooDeep(Stack const& _source, Stack const& _target)
+vector<StackLayoutGenerator::StackTooDeep> findStackTooDeep(
+	Stack const& _source,
+	Stack const& _target,
+	StackShuffleCache& _shuffleCache
+)
 {
 	Stack currentStack = _source;
 	vector<StackLayoutGenerator::StackTooDeep> stackTooDeepErrors;
@@ -130,7 +171,8 @@ vector<StackLayoutGenerator::StackTooDeep> findStackTooDeep(Stack const& _source
 					getVariableChoices(currentStack | ranges::views::take_last(*depth + 1))
 				});
 		},
-		[&]() {}
+		[&]() {},
+		_shuffleCache
 	);
 	return stackTooDeepErrors;
 }
@@ -320,7 +362,7 @@ Stack StackLayoutGenerator::propagateStackThroughBlock(Stack _exitStack, CFG::Ba
 	for (auto&& [idx, operation]: _block.operations | ranges::views::enumerate | ranges::views::reverse)
 	{
 		Stack newStack = propagateStackThroughOperation(stack, operation, _aggressiveStackCompression);
-		if (!_aggressiveStackCompression && !findStackTooDeep(newStack, stack).empty())
+		if (!_aggressiveStackCompression && !findStackTooDeep(newStack, stack, m_shuffleCache).empty())
 			// If we had stack errors, run again with aggressive stack compression.
 			return propagateStackThroughBlock(move(_exitStack), _block, true);
 		stack = move(newStack);
@@ -541,7 +583,7 @@ void StackLayoutGenerator::stitchConditionalJumps(CFG::BasicBlock const& _block)
 	});
 }
 
-Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2)
+Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2) const
 {
 	// TODO: it would be nicer to replace this by a constructive algorithm.
 	// Currently it uses a reduced version of the Heap Algorithm to partly brute-force, which seems
@@ -586,9 +628,9 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 			if (depth && *depth >= 16)
 				numOps += 1000;
 		};
-		createStackLayout(testStack, stack1Tail, swap, dupOrPush, [&](){});
+		createStackLayout(testStack, stack1Tail, swap, dupOrPush, [&](){}, m_shuffleCache);
 		testStack = _candidate;
-		createStackLayout(testStack, stack2Tail, swap, dupOrPush, [&](){});
+		createStackLayout(testStack, stack2Tail, swap, dupOrPush, [&](){}, m_shuffleCache);
 		return numOps;
 	};
 
@@ -639,7 +681,7 @@ vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooD
 		{
 			Stack& operationEntry = m_layout.operationEntryLayout.at(&operation);
 
-			stackTooDeepErrors += findStackTooDeep(currentStack, operationEntry);
+			stackTooDeepErrors += findStackTooDeep(currentStack, operationEntry, m_shuffleCache);
 			currentStack = operationEntry;
 			for (size_t i = 0; i < operation.input.size(); i++)
 				currentStack.pop_back();
@@ -653,7 +695,7 @@ vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooD
 			[&](CFG::BasicBlock::Jump const& _jump)
 			{
 				Stack const& targetLayout = m_layout.blockInfos.at(_jump.target).entryLayout;
-				stackTooDeepErrors += findStackTooDeep(currentStack, targetLayout);
+				stackTooDeepErrors += findStackTooDeep(currentStack, targetLayout, m_shuffleCache);
 
 				if (!_jump.backwards)
 					_addChild(_jump.target);
@@ -664,7 +706,7 @@ vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooD
 					m_layout.blockInfos.at(_conditionalJump.zero).entryLayout,
 					m_layout.blockInfos.at(_conditionalJump.nonZero).entryLayout
 				})
-					stackTooDeepErrors += findStackTooDeep(currentStack, targetLayout);
+					stackTooDeepErrors += findStackTooDeep(currentStack, targetLayout, m_shuffleCache);
 
 				_addChild(_conditionalJump.zero);
 				_addChild(_conditionalJump.nonZero);
@@ -28,6 +28,8 @@
 namespace solidity::yul
 {
 
+class StackShuffleCache;
+
 struct StackLayout
 {
 	struct BlockInfo
@@ -56,9 +58,15 @@ public:
 	};
 
 	static StackLayout run(CFG const& _cfg);
+	/// Same as above, but reuses and stores the stack shuffling operations in @a _shuffleCache.
+	/// The layouts of the main entry point and of the functions are independent of each other and are
+	/// computed on up to @a _parallelism threads. The result does not depend on @a _parallelism.
+	static StackLayout run(CFG const& _cfg, StackShuffleCache& _shuffleCache, size_t _parallelism = 1);
 	/// @returns a map from function names to the stack too deep errors occurring in that function.
 	/// Requires @a _cfg to be a control flow graph generated from disambiguated Yul.
 	/// The empty string is mapped to the stack too deep errors of the main entry point.
+	/// Functions without stack too deep errors are not contained in the map.
+	/// Prefer this over calling the version below for every function, which has to look up each function by name.
 	static std::map<YulString, std::vector<StackTooDeep>> reportStackTooDeep(CFG const& _cfg);
 	/// @returns all stack too deep errors in the function named @a _functionName.
 	/// Requires @a _cfg to be a control flow graph generated from disambiguated Yul.
@@ -66,7 +74,11 @@ public:
 	static std::vector<StackTooDeep> reportStackTooDeep(CFG const& _cfg, YulString _functionName);
 
 private:
-	StackLayoutGenerator(StackLayout& _context);
+	StackLayoutGenerator(StackLayout& _context, StackShuffleCache& _shuffleCache);
+
+	/// @returns the stack too deep errors of the code reachable from @a _entry, i.e. of the main
+	/// entry point or of one function.
+	static std::vector<StackTooDeep> reportStackTooDeep(CFG::BasicBlock const& _entry, StackShuffleCache& _shuffleCache);
 
 	/// @returns the optimal entry stack layout, s.t. @a _operation can be applied to it and
 	/// the result can be transformed to @a _exitStack with minimal stack shuffling.
@@ -100,7 +112,7 @@ private:
 
 	/// Calculates the ideal stack layout, s.t. both @a _stack1 and @a _stack2 can be achieved with minimal
 	/// stack shuffling when starting from the returned layout.
-	static Stack combineStack(Stack const& _stack1, Stack const& _stack2);
+	Stack combineStack(Stack const& _stack1, Stack const& _stack2) const;
 
 	/// Walks through the CFG and reports any stack too deep errors that would occur when generating code for it
 	/// without countermeasures.
@@ -112,6 +124,7 @@ private:
 	static Stack compressStack(Stack _stack);
 
 	StackLayout& m_layout;
+	StackShuffleCache& m_shuffleCache;
 };
 
 }
@@ -25,6 +25,7 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Visitor.h>
 #include <libsolutil/LEB128.h>
+#include <libsolutil/Parallel.h>
 
 #include <range/v3/view/map.hpp>
 #include <range/v3/view/reverse.hpp>
@@ -236,15 +237,18 @@ static map<string, uint8_t> const builtins = {
 	{"i64.extend_i32_u", 0xad},
 };
 
-bytes prefixSize(bytes _data)
+/// @returns the size of a section with the given contents, including its id and size field.
+size_t sectionSize(bytes const& _contents)
 {
-	size_t size = _data.size();
-	return lebEncode(size) + move(_data);
+	return 1 + lebEncodedSize(_contents.size()) + _contents.size();
 }
 
-bytes makeSection(Section _section, bytes _data)
+/// Appends the section with the given id and contents to @a _output.
+void appendSection(bytes& _output, Section _section, bytes const& _contents)
 {
-	return toBytes(_section) + prefixSize(move(_data));
+	_output += toBytes(_section);
+	_output += lebEncode(_contents.size());
+	_output.insert(_output.end(), _contents.begin(), _contents.end());
 }
 
 /// This is a kind of run-length-encoding of local types.
@@ -277,7 +281,7 @@ vector<pair<size_t, ValueType>> groupLocalVariables(vector<VariableDeclaration>
 
 }
 
-bytes BinaryTransform::run(Module const& _module)
+bytes BinaryTransform::run(Module const& _module, size_t _parallelism)
 {
 	map<Type, vector<string>> const types = typeToFunctionMap(_module.imports, _module.functions);
 
@@ -290,73 +294,78 @@ bytes BinaryTransform::run(Module const& _module)
 	yulAssert(functionTypes.size() == functionIDs.size(), "");
 	yulAssert(functionTypes.size() >= types.size(), "");
 
-	bytes ret{0, 'a', 's', 'm'};
-	// version
-	ret += bytes{1, 0, 0, 0};
-	ret += typeSection(types);
-	ret += importSection(_module.imports, functionTypes);
-	ret += functionSection(_module.functions, functionTypes);
-	ret += memorySection();
-	ret += globalSection(_module.globals);
-	ret += exportSection(functionIDs);
+	// Only the contents of the sections are generated here. Their sizes are known in advance,
+	// so that the module is written into a single buffer of the final size at the end.
+	vector<pair<Section, bytes>> sections;
+	sections.emplace_back(Section::TYPE, typeSection(types));
+	sections.emplace_back(Section::IMPORT, importSection(_module.imports, functionTypes));
+	sections.emplace_back(Section::FUNCTION, functionSection(_module.functions, functionTypes));
+	sections.emplace_back(Section::MEMORY, memorySection());
+	sections.emplace_back(Section::GLOBAL, globalSection(_module.globals));
+	sections.emplace_back(Section::EXPORT, exportSection(functionIDs));
+
+	// The offsets of the custom sections are absolute, so they depend on the sizes of
+	// all previous sections.
+	size_t offset = 8;
+	for (bytes const& contents: sections | ranges::views::values)
+		offset += sectionSize(contents);
 
 	map<string, pair<size_t, size_t>> subModulePosAndSize;
+	auto addCustomSection = [&](string const& _name, bytes const& _data) {
+		sections.emplace_back(Section::CUSTOM, customSection(_name, _data));
+		offset += sectionSize(sections.back().second);
+		// Skip all the previous sections and the size field of this current custom section.
+		subModulePosAndSize[_name] = {offset - _data.size(), _data.size()};
+	};
 	for (auto const& [name, module]: _module.subModules)
-	{
 		// TODO should we prefix and / or shorten the name?
-		bytes data = BinaryTransform::run(module);
-		size_t const length = data.size();
-		ret += customSection(name, move(data));
-		// Skip all the previous sections and the size field of this current custom section.
-		size_t const offset = ret.size() - length;
-		subModulePosAndSize[name] = {offset, length};
-	}
+		addCustomSection(name, BinaryTransform::run(module, _parallelism));
 	for (auto const& [name, data]: _module.customSections)
-	{
-		size_t const length = data.size();
-		ret += customSection(name, data);
-		// Skip all the previous sections and the size field of this current custom section.
-		size_t const offset = ret.size() - length;
-		subModulePosAndSize[name] = {offset, length};
-	}
+		addCustomSection(name, data);
 
-	BinaryTransform bt(
-		move(globalIDs),
-		move(functionIDs),
-		move(functionTypes),
-		move(subModulePosAndSize)
-	);
+	BinaryTransform bt(globalIDs, functionIDs, functionTypes, subModulePosAndSize);
+	sections.emplace_back(Section::CODE, bt.codeSection(_module.functions, _parallelism));
+	size_t const size = offset + sectionSize(sections.back().second);
 
-	ret += bt.codeSection(_module.functions);
+	bytes ret;
+	ret.reserve(size);
+	ret += bytes{0, 'a', 's', 'm'};
+	// version
+	ret += bytes{1, 0, 0, 0};
+	for (auto const& [section, contents]: sections)
+		appendSection(ret, section, contents);
+	yulAssert(ret.size() == size, "");
 	return ret;
 }
 
-bytes BinaryTransform::operator()(Literal const& _literal)
+void BinaryTransform::operator()(Literal const& _literal)
 {
-	return std::visit(GenericVisitor{
-		[&](uint32_t _value) -> bytes { return toBytes(Opcode::I32Const) + lebEncodeSigned(static_cast<int32_t>(_value)); },
-		[&](uint64_t _value) -> bytes { return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(_value)); },
+	std::visit(GenericVisitor{
+		[&](uint32_t _value) { emit(Opcode::I32Const); m_code += lebEncodeSigned(static_cast<int32_t>(_value)); },
+		[&](uint64_t _value) { emit(Opcode::I64Const); m_code += lebEncodeSigned(static_cast<int64_t>(_value)); },
 	}, _literal.value);
 }
 
-bytes BinaryTransform::operator()(StringLiteral const&)
+void BinaryTransform::operator()(StringLiteral const&)
 {
 	// StringLiteral is a special AST element used for certain builtins.
 	// It is not mapped to actual WebAssembly, and should be processed in visit(BuiltinCall).
 	yulAssert(false, "");
 }
 
-bytes BinaryTransform::operator()(LocalVariable const& _variable)
+void BinaryTransform::operator()(LocalVariable const& _variable)
 {
-	return toBytes(Opcode::LocalGet) + lebEncode(m_locals.at(_variable.name));
+	emit(Opcode::LocalGet);
+	m_code += lebEncode(m_locals.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(GlobalVariable const& _variable)
+void BinaryTransform::operator()(GlobalVariable const& _variable)
 {
-	return toBytes(Opcode::GlobalGet) + lebEncode(m_globalIDs.at(_variable.name));
+	emit(Opcode::GlobalGet);
+	m_code += lebEncode(m_globalIDs.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(BuiltinCall const& _call)
+void BinaryTransform::operator()(BuiltinCall const& _call)
 {
 	// We need to avoid visiting the arguments of `dataoffset` and `datasize` because
 	// they are references to object names that should not end up in the code.
@@ -365,20 +374,24 @@ bytes BinaryTransform::operator()(BuiltinCall const& _call)
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		emit(Opcode::I64Const);
+		m_code += lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		return;
 	}
 	else if (_call.functionName == "datasize")
 	{
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		emit(Opcode::I64Const);
+		m_code += lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		return;
 	}
 
 	yulAssert(builtins.count(_call.functionName), "Builtin " + _call.functionName + " not found");
 	// NOTE: the dialect ensures we have the right amount of arguments
-	bytes args = visit(_call.arguments);
-	bytes ret = move(args) + toBytes(builtins.at(_call.functionName));
+	visit(_call.arguments);
+	emit(builtins.at(_call.functionName));
 	if (
 		_call.functionName.find(".load") != string::npos ||
 		_call.functionName.find(".store") != string::npos
@@ -387,103 +400,101 @@ bytes BinaryTransform::operator()(BuiltinCall const& _call)
 		// into account to generate more efficient code but if the hint is invalid it could
 		// actually be more expensive. It's best to hint at 1-byte alignment if we don't plan
 		// to control the memory layout accordingly.
-		ret += bytes{{0, 0}}; // 2^0 == 1-byte alignment
-
-	return ret;
+		m_code += bytes{{0, 0}}; // 2^0 == 1-byte alignment
 }
 
-bytes BinaryTransform::operator()(FunctionCall const& _call)
+void BinaryTransform::operator()(FunctionCall const& _call)
 {
-	return visit(_call.arguments) + toBytes(Opcode::Call) + lebEncode(m_functionIDs.at(_call.functionName));
+	visit(_call.arguments);
+	emit(Opcode::Call);
+	m_code += lebEncode(m_functionIDs.at(_call.functionName));
 }
 
-bytes BinaryTransform::operator()(LocalAssignment const& _assignment)
+void BinaryTransform::operator()(LocalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::LocalSet) +
-		lebEncode(m_locals.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	emit(Opcode::LocalSet);
+	m_code += lebEncode(m_locals.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(GlobalAssignment const& _assignment)
+void BinaryTransform::operator()(GlobalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::GlobalSet) +
-		lebEncode(m_globalIDs.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	emit(Opcode::GlobalSet);
+	m_code += lebEncode(m_globalIDs.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(If const& _if)
+void BinaryTransform::operator()(If const& _if)
 {
-	bytes result =
-		std::visit(*this, *_if.condition) +
-		toBytes(Opcode::If) +
-		toBytes(ValueType::Void);
+	std::visit(*this, *_if.condition);
+	emit(Opcode::If);
+	emit(ValueType::Void);
 
 	m_labels.emplace_back();
 
-	result += visit(_if.statements);
+	visit(_if.statements);
 	if (_if.elseStatements)
-		result += toBytes(Opcode::Else) + visit(*_if.elseStatements);
+	{
+		emit(Opcode::Else);
+		visit(*_if.elseStatements);
+	}
 
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	emit(Opcode::End);
 }
 
-bytes BinaryTransform::operator()(Loop const& _loop)
+void BinaryTransform::operator()(Loop const& _loop)
 {
-	bytes result = toBytes(Opcode::Loop) + toBytes(ValueType::Void);
+	emit(Opcode::Loop);
+	emit(ValueType::Void);
 
 	m_labels.emplace_back(_loop.labelName);
-	result += visit(_loop.statements);
+	visit(_loop.statements);
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	emit(Opcode::End);
 }
 
-bytes BinaryTransform::operator()(Branch const& _branch)
+void BinaryTransform::operator()(Branch const& _branch)
 {
-	return toBytes(Opcode::Br) + encodeLabelIdx(_branch.label.name);
+	emit(Opcode::Br);
+	m_code += encodeLabelIdx(_branch.label.name);
 }
 
-bytes BinaryTransform::operator()(BranchIf const& _branchIf)
+void BinaryTransform::operator()(BranchIf const& _branchIf)
 {
-	bytes result = std::visit(*this, *_branchIf.condition);
-	result += toBytes(Opcode::BrIf) + encodeLabelIdx(_branchIf.label.name);
-	return result;
+	std::visit(*this, *_branchIf.condition);
+	emit(Opcode::BrIf);
+	m_code += encodeLabelIdx(_branchIf.label.name);
 }
 
-bytes BinaryTransform::operator()(Return const&)
+void BinaryTransform::operator()(Return const&)
 {
 	// Note that this does not work if the function returns a value.
-	return toBytes(Opcode::Return);
+	emit(Opcode::Return);
 }
 
-bytes BinaryTransform::operator()(Block const& _block)
+void BinaryTransform::operator()(Block const& _block)
 {
 	m_labels.emplace_back(_block.labelName);
-	bytes result =
-		toBytes(Opcode::Block) +
-		toBytes(ValueType::Void) +
-		visit(_block.statements) +
-		toBytes(Opcode::End);
+	emit(Opcode::Block);
+	emit(ValueType::Void);
+	visit(_block.statements);
+	emit(Opcode::End);
 	m_labels.pop_back();
-	return result;
 }
 
-bytes BinaryTransform::operator()(FunctionDefinition const& _function)
+bytes BinaryTransform::encodeFunction(FunctionDefinition const& _function)
 {
-	bytes ret;
+	m_code.clear();
 
 	vector<pair<size_t, ValueType>> localEntries = groupLocalVariables(_function.locals);
-	ret += lebEncode(localEntries.size());
+	m_code += lebEncode(localEntries.size());
 	for (pair<size_t, ValueType> const& entry: localEntries)
 	{
-		ret += lebEncode(entry.first);
-		ret += toBytes(entry.second);
+		m_code += lebEncode(entry.first);
+		emit(entry.second);
 	}
 
 	m_locals.clear();
@@ -495,12 +506,12 @@ bytes BinaryTransform::operator()(FunctionDefinition const& _function)
 
 	yulAssert(m_labels.empty(), "Stray labels.");
 
-	ret += visit(_function.body);
-	ret += toBytes(Opcode::End);
+	visit(_function.body);
+	emit(Opcode::End);
 
 	yulAssert(m_labels.empty(), "Stray labels.");
 
-	return prefixSize(move(ret));
+	return move(m_code);
 }
 
 BinaryTransform::Type BinaryTransform::typeOf(FunctionImport const& _import)
@@ -602,7 +613,7 @@ bytes BinaryTransform::typeSection(map<BinaryTransform::Type, vector<string>> co
 		index++;
 	}
 
-	return makeSection(Section::TYPE, lebEncode(index) + move(result));
+	return lebEncode(index) + move(result);
 }
 
 bytes BinaryTransform::importSection(
@@ -620,7 +631,7 @@ bytes BinaryTransform::importSection(
 			toBytes(importKind) +
 			lebEncode(_functionTypes.at(import.internalName));
 	}
-	return makeSection(Section::IMPORT, move(result));
+	return result;
 }
 
 bytes BinaryTransform::functionSection(
@@ -631,7 +642,7 @@ bytes BinaryTransform::functionSection(
 	bytes result = lebEncode(_functions.size());
 	for (auto const& fun: _functions)
 		result += lebEncode(_functionTypes.at(fun.name));
-	return makeSection(Section::FUNCTION, move(result));
+	return result;
 }
 
 bytes BinaryTransform::memorySection()
@@ -639,7 +650,7 @@ bytes BinaryTransform::memorySection()
 	bytes result = lebEncode(1);
 	result.push_back(static_cast<uint8_t>(LimitsKind::Min));
 	result.push_back(1); // initial length
-	return makeSection(Section::MEMORY, move(result));
+	return result;
 }
 
 bytes BinaryTransform::globalSection(vector<wasm::GlobalVariableDeclaration> const& _globals)
@@ -656,7 +667,7 @@ bytes BinaryTransform::globalSection(vector<wasm::GlobalVariableDeclaration> con
 			toBytes(Opcode::End);
 	}
 
-	return makeSection(Section::GLOBAL, move(result));
+	return result;
 }
 
 bytes BinaryTransform::exportSection(map<string, size_t> const& _functionIDs)
@@ -666,37 +677,43 @@ bytes BinaryTransform::exportSection(map<string, size_t> const& _functionIDs)
 	result += encodeName("memory") + toBytes(Export::Memory) + lebEncode(0);
 	if (hasMain)
 		result += encodeName("main") + toBytes(Export::Function) + lebEncode(_functionIDs.at("main"));
-	return makeSection(Section::EXPORT, move(result));
+	return result;
 }
 
-bytes BinaryTransform::customSection(string const& _name, bytes _data)
+bytes BinaryTransform::customSection(string const& _name, bytes const& _data)
 {
-	bytes result = encodeName(_name) + move(_data);
-	return makeSection(Section::CUSTOM, move(result));
+	bytes result = encodeName(_name);
+	result.insert(result.end(), _data.begin(), _data.end());
+	return result;
 }
 
-bytes BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions)
+bytes BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions, size_t _parallelism) const
 {
-	bytes result = lebEncode(_functions.size());
-	for (FunctionDefinition const& fun: _functions)
-		result += (*this)(fun);
-	return makeSection(Section::CODE, move(result));
-}
+	// The functions are independent of each other, so they are encoded separately and joined in
+	// their original order.
+	vector<bytes> encodedFunctions(_functions.size());
+	parallelFor(_functions.size(), _parallelism, [&](size_t _index) {
+		BinaryTransform functionTransform(m_globalIDs, m_functionIDs, m_functionTypes, m_subModulePosAndSize);
+		encodedFunctions[_index] = functionTransform.encodeFunction(_functions[_index]);
+	});
 
-bytes BinaryTransform::visit(vector<Expression> const& _expressions)
-{
-	bytes result;
-	for (auto const& expr: _expressions)
-		result += std::visit(*this, expr);
+	bytes result = lebEncode(_functions.size());
+	size_t size = result.size();
+	for (bytes const& encodedFunction: encodedFunctions)
+		size += lebEncodedSize(encodedFunction.size()) + encodedFunction.size();
+	result.reserve(size);
+	for (bytes const& encodedFunction: encodedFunctions)
+	{
+		result += lebEncode(encodedFunction.size());
+		result.insert(result.end(), encodedFunction.begin(), encodedFunction.end());
+	}
 	return result;
 }
 
-bytes BinaryTransform::visitReversed(vector<Expression> const& _expressions)
+void BinaryTransform::visit(vector<Expression> const& _expressions)
 {
-	bytes result;
-	for (auto const& expr: _expressions | ranges::views::reverse)
-		result += std::visit(*this, expr);
-	return result;
+	for (auto const& expr: _expressions)
+		std::visit(*this, expr);
 }
 
 bytes BinaryTransform::encodeLabelIdx(string const& _label) const
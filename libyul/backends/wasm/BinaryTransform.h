@@ -33,39 +33,40 @@ namespace solidity::yul::wasm
 
 /**
  * Web assembly to binary transform.
+ *
+ * The functions are encoded on up to @a _parallelism threads. The result does not depend on it.
  */
 class BinaryTransform
 {
 public:
-	static bytes run(Module const& _module);
-
-	bytes operator()(wasm::Literal const& _literal);
-	bytes operator()(wasm::StringLiteral const& _literal);
-	bytes operator()(wasm::LocalVariable const& _identifier);
-	bytes operator()(wasm::GlobalVariable const& _identifier);
-	bytes operator()(wasm::BuiltinCall const& _builinCall);
-	bytes operator()(wasm::FunctionCall const& _functionCall);
-	bytes operator()(wasm::LocalAssignment const& _assignment);
-	bytes operator()(wasm::GlobalAssignment const& _assignment);
-	bytes operator()(wasm::If const& _if);
-	bytes operator()(wasm::Loop const& _loop);
-	bytes operator()(wasm::Branch const& _branch);
-	bytes operator()(wasm::BranchIf const& _branchIf);
-	bytes operator()(wasm::Return const& _return);
-	bytes operator()(wasm::Block const& _block);
-	bytes operator()(wasm::FunctionDefinition const& _function);
+	static bytes run(Module const& _module, size_t _parallelism = 1);
+
+	void operator()(wasm::Literal const& _literal);
+	void operator()(wasm::StringLiteral const& _literal);
+	void operator()(wasm::LocalVariable const& _identifier);
+	void operator()(wasm::GlobalVariable const& _identifier);
+	void operator()(wasm::BuiltinCall const& _builinCall);
+	void operator()(wasm::FunctionCall const& _functionCall);
+	void operator()(wasm::LocalAssignment const& _assignment);
+	void operator()(wasm::GlobalAssignment const& _assignment);
+	void operator()(wasm::If const& _if);
+	void operator()(wasm::Loop const& _loop);
+	void operator()(wasm::Branch const& _branch);
+	void operator()(wasm::BranchIf const& _branchIf);
+	void operator()(wasm::Return const& _return);
+	void operator()(wasm::Block const& _block);
 
 private:
 	BinaryTransform(
-		std::map<std::string, size_t> _globalIDs,
-		std::map<std::string, size_t> _functionIDs,
-		std::map<std::string, size_t> _functionTypes,
-		std::map<std::string, std::pair<size_t, size_t>> _subModulePosAndSize
+		std::map<std::string, size_t> const& _globalIDs,
+		std::map<std::string, size_t> const& _functionIDs,
+		std::map<std::string, size_t> const& _functionTypes,
+		std::map<std::string, std::pair<size_t, size_t>> const& _subModulePosAndSize
 	):
-		m_globalIDs(std::move(_globalIDs)),
-		m_functionIDs(std::move(_functionIDs)),
-		m_functionTypes(std::move(_functionTypes)),
-		m_subModulePosAndSize(std::move(_subModulePosAndSize))
+		m_globalIDs(_globalIDs),
+		m_functionIDs(_functionIDs),
+		m_functionTypes(_functionTypes),
+		m_subModulePosAndSize(_subModulePosAndSize)
 	{}
 
 	using Type = std::pair<std::vector<std::uint8_t>, std::vector<std::uint8_t>>;
@@ -87,6 +88,8 @@ private:
 		std::map<Type, std::vector<std::string>> const& _typeToFunctionMap
 	);
 
+	/// The section functions @returns the contents of the respective section, without its id
+	/// and size, which are added by run().
 	static bytes typeSection(std::map<Type, std::vector<std::string>> const& _typeToFunctionMap);
 	static bytes importSection(
 		std::vector<wasm::FunctionImport> const& _imports,
@@ -99,26 +102,32 @@ private:
 	static bytes memorySection();
 	static bytes globalSection(std::vector<wasm::GlobalVariableDeclaration> const& _globals);
 	static bytes exportSection(std::map<std::string, size_t> const& _functionIDs);
-	static bytes customSection(std::string const& _name, bytes _data);
-	bytes codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
+	static bytes customSection(std::string const& _name, bytes const& _data);
+	bytes codeSection(std::vector<wasm::FunctionDefinition> const& _functions, size_t _parallelism) const;
 
-	bytes visit(std::vector<wasm::Expression> const& _expressions);
-	bytes visitReversed(std::vector<wasm::Expression> const& _expressions);
+	/// @returns the encoded function without its size prefix.
+	bytes encodeFunction(wasm::FunctionDefinition const& _function);
+	void visit(std::vector<wasm::Expression> const& _expressions);
+
+	/// Appends a single byte, such as an opcode or a value type, to the code of the current function.
+	template<typename T>
+	void emit(T _value) { m_code.push_back(static_cast<uint8_t>(_value)); }
 
 	bytes encodeLabelIdx(std::string const& _label) const;
 
 	static bytes encodeName(std::string const& _name);
 
-	std::map<std::string, size_t> const m_globalIDs;
-	std::map<std::string, size_t> const m_functionIDs;
-	std::map<std::string, size_t> const m_functionTypes;
+	std::map<std::string, size_t> const& m_globalIDs;
+	std::map<std::string, size_t> const& m_functionIDs;
+	std::map<std::string, size_t> const& m_functionTypes;
 	/// The map of submodules, where the pair refers to the [offset, length]. The offset is
 	/// an absolute offset within the resulting assembled bytecode.
-	std::map<std::string, std::pair<size_t, size_t>> const m_subModulePosAndSize;
+	std::map<std::string, std::pair<size_t, size_t>> const& m_subModulePosAndSize;
 
+	/// Code of the function that is currently being encoded.
+	bytes m_code;
 	std::map<std::string, size_t> m_locals;
 	std::vector<std::string> m_labels;
 };
-
 }
 
@@ -23,6 +23,7 @@
 
 #include <libyul/backends/wasm/WordSizeTransform.h>
 #include <libyul/backends/wasm/WasmDialect.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/MainFunction.h>
@@ -37,6 +38,7 @@
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/Object.h>
+#include <libyul/YulString.h>
 
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/Scanner.h>
@@ -45,6 +47,8 @@
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
+#include <libsolutil/LazyInit.h>
+
 // The following headers are generated from the
 // yul files placed in libyul/backends/wasm/polyfill.
 
@@ -63,10 +67,97 @@ using namespace solidity::yul;
 using namespace solidity::util;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// The parsed polyfill, which is shared by all translations.
+struct Polyfill
+{
+	std::shared_ptr<Block const> ast;
+	/// Names of all polyfill functions.
+	std::set<YulString> functions;
+	/// Polyfill functions called by each polyfill function.
+	std::map<YulString, std::set<YulString>> callees;
+};
+
+Polyfill parsePolyfill()
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(
+		"{" +
+			string(solidity::yul::wasm::polyfill::Arithmetic) +
+			string(solidity::yul::wasm::polyfill::Bitwise) +
+			string(solidity::yul::wasm::polyfill::Comparison) +
+			string(solidity::yul::wasm::polyfill::Conversion) +
+			string(solidity::yul::wasm::polyfill::Interface) +
+			string(solidity::yul::wasm::polyfill::Keccak) +
+			string(solidity::yul::wasm::polyfill::Logical) +
+			string(solidity::yul::wasm::polyfill::Memory) +
+		"}", "");
+
+	// Passing an empty SourceLocation() here is a workaround to prevent a crash
+	// when compiling from yul->ewasm. We're stripping nativeLocation and
+	// originLocation from the AST (but we only really need to strip nativeLocation)
+	Polyfill polyfill;
+	polyfill.ast = Parser(errorReporter, WasmDialect::instance(), langutil::SourceLocation()).parse(charStream);
+	if (!errors.empty())
+	{
+		string message;
+		for (auto const& err: errors)
+			message += langutil::SourceReferenceFormatter::formatErrorInformation(
+				*err,
+				SingletonCharStreamProvider(charStream)
+			);
+		yulAssert(false, message);
+	}
+
+	for (auto const& statement: polyfill.ast->statements)
+		polyfill.functions.insert(std::get<FunctionDefinition>(statement).name);
+	for (auto& [function, callees]: CallGraphGenerator::callGraph(*polyfill.ast).functionCalls)
+		for (YulString callee: callees)
+			if (polyfill.functions.count(callee))
+				polyfill.callees[function].insert(callee);
+
+	return polyfill;
+}
+
+/// @returns the polyfill, which is parsed on first use and whenever the Yul strings were reset.
+Polyfill const& polyfill()
+{
+	static solidity::util::ConcurrentLazyInit<Polyfill> polyfill;
+	static YulStringRepository::ResetCallback callback{[&] { polyfill.reset(); }};
+	return polyfill.init(parsePolyfill);
+}
+
+/// @returns the polyfill functions called from @a _ast, directly or through other polyfill functions.
+set<YulString> requiredPolyfillFunctions(Polyfill const& _polyfill, Block const& _ast)
+{
+	set<YulString> required;
+	vector<YulString> toVisit;
+	for (auto const& [function, callees]: CallGraphGenerator::callGraph(_ast).functionCalls)
+		for (YulString callee: callees)
+			if (_polyfill.functions.count(callee) && required.insert(callee).second)
+				toVisit.push_back(callee);
+
+	while (!toVisit.empty())
+	{
+		YulString function = toVisit.back();
+		toVisit.pop_back();
+		if (_polyfill.callees.count(function))
+			for (YulString callee: _polyfill.callees.at(function))
+				if (required.insert(callee).second)
+					toVisit.push_back(callee);
+	}
+
+	return required;
+}
+
+}
+
 Object EVMToEwasmTranslator::run(Object const& _object)
 {
-	if (!m_polyfill)
-		parsePolyfill();
+	Polyfill const& polyfill = ::polyfill();
 
 	Block ast = std::get<Block>(Disambiguator(m_dialect, *_object.analysisInfo)(*_object.code));
 	set<YulString> reservedIdentifiers;
@@ -76,7 +167,9 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 		m_dialect,
 		nameDispenser,
 		reservedIdentifiers,
-		frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment
+		frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment,
+		1,
+		nullptr
 	};
 
 	FunctionHoister::run(context, ast);
@@ -86,9 +179,13 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 	ExpressionSplitter::run(context, ast);
 	WordSizeTransform::run(m_dialect, WasmDialect::instance(), ast, nameDispenser);
 
-	NameDisplacer{nameDispenser, m_polyfillFunctions}(ast);
-	for (auto const& st: m_polyfill->statements)
-		ast.statements.emplace_back(ASTCopier{}.translate(st));
+	NameDisplacer{nameDispenser, polyfill.functions}(ast);
+	// Only the functions that are actually used are added, so that the optimiser
+	// does not have to remove the other ones again.
+	set<YulString> requiredFunctions = requiredPolyfillFunctions(polyfill, ast);
+	for (auto const& statement: polyfill.ast->statements)
+		if (requiredFunctions.count(std::get<FunctionDefinition>(statement).name))
+			ast.statements.emplace_back(ASTCopier{}.translate(statement));
 
 	Object ret;
 	ret.name = _object.name;
@@ -121,39 +218,3 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 
 	return ret;
 }
-
-void EVMToEwasmTranslator::parsePolyfill()
-{
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	CharStream charStream(
-		"{" +
-			string(solidity::yul::wasm::polyfill::Arithmetic) +
-			string(solidity::yul::wasm::polyfill::Bitwise) +
-			string(solidity::yul::wasm::polyfill::Comparison) +
-			string(solidity::yul::wasm::polyfill::Conversion) +
-			string(solidity::yul::wasm::polyfill::Interface) +
-			string(solidity::yul::wasm::polyfill::Keccak) +
-			string(solidity::yul::wasm::polyfill::Logical) +
-			string(solidity::yul::wasm::polyfill::Memory) +
-		"}", "");
-
-	// Passing an empty SourceLocation() here is a workaround to prevent a crash
-	// when compiling from yul->ewasm. We're stripping nativeLocation and
-	// originLocation from the AST (but we only really need to strip nativeLocation)
-	m_polyfill = Parser(errorReporter, WasmDialect::instance(), langutil::SourceLocation()).parse(charStream);
-	if (!errors.empty())
-	{
-		string message;
-		for (auto const& err: errors)
-			message += langutil::SourceReferenceFormatter::formatErrorInformation(
-				*err,
-				SingletonCharStreamProvider(charStream)
-			);
-		yulAssert(false, message);
-	}
-
-	m_polyfillFunctions.clear();
-	for (auto const& statement: m_polyfill->statements)
-		m_polyfillFunctions.insert(std::get<FunctionDefinition>(statement).name);
-}
@@ -43,13 +43,8 @@ public:
 	Object run(Object const& _object);
 
 private:
-	void parsePolyfill();
-
 	Dialect const& m_dialect;
 	langutil::CharStreamProvider const& m_charStreamProvider;
-
-	std::shared_ptr<Block> m_polyfill;
-	std::set<YulString> m_polyfillFunctions;
 };
 
 }
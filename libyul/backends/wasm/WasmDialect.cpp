@@ -24,6 +24,8 @@
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
 
+#include <libsolutil/LazyInit.h>
+
 using namespace std;
 using namespace solidity::yul;
 
@@ -166,11 +168,9 @@ BuiltinFunction const* WasmDialect::equalityFunction(YulString _type) const
 
 WasmDialect const& WasmDialect::instance()
 {
-	static std::unique_ptr<WasmDialect> dialect;
+	static solidity::util::ConcurrentLazyInit<unique_ptr<WasmDialect const>> dialect;
 	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
-	if (!dialect)
-		dialect = make_unique<WasmDialect>();
-	return *dialect;
+	return *dialect.init([] { return make_unique<WasmDialect const>(); });
 }
 
 void WasmDialect::addExternals()
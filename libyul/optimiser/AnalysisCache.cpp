@@ -0,0 +1,164 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/AnalysisCache.h>
+
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AST.h>
+#include <libyul/ControlFlowSideEffectsCollector.h>
+#include <libyul/Exceptions.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <unordered_set>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+void AnalysisCache::setAST(Block const& _ast, size_t _fingerprint, vector<size_t> _statementFingerprints)
+{
+	yulAssert(_ast.statements.size() == _statementFingerprints.size(), "");
+	m_ast = &_ast;
+	m_statementFingerprints = move(_statementFingerprints);
+	if (m_programFingerprint != _fingerprint)
+	{
+		m_programFingerprint = _fingerprint;
+		m_programAnalysis = {};
+	}
+
+	// Forget the statements that are gone.
+	unordered_set<size_t> current(m_statementFingerprints.begin(), m_statementFingerprints.end());
+	for (auto it = m_statementAnalyses.begin(); it != m_statementAnalyses.end();)
+		if (current.count(it->first))
+			++it;
+		else
+			it = m_statementAnalyses.erase(it);
+}
+
+CallGraph AnalysisCache::callGraph(OptimiserStepContext const& _context, Block const& _ast)
+{
+	if (_context.analysisCache && _context.analysisCache->serves(_ast))
+		return _context.analysisCache->callGraph();
+	return CallGraphGenerator::callGraph(_ast);
+}
+
+map<YulString, SideEffects> AnalysisCache::sideEffects(OptimiserStepContext const& _context, Block const& _ast)
+{
+	AnalysisCache* cache = _context.analysisCache;
+	if (!cache || !cache->serves(_ast))
+		return SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	if (!cache->m_programAnalysis.sideEffects)
+		cache->m_programAnalysis.sideEffects =
+			SideEffectsPropagator::sideEffects(_context.dialect, cache->callGraph());
+	return *cache->m_programAnalysis.sideEffects;
+}
+
+bool AnalysisCache::containsMSize(OptimiserStepContext const& _context, Block const& _ast)
+{
+	AnalysisCache* cache = _context.analysisCache;
+	if (!cache || !cache->serves(_ast))
+		return MSizeFinder::containsMSize(_context.dialect, _ast);
+	if (!cache->m_programAnalysis.containsMSize)
+	{
+		bool containsMSize = false;
+		for (size_t i = 0; i < _ast.statements.size() && !containsMSize; ++i)
+		{
+			StatementAnalysis& analysis = cache->statementAnalysis(i);
+			if (!analysis.containsMSize)
+				analysis.containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast.statements[i]);
+			containsMSize = *analysis.containsMSize;
+		}
+		cache->m_programAnalysis.containsMSize = containsMSize;
+	}
+	return *cache->m_programAnalysis.containsMSize;
+}
+
+map<YulString, set<u256>> AnalysisCache::storageWrites(OptimiserStepContext const& _context, Block const& _ast)
+{
+	AnalysisCache* cache = _context.analysisCache;
+	if (!cache || !cache->serves(_ast))
+		return StorageWritesPropagator::storageWrites(_context.dialect, _ast);
+	if (!cache->m_programAnalysis.storageWrites)
+		cache->m_programAnalysis.storageWrites = StorageWritesPropagator::storageWrites(_context.dialect, _ast);
+	return *cache->m_programAnalysis.storageWrites;
+}
+
+map<YulString, ControlFlowSideEffects> AnalysisCache::controlFlowSideEffects(
+	OptimiserStepContext const& _context,
+	Block const& _ast
+)
+{
+	AnalysisCache* cache = _context.analysisCache;
+	if (!cache || !cache->serves(_ast))
+		return ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed();
+	if (!cache->m_programAnalysis.controlFlowSideEffects)
+		cache->m_programAnalysis.controlFlowSideEffects =
+			ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed();
+	return *cache->m_programAnalysis.controlFlowSideEffects;
+}
+
+unordered_map<YulString, uint64_t> AnalysisCache::functionBodyHashes(
+	OptimiserStepContext const& _context,
+	Block const& _ast
+)
+{
+	AnalysisCache* cache = _context.analysisCache;
+	if (!cache || !cache->serves(_ast))
+		return BlockHasher::functionBodyHashes(_ast);
+	unordered_map<YulString, uint64_t> hashes;
+	for (size_t i = 0; i < _ast.statements.size(); ++i)
+	{
+		StatementAnalysis& analysis = cache->statementAnalysis(i);
+		if (!analysis.functionBodyHashes)
+			analysis.functionBodyHashes = BlockHasher::functionBodyHashes(_ast.statements[i]);
+		hashes.insert(analysis.functionBodyHashes->begin(), analysis.functionBodyHashes->end());
+	}
+	return hashes;
+}
+
+AnalysisCache::StatementAnalysis& AnalysisCache::statementAnalysis(size_t _index)
+{
+	yulAssert(m_ast && _index < m_statementFingerprints.size(), "");
+	return m_statementAnalyses[m_statementFingerprints[_index]];
+}
+
+CallGraph const& AnalysisCache::callGraph()
+{
+	if (!m_programAnalysis.callGraph)
+	{
+		// The functions of different statements have different names, so their graphs are
+		// disjoint, except for the calls from outside of any function.
+		CallGraph callGraph;
+		callGraph.functionCalls[YulString{}] = {};
+		for (size_t i = 0; i < m_statementFingerprints.size(); ++i)
+		{
+			StatementAnalysis& analysis = statementAnalysis(i);
+			if (!analysis.callGraph)
+				analysis.callGraph = CallGraphGenerator::callGraph(m_ast->statements[i]);
+			CallGraph const& statementGraph = *analysis.callGraph;
+			for (auto const& [function, callees]: statementGraph.functionCalls)
+				callGraph.functionCalls[function] += callees;
+			callGraph.functionsWithLoops += statementGraph.functionsWithLoops;
+		}
+		m_programAnalysis.callGraph = move(callGraph);
+	}
+	return *m_programAnalysis.callGraph;
+}
@@ -0,0 +1,112 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for whole-program analyses that are used by many optimiser steps.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/ControlFlowSideEffects.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulString.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+struct OptimiserStepContext;
+
+/**
+ * Keeps the results of the call graph, side-effect, storage write, msize and block hash analyses
+ * of an AST between optimiser steps.
+ *
+ * The optimiser suite announces the AST before running a step, together with
+ * fingerprints of its top-level statements. The call graph, the msize check and the
+ * function body hashes are assembled from the results for the top-level statements,
+ * which are only recomputed for statements whose fingerprint changed. Results that depend on the whole program are kept as
+ * long as no statement changed.
+ *
+ * Steps have to query the analyses before they modify the AST. Queries about other
+ * ASTs and queries while no AST is announced are computed from scratch.
+ */
+class AnalysisCache
+{
+public:
+	/// Announces that steps will be run on @a _ast, which has the given fingerprint and
+	/// whose top-level statements have the given fingerprints.
+	void setAST(Block const& _ast, size_t _fingerprint, std::vector<size_t> _statementFingerprints);
+	/// Stops answering queries, because the announced AST might be modified.
+	void invalidate() { m_ast = nullptr; }
+
+	/// Used by the optimiser steps. Use the cache of @a _context if it has one
+	/// and compute the analysis of @a _ast otherwise.
+	static CallGraph callGraph(OptimiserStepContext const& _context, Block const& _ast);
+	static std::map<YulString, SideEffects> sideEffects(OptimiserStepContext const& _context, Block const& _ast);
+	static bool containsMSize(OptimiserStepContext const& _context, Block const& _ast);
+	/// @returns the storage slots written by functions, see StorageWritesPropagator::storageWrites.
+	static std::map<YulString, std::set<u256>> storageWrites(OptimiserStepContext const& _context, Block const& _ast);
+	static std::map<YulString, ControlFlowSideEffects> controlFlowSideEffects(
+		OptimiserStepContext const& _context,
+		Block const& _ast
+	);
+	/// @returns the hashes of all function bodies, see BlockHasher::functionBodyHashes.
+	static std::unordered_map<YulString, uint64_t> functionBodyHashes(
+		OptimiserStepContext const& _context,
+		Block const& _ast
+	);
+
+private:
+	/// Analyses of a single top-level statement, computed on demand.
+	struct StatementAnalysis
+	{
+		std::optional<CallGraph> callGraph;
+		std::optional<bool> containsMSize;
+		std::optional<std::unordered_map<YulString, uint64_t>> functionBodyHashes;
+	};
+	/// Results that depend on the whole AST.
+	struct ProgramAnalysis
+	{
+		std::optional<CallGraph> callGraph;
+		std::optional<std::map<YulString, SideEffects>> sideEffects;
+		std::optional<bool> containsMSize;
+		std::optional<std::map<YulString, std::set<u256>>> storageWrites;
+		std::optional<std::map<YulString, ControlFlowSideEffects>> controlFlowSideEffects;
+	};
+
+	bool serves(Block const& _ast) const { return m_ast == &_ast; }
+	/// @returns the analyses of the top-level statement @a _index.
+	StatementAnalysis& statementAnalysis(size_t _index);
+	CallGraph const& callGraph();
+
+	Block const* m_ast = nullptr;
+	std::vector<size_t> m_statementFingerprints;
+	std::unordered_map<size_t, StatementAnalysis> m_statementAnalyses;
+	std::optional<size_t> m_programFingerprint;
+	ProgramAnalysis m_programAnalysis;
+};
+
+}
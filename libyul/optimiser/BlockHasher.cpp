@@ -41,16 +41,53 @@ static constexpr uint64_t compileTimeLiteralHash(char const (&_literal)[N])
 {
 	return compileTimeLiteralHash(_literal, N);
 }
+
+struct FunctionBodyHashCollector: ASTWalker
+{
+	explicit FunctionBodyHashCollector(unordered_map<Block const*, uint64_t> const& _blockHashes):
+		blockHashes(_blockHashes)
+	{}
+
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const& _funDef) override
+	{
+		auto it = blockHashes.find(&_funDef.body);
+		bodyHashes[_funDef.name] = it == blockHashes.end() ? 0 : it->second;
+		ASTWalker::operator()(_funDef);
+	}
+
+	unordered_map<Block const*, uint64_t> const& blockHashes;
+	unordered_map<YulString, uint64_t> bodyHashes;
+};
 }
 
-std::map<Block const*, uint64_t> BlockHasher::run(Block const& _block)
+unordered_map<Block const*, uint64_t> BlockHasher::run(Block const& _block)
 {
-	std::map<Block const*, uint64_t> result;
+	unordered_map<Block const*, uint64_t> result;
 	BlockHasher blockHasher(result);
 	blockHasher(_block);
 	return result;
 }
 
+unordered_map<YulString, uint64_t> BlockHasher::functionBodyHashes(Statement const& _statement)
+{
+	unordered_map<Block const*, uint64_t> blockHashes;
+	BlockHasher blockHasher(blockHashes);
+	blockHasher.visit(_statement);
+
+	FunctionBodyHashCollector collector{blockHashes};
+	collector.visit(_statement);
+	return std::move(collector.bodyHashes);
+}
+
+unordered_map<YulString, uint64_t> BlockHasher::functionBodyHashes(Block const& _block)
+{
+	unordered_map<Block const*, uint64_t> blockHashes = run(_block);
+	FunctionBodyHashCollector collector{blockHashes};
+	collector(_block);
+	return std::move(collector.bodyHashes);
+}
+
 void BlockHasher::operator()(Literal const& _literal)
 {
 	hash64(compileTimeLiteralHash("Literal"));
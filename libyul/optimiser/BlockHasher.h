@@ -24,6 +24,8 @@
 #include <libyul/ASTForward.h>
 #include <libyul/YulString.h>
 
+#include <unordered_map>
+
 namespace solidity::yul
 {
 
@@ -62,13 +64,17 @@ public:
 	void operator()(Leave const&) override;
 	void operator()(Block const& _block) override;
 
-	static std::map<Block const*, uint64_t> run(Block const& _block);
+	static std::unordered_map<Block const*, uint64_t> run(Block const& _block);
+	/// @returns the hashes of the bodies of all functions defined in @a _statement,
+	/// by function name. Empty bodies have the hash zero. Requires unique function names.
+	static std::unordered_map<YulString, uint64_t> functionBodyHashes(Statement const& _statement);
+	static std::unordered_map<YulString, uint64_t> functionBodyHashes(Block const& _block);
 
 	static constexpr uint64_t fnvPrime = 1099511628211u;
 	static constexpr uint64_t fnvEmptyHash = 14695981039346656037u;
 
 private:
-	BlockHasher(std::map<Block const*, uint64_t>& _blockHashes): m_blockHashes(_blockHashes) {}
+	BlockHasher(std::unordered_map<Block const*, uint64_t>& _blockHashes): m_blockHashes(_blockHashes) {}
 
 	void hash8(uint8_t _value)
 	{
@@ -91,7 +97,7 @@ private:
 		hash32(static_cast<uint32_t>(_value >> 32));
 	}
 
-	std::map<Block const*, uint64_t>& m_blockHashes;
+	std::unordered_map<Block const*, uint64_t>& m_blockHashes;
 
 	uint64_t m_hash = fnvEmptyHash;
 	struct VariableReference
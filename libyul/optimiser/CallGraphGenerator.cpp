@@ -77,6 +77,13 @@ CallGraph CallGraphGenerator::callGraph(Block const& _ast)
 	return std::move(gen.m_callGraph);
 }
 
+CallGraph CallGraphGenerator::callGraph(Statement const& _statement)
+{
+	CallGraphGenerator gen;
+	gen.visit(_statement);
+	return std::move(gen.m_callGraph);
+}
+
 void CallGraphGenerator::operator()(FunctionCall const& _functionCall)
 {
 	m_callGraph.functionCalls[m_currentFunction].insert(_functionCall.functionName.name);
@@ -51,6 +51,9 @@ class CallGraphGenerator: public ASTWalker
 {
 public:
 	static CallGraph callGraph(Block const& _ast);
+	/// @returns the call graph of a single top-level statement. The call graph of a block
+	/// is the union of the call graphs of its top-level statements.
+	static CallGraph callGraph(Statement const& _statement);
 
 	using ASTWalker::operator();
 	void operator()(FunctionCall const& _functionCall) override;
@@ -22,7 +22,7 @@
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
 #include <libyul/optimiser/SyntacticalEquality.h>
-#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/SideEffects.h>
 #include <libyul/Exceptions.h>
@@ -39,7 +39,7 @@ void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _
 {
 	CommonSubexpressionEliminator cse{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+		AnalysisCache::sideEffects(_context, _ast)
 	};
 	cse(_ast);
 }
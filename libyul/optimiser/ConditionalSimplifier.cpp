@@ -16,10 +16,10 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 #include <libyul/optimiser/ConditionalSimplifier.h>
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/AST.h>
 #include <libyul/optimiser/NameCollector.h>
-#include <libyul/ControlFlowSideEffectsCollector.h>
 #include <libsolutil/CommonData.h>
 
 using namespace std;
@@ -31,7 +31,7 @@ void ConditionalSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
 	ConditionalSimplifier{
 		_context.dialect,
-		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
+		AnalysisCache::controlFlowSideEffects(_context, _ast)
 	}(_ast);
 }
 
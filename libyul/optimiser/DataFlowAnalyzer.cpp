@@ -30,7 +30,6 @@
 #include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
-#include <libsolutil/cxx20.h>
 
 #include <variant>
 
@@ -43,10 +42,12 @@ using namespace solidity::yul;
 
 DataFlowAnalyzer::DataFlowAnalyzer(
 	Dialect const& _dialect,
-	map<YulString, SideEffects> _functionSideEffects
+	map<YulString, SideEffects> _functionSideEffects,
+	map<YulString, set<u256>> _functionStorageWrites
 ):
 	m_dialect(_dialect),
 	m_functionSideEffects(std::move(_functionSideEffects)),
+	m_functionStorageWrites(std::move(_functionStorageWrites)),
 	m_knowledgeBase(_dialect, m_value)
 {
 	if (auto const* builtin = _dialect.memoryStoreFunction(YulString{}))
@@ -64,20 +65,22 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 	if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_storage, mapTuple([&](auto&& key, auto&& value) {
+		KeyValueMap& storage = modifiable(m_storage);
+		storage.eraseIf([&](YulString _key, YulString _value) {
 			return
-				!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
-				!m_knowledgeBase.knownToBeEqual(vars->second, value);
-		}));
-		m_storage[vars->first] = vars->second;
+				!m_knowledgeBase.knownToBeDifferent(vars->first, _key) &&
+				!m_knowledgeBase.knownToBeEqual(vars->second, _value);
+		});
+		storage.set(vars->first, vars->second);
 	}
 	else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_memory, mapTuple([&](auto&& key, auto&& /* value */) {
-			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
-		}));
-		m_memory[vars->first] = vars->second;
+		KeyValueMap& memory = modifiable(m_memory);
+		memory.eraseIf([&](YulString _key, YulString /* _value */) {
+			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, _key);
+		});
+		memory.set(vars->first, vars->second);
 	}
 	else
 	{
@@ -88,7 +91,7 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 
 void DataFlowAnalyzer::operator()(Assignment& _assignment)
 {
-	set<YulString> names;
+	FlatSet<YulString, 4> names;
 	for (auto const& var: _assignment.variableNames)
 		names.emplace(var.name);
 	assertThrow(_assignment.value, OptimizerException, "");
@@ -99,7 +102,7 @@ void DataFlowAnalyzer::operator()(Assignment& _assignment)
 
 void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 {
-	set<YulString> names;
+	FlatSet<YulString, 4> names;
 	for (auto const& var: _varDecl.variables)
 		names.emplace(var.name);
 	m_variableScopes.back().variables += names;
@@ -116,8 +119,8 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	unordered_map<YulString, YulString> storage = m_storage;
-	unordered_map<YulString, YulString> memory = m_memory;
+	shared_ptr<KeyValueMap> storage = m_storage;
+	shared_ptr<KeyValueMap> memory = m_memory;
 
 	ASTModifier::operator()(_if);
 
@@ -133,8 +136,8 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	set<YulString> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		unordered_map<YulString, YulString> storage = m_storage;
-		unordered_map<YulString, YulString> memory = m_memory;
+		shared_ptr<KeyValueMap> storage = m_storage;
+		shared_ptr<KeyValueMap> memory = m_memory;
 		(*this)(_case.body);
 		joinKnowledge(storage, memory);
 
@@ -156,8 +159,8 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	ScopedSaveAndRestore valueResetter(m_value, {});
 	ScopedSaveAndRestore loopDepthResetter(m_loopDepth, 0u);
 	ScopedSaveAndRestore referencesResetter(m_references, {});
-	ScopedSaveAndRestore storageResetter(m_storage, {});
-	ScopedSaveAndRestore memoryResetter(m_memory, {});
+	ScopedSaveAndRestore storageResetter(m_storage, make_shared<KeyValueMap>());
+	ScopedSaveAndRestore memoryResetter(m_memory, make_shared<KeyValueMap>());
 	pushScope(true);
 
 	for (auto const& parameter: _fun.parameters)
@@ -218,10 +221,10 @@ void DataFlowAnalyzer::operator()(Block& _block)
 	assertThrow(numScopes == m_variableScopes.size(), OptimizerException, "");
 }
 
-void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expression* _value, bool _isDeclaration)
+void DataFlowAnalyzer::handleAssignment(FlatSet<YulString, 4> const& _variables, Expression* _value, bool _isDeclaration)
 {
 	if (!_isDeclaration)
-		clearValues(_variables);
+		clearValues(set<YulString>(_variables.begin(), _variables.end()));
 
 	MovableChecker movableChecker{m_dialect, &m_functionSideEffects};
 	if (_value)
@@ -242,18 +245,17 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 	auto const& referencedVariables = movableChecker.referencedVariables();
 	for (auto const& name: _variables)
 	{
-		m_references[name] = referencedVariables;
+		m_references.set(name, referencedVariables);
 		if (!_isDeclaration)
-		{
-			// assignment to slot denoted by "name"
-			m_storage.erase(name);
-			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
-			// assignment to slot denoted by "name"
-			m_memory.erase(name);
-			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
-		}
+			for (shared_ptr<KeyValueMap>* data: {&m_storage, &m_memory})
+				if ((*data)->values.count(name) || (*data)->references.count(name))
+				{
+					KeyValueMap& modifiableData = modifiable(*data);
+					// assignment to slot denoted by "name"
+					modifiableData.eraseKey(name);
+					// assignment to slot contents denoted by "name"
+					modifiableData.eraseValue(name);
+				}
 	}
 
 	if (_value && _variables.size() == 1)
@@ -265,9 +267,9 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_memory[*key] = variable;
+				modifiable(m_memory).set(*key, variable);
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_storage[*key] = variable;
+				modifiable(m_storage).set(*key, variable);
 		}
 	}
 }
@@ -282,7 +284,7 @@ void DataFlowAnalyzer::popScope()
 	for (auto const& name: m_variableScopes.back().variables)
 	{
 		m_value.erase(name);
-		m_references.erase(name);
+		m_references.eraseKey(name);
 	}
 	m_variableScopes.pop_back();
 }
@@ -305,23 +307,25 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 	// First clear storage knowledge, because we do not have to clear
 	// storage knowledge of variables whose expression has changed,
 	// since the value is still unchanged.
-	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
-		return _variables.count(key) || _variables.count(value);
-	});
-	cxx20::erase_if(m_storage, eraseCondition);
-	cxx20::erase_if(m_memory, eraseCondition);
+	for (shared_ptr<KeyValueMap>* data: {&m_storage, &m_memory})
+		for (auto const& name: _variables)
+			if ((*data)->values.count(name) || (*data)->references.count(name))
+			{
+				KeyValueMap& modifiableData = modifiable(*data);
+				modifiableData.eraseKey(name);
+				modifiableData.eraseValue(name);
+			}
 
 	// Also clear variables that reference variables to be cleared.
 	for (auto const& variableToClear: _variables)
-		for (auto const& [ref, names]: m_references)
-			if (names.count(variableToClear))
-				_variables.emplace(ref);
+		if (set<YulString> const* referencingVariables = valueOrNullptr(m_references.references, variableToClear))
+			_variables += *referencingVariables;
 
 	// Clear the value and update the reference relation.
 	for (auto const& name: _variables)
 	{
 		m_value.erase(name);
-		m_references.erase(name);
+		m_references.eraseKey(name);
 	}
 }
 
@@ -334,23 +338,55 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 {
 	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects);
 	if (sideEffects.invalidatesStorage())
-		m_storage.clear();
+		clear(m_storage);
 	if (sideEffects.invalidatesMemory())
-		m_memory.clear();
+		clear(m_memory);
 }
 
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 {
 	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
 	if (sideEffects.invalidatesStorage())
-		m_storage.clear();
+	{
+		if (optional<set<u256>> slots = storageWritesOfCalls(_expr))
+			modifiable(m_storage).eraseIf([&](YulString _key, YulString /* _value */) {
+				optional<u256> key = valueOfIdentifier(_key);
+				return !key || slots->count(*key);
+			});
+		else
+			clear(m_storage);
+	}
 	if (sideEffects.invalidatesMemory())
-		m_memory.clear();
+		clear(m_memory);
+}
+
+optional<set<u256>> DataFlowAnalyzer::storageWritesOfCalls(Expression const& _expression) const
+{
+	FunctionCall const* call = get_if<FunctionCall>(&_expression);
+	if (!call || m_functionStorageWrites.empty())
+		return nullopt;
+
+	set<u256> slots;
+	bool known = true;
+	forEach<FunctionCall const>(*call, [&](FunctionCall const& _call) {
+		if (BuiltinFunction const* builtin = m_dialect.builtin(_call.functionName.name))
+		{
+			if (builtin->sideEffects.storage == SideEffects::Write)
+				known = false;
+		}
+		else if (auto writes = m_functionStorageWrites.find(_call.functionName.name); writes != m_functionStorageWrites.end())
+			slots += writes->second;
+		else
+			known = false;
+	});
+	if (!known)
+		return nullopt;
+	return slots;
 }
 
 void DataFlowAnalyzer::joinKnowledge(
-	unordered_map<YulString, YulString> const& _olderStorage,
-	unordered_map<YulString, YulString> const& _olderMemory
+	shared_ptr<KeyValueMap> const& _olderStorage,
+	shared_ptr<KeyValueMap> const& _olderMemory
 )
 {
 	joinKnowledgeHelper(m_storage, _olderStorage);
@@ -358,18 +394,43 @@ void DataFlowAnalyzer::joinKnowledge(
 }
 
 void DataFlowAnalyzer::joinKnowledgeHelper(
-	std::unordered_map<YulString, YulString>& _this,
-	std::unordered_map<YulString, YulString> const& _older
+	shared_ptr<KeyValueMap>& _this,
+	shared_ptr<KeyValueMap> const& _older
 )
 {
+	// Nothing was modified since the older point.
+	if (_this == _older)
+		return;
+	if (_older->empty())
+	{
+		clear(_this);
+		return;
+	}
 	// We clear if the key does not exist in the older map or if the value is different.
 	// This also works for memory because _older is an "older version"
 	// of m_memory and thus any overlapping write would have cleared the keys
 	// that are not known to be different inside m_memory already.
-	cxx20::erase_if(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
-		YulString const* oldValue = valueOrNullptr(_older, key);
-		return !oldValue || *oldValue != currentValue;
-	}));
+	auto differs = [&](YulString _key, YulString _currentValue) {
+		YulString const* oldValue = valueOrNullptr(_older->values, _key);
+		return !oldValue || *oldValue != _currentValue;
+	};
+	if (any_of(_this->values.begin(), _this->values.end(), [&](auto const& _entry) {
+		return differs(_entry.first, _entry.second);
+	}))
+		modifiable(_this).eraseIf(differs);
+}
+
+DataFlowAnalyzer::KeyValueMap& DataFlowAnalyzer::modifiable(shared_ptr<KeyValueMap>& _data)
+{
+	if (_data.use_count() > 1)
+		_data = make_shared<KeyValueMap>(*_data);
+	return *_data;
+}
+
+void DataFlowAnalyzer::clear(shared_ptr<KeyValueMap>& _data)
+{
+	if (!_data->empty())
+		_data = make_shared<KeyValueMap>();
 }
 
 bool DataFlowAnalyzer::inScope(YulString _variableName) const
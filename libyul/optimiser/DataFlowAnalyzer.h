@@ -30,8 +30,12 @@
 #include <libyul/SideEffects.h>
 
 #include <libsolutil/Common.h>
+#include <libsolutil/FlatSet.h>
+#include <libsolutil/InvertibleMap.h>
+#include <libsolutil/Numeric.h>
 
 #include <map>
+#include <memory>
 #include <set>
 
 namespace solidity::yul
@@ -69,6 +73,9 @@ struct AssignedValue
  * This works also for memory (where addresses overlap) because one branch is always an
  * older version of the other and thus overlapping contents would have been deleted already
  * at the point of assignment.
+ * The storage/memory information is shared with the copies taken at control-flow splits
+ * and only copied when it is modified, so that joining with a branch that does not
+ * change it is free.
  *
  * The DataFlowAnalyzer currently does not deal with the ``leave`` statement. This is because
  * it only matters at the end of a function body, which is a point in the code a derived class
@@ -83,11 +90,19 @@ public:
 	///            Side-effects of user-defined functions. Worst-case side-effects are assumed
 	///            if this is not provided or the function is not found.
 	///            The parameter is mostly used to determine movability of expressions.
+	/// @param _functionStorageWrites
+	///            Storage slots written by user-defined functions, see
+	///            StorageWritesPropagator::storageWrites. Knowledge about the other slots
+	///            is kept across calls to these functions.
 	explicit DataFlowAnalyzer(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> _functionSideEffects = {}
+		std::map<YulString, SideEffects> _functionSideEffects = {},
+		std::map<YulString, std::set<u256>> _functionStorageWrites = {}
 	);
 
+	/// Storage or memory contents: Both keys and values are names of variables.
+	using KeyValueMap = util::InvertibleMap<YulString, YulString>;
+
 	using ASTModifier::operator();
 	void operator()(ExpressionStatement& _statement) override;
 	void operator()(Assignment& _assignment) override;
@@ -100,7 +115,7 @@ public:
 
 protected:
 	/// Registers the assignment.
-	void handleAssignment(std::set<YulString> const& _names, Expression* _value, bool _isDeclaration);
+	void handleAssignment(util::FlatSet<YulString, 4> const& _names, Expression* _value, bool _isDeclaration);
 
 	/// Creates a new inner scope.
 	void pushScope(bool _functionScope);
@@ -120,19 +135,29 @@ protected:
 	/// Clears knowledge about storage or memory if they may be modified inside the expression.
 	void clearKnowledgeIfInvalidated(Expression const& _expression);
 
+	/// @returns the storage slots the functions called in @a _expression write to, or nullopt
+	/// if they are not known.
+	std::optional<std::set<u256>> storageWritesOfCalls(Expression const& _expression) const;
+
 	/// Joins knowledge about storage and memory with an older point in the control-flow.
 	/// This only works if the current state is a direct successor of the older point,
 	/// i.e. `_otherStorage` and `_otherMemory` cannot have additional changes.
 	void joinKnowledge(
-		std::unordered_map<YulString, YulString> const& _olderStorage,
-		std::unordered_map<YulString, YulString> const& _olderMemory
+		std::shared_ptr<KeyValueMap> const& _olderStorage,
+		std::shared_ptr<KeyValueMap> const& _olderMemory
 	);
 
 	static void joinKnowledgeHelper(
-		std::unordered_map<YulString, YulString>& _thisData,
-		std::unordered_map<YulString, YulString> const& _olderData
+		std::shared_ptr<KeyValueMap>& _thisData,
+		std::shared_ptr<KeyValueMap> const& _olderData
 	);
 
+	/// @returns a version of @a _data that can be modified, copying it first if it
+	/// is shared with an older point in the control-flow.
+	static KeyValueMap& modifiable(std::shared_ptr<KeyValueMap>& _data);
+	/// Removes all knowledge from @a _data without modifying shared copies.
+	static void clear(std::shared_ptr<KeyValueMap>& _data);
+
 	/// Returns true iff the variable is in scope.
 	bool inScope(YulString _variableName) const;
 
@@ -163,14 +188,18 @@ protected:
 	/// Side-effects of user-defined functions. Worst-case side-effects are assumed
 	/// if this is not provided or the function is not found.
 	std::map<YulString, SideEffects> m_functionSideEffects;
+	/// Storage slots written by user-defined functions. Arbitrary writes are assumed
+	/// if the function is not found.
+	std::map<YulString, std::set<u256>> m_functionStorageWrites;
 
 	/// Current values of variables, always movable.
 	std::map<YulString, AssignedValue> m_value;
-	/// m_references[a].contains(b) <=> the current expression assigned to a references b
-	std::unordered_map<YulString, std::set<YulString>> m_references;
+	/// m_references.values[a].contains(b) <=> the current expression assigned to a references b
+	util::InvertibleRelation<YulString> m_references;
 
-	std::unordered_map<YulString, YulString> m_storage;
-	std::unordered_map<YulString, YulString> m_memory;
+	/// Knowledge about storage and memory, never null.
+	std::shared_ptr<KeyValueMap> m_storage = std::make_shared<KeyValueMap>();
+	std::shared_ptr<KeyValueMap> m_memory = std::make_shared<KeyValueMap>();
 
 	KnowledgeBase m_knowledgeBase;
 
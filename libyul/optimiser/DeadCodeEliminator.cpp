@@ -20,9 +20,9 @@
  */
 
 #include <libyul/optimiser/DeadCodeEliminator.h>
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimiserStep.h>
-#include <libyul/ControlFlowSideEffectsCollector.h>
 #include <libyul/AST.h>
 
 #include <libevmasm/SemanticInformation.h>
@@ -37,10 +37,9 @@ using namespace solidity::yul;
 
 void DeadCodeEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	ControlFlowSideEffectsCollector sideEffects(_context.dialect, _ast);
 	DeadCodeEliminator{
 		_context.dialect,
-		sideEffects.functionSideEffectsNamed()
+		AnalysisCache::controlFlowSideEffects(_context, _ast)
 	}(_ast);
 }
 
@@ -29,9 +29,24 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
+map<YulString, FunctionDefinition const*> EquivalentFunctionDetector::run(Block& _block)
+{
+	return run(_block, BlockHasher::functionBodyHashes(_block));
+}
+
+map<YulString, FunctionDefinition const*> EquivalentFunctionDetector::run(
+	Block& _block,
+	unordered_map<YulString, uint64_t> _bodyHashes
+)
+{
+	EquivalentFunctionDetector detector{std::move(_bodyHashes)};
+	detector(_block);
+	return std::move(detector.m_duplicates);
+}
+
 void EquivalentFunctionDetector::operator()(FunctionDefinition const& _fun)
 {
-	uint64_t bodyHash = m_blockHashes[&_fun.body];
+	uint64_t bodyHash = m_bodyHashes.at(_fun.name);
 	auto& candidates = m_candidates[bodyHash];
 	for (auto const& candidate: candidates)
 		if (SyntacticallyEqual{}.statementEqual(_fun, *candidate))
@@ -35,21 +35,21 @@ namespace solidity::yul
 class EquivalentFunctionDetector: public ASTWalker
 {
 public:
-	static std::map<YulString, FunctionDefinition const*> run(Block& _block)
-	{
-		EquivalentFunctionDetector detector{BlockHasher::run(_block)};
-		detector(_block);
-		return std::move(detector.m_duplicates);
-	}
+	static std::map<YulString, FunctionDefinition const*> run(Block& _block);
+	/// @param _bodyHashes the hashes of the function bodies, see BlockHasher::functionBodyHashes.
+	static std::map<YulString, FunctionDefinition const*> run(
+		Block& _block,
+		std::unordered_map<YulString, uint64_t> _bodyHashes
+	);
 
 	using ASTWalker::operator();
 	void operator()(FunctionDefinition const& _fun) override;
 
 private:
-	EquivalentFunctionDetector(std::map<Block const*, uint64_t> _blockHashes): m_blockHashes(std::move(_blockHashes)) {}
+	EquivalentFunctionDetector(std::unordered_map<YulString, uint64_t> _bodyHashes): m_bodyHashes(std::move(_bodyHashes)) {}
 
-	std::map<Block const*, uint64_t> m_blockHashes;
-	std::map<uint64_t, std::vector<FunctionDefinition const*>> m_candidates;
+	std::unordered_map<YulString, uint64_t> m_bodyHashes;
+	std::unordered_map<uint64_t, std::vector<FunctionDefinition const*>> m_candidates;
 	std::map<YulString, FunctionDefinition const*> m_duplicates;
 };
 
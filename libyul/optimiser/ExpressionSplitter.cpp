@@ -78,16 +78,27 @@ void ExpressionSplitter::operator()(Block& _block)
 	vector<Statement> saved;
 	swap(saved, m_statementsToPrefix);
 
-	function<std::optional<vector<Statement>>(Statement&)> f =
-			[&](Statement& _statement) -> std::optional<vector<Statement>> {
+	// The statements are only moved to a new vector once something is split off. The statements
+	// to prefix are collected in the same buffer for all statements of the block.
+	optional<vector<Statement>> modified;
+	for (size_t i = 0; i < _block.statements.size(); ++i)
+	{
 		m_statementsToPrefix.clear();
-		visit(_statement);
-		if (m_statementsToPrefix.empty())
-			return {};
-		m_statementsToPrefix.emplace_back(std::move(_statement));
-		return std::move(m_statementsToPrefix);
-	};
-	iterateReplacing(_block.statements, f);
+		visit(_block.statements[i]);
+		if (!m_statementsToPrefix.empty() && !modified)
+		{
+			modified.emplace();
+			modified->reserve(_block.statements.size() + m_statementsToPrefix.size());
+			std::move(_block.statements.begin(), _block.statements.begin() + ptrdiff_t(i), back_inserter(*modified));
+		}
+		if (modified)
+		{
+			std::move(m_statementsToPrefix.begin(), m_statementsToPrefix.end(), back_inserter(*modified));
+			modified->emplace_back(std::move(_block.statements[i]));
+		}
+	}
+	if (modified)
+		_block.statements = std::move(*modified);
 
 	swap(saved, m_statementsToPrefix);
 }
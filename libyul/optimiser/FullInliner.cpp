@@ -40,12 +40,23 @@ using namespace solidity::yul;
 
 void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	FullInliner inliner{_ast, _context.dispenser, _context.dialect};
+	run(_context, _ast, defaultGrowthBudgetPercent);
+}
+
+FullInliner::Statistics FullInliner::run(OptimiserStepContext& _context, Block& _ast, size_t _growthBudgetPercent)
+{
+	FullInliner inliner{_ast, _context.dispenser, _context.dialect, _growthBudgetPercent};
 	inliner.run(Pass::InlineTiny);
 	inliner.run(Pass::InlineRest);
+	return inliner.m_statistics;
 }
 
-FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
+FullInliner::FullInliner(
+	Block& _ast,
+	NameDispenser& _dispenser,
+	Dialect const& _dialect,
+	size_t _growthBudgetPercent
+):
 	m_ast(_ast), m_nameDispenser(_dispenser), m_dialect(_dialect)
 {
 	// Determine constants
@@ -71,6 +82,13 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 			m_singleUse.emplace(fun.name);
 		updateCodeSize(fun);
 	}
+
+	for (auto const& [function, size]: m_functionSizes)
+		m_statistics.initialSize += size;
+	m_statistics.growthBudget = max(
+		m_statistics.initialSize * _growthBudgetPercent / 100,
+		minimumGrowthBudget
+	);
 }
 
 void FullInliner::run(Pass _pass)
@@ -196,12 +214,24 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 			break;
 		}
 
-	return (size < 6 || (constantArg && size < 12));
+	if (!(size < 6 || (constantArg && size < 12)))
+		return false;
+
+	if (m_statistics.sizeIncrease + size > m_statistics.growthBudget)
+	{
+		++m_statistics.callsRejectedByBudget;
+		return false;
+	}
+	return true;
 }
 
 void FullInliner::tentativelyUpdateCodeSize(YulString _function, YulString _callSite)
 {
-	m_functionSizes.at(_callSite) += m_functionSizes.at(_function);
+	size_t size = m_functionSizes.at(_function);
+	m_functionSizes.at(_callSite) += size;
+	++m_statistics.inlinedCalls;
+	if (size > 1 && !m_singleUse.count(_function))
+		m_statistics.sizeIncrease += size;
 }
 
 void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
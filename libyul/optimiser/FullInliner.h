@@ -64,6 +64,11 @@ class NameCollector;
  * code of f, with replacements: a -> f_a, b -> f_b, c -> f_c
  * let z := f_c
  *
+ * To keep the code from growing too much, inlining stops once the estimated code size
+ * added by a run exceeds a budget relative to the size of the code at its start.
+ * Inlining functions that are only called once and tiny functions is always allowed,
+ * since it does not make the code larger.
+ *
  * Prerequisites: Disambiguator
  * More efficient if run after: Function Hoister, Expression Splitter
  */
@@ -71,7 +76,28 @@ class FullInliner: public ASTModifier
 {
 public:
 	static constexpr char const* name{"FullInliner"};
+	/// Default growth budget in percent of the code size at the start of a run.
+	static constexpr size_t defaultGrowthBudgetPercent = 100;
+	/// The budget is never smaller than this, so that small programs are always fully inlined.
+	static constexpr size_t minimumGrowthBudget = 500;
+
+	struct Statistics
+	{
+		/// Estimated code size of the whole program at the start of the run.
+		size_t initialSize = 0;
+		/// Maximum estimated code size that may be added by inlining.
+		size_t growthBudget = 0;
+		/// Estimated code size added by inlining, not counting tiny and single-use functions.
+		size_t sizeIncrease = 0;
+		size_t inlinedCalls = 0;
+		/// Number of calls that would have been inlined without the budget.
+		size_t callsRejectedByBudget = 0;
+	};
+
 	static void run(OptimiserStepContext& _context, Block& _ast);
+	/// Runs the inliner with a growth budget of @a _growthBudgetPercent percent
+	/// and @returns statistics about the run.
+	static Statistics run(OptimiserStepContext& _context, Block& _ast, size_t _growthBudgetPercent);
 
 	/// Inlining heuristic.
 	/// @param _callSite the name of the function in which the function call is located.
@@ -93,7 +119,7 @@ public:
 private:
 	enum Pass { InlineTiny, InlineRest };
 
-	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect);
+	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect, size_t _growthBudgetPercent);
 	void run(Pass _pass);
 
 	/// @returns a map containing the maximum depths of a call chain starting at each
@@ -118,6 +144,7 @@ private:
 	std::map<YulString, size_t> m_functionSizes;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
+	Statistics m_statistics;
 };
 
 /**
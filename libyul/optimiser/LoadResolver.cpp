@@ -25,7 +25,7 @@
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/optimiser/Semantics.h>
-#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/SideEffects.h>
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
@@ -43,10 +43,11 @@ using namespace solidity::yul;
 
 void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 {
-	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
+	bool containsMSize = AnalysisCache::containsMSize(_context, _ast);
 	LoadResolver{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		AnalysisCache::sideEffects(_context, _ast),
+		AnalysisCache::storageWrites(_context, _ast),
 		containsMSize,
 		_context.expectedExecutionsPerDeployment
 	}(_ast);
@@ -82,12 +83,12 @@ void LoadResolver::tryResolve(
 	YulString key = std::get<Identifier>(_arguments.at(0)).name;
 	if (_location == StoreLoadLocation::Storage)
 	{
-		if (auto value = util::valueOrNullptr(m_storage, key))
+		if (auto value = util::valueOrNullptr(m_storage->values, key))
 			if (inScope(*value))
 				_e = Identifier{debugDataOf(_e), *value};
 	}
 	else if (!m_containsMSize && _location == StoreLoadLocation::Memory)
-		if (auto value = util::valueOrNullptr(m_memory, key))
+		if (auto value = util::valueOrNullptr(m_memory->values, key))
 			if (inScope(*value))
 				_e = Identifier{debugDataOf(_e), *value};
 }
@@ -129,7 +130,7 @@ void LoadResolver::tryEvaluateKeccak(
 	if (costOfLiteral > costOfKeccak)
 		return;
 
-	auto memoryValue = util::valueOrNullptr(m_memory, memoryKey->name);
+	auto memoryValue = util::valueOrNullptr(m_memory->values, memoryKey->name);
 	if (memoryValue && inScope(*memoryValue))
 	{
 		optional<u256> memoryContent = valueOfIdentifier(*memoryValue);
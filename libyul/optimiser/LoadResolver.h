@@ -35,6 +35,9 @@ namespace solidity::yul
  * Also evaluates simple ``keccak256(a, c)`` when the value at memory location `a` is known and `c`
  * is a constant `<= 32`.
  *
+ * Knowledge about storage is kept across calls to user-defined functions that only write
+ * to other constant slots, also through the functions they call.
+ *
  * Works best if the code is in SSA form.
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
@@ -50,10 +53,11 @@ private:
 	LoadResolver(
 		Dialect const& _dialect,
 		std::map<YulString, SideEffects> _functionSideEffects,
+		std::map<YulString, std::set<u256>> _functionStorageWrites,
 		bool _containsMSize,
 		std::optional<size_t> _expectedExecutionsPerDeployment
 	):
-		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects)),
+		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects), std::move(_functionStorageWrites)),
 		m_containsMSize(_containsMSize),
 		m_expectedExecutionsPerDeployment(std::move(_expectedExecutionsPerDeployment))
 	{}
@@ -18,7 +18,7 @@
 
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 
-#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
@@ -33,9 +33,8 @@ using namespace solidity::yul;
 
 void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 {
-	map<YulString, SideEffects> functionSideEffects =
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
-	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
+	map<YulString, SideEffects> functionSideEffects = AnalysisCache::sideEffects(_context, _ast);
+	bool containsMSize = AnalysisCache::containsMSize(_context, _ast);
 	set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
 	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
 }
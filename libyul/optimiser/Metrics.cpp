@@ -109,6 +109,13 @@ size_t CodeSize::codeSizeIncludingFunctions(Block const& _block, CodeWeights con
 	return cs.m_size;
 }
 
+size_t CodeSize::codeSizeIncludingFunctions(Statement const& _statement, CodeWeights const& _weights)
+{
+	CodeSize cs(false, _weights);
+	cs.visit(_statement);
+	return cs.m_size;
+}
+
 void CodeSize::visit(Statement const& _statement)
 {
 	if (holds_alternative<FunctionDefinition>(_statement) && m_ignoreFunctions)
@@ -132,6 +139,13 @@ size_t CodeCost::codeCost(Dialect const& _dialect, Expression const& _expr)
 	return cc.m_cost;
 }
 
+size_t CodeCost::codeCost(Dialect const& _dialect, Block const& _block)
+{
+	CodeCost cc(_dialect);
+	cc.ASTWalker::operator()(_block);
+	return cc.m_cost;
+}
+
 
 void CodeCost::operator()(FunctionCall const& _funCall)
 {
@@ -89,6 +89,7 @@ public:
 	static size_t codeSize(Expression const& _expression, CodeWeights const& _weights = {});
 	static size_t codeSize(Block const& _block, CodeWeights const& _weights = {});
 	static size_t codeSizeIncludingFunctions(Block const& _block, CodeWeights const& _weights = {});
+	static size_t codeSizeIncludingFunctions(Statement const& _statement, CodeWeights const& _weights = {});
 
 private:
 	CodeSize(bool _ignoreFunctions = true, CodeWeights const& _weights = {}):
@@ -114,6 +115,8 @@ class CodeCost: public ASTWalker
 {
 public:
 	static size_t codeCost(Dialect const& _dialect, Expression const& _expression);
+	/// @returns the cost of @a _block including the functions defined in it.
+	static size_t codeCost(Dialect const& _dialect, Block const& _block);
 
 private:
 	CodeCost(Dialect const& _dialect): m_dialect(_dialect) {}
@@ -42,7 +42,7 @@ NameDispenser::NameDispenser(Dialect const& _dialect, Block const& _ast, set<Yul
 
 NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames):
 	m_dialect(_dialect),
-	m_usedNames(std::move(_usedNames))
+	m_usedNames(_usedNames.begin(), _usedNames.end())
 {
 }
 
@@ -60,11 +60,12 @@ YulString NameDispenser::newName(YulString _nameHint)
 
 bool NameDispenser::illegalName(YulString _name)
 {
-	return isRestrictedIdentifier(m_dialect, _name) || m_usedNames.count(_name);
+	return m_usedNames.count(_name) || isRestrictedIdentifier(m_dialect, _name);
 }
 
 void NameDispenser::reset(Block const& _ast)
 {
-	m_usedNames = NameCollector(_ast).names() + m_reservedNames;
+	set<YulString> usedNames = NameCollector(_ast).names() + m_reservedNames;
+	m_usedNames = unordered_set<YulString>(usedNames.begin(), usedNames.end());
 	m_counter = 0;
 }
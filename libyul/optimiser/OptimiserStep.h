@@ -31,6 +31,7 @@ struct Dialect;
 struct Block;
 class YulString;
 class NameDispenser;
+class AnalysisCache;
 
 struct OptimiserStepContext
 {
@@ -39,6 +40,10 @@ struct OptimiserStepContext
 	std::set<YulString> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// Maximum number of threads used to run function-local steps.
+	size_t parallelism = 1;
+	/// Analyses shared between steps, can be null.
+	AnalysisCache* analysisCache = nullptr;
 };
 
 
@@ -56,6 +61,9 @@ struct OptimiserStep
 	/// an SMT solver to be loaded, but none is available. In that case, the string
 	/// contains a human-readable reason.
 	virtual std::optional<std::string> invalidInCurrentEnvironment() const = 0;
+	/// @returns true if the step transforms every function independently of the rest of the code,
+	/// without using the name dispenser. Such steps can be run concurrently on separate functions.
+	virtual bool isFunctionLocal() const = 0;
 	std::string name;
 };
 
@@ -73,6 +81,16 @@ private:
 	public:
 		static constexpr bool value = decltype(test<T>(0))::value;
 	};
+	template<typename T>
+	struct HasFunctionLocalMember
+	{
+	private:
+		template<typename U> static auto test(int) -> decltype(U::functionLocal, std::true_type());
+		template<typename> static std::false_type test(...);
+
+	public:
+		static constexpr bool value = decltype(test<T>(0))::value;
+	};
 
 public:
 	OptimiserStepInstance(): OptimiserStep{Step::name} {}
@@ -87,6 +105,13 @@ public:
 		else
 			return std::nullopt;
 	}
+	bool isFunctionLocal() const override
+	{
+		if constexpr (HasFunctionLocalMember<Step>::value)
+			return Step::functionLocal;
+		else
+			return false;
+	}
 };
 
 
@@ -0,0 +1,163 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that removes storage writes which are overwritten before they can be observed.
+ */
+
+#include <libyul/optimiser/OverwrittenStoreEliminator.h>
+
+#include <libyul/optimiser/AnalysisCache.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+
+#include <range/v3/action/remove_if.hpp>
+
+#include <set>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Finds calls to functions that can stop the execution successfully.
+class TerminatingCallFinder: public ASTWalker
+{
+public:
+	TerminatingCallFinder(
+		Dialect const& _dialect,
+		map<YulString, ControlFlowSideEffects> const& _functionSideEffects
+	): m_dialect(_dialect), m_functionSideEffects(_functionSideEffects) {}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+		if (BuiltinFunction const* builtin = m_dialect.builtin(_functionCall.functionName.name))
+			found = found || builtin->controlFlowSideEffects.canTerminate;
+		else if (auto sideEffects = m_functionSideEffects.find(_functionCall.functionName.name); sideEffects != m_functionSideEffects.end())
+			found = found || sideEffects->second.canTerminate;
+		else
+			found = true;
+	}
+
+	bool found = false;
+
+private:
+	Dialect const& m_dialect;
+	map<YulString, ControlFlowSideEffects> const& m_functionSideEffects;
+};
+
+}
+
+void OverwrittenStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	BuiltinFunction const* storeFunction = _context.dialect.storageStoreFunction({});
+	if (!storeFunction)
+		return;
+	OverwrittenStoreEliminator{
+		_context.dialect,
+		storeFunction->name,
+		AnalysisCache::sideEffects(_context, _ast),
+		AnalysisCache::controlFlowSideEffects(_context, _ast)
+	}(_ast);
+}
+
+void OverwrittenStoreEliminator::operator()(Block& _block)
+{
+	ASTModifier::operator()(_block);
+
+	// Indices of the stores that can still be overwritten before they are observed.
+	vector<size_t> pendingStores;
+	set<size_t> overwrittenStores;
+	for (size_t index = 0; index < _block.statements.size(); ++index)
+	{
+		Statement const& statement = _block.statements[index];
+		if (Expression const* slot = simpleStoreSlot(statement))
+		{
+			for (size_t pending: pendingStores)
+				if (SyntacticallyEqual{}(*simpleStoreSlot(_block.statements[pending]), *slot))
+					overwrittenStores.insert(pending);
+			ranges::actions::remove_if(pendingStores, [&](size_t _pending) {
+				return overwrittenStores.count(_pending) > 0;
+			});
+			pendingStores.push_back(index);
+		}
+		else if (!isTransparent(statement))
+			pendingStores.clear();
+		else if (auto const* assignment = get_if<Assignment>(&statement))
+		{
+			// The slot of a pending store is not the same after an assignment to it.
+			set<YulString> assignedNames;
+			for (Identifier const& variable: assignment->variableNames)
+				assignedNames.insert(variable.name);
+			ranges::actions::remove_if(pendingStores, [&](size_t _pending) {
+				auto const* slot = get_if<Identifier>(simpleStoreSlot(_block.statements[_pending]));
+				return slot && assignedNames.count(slot->name) > 0;
+			});
+		}
+	}
+
+	if (overwrittenStores.empty())
+		return;
+	vector<Statement> statements;
+	statements.reserve(_block.statements.size() - overwrittenStores.size());
+	for (size_t index = 0; index < _block.statements.size(); ++index)
+		if (!overwrittenStores.count(index))
+			statements.emplace_back(move(_block.statements[index]));
+	_block.statements = move(statements);
+}
+
+Expression const* OverwrittenStoreEliminator::simpleStoreSlot(Statement const& _statement) const
+{
+	auto const* expressionStatement = get_if<ExpressionStatement>(&_statement);
+	if (!expressionStatement)
+		return nullptr;
+	auto const* functionCall = get_if<FunctionCall>(&expressionStatement->expression);
+	if (!functionCall || functionCall->functionName.name != m_storeFunctionName)
+		return nullptr;
+	for (Expression const& argument: functionCall->arguments)
+		if (!holds_alternative<Identifier>(argument) && !holds_alternative<Literal>(argument))
+			return nullptr;
+	return &functionCall->arguments.front();
+}
+
+bool OverwrittenStoreEliminator::isTransparent(Statement const& _statement) const
+{
+	if (holds_alternative<FunctionDefinition>(_statement))
+		return true;
+	if (
+		!holds_alternative<ExpressionStatement>(_statement) &&
+		!holds_alternative<Assignment>(_statement) &&
+		!holds_alternative<VariableDeclaration>(_statement)
+	)
+		return false;
+
+	SideEffectsCollector sideEffects(m_dialect, &m_functionSideEffects);
+	sideEffects.visit(_statement);
+	if (sideEffects.sideEffects().storage != SideEffects::None)
+		return false;
+
+	TerminatingCallFinder terminatingCalls(m_dialect, m_controlFlowSideEffects);
+	terminatingCalls.visit(_statement);
+	return !terminatingCalls.found;
+}
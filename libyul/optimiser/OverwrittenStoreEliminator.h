@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that removes storage writes which are overwritten before they can be observed.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/ControlFlowSideEffects.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulString.h>
+
+#include <map>
+
+namespace solidity::yul
+{
+struct Dialect;
+
+/**
+ * Optimisation stage that removes a statement of the form ``sstore(k, v)`` if a later statement
+ * ``sstore(k, w)`` of the same block writes to the same slot and nothing in between can read
+ * storage or end the execution successfully.
+ *
+ * Only stores whose arguments are identifiers or literals are considered, and the slot of the
+ * later store has to be syntactically equal to the one of the earlier store. The statements in
+ * between may only be expression statements, assignments and variable declarations that do
+ * not access storage, do not call functions that can terminate and do not assign to the
+ * variables used as slot, or function definitions. Any other statement, including nested
+ * blocks and control flow, ends the search.
+ *
+ * Works best if the code is in SSA form.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class OverwrittenStoreEliminator: public ASTModifier
+{
+public:
+	static constexpr char const* name{"OverwrittenStoreEliminator"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	OverwrittenStoreEliminator(
+		Dialect const& _dialect,
+		YulString _storeFunctionName,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		std::map<YulString, ControlFlowSideEffects> _controlFlowSideEffects
+	):
+		m_dialect(_dialect),
+		m_storeFunctionName(_storeFunctionName),
+		m_functionSideEffects(std::move(_functionSideEffects)),
+		m_controlFlowSideEffects(std::move(_controlFlowSideEffects))
+	{}
+
+	/// @returns the slot of @a _statement if it is a store whose arguments are identifiers or
+	/// literals and nullptr otherwise.
+	Expression const* simpleStoreSlot(Statement const& _statement) const;
+	/// @returns true if the store of a slot before @a _statement can be removed in favour of a
+	/// store of the same slot after it, as long as the slot is not assigned to.
+	bool isTransparent(Statement const& _statement) const;
+
+	Dialect const& m_dialect;
+	YulString m_storeFunctionName;
+	std::map<YulString, SideEffects> m_functionSideEffects;
+	std::map<YulString, ControlFlowSideEffects> m_controlFlowSideEffects;
+};
+
+}
@@ -0,0 +1,472 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that uses the ranges of values of variables to decide `if` conditions.
+ */
+
+#include <libyul/optimiser/RangeBasedSimplifier.h>
+
+#include <libyul/optimiser/AnalysisCache.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <optional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Number of values of variables that are followed to narrow the ranges according to a condition.
+size_t const maxValueDepth = 4;
+
+bigint const valueRangeEnd = bigint(1) << 256;
+
+/// @returns the largest value with the same number of bits as @a _value.
+u256 bitMask(u256 const& _value)
+{
+	if (_value == 0)
+		return 0;
+	unsigned bits = boost::multiprecision::msb(_value) + 1;
+	return bits == 256 ? ~u256(0) : (u256(1) << bits) - 1;
+}
+
+/// Finds `continue` statements that belong to the loop of the visited body.
+class ContinueFinder: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(Continue const&) override { found = true; }
+	void operator()(ForLoop const&) override {}
+	void operator()(FunctionDefinition const&) override {}
+
+	bool found = false;
+};
+
+}
+
+void RangeBasedSimplifier::run(OptimiserStepContext& _context, Block& _ast)
+{
+	RangeBasedSimplifier{_context.dialect, AnalysisCache::controlFlowSideEffects(_context, _ast)}(_ast);
+}
+
+void RangeBasedSimplifier::operator()(VariableDeclaration& _varDecl)
+{
+	if (!_varDecl.value)
+		for (TypedName const& variable: _varDecl.variables)
+			assign(variable.name, nullptr);
+	else if (_varDecl.variables.size() == 1)
+		assign(_varDecl.variables.front().name, _varDecl.value.get());
+}
+
+void RangeBasedSimplifier::operator()(If& _if)
+{
+	Range condition = rangeOf(*_if.condition);
+	if (SideEffectsCollector{m_dialect, *_if.condition}.movable())
+	{
+		if (condition.max == 0)
+		{
+			Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
+			falseCondition.debugData = debugDataOf(*_if.condition);
+			_if.condition = make_unique<Expression>(move(falseCondition));
+			_if.body = Block{};
+			return;
+		}
+		else if (condition.min > 0)
+		{
+			Literal trueCondition = m_dialect.trueLiteral();
+			trueCondition.debugData = debugDataOf(*_if.condition);
+			_if.condition = make_unique<Expression>(move(trueCondition));
+		}
+	}
+
+	Ranges before = m_ranges;
+	narrow(*_if.condition, true);
+	(*this)(_if.body);
+	Ranges afterBody = move(m_ranges);
+	forgetValues(assignedVariableNames(_if.body));
+
+	m_ranges = move(before);
+	narrow(*_if.condition, false);
+	if (flowsOut(_if.body))
+		m_ranges = join(m_ranges, afterBody);
+}
+
+void RangeBasedSimplifier::operator()(Switch& _switch)
+{
+	Ranges before = m_ranges;
+	optional<Ranges> after;
+	bool hasDefault = false;
+	for (Case& switchCase: _switch.cases)
+	{
+		m_ranges = before;
+		if (switchCase.value)
+		{
+			u256 value = valueOfLiteral(*switchCase.value);
+			narrow(*_switch.expression, Range{value, value});
+		}
+		else
+			hasDefault = true;
+		(*this)(switchCase.body);
+		if (flowsOut(switchCase.body))
+			after = after ? join(*after, m_ranges) : m_ranges;
+		forgetValues(assignedVariableNames(switchCase.body));
+	}
+	if (!hasDefault)
+		after = after ? join(*after, before) : before;
+	m_ranges = after ? move(*after) : move(before);
+}
+
+void RangeBasedSimplifier::operator()(ForLoop& _loop)
+{
+	yulAssert(_loop.pre.statements.empty(), "RangeBasedSimplifier needs ForLoopInitRewriter as a prerequisite.");
+
+	Ranges before = m_ranges;
+	narrow(*_loop.condition, true);
+	Ranges atBodyStart = m_ranges;
+	(*this)(_loop.body);
+
+	ContinueFinder continueFinder;
+	continueFinder(_loop.body);
+	if (continueFinder.found || !flowsOut(_loop.body))
+	{
+		m_ranges = move(atBodyStart);
+		forget(assignedVariableNames(_loop.body));
+	}
+	(*this)(_loop.post);
+
+	m_ranges = move(before);
+}
+
+void RangeBasedSimplifier::operator()(FunctionDefinition& _function)
+{
+	Ranges outside = move(m_ranges);
+	m_ranges = {};
+	for (TypedName const& returnVariable: _function.returnVariables)
+		assign(returnVariable.name, nullptr);
+	(*this)(_function.body);
+	m_ranges = move(outside);
+}
+
+void RangeBasedSimplifier::operator()(Block& _block)
+{
+	for (Statement& statement: _block.statements)
+		if (auto* assignment = get_if<Assignment>(&statement); assignment && assignment->variableNames.size() == 1)
+		{
+			// The value has to be evaluated before the knowledge about the variable is removed.
+			YulString variable = assignment->variableNames.front().name;
+			Range range = rangeOf(*assignment->value);
+			forget({variable});
+			if (!ReferencesCounter::countReferences(*assignment->value, ReferencesCounter::OnlyVariables).count(variable))
+				assign(variable, assignment->value.get());
+			else if (!range.isFull())
+				m_ranges[variable] = range;
+		}
+		else
+		{
+			set<YulString> assigned;
+			std::visit([&](auto const& _statement) {
+				forEach<Assignment const>(_statement, [&](Assignment const& _assignment) {
+					for (Identifier const& variable: _assignment.variableNames)
+						assigned.insert(variable.name);
+				});
+			}, statement);
+			// The ranges are joined after branches, but the knowledge from before a loop
+			// does not hold in later iterations.
+			if (holds_alternative<ForLoop>(statement) || holds_alternative<Assignment>(statement))
+				forget(assigned);
+			visit(statement);
+			// The values assigned in a branch or iteration are not known afterwards.
+			forgetValues(assigned);
+		}
+}
+
+RangeBasedSimplifier::Range RangeBasedSimplifier::rangeOf(Expression const& _expression) const
+{
+	if (auto const* literal = get_if<Literal>(&_expression))
+	{
+		u256 value = valueOfLiteral(*literal);
+		return {value, value};
+	}
+	else if (auto const* identifier = get_if<Identifier>(&_expression))
+	{
+		if (auto range = m_ranges.find(identifier->name); range != m_ranges.end())
+			return range->second;
+	}
+	else if (auto const* call = get_if<FunctionCall>(&_expression))
+		if (auto instruction = toEVMInstruction(m_dialect, call->functionName.name))
+			return rangeOfBuiltin(*instruction, call->arguments);
+	return {};
+}
+
+RangeBasedSimplifier::Range RangeBasedSimplifier::rangeOfBuiltin(
+	evmasm::Instruction _instruction,
+	vector<Expression> const& _arguments
+) const
+{
+	using evmasm::Instruction;
+	u256 const maxValue = ~u256(0);
+	u256 const maxAddress = (u256(1) << 160) - 1;
+	u256 const maxSigned = maxValue >> 1;
+
+	vector<Range> arguments;
+	for (Expression const& argument: _arguments)
+		arguments.emplace_back(rangeOf(argument));
+	auto compare = [](Range const& _a, Range const& _b) -> Range {
+		if (_a.max < _b.min)
+			return {1, 1};
+		else if (_a.min >= _b.max)
+			return {0, 0};
+		else
+			return {0, 1};
+	};
+
+	switch (_instruction)
+	{
+	case Instruction::ADD:
+		if (bigint(arguments[0].max) + arguments[1].max < valueRangeEnd)
+			return {arguments[0].min + arguments[1].min, arguments[0].max + arguments[1].max};
+		break;
+	case Instruction::SUB:
+		if (arguments[0].min >= arguments[1].max)
+			return {arguments[0].min - arguments[1].max, arguments[0].max - arguments[1].min};
+		break;
+	case Instruction::MUL:
+		if (bigint(arguments[0].max) * arguments[1].max < valueRangeEnd)
+			return {arguments[0].min * arguments[1].min, arguments[0].max * arguments[1].max};
+		break;
+	case Instruction::DIV:
+		// Division by zero results in zero.
+		if (arguments[1].max == 0)
+			return {0, 0};
+		return {
+			arguments[1].min == 0 ? u256(0) : arguments[0].min / arguments[1].max,
+			arguments[0].max / max(arguments[1].min, u256(1))
+		};
+	case Instruction::MOD:
+		if (arguments[1].max == 0)
+			return {0, 0};
+		else if (arguments[0].max < arguments[1].min)
+			return arguments[0];
+		return {0, min(arguments[0].max, arguments[1].max - 1)};
+	case Instruction::ADDMOD:
+	case Instruction::MULMOD:
+		return {0, arguments[2].max == 0 ? u256(0) : arguments[2].max - 1};
+	case Instruction::AND:
+		return {0, min(arguments[0].max, arguments[1].max)};
+	case Instruction::OR:
+		return {max(arguments[0].min, arguments[1].min), bitMask(max(arguments[0].max, arguments[1].max))};
+	case Instruction::XOR:
+		return {0, bitMask(max(arguments[0].max, arguments[1].max))};
+	case Instruction::NOT:
+		return {~arguments[0].max, ~arguments[0].min};
+	case Instruction::BYTE:
+		return {0, 0xff};
+	case Instruction::SHL:
+		if (
+			arguments[0].min == arguments[0].max &&
+			arguments[0].max < 256 &&
+			(bigint(arguments[1].max) << unsigned(arguments[0].max)) < valueRangeEnd
+		)
+		{
+			unsigned shift = unsigned(arguments[0].max);
+			return {arguments[1].min << shift, arguments[1].max << shift};
+		}
+		break;
+	case Instruction::SHR:
+		if (arguments[0].min >= 256)
+			return {0, 0};
+		return {
+			arguments[0].max >= 256 ? u256(0) : arguments[1].min >> unsigned(arguments[0].max),
+			arguments[1].max >> unsigned(arguments[0].min)
+		};
+	case Instruction::LT:
+		return compare(arguments[0], arguments[1]);
+	case Instruction::GT:
+		return compare(arguments[1], arguments[0]);
+	case Instruction::SLT:
+	case Instruction::SGT:
+		// Signed and unsigned comparison agree on non-negative values.
+		if (arguments[0].max <= maxSigned && arguments[1].max <= maxSigned)
+			return _instruction == Instruction::SLT ?
+				compare(arguments[0], arguments[1]) :
+				compare(arguments[1], arguments[0]);
+		return {0, 1};
+	case Instruction::EQ:
+		if (arguments[0].max < arguments[1].min || arguments[1].max < arguments[0].min)
+			return {0, 0};
+		else if (arguments[0].min == arguments[0].max && arguments[1].min == arguments[1].max)
+			return {1, 1};
+		return {0, 1};
+	case Instruction::ISZERO:
+		if (arguments[0].min > 0)
+			return {0, 0};
+		else if (arguments[0].max == 0)
+			return {1, 1};
+		return {0, 1};
+	case Instruction::ADDRESS:
+	case Instruction::CALLER:
+	case Instruction::ORIGIN:
+	case Instruction::COINBASE:
+		return {0, maxAddress};
+	default:
+		break;
+	}
+	return {};
+}
+
+void RangeBasedSimplifier::narrow(Expression const& _condition, bool _value, size_t _depth)
+{
+	u256 const maxValue = ~u256(0);
+	if (auto const* identifier = get_if<Identifier>(&_condition))
+	{
+		narrow(_condition, _value ? Range{1, maxValue} : Range{0, 0});
+		if (auto value = m_values.find(identifier->name); value != m_values.end() && _depth < maxValueDepth)
+			narrow(*value->second, _value, _depth + 1);
+		return;
+	}
+
+	auto const* call = get_if<FunctionCall>(&_condition);
+	if (!call)
+		return;
+	auto instruction = toEVMInstruction(m_dialect, call->functionName.name);
+	if (!instruction)
+		return;
+	vector<Expression> const& arguments = call->arguments;
+	// Narrows the ranges for `_less < _greater`, or `_less >= _greater` if @a _value is false.
+	auto narrowLessThan = [&](Expression const& _less, Expression const& _greater) {
+		Range less = rangeOf(_less);
+		Range greater = rangeOf(_greater);
+		if (_value)
+		{
+			if (greater.max > 0)
+				narrow(_less, Range{0, greater.max - 1});
+			if (less.min < maxValue)
+				narrow(_greater, Range{less.min + 1, maxValue});
+		}
+		else
+		{
+			narrow(_less, Range{greater.min, maxValue});
+			narrow(_greater, Range{0, less.max});
+		}
+	};
+	switch (*instruction)
+	{
+	case evmasm::Instruction::ISZERO:
+		narrow(arguments[0], !_value, _depth);
+		break;
+	case evmasm::Instruction::LT:
+		narrowLessThan(arguments[0], arguments[1]);
+		break;
+	case evmasm::Instruction::GT:
+		narrowLessThan(arguments[1], arguments[0]);
+		break;
+	case evmasm::Instruction::EQ:
+		if (_value)
+		{
+			Range first = rangeOf(arguments[0]);
+			Range second = rangeOf(arguments[1]);
+			narrow(arguments[0], second);
+			narrow(arguments[1], first);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void RangeBasedSimplifier::narrow(Expression const& _expression, Range const& _range)
+{
+	auto const* identifier = get_if<Identifier>(&_expression);
+	if (!identifier)
+		return;
+	Range range = rangeOf(_expression);
+	range.min = max(range.min, _range.min);
+	range.max = min(range.max, _range.max);
+	// An empty range means that the code is unreachable, which is not used.
+	if (range.min > range.max)
+		return;
+	if (range.isFull())
+		m_ranges.erase(identifier->name);
+	else
+		m_ranges[identifier->name] = range;
+}
+
+void RangeBasedSimplifier::assign(YulString _variable, Expression const* _value)
+{
+	if (!_value)
+	{
+		m_ranges[_variable] = Range{0, 0};
+		return;
+	}
+	if (Range range = rangeOf(*_value); !range.isFull())
+		m_ranges[_variable] = range;
+	m_values[_variable] = _value;
+	for (auto const& [reference, count]: ReferencesCounter::countReferences(*_value, ReferencesCounter::OnlyVariables))
+		m_valuesReferencing[reference].insert(_variable);
+}
+
+void RangeBasedSimplifier::forget(set<YulString> const& _variables)
+{
+	for (YulString variable: _variables)
+		m_ranges.erase(variable);
+	forgetValues(_variables);
+}
+
+void RangeBasedSimplifier::forgetValues(set<YulString> const& _variables)
+{
+	for (YulString variable: _variables)
+	{
+		m_values.erase(variable);
+		if (auto referencing = m_valuesReferencing.find(variable); referencing != m_valuesReferencing.end())
+		{
+			for (YulString other: referencing->second)
+				m_values.erase(other);
+			m_valuesReferencing.erase(referencing);
+		}
+	}
+}
+
+RangeBasedSimplifier::Ranges RangeBasedSimplifier::join(Ranges const& _a, Ranges const& _b)
+{
+	Ranges result;
+	for (auto const& [variable, range]: _a)
+		if (auto other = _b.find(variable); other != _b.end())
+		{
+			Range joined{min(range.min, other->second.min), max(range.max, other->second.max)};
+			if (!joined.isFull())
+				result[variable] = joined;
+		}
+	return result;
+}
+
+bool RangeBasedSimplifier::flowsOut(Block const& _block) const
+{
+	return
+		_block.statements.empty() ||
+		TerminationFinder{m_dialect, &m_functionSideEffects}.controlFlowKind(_block.statements.back()) ==
+			TerminationFinder::ControlFlow::FlowOut;
+}
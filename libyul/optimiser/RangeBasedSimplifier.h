@@ -0,0 +1,137 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that uses the ranges of values of variables to decide `if` conditions.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/ControlFlowSideEffects.h>
+#include <libyul/YulString.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace solidity::evmasm
+{
+enum class Instruction: uint8_t;
+}
+
+namespace solidity::yul
+{
+struct Dialect;
+
+/**
+ * Range-based simplifier.
+ * This optimizer computes an interval of unsigned values for variables and expressions and
+ * uses it to check whether `if` conditions are constant, which is a cheaper and weaker
+ * alternative to the ReasoningBasedSimplifier.
+ * - If the condition is never true, the condition is replaced by `0` and the body is removed.
+ * - If the condition is never false, the condition is replaced by `1`.
+ * The simplifications above can only be applied if the condition is movable.
+ *
+ * The ranges of variables are determined from the values assigned to them, where arithmetic
+ * that can overflow or underflow results in the full range. Inside the body of an `if` or
+ * of a `for` loop, the ranges are narrowed according to the condition, if it is a comparison
+ * or a variable whose value is a comparison. After an `if` statement whose body does not
+ * flow out, e.g. because it reverts or breaks, the ranges are narrowed according to the
+ * negated condition. The ranges are joined where control flow merges and the knowledge
+ * about the variables assigned in a loop is removed before the loop. This removes the
+ * overflow checks of loop counters and of values that were masked or compared before, for
+ * example when validating the length of an array.
+ *
+ * It is only effective on the EVM dialect, but safe to use on other dialects.
+ *
+ * Works best after the ExpressionSplitter and the SSATransform, and after the FullInliner
+ * has inlined the checked arithmetic functions.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class RangeBasedSimplifier: public ASTModifier
+{
+public:
+	static constexpr char const* name{"RangeBasedSimplifier"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(VariableDeclaration& _varDecl) override;
+	void operator()(If& _if) override;
+	void operator()(Switch& _switch) override;
+	void operator()(ForLoop& _loop) override;
+	void operator()(FunctionDefinition& _function) override;
+	void operator()(Block& _block) override;
+
+private:
+	/// Inclusive bounds of an unsigned value.
+	struct Range
+	{
+		u256 min = 0;
+		u256 max = ~u256(0);
+		bool isFull() const { return min == 0 && max == ~u256(0); }
+	};
+	using Ranges = std::map<YulString, Range>;
+
+	RangeBasedSimplifier(
+		Dialect const& _dialect,
+		std::map<YulString, ControlFlowSideEffects> _functionSideEffects
+	):
+		m_dialect(_dialect),
+		m_functionSideEffects(std::move(_functionSideEffects))
+	{}
+
+	/// @returns the range of the value of @a _expression at the current point.
+	Range rangeOf(Expression const& _expression) const;
+	Range rangeOfBuiltin(evmasm::Instruction _instruction, std::vector<Expression> const& _arguments) const;
+	/// Narrows the ranges of the variables in @a _condition under the assumption that it
+	/// evaluates to a non-zero value iff @a _value is true. @a _depth counts the values of
+	/// variables that were followed.
+	void narrow(Expression const& _condition, bool _value, size_t _depth = 0);
+	/// Intersects the range of @a _expression with @a _range if it is a variable, unless that
+	/// would result in an empty range.
+	void narrow(Expression const& _expression, Range const& _range);
+	/// Records that @a _variable was assigned @a _value.
+	void assign(YulString _variable, Expression const* _value);
+	/// Removes the knowledge about the given variables and about the variables whose
+	/// values reference them.
+	void forget(std::set<YulString> const& _variables);
+	/// Removes the values of the given variables and of the variables whose values
+	/// reference them, but keeps the ranges.
+	void forgetValues(std::set<YulString> const& _variables);
+	/// @returns the ranges of the variables that are known in both @a _a and @a _b.
+	static Ranges join(Ranges const& _a, Ranges const& _b);
+	/// @returns true if control flow can continue after @a _block.
+	bool flowsOut(Block const& _block) const;
+
+	Dialect const& m_dialect;
+	std::map<YulString, ControlFlowSideEffects> m_functionSideEffects;
+	/// The values of variables at the current point, as long as none of the variables they
+	/// reference was assigned to.
+	std::map<YulString, Expression const*> m_values;
+	/// The variables whose value in @a m_values references a variable.
+	std::map<YulString, std::set<YulString>> m_valuesReferencing;
+	/// The known ranges of variables at the current point, variables with the full range
+	/// are omitted.
+	Ranges m_ranges;
+};
+
+}
@@ -28,8 +28,10 @@
 
 #include <libsolutil/CommonData.h>
 
-#include <utility>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 using namespace std;
 using namespace solidity;
@@ -37,6 +39,182 @@ using namespace solidity::util;
 using namespace solidity::yul;
 using namespace solidity::smtutil;
 
+namespace
+{
+
+/**
+ * Solver interface that forwards to another solver and caches the results of
+ * satisfiability checks without expressions to evaluate.
+ *
+ * The cache key only contains the assertions added since the last push and all
+ * assertions that transitively share variables with them. Assertions over other
+ * variables do not influence the result as long as they are satisfiable on their own,
+ * which is the case for the variable definitions and (non-constant) conditions
+ * asserted by the ReasoningBasedSimplifier.
+ * Declared variables are renamed in order of appearance, so that the same pattern
+ * in different functions results in the same key.
+ */
+class CachingSolver: public SolverInterface
+{
+public:
+	explicit CachingSolver(unique_ptr<SolverInterface> _solver): m_solver(std::move(_solver)) {}
+
+	void reset() override
+	{
+		m_solver->reset();
+		m_assertions.clear();
+		m_assertionsByVariable.clear();
+		m_levels.clear();
+		m_variables.clear();
+	}
+
+	void push() override
+	{
+		m_solver->push();
+		m_levels.push_back(m_assertions.size());
+	}
+
+	void pop() override
+	{
+		m_solver->pop();
+		yulAssert(!m_levels.empty(), "");
+		size_t size = m_levels.back();
+		m_levels.pop_back();
+		for (; m_assertions.size() > size; m_assertions.pop_back())
+			for (string const& variable: m_assertions.back().variables)
+			{
+				vector<size_t>& indices = m_assertionsByVariable[variable];
+				yulAssert(!indices.empty() && indices.back() == m_assertions.size() - 1, "");
+				indices.pop_back();
+			}
+	}
+
+	void declareVariable(string const& _name, SortPointer const& _sort) override
+	{
+		m_solver->declareVariable(_name, _sort);
+		m_variables.insert(_name);
+	}
+
+	void addAssertion(smtutil::Expression const& _expr) override
+	{
+		m_solver->addAssertion(_expr);
+		Assertion& assertion = m_assertions.emplace_back(Assertion{_expr, {}});
+		collectVariables(_expr, assertion.variables);
+		for (string const& variable: assertion.variables)
+			m_assertionsByVariable[variable].push_back(m_assertions.size() - 1);
+	}
+
+	pair<CheckResult, vector<string>> check(vector<smtutil::Expression> const& _expressionsToEvaluate) override
+	{
+		if (!_expressionsToEvaluate.empty())
+			return m_solver->check(_expressionsToEvaluate);
+
+		string key = queryKey();
+		{
+			lock_guard<mutex> lock(s_mutex);
+			if (CheckResult const* result = valueOrNullptr(s_cache, key))
+				return {*result, {}};
+		}
+
+		auto result = m_solver->check(_expressionsToEvaluate);
+		if (result.first == CheckResult::SATISFIABLE || result.first == CheckResult::UNSATISFIABLE)
+		{
+			lock_guard<mutex> lock(s_mutex);
+			s_cache.emplace(std::move(key), result.first);
+		}
+		return result;
+	}
+
+	vector<string> unhandledQueries() override { return m_solver->unhandledQueries(); }
+	size_t solvers() override { return m_solver->solvers(); }
+
+private:
+	struct Assertion
+	{
+		smtutil::Expression expression;
+		set<string> variables;
+	};
+
+	void collectVariables(smtutil::Expression const& _expr, set<string>& _variables) const
+	{
+		if (_expr.arguments.empty() && m_variables.count(_expr.name))
+			_variables.insert(_expr.name);
+		for (smtutil::Expression const& argument: _expr.arguments)
+			collectVariables(argument, _variables);
+	}
+
+	string queryKey() const
+	{
+		size_t queryStart = m_levels.empty() ? 0 : m_levels.back();
+		vector<bool> selected(m_assertions.size(), false);
+		vector<size_t> toVisit;
+		for (size_t i = queryStart; i < m_assertions.size(); ++i)
+		{
+			selected[i] = true;
+			toVisit.push_back(i);
+		}
+		set<string> visitedVariables;
+		while (!toVisit.empty())
+		{
+			size_t index = toVisit.back();
+			toVisit.pop_back();
+			for (string const& variable: m_assertions[index].variables)
+				if (visitedVariables.insert(variable).second)
+					for (size_t other: m_assertionsByVariable.at(variable))
+						if (!selected[other])
+						{
+							selected[other] = true;
+							toVisit.push_back(other);
+						}
+		}
+
+		string key;
+		map<string, size_t> renaming;
+		for (size_t i = 0; i < m_assertions.size(); ++i)
+			if (selected[i])
+			{
+				serialize(m_assertions[i].expression, renaming, key);
+				key += ';';
+			}
+		return key;
+	}
+
+	void serialize(smtutil::Expression const& _expr, map<string, size_t>& _renaming, string& _out) const
+	{
+		if (_expr.arguments.empty() && m_variables.count(_expr.name))
+			_out += "v" + to_string(_renaming.emplace(_expr.name, _renaming.size()).first->second);
+		else
+			_out += _expr.name;
+		if (_expr.sort)
+			_out += ":" + to_string(static_cast<int>(_expr.sort->kind));
+		if (!_expr.arguments.empty())
+		{
+			_out += '(';
+			for (smtutil::Expression const& argument: _expr.arguments)
+			{
+				serialize(argument, _renaming, _out);
+				_out += ',';
+			}
+			_out += ')';
+		}
+	}
+
+	unique_ptr<SolverInterface> m_solver;
+	vector<Assertion> m_assertions;
+	map<string, vector<size_t>> m_assertionsByVariable;
+	/// Sizes of m_assertions at the time of each push.
+	vector<size_t> m_levels;
+	set<string> m_variables;
+
+	static mutex s_mutex;
+	static unordered_map<string, CheckResult> s_cache;
+};
+
+mutex CachingSolver::s_mutex;
+unordered_map<string, CheckResult> CachingSolver::s_cache;
+
+}
+
 void ReasoningBasedSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
 	set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
@@ -62,6 +240,10 @@ void ReasoningBasedSimplifier::operator()(If& _if)
 	if (!SideEffectsCollector{m_dialect, *_if.condition}.movable())
 		return;
 
+	if (m_remainingQueries == 0)
+		return;
+	--m_remainingQueries;
+
 	smtutil::Expression condition = encodeExpression(*_if.condition);
 	m_solver->push();
 	m_solver->addAssertion(condition == constantValue(0));
@@ -105,6 +287,7 @@ ReasoningBasedSimplifier::ReasoningBasedSimplifier(
 	SMTSolver(_ssaVariables, _dialect),
 	m_dialect(_dialect)
 {
+	m_solver = make_unique<CachingSolver>(std::move(m_solver));
 }
 
 
@@ -45,12 +45,20 @@ namespace solidity::yul
  *
  * It is only effective on the EVM dialect, but safe to use on other dialects.
  *
+ * Answers to queries are cached across all runs of the step, keyed by the query restricted
+ * to the assertions it depends on, with the variables renamed in order of appearance.
+ * At most queryBudget queries (cached or not) are considered per run, further
+ * conditions are left unchanged.
+ *
  * Prerequisite: Disambiguator, SSATransform.
  */
 class ReasoningBasedSimplifier: public ASTModifier, SMTSolver
 {
 public:
 	static constexpr char const* name{"ReasoningBasedSimplifier"};
+	/// Maximum number of `if` conditions checked in one run.
+	/// This is a count and not a time limit so that the output stays deterministic.
+	static constexpr size_t queryBudget = 1000;
 	static void run(OptimiserStepContext& _context, Block& _ast);
 	static std::optional<std::string> invalidInCurrentEnvironment();
 
@@ -70,6 +78,7 @@ private:
 	) override;
 
 	Dialect const& m_dialect;
+	size_t m_remainingQueries = queryBudget;
 };
 
 }
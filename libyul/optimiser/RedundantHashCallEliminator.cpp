@@ -0,0 +1,453 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that reuses the results of earlier calls to functions that hash memory
+ * they wrote themselves, like the helpers that compute the storage slots of mapping elements.
+ */
+
+#include <libyul/optimiser/RedundantHashCallEliminator.h>
+
+#include <libyul/optimiser/AnalysisCache.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/Dialect.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <range/v3/action/remove_if.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Offsets and lengths of memory accesses have to be below this bound, so that
+/// the computations on them cannot overflow.
+u256 const maxOffset = u256(1) << 32;
+
+/// @returns the value of @a _expression if it is a literal or a variable in @a _constants
+/// and small enough to be used as memory offset or length.
+optional<u256> constantValue(Expression const& _expression, map<YulString, u256> const& _constants)
+{
+	optional<u256> value;
+	if (Literal const* literal = get_if<Literal>(&_expression))
+		value = valueOfLiteral(*literal);
+	else if (Identifier const* identifier = get_if<Identifier>(&_expression))
+		if (u256 const* constant = util::valueOrNullptr(_constants, identifier->name))
+			value = *constant;
+	if (value && *value < maxOffset)
+		return value;
+	return nullopt;
+}
+
+/// @returns true if the memory from @a _start to @a _end is contained in the 32 byte words
+/// starting at @a _written.
+bool contains(set<u256> const& _written, u256 _start, u256 _end)
+{
+	for (u256 position = _start; position < _end;)
+	{
+		// The word with the greatest start not after the position ends last among the
+		// words that could contain the position.
+		auto word = _written.upper_bound(position);
+		if (word == _written.begin())
+			return false;
+		--word;
+		if (*word + 32 <= position)
+			return false;
+		position = *word + 32;
+	}
+	return true;
+}
+
+/// @returns true if one of the 32 byte words starting at @a _words overlaps one starting at @a _others.
+bool overlap(set<u256> const& _words, set<u256> const& _others)
+{
+	for (u256 const& word: _words)
+		for (u256 const& other: _others)
+			if (word < other + 32 && other < word + 32)
+				return true;
+	return false;
+}
+
+set<size_t> intersection(set<size_t> const& _a, set<size_t> const& _b)
+{
+	set<size_t> result;
+	set_intersection(_a.begin(), _a.end(), _b.begin(), _b.end(), inserter(result, result.end()));
+	return result;
+}
+
+}
+
+RedundantHashCallEliminator::RedundantHashCallEliminator(
+	Dialect const& _dialect,
+	map<YulString, SideEffects> _functionSideEffects
+):
+	m_dialect(_dialect),
+	m_functionSideEffects(move(_functionSideEffects))
+{
+}
+
+void RedundantHashCallEliminator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (
+		!_context.dialect.memoryStoreFunction({}) ||
+		!_context.dialect.memoryLoadFunction({}) ||
+		_context.dialect.hashFunction({}).empty()
+	)
+		return;
+
+	RedundantHashCallEliminator eliminator{_context.dialect, AnalysisCache::sideEffects(_context, _ast)};
+	for (auto const& [name, function]: allFunctionDefinitions(_ast))
+		if (optional<Words> words = eliminator.hashFunctionWords(*function))
+			eliminator.m_hashFunctions[name] = move(*words);
+	if (!eliminator.m_hashFunctions.empty())
+		eliminator(_ast);
+}
+
+void RedundantHashCallEliminator::operator()(ExpressionStatement& _statement)
+{
+	ASTModifier::operator()(_statement);
+	handleMemoryWrites(SideEffectsCollector(m_dialect, _statement.expression, &m_functionSideEffects).sideEffects());
+}
+
+void RedundantHashCallEliminator::operator()(Assignment& _assignment)
+{
+	ASTModifier::operator()(_assignment);
+	handleMemoryWrites(SideEffectsCollector(m_dialect, *_assignment.value, &m_functionSideEffects).sideEffects());
+	set<YulString> names;
+	for (Identifier const& variable: _assignment.variableNames)
+		names.insert(variable.name);
+	forget(names);
+}
+
+void RedundantHashCallEliminator::operator()(VariableDeclaration& _varDecl)
+{
+	ASTModifier::operator()(_varDecl);
+	if (!_varDecl.value)
+		return;
+
+	FunctionCall const* call = hashCall(_varDecl);
+	if (!call)
+	{
+		handleMemoryWrites(SideEffectsCollector(m_dialect, *_varDecl.value, &m_functionSideEffects).sideEffects());
+		return;
+	}
+
+	Words const& words = m_hashFunctions.at(call->functionName.name);
+	for (HashCall& earlier: m_calls)
+		if (overlap(m_hashFunctions.at(earlier.function), words))
+			earlier.memoryCurrent = false;
+	m_calls.emplace_back(HashCall{
+		m_nextId++,
+		call->functionName.name,
+		normalizedArguments(*call),
+		_varDecl.variables.front().name,
+		m_depth,
+		true
+	});
+}
+
+void RedundantHashCallEliminator::operator()(If& _if)
+{
+	visit(*_if.condition);
+	handleMemoryWrites(SideEffectsCollector(m_dialect, *_if.condition, &m_functionSideEffects).sideEffects());
+
+	set<size_t> before = currentCalls();
+	(*this)(_if.body);
+	setCurrent(intersection(before, currentCalls()));
+}
+
+void RedundantHashCallEliminator::operator()(Switch& _switch)
+{
+	visit(*_switch.expression);
+	handleMemoryWrites(SideEffectsCollector(m_dialect, *_switch.expression, &m_functionSideEffects).sideEffects());
+
+	set<size_t> before = currentCalls();
+	set<size_t> after = before;
+	for (Case& switchCase: _switch.cases)
+	{
+		setCurrent(before);
+		(*this)(switchCase.body);
+		after = intersection(after, currentCalls());
+	}
+	setCurrent(after);
+}
+
+void RedundantHashCallEliminator::operator()(FunctionDefinition& _functionDefinition)
+{
+	vector<HashCall> calls;
+	map<YulString, YulString> aliases;
+	swap(m_calls, calls);
+	swap(m_aliases, aliases);
+
+	ASTModifier::operator()(_functionDefinition);
+
+	swap(m_calls, calls);
+	swap(m_aliases, aliases);
+}
+
+void RedundantHashCallEliminator::operator()(ForLoop& _loop)
+{
+	yulAssert(_loop.pre.statements.empty(), "Requires ForLoopInitRewriter.");
+
+	// At the start of later iterations, the variables assigned in the loop and the memory
+	// written in the loop can be different.
+	forget(assignedVariableNames(_loop.body) + assignedVariableNames(_loop.post));
+	handleMemoryWrites(SideEffectsCollector(m_dialect, _loop, &m_functionSideEffects).sideEffects());
+
+	visit(*_loop.condition);
+	set<size_t> before = currentCalls();
+	(*this)(_loop.body);
+	// The post block is also reached from ``continue`` statements.
+	setCurrent(intersection(before, currentCalls()));
+	(*this)(_loop.post);
+	setCurrent(intersection(before, currentCalls()));
+}
+
+void RedundantHashCallEliminator::operator()(Block& _block)
+{
+	++m_depth;
+	for (size_t index = 0; index < _block.statements.size(); ++index)
+	{
+		Statement& statement = _block.statements[index];
+		if (auto* varDecl = get_if<VariableDeclaration>(&statement))
+			if (FunctionCall const* call = hashCall(*varDecl))
+				if (HashCall const* earlier = earlierCall(*call))
+					if (
+						earlier->memoryCurrent ||
+						overwrittenLater(_block, index, m_hashFunctions.at(call->functionName.name))
+					)
+					{
+						YulString variable = varDecl->variables.front().name;
+						m_aliases[variable] = earlier->result;
+						*varDecl->value = Identifier{debugDataOf(*varDecl->value), earlier->result};
+						continue;
+					}
+		visit(statement);
+	}
+	--m_depth;
+
+	ranges::actions::remove_if(m_calls, [&](HashCall const& _call) { return _call.depth > m_depth; });
+}
+
+optional<RedundantHashCallEliminator::Words> RedundantHashCallEliminator::hashFunctionWords(
+	FunctionDefinition const& _function
+) const
+{
+	if (_function.returnVariables.size() != 1)
+		return nullopt;
+
+	YulString storeFunction = m_dialect.memoryStoreFunction({})->name;
+	map<YulString, u256> constants;
+
+	Words written;
+	for (Statement const& statement: _function.body.statements)
+		if (auto const* varDecl = get_if<VariableDeclaration>(&statement))
+		{
+			if (!varDecl->value)
+				continue;
+			if (!onlyReadsWritten(*varDecl->value, constants, written))
+				return nullopt;
+			if (varDecl->variables.size() == 1)
+				if (optional<u256> value = constantValue(*varDecl->value, constants))
+					constants[varDecl->variables.front().name] = *value;
+		}
+		else if (auto const* assignment = get_if<Assignment>(&statement))
+		{
+			if (!onlyReadsWritten(*assignment->value, constants, written))
+				return nullopt;
+			for (Identifier const& variable: assignment->variableNames)
+				constants.erase(variable.name);
+		}
+		else if (auto const* expressionStatement = get_if<ExpressionStatement>(&statement))
+		{
+			FunctionCall const* call = get_if<FunctionCall>(&expressionStatement->expression);
+			if (!call || call->functionName.name != storeFunction)
+				return nullopt;
+			optional<u256> offset = constantValue(call->arguments.at(0), constants);
+			if (!offset || !onlyReadsWritten(call->arguments.at(1), constants, written))
+				return nullopt;
+			written.insert(*offset);
+		}
+		else
+			return nullopt;
+
+	if (written.empty())
+		return nullopt;
+	return written;
+}
+
+bool RedundantHashCallEliminator::onlyReadsWritten(
+	Expression const& _expression,
+	map<YulString, u256> const& _constants,
+	Words const& _written
+) const
+{
+	FunctionCall const* call = get_if<FunctionCall>(&_expression);
+	if (!call)
+		return true;
+	for (Expression const& argument: call->arguments)
+		if (!onlyReadsWritten(argument, _constants, _written))
+			return false;
+
+	YulString name = call->functionName.name;
+	if (name == m_dialect.memoryLoadFunction({})->name)
+	{
+		optional<u256> offset = constantValue(call->arguments.at(0), _constants);
+		return offset && contains(_written, *offset, *offset + 32);
+	}
+	else if (name == m_dialect.hashFunction({}))
+	{
+		optional<u256> offset = constantValue(call->arguments.at(0), _constants);
+		optional<u256> length = constantValue(call->arguments.at(1), _constants);
+		return offset && length && contains(_written, *offset, *offset + *length);
+	}
+	else if (BuiltinFunction const* builtin = m_dialect.builtin(name))
+		return builtin->sideEffects.movable;
+	else if (SideEffects const* sideEffects = util::valueOrNullptr(m_functionSideEffects, name))
+		return sideEffects->movable && sideEffects->cannotLoop;
+	else
+		return false;
+}
+
+FunctionCall const* RedundantHashCallEliminator::hashCall(VariableDeclaration const& _varDecl) const
+{
+	if (_varDecl.variables.size() != 1 || !_varDecl.value)
+		return nullptr;
+	FunctionCall const* call = get_if<FunctionCall>(_varDecl.value.get());
+	if (!call || !m_hashFunctions.count(call->functionName.name))
+		return nullptr;
+	for (Expression const& argument: call->arguments)
+		if (!holds_alternative<Identifier>(argument) && !holds_alternative<Literal>(argument))
+			return nullptr;
+	return call;
+}
+
+vector<Expression> RedundantHashCallEliminator::normalizedArguments(FunctionCall const& _call) const
+{
+	vector<Expression> arguments;
+	for (Expression const& argument: _call.arguments)
+		if (Identifier const* identifier = get_if<Identifier>(&argument))
+			arguments.emplace_back(Identifier{
+				identifier->debugData,
+				util::valueOrDefault(m_aliases, identifier->name, identifier->name)
+			});
+		else
+			arguments.emplace_back(std::get<Literal>(argument));
+	return arguments;
+}
+
+RedundantHashCallEliminator::HashCall const* RedundantHashCallEliminator::earlierCall(
+	FunctionCall const& _call
+) const
+{
+	vector<Expression> arguments = normalizedArguments(_call);
+	HashCall const* found = nullptr;
+	for (HashCall const& earlier: m_calls)
+		if (
+			earlier.function == _call.functionName.name &&
+			equal(
+				earlier.arguments.begin(), earlier.arguments.end(),
+				arguments.begin(), arguments.end(),
+				SyntacticallyEqual{}
+			)
+		)
+		{
+			if (earlier.memoryCurrent)
+				return &earlier;
+			if (!found)
+				found = &earlier;
+		}
+	return found;
+}
+
+bool RedundantHashCallEliminator::overwrittenLater(
+	Block const& _block,
+	size_t _index,
+	Words const& _words
+) const
+{
+	for (size_t index = _index + 1; index < _block.statements.size(); ++index)
+	{
+		Statement const& statement = _block.statements[index];
+		if (auto const* varDecl = get_if<VariableDeclaration>(&statement))
+			if (FunctionCall const* call = hashCall(*varDecl))
+			{
+				Words const& overwritten = m_hashFunctions.at(call->functionName.name);
+				return includes(overwritten.begin(), overwritten.end(), _words.begin(), _words.end());
+			}
+		if (
+			!holds_alternative<VariableDeclaration>(statement) &&
+			!holds_alternative<Assignment>(statement) &&
+			!holds_alternative<ExpressionStatement>(statement)
+		)
+			return false;
+		SideEffectsCollector sideEffects(m_dialect, &m_functionSideEffects);
+		sideEffects.visit(statement);
+		if (sideEffects.sideEffects().memory != SideEffects::None)
+			return false;
+	}
+	return false;
+}
+
+void RedundantHashCallEliminator::handleMemoryWrites(SideEffects const& _sideEffects)
+{
+	if (_sideEffects.memory == SideEffects::Write)
+		setCurrent({});
+}
+
+void RedundantHashCallEliminator::forget(set<YulString> const& _variables)
+{
+	auto references = [&](HashCall const& _call) {
+		if (_variables.count(_call.result))
+			return true;
+		for (Expression const& argument: _call.arguments)
+			if (Identifier const* identifier = get_if<Identifier>(&argument))
+				if (_variables.count(identifier->name))
+					return true;
+		return false;
+	};
+	ranges::actions::remove_if(m_calls, references);
+	for (auto alias = m_aliases.begin(); alias != m_aliases.end();)
+		if (_variables.count(alias->first) || _variables.count(alias->second))
+			alias = m_aliases.erase(alias);
+		else
+			++alias;
+}
+
+set<size_t> RedundantHashCallEliminator::currentCalls() const
+{
+	set<size_t> ids;
+	for (HashCall const& call: m_calls)
+		if (call.memoryCurrent)
+			ids.insert(call.id);
+	return ids;
+}
+
+void RedundantHashCallEliminator::setCurrent(set<size_t> const& _ids)
+{
+	for (HashCall& call: m_calls)
+		call.memoryCurrent = _ids.count(call.id) > 0;
+}
@@ -0,0 +1,140 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that reuses the results of earlier calls to functions that hash memory
+ * they wrote themselves, like the helpers that compute the storage slots of mapping elements.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/AST.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulString.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+struct Dialect;
+
+/**
+ * Optimisation stage that replaces ``let y := f(a, b)`` by ``let y := x`` if ``f`` is a hash
+ * function and ``let x := f(a, b)`` is executed before on every path to it.
+ *
+ * A hash function has a single return variable and a body that only consists of variable
+ * declarations, assignments and ``mstore`` at constant offsets. Apart from movable functions,
+ * the body may only call ``mload`` and ``keccak256`` on constant ranges of the memory it wrote
+ * before. The helpers that compute the storage slot of a mapping element look like this. The
+ * result of a hash function only depends on its arguments, and every call writes the same
+ * values to the same memory words.
+ *
+ * The call is replaced if the memory it writes was not changed since the earlier call, or if
+ * a later call of a hash function in the same block overwrites it and only statements that do
+ * not access memory are in between. The arguments have to be identifiers or literals that are
+ * syntactically equal, where variables that were replaced by an earlier result count as that
+ * result, and neither they nor ``x`` can be assigned to in between.
+ *
+ * Works best if the code is in SSA form.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class RedundantHashCallEliminator: public ASTModifier
+{
+public:
+	static constexpr char const* name{"RedundantHashCallEliminator"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(ExpressionStatement& _statement) override;
+	void operator()(Assignment& _assignment) override;
+	void operator()(VariableDeclaration& _varDecl) override;
+	void operator()(If& _if) override;
+	void operator()(Switch& _switch) override;
+	void operator()(FunctionDefinition& _functionDefinition) override;
+	void operator()(ForLoop& _loop) override;
+	void operator()(Block& _block) override;
+
+private:
+	/// Start offsets of the 32 byte memory words a hash function writes.
+	using Words = std::set<u256>;
+
+	/// A call of a hash function whose result is still valid.
+	struct HashCall
+	{
+		size_t id;
+		YulString function;
+		/// Identifiers or literals, with variables replaced by the results they are aliases of.
+		std::vector<Expression> arguments;
+		YulString result;
+		/// Nesting depth of the block the result is declared in.
+		size_t depth;
+		/// True if the memory words written by the call were not changed since.
+		bool memoryCurrent;
+	};
+
+	RedundantHashCallEliminator(Dialect const& _dialect, std::map<YulString, SideEffects> _functionSideEffects);
+
+	/// @returns the memory words @a _function writes if it is a hash function.
+	std::optional<Words> hashFunctionWords(FunctionDefinition const& _function) const;
+	/// @returns true if @a _expression only calls movable functions and reads memory
+	/// within @a _written at offsets given by literals or by variables in @a _constants.
+	bool onlyReadsWritten(
+		Expression const& _expression,
+		std::map<YulString, u256> const& _constants,
+		Words const& _written
+	) const;
+
+	/// @returns the call of a hash function whose arguments are identifiers or literals
+	/// if @a _varDecl declares a single variable with the value of such a call.
+	FunctionCall const* hashCall(VariableDeclaration const& _varDecl) const;
+	/// @returns the arguments of @a _call with variables replaced by the results they are aliases of.
+	std::vector<Expression> normalizedArguments(FunctionCall const& _call) const;
+	/// @returns the earlier call with the same function and arguments as @a _call, preferring
+	/// calls whose memory words are not changed since.
+	HashCall const* earlierCall(FunctionCall const& _call) const;
+	/// @returns true if the memory words @a _words are overwritten by a later hash function call
+	/// in @a _block, after the statement at @a _index, before memory can be accessed.
+	bool overwrittenLater(Block const& _block, size_t _index, Words const& _words) const;
+
+	/// Marks the memory of all calls as changed if @a _sideEffects write to memory.
+	void handleMemoryWrites(SideEffects const& _sideEffects);
+	/// Removes the calls and aliases that refer to the given variables.
+	void forget(std::set<YulString> const& _variables);
+	/// @returns the ids of the calls whose memory words were not changed.
+	std::set<size_t> currentCalls() const;
+	/// Marks the memory of exactly the calls in @a _ids as not changed.
+	void setCurrent(std::set<size_t> const& _ids);
+
+	Dialect const& m_dialect;
+	std::map<YulString, SideEffects> m_functionSideEffects;
+	std::map<YulString, Words> m_hashFunctions;
+	std::vector<HashCall> m_calls;
+	/// Variables whose value was replaced by the result of an earlier call.
+	std::map<YulString, YulString> m_aliases;
+	size_t m_depth = 0;
+	size_t m_nextId = 0;
+};
+
+}
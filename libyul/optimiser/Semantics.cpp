@@ -21,10 +21,13 @@
 
 #include <libyul/optimiser/Semantics.h>
 
+#include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
 
 #include <libevmasm/SemanticInformation.h>
 
@@ -94,6 +97,13 @@ bool MSizeFinder::containsMSize(Dialect const& _dialect, Block const& _ast)
 	return finder.m_msizeFound;
 }
 
+bool MSizeFinder::containsMSize(Dialect const& _dialect, Statement const& _statement)
+{
+	MSizeFinder finder(_dialect);
+	finder.visit(_statement);
+	return finder.m_msizeFound;
+}
+
 void MSizeFinder::operator()(FunctionCall const& _functionCall)
 {
 	ASTWalker::operator()(_functionCall);
@@ -149,6 +159,80 @@ map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
 	return ret;
 }
 
+map<YulString, set<u256>> StorageWritesPropagator::storageWrites(
+	Dialect const& _dialect,
+	Block const& _ast
+)
+{
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+	auto constantSlot = [&](Expression const& _slot) -> optional<u256> {
+		Expression const* slot = &_slot;
+		if (Identifier const* identifier = get_if<Identifier>(slot))
+		{
+			auto value = ssaValues.values().find(identifier->name);
+			if (value == ssaValues.values().end())
+				return nullopt;
+			slot = value->second;
+		}
+		if (Literal const* literal = get_if<Literal>(slot))
+			return valueOfLiteral(*literal);
+		return nullopt;
+	};
+
+	BuiltinFunction const* storeFunction = _dialect.storageStoreFunction(YulString{});
+	map<YulString, set<u256>> ret;
+	map<YulString, set<YulString>> callees;
+	for (auto const& [name, function]: allFunctionDefinitions(_ast))
+	{
+		set<u256> slots;
+		bool known = true;
+		forEach<FunctionCall const>(function->body, [&](FunctionCall const& _call) {
+			if (BuiltinFunction const* builtin = _dialect.builtin(_call.functionName.name))
+			{
+				if (builtin->sideEffects.storage != SideEffects::Write)
+					return;
+				optional<u256> slot;
+				if (storeFunction && builtin->name == storeFunction->name)
+					slot = constantSlot(_call.arguments.at(0));
+				if (slot)
+					slots.insert(*slot);
+				else
+					known = false;
+			}
+			else
+				callees[name].insert(_call.functionName.name);
+		});
+		if (known)
+			ret[name] = move(slots);
+	}
+
+	// Adds the slots of the callees until nothing changes. This terminates because the sets
+	// only grow and functions only ever become unknown.
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (auto const& [caller, calledFunctions]: callees)
+			if (ret.count(caller))
+				for (YulString callee: calledFunctions)
+				{
+					if (callee == caller)
+						continue;
+					if (!ret.count(callee))
+					{
+						ret.erase(caller);
+						changed = true;
+						break;
+					}
+					set<u256>& slots = ret.at(caller);
+					size_t previousSize = slots.size();
+					slots += ret.at(callee);
+					changed = changed || slots.size() != previousSize;
+				}
+	}
+	return ret;
+}
+
 MovableChecker::MovableChecker(Dialect const& _dialect, Expression const& _expression):
 	MovableChecker(_dialect)
 {
@@ -26,6 +26,8 @@
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/AST.h>
 
+#include <libsolutil/Numeric.h>
+
 #include <set>
 
 namespace solidity::yul
@@ -130,6 +132,27 @@ public:
 	);
 };
 
+/**
+ * This class can be used to determine the storage slots that user-defined functions write to,
+ * including the writes of the functions they call.
+ *
+ * The slots are only known if every ``sstore`` uses a literal or a variable that is initialised
+ * with a literal and never re-assigned, and if no other builtin that writes to storage is called.
+ *
+ * Prerequisite: Disambiguator
+ */
+class StorageWritesPropagator
+{
+public:
+	/// @returns the written slots of the functions whose writes are known. Functions that
+	/// do not write to storage map to the empty set, functions that are missing can write
+	/// to arbitrary slots.
+	static std::map<YulString, std::set<u256>> storageWrites(
+		Dialect const& _dialect,
+		Block const& _ast
+	);
+};
+
 /**
  * Class that can be used to find out if certain code contains the MSize instruction
  * or a verbatim bytecode builtin (which is always assumed that it could contain MSize).
@@ -143,6 +166,7 @@ class MSizeFinder: public ASTWalker
 {
 public:
 	static bool containsMSize(Dialect const& _dialect, Block const& _ast);
+	static bool containsMSize(Dialect const& _dialect, Statement const& _statement);
 
 	using ASTWalker::operator();
 	void operator()(FunctionCall const& _funCall) override;
@@ -47,7 +47,8 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
+	// The rules store the current match groups, so every thread needs its own copy.
+	thread_local std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
 
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
@@ -59,8 +60,40 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	SimplificationRules& rules = *evmRules[version];
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	// Rules never match direct function call arguments (see Pattern::matches), so we can stop early.
+	vector<ArgumentShape> argumentShapes;
+	for (Expression const& argument: *instruction->second)
 	{
+		if (holds_alternative<FunctionCall>(argument))
+			return nullptr;
+
+		// Resolve the variable the same way Pattern::matches does for non-"Any" patterns.
+		Expression const* value = &argument;
+		if (Identifier const* identifier = get_if<Identifier>(&argument))
+			if (AssignedValue const* assignedValue = util::valueOrNullptr(_ssaValues, identifier->name))
+				if (assignedValue->value)
+					value = assignedValue->value;
+
+		ArgumentShape& shape = argumentShapes.emplace_back();
+		if (Literal const* literal = get_if<Literal>(value))
+		{
+			if (literal->kind == LiteralKind::Number)
+				shape.kind = PatternKind::Constant;
+		}
+		else if (auto valueInstruction = instructionAndArguments(_dialect, *value))
+		{
+			shape.kind = PatternKind::Operation;
+			shape.instruction = valueInstruction->first;
+		}
+	}
+
+	auto const& candidates = rules.m_rules[uint8_t(instruction->first)];
+	auto const& candidateShapes = rules.m_argumentShapes[uint8_t(instruction->first)];
+	for (size_t i = 0; i < candidates.size(); ++i)
+	{
+		if (!shapesCompatible(candidateShapes[i], argumentShapes))
+			continue;
+		auto const& rule = candidates[i];
 		rules.resetMatchGroups();
 		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
 			if (!rule.feasible || rule.feasible())
@@ -94,7 +127,38 @@ void SimplificationRules::addRules(std::vector<Rule> const& _rules)
 
 void SimplificationRules::addRule(Rule const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	uint8_t instruction = uint8_t(_rule.pattern.instruction());
+	m_rules[instruction].push_back(_rule);
+
+	vector<ArgumentShape> shapes;
+	for (Pattern const& argument: _rule.pattern.arguments())
+	{
+		ArgumentShape& shape = shapes.emplace_back();
+		shape.kind = argument.kind();
+		if (shape.kind == PatternKind::Operation)
+			shape.instruction = argument.instruction();
+	}
+	m_argumentShapes[instruction].emplace_back(std::move(shapes));
+}
+
+bool SimplificationRules::shapesCompatible(
+	vector<ArgumentShape> const& _ruleShapes,
+	vector<ArgumentShape> const& _argumentShapes
+)
+{
+	if (_ruleShapes.size() != _argumentShapes.size())
+		return true;
+	for (size_t i = 0; i < _ruleShapes.size(); ++i)
+	{
+		ArgumentShape const& ruleShape = _ruleShapes[i];
+		if (ruleShape.kind == PatternKind::Any)
+			continue;
+		if (ruleShape.kind != _argumentShapes[i].kind)
+			return false;
+		if (ruleShape.kind == PatternKind::Operation && ruleShape.instruction != _argumentShapes[i].instruction)
+			return false;
+	}
+	return true;
 }
 
 SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _evmVersion)
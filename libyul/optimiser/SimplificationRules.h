@@ -41,6 +41,13 @@ struct Dialect;
 struct AssignedValue;
 class Pattern;
 
+enum class PatternKind
+{
+	Operation,
+	Constant,
+	Any
+};
+
 /**
  * Container for all simplification rules.
  */
@@ -72,20 +79,30 @@ public:
 	instructionAndArguments(Dialect const& _dialect, Expression const& _expr);
 
 private:
+	/// Kind and instruction of a (top-level) argument of a pattern or an expression.
+	/// Used to discard rules that cannot match without attempting a full match.
+	struct ArgumentShape
+	{
+		PatternKind kind = PatternKind::Any;
+		evmasm::Instruction instruction = evmasm::Instruction::STOP;
+	};
+
 	void addRules(std::vector<Rule> const& _rules);
 	void addRule(Rule const& _rule);
 
 	void resetMatchGroups() { m_matchGroups.clear(); }
 
+	/// @returns false if a rule whose arguments have the shapes @a _ruleShapes
+	/// can never match arguments with the shapes @a _argumentShapes.
+	static bool shapesCompatible(
+		std::vector<ArgumentShape> const& _ruleShapes,
+		std::vector<ArgumentShape> const& _argumentShapes
+	);
+
 	std::map<unsigned, Expression const*> m_matchGroups;
 	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
-};
-
-enum class PatternKind
-{
-	Operation,
-	Constant,
-	Any
+	/// Shapes of the arguments of the patterns in m_rules, with the same indices.
+	std::vector<std::vector<ArgumentShape>> m_argumentShapes[256];
 };
 
 /**
@@ -122,6 +139,7 @@ public:
 	) const;
 
 	std::vector<Pattern> arguments() const { return m_arguments; }
+	PatternKind kind() const { return m_kind; }
 
 	/// @returns the data of the matched expression if this pattern is part of a match group.
 	u256 d() const;
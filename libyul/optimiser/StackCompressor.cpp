@@ -236,30 +236,37 @@ bool StackCompressor::run(
 	bool allowMSizeOptimzation = !MSizeFinder::containsMSize(_dialect, *_object.code);
 	if (usesOptimizedCodeGenerator)
 	{
-		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
+		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::reanalyzeAssertCorrect(_dialect, _object);
 		unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, _dialect, *_object.code);
+		map<YulString, vector<StackLayoutGenerator::StackTooDeep>> stackTooDeepErrors =
+			StackLayoutGenerator::reportStackTooDeep(*cfg);
+		// Only the main entry point is reported even if it has no errors.
+		if (stackTooDeepErrors.at(YulString{}).empty())
+			stackTooDeepErrors.erase(YulString{});
+		if (stackTooDeepErrors.empty())
+			return true;
 		Block& mainBlock = std::get<Block>(_object.code->statements.at(0));
-		if (
-			auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg, YulString{});
-			!stackTooDeepErrors.empty()
-		)
-			eliminateVariables(_dialect, mainBlock, stackTooDeepErrors, allowMSizeOptimzation);
+		if (auto const* errors = util::valueOrNullptr(stackTooDeepErrors, YulString{}))
+			eliminateVariables(_dialect, mainBlock, *errors, allowMSizeOptimzation);
 		for (size_t i = 1; i < _object.code->statements.size(); ++i)
 		{
 			auto& fun = std::get<FunctionDefinition>(_object.code->statements[i]);
-			if (
-				auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg, fun.name);
-				!stackTooDeepErrors.empty()
-			)
-				eliminateVariables(_dialect, fun.body, stackTooDeepErrors, allowMSizeOptimzation);
+			if (auto const* errors = util::valueOrNullptr(stackTooDeepErrors, fun.name))
+				eliminateVariables(_dialect, fun.body, *errors, allowMSizeOptimzation);
 		}
 	}
 	else
+	{
+		// Variables are only eliminated in the functions that are not compilable and the stack of a
+		// function does not depend on the other functions, so only those functions are checked again.
+		optional<set<YulString>> functionsToCheck;
 		for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 		{
-			map<YulString, int> stackSurplus = CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
+			map<YulString, int> stackSurplus =
+				CompilabilityChecker(_dialect, _object, _optimizeStackAllocation, functionsToCheck).stackDeficit;
 			if (stackSurplus.empty())
 				return true;
+			functionsToCheck = util::keys(stackSurplus);
 
 			if (stackSurplus.count(YulString{}))
 			{
@@ -287,6 +294,7 @@ bool StackCompressor::run(
 				);
 			}
 		}
+	}
 	return false;
 }
 
@@ -45,7 +45,9 @@ class StackCompressor
 {
 public:
 	/// Try to remove local variables until the AST is compilable.
-	/// @returns true if it was successful.
+	/// @returns true if it was successful. If the optimized code generator is used, the variables
+	/// are only removed once, so the function returns true only if the AST was compilable already
+	/// and has not been changed.
 	static bool run(
 		Dialect const& _dialect,
 		Object& _object,
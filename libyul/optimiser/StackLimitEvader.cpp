@@ -130,7 +130,7 @@ void StackLimitEvader::run(
 	);
 	if (evmDialect && evmDialect->evmVersion().canOverchargeGasForCall())
 	{
-		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(*evmDialect, _object);
+		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::reanalyzeAssertCorrect(*evmDialect, _object);
 		unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, *evmDialect, *_object.code);
 		run(_context, _object, StackLayoutGenerator::reportStackTooDeep(*cfg));
 	}
@@ -186,22 +186,50 @@ void StackLimitEvader::run(
 		if (reservedMemory != literalArgumentValue(*memoryGuardCall))
 			return;
 
-	CallGraph callGraph = CallGraphGenerator::callGraph(*_object.code);
-
-	// We cannot move variables in recursive functions to fixed memory offsets.
-	for (YulString function: callGraph.recursiveFunctions())
-		if (_unreachableVariables.count(function))
-			return;
-
-	map<YulString, FunctionDefinition const*> functionDefinitions = allFunctionDefinitions(*_object.code);
-
-	MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls, functionDefinitions};
-	uint64_t requiredSlots = memoryOffsetAllocator.run();
-	yulAssert(requiredSlots < (uint64_t(1) << 32) - 1, "");
-
-	StackToMemoryMover::run(_context, reservedMemory, memoryOffsetAllocator.slotAllocations, requiredSlots, *_object.code);
-
-	reservedMemory += 32 * requiredSlots;
+	// Without unreachable variables, there is nothing to move and only the arguments of
+	// the ``memoryguard`` calls are normalised below.
+	if (!_unreachableVariables.empty())
+	{
+		CallGraph callGraph = CallGraphGenerator::callGraph(*_object.code);
+
+		// We cannot move variables in recursive functions to fixed memory offsets.
+		for (YulString function: callGraph.recursiveFunctions())
+			if (_unreachableVariables.count(function))
+				return;
+
+		map<YulString, FunctionDefinition const*> functionDefinitions = allFunctionDefinitions(*_object.code);
+
+		MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls, functionDefinitions};
+		uint64_t requiredSlots = memoryOffsetAllocator.run();
+		yulAssert(requiredSlots < (uint64_t(1) << 32) - 1, "");
+
+		// Only the functions containing moved variables and the callers of functions with
+		// moved return variables have to be rewritten.
+		set<YulString> affectedFunctions;
+		set<YulString> functionsWithMovedReturnVariables;
+		for (auto const& [function, unreachables]: _unreachableVariables)
+			affectedFunctions.insert(function);
+		for (auto const& [name, functionDefinition]: functionDefinitions)
+			if (util::contains_if(functionDefinition->returnVariables, [&](TypedName const& _variable) {
+				return memoryOffsetAllocator.slotAllocations.count(_variable.name);
+			}))
+				functionsWithMovedReturnVariables.insert(name);
+		if (!functionsWithMovedReturnVariables.empty())
+			for (auto const& [caller, callees]: callGraph.functionCalls)
+				if (util::contains_if(callees, [&](YulString _callee) { return functionsWithMovedReturnVariables.count(_callee); }))
+					affectedFunctions.insert(caller);
+
+		StackToMemoryMover::run(
+			_context,
+			reservedMemory,
+			memoryOffsetAllocator.slotAllocations,
+			requiredSlots,
+			*_object.code,
+			affectedFunctions
+		);
+
+		reservedMemory += 32 * requiredSlots;
+	}
 	for (FunctionCall* memoryGuardCall: FunctionCallFinder::run(*_object.code, "memoryguard"_yulstring))
 	{
 		Literal* literal = std::get_if<Literal>(&memoryGuardCall->arguments.front());
@@ -33,7 +33,9 @@ struct Object;
  * Optimisation stage that assigns memory offsets to variables that would become unreachable if
  * assigned a stack slot as usual.
  *
- * Uses CompilabilityChecker to determine which variables in which functions are unreachable.
+ * Determines which variables in which functions are unreachable using the stack too deep reports of
+ * the StackLayoutGenerator or, for the legacy code transform, using the CompilabilityChecker.
+ * Only the functions that are affected by moving these variables are rewritten.
  *
  * Only variables outside of functions contained in cycles in the call graph are considered. Thereby it is possible
  * to assign globally fixed memory offsets to the variable. If a variable in a function contained in a cycle in the
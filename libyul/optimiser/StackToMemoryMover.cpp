@@ -98,6 +98,62 @@ void StackToMemoryMover::run(
 	_block.statements += move(stackToMemoryMover.m_newFunctionDefinitions);
 }
 
+void StackToMemoryMover::run(
+	OptimiserStepContext& _context,
+	u256 _reservedMemory,
+	map<YulString, uint64_t> const& _memorySlots,
+	uint64_t _numRequiredSlots,
+	Block& _block,
+	set<YulString> const& _affectedFunctions
+)
+{
+	if (_memorySlots.empty())
+		return;
+
+	map<YulString, FunctionDefinition const*> functionDefinitions = allFunctionDefinitions(_block);
+	size_t topLevelFunctions = static_cast<size_t>(count_if(
+		_block.statements.begin(),
+		_block.statements.end(),
+		[](Statement const& _statement) { return holds_alternative<FunctionDefinition>(_statement); }
+	));
+	// Skipping functions is only safe if no function is nested in code that is skipped.
+	if (topLevelFunctions != functionDefinitions.size())
+	{
+		run(_context, _reservedMemory, _memorySlots, _numRequiredSlots, _block);
+		return;
+	}
+
+	VariableMemoryOffsetTracker memoryOffsetTracker(_reservedMemory, _memorySlots, _numRequiredSlots);
+	StackToMemoryMover stackToMemoryMover(
+		_context,
+		memoryOffsetTracker,
+		util::applyMap(
+			functionDefinitions,
+			util::mapTuple([](YulString _name, FunctionDefinition const* _funDef) {
+				return make_pair(_name, _funDef->returnVariables);
+			}),
+			map<YulString, TypedNameList>{}
+		)
+	);
+	// None of the top-level statements is an assignment or a variable declaration, since
+	// the code is split into the main block and the function definitions, so it suffices to visit them.
+	yulAssert(
+		ranges::none_of(_block.statements, [](Statement const& _statement) {
+			return holds_alternative<Assignment>(_statement) || holds_alternative<VariableDeclaration>(_statement);
+		}),
+		""
+	);
+	for (Statement& statement: _block.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+		{
+			if (_affectedFunctions.count(function->name))
+				stackToMemoryMover.visit(statement);
+		}
+		else
+			stackToMemoryMover.visit(statement);
+	_block.statements += move(stackToMemoryMover.m_newFunctionDefinitions);
+}
+
 StackToMemoryMover::StackToMemoryMover(
 	OptimiserStepContext& _context,
 	VariableMemoryOffsetTracker const& _memoryOffsetTracker,
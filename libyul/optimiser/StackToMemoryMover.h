@@ -29,6 +29,8 @@
 #include <libsolutil/Numeric.h>
 
 #include <list>
+#include <map>
+#include <set>
 
 namespace solidity::yul
 {
@@ -146,6 +148,21 @@ public:
 		uint64_t _numRequiredSlots,
 		Block& _block
 	);
+	/**
+	 * Runs the stack to memory mover like the version above, but only rewrites the top-level code
+	 * of @a _block that is not a function definition and the top-level functions in @a _affectedFunctions.
+	 * These have to include all functions declaring a variable in @a _memorySlots and all functions
+	 * calling a function with a return variable in @a _memorySlots.
+	 * If @a _block contains nested function definitions, all of the code is rewritten.
+	 */
+	static void run(
+		OptimiserStepContext& _context,
+		u256 _reservedMemory,
+		std::map<YulString, uint64_t> const& _memorySlots,
+		uint64_t _numRequiredSlots,
+		Block& _block,
+		std::set<YulString> const& _affectedFunctions
+	);
 	using ASTModifier::operator();
 
 	void operator()(FunctionDefinition& _functionDefinition) override;
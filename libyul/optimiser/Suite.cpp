@@ -21,6 +21,7 @@
 
 #include <libyul/optimiser/Suite.h>
 
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
@@ -42,7 +43,9 @@
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
 #include <libyul/optimiser/FunctionSpecializer.h>
+#include <libyul/optimiser/RangeBasedSimplifier.h>
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
+#include <libyul/optimiser/RedundantHashCallEliminator.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/UnusedFunctionParameterPruner.h>
 #include <libyul/optimiser/UnusedPruner.h>
@@ -61,6 +64,7 @@
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameSimplifier.h>
+#include <libyul/optimiser/OverwrittenStoreEliminator.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
@@ -72,12 +76,16 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Timing.h>
 
 #include <libyul/CompilabilityChecker.h>
 
 #include <range/v3/view/map.hpp>
 #include <range/v3/action/remove.hpp>
 
+#include <boost/functional/hash.hpp>
+
 #include <limits>
 #include <tuple>
 
@@ -92,7 +100,10 @@ void OptimiserSuite::run(
 	bool _optimizeStackAllocation,
 	string_view _optimisationSequence,
 	optional<size_t> _expectedExecutionsPerDeployment,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	util::TimingCollector* _stepTimings,
+	size_t _parallelism,
+	optional<chrono::steady_clock::time_point> _deadline
 )
 {
 	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
@@ -112,9 +123,10 @@ void OptimiserSuite::run(
 	Block& ast = *_object.code;
 
 	NameDispenser dispenser{_dialect, ast, reservedIdentifiers};
-	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
+	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment, _parallelism, nullptr};
 
-	OptimiserSuite suite(context, Debug::None);
+	OptimiserSuite suite(context, Debug::None, _stepTimings);
+	suite.m_deadline = _deadline;
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -145,13 +157,17 @@ void OptimiserSuite::run(
 		ConstantOptimiser{*evmDialect, *_meter}(ast);
 		if (usesOptimizedCodeGenerator)
 		{
-			StackCompressor::run(
+			bool compilable = StackCompressor::run(
 				_dialect,
 				_object,
 				_optimizeStackAllocation,
 				stackCompressorMaxIterations
 			);
-			if (evmDialect->providesObjectAccess())
+			// If the stack compressor did not find any stack too deep errors, the code is unchanged
+			// and there is no need to determine them again.
+			if (compilable)
+				StackLimitEvader::run(suite.m_context, _object, map<YulString, set<YulString>>{});
+			else
 				StackLimitEvader::run(suite.m_context, _object);
 		}
 		else if (evmDialect->providesObjectAccess() && _optimizeStackAllocation)
@@ -169,12 +185,156 @@ void OptimiserSuite::run(
 	NameSimplifier::run(suite.m_context, ast);
 	VarNameCleaner::run(suite.m_context, ast);
 
-	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
+	*_object.analysisInfo = AsmAnalyzer::reanalyzeAssertCorrect(_dialect, _object);
 }
 
 namespace
 {
 
+/**
+ * Computes a hash of the exact contents of an AST, including all names and debug data.
+ * Unlike BlockHasher, renaming variables changes the hash.
+ */
+class ASTFingerprint: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+
+	/// @returns the fingerprints of the top-level statements of @a _ast.
+	static vector<size_t> ofStatements(Block const& _ast)
+	{
+		vector<size_t> fingerprints;
+		fingerprints.reserve(_ast.statements.size());
+		for (Statement const& statement: _ast.statements)
+		{
+			ASTFingerprint fingerprint;
+			fingerprint.visit(statement);
+			fingerprints.push_back(fingerprint.m_hash);
+		}
+		return fingerprints;
+	}
+
+	/// @returns the fingerprint of @a _ast given the fingerprints of its top-level statements.
+	static size_t ofBlock(Block const& _ast, vector<size_t> const& _statementFingerprints)
+	{
+		ASTFingerprint fingerprint;
+		fingerprint.add(14, _ast.debugData);
+		boost::hash_combine(fingerprint.m_hash, _ast.statements.size());
+		for (size_t statementFingerprint: _statementFingerprints)
+			boost::hash_combine(fingerprint.m_hash, statementFingerprint);
+		return fingerprint.m_hash;
+	}
+
+	void operator()(Literal const& _literal) override
+	{
+		add(1, _literal.debugData);
+		boost::hash_combine(m_hash, static_cast<int>(_literal.kind));
+		boost::hash_combine(m_hash, _literal.value.hash());
+		boost::hash_combine(m_hash, _literal.type.hash());
+	}
+	void operator()(Identifier const& _identifier) override
+	{
+		add(2, _identifier.debugData);
+		boost::hash_combine(m_hash, _identifier.name.hash());
+	}
+	void operator()(FunctionCall const& _funCall) override
+	{
+		add(3, _funCall.debugData);
+		(*this)(_funCall.functionName);
+		boost::hash_combine(m_hash, _funCall.arguments.size());
+		ASTWalker::operator()(_funCall);
+	}
+	void operator()(ExpressionStatement const& _statement) override
+	{
+		add(4, _statement.debugData);
+		ASTWalker::operator()(_statement);
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		add(5, _assignment.debugData);
+		boost::hash_combine(m_hash, _assignment.variableNames.size());
+		ASTWalker::operator()(_assignment);
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		add(6, _varDecl.debugData);
+		addNames(_varDecl.variables);
+		boost::hash_combine(m_hash, !!_varDecl.value);
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(If const& _if) override
+	{
+		add(7, _if.debugData);
+		ASTWalker::operator()(_if);
+	}
+	void operator()(Switch const& _switch) override
+	{
+		add(8, _switch.debugData);
+		boost::hash_combine(m_hash, _switch.cases.size());
+		for (Case const& _case: _switch.cases)
+		{
+			addDebugData(_case.debugData);
+			boost::hash_combine(m_hash, !!_case.value);
+		}
+		ASTWalker::operator()(_switch);
+	}
+	void operator()(FunctionDefinition const& _funDef) override
+	{
+		add(9, _funDef.debugData);
+		boost::hash_combine(m_hash, _funDef.name.hash());
+		addNames(_funDef.parameters);
+		addNames(_funDef.returnVariables);
+		ASTWalker::operator()(_funDef);
+	}
+	void operator()(ForLoop const& _loop) override
+	{
+		add(10, _loop.debugData);
+		ASTWalker::operator()(_loop);
+	}
+	void operator()(Break const& _break) override { add(11, _break.debugData); }
+	void operator()(Continue const& _continue) override { add(12, _continue.debugData); }
+	void operator()(Leave const& _leave) override { add(13, _leave.debugData); }
+	void operator()(Block const& _block) override
+	{
+		add(14, _block.debugData);
+		boost::hash_combine(m_hash, _block.statements.size());
+		ASTWalker::operator()(_block);
+	}
+
+private:
+	void add(int _kind, shared_ptr<DebugData const> const& _debugData)
+	{
+		boost::hash_combine(m_hash, _kind);
+		addDebugData(_debugData);
+	}
+	void addDebugData(shared_ptr<DebugData const> const& _debugData)
+	{
+		boost::hash_combine(m_hash, !!_debugData);
+		if (!_debugData)
+			return;
+		for (langutil::SourceLocation const* location: {&_debugData->nativeLocation, &_debugData->originLocation})
+		{
+			// Source names are interned, so equal names have equal pointers.
+			boost::hash_combine(m_hash, location->sourceName);
+			boost::hash_combine(m_hash, location->start);
+			boost::hash_combine(m_hash, location->end);
+		}
+		boost::hash_combine(m_hash, _debugData->astID.value_or(-1));
+		boost::hash_combine(m_hash, _debugData->astID.has_value());
+	}
+	void addNames(TypedNameList const& _names)
+	{
+		boost::hash_combine(m_hash, _names.size());
+		for (TypedName const& name: _names)
+		{
+			addDebugData(name.debugData);
+			boost::hash_combine(m_hash, name.name.hash());
+			boost::hash_combine(m_hash, name.type.hash());
+		}
+	}
+
+	size_t m_hash = 0;
+};
 
 template <class... Step>
 map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
@@ -194,41 +354,44 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			UnusedAssignEliminator,
-			ReasoningBasedSimplifier,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	// Initialisation of function-local statics is thread-safe, so the collection is
+	// created directly instead of being filled on first use.
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		OverwrittenStoreEliminator,
+		UnusedAssignEliminator,
+		RangeBasedSimplifier,
+		ReasoningBasedSimplifier,
+		RedundantHashCallEliminator,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -259,7 +422,10 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{LiteralRematerialiser::name,         'T'},
 		{LoadResolver::name,                  'L'},
 		{LoopInvariantCodeMotion::name,       'M'},
+		{OverwrittenStoreEliminator::name,    'S'},
+		{RangeBasedSimplifier::name,          'E'},
 		{ReasoningBasedSimplifier::name,      'R'},
+		{RedundantHashCallEliminator::name,   'H'},
 		{UnusedAssignEliminator::name,        'r'},
 		{Rematerialiser::name,                'm'},
 		{SSAReverser::name,                   'V'},
@@ -396,6 +562,8 @@ void OptimiserSuite::runSequence(string_view _stepAbbreviations, Block& _ast, bo
 			subsequences.push_back({subsequence, true});
 	}
 
+	// The caller might have modified the AST since the last step was run.
+	m_fingerprintedAST = nullptr;
 	size_t codeSize = 0;
 	for (size_t round = 0; round < MaxRounds; ++round)
 	{
@@ -410,7 +578,7 @@ void OptimiserSuite::runSequence(string_view _stepAbbreviations, Block& _ast, bo
 		if (!_repeatUntilStable)
 			break;
 
-		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
+		size_t newSize = this->codeSize(_ast, m_fingerprintedAST == &_ast ? &m_statementFingerprints : nullptr);
 		if (newSize == codeSize)
 			break;
 		codeSize = newSize;
@@ -422,11 +590,60 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+	// Steps are deterministic, so a step that did not change the AST will not change it
+	// when run again on the same AST. Such runs are skipped.
+	// This is disabled for debug output, so that every step is reported.
+	// The fingerprints also tell the analysis cache which top-level statements changed.
+	bool const skipNoOps = m_debug == Debug::None;
+	// If step timings are collected, also record whether each step changed the AST and by how much.
+	bool const collectStatistics = m_stepTimings != nullptr;
+	optional<size_t> fingerprint;
+	vector<size_t> statementFingerprints;
+	ScopedSaveAndRestore analysisCache(m_context.analysisCache, skipNoOps ? &m_analysisCache : nullptr);
+	if (skipNoOps || collectStatistics)
+	{
+		statementFingerprints = ASTFingerprint::ofStatements(_ast);
+		fingerprint = ASTFingerprint::ofBlock(_ast, statementFingerprints);
+	}
+	size_t codeSize = collectStatistics ? this->codeSize(_ast, &statementFingerprints) : 0;
 	for (string const& step: _steps)
 	{
+		assertThrow(
+			!m_deadline || chrono::steady_clock::now() < *m_deadline,
+			OptimizerTimeout,
+			"Optimiser deadline passed."
+		);
+		if (skipNoOps)
+			if (auto it = m_noOpFingerprints.find(step); it != m_noOpFingerprints.end() && it->second == *fingerprint)
+				continue;
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		if (skipNoOps)
+			m_analysisCache.setAST(_ast, *fingerprint, statementFingerprints);
+		{
+			util::ScopedTimer timer(m_stepTimings, step);
+			runStep(*allSteps().at(step), _ast);
+		}
+		if (skipNoOps)
+			m_analysisCache.invalidate();
+		if (skipNoOps || collectStatistics)
+		{
+			statementFingerprints = ASTFingerprint::ofStatements(_ast);
+			size_t newFingerprint = ASTFingerprint::ofBlock(_ast, statementFingerprints);
+			if (skipNoOps && newFingerprint == *fingerprint)
+				m_noOpFingerprints[step] = newFingerprint;
+			if (collectStatistics)
+			{
+				size_t newCodeSize = this->codeSize(_ast, &statementFingerprints);
+				m_stepTimings->recordChange(
+					step,
+					newFingerprint != *fingerprint,
+					static_cast<int64_t>(newCodeSize) - static_cast<int64_t>(codeSize)
+				);
+				codeSize = newCodeSize;
+			}
+			fingerprint = newFingerprint;
+		}
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -440,4 +657,71 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 			}
 		}
 	}
+
+	if (skipNoOps || collectStatistics)
+	{
+		m_fingerprintedAST = &_ast;
+		m_statementFingerprints = std::move(statementFingerprints);
+	}
+	else
+		m_fingerprintedAST = nullptr;
+}
+
+size_t OptimiserSuite::codeSize(Block const& _ast, vector<size_t> const* _statementFingerprints)
+{
+	if (!_statementFingerprints)
+		return CodeSize::codeSizeIncludingFunctions(_ast);
+
+	yulAssert(_statementFingerprints->size() == _ast.statements.size(), "");
+	// Only the sizes of the current statements are kept, which are the ones most likely to be
+	// asked for again.
+	unordered_map<size_t, size_t> statementCodeSizes;
+	size_t size = 0;
+	for (size_t i = 0; i < _ast.statements.size(); ++i)
+	{
+		size_t fingerprint = (*_statementFingerprints)[i];
+		auto it = m_statementCodeSizes.find(fingerprint);
+		size_t statementSize =
+			it != m_statementCodeSizes.end() ?
+			it->second :
+			CodeSize::codeSizeIncludingFunctions(_ast.statements[i]);
+		statementCodeSizes[fingerprint] = statementSize;
+		size += statementSize;
+	}
+	m_statementCodeSizes = std::move(statementCodeSizes);
+	return size;
+}
+
+void OptimiserSuite::runStep(OptimiserStep const& _step, Block& _ast)
+{
+	// After the FunctionGrouper, the AST consists of a block with the main code
+	// followed by the function definitions.
+	bool const grouped =
+		!_ast.statements.empty() &&
+		holds_alternative<Block>(_ast.statements.front()) &&
+		all_of(_ast.statements.begin() + 1, _ast.statements.end(), [](Statement const& _statement) {
+			return holds_alternative<FunctionDefinition>(_statement);
+		});
+	if (m_context.parallelism <= 1 || !_step.isFunctionLocal() || !grouped || _ast.statements.size() <= 2)
+	{
+		_step.run(m_context, _ast);
+		return;
+	}
+
+	// Every statement is moved into a block of its own, so that the steps can process them
+	// concurrently. Function-local steps do not add or remove top-level statements.
+	vector<Block> parts(_ast.statements.size());
+	for (size_t i = 0; i < parts.size(); ++i)
+	{
+		parts[i].debugData = _ast.debugData;
+		parts[i].statements.emplace_back(std::move(_ast.statements[i]));
+	}
+	util::parallelFor(parts.size(), m_context.parallelism, [&](size_t _index) {
+		_step.run(m_context, parts[_index]);
+	});
+	for (size_t i = 0; i < parts.size(); ++i)
+	{
+		yulAssert(parts[i].statements.size() == 1, "Function-local step changed the top-level statements.");
+		_ast.statements[i] = std::move(parts[i].statements.front());
+	}
 }
@@ -23,15 +23,24 @@
 
 #include <libyul/ASTForward.h>
 #include <libyul/YulString.h>
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <chrono>
+#include <optional>
 #include <set>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <memory>
 
+namespace solidity::util
+{
+class TimingCollector;
+}
+
 namespace solidity::yul
 {
 
@@ -59,9 +68,21 @@ public:
 		PrintStep,
 		PrintChanges
 	};
-	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
+	/// If @a _stepTimings is given, the time spent in each step is recorded in it, together with
+	/// the number of runs that changed the AST and the resulting change of the code size.
+	OptimiserSuite(
+		OptimiserStepContext& _context,
+		Debug _debug = Debug::None,
+		util::TimingCollector* _stepTimings = nullptr
+	):
+		m_context(_context),
+		m_debug(_debug),
+		m_stepTimings(_stepTimings)
+	{}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// If @a _deadline passes before the optimisation is finished, OptimizerTimeout is thrown and
+	/// the object is left in an unspecified state.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
@@ -69,7 +90,10 @@ public:
 		bool _optimizeStackAllocation,
 		std::string_view _optimisationSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		util::TimingCollector* _stepTimings = nullptr,
+		size_t _parallelism = 1,
+		std::optional<std::chrono::steady_clock::time_point> _deadline = std::nullopt
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -84,8 +108,28 @@ public:
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
+	/// Runs the given step. Function-local steps are run concurrently on the top-level
+	/// functions if the AST is in the form established by the FunctionGrouper.
+	void runStep(OptimiserStep const& _step, Block& _ast);
+	/// @returns the code size of @a _ast including functions. If @a _statementFingerprints are
+	/// given, the sizes of the top-level statements are reused from earlier calls.
+	size_t codeSize(Block const& _ast, std::vector<size_t> const* _statementFingerprints);
+
 	OptimiserStepContext& m_context;
 	Debug m_debug;
+	util::TimingCollector* m_stepTimings = nullptr;
+	/// Time after which no further step is started and OptimizerTimeout is thrown instead.
+	std::optional<std::chrono::steady_clock::time_point> m_deadline;
+	/// For each step, the fingerprint of the AST on which it was last run without changing it.
+	std::map<std::string, size_t> m_noOpFingerprints;
+	/// Analyses shared between the steps, keyed by the same fingerprints.
+	AnalysisCache m_analysisCache;
+	/// Fingerprints of the top-level statements of the AST after the last step, as long as it was
+	/// not modified since.
+	Block const* m_fingerprintedAST = nullptr;
+	std::vector<size_t> m_statementFingerprints;
+	/// Code sizes of the top-level statements of the last AST measured, by their fingerprints.
+	std::unordered_map<size_t, size_t> m_statementCodeSizes;
 };
 
 }
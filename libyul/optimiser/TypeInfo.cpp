@@ -71,6 +71,11 @@ public:
 TypeInfo::TypeInfo(Dialect const& _dialect, Block const& _ast):
 	m_dialect(_dialect)
 {
+	if (m_dialect.types.size() == 1)
+	{
+		m_singleType = *m_dialect.types.begin();
+		return;
+	}
 	TypeCollector types(_ast);
 	m_functionTypes = std::move(types.functionTypes);
 	m_variableTypes = std::move(types.variableTypes);
@@ -78,6 +83,8 @@ TypeInfo::TypeInfo(Dialect const& _dialect, Block const& _ast):
 
 YulString TypeInfo::typeOf(Expression const& _expression) const
 {
+	if (m_singleType)
+		return *m_singleType;
 	return std::visit(GenericVisitor{
 		[&](FunctionCall const& _funCall) {
 			YulString name = _funCall.functionName.name;
@@ -100,5 +107,7 @@ YulString TypeInfo::typeOf(Expression const& _expression) const
 
 YulString TypeInfo::typeOfVariable(YulString _name) const
 {
+	if (m_singleType)
+		return *m_singleType;
 	return m_variableTypes.at(_name);
 }
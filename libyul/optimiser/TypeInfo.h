@@ -25,6 +25,7 @@
 
 #include <vector>
 #include <map>
+#include <optional>
 
 namespace solidity::yul
 {
@@ -32,6 +33,7 @@ struct Dialect;
 
 /**
  * Helper class that keeps track of the types while performing optimizations.
+ * For dialects with a single type, no types are collected.
  *
  * Only works on disambiguated sources!
  */
@@ -40,7 +42,11 @@ class TypeInfo
 public:
 	TypeInfo(Dialect const& _dialect, Block const& _ast);
 
-	void setVariableType(YulString _name, YulString _type) { m_variableTypes[_name] = _type; }
+	void setVariableType(YulString _name, YulString _type)
+	{
+		if (!m_singleType)
+			m_variableTypes[_name] = _type;
+	}
 
 	/// @returns the type of an expression that is assumed to return exactly one value.
 	YulString typeOf(Expression const& _expression) const;
@@ -58,6 +64,8 @@ private:
 	};
 
 	Dialect const& m_dialect;
+	/// The type of everything if the dialect only has one type.
+	std::optional<YulString> m_singleType;
 	std::map<YulString, YulString> m_variableTypes;
 	std::map<YulString, FunctionType> m_functionTypes;
 };
@@ -111,6 +111,7 @@ class UnusedAssignEliminator: public UnusedStoreBase
 {
 public:
 	static constexpr char const* name{"UnusedAssignEliminator"};
+	static constexpr bool functionLocal = true;
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	explicit UnusedAssignEliminator(Dialect const& _dialect): UnusedStoreBase(_dialect) {}
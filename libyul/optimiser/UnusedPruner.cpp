@@ -20,6 +20,7 @@
 
 #include <libyul/optimiser/UnusedPruner.h>
 
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/NameCollector.h>
@@ -30,13 +31,23 @@
 #include <libyul/Dialect.h>
 #include <libyul/SideEffects.h>
 
+#include <libsolutil/CommonData.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
 void UnusedPruner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	UnusedPruner::runUntilStabilisedOnFullAST(_context.dialect, _ast, _context.reservedIdentifiers);
+	map<YulString, SideEffects> functionSideEffects = AnalysisCache::sideEffects(_context, _ast);
+	bool allowMSizeOptimization = !AnalysisCache::containsMSize(_context, _ast);
+	runUntilStabilised(
+		_context.dialect,
+		_ast,
+		allowMSizeOptimization,
+		&functionSideEffects,
+		_context.reservedIdentifiers
+	);
 	FunctionGrouper::run(_context, _ast);
 }
 
@@ -70,66 +81,130 @@ UnusedPruner::UnusedPruner(
 		++m_references[f];
 }
 
+namespace
+{
+
+/// Removes empty blocks from all blocks, from the outermost to the innermost.
+class EmptyBlockRemover: public ASTModifier
+{
+public:
+	using ASTModifier::operator();
+	void operator()(Block& _block) override
+	{
+		removeEmptyBlocks(_block);
+		ASTModifier::operator()(_block);
+	}
+};
+
+}
+
 void UnusedPruner::operator()(Block& _block)
 {
 	for (auto&& statement: _block.statements)
-		if (holds_alternative<FunctionDefinition>(statement))
+		prune(statement);
+
+	removeEmptyBlocks(_block);
+
+	for (auto&& statement: _block.statements)
+		if (auto* funDef = get_if<FunctionDefinition>(&statement))
+			m_declarations[funDef->name] = &statement;
+		else if (auto* varDecl = get_if<VariableDeclaration>(&statement))
+			for (TypedName const& variable: varDecl->variables)
+				m_declarations[variable.name] = &statement;
+
+	ASTModifier::operator()(_block);
+}
+
+void UnusedPruner::prune(Statement& _statement)
+{
+	if (holds_alternative<FunctionDefinition>(_statement))
+	{
+		FunctionDefinition& funDef = std::get<FunctionDefinition>(_statement);
+		if (!used(funDef.name))
 		{
-			FunctionDefinition& funDef = std::get<FunctionDefinition>(statement);
-			if (!used(funDef.name))
-			{
-				subtractReferences(ReferencesCounter::countReferences(funDef.body));
-				statement = Block{std::move(funDef.debugData), {}};
-			}
+			// The visited declarations inside the body are destroyed along with it.
+			for (YulString name: NameCollector{funDef}.names())
+				m_declarations.erase(name);
+			subtractReferences(ReferencesCounter::countReferences(funDef.body));
+			_statement = Block{std::move(funDef.debugData), {}};
 		}
-		else if (holds_alternative<VariableDeclaration>(statement))
+	}
+	else if (holds_alternative<VariableDeclaration>(_statement))
+	{
+		VariableDeclaration& varDecl = std::get<VariableDeclaration>(_statement);
+		// Multi-variable declarations are special. We can only remove it
+		// if all variables are unused and the right-hand-side is either
+		// movable or it returns a single value. In the latter case, we
+		// replace `let a := f()` by `pop(f())` (in pure Yul, this will be
+		// `drop(f())`).
+		if (std::none_of(
+			varDecl.variables.begin(),
+			varDecl.variables.end(),
+			[&](TypedName const& _typedName) { return used(_typedName.name); }
+		))
 		{
-			VariableDeclaration& varDecl = std::get<VariableDeclaration>(statement);
-			// Multi-variable declarations are special. We can only remove it
-			// if all variables are unused and the right-hand-side is either
-			// movable or it returns a single value. In the latter case, we
-			// replace `let a := f()` by `pop(f())` (in pure Yul, this will be
-			// `drop(f())`).
-			if (std::none_of(
-				varDecl.variables.begin(),
-				varDecl.variables.end(),
-				[&](TypedName const& _typedName) { return used(_typedName.name); }
-			))
+			auto forgetDeclaration = [&]() {
+				for (TypedName const& variable: varDecl.variables)
+					m_declarations.erase(variable.name);
+			};
+			if (!varDecl.value)
 			{
-				if (!varDecl.value)
-					statement = Block{std::move(varDecl.debugData), {}};
-				else if (
-					SideEffectsCollector(m_dialect, *varDecl.value, m_functionSideEffects).
-					canBeRemoved(m_allowMSizeOptimization)
-				)
-				{
-					subtractReferences(ReferencesCounter::countReferences(*varDecl.value));
-					statement = Block{std::move(varDecl.debugData), {}};
-				}
-				else if (varDecl.variables.size() == 1 && m_dialect.discardFunction(varDecl.variables.front().type))
-					statement = ExpressionStatement{varDecl.debugData, FunctionCall{
-						varDecl.debugData,
-						{varDecl.debugData, m_dialect.discardFunction(varDecl.variables.front().type)->name},
-						{*std::move(varDecl.value)}
-					}};
+				forgetDeclaration();
+				_statement = Block{std::move(varDecl.debugData), {}};
 			}
-		}
-		else if (holds_alternative<ExpressionStatement>(statement))
-		{
-			ExpressionStatement& exprStmt = std::get<ExpressionStatement>(statement);
-			if (
-				SideEffectsCollector(m_dialect, exprStmt.expression, m_functionSideEffects).
+			else if (
+				SideEffectsCollector(m_dialect, *varDecl.value, m_functionSideEffects).
 				canBeRemoved(m_allowMSizeOptimization)
 			)
 			{
-				subtractReferences(ReferencesCounter::countReferences(exprStmt.expression));
-				statement = Block{std::move(exprStmt.debugData), {}};
+				forgetDeclaration();
+				subtractReferences(ReferencesCounter::countReferences(*varDecl.value));
+				_statement = Block{std::move(varDecl.debugData), {}};
+			}
+			else if (varDecl.variables.size() == 1 && m_dialect.discardFunction(varDecl.variables.front().type))
+			{
+				forgetDeclaration();
+				_statement = ExpressionStatement{varDecl.debugData, FunctionCall{
+					varDecl.debugData,
+					{varDecl.debugData, m_dialect.discardFunction(varDecl.variables.front().type)->name},
+					{*std::move(varDecl.value)}
+				}};
 			}
 		}
+	}
+	else if (holds_alternative<ExpressionStatement>(_statement))
+	{
+		ExpressionStatement& exprStmt = std::get<ExpressionStatement>(_statement);
+		if (
+			SideEffectsCollector(m_dialect, exprStmt.expression, m_functionSideEffects).
+			canBeRemoved(m_allowMSizeOptimization)
+		)
+		{
+			subtractReferences(ReferencesCounter::countReferences(exprStmt.expression));
+			_statement = Block{std::move(exprStmt.debugData), {}};
+		}
+	}
+}
 
-	removeEmptyBlocks(_block);
+void UnusedPruner::pruneUnusedDeclarations()
+{
+	while (!m_unusedNames.empty())
+	{
+		YulString name = m_unusedNames.back();
+		m_unusedNames.pop_back();
+		// Declarations that were not visited yet are handled when they are visited.
+		if (Statement* const* declaration = util::valueOrNullptr(m_declarations, name))
+			prune(**declaration);
+	}
+}
 
-	ASTModifier::operator()(_block);
+template <typename Node>
+void UnusedPruner::finalize(Node& _node)
+{
+	pruneUnusedDeclarations();
+	// Statements removed while pruning the unused declarations leave empty blocks behind.
+	if (m_shouldRunAgain)
+		EmptyBlockRemover{}(_node);
 }
 
 void UnusedPruner::runUntilStabilised(
@@ -140,15 +215,9 @@ void UnusedPruner::runUntilStabilised(
 	set<YulString> const& _externallyUsedFunctions
 )
 {
-	while (true)
-	{
-		UnusedPruner pruner(
-			_dialect, _ast, _allowMSizeOptimization, _functionSideEffects,
-							_externallyUsedFunctions);
-		pruner(_ast);
-		if (!pruner.shouldRunAgain())
-			return;
-	}
+	UnusedPruner pruner(_dialect, _ast, _allowMSizeOptimization, _functionSideEffects, _externallyUsedFunctions);
+	pruner(_ast);
+	pruner.finalize(_ast);
 }
 
 void UnusedPruner::runUntilStabilisedOnFullAST(
@@ -170,13 +239,9 @@ void UnusedPruner::runUntilStabilised(
 	set<YulString> const& _externallyUsedFunctions
 )
 {
-	while (true)
-	{
-		UnusedPruner pruner(_dialect, _function, _allowMSizeOptimization, _externallyUsedFunctions);
-		pruner(_function);
-		if (!pruner.shouldRunAgain())
-			return;
-	}
+	UnusedPruner pruner(_dialect, _function, _allowMSizeOptimization, _externallyUsedFunctions);
+	pruner(_function);
+	pruner.finalize(_function);
 }
 
 bool UnusedPruner::used(YulString _name) const
@@ -191,6 +256,8 @@ void UnusedPruner::subtractReferences(map<YulString, size_t> const& _subtrahend)
 		assertThrow(m_references.count(ref.first), OptimizerException, "");
 		assertThrow(m_references.at(ref.first) >= ref.second, OptimizerException, "");
 		m_references[ref.first] -= ref.second;
+		if (m_references[ref.first] == 0)
+			m_unusedNames.push_back(ref.first);
 		m_shouldRunAgain = true;
 	}
 }
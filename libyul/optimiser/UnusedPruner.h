@@ -44,6 +44,10 @@ struct SideEffects;
  *
  * Note that this does not remove circular references.
  *
+ * Reference counts are maintained during the removal: Once the last reference to a
+ * name is removed, its already visited declaration is examined again, so that a single
+ * traversal reaches the fixpoint.
+ *
  * Prerequisite: Disambiguator
  */
 class UnusedPruner: public ASTModifier
@@ -114,6 +118,15 @@ private:
 		std::set<YulString> const& _externallyUsedFunctions = {}
 	);
 
+	/// Removes or simplifies @a _statement if the names it declares are unused.
+	void prune(Statement& _statement);
+	/// Examines the visited declarations of names that became unused again until
+	/// no more names become unused.
+	void pruneUnusedDeclarations();
+	/// Removes the empty blocks left behind by pruneUnusedDeclarations, if anything changed.
+	template <typename Node>
+	void finalize(Node& _node);
+
 	bool used(YulString _name) const;
 	void subtractReferences(std::map<YulString, size_t> const& _subtrahend);
 
@@ -122,6 +135,12 @@ private:
 	std::map<YulString, SideEffects> const* m_functionSideEffects = nullptr;
 	bool m_shouldRunAgain = false;
 	std::map<YulString, size_t> m_references;
+	/// Statements visited and kept so far that declare a variable or function, by declared name.
+	/// They are recorded after the empty blocks have been removed from their block,
+	/// so they do not move anymore.
+	std::map<YulString, Statement*> m_declarations;
+	/// Names whose reference count dropped to zero.
+	std::vector<YulString> m_unusedNames;
 };
 
 }
@@ -192,6 +192,7 @@ def examine_id_coverage(top_dir, source_id_to_file_names, new_ids_only=False):
     # white list of ids which are not covered by tests
     white_ids = {
         "9804", # Tested in test/libyul/ObjectParser.cpp.
+        "2758", # Tested in test/cmdlineTests/model_checker_external_solver_not_found.
         "1544",
         "1749",
         "2674",
@@ -202,7 +203,9 @@ def examine_id_coverage(top_dir, source_id_to_file_names, new_ids_only=False):
         "4591", # "There are more than 256 warnings. Ignoring the rest."
                 # Due to 3805, the warning lists look different for different compiler builds.
         "1834", # Unimplemented feature error, as we do not test it anymore via cmdLineTests
-        "5430"  # basefee being used in inline assembly for EVMVersion < london
+        "5430", # basefee being used in inline assembly for EVMVersion < london
+        "4280", # Solving times of the model checker, which are not deterministic.
+        "6917"
     }
     assert len(test_ids & white_ids) == 0, "The sets are not supposed to intersect"
     test_ids |= white_ids
@@ -30,12 +30,15 @@
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
+#include <libsolidity/interface/BytecodeCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/StorageLayout.h>
+#include <libsolidity/lsp/LanguageServer.h>
+#include <libsolidity/lsp/Transport.h>
 
 #include <libyul/AssemblyStack.h>
 
@@ -52,9 +55,14 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/MemoryMappedFile.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Timing.h>
 
 #include <algorithm>
+#include <iomanip>
 #include <memory>
+#include <mutex>
 
 #include <range/v3/view/map.hpp>
 
@@ -237,7 +245,8 @@ void CommandLineInterface::handleEwasm(string const& _contractName)
 		createFile(m_compiler->filesystemFriendlyName(_contractName) + ".wast", m_compiler->ewasm(_contractName));
 		createFile(
 			m_compiler->filesystemFriendlyName(_contractName) + ".wasm",
-			asString(m_compiler->ewasmObject(_contractName).bytecode)
+			asString(m_compiler->ewasmObject(_contractName).bytecode),
+			/* _binary */ true
 		);
 	}
 	else
@@ -360,6 +369,20 @@ void CommandLineInterface::handleNatspec(bool _natspecDev, string const& _contra
 	}
 }
 
+void CommandLineInterface::handleYulOptimizerStatistics(util::TimingCollector const& _stepTimings)
+{
+	m_hasOutput = true;
+	sout() << endl << "Yul optimizer step statistics:" << endl;
+	sout() << left << setw(32) << "Step" << right << setw(10) << "Runs" << setw(14) << "Time (us)";
+	sout() << setw(10) << "Changes" << setw(12) << "Size delta" << endl;
+	for (auto const& [step, entry]: _stepTimings.entries())
+	{
+		sout() << left << setw(32) << step << right << setw(10) << entry.count;
+		sout() << setw(14) << chrono::duration_cast<chrono::microseconds>(entry.wallTime).count();
+		sout() << setw(10) << entry.changes << setw(12) << entry.sizeDelta << endl;
+	}
+}
+
 void CommandLineInterface::handleGasEstimation(string const& _contract)
 {
 	solAssert(m_options.input.mode == InputMode::Compiler || m_options.input.mode == InputMode::CompilerWithASTImport, "");
@@ -454,6 +477,10 @@ bool CommandLineInterface::readInputFiles()
 		return false;
 	}
 
+	if (m_options.input.mode == InputMode::Server || m_options.input.mode == InputMode::LanguageServer)
+		// The requests are read one by one while serving them.
+		return true;
+
 	for (boost::filesystem::path const& infile: m_options.input.paths)
 	{
 		if (!boost::filesystem::exists(infile))
@@ -482,6 +509,18 @@ bool CommandLineInterface::readInputFiles()
 			continue;
 		}
 
+		if (m_options.input.memoryMapSources)
+		{
+			solAssert(m_options.input.mode == InputMode::Compiler, "");
+			// NOTE: we ignore the FileNotFound exception as we manually check above
+			if (shared_ptr<MemoryMappedFile const> file = MemoryMappedFile::map(infile))
+			{
+				m_fileReader.setMappedSource(infile, move(file));
+				m_fileReader.allowDirectory(boost::filesystem::canonical(infile).remove_filename());
+				continue;
+			}
+		}
+
 		// NOTE: we ignore the FileNotFound exception as we manually check above
 		string fileContent = readFileAsString(infile);
 		if (m_options.input.mode == InputMode::StandardJson)
@@ -507,7 +546,7 @@ bool CommandLineInterface::readInputFiles()
 			m_fileReader.setStdin(readUntilEnd(m_sin));
 	}
 
-	if (m_fileReader.sourceCodes().empty() && !m_standardJsonInput.has_value())
+	if (m_fileReader.sourceUnitNames().empty() && !m_standardJsonInput.has_value())
 	{
 		serr() << "All specified input files either do not exist or are not regular files." << endl;
 		return false;
@@ -546,7 +585,32 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 	return sourceJsons;
 }
 
-void CommandLineInterface::createFile(string const& _fileName, string const& _data)
+void CommandLineInterface::writeProfile(Json::Value const& _profile)
+{
+	string const pathName = m_options.output.profileJson.string();
+	ofstream outFile(pathName);
+	outFile << jsonPrettyPrint(_profile) << endl;
+	if (!outFile)
+	{
+		serr() << "Could not write to file \"" << pathName << "\"." << endl;
+		m_outputFailed = true;
+	}
+}
+
+void CommandLineInterface::writeTrace()
+{
+	util::TraceRecorder::disable();
+	string const pathName = m_options.output.traceFile.string();
+	ofstream outFile(pathName);
+	util::TraceRecorder::print(outFile);
+	if (!outFile)
+	{
+		serr() << "Could not write to file \"" << pathName << "\"." << endl;
+		m_outputFailed = true;
+	}
+}
+
+void CommandLineInterface::createFile(string const& _fileName, string const& _data, bool _binary)
 {
 	namespace fs = boost::filesystem;
 
@@ -564,7 +628,7 @@ void CommandLineInterface::createFile(string const& _fileName, string const& _da
 		m_outputFailed = true;
 		return;
 	}
-	ofstream outFile(pathName);
+	ofstream outFile(pathName, _binary ? ios::out | ios::binary : ios::out);
 	outFile << _data;
 	if (!outFile)
 	{
@@ -603,6 +667,14 @@ bool CommandLineInterface::parseArguments(int _argc, char const* const* _argv)
 
 bool CommandLineInterface::processInput()
 {
+	// The trace is also written if the compilation fails.
+	if (!m_options.output.traceFile.empty())
+		util::TraceRecorder::enable();
+	ScopeGuard writeTraceFile([&]() {
+		if (!m_options.output.traceFile.empty())
+			writeTrace();
+	});
+
 	switch (m_options.input.mode)
 	{
 	case InputMode::Help:
@@ -619,10 +691,23 @@ bool CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value(), "");
 
 		StandardCompiler compiler(m_fileReader.reader(), m_options.formatting.json);
-		sout() << compiler.compile(move(m_standardJsonInput.value())) << endl;
+		bool const outputWritten = compiler.compile(m_standardJsonInput.value(), sout());
+		sout() << endl;
 		m_standardJsonInput.reset();
+		if (!outputWritten)
+		{
+			serr() << "Error writing output JSON." << endl;
+			return false;
+		}
 		break;
 	}
+	case InputMode::Server:
+		serveStandardJson();
+		break;
+	case InputMode::LanguageServer:
+		if (!serveLSP())
+			return false;
+		break;
 	case InputMode::Assembler:
 		if (!assemble(m_options.assembly.inputLanguage, m_options.assembly.targetMachine))
 			return false;
@@ -634,9 +719,27 @@ bool CommandLineInterface::processInput()
 		break;
 	case InputMode::Compiler:
 	case InputMode::CompilerWithASTImport:
-		if (!compile())
-			return false;
-		outputCompilationResults();
+		if (m_options.output.compileSeparately)
+		{
+			if (!compileSeparately())
+				return false;
+		}
+		else
+		{
+			if (!compile())
+				return false;
+			outputCompilationResults();
+			if (!m_options.output.profileJson.empty())
+				writeProfile(m_compiler->timingJSON());
+		}
+
+		if (!m_hasOutput)
+		{
+			if (!m_options.output.dir.empty())
+				sout() << "Compiler run successful. Artifact(s) can be found in directory " << m_options.output.dir << "." << endl;
+			else
+				serr() << "Compiler run successful, no output requested." << endl;
+		}
 	}
 
 	return !m_outputFailed;
@@ -655,6 +758,41 @@ void CommandLineInterface::printLicense()
 	sout() << licenseText << endl;
 }
 
+void CommandLineInterface::serveStandardJson()
+{
+	solAssert(m_options.input.mode == InputMode::Server, "");
+
+	// Keep the interned Yul identifiers and the dialects built from them across requests,
+	// but do not let them grow without bounds.
+	size_t const yulStringMemoryLimit = 256 * 1024 * 1024;
+	// Sources given with their hash can be given by the hash alone in later requests and are not
+	// parsed and analysed again if they did not change.
+	size_t const sourceCacheMemoryLimit = 256 * 1024 * 1024;
+
+	// Every result has to fit on a single line.
+	StandardCompiler compiler(m_fileReader.reader(), JsonFormat{JsonFormat::Compact});
+	compiler.setYulStringMemoryLimit(yulStringMemoryLimit);
+	compiler.enableSourceCache(sourceCacheMemoryLimit);
+	string request;
+	while (getline(m_sin, request))
+	{
+		if (request.find_first_not_of(" \t\r") == string::npos)
+			continue;
+
+		// Files imported by an earlier request have to be read again, since they might have changed.
+		m_fileReader.setSources({});
+		sout() << compiler.compile(request) << endl;
+	}
+}
+
+bool CommandLineInterface::serveLSP()
+{
+	solAssert(m_options.input.mode == InputMode::LanguageServer, "");
+
+	lsp::IOStreamTransport transport(m_sin, sout());
+	return lsp::LanguageServer(transport).run();
+}
+
 bool CommandLineInterface::compile()
 {
 	solAssert(m_options.input.mode == InputMode::Compiler || m_options.input.mode == InputMode::CompilerWithASTImport, "");
@@ -673,8 +811,13 @@ bool CommandLineInterface::compile()
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.experimentalViaIR);
+		m_compiler->setParallelism(m_options.output.parallelism);
+		// Gas estimates need the assembly items, which are not stored in the cache.
+		if (!m_options.output.cacheDir.empty() && !m_options.compiler.estimateGas)
+			m_compiler->setBytecodeCache(make_shared<BytecodeCache>(m_options.output.cacheDir));
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
+		m_compiler->enableTimingCollection(m_options.optimizer.yulStepStatistics || !m_options.output.profileJson.empty());
 		if (m_options.output.debugInfoSelection.has_value())
 			m_compiler->selectDebugInfo(m_options.output.debugInfoSelection.value());
 		// TODO: Perhaps we should not compile unless requested
@@ -701,6 +844,21 @@ bool CommandLineInterface::compile()
 				m_options.compiler.combinedJsonRequests->funDebugRuntime
 			))
 		);
+		m_compiler->enableCreationCodeOptimisation(
+			m_options.compiler.estimateGas ||
+			m_options.compiler.outputs.asm_ ||
+			m_options.compiler.outputs.asmJson ||
+			m_options.compiler.outputs.opcodes ||
+			m_options.compiler.outputs.binary ||
+			(m_options.compiler.combinedJsonRequests && (
+				m_options.compiler.combinedJsonRequests->binary ||
+				m_options.compiler.combinedJsonRequests->opcodes ||
+				m_options.compiler.combinedJsonRequests->asm_ ||
+				m_options.compiler.combinedJsonRequests->generatedSources ||
+				m_options.compiler.combinedJsonRequests->srcMap ||
+				m_options.compiler.combinedJsonRequests->funDebug
+			))
+		);
 
 		m_compiler->setOptimiserSettings(m_options.optimiserSettings());
 
@@ -724,7 +882,7 @@ bool CommandLineInterface::compile()
 		}
 		else
 		{
-			m_compiler->setSources(m_fileReader.sourceCodes());
+			m_compiler->setSources(m_fileReader.sourceCodes(), m_fileReader.mappedSourceCodes());
 			m_compiler->setParserErrorRecovery(m_options.input.errorRecovery);
 		}
 
@@ -768,6 +926,16 @@ void CommandLineInterface::handleCombinedJSON()
 	if (!m_options.compiler.combinedJsonRequests.has_value())
 		return;
 
+	// The ASTs and the largest outputs of the contracts are only generated while printing, so that
+	// they do not have to be kept in memory at the same time.
+	vector<function<void(ostream&, string const&)>> deferredOutputs;
+	auto deferredString = [&](function<string()> _generate) {
+		deferredOutputs.emplace_back([generate = move(_generate)](ostream& _stream, string const&) {
+			jsonStreamPrintString(_stream, generate());
+		});
+		return jsonStringPlaceholder(deferredOutputs.size() - 1);
+	};
+
 	Json::Value output(Json::objectValue);
 
 	output[g_strVersion] = frontend::VersionString;
@@ -783,11 +951,15 @@ void CommandLineInterface::handleCombinedJSON()
 		if (m_options.compiler.combinedJsonRequests->metadata)
 			contractData["metadata"] = m_compiler->metadata(contractName);
 		if (m_options.compiler.combinedJsonRequests->binary && m_compiler->compilationSuccessful())
-			contractData[g_strBinary] = m_compiler->object(contractName).toHex();
+			contractData[g_strBinary] = deferredString([this, contractName]() { return m_compiler->object(contractName).toHex(); });
 		if (m_options.compiler.combinedJsonRequests->binaryRuntime && m_compiler->compilationSuccessful())
-			contractData[g_strBinaryRuntime] = m_compiler->runtimeObject(contractName).toHex();
+			contractData[g_strBinaryRuntime] = deferredString([this, contractName]() {
+				return m_compiler->runtimeObject(contractName).toHex();
+			});
 		if (m_options.compiler.combinedJsonRequests->opcodes && m_compiler->compilationSuccessful())
-			contractData[g_strOpcodes] = evmasm::disassemble(m_compiler->object(contractName).bytecode);
+			contractData[g_strOpcodes] = deferredString([this, contractName]() {
+				return evmasm::disassemble(m_compiler->object(contractName).bytecode);
+			});
 		if (m_options.compiler.combinedJsonRequests->asm_ && m_compiler->compilationSuccessful())
 			contractData[g_strAsm] = m_compiler->assemblyJSON(contractName);
 		if (m_options.compiler.combinedJsonRequests->storageLayout && m_compiler->compilationSuccessful())
@@ -838,19 +1010,37 @@ void CommandLineInterface::handleCombinedJSON()
 	if (m_options.compiler.combinedJsonRequests->ast)
 	{
 		output[g_strSources] = Json::Value(Json::objectValue);
-		for (auto const& sourceCode: m_fileReader.sourceCodes())
+		for (auto const& sourceUnitName: m_fileReader.sourceUnitNames())
 		{
-			ASTJsonConverter converter(m_compiler->state(), m_compiler->sourceIndices());
-			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
-			output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			output[g_strSources][sourceUnitName] = Json::Value(Json::objectValue);
+			output[g_strSources][sourceUnitName]["AST"] = jsonPlaceholder(deferredOutputs.size());
+			deferredOutputs.emplace_back([this, ast = &m_compiler->ast(sourceUnitName)](ostream& _stream, string const& _indentation) {
+				ASTJsonConverter(m_compiler->state(), m_compiler->sourceIndices()).print(_stream, *ast, m_options.formatting.json, _indentation);
+			});
 		}
 	}
 
-	string json = jsonPrint(removeNullMembers(std::move(output)), m_options.formatting.json);
+	auto printOutput = [&](ostream& _output) {
+		jsonStreamPrint(
+			_output,
+			removeNullMembers(std::move(output)),
+			m_options.formatting.json,
+			[&](ostream& _stream, size_t _index, string const& _indentation) {
+				deferredOutputs.at(_index)(_stream, _indentation);
+			}
+		);
+	};
 	if (!m_options.output.dir.empty())
-		createJson("combined", json);
+	{
+		ostringstream jsonStream;
+		printOutput(jsonStream);
+		createJson("combined", jsonStream.str());
+	}
 	else
-		sout() << json << endl;
+	{
+		printOutput(sout());
+		sout() << endl;
+	}
 }
 
 void CommandLineInterface::handleAst()
@@ -861,91 +1051,180 @@ void CommandLineInterface::handleAst()
 		return;
 
 	vector<ASTNode const*> asts;
-	for (auto const& sourceCode: m_fileReader.sourceCodes())
-		asts.push_back(&m_compiler->ast(sourceCode.first));
+	for (auto const& sourceUnitName: m_fileReader.sourceUnitNames())
+		asts.push_back(&m_compiler->ast(sourceUnitName));
 
 	if (!m_options.output.dir.empty())
 	{
-		for (auto const& sourceCode: m_fileReader.sourceCodes())
+		for (auto const& sourceUnitName: m_fileReader.sourceUnitNames())
 		{
 			stringstream data;
 			string postfix = "";
-			ASTJsonConverter(m_compiler->state(), m_compiler->sourceIndices()).print(data, m_compiler->ast(sourceCode.first));
+			ASTJsonConverter(m_compiler->state(), m_compiler->sourceIndices()).print(data, m_compiler->ast(sourceUnitName));
 			postfix += "_json";
-			boost::filesystem::path path(sourceCode.first);
+			boost::filesystem::path path(sourceUnitName);
 			createFile(path.filename().string() + postfix + ".ast", data.str());
 		}
 	}
 	else
 	{
 		sout() << "JSON AST (compact format):" << endl << endl;
-		for (auto const& sourceCode: m_fileReader.sourceCodes())
+		for (auto const& sourceUnitName: m_fileReader.sourceUnitNames())
 		{
-			sout() << endl << "======= " << sourceCode.first << " =======" << endl;
-			ASTJsonConverter(m_compiler->state(), m_compiler->sourceIndices()).print(sout(), m_compiler->ast(sourceCode.first));
+			sout() << endl << "======= " << sourceUnitName << " =======" << endl;
+			ASTJsonConverter(m_compiler->state(), m_compiler->sourceIndices()).print(sout(), m_compiler->ast(sourceUnitName));
 		}
 	}
 }
 
+bool CommandLineInterface::compileSeparately()
+{
+	solAssert(m_options.input.mode == InputMode::Compiler, "");
+
+	struct Unit
+	{
+		ostringstream sout;
+		ostringstream serr;
+		unique_ptr<CommandLineInterface> cli;
+		bool compiled = false;
+		bool successful = false;
+	};
+
+	// The compilations are already run in parallel.
+	CommandLineOptions unitOptions = m_options;
+	unitOptions.output.parallelism = 1;
+	unitOptions.output.compileSeparately = false;
+
+	set<string> const sourceUnitNames = m_fileReader.sourceUnitNames();
+	vector<string> const names(sourceUnitNames.begin(), sourceUnitNames.end());
+	vector<Unit> units(names.size());
+	mutex outputMutex;
+	size_t nextOutput = 0;
+	bool successful = true;
+	Json::Value profile(Json::objectValue);
+
+	parallelFor(units.size(), m_options.output.parallelism, [&](size_t _index) {
+		Unit& unit = units[_index];
+		unit.cli = make_unique<CommandLineInterface>(m_sin, unit.sout, unit.serr, unitOptions);
+		FileReader& fileReader = unit.cli->m_fileReader;
+		fileReader = FileReader(m_fileReader.basePath(), m_fileReader.includePaths(), m_fileReader.allowedDirectories());
+		if (auto mapped = m_fileReader.mappedSourceCodes().find(names[_index]); mapped != m_fileReader.mappedSourceCodes().end())
+			fileReader.setSources({{names[_index], string(mapped->second->contents())}});
+		else
+			fileReader.setSources({{names[_index], m_fileReader.sourceCode(names[_index])}});
+		fileReader.setSharedSources(&m_fileReader);
+		unit.successful = unit.cli->compile();
+
+		// The outputs are generated in order, so that the same files are written if several
+		// compilations output a contract with the same name.
+		lock_guard<mutex> lock(outputMutex);
+		unit.compiled = true;
+		for (; nextOutput < units.size() && units[nextOutput].compiled; ++nextOutput)
+		{
+			Unit& next = units[nextOutput];
+			if (next.successful)
+			{
+				next.cli->outputCompilationResults();
+				if (!m_options.output.profileJson.empty())
+					profile["sourceUnits"][names[nextOutput]] = next.cli->m_compiler->timingJSON();
+			}
+			successful = successful && next.successful && !next.cli->m_outputFailed;
+			m_hasOutput = m_hasOutput || next.cli->m_hasOutput;
+			next.cli.reset();
+
+			serr(false) << next.serr.str();
+			sout(false) << next.sout.str();
+			next.serr = ostringstream();
+			next.sout = ostringstream();
+		}
+	});
+
+	if (!m_options.output.profileJson.empty())
+		writeProfile(profile);
+	return successful;
+}
+
 bool CommandLineInterface::link()
 {
 	solAssert(m_options.input.mode == InputMode::Linker, "");
 
-	// Map from how the libraries will be named inside the bytecode to their addresses.
-	map<string, h160> librariesReplacements;
-	int const placeholderSize = 40; // 20 bytes or 40 hex characters
+	// Map from how the libraries will be named inside the bytecode to the hex of their addresses.
+	map<string, string, less<>> librariesReplacements;
+	size_t const placeholderSize = 40; // 20 bytes or 40 hex characters
+	vector<string> libraryHints;
 	for (auto const& library: m_options.linker.libraries)
 	{
 		string const& name = library.first;
+		string const address = toHex(library.second.asBytes());
 		// Library placeholders are 40 hex digits (20 bytes) that start and end with '__'.
 		// This leaves 36 characters for the library identifier. The identifier used to
 		// be just the cropped or '_'-padded library name, but this changed to
 		// the cropped hex representation of the hash of the library name.
 		// We support both ways of linking here.
-		librariesReplacements["__" + evmasm::LinkerObject::libraryPlaceholder(name) + "__"] = library.second;
+		librariesReplacements["__" + evmasm::LinkerObject::libraryPlaceholder(name) + "__"] = address;
 
 		string replacement = "__";
 		for (size_t i = 0; i < placeholderSize - 4; ++i)
 			replacement.push_back(i < name.size() ? name[i] : '_');
 		replacement += "__";
-		librariesReplacements[replacement] = library.second;
+		librariesReplacements[replacement] = address;
+
+		libraryHints.emplace_back("\n" + libraryPlaceholderHint(name));
 	}
 
 	FileReader::StringMap sourceCodes = m_fileReader.sourceCodes();
+	vector<pair<string const, string>*> files;
 	for (auto& src: sourceCodes)
-	{
-		auto end = src.second.end();
-		for (auto it = src.second.begin(); it != end;)
+		files.push_back(&src);
+
+	auto linkFile = [&](string const& _fileName, string& _code, ostream& _messages) {
+		for (size_t position = _code.find('_'); position != string::npos; position = _code.find('_', position + placeholderSize))
 		{
-			while (it != end && *it != '_') ++it;
-			if (it == end) break;
 			if (
-				end - it < placeholderSize ||
-				*(it + 1) != '_' ||
-				*(it + placeholderSize - 2) != '_' ||
-				*(it + placeholderSize - 1) != '_'
+				_code.size() - position < placeholderSize ||
+				_code[position + 1] != '_' ||
+				_code[position + placeholderSize - 2] != '_' ||
+				_code[position + placeholderSize - 1] != '_'
 			)
 			{
-				serr() << "Error in binary object file " << src.first << " at position " << (it - src.second.begin()) << endl;
-				serr() << '"' << string(it, it + min(placeholderSize, static_cast<int>(end - it))) << "\" is not a valid link reference." << endl;
+				_messages << "Error in binary object file " << _fileName << " at position " << position << endl;
+				_messages << '"' << _code.substr(position, placeholderSize) << "\" is not a valid link reference." << endl;
 				return false;
 			}
 
-			string foundPlaceholder(it, it + placeholderSize);
-			if (librariesReplacements.count(foundPlaceholder))
-			{
-				string hexStr(toHex(librariesReplacements.at(foundPlaceholder).asBytes()));
-				copy(hexStr.begin(), hexStr.end(), it);
-			}
+			string_view const foundPlaceholder(_code.data() + position, placeholderSize);
+			if (auto replacement = librariesReplacements.find(foundPlaceholder); replacement != librariesReplacements.end())
+				_code.replace(position, placeholderSize, replacement->second);
 			else
-				serr() << "Reference \"" << foundPlaceholder << "\" in file \"" << src.first << "\" still unresolved." << endl;
-			it += placeholderSize;
+				_messages << "Reference \"" << foundPlaceholder << "\" in file \"" << _fileName << "\" still unresolved." << endl;
 		}
 		// Remove hints for resolved libraries.
-		for (auto const& library: m_options.linker.libraries)
-			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
-		while (!src.second.empty() && *prev(src.second.end()) == '\n')
-			src.second.resize(src.second.size() - 1);
+		if (_code.find("\n// ") != string::npos)
+			for (string const& hint: libraryHints)
+				boost::algorithm::erase_all(_code, hint);
+		while (!_code.empty() && _code.back() == '\n')
+			_code.pop_back();
+		return true;
+	};
+
+	struct LinkResult
+	{
+		bool success = false;
+		string messages;
+	};
+	// The files are linked independently of each other, but the messages are printed in their order.
+	vector<LinkResult> results(files.size());
+	parallelFor(files.size(), m_options.output.parallelism, [&](size_t _index) {
+		ostringstream messages;
+		results[_index].success = linkFile(files[_index]->first, files[_index]->second, messages);
+		results[_index].messages = messages.str();
+	});
+
+	for (LinkResult const& result: results)
+	{
+		serr() << result.messages;
+		if (!result.success)
+			return false;
 	}
 	m_fileReader.setSources(move(sourceCodes));
 
@@ -996,6 +1275,7 @@ bool CommandLineInterface::assemble(yul::AssemblyStack::Language _language, yul:
 
 	bool successful = true;
 	map<string, yul::AssemblyStack> assemblyStacks;
+	util::TimingCollector optimiserStepTimings;
 	for (auto const& src: m_fileReader.sourceCodes())
 	{
 		// --no-optimize-yul option is not accepted in assembly mode.
@@ -1009,6 +1289,9 @@ bool CommandLineInterface::assemble(yul::AssemblyStack::Language _language, yul:
 				m_options.output.debugInfoSelection.value() :
 				DebugInfoSelection::Default()
 		);
+		stack.setParallelism(m_options.output.parallelism);
+		if (m_options.optimizer.yulStepStatistics)
+			stack.setOptimiserStepTimings(&optimiserStepTimings);
 
 		if (!stack.parseAndAnalyze(src.first, src.second))
 			successful = false;
@@ -1090,6 +1373,9 @@ bool CommandLineInterface::assemble(yul::AssemblyStack::Language _language, yul:
 		}
 	}
 
+	if (m_options.optimizer.yulStepStatistics)
+		handleYulOptimizerStatistics(optimiserStepTimings);
+
 	return true;
 }
 
@@ -1111,6 +1397,17 @@ void CommandLineInterface::outputCompilationResults()
 		return;
 	}
 
+	// The assembly printer needs the text of memory-mapped sources as well.
+	FileReader::StringMap allSourceCodes;
+	if (m_options.compiler.outputs.asm_ && !m_fileReader.mappedSourceCodes().empty())
+	{
+		allSourceCodes = m_fileReader.sourceCodes();
+		for (auto const& [sourceUnitName, file]: m_fileReader.mappedSourceCodes())
+			allSourceCodes[sourceUnitName] = string(file->contents());
+	}
+	FileReader::StringMap const& assemblySourceCodes =
+		m_fileReader.mappedSourceCodes().empty() ? m_fileReader.sourceCodes() : allSourceCodes;
+
 	vector<string> contracts = m_compiler->contractNames();
 	for (string const& contract: contracts)
 	{
@@ -1124,7 +1421,7 @@ void CommandLineInterface::outputCompilationResults()
 			if (m_options.compiler.outputs.asmJson)
 				ret = jsonPrettyPrint(removeNullMembers(m_compiler->assemblyJSON(contract)));
 			else
-				ret = m_compiler->assemblyString(contract, m_fileReader.sourceCodes());
+				ret = m_compiler->assemblyString(contract, assemblySourceCodes);
 
 			if (!m_options.output.dir.empty())
 			{
@@ -1151,13 +1448,8 @@ void CommandLineInterface::outputCompilationResults()
 		handleNatspec(false, contract);
 	} // end of contracts iteration
 
-	if (!m_hasOutput)
-	{
-		if (!m_options.output.dir.empty())
-			sout() << "Compiler run successful. Artifact(s) can be found in directory " << m_options.output.dir << "." << endl;
-		else
-			serr() << "Compiler run successful, no output requested." << endl;
-	}
+	if (m_options.optimizer.yulStepStatistics && m_compiler->optimiserStepTimings())
+		handleYulOptimizerStatistics(*m_compiler->optimiserStepTimings());
 }
 
 }
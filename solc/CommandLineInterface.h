@@ -66,6 +66,14 @@ private:
 	void printVersion();
 	void printLicense();
 	bool compile();
+	/// Compiles every input source in a compilation of its own, using up to m_options.output.parallelism
+	/// threads, and prints the outputs of each compilation in the order of the source unit names.
+	/// The input sources are shared with the imports of all compilations.
+	bool compileSeparately();
+	/// Compiles one Standard JSON request per line read from the standard input until it ends.
+	void serveStandardJson();
+	/// @returns false if the client did not shut down the language server before it exited.
+	bool serveLSP();
 	bool link();
 	void writeLinkedFiles();
 	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
@@ -76,6 +84,10 @@ private:
 	bool assemble(yul::AssemblyStack::Language _language, yul::AssemblyStack::Machine _targetMachine);
 
 	void outputCompilationResults();
+	/// Writes @a _profile to the file given by --profile-json.
+	void writeProfile(Json::Value const& _profile);
+	/// Stops recording the trace and writes it to the file given by --trace-file.
+	void writeTrace();
 
 	void handleCombinedJSON();
 	void handleAst();
@@ -91,6 +103,7 @@ private:
 	void handleNatspec(bool _natspecDev, std::string const& _contract);
 	void handleGasEstimation(std::string const& _contract);
 	void handleStorageLayout(std::string const& _contract);
+	void handleYulOptimizerStatistics(util::TimingCollector const& _stepTimings);
 
 	/// Tries to read @ m_sourceCodes as a JSONs holding ASTs
 	/// such that they can be imported into the compiler  (importASTs())
@@ -101,7 +114,8 @@ private:
 	/// Create a file in the given directory
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
-	void createFile(std::string const& _fileName, std::string const& _data);
+	/// @arg _binary whether to write @a _data without translating line endings
+	void createFile(std::string const& _fileName, std::string const& _data, bool _binary = false);
 
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
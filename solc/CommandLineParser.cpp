@@ -46,7 +46,9 @@ static string const g_strAllowPaths = "allow-paths";
 static string const g_strBasePath = "base-path";
 static string const g_strIncludePath = "include-path";
 static string const g_strAssemble = "assemble";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strCombinedJson = "combined-json";
+static string const g_strCompileSeparately = "compile-separately";
 static string const g_strErrorRecovery = "error-recovery";
 static string const g_strEVM = "evm";
 static string const g_strEVMVersion = "evm-version";
@@ -60,27 +62,39 @@ static string const g_strYul = "yul";
 static string const g_strYulDialect = "yul-dialect";
 static string const g_strDebugInfo = "debug-info";
 static string const g_strIPFS = "ipfs";
+static string const g_strJobs = "jobs";
 static string const g_strLicense = "license";
 static string const g_strLibraries = "libraries";
+static string const g_strLSP = "lsp";
 static string const g_strLink = "link";
 static string const g_strMachine = "machine";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
+static string const g_strModelCheckerBMCLoopIterations = "model-checker-bmc-loop-iterations";
 static string const g_strModelCheckerContracts = "model-checker-contracts";
 static string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mod-no-slacks";
 static string const g_strModelCheckerEngine = "model-checker-engine";
+static string const g_strModelCheckerExternalSolver = "model-checker-external-solver";
 static string const g_strModelCheckerInvariants = "model-checker-invariants";
+static string const g_strModelCheckerQueryCache = "model-checker-query-cache";
+static string const g_strModelCheckerReuseInvariants = "model-checker-reuse-invariants";
 static string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
 static string const g_strModelCheckerSolvers = "model-checker-solvers";
 static string const g_strModelCheckerTargets = "model-checker-targets";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
+static string const g_strModelCheckerTotalTimeout = "model-checker-total-timeout";
 static string const g_strNone = "none";
 static string const g_strNoOptimizeYul = "no-optimize-yul";
 static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
 static string const g_strYulOptimizations = "yul-optimizations";
+static string const g_strYulOptimizationsStats = "yul-optimizations-stats";
+static string const g_strYulOptimizationsCandidate = "yul-optimizations-candidate";
+static string const g_strYulOptimizationsCandidateTimeBudget = "yul-optimizations-candidate-time-budget";
 static string const g_strOutputDir = "output-dir";
+static string const g_strProfileJson = "profile-json";
+static string const g_strTraceFile = "trace-file";
 static string const g_strOverwrite = "overwrite";
 static string const g_strRevertStrings = "revert-strings";
 static string const g_strStopAfter = "stop-after";
@@ -97,6 +111,7 @@ static set<string> const g_revertStringsArgs
 
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
+static string const g_strServer = "server";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strSwarm = "swarm";
@@ -104,6 +119,7 @@ static string const g_strPrettyJson = "pretty-json";
 static string const g_strJsonIndent = "json-indent";
 static string const g_strVersion = "version";
 static string const g_strIgnoreMissingFiles = "ignore-missing";
+static string const g_strMemoryMapSources = "memory-map-sources";
 static string const g_strColor = "color";
 static string const g_strNoColor = "no-color";
 static string const g_strErrorIds = "error-codes";
@@ -135,6 +151,8 @@ static map<InputMode, string> const g_inputModeName = {
 	{InputMode::CompilerWithASTImport, "compiler (AST import)"},
 	{InputMode::Assembler, "assembler"},
 	{InputMode::StandardJson, "standard JSON"},
+	{InputMode::Server, "server"},
+	{InputMode::LanguageServer, "language server"},
 	{InputMode::Linker, "linker"},
 };
 
@@ -219,11 +237,17 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		input.includePaths == _other.input.includePaths &&
 		input.allowedDirectories == _other.input.allowedDirectories &&
 		input.ignoreMissingFiles == _other.input.ignoreMissingFiles &&
+		input.memoryMapSources == _other.input.memoryMapSources &&
 		input.errorRecovery == _other.input.errorRecovery &&
 		output.dir == _other.output.dir &&
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
 		output.experimentalViaIR == _other.output.experimentalViaIR &&
+		output.parallelism == _other.output.parallelism &&
+		output.compileSeparately == _other.output.compileSeparately &&
+		output.cacheDir == _other.output.cacheDir &&
+		output.profileJson == _other.output.profileJson &&
+		output.traceFile == _other.output.traceFile &&
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
@@ -243,6 +267,9 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.noOptimizeYul == _other.optimizer.noOptimizeYul &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.yulCandidateSteps == _other.optimizer.yulCandidateSteps &&
+		optimizer.yulCandidateTimeBudget == _other.optimizer.yulCandidateTimeBudget &&
+		optimizer.yulStepStatistics == _other.optimizer.yulStepStatistics &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
 		modelChecker.settings == _other.modelChecker.settings;
 }
@@ -265,6 +292,9 @@ OptimiserSettings CommandLineOptions::optimiserSettings() const
 	if (optimizer.yulSteps.has_value())
 		settings.yulOptimiserSteps = optimizer.yulSteps.value();
 
+	settings.yulOptimiserCandidateSteps = optimizer.yulCandidateSteps;
+	settings.yulOptimiserCandidateTimeBudget = optimizer.yulCandidateTimeBudget;
+
 	return settings;
 }
 
@@ -281,6 +311,7 @@ bool CommandLineParser::parse(int _argc, char const* const* _argv)
 bool CommandLineParser::parseInputPathsAndRemappings()
 {
 	m_options.input.ignoreMissingFiles = (m_args.count(g_strIgnoreMissingFiles) > 0);
+	m_options.input.memoryMapSources = (m_args.count(g_strMemoryMapSources) > 0);
 
 	if (m_args.count(g_strInputFile))
 		for (string const& positionalArg: m_args[g_strInputFile].as<vector<string>>())
@@ -294,7 +325,7 @@ bool CommandLineParser::parseInputPathsAndRemappings()
 					return false;
 				}
 
-				if (m_options.input.mode == InputMode::StandardJson)
+				if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::Server)
 				{
 					serr() << "Import remappings are not accepted on the command line in Standard JSON mode." << endl;
 					serr() << "Please put them under 'settings.remappings' in the JSON input." << endl;
@@ -334,6 +365,15 @@ bool CommandLineParser::parseInputPathsAndRemappings()
 			// Keep it working that way for backwards-compatibility.
 			m_options.input.addStdin = true;
 	}
+	else if (m_options.input.mode == InputMode::Server || m_options.input.mode == InputMode::LanguageServer)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin)
+		{
+			serr() << "No input files can be given for --" << (m_options.input.mode == InputMode::Server ? g_strServer : g_strLSP) << "." << endl;
+			serr() << "The requests are read from standard input." << endl;
+			return false;
+		}
+	}
 	else if (m_options.input.paths.size() == 0 && !m_options.input.addStdin)
 	{
 		serr() << "No input files given. If you wish to use the standard input please specify \"-\" explicitly." << endl;
@@ -471,6 +511,8 @@ bool CommandLineParser::parseOutputSelection()
 		case InputMode::Assembler:
 			return contains(assemblerModeOutputs, _outputName);
 		case InputMode::StandardJson:
+		case InputMode::Server:
+		case InputMode::LanguageServer:
 		case InputMode::Linker:
 			return false;
 		}
@@ -560,6 +602,11 @@ General Information)").c_str(),
 			g_strIgnoreMissingFiles.c_str(),
 			"Ignore missing files."
 		)
+		(
+			g_strMemoryMapSources.c_str(),
+			"Map the input files into memory instead of reading them. "
+			"Saves copying large source files. The files must not be modified during compilation."
+		)
 		(
 			g_strErrorRecovery.c_str(),
 			"Enables additional parser error recovery."
@@ -588,6 +635,43 @@ General Information)").c_str(),
 			g_strExperimentalViaIR.c_str(),
 			"Turn on experimental compilation mode via the IR (EXPERIMENTAL)."
 		)
+		(
+			g_strJobs.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Use up to n threads to compile independent contracts and to optimise Yul objects in parallel. "
+			"Only affects the compilation via the IR and assembler mode, the number of files compiled at once "
+			"with --compile-separately and the number of files linked at once in linker mode. "
+			"The output does not depend on this setting."
+		)
+		(
+			g_strCompileSeparately.c_str(),
+			"Compile every input file on its own, as if the compiler was run once for each of them, "
+			"and compile up to n files at once, where n is given by --jobs. "
+			"The outputs are printed in the order of the source unit names of the files."
+		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the EVM outputs of compiled contracts in the given directory and take them "
+			"from there instead of generating code again if the metadata of a contract did not change. "
+			"Not used if gas estimates, IR or Ewasm output are requested."
+		)
+		(
+			g_strProfileJson.c_str(),
+			po::value<string>()->value_name("path"),
+			"Write the time spent in the stages of the compilation, in the code generation of each contract, "
+			"in the Yul optimiser steps, in the evmasm optimiser passes and in the model checker engines, "
+			"as well as the peak memory usage, to the given file as JSON. "
+			"With --compile-separately, the file contains these timings for each input file."
+		)
+		(
+			g_strTraceFile.c_str(),
+			po::value<string>()->value_name("path"),
+			"Write the spans of the compilation stages, of the code generation of each contract, "
+			"of the Yul optimiser steps, of the evmasm optimiser passes and of the SMT solver queries "
+			"together with the threads they ran on to the given file, as JSON in the Chrome trace event "
+			"format, which can be shown by Perfetto."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<string>()->value_name(joinHumanReadable(g_revertStringsArgs, ",")),
@@ -603,7 +687,8 @@ General Information)").c_str(),
 		(
 			g_strStopAfter.c_str(),
 			po::value<string>()->value_name("stage"),
-			"Stop execution after the given compiler stage. Valid options: \"parsing\"."
+			"Stop execution after the given compiler stage. Valid options: \"parsing\", \"analysis\" and \"ir\". "
+			"After \"ir\", only the IR and the optimized IR can be requested as code outputs."
 		)
 	;
 	desc.add(outputOptions);
@@ -615,6 +700,19 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_strServer.c_str(),
+			"Switch to Standard JSON server mode, ignoring all options except the ones affecting imports. "
+			"It keeps running and reads one Standard JSON request per line from standard input until it is closed. "
+			"The result of each request is written to standard output as a single line. "
+			"Sources whose keccak256 hash was given in a request can be given by their hash alone in later requests."
+		)
+		(
+			g_strLSP.c_str(),
+			"Switch to language server mode (\"LSP\"), ignoring all options. "
+			"It reads the messages of the language server protocol from standard input and writes the responses "
+			"to standard output, reporting the diagnostics of the opened documents and resolving definitions."
+		)
 		(
 			g_strLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_strLibraries + " "
@@ -776,11 +874,35 @@ General Information)").c_str(),
 			po::value<string>()->value_name("steps"),
 			"Forces yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strYulOptimizationsCandidate.c_str(),
+			po::value<vector<string>>()->value_name("steps"),
+			"Also optimizes each Yul object with the specified sequence of optimization steps in parallel "
+			"and keeps the result with the lowest estimated costs. Can be given multiple times."
+		)
+		(
+			g_strYulOptimizationsCandidateTimeBudget.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			("Abandons the optimization of a Yul object with a sequence given by --" + g_strYulOptimizationsCandidate + " "
+			"after the specified number of milliseconds. The output then depends on the speed of the machine.").c_str()
+		)
+		(
+			g_strYulOptimizationsStats.c_str(),
+			"Print the number of runs, the time spent, the number of runs that changed the code and the "
+			"resulting change of the code size for each Yul optimizer step."
+		)
 	;
 	desc.add(optimizerOptions);
 
 	po::options_description smtCheckerOptions("Model Checker Options");
 	smtCheckerOptions.add_options()
+		(
+			g_strModelCheckerBMCLoopIterations.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Let the BMC engine unroll loops for the given number of iterations instead of erasing "
+			"what is known about the variables they touch. "
+			"Loops with break, continue or return statements or whose condition assigns to variables are not unrolled."
+		)
 		(
 			g_strModelCheckerContracts.c_str(),
 			po::value<string>()->value_name("default,<source>:<contract>")->default_value("default"),
@@ -798,6 +920,13 @@ General Information)").c_str(),
 			po::value<string>()->value_name("all,bmc,chc,none")->default_value("none"),
 			"Select model checker engine."
 		)
+		(
+			g_strModelCheckerExternalSolver.c_str(),
+			po::value<string>()->value_name("command"),
+			"Answer the SMT-LIB2 queries of the model checker with the given solver command, e.g. \"z3 -in\", "
+			"whose arguments are separated by spaces. The solver is started once, has to read SMT-LIB2 from "
+			"its standard input and is only used if the smtlib2 solver is selected."
+		)
 		(
 			g_strModelCheckerInvariants.c_str(),
 			po::value<string>()->value_name("default,all,contract,reentrancy")->default_value("default"),
@@ -805,6 +934,17 @@ General Information)").c_str(),
 			" Multiple types of invariants can be selected at the same time, separated by a comma and no spaces."
 			" By default no invariants are reported."
 		)
+		(
+			g_strModelCheckerQueryCache.c_str(),
+			po::value<string>()->value_name("path"),
+			"Cache the responses of the SMT solvers in the given directory, so that queries that "
+			"were already answered in earlier runs do not need to be solved again."
+		)
+		(
+			g_strModelCheckerReuseInvariants.c_str(),
+			"Let the CHC engine start from the invariants that Z3 found for the same predicates "
+			"earlier in this process, after checking that they are still inductive."
+		)
 		(
 			g_strModelCheckerShowUnproved.c_str(),
 			"Show all unproved targets separately."
@@ -828,6 +968,14 @@ General Information)").c_str(),
 			"The default is a deterministic resource limit. "
 			"A timeout of 0 means no resource/time restrictions for any query."
 		)
+		(
+			g_strModelCheckerTotalTimeout.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			"Set the wall-clock time in milliseconds that the model checker may spend solving queries. "
+			"The targets are first checked with a short timeout per query and the unproved ones are "
+			"checked again with a longer timeout while time is left. "
+			"The solving time of each target is reported."
+		)
 	;
 	desc.add(smtCheckerOptions);
 
@@ -874,6 +1022,8 @@ bool CommandLineParser::processArgs()
 		g_strLicense,
 		g_strVersion,
 		g_strStandardJSON,
+		g_strServer,
+		g_strLSP,
 		g_strLink,
 		g_strAssemble,
 		g_strStrictAssembly,
@@ -890,6 +1040,10 @@ bool CommandLineParser::processArgs()
 		m_options.input.mode = InputMode::Version;
 	else if (m_args.count(g_strStandardJSON) > 0)
 		m_options.input.mode = InputMode::StandardJson;
+	else if (m_args.count(g_strServer) > 0)
+		m_options.input.mode = InputMode::Server;
+	else if (m_args.count(g_strLSP) > 0)
+		m_options.input.mode = InputMode::LanguageServer;
 	else if (m_args.count(g_strAssemble) > 0 || m_args.count(g_strStrictAssembly) > 0 || m_args.count(g_strYul) > 0)
 		m_options.input.mode = InputMode::Assembler;
 	else if (m_args.count(g_strLink) > 0)
@@ -910,6 +1064,12 @@ bool CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strErrorRecovery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::Assembler, InputMode::Linker}},
+		{g_strCompileSeparately, {InputMode::Compiler}},
+		{g_strCacheDir, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strProfileJson, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strTraceFile, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::Assembler, InputMode::StandardJson}},
+		{g_strMemoryMapSources, {InputMode::Compiler}},
 	};
 	vector<string> invalidOptionsForCurrentInputMode;
 	for (auto const& [optionName, inputModes]: validOptionInputModeCombinations)
@@ -939,8 +1099,18 @@ bool CommandLineParser::processArgs()
 		CompilerOutputs::componentName(&CompilerOutputs::opcodes),
 	};
 
+	// The IR is still generated when stopping after the IR generation.
+	bool const stopAfterIR = m_args.count(g_strStopAfter) && m_args[g_strStopAfter].as<string>() == "ir";
 	for (auto& option: conflictingWithStopAfter)
-		if (!checkMutuallyExclusive({g_strStopAfter, option}))
+		if (
+			!(
+				stopAfterIR && (
+					option == CompilerOutputs::componentName(&CompilerOutputs::ir) ||
+					option == CompilerOutputs::componentName(&CompilerOutputs::irOptimized)
+				)
+			) &&
+			!checkMutuallyExclusive({g_strStopAfter, option})
+		)
 			return false;
 
 	if (
@@ -955,7 +1125,14 @@ bool CommandLineParser::processArgs()
 			return false;
 		}
 
-		for (string const& option: {g_strOptimize, g_strNoOptimizeYul, g_strOptimizeYul, g_strYulOptimizations})
+		for (string const& option: {
+			g_strOptimize,
+			g_strNoOptimizeYul,
+			g_strOptimizeYul,
+			g_strYulOptimizations,
+			g_strYulOptimizationsCandidate,
+			g_strYulOptimizationsCandidateTimeBudget
+		})
 			if (m_args.count(option) > 0)
 			{
 				serr() << "Option --" << option << " is only valid in compiler and assembler modes." << endl;
@@ -1065,19 +1242,50 @@ bool CommandLineParser::processArgs()
 
 	if (m_args.count(g_strStopAfter))
 	{
-		if (m_args[g_strStopAfter].as<string>() != "parsing")
+		static map<string, CompilerStack::State> const stages{
+			{"parsing", CompilerStack::State::Parsed},
+			{"analysis", CompilerStack::State::AnalysisPerformed},
+			{"ir", CompilerStack::State::IRGenerated},
+		};
+		auto stage = stages.find(m_args[g_strStopAfter].as<string>());
+		if (stage == stages.end())
 		{
-			serr() << "Valid options for --" << g_strStopAfter << " are: \"parsing\".\n";
+			serr() << "Valid options for --" << g_strStopAfter << " are: \"parsing\", \"analysis\" and \"ir\".\n";
 			return false;
 		}
 		else
-			m_options.output.stopAfter = CompilerStack::State::Parsed;
+			m_options.output.stopAfter = stage->second;
+	}
+
+	if (m_args.count(g_strJobs))
+	{
+		unsigned jobs = m_args[g_strJobs].as<unsigned>();
+		if (jobs == 0)
+		{
+			serr() << "Option --" << g_strJobs << " must be a positive integer." << endl;
+			return false;
+		}
+		m_options.output.parallelism = jobs;
 	}
+	m_options.output.compileSeparately = (m_args.count(g_strCompileSeparately) > 0);
+
+	if (m_args.count(g_strCacheDir))
+		m_options.output.cacheDir = m_args.at(g_strCacheDir).as<string>();
+
+	if (m_args.count(g_strProfileJson))
+		m_options.output.profileJson = m_args.at(g_strProfileJson).as<string>();
+
+	if (m_args.count(g_strTraceFile))
+		m_options.output.traceFile = m_args.at(g_strTraceFile).as<string>();
 
 	if (!parseInputPathsAndRemappings())
 		return false;
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (
+		m_options.input.mode == InputMode::StandardJson ||
+		m_options.input.mode == InputMode::Server ||
+		m_options.input.mode == InputMode::LanguageServer
+	)
 		return true;
 
 	if (m_args.count(g_strLibraries))
@@ -1127,6 +1335,41 @@ bool CommandLineParser::processArgs()
 		m_options.optimizer.yulSteps = m_args[g_strYulOptimizations].as<string>();
 	}
 
+	if (m_args.count(g_strYulOptimizationsCandidate))
+	{
+		if (!m_options.optimiserSettings().runYulOptimiser)
+		{
+			serr() << "--" << g_strYulOptimizationsCandidate << " is invalid if Yul optimizer is disabled" << endl;
+			return false;
+		}
+
+		for (string const& steps: m_args[g_strYulOptimizationsCandidate].as<vector<string>>())
+		{
+			try
+			{
+				yul::OptimiserSuite::validateSequence(steps);
+			}
+			catch (yul::OptimizerException const& _exception)
+			{
+				serr() << "Invalid optimizer step sequence in --" << g_strYulOptimizationsCandidate << ": " << _exception.what() << endl;
+				return false;
+			}
+			m_options.optimizer.yulCandidateSteps.push_back(steps);
+		}
+	}
+
+	if (m_args.count(g_strYulOptimizationsCandidateTimeBudget))
+	{
+		if (!m_args.count(g_strYulOptimizationsCandidate))
+		{
+			serr() << "--" << g_strYulOptimizationsCandidateTimeBudget << " requires --" << g_strYulOptimizationsCandidate << "." << endl;
+			return false;
+		}
+		m_options.optimizer.yulCandidateTimeBudget = m_args[g_strYulOptimizationsCandidateTimeBudget].as<unsigned>();
+	}
+
+	m_options.optimizer.yulStepStatistics = (m_args.count(g_strYulOptimizationsStats) > 0);
+
 	if (m_options.input.mode == InputMode::Assembler)
 	{
 		vector<string> const nonAssemblyModeOptions = {
@@ -1274,6 +1517,15 @@ bool CommandLineParser::processArgs()
 		m_options.modelChecker.settings.invariants = *invs;
 	}
 
+	if (m_args.count(g_strModelCheckerExternalSolver))
+		m_options.modelChecker.settings.externalSolver = m_args[g_strModelCheckerExternalSolver].as<string>();
+
+	if (m_args.count(g_strModelCheckerQueryCache))
+		m_options.modelChecker.settings.queryCacheDirectory = m_args[g_strModelCheckerQueryCache].as<string>();
+
+	if (m_args.count(g_strModelCheckerReuseInvariants))
+		m_options.modelChecker.settings.reuseInvariants = true;
+
 	if (m_args.count(g_strModelCheckerShowUnproved))
 		m_options.modelChecker.settings.showUnproved = true;
 
@@ -1304,16 +1556,27 @@ bool CommandLineParser::processArgs()
 	if (m_args.count(g_strModelCheckerTimeout))
 		m_options.modelChecker.settings.timeout = m_args[g_strModelCheckerTimeout].as<unsigned>();
 
+	if (m_args.count(g_strModelCheckerTotalTimeout))
+		m_options.modelChecker.settings.totalTimeout = m_args[g_strModelCheckerTotalTimeout].as<unsigned>();
+
+	if (m_args.count(g_strModelCheckerBMCLoopIterations))
+		m_options.modelChecker.settings.bmcLoopIterations = m_args[g_strModelCheckerBMCLoopIterations].as<unsigned>();
+
 	m_options.metadata.literalSources = (m_args.count(g_strMetadataLiteral) > 0);
 	m_options.modelChecker.initialize =
+		m_args.count(g_strModelCheckerBMCLoopIterations) ||
 		m_args.count(g_strModelCheckerContracts) ||
 		m_args.count(g_strModelCheckerDivModNoSlacks) ||
 		m_args.count(g_strModelCheckerEngine) ||
+		m_args.count(g_strModelCheckerExternalSolver) ||
 		m_args.count(g_strModelCheckerInvariants) ||
+		m_args.count(g_strModelCheckerQueryCache) ||
+		m_args.count(g_strModelCheckerReuseInvariants) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
 		m_args.count(g_strModelCheckerSolvers) ||
 		m_args.count(g_strModelCheckerTargets) ||
-		m_args.count(g_strModelCheckerTimeout);
+		m_args.count(g_strModelCheckerTimeout) ||
+		m_args.count(g_strModelCheckerTotalTimeout);
 	m_options.output.experimentalViaIR = (m_args.count(g_strExperimentalViaIR) > 0);
 	if (m_options.input.mode == InputMode::Compiler)
 		m_options.input.errorRecovery = (m_args.count(g_strErrorRecovery) > 0);
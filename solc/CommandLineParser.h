@@ -54,6 +54,8 @@ enum class InputMode
 	Compiler,
 	CompilerWithASTImport,
 	StandardJson,
+	Server,
+	LanguageServer,
 	Linker,
 	Assembler,
 };
@@ -173,6 +175,7 @@ struct CommandLineOptions
 		std::vector<boost::filesystem::path> includePaths;
 		FileReader::FileSystemPathSet allowedDirectories;
 		bool ignoreMissingFiles = false;
+		bool memoryMapSources = false;
 		bool errorRecovery = false;
 	} input;
 
@@ -182,6 +185,11 @@ struct CommandLineOptions
 		bool overwriteFiles = false;
 		langutil::EVMVersion evmVersion;
 		bool experimentalViaIR = false;
+		size_t parallelism = 1;
+		bool compileSeparately = false;
+		boost::filesystem::path cacheDir;
+		boost::filesystem::path profileJson;
+		boost::filesystem::path traceFile;
 		RevertStrings revertStrings = RevertStrings::Default;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
@@ -224,6 +232,9 @@ struct CommandLineOptions
 		std::optional<unsigned> expectedExecutionsPerDeployment;
 		bool noOptimizeYul = false;
 		std::optional<std::string> yulSteps;
+		std::vector<std::string> yulCandidateSteps;
+		unsigned yulCandidateTimeBudget = 0;
+		bool yulStepStatistics = false;
 	} optimizer;
 
 	struct
@@ -28,6 +28,8 @@
 #include <boost/exception/all.hpp>
 
 #include <clocale>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 
 using namespace std;
@@ -67,6 +69,23 @@ int main(int argc, char** argv)
 			cli.readInputFiles() &&
 			cli.processInput();
 
+		// Freeing the ASTs, the compiled contracts and the global caches one by one only takes time
+		// right before the process ends. The servers can run for a long time, so they are torn down properly.
+		if (
+			cli.options().input.mode != frontend::InputMode::Server &&
+			cli.options().input.mode != frontend::InputMode::LanguageServer
+		)
+		{
+			cout.flush();
+			cerr.flush();
+			fflush(nullptr);
+#ifdef COVERAGE_BUILD
+			// The coverage data is written by the exit handlers.
+			std::exit(success ? 0 : 1);
+#else
+			std::_Exit(success ? 0 : 1);
+#endif
+		}
 		return success ? 0 : 1;
 	}
 	catch (smtutil::SMTLogicError const& _exception)
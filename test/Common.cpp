@@ -111,7 +111,10 @@ void CommonOptions::addOptions()
 		("enforce-gas-cost-min-value", po::value(&enforceGasTestMinValue)->default_value(enforceGasTestMinValue), "Threshold value to enforce adding gas checks to a test.")
 		("abiencoderv1", po::bool_switch(&useABIEncoderV1)->default_value(useABIEncoderV1), "enables abi encoder v1")
 		("show-messages", po::bool_switch(&showMessages)->default_value(showMessages), "enables message output")
-		("show-metadata", po::bool_switch(&showMetadata)->default_value(showMetadata), "enables metadata output");
+		("show-metadata", po::bool_switch(&showMetadata)->default_value(showMetadata), "enables metadata output")
+		("compilation-cache", po::value<fs::path>(&compilationCacheDirectory), "directory in which the bytecode of compiled test contracts is kept between runs")
+		("smt-fixtures", po::value<fs::path>(&smtFixtureDirectory), "directory with the recorded responses of the SMT solvers, which are replayed in the SMTChecker tests")
+		("record-smt-fixtures", po::bool_switch(&recordSMTFixtures)->default_value(recordSMTFixtures), "records the responses of the SMT solvers into the directory given by --smt-fixtures");
 }
 
 void CommonOptions::validate() const
@@ -126,6 +129,11 @@ void CommonOptions::validate() const
 		ConfigException,
 		"Invalid test path specified."
 	);
+	assertThrow(
+		!recordSMTFixtures || !smtFixtureDirectory.empty(),
+		ConfigException,
+		"The responses of the SMT solvers can only be recorded if --smt-fixtures is given."
+	);
 	if (enforceGasTest)
 	{
 		assertThrow(
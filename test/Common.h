@@ -67,6 +67,12 @@ struct CommonOptions
 	bool useABIEncoderV1 = false;
 	bool showMessages = false;
 	bool showMetadata = false;
+	/// Directory in which the bytecode of compiled test contracts is kept between runs.
+	boost::filesystem::path compilationCacheDirectory;
+	/// Directory with the recorded responses of the SMT solvers to the queries of the SMTChecker tests.
+	boost::filesystem::path smtFixtureDirectory;
+	/// Whether the SMT solvers answer all queries and their responses are recorded into smtFixtureDirectory.
+	bool recordSMTFixtures = false;
 
 	langutil::EVMVersion evmVersion() const;
 
@@ -31,6 +31,8 @@
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/picosha2.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -43,6 +45,9 @@ evmc::VM& EVMHost::getVM(string const& _path)
 {
 	static evmc::VM NullVM{nullptr};
 	static map<string, unique_ptr<evmc::VM>> vms;
+	// Test cases can be run on several threads at once.
+	static mutex vmsMutex;
+	lock_guard<mutex> lock(vmsMutex);
 	if (vms.count(_path) == 0)
 	{
 		evmc_loader_error_code errorCode = {};
@@ -144,10 +149,41 @@ EVMHost::EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm):
 	reset();
 }
 
+EVMHost& EVMHost::reusable(langutil::EVMVersion _evmVersion, evmc::VM& _vm)
+{
+	struct ReusableHost
+	{
+		unique_ptr<EVMHost> host;
+		evmc_tx_context initialContext;
+	};
+	thread_local map<pair<langutil::EVMVersion, evmc::VM*>, ReusableHost> hosts;
+
+	ReusableHost& reusableHost = hosts[{_evmVersion, &_vm}];
+	if (!reusableHost.host)
+	{
+		reusableHost.host = make_unique<EVMHost>(_evmVersion, _vm);
+		reusableHost.initialContext = reusableHost.host->tx_context;
+	}
+	else
+	{
+		reusableHost.host->reset();
+		reusableHost.host->recorded_logs.clear();
+		reusableHost.host->tx_context = reusableHost.initialContext;
+	}
+	return *reusableHost.host;
+}
+
 void EVMHost::reset()
 {
+	if (m_initialAccounts)
+	{
+		restore(m_initialAccounts);
+		return;
+	}
+
 	accounts.clear();
 	m_currentAddress = {};
+	m_savedAccounts.clear();
 	// Clear self destruct records
 	recorded_selfdestructs.clear();
 	// Clear call records
@@ -170,6 +206,24 @@ void EVMHost::reset()
 		if (precompiledAddress < 5 || m_evmVersion >= langutil::EVMVersion::byzantium())
 			accounts[address].codehash = 0xc5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470_bytes32;
 	}
+	m_initialAccounts = snapshot();
+}
+
+EVMHost::Snapshot EVMHost::snapshot() const
+{
+	assertThrow(m_savedAccounts.empty(), Exception, "Snapshot taken during a call.");
+	return make_shared<Accounts const>(accounts);
+}
+
+void EVMHost::restore(Snapshot const& _snapshot)
+{
+	assertThrow(_snapshot, Exception, "");
+	accounts = *_snapshot;
+	m_currentAddress = {};
+	m_savedAccounts.clear();
+	recorded_selfdestructs.clear();
+	recorded_calls.clear();
+	recorded_account_accesses.clear();
 }
 
 void EVMHost::resetWarmAccess()
@@ -193,12 +247,64 @@ void EVMHost::selfdestruct(const evmc::address& _addr, const evmc::address& _ben
 {
 	// TODO actual selfdestruct is even more complicated.
 
+	saveAccount(_addr);
+	saveAccount(_beneficiary);
 	transfer(accounts[_addr], accounts[_beneficiary], convertFromEVMC(accounts[_addr].balance));
 	accounts.erase(_addr);
 	// Record self destructs
 	recorded_selfdestructs.push_back({_addr, _beneficiary});
 }
 
+evmc_storage_status EVMHost::set_storage(
+	evmc::address const& _addr,
+	evmc::bytes32 const& _key,
+	evmc::bytes32 const& _value
+) noexcept
+{
+	saveAccount(_addr);
+	return MockedHost::set_storage(_addr, _key, _value);
+}
+
+evmc_access_status EVMHost::access_storage(evmc::address const& _addr, evmc::bytes32 const& _key) noexcept
+{
+	saveAccount(_addr);
+	return MockedHost::access_storage(_addr, _key);
+}
+
+void EVMHost::saveAccount(evmc::address const& _address)
+{
+	if (m_savedAccounts.empty())
+		return;
+	auto& saved = m_savedAccounts.back();
+	if (saved.count(_address))
+		return;
+	auto account = accounts.find(_address);
+	if (account == accounts.end())
+		saved.emplace(_address, nullopt);
+	else
+		saved.emplace(_address, account->second);
+}
+
+void EVMHost::revertCall()
+{
+	for (auto& [address, account]: m_savedAccounts.back())
+		if (account)
+			accounts[address] = move(*account);
+		else
+			accounts.erase(address);
+	m_savedAccounts.pop_back();
+}
+
+void EVMHost::commitCall()
+{
+	auto saved = move(m_savedAccounts.back());
+	m_savedAccounts.pop_back();
+	// The enclosing call has to be able to revert the changes, too.
+	if (!m_savedAccounts.empty())
+		for (auto& [address, account]: saved)
+			m_savedAccounts.back().try_emplace(address, move(account));
+}
+
 void EVMHost::recordCalls(evmc_message const& _message) noexcept
 {
 	if (recorded_calls.size() < max_recorded_calls)
@@ -225,7 +331,8 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	else if (_message.destination == 0x0000000000000000000000000000000000000008_address && m_evmVersion >= langutil::EVMVersion::byzantium())
 		return precompileALTBN128PairingProduct(_message);
 
-	auto const stateBackup = accounts;
+	m_savedAccounts.emplace_back();
+	saveAccount(_message.sender);
 
 	u256 value{convertFromEVMC(_message.value)};
 	auto& sender = accounts[_message.sender];
@@ -242,7 +349,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertCall();
 			return result;
 		}
 	}
@@ -256,6 +363,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 			asBytes(to_string(sender.nonce++))
 		));
 		message.destination = convertToEVMC(createAddress);
+		saveAccount(message.destination);
 		code = evmc::bytes(message.input_data, message.input_data + message.input_size);
 	}
 	else if (message.kind == EVMC_CREATE2)
@@ -267,6 +375,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 			keccak256(bytes(message.input_data, message.input_data + message.input_size)).asBytes()
 		));
 		message.destination = convertToEVMC(createAddress);
+		saveAccount(message.destination);
 		if (accounts.count(message.destination) && (
 			accounts[message.destination].nonce > 0 ||
 			!accounts[message.destination].code.empty()
@@ -274,7 +383,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertCall();
 			return result;
 		}
 
@@ -282,11 +391,16 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	}
 	else if (message.kind == EVMC_DELEGATECALL || message.kind == EVMC_CALLCODE)
 	{
+		saveAccount(message.destination);
 		code = accounts[message.destination].code;
 		message.destination = m_currentAddress;
+		saveAccount(message.destination);
 	}
 	else
+	{
+		saveAccount(message.destination);
 		code = accounts[message.destination].code;
+	}
 
 	auto& destination = accounts[message.destination];
 
@@ -296,7 +410,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_INSUFFICIENT_BALANCE;
-			accounts = stateBackup;
+			revertCall();
 			return result;
 		}
 		transfer(sender, destination, value);
@@ -333,7 +447,9 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	}
 
 	if (result.status_code != EVMC_SUCCESS)
-		accounts = stateBackup;
+		revertCall();
+	else
+		commitCall();
 
 	return result;
 }
@@ -401,7 +517,7 @@ evmc::result EVMHost::precompileECRecover(evmc_message const& _message) noexcept
 evmc::result EVMHost::precompileSha256(evmc_message const& _message) noexcept
 {
 	// static data so that we do not need a release routine...
-	bytes static hash;
+	bytes thread_local hash;
 	hash = picosha2::hash256(bytes(
 		_message.input_data,
 		_message.input_data + _message.input_size
@@ -483,7 +599,7 @@ evmc::result EVMHost::precompileRipeMD160(evmc_message const& _message) noexcept
 evmc::result EVMHost::precompileIdentity(evmc_message const& _message) noexcept
 {
 	// static data so that we do not need a release routine...
-	bytes static data;
+	bytes thread_local data;
 	data = bytes(_message.input_data, _message.input_data + _message.input_size);
 	evmc::result result({});
 	result.gas_left = _message.gas;
@@ -32,6 +32,10 @@
 
 #include <boost/filesystem.hpp>
 
+#include <map>
+#include <memory>
+#include <optional>
+
 namespace solidity::test
 {
 using Address = util::h160;
@@ -53,9 +57,24 @@ public:
 	///          the second being true, if an evmc vm supporting ewasm was loaded properly.
 	static std::tuple<bool, bool> checkVmPaths(std::vector<boost::filesystem::path> const& _vmPaths);
 
+	using Accounts = std::unordered_map<evmc::address, evmc::MockedAccount>;
+	/// Immutable copy of the accounts, which can be restored any number of times.
+	using Snapshot = std::shared_ptr<Accounts const>;
+
 	explicit EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm);
 
+	/// @returns a host for @a _evmVersion executing on @a _vm that is created once per thread and put
+	/// back into the state of a new host on every call. This is cheaper than creating a new host,
+	/// e.g. for every input of a fuzzer.
+	static EVMHost& reusable(langutil::EVMVersion _evmVersion, evmc::VM& _vm);
+
+	/// Restores the accounts that exist before any transaction, which are only created once.
 	void reset();
+	/// @returns a copy of the current accounts. Must not be called during a call.
+	Snapshot snapshot() const;
+	/// Replaces the accounts by @a _snapshot and clears the records of calls, self-destructs and
+	/// account accesses like reset(). The transaction context is not changed.
+	void restore(Snapshot const& _snapshot);
 	/// Clears EIP-2929 account and storage access indicator
 	void resetWarmAccess();
 	void newBlock()
@@ -74,6 +93,14 @@ public:
 		return evmc::MockedHost::account_exists(_addr);
 	}
 
+	evmc_storage_status set_storage(
+		evmc::address const& _addr,
+		evmc::bytes32 const& _key,
+		evmc::bytes32 const& _value
+	) noexcept final;
+
+	evmc_access_status access_storage(evmc::address const& _addr, evmc::bytes32 const& _key) noexcept final;
+
 	void selfdestruct(evmc::address const& _addr, evmc::address const& _beneficiary) noexcept final;
 
 	evmc::result call(evmc_message const& _message) noexcept final;
@@ -99,6 +126,19 @@ private:
 	/// Records calls made via @param _message.
 	void recordCalls(evmc_message const& _message) noexcept;
 
+	/// Saves the account at @a _address before the current call changes it, unless it is saved already.
+	void saveAccount(evmc::address const& _address);
+	/// Restores the accounts saved by the current call, which ends it.
+	void revertCall();
+	/// Keeps the changes of the current call, which ends it, so that the enclosing call can still revert them.
+	void commitCall();
+
+	/// For each active call, the accounts it changed as they were before, or nullopt for the accounts
+	/// it created. A failing call only restores these instead of a copy of all accounts.
+	std::vector<std::map<evmc::address, std::optional<evmc::MockedAccount>>> m_savedAccounts;
+	/// Accounts after the first reset(), which are restored by later resets.
+	Snapshot m_initialAccounts;
+
 	static evmc::result precompileECRecover(evmc_message const& _message) noexcept;
 	static evmc::result precompileSha256(evmc_message const& _message) noexcept;
 	static evmc::result precompileRipeMD160(evmc_message const& _message) noexcept;
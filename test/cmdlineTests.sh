@@ -186,7 +186,7 @@ function test_solc_behaviour
     exitCode=$?
     set -e
 
-    if [[ " ${solc_args[*]} " == *" --standard-json "* ]]
+    if [[ " ${solc_args[*]} " == *" --standard-json "* || " ${solc_args[*]} " == *" --server "* ]]
     then
         python3 - <<EOF
 import re, sys
@@ -547,10 +547,29 @@ SOLTMPDIR=$(mktemp -d)
     grep -q '//' C.bin && grep -q '__' C.bin
     # But not in library file.
     grep -q -v '[/_]' L.bin
+    cp C.bin D.bin
     # Now link
     msg_on_error "$SOLC" --link --libraries x.sol:L=0x90f20564390eAe531E810af625A22f51385Cd222 C.bin
     # Now the placeholder and explanation should be gone.
     grep -q -v '[/_]' C.bin
+    # Files linked in parallel are linked in the same way.
+    cp C.bin E.bin
+    msg_on_error "$SOLC" --link --jobs 2 --libraries x.sol:L=0x90f20564390eAe531E810af625A22f51385Cd222 D.bin E.bin
+    cmp C.bin D.bin && cmp C.bin E.bin
+)
+rm -r "$SOLTMPDIR"
+
+printTask "Testing the compilation profile..."
+SOLTMPDIR=$(mktemp -d)
+(
+    cd "$SOLTMPDIR"
+    echo 'contract C { function f() public pure {} }' > x.sol
+    msg_on_error --no-stdout "$SOLC" --bin --optimize --profile-json profile.json x.sol
+    grep -q '"stages"' profile.json && grep -q '"evmAssemblyOptimiserPasses"' profile.json
+    msg_on_error --no-stdout "$SOLC" --bin --compile-separately --profile-json profile.json x.sol
+    grep -q '"sourceUnits"' profile.json && grep -q '"x.sol"' profile.json
+    msg_on_error --no-stdout "$SOLC" --bin --optimize --trace-file trace.json x.sol
+    grep -q '"traceEvents"' trace.json && grep -q '"name":"x.sol:C"' trace.json && grep -q '"cat":"evmasm"' trace.json
 )
 rm -r "$SOLTMPDIR"
 
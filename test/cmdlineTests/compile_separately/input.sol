@@ -0,0 +1,8 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+
+import "./lib.sol";
+
+contract C {
+    function f() public pure {}
+}
@@ -58,11 +58,11 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 		{ "sub.asm", 1 }
 	};
 	Assembly _assembly;
-	auto root_asm = make_shared<string>("root.asm");
+	auto root_asm = internSourceName("root.asm");
 	_assembly.setSourceLocation({1, 3, root_asm});
 
 	Assembly _subAsm;
-	auto sub_asm = make_shared<string>("sub.asm");
+	auto sub_asm = internSourceName("sub.asm");
 	_subAsm.setSourceLocation({6, 8, sub_asm});
 	// PushImmutable
 	_subAsm.appendImmutable("someImmutable");
@@ -188,8 +188,8 @@ BOOST_AUTO_TEST_CASE(immutables_and_its_source_maps)
 				NumSubs +                  // PUSH <addr> for every sub assembly
 				1;                         // INVALID
 
-			auto assemblyName = make_shared<string>("root.asm");
-			auto subName = make_shared<string>("sub.asm");
+			auto assemblyName = internSourceName("root.asm");
+			auto subName = internSourceName("sub.asm");
 
 			map<string, unsigned> indices = {
 				{ *assemblyName, 0 },
@@ -249,6 +249,36 @@ BOOST_AUTO_TEST_CASE(immutables_and_its_source_maps)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(binary_source_mapping)
+{
+	auto rootName = internSourceName("root.asm");
+	auto subName = internSourceName("sub.asm");
+	map<string, unsigned> indices = {
+		{ *rootName, 0 },
+		{ *subName, 1 }
+	};
+
+	Assembly assembly;
+	assembly.setSourceLocation({1, 3, rootName});
+	assembly.append(u256(1));
+	assembly.append(Instruction::POP);
+	assembly.setSourceLocation({10, 20, subName});
+	AssemblyItem jump(Instruction::JUMP);
+	jump.setJumpType(AssemblyItem::JumpType::IntoFunction);
+	assembly.append(jump);
+	assembly.setSourceLocation({2, 3, rootName});
+	assembly.append(Instruction::STOP);
+
+	BOOST_CHECK_EQUAL(AssemblyItem::computeSourceMapping(assembly.items(), indices), "1:2:0:-:0;;10:10:1:i;2:1:0:-");
+	bytes const expectation = {
+		1, 2, 0, 0, 0,
+		0, 0, 0, 0, 0,
+		9, 8, 1, 1, 0,
+		0x78, 0x77, 0x7f, 0, 0
+	};
+	BOOST_CHECK(AssemblyItem::computeBinarySourceMapping(assembly.items(), indices) == expectation);
+}
+
 BOOST_AUTO_TEST_CASE(immutable)
 {
 	map<string, unsigned> indices = {
@@ -256,11 +286,11 @@ BOOST_AUTO_TEST_CASE(immutable)
 		{ "sub.asm", 1 }
 	};
 	Assembly _assembly;
-	auto root_asm = make_shared<string>("root.asm");
+	auto root_asm = internSourceName("root.asm");
 	_assembly.setSourceLocation({1, 3, root_asm});
 
 	Assembly _subAsm;
-	auto sub_asm = make_shared<string>("sub.asm");
+	auto sub_asm = internSourceName("sub.asm");
 	_subAsm.setSourceLocation({6, 8, sub_asm});
 	_subAsm.appendImmutable("someImmutable");
 	_subAsm.appendImmutable("someOtherImmutable");
@@ -364,6 +394,33 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(tag_table)
+{
+	Assembly assembly;
+	AssemblyItem first = assembly.newTag();
+	AssemblyItem second = assembly.newTag();
+	assembly.append(assembly.newTagTable({second, first, second}));
+	assembly.append(u256(0));
+	assembly.append(Instruction::MSTORE);
+	assembly.append(first);
+	assembly.append(second);
+
+	checkCompilation(assembly);
+	BOOST_CHECK_EQUAL(
+		assembly.assemble().toHex(),
+		"6008" // PUSH1 8 - offset of the tag table
+		"6000" // PUSH1 0
+		"52" // MSTORE
+		"5b" // JUMPDEST - tag_1 at offset 5
+		"5b" // JUMPDEST - tag_2 at offset 6
+		"fe" // INVALID
+		"00000006" // tag_2
+		"00000005" // tag_1
+		"00000006" // tag_2
+	);
+	BOOST_CHECK(assembly.assemblyString().find(" tag_2 tag_1 tag_2\n") != string::npos);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
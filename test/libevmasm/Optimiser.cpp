@@ -29,6 +29,7 @@
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/Assembly.h>
 
 #include <boost/test/unit_test.hpp>
@@ -975,6 +976,41 @@ BOOST_AUTO_TEST_CASE(block_deduplicator_loops)
 	BOOST_CHECK_EQUAL(pushTags.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(block_deduplicator_transitive)
+{
+	// Tags 3 and 4 only become equal after tags 1 and 2 were unified.
+	AssemblyItems input{
+		AssemblyItem(PushTag, 3),
+		AssemblyItem(PushTag, 4),
+		Instruction::JUMPI,
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(5),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(5),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 3),
+		u256(7),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 4),
+		u256(7),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP
+	};
+	BlockDeduplicator deduplicator(input);
+	BOOST_CHECK(deduplicator.deduplicate());
+
+	set<u256> pushTags;
+	for (AssemblyItem const& item: input)
+		if (item.type() == PushTag)
+			pushTags.insert(item.data());
+	BOOST_CHECK_EQUAL(pushTags.size(), 2);
+	BOOST_CHECK(pushTags.count(1));
+	BOOST_CHECK(pushTags.count(3));
+}
+
 BOOST_AUTO_TEST_CASE(clear_unreachable_code)
 {
 	AssemblyItems items{
@@ -1243,6 +1279,39 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(jumpdest_removal_foreign_and_sparse_tags)
+{
+	// References to tags of sub-assemblies do not keep the tags of the
+	// assembly itself, and sparse tag numbers are handled as well.
+	for (size_t offset: {size_t(0), size_t(1) << 40})
+	{
+		AssemblyItems items{
+			AssemblyItem(PushTag, offset + 1).toSubAssemblyTag(0),
+			AssemblyItem(PushTag, offset + 2),
+			AssemblyItem(Tag, offset + 1),
+			AssemblyItem(Tag, offset + 2),
+			AssemblyItem(Tag, offset + 3),
+			AssemblyItem(Tag, offset + 4),
+			Instruction::JUMP,
+		};
+		AssemblyItems expectation{
+			AssemblyItem(PushTag, offset + 1).toSubAssemblyTag(0),
+			AssemblyItem(PushTag, offset + 2),
+			AssemblyItem(Tag, offset + 2),
+			AssemblyItem(Tag, offset + 3),
+			Instruction::JUMP,
+		};
+		JumpdestRemover jdr(items);
+		BOOST_REQUIRE(jdr.optimise({offset + 3}));
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			items.begin(), items.end(),
+			expectation.begin(), expectation.end()
+		);
+		vector<set<size_t>> subReferences = JumpdestRemover::referencedTagsOfSubs(items, 2);
+		BOOST_CHECK(subReferences == (vector<set<size_t>>{{offset + 1}, {}}));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 {
 	// This tests that tags from subassemblies are not removed
@@ -1917,6 +1986,196 @@ BOOST_AUTO_TEST_CASE(inliner_invalid)
 }
 
 
+BOOST_AUTO_TEST_CASE(inliner_call_site_cost_model_loop)
+{
+	AssemblyItem jumpInto{Instruction::JUMP};
+	jumpInto.setJumpType(AssemblyItem::JumpType::IntoFunction);
+	AssemblyItem jumpOutOf{Instruction::JUMP};
+	jumpOutOf.setJumpType(AssemblyItem::JumpType::OutOfFunction);
+	// Two calls of a function inside a loop.
+	AssemblyItems items{
+		AssemblyItem(Tag, 10),
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2),
+		jumpInto,
+		AssemblyItem(Tag, 1),
+		AssemblyItem(PushTag, 3),
+		AssemblyItem(PushTag, 2),
+		jumpInto,
+		AssemblyItem(Tag, 3),
+		AssemblyItem(PushTag, 10),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+	};
+	for (size_t i = 0; i < 30; ++i)
+		items.emplace_back(Instruction::CALLVALUE);
+	items.emplace_back(jumpOutOf);
+
+	auto callCount = [&](AssemblyItems const& _items) {
+		return count_if(_items.begin(), _items.end(), [&](AssemblyItem const& _item) {
+			return _item == Instruction::JUMP && _item.getJumpType() == AssemblyItem::JumpType::IntoFunction;
+		});
+	};
+
+	// With ten runs, the two calls are not worth the size of a second copy of the function body.
+	AssemblyItems withoutCostModel = items;
+	Inliner{withoutCostModel, {}, 10, false, {}}.optimise();
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		withoutCostModel.begin(), withoutCostModel.end(),
+		items.begin(), items.end()
+	);
+
+	// Taking the iterations of the loop into account, they are.
+	AssemblyItems withCostModel = items;
+	Inliner{withCostModel, {}, 10, false, {}, true}.optimise();
+	BOOST_CHECK_EQUAL(callCount(withCostModel), 0);
+	BOOST_CHECK_EQUAL(withCostModel.size(), items.size() + 2 * 30 - 2);
+}
+
+BOOST_AUTO_TEST_CASE(constant_optimiser_parallel)
+{
+	Assembly assembly;
+	for (unsigned i = 0; i < 40; ++i)
+	{
+		// Constants that are cheaper to compute, to copy or to push, some of them repeated.
+		assembly.append(u256(0x1234 + i % 7) << (200 - i));
+		assembly.append((u256(1) << 255) - (i % 5));
+		assembly.append(u256(0x123456789abcdefULL * (i + 1)) << 120);
+		assembly.append(Instruction::POP);
+	}
+
+	for (bool isCreation: {false, true})
+	{
+		Assembly sequential = assembly;
+		Assembly parallel = assembly;
+		unsigned sequentialOptimisations = ConstantOptimisationMethod::optimiseConstants(
+			isCreation,
+			200,
+			solidity::test::CommonOptions::get().evmVersion(),
+			sequential,
+			1
+		);
+		unsigned parallelOptimisations = ConstantOptimisationMethod::optimiseConstants(
+			isCreation,
+			200,
+			solidity::test::CommonOptions::get().evmVersion(),
+			parallel,
+			4
+		);
+		BOOST_CHECK(sequentialOptimisations > 0);
+		BOOST_CHECK_EQUAL(sequentialOptimisations, parallelOptimisations);
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			sequential.items().begin(), sequential.items().end(),
+			parallel.items().begin(), parallel.items().end()
+		);
+		BOOST_CHECK(sequential.assemble().bytecode == parallel.assemble().bytecode);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(optimiser_iteration_budget)
+{
+	Assembly assembly;
+	for (unsigned i = 0; i < 10; ++i)
+	{
+		assembly.append(u256(i));
+		assembly.append(Instruction::POP);
+	}
+	assembly.append(Instruction::STOP);
+
+	Assembly::OptimiserSettings settings;
+	settings.runPeephole = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	Assembly unlimited = assembly;
+	unlimited.optimise(settings);
+	Assembly::OptimiserReport const& report = unlimited.optimiserReport();
+	BOOST_CHECK(report.converged);
+	BOOST_CHECK_EQUAL(report.iterations, 2);
+	BOOST_CHECK(report.passes.at("PeepholeOptimiser").changes > 0);
+	BOOST_CHECK_EQUAL(report.passes.at("PeepholeOptimiser").lastIterationChanges, 0);
+	BOOST_CHECK(report.unconvergedPasses().empty());
+
+	settings.maxIterations = 1;
+	Assembly limited = assembly;
+	limited.optimise(settings);
+	Assembly::OptimiserReport const& limitedReport = limited.optimiserReport();
+	BOOST_CHECK(!limitedReport.converged);
+	BOOST_CHECK_EQUAL(limitedReport.iterations, 1);
+	BOOST_CHECK(limitedReport.unconvergedPasses() == vector<string>{"PeepholeOptimiser"});
+}
+
+BOOST_AUTO_TEST_CASE(optimiser_shares_identical_subs)
+{
+	auto createSub = [](u256 const& _value) {
+		auto sub = make_shared<Assembly>("sub");
+		sub->append(_value);
+		sub->append(u256(0));
+		sub->append(Instruction::SSTORE);
+		sub->append(Instruction::STOP);
+		return sub;
+	};
+
+	Assembly assembly;
+	for (u256 value: {u256(1), u256(2), u256(1)})
+	{
+		auto sub = createSub(value);
+		// The same nested assembly twice, once in each of two otherwise identical subs.
+		sub->newSub(createSub(7));
+		assembly.append(assembly.newSub(sub));
+		assembly.append(Instruction::POP);
+	}
+	assembly.append(Instruction::STOP);
+
+	Assembly::OptimiserSettings settings;
+	settings.runPeephole = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	assembly.optimise(settings);
+
+	BOOST_CHECK(&assembly.sub(0) == &assembly.sub(2));
+	BOOST_CHECK(&assembly.sub(0) != &assembly.sub(1));
+	BOOST_CHECK(&assembly.sub(0).sub(0) == &assembly.sub(1).sub(0));
+	BOOST_CHECK(!assembly.assemble().bytecode.empty());
+}
+
+BOOST_AUTO_TEST_CASE(optimiser_sub_assemblies_only)
+{
+	auto appendUselessCode = [](Assembly& _assembly) {
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			_assembly.append(u256(i));
+			_assembly.append(Instruction::POP);
+		}
+		_assembly.append(Instruction::STOP);
+	};
+	// Sub-assemblies are shared between copies, so each assembly is created from scratch.
+	auto createAssembly = [&]() {
+		Assembly assembly;
+		auto sub = make_shared<Assembly>("sub");
+		appendUselessCode(*sub);
+		assembly.append(assembly.newSub(sub));
+		assembly.append(Instruction::POP);
+		appendUselessCode(assembly);
+		return assembly;
+	};
+
+	Assembly::OptimiserSettings settings;
+	settings.runPeephole = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	Assembly fullyOptimised = createAssembly();
+	fullyOptimised.optimise(settings);
+
+	Assembly assembly = createAssembly();
+	AssemblyItems const itemsBefore = assembly.items();
+	AssemblyItems const subItemsBefore = assembly.sub(0).items();
+	settings.optimiseSubAssembliesOnly = true;
+	assembly.optimise(settings);
+	BOOST_CHECK(assembly.items() == itemsBefore);
+	BOOST_CHECK(fullyOptimised.items().size() < itemsBefore.size());
+	BOOST_CHECK(assembly.sub(0).items() == fullyOptimised.sub(0).items());
+	BOOST_CHECK(assembly.sub(0).items().size() < subItemsBefore.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -131,6 +131,40 @@ BOOST_AUTO_TEST_CASE(translateLineColumnToPosition)
 	BOOST_CHECK_EQUAL(toPosition(2, 2, "ABC\nDEF\nGHI\n"), 10);
 }
 
+BOOST_AUTO_TEST_CASE(translatePositionToLineColumn)
+{
+	CharStream const stream("ABC\nDE\r\n\nF", "source");
+	auto check = [&](int _position, int _line, int _column) {
+		LineColumn const lineColumn = stream.translatePositionToLineColumn(_position);
+		BOOST_CHECK_EQUAL(lineColumn.line, _line);
+		BOOST_CHECK_EQUAL(lineColumn.column, _column);
+	};
+	check(0, 0, 0);
+	check(3, 0, 3);
+	check(4, 1, 0);
+	check(6, 1, 2);
+	check(7, 1, 3);
+	check(8, 2, 0);
+	check(9, 3, 0);
+	check(10, 3, 1);
+	// Positions past the end are clamped.
+	check(100, 3, 1);
+}
+
+BOOST_AUTO_TEST_CASE(lineAtPosition)
+{
+	CharStream const stream("ABC\nDE\r\n\nF", "source");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(0), "ABC");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(2), "ABC");
+	// Positions of line feeds belong to the line before.
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(3), "ABC");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(4), "DE");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(8), "");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(9), "F");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(100), "F");
+	BOOST_CHECK_EQUAL(CharStream("", "source").lineAtPosition(0), "");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
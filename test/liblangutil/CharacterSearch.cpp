@@ -0,0 +1,108 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the functions in liblangutil/CharacterSearch.h.
+ */
+
+#include <liblangutil/CharacterSearch.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+
+using namespace std;
+
+namespace solidity::langutil::test
+{
+
+namespace
+{
+
+/// Compares the results of all search functions with their bytewise reference implementations
+/// for every start position in @a _text.
+void checkAgainstReference(string_view _text)
+{
+	for (size_t position = 0; position <= _text.size(); ++position)
+	{
+		BOOST_CHECK_EQUAL(findEndOfWhitespace(_text, position), findEndOfWhitespaceBytewise(_text, position));
+		BOOST_CHECK_EQUAL(findLineBreakCandidate(_text, position), findLineBreakCandidateBytewise(_text, position));
+		BOOST_CHECK_EQUAL(findCharacter(_text, position, '*'), findCharacterBytewise(_text, position, '*'));
+		for (bool allowPeriod: {false, true})
+			BOOST_CHECK_EQUAL(
+				findEndOfIdentifier(_text, position, allowPeriod),
+				findEndOfIdentifierBytewise(_text, position, allowPeriod)
+			);
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CharacterSearchTest)
+
+BOOST_AUTO_TEST_CASE(whitespace)
+{
+	string const text = string(40, ' ') + "\t\r\n x";
+	BOOST_CHECK_EQUAL(findEndOfWhitespace(text, 0), 44);
+	BOOST_CHECK_EQUAL(findEndOfWhitespace(text, 44), 44);
+	BOOST_CHECK_EQUAL(findEndOfWhitespace(string(33, '\n'), 0), 33);
+	BOOST_CHECK_EQUAL(findEndOfWhitespace("", 0), 0);
+}
+
+BOOST_AUTO_TEST_CASE(line_breaks)
+{
+	string const text = string(20, 'a') + "\v" + string(20, 'b') + "\xE2\x80\xA8";
+	BOOST_CHECK_EQUAL(findLineBreakCandidate(text, 0), 20);
+	BOOST_CHECK_EQUAL(findLineBreakCandidate(text, 21), 41);
+	BOOST_CHECK_EQUAL(findLineBreakCandidate(string(50, 'x'), 3), 50);
+}
+
+BOOST_AUTO_TEST_CASE(characters)
+{
+	string const text = string(100, '/') + "*";
+	BOOST_CHECK_EQUAL(findCharacter(text, 0, '*'), 100);
+	BOOST_CHECK_EQUAL(findCharacter(text, 101, '*'), 101);
+	BOOST_CHECK_EQUAL(findCharacter(text, 200, '*'), 101);
+}
+
+BOOST_AUTO_TEST_CASE(identifiers)
+{
+	string const text = "abcdefghijklmnopqrstuvwxyz_$ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789.x\xC3\x9A";
+	BOOST_CHECK_EQUAL(findEndOfIdentifier(text, 0, false), 64);
+	BOOST_CHECK_EQUAL(findEndOfIdentifier(text, 0, true), 66);
+	BOOST_CHECK_EQUAL(findEndOfIdentifier(text, 66, true), 66);
+}
+
+BOOST_AUTO_TEST_CASE(random_input)
+{
+	// Characters that are close to the boundaries of the character classes.
+	string const alphabet = string("\t\n\v\f\r \x1f!$*./09:@AZ[_`az{\x7f") + "\x80\xC2\xE2\xFF";
+	mt19937 generator(1234);
+	uniform_int_distribution<size_t> characterDistribution(0, alphabet.size() - 1);
+	for (size_t length: {0u, 1u, 15u, 16u, 17u, 31u, 32u, 33u, 100u})
+		for (size_t run = 0; run < 20; ++run)
+		{
+			string text;
+			for (size_t i = 0; i < length; ++i)
+				text.push_back(alphabet[characterDistribution(generator)]);
+			checkAgainstReference(text);
+		}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the ErrorReporter and UniqueErrorReporter classes.
+ */
+
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/UniqueErrorReporter.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::langutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(ErrorReporterTest)
+
+BOOST_AUTO_TEST_CASE(limit_per_error_id)
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	errorReporter.setLimitPerErrorId(2);
+	SourceLocation const location{0, 1, internSourceName("a")};
+	for (int i = 0; i < 5; ++i)
+	{
+		errorReporter.warning(1234_error, location, "first");
+		errorReporter.info(2345_error, location, "second");
+		errorReporter.typeError(3456_error, location, "third");
+	}
+	BOOST_CHECK_EQUAL(errors.size(), 2 + 2 + 5);
+	BOOST_CHECK_EQUAL(errorReporter.errorCount(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(lazy_description)
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	errorReporter.setLimitPerErrorId(1);
+	SourceLocation const location{0, 1, internSourceName("a")};
+	size_t descriptionsCreated = 0;
+	for (int i = 0; i < 3; ++i)
+		errorReporter.warning(1234_error, location, [&]() { ++descriptionsCreated; return string("text"); });
+	BOOST_CHECK_EQUAL(descriptionsCreated, 1);
+	BOOST_REQUIRE_EQUAL(errors.size(), 1);
+	BOOST_CHECK_EQUAL(*errors.front()->comment(), "text");
+}
+
+BOOST_AUTO_TEST_CASE(unique_errors)
+{
+	UniqueErrorReporter errorReporter;
+	string const* source = internSourceName("a");
+	size_t descriptionsCreated = 0;
+	for (int i = 0; i < 3; ++i)
+	{
+		errorReporter.warning(1234_error, SourceLocation{0, 1, source}, "first");
+		errorReporter.warning(1234_error, SourceLocation{1, 2, source}, [&]() { ++descriptionsCreated; return string("second"); });
+		errorReporter.warning(2345_error, SourceLocation{0, 1, source}, "third");
+		errorReporter.info(2345_error, SourceLocation{0, 1, internSourceName("b")}, "fourth");
+	}
+	BOOST_CHECK_EQUAL(descriptionsCreated, 1);
+	BOOST_CHECK_EQUAL(errorReporter.errors().size(), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // end namespaces
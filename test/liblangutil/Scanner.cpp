@@ -58,6 +58,37 @@ BOOST_AUTO_TEST_CASE(smoke_test)
 	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
 }
 
+BOOST_AUTO_TEST_CASE(literals_without_escapes_are_not_copied)
+{
+	CharStream stream("abc 0x12_34 .5e3 \"x y\" \"a\\nb\" hex\"00ff\" unicode\"\xC3\x9A\"", "");
+	Scanner scanner(stream);
+	string_view const source = stream.source();
+	auto isSliceOfSource = [&](string_view _literal) {
+		return _literal.data() >= source.data() && _literal.data() + _literal.size() <= source.data() + source.size();
+	};
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK(isSliceOfSource(scanner.currentLiteral()));
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Number);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "0x12_34");
+	BOOST_CHECK(isSliceOfSource(scanner.currentLiteral()));
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Number);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), ".5e3");
+	BOOST_CHECK(isSliceOfSource(scanner.currentLiteral()));
+	BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "x y");
+	BOOST_CHECK(isSliceOfSource(scanner.currentLiteral()));
+	BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "a\nb");
+	BOOST_CHECK(!isSliceOfSource(scanner.currentLiteral()));
+	BOOST_CHECK_EQUAL(scanner.next(), Token::HexStringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), string("\x00\xff", 2));
+	BOOST_CHECK(!isSliceOfSource(scanner.currentLiteral()));
+	BOOST_CHECK_EQUAL(scanner.next(), Token::UnicodeStringLiteral);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "\xC3\x9A");
+	BOOST_CHECK(isSliceOfSource(scanner.currentLiteral()));
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
 BOOST_AUTO_TEST_CASE(assembly_assign)
 {
 	CharStream stream("let a := 1", "");
@@ -109,7 +109,7 @@ void printAssemblyLocations(AssemblyItems const& _items)
 			_loc.start <<
 			", " <<
 			_loc.end <<
-			", make_shared<string>(\"" <<
+			", internSourceName(\"" <<
 			*_loc.sourceName <<
 			"\")}) +" << endl;
 	};
@@ -167,7 +167,7 @@ BOOST_AUTO_TEST_CASE(location_test)
 	}
 	)";
 	AssemblyItems items = compileContract(make_shared<CharStream>(sourceCode, ""));
-	shared_ptr<string> sourceName = make_shared<string>();
+	string const* sourceName = internSourceName("");
 	bool hasShifts = solidity::test::CommonOptions::get().evmVersion().hasBitwiseShifting();
 
 	auto codegenCharStream = make_shared<CharStream>("", "--CODEGEN--");
@@ -25,6 +25,7 @@
 #include <libevmasm/GasMeter.h>
 
 #include <cmath>
+#include <numeric>
 
 using namespace std;
 using namespace solidity::langutil;
@@ -200,6 +201,41 @@ BOOST_AUTO_TEST_CASE(single_callvaluecheck)
 	BOOST_CHECK_EQUAL(bytecodeSizePayable - bytecodeSizeNonpayable, 26);
 }
 
+BOOST_AUTO_TEST_CASE(selector_jump_table)
+{
+	// Compares the gas used to dispatch calls to each of many functions through
+	// comparisons with the gas used to dispatch them through a jump table.
+	size_t const numFunctions = 80;
+	string sourceCode = "contract C {\n";
+	for (size_t i = 0; i < numFunctions; ++i)
+		sourceCode += "function f" + to_string(i) + "() external pure returns (uint) { return " + to_string(i) + "; }\n";
+	sourceCode += "}\n";
+
+	auto dispatchGas = [&](size_t _jumpTableThreshold) {
+		m_optimiserSettings.selectorJumpTableThreshold = _jumpTableThreshold;
+		compileAndRun(sourceCode);
+		vector<u256> gas;
+		for (size_t i = 0; i < numFunctions; ++i)
+		{
+			BOOST_CHECK(callContractFunction("f" + to_string(i) + "()") == encodeArgs(i));
+			gas.push_back(m_gasUsed);
+		}
+		callContractFunction("g()");
+		BOOST_CHECK(!m_transactionSuccessful);
+		return gas;
+	};
+	vector<u256> comparisonGas = dispatchGas(0);
+	vector<u256> jumpTableGas = dispatchGas(numFunctions);
+
+	u256 const totalComparisonGas = accumulate(comparisonGas.begin(), comparisonGas.end(), u256(0));
+	u256 const totalJumpTableGas = accumulate(jumpTableGas.begin(), jumpTableGas.end(), u256(0));
+	BOOST_TEST_MESSAGE(
+		"Average gas per call with comparisons: " + (totalComparisonGas / numFunctions).str() +
+		", with a jump table: " + (totalJumpTableGas / numFunctions).str()
+	);
+	BOOST_CHECK(totalJumpTableGas < totalComparisonGas);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
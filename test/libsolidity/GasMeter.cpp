@@ -22,6 +22,7 @@
  */
 
 #include <test/libsolidity/SolidityExecutionFramework.h>
+#include <libevmasm/BlockGasMeter.h>
 #include <libevmasm/GasMeter.h>
 #include <libevmasm/KnownState.h>
 #include <libevmasm/PathGasMeter.h>
@@ -338,6 +339,63 @@ BOOST_AUTO_TEST_CASE(complex_control_flow)
 	testRunTimeGas("ln(int128)", vector<bytes>{encodeArgs(0), encodeArgs(10), encodeArgs(105), encodeArgs(30000)});
 }
 
+BOOST_AUTO_TEST_CASE(block_gas_meter)
+{
+	auto jump = [](AssemblyItem::JumpType _jumpType) {
+		AssemblyItem item(Instruction::JUMP);
+		item.setJumpType(_jumpType);
+		return item;
+	};
+	// Calls the function at tag 3 twice, which the path based estimation does not allow.
+	AssemblyItems items{
+		AssemblyItem(PushTag, 1),
+		u256(5),
+		AssemblyItem(PushTag, 3),
+		jump(AssemblyItem::JumpType::IntoFunction),
+		AssemblyItem(Tag, 1),
+		AssemblyItem(PushTag, 2),
+		Instruction::SWAP1,
+		AssemblyItem(PushTag, 3),
+		jump(AssemblyItem::JumpType::IntoFunction),
+		AssemblyItem(Tag, 2),
+		Instruction::STOP,
+		AssemblyItem(Tag, 3),
+		u256(1),
+		Instruction::ADD,
+		Instruction::SWAP1,
+		jump(AssemblyItem::JumpType::OutOfFunction)
+	};
+	BOOST_CHECK(PathGasMeter::estimateMax(items, m_evmVersion, 0, make_shared<KnownState>()).isInfinite);
+
+	GasMeter::GasConsumption blockGas = BlockGasMeter::estimateMax(items, m_evmVersion, 0);
+	BOOST_REQUIRE(!blockGas.isInfinite);
+	BOOST_CHECK_EQUAL(blockGas.value, 72);
+	GasMeter::GasConsumption functionGas = BlockGasMeter::estimateMax(items, m_evmVersion, 11);
+	BOOST_REQUIRE(!functionGas.isInfinite);
+	BOOST_CHECK_EQUAL(functionGas.value, 18);
+
+	// Without steps left for the exact estimation, the estimator falls back to the basic blocks.
+	GasMeter::GasConsumption fallbackGas = GasEstimator(m_evmVersion, 0).functionalEstimation(items);
+	BOOST_REQUIRE(!fallbackGas.isInfinite);
+	BOOST_CHECK_EQUAL(fallbackGas.value, 72);
+}
+
+BOOST_AUTO_TEST_CASE(block_gas_meter_loop)
+{
+	char const* sourceCode = R"(
+		contract test {
+			uint data;
+			function f(uint x) public {
+				for (uint i = 0; i < x; i++)
+					data += i;
+			}
+		}
+	)";
+	compile(sourceCode);
+	AssemblyItems const& items = *m_compiler.runtimeAssemblyItems(m_compiler.lastContractName());
+	BOOST_CHECK(BlockGasMeter::estimateMax(items, m_evmVersion, 0).isInfinite);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -25,9 +25,14 @@
 #include <test/Common.h>
 
 #include <liblangutil/Exceptions.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/ImportRemapper.h>
 
+#include <libsolutil/JSON.h>
+
 #include <boost/test/unit_test.hpp>
 
 #include <string>
@@ -37,6 +42,21 @@ using namespace std;
 namespace solidity::frontend::test
 {
 
+namespace
+{
+
+/// @returns the metadata and the bytecode of the contract "C" compiled from @a _sources.
+pair<string, bytes> compileWithoutCache(map<string, string> const& _sources)
+{
+	CompilerStack compilerStack;
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setSources(_sources);
+	BOOST_REQUIRE(compilerStack.compile());
+	return {compilerStack.metadata("C"), compilerStack.object("C").bytecode};
+}
+
+}
+
 BOOST_AUTO_TEST_SUITE(SolidityImports)
 
 BOOST_AUTO_TEST_CASE(remappings)
@@ -113,6 +133,281 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(remapping_longest_context_and_prefix)
+{
+	ImportRemapper remapper;
+	remapper.setRemappings({
+		{"", "x", "a"},
+		{"", "x/y", "b"},
+		{"c", "x", "c"},
+		{"c/d", "z", "d"},
+		{"", "x/y", "e"}
+	});
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", ""), "e/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("x/z/f.sol", "g.sol"), "a/z/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", "c/g.sol"), "c/y/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", "c/d/g.sol"), "c/y/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("z/f.sol", "c/d/g.sol"), "d/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("z/f.sol", "c/g.sol"), "z/f.sol");
+
+	remapper.setRemappings({{"", "x/y", "h"}});
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", ""), "h/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", "c/g.sol"), "h/f.sol");
+	remapper.clear();
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", ""), "x/y/f.sol");
+}
+
+BOOST_AUTO_TEST_CASE(ast_cache_reuses_unchanged_sources)
+{
+	string const library = "library L { function f(uint x) internal pure returns (uint) { return x + 1; } } pragma solidity >=0.0;";
+	string const mainVersion1 = "import \"a.sol\"; contract C { function g() public pure returns (uint) { return L.f(1); } } pragma solidity >=0.0;";
+	string const mainVersion2 = "import \"a.sol\"; contract C { function g() public pure returns (uint) { return L.f(2) + 3; } } pragma solidity >=0.0;";
+	auto const [expectedMetadata, expectedBytecode] = compileWithoutCache({{"a.sol", library}, {"b.sol", mainVersion2}});
+
+	CompilerStack c;
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	c.enableASTCache();
+	c.setSources({{"a.sol", library}, {"b.sol", mainVersion1}});
+	BOOST_REQUIRE(c.compile());
+	SourceUnit const* libraryAST = &c.ast("a.sol");
+	SourceUnit const* mainAST = &c.ast("b.sol");
+	string const metadata = c.metadata("C");
+
+	c.reset(true);
+	c.setSources({{"a.sol", library}, {"b.sol", mainVersion1}});
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(&c.ast("a.sol") == libraryAST);
+	BOOST_CHECK(&c.ast("b.sol") == mainAST);
+	BOOST_CHECK_EQUAL(c.metadata("C"), metadata);
+
+	c.reset(true);
+	c.setSources({{"a.sol", library}, {"b.sol", mainVersion2}});
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(&c.ast("a.sol") == libraryAST);
+	BOOST_CHECK_EQUAL(c.metadata("C"), expectedMetadata);
+	BOOST_CHECK(c.object("C").bytecode == expectedBytecode);
+}
+
+BOOST_AUTO_TEST_CASE(ast_cache_reuses_analysis_of_unchanged_imports)
+{
+	string const library = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		library L {
+			struct S { uint x; }
+			function f(S memory s) internal pure returns (uint) { return s.x + 1; }
+		}
+	)";
+	string const libraryVersion2 = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		library L {
+			struct S { uint x; }
+			function f(S memory s) internal pure returns (uint) { return s.x + 2; }
+		}
+	)";
+	string const main = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		import "a.sol";
+		contract C {
+			function g(L.S memory s) public pure returns (uint) { return L.f(s); }
+		}
+	)";
+	string const mainVersion2 = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		import "a.sol";
+		contract C {
+			function g(L.S memory s) public pure returns (uint) { return L.f(s) * 7; }
+		}
+	)";
+	auto const [expectedMetadata2, expectedBytecode2] = compileWithoutCache({{"a.sol", library}, {"b.sol", mainVersion2}});
+	auto const [expectedMetadata3, expectedBytecode3] = compileWithoutCache({{"a.sol", libraryVersion2}, {"b.sol", mainVersion2}});
+
+	// Types are only created anew if a declaration is analysed again.
+	auto const parameterType = [](SourceUnit const& _sourceUnit) {
+		ContractDefinition const* contract = ASTNode::filteredNodes<ContractDefinition>(_sourceUnit.nodes()).front();
+		return contract->definedFunctions().front()->parameters().front()->annotation().type;
+	};
+
+	CompilerStack c;
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	c.enableASTCache();
+	c.setSources({{"a.sol", library}, {"b.sol", main}});
+	BOOST_REQUIRE(c.compile());
+	Type const* libraryParameterType = parameterType(c.ast("a.sol"));
+
+	// Only the changed main source is analysed again.
+	c.reset(true);
+	c.setSources({{"a.sol", library}, {"b.sol", mainVersion2}});
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(parameterType(c.ast("a.sol")) == libraryParameterType);
+	BOOST_CHECK_EQUAL(c.metadata("C"), expectedMetadata2);
+	BOOST_CHECK(c.object("C").bytecode == expectedBytecode2);
+	SourceUnit const* mainAST = &c.ast("b.sol");
+
+	// The unchanged main source is not parsed again, but it is analysed again,
+	// because it imports the changed library.
+	c.reset(true);
+	c.setSources({{"a.sol", libraryVersion2}, {"b.sol", mainVersion2}});
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(&c.ast("b.sol") == mainAST);
+	BOOST_CHECK_EQUAL(c.metadata("C"), expectedMetadata3);
+	BOOST_CHECK(c.object("C").bytecode == expectedBytecode3);
+}
+
+BOOST_AUTO_TEST_CASE(ast_cache_reuses_artifacts_of_unchanged_contracts)
+{
+	string const base = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		/// @title Base
+		contract A {
+			struct S { uint x; }
+			S s;
+			/// @notice Returns x.
+			function f() public view returns (uint) { return s.x; }
+		}
+	)";
+	string const baseVersion2 = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		/// @title Base
+		contract A {
+			struct S { uint x; uint y; }
+			S s;
+			/// @notice Returns y.
+			function f() public view returns (uint) { return s.y; }
+		}
+	)";
+	auto const derived = [](string const& _body) {
+		return "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"a.sol\";\ncontract B is A { " + _body + " }";
+	};
+	auto const expectedArtifacts = [](map<string, string> const& _sources, string const& _contract) {
+		CompilerStack compilerStack;
+		compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		compilerStack.setSources(_sources);
+		BOOST_REQUIRE(compilerStack.parseAndAnalyze());
+		return vector<Json::Value>{
+			compilerStack.contractABI(_contract),
+			compilerStack.storageLayout(_contract),
+			compilerStack.natspecUser(_contract),
+			compilerStack.natspecDev(_contract)
+		};
+	};
+	auto const artifacts = [](CompilerStack const& _compilerStack, string const& _contract) {
+		return vector<Json::Value>{
+			_compilerStack.contractABI(_contract),
+			_compilerStack.storageLayout(_contract),
+			_compilerStack.natspecUser(_contract),
+			_compilerStack.natspecDev(_contract)
+		};
+	};
+
+	CompilerStack c;
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	c.enableASTCache();
+	for (auto const& sources: vector<map<string, string>>{
+		{{"a.sol", base}, {"b.sol", derived("uint t;")}},
+		// Unchanged sources.
+		{{"a.sol", base}, {"b.sol", derived("uint t;")}},
+		// Changed derived contract.
+		{{"a.sol", base}, {"b.sol", derived("uint t; function g() public {}")}},
+		// Changed base contract.
+		{{"a.sol", baseVersion2}, {"b.sol", derived("uint t; function g() public {}")}},
+	})
+	{
+		c.reset(true);
+		c.setSources(sources);
+		BOOST_REQUIRE(c.parseAndAnalyze());
+		for (string const contract: {"A", "B"})
+			BOOST_CHECK(artifacts(c, contract) == expectedArtifacts(sources, contract));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing_numbers_nodes_sequentially)
+{
+	map<string, string> const sources{
+		{"a.sol", R"(
+			// SPDX-License-Identifier: GPL-3.0
+			pragma solidity >=0.0;
+			import "c.sol";
+			/// @title Library
+			library L {
+				struct S { uint x; }
+				/// @dev Increments.
+				function f(uint x) internal pure returns (uint y) {
+					uint[2] memory a;
+					a[1] = x;
+					assembly { y := add(mload(add(a, 0x20)), 1) }
+				}
+			}
+		)"},
+		{"b.sol", R"(
+			// SPDX-License-Identifier: GPL-3.0
+			pragma solidity >=0.0;
+			import {L as M} from "a.sol";
+			contract C is D {
+				function g() public pure returns (uint) { M.S[] memory s; return M.f(s.length + h()); }
+			}
+		)"},
+	};
+	// Only found through the import in "a.sol".
+	string const imported = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		contract D { function h() internal pure returns (uint) { return 7; } }
+	)";
+	ReadCallback::Callback readFile = [&](string const&, string const& _path) {
+		return ReadCallback::Result{_path == "c.sol", imported};
+	};
+
+	auto const compile = [&](size_t _parallelism) {
+		CompilerStack c(readFile);
+		c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		c.setParallelism(_parallelism);
+		c.setSources(sources);
+		BOOST_REQUIRE(c.compile());
+		vector<string> result;
+		for (char const* name: {"a.sol", "b.sol", "c.sol"})
+			result.push_back(util::jsonCompactPrint(ASTJsonConverter(c.state()).toJson(c.ast(name))));
+		result.push_back(c.metadata("C"));
+		result.push_back(util::toHex(c.object("C").bytecode));
+		return result;
+	};
+	vector<string> const sequential = compile(1);
+	BOOST_CHECK(compile(4) == sequential);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_analysis_reports_errors_in_source_order)
+{
+	map<string, string> sources;
+	for (char const* name: {"a.sol", "b.sol", "c.sol", "d.sol", "e.sol"})
+		sources[name] = R"(
+			// SPDX-License-Identifier: GPL-3.0
+			pragma solidity >=0.0;
+			struct S { uint[2**64] a; }
+			contract C { S s; function f() public pure { uint unused; uint alsoUnused; } }
+		)";
+
+	auto const analyze = [&](size_t _parallelism) {
+		CompilerStack c;
+		c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		c.setParallelism(_parallelism);
+		c.setSources(sources);
+		BOOST_REQUIRE(c.parseAndAnalyze());
+		vector<string> result;
+		for (auto const& error: c.errors())
+			result.push_back(langutil::SourceReferenceFormatter::formatErrorInformation(*error, c));
+		return result;
+	};
+	vector<string> const sequential = analyze(1);
+	// Two warnings about unused variables and two about the size of the storage variable.
+	BOOST_CHECK_EQUAL(sequential.size(), 4 * sources.size());
+	BOOST_CHECK(analyze(4) == sequential);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,244 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the language server.
+ */
+
+#include <libsolidity/lsp/LanguageServer.h>
+#include <libsolidity/lsp/Transport.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <deque>
+#include <sstream>
+
+using namespace std;
+using namespace solidity::lsp;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Transport that hands out a fixed list of messages and records the messages sent.
+class MockTransport: public Transport
+{
+public:
+	bool closed() const noexcept override { return input.empty(); }
+	optional<Json::Value> receive() override
+	{
+		Json::Value message = move(input.front());
+		input.pop_front();
+		return message;
+	}
+
+	void request(int _id, string const& _method, Json::Value _params = Json::objectValue)
+	{
+		Json::Value message;
+		message["id"] = _id;
+		message["method"] = _method;
+		message["params"] = move(_params);
+		input.push_back(move(message));
+	}
+	void notification(string const& _method, Json::Value _params = Json::objectValue)
+	{
+		Json::Value message;
+		message["method"] = _method;
+		message["params"] = move(_params);
+		input.push_back(move(message));
+	}
+
+	/// @returns the response to the request with the given ID.
+	Json::Value response(int _id) const
+	{
+		for (Json::Value const& message: output)
+			if (message["id"] == _id)
+				return message;
+		BOOST_FAIL("No response to request " + to_string(_id) + ".");
+		return {};
+	}
+	/// @returns the diagnostics published last for @a _uri.
+	Json::Value diagnostics(string const& _uri) const
+	{
+		for (auto message = output.rbegin(); message != output.rend(); ++message)
+			if ((*message)["method"] == "textDocument/publishDiagnostics" && (*message)["params"]["uri"] == _uri)
+				return (*message)["params"]["diagnostics"];
+		BOOST_FAIL("No diagnostics for " + _uri + ".");
+		return {};
+	}
+
+	deque<Json::Value> input;
+	vector<Json::Value> output;
+
+protected:
+	void send(Json::Value _message) override { output.push_back(move(_message)); }
+};
+
+Json::Value initializeParams()
+{
+	Json::Value params;
+	params["rootUri"] = "file:///project";
+	return params;
+}
+
+Json::Value didOpenParams(string const& _uri, string const& _text)
+{
+	Json::Value params;
+	params["textDocument"]["uri"] = _uri;
+	params["textDocument"]["text"] = _text;
+	return params;
+}
+
+Json::Value position(int _line, int _character)
+{
+	Json::Value result;
+	result["line"] = _line;
+	result["character"] = _character;
+	return result;
+}
+
+string const preamble = "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\n";
+
+}
+
+BOOST_AUTO_TEST_SUITE(LanguageServerTest)
+
+BOOST_AUTO_TEST_CASE(transport_framing)
+{
+	istringstream input("Content-Length: 34\r\n\r\n{\"id\":1,\"method\":\"shutdown\",\"x\":1}");
+	ostringstream output;
+	IOStreamTransport transport(input, output);
+
+	optional<Json::Value> message = transport.receive();
+	BOOST_REQUIRE(message);
+	BOOST_CHECK_EQUAL((*message)["method"].asString(), "shutdown");
+	BOOST_CHECK_EQUAL((*message)["id"].asInt(), 1);
+
+	transport.reply(1, Json::nullValue);
+	string const content = "{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":null}";
+	BOOST_CHECK_EQUAL(output.str(), "Content-Length: " + to_string(content.size()) + "\r\n\r\n" + content);
+
+	BOOST_CHECK(!transport.receive());
+	BOOST_CHECK(transport.closed());
+}
+
+BOOST_AUTO_TEST_CASE(lifecycle)
+{
+	MockTransport client;
+	client.request(1, "textDocument/definition");
+	client.request(2, "initialize", initializeParams());
+	client.notification("initialized");
+	client.request(3, "unknown/method");
+	client.notification("$/unknownNotification");
+	client.request(4, "shutdown");
+	client.notification("exit");
+	// Not processed anymore.
+	client.request(5, "shutdown");
+
+	BOOST_CHECK(LanguageServer(client).run());
+	BOOST_CHECK_EQUAL(client.response(1)["error"]["code"].asInt(), static_cast<int>(ErrorCode::ServerNotInitialized));
+	BOOST_CHECK(client.response(2)["result"]["capabilities"]["definitionProvider"].asBool());
+	BOOST_CHECK_EQUAL(client.response(3)["error"]["code"].asInt(), static_cast<int>(ErrorCode::MethodNotFound));
+	BOOST_CHECK(client.response(4)["result"].isNull());
+	BOOST_CHECK_EQUAL(client.output.size(), 4);
+
+	MockTransport exitWithoutShutdown;
+	exitWithoutShutdown.request(1, "initialize", initializeParams());
+	exitWithoutShutdown.notification("exit");
+	BOOST_CHECK(!LanguageServer(exitWithoutShutdown).run());
+}
+
+BOOST_AUTO_TEST_CASE(diagnostics_follow_edits)
+{
+	string const uri = "file:///project/c.sol";
+	MockTransport client;
+	client.request(1, "initialize", initializeParams());
+	client.notification("textDocument/didOpen", didOpenParams(
+		uri,
+		preamble + "contract C { function h() public pure returns (uint) { return x; } }"
+	));
+
+	LanguageServer server(client);
+	server.run();
+	Json::Value diagnostics = client.diagnostics(uri);
+	BOOST_REQUIRE_EQUAL(diagnostics.size(), 1);
+	BOOST_CHECK_EQUAL(diagnostics[0]["severity"].asInt(), 1);
+	BOOST_CHECK_EQUAL(diagnostics[0]["code"].asInt(), 7576);
+	BOOST_CHECK(diagnostics[0]["message"].asString().rfind("Undeclared identifier.", 0) == 0);
+	BOOST_CHECK(diagnostics[0]["range"]["start"] == position(2, 62));
+	BOOST_CHECK(diagnostics[0]["range"]["end"] == position(2, 63));
+
+	Json::Value change;
+	change["range"]["start"] = position(2, 62);
+	change["range"]["end"] = position(2, 63);
+	change["text"] = "1";
+	Json::Value params;
+	params["textDocument"]["uri"] = uri;
+	params["contentChanges"].append(change);
+	client.notification("textDocument/didChange", params);
+	server.run();
+	BOOST_CHECK_EQUAL(client.diagnostics(uri).size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(definition_in_imported_document)
+{
+	string const baseUri = "file:///project/a.sol";
+	string const derivedUri = "file:///project/b.sol";
+	MockTransport client;
+	client.request(1, "initialize", initializeParams());
+	client.notification("textDocument/didOpen", didOpenParams(
+		baseUri,
+		preamble + "contract A { function f() internal pure {} }"
+	));
+	client.notification("textDocument/didOpen", didOpenParams(
+		derivedUri,
+		preamble + "import \"a.sol\";\ncontract B is A { function g() public pure { f(); } }"
+	));
+	Json::Value params;
+	params["textDocument"]["uri"] = derivedUri;
+	params["position"] = position(3, 45);
+	client.request(2, "textDocument/definition", params);
+	params["position"] = position(2, 9);
+	client.request(3, "textDocument/definition", params);
+	params["position"] = position(3, 1);
+	client.request(4, "textDocument/definition", params);
+
+	LanguageServer(client).run();
+	BOOST_CHECK_EQUAL(client.diagnostics(baseUri).size(), 0);
+	BOOST_CHECK_EQUAL(client.diagnostics(derivedUri).size(), 0);
+
+	Json::Value function = client.response(2)["result"];
+	BOOST_REQUIRE_EQUAL(function.size(), 1);
+	BOOST_CHECK_EQUAL(function[0]["uri"].asString(), baseUri);
+	BOOST_CHECK(function[0]["range"]["start"] == position(2, 22));
+	BOOST_CHECK(function[0]["range"]["end"] == position(2, 23));
+
+	Json::Value import = client.response(3)["result"];
+	BOOST_REQUIRE_EQUAL(import.size(), 1);
+	BOOST_CHECK_EQUAL(import[0]["uri"].asString(), baseUri);
+	BOOST_CHECK(import[0]["range"]["start"] == position(0, 0));
+
+	BOOST_CHECK_EQUAL(client.response(4)["result"].size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -20,7 +20,11 @@
  * Unit tests for libsolc/libsolc.cpp.
  */
 
+#include <cstring>
+#include <map>
 #include <string>
+#include <thread>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <libsolutil/JSON.h>
 #include <libsolidity/interface/ReadFile.h>
@@ -65,6 +69,45 @@ Json::Value compile(string const& _input, CStyleReadFileCallback _callback = nul
 	return ret;
 }
 
+/// Compiles @a _input with @a _compiler and @returns the output without parsing it.
+/// Does not use the test framework, so that it can be called from other threads.
+string compileWithCompiler(
+	solidity_compiler* _compiler,
+	string const& _input,
+	CStyleReadFileCallback _callback = nullptr,
+	void* _context = nullptr
+)
+{
+	char* output_ptr = solidity_compiler_compile(_compiler, _input.c_str(), _callback, _context);
+	if (!output_ptr)
+		return {};
+	string output(output_ptr);
+	solidity_free(output_ptr);
+	return output;
+}
+
+Json::Value parseOutput(string const& _output)
+{
+	Json::Value ret;
+	BOOST_REQUIRE(util::jsonParseStrict(_output, ret));
+	return ret;
+}
+
+char const* bytecodeInput = R"(
+{
+	"language": "Solidity",
+	"sources": {
+		"fileA": {
+			"content": "contract A { function f(uint x) public pure returns (uint) { return x * 7; } }"
+		}
+	},
+	"settings": {
+		"optimizer": { "enabled": true },
+		"outputSelection": { "*": { "*": ["evm.bytecode.object", "evm.deployedBytecode.object"] } }
+	}
+}
+)";
+
 char* stringToSolidity(string const& _input)
 {
 	char* ptr = solidity_alloc(_input.length());
@@ -179,6 +222,145 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
 }
 
+BOOST_AUTO_TEST_CASE(compiler_reuse)
+{
+	solidity_compiler* compiler = solidity_compiler_create();
+	BOOST_REQUIRE(compiler != nullptr);
+
+	Json::Value expectation = compile(bytecodeInput);
+	BOOST_REQUIRE(!expectation.isMember("errors"));
+	BOOST_REQUIRE(!expectation["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString().empty());
+	for (size_t i = 0; i < 3; ++i)
+		BOOST_CHECK(parseOutput(compileWithCompiler(compiler, bytecodeInput)) == expectation);
+
+	solidity_compiler_destroy(compiler);
+	solidity_compiler_destroy(nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(compiler_with_callback)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {
+				"urls": ["found.sol"]
+			}
+		}
+	}
+	)";
+
+	CStyleReadFileCallback callback{
+		[](void* _context, char const*, char const* _path, char** o_contents, char** o_error)
+		{
+			++*static_cast<size_t*>(_context);
+			*o_error = nullptr;
+			*o_contents = string(_path) == "found.sol" ? stringToSolidity("contract B {}") : nullptr;
+		}
+	};
+
+	solidity_compiler* compiler = solidity_compiler_create();
+	BOOST_REQUIRE(compiler != nullptr);
+	size_t calls = 0;
+	Json::Value result = parseOutput(compileWithCompiler(compiler, input, callback, &calls));
+	BOOST_CHECK(!result.isMember("errors"));
+	BOOST_CHECK(result["sources"].isMember("fileA"));
+	BOOST_CHECK_EQUAL(calls, 1);
+
+	// The callback is only used for the compilation it was passed to.
+	result = parseOutput(compileWithCompiler(compiler, input));
+	BOOST_CHECK(containsError(result, "JSONError", "No import callback supplied, but URL is requested."));
+	BOOST_CHECK_EQUAL(calls, 1);
+	solidity_compiler_destroy(compiler);
+}
+
+BOOST_AUTO_TEST_CASE(compilers_in_parallel)
+{
+	solidity_compiler* reference = solidity_compiler_create();
+	BOOST_REQUIRE(reference != nullptr);
+	string expectation = compileWithCompiler(reference, bytecodeInput);
+	solidity_compiler_destroy(reference);
+	BOOST_REQUIRE(!parseOutput(expectation).isMember("errors"));
+
+	size_t const threadCount = 4;
+	size_t const compilationsPerThread = 3;
+	vector<vector<string>> outputs(threadCount);
+	vector<thread> threads;
+	for (size_t i = 0; i < threadCount; ++i)
+		threads.emplace_back([&, i]() {
+			solidity_compiler* compiler = solidity_compiler_create();
+			if (!compiler)
+				return;
+			for (size_t j = 0; j < compilationsPerThread; ++j)
+				outputs[i].emplace_back(compileWithCompiler(compiler, bytecodeInput));
+			solidity_compiler_destroy(compiler);
+		});
+	for (thread& t: threads)
+		t.join();
+
+	for (vector<string> const& threadOutputs: outputs)
+	{
+		BOOST_REQUIRE_EQUAL(threadOutputs.size(), compilationsPerThread);
+		for (string const& output: threadOutputs)
+			BOOST_CHECK(output == expectation);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(compiler_with_batched_callback)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": {
+				"content": "import \"b.sol\"; import \"c.sol\"; contract A { }"
+			}
+		}
+	}
+	)";
+
+	CStyleReadFilesCallback callback{
+		[](void* _context, char const* _kind, size_t _count, char const* const* _data, solidity_read_request* _request)
+		{
+			auto& batches = *static_cast<vector<vector<string>>*>(_context);
+			batches.emplace_back(_data, _data + _count);
+			// The results may be passed after the callback returned, from another thread.
+			thread([kind = string(_kind), paths = batches.back(), _request]() {
+				map<string, string> files{
+					{"b.sol", "import \"d.sol\"; contract B { }"},
+					{"c.sol", "import \"d.sol\"; import \"missing.sol\"; contract C { }"},
+					{"d.sol", "contract D { }"}
+				};
+				for (size_t i = paths.size(); i > 0; --i)
+				{
+					char* contents = nullptr;
+					if (kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile) && files.count(paths[i - 1]))
+					{
+						string const& content = files.at(paths[i - 1]);
+						contents = solidity_alloc(content.size());
+						std::memcpy(contents, content.data(), content.size());
+					}
+					solidity_read_request_complete(_request, i - 1, contents, nullptr);
+				}
+			}).detach();
+		}
+	};
+
+	solidity_compiler* compiler = solidity_compiler_create();
+	BOOST_REQUIRE(compiler != nullptr);
+	vector<vector<string>> batches;
+	char* output_ptr = solidity_compiler_compile_batched(compiler, input, callback, &batches);
+	BOOST_REQUIRE(output_ptr != nullptr);
+	Json::Value result = parseOutput(output_ptr);
+	solidity_free(output_ptr);
+	solidity_compiler_destroy(compiler);
+
+	// The imports of every round of parsing are requested at once.
+	BOOST_CHECK(batches == (vector<vector<string>>{{"b.sol", "c.sol"}, {"d.sol", "missing.sol"}}));
+	BOOST_CHECK(result["sources"].isMember("d.sol"));
+	BOOST_CHECK(containsError(result, "ParserError", "Source \"missing.sol\" not found: Callback not supported."));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,170 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the collector of Yul functions and the cache shared between collectors.
+ */
+
+#include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <optional>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Creates functions "f<n>" that request "f<n - 1>" and "f<n - 2>" and counts how often each
+/// function is generated. "c<n>" is like "f<n>", but depends on the contract and requests "f<n>".
+class TestFunctions
+{
+public:
+	explicit TestFunctions(MultiUseYulFunctionCollector& _collector): m_collector(_collector) {}
+
+	string shared(size_t _n)
+	{
+		string name = "f" + to_string(_n);
+		return m_collector.createSharedFunction(name, [&, name]() {
+			++generated[name];
+			string body;
+			if (_n >= 1)
+				body += shared(_n - 1) + "() ";
+			if (_n >= 2)
+				body += shared(_n - 2) + "() ";
+			// Recursive functions request themselves.
+			if (_n == 3)
+				body += shared(3) + "() ";
+			return "function " + name + "() { " + body + "}\n";
+		});
+	}
+
+	string sharedWithContractDependency(size_t _n)
+	{
+		string name = "g" + to_string(_n);
+		return m_collector.createSharedFunction(name, [&, name](vector<string>& _args, vector<string>&) {
+			++generated[name];
+			_args.push_back("x");
+			return contractSpecific(_n) + "(x)";
+		});
+	}
+
+	string contractSpecific(size_t _n)
+	{
+		string name = "c" + to_string(_n);
+		return m_collector.createFunction(name, [&, name]() {
+			++generated[name];
+			return "function " + name + "() { " + shared(_n) + "() }\n";
+		});
+	}
+
+	map<string, size_t> generated;
+
+private:
+	MultiUseYulFunctionCollector& m_collector;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(MultiUseYulFunctionCollectorTest)
+
+BOOST_AUTO_TEST_CASE(cached_functions_are_added_in_the_same_order)
+{
+	MultiUseYulFunctionCache cache;
+
+	MultiUseYulFunctionCollector uncached;
+	TestFunctions uncachedFunctions(uncached);
+	uncachedFunctions.shared(2);
+	uncachedFunctions.shared(5);
+	string const expectation = uncached.requestedFunctions();
+
+	MultiUseYulFunctionCollector first;
+	first.setCache(&cache);
+	TestFunctions firstFunctions(first);
+	firstFunctions.shared(5);
+	BOOST_CHECK_EQUAL(firstFunctions.generated.size(), 6);
+	BOOST_CHECK_EQUAL(cache.size(), 6);
+
+	MultiUseYulFunctionCollector second;
+	second.setCache(&cache);
+	TestFunctions secondFunctions(second);
+	secondFunctions.shared(2);
+	secondFunctions.shared(5);
+	BOOST_CHECK(secondFunctions.generated.empty());
+	BOOST_CHECK_EQUAL(second.requestedFunctions(), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(functions_depending_on_the_contract_are_not_cached)
+{
+	MultiUseYulFunctionCache cache;
+	for (size_t run = 0; run < 2; ++run)
+	{
+		MultiUseYulFunctionCollector collector;
+		collector.setCache(&cache);
+		TestFunctions functions(collector);
+		functions.sharedWithContractDependency(1);
+		// The functions requested by the contract specific function are still shared.
+		BOOST_CHECK_EQUAL(functions.generated["g1"], 1);
+		BOOST_CHECK_EQUAL(functions.generated["c1"], 1);
+		BOOST_CHECK_EQUAL(functions.generated["f1"], run == 0 ? 1 : 0);
+		BOOST_CHECK_EQUAL(functions.generated["f0"], run == 0 ? 1 : 0);
+		BOOST_CHECK(collector.contains("f0"));
+		string const code = collector.requestedFunctions();
+		BOOST_CHECK(code.find("function g1(x)") != string::npos);
+		BOOST_CHECK(code.find("function f0()") < code.find("function f1()"));
+	}
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(recorded_functions_are_added_from_the_cache)
+{
+	MultiUseYulFunctionCache cache;
+
+	MultiUseYulFunctionCollector first;
+	first.setCache(&cache);
+	TestFunctions firstFunctions(first);
+	firstFunctions.shared(1);
+	first.startRecording();
+	firstFunctions.shared(3);
+	firstFunctions.shared(0);
+	optional<vector<string>> recorded = first.stopRecording();
+	BOOST_REQUIRE(recorded);
+	BOOST_CHECK(*recorded == vector<string>({"f3", "f0"}));
+	string const expectation = first.requestedFunctions();
+
+	MultiUseYulFunctionCollector second;
+	second.setCache(&cache);
+	TestFunctions secondFunctions(second);
+	secondFunctions.shared(1);
+	second.addCachedFunctions(*recorded);
+	BOOST_CHECK(secondFunctions.generated["f1"] == 0);
+	BOOST_CHECK_EQUAL(second.requestedFunctions(), expectation);
+
+	// Recordings including functions that depend on the contract cannot be used elsewhere.
+	second.startRecording();
+	secondFunctions.sharedWithContractDependency(2);
+	BOOST_CHECK(!second.stopRecording());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
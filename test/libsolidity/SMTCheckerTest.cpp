@@ -58,9 +58,21 @@ SMTCheckerTest::SMTCheckerTest(string const& _filename): SyntaxTest(_filename, E
 	else
 		BOOST_THROW_EXCEPTION(runtime_error("Invalid SMT engine choice."));
 
+	if (size_t iterations = m_reader.sizetSetting("SMTBMCLoopIterations", 0))
+		m_modelCheckerSettings.bmcLoopIterations = static_cast<unsigned>(iterations);
+
 	if (m_modelCheckerSettings.solvers.none() || m_modelCheckerSettings.engine.none())
 		m_shouldRun = false;
 
+	if (auto const& fixtureDirectory = solidity::test::CommonOptions::get().smtFixtureDirectory; !fixtureDirectory.empty())
+	{
+		m_modelCheckerSettings.queryCacheDirectory = fixtureDirectory.string();
+		m_modelCheckerSettings.queryCacheMode =
+			solidity::test::CommonOptions::get().recordSMTFixtures ?
+			smtutil::QueryCache::Mode::Record :
+			smtutil::QueryCache::Mode::Replay;
+	}
+
 	auto const& ignoreCex = m_reader.stringSetting("SMTIgnoreCex", "no");
 	if (ignoreCex == "no")
 		m_ignoreCex = false;
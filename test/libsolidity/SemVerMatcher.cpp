@@ -50,7 +50,7 @@ SemVerMatchExpression parseExpression(string const& _input)
 	while (scanner.currentToken() != Token::EOS)
 	{
 		auto token = scanner.currentToken();
-		string literal = scanner.currentLiteral();
+		string literal{scanner.currentLiteral()};
 		if (literal.empty() && TokenTraits::toString(token))
 			literal = TokenTraits::toString(token);
 		literals.push_back(literal);
@@ -22,6 +22,10 @@
 #include <test/Metadata.h>
 #include <test/Common.h>
 
+#include <libsolidity/codegen/ir/Common.h>
+
+#include <libyul/AssemblyStack.h>
+
 #include <boost/test/unit_test.hpp>
 
 using namespace std;
@@ -51,6 +55,97 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(via_ir_bytecode_matches_optimized_ir)
+{
+	char const* sourceCode = R"(
+		contract D {
+			uint public x;
+			constructor(uint _x) { x = _x; }
+		}
+		contract C {
+			D d;
+			constructor() { d = new D(3); }
+			function f(uint a) public returns (uint r) {
+				for (uint i = 0; i < a; ++i)
+					r += d.x() * i;
+			}
+		}
+	)";
+	// The code generator reuses the optimised object instead of parsing the optimised IR.
+	// This has to result in the same code as parsing it.
+	CompilerStack compilerStack;
+	compilerStack.setSources({{"", string(sourceCode)}});
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setOptimiserSettings(OptimiserSettings::standard());
+	compilerStack.setViaIR(true);
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+
+	yul::AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		yul::AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::standard(),
+		langutil::DebugInfoSelection::Default()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", compilerStack.yulIROptimized("C")));
+	stack.optimize();
+	auto [creationObject, runtimeObject] = stack.assembleWithDeployed(
+		IRNames::deployedObject(compilerStack.contractDefinition("C"))
+	);
+	BOOST_REQUIRE(creationObject.bytecode && runtimeObject.bytecode);
+	BOOST_CHECK(creationObject.bytecode->bytecode == compilerStack.object("C").bytecode);
+	BOOST_CHECK(runtimeObject.bytecode->bytecode == compilerStack.runtimeObject("C").bytecode);
+}
+
+BOOST_AUTO_TEST_CASE(inherited_functions_compile_as_in_separate_compilations)
+{
+	char const* sourceCode = R"(
+		library L {
+			function twice(uint x) external pure returns (uint) { return 2 * x; }
+		}
+		abstract contract Base {
+			uint public counter;
+			uint immutable factor = 3;
+			modifier bounded(uint x) virtual { require(x < 1000, "too large"); _; }
+			function step(uint x) internal virtual returns (uint) { return x + 1; }
+			function run(uint x) public bounded(x) returns (uint) {
+				counter += step(x) * factor;
+				return L.twice(counter);
+			}
+			function encoded(uint x) public pure returns (bytes memory) { return abi.encode(x, "abc"); }
+		}
+		contract A is Base {}
+		contract B is Base {
+			function step(uint x) internal override returns (uint) { return super.step(x) * 2; }
+		}
+		contract Storage { uint[3] data; }
+		contract C is Storage, Base {
+			modifier bounded(uint x) override { require(x < 10); _; }
+		}
+		contract D is A {}
+	)";
+	// The code generator reuses the code of functions compiled for other contracts of the
+	// compilation. This has to result in the same code as compiling each contract on its own.
+	for (OptimiserSettings const& optimiserSettings: {OptimiserSettings::minimal(), OptimiserSettings::standard()})
+	{
+		auto compile = [&](CompilerStack& _compilerStack, map<string, set<string>> const& _requestedContracts) {
+			_compilerStack.setSources({{"", string(sourceCode)}});
+			_compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+			_compilerStack.setOptimiserSettings(optimiserSettings);
+			_compilerStack.setRequestedContractNames(_requestedContracts);
+			BOOST_REQUIRE_MESSAGE(_compilerStack.compile(), "Compiling contract failed");
+		};
+		CompilerStack compilerStack;
+		compile(compilerStack, {});
+		for (string const contract: {"A", "B", "C", "D"})
+		{
+			CompilerStack separateStack;
+			compile(separateStack, {{"", {contract}}});
+			BOOST_CHECK_EQUAL(compilerStack.assemblyString(contract), separateStack.assemblyString(contract));
+			BOOST_CHECK(compilerStack.object(contract).bytecode == separateStack.object(contract).bytecode);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -23,10 +23,15 @@
 
 #include <test/libsolidity/SolidityExecutionFramework.h>
 
+#include <libsolidity/interface/BytecodeCache.h>
+#include <libsolidity/interface/Version.h>
+
 #include <liblangutil/DebugInfoSelection.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <libsolutil/Keccak256.h>
+
 #include <boost/test/framework.hpp>
 
 #include <cstdlib>
@@ -39,6 +44,38 @@ using namespace solidity::langutil;
 using namespace solidity::test;
 using namespace std;
 
+namespace
+{
+
+/// @returns the cache given by --compilation-cache or nullptr if there is none. The entries are kept
+/// in a subdirectory specific to the test binary, so that a rebuilt compiler does not use the outputs
+/// of the previous one. The cache is disabled if the binary cannot be identified.
+shared_ptr<BytecodeCache const> const& compilationCache()
+{
+	static shared_ptr<BytecodeCache const> const cache = []() -> shared_ptr<BytecodeCache const> {
+		boost::filesystem::path const& directory = CommonOptions::get().compilationCacheDirectory;
+		if (directory.empty())
+			return nullptr;
+
+		boost::system::error_code errorCode;
+		boost::filesystem::path const executable = boost::filesystem::read_symlink("/proc/self/exe", errorCode);
+		if (errorCode)
+			return nullptr;
+		uintmax_t const size = boost::filesystem::file_size(executable, errorCode);
+		if (errorCode)
+			return nullptr;
+		time_t const modificationTime = boost::filesystem::last_write_time(executable, errorCode);
+		if (errorCode)
+			return nullptr;
+
+		string const identity = VersionStringStrict + '\0' + to_string(size) + '\0' + to_string(modificationTime);
+		return make_shared<BytecodeCache const>(directory / util::keccak256(identity).hex().substr(0, 16));
+	}();
+	return cache;
+}
+
+}
+
 bytes SolidityExecutionFramework::multiSourceCompileContract(
 	map<string, string> const& _sourceCode,
 	optional<string> const& _mainSourceName,
@@ -52,17 +89,44 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 	for (auto& entry: sourcesWithPreamble)
 		entry.second = addPreamble(entry.second);
 
-	m_compiler.reset();
+	AnalysisInputs inputs{move(sourcesWithPreamble), _libraryAddresses, m_evmVersion, m_revertStrings, m_optimiserSettings};
+	// The legacy and the IR pipeline are run on the same sources one after the other.
+	if (m_analysedInputs == inputs)
+		m_compiler.resetCompilation(m_optimiserSettings, false);
+	else
+	{
+		m_compiler.reset();
+		m_compiler.setSources(inputs.sources);
+		m_compiler.setLibraries(_libraryAddresses);
+		m_compiler.setRevertStringBehaviour(m_revertStrings);
+		m_compiler.setEVMVersion(m_evmVersion);
+		m_compiler.setOptimiserSettings(m_optimiserSettings);
+	}
+	m_analysedInputs.reset();
+	m_compiler.setBytecodeCache(compilationCache());
 	m_compiler.enableEwasmGeneration(m_compileToEwasm);
-	m_compiler.setSources(sourcesWithPreamble);
-	m_compiler.setLibraries(_libraryAddresses);
-	m_compiler.setRevertStringBehaviour(m_revertStrings);
-	m_compiler.setEVMVersion(m_evmVersion);
-	m_compiler.setOptimiserSettings(m_optimiserSettings);
 	m_compiler.enableEvmBytecodeGeneration(!m_compileViaYul);
 	m_compiler.enableIRGeneration(m_compileViaYul);
-	m_compiler.setRevertStringBehaviour(m_revertStrings);
-	if (!m_compiler.compile())
+
+	// The compiler stack caches the output of the legacy pipeline itself. The output of the IR
+	// pipeline is looked up here after the analysis, since it is assembled outside of the stack.
+	optional<util::h256> cacheKey;
+	optional<evmasm::LinkerObject> cachedObject;
+	bool success = m_compiler.compile(CompilerStack::State::AnalysisPerformed);
+	if (success && m_compileViaYul && compilationCache())
+	{
+		string key = m_compiler.metadata(
+			_contractName.empty() ? m_compiler.lastContractName(_mainSourceName) : _contractName
+		);
+		key += '\0';
+		key += m_compileToEwasm ? "ewasm" : "ir";
+		cacheKey = util::keccak256(key);
+		if (auto entry = compilationCache()->load(*cacheKey))
+			cachedObject = move(entry->object);
+	}
+	if (success && !cachedObject)
+		success = m_compiler.compile();
+	if (!success)
 	{
 		// The testing framework expects an exception for
 		// "unimplemented" yul IR generation.
@@ -74,9 +138,13 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 			.printErrorInformation(m_compiler.errors());
 		BOOST_ERROR("Compiling contract failed");
 	}
+	else
+		m_analysedInputs = move(inputs);
 	string contractName(_contractName.empty() ? m_compiler.lastContractName(_mainSourceName) : _contractName);
 	evmasm::LinkerObject obj;
-	if (m_compileViaYul)
+	if (cachedObject)
+		obj = move(*cachedObject);
+	else if (m_compileViaYul)
 	{
 		if (m_compileToEwasm)
 			obj = m_compiler.ewasmObject(contractName);
@@ -119,6 +187,12 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 				}
 			}
 		}
+		if (cacheKey)
+		{
+			BytecodeCache::Entry entry;
+			entry.object = obj;
+			compilationCache()->store(*cacheKey, entry);
+		}
 	}
 	else
 		obj = m_compiler.object(contractName);
@@ -32,6 +32,8 @@
 
 #include <libyul/AssemblyStack.h>
 
+#include <optional>
+
 namespace solidity::frontend::test
 {
 
@@ -75,7 +77,26 @@ public:
 	/// the latter only if it is forced.
 	static std::string addPreamble(std::string const& _sourceCode);
 protected:
-
+	/// Inputs of the analysis of the sources in m_compiler. Code can be generated again from the
+	/// same analysis as long as only the code generation pipeline changes.
+	struct AnalysisInputs
+	{
+		std::map<std::string, std::string> sources;
+		std::map<std::string, solidity::test::Address> libraries;
+		langutil::EVMVersion evmVersion;
+		RevertStrings revertStrings;
+		OptimiserSettings optimiserSettings;
+
+		bool operator==(AnalysisInputs const& _other) const
+		{
+			return
+				std::tie(sources, libraries, evmVersion, revertStrings, optimiserSettings) ==
+				std::tie(_other.sources, _other.libraries, _other.evmVersion, _other.revertStrings, _other.optimiserSettings);
+		}
+	};
+
+	/// Inputs of the last successful compilation, if its analysis can be reused.
+	std::optional<AnalysisInputs> m_analysedInputs;
 	solidity::frontend::CompilerStack m_compiler;
 	bool m_compileViaYul = false;
 	bool m_compileToEwasm = false;
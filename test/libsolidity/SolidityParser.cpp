@@ -24,6 +24,7 @@
 #include <memory>
 #include <liblangutil/Scanner.h>
 #include <libsolidity/parsing/Parser.h>
+#include <libsolidity/interface/CompilerStack.h>
 #include <liblangutil/ErrorReporter.h>
 #include <test/Common.h>
 #include <test/libsolidity/ErrorCheck.h>
@@ -612,6 +613,75 @@ BOOST_AUTO_TEST_CASE(inline_asm_end_location)
 	BOOST_CHECK_MESSAGE(visitor.visited, "No inline asm block found?!");
 }
 
+BOOST_AUTO_TEST_CASE(skip_function_bodies)
+{
+	string const text = R"(
+		contract C {
+			modifier m() { _; }
+			function f(uint a) public m returns (uint) { if (a > 0) { return a; } assembly { a := 1 } return ++; }
+			function g() public;
+		}
+	)";
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(text, "");
+	ASTPointer<SourceUnit> sourceUnit = Parser(
+		errorReporter,
+		solidity::test::CommonOptions::get().evmVersion(),
+		false,
+		/* _skipFunctionBodies */ true
+	).parse(charStream);
+	BOOST_REQUIRE(sourceUnit);
+	// The syntax error in the body of f is not noticed.
+	BOOST_CHECK(errors.empty());
+
+	auto const contract = dynamic_pointer_cast<ContractDefinition>(sourceUnit->nodes().front());
+	BOOST_REQUIRE(contract);
+	vector<FunctionDefinition const*> functions = contract->definedFunctions();
+	BOOST_REQUIRE_EQUAL(functions.size(), 2);
+	BOOST_REQUIRE(functions[0]->isImplemented());
+	BOOST_CHECK(functions[0]->body().statements().empty());
+	BOOST_CHECK_EQUAL(
+		charStream.text(functions[0]->body().location()),
+		"{ if (a > 0) { return a; } assembly { a := 1 } return ++; }"
+	);
+	BOOST_CHECK(!functions[1]->isImplemented());
+	ModifierDefinition const& modifier = *contract->functionModifiers().front();
+	BOOST_CHECK(modifier.body().statements().empty());
+	BOOST_CHECK_EQUAL(charStream.text(modifier.body().location()), "{ _; }");
+}
+
+BOOST_AUTO_TEST_CASE(lazy_function_bodies_in_compiler_stack)
+{
+	string const text = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		contract C { function f() public pure returns (uint) { return 1 + true; } }
+	)";
+	CompilerStack compiler;
+	compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compiler.setLazyFunctionBodies(true);
+	compiler.setSources({{"a.sol", text}});
+	BOOST_REQUIRE(compiler.parseAndAnalyze(CompilerStack::State::ParsedAndImported));
+	auto const* function = ASTNode::filteredNodes<ContractDefinition>(compiler.ast("a.sol").nodes()).front()->definedFunctions().front();
+	BOOST_CHECK(function->body().statements().empty());
+
+	// The analysis parses the bodies and finds the type error.
+	BOOST_CHECK(!compiler.analyze());
+	BOOST_CHECK(Error::containsErrorOfType(compiler.errors(), Error::Type::TypeError));
+	function = ASTNode::filteredNodes<ContractDefinition>(compiler.ast("a.sol").nodes()).front()->definedFunctions().front();
+	BOOST_CHECK_EQUAL(function->body().statements().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(skip_function_bodies_unbalanced)
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream("contract C { function f() public { { } ", "");
+	BOOST_CHECK(!Parser(errorReporter, solidity::test::CommonOptions::get().evmVersion(), false, true).parse(charStream));
+	BOOST_CHECK(Error::containsErrorOfType(errors, Error::Type::ParserError));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -24,9 +24,12 @@
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/interface/CompilerStack.h>
 #include <libsolutil/Keccak256.h>
 #include <boost/test/unit_test.hpp>
 
+#include <thread>
+
 using namespace std;
 using namespace solidity::langutil;
 
@@ -279,6 +282,77 @@ BOOST_AUTO_TEST_CASE(helper_string_result)
 	BOOST_REQUIRE_EQUAL(r1.message(), "Failure");
 }
 
+BOOST_AUTO_TEST_CASE(interned_types)
+{
+	CompilerStack compilerStack;
+	ArrayType const* uintArray = TypeProvider::array(DataLocation::Memory, TypeProvider::uint256());
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, TypeProvider::uint256()) == uintArray);
+	BOOST_CHECK(TypeProvider::array(DataLocation::Storage, TypeProvider::uint256()) != uintArray);
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, TypeProvider::uint256(), 2) != uintArray);
+	BOOST_CHECK(TypeProvider::withLocation(uintArray, DataLocation::Storage, true) == TypeProvider::withLocation(uintArray, DataLocation::Storage, true));
+	BOOST_CHECK(TypeProvider::mapping(TypeProvider::address(), uintArray) == TypeProvider::mapping(TypeProvider::address(), uintArray));
+	BOOST_CHECK(TypeProvider::tuple({uintArray, TypeProvider::boolean()}) == TypeProvider::tuple({uintArray, TypeProvider::boolean()}));
+	BOOST_CHECK(TypeProvider::tuple({uintArray, TypeProvider::boolean()}) != TypeProvider::tuple({TypeProvider::boolean(), uintArray}));
+	BOOST_CHECK(TypeProvider::typeType(uintArray) == TypeProvider::typeType(uintArray));
+	BOOST_CHECK(
+		TypeProvider::function(strings{"uint256"}, strings{"bool"}, FunctionType::Kind::Internal) ==
+		TypeProvider::function(strings{"uint256"}, strings{"bool"}, FunctionType::Kind::Internal)
+	);
+	BOOST_CHECK(
+		TypeProvider::function(strings{"uint256"}, strings{"bool"}, FunctionType::Kind::Internal) !=
+		TypeProvider::function(strings{"uint256"}, strings{"bool"}, FunctionType::Kind::External)
+	);
+	BOOST_CHECK(TypeProvider::rationalNumber(rational(7)) == TypeProvider::rationalNumber(rational(7)));
+
+	// Types are not shared with the ones created before the caches were cleared.
+	TypeProvider::clearTypeCaches();
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, TypeProvider::uint256()) != uintArray);
+	BOOST_CHECK(*TypeProvider::array(DataLocation::Memory, TypeProvider::uint256()) == *uintArray);
+}
+
+BOOST_AUTO_TEST_CASE(type_provider_per_compiler_stack)
+{
+	Type const* defaultType = TypeProvider::uint256();
+	Type const* compilerStackType = nullptr;
+	{
+		CompilerStack compilerStack;
+		compilerStackType = TypeProvider::uint256();
+	}
+	BOOST_CHECK(compilerStackType != defaultType);
+	BOOST_CHECK(TypeProvider::uint256() == defaultType);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_compiler_stacks)
+{
+	string const sourceCode = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		contract C {
+			mapping(uint => string) m;
+			function f(uint a, bytes memory b) public returns (uint[] memory r) {
+				m[a] = string(b);
+				r = new uint[](a);
+			}
+		}
+	)";
+	size_t const threadCount = 4;
+	vector<optional<string>> metadata(threadCount);
+	vector<thread> threads;
+	for (size_t i = 0; i < threadCount; ++i)
+		threads.emplace_back([&, i]() {
+			CompilerStack compilerStack;
+			compilerStack.setSources({{"A.sol", sourceCode}});
+			if (compilerStack.compile())
+				metadata[i] = compilerStack.metadata("C");
+		});
+	for (thread& t: threads)
+		t.join();
+
+	BOOST_REQUIRE(metadata[0].has_value());
+	for (size_t i = 0; i < threadCount; ++i)
+		BOOST_CHECK(metadata[i] == metadata[0]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -27,9 +27,11 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
 #include <test/Metadata.h>
 
 #include <algorithm>
+#include <limits>
 #include <set>
 
 using namespace std;
@@ -1616,7 +1618,7 @@ BOOST_AUTO_TEST_CASE(stopAfter_invalid_value)
 	}
 	)";
 	Json::Value result = compile(input);
-	BOOST_CHECK(containsError(result, "JSONError", "Invalid value for \"settings.stopAfter\". Only valid value is \"parsing\"."));
+	BOOST_CHECK(containsError(result, "JSONError", "Invalid value for \"settings.stopAfter\". Valid values are \"parsing\", \"analysis\" and \"ir\"."));
 }
 
 BOOST_AUTO_TEST_CASE(stopAfter_invalid_type)
@@ -1661,6 +1663,49 @@ BOOST_AUTO_TEST_CASE(stopAfter_bin_conflict)
 	BOOST_CHECK(containsError(result, "JSONError", "Requested output selection conflicts with \"settings.stopAfter\"."));
 }
 
+BOOST_AUTO_TEST_CASE(stopAfter_ir)
+{
+	auto input = [](string const& _outputs) {
+		return
+			"{\"language\": \"Solidity\", \"sources\": {\"a.sol\": {\"content\": "
+			"\"pragma solidity >=0.0; contract C { function f() public pure {} }\"}}, "
+			"\"settings\": {\"stopAfter\": \"ir\", \"outputSelection\": {\"*\": {\"C\": [" + _outputs + "]}}}}";
+	};
+
+	Json::Value result = compile(input("\"abi\", \"ir\", \"irOptimized\""));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "a.sol", "C");
+	BOOST_REQUIRE(contract.isObject());
+	BOOST_CHECK(contract["abi"].isArray());
+	BOOST_CHECK(!contract["ir"].asString().empty());
+	BOOST_CHECK(!contract["irOptimized"].asString().empty());
+	BOOST_CHECK(!contract.isMember("evm"));
+
+	result = compile(input("\"ir\", \"evm.bytecode\""));
+	BOOST_CHECK(containsError(result, "JSONError", "Requested output selection conflicts with \"settings.stopAfter\"."));
+}
+
+BOOST_AUTO_TEST_CASE(stopAfter_analysis_ir_conflict)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"stopAfter": "analysis",
+			"outputSelection":
+			{
+				"*": { "C": ["ir"] }
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "Requested output selection conflicts with \"settings.stopAfter\"."));
+}
+
 BOOST_AUTO_TEST_CASE(stopAfter_ast_output)
 {
 	char const* input = R"(
@@ -1810,6 +1855,286 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(timing_output)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "pragma solidity >=0.0; contract C { function f(uint x) public pure returns (uint) { return x * 2; } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "": ["timing"], "C": ["evm.bytecode.object"] }
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+
+	Json::Value const& timing = result["timing"];
+	BOOST_REQUIRE(timing.isObject());
+	for (char const* stage: {"parsing", "analysis", "compilation"})
+	{
+		BOOST_REQUIRE(timing["stages"][stage].isObject());
+		BOOST_CHECK(timing["stages"][stage]["wallTime"].isUInt64());
+		BOOST_CHECK_EQUAL(timing["stages"][stage]["count"].asUInt64(), 1);
+		BOOST_CHECK(timing["stages"][stage]["peakMemory"].isUInt64());
+	}
+	for (char const* phase: {"irGeneration", "irOptimisation", "evmCodeGeneration"})
+		BOOST_CHECK(timing["contracts"]["A.sol"]["C"][phase]["wallTime"].isUInt64());
+	BOOST_REQUIRE(timing["optimiserSteps"].isObject());
+	BOOST_CHECK(timing["optimiserSteps"]["UnusedPruner"]["count"].asUInt64() > 0);
+	// The generated code contains unused functions, which the UnusedPruner removes.
+	BOOST_CHECK(timing["optimiserSteps"]["UnusedPruner"]["changes"].asUInt64() > 0);
+	BOOST_CHECK(timing["optimiserSteps"]["UnusedPruner"]["sizeDelta"].asInt64() < 0);
+	BOOST_CHECK(timing["memberCache"]["hits"].isUInt64());
+	BOOST_CHECK(timing["memberCache"]["misses"].asUInt64() > 0);
+
+	// The timings differ between runs, so they are not matched by wildcards.
+	parsedInput["settings"]["outputSelection"]["*"][""] = Json::arrayValue;
+	parsedInput["settings"]["outputSelection"]["*"][""].append("*");
+	result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(!result.isMember("timing"));
+}
+
+BOOST_AUTO_TEST_CASE(analysis_only_outputs_do_not_compile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "pragma solidity >=0.0; contract C { uint x; function f() public view returns (uint) { return x; } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"": ["*", "timing"],
+					"C": ["abi", "metadata", "storageLayout", "devdoc", "userdoc", "evm.methodIdentifiers"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["sources"]["A.sol"]["ast"].isObject());
+	Json::Value const& contract = getContractResult(result, "A.sol", "C");
+	BOOST_CHECK(contract["abi"].isArray());
+	BOOST_CHECK(contract["storageLayout"].isObject());
+	BOOST_CHECK(contract["evm"]["methodIdentifiers"].isObject());
+	BOOST_CHECK(!contract["evm"].isMember("bytecode"));
+
+	// Source-level wildcards do not select any contract outputs and thus do not need compilation.
+	Json::Value const& timing = result["timing"];
+	BOOST_REQUIRE(timing.isObject());
+	BOOST_CHECK(timing["stages"]["analysis"].isObject());
+	BOOST_CHECK(!timing["stages"].isMember("compilation"));
+
+	parsedInput["settings"]["outputSelection"]["*"]["C"].append("evm.deployedBytecode.functionDebugData");
+	result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["timing"]["stages"]["compilation"].isObject());
+}
+
+BOOST_AUTO_TEST_CASE(batch_read_callback)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"x.sol": { "urls": ["x1", "x2"] },
+			"y.sol": { "urls": ["y1"] }
+		}
+	}
+	)";
+	map<string, string> files{
+		{"x2", "contract X { }"},
+		{"y1", "import \"z.sol\"; contract Y { }"},
+		{"z.sol", "contract Z { }"}
+	};
+	vector<vector<string>> batches;
+	frontend::StandardCompiler compiler;
+	compiler.setBatchReadCallback([&](string const&, vector<string> const& _paths) {
+		batches.push_back(_paths);
+		vector<ReadCallback::Result> results;
+		for (string const& path: _paths)
+			if (files.count(path))
+				results.push_back({true, files.at(path)});
+			else
+				results.push_back({false, "Not found."});
+		return results;
+	});
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(string(input)), result));
+
+	// The first URLs are read at once, the second one only after the first one failed.
+	BOOST_CHECK(batches == (vector<vector<string>>{{"x1", "y1"}, {"x2"}, {"z.sol"}}));
+	BOOST_CHECK(containsError(result, "IOError", "Cannot import url (\"x1\"): Not found."));
+	BOOST_CHECK(result["sources"].isMember("x.sol"));
+	BOOST_CHECK(result["sources"].isMember("z.sol"));
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": { "content": "interface I { function f() external; } contract C { function f() public pure returns (uint) { return 1; } }" }
+		},
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"": ["ast"],
+					"*": ["abi", "evm.assembly", "evm.legacyAssembly", "evm.gasEstimates", "evm.bytecode", "evm.deployedBytecode.object"]
+				}
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+	for (util::JsonFormat format: {util::JsonFormat{util::JsonFormat::Compact}, util::JsonFormat{util::JsonFormat::Pretty}})
+	{
+		// The outputs that are generated while printing are the same as the ones of the JSON interface.
+		frontend::StandardCompiler compiler({}, format);
+		string const expectation = util::jsonPrint(compiler.compile(parsedInput), format);
+		BOOST_CHECK(expectation.find("\"deployedBytecode\"") != string::npos);
+
+		ostringstream stream;
+		BOOST_REQUIRE(compiler.compile(string(input), stream));
+		BOOST_CHECK_EQUAL(stream.str(), expectation);
+		BOOST_CHECK_EQUAL(compiler.compile(string(input)), expectation);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_releases_intermediates)
+{
+	// The intermediates of D and C are released before the contracts creating them are compiled
+	// or printed, but their bytecode is still embedded.
+	string const source =
+		"contract D { uint x; function f() public { x = 1; } } "
+		"contract C { function f() public returns (address) { return address(new D()); } } "
+		"contract E { function g() public { new C(); } }";
+	for (bool viaIR: {false, true})
+	{
+		string const input = R"(
+		{
+			"language": "Solidity",
+			"sources": { "a.sol": { "content": ")" + source + R"(" } },
+			"settings": {
+				"viaIR": )" + (viaIR ? "true" : "false") + R"(,
+				"outputSelection": {
+					"a.sol": {
+						"D": ["evm.bytecode.object"],
+						"C": ["ir", "evm.bytecode.sourceMap", "evm.deployedBytecode.object"],
+						"E": ["evm.assembly", "evm.gasEstimates", "evm.bytecode"]
+					}
+				}
+			}
+		}
+		)";
+		Json::Value parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+		frontend::StandardCompiler compiler;
+		string const expectation = util::jsonPrint(compiler.compile(parsedInput), util::JsonFormat{});
+		BOOST_CHECK(expectation.find("\"assembly\"") != string::npos);
+		BOOST_CHECK(expectation.find("\"sourceMap\"") != string::npos);
+
+		ostringstream stream;
+		BOOST_REQUIRE(compiler.compile(input, stream));
+		BOOST_CHECK_EQUAL(stream.str(), expectation);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(sources_by_hash)
+{
+	string const content = "contract C { function f() public {} }";
+	string const hash = "0x" + util::keccak256(content).hex();
+	auto input = [&](string const& _source, string const& _output) {
+		return
+			"{\"language\": \"Solidity\", \"sources\": {\"a.sol\": " + _source + "}, "
+			"\"settings\": {\"outputSelection\": {\"*\": {\"*\": [\"" + _output + "\"]}}}}";
+	};
+	string const byHash = "{\"keccak256\": \"" + hash + "\"}";
+
+	frontend::StandardCompiler compiler;
+	compiler.setYulStringMemoryLimit(numeric_limits<size_t>::max());
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input(byHash, "abi")), result));
+	BOOST_CHECK(containsError(result, "JSONError", "Invalid input source specified."));
+
+	compiler.enableSourceCache(1024);
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input(byHash, "abi")), result));
+	BOOST_CHECK(containsError(result, "IOError", "No content known for the supplied hash of \"a.sol\"."));
+
+	string const withContent = "{\"keccak256\": \"" + hash + "\", \"content\": \"" + content + "\"}";
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input(withContent, "abi")), result));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["a.sol"]["C"]["abi"].isArray());
+
+	// The source is known now and its AST is reused with different outputs.
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input(byHash, "evm.methodIdentifiers")), result));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK_EQUAL(result["contracts"]["a.sol"]["C"]["evm"]["methodIdentifiers"]["f()"].asString(), "26121ff0");
+}
+
+BOOST_AUTO_TEST_CASE(configurations)
+{
+	auto input = [](string const& _optimizer, string const& _configuration) {
+		return
+			"{\"language\": \"Solidity\", \"sources\": {\"a.sol\": {\"content\": "
+			"\"contract C { function f(uint x) public pure returns (uint) { return x + 1 + 2; } }\"}}, "
+			"\"settings\": {\"optimizer\": " + _optimizer + ", "
+			"\"configurations\": {\"x\": " + _configuration + "}, "
+			"\"outputSelection\": {\"*\": {\"*\": [\"evm.bytecode.object\"]}}}}";
+	};
+
+	Json::Value result = compile(input("{\"enabled\": true}", "{\"optimizer\": {\"enabled\": false}}"));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value const& configurationResult = result["configurations"]["x"];
+	BOOST_REQUIRE(configurationResult.isObject());
+	BOOST_CHECK(!configurationResult.isMember("sources"));
+	string const optimized = getContractResult(result, "a.sol", "C")["evm"]["bytecode"]["object"].asString();
+	string const unoptimized = getContractResult(configurationResult, "a.sol", "C")["evm"]["bytecode"]["object"].asString();
+	BOOST_CHECK(!optimized.empty());
+	BOOST_CHECK(!unoptimized.empty());
+	BOOST_CHECK(optimized != unoptimized);
+
+	// The configuration has to produce the same code as a separate compilation.
+	Json::Value separate = compile(input("{\"enabled\": false}", "{}"));
+	BOOST_CHECK_EQUAL(getContractResult(separate, "a.sol", "C")["evm"]["bytecode"]["object"].asString(), unoptimized);
+
+	result = compile(input("{\"enabled\": false}", "{\"optimizer\": {\"enabled\": true}}"));
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"\"settings.configurations.x\" cannot enable the Yul optimizer if the main settings do not enable it."
+	));
+
+	result = compile(input("{\"enabled\": false}", "{\"runs\": 1}"));
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown key \"runs\""));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -2162,6 +2162,62 @@ BOOST_AUTO_TEST_CASE(function_selector_access)
 	checkCallGraphExpectations(get<1>(graphs), expectedDeployedEdges);
 }
 
+BOOST_AUTO_TEST_CASE(shared_base_resolved_per_contract)
+{
+	// The calls of A.run() are only collected once but have to be resolved differently
+	// for each of the contracts inheriting it.
+	unique_ptr<CompilerStack> compilerStack = parseAndAnalyzeContracts(R"(
+		contract A {
+			function f() internal virtual {}
+			function run() public { f(); }
+		}
+
+		contract B is A {
+			function f() internal virtual override { super.f(); }
+		}
+
+		contract C is A {
+			function f() internal virtual override {}
+		}
+
+		contract D is B, C {
+			function f() internal override(B, C) { super.f(); }
+		}
+	)"s);
+	tuple<CallGraphMap, CallGraphMap> graphs = collectGraphs(*compilerStack);
+
+	map<string, EdgeNames> expectedCreationEdges = {
+		{"A", {}},
+		{"B", {}},
+		{"C", {}},
+		{"D", {}},
+	};
+
+	map<string, EdgeNames> expectedDeployedEdges = {
+		{"A", {
+			{"Entry", "function A.run()"},
+			{"function A.run()", "function A.f()"},
+		}},
+		{"B", {
+			{"Entry", "function A.run()"},
+			{"function A.run()", "function B.f()"},
+			{"function B.f()", "function A.f()"},
+		}},
+		{"C", {
+			{"Entry", "function A.run()"},
+			{"function A.run()", "function C.f()"},
+		}},
+		{"D", {
+			{"Entry", "function A.run()"},
+			{"function A.run()", "function D.f()"},
+			{"function D.f()", "function C.f()"},
+		}},
+	};
+
+	checkCallGraphExpectations(get<0>(graphs), expectedCreationEdges);
+	checkCallGraphExpectations(get<1>(graphs), expectedDeployedEdges);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace solidity::frontend::test
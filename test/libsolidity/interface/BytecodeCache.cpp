@@ -0,0 +1,179 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for libsolidity/interface/BytecodeCache.h
+
+#include <libsolidity/interface/BytecodeCache.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+#include <test/Common.h>
+#include <test/FilesystemUtils.h>
+#include <test/TemporaryDirectory.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::test;
+using namespace solidity::evmasm;
+
+#define TEST_CASE_NAME (boost::unit_test::framework::current_test_case().p_name)
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+string const sourceCode = R"(
+	// SPDX-License-Identifier: GPL-3.0
+	pragma solidity >=0.0;
+	library L { function f() public pure returns (uint) { return 7; } }
+	contract C {
+		uint immutable x = 2;
+		function g() public view returns (uint) { return L.f() + x; }
+	}
+)";
+
+struct Outputs
+{
+	bool fromCache = false;
+	bytes bytecode;
+	map<size_t, string> linkReferences;
+	string sourceMapping;
+	string runtimeSourceMapping;
+	string assembly;
+	Json::Value assemblyJSON;
+};
+
+Outputs compile(shared_ptr<BytecodeCache const> _cache, bool _optimize = false)
+{
+	CompilerStack compilerStack;
+	compilerStack.setEVMVersion(CommonOptions::get().evmVersion());
+	compilerStack.setOptimiserSettings(_optimize);
+	compilerStack.setBytecodeCache(move(_cache));
+	compilerStack.setSources({{"a.sol", sourceCode}});
+	BOOST_REQUIRE(compilerStack.compile());
+
+	Outputs outputs;
+	outputs.fromCache = !compilerStack.assemblyItems("C");
+	outputs.bytecode = compilerStack.runtimeObject("C").bytecode;
+	outputs.linkReferences = compilerStack.runtimeObject("C").linkReferences;
+	outputs.sourceMapping = *compilerStack.sourceMapping("C");
+	outputs.runtimeSourceMapping = *compilerStack.runtimeSourceMapping("C");
+	outputs.assembly = compilerStack.assemblyString("C", {{"a.sol", sourceCode}});
+	outputs.assemblyJSON = compilerStack.assemblyJSON("C");
+	return outputs;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(BytecodeCacheTest)
+
+BOOST_AUTO_TEST_CASE(entry_json_roundtrip)
+{
+	BytecodeCache::Entry entry;
+	entry.object.bytecode = bytes{0x60, 0x80, 0x00};
+	entry.object.linkReferences[1] = "a.sol:L";
+	entry.object.immutableReferences[u256("123456789012345678901234567890")] = {"x", {0, 2}};
+	entry.object.functionDebugData["f"] = LinkerObject::FunctionDebugData{3, nullopt, 1, 2, 1};
+	entry.runtimeObject.bytecode = bytes{0x00};
+	entry.sourceMapping = "1:2:0:-:0";
+	entry.runtimeSourceMapping = "3:4:0:-:0";
+	entry.generatedSources = Json::arrayValue;
+	entry.runtimeGeneratedSources = Json::arrayValue;
+	entry.assembly = "stop\n";
+	entry.assemblyJSON["code"] = Json::arrayValue;
+
+	optional<BytecodeCache::Entry> restored = BytecodeCache::fromJson(BytecodeCache::toJson(entry));
+	BOOST_REQUIRE(restored);
+	BOOST_CHECK(restored->object.bytecode == entry.object.bytecode);
+	BOOST_CHECK(restored->object.linkReferences == entry.object.linkReferences);
+	BOOST_CHECK(restored->object.immutableReferences == entry.object.immutableReferences);
+	BOOST_REQUIRE_EQUAL(restored->object.functionDebugData.size(), 1);
+	LinkerObject::FunctionDebugData const& debugData = restored->object.functionDebugData.at("f");
+	BOOST_CHECK(debugData.bytecodeOffset == 3);
+	BOOST_CHECK(!debugData.instructionIndex);
+	BOOST_CHECK(debugData.sourceID == 1);
+	BOOST_CHECK_EQUAL(debugData.params, 2);
+	BOOST_CHECK_EQUAL(debugData.returns, 1);
+	BOOST_CHECK(restored->runtimeObject.bytecode == entry.runtimeObject.bytecode);
+	BOOST_CHECK_EQUAL(restored->sourceMapping, entry.sourceMapping);
+	BOOST_CHECK_EQUAL(restored->runtimeSourceMapping, entry.runtimeSourceMapping);
+	BOOST_CHECK_EQUAL(restored->assembly, entry.assembly);
+	BOOST_CHECK(restored->assemblyJSON == entry.assemblyJSON);
+}
+
+BOOST_AUTO_TEST_CASE(malformed_entries_are_ignored)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	BytecodeCache cache(tempDir.path());
+
+	util::h256 const key = util::keccak256("key");
+	BOOST_CHECK(!cache.load(key));
+
+	util::h256 const truncatedKey = util::keccak256("truncated");
+	createFileWithContent(tempDir.path() / (truncatedKey.hex() + ".json"), "{\"bytecode\": ");
+	BOOST_CHECK(!cache.load(truncatedKey));
+
+	util::h256 const invalidHexKey = util::keccak256("invalid hex");
+	createFileWithContent(
+		tempDir.path() / (invalidHexKey.hex() + ".json"),
+		"{\"bytecode\": {\"object\": \"xyz\"}, \"deployedBytecode\": {}}"
+	);
+	BOOST_CHECK(!cache.load(invalidHexKey));
+
+	cache.store(key, BytecodeCache::Entry{});
+	BOOST_CHECK(cache.load(key));
+}
+
+BOOST_AUTO_TEST_CASE(compiler_stack_reuses_cached_outputs)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	auto cache = make_shared<BytecodeCache const>(tempDir.path());
+
+	Outputs const uncached = compile(nullptr);
+	BOOST_CHECK(!uncached.fromCache);
+
+	Outputs const first = compile(cache);
+	BOOST_CHECK(!first.fromCache);
+
+	Outputs const second = compile(cache);
+	BOOST_CHECK(second.fromCache);
+
+	for (Outputs const* outputs: {&first, &second})
+	{
+		BOOST_CHECK(outputs->bytecode == uncached.bytecode);
+		BOOST_CHECK(outputs->linkReferences == uncached.linkReferences);
+		BOOST_CHECK(!outputs->linkReferences.empty());
+		BOOST_CHECK_EQUAL(outputs->sourceMapping, uncached.sourceMapping);
+		BOOST_CHECK_EQUAL(outputs->runtimeSourceMapping, uncached.runtimeSourceMapping);
+		BOOST_CHECK_EQUAL(outputs->assembly, uncached.assembly);
+		BOOST_CHECK(outputs->assemblyJSON == uncached.assemblyJSON);
+	}
+
+	// Different settings result in different metadata.
+	BOOST_CHECK(!compile(cache, true).fromCache);
+	BOOST_CHECK(compile(cache, true).fromCache);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
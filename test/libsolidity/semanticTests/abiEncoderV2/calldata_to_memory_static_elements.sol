@@ -0,0 +1,22 @@
+pragma abicoder v2;
+
+contract C {
+    struct S { uint256 a; bytes32 b; int256 c; }
+    function f(S[] memory s) external pure returns (uint256, uint256, uint256, int256) {
+        return (s.length, s[1].a, uint256(s[1].b), s[2].c);
+    }
+    function g(S[] memory s) external pure returns (uint256, uint256) {
+        s[0].a = 7;
+        return (s[0].a, s[1].a);
+    }
+    function h(uint256[][] memory x, uint256[2][] memory y) external pure returns (uint256, uint256, uint256, uint256) {
+        return (x.length, x[1][1], y.length, y[1][0]);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f((uint256,bytes32,int256)[]): 0x20, 3, 1, 2, 3, 4, 5, 6, 7, 8, -9 -> 3, 4, 5, -9
+// f((uint256,bytes32,int256)[]): 0x20, 3, 1, 2, 3, 4, 5, 6, 7, 8 -> FAILURE
+// g((uint256,bytes32,int256)[]): 0x20, 2, 1, 2, 3, 4, 5, 6 -> 7, 4
+// h(uint256[][],uint256[2][]): 0x40, 0x120, 2, 0x40, 0x60, 0, 2, 7, 8, 2, 1, 2, 3, 4 -> 2, 8, 2, 3
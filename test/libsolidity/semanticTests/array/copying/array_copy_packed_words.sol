@@ -0,0 +1,39 @@
+contract C {
+    int16[] a;
+    uint8[] b;
+
+    function slots(uint256 slot) internal view returns (uint256 first, uint256 second) {
+        uint256 data = uint256(keccak256(abi.encode(slot)));
+        assembly {
+            first := sload(data)
+            second := sload(add(data, 1))
+        }
+    }
+
+    function f(uint256 length) public returns (uint256, uint256, uint256) {
+        int16[] memory m = new int16[](length);
+        for (uint256 i = 0; i < length; i++)
+            m[i] = -int16(uint16(i));
+        a = m;
+        uint256 slot;
+        assembly { slot := a.slot }
+        (uint256 first, uint256 second) = slots(slot);
+        return (a.length, first, second);
+    }
+
+    function g(uint8[] calldata x) public returns (uint256, uint256, uint256) {
+        b = x;
+        uint256 slot;
+        assembly { slot := b.slot }
+        (uint256 first, uint256 second) = slots(slot);
+        return (b.length, first, second);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f(uint256): 17 -> 17, 0xfff1fff2fff3fff4fff5fff6fff7fff8fff9fffafffbfffcfffdfffeffff0000, 0xfff0
+// f(uint256): 3 -> 3, 0xfffeffff0000, 0
+// f(uint256): 0 -> 0, 0, 0
+// g(uint8[]): 0x20, 33, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33 -> 33, 0x201f1e1d1c1b1a191817161514131211100f0e0d0c0b0a090807060504030201, 0x21
+// g(uint8[]): 0x20, 2, 7, 8 -> 2, 0x0807, 0
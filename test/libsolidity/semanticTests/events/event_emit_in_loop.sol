@@ -0,0 +1,15 @@
+contract C {
+    event Transfer(address indexed from, address indexed to, uint256 value);
+    function batchTransfer(address[] calldata to, uint256[] calldata amounts) public returns (uint256 freeMemoryPointer) {
+        for (uint256 i = 0; i < to.length; ++i)
+            emit Transfer(msg.sender, to[i], amounts[i]);
+        // The events are encoded at the free memory pointer without allocating memory.
+        assembly { freeMemoryPointer := mload(0x40) }
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// batchTransfer(address[],uint256[]): 0x40, 0xa0, 2, 0x01, 0x02, 2, 0x03, 0x04 -> 0x80
+// ~ emit Transfer(address,address,uint256): #0x1212121212121212121212121212120000000012, #0x01, 0x03
+// ~ emit Transfer(address,address,uint256): #0x1212121212121212121212121212120000000012, #0x02, 0x04
@@ -0,0 +1,22 @@
+contract C {
+    function g(uint256 x) external pure returns (uint256) {
+        return x + 1;
+    }
+
+    function f() public returns (uint256 sum, bool memoryReused) {
+        uint256 freeMemoryBefore;
+        assembly { freeMemoryBefore := mload(0x40) }
+        for (uint256 i = 0; i < 10; i++) {
+            sum = this.g(sum);
+            if (keccak256(abi.encode(i, sum)) == keccak256(abi.encodePacked(i, sum)))
+                sum += 100;
+        }
+        uint256 freeMemoryAfter;
+        assembly { freeMemoryAfter := mload(0x40) }
+        memoryReused = freeMemoryBefore == freeMemoryAfter;
+    }
+}
+// ====
+// compileViaYul: true
+// ----
+// f() -> 1010, true
@@ -0,0 +1,57 @@
+contract C {
+    struct S { uint128 a; uint128 b; uint256 c; }
+    S s;
+    uint8 x;
+    uint8 y;
+
+    function f() public returns (uint256 r) {
+        s.a = 1;
+        s.b = 2;
+        s.c = 3;
+        r = s.a + s.a * s.b;
+        s.b = 5;
+        r += s.a + s.b;
+        x = 7;
+        y = x + 1;
+        r += uint256(x) + y;
+        if (r > 10)
+            s.a = 10;
+        r += s.a;
+        if (s.a == 10 || inc())
+            r += 1;
+        r += s.c;
+        g();
+        r += s.c;
+        this.h();
+        r += s.a;
+        delete s.b;
+        r += s.b;
+        r += s.c > 0 ? s.c : 0;
+        S storage p = s;
+        p.a = 42;
+        r += s.a;
+        for (uint256 i = 0; i < 3; i++)
+        {
+            r += s.a;
+            s.a += 1;
+        }
+        r += s.a;
+    }
+
+    function inc() internal returns (bool) {
+        s.c += 1;
+        return true;
+    }
+
+    function g() internal {
+        s.c = 100;
+    }
+
+    function h() external {
+        s.a = 1000;
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f() -> 1454
@@ -0,0 +1,13 @@
+contract C {
+	function f() public pure {
+		uint x = 0;
+		for (uint i = 0; i < 3; ++i)
+			x += 2;
+		assert(x == 6);
+	}
+}
+// ====
+// SMTBMCLoopIterations: 3
+// SMTEngine: bmc
+// SMTSolvers: z3
+// ----
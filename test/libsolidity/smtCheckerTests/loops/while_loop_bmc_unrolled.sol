@@ -0,0 +1,17 @@
+contract C {
+	function f(uint x) public pure {
+		require(x < 2);
+		uint y = 0;
+		while (x < 4) {
+			x = x + 1;
+			y = y + 1;
+		}
+		assert(y >= 2);
+		assert(y <= 4);
+	}
+}
+// ====
+// SMTBMCLoopIterations: 4
+// SMTEngine: bmc
+// SMTSolvers: z3
+// ----
@@ -0,0 +1,79 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the arena allocator.
+ */
+
+#include <libsolutil/Arena.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ArenaTest)
+
+BOOST_AUTO_TEST_CASE(alignment)
+{
+	Arena arena(256);
+	for (size_t alignment: {1u, 2u, 8u, 16u, 32u})
+		for (size_t size: {1u, 3u, 17u, 100u})
+		{
+			void* memory = arena.allocate(size, alignment);
+			BOOST_CHECK(reinterpret_cast<uintptr_t>(memory) % alignment == 0);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(blocks)
+{
+	Arena arena(1024);
+	char* first = static_cast<char*>(arena.allocate(8, 1));
+	char* second = static_cast<char*>(arena.allocate(8, 1));
+	BOOST_CHECK(second == first + 8);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 1024);
+
+	// Large allocations get a block of their own and do not interrupt the current block.
+	arena.allocate(4000, 8);
+	BOOST_CHECK_EQUAL(arena.reservedBytes(), 1024 + 4008);
+	BOOST_CHECK(static_cast<char*>(arena.allocate(8, 1)) == second + 8);
+}
+
+BOOST_AUTO_TEST_CASE(shared_objects_keep_arena_alive)
+{
+	auto arena = make_shared<Arena>();
+	weak_ptr<Arena> weakArena = arena;
+	shared_ptr<string> text = allocate_shared<string>(ArenaAllocator<string>(arena), 100, 'x');
+	shared_ptr<int> number = allocate_shared<int>(ArenaAllocator<int>(arena), 7);
+	arena.reset();
+
+	BOOST_CHECK(!weakArena.expired());
+	BOOST_CHECK_EQUAL(*text, string(100, 'x'));
+	BOOST_CHECK_EQUAL(*number, 7);
+	text.reset();
+	BOOST_CHECK(!weakArena.expired());
+	number.reset();
+	BOOST_CHECK(weakArena.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -28,6 +28,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <random>
+
 using namespace std;
 using namespace solidity::frontend;
 
@@ -97,6 +99,34 @@ BOOST_AUTO_TEST_CASE(tohex_bytes)
 	BOOST_CHECK_EQUAL(toHex(fromHex("00112233445566778899aAbBcCdDeEfF"), HexPrefix::Add, static_cast<HexCase>(42)), "0x00112233445566778899aabbccddeeff");
 }
 
+BOOST_AUTO_TEST_CASE(tohex_fromhex_buffer)
+{
+	mt19937 random(42);
+	for (size_t size = 0; size < 100; ++size)
+	{
+		bytes data(size);
+		for (uint8_t& byte: data)
+			byte = static_cast<uint8_t>(random());
+		string expectation;
+		for (uint8_t byte: data)
+			expectation += toHex(byte, HexCase::Upper);
+
+		string hex(2 * size, 'x');
+		toHex(bytesConstRef(&data), hex.data(), HexCase::Upper);
+		BOOST_CHECK_EQUAL(hex, expectation);
+
+		bytes decoded(size);
+		BOOST_CHECK(fromHex(hex.data(), size, decoded.data()));
+		BOOST_CHECK_EQUAL(decoded, data);
+		if (size > 0)
+		{
+			hex[random() % hex.size()] = 'g';
+			BOOST_CHECK(!fromHex(hex.data(), size, decoded.data()));
+		}
+	}
+	BOOST_CHECK_THROW(toHex(bytesConstRef(), nullptr, HexCase::Mixed), BadHexCase);
+}
+
 BOOST_AUTO_TEST_CASE(test_format_number)
 {
 	BOOST_CHECK_EQUAL(formatNumber(u256(0x8000000)), "0x08000000");
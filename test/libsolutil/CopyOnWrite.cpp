@@ -0,0 +1,69 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the copy-on-write value.
+ */
+
+#include <libsolutil/CopyOnWrite.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(CopyOnWriteTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(default_value)
+{
+	CopyOnWrite<map<int, int>> a;
+	CopyOnWrite<map<int, int>> b;
+	BOOST_CHECK(a->empty());
+	BOOST_CHECK(a.sharesValueWith(b));
+	a.write()[1] = 2;
+	BOOST_CHECK(!a.sharesValueWith(b));
+	BOOST_CHECK(b->empty());
+	a.reset();
+	BOOST_CHECK(a->empty());
+}
+
+BOOST_AUTO_TEST_CASE(copies_share_until_written)
+{
+	CopyOnWrite<map<int, int>> a(map<int, int>{{1, 2}});
+	CopyOnWrite<map<int, int>> b = a;
+	BOOST_CHECK(a.sharesValueWith(b));
+	BOOST_CHECK(&*a == &*b);
+
+	b.write()[3] = 4;
+	BOOST_CHECK(!a.sharesValueWith(b));
+	BOOST_CHECK((*a == map<int, int>{{1, 2}}));
+	BOOST_CHECK((*b == map<int, int>{{1, 2}, {3, 4}}));
+
+	// Writing to a value that is not shared does not copy it.
+	map<int, int> const* value = &*b;
+	b.write()[5] = 6;
+	BOOST_CHECK(&*b == value);
+	BOOST_CHECK_EQUAL(b->size(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
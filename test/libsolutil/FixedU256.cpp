@@ -0,0 +1,174 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the fixed-width 256-bit integer, which is compared against u256.
+ */
+
+#include <libsolutil/FixedU256.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+/// @returns a random number whose bits are mostly ones or zeros at the top, which covers the carries
+/// and the sign of two's complement better than uniformly random numbers.
+u256 randomNumber(mt19937_64& _random)
+{
+	u256 result;
+	for (size_t i = _random() % 5; i > 0; --i)
+		result = (result << 64) | u256(_random());
+	if (_random() % 4 == 0)
+		result = ~result;
+	if (_random() % 5 == 0)
+		result >>= unsigned(_random() % 256);
+	return result;
+}
+
+u256 signExtendReference(u256 const& _byte, u256 const& _value)
+{
+	if (_byte >= 31)
+		return _value;
+	unsigned testBit = unsigned(_byte) * 8 + 7;
+	u256 mask = (u256(1) << testBit) - 1;
+	return boost::multiprecision::bit_test(_value, testBit) ? _value | ~mask : _value & mask;
+}
+
+u256 power(u256 const& _base, u256 const& _exponent) { return exp256(_base, _exponent); }
+FixedU256 power(FixedU256 const& _base, FixedU256 const& _exponent) { return exp(_base, _exponent); }
+
+}
+
+BOOST_AUTO_TEST_SUITE(FixedU256Test)
+
+BOOST_AUTO_TEST_CASE(conversion)
+{
+	BOOST_CHECK(u256(FixedU256()) == 0);
+	BOOST_CHECK(u256(FixedU256(0x1234)) == 0x1234);
+	u256 const maximum = ~u256(0);
+	BOOST_CHECK(u256(FixedU256(maximum)) == maximum);
+	BOOST_CHECK(FixedU256(maximum).limb(3) == ~uint64_t(0));
+	BOOST_CHECK(FixedU256(u256(1) << 200).limb(3) == uint64_t(1) << 8);
+}
+
+BOOST_AUTO_TEST_CASE(evm_semantics)
+{
+	FixedU256 const maximum = ~FixedU256(0);
+	FixedU256 const minimum = FixedU256(1) << 255;
+	BOOST_CHECK(maximum + FixedU256(1) == FixedU256(0));
+	BOOST_CHECK(FixedU256(0) - FixedU256(1) == maximum);
+	BOOST_CHECK(FixedU256(7) / FixedU256(0) == FixedU256(0));
+	BOOST_CHECK(FixedU256(7) % FixedU256(0) == FixedU256(0));
+	BOOST_CHECK(sdiv(minimum, maximum) == minimum);
+	BOOST_CHECK(smod(-FixedU256(7), FixedU256(3)) == -FixedU256(1));
+	BOOST_CHECK((maximum << 256) == FixedU256(0));
+	BOOST_CHECK((maximum >> 256) == FixedU256(0));
+	BOOST_CHECK(sar(minimum, 300) == maximum);
+	BOOST_CHECK(exp(FixedU256(2), FixedU256(255)) == minimum);
+	BOOST_CHECK(exp(FixedU256(2), FixedU256(256)) == FixedU256(0));
+	BOOST_CHECK(exp(FixedU256(0), FixedU256(0)) == FixedU256(1));
+	BOOST_CHECK(signExtend(FixedU256(0), FixedU256(0x80)) == ~FixedU256(0x7f));
+	BOOST_CHECK(byteOf(FixedU256(31), FixedU256(0x1234)) == FixedU256(0x34));
+	BOOST_CHECK(byteOf(FixedU256(32), maximum) == FixedU256(0));
+}
+
+BOOST_AUTO_TEST_CASE(division_with_overestimated_quotient)
+{
+	// The estimate of the quotient is one too large here, so the division has to add the divisor back.
+	u256 const a("0x7fffffffffffffff800000000000000000000000000000000000000000000000");
+	u256 const b("0x800000000000000000000000000000000000000000000001");
+	auto const [quotient, remainder] = divMod(FixedU256(a), FixedU256(b));
+	BOOST_CHECK(u256(quotient) == a / b);
+	BOOST_CHECK(u256(remainder) == a % b);
+}
+
+BOOST_AUTO_TEST_CASE(random_against_u256)
+{
+	mt19937_64 random(42);
+	for (size_t i = 0; i < 20000; ++i)
+	{
+		u256 const a = randomNumber(random);
+		u256 const b = randomNumber(random);
+		FixedU256 const fixedA(a);
+		FixedU256 const fixedB(b);
+		unsigned const shift = unsigned(random() % 300);
+		u256 const exponent = random() % 2 ? b : u256(random() % 1000);
+		u256 const index = random() % 40;
+
+		BOOST_CHECK(u256(fixedA + fixedB) == a + b);
+		BOOST_CHECK(u256(fixedA - fixedB) == a - b);
+		BOOST_CHECK(u256(fixedA * fixedB) == a * b);
+		BOOST_CHECK(u256(fixedA / fixedB) == (b == 0 ? 0 : a / b));
+		BOOST_CHECK(u256(fixedA % fixedB) == (b == 0 ? 0 : a % b));
+		BOOST_CHECK(u256(sdiv(fixedA, fixedB)) == (b == 0 ? 0 : s2u(u2s(a) / u2s(b))));
+		BOOST_CHECK(u256(smod(fixedA, fixedB)) == (b == 0 ? 0 : s2u(u2s(a) % u2s(b))));
+		BOOST_CHECK(u256(fixedA & fixedB) == (a & b));
+		BOOST_CHECK(u256(fixedA | fixedB) == (a | b));
+		BOOST_CHECK(u256(fixedA ^ fixedB) == (a ^ b));
+		BOOST_CHECK(u256(~fixedA) == ~a);
+		BOOST_CHECK(u256(fixedA << shift) == (shift >= 256 ? 0 : u256(a << shift)));
+		BOOST_CHECK(u256(fixedA >> shift) == (shift >= 256 ? 0 : u256(a >> shift)));
+		BOOST_CHECK(u256(exp(fixedA, FixedU256(exponent))) == exp256(a, exponent));
+		BOOST_CHECK(u256(signExtend(FixedU256(index), fixedA)) == signExtendReference(index, a));
+		BOOST_CHECK((fixedA < fixedB) == (a < b));
+		BOOST_CHECK((fixedA == fixedB) == (a == b));
+		BOOST_CHECK(fixedA.bitLength() == (a == 0 ? 0 : boost::multiprecision::msb(a) + 1));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(performance_against_u256)
+{
+	mt19937_64 random(7);
+	vector<u256> numbers;
+	for (size_t i = 0; i < 2000; ++i)
+		numbers.emplace_back(randomNumber(random));
+	vector<FixedU256> fixedNumbers(numbers.begin(), numbers.end());
+
+	auto measure = [](auto const& _numbers) {
+		auto const start = chrono::steady_clock::now();
+		auto checksum = _numbers.front();
+		for (size_t i = 1; i < _numbers.size(); ++i)
+		{
+			auto const& a = _numbers[i - 1];
+			auto const& b = _numbers[i];
+			checksum ^= a * b + a / (b | 1) + power(a, b);
+		}
+		return make_pair(checksum, chrono::steady_clock::now() - start);
+	};
+	auto [checksum, time] = measure(numbers);
+	auto [fixedChecksum, fixedTime] = measure(fixedNumbers);
+
+	BOOST_CHECK(u256(fixedChecksum) == checksum);
+	BOOST_TEST_MESSAGE(
+		"u256: " + to_string(chrono::duration_cast<chrono::microseconds>(time).count()) + "us, " +
+		"FixedU256: " + to_string(chrono::duration_cast<chrono::microseconds>(fixedTime).count()) + "us"
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the flat set and map, which are compared against std::set and std::map.
+ */
+
+#include <libsolutil/FlatMap.h>
+#include <libsolutil/FlatSet.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(FlatMapTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(set_random_against_set)
+{
+	mt19937 random(42);
+	FlatSet<int, 4> flat;
+	set<int> expectation;
+	for (size_t i = 0; i < 5000; ++i)
+	{
+		int const value = static_cast<int>(random() % 40);
+		switch (random() % 3)
+		{
+		case 0:
+			BOOST_CHECK(flat.insert(value).second == expectation.insert(value).second);
+			break;
+		case 1:
+			BOOST_CHECK_EQUAL(flat.erase(value), expectation.erase(value));
+			break;
+		case 2:
+			BOOST_CHECK_EQUAL(flat.count(value), expectation.count(value));
+			BOOST_CHECK((flat.lower_bound(value) == flat.end()) == (expectation.lower_bound(value) == expectation.end()));
+			break;
+		}
+		BOOST_REQUIRE(vector<int>(flat.begin(), flat.end()) == vector<int>(expectation.begin(), expectation.end()));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(map_random_against_map)
+{
+	mt19937 random(42);
+	FlatMap<int, unsigned, 4> flat;
+	map<int, unsigned> expectation;
+	for (size_t i = 0; i < 5000; ++i)
+	{
+		int const key = static_cast<int>(random() % 40);
+		unsigned const value = static_cast<unsigned>(random());
+		switch (random() % 5)
+		{
+		case 0:
+			flat[key] = value;
+			expectation[key] = value;
+			break;
+		case 1:
+			BOOST_CHECK(flat.emplace(key, value).second == expectation.emplace(key, value).second);
+			break;
+		case 2:
+			BOOST_CHECK_EQUAL(flat.erase(key), expectation.erase(key));
+			break;
+		case 3:
+			flat.erase(flat.upper_bound(key), flat.end());
+			expectation.erase(expectation.upper_bound(key), expectation.end());
+			break;
+		case 4:
+			BOOST_REQUIRE_EQUAL(flat.count(key), expectation.count(key));
+			if (expectation.count(key))
+				BOOST_CHECK_EQUAL(flat.at(key), expectation.at(key));
+			else
+				BOOST_CHECK_THROW(flat.at(key), out_of_range);
+			break;
+		}
+		using Entries = vector<pair<int, unsigned>>;
+		BOOST_REQUIRE(Entries(flat.begin(), flat.end()) == Entries(expectation.begin(), expectation.end()));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for InvertibleMap and InvertibleRelation.
+ */
+
+#include <libsolutil/InvertibleMap.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(InvertibleMapTest)
+
+BOOST_AUTO_TEST_CASE(map_set_and_erase)
+{
+	InvertibleMap<string, string> data;
+	data.set("a", "x");
+	data.set("b", "x");
+	data.set("c", "y");
+	BOOST_CHECK((data.references.at("x") == set<string>{"a", "b"}));
+
+	data.set("a", "y");
+	BOOST_CHECK((data.references.at("x") == set<string>{"b"}));
+	BOOST_CHECK((data.references.at("y") == set<string>{"a", "c"}));
+
+	data.eraseKey("b");
+	BOOST_CHECK(!data.references.count("x"));
+	BOOST_CHECK_EQUAL(data.values.size(), 2);
+
+	data.eraseValue("y");
+	BOOST_CHECK(data.empty());
+	BOOST_CHECK(data.references.empty());
+}
+
+BOOST_AUTO_TEST_CASE(map_erase_if)
+{
+	InvertibleMap<string, string> data;
+	data.set("a", "x");
+	data.set("b", "y");
+	data.set("c", "x");
+	data.eraseIf([](string const& _key, string const& _value) { return _key == "a" || _value == "y"; });
+	BOOST_CHECK((data.values == unordered_map<string, string>{{"c", "x"}}));
+	BOOST_CHECK((data.references.at("x") == set<string>{"c"}));
+	BOOST_CHECK(!data.references.count("y"));
+}
+
+BOOST_AUTO_TEST_CASE(relation)
+{
+	InvertibleRelation<string> relation;
+	relation.set("a", {"x", "y"});
+	relation.set("b", {"y"});
+	BOOST_CHECK((relation.references.at("y") == set<string>{"a", "b"}));
+
+	relation.set("a", {"z"});
+	BOOST_CHECK(!relation.references.count("x"));
+	BOOST_CHECK((relation.references.at("y") == set<string>{"b"}));
+	BOOST_CHECK((relation.references.at("z") == set<string>{"a"}));
+
+	relation.eraseKey("b");
+	BOOST_CHECK(!relation.values.count("b"));
+	BOOST_CHECK(!relation.references.count("y"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
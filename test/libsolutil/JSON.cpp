@@ -118,6 +118,89 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK("{\"1\":1,\"2\":\"2\",\"3\":{\"3.1\":\"3.1\",\"3.2\":2},\"4\":\"\\u0911 \\u0912 \\u0913 \\u0914 \\u0915 \\u0916\",\"5\":\"\\ufffd\"}" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_stream_print)
+{
+	Json::Value leaf(Json::objectValue);
+	leaf["name"] = "a\x01\":";
+	leaf["values"] = Json::arrayValue;
+	leaf["values"].append(1);
+	leaf["values"].append("\x01");
+	leaf["empty"] = Json::arrayValue;
+	Json::Value inner(Json::objectValue);
+	inner["children"] = Json::arrayValue;
+	inner["children"].append(leaf);
+	inner["children"].append(Json::nullValue);
+	inner["children"].append(leaf);
+	inner["child"] = leaf;
+	Json::Value document(Json::objectValue);
+	document["inner"] = inner;
+	document["list"] = Json::arrayValue;
+	document["list"].append(inner);
+	document["text"] = "\x01";
+
+	// The same document, with all objects but the outermost replaced by placeholders.
+	vector<Json::Value> parts;
+	function<Json::Value(Json::Value)> split = [&](Json::Value _value) {
+		if (_value.isObject())
+			for (string const& member: _value.getMemberNames())
+			{
+				Json::Value& child = _value[member];
+				if (child.isObject())
+				{
+					parts.push_back(split(child));
+					child = jsonPlaceholder(parts.size() - 1);
+				}
+				else
+					child = split(child);
+			}
+		else if (_value.isArray())
+			for (Json::Value& child: _value)
+				if (child.isObject())
+				{
+					parts.push_back(split(child));
+					child = jsonPlaceholder(parts.size() - 1);
+				}
+		return _value;
+	};
+	Json::Value const root = split(document);
+	BOOST_REQUIRE_EQUAL(parts.size(), 8);
+
+	for (JsonFormat format: {JsonFormat{JsonFormat::Compact}, JsonFormat{JsonFormat::Pretty}, JsonFormat{JsonFormat::Pretty, 4}})
+	{
+		function<void(ostream&, size_t, string const&)> printPart = [&](ostream& _stream, size_t _index, string const& _indentation) {
+			jsonStreamPrint(_stream, parts.at(_index), format, printPart, _indentation);
+		};
+		stringstream output;
+		jsonStreamPrint(output, root, format, printPart);
+		BOOST_CHECK_EQUAL(output.str(), jsonPrint(document, format));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(json_stream_print_string)
+{
+	// Long enough to be escaped in several chunks, with multi-byte characters and invalid
+	// UTF-8 sequences right before line breaks.
+	string text;
+	for (size_t i = 0; i < 20000; ++i)
+		text += "line \"" + to_string(i) + "\"\t\\ \xc3\xa4\xf0\x9f\x98\x80" + (i % 7 ? "\n" : "\xe2\n") + (i % 5 ? "" : "\xc3");
+	Json::Value document(Json::objectValue);
+	document["value"] = jsonStringPlaceholder(0);
+	document["other"] = "\x01";
+	for (JsonFormat format: {JsonFormat{JsonFormat::Compact}, JsonFormat{JsonFormat::Pretty}, JsonFormat{JsonFormat::Pretty, 4}})
+	{
+		stringstream output;
+		jsonStreamPrint(output, document, format, [&](ostream& _stream, size_t, string const&) {
+			jsonStreamPrintString(_stream, text);
+		});
+		Json::Value expected = document;
+		expected["value"] = text;
+		BOOST_CHECK_EQUAL(output.str(), jsonPrint(expected, format));
+	}
+	stringstream empty;
+	jsonStreamPrintString(empty, "");
+	BOOST_CHECK_EQUAL(empty.str(), "\"\"");
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
@@ -184,6 +267,47 @@ BOOST_AUTO_TEST_CASE(parse_json_strict)
 	BOOST_CHECK(json[0] == "😊");
 }
 
+BOOST_AUTO_TEST_CASE(parse_json_strict_extracting_strings)
+{
+	auto extractContents = [](vector<string> const& _path) {
+		return _path.size() == 3 && _path[0] == "sources" && _path[2] == "content";
+	};
+	Json::Value json;
+	vector<pair<vector<string>, string>> extracted;
+	string errors;
+
+	BOOST_CHECK(jsonParseStrictExtractingStrings(
+		"{\"sources\": {\"a\": {\"content\": \"x\\n\\\"\\u00e9\\ud83d\\ude0a\"}, \"b\": {\"urls\": [\"u\"]}},"
+		" \"settings\": {\"content\": \"y\", \"list\": [{\"content\": \"z\"}]}}",
+		json,
+		extractContents,
+		extracted,
+		&errors
+	));
+	BOOST_CHECK(errors.empty());
+	BOOST_REQUIRE_EQUAL(extracted.size(), 1);
+	BOOST_CHECK(extracted[0].first == (vector<string>{"sources", "a", "content"}));
+	BOOST_CHECK_EQUAL(extracted[0].second, "x\n\"é😊");
+	BOOST_CHECK(json["sources"]["a"]["content"] == "");
+	BOOST_CHECK(json["sources"]["b"]["urls"][0] == "u");
+	BOOST_CHECK(json["settings"]["content"] == "y");
+	BOOST_CHECK(json["settings"]["list"][0]["content"] == "z");
+
+	// Invalid input is reported like by jsonParseStrict, with positions in the original input.
+	for (string const& input: {
+		"{\"sources\": {\"a\": {\"content\": \"\\q\"}}}",
+		"{\"sources\": {\"a\": {\"content\": \"x\"}}, }",
+		"{\"sources\": {\"a\": {\"content\": \"x\"}, \"a\": {\"content\": \"y\"}}}"
+	})
+	{
+		string expectedErrors;
+		BOOST_CHECK(!jsonParseStrict(input, json, &expectedErrors));
+		BOOST_CHECK(!jsonParseStrictExtractingStrings(input, json, extractContents, extracted, &errors));
+		BOOST_CHECK_EQUAL(errors, expectedErrors);
+		BOOST_CHECK(extracted.empty());
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -69,6 +69,30 @@ BOOST_AUTO_TEST_CASE(strings)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(many)
+{
+	BOOST_CHECK(keccak256Many({}).empty());
+
+	// Inputs of one, two and three blocks, with lengths around the block size of 136 bytes,
+	// so that some of them are hashed in parallel and some of them on their own.
+	vector<bytes> inputs;
+	for (size_t length: {0, 1, 135, 136, 137, 271, 272, 300, 5, 64, 64, 64, 64, 64, 10})
+		inputs.emplace_back(length, static_cast<uint8_t>(length));
+	inputs.emplace_back(asBytes("test"));
+	vector<bytesConstRef> refs;
+	for (bytes const& input: inputs)
+		refs.emplace_back(&input);
+
+	vector<h256> hashes = keccak256Many(refs);
+	BOOST_REQUIRE_EQUAL(hashes.size(), inputs.size());
+	for (size_t i = 0; i < inputs.size(); ++i)
+		BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+	BOOST_CHECK_EQUAL(
+		hashes.back(),
+		FixedHash<32>("0x9c22ff5f21f0b81b113e63f7db6da94fedef11b2119b4088b89664fb9a3cb658")
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
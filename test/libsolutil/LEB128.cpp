@@ -96,6 +96,12 @@ BOOST_AUTO_TEST_CASE(encode_signed)
 	BOOST_REQUIRE(negative_larger[5] == 0x7C);
 }
 
+BOOST_AUTO_TEST_CASE(encoded_size)
+{
+	for (uint64_t value: {0ull, 1ull, 0x7full, 0x80ull, 0x3fffull, 0x4000ull, 624485ull, 123456123456ull, ~0ull})
+		BOOST_CHECK_EQUAL(solidity::util::lebEncodedSize(value), solidity::util::lebEncode(value).size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
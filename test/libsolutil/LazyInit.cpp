@@ -20,7 +20,11 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <atomic>
+#include <stdexcept>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace solidity::util::test
 {
@@ -114,6 +118,49 @@ BOOST_AUTO_TEST_CASE(move_constructed_has_same_value_as_original)
 	BOOST_CHECK_EQUAL(valueOf(std::move(moveConstructed)), 12);
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_init_calls_function_once)
+{
+	for (size_t round = 0; round < 100; ++round)
+	{
+		ConcurrentLazyInit<std::vector<int> const> lazyInit;
+		std::atomic<size_t> calls = 0;
+		std::vector<std::vector<int> const*> results(4);
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < results.size(); ++t)
+			threads.emplace_back([&, t]() {
+				results[t] = &lazyInit.init([&]{
+					++calls;
+					return std::vector<int>(100, 12);
+				});
+			});
+		for (std::thread& t: threads)
+			t.join();
+
+		BOOST_REQUIRE_EQUAL(calls, 1);
+		for (auto const* result: results)
+		{
+			BOOST_REQUIRE(result == results.front());
+			BOOST_REQUIRE_EQUAL(result->at(99), 12);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_reset_initializes_again)
+{
+	ConcurrentLazyInit<int> lazyInit;
+	BOOST_CHECK_EQUAL(lazyInit.init([]{ return 12; }), 12);
+	BOOST_CHECK_EQUAL(lazyInit.init([]{ return 42; }), 12);
+	lazyInit.reset();
+	BOOST_CHECK_EQUAL(lazyInit.init([]{ return 42; }), 42);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_init_retries_after_exception)
+{
+	ConcurrentLazyInit<int> lazyInit;
+	BOOST_CHECK_THROW(lazyInit.init([]() -> int { throw std::runtime_error("init"); }), std::runtime_error);
+	BOOST_CHECK_EQUAL(lazyInit.init([]{ return 12; }), 12);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,61 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the numeric helper functions.
+ */
+
+#include <libsolutil/Numeric.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(NumericTest)
+
+BOOST_AUTO_TEST_CASE(parse_decimal_number)
+{
+	BOOST_CHECK(parseNumber("", 10) == bigint(0));
+	BOOST_CHECK(parseNumber("0", 10) == bigint(0));
+	BOOST_CHECK(parseNumber("1234", 10) == bigint(1234));
+	BOOST_CHECK(parseNumber("18446744073709551615", 10) == bigint("18446744073709551615"));
+	string const digits = "123456789012345678901234567890123456789012345678901234567890123456789012345678";
+	for (size_t length = 1; length <= digits.size(); ++length)
+		BOOST_CHECK(parseNumber(digits.substr(0, length), 10) == bigint(digits.substr(0, length)));
+	BOOST_CHECK(!parseNumber("12a", 10));
+	BOOST_CHECK(!parseNumber("-1", 10));
+}
+
+BOOST_AUTO_TEST_CASE(parse_hex_number)
+{
+	BOOST_CHECK(parseNumber("", 16) == bigint(0));
+	BOOST_CHECK(parseNumber("fF", 16) == bigint(255));
+	string const digits = "0123456789abcdefABCDEF0123456789abcdef0123456789abcdef0123456789abcdef0123456789";
+	for (size_t length = 1; length <= digits.size(); ++length)
+		BOOST_CHECK(parseNumber(digits.substr(0, length), 16) == bigint("0x" + digits.substr(0, length)));
+	BOOST_CHECK(!parseNumber("0x1", 16));
+	BOOST_CHECK(!parseNumber("g", 16));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ParallelTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(no_jobs)
+{
+	bool called = false;
+	parallelFor(0, 4, [&](size_t) { called = true; });
+	BOOST_CHECK(!called);
+}
+
+BOOST_AUTO_TEST_CASE(every_index_visited_once)
+{
+	for (size_t threads: vector<size_t>{0, 1, 2, 7, 100})
+	{
+		vector<atomic<unsigned>> visits(50);
+		parallelFor(visits.size(), threads, [&](size_t _index) { ++visits[_index]; });
+		for (auto const& count: visits)
+			BOOST_CHECK_EQUAL(count.load(), 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_exception_of_smallest_index)
+{
+	for (size_t threads: vector<size_t>{1, 4})
+	{
+		atomic<unsigned> finished{0};
+		BOOST_CHECK_EXCEPTION(
+			parallelFor(10, threads, [&](size_t _index) {
+				if (_index == 3 || _index == 7)
+					throw runtime_error(to_string(_index));
+				++finished;
+			}),
+			runtime_error,
+			[](runtime_error const& _error) { return string(_error.what()) == "3"; }
+		);
+		// The failing jobs did not prevent the other ones from running.
+		BOOST_CHECK_EQUAL(finished.load(), 8);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,111 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for SHA-256, which is compared against picosha2.
+ */
+
+#include <libsolutil/SHA256.h>
+#include <libsolutil/picosha2.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <random>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+bytes picosha2Hash(bytes const& _input)
+{
+	bytes hash(picosha2::k_digest_size);
+	picosha2::hash256(_input.begin(), _input.end(), hash.begin(), hash.end());
+	return hash;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SHA256Test, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(known_hashes)
+{
+	BOOST_CHECK_EQUAL(
+		sha256(bytesConstRef()),
+		FixedHash<32>("0xe3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855")
+	);
+	BOOST_CHECK_EQUAL(
+		sha256(bytesConstRef("abc")),
+		FixedHash<32>("0xba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad")
+	);
+	BOOST_CHECK_EQUAL(
+		sha256(bytesConstRef("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")),
+		FixedHash<32>("0x248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1")
+	);
+	bytes const million(1000000, 'a');
+	BOOST_CHECK_EQUAL(
+		sha256(&million),
+		FixedHash<32>("0xcdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(random_against_picosha2)
+{
+	mt19937 random(42);
+	for (size_t i = 0; i < 500; ++i)
+	{
+		bytes input(random() % 1000);
+		for (uint8_t& byte: input)
+			byte = static_cast<uint8_t>(random());
+
+		BOOST_CHECK(sha256(&input).asBytes() == picosha2Hash(input));
+
+		// Incremental hashing in parts of random sizes, which may be empty or span blocks.
+		SHA256 hasher;
+		for (size_t position = 0; position < input.size();)
+		{
+			size_t const size = min<size_t>(random() % 150, input.size() - position);
+			hasher.update(bytesConstRef(input.data() + position, size));
+			position += size;
+		}
+		BOOST_CHECK(hasher.digest().asBytes() == picosha2Hash(input));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(performance_against_picosha2)
+{
+	bytes const input(1 << 22, 0x5a);
+	auto const start = chrono::steady_clock::now();
+	bytes const expectation = picosha2Hash(input);
+	auto const middle = chrono::steady_clock::now();
+	h256 const hash = sha256(&input);
+	auto const end = chrono::steady_clock::now();
+
+	BOOST_CHECK(hash.asBytes() == expectation);
+	BOOST_TEST_MESSAGE(
+		"picosha2: " + to_string(chrono::duration_cast<chrono::microseconds>(middle - start).count()) + "us, " +
+		"sha256: " + to_string(chrono::duration_cast<chrono::microseconds>(end - middle).count()) + "us"
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,122 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the small vector, which is compared against std::vector.
+ */
+
+#include <libsolutil/SmallVector.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(SmallVectorTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(inline_storage)
+{
+	SmallVector<int, 4> numbers{1, 2, 3};
+	BOOST_CHECK(numbers.isInline());
+	numbers.push_back(4);
+	BOOST_CHECK(numbers.isInline());
+	numbers.push_back(5);
+	BOOST_CHECK(!numbers.isInline());
+	BOOST_CHECK_EQUAL(numbers.size(), 5);
+	BOOST_CHECK_EQUAL(numbers.back(), 5);
+
+	SmallVector<int, 4> moved = move(numbers);
+	BOOST_CHECK(numbers.empty());
+	BOOST_CHECK(numbers.isInline());
+	BOOST_CHECK(moved == (SmallVector<int, 4>{1, 2, 3, 4, 5}));
+}
+
+BOOST_AUTO_TEST_CASE(element_as_argument)
+{
+	// The arguments refer to elements that are moved when the vector grows.
+	SmallVector<string, 2> strings{"a very long string that is allocated", "b"};
+	strings.push_back(strings.front());
+	strings.insert(strings.begin(), strings.back());
+	BOOST_CHECK(strings == (SmallVector<string, 2>{
+		"a very long string that is allocated",
+		"a very long string that is allocated",
+		"b",
+		"a very long string that is allocated"
+	}));
+}
+
+BOOST_AUTO_TEST_CASE(random_against_vector)
+{
+	mt19937 random(42);
+	for (size_t round = 0; round < 200; ++round)
+	{
+		SmallVector<string, 3> small;
+		vector<string> expectation;
+		for (size_t i = 0; i < 50; ++i)
+		{
+			string value = to_string(random()) + string(random() % 2 ? 30 : 0, 'x');
+			switch (random() % 6)
+			{
+			case 0:
+			case 1:
+				small.push_back(value);
+				expectation.push_back(value);
+				break;
+			case 2:
+			{
+				size_t position = random() % (expectation.size() + 1);
+				small.insert(small.begin() + position, value);
+				expectation.insert(expectation.begin() + static_cast<ptrdiff_t>(position), value);
+				break;
+			}
+			case 3:
+				if (!expectation.empty())
+				{
+					size_t first = random() % expectation.size();
+					size_t last = first + random() % (expectation.size() - first + 1);
+					small.erase(small.begin() + first, small.begin() + last);
+					expectation.erase(expectation.begin() + static_cast<ptrdiff_t>(first), expectation.begin() + static_cast<ptrdiff_t>(last));
+				}
+				break;
+			case 4:
+			{
+				SmallVector<string, 3> copy = small;
+				small = random() % 2 ? move(copy) : copy;
+				break;
+			}
+			case 5:
+				if (!expectation.empty())
+				{
+					small.pop_back();
+					expectation.pop_back();
+				}
+				break;
+			}
+			BOOST_REQUIRE(vector<string>(small.begin(), small.end()) == expectation);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
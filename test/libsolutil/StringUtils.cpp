@@ -29,6 +29,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <random>
+
 using namespace std;
 
 namespace solidity::util::test
@@ -73,6 +75,32 @@ BOOST_AUTO_TEST_CASE(test_dldistance)
 
 }
 
+BOOST_AUTO_TEST_CASE(test_bounded_dldistance)
+{
+	BOOST_CHECK_EQUAL(boundedStringDistance("hello", "helol", 2), 1);
+	BOOST_CHECK_EQUAL(boundedStringDistance("hello", "hllllo", 2), 2);
+	BOOST_CHECK_EQUAL(boundedStringDistance("hello", "hllllo", 1), 2);
+	BOOST_CHECK_EQUAL(boundedStringDistance("abc", "abcdef", 2), 3);
+	BOOST_CHECK_EQUAL(boundedStringDistance("abcd", "wxyz", 0), 1);
+	BOOST_CHECK_EQUAL(boundedStringDistance("", "", 0), 0);
+
+	// Strings over a small alphabet, so that there are many matches and transpositions.
+	mt19937 random(42);
+	auto randomString = [&]() {
+		string result(random() % 12, 'a');
+		for (char& c: result)
+			c = static_cast<char>('a' + random() % 3);
+		return result;
+	};
+	for (size_t i = 0; i < 5000; ++i)
+	{
+		string const a = randomString();
+		string const b = random() % 2 ? randomString() : a.substr(0, a.size() / 2) + randomString().substr(0, 2) + a.substr(a.size() / 2);
+		size_t const maxDistance = random() % 5;
+		BOOST_CHECK_EQUAL(boundedStringDistance(a, b, maxDistance), min(stringDistance(a, b), maxDistance + 1));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(test_alternatives_list)
 {
 	vector<string> strings;
@@ -0,0 +1,138 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Timing.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <set>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(TimingTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(null_collector)
+{
+	// Must not crash.
+	ScopedTimer timer(nullptr, "phase", true);
+}
+
+BOOST_AUTO_TEST_CASE(accumulate)
+{
+	TimingCollector collector;
+	collector.record("a", chrono::microseconds(3));
+	collector.record("a", chrono::microseconds(4), 10);
+	collector.record("b", chrono::microseconds(1), 20);
+	collector.record("a", chrono::microseconds(5), 5);
+
+	auto const entries = collector.entries();
+	BOOST_REQUIRE_EQUAL(entries.size(), 2);
+	BOOST_CHECK(entries.at("a").wallTime == chrono::microseconds(12));
+	BOOST_CHECK_EQUAL(entries.at("a").count, 3);
+	BOOST_CHECK_EQUAL(entries.at("a").peakMemory, 10);
+	BOOST_CHECK(entries.at("b").wallTime == chrono::microseconds(1));
+	BOOST_CHECK_EQUAL(entries.at("b").count, 1);
+	BOOST_CHECK_EQUAL(entries.at("b").peakMemory, 20);
+}
+
+BOOST_AUTO_TEST_CASE(record_change)
+{
+	TimingCollector collector;
+	collector.record("a", chrono::microseconds(1));
+	collector.recordChange("a", true, -5);
+	collector.record("a", chrono::microseconds(1));
+	collector.recordChange("a", false, 0);
+	collector.recordChange("a", true, 2);
+
+	auto const entries = collector.entries();
+	BOOST_CHECK_EQUAL(entries.at("a").count, 2);
+	BOOST_CHECK_EQUAL(entries.at("a").changes, 2);
+	BOOST_CHECK_EQUAL(entries.at("a").sizeDelta, -3);
+}
+
+BOOST_AUTO_TEST_CASE(scoped_timer)
+{
+	TimingCollector collector;
+	{
+		ScopedTimer timer(&collector, "sleep");
+		this_thread::sleep_for(chrono::milliseconds(2));
+	}
+	auto const entries = collector.entries();
+	BOOST_REQUIRE_EQUAL(entries.count("sleep"), 1);
+	BOOST_CHECK(entries.at("sleep").wallTime >= chrono::milliseconds(2));
+	BOOST_CHECK_EQUAL(entries.at("sleep").count, 1);
+	BOOST_CHECK_EQUAL(entries.at("sleep").peakMemory, 0);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_recording)
+{
+	TimingCollector collector;
+	parallelFor(100, 4, [&](size_t _index) {
+		collector.record(_index % 2 ? "odd" : "even", chrono::microseconds(1));
+	});
+	auto const entries = collector.entries();
+	BOOST_CHECK_EQUAL(entries.at("odd").count, 50);
+	BOOST_CHECK_EQUAL(entries.at("even").count, 50);
+	BOOST_CHECK(entries.at("odd").wallTime == chrono::microseconds(50));
+}
+
+BOOST_AUTO_TEST_CASE(trace_events)
+{
+	{
+		ScopedTraceSpan span("not recorded", "test");
+	}
+	TraceRecorder::enable();
+	{
+		ScopedTimer timer(nullptr, "outer");
+		ScopedTraceSpan span("inner \"span\"", "test");
+	}
+	parallelFor(4, 2, [](size_t) { ScopedTraceSpan span("parallel", "test"); });
+	TraceRecorder::disable();
+	{
+		ScopedTraceSpan span("not recorded", "test");
+	}
+
+	ostringstream stream;
+	TraceRecorder::print(stream);
+	Json::Value trace;
+	BOOST_REQUIRE(jsonParseStrict(stream.str(), trace));
+	map<string, size_t> spanCounts;
+	set<int> threads;
+	for (auto const& event: trace["traceEvents"])
+		if (event["ph"].asString() == "X")
+		{
+			++spanCounts[event["name"].asString()];
+			threads.insert(event["tid"].asInt());
+			BOOST_CHECK(event["ts"].asDouble() >= 0);
+			BOOST_CHECK(event["dur"].asDouble() >= 0);
+		}
+	BOOST_CHECK((spanCounts == map<string, size_t>{{"outer", 1}, {"inner \"span\"", 1}, {"parallel", 4}}));
+	BOOST_CHECK(threads.count(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -26,6 +26,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <chrono>
+#include <random>
+
 using namespace std;
 
 namespace solidity::util::test
@@ -51,6 +54,64 @@ bool isInvalidUTF8(string const& _value, size_t _expectedPos)
 	return true;
 }
 
+/// Byte by byte validation, which the block-wise validation has to agree with, including the position.
+bool referenceValidateUTF8(string const& _input, size_t& _invalidPosition)
+{
+	auto const* input = reinterpret_cast<unsigned char const*>(_input.data());
+	bool valid = true;
+	size_t i = 0;
+	for (; i < _input.size(); i++)
+	{
+		if (input[i] < 0x80)
+			continue;
+		size_t count = 0;
+		if (input[i] >= 0xc0 && input[i] <= 0xdf)
+			count = 1;
+		else if (input[i] >= 0xe0 && input[i] <= 0xef)
+			count = 2;
+		else if (input[i] >= 0xf0 && input[i] <= 0xf7)
+			count = 3;
+		if (count == 0 || i + count >= _input.size())
+		{
+			valid = false;
+			break;
+		}
+		for (size_t j = 0; j < count; j++)
+		{
+			i++;
+			unsigned char const lead = input[i - 1];
+			unsigned char const next = input[i];
+			bool const wellFormed = j > 0 || (
+				lead >= 0xc2 && lead <= 0xf4 &&
+				!(lead == 0xe0 && next < 0xa0) &&
+				!(lead == 0xed && next > 0x9f) &&
+				!(lead == 0xf0 && next < 0x90) &&
+				!(lead == 0xf4 && next > 0x8f)
+			);
+			if ((next & 0xc0) != 0x80 || !wellFormed)
+			{
+				valid = false;
+				break;
+			}
+		}
+	}
+	if (!valid)
+		_invalidPosition = i;
+	return valid;
+}
+
+/// @returns text of mostly ASCII and valid characters, in which some bytes are replaced by random ones.
+string randomText(mt19937& _random, size_t _length)
+{
+	static vector<string> const characters{"a", "0", " ", "\n", "\xc3\xa9", "\xe2\x82\xac", "\xed\x9f\xbf", "\xf0\x9f\x98\x80", "\xf4\x8f\xbf\xbf"};
+	string text;
+	while (text.size() < _length)
+		text += characters[_random() % (_random() % 2 ? 4 : characters.size())];
+	for (size_t i = text.empty() ? 0 : _random() % 3; i > 0; --i)
+		text[_random() % text.size()] = static_cast<char>(_random());
+	return text;
+}
+
 }
 
 BOOST_AUTO_TEST_CASE(valid)
@@ -92,6 +153,64 @@ BOOST_AUTO_TEST_CASE(invalid)
 	BOOST_CHECK(isInvalidUTF8("f9", 0)); // invalid per table 3.7
 }
 
+BOOST_AUTO_TEST_CASE(invalid_after_blocks)
+{
+	string const ascii(100, 'a');
+	string const twoByte = asString(fromHex("c3a9"));
+	size_t pos;
+	BOOST_CHECK(!validateUTF8(ascii + asString(fromHex("e08081")), pos));
+	BOOST_CHECK_EQUAL(pos, 102);
+	BOOST_CHECK(!validateUTF8(ascii + twoByte + asString(fromHex("80")) + ascii, pos));
+	BOOST_CHECK_EQUAL(pos, 102);
+	// An incomplete character at the end of a block of sixteen bytes. The validation continues after
+	// the missing continuation byte, so the position is the end of the input.
+	BOOST_CHECK(!validateUTF8(string(15, 'a') + asString(fromHex("e2")) + ascii, pos));
+	BOOST_CHECK_EQUAL(pos, 116);
+	BOOST_CHECK(!validateUTF8(string(63, 'a') + asString(fromHex("f09f98")) + ascii + twoByte, pos));
+	BOOST_CHECK_EQUAL(pos, 168);
+}
+
+BOOST_AUTO_TEST_CASE(random_against_byte_by_byte)
+{
+	mt19937 random(42);
+	for (size_t i = 0; i < 20000; ++i)
+	{
+		string const text = randomText(random, random() % 300);
+		size_t position = 0;
+		size_t expectedPosition = 0;
+		bool const valid = validateUTF8(text, position);
+		BOOST_REQUIRE_EQUAL(valid, referenceValidateUTF8(text, expectedPosition));
+		if (!valid)
+			BOOST_REQUIRE_EQUAL(position, expectedPosition);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(performance_against_byte_by_byte)
+{
+	string ascii;
+	while (ascii.size() < (1 << 22))
+		ascii += "contract C { function f() public pure returns (uint) { return 1; } }\n";
+	string text;
+	while (text.size() < (1 << 22))
+		text += "// Gr\xc3\xbc\xc3\x9f dich, \xe2\x82\xac and \xf0\x9f\x98\x80\n";
+
+	for (string const* input: {&ascii, &text})
+	{
+		size_t position = 0;
+		auto const start = chrono::steady_clock::now();
+		bool const expectation = referenceValidateUTF8(*input, position);
+		auto const middle = chrono::steady_clock::now();
+		bool const valid = validateUTF8(*input, position);
+		auto const end = chrono::steady_clock::now();
+
+		BOOST_CHECK(valid && expectation);
+		BOOST_TEST_MESSAGE(
+			"byte by byte: " + to_string(chrono::duration_cast<chrono::microseconds>(middle - start).count()) + "us, " +
+			"validateUTF8: " + to_string(chrono::duration_cast<chrono::microseconds>(end - middle).count()) + "us"
+		);
+	}
+}
+
 BOOST_AUTO_TEST_CASE(corpus)
 {
 	string source = R"(
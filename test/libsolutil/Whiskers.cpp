@@ -208,6 +208,30 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(unclosed_elements_rendered)
+{
+	string templ = "<#l>a <?c>b <x></c> <?c>c<!c>d";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("x", "X")("c", true).render(), "<#l>a b X <?c>c<!c>d");
+}
+
+BOOST_AUTO_TEST_CASE(first_closing_tag)
+{
+	string templ = "<?c>a<?c>b</c>c<!c>d</c>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true).render(), "a<?c>bc<!c>d</c>");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false).render(), "c<!c>d</c>");
+}
+
+BOOST_AUTO_TEST_CASE(same_template_different_values)
+{
+	string templ = "<#l><x><?c>!</c></l>";
+	vector<map<string, string>> list(2);
+	list[0]["x"] = "a";
+	list[1]["x"] = "b";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("l", list)("c", true).render(), "a!b!");
+	list.pop_back();
+	BOOST_CHECK_EQUAL(Whiskers(templ)("l", list)("c", false).render(), "a");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the cache of analyses shared between optimiser steps.
+ */
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/AnalysisCache.h>
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+
+#include <liblangutil/ErrorReporter.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulAnalysisCache)
+
+BOOST_AUTO_TEST_CASE(matches_uncached_analyses)
+{
+	EVMDialect dialect{EVMVersion{}, true};
+	ErrorList errorList;
+	auto [object, analysisInfo] = yul::test::parse(R"({
+		{ f() }
+		function f() { g() sstore(0, msize()) }
+		function g() { for {} 1 {} { h() } }
+		function h() { g() }
+	})", dialect, errorList);
+	BOOST_REQUIRE(object && errorList.empty() && object->code);
+	Block& ast = *object->code;
+
+	NameDispenser dispenser(dialect, ast);
+	set<YulString> reserved;
+	AnalysisCache cache;
+	OptimiserStepContext context{dialect, dispenser, reserved, 0, 1, &cache};
+	cache.setAST(ast, 0, {1, 2, 3, 4});
+
+	CallGraph expected = CallGraphGenerator::callGraph(ast);
+	CallGraph callGraph = AnalysisCache::callGraph(context, ast);
+	BOOST_CHECK(callGraph.functionCalls == expected.functionCalls);
+	BOOST_CHECK(callGraph.functionsWithLoops == expected.functionsWithLoops);
+	BOOST_CHECK(
+		AnalysisCache::sideEffects(context, ast) ==
+		SideEffectsPropagator::sideEffects(dialect, expected)
+	);
+	BOOST_CHECK(AnalysisCache::containsMSize(context, ast));
+	BOOST_CHECK(AnalysisCache::functionBodyHashes(context, ast) == BlockHasher::functionBodyHashes(ast));
+
+	// Once the AST is no longer announced, the analyses are computed from scratch.
+	cache.invalidate();
+	get<FunctionDefinition>(ast.statements[1]).body.statements.clear();
+	BOOST_CHECK(!AnalysisCache::containsMSize(context, ast));
+	BOOST_CHECK(AnalysisCache::callGraph(context, ast).functionCalls.at("f"_yulstring).empty());
+
+	// Only the changed statement is analysed again.
+	cache.setAST(ast, 1, {1, 5, 3, 4});
+	BOOST_CHECK(!AnalysisCache::containsMSize(context, ast));
+	BOOST_CHECK(AnalysisCache::callGraph(context, ast).functionCalls.at("f"_yulstring).empty());
+	BOOST_CHECK(AnalysisCache::callGraph(context, ast).functionCalls.at("g"_yulstring).count("h"_yulstring));
+	BOOST_CHECK(AnalysisCache::functionBodyHashes(context, ast) == BlockHasher::functionBodyHashes(ast));
+	BOOST_CHECK_EQUAL(AnalysisCache::functionBodyHashes(context, ast).at("f"_yulstring), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,170 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for writing bytecode directly without an evmasm assembly.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/AssemblyStack.h>
+
+#include <libevmasm/LinkerObject.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <optional>
+#include <string>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+pair<MachineAssemblyObject, MachineAssemblyObject> assemble(
+	string const& _source,
+	frontend::OptimiserSettings const& _settings,
+	bool _direct
+)
+{
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		_settings,
+		DebugInfoSelection::All()
+	);
+	stack.setDirectBytecodeGeneration(_direct);
+	BOOST_REQUIRE(stack.parseAndAnalyze("source", _source));
+	stack.optimize();
+	return stack.assembleWithDeployed();
+}
+
+void checkEqual(MachineAssemblyObject const& _direct, MachineAssemblyObject const& _assembled)
+{
+	BOOST_REQUIRE(!!_direct.bytecode == !!_assembled.bytecode);
+	if (!_direct.bytecode)
+		return;
+	BOOST_CHECK_EQUAL(_direct.bytecode->toHex(), _assembled.bytecode->toHex());
+	BOOST_CHECK(_direct.bytecode->linkReferences == _assembled.bytecode->linkReferences);
+	BOOST_CHECK(_direct.bytecode->immutableReferences == _assembled.bytecode->immutableReferences);
+	BOOST_CHECK_EQUAL(_direct.bytecode->functionDebugData.size(), _assembled.bytecode->functionDebugData.size());
+	for (auto const& [name, data]: _assembled.bytecode->functionDebugData)
+	{
+		BOOST_REQUIRE(_direct.bytecode->functionDebugData.count(name));
+		auto const& directData = _direct.bytecode->functionDebugData.at(name);
+		BOOST_CHECK(directData.bytecodeOffset == data.bytecodeOffset);
+		BOOST_CHECK(directData.instructionIndex == data.instructionIndex);
+	}
+	BOOST_REQUIRE(_direct.sourceMappings && _assembled.sourceMappings);
+	BOOST_CHECK_EQUAL(*_direct.sourceMappings, *_assembled.sourceMappings);
+	BOOST_CHECK(_direct.assembly.empty());
+}
+
+void checkSameAsAssembly(string const& _source)
+{
+	frontend::OptimiserSettings yulOptimiserOnly = frontend::OptimiserSettings::none();
+	yulOptimiserOnly.runYulOptimiser = true;
+	yulOptimiserOnly.optimizeStackAllocation = true;
+	for (auto const& settings: {frontend::OptimiserSettings::none(), yulOptimiserOnly})
+	{
+		auto [creation, deployed] = assemble(_source, settings, true);
+		auto [assembledCreation, assembledDeployed] = assemble(_source, settings, false);
+		checkEqual(creation, assembledCreation);
+		checkEqual(deployed, assembledDeployed);
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulBytecodeAssembly)
+
+BOOST_AUTO_TEST_CASE(code_only)
+{
+	checkSameAsAssembly(R"({
+		function f(a, b) -> c {
+			for { let i := 0 } lt(i, b) { i := add(i, 1) } {
+				switch a
+				case 0 { c := add(c, 0x1234567890) }
+				case 0x20 { continue }
+				default { break }
+			}
+		}
+		sstore(0, f(calldataload(0), calldataload(0x20)))
+		sstore(1, linkersymbol("contract/test.sol:L"))
+		sstore(2, verbatim_1i_1o(hex"600202", calldataload(0x40)))
+	})");
+}
+
+BOOST_AUTO_TEST_CASE(objects)
+{
+	checkSameAsAssembly(R"(
+		object "A" {
+			code {
+				let size := datasize("A_deployed")
+				datacopy(0, dataoffset("A_deployed"), size)
+				setimmutable(0, "x", calldataload(0))
+				mstore(0x40, dataoffset("data"))
+				mstore(0x60, datasize("data"))
+				return(0, size)
+			}
+			object "A_deployed" {
+				code {
+					function g(x) -> y { y := mul(x, loadimmutable("x")) }
+					sstore(0, g(loadimmutable("x")))
+					sstore(1, dataoffset("B"))
+					sstore(2, datasize("B"))
+				}
+				object "B" {
+					code { invalid() }
+				}
+			}
+			data "data" hex"00ff"
+			data ".metadata" "metadata"
+		}
+	)");
+}
+
+BOOST_AUTO_TEST_CASE(nested_sub_paths)
+{
+	checkSameAsAssembly(R"(
+		object "A" {
+			code {
+				sstore(0, dataoffset("B.C"))
+				sstore(1, datasize("B.C"))
+				sstore(2, dataoffset("B"))
+			}
+			object "B" {
+				code { sstore(0, datasize("C")) }
+				object "C" {
+					code { sstore(0, 1) }
+				}
+			}
+		}
+	)");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
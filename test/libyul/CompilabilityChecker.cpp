@@ -34,12 +34,17 @@ namespace solidity::yul::test
 
 namespace
 {
-string check(string const& _input)
+string check(string const& _input, optional<set<YulString>> const& _functionsToCheck = nullopt)
 {
 	Object obj;
 	std::tie(obj.code, obj.analysisInfo) = yul::test::parse(_input, false);
 	BOOST_REQUIRE(obj.code);
-	auto functions = CompilabilityChecker(EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion()), obj, true).stackDeficit;
+	auto functions = CompilabilityChecker(
+		EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion()),
+		obj,
+		true,
+		_functionsToCheck
+	).stackDeficit;
 	string out;
 	for (auto const& function: functions)
 		out += function.first.str() + ": " + to_string(function.second) + " ";
@@ -335,6 +340,46 @@ BOOST_AUTO_TEST_CASE(also_in_outer_block_unused_arguments)
 	BOOST_CHECK_EQUAL(out, ": 9 ");
 }
 
+BOOST_AUTO_TEST_CASE(only_selected_functions)
+{
+	string source = R"({
+		{
+			let x := 0
+			let r1 := 0
+			let r2 := 0
+			let r3 := 0
+			let r4 := 0
+			let r5 := 0
+			let r6 := 0
+			let r7 := 0
+			let r8 := 0
+			let r9 := 0
+			let r10 := 0
+			let r11 := 0
+			let r12 := 0
+			let r13 := 0
+			let r14 := 0
+			let r15 := 0
+			let r16 := 0
+			let r17 := 0
+			let r18 := 0
+			x := add(add(add(add(add(add(add(add(add(add(add(add(x, r12), r11), r10), r9), r8), r7), r6), r5), r4), r3), r2), r1)
+		}
+		function f(a, b) -> r1, r2, r3, r4, r5, r6, r7, r8, r9, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19 {
+			r1 := 0
+			sstore(a, b)
+		}
+		function g(s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13, s14, s15, s16, s17, s18, s19) -> w, v {
+			w := v
+			sstore(s1, s2)
+		}
+	})";
+	BOOST_CHECK_EQUAL(check(source, set<YulString>{}), "");
+	BOOST_CHECK_EQUAL(check(source, set<YulString>{YulString{}}), ": 9 ");
+	BOOST_CHECK_EQUAL(check(source, set<YulString>{YulString{"f"}}), "f: 5 ");
+	BOOST_CHECK_EQUAL(check(source, set<YulString>{YulString{"g"}}), "g: 5 ");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
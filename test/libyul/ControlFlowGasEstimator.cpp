@@ -0,0 +1,179 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the gas estimation on the control flow graph of Yul code.
+ */
+
+#include <test/Common.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/backends/evm/ControlFlowGasEstimator.h>
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmAnalysisInfo.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+using GasConsumption = ControlFlowGasEstimator::GasConsumption;
+
+class Estimate
+{
+public:
+	explicit Estimate(string const& _source, size_t _parallelism = 1)
+	{
+		std::tie(m_code, m_analysisInfo) = yul::test::parse(_source, false);
+		BOOST_REQUIRE(m_code && m_analysisInfo);
+		EVMDialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+		m_cfg = ControlFlowGraphBuilder::build(*m_analysisInfo, dialect, *m_code);
+		m_estimator = make_unique<ControlFlowGasEstimator>(*m_cfg, dialect, _parallelism);
+	}
+
+	ControlFlowGasEstimator const& operator*() const { return *m_estimator; }
+	ControlFlowGasEstimator const* operator->() const { return m_estimator.get(); }
+
+private:
+	shared_ptr<Block> m_code;
+	shared_ptr<AsmAnalysisInfo> m_analysisInfo;
+	unique_ptr<CFG> m_cfg;
+	unique_ptr<ControlFlowGasEstimator> m_estimator;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(ControlFlowGasEstimatorTest)
+
+BOOST_AUTO_TEST_CASE(smoke_test)
+{
+	Estimate estimate("{}");
+	BOOST_CHECK(!estimate->mainGas().isInfinite);
+	BOOST_CHECK(!estimate->functionGas("f"_yulstring));
+}
+
+BOOST_AUTO_TEST_CASE(function_calls)
+{
+	Estimate estimate(R"({
+		function f(a) -> x { x := add(a, 1) }
+		function g(a) -> x { x := f(f(a)) }
+		sstore(0, g(calldataload(0)))
+	})");
+	optional<GasConsumption> f = estimate->functionGas("f"_yulstring);
+	optional<GasConsumption> g = estimate->functionGas("g"_yulstring);
+	BOOST_REQUIRE(f && g);
+	BOOST_CHECK(!f->isInfinite && !g->isInfinite);
+	BOOST_CHECK(u256(2) * f->value < g->value);
+	GasConsumption mainGas = estimate->mainGas();
+	BOOST_CHECK(!mainGas.isInfinite);
+	BOOST_CHECK(g->value < mainGas.value);
+}
+
+BOOST_AUTO_TEST_CASE(branches)
+{
+	Estimate estimate(R"({
+		function f(a) -> x {
+			if a { x := keccak256(0, 0x20) }
+		}
+		function g(a) -> x {
+			if a { x := keccak256(0, 0x20) leave }
+			x := 1
+		}
+	})");
+	optional<GasConsumption> f = estimate->functionGas("f"_yulstring);
+	optional<GasConsumption> g = estimate->functionGas("g"_yulstring);
+	BOOST_REQUIRE(f && g);
+	BOOST_CHECK(!f->isInfinite && !g->isInfinite);
+	BOOST_CHECK(GasConsumption(evmasm::GasCosts::keccak256Gas) < *f);
+	BOOST_CHECK(GasConsumption(evmasm::GasCosts::keccak256Gas) < *g);
+}
+
+BOOST_AUTO_TEST_CASE(loops_and_recursion)
+{
+	Estimate estimate(R"({
+		function loop(n) { for { let i := 0 } lt(i, n) { i := add(i, 1) } { sstore(i, i) } }
+		function even(n) -> r { switch n case 0 { r := 1 } default { r := odd(sub(n, 1)) } }
+		function odd(n) -> r { switch n case 0 { r := 0 } default { r := even(sub(n, 1)) } }
+		function callsEven(n) -> r { r := even(n) }
+		function finite(n) -> r { r := add(n, 1) }
+	})");
+	BOOST_CHECK(estimate->functionGas("loop"_yulstring)->isInfinite);
+	BOOST_CHECK(estimate->functionGas("even"_yulstring)->isInfinite);
+	BOOST_CHECK(estimate->functionGas("odd"_yulstring)->isInfinite);
+	BOOST_CHECK(estimate->functionGas("callsEven"_yulstring)->isInfinite);
+	BOOST_CHECK(!estimate->functionGas("finite"_yulstring)->isInfinite);
+	BOOST_CHECK(!estimate->mainGas().isInfinite);
+}
+
+BOOST_AUTO_TEST_CASE(external_calls)
+{
+	Estimate estimate(R"({
+		function f() -> r { r := call(gas(), 0, 0, 0, 0, 0, 0) }
+	})");
+	BOOST_CHECK(estimate->functionGas("f"_yulstring)->isInfinite);
+}
+
+BOOST_AUTO_TEST_CASE(switch_value)
+{
+	Estimate estimate(R"({
+		function expensive() { sstore(1, keccak256(0, 0x20)) }
+		switch calldataload(0)
+		case 1 { sstore(0, 1) }
+		case 2 { expensive() }
+		default { revert(0, 0) }
+	})");
+	GasConsumption anyCase = estimate->mainGas();
+	GasConsumption firstCase = estimate->mainGas(u256(1));
+	GasConsumption secondCase = estimate->mainGas(u256(2));
+	BOOST_CHECK(!anyCase.isInfinite);
+	BOOST_CHECK(firstCase < secondCase);
+	BOOST_CHECK_EQUAL(secondCase.value, anyCase.value);
+	// Values without a case do not restrict the switch.
+	BOOST_CHECK_EQUAL(estimate->mainGas(u256(3)).value, anyCase.value);
+}
+
+BOOST_AUTO_TEST_CASE(parallel)
+{
+	string source = "{\n";
+	for (size_t i = 0; i < 20; ++i)
+	{
+		source += "function f" + to_string(i) + "(a) -> r { r := add(a, " + to_string(i) + ") ";
+		if (i > 0)
+			source += "r := f" + to_string(i - 1) + "(r) ";
+		source += "}\n";
+	}
+	source += "}\n";
+	Estimate sequential(source);
+	Estimate parallel(source, 4);
+	for (size_t i = 0; i < 20; ++i)
+	{
+		YulString name("f" + to_string(i));
+		BOOST_CHECK(!sequential->functionGas(name)->isInfinite);
+		BOOST_CHECK_EQUAL(sequential->functionGas(name)->value, parallel->functionGas(name)->value);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
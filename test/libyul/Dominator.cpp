@@ -0,0 +1,156 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the dominator and loop nesting analysis.
+ */
+
+#include <test/libyul/Common.h>
+
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/Dominator.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/Object.h>
+
+#include <liblangutil/ErrorReporter.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+struct TestVertex
+{
+	vector<TestVertex const*> successors;
+};
+
+struct ForEachTestSuccessor
+{
+	template<typename Callback>
+	void operator()(TestVertex const& _vertex, Callback&& _callback) const
+	{
+		for (TestVertex const* successor: _vertex.successors)
+			_callback(*successor);
+	}
+};
+
+using TestDominatorFinder = DominatorFinder<TestVertex, ForEachTestSuccessor>;
+using TestLoopNestingFinder = LoopNestingFinder<TestVertex, ForEachTestSuccessor>;
+
+vector<TestVertex> makeGraph(size_t _vertices, vector<pair<size_t, size_t>> const& _edges)
+{
+	vector<TestVertex> graph(_vertices);
+	for (auto const& [from, to]: _edges)
+		graph[from].successors.push_back(&graph[to]);
+	return graph;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulDominator)
+
+BOOST_AUTO_TEST_CASE(loop_with_diamond)
+{
+	// 0 -> 1 -> {2, 3} -> 4 -> {1, 5}; 6 is unreachable.
+	vector<TestVertex> graph = makeGraph(7, {{0, 1}, {1, 2}, {1, 3}, {2, 4}, {3, 4}, {4, 1}, {4, 5}, {6, 4}});
+	TestDominatorFinder dominators(graph[0]);
+
+	BOOST_CHECK_EQUAL(dominators.reversePostOrder().size(), 6);
+	BOOST_CHECK(dominators.reversePostOrder().front() == &graph[0]);
+	BOOST_CHECK(!dominators.reachable(graph[6]));
+
+	BOOST_CHECK(dominators.immediateDominator(graph[0]) == nullptr);
+	BOOST_CHECK(dominators.immediateDominator(graph[1]) == &graph[0]);
+	BOOST_CHECK(dominators.immediateDominator(graph[2]) == &graph[1]);
+	BOOST_CHECK(dominators.immediateDominator(graph[3]) == &graph[1]);
+	BOOST_CHECK(dominators.immediateDominator(graph[4]) == &graph[1]);
+	BOOST_CHECK(dominators.immediateDominator(graph[5]) == &graph[4]);
+
+	BOOST_CHECK(dominators.dominates(graph[1], graph[5]));
+	BOOST_CHECK(dominators.dominates(graph[4], graph[4]));
+	BOOST_CHECK(!dominators.dominates(graph[2], graph[4]));
+	BOOST_CHECK(!dominators.dominates(graph[5], graph[1]));
+	BOOST_CHECK_EQUAL(dominators.dominatorTreeChildren(graph[1]).size(), 3);
+	// The unreachable predecessor is not reported.
+	BOOST_CHECK_EQUAL(dominators.predecessors(graph[4]).size(), 2);
+
+	TestLoopNestingFinder loops(dominators);
+	BOOST_REQUIRE_EQUAL(loops.loopHeaders().size(), 1);
+	BOOST_CHECK(loops.loopHeaders().front() == &graph[1]);
+	for (size_t vertex: {1, 2, 3, 4})
+		BOOST_CHECK_EQUAL(loops.loopDepth(graph[vertex]), 1);
+	BOOST_CHECK_EQUAL(loops.loopDepth(graph[0]), 0);
+	BOOST_CHECK_EQUAL(loops.loopDepth(graph[5]), 0);
+}
+
+BOOST_AUTO_TEST_CASE(nested_and_self_loops)
+{
+	// Outer loop 1 -> 2 -> 3 -> 1, inner loop 2 -> 3 -> 2, self loop 4 -> 4.
+	vector<TestVertex> graph = makeGraph(5, {{0, 1}, {1, 2}, {2, 3}, {3, 2}, {3, 1}, {1, 4}, {4, 4}});
+	TestDominatorFinder dominators(graph[0]);
+	TestLoopNestingFinder loops(dominators);
+
+	BOOST_REQUIRE_EQUAL(loops.loopHeaders().size(), 3);
+	BOOST_CHECK_EQUAL(loops.loopDepth(graph[1]), 1);
+	BOOST_CHECK_EQUAL(loops.loopDepth(graph[2]), 2);
+	BOOST_CHECK_EQUAL(loops.loopDepth(graph[3]), 2);
+	BOOST_CHECK_EQUAL(loops.loopDepth(graph[4]), 1);
+	BOOST_CHECK(loops.inLoop(graph[1], graph[3]));
+	BOOST_CHECK(!loops.inLoop(graph[2], graph[1]));
+	BOOST_CHECK(!loops.inLoop(graph[1], graph[4]));
+}
+
+BOOST_AUTO_TEST_CASE(control_flow_graph)
+{
+	EVMDialect dialect{EVMVersion{}, true};
+	ErrorList errorList;
+	auto [object, analysisInfo] = yul::test::parse(R"({
+		let x := calldataload(0)
+		for { let i := 0 } lt(i, x) { i := add(i, 1) } {
+			for { let j := 0 } lt(j, x) { j := add(j, 1) } { sstore(i, j) }
+		}
+		sstore(0, x)
+	})", dialect, errorList);
+	BOOST_REQUIRE(object && errorList.empty() && object->code);
+	unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(*analysisInfo, dialect, *object->code);
+
+	CFGDominatorFinder dominators(*cfg->entry);
+	for (CFG::BasicBlock const* block: dominators.reversePostOrder())
+		BOOST_CHECK(dominators.dominates(*cfg->entry, *block));
+
+	CFGLoopNestingFinder loops(dominators);
+	BOOST_REQUIRE_EQUAL(loops.loopHeaders().size(), 2);
+	CFG::BasicBlock const& outer = *loops.loopHeaders()[0];
+	CFG::BasicBlock const& inner = *loops.loopHeaders()[1];
+	BOOST_CHECK(loops.inLoop(outer, inner));
+	BOOST_CHECK(!loops.inLoop(inner, outer));
+	BOOST_CHECK(dominators.dominates(outer, inner));
+	BOOST_CHECK_EQUAL(loops.loopDepth(*cfg->entry), 0);
+	BOOST_CHECK_EQUAL(loops.loopDepth(outer), 1);
+	BOOST_CHECK_EQUAL(loops.loopDepth(inner), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
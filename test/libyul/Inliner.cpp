@@ -21,12 +21,16 @@
  */
 
 #include <test/libyul/Common.h>
+#include <test/Common.h>
 
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/InlinableExpressionFunctionFinder.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/FunctionHoister.h>
 #include <libyul/optimiser/FunctionGrouper.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AST.h>
 
 #include <boost/test/unit_test.hpp>
@@ -107,4 +111,37 @@ BOOST_AUTO_TEST_CASE(negative)
 }
 
 
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(YulFullInliner)
+
+BOOST_AUTO_TEST_CASE(growth_budget)
+{
+	// Many small functions calling the same function, which is small enough to be inlined everywhere.
+	string source = "{ function f(a) -> r { r := add(mul(a, a), sub(a, 1)) }";
+	for (size_t i = 0; i < 200; ++i)
+		source += " function g" + to_string(i) + "(x) -> y { y := f(x) }";
+	source += " }";
+
+	auto inline_ = [&](size_t _growthBudgetPercent) {
+		Block ast = disambiguate(source, false);
+		Dialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+		NameDispenser dispenser(dialect, ast);
+		set<YulString> reserved;
+		OptimiserStepContext context{dialect, dispenser, reserved, 0, 1, nullptr};
+		return FullInliner::run(context, ast, _growthBudgetPercent);
+	};
+
+	FullInliner::Statistics unlimited = inline_(10000);
+	BOOST_CHECK_EQUAL(unlimited.inlinedCalls, 200);
+	BOOST_CHECK_EQUAL(unlimited.callsRejectedByBudget, 0);
+	BOOST_CHECK(unlimited.sizeIncrease > FullInliner::minimumGrowthBudget);
+
+	FullInliner::Statistics limited = inline_(0);
+	BOOST_CHECK_EQUAL(limited.growthBudget, FullInliner::minimumGrowthBudget);
+	BOOST_CHECK(limited.sizeIncrease <= limited.growthBudget);
+	BOOST_CHECK(limited.callsRejectedByBudget > 0);
+	BOOST_CHECK_EQUAL(limited.inlinedCalls + limited.callsRejectedByBudget, 200);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
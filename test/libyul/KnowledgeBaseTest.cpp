@@ -52,7 +52,7 @@ protected:
 
 		NameDispenser dispenser(m_dialect, *m_object->code);
 		std::set<YulString> reserved;
-		OptimiserStepContext context{m_dialect, dispenser, reserved, 0};
+		OptimiserStepContext context{m_dialect, dispenser, reserved, 0, 1, nullptr};
 		CommonSubexpressionEliminator::run(context, *m_object->code);
 
 		m_ssaValues(*m_object->code);
@@ -378,6 +378,17 @@ BOOST_FIXTURE_TEST_CASE(switch_statement_large_custom_weights, CustomWeightFixtu
 	);
 }
 
+BOOST_AUTO_TEST_CASE(statements_including_functions)
+{
+	shared_ptr<Block> ast = parse("{ function f(a) -> b { b := add(a, 1) } let x := f(2) { sstore(x, 0) } }", false).first;
+	BOOST_REQUIRE(ast);
+	size_t sum = 0;
+	for (Statement const& statement: ast->statements)
+		sum += CodeSize::codeSizeIncludingFunctions(statement);
+	BOOST_CHECK_EQUAL(sum, CodeSize::codeSizeIncludingFunctions(*ast));
+	BOOST_CHECK_EQUAL(CodeSize::codeSizeIncludingFunctions(ast->statements.front()), 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
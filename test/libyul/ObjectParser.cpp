@@ -26,6 +26,7 @@
 #include <liblangutil/DebugInfoSelection.h>
 #include <liblangutil/Scanner.h>
 
+#include <libyul/AssemblyCache.h>
 #include <libyul/AssemblyStack.h>
 #include <libyul/backends/evm/EVMDialect.h>
 
@@ -42,6 +43,7 @@
 #include <optional>
 #include <string>
 #include <sstream>
+#include <thread>
 
 using namespace ranges;
 using namespace std;
@@ -282,6 +284,158 @@ BOOST_AUTO_TEST_CASE(use_src_leading_text)
 	BOOST_REQUIRE_EQUAL(*mapping->at(1), "misc.sol");
 }
 
+BOOST_AUTO_TEST_CASE(parallel_optimisation_of_sub_objects)
+{
+	string subObject = R"(
+		object "A" {
+			code {
+				datacopy(0, dataoffset("A_deployed"), datasize("A_deployed"))
+				return(0, datasize("A_deployed"))
+			}
+			object "A_deployed" {
+				code {
+					function f(a, b) -> c { c := add(mul(a, 2), b) }
+					sstore(f(calldataload(0), 1), f(sload(0), 2))
+				}
+			}
+		}
+	)";
+	string source = "object \"factory\" { code { sstore(0, datasize(\"A\")) sstore(1, datasize(\"B\")) }";
+	source += subObject;
+	source += boost::replace_all_copy(subObject, "A", "B");
+	source += "}";
+
+	auto optimise = [&](size_t _parallelism) {
+		AssemblyStack asmStack(
+			solidity::test::CommonOptions::get().evmVersion(),
+			AssemblyStack::Language::StrictAssembly,
+			solidity::frontend::OptimiserSettings::full(),
+			DebugInfoSelection::All()
+		);
+		asmStack.setParallelism(_parallelism);
+		BOOST_REQUIRE(asmStack.parseAndAnalyze("source", source));
+		asmStack.optimize();
+		return make_pair(asmStack.print(), asmStack.assemble(AssemblyStack::Machine::EVM).bytecode->bytecode);
+	};
+
+	auto const sequential = optimise(1);
+	auto const parallel = optimise(4);
+	BOOST_CHECK_EQUAL(sequential.first, parallel.first);
+	BOOST_CHECK(sequential.second == parallel.second);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_stack_layouts_of_functions)
+{
+	string source = "{\n";
+	for (size_t i = 0; i < 20; ++i)
+	{
+		string name = "f" + std::to_string(i);
+		source += "function " + name + "(a, b) -> c { for { } lt(a, b) { a := add(a, 1) } { c := add(c, mul(a, " + std::to_string(i) + ")) } }\n";
+		source += "sstore(" + std::to_string(i) + ", " + name + "(calldataload(" + std::to_string(i) + "), 10))\n";
+	}
+	source += "}";
+
+	auto assemble = [&](size_t _parallelism) {
+		AssemblyStack asmStack(
+			solidity::test::CommonOptions::get().evmVersion(),
+			AssemblyStack::Language::StrictAssembly,
+			solidity::frontend::OptimiserSettings::full(),
+			DebugInfoSelection::All()
+		);
+		asmStack.setParallelism(_parallelism);
+		BOOST_REQUIRE(asmStack.parseAndAnalyze("source", source));
+		MachineAssemblyObject object = asmStack.assemble(AssemblyStack::Machine::EVM);
+		return make_pair(object.assembly, object.bytecode->bytecode);
+	};
+
+	auto const sequential = assemble(1);
+	auto const parallel = assemble(4);
+	BOOST_CHECK_EQUAL(sequential.first, parallel.first);
+	BOOST_CHECK(sequential.second == parallel.second);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_compilation_for_all_evm_versions)
+{
+	// The threads create the dialects and the other global caches concurrently on first use,
+	// which is meant to be run with -DSANITIZE=thread.
+	string const source = R"(
+		object "a" {
+			code {
+				function f(a, b) -> c { c := add(mul(a, 2), div(b, 3)) }
+				sstore(f(calldataload(0), 1), f(sload(0), 2))
+				datacopy(0, dataoffset("b"), datasize("b"))
+				return(0, datasize("b"))
+			}
+			object "b" { code { sstore(0, calldataload(0)) } }
+		}
+	)";
+	vector<EVMVersion> const versions = EVMVersion::allVersions();
+	auto compile = [&](size_t _index) {
+		AssemblyStack asmStack(
+			versions[_index % versions.size()],
+			AssemblyStack::Language::StrictAssembly,
+			solidity::frontend::OptimiserSettings::full(),
+			DebugInfoSelection::All()
+		);
+		// Boost.Test assertions must not be used on other threads.
+		if (!asmStack.parseAndAnalyze("source", source))
+			return bytes{};
+		asmStack.optimize();
+		return asmStack.assemble(AssemblyStack::Machine::EVM).bytecode->bytecode;
+	};
+
+	size_t const jobCount = 4 * versions.size();
+	vector<bytes> parallel(jobCount);
+	vector<thread> threads;
+	for (size_t t = 0; t < 4; ++t)
+		threads.emplace_back([&, t]() {
+			for (size_t i = t; i < jobCount; i += 4)
+				parallel[i] = compile(i);
+		});
+	for (thread& t: threads)
+		t.join();
+
+	for (size_t i = 0; i < jobCount; ++i)
+	{
+		BOOST_CHECK(!parallel[i].empty());
+		BOOST_CHECK(parallel[i] == compile(i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(assembly_cache)
+{
+	string const source = R"(
+		object "a" {
+			code { datacopy(0, dataoffset("b"), datasize("b")) return(0, datasize("b")) }
+			object "b" { code { sstore(0, calldataload(0)) } }
+		}
+	)";
+	EVMAssemblyCache cache;
+	auto assemble = [&](string const& _source, EVMAssemblyCache* _cache) {
+		AssemblyStack asmStack(
+			solidity::test::CommonOptions::get().evmVersion(),
+			AssemblyStack::Language::StrictAssembly,
+			solidity::frontend::OptimiserSettings::full(),
+			DebugInfoSelection::All()
+		);
+		asmStack.setAssemblyCache(_cache);
+		BOOST_REQUIRE(asmStack.parseAndAnalyze("source", _source));
+		asmStack.optimize();
+		auto [creation, deployed] = asmStack.assembleWithDeployed();
+		return make_pair(creation.bytecode->bytecode, deployed.bytecode->bytecode);
+	};
+
+	auto const uncached = assemble(source, nullptr);
+	BOOST_CHECK(assemble(source, &cache) == uncached);
+	BOOST_CHECK_EQUAL(cache.size(), 1);
+	BOOST_CHECK(assemble(source, &cache) == uncached);
+	BOOST_CHECK_EQUAL(cache.size(), 1);
+
+	string const otherSource = boost::replace_all_copy(source, "calldataload(0)", "calldataload(1)");
+	BOOST_CHECK(assemble(otherSource, &cache) != uncached);
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
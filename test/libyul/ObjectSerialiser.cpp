@@ -0,0 +1,129 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the binary format of Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
+#include <libyul/ObjectSerialiser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+shared_ptr<Object> parseObject(string const& _source)
+{
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		solidity::frontend::OptimiserSettings::none(),
+		DebugInfoSelection::All()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("source", _source));
+	return stack.parserResult();
+}
+
+string print(Object const& _object)
+{
+	return _object.toString(
+		&EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion()),
+		DebugInfoSelection::All()
+	);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulObjectSerialiser)
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+	string source = R"(
+		/// @use-src 0:"a.sol", 1:"b.sol"
+		object "A" {
+			code {
+				/// @src 0:10:20
+				function f(a, b) -> c {
+					for { let i := 0 } lt(i, b) { i := add(i, 1) } {
+						/// @src 1:5:7 @ast-id 12
+						switch a
+						case 0 { c := "abc" leave }
+						case 0x20 { continue }
+						default { break }
+					}
+				}
+				let x, y
+				x := f(true, dataoffset("B"))
+				if x { sstore(0, datasize("data")) }
+				{}
+			}
+			object "B" {
+				code { invalid() }
+				data "data" hex"00ff"
+			}
+			data "data" "hello"
+		}
+	)";
+	shared_ptr<Object> object = parseObject(source);
+	bytes serialised = ObjectSerialiser::serialise(*object);
+	shared_ptr<Object> deserialised = ObjectSerialiser::deserialise(&serialised);
+
+	BOOST_CHECK_EQUAL(print(*deserialised), print(*object));
+	BOOST_CHECK(deserialised->subIndexByName == object->subIndexByName);
+	BOOST_CHECK(!deserialised->analysisInfo);
+	BOOST_CHECK(ObjectSerialiser::serialise(*deserialised) == serialised);
+}
+
+BOOST_AUTO_TEST_CASE(malformed_data)
+{
+	shared_ptr<Object> object = parseObject("{ let x := calldataload(0) sstore(x, x) }");
+	bytes serialised = ObjectSerialiser::serialise(*object);
+
+	for (size_t length = 0; length < serialised.size(); ++length)
+	{
+		bytes truncated(serialised.begin(), serialised.begin() + static_cast<ptrdiff_t>(length));
+		BOOST_CHECK_THROW(ObjectSerialiser::deserialise(&truncated), ObjectSerialisationError);
+	}
+
+	bytes otherVersion = serialised;
+	otherVersion[4]++;
+	BOOST_CHECK_THROW(ObjectSerialiser::deserialise(&otherVersion), ObjectSerialisationError);
+	bytes trailingData = serialised + bytes{0};
+	BOOST_CHECK_THROW(ObjectSerialiser::deserialise(&trailingData), ObjectSerialisationError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,105 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for optimising Yul objects with several candidate sequences of optimiser steps.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/AssemblyStack.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+string const source = R"(
+	object "A" {
+		code {
+			function f(a, b) -> c { c := add(mul(a, 0), add(b, 0)) }
+			let x := f(calldataload(0), calldataload(0x20))
+			let y := f(x, x)
+			sstore(0, add(y, 0))
+			datacopy(0, dataoffset("A_deployed"), datasize("A_deployed"))
+			return(0, datasize("A_deployed"))
+		}
+		object "A_deployed" {
+			code {
+				function g(x) -> y { y := mul(exp(2, 8), x) }
+				sstore(0, g(g(calldataload(0))))
+			}
+		}
+	}
+)";
+
+string optimize(string _steps, vector<string> _candidateSteps, size_t _parallelism)
+{
+	frontend::OptimiserSettings settings = frontend::OptimiserSettings::full();
+	settings.yulOptimiserSteps = move(_steps);
+	settings.yulOptimiserCandidateSteps = move(_candidateSteps);
+	AssemblyStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		settings,
+		DebugInfoSelection::None()
+	);
+	stack.setParallelism(_parallelism);
+	BOOST_REQUIRE(stack.parseAndAnalyze("source", source));
+	stack.optimize();
+	return stack.print();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimiserPortfolio)
+
+BOOST_AUTO_TEST_CASE(keeps_cheaper_candidate)
+{
+	string const defaultSteps = frontend::OptimiserSettings::DefaultYulOptimiserSteps;
+	string const optimized = optimize(defaultSteps, {}, 1);
+	BOOST_CHECK(optimize("", {}, 1) != optimized);
+	for (size_t parallelism: {1, 4})
+		BOOST_CHECK_EQUAL(optimize("", {"", defaultSteps}, parallelism), optimized);
+}
+
+BOOST_AUTO_TEST_CASE(prefers_steps_of_settings)
+{
+	string const defaultSteps = frontend::OptimiserSettings::DefaultYulOptimiserSteps;
+	for (size_t parallelism: {1, 4})
+	{
+		BOOST_CHECK_EQUAL(optimize(defaultSteps, {defaultSteps}, parallelism), optimize(defaultSteps, {}, 1));
+		BOOST_CHECK_EQUAL(optimize("", {""}, parallelism), optimize("", {}, 1));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -58,9 +58,9 @@ shared_ptr<Block> parse(string const& _source, Dialect const& _dialect, ErrorRep
 	try
 	{
 		auto stream = CharStream(_source, "");
-		map<unsigned, shared_ptr<string const>> indicesToSourceNames;
-		indicesToSourceNames[0] = make_shared<string const>("source0");
-		indicesToSourceNames[1] = make_shared<string const>("source1");
+		map<unsigned, string const*> indicesToSourceNames;
+		indicesToSourceNames[0] = internSourceName("source0");
+		indicesToSourceNames[1] = internSourceName("source1");
 
 		auto parserResult = yul::Parser(
 			errorReporter,
@@ -951,6 +951,26 @@ BOOST_AUTO_TEST_CASE(customSourceLocations_multiple_src_tags_on_one_line)
 	CHECK_LOCATION(varX.debugData->originLocation, "source1", 4, 5);
 }
 
+BOOST_AUTO_TEST_CASE(location_override_shares_debug_data)
+{
+	ErrorList errorList;
+	ErrorReporter reporter(errorList);
+	SourceLocation location{10, 20, internSourceName("source0")};
+	CharStream stream("{ let x := add(1, 2) sstore(x, 3) }", "");
+	EVMDialectTyped const& dialect = EVMDialectTyped::instance(EVMVersion{});
+	shared_ptr<Block> result = yul::Parser(reporter, dialect, location).parse(stream);
+	BOOST_REQUIRE(!!result && errorList.size() == 0);
+	BOOST_REQUIRE_EQUAL(result->statements.size(), 2);
+
+	VariableDeclaration const& varX = get<VariableDeclaration>(result->statements.at(0));
+	ExpressionStatement const& store = get<ExpressionStatement>(result->statements.at(1));
+	CHECK_LOCATION(varX.debugData->originLocation, "source0", 10, 20);
+	BOOST_CHECK(result->debugData == varX.debugData);
+	BOOST_CHECK(varX.debugData == varX.variables.front().debugData);
+	BOOST_CHECK(varX.debugData == get<FunctionCall>(*varX.value).debugData);
+	BOOST_CHECK(varX.debugData == store.debugData);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -48,7 +48,10 @@
 #include <libyul/optimiser/UnusedPruner.h>
 #include <libyul/optimiser/ExpressionJoiner.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/OverwrittenStoreEliminator.h>
+#include <libyul/optimiser/RangeBasedSimplifier.h>
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
+#include <libyul/optimiser/RedundantHashCallEliminator.h>
 #include <libyul/optimiser/SSAReverser.h>
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/Semantics.h>
@@ -256,6 +259,11 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			ExpressionJoiner::run(*m_context, *m_ast);
 			ExpressionJoiner::run(*m_context, *m_ast);
 		}},
+		{"overwrittenStoreEliminator", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			OverwrittenStoreEliminator::run(*m_context, *m_ast);
+		}},
 		{"loopInvariantCodeMotion", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -278,6 +286,16 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			disambiguate();
 			ReasoningBasedSimplifier::run(*m_context, *m_object->code);
 		}},
+		{"rangeBasedSimplifier", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			RangeBasedSimplifier::run(*m_context, *m_ast);
+		}},
+		{"redundantHashCallEliminator", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			RedundantHashCallEliminator::run(*m_context, *m_ast);
+		}},
 		{"equivalentFunctionCombiner", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -445,6 +463,8 @@ void YulOptimizerTestCommon::updateContext()
 		*m_dialect,
 		*m_nameDispenser,
 		m_reservedIdentifiers,
-		frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment
+		frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment,
+		1,
+		nullptr
 	});
 }
@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	YulString empty;
+	BOOST_CHECK(empty.empty());
+	BOOST_CHECK(YulString{""} == empty);
+	BOOST_CHECK(YulString{"interning_a"} == YulString{string("interning_a")});
+	BOOST_CHECK(YulString{"interning_a"} != YulString{"interning_b"});
+	BOOST_CHECK_EQUAL(YulString{"interning_b"}.str(), "interning_b");
+}
+
+BOOST_AUTO_TEST_CASE(many_strings)
+{
+	// Spans several storage blocks of the repository.
+	vector<YulString> strings;
+	for (size_t i = 0; i < 10000; ++i)
+		strings.emplace_back("many_strings_" + to_string(i));
+	for (size_t i = 0; i < strings.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(strings[i].str(), "many_strings_" + to_string(i));
+		BOOST_CHECK(strings[i] == YulString{"many_strings_" + to_string(i)});
+	}
+}
+
+BOOST_AUTO_TEST_CASE(statistics)
+{
+	YulStringRepository::Statistics before = YulStringRepository::instance().statistics();
+	YulString{"statistics_a"};
+	YulString{"statistics_a"};
+	YulString{"statistics_with_a_name_that_is_not_stored_inline"};
+	YulStringRepository::Statistics after = YulStringRepository::instance().statistics();
+	BOOST_CHECK_EQUAL(after.strings, before.strings + 2);
+	BOOST_CHECK_EQUAL(after.characters, before.characters + 12 + 48);
+	BOOST_CHECK_GT(after.bytes, before.bytes);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const threadCount = 4;
+	size_t const stringCount = 5000;
+	vector<vector<YulString>> results(threadCount);
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]() {
+			for (size_t i = 0; i < stringCount; ++i)
+				results[t].emplace_back("concurrent_" + to_string((i + t * 1000) % stringCount));
+		});
+	for (thread& t: threads)
+		t.join();
+
+	for (size_t t = 0; t < threadCount; ++t)
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			YulString const& result = results[t][i];
+			BOOST_CHECK_EQUAL(result.str(), "concurrent_" + to_string((i + t * 1000) % stringCount));
+			BOOST_CHECK(result == results[0][(i + t * 1000) % stringCount]);
+		}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
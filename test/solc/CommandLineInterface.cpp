@@ -263,6 +263,40 @@ BOOST_AUTO_TEST_CASE(cli_ignore_missing_no_files_exist)
 	BOOST_TEST(result.stderrContent == expectedMessage);
 }
 
+BOOST_AUTO_TEST_CASE(cli_memory_map_sources)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	createFilesWithParentDirs({tempDir.path() / "input.sol"}, "contract C {}");
+	createFilesWithParentDirs({tempDir.path() / "empty.sol"});
+
+	boost::filesystem::path expectedDir = "/" / tempDir.path().relative_path();
+	soltestAssert(expectedDir.is_absolute() || expectedDir.root_path() == "/", "");
+
+	OptionsReaderAndMessages result = parseCommandLineAndReadInputFiles({
+		"solc",
+		(tempDir.path() / "input.sol").string(),
+		(tempDir.path() / "empty.sol").string(),
+		"--memory-map-sources",
+	});
+	BOOST_TEST(result.success);
+	BOOST_TEST(result.stderrContent == "");
+	BOOST_TEST(result.options.input.memoryMapSources);
+
+	string const inputName = (expectedDir / "input.sol").generic_string();
+	string const emptyName = (expectedDir / "empty.sol").generic_string();
+	// Empty files cannot be mapped and are read normally.
+	BOOST_TEST(result.reader.sourceCodes().at(emptyName) == "");
+	// Memory mapping is not supported on all platforms, the file is read normally then.
+	if (result.reader.mappedSourceCodes().count(inputName))
+	{
+		BOOST_TEST(result.reader.mappedSourceCodes().at(inputName)->contents() == "contract C {}");
+		BOOST_TEST(result.reader.sourceCodes().count(inputName) == 0);
+	}
+	else
+		BOOST_TEST(result.reader.sourceCodes().at(inputName) == "contract C {}");
+	BOOST_TEST((result.reader.sourceUnitNames() == set<string>{inputName, emptyName}));
+}
+
 BOOST_AUTO_TEST_CASE(cli_not_a_file)
 {
 	TemporaryDirectory tempDir(TEST_CASE_NAME);
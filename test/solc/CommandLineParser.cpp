@@ -130,6 +130,10 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--overwrite",
 			"--evm-version=spuriousDragon",
 			"--experimental-via-ir",
+			"--jobs=4",
+			"--cache-dir=/tmp/cache",
+			"--profile-json=/tmp/profile.json",
+			"--trace-file=/tmp/trace.json",
 			"--revert-strings=strip",
 			"--debug-info=location",
 			"--pretty-json",
@@ -150,20 +154,34 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize",
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
+			"--yul-optimizations-candidate=dhfoD",
+			"--yul-optimizations-candidate=xarrscLM",
+			"--yul-optimizations-candidate-time-budget=500",
+			"--yul-optimizations-stats",
+			"--model-checker-bmc-loop-iterations=3",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
 			"--model-checker-div-mod-no-slacks",
 			"--model-checker-engine=bmc",
+			"--model-checker-external-solver=z3 -in",
 			"--model-checker-invariants=contract,reentrancy",
+			"--model-checker-query-cache=dir3/smt-cache",
+			"--model-checker-reuse-invariants",
 			"--model-checker-show-unproved",
 			"--model-checker-solvers=z3,smtlib2",
 			"--model-checker-targets=underflow,divByZero",
 			"--model-checker-timeout=5",
+			"--model-checker-total-timeout=1000",
 		};
 
 		if (inputMode == InputMode::CompilerWithASTImport)
 			commandLine += vector<string>{
 				"--import-ast",
 			};
+		else
+			commandLine += vector<string>{
+				"--memory-map-sources",
+				"--compile-separately",
+			};
 
 		CommandLineOptions expectedOptions;
 		expectedOptions.input.mode = inputMode;
@@ -180,11 +198,17 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 
 		expectedOptions.input.allowedDirectories = {"/tmp", "/home", "project", "../contracts", "c", "/usr/lib"};
 		expectedOptions.input.ignoreMissingFiles = true;
+		expectedOptions.input.memoryMapSources = (inputMode == InputMode::Compiler);
+		expectedOptions.output.compileSeparately = (inputMode == InputMode::Compiler);
 		expectedOptions.input.errorRecovery = (inputMode == InputMode::Compiler);
 		expectedOptions.output.dir = "/tmp/out";
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
 		expectedOptions.output.experimentalViaIR = true;
+		expectedOptions.output.parallelism = 4;
+		expectedOptions.output.cacheDir = "/tmp/cache";
+		expectedOptions.output.profileJson = "/tmp/profile.json";
+		expectedOptions.output.traceFile = "/tmp/trace.json";
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
@@ -213,6 +237,9 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.optimizer.enabled = true;
 		expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
 		expectedOptions.optimizer.yulSteps = "agf";
+		expectedOptions.optimizer.yulCandidateSteps = {"dhfoD", "xarrscLM"};
+		expectedOptions.optimizer.yulCandidateTimeBudget = 500;
+		expectedOptions.optimizer.yulStepStatistics = true;
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
@@ -224,6 +251,11 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			{false, true, true},
 			{{VerificationTargetType::Underflow, VerificationTargetType::DivByZero}},
 			5,
+			"dir3/smt-cache",
+			"z3 -in",
+			1000,
+			true,
+			3,
 		};
 
 		stringstream serr;
@@ -287,23 +319,29 @@ BOOST_AUTO_TEST_CASE(assembly_mode_options)
 				"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
 			"--metadata-hash=swarm",       // Ignored in assembly mode
 			"--metadata-literal",          // Ignored in assembly mode
+			"--model-checker-bmc-loop-iterations=3", // Ignored in assembly mode
 			"--model-checker-contracts="   // Ignored in assembly mode
 				"contract1.yul:A,"
 				"contract2.yul:B",
 			"--model-checker-div-mod-no-slacks", // Ignored in assembly mode
 			"--model-checker-engine=bmc",  // Ignored in assembly mode
+			"--model-checker-external-solver=z3 -in", // Ignored in assembly mode
 			"--model-checker-invariants=contract,reentrancy",  // Ignored in assembly mode
+			"--model-checker-query-cache=dir3/smt-cache", // Ignored in assembly mode
+			"--model-checker-reuse-invariants", // Ignored in assembly mode
 			"--model-checker-show-unproved", // Ignored in assembly mode
 			"--model-checker-solvers=z3,smtlib2", // Ignored in assembly mode
 			"--model-checker-targets="     // Ignored in assembly mode
 				"underflow,"
 				"divByZero",
 			"--model-checker-timeout=5",   // Ignored in assembly mode
+			"--model-checker-total-timeout=1000", // Ignored in assembly mode
 			"--asm",
 			"--bin",
 			"--ir-optimized",
 			"--ewasm",
 			"--ewasm-ir",
+			"--jobs=3",
 		};
 		commandLine += assemblyOptions;
 		if (expectedLanguage == AssemblyStack::Language::StrictAssembly || expectedLanguage == AssemblyStack::Language::Ewasm)
@@ -331,6 +369,7 @@ BOOST_AUTO_TEST_CASE(assembly_mode_options)
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
+		expectedOptions.output.parallelism = 3;
 		expectedOptions.formatting.json = JsonFormat {JsonFormat::Pretty, 1};
 		expectedOptions.assembly.targetMachine = expectedMachine;
 		expectedOptions.assembly.inputLanguage = expectedLanguage;
@@ -387,18 +426,23 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 		"--combined-json=abi,bin",         // Accepted but has no effect in Standard JSON mode
 		"--metadata-hash=swarm",           // Ignored in Standard JSON mode
 		"--metadata-literal",              // Ignored in Standard JSON mode
+		"--model-checker-bmc-loop-iterations=3", // Ignored in Standard JSON mode
 		"--model-checker-contracts="       // Ignored in Standard JSON mode
 			"contract1.yul:A,"
 			"contract2.yul:B",
 		"--model-checker-div-mod-no-slacks", // Ignored in Standard JSON mode
 		"--model-checker-engine=bmc",      // Ignored in Standard JSON mode
+		"--model-checker-external-solver=z3 -in", // Ignored in Standard JSON mode
 		"--model-checker-invariants=contract,reentrancy",      // Ignored in Standard JSON mode
+		"--model-checker-query-cache=dir3/smt-cache", // Ignored in Standard JSON mode
+		"--model-checker-reuse-invariants", // Ignored in Standard JSON mode
 		"--model-checker-show-unproved",      // Ignored in Standard JSON mode
 		"--model-checker-solvers=z3,smtlib2", // Ignored in Standard JSON mode
 		"--model-checker-targets="         // Ignored in Standard JSON mode
 			"underflow,"
 			"divByZero",
 		"--model-checker-timeout=5",       // Ignored in Standard JSON mode
+		"--model-checker-total-timeout=1000", // Ignored in Standard JSON mode
 	};
 
 	CommandLineOptions expectedOptions;
@@ -428,12 +472,63 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 	BOOST_TEST(parsedOptions.value() == expectedOptions);
 }
 
+BOOST_AUTO_TEST_CASE(server_mode_options)
+{
+	vector<string> commandLine = {
+		"solc",
+		"--server",
+		"--base-path=/home/user/",
+		"--include-path=/usr/lib/include/",
+		"--allow-paths=/tmp,/home",
+	};
+
+	CommandLineOptions expectedOptions;
+
+	expectedOptions.input.mode = InputMode::Server;
+	expectedOptions.input.basePath = "/home/user/";
+	expectedOptions.input.includePaths = {"/usr/lib/include/"};
+	expectedOptions.input.allowedDirectories = {"/tmp", "/home"};
+
+	stringstream serr;
+	optional<CommandLineOptions> parsedOptions = parseCommandLine(commandLine, serr);
+
+	BOOST_TEST(serr.str() == "");
+	BOOST_REQUIRE(parsedOptions.has_value());
+	BOOST_TEST(parsedOptions.value() == expectedOptions);
+}
+
+BOOST_AUTO_TEST_CASE(server_mode_rejects_input_files)
+{
+	for (string const& input: vector<string>{"input.json", "-"})
+	{
+		stringstream serr;
+		optional<CommandLineOptions> parsedOptions = parseCommandLine({"solc", "--server", input}, serr);
+
+		BOOST_TEST(serr.str() == "No input files can be given for --server.\nThe requests are read from standard input.\n");
+		BOOST_REQUIRE(!parsedOptions.has_value());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(language_server_mode_rejects_input_files)
+{
+	stringstream serr;
+	optional<CommandLineOptions> parsedOptions = parseCommandLine({"solc", "--lsp", "input.sol"}, serr);
+
+	BOOST_TEST(serr.str() == "No input files can be given for --lsp.\nThe requests are read from standard input.\n");
+	BOOST_REQUIRE(!parsedOptions.has_value());
+
+	parsedOptions = parseCommandLine({"solc", "--lsp"}, serr);
+	BOOST_REQUIRE(parsedOptions.has_value());
+	BOOST_TEST(parsedOptions->input.mode == InputMode::LanguageServer);
+}
+
 BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 {
 	map<string, vector<string>> invalidOptionInputModeCombinations = {
 		// TODO: This should eventually contain all options.
 		{"--error-recovery", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
-		{"--experimental-via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}}
+		{"--experimental-via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--memory-map-sources", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link", "--import-ast"}}
 	};
 
 	for (auto const& [optionName, inputModes]: invalidOptionInputModeCombinations)
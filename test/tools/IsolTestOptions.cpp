@@ -70,7 +70,19 @@ void IsolTestOptions::addOptions()
 		("help", po::bool_switch(&showHelp)->default_value(showHelp), "Show this help screen.")
 		("no-color", po::bool_switch(&noColor)->default_value(noColor), "Don't use colors.")
 		("accept-updates", po::bool_switch(&acceptUpdates)->default_value(acceptUpdates), "Automatically accept expectation updates.")
-		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
+		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.")
+		(
+			"jobs,j",
+			po::value<size_t>(&jobs)->default_value(jobs),
+			"Number of test cases to run at once. Test cases that fail are run again one by one "
+			"afterwards, so that they can be edited or updated."
+		)
+		(
+			"durations",
+			po::value<std::string>(&durationsFile)->default_value(durationsFile),
+			"File in which the run times of the test cases are recorded if more than one job is used, "
+			"so that the test cases that took longest are started first in the next run."
+		);
 }
 
 bool IsolTestOptions::parse(int _argc, char const* const* _argv)
@@ -98,6 +110,7 @@ void IsolTestOptions::validate() const
 		ConfigException,
 		"Invalid test unit filter - can only contain '" + filterString + ": " + testFilter
 	);
+	assertThrow(jobs > 0, ConfigException, "The number of jobs has to be positive.");
 }
 
 }
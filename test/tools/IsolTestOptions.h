@@ -34,6 +34,10 @@ struct IsolTestOptions: CommonOptions
 	bool acceptUpdates = false;
 	std::string testFilter = std::string{};
 	std::string editor = std::string{};
+	/// Maximum number of test cases that are run at once.
+	size_t jobs = 1;
+	/// File to read the run times of the test cases from and to record them in, if not empty.
+	std::string durationsFile = std::string{};
 
 	explicit IsolTestOptions();
 	void addOptions() override;
@@ -0,0 +1,175 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark comparing the import of JSON ASTs to parsing the original sources.
+ */
+
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/ast/ASTJsonImporter.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// @returns the average time in milliseconds of running @a _job @a _repetitions times.
+double milliseconds(size_t _repetitions, function<void()> const& _job)
+{
+	auto const start = chrono::steady_clock::now();
+	for (size_t i = 0; i < _repetitions; ++i)
+		_job();
+	chrono::duration<double, milli> const duration = chrono::steady_clock::now() - start;
+	return duration.count() / static_cast<double>(max<size_t>(_repetitions, 1));
+}
+
+bool parseSources(CompilerStack& _compiler, map<string, string> const& _sources)
+{
+	_compiler.setSources(_sources);
+	if (_compiler.parse())
+		return true;
+	SourceReferenceFormatter formatter(cerr, _compiler, false, false);
+	formatter.printErrorInformation(_compiler.errors());
+	return false;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(astimportbench, benchmark for the import of JSON ASTs.
+Usage: astimportbench [Options] file...
+Parses all given Solidity files, exports their ASTs as compact JSON and reports
+how long it takes to import them again, compared to parsing the sources.
+Imports have to be resolvable among the given files.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repeat", po::value<size_t>()->default_value(10), "Number of times to process the input.")
+		("input-file", po::value<vector<string>>(), "input file");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	map<string, string> sources;
+	for (string const& path: arguments["input-file"].as<vector<string>>())
+	{
+		try
+		{
+			sources[path] = readFileAsString(path);
+		}
+		catch (FileNotFound const&)
+		{
+			cerr << "File not found: " << path << endl;
+			return 1;
+		}
+		catch (NotAFile const&)
+		{
+			cerr << "Not a regular file: " << path << endl;
+			return 1;
+		}
+	}
+	size_t const repetitions = arguments["repeat"].as<size_t>();
+
+	map<string, string> astJsons;
+	{
+		CompilerStack compiler;
+		if (!parseSources(compiler, sources))
+			return 1;
+		for (string const& sourceName: compiler.sourceNames())
+			astJsons[sourceName] = jsonCompactPrint(
+				ASTJsonConverter(compiler.state(), compiler.sourceIndices()).toJson(compiler.ast(sourceName))
+			);
+	}
+
+	size_t sourceBytes = 0;
+	size_t jsonBytes = 0;
+	for (auto const& [name, source]: sources)
+		sourceBytes += source.size();
+	for (auto const& [name, json]: astJsons)
+		jsonBytes += json.size();
+
+	double const parsing = milliseconds(repetitions, [&]() {
+		CompilerStack compiler;
+		parseSources(compiler, sources);
+	});
+
+	map<string, Json::Value> astValues;
+	double const jsonParsing = milliseconds(repetitions, [&]() {
+		astValues.clear();
+		for (auto const& [name, json]: astJsons)
+			jsonParseStrict(json, astValues[name]);
+	});
+
+	double const importing = milliseconds(repetitions, [&]() {
+		ASTJsonImporter(EVMVersion{}).jsonToSourceUnit(astValues);
+	});
+
+	cout << fixed << setprecision(3);
+	cout << "Sources: " << sources.size() << ", " << sourceBytes << " bytes of Solidity, " << jsonBytes << " bytes of JSON" << endl;
+	cout << "Parsing the sources:    " << setw(10) << parsing << " ms" << endl;
+	cout << "Parsing the JSON:       " << setw(10) << jsonParsing << " ms" << endl;
+	cout << "Importing the JSON:     " << setw(10) << importing << " ms" << endl;
+	cout << "Import in total:        " << setw(10) << jsonParsing + importing << " ms" << endl;
+
+	return 0;
+}
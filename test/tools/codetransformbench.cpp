@@ -0,0 +1,205 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark measuring the time spent in the optimized EVM code transform when compiling via IR.
+ */
+
+#include <test/TestCaseReader.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/EthAssemblyAdapter.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMObjectCompiler.h>
+
+#include <libevmasm/Assembly.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/EVMVersion.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+using namespace solidity::frontend::test;
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// Adds @a _path to @a _files if it is a Solidity file or all Solidity files below it if it is a directory.
+void collectFiles(fs::path const& _path, vector<fs::path>& _files)
+{
+	if (!fs::is_directory(_path))
+	{
+		_files.push_back(_path);
+		return;
+	}
+	for (auto const& entry: fs::recursive_directory_iterator(_path))
+		if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+			_files.push_back(entry.path());
+}
+
+/// @returns the optimized IR of all contracts in the test case at @a _path or
+/// nothing if the test case cannot be compiled via IR.
+vector<string> optimizedIR(fs::path const& _path, EVMVersion _evmVersion)
+{
+	TestCaseReader reader(_path.string());
+	if (!reader.sources().externalSources.empty())
+		return {};
+	if (reader.settings().count("compileViaYul") && reader.settings().at("compileViaYul") == "false")
+		return {};
+
+	CompilerStack compiler;
+	compiler.setSources(reader.sources().sources);
+	compiler.setEVMVersion(_evmVersion);
+	compiler.setViaIR(true);
+	compiler.setOptimiserSettings(OptimiserSettings::standard());
+	try
+	{
+		if (!compiler.compile())
+			return {};
+	}
+	catch (util::Exception const&)
+	{
+		// Mostly stack too deep errors, which are not interesting for this benchmark.
+		return {};
+	}
+
+	vector<string> result;
+	for (string const& contractName: compiler.contractNames())
+		if (!compiler.yulIROptimized(contractName).empty())
+			result.push_back(compiler.yulIROptimized(contractName));
+	return result;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(codetransformbench, benchmark for the optimized EVM code transform.
+Usage: codetransformbench [Options] path...
+Compiles all given semantic test files via IR, as well as all Solidity files in the
+given directories, and reports how long it takes to generate EVM assembly from the
+optimized IR of their contracts. Test files that cannot be compiled via IR are skipped.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repeat", po::value<size_t>()->default_value(10), "Number of times to process the input.")
+		("jobs", po::value<size_t>()->default_value(1), "Number of threads used to compute the stack layouts.")
+		("input-path", po::value<vector<string>>(), "input file or directory");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-path", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-path"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<fs::path> files;
+	for (string const& path: arguments["input-path"].as<vector<string>>())
+	{
+		if (!fs::exists(path))
+		{
+			cerr << "File not found: " << path << endl;
+			return 1;
+		}
+		collectFiles(path, files);
+	}
+	size_t const repetitions = max<size_t>(arguments["repeat"].as<size_t>(), 1);
+	size_t const parallelism = max<size_t>(arguments["jobs"].as<size_t>(), 1);
+	EVMVersion const evmVersion{};
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(evmVersion);
+
+	size_t skipped = 0;
+	vector<unique_ptr<AssemblyStack>> stacks;
+	for (fs::path const& file: files)
+	{
+		vector<string> irs = optimizedIR(file, evmVersion);
+		if (irs.empty())
+			++skipped;
+		for (string const& ir: irs)
+		{
+			// Prepare the code in the same way as the compiler does before generating EVM code from it.
+			auto stack = make_unique<AssemblyStack>(
+				evmVersion,
+				AssemblyStack::Language::StrictAssembly,
+				OptimiserSettings::standard(),
+				DebugInfoSelection::Default()
+			);
+			if (!stack->parseAndAnalyze("", ir))
+			{
+				cerr << "Could not analyze the IR of " << file.string() << endl;
+				return 1;
+			}
+			stack->optimize();
+			stacks.push_back(move(stack));
+		}
+	}
+
+	chrono::duration<double, milli> total{0};
+	for (size_t i = 0; i < repetitions; ++i)
+		for (auto const& stack: stacks)
+		{
+			evmasm::Assembly assembly;
+			EthAssemblyAdapter adapter(assembly);
+			auto const start = chrono::steady_clock::now();
+			EVMObjectCompiler::compile(*stack->parserResult(), adapter, dialect, true, parallelism);
+			total += chrono::steady_clock::now() - start;
+		}
+
+	cout << fixed << setprecision(3);
+	cout << "Test files: " << files.size() << ", skipped: " << skipped << ", objects: " << stacks.size() << endl;
+	cout << "Code transform:         " << setw(10) << total.count() / static_cast<double>(repetitions) << " ms" << endl;
+
+	return 0;
+}
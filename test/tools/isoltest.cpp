@@ -18,6 +18,7 @@
 
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/AnsiColorized.h>
+#include <libsolutil/Parallel.h>
 
 #include <memory>
 #include <test/Common.h>
@@ -28,11 +29,19 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <numeric>
 #include <queue>
 #include <regex>
+#include <sstream>
 #include <utility>
+#include <vector>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -113,8 +122,10 @@ public:
 		Skipped
 	};
 
-	Result process();
+	/// Runs the test case if it matches the filter and prints its result to @a _output.
+	Result process(ostream& _output = cout);
 
+	/// Runs the test cases in @a _path, using up to _options.jobs threads.
 	static TestStats processPath(
 		TestCreator _testCaseCreator,
 		TestOptions const& _options,
@@ -122,6 +133,22 @@ public:
 		fs::path const& _path
 	);
 private:
+	/// Runs the test cases in @a _paths one after another and asks what to do about failing ones.
+	static TestStats processPaths(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		std::queue<fs::path> _paths
+	);
+	/// Runs the test cases in @a _path on up to _options.jobs threads, printing their results in
+	/// the order of their paths. The test cases that fail are run again by processPaths() afterwards.
+	static TestStats processPathInParallel(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		fs::path const& _path
+	);
+
 	enum class Request
 	{
 		Skip,
@@ -145,7 +172,7 @@ private:
 
 bool TestTool::m_exitRequested = false;
 
-TestTool::Result TestTool::process()
+TestTool::Result TestTool::process(ostream& _output)
 {
 	bool formatted{!m_options.noColor};
 
@@ -153,7 +180,7 @@ TestTool::Result TestTool::process()
 	{
 		if (m_filter.matches(m_path, m_name))
 		{
-			(AnsiColorized(cout, formatted, {BOLD}) << m_name << ": ").flush();
+			(AnsiColorized(_output, formatted, {BOLD}) << m_name << ": ").flush();
 
 			m_test = m_testCaseCreator(TestCase::Config{
 				m_path.string(),
@@ -170,22 +197,22 @@ TestTool::Result TestTool::process()
 				switch (TestCase::TestResult result = m_test->run(outputMessages, "  ", formatted))
 				{
 					case TestCase::TestResult::Success:
-						AnsiColorized(cout, formatted, {BOLD, GREEN}) << "OK" << endl;
+						AnsiColorized(_output, formatted, {BOLD, GREEN}) << "OK" << endl;
 						return Result::Success;
 					default:
-						AnsiColorized(cout, formatted, {BOLD, RED}) << "FAIL" << endl;
+						AnsiColorized(_output, formatted, {BOLD, RED}) << "FAIL" << endl;
 
-						AnsiColorized(cout, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
-						m_test->printSource(cout, "    ", formatted);
-						m_test->printSettings(cout, "    ", formatted);
+						AnsiColorized(_output, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
+						m_test->printSource(_output, "    ", formatted);
+						m_test->printSettings(_output, "    ", formatted);
 
-						cout << endl << outputMessages.str() << endl;
+						_output << endl << outputMessages.str() << endl;
 						return result == TestCase::TestResult::FatalError ? Result::Exception : Result::Failure;
 				}
 			}
 			else
 			{
-				AnsiColorized(cout, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
+				AnsiColorized(_output, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
 				return Result::Skipped;
 			}
 		}
@@ -194,19 +221,19 @@ TestTool::Result TestTool::process()
 	}
 	catch (boost::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_output, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (std::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_output, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (...)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_output, formatted, {BOLD, RED}) <<
 			"Unknown exception during test: " << boost::current_exception_diagnostic_information() << endl;
 		return Result::Exception;
 	}
@@ -265,6 +292,55 @@ TestTool::Request TestTool::handleResponse(bool _exception)
 	}
 }
 
+namespace
+{
+
+/// @returns the paths of the test cases in @a _path relative to @a _basepath, sorted by their names.
+vector<fs::path> collectTestPaths(fs::path const& _basepath, fs::path const& _path)
+{
+	if (!fs::is_directory(_basepath / _path))
+		return {_path};
+
+	vector<fs::path> entries{fs::directory_iterator(_basepath / _path), fs::directory_iterator()};
+	sort(entries.begin(), entries.end());
+	vector<fs::path> testPaths;
+	for (fs::path const& entry: entries)
+		if (fs::is_directory(entry))
+		{
+			vector<fs::path> nestedPaths = collectTestPaths(_basepath, _path / entry.filename());
+			testPaths.insert(testPaths.end(), nestedPaths.begin(), nestedPaths.end());
+		}
+		else if (TestCase::isTestFilename(entry.filename()))
+			testPaths.push_back(_path / entry.filename());
+	return testPaths;
+}
+
+/// Reads the run times recorded in @a _file, one test case per line, preceded by its run time in microseconds.
+map<string, chrono::microseconds> readDurations(string const& _file)
+{
+	map<string, chrono::microseconds> durations;
+	if (_file.empty())
+		return durations;
+
+	ifstream input(_file);
+	int64_t microseconds = 0;
+	string test;
+	while (input >> microseconds && getline(input >> ws, test))
+		durations[test] = chrono::microseconds(microseconds);
+	return durations;
+}
+
+void writeDurations(string const& _file, map<string, chrono::microseconds> const& _durations)
+{
+	ofstream output(_file, ios::trunc);
+	for (auto const& [test, duration]: _durations)
+		output << duration.count() << " " << test << endl;
+	if (!output)
+		cerr << "Could not write the run times of the test cases to " << _file << "." << endl;
+}
+
+}
+
 TestStats TestTool::processPath(
 	TestCreator _testCaseCreator,
 	TestOptions const& _options,
@@ -272,31 +348,143 @@ TestStats TestTool::processPath(
 	fs::path const& _path
 )
 {
+	if (_options.jobs > 1 && !m_exitRequested)
+		return processPathInParallel(_testCaseCreator, _options, _basepath, _path);
+
 	std::queue<fs::path> paths;
 	paths.push(_path);
+	return processPaths(_testCaseCreator, _options, _basepath, std::move(paths));
+}
+
+TestStats TestTool::processPathInParallel(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	fs::path const& _path
+)
+{
+	vector<fs::path> const testPaths = collectTestPaths(_basepath, _path);
+	map<string, chrono::microseconds> durations = readDurations(_options.durationsFile);
+	auto durationKey = [&](size_t _index) { return (_basepath.filename() / testPaths[_index]).generic_string(); };
+	auto recordedDuration = [&](size_t _index) {
+		auto duration = durations.find(durationKey(_index));
+		return duration == durations.end() ? chrono::microseconds{0} : duration->second;
+	};
+
+	// Starting the test cases that took longest first avoids waiting for one of them at the end.
+	vector<size_t> schedule(testPaths.size());
+	iota(schedule.begin(), schedule.end(), size_t(0));
+	stable_sort(schedule.begin(), schedule.end(), [&](size_t _a, size_t _b) {
+		return recordedDuration(_a) > recordedDuration(_b);
+	});
+
+	struct Run
+	{
+		ostringstream output;
+		Result result = Result::Skipped;
+		chrono::microseconds duration{0};
+		bool done = false;
+	};
+	vector<Run> runs(testPaths.size());
+	mutex outputMutex;
+	size_t nextOutput = 0;
+
+	parallelFor(schedule.size(), _options.jobs, [&](size_t _position) {
+		size_t const index = schedule[_position];
+		Run& run = runs[index];
+		auto const start = chrono::steady_clock::now();
+		TestTool testTool(
+			_testCaseCreator,
+			_options,
+			_basepath / testPaths[index],
+			testPaths[index].generic_path().string()
+		);
+		run.result = testTool.process(run.output);
+		// Updating the expectations does not need any interaction.
+		while (_options.acceptUpdates && run.result == Result::Failure)
+		{
+			testTool.updateTestCase();
+			run.output << "Re-running test case..." << endl;
+			run.result = testTool.process(run.output);
+		}
+		run.duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+		lock_guard<mutex> lock(outputMutex);
+		run.done = true;
+		for (; nextOutput < runs.size() && runs[nextOutput].done; ++nextOutput)
+		{
+			cout << runs[nextOutput].output.str();
+			runs[nextOutput].output = ostringstream();
+		}
+		cout.flush();
+	});
+
+	TestStats stats;
+	std::queue<fs::path> failedPaths;
+	for (size_t index = 0; index < runs.size(); ++index)
+	{
+		switch (runs[index].result)
+		{
+		case Result::Success:
+			++stats.testCount;
+			++stats.successCount;
+			break;
+		case Result::Skipped:
+			++stats.testCount;
+			++stats.skippedCount;
+			// The run times of test cases that were not run are kept.
+			continue;
+		case Result::Failure:
+		case Result::Exception:
+			failedPaths.push(testPaths[index]);
+			break;
+		}
+		durations[durationKey(index)] = runs[index].duration;
+	}
+	if (!_options.durationsFile.empty())
+		writeDurations(_options.durationsFile, durations);
+
+	if (!failedPaths.empty())
+	{
+		cout << endl;
+		AnsiColorized(cout, !_options.noColor, {BOLD}) <<
+			"Running the " << failedPaths.size() << " failed test cases again one by one...";
+		cout << endl << endl;
+		stats += processPaths(_testCaseCreator, _options, _basepath, std::move(failedPaths));
+	}
+	return stats;
+}
+
+TestStats TestTool::processPaths(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	std::queue<fs::path> _paths
+)
+{
 	int successCount = 0;
 	int testCount = 0;
 	int skippedCount = 0;
 
-	while (!paths.empty())
+	while (!_paths.empty())
 	{
-		auto currentPath = paths.front();
+		auto currentPath = _paths.front();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
+			_paths.pop();
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
 			))
 				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
-					paths.push(currentPath / entry.path().filename());
+					_paths.push(currentPath / entry.path().filename());
 		}
 		else if (m_exitRequested)
 		{
 			++testCount;
-			paths.pop();
+			_paths.pop();
 		}
 		else
 		{
@@ -316,7 +504,7 @@ TestStats TestTool::processPath(
 				switch(testTool.handleResponse(result == Result::Exception))
 				{
 				case Request::Quit:
-					paths.pop();
+					_paths.pop();
 					m_exitRequested = true;
 					break;
 				case Request::Rerun:
@@ -324,17 +512,17 @@ TestStats TestTool::processPath(
 					--testCount;
 					break;
 				case Request::Skip:
-					paths.pop();
+					_paths.pop();
 					++skippedCount;
 					break;
 				}
 				break;
 			case Result::Success:
-				paths.pop();
+				_paths.pop();
 				++successCount;
 				break;
 			case Result::Skipped:
-				paths.pop();
+				_paths.pop();
 				++skippedCount;
 				break;
 			}
@@ -0,0 +1,268 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark measuring the throughput of the name and type resolution.
+ */
+
+#include <libsolidity/analysis/DocStringTagParser.h>
+#include <libsolidity/analysis/GlobalContext.h>
+#include <libsolidity/analysis/NameAndTypeResolver.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/parsing/Parser.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/CharStreamProvider.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+class CharStreams: public CharStreamProvider
+{
+public:
+	explicit CharStreams(map<string, string> const& _sources)
+	{
+		for (auto const& [name, source]: _sources)
+			m_charStreams[name] = make_unique<CharStream>(source, name);
+	}
+	CharStream const& charStream(string const& _sourceName) const override
+	{
+		return *m_charStreams.at(_sourceName);
+	}
+	CharStream& charStream(string const& _sourceName) { return *m_charStreams.at(_sourceName); }
+
+private:
+	map<string, unique_ptr<CharStream>> m_charStreams;
+};
+
+/// Counts the names that are resolved by the name and type resolution.
+class NameCounter: private ASTConstVisitor
+{
+public:
+	size_t count(SourceUnit const& _sourceUnit)
+	{
+		_sourceUnit.accept(*this);
+		return m_count;
+	}
+
+private:
+	void endVisit(Identifier const&) override { ++m_count; }
+	void endVisit(IdentifierPath const&) override { ++m_count; }
+
+	size_t m_count = 0;
+};
+
+/// Sources parsed for one run of the resolution, in an order in which every source comes after
+/// the sources it imports.
+struct ParsedSources
+{
+	map<string, ASTPointer<SourceUnit>> asts;
+	vector<SourceUnit*> order;
+};
+
+void printErrors(ErrorList const& _errors, CharStreams const& _charStreams)
+{
+	SourceReferenceFormatter formatter(cerr, _charStreams, false, false);
+	formatter.printErrorInformation(_errors);
+}
+
+bool parse(map<string, string> const& _sources, ParsedSources& _parsed)
+{
+	CharStreams charStreams(_sources);
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	Parser parser(errorReporter, EVMVersion{});
+	for (auto const& [name, source]: _sources)
+		if (ASTPointer<SourceUnit> ast = parser.parse(charStreams.charStream(name)))
+			_parsed.asts[name] = ast;
+
+	DocStringTagParser docStringTagParser(errorReporter);
+	for (auto const& [name, ast]: _parsed.asts)
+	{
+		for (auto const* import: ASTNode::filteredNodes<ImportDirective>(ast->nodes()))
+			import->annotation().absolutePath = util::absolutePath(import->path(), name);
+		docStringTagParser.parseDocStrings(*ast);
+	}
+	if (Error::containsErrors(errors))
+	{
+		printErrors(errors, charStreams);
+		return false;
+	}
+
+	set<string> visited;
+	function<bool(string const&)> addToOrder = [&](string const& _name) {
+		if (!_parsed.asts.count(_name))
+		{
+			cerr << "Imported source not found: " << _name << endl;
+			return false;
+		}
+		if (!visited.insert(_name).second)
+			return true;
+		SourceUnit& ast = *_parsed.asts.at(_name);
+		for (auto const* import: ASTNode::filteredNodes<ImportDirective>(ast.nodes()))
+			if (!addToOrder(*import->annotation().absolutePath))
+				return false;
+		_parsed.order.push_back(&ast);
+		return true;
+	};
+	for (auto const& [name, ast]: _parsed.asts)
+		if (!addToOrder(name))
+			return false;
+	return true;
+}
+
+bool resolve(ParsedSources const& _parsed, ErrorReporter& _errorReporter)
+{
+	GlobalContext globalContext;
+	NameAndTypeResolver resolver(globalContext, EVMVersion{}, _errorReporter);
+
+	map<string, SourceUnit const*> sourceUnitsByName;
+	for (auto const& [name, ast]: _parsed.asts)
+		sourceUnitsByName[name] = ast.get();
+
+	for (SourceUnit* ast: _parsed.order)
+		if (!resolver.registerDeclarations(*ast))
+			return false;
+	for (SourceUnit* ast: _parsed.order)
+		if (!resolver.performImports(*ast, sourceUnitsByName))
+			return false;
+	for (SourceUnit* ast: _parsed.order)
+		if (!resolver.resolveNamesAndTypes(*ast))
+			return false;
+	return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(nameresolutionbench, benchmark for the name and type resolution.
+Usage: nameresolutionbench [Options] file...
+Parses all given Solidity files and reports how long it takes to register their
+declarations and to resolve all names in them.
+Imports have to be resolvable among the given files.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repeat", po::value<size_t>()->default_value(10), "Number of times to process the input.")
+		("input-file", po::value<vector<string>>(), "input file");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	map<string, string> sources;
+	for (string const& path: arguments["input-file"].as<vector<string>>())
+	{
+		try
+		{
+			sources[path] = readFileAsString(path);
+		}
+		catch (FileNotFound const&)
+		{
+			cerr << "File not found: " << path << endl;
+			return 1;
+		}
+		catch (NotAFile const&)
+		{
+			cerr << "Not a regular file: " << path << endl;
+			return 1;
+		}
+	}
+	size_t const repetitions = max<size_t>(arguments["repeat"].as<size_t>(), 1);
+
+	size_t names = 0;
+	chrono::duration<double, milli> total{0};
+	for (size_t i = 0; i < repetitions; ++i)
+	{
+		// The resolution annotates the AST, so every run needs freshly parsed sources.
+		ParsedSources parsed;
+		if (!parse(sources, parsed))
+			return 1;
+
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		auto const start = chrono::steady_clock::now();
+		bool const success = resolve(parsed, errorReporter);
+		total += chrono::steady_clock::now() - start;
+		if (!success)
+		{
+			printErrors(errors, CharStreams(sources));
+			return 1;
+		}
+
+		if (i == 0)
+			for (SourceUnit const* ast: parsed.order)
+				names += NameCounter{}.count(*ast);
+	}
+
+	double const milliseconds = total.count() / static_cast<double>(repetitions);
+	cout << fixed << setprecision(3);
+	cout << "Sources: " << sources.size() << ", " << names << " resolved names" << endl;
+	cout << "Name and type resolution: " << setw(10) << milliseconds << " ms" << endl;
+	cout << "Throughput:               " << setw(10) << static_cast<double>(names) / milliseconds << " names/ms" << endl;
+
+	return 0;
+}
@@ -62,8 +62,7 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 	string yul_source = converter.programToString(_input);
 	// Fuzzer also fuzzes the EVM version field.
 	langutil::EVMVersion version = converter.version();
-	EVMHost hostContext(version, evmone);
-	hostContext.reset();
+	EVMHost& hostContext = EVMHost::reusable(version, evmone);
 
 	if (const char* dump_path = getenv("PROTO_FUZZER_DUMP_PATH"))
 	{
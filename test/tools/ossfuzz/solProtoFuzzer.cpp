@@ -65,7 +65,7 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 
 	// We target the default EVM which is the latest
 	langutil::EVMVersion version;
-	EVMHost hostContext(version, evmone);
+	EVMHost& hostContext = EVMHost::reusable(version, evmone);
 	string contractName = "C";
 	string libraryName = converter.libraryTest() ? converter.libraryName() : "";
 	string methodName = "test()";
@@ -57,7 +57,8 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	}))
 		return 0;
 
-	YulStringRepository::reset();
+	yulFuzzerUtil::limitYulStringMemory();
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion());
 
 	AssemblyStack stack(
 		langutil::EVMVersion(),
@@ -84,7 +85,7 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	yulFuzzerUtil::TerminationReason termReason = yulFuzzerUtil::interpret(
 		os1,
 		stack.parserResult()->code,
-		EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion())
+		dialect
 	);
 	if (yulFuzzerUtil::resourceLimitsExceeded(termReason))
 		return 0;
@@ -93,7 +94,7 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	termReason = yulFuzzerUtil::interpret(
 		os2,
 		stack.parserResult()->code,
-		EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion())
+		dialect
 	);
 
 	if (yulFuzzerUtil::resourceLimitsExceeded(termReason))
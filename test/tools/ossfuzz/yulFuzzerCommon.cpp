@@ -78,6 +78,12 @@ yulFuzzerUtil::TerminationReason yulFuzzerUtil::interpret(
 	return reason;
 }
 
+void yulFuzzerUtil::limitYulStringMemory()
+{
+	if (YulStringRepository::instance().statistics().bytes > yulStringMemoryLimit)
+		YulStringRepository::reset();
+}
+
 bool yulFuzzerUtil::resourceLimitsExceeded(TerminationReason _reason)
 {
 	return
@@ -46,6 +46,13 @@ struct yulFuzzerUtil
 	/// resource exhaustion of some form e.g., exceeded maximum time-out
 	/// threshold, number of nested expressions etc.
 	static bool resourceLimitsExceeded(TerminationReason _reason);
+
+	/// Clears the interned Yul identifiers once they take up more than @a yulStringMemoryLimit bytes.
+	/// Clearing them also discards the cached dialects, which are expensive to build again, so this
+	/// is not done for every input.
+	static void limitYulStringMemory();
+
+	static size_t constexpr yulStringMemoryLimit = 64 * 1024 * 1024;
 	static size_t constexpr maxSteps = 100;
 	static size_t constexpr maxTraceSize = 75;
 	static size_t constexpr maxExprNesting = 64;
@@ -58,7 +58,8 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 		of.write(yul_source.data(), static_cast<streamsize>(yul_source.size()));
 	}
 
-	YulStringRepository::reset();
+	yulFuzzerUtil::limitYulStringMemory();
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(version);
 
 	// AssemblyStack entry point
 	AssemblyStack stack(
@@ -91,7 +92,7 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 	yulFuzzerUtil::TerminationReason termReason = yulFuzzerUtil::interpret(
 		os1,
 		stack.parserResult()->code,
-		EVMDialect::strictAssemblyForEVMObjects(version)
+		dialect
 	);
 
 	if (yulFuzzerUtil::resourceLimitsExceeded(termReason))
@@ -99,7 +100,7 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 
 	YulOptimizerTestCommon optimizerTest(
 		stack.parserResult(),
-		EVMDialect::strictAssemblyForEVMObjects(version)
+		dialect
 	);
 	optimizerTest.setStep(optimizerTest.randomOptimiserStep(_input.step()));
 	shared_ptr<solidity::yul::Block> astBlock = optimizerTest.run();
@@ -107,7 +108,7 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 	termReason = yulFuzzerUtil::interpret(
 		os2,
 		astBlock,
-		EVMDialect::strictAssemblyForEVMObjects(version)
+		dialect
 	);
 	if (yulFuzzerUtil::resourceLimitsExceeded(termReason))
 		return;
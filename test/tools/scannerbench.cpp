@@ -0,0 +1,184 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark for the scanner and the character search functions it uses.
+ */
+
+#include <liblangutil/CharacterSearch.h>
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// @returns the throughput in MB/s of running @a _job @a _repetitions times on @a _corpus.
+double throughput(vector<string> const& _corpus, size_t _repetitions, function<void(string const&)> const& _job)
+{
+	size_t bytes = 0;
+	auto const start = chrono::steady_clock::now();
+	for (size_t i = 0; i < _repetitions; ++i)
+		for (string const& source: _corpus)
+		{
+			_job(source);
+			bytes += source.size();
+		}
+	chrono::duration<double> const duration = chrono::steady_clock::now() - start;
+	return static_cast<double>(bytes) / max(duration.count(), 1e-9) / 1e6;
+}
+
+/// Calls @a _search repeatedly to visit all of @a _text, like the scanner would do.
+void searchAll(string const& _text, function<size_t(string_view, size_t)> const& _search)
+{
+	for (size_t position = 0; position < _text.size();)
+		position = _search(_text, position) + 1;
+}
+
+size_t scanAll(string const& _source, ScannerKind _kind)
+{
+	CharStream stream(_source, "");
+	Scanner scanner(stream);
+	scanner.setScannerMode(_kind);
+	size_t tokens = 0;
+	for (; scanner.currentToken() != Token::EOS; scanner.next())
+		++tokens;
+	return tokens;
+}
+
+void benchmarkSearch(
+	vector<string> const& _corpus,
+	size_t _repetitions,
+	string const& _name,
+	function<size_t(string_view, size_t)> const& _search,
+	function<size_t(string_view, size_t)> const& _reference
+)
+{
+	double const fast = throughput(_corpus, _repetitions, [&](string const& _text) { searchAll(_text, _search); });
+	double const bytewise = throughput(_corpus, _repetitions, [&](string const& _text) { searchAll(_text, _reference); });
+	cout <<
+		setw(20) << left << _name <<
+		setw(12) << right << fixed << setprecision(1) << fast << " MB/s" <<
+		setw(12) << bytewise << " MB/s (bytewise)" <<
+		endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(scannerbench, benchmark for the Solidity and Yul scanner.
+Usage: scannerbench [Options] file...
+Scans all given files and reports the throughput of the scanner and of the
+character search functions it uses, compared to searching one byte at a time.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repeat", po::value<size_t>()->default_value(10), "Number of times to process the input.")
+		("input-file", po::value<vector<string>>(), "input file");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-file"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<string> corpus;
+	for (string const& path: arguments["input-file"].as<vector<string>>())
+	{
+		try
+		{
+			corpus.emplace_back(readFileAsString(path));
+		}
+		catch (FileNotFound const&)
+		{
+			cerr << "File not found: " << path << endl;
+			return 1;
+		}
+		catch (NotAFile const&)
+		{
+			cerr << "Not a regular file: " << path << endl;
+			return 1;
+		}
+	}
+	size_t const repetitions = arguments["repeat"].as<size_t>();
+
+	for (auto [kind, name]: {pair{ScannerKind::Solidity, "Solidity"}, pair{ScannerKind::Yul, "Yul"}})
+	{
+		size_t tokens = 0;
+		double const speed = throughput(corpus, repetitions, [&, kind = kind](string const& _source) {
+			tokens += scanAll(_source, kind);
+		});
+		cout << "Scanner (" << name << "): " << fixed << setprecision(1) << speed << " MB/s, " << tokens << " tokens" << endl;
+	}
+
+	benchmarkSearch(corpus, repetitions, "whitespace", findEndOfWhitespace, findEndOfWhitespaceBytewise);
+	benchmarkSearch(corpus, repetitions, "line break", findLineBreakCandidate, findLineBreakCandidateBytewise);
+	benchmarkSearch(
+		corpus,
+		repetitions,
+		"comment end",
+		[](string_view _text, size_t _position) { return findCharacter(_text, _position, '*'); },
+		[](string_view _text, size_t _position) { return findCharacterBytewise(_text, _position, '*'); }
+	);
+	benchmarkSearch(
+		corpus,
+		repetitions,
+		"identifier",
+		[](string_view _text, size_t _position) { return findEndOfIdentifier(_text, _position, false); },
+		[](string_view _text, size_t _position) { return findEndOfIdentifierBytewise(_text, _position, false); }
+	);
+
+	return 0;
+}
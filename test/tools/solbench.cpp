@@ -0,0 +1,448 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark of the compiler throughput on a corpus of projects, which compiles each of them
+ * in the legacy and the IR-based pipeline with and without the optimiser.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/FileReader.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/Version.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Timing.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+struct Mode
+{
+	string name;
+	bool viaIR;
+	bool optimize;
+};
+
+vector<Mode> const allModes{
+	{"legacy", false, false},
+	{"legacy-optimize", false, true},
+	{"via-ir", true, false},
+	{"via-ir-optimize", true, true},
+};
+
+/// Set of sources that is compiled as a whole, either a single file or all files in a directory.
+struct Benchmark
+{
+	string name;
+	fs::path basePath;
+	map<string, string> sources;
+};
+
+optional<Benchmark> loadBenchmark(fs::path const& _path)
+{
+	Benchmark benchmark;
+	benchmark.name = _path.generic_string();
+	while (benchmark.name.size() > 1 && benchmark.name.back() == '/')
+		benchmark.name.pop_back();
+
+	vector<fs::path> files;
+	if (fs::is_directory(_path))
+	{
+		benchmark.basePath = _path;
+		for (fs::directory_entry const& entry: fs::recursive_directory_iterator(_path))
+			if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+				files.push_back(entry.path());
+		sort(files.begin(), files.end());
+	}
+	else if (fs::is_regular_file(_path))
+	{
+		benchmark.basePath = _path.parent_path().empty() ? fs::path(".") : _path.parent_path();
+		files.push_back(_path);
+	}
+	else
+	{
+		cerr << "Not a file or directory: " << _path.string() << endl;
+		return nullopt;
+	}
+
+	if (files.empty())
+	{
+		cerr << "No Solidity files found in " << _path.string() << endl;
+		return nullopt;
+	}
+
+	FileReader reader(benchmark.basePath);
+	for (fs::path const& file: files)
+		reader.setSource(file, readFileAsString(file));
+	benchmark.sources = reader.sourceCodes();
+	return benchmark;
+}
+
+/// Compiles @a _benchmark in @a _mode and @returns its measurements or null if the compilation failed.
+Json::Value compileBenchmark(Benchmark const& _benchmark, Mode const& _mode, vector<fs::path> const& _includePaths)
+{
+	FileReader::FileSystemPathSet allowedDirectories{_benchmark.basePath};
+	allowedDirectories.insert(_includePaths.begin(), _includePaths.end());
+	FileReader reader(_benchmark.basePath, _includePaths, allowedDirectories);
+	reader.setSources(_benchmark.sources);
+
+	CompilerStack compiler(reader.reader());
+	compiler.setSources(reader.sourceCodes());
+	compiler.setViaIR(_mode.viaIR);
+	compiler.setOptimiserSettings(_mode.optimize ? OptimiserSettings::standard() : OptimiserSettings::minimal());
+	compiler.enableTimingCollection();
+
+	auto const start = chrono::steady_clock::now();
+	bool const success = compiler.compile();
+	auto const wallTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+	if (!success)
+	{
+		SourceReferenceFormatter formatter(cerr, compiler, false, false);
+		formatter.printErrorInformation(compiler.errors());
+		return Json::nullValue;
+	}
+
+	Json::Value const timings = compiler.timingJSON();
+	Json::Value result(Json::objectValue);
+	result["wallTime"] = Json::UInt64(wallTime.count());
+	result["peakMemory"] = Json::UInt64(peakMemoryUsage());
+	result["stages"] = Json::objectValue;
+	for (string const& stage: timings["stages"].getMemberNames())
+		result["stages"][stage] = timings["stages"][stage]["wallTime"];
+	// Sums up the phases of the code generation over all contracts.
+	result["contractPhases"] = Json::objectValue;
+	for (Json::Value const& sourceTimings: timings["contracts"])
+		for (Json::Value const& contractTimings: sourceTimings)
+			for (string const& phase: contractTimings.getMemberNames())
+				if (contractTimings[phase].isMember("wallTime"))
+				{
+					Json::Value& phaseTime = result["contractPhases"][phase];
+					phaseTime = Json::UInt64(phaseTime.asUInt64() + contractTimings[phase]["wallTime"].asUInt64());
+				}
+
+	size_t bytecodeSize = 0;
+	size_t deployedBytecodeSize = 0;
+	for (string const& contract: compiler.contractNames())
+	{
+		bytecodeSize += compiler.object(contract).bytecode.size();
+		deployedBytecodeSize += compiler.runtimeObject(contract).bytecode.size();
+	}
+	result["bytecodeSize"] = Json::UInt64(bytecodeSize);
+	result["deployedBytecodeSize"] = Json::UInt64(deployedBytecodeSize);
+	return result;
+}
+
+/// Runs @a _job in a child process where possible, so that the peak memory usage and the caches
+/// of one compilation do not affect the next. @returns its result or null if it failed.
+Json::Value runIsolated(function<Json::Value()> const& _job)
+{
+#if defined(__linux__) || defined(__APPLE__)
+	int pipeFds[2];
+	if (pipe(pipeFds) != 0)
+		return _job();
+	cout.flush();
+	cerr.flush();
+	pid_t const child = fork();
+	if (child < 0)
+	{
+		close(pipeFds[0]);
+		close(pipeFds[1]);
+		return _job();
+	}
+	if (child == 0)
+	{
+		close(pipeFds[0]);
+		string output;
+		try
+		{
+			output = jsonCompactPrint(_job());
+		}
+		catch (...)
+		{
+			cerr << "Uncaught exception:" << endl << boost::current_exception_diagnostic_information() << endl;
+			cerr.flush();
+			_Exit(1);
+		}
+		size_t written = 0;
+		while (written < output.size())
+		{
+			ssize_t const count = write(pipeFds[1], output.data() + written, output.size() - written);
+			if (count <= 0)
+				break;
+			written += static_cast<size_t>(count);
+		}
+		close(pipeFds[1]);
+		cerr.flush();
+		_Exit(written == output.size() ? 0 : 1);
+	}
+
+	close(pipeFds[1]);
+	string output;
+	char buffer[4096];
+	for (ssize_t count; (count = read(pipeFds[0], buffer, sizeof(buffer))) > 0;)
+		output.append(buffer, static_cast<size_t>(count));
+	close(pipeFds[0]);
+	int status = 0;
+	waitpid(child, &status, 0);
+
+	Json::Value result;
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || !jsonParseStrict(output, result))
+		return Json::nullValue;
+	return result;
+#else
+	return _job();
+#endif
+}
+
+double percentChange(Json::Value const& _baseline, Json::Value const& _current)
+{
+	double const baseline = static_cast<double>(_baseline.asUInt64());
+	if (baseline == 0)
+		return 0;
+	return (static_cast<double>(_current.asUInt64()) - baseline) / baseline * 100;
+}
+
+string formatChange(double _change)
+{
+	ostringstream output;
+	output << fixed << setprecision(1) << showpos << _change << "%";
+	return output.str();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(solbench, benchmark for the compiler throughput.
+Usage: solbench [Options] path...
+Compiles each given file or directory, where a directory is compiled together with
+all Solidity files in it, and reports the wall time of the phases of the compilation,
+the peak memory usage and the size of the generated bytecode.
+For example, run it on the projects from the repository:
+    solbench test/compilationTests/*/
+or on checkouts of external projects with their dependencies given as include paths.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		(
+			"modes",
+			po::value<string>()->default_value("legacy,legacy-optimize,via-ir,via-ir-optimize"),
+			"Comma-separated list of the modes to compile in."
+		)
+		("repeat", po::value<size_t>()->default_value(3), "Number of compilations per mode, of which the fastest is reported.")
+		("include-path", po::value<vector<string>>(), "Additional directory to look for imported files in.")
+		("output-json", po::value<string>(), "Write the results as JSON to the given file.")
+		("baseline", po::value<string>(), "Compare the results to a file written by --output-json.")
+		(
+			"max-regression",
+			po::value<double>(),
+			"Fail if the wall time or the peak memory usage of any compilation grew by more than "
+			"the given percentage compared to the baseline."
+		)
+		("input-path", po::value<vector<string>>(), "input file or directory");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-path", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-path"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<Mode> modes;
+	vector<string> modeNames;
+	boost::split(modeNames, arguments["modes"].as<string>(), boost::is_any_of(","));
+	for (string const& modeName: modeNames)
+	{
+		auto mode = find_if(allModes.begin(), allModes.end(), [&](Mode const& _mode) { return _mode.name == modeName; });
+		if (mode == allModes.end())
+		{
+			cerr << "Invalid mode: " << modeName << endl;
+			return 1;
+		}
+		modes.push_back(*mode);
+	}
+
+	vector<fs::path> includePaths;
+	if (arguments.count("include-path"))
+		for (string const& path: arguments["include-path"].as<vector<string>>())
+			includePaths.emplace_back(path);
+
+	Json::Value baseline;
+	if (arguments.count("baseline"))
+	{
+		try
+		{
+			if (!jsonParseStrict(readFileAsString(arguments["baseline"].as<string>()), baseline))
+			{
+				cerr << "Invalid baseline file: " << arguments["baseline"].as<string>() << endl;
+				return 1;
+			}
+		}
+		catch (FileNotFound const&)
+		{
+			cerr << "File not found: " << arguments["baseline"].as<string>() << endl;
+			return 1;
+		}
+	}
+	optional<double> maxRegression;
+	if (arguments.count("max-regression"))
+		maxRegression = arguments["max-regression"].as<double>();
+
+	vector<Benchmark> benchmarks;
+	for (string const& path: arguments["input-path"].as<vector<string>>())
+		try
+		{
+			optional<Benchmark> benchmark = loadBenchmark(path);
+			if (!benchmark)
+				return 1;
+			benchmarks.emplace_back(move(*benchmark));
+		}
+		catch (FileNotFound const&)
+		{
+			cerr << "File not found: " << path << endl;
+			return 1;
+		}
+	size_t const repetitions = max<size_t>(arguments["repeat"].as<size_t>(), 1);
+
+	Json::Value output(Json::objectValue);
+	output["version"] = VersionString;
+	output["repeat"] = Json::UInt64(repetitions);
+	output["benchmarks"] = Json::objectValue;
+
+	bool failed = false;
+	bool regressed = false;
+	cout << fixed << setprecision(3);
+	for (Benchmark const& benchmark: benchmarks)
+	{
+		cout << benchmark.name << " (" << benchmark.sources.size() << " sources)" << endl;
+		for (Mode const& mode: modes)
+		{
+			Json::Value fastest;
+			for (size_t i = 0; i < repetitions; ++i)
+			{
+				Json::Value result = runIsolated([&]() { return compileBenchmark(benchmark, mode, includePaths); });
+				if (result.isNull())
+				{
+					fastest = Json::nullValue;
+					break;
+				}
+				if (fastest.isNull() || result["wallTime"].asUInt64() < fastest["wallTime"].asUInt64())
+					fastest = move(result);
+			}
+
+			cout << "  " << left << setw(17) << mode.name << right;
+			if (fastest.isNull())
+			{
+				cout << "compilation failed" << endl;
+				failed = true;
+				continue;
+			}
+			cout <<
+				setw(12) << static_cast<double>(fastest["wallTime"].asUInt64()) / 1000 << " ms" <<
+				setw(12) << static_cast<double>(fastest["peakMemory"].asUInt64()) / (1024 * 1024) << " MiB" <<
+				setw(10) << fastest["bytecodeSize"].asUInt64() << " bytes";
+
+			Json::Value const& previous = baseline["benchmarks"][benchmark.name][mode.name];
+			if (previous.isObject())
+			{
+				double const timeChange = percentChange(previous["wallTime"], fastest["wallTime"]);
+				double const memoryChange = percentChange(previous["peakMemory"], fastest["peakMemory"]);
+				cout << "   time " << formatChange(timeChange) << ", memory " << formatChange(memoryChange);
+				if (previous["bytecodeSize"] != fastest["bytecodeSize"])
+					cout << ", bytecode " << formatChange(percentChange(previous["bytecodeSize"], fastest["bytecodeSize"]));
+				if (maxRegression && (timeChange > *maxRegression || memoryChange > *maxRegression))
+				{
+					cout << " (regression)";
+					regressed = true;
+				}
+			}
+			cout << endl;
+
+			output["benchmarks"][benchmark.name][mode.name] = move(fastest);
+		}
+	}
+
+	if (arguments.count("output-json"))
+	{
+		ofstream outputFile(arguments["output-json"].as<string>());
+		outputFile << jsonPrettyPrint(output) << endl;
+		if (!outputFile)
+		{
+			cerr << "Could not write " << arguments["output-json"].as<string>() << endl;
+			return 1;
+		}
+	}
+
+	if (failed)
+		return 1;
+	return regressed ? 2 : 0;
+}
@@ -31,6 +31,7 @@
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/Numeric.h>
 
+#include <algorithm>
 #include <limits>
 
 using namespace std;
@@ -72,12 +73,18 @@ u256 readZeroExtended(bytes const& _data, u256 const& _offset)
 /// @a _target at offset @a _targetOffset. Behaves as if @a _source would
 /// continue with an infinite sequence of zero bytes beyond its end.
 void copyZeroExtended(
-	map<u256, uint8_t>& _target, bytes const& _source,
+	InterpreterMemory& _target, bytes const& _source,
 	size_t _targetOffset, size_t _sourceOffset, size_t _size
 )
 {
-	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0;
+	bytes data(_size, 0);
+	if (_sourceOffset < _source.size())
+		copy_n(
+			_source.begin() + static_cast<ptrdiff_t>(_sourceOffset),
+			min(_size, _source.size() - _sourceOffset),
+			data.begin()
+		);
+	_target.write(_targetOffset, data);
 }
 
 }
@@ -487,10 +494,7 @@ bool EVMInstructionInterpreter::accessMemory(u256 const& _offset, u256 const& _s
 bytes EVMInstructionInterpreter::readMemory(u256 const& _offset, u256 const& _size)
 {
 	yulAssert(_size <= 0xffff, "Too large read.");
-	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
-	return data;
+	return m_state.memory.read(_offset, size_t(_size));
 }
 
 u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
@@ -500,8 +504,7 @@ u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
 
 void EVMInstructionInterpreter::writeMemoryWord(u256 const& _offset, u256 const& _value)
 {
-	for (size_t i = 0; i < 32; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (8 * (31 - i))) & 0xff);
+	m_state.memory.write(_offset, h256(_value).asBytes());
 }
 
 
@@ -31,6 +31,7 @@
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/Numeric.h>
 
+#include <algorithm>
 #include <limits>
 
 using namespace std;
@@ -48,12 +49,18 @@ namespace
 /// @a _target at offset @a _targetOffset. Behaves as if @a _source would
 /// continue with an infinite sequence of zero bytes beyond its end.
 void copyZeroExtended(
-	map<u256, uint8_t>& _target, bytes const& _source,
+	InterpreterMemory& _target, bytes const& _source,
 	size_t _targetOffset, size_t _sourceOffset, size_t _size
 )
 {
-	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0;
+	bytes data(_size, 0);
+	if (_sourceOffset < _source.size())
+		copy_n(
+			_source.begin() + static_cast<ptrdiff_t>(_sourceOffset),
+			min(_size, _source.size() - _sourceOffset),
+			data.begin()
+		);
+	_target.write(_targetOffset, data);
 }
 
 /// Count leading zeros for uint64. Following WebAssembly rules, it returns 64 for @a _v being zero.
@@ -530,10 +537,7 @@ void EwasmBuiltinInterpreter::accessMemory(u256 const& _offset, u256 const& _siz
 bytes EwasmBuiltinInterpreter::readMemory(uint64_t _offset, uint64_t _size)
 {
 	yulAssert(_size <= 0xffff, "Too large read.");
-	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
-	return data;
+	return m_state.memory.read(_offset, size_t(_size));
 }
 
 uint64_t EwasmBuiltinInterpreter::readMemoryWord(uint64_t _offset)
@@ -554,8 +558,7 @@ uint32_t EwasmBuiltinInterpreter::readMemoryHalfWord(uint64_t _offset)
 
 void EwasmBuiltinInterpreter::writeMemory(uint64_t _offset, bytes const& _value)
 {
-	for (size_t i = 0; i < _value.size(); i++)
-		m_state.memory[_offset + i] = _value[i];
+	m_state.memory.write(_offset, _value);
 }
 
 void EwasmBuiltinInterpreter::writeMemoryWord(uint64_t _offset, uint64_t _value)
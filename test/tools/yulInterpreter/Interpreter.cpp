@@ -33,11 +33,13 @@
 #include <liblangutil/Exceptions.h>
 
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/Visitor.h>
 
 #include <boost/algorithm/cxx11/all_of.hpp>
 
 #include <range/v3/view/reverse.hpp>
 
+#include <algorithm>
 #include <ostream>
 #include <variant>
 
@@ -48,6 +50,217 @@ using namespace solidity::yul::test;
 
 using solidity::util::h256;
 
+namespace
+{
+
+/// Assigns the slots of the variables and the targets of the function calls.
+class NameResolver
+{
+public:
+	NameResolver(Dialect const& _dialect, ResolvedNames& _names): m_dialect(_dialect), m_names(_names) {}
+
+	void resolveMain(Block const& _ast)
+	{
+		block(_ast);
+		m_names.mainFrameSize = m_frameSize;
+	}
+
+private:
+	struct Scope
+	{
+		std::map<YulString, size_t> variables;
+		std::map<YulString, FunctionDefinition const*> functions;
+		/// True for the scope of the parameters of a function, which hides the variables outside.
+		bool isFunction = false;
+	};
+
+	void block(Block const& _block)
+	{
+		m_scopes.emplace_back();
+		registerFunctions(_block);
+		for (Statement const& statement: _block.statements)
+			visit(statement);
+		m_scopes.pop_back();
+	}
+
+	void visit(Statement const& _statement)
+	{
+		std::visit(util::GenericVisitor{
+			[&](ExpressionStatement const& _expressionStatement) { visit(_expressionStatement.expression); },
+			[&](Assignment const& _assignment) {
+				visit(*_assignment.value);
+				for (Identifier const& variable: _assignment.variableNames)
+					reference(variable);
+			},
+			[&](VariableDeclaration const& _declaration) {
+				if (_declaration.value)
+					visit(*_declaration.value);
+				for (TypedName const& variable: _declaration.variables)
+					declare(variable);
+			},
+			[&](If const& _if) {
+				visit(*_if.condition);
+				block(_if.body);
+			},
+			[&](Switch const& _switch) {
+				visit(*_switch.expression);
+				for (Case const& switchCase: _switch.cases)
+					block(switchCase.body);
+			},
+			[&](FunctionDefinition const& _function) { function(_function); },
+			[&](ForLoop const& _forLoop) {
+				// The variables of the pre block are visible in the rest of the loop.
+				m_scopes.emplace_back();
+				registerFunctions(_forLoop.pre);
+				for (Statement const& statement: _forLoop.pre.statements)
+					visit(statement);
+				visit(*_forLoop.condition);
+				block(_forLoop.body);
+				block(_forLoop.post);
+				m_scopes.pop_back();
+			},
+			[&](Block const& _block) { block(_block); },
+			[](Break const&) {},
+			[](Continue const&) {},
+			[](Leave const&) {},
+		}, _statement);
+	}
+
+	void visit(Expression const& _expression)
+	{
+		std::visit(util::GenericVisitor{
+			[&](FunctionCall const& _call) { call(_call); },
+			[&](Identifier const& _identifier) { reference(_identifier); },
+			[](Literal const&) {},
+		}, _expression);
+	}
+
+	void function(FunctionDefinition const& _function)
+	{
+		size_t const outerFrameSize = exchange(m_frameSize, 0);
+		m_scopes.emplace_back();
+		m_scopes.back().isFunction = true;
+		for (TypedName const& parameter: _function.parameters)
+			declare(parameter);
+		for (TypedName const& returnVariable: _function.returnVariables)
+			declare(returnVariable);
+		block(_function.body);
+		m_scopes.pop_back();
+		m_names.frameSizes[&_function] = m_frameSize;
+		m_frameSize = outerFrameSize;
+	}
+
+	void call(FunctionCall const& _call)
+	{
+		ResolvedNames::CallTarget target;
+		if (BuiltinFunction const* builtin = m_dialect.builtin(_call.functionName.name))
+		{
+			if (!builtin->literalArguments.empty())
+				target.literalArguments = &builtin->literalArguments;
+			if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+				target.evmBuiltin = dialect->builtin(_call.functionName.name);
+			else if (dynamic_cast<WasmDialect const*>(&m_dialect))
+				target.wasmBuiltin = true;
+		}
+		if (!target.evmBuiltin && !target.wasmBuiltin)
+		{
+			for (auto scope = m_scopes.rbegin(); scope != m_scopes.rend() && !target.function; ++scope)
+				if (auto function = scope->functions.find(_call.functionName.name); function != scope->functions.end())
+					target.function = function->second;
+			yulAssert(target.function, "Function not found.");
+		}
+		m_names.callTargets[&_call] = target;
+
+		for (Expression const& argument: _call.arguments)
+			visit(argument);
+	}
+
+	void registerFunctions(Block const& _block)
+	{
+		for (Statement const& statement: _block.statements)
+			if (FunctionDefinition const* function = get_if<FunctionDefinition>(&statement))
+				m_scopes.back().functions[function->name] = function;
+	}
+
+	void declare(TypedName const& _variable)
+	{
+		m_names.declarationSlots[&_variable] = m_frameSize;
+		m_scopes.back().variables[_variable.name] = m_frameSize;
+		++m_frameSize;
+	}
+
+	void reference(Identifier const& _identifier)
+	{
+		for (auto scope = m_scopes.rbegin(); scope != m_scopes.rend(); ++scope)
+		{
+			if (auto variable = scope->variables.find(_identifier.name); variable != scope->variables.end())
+			{
+				m_names.identifierSlots[&_identifier] = variable->second;
+				return;
+			}
+			if (scope->isFunction)
+				break;
+		}
+		yulAssert(false, "Variable not found.");
+	}
+
+	Dialect const& m_dialect;
+	ResolvedNames& m_names;
+	std::vector<Scope> m_scopes;
+	/// Number of slots used in the frame of the current function so far.
+	size_t m_frameSize = 0;
+};
+
+}
+
+uint8_t& InterpreterMemory::operator[](u256 const& _offset)
+{
+	return page(_offset / PageSize)[static_cast<size_t>(_offset % PageSize)];
+}
+
+bytes InterpreterMemory::read(u256 const& _offset, size_t _size)
+{
+	bytes data;
+	data.reserve(_size);
+	u256 position = _offset;
+	while (data.size() < _size)
+	{
+		size_t const begin = static_cast<size_t>(position % PageSize);
+		size_t const count = min(PageSize - begin, _size - data.size());
+		Page const& current = page(position / PageSize);
+		data.insert(data.end(), current.begin() + static_cast<ptrdiff_t>(begin), current.begin() + static_cast<ptrdiff_t>(begin + count));
+		position += count;
+	}
+	return data;
+}
+
+void InterpreterMemory::write(u256 const& _offset, bytes const& _data)
+{
+	u256 position = _offset;
+	for (size_t written = 0; written < _data.size();)
+	{
+		size_t const begin = static_cast<size_t>(position % PageSize);
+		size_t const count = min(PageSize - begin, _data.size() - written);
+		Page& current = page(position / PageSize);
+		copy_n(_data.begin() + static_cast<ptrdiff_t>(written), count, current.begin() + static_cast<ptrdiff_t>(begin));
+		written += count;
+		position += count;
+	}
+}
+
+InterpreterMemory::Page& InterpreterMemory::page(u256 const& _index)
+{
+	if (!m_lastPage || m_lastPageIndex != _index)
+	{
+		auto [position, inserted] = m_pages.try_emplace(_index);
+		if (inserted)
+			position->second.fill(0);
+		m_lastPageIndex = _index;
+		m_lastPage = &position->second;
+	}
+	return *m_lastPage;
+}
+
 void InterpreterState::dumpStorage(ostream& _out) const
 {
 	for (auto const& slot: storage)
@@ -61,20 +274,31 @@ void InterpreterState::dumpTraceAndState(ostream& _out) const
 	for (auto const& line: trace)
 		_out << "  " << line << endl;
 	_out << "Memory dump:\n";
-	map<u256, u256> words;
-	for (auto const& [offset, value]: memory)
-		words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-	for (auto const& [offset, value]: words)
-		if (value != 0)
-			_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+	// The page size is a multiple of the word size, so that the words do not span pages.
+	static_assert(InterpreterMemory::PageSize % 0x20 == 0);
+	for (auto const& [index, page]: memory.pages())
+		for (size_t begin = 0; begin < InterpreterMemory::PageSize; begin += 0x20)
+		{
+			h256 word;
+			copy_n(page.begin() + static_cast<ptrdiff_t>(begin), 0x20, word.data());
+			if (word != h256{})
+				_out << "  " << std::uppercase << std::hex << std::setw(4) << u256(index * InterpreterMemory::PageSize + begin) << ": " << word.hex() << endl;
+		}
 	_out << "Storage dump:" << endl;
 	dumpStorage(_out);
 }
 
+ResolvedNames ResolvedNames::resolve(Dialect const& _dialect, Block const& _ast)
+{
+	ResolvedNames names;
+	NameResolver{_dialect, names}.resolveMain(_ast);
+	return names;
+}
+
 void Interpreter::run(InterpreterState& _state, Dialect const& _dialect, Block const& _ast)
 {
-	Scope scope;
-	Interpreter{_state, _dialect, scope}(_ast);
+	ResolvedNames const names = ResolvedNames::resolve(_dialect, _ast);
+	Interpreter{_state, _dialect, names, vector<u256>(names.mainFrameSize, 0)}(_ast);
 }
 
 void Interpreter::operator()(ExpressionStatement const& _expressionStatement)
@@ -88,11 +312,7 @@ void Interpreter::operator()(Assignment const& _assignment)
 	vector<u256> values = evaluateMulti(*_assignment.value);
 	solAssert(values.size() == _assignment.variableNames.size(), "");
 	for (size_t i = 0; i < values.size(); ++i)
-	{
-		YulString varName = _assignment.variableNames.at(i).name;
-		solAssert(m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
-	}
+		m_variables[m_names.identifierSlots.at(&_assignment.variableNames[i])] = values[i];
 }
 
 void Interpreter::operator()(VariableDeclaration const& _declaration)
@@ -103,12 +323,7 @@ void Interpreter::operator()(VariableDeclaration const& _declaration)
 
 	solAssert(values.size() == _declaration.variables.size(), "");
 	for (size_t i = 0; i < values.size(); ++i)
-	{
-		YulString varName = _declaration.variables.at(i).name;
-		solAssert(!m_variables.count(varName), "");
-		m_variables[varName] = values.at(i);
-		m_scope->names.emplace(varName, nullptr);
-	}
+		m_variables[m_names.declarationSlots.at(&_declaration.variables[i])] = values[i];
 }
 
 void Interpreter::operator()(If const& _if)
@@ -140,9 +355,6 @@ void Interpreter::operator()(ForLoop const& _forLoop)
 {
 	solAssert(_forLoop.condition, "");
 
-	enterScope(_forLoop.pre);
-	ScopeGuard g([this]{ leaveScope(); });
-
 	for (auto const& statement: _forLoop.pre.statements)
 	{
 		visit(statement);
@@ -187,15 +399,6 @@ void Interpreter::operator()(Leave const&)
 
 void Interpreter::operator()(Block const& _block)
 {
-	enterScope(_block);
-	// Register functions.
-	for (auto const& statement: _block.statements)
-		if (holds_alternative<FunctionDefinition>(statement))
-		{
-			FunctionDefinition const& funDef = std::get<FunctionDefinition>(statement);
-			m_scope->names.emplace(funDef.name, &funDef);
-		}
-
 	for (auto const& statement: _block.statements)
 	{
 		incrementStep();
@@ -203,44 +406,22 @@ void Interpreter::operator()(Block const& _block)
 		if (m_state.controlFlowState != ControlFlowState::Default)
 			break;
 	}
-
-	leaveScope();
 }
 
 u256 Interpreter::evaluate(Expression const& _expression)
 {
-	ExpressionEvaluator ev(m_state, m_dialect, *m_scope, m_variables);
+	ExpressionEvaluator ev(m_state, m_dialect, m_names, m_variables);
 	ev.visit(_expression);
 	return ev.value();
 }
 
 vector<u256> Interpreter::evaluateMulti(Expression const& _expression)
 {
-	ExpressionEvaluator ev(m_state, m_dialect, *m_scope, m_variables);
+	ExpressionEvaluator ev(m_state, m_dialect, m_names, m_variables);
 	ev.visit(_expression);
 	return ev.values();
 }
 
-void Interpreter::enterScope(Block const& _block)
-{
-	if (!m_scope->subScopes.count(&_block))
-		m_scope->subScopes[&_block] = make_unique<Scope>(Scope{
-			{},
-			{},
-			m_scope
-		});
-	m_scope = m_scope->subScopes[&_block].get();
-}
-
-void Interpreter::leaveScope()
-{
-	for (auto const& [var, funDeclaration]: m_scope->names)
-		if (!funDeclaration)
-			m_variables.erase(var);
-	m_scope = m_scope->parent;
-	yulAssert(m_scope, "");
-}
-
 void Interpreter::incrementStep()
 {
 	m_state.numSteps++;
@@ -262,59 +443,42 @@ void ExpressionEvaluator::operator()(Literal const& _literal)
 
 void ExpressionEvaluator::operator()(Identifier const& _identifier)
 {
-	solAssert(m_variables.count(_identifier.name), "");
 	incrementStep();
-	setValue(m_variables.at(_identifier.name));
+	setValue(m_variables[m_names.identifierSlots.at(&_identifier)]);
 }
 
 void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
 {
-	vector<optional<LiteralKind>> const* literalArguments = nullptr;
-	if (BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name))
-		if (!builtin->literalArguments.empty())
-			literalArguments = &builtin->literalArguments;
-	evaluateArgs(_funCall.arguments, literalArguments);
+	ResolvedNames::CallTarget const& target = m_names.callTargets.at(&_funCall);
+	evaluateArgs(_funCall.arguments, target.literalArguments);
 
-	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+	if (target.evmBuiltin)
 	{
-		if (BuiltinFunctionForEVM const* fun = dialect->builtin(_funCall.functionName.name))
-		{
-			EVMInstructionInterpreter interpreter(m_state);
-			setValue(interpreter.evalBuiltin(*fun, _funCall.arguments, values()));
-			return;
-		}
+		EVMInstructionInterpreter interpreter(m_state);
+		setValue(interpreter.evalBuiltin(*target.evmBuiltin, _funCall.arguments, values()));
+		return;
+	}
+	else if (target.wasmBuiltin)
+	{
+		EwasmBuiltinInterpreter interpreter(m_state);
+		setValue(interpreter.evalBuiltin(_funCall.functionName.name, _funCall.arguments, values()));
+		return;
 	}
-	else if (WasmDialect const* dialect = dynamic_cast<WasmDialect const*>(&m_dialect))
-		if (dialect->builtin(_funCall.functionName.name))
-		{
-			EwasmBuiltinInterpreter interpreter(m_state);
-			setValue(interpreter.evalBuiltin(_funCall.functionName.name, _funCall.arguments, values()));
-			return;
-		}
-
-	Scope* scope = &m_scope;
-	for (; scope; scope = scope->parent)
-		if (scope->names.count(_funCall.functionName.name))
-			break;
-	yulAssert(scope, "");
 
-	FunctionDefinition const* fun = scope->names.at(_funCall.functionName.name);
-	yulAssert(fun, "Function not found.");
-	yulAssert(m_values.size() == fun->parameters.size(), "");
-	map<YulString, u256> variables;
-	for (size_t i = 0; i < fun->parameters.size(); ++i)
-		variables[fun->parameters.at(i).name] = m_values.at(i);
-	for (size_t i = 0; i < fun->returnVariables.size(); ++i)
-		variables[fun->returnVariables.at(i).name] = 0;
+	FunctionDefinition const& fun = *target.function;
+	yulAssert(m_values.size() == fun.parameters.size(), "");
+	vector<u256> variables(m_names.frameSizes.at(&fun), 0);
+	for (size_t i = 0; i < fun.parameters.size(); ++i)
+		variables[m_names.declarationSlots.at(&fun.parameters[i])] = m_values[i];
 
 	m_state.controlFlowState = ControlFlowState::Default;
-	Interpreter interpreter(m_state, m_dialect, *scope, std::move(variables));
-	interpreter(fun->body);
+	Interpreter interpreter(m_state, m_dialect, m_names, std::move(variables));
+	interpreter(fun.body);
 	m_state.controlFlowState = ControlFlowState::Default;
 
 	m_values.clear();
-	for (auto const& retVar: fun->returnVariables)
-		m_values.emplace_back(interpreter.valueOfVariable(retVar.name));
+	for (auto const& retVar: fun.returnVariables)
+		m_values.emplace_back(interpreter.valueOfVariable(retVar));
 }
 
 u256 ExpressionEvaluator::value() const
@@ -29,11 +29,16 @@
 
 #include <libsolutil/Exceptions.h>
 
+#include <array>
 #include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::yul
 {
 struct Dialect;
+struct BuiltinFunctionForEVM;
 }
 
 namespace solidity::yul::test
@@ -67,11 +72,47 @@ enum class ControlFlowState
 	Leave
 };
 
+/**
+ * Byte-addressed memory of the interpreter. The bytes are stored in pages of consecutive bytes,
+ * so that accessing a word does not need a lookup per byte. Bytes that were not accessed are zero.
+ */
+class InterpreterMemory
+{
+public:
+	static size_t constexpr PageSize = 1024;
+	using Page = std::array<uint8_t, PageSize>;
+
+	InterpreterMemory() = default;
+	InterpreterMemory(InterpreterMemory const& _other): m_pages(_other.m_pages) {}
+	InterpreterMemory& operator=(InterpreterMemory const& _other)
+	{
+		m_pages = _other.m_pages;
+		m_lastPage = nullptr;
+		return *this;
+	}
+
+	/// @returns the byte at @a _offset, which wraps around at 2**256.
+	uint8_t& operator[](u256 const& _offset);
+	bytes read(u256 const& _offset, size_t _size);
+	void write(u256 const& _offset, bytes const& _data);
+
+	/// @returns the pages that were accessed, by the offset of their first byte divided by the page size.
+	std::map<u256, Page> const& pages() const { return m_pages; }
+
+private:
+	Page& page(u256 const& _index);
+
+	std::map<u256, Page> m_pages;
+	/// The page accessed last, since accesses tend to be close to each other.
+	u256 m_lastPageIndex;
+	Page* m_lastPage = nullptr;
+};
+
 struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
+	InterpreterMemory memory;
 	/// This is different than memory.size() because we ignore gas.
 	u256 msize;
 	std::map<util::h256, util::h256> storage;
@@ -108,14 +149,35 @@ struct InterpreterState
 };
 
 /**
- * Scope structure built and maintained during execution.
+ * Names of an AST resolved before running it. Every variable gets a slot in the frame of the
+ * function it belongs to and every function call its target, so that no names have to be looked
+ * up while running the code.
  */
-struct Scope
+struct ResolvedNames
 {
-	/// Used for variables and functions. Value is nullptr for variables.
-	std::map<YulString, FunctionDefinition const*> names;
-	std::map<Block const*, std::unique_ptr<Scope>> subScopes;
-	Scope* parent = nullptr;
+	struct CallTarget
+	{
+		/// Set for the builtins of an EVM dialect.
+		BuiltinFunctionForEVM const* evmBuiltin = nullptr;
+		/// True for the builtins of a Wasm dialect.
+		bool wasmBuiltin = false;
+		/// The arguments of the builtin that are literals which are not evaluated, if there are any.
+		std::vector<std::optional<LiteralKind>> const* literalArguments = nullptr;
+		/// Set for user-defined functions.
+		FunctionDefinition const* function = nullptr;
+	};
+
+	static ResolvedNames resolve(Dialect const& _dialect, Block const& _ast);
+
+	/// Slots of the variables that are referenced or assigned to.
+	std::unordered_map<Identifier const*, size_t> identifierSlots;
+	/// Slots of the declared variables, parameters and return variables.
+	std::unordered_map<TypedName const*, size_t> declarationSlots;
+	std::unordered_map<FunctionCall const*, CallTarget> callTargets;
+	/// Number of slots in the frame of each function.
+	std::unordered_map<FunctionDefinition const*, size_t> frameSizes;
+	/// Number of slots in the frame of the code outside of functions.
+	size_t mainFrameSize = 0;
 };
 
 /**
@@ -129,13 +191,13 @@ public:
 	Interpreter(
 		InterpreterState& _state,
 		Dialect const& _dialect,
-		Scope& _scope,
-		std::map<YulString, u256> _variables = {}
+		ResolvedNames const& _names,
+		std::vector<u256> _variables
 	):
 		m_dialect(_dialect),
 		m_state(_state),
-		m_variables(std::move(_variables)),
-		m_scope(&_scope)
+		m_names(_names),
+		m_variables(std::move(_variables))
 	{
 	}
 
@@ -153,7 +215,7 @@ public:
 
 	std::vector<std::string> const& trace() const { return m_state.trace; }
 
-	u256 valueOfVariable(YulString _name) const { return m_variables.at(_name); }
+	u256 valueOfVariable(TypedName const& _variable) const { return m_variables.at(m_names.declarationSlots.at(&_variable)); }
 
 private:
 	/// Asserts that the expression evaluates to exactly one value and returns it.
@@ -161,18 +223,15 @@ private:
 	/// Evaluates the expression and returns its value.
 	std::vector<u256> evaluateMulti(Expression const& _expression);
 
-	void enterScope(Block const& _block);
-	void leaveScope();
-
 	/// Increment interpreter step count, throwing exception if step limit
 	/// is reached.
 	void incrementStep();
 
 	Dialect const& m_dialect;
 	InterpreterState& m_state;
-	/// Values of variables.
-	std::map<YulString, u256> m_variables;
-	Scope* m_scope;
+	ResolvedNames const& m_names;
+	/// Values of the variables in the frame of the current function, indexed by their slots.
+	std::vector<u256> m_variables;
 };
 
 /**
@@ -184,13 +243,13 @@ public:
 	ExpressionEvaluator(
 		InterpreterState& _state,
 		Dialect const& _dialect,
-		Scope& _scope,
-		std::map<YulString, u256> const& _variables
+		ResolvedNames const& _names,
+		std::vector<u256> const& _variables
 	):
 		m_state(_state),
 		m_dialect(_dialect),
-		m_variables(_variables),
-		m_scope(_scope)
+		m_names(_names),
+		m_variables(_variables)
 	{}
 
 	void operator()(Literal const&) override;
@@ -219,9 +278,9 @@ private:
 
 	InterpreterState& m_state;
 	Dialect const& m_dialect;
-	/// Values of variables.
-	std::map<YulString, u256> const& m_variables;
-	Scope& m_scope;
+	ResolvedNames const& m_names;
+	/// Values of the variables in the frame of the current function.
+	std::vector<u256> const& m_variables;
 	/// Current value of the expression
 	std::vector<u256> m_values;
 	/// Current expression nesting level
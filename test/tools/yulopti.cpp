@@ -41,6 +41,7 @@
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/Timing.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <liblangutil/CharStreamProvider.h>
@@ -59,6 +60,7 @@
 #include <range/v3/view/transform.hpp>
 
 #include <cctype>
+#include <iomanip>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -181,10 +183,22 @@ public:
 	{
 		parse(_source);
 		disambiguate();
-		OptimiserSuite{m_context}.runSequence(_steps, *m_ast);
+		OptimiserSuite{m_context, OptimiserSuite::Debug::None, &m_stepTimings}.runSequence(_steps, *m_ast);
 		cout << AsmPrinter{m_dialect}(*m_ast) << endl;
 	}
 
+	void printStepStatistics() const
+	{
+		cerr << left << setw(32) << "Step" << right << setw(10) << "Runs" << setw(14) << "Time (us)";
+		cerr << setw(10) << "Changes" << setw(12) << "Size delta" << endl;
+		for (auto const& [step, entry]: m_stepTimings.entries())
+		{
+			cerr << left << setw(32) << step << right << setw(10) << entry.count;
+			cerr << setw(14) << chrono::duration_cast<chrono::microseconds>(entry.wallTime).count();
+			cerr << setw(10) << entry.changes << setw(12) << entry.sizeDelta << endl;
+		}
+	}
+
 	void runInteractive(string _source, bool _disambiguated = false)
 	{
 		bool disambiguated = _disambiguated;
@@ -225,7 +239,7 @@ public:
 						break;
 					}
 					default:
-						OptimiserSuite{m_context}.runSequence(
+						OptimiserSuite{m_context, OptimiserSuite::Debug::None, &m_stepTimings}.runSequence(
 							std::string_view(&option, 1),
 							*m_ast
 						);
@@ -247,12 +261,15 @@ private:
 	Dialect const& m_dialect{EVMDialect::strictAssemblyForEVMObjects(EVMVersion{})};
 	unique_ptr<AsmAnalysisInfo> m_analysisInfo;
 	set<YulString> const m_reservedIdentifiers = {};
+	TimingCollector m_stepTimings;
 	NameDispenser m_nameDispenser{m_dialect, m_reservedIdentifiers};
 	OptimiserStepContext m_context{
 		m_dialect,
 		m_nameDispenser,
 		m_reservedIdentifiers,
-		solidity::frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment
+		solidity::frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment,
+		1,
+		nullptr
 	};
 };
 
@@ -261,6 +278,8 @@ int main(int argc, char** argv)
 	try
 	{
 		bool nonInteractive = false;
+		bool stringStatistics = false;
+		bool stepStatistics = false;
 		po::options_description options(
 			R"(yulopti, yul optimizer exploration tool.
 	Usage: yulopti [Options] <file>
@@ -288,6 +307,17 @@ int main(int argc, char** argv)
 				po::bool_switch(&nonInteractive)->default_value(false),
 				"stop after executing the provided steps"
 			)
+			(
+				"string-stats",
+				po::bool_switch(&stringStatistics)->default_value(false),
+				"print the number and memory footprint of the interned identifiers before exiting"
+			)
+			(
+				"step-stats",
+				po::bool_switch(&stepStatistics)->default_value(false),
+				"print the number of runs, the time spent, the number of runs that changed the code "
+				"and the resulting change of the code size of each optimiser step before exiting"
+			)
 			("help,h", "Show this help screen.");
 
 		// All positional options should be interpreted as input files
@@ -345,6 +375,17 @@ int main(int argc, char** argv)
 		if (!nonInteractive)
 			yulOpti.runInteractive(input, disambiguated);
 
+		if (stepStatistics)
+			yulOpti.printStepStatistics();
+
+		if (stringStatistics)
+		{
+			YulStringRepository::Statistics statistics = YulStringRepository::instance().statistics();
+			cerr << "Interned strings: " << statistics.strings << endl;
+			cerr << "Characters: " << statistics.characters << endl;
+			cerr << "Bytes allocated: " << statistics.bytes << endl;
+		}
+
 		return 0;
 	}
 	catch (po::error const& _exception)
@@ -0,0 +1,215 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark measuring the throughput of the Yul parser on the optimized IR of Solidity contracts,
+ * with and without debug annotations in comments.
+ */
+
+#include <test/TestCaseReader.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libyul/Object.h>
+#include <libyul/ObjectParser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/Scanner.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+using namespace solidity::frontend::test;
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// Adds @a _path to @a _files if it is a Solidity file or all Solidity files below it if it is a directory.
+void collectFiles(fs::path const& _path, vector<fs::path>& _files)
+{
+	if (!fs::is_directory(_path))
+	{
+		_files.push_back(_path);
+		return;
+	}
+	for (auto const& entry: fs::recursive_directory_iterator(_path))
+		if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+			_files.push_back(entry.path());
+}
+
+/// @returns the optimized IR of all contracts in the test case at @a _path, annotated with the
+/// debug information given, or nothing if the test case cannot be compiled via IR.
+vector<string> optimizedIR(fs::path const& _path, DebugInfoSelection const& _debugInfo)
+{
+	TestCaseReader reader(_path.string());
+	if (!reader.sources().externalSources.empty())
+		return {};
+	if (reader.settings().count("compileViaYul") && reader.settings().at("compileViaYul") == "false")
+		return {};
+
+	CompilerStack compiler;
+	compiler.setSources(reader.sources().sources);
+	compiler.setViaIR(true);
+	compiler.setOptimiserSettings(OptimiserSettings::standard());
+	compiler.selectDebugInfo(_debugInfo);
+	try
+	{
+		if (!compiler.compile())
+			return {};
+	}
+	catch (util::Exception const&)
+	{
+		return {};
+	}
+
+	vector<string> result;
+	for (string const& contractName: compiler.contractNames())
+		if (!compiler.yulIROptimized(contractName).empty())
+			result.push_back(compiler.yulIROptimized(contractName));
+	return result;
+}
+
+/// @returns the throughput of the parser in MB/s on @a _irs, parsing each of them @a _repetitions times,
+/// or nullopt if one of them cannot be parsed.
+optional<double> parserThroughput(vector<string> const& _irs, size_t _repetitions, Dialect const& _dialect)
+{
+	size_t bytes = 0;
+	chrono::duration<double> total{0};
+	for (size_t i = 0; i < _repetitions; ++i)
+		for (string const& ir: _irs)
+		{
+			ErrorList errors;
+			langutil::ErrorReporter errorReporter(errors);
+			CharStream charStream(ir, "");
+			auto const start = chrono::steady_clock::now();
+			shared_ptr<Object> object = ObjectParser(errorReporter, _dialect).parse(make_shared<Scanner>(charStream), false);
+			total += chrono::steady_clock::now() - start;
+			if (!object || !errors.empty())
+				return nullopt;
+			bytes += ir.size();
+		}
+	return static_cast<double>(bytes) / max(total.count(), 1e-9) / 1e6;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(yulparserbench, benchmark for the Yul parser.
+Usage: yulparserbench [Options] path...
+Compiles all given semantic test files via IR, as well as all Solidity files in the
+given directories, and reports the throughput of parsing the optimized IR of their
+contracts with all debug annotations and without them. Test files that cannot be
+compiled via IR are skipped.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("repeat", po::value<size_t>()->default_value(10), "Number of times to process the input.")
+		("input-path", po::value<vector<string>>(), "input file or directory");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-path", -1);
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help") || !arguments.count("input-path"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<fs::path> files;
+	for (string const& path: arguments["input-path"].as<vector<string>>())
+	{
+		if (!fs::exists(path))
+		{
+			cerr << "File not found: " << path << endl;
+			return 1;
+		}
+		collectFiles(path, files);
+	}
+	size_t const repetitions = max<size_t>(arguments["repeat"].as<size_t>(), 1);
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(EVMVersion{});
+
+	cout << fixed << setprecision(1);
+	for (auto [debugInfo, name]: {
+		pair{DebugInfoSelection::All(), "all debug annotations"},
+		pair{DebugInfoSelection::None(), "no debug annotations"}
+	})
+	{
+		size_t skipped = 0;
+		size_t bytes = 0;
+		vector<string> irs;
+		for (fs::path const& file: files)
+		{
+			vector<string> fileIRs = optimizedIR(file, debugInfo);
+			if (fileIRs.empty())
+				++skipped;
+			for (string& ir: fileIRs)
+			{
+				bytes += ir.size();
+				irs.emplace_back(move(ir));
+			}
+		}
+
+		optional<double> throughput = parserThroughput(irs, repetitions, dialect);
+		if (!throughput)
+		{
+			cerr << "Could not parse the IR with " << name << "." << endl;
+			return 1;
+		}
+		cout <<
+			"Parser, " << name << ": " << *throughput << " MB/s on " << irs.size() << " objects of " <<
+			bytes << " bytes, " << skipped << " test files skipped" << endl;
+	}
+
+	return 0;
+}
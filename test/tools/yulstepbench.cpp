@@ -0,0 +1,389 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark of the Yul optimiser steps on generated code of increasing size, which estimates
+ * how the run time of each step grows with the size of its input.
+ */
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libyul/AST.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Suite.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/EVMVersion.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Shape of the generated code.
+struct CodeShape
+{
+	size_t functions = 0;
+	size_t depth = 0;
+	size_t expressionSize = 0;
+};
+
+/// Generates Yul code of the given shape. The code only depends on the shape, so that the
+/// results of different runs are comparable.
+class CodeGenerator
+{
+public:
+	explicit CodeGenerator(CodeShape const& _shape): m_shape(_shape) {}
+
+	string generate()
+	{
+		m_code << "{\n";
+		m_code << "\tlet s := 0\n";
+		for (size_t i = 0; i < m_shape.functions; ++i)
+			m_code << "\ts := add(s, f" << i << "(calldataload(" << 32 * i << ")))\n";
+		m_code << "\tsstore(0, s)\n";
+		for (size_t i = 0; i < m_shape.functions; ++i)
+		{
+			m_code << "\tfunction f" << i << "(a) -> r {\n";
+			body(0, {"a"}, "\t\t");
+			// Each function calls the previous one, which gives the inliner something to do.
+			if (i > 0)
+				m_code << "\t\tr := xor(r, f" << i - 1 << "(r))\n";
+			m_code << "\t}\n";
+		}
+		m_code << "}\n";
+		return m_code.str();
+	}
+
+private:
+	/// Generates the statements of nesting level @a _level, ending with one nested block
+	/// if the depth has not been reached yet.
+	void body(size_t _level, vector<string> _variables, string const& _indent)
+	{
+		string const variable = "v" + to_string(_level);
+		m_code << _indent << "let " << variable << " := " << expression(m_shape.expressionSize, _variables) << "\n";
+		_variables.push_back(variable);
+		m_code << _indent << "mstore(" << variable << ", " << expression(m_shape.expressionSize, _variables) << ")\n";
+		if (_level + 1 < m_shape.depth)
+		{
+			if (_level % 2 == 0)
+			{
+				m_code << _indent << "if lt(" << variable << ", 1000) {\n";
+				body(_level + 1, _variables, _indent + "\t");
+			}
+			else
+			{
+				string const counter = "i" + to_string(_level);
+				m_code << _indent << "for { let " << counter << " := 0 } lt(" << counter << ", a) { " <<
+					counter << " := add(" << counter << ", 1) } {\n";
+				vector<string> variables = _variables;
+				variables.push_back(counter);
+				body(_level + 1, move(variables), _indent + "\t");
+			}
+			m_code << _indent << "}\n";
+		}
+		m_code << _indent << "r := add(r, " << variable << ")\n";
+	}
+
+	/// @returns an expression with @a _size operations on @a _variables and literals.
+	string expression(size_t _size, vector<string> const& _variables)
+	{
+		static vector<string> const operations{"add", "mul", "sub", "xor", "and", "or", "div", "shl"};
+		size_t const index = m_counter++;
+		if (_size == 0)
+			return index % 3 == 2 ? to_string(index) : _variables[index % _variables.size()];
+		size_t const leftSize = (_size - 1) / 2;
+		string const left = expression(leftSize, _variables);
+		string const right = expression(_size - 1 - leftSize, _variables);
+		return operations[index % operations.size()] + "(" + left + ", " + right + ")";
+	}
+
+	CodeShape m_shape;
+	ostringstream m_code;
+	size_t m_counter = 0;
+};
+
+shared_ptr<Object> parse(string const& _source)
+{
+	AssemblyStack stack(
+		EVMVersion{},
+		AssemblyStack::Language::StrictAssembly,
+		OptimiserSettings::none(),
+		DebugInfoSelection::Default()
+	);
+	if (!stack.parseAndAnalyze("", _source))
+	{
+		cerr << "Could not analyze the generated code:" << endl << _source << endl;
+		exit(1);
+	}
+	return stack.parserResult();
+}
+
+/// @returns the code of @a _object in the form the optimiser suite establishes before running
+/// the steps of the sequence.
+Block prepare(Object const& _object, Dialect const& _dialect, set<YulString> const& _reservedIdentifiers)
+{
+	Block ast = std::get<Block>(Disambiguator(_dialect, *_object.analysisInfo, _reservedIdentifiers)(*_object.code));
+	NameDispenser dispenser{_dialect, ast, _reservedIdentifiers};
+	OptimiserStepContext context{_dialect, dispenser, _reservedIdentifiers, 200};
+	OptimiserSuite(context).runSequence("hgfo", ast);
+	return ast;
+}
+
+/// @returns the shortest time of @a _repetitions runs of @a _job in milliseconds, where @a _job
+/// returns the time measured by itself.
+double fastest(size_t _repetitions, function<chrono::steady_clock::duration()> const& _job)
+{
+	optional<chrono::steady_clock::duration> result;
+	for (size_t i = 0; i < _repetitions; ++i)
+	{
+		chrono::steady_clock::duration const time = _job();
+		if (!result || time < *result)
+			result = time;
+	}
+	return chrono::duration<double, milli>(*result).count();
+}
+
+/// @returns the exponent k of the best fit of time = c * size^k.
+double scalingExponent(vector<double> const& _sizes, vector<double> const& _times)
+{
+	size_t const count = _sizes.size();
+	if (count < 2)
+		return 0;
+	double sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		double const x = log(_sizes[i]);
+		double const y = log(max(_times[i], 1e-6));
+		sumX += x;
+		sumY += y;
+		sumXX += x * x;
+		sumXY += x * y;
+	}
+	double const n = static_cast<double>(count);
+	double const denominator = n * sumXX - sumX * sumX;
+	return denominator == 0 ? 0 : (n * sumXY - sumX * sumY) / denominator;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(yulstepbench, benchmark for the Yul optimiser steps.
+Usage: yulstepbench [Options]
+Generates Yul code with the given number of functions, nesting depth of the control flow
+and size of the expressions, scales one of them by the given factors, and reports the
+time each optimiser step and the default optimiser sequence take on the code. The exponent
+is the estimated growth of the time with the size of the code, i.e. 1 for linear and
+2 for quadratic run time.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("functions", po::value<size_t>()->default_value(16), "Number of functions in the generated code.")
+		("depth", po::value<size_t>()->default_value(4), "Nesting depth of the control flow inside the functions.")
+		("expression-size", po::value<size_t>()->default_value(8), "Number of operations in each expression.")
+		("scale", po::value<string>()->default_value("functions"), "Which of functions, depth and expression-size to scale.")
+		("factors", po::value<string>()->default_value("1,2,4,8"), "Comma-separated factors by which to scale.")
+		(
+			"steps",
+			po::value<string>(),
+			"Comma-separated names of the steps to run, where \"sequence\" is the default optimiser "
+			"sequence. All steps and the sequence by default."
+		)
+		("repeat", po::value<size_t>()->default_value(5), "Number of runs per step and size, of which the fastest is reported.")
+		("max-exponent", po::value<double>(), "Fail if the exponent of any step is larger than the given value.");
+
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options);
+		po::store(cmdLineParser.run(), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	CodeShape const baseShape{
+		arguments["functions"].as<size_t>(),
+		arguments["depth"].as<size_t>(),
+		arguments["expression-size"].as<size_t>()
+	};
+	string const scaled = arguments["scale"].as<string>();
+	if (scaled != "functions" && scaled != "depth" && scaled != "expression-size")
+	{
+		cerr << "Invalid value for --scale: " << scaled << endl;
+		return 1;
+	}
+
+	vector<string> factorStrings;
+	boost::split(factorStrings, arguments["factors"].as<string>(), boost::is_any_of(","));
+	vector<size_t> factors;
+	for (string const& factor: factorStrings)
+		try
+		{
+			factors.push_back(stoul(factor));
+		}
+		catch (logic_error const&)
+		{
+			cerr << "Invalid factor: " << factor << endl;
+			return 1;
+		}
+
+	vector<string> steps;
+	if (arguments.count("steps"))
+		boost::split(steps, arguments["steps"].as<string>(), boost::is_any_of(","));
+	else
+	{
+		for (auto const& [name, step]: OptimiserSuite::allSteps())
+			if (!step->invalidInCurrentEnvironment())
+				steps.push_back(name);
+		steps.emplace_back("sequence");
+	}
+	for (string const& step: steps)
+		if (step != "sequence" && !OptimiserSuite::allSteps().count(step))
+		{
+			cerr << "Unknown optimiser step: " << step << endl;
+			return 1;
+		}
+
+	size_t const repetitions = max<size_t>(arguments["repeat"].as<size_t>(), 1);
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(EVMVersion{});
+	GasMeter const meter(dialect, false, 200);
+	set<YulString> const reservedIdentifiers = dialect.fixedFunctionNames();
+
+	vector<string> sources;
+	vector<Block> preparedCode;
+	vector<double> codeSizes;
+	for (size_t factor: factors)
+	{
+		CodeShape shape = baseShape;
+		if (scaled == "functions")
+			shape.functions *= factor;
+		else if (scaled == "depth")
+			shape.depth *= factor;
+		else
+			shape.expressionSize *= factor;
+		sources.push_back(CodeGenerator(shape).generate());
+		preparedCode.push_back(prepare(*parse(sources.back()), dialect, reservedIdentifiers));
+		codeSizes.push_back(static_cast<double>(CodeSize::codeSizeIncludingFunctions(preparedCode.back())));
+	}
+
+	cout << fixed << setprecision(3);
+	cout << left << setw(36) << "Scaling " + scaled + " by" << right;
+	for (size_t factor: factors)
+		cout << setw(12) << to_string(factor) + "x";
+	cout << endl;
+	cout << left << setw(36) << "Code size" << right;
+	for (double size: codeSizes)
+		cout << setw(12) << static_cast<size_t>(size);
+	cout << endl;
+	cout << left << setw(36) << "Time in ms" << right << endl;
+
+	optional<double> const maxExponent = arguments.count("max-exponent") ?
+		optional<double>(arguments["max-exponent"].as<double>()) :
+		nullopt;
+	bool exceeded = false;
+	for (string const& stepName: steps)
+	{
+		vector<double> times;
+		for (size_t i = 0; i < factors.size(); ++i)
+			if (stepName == "sequence")
+				times.push_back(fastest(repetitions, [&]() {
+					shared_ptr<Object> object = parse(sources[i]);
+					auto const start = chrono::steady_clock::now();
+					OptimiserSuite::run(
+						dialect,
+						&meter,
+						*object,
+						true,
+						OptimiserSettings::DefaultYulOptimiserSteps,
+						200
+					);
+					return chrono::steady_clock::now() - start;
+				}));
+			else
+			{
+				OptimiserStep const& step = *OptimiserSuite::allSteps().at(stepName);
+				times.push_back(fastest(repetitions, [&]() {
+					Block ast = std::get<Block>(ASTCopier{}(preparedCode[i]));
+					NameDispenser dispenser{dialect, ast, reservedIdentifiers};
+					OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, 200};
+					auto const start = chrono::steady_clock::now();
+					step.run(context, ast);
+					return chrono::steady_clock::now() - start;
+				}));
+			}
+
+		double const exponent = scalingExponent(codeSizes, times);
+		cout << left << setw(36) << stepName << right;
+		for (double time: times)
+			cout << setw(12) << time;
+		cout << "   exponent " << setprecision(2) << exponent << setprecision(3);
+		if (maxExponent && exponent > *maxExponent)
+		{
+			cout << " (too large)";
+			exceeded = true;
+		}
+		cout << endl;
+	}
+
+	return exceeded ? 2 : 0;
+}
@@ -326,6 +326,7 @@ BOOST_FIXTURE_TEST_CASE(run_should_print_cache_stats_if_requested, AlgorithmRunn
 		BOOST_TEST(nextLineMatches(m_output, regex(R"(Totalhits:\d+)")));
 		BOOST_TEST(nextLineMatches(m_output, regex(R"(Totalmisses:\d+)")));
 		BOOST_TEST(nextLineMatches(m_output, regex(R"(Sizeofcachedcode:\d+)")));
+		BOOST_TEST(nextLineMatches(m_output, regex(R"(Evictedentries:\d+)")));
 	}
 
 	BOOST_REQUIRE(stats.roundEntryCounts.size() == 2);
@@ -340,6 +341,7 @@ BOOST_FIXTURE_TEST_CASE(run_should_print_cache_stats_if_requested, AlgorithmRunn
 	BOOST_TEST(nextLineMatches(m_output, regex("Totalhits:" + toString(stats.hits))));
 	BOOST_TEST(nextLineMatches(m_output, regex("Totalmisses:" + toString(stats.misses))));
 	BOOST_TEST(nextLineMatches(m_output, regex("Sizeofcachedcode:" + toString(stats.totalCodeSize))));
+	BOOST_TEST(nextLineMatches(m_output, regex("Evictedentries:" + toString(stats.evictions))));
 	BOOST_TEST(m_output.peek() == EOF);
 }
 
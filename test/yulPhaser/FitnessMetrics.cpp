@@ -18,6 +18,8 @@
 
 #include <tools/yulPhaser/FitnessMetrics.h>
 
+#include <libevmasm/Assembly.h>
+
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
 #include <libyul/optimiser/UnusedPruner.h>
 
@@ -238,6 +240,59 @@ BOOST_FIXTURE_TEST_CASE(evaluate_should_multiply_the_result_by_scaling_factor, P
 	BOOST_TEST(RelativeProgramSize(m_program, nullptr, 4, m_weights).evaluate(m_chromosome) == round(10000.0 * sizeRatio));
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(BytecodeSizeTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_compute_bytecode_size_of_the_optimised_program, ProgramBasedMetricFixture)
+{
+	size_t fitness = BytecodeSize(m_program, nullptr, m_weights).evaluate(m_chromosome);
+
+	BOOST_TEST(fitness == m_optimisedProgram.assemble()->assemble().bytecode.size());
+	BOOST_TEST(fitness < m_program.assemble()->assemble().bytecode.size());
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_be_able_to_use_program_cache_if_available, ProgramBasedMetricFixture)
+{
+	size_t fitness = BytecodeSize(nullopt, m_programCache, m_weights).evaluate(m_chromosome);
+
+	BOOST_TEST(fitness == m_optimisedProgram.assemble()->assemble().bytecode.size());
+	BOOST_TEST(m_programCache->size() == m_chromosome.length());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(GasCostTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_be_lower_for_the_optimised_program, ProgramBasedMetricFixture)
+{
+	Chromosome emptyChromosome("");
+
+	BOOST_TEST(
+		GasCost(m_program, nullptr, 200, m_weights).evaluate(m_chromosome) <
+		GasCost(m_program, nullptr, 200, m_weights).evaluate(emptyChromosome)
+	);
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_weigh_execution_cost_by_expected_executions, ProgramBasedMetricFixture)
+{
+	size_t deploymentOnly = GasCost(m_program, nullptr, 0, m_weights).evaluate(m_chromosome);
+	size_t oneExecution = GasCost(m_program, nullptr, 1, m_weights).evaluate(m_chromosome);
+	size_t tenExecutions = GasCost(m_program, nullptr, 10, m_weights).evaluate(m_chromosome);
+
+	BOOST_TEST(deploymentOnly == 200 * m_optimisedProgram.assemble()->assemble().bytecode.size());
+	BOOST_TEST(oneExecution > deploymentOnly);
+	BOOST_TEST(tenExecutions - deploymentOnly == 10 * (oneExecution - deploymentOnly));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(OptimisationTimeTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_not_use_program_cache, ProgramBasedMetricFixture)
+{
+	OptimisationTime(nullopt, m_programCache, m_weights).evaluate(m_chromosome);
+
+	BOOST_TEST(m_programCache->size() == 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(FitnessMetricCombinationTest)
 
@@ -259,6 +314,15 @@ BOOST_FIXTURE_TEST_CASE(FitnessMetricSum_evaluate_should_compute_sum_of_values_r
 	BOOST_TEST(metric.metrics() == m_simpleMetrics);
 }
 
+BOOST_FIXTURE_TEST_CASE(FitnessMetricWeightedSum_evaluate_should_compute_weighted_sum_of_values_returned_by_metrics_passed_to_it, FitnessMetricCombinationFixture)
+{
+	FitnessMetricWeightedSum metric(m_simpleMetrics, {1, 0, 5});
+
+	assert(m_simpleMetrics.size() == 3);
+	BOOST_TEST(metric.evaluate(m_chromosome) == m_fitness[0] + 5 * m_fitness[2]);
+	BOOST_TEST(metric.metrics() == m_simpleMetrics);
+}
+
 BOOST_FIXTURE_TEST_CASE(FitnessMetricMaximum_evaluate_should_compute_maximum_of_values_returned_by_metrics_passed_to_it, FitnessMetricCombinationFixture)
 {
 	FitnessMetricMaximum metric(m_simpleMetrics);
@@ -277,6 +341,29 @@ BOOST_FIXTURE_TEST_CASE(FitnessMetricMinimum_evaluate_should_compute_minimum_of_
 	BOOST_TEST(metric.metrics() == m_simpleMetrics);
 }
 
+BOOST_FIXTURE_TEST_CASE(evaluateAll_should_return_the_same_values_regardless_of_the_number_of_threads, ProgramBasedMetricFixture)
+{
+	vector<Chromosome> chromosomes = {
+		m_chromosome,
+		Chromosome(vector<string>{UnusedPruner::name}),
+		Chromosome(vector<string>{EquivalentFunctionCombiner::name}),
+		Chromosome(vector<string>{EquivalentFunctionCombiner::name, UnusedPruner::name}),
+		Chromosome(""),
+	};
+	FitnessMetricSum metric({
+		make_shared<ProgramSize>(m_program, nullptr, m_weights),
+		make_shared<RelativeProgramSize>(nullopt, m_programCache, 3, m_weights),
+	});
+
+	vector<size_t> expectedFitness;
+	for (Chromosome const& chromosome: chromosomes)
+		expectedFitness.push_back(metric.evaluate(chromosome));
+
+	metric.setParallelism(4);
+	for (size_t round = 0; round < 10; ++round)
+		BOOST_TEST(metric.evaluateAll(chromosomes) == expectedFitness);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
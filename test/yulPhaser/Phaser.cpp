@@ -85,10 +85,13 @@ class FitnessMetricFactoryFixture: public FixtureWithPrograms
 {
 protected:
 	FitnessMetricFactory::Options m_options = {
-		/* metric = */ MetricChoice::CodeSize,
+		/* metrics = */ {MetricChoice::CodeSize},
+		/* metricWeights = */ {},
 		/* metricAggregator = */ MetricAggregatorChoice::Average,
 		/* relativeMetricScale = */ 5,
+		/* expectedExecutions = */ 200,
 		/* chromosomeRepetitions = */ 1,
+		/* threads = */ 1,
 	};
 	CodeWeights const m_weights{};
 };
@@ -186,7 +189,7 @@ BOOST_AUTO_TEST_SUITE(FitnessMetricFactoryTest)
 
 BOOST_FIXTURE_TEST_CASE(build_should_create_metric_of_the_right_type, FitnessMetricFactoryFixture)
 {
-	m_options.metric = MetricChoice::RelativeCodeSize;
+	m_options.metrics = {MetricChoice::RelativeCodeSize};
 	m_options.metricAggregator = MetricAggregatorChoice::Sum;
 	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
 	BOOST_REQUIRE(metric != nullptr);
@@ -203,7 +206,7 @@ BOOST_FIXTURE_TEST_CASE(build_should_create_metric_of_the_right_type, FitnessMet
 
 BOOST_FIXTURE_TEST_CASE(build_should_respect_chromosome_repetitions_option, FitnessMetricFactoryFixture)
 {
-	m_options.metric = MetricChoice::CodeSize;
+	m_options.metrics = {MetricChoice::CodeSize};
 	m_options.metricAggregator = MetricAggregatorChoice::Average;
 	m_options.chromosomeRepetitions = 5;
 	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
@@ -219,9 +222,17 @@ BOOST_FIXTURE_TEST_CASE(build_should_respect_chromosome_repetitions_option, Fitn
 	BOOST_TEST(programSizeMetric->repetitionCount() == m_options.chromosomeRepetitions);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_respect_threads_option, FitnessMetricFactoryFixture)
+{
+	m_options.threads = 4;
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+	BOOST_TEST(metric->parallelism() == m_options.threads);
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_set_relative_metric_scale, FitnessMetricFactoryFixture)
 {
-	m_options.metric = MetricChoice::RelativeCodeSize;
+	m_options.metrics = {MetricChoice::RelativeCodeSize};
 	m_options.metricAggregator = MetricAggregatorChoice::Average;
 	m_options.relativeMetricScale = 10;
 	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
@@ -237,6 +248,36 @@ BOOST_FIXTURE_TEST_CASE(build_should_set_relative_metric_scale, FitnessMetricFac
 	BOOST_TEST(relativeProgramSizeMetric->fixedPointPrecision() == m_options.relativeMetricScale);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_combine_multiple_metrics_with_weights, FitnessMetricFactoryFixture)
+{
+	m_options.metrics = {MetricChoice::BytecodeSize, MetricChoice::GasCost};
+	m_options.metricWeights = {3, 1};
+	m_options.expectedExecutions = 10;
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+
+	auto averageMetric = dynamic_cast<FitnessMetricAverage*>(metric.get());
+	BOOST_REQUIRE(averageMetric != nullptr);
+	BOOST_REQUIRE(averageMetric->metrics().size() == 1);
+
+	auto weightedSumMetric = dynamic_cast<FitnessMetricWeightedSum*>(averageMetric->metrics()[0].get());
+	BOOST_REQUIRE(weightedSumMetric != nullptr);
+	BOOST_TEST(weightedSumMetric->weights() == m_options.metricWeights);
+	BOOST_REQUIRE(weightedSumMetric->metrics().size() == 2);
+	BOOST_TEST(dynamic_cast<BytecodeSize*>(weightedSumMetric->metrics()[0].get()) != nullptr);
+
+	auto gasCostMetric = dynamic_cast<GasCost*>(weightedSumMetric->metrics()[1].get());
+	BOOST_REQUIRE(gasCostMetric != nullptr);
+	BOOST_TEST(gasCostMetric->expectedExecutions() == m_options.expectedExecutions);
+}
+
+BOOST_FIXTURE_TEST_CASE(build_should_reject_wrong_number_of_metric_weights, FitnessMetricFactoryFixture)
+{
+	m_options.metrics = {MetricChoice::BytecodeSize, MetricChoice::GasCost};
+	m_options.metricWeights = {1};
+	BOOST_CHECK_THROW(FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights), InvalidMetricWeights);
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_create_metric_for_each_input_program, FitnessMetricFactoryFixture)
 {
 	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(
@@ -261,7 +302,7 @@ BOOST_FIXTURE_TEST_CASE(build_should_pass_program_caches_to_metrics, FitnessMetr
 		make_shared<ProgramCache>(m_programs[2]),
 	};
 
-	m_options.metric = MetricChoice::RelativeCodeSize;
+	m_options.metrics = {MetricChoice::RelativeCodeSize};
 	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, m_programs, caches, m_weights);
 	BOOST_REQUIRE(metric != nullptr);
 
@@ -387,7 +428,7 @@ BOOST_AUTO_TEST_SUITE(ProgramCacheFactoryTest)
 
 BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cache_enabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true};
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true, /* maxCachedCodeSize = */ 1000};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
@@ -396,12 +437,13 @@ BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cach
 	{
 		BOOST_REQUIRE(caches[i] != nullptr);
 		BOOST_TEST(toString(caches[i]->program()) == toString(m_programs[i]));
+		BOOST_CHECK(caches[i]->maxTotalCodeSize() == 1000);
 	}
 }
 
 BOOST_FIXTURE_TEST_CASE(build_should_return_nullptr_for_each_input_program_if_cache_disabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false};
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false, /* maxCachedCodeSize = */ nullopt};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
@@ -59,11 +59,7 @@ protected:
 
 	static set<string> cachedKeys(ProgramCache const& _programCache)
 	{
-		 set<string> keys;
-		for (auto pair = _programCache.entries().begin(); pair != _programCache.entries().end(); ++pair)
-			keys.insert(pair->first);
-
-		return keys;
+		return _programCache.prefixes();
 	}
 
 	CharStream m_sourceStream = CharStream(SampleSourceCode, "program-cache-test");
@@ -76,9 +72,9 @@ BOOST_AUTO_TEST_SUITE(ProgramCacheTest)
 
 BOOST_AUTO_TEST_CASE(CacheStats_operator_plus_should_add_stats_together)
 {
-	CacheStats statsA{11, 12, 13, {{1, 14}, {2, 15}}};
-	CacheStats statsB{21, 22, 23, {{2, 24}, {3, 25}}};
-	CacheStats statsC{32, 34, 36, {{1, 14}, {2, 39}, {3, 25}}};
+	CacheStats statsA{11, 12, 13, {{1, 14}, {2, 15}}, 16};
+	CacheStats statsB{21, 22, 23, {{2, 24}, {3, 25}}, 26};
+	CacheStats statsC{32, 34, 36, {{1, 14}, {2, 39}, {3, 25}}, 42};
 
 	BOOST_CHECK(statsA + statsB == statsC);
 }
@@ -149,18 +145,18 @@ BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_reuse_the_longest_prefix_and_move
 
 	BOOST_TEST(m_programCache.currentRound() == 1);
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"I", "Iu", "Ia"}));
-	BOOST_TEST(m_programCache.entries().find("I")->second.roundNumber == 0);
-	BOOST_TEST(m_programCache.entries().find("Iu")->second.roundNumber == 0);
-	BOOST_TEST(m_programCache.entries().find("Ia")->second.roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("I")->roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("Iu")->roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("Ia")->roundNumber == 0);
 
 	m_programCache.optimiseProgram("IuOI");
 
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"I", "Iu", "Ia", "IuO", "IuOI"}));
-	BOOST_TEST(m_programCache.entries().find("I")->second.roundNumber == 1);
-	BOOST_TEST(m_programCache.entries().find("Iu")->second.roundNumber == 1);
-	BOOST_TEST(m_programCache.entries().find("Ia")->second.roundNumber == 0);
-	BOOST_TEST(m_programCache.entries().find("IuO")->second.roundNumber == 1);
-	BOOST_TEST(m_programCache.entries().find("IuOI")->second.roundNumber == 1);
+	BOOST_TEST(m_programCache.entry("I")->roundNumber == 1);
+	BOOST_TEST(m_programCache.entry("Iu")->roundNumber == 1);
+	BOOST_TEST(m_programCache.entry("Ia")->roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("IuO")->roundNumber == 1);
+	BOOST_TEST(m_programCache.entry("IuOI")->roundNumber == 1);
 }
 
 BOOST_FIXTURE_TEST_CASE(startRound_should_remove_entries_older_than_two_rounds, ProgramCacheFixture)
@@ -172,40 +168,40 @@ BOOST_FIXTURE_TEST_CASE(startRound_should_remove_entries_older_than_two_rounds,
 
 	BOOST_TEST(m_programCache.currentRound() == 0);
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"I", "Iu"}));
-	BOOST_TEST(m_programCache.entries().find("I")->second.roundNumber == 0);
-	BOOST_TEST(m_programCache.entries().find("Iu")->second.roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("I")->roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("Iu")->roundNumber == 0);
 
 	m_programCache.optimiseProgram("a");
 
 	BOOST_TEST(m_programCache.currentRound() == 0);
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"I", "Iu", "a"}));
-	BOOST_TEST(m_programCache.entries().find("I")->second.roundNumber == 0);
-	BOOST_TEST(m_programCache.entries().find("Iu")->second.roundNumber == 0);
-	BOOST_TEST(m_programCache.entries().find("a")->second.roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("I")->roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("Iu")->roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("a")->roundNumber == 0);
 
 	m_programCache.startRound(1);
 
 	BOOST_TEST(m_programCache.currentRound() == 1);
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"I", "Iu", "a"}));
-	BOOST_TEST(m_programCache.entries().find("I")->second.roundNumber == 0);
-	BOOST_TEST(m_programCache.entries().find("Iu")->second.roundNumber == 0);
-	BOOST_TEST(m_programCache.entries().find("a")->second.roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("I")->roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("Iu")->roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("a")->roundNumber == 0);
 
 	m_programCache.optimiseProgram("af");
 
 	BOOST_TEST(m_programCache.currentRound() == 1);
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"I", "Iu", "a", "af"}));
-	BOOST_TEST(m_programCache.entries().find("I")->second.roundNumber == 0);
-	BOOST_TEST(m_programCache.entries().find("Iu")->second.roundNumber == 0);
-	BOOST_TEST(m_programCache.entries().find("a")->second.roundNumber == 1);
-	BOOST_TEST(m_programCache.entries().find("af")->second.roundNumber == 1);
+	BOOST_TEST(m_programCache.entry("I")->roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("Iu")->roundNumber == 0);
+	BOOST_TEST(m_programCache.entry("a")->roundNumber == 1);
+	BOOST_TEST(m_programCache.entry("af")->roundNumber == 1);
 
 	m_programCache.startRound(2);
 
 	BOOST_TEST(m_programCache.currentRound() == 2);
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"a", "af"}));
-	BOOST_TEST(m_programCache.entries().find("a")->second.roundNumber == 1);
-	BOOST_TEST(m_programCache.entries().find("af")->second.roundNumber == 1);
+	BOOST_TEST(m_programCache.entry("a")->roundNumber == 1);
+	BOOST_TEST(m_programCache.entry("af")->roundNumber == 1);
 
 	m_programCache.startRound(3);
 
@@ -224,12 +220,12 @@ BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCache
 	m_programCache.optimiseProgram("L");
 	m_programCache.optimiseProgram("Iu");
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"L", "I", "Iu"}));
-	CacheStats expectedStats1{0, 3, sizeL + sizeI + sizeIu, {{0, 3}}};
+	CacheStats expectedStats1{0, 3, sizeL + sizeI + sizeIu, {{0, 3}}, 0};
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats1);
 
 	m_programCache.optimiseProgram("IuO");
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"L", "I", "Iu", "IuO"}));
-	CacheStats expectedStats2{2, 4, sizeL + sizeI + sizeIu + sizeIuO, {{0, 4}}};
+	CacheStats expectedStats2{2, 4, sizeL + sizeI + sizeIu + sizeIuO, {{0, 4}}, 0};
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats2);
 
 	m_programCache.startRound(1);
@@ -238,20 +234,56 @@ BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCache
 
 	m_programCache.optimiseProgram("IuO");
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"L", "I", "Iu", "IuO"}));
-	CacheStats expectedStats3{5, 4, sizeL + sizeI + sizeIu + sizeIuO, {{0, 1}, {1, 3}}};
+	CacheStats expectedStats3{5, 4, sizeL + sizeI + sizeIu + sizeIuO, {{0, 1}, {1, 3}}, 0};
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats3);
 
 	m_programCache.startRound(2);
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"I", "Iu", "IuO"}));
-	CacheStats expectedStats4{5, 4, sizeI + sizeIu + sizeIuO, {{1, 3}}};
+	CacheStats expectedStats4{5, 4, sizeI + sizeIu + sizeIuO, {{1, 3}}, 0};
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats4);
 
 	m_programCache.optimiseProgram("LT");
 	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"L", "LT", "I", "Iu", "IuO"}));
-	CacheStats expectedStats5{5, 6, sizeL + sizeLT + sizeI + sizeIu + sizeIuO, {{1, 3}, {2, 2}}};
+	CacheStats expectedStats5{5, 6, sizeL + sizeLT + sizeI + sizeIu + sizeIuO, {{1, 3}, {2, 2}}, 0};
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats5);
 }
 
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_evict_least_recently_used_entries_above_size_limit, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	size_t sizeL = optimisedProgram(m_program, "L").codeSize(CacheStats::StorageWeights);
+	ProgramCache programCache(m_program, sizeI + sizeIu + sizeL - 1);
+
+	programCache.optimiseProgram("Iu");
+	BOOST_REQUIRE((cachedKeys(programCache) == set<string>{"I", "Iu"}));
+	BOOST_TEST(programCache.gatherStats().evictions == 0);
+
+	// "I" is shared by more chromosomes than "Iu" so it counts as used later.
+	programCache.optimiseProgram("L");
+	BOOST_REQUIRE((cachedKeys(programCache) == set<string>{"I", "L"}));
+	CacheStats expectedStats{0, 3, sizeI + sizeL, {{0, 2}}, 1};
+	BOOST_CHECK(programCache.gatherStats() == expectedStats);
+
+	Program cachedProgram = programCache.optimiseProgram("Iu");
+	BOOST_TEST(toString(cachedProgram) == toString(optimisedProgram(m_program, "Iu")));
+	BOOST_TEST(programCache.gatherStats().hits == 1);
+	BOOST_REQUIRE((cachedKeys(programCache) == set<string>{"I", "Iu"}));
+	BOOST_TEST(programCache.gatherStats().evictions == 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_not_cache_anything_if_limit_is_zero, ProgramCacheFixture)
+{
+	ProgramCache programCache(m_program, 0);
+
+	Program cachedProgram = programCache.optimiseProgram("IuO");
+
+	BOOST_TEST(toString(cachedProgram) == toString(optimisedProgram(m_program, "IuO")));
+	BOOST_TEST(programCache.size() == 0);
+	BOOST_TEST(programCache.gatherStats().totalCodeSize == 0);
+	BOOST_TEST(programCache.gatherStats().evictions == 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -22,10 +22,17 @@
 
 #include <libsolidity/ast/AST.h>
 
+#include <libsolutil/Parallel.h>
+
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <range/v3/view/map.hpp>
+#include <range/v3/view/reverse.hpp>
+
+#include <thread>
+
 #ifdef _WIN32 // windows
 	#include <io.h>
 	#define isatty _isatty
@@ -55,6 +62,7 @@ static string const g_argUnsafe = "unsafe";
 static string const g_argVerbose = "verbose";
 static string const g_argIgnoreMissingFiles = "ignore-missing";
 static string const g_argAllowPaths = "allow-paths";
+static string const g_argJobs = "jobs";
 
 namespace
 {
@@ -133,6 +141,12 @@ Allowed options)",
 			"Only activate a specific upgrade module. A list of "
 			"modules can be supplied by separating them with a comma."
 		)
+		(
+			g_argJobs.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Use up to n threads to analyse the sources and to search them for upgrades in parallel. "
+			"Defaults to the number of hardware threads. The upgrades do not depend on this setting."
+		)
 		(g_argDryRun.c_str(), "Apply changes in-memory only and don't write to input file.")
 		(g_argVerbose.c_str(), "Print logs, errors and changes. Shortens output of upgrade patches.")
 		(g_argUnsafe.c_str(), "Accept *unsafe* changes.");
@@ -209,6 +223,18 @@ Allowed options)",
 		}
 	}
 
+	m_jobs = max<size_t>(thread::hardware_concurrency(), 1);
+	if (m_args.count(g_argJobs))
+	{
+		unsigned jobs = m_args[g_argJobs].as<unsigned>();
+		if (jobs == 0)
+		{
+			error() << "Option --" << g_argJobs << " must be a positive integer." << endl;
+			return false;
+		}
+		m_jobs = jobs;
+	}
+
 	/// TODO Share with solc commandline interface.
 	if (m_args.count(g_argAllowPaths))
 	{
@@ -317,81 +343,128 @@ void SourceUpgrade::tryCompile() const
 }
 
 void SourceUpgrade::runUpgrade()
-{
-	bool recompile = true;
-
-	while (recompile && !m_compiler->errors().empty())
-	{
-		for (auto& sourceCode: m_sourceCodes)
-		{
-			recompile = analyzeAndUpgrade(sourceCode);
-			if (recompile)
-				break;
-		}
-
-		if (recompile)
-		{
-			m_suite.reset();
-			resetCompiler();
-			tryCompile();
-		}
-	}
-}
-
-bool SourceUpgrade::analyzeAndUpgrade(pair<string, string> const& _sourceCode)
 {
 	bool applyUnsafe = m_args.count(g_argUnsafe);
 	bool verbose = m_args.count(g_argVerbose);
 
-	if (verbose)
-		log() << "Analyzing and upgrading " << _sourceCode.first << "." << endl;
-
-	if (m_compiler->state() >= CompilerStack::State::AnalysisPerformed)
-		m_suite.analyze(*m_compiler, m_compiler->ast(_sourceCode.first));
-
-	if (!m_suite.changes().empty())
+	/// Changes found in the latest analysis of each source that were not applied.
+	map<string, vector<UpgradeChange>> remainingChanges;
+	set<string> sourcesToAnalyze;
+	for (string const& sourceName: m_compiler->sourceNames())
+		sourcesToAnalyze.insert(sourceName);
+
+	while (
+		!sourcesToAnalyze.empty() &&
+		!m_compiler->errors().empty() &&
+		m_compiler->state() >= CompilerStack::State::AnalysisPerformed
+	)
 	{
-		auto& change = m_suite.changes().front();
+		vector<string> sourceNames(sourcesToAnalyze.begin(), sourcesToAnalyze.end());
+		vector<vector<UpgradeChange>> changes(sourceNames.size());
+		parallelFor(sourceNames.size(), m_jobs, [&](size_t _index) {
+			changes[_index] = analyze(sourceNames[_index]);
+		});
+
+		set<string> changedSources;
+		for (size_t i = 0; i < sourceNames.size(); ++i)
+		{
+			if (verbose)
+				log() << "Analyzing and upgrading " << sourceNames[i] << "." << endl;
 
-		if (verbose)
-			change.log(*m_compiler, true);
+			stable_sort(changes[i].begin(), changes[i].end(), [](UpgradeChange const& _a, UpgradeChange const& _b) {
+				return _a.location().start < _b.location().start;
+			});
 
-		if (change.level() == UpgradeChange::Level::Safe)
-		{
-			applyChange(_sourceCode, change);
-			return true;
-		}
-		else if (change.level() == UpgradeChange::Level::Unsafe)
-		{
-			if (applyUnsafe)
+			vector<UpgradeChange> applicable;
+			vector<UpgradeChange>& remaining = remainingChanges[sourceNames[i]];
+			remaining.clear();
+			for (UpgradeChange& change: changes[i])
+			{
+				if (verbose)
+					change.log(*m_compiler, true);
+
+				bool overlaps = !applicable.empty() && (
+					change.location().start < applicable.back().location().end ||
+					change.location().start == applicable.back().location().start
+				);
+				if (!overlaps && (change.level() == UpgradeChange::Level::Safe || applyUnsafe))
+					applicable.emplace_back(move(change));
+				else
+					remaining.emplace_back(move(change));
+			}
+
+			if (!applicable.empty())
 			{
-				applyChange(_sourceCode, change);
-				return true;
+				applyChanges(sourceNames[i], applicable);
+				changedSources.insert(sourceNames[i]);
 			}
 		}
+
+		if (changedSources.empty())
+			break;
+
+		resetCompiler();
+		tryCompile();
+		if (m_compiler->state() >= CompilerStack::State::AnalysisPerformed)
+			sourcesToAnalyze = sourcesDependingOn(changedSources);
 	}
 
-	return false;
+	m_suite.reset();
+	for (auto& changes: remainingChanges | ranges::views::values)
+		for (UpgradeChange& change: changes)
+			m_suite.changes().emplace_back(move(change));
 }
 
-void SourceUpgrade::applyChange(
-	pair<string, string> const& _sourceCode,
-	UpgradeChange& _change
+vector<UpgradeChange> SourceUpgrade::analyze(string const& _sourceName) const
+{
+	Suite suite = m_suite;
+	suite.reset();
+	suite.analyze(*m_compiler, m_compiler->ast(_sourceName));
+	return move(suite.changes());
+}
+
+void SourceUpgrade::applyChanges(
+	string const& _sourceName,
+	vector<UpgradeChange> const& _changes
 )
 {
 	bool dryRun = m_args.count(g_argDryRun);
 	bool verbose = m_args.count(g_argVerbose);
 
-	if (verbose)
+	string& source = m_sourceCodes[_sourceName];
+
+	/// Applying the changes from the end of the source keeps the locations
+	/// of the remaining ones valid.
+	for (UpgradeChange const& change: _changes | ranges::views::reverse)
 	{
-		log() << "Applying change to " << _sourceCode.first << endl << endl;
-		log() << _change.patch();
-	}
+		if (verbose)
+		{
+			log() << "Applying change to " << _sourceName << endl << endl;
+			log() << change.patch();
+		}
 
-	m_sourceCodes[_sourceCode.first] = _change.apply(_sourceCode.second);
+		source = change.apply(source);
+	}
 
 	if (!dryRun)
-		writeInputFile(_sourceCode.first, m_sourceCodes[_sourceCode.first]);
+		writeInputFile(_sourceName, source);
+}
+
+set<string> SourceUpgrade::sourcesDependingOn(set<string> const& _sourceNames) const
+{
+	set<SourceUnit const*> changedUnits;
+	for (string const& sourceName: _sourceNames)
+		changedUnits.insert(&m_compiler->ast(sourceName));
+
+	set<string> sourceNames = _sourceNames;
+	for (string const& sourceName: m_compiler->sourceNames())
+		for (SourceUnit const* referenced: m_compiler->ast(sourceName).referencedSourceUnits(true))
+			if (changedUnits.count(referenced))
+			{
+				sourceNames.insert(sourceName);
+				break;
+			}
+	return sourceNames;
 }
 
 void SourceUpgrade::printErrors() const
@@ -526,9 +599,8 @@ ReadCallback::Callback SourceUpgrade::fileReader()
 
 void SourceUpgrade::resetCompiler()
 {
-	m_compiler->reset();
+	m_compiler->reset(true);
 	m_compiler->setSources(m_sourceCodes);
-	m_compiler->setParserErrorRecovery(true);
 }
 
 void SourceUpgrade::resetCompiler(ReadCallback::Callback const& _callback)
@@ -536,4 +608,6 @@ void SourceUpgrade::resetCompiler(ReadCallback::Callback const& _callback)
 	m_compiler = std::make_unique<CompilerStack>(_callback);
 	m_compiler->setSources(m_sourceCodes);
 	m_compiler->setParserErrorRecovery(true);
+	m_compiler->enableASTCache();
+	m_compiler->setParallelism(m_jobs);
 }
@@ -30,6 +30,7 @@
 #include <boost/filesystem/path.hpp>
 
 #include <memory>
+#include <set>
 
 namespace solidity::tools
 {
@@ -119,24 +120,26 @@ private:
 	/// them if parsing was successful.
 	void tryCompile() const;
 	/// Analyses and upgrades the sources given. The upgrade happens in a loop,
-	/// applying one change at a time, which is run until no applicable changes
-	/// are found any more. Only one change is done at a time and all sources
-	/// are being compiled again after each change.
+	/// which is run until no applicable changes are found any more. In each
+	/// iteration, the sources changed in the previous one and the sources
+	/// importing them are analysed in parallel, all applicable changes that do
+	/// not overlap are applied at once and all sources are compiled again.
 	void runUpgrade();
-	/// Runs upgrade analysis on source and applies upgrades changes to it.
-	/// Returns `true` if there're still changes that can be applied,
-	/// `false` otherwise.
-	bool analyzeAndUpgrade(
-		std::pair<std::string, std::string> const& _sourceCode
-	);
-
-	/// Applies the change given to its source code. If no `--dry-run` was
-	/// passed via the commandline, the upgraded source code is written back
-	/// to its file.
-	void applyChange(
-		std::pair<std::string, std::string> const& _sourceCode,
-		UpgradeChange& _change
+	/// Runs upgrade analysis on the source with the given name and returns the
+	/// changes found. Only reads the compiler stack and the suite, so that it
+	/// can be run for several sources at the same time.
+	std::vector<UpgradeChange> analyze(std::string const& _sourceName) const;
+
+	/// Applies the changes given to the source code with the given name.
+	/// The changes must not overlap. If no `--dry-run` was passed via the
+	/// commandline, the upgraded source code is written back to its file.
+	void applyChanges(
+		std::string const& _sourceName,
+		std::vector<UpgradeChange> const& _changes
 	);
+	/// Returns the names of the sources given and of all sources that import
+	/// one of them, directly or indirectly.
+	std::set<std::string> sourcesDependingOn(std::set<std::string> const& _sourceNames) const;
 
 	/// Prints all errors (excluding warnings) the compiler currently reported.
 	void printErrors() const;
@@ -151,11 +154,12 @@ private:
 	/// Returns a file reader function that fills `m_sources`.
 	frontend::ReadCallback::Callback fileReader();
 
-	/// Resets the compiler stack and configures sources to compile.
-	/// Also enables error recovery.
+	/// Resets the compiler stack, keeping its settings and the sources parsed
+	/// before, and configures sources to compile.
 	void resetCompiler();
 	/// Resets the compiler stack and configures sources to compile.
-	/// Also enables error recovery. Passes read callback to the compiler stack.
+	/// Also enables error recovery and the reuse of unchanged sources across
+	/// compilations. Passes read callback to the compiler stack.
 	void resetCompiler(frontend::ReadCallback::Callback const& _callback);
 
 	/// Compiler arguments variable map
@@ -166,8 +170,11 @@ private:
 	std::unique_ptr<frontend::CompilerStack> m_compiler;
 	/// List of allowed directories to read files from
 	std::vector<boost::filesystem::path> m_allowedDirectories;
-	/// Holds all upgrade modules and source upgrades.
+	/// Holds all upgrade modules and the source upgrades that were found, but
+	/// not applied.
 	Suite m_suite;
+	/// Number of threads used to analyse and compile the sources.
+	size_t m_jobs = 1;
 };
 
 }
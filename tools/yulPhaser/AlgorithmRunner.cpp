@@ -117,6 +117,7 @@ void AlgorithmRunner::printCacheStats() const
 		m_outputStream << "Total hits: " << totalStats.hits << endl;
 		m_outputStream << "Total misses: " << totalStats.misses << endl;
 		m_outputStream << "Size of cached code: " << totalStats.totalCodeSize << endl;
+		m_outputStream << "Evicted entries: " << totalStats.evictions << endl;
 	}
 
 	if (disabledCacheCount == m_programCaches.size())
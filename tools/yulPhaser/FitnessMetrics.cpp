@@ -18,15 +18,53 @@
 
 #include <tools/yulPhaser/FitnessMetrics.h>
 
+#include <libevmasm/Assembly.h>
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/KnownState.h>
+
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Parallel.h>
 
+#include <chrono>
 #include <cmath>
 
 using namespace std;
+using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::yul;
 using namespace solidity::phaser;
 
+namespace
+{
+
+/// @returns the cost of executing @a _item once, not including memory expansion and external costs.
+u256 staticExecutionGas(evmasm::AssemblyItem const& _item, langutil::EVMVersion _evmVersion)
+{
+	evmasm::GasMeter meter(make_shared<evmasm::KnownState>(), _evmVersion);
+	evmasm::GasMeter::GasConsumption gas = meter.estimateMax(_item, false);
+	if (!gas.isInfinite)
+		return gas.value;
+
+	// The gas meter does not know the values on the stack and gives up on memory expansion.
+	if (
+		_item.type() == evmasm::Operation &&
+		evmasm::instructionInfo(_item.instruction()).gasPriceTier != evmasm::Tier::Special
+	)
+		return evmasm::GasMeter::runGas(_item.instruction());
+	return 0;
+}
+
+}
+
+vector<size_t> FitnessMetric::evaluateAll(vector<Chromosome> const& _chromosomes)
+{
+	vector<size_t> values(_chromosomes.size());
+	parallelFor(_chromosomes.size(), m_parallelism, [&](size_t _index) {
+		values[_index] = evaluate(_chromosomes[_index]);
+	});
+	return values;
+}
+
 Program const& ProgramBasedMetric::program() const
 {
 	if (m_programCache == nullptr)
@@ -75,6 +113,43 @@ size_t RelativeProgramSize::evaluate(Chromosome const& _chromosome)
 	));
 }
 
+size_t OptimisationTime::evaluate(Chromosome const& _chromosome)
+{
+	auto startTime = chrono::steady_clock::now();
+	optimisedProgramNoCache(_chromosome).assemble();
+	auto elapsedTime = chrono::steady_clock::now() - startTime;
+
+	return static_cast<size_t>(chrono::duration_cast<chrono::microseconds>(elapsedTime).count());
+}
+
+size_t BytecodeSize::evaluate(Chromosome const& _chromosome)
+{
+	shared_ptr<evmasm::Assembly> assembly = optimisedProgram(_chromosome).assemble();
+	if (!assembly)
+		return UncompilableProgramValue;
+
+	return assembly->assemble().bytecode.size();
+}
+
+size_t GasCost::evaluate(Chromosome const& _chromosome)
+{
+	shared_ptr<evmasm::Assembly> assembly = optimisedProgram(_chromosome).assemble();
+	if (!assembly)
+		return UncompilableProgramValue;
+
+	langutil::EVMVersion const evmVersion{};
+	bigint executionGas = 0;
+	for (evmasm::AssemblyItem const& item: assembly->items())
+		executionGas += staticExecutionGas(item, evmVersion);
+
+	bytes const& bytecode = assembly->assemble().bytecode;
+	bigint totalGas =
+		bigint(evmasm::GasMeter::dataGas(bytecode, false, evmVersion)) +
+		executionGas * m_expectedExecutions;
+
+	return static_cast<size_t>(min<bigint>(totalGas, UncompilableProgramValue));
+}
+
 size_t FitnessMetricAverage::evaluate(Chromosome const& _chromosome)
 {
 	assert(m_metrics.size() > 0);
@@ -97,6 +172,17 @@ size_t FitnessMetricSum::evaluate(Chromosome const& _chromosome)
 	return total;
 }
 
+size_t FitnessMetricWeightedSum::evaluate(Chromosome const& _chromosome)
+{
+	assert(m_metrics.size() > 0);
+
+	size_t total = 0;
+	for (size_t i = 0; i < m_metrics.size(); ++i)
+		total += m_weights[i] * m_metrics[i]->evaluate(_chromosome);
+
+	return total;
+}
+
 size_t FitnessMetricMaximum::evaluate(Chromosome const& _chromosome)
 {
 	assert(m_metrics.size() > 0);
@@ -27,8 +27,12 @@
 
 #include <libyul/optimiser/Metrics.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <vector>
 
 namespace solidity::phaser
 {
@@ -39,6 +43,10 @@ namespace solidity::phaser
  * The main feature is the @a evaluate() method that can tell how good a given chromosome is.
  * The lower the value, the better the fitness is. The result should be deterministic and depend
  * only on the chromosome and metric's state (which is constant).
+ *
+ * @a evaluateAll() evaluates several chromosomes on up to @a parallelism() threads. Metrics must
+ * allow @a evaluate() to be called from several threads at once unless they are only used with
+ * the default parallelism of one.
  */
 class FitnessMetric
 {
@@ -49,6 +57,15 @@ public:
 	virtual ~FitnessMetric() = default;
 
 	virtual size_t evaluate(Chromosome const& _chromosome) = 0;
+
+	/// @returns the values of @a _chromosomes in the same order.
+	std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes);
+
+	size_t parallelism() const { return m_parallelism; }
+	void setParallelism(size_t _threads) { m_parallelism = std::max<size_t>(_threads, 1); }
+
+private:
+	size_t m_parallelism = 1;
 };
 
 /**
@@ -86,6 +103,12 @@ public:
 	Program optimisedProgram(Chromosome const& _chromosome);
 	Program optimisedProgramNoCache(Chromosome const& _chromosome) const;
 
+protected:
+	/// Value returned by metrics based on the generated EVM code for programs that cannot be
+	/// compiled. It is high enough to rule such chromosomes out but still leaves room for
+	/// adding up the values for several programs.
+	static size_t constexpr UncompilableProgramValue = std::numeric_limits<uint32_t>::max();
+
 private:
 	std::optional<Program> m_program;
 	std::shared_ptr<ProgramCache> m_programCache;
@@ -132,6 +155,62 @@ private:
 	size_t m_fixedPointPrecision;
 };
 
+/**
+ * Fitness metric based on the time it takes to apply the optimisations from the chromosome to
+ * a specific program and to generate EVM code from the result, in microseconds.
+ *
+ * The program cache is never used since it would hide the time spent in the steps it has already
+ * applied. Unlike the other metrics, the value depends on the machine and its load so it is not
+ * deterministic.
+ */
+class OptimisationTime: public ProgramBasedMetric
+{
+public:
+	using ProgramBasedMetric::ProgramBasedMetric;
+	size_t evaluate(Chromosome const& _chromosome) override;
+};
+
+/**
+ * Fitness metric based on the size of the bytecode generated from a specific program after
+ * applying the optimisations from the chromosome to it.
+ */
+class BytecodeSize: public ProgramBasedMetric
+{
+public:
+	using ProgramBasedMetric::ProgramBasedMetric;
+	size_t evaluate(Chromosome const& _chromosome) override;
+};
+
+/**
+ * Fitness metric based on the gas needed to deploy the bytecode generated from a specific program
+ * after applying the optimisations from the chromosome to it and to then run it
+ * @a _expectedExecutions times.
+ *
+ * The cost of a run is a static estimate that counts every instruction in the bytecode once and
+ * ignores memory expansion and the costs of external calls, just like the cost model used by
+ * the optimiser when it is given the expected number of runs.
+ */
+class GasCost: public ProgramBasedMetric
+{
+public:
+	explicit GasCost(
+		std::optional<Program> _program,
+		std::shared_ptr<ProgramCache> _programCache,
+		size_t _expectedExecutions,
+		yul::CodeWeights const& _weights,
+		size_t _repetitionCount = 1
+	):
+		ProgramBasedMetric(std::move(_program), std::move(_programCache), _weights, _repetitionCount),
+		m_expectedExecutions(_expectedExecutions) {}
+
+	size_t expectedExecutions() const { return m_expectedExecutions; }
+
+	size_t evaluate(Chromosome const& _chromosome) override;
+
+private:
+	size_t m_expectedExecutions;
+};
+
 /**
  * Abstract base class for fitness metrics that compute their value based on values of multiple
  * other, nested metrics.
@@ -168,6 +247,31 @@ public:
 	size_t evaluate(Chromosome const& _chromosome) override;
 };
 
+/**
+ * Fitness metric that returns the sum of values of its nested metrics, each multiplied by the
+ * corresponding weight. Allows optimising several objectives at once.
+ */
+class FitnessMetricWeightedSum: public FitnessMetricCombination
+{
+public:
+	explicit FitnessMetricWeightedSum(
+		std::vector<std::shared_ptr<FitnessMetric>> _metrics,
+		std::vector<size_t> _weights
+	):
+		FitnessMetricCombination(std::move(_metrics)),
+		m_weights(std::move(_weights))
+	{
+		assert(m_weights.size() == m_metrics.size());
+	}
+
+	std::vector<size_t> const& weights() const { return m_weights; }
+
+	size_t evaluate(Chromosome const& _chromosome) override;
+
+private:
+	std::vector<size_t> m_weights;
+};
+
 /**
  * Fitness metric that returns the highest of values of its nested metrics.
  */
@@ -69,6 +69,9 @@ map<MetricChoice, string> MetricChoiceToStringMap =
 {
 	{MetricChoice::CodeSize, "code-size"},
 	{MetricChoice::RelativeCodeSize, "relative-code-size"},
+	{MetricChoice::OptimisationTime, "optimisation-time"},
+	{MetricChoice::BytecodeSize, "bytecode-size"},
+	{MetricChoice::GasCost, "gas-cost"},
 };
 map<string, MetricChoice> const StringToMetricChoiceMap = invertMap(MetricChoiceToStringMap);
 
@@ -215,10 +218,15 @@ CodeWeights CodeWeightFactory::buildFromCommandLine(po::variables_map const& _ar
 FitnessMetricFactory::Options FitnessMetricFactory::Options::fromCommandLine(po::variables_map const& _arguments)
 {
 	return {
-		_arguments["metric"].as<MetricChoice>(),
+		_arguments["metric"].as<vector<MetricChoice>>(),
+		_arguments.count("metric-weights") > 0 ?
+			_arguments["metric-weights"].as<vector<size_t>>() :
+			vector<size_t>{},
 		_arguments["metric-aggregator"].as<MetricAggregatorChoice>(),
 		_arguments["relative-metric-scale"].as<size_t>(),
+		_arguments["expected-executions"].as<size_t>(),
 		_arguments["chromosome-repetitions"].as<size_t>(),
+		_arguments["threads"].as<size_t>(),
 	};
 }
 
@@ -232,50 +240,100 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 	assert(_programCaches.size() == _programs.size());
 	assert(_programs.size() > 0 && "Validations should prevent this from being executed with zero files.");
 
+	assert(_options.metrics.size() > 0);
+	assertThrow(
+		_options.metricWeights.empty() || _options.metricWeights.size() == _options.metrics.size(),
+		InvalidMetricWeights,
+		"The number of metric weights must match the number of metrics."
+	);
+
 	vector<shared_ptr<FitnessMetric>> metrics;
-	switch (_options.metric)
+	for (size_t i = 0; i < _programs.size(); ++i)
 	{
-		case MetricChoice::CodeSize:
+		vector<shared_ptr<FitnessMetric>> programMetrics;
+		for (MetricChoice metricChoice: _options.metrics)
 		{
-			for (size_t i = 0; i < _programs.size(); ++i)
-				metrics.push_back(make_unique<ProgramSize>(
-					_programCaches[i] != nullptr ? optional<Program>{} : move(_programs[i]),
-					move(_programCaches[i]),
-					_weights,
-					_options.chromosomeRepetitions
-				));
-
-			break;
+			optional<Program> program = _programCaches[i] != nullptr ? optional<Program>{} : _programs[i];
+			switch (metricChoice)
+			{
+				case MetricChoice::CodeSize:
+					programMetrics.push_back(make_unique<ProgramSize>(
+						move(program),
+						_programCaches[i],
+						_weights,
+						_options.chromosomeRepetitions
+					));
+					break;
+				case MetricChoice::RelativeCodeSize:
+					programMetrics.push_back(make_unique<RelativeProgramSize>(
+						move(program),
+						_programCaches[i],
+						_options.relativeMetricScale,
+						_weights,
+						_options.chromosomeRepetitions
+					));
+					break;
+				case MetricChoice::OptimisationTime:
+					programMetrics.push_back(make_unique<OptimisationTime>(
+						move(program),
+						_programCaches[i],
+						_weights,
+						_options.chromosomeRepetitions
+					));
+					break;
+				case MetricChoice::BytecodeSize:
+					programMetrics.push_back(make_unique<BytecodeSize>(
+						move(program),
+						_programCaches[i],
+						_weights,
+						_options.chromosomeRepetitions
+					));
+					break;
+				case MetricChoice::GasCost:
+					programMetrics.push_back(make_unique<GasCost>(
+						move(program),
+						_programCaches[i],
+						_options.expectedExecutions,
+						_weights,
+						_options.chromosomeRepetitions
+					));
+					break;
+				default:
+					assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
+			}
 		}
-		case MetricChoice::RelativeCodeSize:
-		{
-			for (size_t i = 0; i < _programs.size(); ++i)
-				metrics.push_back(make_unique<RelativeProgramSize>(
-					_programCaches[i] != nullptr ? optional<Program>{} : move(_programs[i]),
-					move(_programCaches[i]),
-					_options.relativeMetricScale,
-					_weights,
-					_options.chromosomeRepetitions
-				));
-			break;
-		}
-		default:
-			assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
+
+		if (programMetrics.size() == 1)
+			metrics.push_back(move(programMetrics[0]));
+		else
+			metrics.push_back(make_unique<FitnessMetricWeightedSum>(
+				move(programMetrics),
+				!_options.metricWeights.empty() ?
+					_options.metricWeights :
+					vector<size_t>(_options.metrics.size(), 1)
+			));
 	}
 
+	unique_ptr<FitnessMetric> metric;
 	switch (_options.metricAggregator)
 	{
 		case MetricAggregatorChoice::Average:
-			return make_unique<FitnessMetricAverage>(move(metrics));
+			metric = make_unique<FitnessMetricAverage>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Sum:
-			return make_unique<FitnessMetricSum>(move(metrics));
+			metric = make_unique<FitnessMetricSum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Maximum:
-			return make_unique<FitnessMetricMaximum>(move(metrics));
+			metric = make_unique<FitnessMetricMaximum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Minimum:
-			return make_unique<FitnessMetricMinimum>(move(metrics));
+			metric = make_unique<FitnessMetricMinimum>(move(metrics));
+			break;
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricAggregatorChoice value.");
 	}
+	metric->setParallelism(_options.threads);
+	return metric;
 }
 
 PopulationFactory::Options PopulationFactory::Options::fromCommandLine(po::variables_map const& _arguments)
@@ -358,6 +416,9 @@ ProgramCacheFactory::Options ProgramCacheFactory::Options::fromCommandLine(po::v
 {
 	return {
 		_arguments["program-cache"].as<bool>(),
+		_arguments.count("program-cache-limit") > 0 ?
+			_arguments["program-cache-limit"].as<size_t>() :
+			optional<size_t>{},
 	};
 }
 
@@ -368,7 +429,11 @@ vector<shared_ptr<ProgramCache>> ProgramCacheFactory::build(
 {
 	vector<shared_ptr<ProgramCache>> programCaches;
 	for (Program& program: _programs)
-		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(move(program)) : nullptr);
+		programCaches.push_back(
+			_options.programCacheEnabled ?
+			make_shared<ProgramCache>(move(program), _options.maxCachedCodeSize) :
+			nullptr
+		);
 
 	return programCaches;
 }
@@ -639,15 +704,28 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 	metricsDescription.add_options()
 		(
 			"metric",
-			po::value<MetricChoice>()->value_name("<NAME>")->default_value(MetricChoice::RelativeCodeSize),
+			po::value<vector<MetricChoice>>()->multitoken()->value_name("<NAME>...")->default_value(
+				{MetricChoice::RelativeCodeSize},
+				toString(MetricChoice::RelativeCodeSize)
+			),
 			(
-				"Metric used to evaluate the fitness of a chromosome.\n"
+				"Metric used to evaluate the fitness of a chromosome. "
+				"If several metrics are given, their values for each input program are added up, "
+				"multiplied by the weights from --metric-weights.\n"
 				"\n"
 				"AVAILABLE METRICS:\n"
 				"* " + toString(MetricChoice::CodeSize) + "\n" +
-				"* " + toString(MetricChoice::RelativeCodeSize)
+				"* " + toString(MetricChoice::RelativeCodeSize) + "\n" +
+				"* " + toString(MetricChoice::OptimisationTime) + "\n" +
+				"* " + toString(MetricChoice::BytecodeSize) + "\n" +
+				"* " + toString(MetricChoice::GasCost)
 			).c_str()
 		)
+		(
+			"metric-weights",
+			po::value<vector<size_t>>()->multitoken()->value_name("<WEIGHT>..."),
+			"Weights of the metrics chosen with --metric, in the same order. All metrics have weight 1 by default."
+		)
 		(
 			"metric-aggregator",
 			po::value<MetricAggregatorChoice>()->value_name("<NAME>")->default_value(MetricAggregatorChoice::Average),
@@ -674,11 +752,26 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			"Using a bigger factor allows discerning smaller relative differences between chromosomes "
 			"but makes the numbers less readable and may also lose precision if the numbers are very large."
 		)
+		(
+			"expected-executions",
+			po::value<size_t>()->value_name("<COUNT>")->default_value(200),
+			(
+				"Number of times the code is expected to be executed after deployment. "
+				"Used by the " + toString(MetricChoice::GasCost) + " metric to weigh the deployment cost "
+				"against the execution cost, like --optimize-runs in the compiler."
+			).c_str()
+		)
 		(
 			"chromosome-repetitions",
 			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
 			"Number of times to repeat the sequence optimisation steps represented by a chromosome."
 		)
+		(
+			"threads",
+			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
+			"Number of threads used to compute the fitness of the chromosomes in a population. "
+			"The results do not depend on the number of threads."
+		)
 	;
 	keywordDescription.add(metricsDescription);
 
@@ -711,8 +804,14 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::bool_switch(),
 			"Enables caching of intermediate programs corresponding to chromosome prefixes.\n"
 			"This speeds up fitness evaluation by a lot but eats tons of memory if the chromosomes are long. "
-			"Disabled by default since there's currently no way to set an upper limit on memory usage but "
-			"highly recommended if your computer has enough RAM."
+			"Disabled by default but highly recommended, together with --program-cache-limit "
+			"if your computer does not have enough RAM."
+		)
+		(
+			"program-cache-limit",
+			po::value<size_t>()->value_name("<NODES>"),
+			"Maximum total size of the programs stored in each program cache, measured roughly in AST nodes. "
+			"When exceeded, the least recently used programs are removed. No limit by default."
 		)
 	;
 	keywordDescription.add(cacheDescription);
@@ -76,6 +76,9 @@ enum class MetricChoice
 {
 	CodeSize,
 	RelativeCodeSize,
+	OptimisationTime,
+	BytecodeSize,
+	GasCost,
 };
 
 enum class MetricAggregatorChoice
@@ -154,10 +157,14 @@ class FitnessMetricFactory
 public:
 	struct Options
 	{
-		MetricChoice metric;
+		std::vector<MetricChoice> metrics;
+		/// Weights of @a metrics. If empty, all metrics are weighted equally.
+		std::vector<size_t> metricWeights;
 		MetricAggregatorChoice metricAggregator;
 		size_t relativeMetricScale;
+		size_t expectedExecutions;
 		size_t chromosomeRepetitions;
+		size_t threads;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -216,6 +223,7 @@ public:
 	struct Options
 	{
 		bool programCacheEnabled;
+		std::optional<size_t> maxCachedCodeSize;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -28,9 +28,13 @@
 #include <libyul/AsmParser.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
 #include <libyul/YulString.h>
+#include <libyul/backends/evm/EthAssemblyAdapter.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMObjectCompiler.h>
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
@@ -39,6 +43,8 @@
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/Suite.h>
 
+#include <libevmasm/Assembly.h>
+
 #include <libsolutil/JSON.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -105,6 +111,29 @@ void Program::optimise(vector<string> const& _optimisationSteps)
 	m_ast = applyOptimisationSteps(m_dialect, m_nameDispenser, move(m_ast), _optimisationSteps);
 }
 
+shared_ptr<evmasm::Assembly> Program::assemble() const
+{
+	Object object;
+	object.code = make_shared<Block>(get<Block>(ASTCopier{}(*m_ast)));
+
+	variant<unique_ptr<AsmAnalysisInfo>, ErrorList> analysisInfoOrErrors = analyzeAST(m_dialect, *object.code);
+	assert(holds_alternative<unique_ptr<AsmAnalysisInfo>>(analysisInfoOrErrors) && "Optimised programs must pass the analysis.");
+	object.analysisInfo = move(get<unique_ptr<AsmAnalysisInfo>>(analysisInfoOrErrors));
+
+	auto assembly = make_shared<evmasm::Assembly>();
+	EthAssemblyAdapter adapter(*assembly);
+	try
+	{
+		EVMObjectCompiler::compile(object, adapter, dynamic_cast<EVMDialect const&>(m_dialect), true);
+	}
+	catch (yul::StackTooDeepError const&)
+	{
+		return nullptr;
+	}
+
+	return assembly;
+}
+
 ostream& phaser::operator<<(ostream& _stream, Program const& _program)
 {
 	return _stream << AsmPrinter()(*_program.m_ast);
@@ -197,7 +226,9 @@ unique_ptr<Block> Program::applyOptimisationSteps(
 		_dialect,
 		_nameDispenser,
 		externallyUsedIdentifiers,
-		frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment
+		frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment,
+		1,
+		nullptr
 	};
 
 	for (string const& step: _optimisationSteps)
@@ -24,6 +24,7 @@
 #include <liblangutil/Exceptions.h>
 
 #include <cstddef>
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <set>
@@ -39,6 +40,13 @@ class Scanner;
 
 }
 
+namespace solidity::evmasm
+{
+
+class Assembly;
+
+}
+
 namespace solidity::yul
 {
 
@@ -78,6 +86,11 @@ public:
 	size_t codeSize(yul::CodeWeights const& _weights) const { return computeCodeSize(*m_ast, _weights); }
 	yul::Block const& ast() const { return *m_ast; }
 
+	/// Runs the optimised EVM code transform on the program.
+	/// @returns the generated assembly or nullptr if the code transform fails due to a stack
+	/// too deep error.
+	std::shared_ptr<evmasm::Assembly> assemble() const;
+
 	friend std::ostream& operator<<(std::ostream& _stream, Program const& _program);
 	std::string toJson() const;
 
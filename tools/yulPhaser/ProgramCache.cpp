@@ -22,6 +22,8 @@
 
 #include <libyul/optimiser/Suite.h>
 
+#include <vector>
+
 using namespace std;
 using namespace solidity::yul;
 using namespace solidity::phaser;
@@ -31,6 +33,7 @@ CacheStats& CacheStats::operator+=(CacheStats const& _other)
 	hits += _other.hits;
 	misses += _other.misses;
 	totalCodeSize += _other.totalCodeSize;
+	evictions += _other.evictions;
 
 	for (auto& [round, count]: _other.roundEntryCounts)
 		if (roundEntryCounts.find(round) != roundEntryCounts.end())
@@ -47,7 +50,8 @@ bool CacheStats::operator==(CacheStats const& _other) const
 		hits == _other.hits &&
 		misses == _other.misses &&
 		totalCodeSize == _other.totalCodeSize &&
-		roundEntryCounts == _other.roundEntryCounts;
+		roundEntryCounts == _other.roundEntryCounts &&
+		evictions == _other.evictions;
 }
 
 Program ProgramCache::optimiseProgram(
@@ -59,35 +63,51 @@ Program ProgramCache::optimiseProgram(
 	for (size_t i = 1; i < _repetitionCount; ++i)
 		targetOptimisations += _abbreviatedOptimisationSteps;
 
+	unique_lock<mutex> lock(m_mutex);
+	// Entries of shorter prefixes may have been removed while longer ones are still there.
 	size_t prefixSize = 0;
+	Node const* prefixNode = &m_root;
+	Node* node = &m_root;
 	for (size_t i = 1; i <= targetOptimisations.size(); ++i)
 	{
-		auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
-		if (pair != m_entries.end())
+		auto child = node->children.find(targetOptimisations[i - 1]);
+		if (child == node->children.end())
+			break;
+
+		node = child->second.get();
+		if (node->entry.has_value())
 		{
-			pair->second.roundNumber = m_currentRound;
-			++prefixSize;
-			++m_hits;
+			node->entry->roundNumber = m_currentRound;
+			prefixSize = i;
+			prefixNode = node;
 		}
-		else
-			break;
 	}
+	m_hits += prefixSize;
 
 	Program intermediateProgram = (
 		prefixSize == 0 ?
 		m_program :
-		m_entries.at(targetOptimisations.substr(0, prefixSize)).program
+		prefixNode->entry->program
 	);
+	lock.unlock();
 
 	for (size_t i = prefixSize + 1; i <= targetOptimisations.size(); ++i)
 	{
 		string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
 		intermediateProgram.optimise({stepName});
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		// Another thread may have stored the same prefix in the meantime, in which case its
+		// entry is kept. The trie is walked from the root again because other threads may have
+		// removed nodes while the lock was released.
+		lock_guard<mutex> storeLock(m_mutex);
+		store(string_view(targetOptimisations).substr(0, i), intermediateProgram);
 		++m_misses;
 	}
 
+	lock.lock();
+	markUsed(targetOptimisations);
+	enforceSizeLimit();
+
 	return intermediateProgram;
 }
 
@@ -96,30 +116,55 @@ void ProgramCache::startRound(size_t _roundNumber)
 	assert(_roundNumber > m_currentRound);
 	m_currentRound = _roundNumber;
 
-	for (auto pair = m_entries.begin(); pair != m_entries.end();)
+	for (auto usePosition = m_leastRecentlyUsed.begin(); usePosition != m_leastRecentlyUsed.end();)
 	{
-		assert(pair->second.roundNumber < m_currentRound);
+		Node& node = **usePosition;
+		++usePosition;
+		assert(node.entry->roundNumber < m_currentRound);
 
-		if (pair->second.roundNumber < m_currentRound - 1)
-			m_entries.erase(pair++);
-		else
-			++pair;
+		if (node.entry->roundNumber < m_currentRound - 1)
+			remove(node);
 	}
 }
 
 void ProgramCache::clear()
 {
-	m_entries.clear();
+	m_root.children.clear();
+	m_leastRecentlyUsed.clear();
+	m_totalCodeSize = 0;
 	m_currentRound = 0;
 }
 
+CacheEntry const* ProgramCache::entry(string const& _abbreviatedOptimisationSteps) const
+{
+	Node const* node = findNode(_abbreviatedOptimisationSteps);
+	if (!node || !node->entry.has_value())
+		return nullptr;
+
+	return &node->entry.value();
+}
+
 Program const* ProgramCache::find(string const& _abbreviatedOptimisationSteps) const
 {
-	auto const& pair = m_entries.find(_abbreviatedOptimisationSteps);
-	if (pair == m_entries.end())
+	CacheEntry const* cacheEntry = entry(_abbreviatedOptimisationSteps);
+	if (!cacheEntry)
 		return nullptr;
 
-	return &(pair->second.program);
+	return &cacheEntry->program;
+}
+
+set<string> ProgramCache::prefixes() const
+{
+	set<string> result;
+	for (Node const* node: m_leastRecentlyUsed)
+	{
+		string prefix;
+		for (Node const* current = node; current != &m_root; current = current->parent)
+			prefix += current->gene;
+		result.insert(string(prefix.rbegin(), prefix.rend()));
+	}
+
+	return result;
 }
 
 CacheStats ProgramCache::gatherStats() const
@@ -127,28 +172,105 @@ CacheStats ProgramCache::gatherStats() const
 	return {
 		/* hits = */ m_hits,
 		/* misses = */ m_misses,
-		/* totalCodeSize = */ calculateTotalCachedCodeSize(),
+		/* totalCodeSize = */ m_totalCodeSize,
 		/* roundEntryCounts = */ countRoundEntries(),
+		/* evictions = */ m_evictions,
 	};
 }
 
-size_t ProgramCache::calculateTotalCachedCodeSize() const
+ProgramCache::Node const* ProgramCache::findNode(string_view _prefix) const
 {
-	size_t size = 0;
-	for (auto const& pair: m_entries)
-		size += pair.second.program.codeSize(CacheStats::StorageWeights);
+	Node const* node = &m_root;
+	for (char gene: _prefix)
+	{
+		auto child = node->children.find(gene);
+		if (child == node->children.end())
+			return nullptr;
+		node = child->second.get();
+	}
 
-	return size;
+	return node;
+}
+
+void ProgramCache::store(string_view _prefix, Program const& _program)
+{
+	assert(!_prefix.empty());
+
+	Node* node = &m_root;
+	for (char gene: _prefix)
+	{
+		unique_ptr<Node>& child = node->children[gene];
+		if (!child)
+		{
+			child = make_unique<Node>();
+			child->parent = node;
+			child->gene = gene;
+		}
+		node = child.get();
+	}
+
+	if (node->entry.has_value())
+		return;
+
+	node->entry.emplace(CacheEntry{_program, m_currentRound});
+	node->codeSize = _program.codeSize(CacheStats::StorageWeights);
+	node->usePosition = m_leastRecentlyUsed.insert(m_leastRecentlyUsed.end(), node);
+	m_totalCodeSize += node->codeSize;
+}
+
+void ProgramCache::markUsed(string_view _prefix)
+{
+	vector<Node*> path;
+	Node* node = &m_root;
+	for (char gene: _prefix)
+	{
+		auto child = node->children.find(gene);
+		if (child == node->children.end())
+			break;
+		node = child->second.get();
+		if (node->entry.has_value())
+			path.push_back(node);
+	}
+
+	for (auto pathNode = path.rbegin(); pathNode != path.rend(); ++pathNode)
+		m_leastRecentlyUsed.splice(m_leastRecentlyUsed.end(), m_leastRecentlyUsed, (*pathNode)->usePosition);
+}
+
+void ProgramCache::remove(Node& _node)
+{
+	assert(_node.entry.has_value());
+
+	m_leastRecentlyUsed.erase(_node.usePosition);
+	m_totalCodeSize -= _node.codeSize;
+	_node.entry.reset();
+	_node.codeSize = 0;
+
+	Node* node = &_node;
+	while (node != &m_root && !node->entry.has_value() && node->children.empty())
+	{
+		Node* parent = node->parent;
+		parent->children.erase(node->gene);
+		node = parent;
+	}
+}
+
+void ProgramCache::enforceSizeLimit()
+{
+	if (!m_maxTotalCodeSize.has_value())
+		return;
+
+	while (m_totalCodeSize > m_maxTotalCodeSize.value() && !m_leastRecentlyUsed.empty())
+	{
+		remove(*m_leastRecentlyUsed.front());
+		++m_evictions;
+	}
 }
 
 map<size_t, size_t> ProgramCache::countRoundEntries() const
 {
 	map<size_t, size_t> counts;
-	for (auto& pair: m_entries)
-		if (counts.find(pair.second.roundNumber) != counts.end())
-			++counts.at(pair.second.roundNumber);
-		else
-			counts.insert({pair.second.roundNumber, 1});
+	for (Node const* node: m_leastRecentlyUsed)
+		++counts[node->entry->roundNumber];
 
 	return counts;
 }
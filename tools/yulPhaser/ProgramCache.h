@@ -23,8 +23,14 @@
 #include <libyul/optimiser/Metrics.h>
 
 #include <cstddef>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <string>
+#include <string_view>
 
 namespace solidity::phaser
 {
@@ -75,6 +81,8 @@ struct CacheStats
 	size_t misses;
 	size_t totalCodeSize;
 	std::map<size_t, size_t> roundEntryCounts;
+	/// Number of entries removed to stay within the size limit.
+	size_t evictions;
 
 	CacheStats& operator+=(CacheStats const& _other);
 	CacheStats operator+(CacheStats const& _other) const { return CacheStats(*this) += _other; }
@@ -87,27 +95,33 @@ struct CacheStats
  * Class that optimises programs one step at a time which allows it to store and later reuse the
  * results of the intermediate steps.
  *
+ * The programs are stored in a trie of chromosome prefixes, so finding the longest cached prefix of
+ * a chromosome takes one lookup per gene. Prefixes whose programs were removed keep their place in
+ * the trie as long as longer prefixes are still cached.
+ *
  * The cache keeps track of the current round number and associates newly created entries with it.
  * @a startRound() must be called at the beginning of a round so that entries that are too old
  * can be purged. The current strategy is to store programs corresponding to all possible prefixes
  * encountered in the current and the previous rounds. Entries older than that get removed to
  * conserve memory.
  *
- * @a gatherStats() allows getting statistics useful for determining cache effectiveness.
+ * If a limit on the total size of the cached code (measured with @a CacheStats::StorageWeights,
+ * i.e. roughly the number of AST nodes) is given, the least recently used entries are removed
+ * whenever the cache grows past it. Shorter prefixes count as used more recently than the longer
+ * ones on the same path, since more chromosomes share them.
  *
- * The current strategy does speed things up (about 4:1 hit:miss ratio observed in my limited
- * experiments) but there's room for improvement. We could fit more useful programs in
- * the cache by being more picky about which ones we choose.
+ * @a gatherStats() allows getting statistics useful for determining cache effectiveness.
  *
- * There is currently no way to purge entries without starting a new round. Since the programs
- * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
- * long and programs large. A limiter based on entry count or total program size would be useful.
+ * @a optimiseProgram() can be called from several threads at once. The cache is locked only while
+ * looking up and storing entries, not while running the optimiser steps. None of the other functions
+ * may be called at the same time.
  */
 class ProgramCache
 {
 public:
-	explicit ProgramCache(Program _program):
-		m_program(std::move(_program)) {}
+	explicit ProgramCache(Program _program, std::optional<size_t> _maxTotalCodeSize = std::nullopt):
+		m_program(std::move(_program)),
+		m_maxTotalCodeSize(_maxTotalCodeSize) {}
 
 	Program optimiseProgram(
 		std::string const& _abbreviatedOptimisationSteps,
@@ -116,29 +130,55 @@ public:
 	void startRound(size_t _nextRoundNumber);
 	void clear();
 
-	size_t size() const { return m_entries.size(); }
+	size_t size() const { return m_leastRecentlyUsed.size(); }
+	CacheEntry const* entry(std::string const& _abbreviatedOptimisationSteps) const;
 	Program const* find(std::string const& _abbreviatedOptimisationSteps) const;
 	bool contains(std::string const& _abbreviatedOptimisationSteps) const { return find(_abbreviatedOptimisationSteps) != nullptr; }
+	/// @returns the prefixes that have a program in the cache.
+	std::set<std::string> prefixes() const;
 
 	CacheStats gatherStats() const;
 
-	std::map<std::string, CacheEntry> const& entries() const { return m_entries; }
 	Program const& program() const { return m_program; }
+	std::optional<size_t> maxTotalCodeSize() const { return m_maxTotalCodeSize; }
 	size_t currentRound() const { return m_currentRound; }
 
 private:
-	size_t calculateTotalCachedCodeSize() const;
+	struct Node
+	{
+		Node* parent = nullptr;
+		char gene = 0;
+		std::map<char, std::unique_ptr<Node>> children;
+		std::optional<CacheEntry> entry;
+		/// Size of the program in @a entry, measured with @a CacheStats::StorageWeights.
+		size_t codeSize = 0;
+		/// Position in @a m_leastRecentlyUsed if there is an entry.
+		std::list<Node*>::iterator usePosition;
+	};
+
+	/// @returns the node of @a _prefix or nullptr if there is none.
+	Node const* findNode(std::string_view _prefix) const;
+	/// Stores @a _program as the entry of @a _prefix, unless there is one already.
+	void store(std::string_view _prefix, Program const& _program);
+	/// Marks the entries of @a _prefix and all its prefixes as used, the shortest ones last.
+	void markUsed(std::string_view _prefix);
+	/// Removes the entry of @a _node and the nodes that are no longer needed.
+	void remove(Node& _node);
+	/// Removes the least recently used entries until the size limit is respected.
+	void enforceSizeLimit();
 	std::map<size_t, size_t> countRoundEntries() const;
 
-	// The best matching data structure here would be a trie of chromosome prefixes but since
-	// the programs are orders of magnitude larger than the prefixes, it does not really matter.
-	// A map should be good enough.
-	std::map<std::string, CacheEntry> m_entries;
+	Node m_root;
+	/// Nodes with entries, the least recently used first.
+	std::list<Node*> m_leastRecentlyUsed;
 
 	Program m_program;
+	std::optional<size_t> m_maxTotalCodeSize;
+	size_t m_totalCodeSize = 0;
 	size_t m_currentRound = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;
+	size_t m_evictions = 0;
+	std::mutex m_mutex;
 };
-
 }